@@ -0,0 +1,553 @@
+#include "Benchmark.h"
+#include "Actor.h"
+#include "ActorPool.h"
+#include "ActorPrefab.h"
+#include "ComponentUpdater.h"
+#include "ShapeFactory.h"
+#include "Steering.h"
+#include "Jobs/JobSystem.h"
+
+using namespace EngineUtilities;
+
+namespace {
+
+	constexpr size_t kSpawnBatch = 1000; ///< Actores creados por iteracin.
+
+	/**
+	 * @brief Crea un lote de actores con un nombre literal, como `BaseApp::initialize`.
+	 *
+	 * Con `MakeShared` reenviando argumentos, el `std::string` del nombre se construye una
+	 * sola vez directamente en el parmetro de `Actor::Actor`.
+	 */
+	void
+	Actor_SpawnBatch_LiteralName(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		actors.reserve(kSpawnBatch);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kSpawnBatch; ++n) {
+				actors.push_back(MakeShared<Actor>("Circle"));
+			}
+			Benchmark::doNotOptimize(actors.data());
+			actors.clear();
+		}
+	}
+
+	/**
+	 * @brief Crea un lote de actores con un nombre largo (fuera del SSO de `std::string`).
+	 *
+	 * Copiarlo implicaba una reserva en el heap por actor; ahora se interna en `NameTable` y
+	 * el actor solo guarda su `NameId`: lo que queda es el hash y la bsqueda en la tabla.
+	 */
+	void
+	Actor_SpawnBatch_MovedLongName(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		actors.reserve(kSpawnBatch);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kSpawnBatch; ++n) {
+				std::string name = "Projectile_Spawned_From_Wave_Emitter";
+				actors.push_back(MakeShared<Actor>(std::move(name)));
+			}
+			Benchmark::doNotOptimize(actors.data());
+			actors.clear();
+		}
+	}
+
+	/**
+	 * @brief Proyectiles creados con `MakeShared` y destruidos al soltar el puntero.
+	 *
+	 * Cada actor cuesta la reserva del bloque, la del `ShapeFactory` y la del vector de
+	 * componentes, ms las liberaciones correspondientes.
+	 */
+	void
+	Actor_SpawnDestroy_MakeShared(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		actors.reserve(kSpawnBatch);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kSpawnBatch; ++n) {
+				TSharedPointer<Actor> actor = MakeShared<Actor>("Projectile");
+				actor->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+				actors.push_back(actor);
+			}
+			Benchmark::doNotOptimize(actors.data());
+			actors.clear();
+		}
+	}
+
+	/**
+	 * @brief Los mismos proyectiles desde un `ActorPool` ya calentado, destruidos con `Actor::destroy`.
+	 */
+	void
+	Actor_SpawnDestroy_ActorPool(Benchmark::State& state) {
+		ActorPool pool(kSpawnBatch);
+		std::vector<TSharedPointer<Actor>> actors;
+		actors.reserve(kSpawnBatch);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kSpawnBatch; ++n) {
+				TSharedPointer<Actor> actor = pool.spawn("Projectile");
+				actor->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+				actors.push_back(actor);
+			}
+			Benchmark::doNotOptimize(actors.data());
+			for (TSharedPointer<Actor>& actor : actors) {
+				actor->destroy();
+			}
+			actors.clear();
+		}
+	}
+
+	constexpr size_t kWaveSize = 10 * 1000; ///< Actores de una oleada.
+
+	struct WaveVelocity {
+		float x = 0.0f;
+		float y = 40.0f;
+	};
+
+	/**
+	 * @brief Oleada armada a mano, como `BaseApp::initialize`: un `MakeShared` y cada llamada
+	 *        de configuracin por actor.
+	 */
+	void
+	Wave_Spawn_ByHand(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> wave;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kWaveSize; ++n) {
+				TSharedPointer<Actor> actor = MakeShared<Actor>("Enemy");
+				ShapeFactory* shape = actor->findComponent<ShapeFactory>();
+				shape->createShape(ShapeType::CIRCLE);
+				shape->setPosition(float(n % 100) * 8.0f, float(n / 100) * 8.0f);
+				shape->setFillColor(sf::Color::Red);
+				actor->addComponent<WaveVelocity>();
+				wave.push_back(actor);
+			}
+			Benchmark::doNotOptimize(wave.data());
+			wave.clear();
+		}
+	}
+
+	/**
+	 * @brief La misma oleada desde un `ActorPrefab` y un pool ya calentado.
+	 */
+	void
+	Wave_Spawn_Prefab(Benchmark::State& state) {
+		ActorPool pool(kWaveSize);
+		ActorPrefab enemy("Enemy", ShapeType::CIRCLE);
+		enemy.setFillColor(sf::Color::Red).addComponent(WaveVelocity{});
+		std::vector<TSharedPointer<Actor>> wave;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			enemy.instantiate(pool, kWaveSize, wave, [](size_t n, Actor& actor) {
+				actor.findComponent<Transform>()->setPosition(float(n % 100) * 8.0f, float(n / 100) * 8.0f);
+			});
+			Benchmark::doNotOptimize(wave.data());
+			for (TSharedPointer<Actor>& actor : wave) {
+				actor->destroy();
+			}
+			wave.clear();
+		}
+	}
+
+	/**
+	 * @brief `getComponent<ShapeFactory>()`: lectura del ndice por tipo y `static_cast`.
+	 */
+	void
+	Actor_GetComponent_TypeTag(Benchmark::State& state) {
+		Actor actor("Circle");
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TIntrusivePtr<ShapeFactory> shape = actor.getComponent<ShapeFactory>();
+			Benchmark::doNotOptimize(shape);
+		}
+	}
+
+	/**
+	 * @brief `findComponent<ShapeFactory>()`: la misma lectura sin tocar el contador.
+	 */
+	void
+	Actor_FindComponent_Index(Benchmark::State& state) {
+		Actor actor("Circle");
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			ShapeFactory* shape = actor.findComponent<ShapeFactory>();
+			Benchmark::doNotOptimize(shape);
+		}
+	}
+
+	/**
+	 * @brief `hasComponents` con una mscara: un AND y una comparacin.
+	 */
+	void
+	Actor_HasComponents_Mask(Benchmark::State& state) {
+		Actor actor("Circle");
+		const ComponentMask mask = componentBit(ComponentType::SHAPE) | componentBit(ComponentType::TRANSFORM);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			bool present = actor.hasComponents(mask);
+			Benchmark::doNotOptimize(present);
+		}
+	}
+
+	/**
+	 * @brief Referencia: la misma bsqueda con `dynamic_pointer_cast` (RTTI) por componente.
+	 */
+	void
+	Actor_GetComponent_DynamicCast(Benchmark::State& state) {
+		Actor actor("Circle");
+		TIntrusivePtr<Component> component = actor.getComponent<ShapeFactory>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TIntrusivePtr<ShapeFactory> shape = component.dynamic_pointer_cast<ShapeFactory>();
+			Benchmark::doNotOptimize(shape);
+		}
+	}
+
+	constexpr size_t kReferencedActors = 1000; ///< Actores referenciados por iteracin.
+
+	ENGINE_NOINLINE float
+	readBySharedPointer(TSharedPointer<Actor> actor) { return actor->findComponent<Transform>()->getPosition().x; }
+
+	ENGINE_NOINLINE float
+	readByHandle(EntityHandle handle) {
+		Actor* actor = TService<EntityRegistry>::instance().find<Actor>(handle);
+		return actor ? actor->findComponent<Transform>()->getPosition().x : 0.0f;
+	}
+
+	/**
+	 * @brief Pasar cada actor como `TSharedPointer` por valor: sube y baja su contador.
+	 */
+	void
+	Actor_Reference_SharedPointerByValue(Benchmark::State& state) {
+		ActorPool pool(kReferencedActors);
+		std::vector<TSharedPointer<Actor>> actors;
+		for (size_t n = 0; n < kReferencedActors; ++n) {
+			actors.push_back(pool.spawn("Actor"));
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			float sum = 0.0f;
+			for (const TSharedPointer<Actor>& actor : actors) {
+				sum += readBySharedPointer(actor);
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Pasar su `EntityHandle` y resolverlo en el `EntityRegistry`.
+	 */
+	void
+	Actor_Reference_EntityHandle(Benchmark::State& state) {
+		ActorPool pool(kReferencedActors);
+		std::vector<TSharedPointer<Actor>> actors;
+		std::vector<EntityHandle> handles;
+		for (size_t n = 0; n < kReferencedActors; ++n) {
+			actors.push_back(pool.spawn("Actor"));
+			handles.push_back(actors.back()->getHandle());
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			float sum = 0.0f;
+			for (EntityHandle handle : handles) {
+				sum += readByHandle(handle);
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	constexpr size_t kFilteredActors = 4096;      ///< Actores de la escena filtrada.
+	constexpr EntityMask kTagEnemy = 1ull << 0;
+
+	/**
+	 * @brief Escena de filtro: un actor de cada cuatro es "Enemy", uno de cada dos est en la capa 2.
+	 */
+	void
+	spawnFilterScene(ActorPool& pool, std::vector<TSharedPointer<Actor>>& actors) {
+		for (size_t n = 0; n < kFilteredActors; ++n) {
+			bool enemy = n % 4 == 0;
+			actors.push_back(pool.spawn(enemy ? "Enemy" : "Scenery"));
+			actors.back()->setTags(enemy ? kTagEnemy : 0);
+			actors.back()->setLayers(n % 2 ? layerBit(0) : layerBit(2));
+		}
+	}
+
+	/**
+	 * @brief "Enemigos de la capa 2" comparando el nombre internado de cada actor.
+	 */
+	void
+	Filter_ByName(Benchmark::State& state) {
+		ActorPool pool(kFilteredActors);
+		std::vector<TSharedPointer<Actor>> actors;
+		spawnFilterScene(pool, actors);
+		const NameId enemy = NameTable::instance().intern("Enemy");
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			size_t matches = 0;
+			for (const TSharedPointer<Actor>& actor : actors) {
+				matches += actor->getNameId() == enemy && (actor->getLayers() & layerBit(2)) != 0;
+			}
+			Benchmark::doNotOptimize(matches);
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con las mscaras contiguas del `EntityRegistry`.
+	 */
+	void
+	Filter_ByTagMask(Benchmark::State& state) {
+		ActorPool pool(kFilteredActors);
+		std::vector<TSharedPointer<Actor>> actors;
+		spawnFilterScene(pool, actors);
+		EntityRegistry& registry = TService<EntityRegistry>::instance();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			Benchmark::doNotOptimize(registry.countMatching({ kTagEnemy, 0, layerBit(2) }));
+		}
+	}
+
+	/**
+	 * @brief Lo mismo partiendo del ndice de la etiqueta: solo se visitan los enemigos.
+	 */
+	void
+	Filter_ByTagIndex(Benchmark::State& state) {
+		ActorPool pool(kFilteredActors);
+		std::vector<TSharedPointer<Actor>> actors;
+		spawnFilterScene(pool, actors);
+		EntityRegistry& registry = TService<EntityRegistry>::instance();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			size_t matches = 0;
+			for (EntityHandle handle : registry.withTag(kTagEnemy)) {
+				matches += (registry.layers(handle) & layerBit(2)) != 0;
+			}
+			Benchmark::doNotOptimize(matches);
+		}
+	}
+
+	constexpr size_t kTransforms = 4096;   ///< Transforms de la escena.
+	constexpr size_t kMovingEvery = 100;   ///< Uno de cada cien se mueve en cada frame.
+
+	/**
+	 * @brief Escena mayormente esttica: cada frame se piden todas las matrices de mundo y
+	 *        solo se recalculan las de los transforms que se movieron.
+	 */
+	void
+	Transform_WorldMatrix_Cached(Benchmark::State& state) {
+		std::vector<Transform> transforms(kTransforms);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kTransforms; n += kMovingEvery) {
+				transforms[n].move(sf::Vector2f(1.0f, 0.0f));
+			}
+			float sum = 0.0f;
+			for (const Transform& transform : transforms) {
+				sum += transform.getWorldTransform().getMatrix()[12];
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Referencia: la misma escena recalculando todas las matrices cada frame.
+	 */
+	void
+	Transform_WorldMatrix_Recompute(Benchmark::State& state) {
+		std::vector<Transform> transforms(kTransforms);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kTransforms; n += kMovingEvery) {
+				transforms[n].move(sf::Vector2f(1.0f, 0.0f));
+			}
+			float sum = 0.0f;
+			for (const Transform& transform : transforms) {
+				sf::Transform matrix;
+				matrix.translate(transform.getPosition()).rotate(transform.getRotation()).scale(transform.getScale());
+				sum += matrix.getMatrix()[12];
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	constexpr size_t kUpdatedActors = 1000; ///< Actores actualizados por iteracin.
+
+	/**
+	 * @brief `update` de cada componente con su llamada virtual, actor por actor.
+	 */
+	void
+	ComponentUpdate_Virtual(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		std::vector<Entity*> entities;
+		for (size_t n = 0; n < kUpdatedActors; ++n) {
+			actors.push_back(MakeShared<Actor>("Actor"));
+			entities.push_back(actors.back().get());
+		}
+		ComponentUpdater updater;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			updater.update(entities, 1.0f / 60.0f);
+			Benchmark::doNotOptimize(entities.data());
+		}
+	}
+
+	/**
+	 * @brief Los mismos actores con `Transform::updateBatch` y `ShapeFactory` sin update.
+	 */
+	void
+	ComponentUpdate_Batch(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		std::vector<Entity*> entities;
+		for (size_t n = 0; n < kUpdatedActors; ++n) {
+			actors.push_back(MakeShared<Actor>("Actor"));
+			entities.push_back(actors.back().get());
+		}
+		ComponentUpdater updater;
+		updater.registerBatch<Transform>(&Transform::updateBatch);
+		updater.registerNoUpdate<ShapeFactory>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			updater.update(entities, 1.0f / 60.0f);
+			Benchmark::doNotOptimize(entities.data());
+		}
+	}
+
+	constexpr size_t kLevelActors = 10000; ///< Actores cargados en el nivel.
+	constexpr size_t kAwakeEvery = 100;    ///< Uno de cada cien est activo.
+
+	/**
+	 * @brief Nivel mayormente dormido recorrido entero, saltando los inactivos.
+	 */
+	void
+	Level_IterateAll_CheckActive(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		for (size_t n = 0; n < kLevelActors; ++n) {
+			actors.push_back(MakeShared<Actor>("Actor"));
+			actors.back()->setActive(n % kAwakeEvery == 0);
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			size_t masks = 0;
+			for (TSharedPointer<Actor>& actor : actors) {
+				if (actor->isActive()) {
+					masks += actor->getComponentMask();
+				}
+			}
+			Benchmark::doNotOptimize(masks);
+		}
+	}
+
+	/**
+	 * @brief El mismo nivel recorriendo solo `ActiveEntities`.
+	 */
+	void
+	Level_IterateActiveList(Benchmark::State& state) {
+		std::vector<TSharedPointer<Actor>> actors;
+		for (size_t n = 0; n < kLevelActors; ++n) {
+			actors.push_back(MakeShared<Actor>("Actor"));
+			actors.back()->setActive(n % kAwakeEvery == 0);
+		}
+		ActiveEntities& active = TService<ActiveEntities>::instance();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			size_t masks = 0;
+			for (Entity* entity : active.entities()) {
+				masks += entity->getComponentMask();
+			}
+			Benchmark::doNotOptimize(masks);
+		}
+	}
+
+	constexpr size_t kSeekAgents = 100000;
+
+	/**
+	 * @brief 100k agentes con `ShapeFactory::seekStep`, uno por uno.
+	 */
+	void
+	Seek_100k_Scalar(Benchmark::State& state) {
+		std::vector<sf::Vector2f> positions(kSeekAgents);
+		for (size_t n = 0; n < kSeekAgents; ++n) {
+			positions[n] = sf::Vector2f(float(n % 800), float(n / 800));
+		}
+		sf::Vector2f target(400.0f, 300.0f);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (sf::Vector2f& position : positions) {
+				position = ShapeFactory::seekStep(position, target, 200.0f, 1.0f / 60.0f, 10.0f);
+			}
+			Benchmark::doNotOptimize(positions.data());
+		}
+	}
+
+	/**
+	 * @brief Los mismos agentes en arreglos separados con `ShapeFactory::seekBatch`.
+	 */
+	void
+	Seek_100k_Batch(Benchmark::State& state) {
+		std::vector<float> x(kSeekAgents), y(kSeekAgents);
+		std::vector<float> targetX(kSeekAgents, 400.0f), targetY(kSeekAgents, 300.0f);
+		std::vector<float> speed(kSeekAgents, 200.0f), range(kSeekAgents, 10.0f);
+		for (size_t n = 0; n < kSeekAgents; ++n) {
+			x[n] = float(n % 800);
+			y[n] = float(n / 800);
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			ShapeFactory::seekBatch(x.data(), y.data(), targetX.data(), targetY.data(), speed.data(), range.data(),
+				kSeekAgents, 1.0f / 60.0f);
+			Benchmark::doNotOptimize(x.data());
+		}
+	}
+
+	constexpr size_t kCrowdAgents = 20000; ///< Agentes repartidos en un rea 100 veces la vista.
+
+	/**
+	 * @brief Una multitud con seek y separacin; la vista de 800 x 600 ve uno de cada cien.
+	 * @param lod Si no es nulo, decide a quin le toca calcular fuerzas.
+	 */
+	void
+	runCrowd(Benchmark::State& state, UpdateLod* lod) {
+		ActorPool pool(kCrowdAgents);
+		SteeringAgent agent;
+		agent.weights.seek = 1.0f;
+		agent.weights.separation = 1.5f;
+		agent.neighborRadius = 12.0f;
+		ActorPrefab prefab("Crowd", ShapeType::CIRCLE);
+		prefab.addComponent(agent);
+		std::vector<TSharedPointer<Actor>> crowd;
+		prefab.instantiate(pool, kCrowdAgents, crowd, [](size_t n, Actor& actor) {
+			actor.findComponent<Transform>()->setPosition(float(n % 200) * 40.0f, float(n / 200) * 60.0f);
+		});
+		JobSystem& jobs = TService<JobSystem>::instance();
+		SteeringSystem steering;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			if (lod) {
+				lod->advance();
+			}
+			steering.update(Entity::world(), jobs, 1.0f / 60.0f, lod);
+			Benchmark::doNotOptimize(steering.steeredCount());
+		}
+		for (TSharedPointer<Actor>& actor : crowd) {
+			actor->destroy();
+		}
+	}
+
+	void
+	Steering_Crowd_FullRate(Benchmark::State& state) {
+		runCrowd(state, nullptr);
+	}
+
+	/**
+	 * @brief La misma multitud con `UpdateLod`: fuera de la vista, fuerzas cada 8 pasos.
+	 */
+	void
+	Steering_Crowd_Lod(Benchmark::State& state) {
+		UpdateLod lod;
+		lod.setVisibleArea(sf::FloatRect(3600.0f, 2700.0f, 800.0f, 600.0f));
+		runCrowd(state, &lod);
+	}
+}
+
+BENCHMARK(Actor_SpawnBatch_LiteralName);
+BENCHMARK(Actor_SpawnBatch_MovedLongName);
+BENCHMARK(Actor_SpawnDestroy_MakeShared);
+BENCHMARK(Actor_SpawnDestroy_ActorPool);
+BENCHMARK(Wave_Spawn_ByHand);
+BENCHMARK(Wave_Spawn_Prefab);
+BENCHMARK(Actor_GetComponent_TypeTag);
+BENCHMARK(Actor_FindComponent_Index);
+BENCHMARK(Actor_HasComponents_Mask);
+BENCHMARK(Actor_GetComponent_DynamicCast);
+BENCHMARK(Actor_Reference_SharedPointerByValue);
+BENCHMARK(Actor_Reference_EntityHandle);
+BENCHMARK(Filter_ByName);
+BENCHMARK(Filter_ByTagMask);
+BENCHMARK(Filter_ByTagIndex);
+BENCHMARK(Transform_WorldMatrix_Cached);
+BENCHMARK(Transform_WorldMatrix_Recompute);
+BENCHMARK(ComponentUpdate_Virtual);
+BENCHMARK(ComponentUpdate_Batch);
+BENCHMARK(Level_IterateAll_CheckActive);
+BENCHMARK(Level_IterateActiveList);
+BENCHMARK(Seek_100k_Scalar);
+BENCHMARK(Seek_100k_Batch);
+BENCHMARK(Steering_Crowd_FullRate);
+BENCHMARK(Steering_Crowd_Lod);
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+#include "Memory/FrameArena.h"
+#include "Memory/TUniquePtr.h"
+#include <algorithm>
+
+using namespace EngineUtilities;
+
+namespace {
+
+	constexpr size_t kScratchLists = 64;    ///< Listas temporales por frame simulado.
+	constexpr size_t kScratchElements = 256; ///< Elementos por lista.
+
+	/**
+	 * @brief Frame simulado: listas temporales de claves que se llenan y ordenan con el heap.
+	 */
+	void
+	FrameScratch_StdAllocator(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t list = 0; list < kScratchLists; ++list) {
+				std::vector<uint32_t> keys;
+				for (size_t n = 0; n < kScratchElements; ++n) {
+					keys.push_back(static_cast<uint32_t>((n * 2654435761u) ^ list));
+				}
+				std::sort(keys.begin(), keys.end());
+				Benchmark::doNotOptimize(keys.data());
+			}
+		}
+	}
+
+	/**
+	 * @brief El mismo frame con las listas en la `FrameArena`: ninguna llamada a `malloc`.
+	 */
+	void
+	FrameScratch_FrameArena(Benchmark::State& state) {
+		FrameArena arena;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			arena.beginFrame();
+			for (size_t list = 0; list < kScratchLists; ++list) {
+				TArenaVector<uint32_t> keys(arena.allocator<uint32_t>());
+				for (size_t n = 0; n < kScratchElements; ++n) {
+					keys.push_back(static_cast<uint32_t>((n * 2654435761u) ^ list));
+				}
+				std::sort(keys.begin(), keys.end());
+				Benchmark::doNotOptimize(keys.data());
+			}
+		}
+	}
+
+	constexpr size_t kBodies = 16 * 1024; ///< Cuerpos en los buffers SoA.
+
+	/**
+	 * @brief Integracin posicin += velocidad * dt sobre buffers SoA.
+	 */
+	template<typename Buffer>
+	void
+	integrate(Buffer& positions, const Buffer& velocities, Benchmark::State& state) {
+		const float dt = 1.0f / 60.0f;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			float* p = &positions[0];
+			const float* v = &velocities[0];
+			for (size_t n = 0; n < kBodies; ++n) {
+				p[n] += v[n] * dt;
+			}
+			Benchmark::doNotOptimize(p);
+		}
+	}
+
+	void
+	SoAIntegrate_StdVector(Benchmark::State& state) {
+		std::vector<float> positions(kBodies), velocities(kBodies, 1.0f);
+		integrate(positions, velocities, state);
+	}
+
+	/**
+	 * @brief Los mismos buffers con `MakeUniqueAligned<float[]>` a 64 bytes (una lnea de cach).
+	 */
+	void
+	SoAIntegrate_AlignedUnique(Benchmark::State& state) {
+		auto positions = MakeUniqueAligned<float[]>(kBodies, 64);
+		auto velocities = MakeUniqueAligned<float[]>(kBodies, 64);
+		for (float& v : velocities) {
+			v = 1.0f;
+		}
+		integrate(positions, velocities, state);
+	}
+}
+
+BENCHMARK(FrameScratch_StdAllocator);
+BENCHMARK(FrameScratch_FrameArena);
+BENCHMARK(SoAIntegrate_StdVector);
+BENCHMARK(SoAIntegrate_AlignedUnique);
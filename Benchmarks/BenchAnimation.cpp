@@ -0,0 +1,49 @@
+#include <cmath>
+#include "Benchmark.h"
+#include "Animation/AnimationClip.h"
+
+namespace {
+
+	constexpr size_t kPlayers = 10000;
+
+	/**
+	 * @brief Cuatro segundos a 60 Hz de una rbita con giro: lo que exportara una herramienta.
+	 */
+	AnimationClip
+	makeOrbitClip() {
+		AnimationCurve x{ AnimationChannel::PositionX, {} };
+		AnimationCurve y{ AnimationChannel::PositionY, {} };
+		AnimationCurve rotation{ AnimationChannel::Rotation, {} };
+		for (uint32_t frame = 0; frame <= 240; ++frame) {
+			float time = frame / 60.0f;
+			x.keys.push_back({ time, 200.0f + 100.0f * std::cos(time * 1.5707963f) });
+			y.keys.push_back({ time, 200.0f + 100.0f * std::sin(time * 1.5707963f) });
+			rotation.keys.push_back({ time, time * 90.0f });
+		}
+		AnimationCurve curves[] = { x, y, rotation };
+		return AnimationClip::build(curves);
+	}
+
+	/**
+	 * @brief Las tres pistas de 10000 actores, cada uno en otro punto del clip.
+	 */
+	void
+	Animation_SampleBatch(Benchmark::State& state) {
+		AnimationClip clip = makeOrbitClip();
+		std::vector<float> times(kPlayers);
+		std::vector<float> out(kPlayers);
+		float time = 0.0f;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			time = clip.advance(time, 1.0f / 60.0f);
+			for (size_t k = 0; k < kPlayers; ++k) {
+				times[k] = clip.advance(time, static_cast<float>(k) * 0.001f) * clip.timeScale();
+			}
+			for (uint32_t track = 0; track < clip.tracks().size(); ++track) {
+				clip.sampleBatch(track, times.data(), kPlayers, out.data());
+				Benchmark::doNotOptimize(out.data());
+			}
+		}
+	}
+}
+
+BENCHMARK(Animation_SampleBatch);
@@ -0,0 +1,204 @@
+#include "Benchmark.h"
+#include "Containers/TSlotMap.h"
+#include "Containers/TSmallVector.h"
+#include "SpatialHash.h"
+#include "Memory/TSharedPointer.h"
+#include "Memory/TWeakPointer.h"
+
+using namespace EngineUtilities;
+
+namespace {
+
+	struct Body {
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	constexpr size_t kBodies = 4096; ///< Elementos en cada contenedor.
+
+	/**
+	 * @brief Resolver referencias cruzadas guardadas como `SlotHandle`: rango + generacin.
+	 */
+	void
+	CrossReference_SlotHandle(Benchmark::State& state) {
+		TSlotMap<Body> bodies;
+		std::vector<SlotHandle> targets;
+		for (size_t n = 0; n < kBodies; ++n) {
+			targets.push_back(bodies.insert(Body{}));
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			float sum = 0.0f;
+			for (SlotHandle target : targets) {
+				if (Body* body = bodies.get(target)) {
+					sum += body->x;
+				}
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Las mismas referencias guardadas como `TWeakPointer`: `lock()` suma y resta una referencia.
+	 */
+	void
+	CrossReference_WeakPointer(Benchmark::State& state) {
+		std::vector<TSharedPointer<Body>> bodies;
+		std::vector<TWeakPointer<Body>> targets;
+		for (size_t n = 0; n < kBodies; ++n) {
+			bodies.push_back(MakeShared<Body>());
+			targets.push_back(bodies.back());
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			float sum = 0.0f;
+			for (const TWeakPointer<Body>& target : targets) {
+				if (TSharedPointer<Body> body = target.lock()) {
+					sum += body->x;
+				}
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Recorrido denso de un `TSlotMap`.
+	 */
+	void
+	Iterate_SlotMap(Benchmark::State& state) {
+		TSlotMap<Body> bodies;
+		for (size_t n = 0; n < kBodies; ++n) {
+			bodies.insert(Body{});
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (Body& body : bodies) {
+				body.x += 1.0f;
+			}
+			Benchmark::doNotOptimize(bodies.data());
+		}
+	}
+
+	/**
+	 * @brief Recorrido de objetos sueltos en el heap a travs de `TSharedPointer`.
+	 */
+	void
+	Iterate_SharedPointers(Benchmark::State& state) {
+		std::vector<TSharedPointer<Body>> bodies;
+		for (size_t n = 0; n < kBodies; ++n) {
+			bodies.push_back(MakeShared<Body>());
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (TSharedPointer<Body>& body : bodies) {
+				body->x += 1.0f;
+			}
+			Benchmark::doNotOptimize(bodies.data());
+		}
+	}
+
+	constexpr size_t kComponentsPerEntity = 3; ///< Componentes tpicos de un actor.
+
+	/**
+	 * @brief Llenar y recorrer la lista de componentes de una entidad con `std::vector`.
+	 */
+	void
+	ComponentList_StdVector(Benchmark::State& state) {
+		Body parts[kComponentsPerEntity];
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			std::vector<Body*> components;
+			for (Body& part : parts) {
+				components.push_back(&part);
+			}
+			float sum = 0.0f;
+			for (Body* component : components) {
+				sum += component->x;
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con `TSmallVector`: sin reservas mientras quepan en el almacenamiento interno.
+	 */
+	void
+	ComponentList_SmallVector(Benchmark::State& state) {
+		Body parts[kComponentsPerEntity];
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TSmallVector<Body*, 4> components;
+			for (Body& part : parts) {
+				components.push_back(&part);
+			}
+			float sum = 0.0f;
+			for (Body* component : components) {
+				sum += component->x;
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	constexpr float kNeighborRadius = 24.0f; ///< Radio de las consultas de vecinos.
+
+	/**
+	 * @brief Puntos repartidos en un cuadrado de 1024 de lado, con unos 7 vecinos cada uno.
+	 */
+	void
+	makePoints(std::vector<float>& x, std::vector<float>& y) {
+		x.resize(kBodies);
+		y.resize(kBodies);
+		uint32_t seed = 12345u;
+		for (size_t n = 0; n < kBodies; ++n) {
+			seed = seed * 1664525u + 1013904223u;
+			x[n] = static_cast<float>(seed >> 8 & 1023u);
+			seed = seed * 1664525u + 1013904223u;
+			y[n] = static_cast<float>(seed >> 8 & 1023u);
+		}
+	}
+
+	/**
+	 * @brief Vecinos de cada punto comparando contra todos: O(n).
+	 */
+	void
+	Neighbors_BruteForce(Benchmark::State& state) {
+		std::vector<float> x, y;
+		makePoints(x, y);
+		float radiusSq = kNeighborRadius * kNeighborRadius;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			size_t pairs = 0;
+			for (size_t a = 0; a < kBodies; ++a) {
+				for (size_t b = 0; b < kBodies; ++b) {
+					float dx = x[a] - x[b];
+					float dy = y[a] - y[b];
+					pairs += (b != a && dx * dx + dy * dy < radiusSq) ? 1 : 0;
+				}
+			}
+			Benchmark::doNotOptimize(pairs);
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con un `SpatialHash` armado en cada vuelta, como cada frame.
+	 */
+	void
+	Neighbors_SpatialHash(Benchmark::State& state) {
+		std::vector<float> x, y;
+		makePoints(x, y);
+		SpatialHash hash;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			hash.build(x, y, kNeighborRadius);
+			size_t pairs = 0;
+			for (size_t a = 0; a < kBodies; ++a) {
+				hash.forEachInRadius(sf::Vector2f(x[a], y[a]), kNeighborRadius, [&pairs, a](uint32_t b, float) {
+					pairs += b != a ? 1 : 0;
+					return true;
+				});
+			}
+			Benchmark::doNotOptimize(pairs);
+		}
+	}
+}
+
+BENCHMARK(CrossReference_SlotHandle);
+BENCHMARK(CrossReference_WeakPointer);
+BENCHMARK(Iterate_SlotMap);
+BENCHMARK(Iterate_SharedPointers);
+BENCHMARK(ComponentList_StdVector);
+BENCHMARK(ComponentList_SmallVector);
+BENCHMARK(Neighbors_BruteForce);
+BENCHMARK(Neighbors_SpatialHash);
@@ -0,0 +1,511 @@
+#include "Benchmark.h"
+#include "ECS/EntityCommandBuffer.h"
+#include "ECS/SystemScheduler.h"
+#include "ECS/World.h"
+#include "ECS/WorldSnapshot.h"
+#include "Jobs/ParallelFor.h"
+#include "Memory/TIntrusivePtr.h"
+#include "Memory/TRefCounted.h"
+#include <cmath>
+
+using namespace EngineUtilities;
+
+namespace {
+
+	struct Position {
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	struct Velocity {
+		float x = 1.0f;
+		float y = 0.5f;
+	};
+
+	struct Tint {
+		uint32_t rgba = 0xFFFFFFFFu;
+	};
+
+	/**
+	 * @brief Marca transitoria guardada en un conjunto disperso.
+	 */
+	struct TintFlash {
+		static constexpr ComponentStorage kStorage = ComponentStorage::SparseSet;
+		uint32_t rgba = 0xFF0000FFu;
+	};
+
+	struct Lifetime {
+		float seconds = 2.0f;
+	};
+
+	struct LocalMatrix {
+		float m[9] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+	};
+
+	constexpr size_t kEntities = 100 * 1000; ///< Entidades simuladas por benchmark.
+
+	/**
+	 * @brief Modelo actual: cada entidad guarda componentes polimrficos sueltos en el heap.
+	 */
+	struct HeapComponent : public TRefCounted<> {
+		virtual ~HeapComponent() = default;
+	};
+
+	struct HeapPosition : public HeapComponent {
+		Position value;
+	};
+
+	struct HeapVelocity : public HeapComponent {
+		Velocity value;
+	};
+
+	struct HeapEntity {
+		std::vector<TIntrusivePtr<HeapComponent>> components;
+	};
+
+	/**
+	 * @brief Integra posicin += velocidad * dt recorriendo entidades y sus punteros a componentes.
+	 */
+	void
+	Integrate_HeapComponents(Benchmark::State& state) {
+		std::vector<HeapEntity> entities(kEntities);
+		for (HeapEntity& entity : entities) {
+			entity.components.push_back(TIntrusivePtr<HeapComponent>(new HeapPosition()));
+			entity.components.push_back(TIntrusivePtr<HeapComponent>(new HeapVelocity()));
+		}
+		const float dt = 1.0f / 60.0f;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (HeapEntity& entity : entities) {
+				HeapPosition* position = static_cast<HeapPosition*>(entity.components[0].get());
+				HeapVelocity* velocity = static_cast<HeapVelocity*>(entity.components[1].get());
+				position->value.x += velocity->value.x * dt;
+				position->value.y += velocity->value.y * dt;
+			}
+			Benchmark::doNotOptimize(entities.data());
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con `World::each<Position, const Velocity>`: dos columnas contiguas por arquetipo.
+	 *
+	 * Un tercio de las entidades tiene adems `Tint`, as que hay dos arquetipos que recorrer.
+	 */
+	void
+	Integrate_WorldArchetypes(Benchmark::State& state) {
+		World world;
+		for (size_t n = 0; n < kEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity);
+			world.addComponent<Velocity>(entity);
+			if (n % 3 == 0) {
+				world.addComponent<Tint>(entity);
+			}
+		}
+		const float dt = 1.0f / 60.0f;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			world.each<Position, const Velocity>([dt](EntityId, Position& position, const Velocity& velocity) {
+				position.x += velocity.x * dt;
+				position.y += velocity.y * dt;
+			});
+			Benchmark::doNotOptimize(world);
+		}
+	}
+
+	/**
+	 * @brief Costo de mudar una entidad entre arquetipos: agregar y quitar un componente.
+	 */
+	void
+	World_AddRemoveComponent(Benchmark::State& state) {
+		World world;
+		std::vector<EntityId> entities;
+		for (size_t n = 0; n < 1024; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity);
+			world.addComponent<Velocity>(entity);
+			entities.push_back(entity);
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			EntityId entity = entities[i & 1023];
+			world.addComponent<Tint>(entity);
+			world.removeComponent<Tint>(entity);
+		}
+	}
+
+	constexpr size_t kChangedEntities = 1024; ///< Entidades con cambios estructurales por frame.
+
+	/**
+	 * @brief Entidades con `Position`, `Velocity` y `LocalMatrix` para los cambios por frame.
+	 */
+	std::vector<EntityId>
+	makeMovingEntities(World& world) {
+		std::vector<EntityId> entities;
+		for (size_t n = 0; n < kChangedEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity);
+			world.addComponent<Velocity>(entity);
+			world.addComponent<LocalMatrix>(entity);
+			entities.push_back(entity);
+		}
+		return entities;
+	}
+
+	/**
+	 * @brief Un frame de cambios aplicados en el acto: tres mudanzas de arquetipo por entidad.
+	 *
+	 * Cada iteracin alterna entre agregar `Tint` y `Lifetime` quitando `Velocity`, y deshacerlo.
+	 */
+	void
+	StructuralChanges_Immediate(Benchmark::State& state) {
+		World world;
+		std::vector<EntityId> entities = makeMovingEntities(world);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (EntityId entity : entities) {
+				if (i & 1) {
+					world.removeComponent<Tint>(entity);
+					world.removeComponent<Lifetime>(entity);
+					world.addComponent<Velocity>(entity);
+				}
+				else {
+					world.addComponent<Tint>(entity);
+					world.addComponent<Lifetime>(entity);
+					world.removeComponent<Velocity>(entity);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Los mismos cambios anotados en un `EntityCommandBuffer`: una mudanza por entidad.
+	 */
+	void
+	StructuralChanges_CommandBuffer(Benchmark::State& state) {
+		World world;
+		EntityCommandBuffer commands;
+		std::vector<EntityId> entities = makeMovingEntities(world);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (EntityId entity : entities) {
+				if (i & 1) {
+					commands.removeComponent<Tint>(entity);
+					commands.removeComponent<Lifetime>(entity);
+					commands.addComponent<Velocity>(entity);
+				}
+				else {
+					commands.addComponent<Tint>(entity);
+					commands.addComponent<Lifetime>(entity);
+					commands.removeComponent<Velocity>(entity);
+				}
+			}
+			commands.playback(world);
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con un tipo `SparseSet`: la entidad no cambia de arquetipo.
+	 */
+	void
+	World_AddRemoveSparseComponent(Benchmark::State& state) {
+		World world;
+		std::vector<EntityId> entities;
+		for (size_t n = 0; n < 1024; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity);
+			world.addComponent<Velocity>(entity);
+			entities.push_back(entity);
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			EntityId entity = entities[i & 1023];
+			world.addComponent<TintFlash>(entity);
+			world.removeComponent<TintFlash>(entity);
+		}
+	}
+
+	struct Health {
+		float value = 100.0f;
+	};
+
+	struct Heat {
+		float value = 0.0f;
+	};
+
+	/**
+	 * @brief Mundo con 16 arquetipos donde solo una de cada cuatro entidades tiene `Velocity`.
+	 */
+	void
+	fillMixedWorld(World& world) {
+		for (size_t n = 0; n < kEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity);
+			if (n % 4 == 0) {
+				world.addComponent<Velocity>(entity);
+			}
+			if (n & 8) {
+				world.addComponent<Tint>(entity);
+			}
+			if (n & 16) {
+				world.addComponent<Health>(entity);
+			}
+			if (n & 32) {
+				world.addComponent<Heat>(entity);
+			}
+		}
+	}
+
+	/**
+	 * @brief `view<Position, const Velocity>().each` pedido cada frame: la lista de arquetipos ya
+	 *        est calculada, solo se recorren los que coinciden.
+	 */
+	void
+	View_Each_Cached(Benchmark::State& state) {
+		World world;
+		fillMixedWorld(world);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			world.view<Position, const Velocity>().each([](EntityId, Position& position, const Velocity& velocity) {
+				position.x += velocity.x;
+			});
+			Benchmark::doNotOptimize(world);
+		}
+	}
+
+	/**
+	 * @brief La misma consulta con `for` de rango: el iterador busca las columnas por fila.
+	 */
+	void
+	View_RangeFor_Cached(Benchmark::State& state) {
+		World world;
+		fillMixedWorld(world);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (auto [entity, position, velocity] : world.view<Position, const Velocity>()) {
+				position.x += velocity.x;
+			}
+			Benchmark::doNotOptimize(world);
+		}
+	}
+
+	/**
+	 * @brief Cuatro sistemas que tocan tipos distintos, sobre 100k entidades.
+	 */
+	void
+	addIndependentSystems(SystemScheduler& scheduler) {
+		scheduler.addSystem("Movement", ComponentAccess().reads<Velocity>().writes<Position>(), [](World& world, float dt) {
+			world.each<Position, const Velocity>([dt](EntityId, Position& position, const Velocity& velocity) {
+				position.x += velocity.x * dt;
+				position.y += velocity.y * dt;
+			});
+		});
+		scheduler.addSystem("Tint", ComponentAccess().writes<Tint>(), [](World& world, float) {
+			world.each<Tint>([](EntityId, Tint& tint) { tint.rgba = tint.rgba * 1664525u + 1013904223u; });
+		});
+		scheduler.addSystem("Regen", ComponentAccess().writes<Health>(), [](World& world, float dt) {
+			world.each<Health>([dt](EntityId, Health& health) { health.value = std::sqrt(health.value * health.value + dt); });
+		});
+		scheduler.addSystem("Cooling", ComponentAccess().writes<Heat>(), [](World& world, float dt) {
+			world.each<Heat>([dt](EntityId, Heat& heat) { heat.value = std::sqrt(heat.value + dt) * 0.5f; });
+		});
+	}
+
+	void
+	runScheduler(Benchmark::State& state, unsigned workers) {
+		World world;
+		for (size_t n = 0; n < kEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity);
+			world.addComponent<Velocity>(entity);
+			world.addComponent<Tint>(entity);
+			world.addComponent<Health>(entity);
+			world.addComponent<Heat>(entity);
+		}
+		JobSystem jobs(workers);
+		SystemScheduler scheduler(jobs);
+		addIndependentSystems(scheduler);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			scheduler.run(world, 1.0f / 60.0f);
+			Benchmark::doNotOptimize(world);
+		}
+	}
+
+	/**
+	 * @brief Los cuatro sistemas uno detrs de otro (sin hilos de trabajo).
+	 */
+	void
+	Scheduler_IndependentSystems_Serial(Benchmark::State& state) { runScheduler(state, 0); }
+
+	/**
+	 * @brief Los mismos sistemas repartidos en un `JobSystem` del tamao de la mquina.
+	 */
+	void
+	Scheduler_IndependentSystems_Parallel(Benchmark::State& state) { runScheduler(state, JobSystem::defaultWorkerCount()); }
+
+	struct Seek {
+		float x = 400.0f;
+		float y = 300.0f;
+	};
+
+	/**
+	 * @brief El paso de `ShapeFactory::seekStep` sobre datos sin SFML.
+	 */
+	inline void
+	seekStep(Position& position, const Seek& seek, float dt) {
+		float dx = seek.x - position.x;
+		float dy = seek.y - position.y;
+		float length = std::sqrt(dx * dx + dy * dy);
+		if (length > 10.0f) {
+			float step = 200.0f * dt / length;
+			position.x += dx * step;
+			position.y += dy * step;
+		}
+	}
+
+	void
+	fillSeekers(World& world) {
+		for (size_t n = 0; n < kEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity, Position{ float(n % 800), float(n / 800) });
+			world.addComponent<Seek>(entity);
+		}
+	}
+
+	/**
+	 * @brief 100k actores acercndose a su objetivo con `WorldView::each`.
+	 */
+	void
+	SeekMovement_Serial(Benchmark::State& state) {
+		World world;
+		fillSeekers(world);
+		WorldView<const Seek, Position> view = world.view<const Seek, Position>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			view.each([](EntityId, const Seek& seek, Position& position) { seekStep(position, seek, 1.0f / 60.0f); });
+			Benchmark::doNotOptimize(world);
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con `parallelForEach` en trozos de 256 filas.
+	 */
+	void
+	SeekMovement_ParallelForEach(Benchmark::State& state) {
+		World world;
+		fillSeekers(world);
+		JobSystem jobs(JobSystem::defaultWorkerCount());
+		WorldView<const Seek, Position> view = world.view<const Seek, Position>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			parallelForEach(jobs, view, 256, [](EntityId, const Seek& seek, Position& position) {
+				seekStep(position, seek, 1.0f / 60.0f);
+			});
+			Benchmark::doNotOptimize(world);
+		}
+	}
+
+	/**
+	 * @brief Escena de 100k entidades donde solo el 1% se mueve cada frame; el consumidor (un
+	 *        ndice espacial, por ejemplo) recalcula una celda por entidad.
+	 */
+	template<typename Consume>
+	void
+	runMostlyStatic(Benchmark::State& state, Consume&& consume) {
+		World world;
+		std::vector<EntityId> entities;
+		for (size_t n = 0; n < kEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity, Position{ float(n % 800), float(n / 800) });
+			world.addComponent<Tint>(entity);
+			entities.push_back(entity);
+		}
+		std::vector<uint32_t> cells(kEntities);
+		uint32_t since = 0;
+		size_t next = 0;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t moved = 0; moved < kEntities / 100; ++moved) {
+				world.getComponent<Position>(entities[next])->x += 1.0f;
+				next = (next + 7919) % kEntities;
+			}
+			uint32_t started = advanceChangeTick();
+			consume(world.view<const Position>(), since, [&cells](EntityId entity, const Position& position) {
+				cells[entity.index] = uint32_t(position.x) / 32 + uint32_t(position.y) / 32 * 64;
+			});
+			since = started;
+			Benchmark::doNotOptimize(cells.data());
+		}
+	}
+
+	/**
+	 * @brief Recalcula todas las entidades cada frame.
+	 */
+	void
+	MostlyStatic_EachAll(Benchmark::State& state) {
+		runMostlyStatic(state, [](const WorldView<const Position>& view, uint32_t, auto&& fn) { view.each(fn); });
+	}
+
+	/**
+	 * @brief Recalcula solo las que cambiaron, con `eachChanged`.
+	 */
+	void
+	MostlyStatic_EachChanged(Benchmark::State& state) {
+		runMostlyStatic(state, [](const WorldView<const Position>& view, uint32_t since, auto&& fn) {
+			view.eachChanged(since, fn);
+		});
+	}
+
+	/**
+	 * @brief Paso de rollback sobre 100k entidades con el 1% movindose: guardar la foto del paso
+	 *        o volver a ella. `Fresh` invalida la foto cada vez, para medir la copia entera.
+	 */
+	template<bool Restore, bool Fresh>
+	void
+	runSnapshot(Benchmark::State& state) {
+		World world;
+		std::vector<EntityId> entities;
+		for (size_t n = 0; n < kEntities; ++n) {
+			EntityId entity = world.createEntity();
+			world.addComponent<Position>(entity, Position{ float(n % 800), float(n / 800) });
+			world.addComponent<Velocity>(entity);
+			world.addComponent<Tint>(entity);
+			entities.push_back(entity);
+		}
+		WorldSnapshot snapshot;
+		world.saveSnapshot(snapshot);
+		size_t next = 0;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t moved = 0; moved < kEntities / 100; ++moved) {
+				world.getComponent<Position>(entities[next])->x += 1.0f;
+				next = (next + 7919) % kEntities;
+			}
+			if (Fresh) {
+				snapshot.invalidate();
+			}
+			if (Restore) {
+				world.restoreSnapshot(snapshot);
+			}
+			else {
+				world.saveSnapshot(snapshot);
+			}
+			Benchmark::doNotOptimize(snapshot.lastCopiedBytes());
+		}
+	}
+
+	void
+	World_Snapshot_SaveFull(Benchmark::State& state) { runSnapshot<false, true>(state); }
+
+	void
+	World_Snapshot_SaveChanged(Benchmark::State& state) { runSnapshot<false, false>(state); }
+
+	void
+	World_Snapshot_Restore(Benchmark::State& state) { runSnapshot<true, false>(state); }
+}
+
+BENCHMARK(Integrate_HeapComponents);
+BENCHMARK(Integrate_WorldArchetypes);
+BENCHMARK(View_Each_Cached);
+BENCHMARK(View_RangeFor_Cached);
+BENCHMARK(World_AddRemoveComponent);
+BENCHMARK(World_AddRemoveSparseComponent);
+BENCHMARK(StructuralChanges_Immediate);
+BENCHMARK(StructuralChanges_CommandBuffer);
+BENCHMARK(Scheduler_IndependentSystems_Serial);
+BENCHMARK(Scheduler_IndependentSystems_Parallel);
+BENCHMARK(SeekMovement_Serial);
+BENCHMARK(SeekMovement_ParallelForEach);
+BENCHMARK(MostlyStatic_EachAll);
+BENCHMARK(MostlyStatic_EachChanged);
+BENCHMARK(World_Snapshot_SaveFull);
+BENCHMARK(World_Snapshot_SaveChanged);
+BENCHMARK(World_Snapshot_Restore);
@@ -0,0 +1,189 @@
+#include "Benchmark.h"
+#include "Events/EventBus.h"
+#include "Events/TimerWheel.h"
+#include "Jobs/JobSystem.h"
+#include <mutex>
+#include <vector>
+
+namespace {
+
+	struct Hit {
+		static constexpr size_t kEventCapacity = 64 * 1024;
+
+		uint32_t source = 0;
+		uint32_t target = 0;
+		float impulse = 0.0f;
+	};
+
+	constexpr size_t kEvents = 1024; ///< Eventos por frame.
+
+	/**
+	 * @brief Publicar un frame de eventos y entregarlos por lote a un oyente.
+	 */
+	void
+	Events_PublishDispatch_Bus(Benchmark::State& state) {
+		EventBus bus;
+		float total = 0.0f;
+		bus.subscribeBatch<Hit>([&total](std::span<const Hit> hits) {
+			for (const Hit& hit : hits) {
+				total += hit.impulse;
+			}
+		});
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kEvents; ++n) {
+				bus.publish(Hit{ uint32_t(n), uint32_t(n + 1), 1.0f });
+			}
+			bus.dispatch();
+			Benchmark::doNotOptimize(total);
+		}
+	}
+
+	/**
+	 * @brief Referencia: vector con mutex por evento y una llamada a `std::function` por evento.
+	 */
+	void
+	Events_PublishDispatch_MutexVector(Benchmark::State& state) {
+		std::mutex mutex;
+		std::vector<Hit> pending;
+		std::vector<Hit> batch;
+		float total = 0.0f;
+		std::function<void(const Hit&)> listener = [&total](const Hit& hit) { total += hit.impulse; };
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = 0; n < kEvents; ++n) {
+				std::lock_guard<std::mutex> lock(mutex);
+				pending.push_back(Hit{ uint32_t(n), uint32_t(n + 1), 1.0f });
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				batch.swap(pending);
+			}
+			for (const Hit& hit : batch) {
+				listener(hit);
+			}
+			batch.clear();
+			Benchmark::doNotOptimize(total);
+		}
+	}
+
+	constexpr size_t kWorkerEvents = 64 * 1024; ///< Eventos publicados desde los hilos por iteracin.
+
+	/**
+	 * @brief Hilos de trabajo publicando a la vez: la cola reparte celdas con un CAS.
+	 */
+	void
+	Events_PublishFromWorkers_Bus(Benchmark::State& state) {
+		JobSystem jobs;
+		EventBus bus;
+		size_t received = 0;
+		bus.subscribeBatch<Hit>([&received](std::span<const Hit> hits) { received += hits.size(); });
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			jobs.parallelFor(kWorkerEvents, 256, [&bus](size_t begin, size_t end) {
+				for (size_t n = begin; n < end; ++n) {
+					bus.publish(Hit{ uint32_t(n), 0, 1.0f });
+				}
+			});
+			bus.dispatch();
+			Benchmark::doNotOptimize(received);
+		}
+	}
+
+	/**
+	 * @brief Referencia: los mismos hilos compitiendo por un mutex.
+	 */
+	void
+	Events_PublishFromWorkers_MutexVector(Benchmark::State& state) {
+		JobSystem jobs;
+		std::mutex mutex;
+		std::vector<Hit> pending;
+		size_t received = 0;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			jobs.parallelFor(kWorkerEvents, 256, [&mutex, &pending](size_t begin, size_t end) {
+				for (size_t n = begin; n < end; ++n) {
+					std::lock_guard<std::mutex> lock(mutex);
+					pending.push_back(Hit{ uint32_t(n), 0, 1.0f });
+				}
+			});
+			received += pending.size();
+			pending.clear();
+			Benchmark::doNotOptimize(received);
+		}
+	}
+
+	constexpr uint32_t kTimers = 100000;   ///< Temporizadores programados a la vez.
+	constexpr uint32_t kTimerSpan = 3600;  ///< Pasos de retraso como mximo: un minuto a 60 Hz.
+
+	/**
+	 * @brief Un paso con `kTimers` programados: la rueda solo toca los que vencen, que se
+	 *        vuelven a programar para mantener la cantidad.
+	 */
+	void
+	Timers_Advance_Wheel(Benchmark::State& state) {
+		TimerWheel timers;
+		uint32_t fired = 0;
+		uint32_t seed = 1;
+		for (uint32_t n = 0; n < kTimers; ++n) {
+			seed = seed * 1664525u + 1013904223u;
+			timers.every(1 + (seed >> 8) % kTimerSpan, [&fired]() { ++fired; });
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			timers.advance();
+			Benchmark::doNotOptimize(fired);
+		}
+	}
+
+	/**
+	 * @brief Referencia: una cuenta regresiva por temporizador, revisadas todas en cada paso.
+	 */
+	void
+	Timers_Advance_CountdownScan(Benchmark::State& state) {
+		struct Countdown {
+			uint32_t remaining;
+			uint32_t period;
+			std::function<void()> callback;
+		};
+		std::vector<Countdown> timers;
+		uint32_t fired = 0;
+		uint32_t seed = 1;
+		for (uint32_t n = 0; n < kTimers; ++n) {
+			seed = seed * 1664525u + 1013904223u;
+			uint32_t period = 1 + (seed >> 8) % kTimerSpan;
+			timers.push_back({ period, period, [&fired]() { ++fired; } });
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (Countdown& timer : timers) {
+				if (--timer.remaining == 0) {
+					timer.remaining = timer.period;
+					timer.callback();
+				}
+			}
+			Benchmark::doNotOptimize(fired);
+		}
+	}
+
+	/**
+	 * @brief Programar un tiempo lmite y cancelarlo antes de que venza, el caso comn.
+	 */
+	void
+	Timers_ScheduleCancel_Wheel(Benchmark::State& state) {
+		TimerWheel timers;
+		uint32_t seed = 1;
+		for (uint32_t n = 0; n < kTimers; ++n) {
+			seed = seed * 1664525u + 1013904223u;
+			timers.after(1 + (seed >> 8) % kTimerSpan, []() {});
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			seed = seed * 1664525u + 1013904223u;
+			TimerHandle timeout = timers.after(1 + (seed >> 8) % kTimerSpan, []() {});
+			timers.cancel(timeout);
+		}
+		Benchmark::doNotOptimize(timers.size());
+	}
+}
+
+BENCHMARK(Events_PublishDispatch_Bus);
+BENCHMARK(Events_PublishDispatch_MutexVector);
+BENCHMARK(Events_PublishFromWorkers_Bus);
+BENCHMARK(Events_PublishFromWorkers_MutexVector);
+BENCHMARK(Timers_Advance_Wheel);
+BENCHMARK(Timers_Advance_CountdownScan);
+BENCHMARK(Timers_ScheduleCancel_Wheel);
@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "Jobs/JobSystem.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+	constexpr size_t kElements = 1 << 18; ///< Elementos del recorrido.
+	constexpr size_t kJobs = 1024;        ///< Trabajos vacos por iteracin.
+
+	void
+	transform(std::vector<float>& values, size_t begin, size_t end) {
+		for (size_t n = begin; n < end; ++n) {
+			values[n] = std::sqrt(values[n] * values[n] + 1.0f);
+		}
+	}
+
+	/**
+	 * @brief Recorrido en un solo hilo, como referencia.
+	 */
+	void
+	ParallelFor_Serial(Benchmark::State& state) {
+		std::vector<float> values(kElements, 1.0f);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			transform(values, 0, values.size());
+			Benchmark::doNotOptimize(values.data());
+		}
+	}
+
+	/**
+	 * @brief El mismo recorrido partido con `parallelFor` en un `JobSystem` del tamao de la mquina.
+	 */
+	void
+	ParallelFor_JobSystem(Benchmark::State& state) {
+		JobSystem jobs;
+		std::vector<float> values(kElements, 1.0f);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			jobs.parallelFor(values.size(), 4096, [&values](size_t begin, size_t end) { transform(values, begin, end); });
+			Benchmark::doNotOptimize(values.data());
+		}
+	}
+
+	/**
+	 * @brief Costo de lanzar y esperar trabajos vacos: mide el sistema, no el trabajo.
+	 */
+	void
+	JobSystem_RunWaitEmpty(Benchmark::State& state) {
+		JobSystem jobs;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			JobCounter counter;
+			for (size_t n = 0; n < kJobs; ++n) {
+				jobs.run([]() {}, &counter);
+			}
+			jobs.wait(counter);
+		}
+	}
+}
+
+BENCHMARK(ParallelFor_Serial);
+BENCHMARK(ParallelFor_JobSystem);
+BENCHMARK(JobSystem_RunWaitEmpty);
@@ -0,0 +1,124 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+	constexpr double kMinSampleSeconds = 0.05; ///< Duracin mnima de una muestra calibrada.
+	constexpr int kSamples = 5;                ///< Muestras tomadas por benchmark.
+
+	/**
+	 * @brief Ejecuta una muestra y devuelve los segundos transcurridos.
+	 */
+	double
+	runSample(Benchmark::BenchmarkFn fn, uint64_t iterations) {
+		Benchmark::State state(iterations);
+		auto start = Benchmark::Clock::now();
+		fn(state);
+		auto end = Benchmark::Clock::now();
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+	/**
+	 * @brief Busca un nmero de iteraciones que dure al menos `kMinSampleSeconds`.
+	 */
+	uint64_t
+	calibrate(Benchmark::BenchmarkFn fn) {
+		uint64_t iterations = 1;
+		while (iterations < (1ull << 40)) {
+			double seconds = runSample(fn, iterations);
+			if (seconds >= kMinSampleSeconds) {
+				break;
+			}
+			iterations *= (seconds < kMinSampleSeconds / 100.0) ? 10 : 2;
+		}
+		return iterations;
+	}
+
+	/**
+	 * @brief Resultado de un benchmark, en nanosegundos por operacin.
+	 */
+	struct Result {
+		std::string name;
+		uint64_t iterations;
+		double minNs;
+		double medianNs;
+		double maxNs;
+	};
+
+	/**
+	 * @brief Escribe los resultados en JSON para compararlos entre mquinas o commits.
+	 * @return `false` si no se pudo abrir el archivo.
+	 */
+	bool
+	writeJson(const char* path, const std::vector<Result>& results) {
+		std::FILE* file = std::fopen(path, "w");
+		if (!file) {
+			return false;
+		}
+		std::fprintf(file, "{\n  \"samples\": %d,\n  \"benchmarks\": [\n", kSamples);
+		for (size_t i = 0; i < results.size(); ++i) {
+			const Result& r = results[i];
+			std::fprintf(file,
+			             "    {\"name\": \"%s\", \"iterations\": %llu, \"min_ns\": %.3f, "
+			             "\"median_ns\": %.3f, \"max_ns\": %.3f}%s\n",
+			             r.name.c_str(),
+			             static_cast<unsigned long long>(r.iterations),
+			             r.minNs, r.medianNs, r.maxNs,
+			             i + 1 < results.size() ? "," : "");
+		}
+		std::fprintf(file, "  ]\n}\n");
+		std::fclose(file);
+		return true;
+	}
+}
+
+/**
+ * @brief Uso: `Benchmarks [filtro] [--json=resultados.json]`.
+ *
+ * El filtro es una subcadena del nombre (por ejemplo `VsStd_` o `WeakLock`).
+ */
+
+int
+main(int argc, char** argv) {
+	const char* filter = nullptr;
+	const char* jsonPath = nullptr;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strncmp(argv[i], "--json=", 7) == 0) {
+			jsonPath = argv[i] + 7;
+		}
+		else {
+			filter = argv[i];
+		}
+	}
+
+	std::vector<Result> results;
+
+	std::printf("%-48s %14s %14s %14s\n", "benchmark", "iterations", "min ns/op", "median ns/op");
+	for (const Benchmark::Registration& bench : Benchmark::registry()) {
+		if (filter && bench.name.find(filter) == std::string::npos) {
+			continue;
+		}
+
+		uint64_t iterations = calibrate(bench.fn);
+		std::vector<double> nsPerOp;
+		for (int i = 0; i < kSamples; ++i) {
+			nsPerOp.push_back(runSample(bench.fn, iterations) * 1e9 / static_cast<double>(iterations));
+		}
+		std::sort(nsPerOp.begin(), nsPerOp.end());
+		results.push_back({ bench.name, iterations, nsPerOp.front(), nsPerOp[nsPerOp.size() / 2], nsPerOp.back() });
+
+		std::printf("%-48s %14llu %14.2f %14.2f\n",
+		            bench.name.c_str(),
+		            static_cast<unsigned long long>(iterations),
+		            nsPerOp.front(),
+		            nsPerOp[nsPerOp.size() / 2]);
+	}
+
+	if (jsonPath && !writeJson(jsonPath, results)) {
+		std::fprintf(stderr, "No se pudo escribir %s\n", jsonPath);
+		return 1;
+	}
+	return 0;
+}
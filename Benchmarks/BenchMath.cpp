@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include "Math/CompactTransform.h"
+#include "Math/Random.h"
+#include <vector>
+
+/**
+ * @brief Recorrer muchos transforms completos (`Vec3` + `Quat` + `Vec3`, 48 bytes) contra los
+ *        mismos en `CompactTransformChunk` (16 bytes), decodificando al vuelo.
+ *
+ * Cada iteracin arma la matriz de `kTransforms` transforms y lleva un punto con ella; los
+ * compactos se decodifican de a `kBlock`, como los usara un sistema. Son bastantes ms de los
+ * que caben en cach, pero con un solo hilo la memoria rara vez es el lmite: lo compacto lee
+ * un tercio y gana cuando varios ncleos comparten el ancho de banda, no aqu.
+ */
+namespace {
+
+	constexpr size_t kTransforms = 1 << 20;
+	constexpr size_t kBlock = 256;              ///< Se decodifica de a bloques que quedan en L1.
+	constexpr float kChunkExtent = 1024.0f;
+
+	struct FullTransform {
+		Vec3 translation;
+		Quat rotation;
+		Vec3 scale;
+	};
+
+	struct Population {
+		std::vector<FullTransform> full;
+		CompactTransformChunk compact{ Vec3(0.0f, 0.0f, 0.0f), kChunkExtent };
+	};
+
+	const Population&
+	population() {
+		static Population s_population = []() {
+			Population result;
+			Random random(7);
+			result.full.reserve(kTransforms);
+			result.compact.reserve(kTransforms);
+			for (size_t i = 0; i < kTransforms; ++i) {
+				FullTransform t;
+				t.translation = Vec3(random.range(0.0f, kChunkExtent), random.range(0.0f, kChunkExtent), random.range(0.0f, kChunkExtent));
+				t.rotation = Quat::fromAxisAngle(Vec3(random.range(-1.0f, 1.0f), random.range(-1.0f, 1.0f), 1.0f), random.range(0.0f, 360.0f));
+				t.scale = Vec3(random.range(0.5f, 2.0f), random.range(0.5f, 2.0f), random.range(0.5f, 2.0f));
+				result.full.push_back(t);
+				result.compact.add(t.translation, t.rotation, t.scale);
+			}
+			return result;
+		}();
+		return s_population;
+	}
+
+	void
+	Math_Transforms_Full(Benchmark::State& state) {
+		const Population& transforms = population();
+		const Vec3 point(1.0f, 2.0f, 3.0f);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			Vec3 sum;
+			for (const FullTransform& t : transforms.full) {
+				sum += transformPoint(composeTransform(t.translation, t.rotation, t.scale), point);
+			}
+			Benchmark::doNotOptimize(sum.x);
+		}
+	}
+
+	void
+	Math_Transforms_Compact(Benchmark::State& state) {
+		const Population& transforms = population();
+		const Vec3 point(1.0f, 2.0f, 3.0f);
+		std::vector<Mat4> matrices(kBlock);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			Vec3 sum;
+			for (size_t first = 0; first < kTransforms; first += kBlock) {
+				transforms.compact.decodeMatrices(first, kBlock, matrices.data());
+				for (const Mat4& matrix : matrices) {
+					sum += transformPoint(matrix, point);
+				}
+			}
+			Benchmark::doNotOptimize(sum.x);
+		}
+	}
+
+	void
+	Math_Positions_Full(Benchmark::State& state) {
+		const Population& transforms = population();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			Vec3 sum;
+			for (const FullTransform& t : transforms.full) {
+				sum += t.translation;
+			}
+			Benchmark::doNotOptimize(sum.x);
+		}
+	}
+
+	void
+	Math_Positions_Compact(Benchmark::State& state) {
+		const Population& transforms = population();
+		Vec3 positions[kBlock];
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			Vec3 sum;
+			for (size_t first = 0; first < kTransforms; first += kBlock) {
+				transforms.compact.decodePositions(first, kBlock, positions);
+				for (const Vec3& position : positions) {
+					sum += position;
+				}
+			}
+			Benchmark::doNotOptimize(sum.x);
+		}
+	}
+}
+
+BENCHMARK(Math_Transforms_Full);
+BENCHMARK(Math_Transforms_Compact);
+BENCHMARK(Math_Positions_Full);
+BENCHMARK(Math_Positions_Compact);
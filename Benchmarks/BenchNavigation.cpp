@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "Navigation/NavGrid.h"
+#include "Navigation/Pathfinder.h"
+#include "Navigation/FlowField.h"
+#include "Jobs/JobSystem.h"
+#include "PathLibrary.h"
+
+namespace {
+
+	constexpr uint32_t kGridSide = 256; ///< Celdas por lado de la grilla de prueba.
+
+	/**
+	 * @brief Grilla abierta con una pared casi de lado a lado: los caminos deben rodearla.
+	 */
+	NavGrid
+	makeWalledGrid() {
+		NavGrid grid(kGridSide, kGridSide, 16.0f);
+		for (uint32_t y = 0; y < kGridSide - 6; ++y) {
+			grid.setCost(kGridSide / 2, y, NavGrid::kBlocked);
+		}
+		return grid;
+	}
+
+	/**
+	 * @brief Una bsqueda de A* que cruza la pared, con los nodos ya reservados.
+	 */
+	void
+	Path_AStar_WalledGrid(Benchmark::State& state) {
+		NavGrid grid = makeWalledGrid();
+		Pathfinder::SearchNodes nodes;
+		std::vector<uint32_t> cells;
+		uint32_t row = 0;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			row = (row + 7) % 64;
+			bool found = Pathfinder::findPath(grid, grid.indexOf(10, row), grid.indexOf(kGridSide - 10, row + 32), nodes, cells);
+			Benchmark::doNotOptimize(found);
+			Benchmark::doNotOptimize(cells.data());
+		}
+	}
+
+	/**
+	 * @brief Un campo completo sobre la misma grilla, sin lmite de celdas por llamada; el
+	 *        destino cambia de celda en cada vuelta para que siempre se reconstruya.
+	 */
+	void
+	Flow_Build_WalledGrid(Benchmark::State& state) {
+		NavGrid grid = makeWalledGrid();
+		JobSystem& jobs = EngineUtilities::TService<JobSystem>::instance();
+		FlowField field;
+		uint32_t row = 0;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			row = (row + 7) % 64;
+			field.setTarget(grid.centerOf(kGridSide - 10, row));
+			bool ready = field.update(grid, jobs, grid.cellCount());
+			Benchmark::doNotOptimize(ready);
+		}
+	}
+
+	/**
+	 * @brief 100000 seguidores de un Catmull-Rom cerrado avanzan un paso: suma, bsqueda en la
+	 *        tabla e interpolacin.
+	 */
+	void
+	Path_SplineLookup(Benchmark::State& state) {
+		constexpr size_t kFollowers = 100000;
+		Path path;
+		path.points = { { 100.0f, 100.0f }, { 400.0f, 100.0f }, { 600.0f, 300.0f }, { 400.0f, 400.0f }, { 100.0f, 400.0f } };
+		path.curve = PathCurve::CatmullRom;
+		PathLibrary::bake(path);
+		std::vector<float> distance(kFollowers);
+		for (size_t i = 0; i < kFollowers; ++i) {
+			distance[i] = path.length * static_cast<float>(i) / kFollowers;
+		}
+		std::vector<sf::Vector2f> position(kFollowers);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t k = 0; k < kFollowers; ++k) {
+				distance[k] += 200.0f / 60.0f;
+				position[k] = path.pointAt(distance[k]);
+			}
+			Benchmark::doNotOptimize(position.data());
+		}
+	}
+}
+
+BENCHMARK(Path_AStar_WalledGrid);
+BENCHMARK(Flow_Build_WalledGrid);
+BENCHMARK(Path_SplineLookup);
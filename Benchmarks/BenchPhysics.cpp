@@ -0,0 +1,208 @@
+#include "Benchmark.h"
+#include "Jobs/JobSystem.h"
+#include "Physics/Broadphase.h"
+#include "Physics/PhysicsWorld.h"
+
+namespace {
+
+	constexpr uint32_t kStaticColliders = 20000; ///< Decorado: nunca se mueve.
+	constexpr uint32_t kMovingColliders = 500;
+
+	/**
+	 * @brief Caja de 8 x 8 en un punto pseudoaleatorio de un cuadrado de 4096 de lado.
+	 */
+	Aabb
+	randomBox(uint32_t& seed) {
+		seed = seed * 1664525u + 1013904223u;
+		float x = static_cast<float>(seed >> 8 & 4095u);
+		seed = seed * 1664525u + 1013904223u;
+		float y = static_cast<float>(seed >> 8 & 4095u);
+		return { x, y, x + 8.0f, y + 8.0f };
+	}
+
+	/**
+	 * @brief Un frame con 20000 colisionadores quietos y 500 que avanzan 1 unidad: mover y
+	 *        rehacer los pares.
+	 */
+	void
+	Broadphase_MostlyStatic(Benchmark::State& state) {
+		Broadphase broadphase;
+		uint32_t seed = 7u;
+		for (uint32_t i = 0; i < kStaticColliders; ++i) {
+			broadphase.createProxy(randomBox(seed), nullptr, true);
+		}
+		std::vector<uint32_t> moving(kMovingColliders);
+		std::vector<Aabb> boxes(kMovingColliders);
+		for (uint32_t i = 0; i < kMovingColliders; ++i) {
+			boxes[i] = randomBox(seed);
+			moving[i] = broadphase.createProxy(boxes[i], nullptr, false);
+		}
+		broadphase.updatePairs();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			float step = (i / 256) % 2 == 0 ? 1.0f : -1.0f;
+			for (uint32_t k = 0; k < kMovingColliders; ++k) {
+				boxes[k].minX += step;
+				boxes[k].maxX += step;
+				broadphase.moveProxy(moving[k], boxes[k], sf::Vector2f(step, 0.0f));
+			}
+			broadphase.updatePairs();
+			Benchmark::doNotOptimize(broadphase.pairs().data());
+		}
+	}
+
+	constexpr uint32_t kPileColumns = 100;
+	constexpr uint32_t kPileRows = 20;
+
+	/**
+	 * @brief 2000 cajas en columnas sobre un piso, con gravedad.
+	 */
+	void
+	buildPile(PhysicsWorld& physics, std::vector<PhysicsWorld::BodyId>& bodies) {
+		physics.setGravity(sf::Vector2f(0.0f, 500.0f));
+		physics.createStatic({ -100.0f, 1000.0f, 4000.0f, 1100.0f });
+		for (uint32_t row = 0; row < kPileRows; ++row) {
+			for (uint32_t column = 0; column < kPileColumns; ++column) {
+				sf::Vector2f position(column * 30.0f, 980.0f - row * 22.0f);
+				bodies.push_back(physics.createBody(position, { 0.0f, 0.0f, 20.0f, 20.0f }, 1.0f, 0.1f));
+			}
+		}
+	}
+
+	/**
+	 * @brief Un paso con toda la pila despierta: en cada vuelta se empuja una caja de cada columna.
+	 */
+	void
+	runAwakePile(Benchmark::State& state, JobSystem* jobs) {
+		PhysicsWorld physics;
+		std::vector<PhysicsWorld::BodyId> bodies;
+		buildPile(physics, bodies);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (uint32_t column = 0; column < kPileColumns; ++column) {
+				physics.setVelocity(bodies[(kPileRows - 1) * kPileColumns + column], sf::Vector2f(0.0f, -1.0f));
+			}
+			physics.step(1.0f / 60.0f, jobs);
+			Benchmark::doNotOptimize(physics.awakeCount());
+		}
+	}
+
+	void
+	Physics_AwakePile(Benchmark::State& state) { runAwakePile(state, nullptr); }
+
+	/**
+	 * @brief Las 100 columnas son islas separadas: se reparten entre los hilos.
+	 */
+	void
+	Physics_AwakePile_Parallel(Benchmark::State& state) {
+		JobSystem jobs(JobSystem::defaultWorkerCount());
+		runAwakePile(state, &jobs);
+	}
+
+	/**
+	 * @brief Un muro de cajas encimadas que forma una sola isla de miles de contactos, resuelta
+	 *        por colores en modo determinista.
+	 */
+	void
+	Physics_AwakeWall_Parallel(Benchmark::State& state) {
+		JobSystem jobs(JobSystem::defaultWorkerCount());
+		PhysicsWorld physics;
+		physics.setDeterministic(true);
+		physics.setGravity(sf::Vector2f(0.0f, 500.0f));
+		physics.createStatic({ -100.0f, 1000.0f, 4000.0f, 1100.0f });
+		std::vector<PhysicsWorld::BodyId> bodies;
+		for (uint32_t row = 0; row < 20; ++row) {
+			for (uint32_t column = 0; column < 60; ++column) {
+				bodies.push_back(physics.createBody(sf::Vector2f(column * 19.0f, 980.0f - row * 19.0f),
+					{ 0.0f, 0.0f, 20.0f, 20.0f }, 1.0f, 0.1f));
+			}
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			physics.setVelocity(bodies.back(), sf::Vector2f(0.0f, -1.0f));
+			physics.step(1.0f / 60.0f, &jobs);
+			Benchmark::doNotOptimize(physics.awakeCount());
+		}
+	}
+
+	/**
+	 * @brief La misma pila ya dormida: un paso casi no cuesta.
+	 */
+	void
+	Physics_SleepingPile(Benchmark::State& state) {
+		PhysicsWorld physics;
+		std::vector<PhysicsWorld::BodyId> bodies;
+		buildPile(physics, bodies);
+		for (uint32_t frame = 0; frame < 600 && physics.awakeCount() > 0; ++frame) {
+			physics.step(1.0f / 60.0f);
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			physics.step(1.0f / 60.0f);
+			Benchmark::doNotOptimize(physics.awakeCount());
+		}
+	}
+
+	constexpr uint32_t kPickRays = 256; ///< Rayos de un lote, cortos como los de la cmara de frente.
+
+	/**
+	 * @brief Segmentos de 64 unidades que salen de puntos pseudoaleatorios.
+	 */
+	std::vector<sf::Vector2f>
+	pickSegments(uint32_t& seed) {
+		std::vector<sf::Vector2f> points;
+		for (uint32_t i = 0; i < kPickRays; ++i) {
+			Aabb box = randomBox(seed);
+			points.push_back(sf::Vector2f(box.minX, box.minY));
+			points.push_back(sf::Vector2f(box.minX + 64.0f, box.minY + 24.0f));
+		}
+		return points;
+	}
+
+	/**
+	 * @brief 256 segmentos contra 20000 cajas, bajando por el rbol.
+	 */
+	void
+	Picking_Raycast_Tree(Benchmark::State& state) {
+		AabbTree tree;
+		uint32_t seed = 11u;
+		for (uint32_t i = 0; i < kStaticColliders; ++i) {
+			tree.createProxy(randomBox(seed), nullptr);
+		}
+		std::vector<sf::Vector2f> segments = pickSegments(seed);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			uint32_t hits = 0;
+			for (size_t k = 0; k < segments.size(); k += 2) {
+				tree.raycast(segments[k], segments[k + 1], [&hits](uint32_t) { ++hits; return true; });
+			}
+			Benchmark::doNotOptimize(hits);
+		}
+	}
+
+	/**
+	 * @brief Referencia: los mismos segmentos contra cada caja, como revisar la caja de cada actor.
+	 */
+	void
+	Picking_Raycast_Scan(Benchmark::State& state) {
+		std::vector<Aabb> boxes;
+		uint32_t seed = 11u;
+		for (uint32_t i = 0; i < kStaticColliders; ++i) {
+			boxes.push_back(randomBox(seed));
+		}
+		std::vector<sf::Vector2f> segments = pickSegments(seed);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			uint32_t hits = 0;
+			for (size_t k = 0; k < segments.size(); k += 2) {
+				sf::Vector2f inverse(1.0f / (segments[k + 1].x - segments[k].x), 1.0f / (segments[k + 1].y - segments[k].y));
+				for (const Aabb& box : boxes) {
+					hits += box.intersectsSegment(segments[k], inverse) ? 1 : 0;
+				}
+			}
+			Benchmark::doNotOptimize(hits);
+		}
+	}
+}
+
+BENCHMARK(Broadphase_MostlyStatic);
+BENCHMARK(Physics_AwakePile);
+BENCHMARK(Physics_AwakePile_Parallel);
+BENCHMARK(Physics_AwakeWall_Parallel);
+BENCHMARK(Physics_SleepingPile);
+BENCHMARK(Picking_Raycast_Tree);
+BENCHMARK(Picking_Raycast_Scan);
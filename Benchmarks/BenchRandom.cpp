@@ -0,0 +1,121 @@
+#include "Benchmark.h"
+#include "Math/Random.h"
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Nmeros al azar del motor contra las opciones de siempre: `std::rand` y un
+ *        `std::mt19937` compartido detrs de un `std::mutex`.
+ *
+ * Cada iteracin llena `kFloats` floats en [0, 1). Las variantes `Contended` lo hacen desde
+ * `kThreads` hilos a la vez, como los trabajos de partculas o de aparicin.
+ */
+namespace {
+
+	constexpr size_t kFloats = 1024;
+	constexpr unsigned kThreads = 4;
+
+	template<typename Fill>
+	void
+	runContended(Benchmark::State& state, Fill fill) {
+		uint64_t perThread = state.iterations();
+		auto work = [&fill, perThread]() {
+			std::vector<float> values(kFloats);
+			for (uint64_t i = 0; i < perThread; ++i) {
+				fill(values.data());
+				Benchmark::doNotOptimize(values[0]);
+			}
+		};
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < kThreads; ++t) {
+			workers.emplace_back(work);
+		}
+		work();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	void
+	Random_Floats_Batch(Benchmark::State& state) {
+		RandomBatch random(1);
+		std::vector<float> values(kFloats);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			random.fillUniform(values.data(), kFloats);
+			Benchmark::doNotOptimize(values[0]);
+		}
+	}
+
+	void
+	Random_Floats_Scalar(Benchmark::State& state) {
+		Random random(1);
+		std::vector<float> values(kFloats);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t k = 0; k < kFloats; ++k) {
+				values[k] = random.nextFloat();
+			}
+			Benchmark::doNotOptimize(values[0]);
+		}
+	}
+
+	void
+	Random_Floats_StdRand(Benchmark::State& state) {
+		std::srand(1);
+		std::vector<float> values(kFloats);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t k = 0; k < kFloats; ++k) {
+				values[k] = static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX) + 1.0f);
+			}
+			Benchmark::doNotOptimize(values[0]);
+		}
+	}
+
+	void
+	Random_Floats_Mt19937Mutex(Benchmark::State& state) {
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+		std::mutex mutex;
+		std::vector<float> values(kFloats);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t k = 0; k < kFloats; ++k) {
+				std::lock_guard<std::mutex> lock(mutex);
+				values[k] = uniform(random);
+			}
+			Benchmark::doNotOptimize(values[0]);
+		}
+	}
+
+	void
+	Random_Contended_Local(Benchmark::State& state) {
+		RandomService service;
+		runContended(state, [&service](float* values) {
+			Random& random = service.local();
+			for (size_t k = 0; k < kFloats; ++k) {
+				values[k] = random.nextFloat();
+			}
+		});
+	}
+
+	void
+	Random_Contended_Mt19937Mutex(Benchmark::State& state) {
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+		std::mutex mutex;
+		runContended(state, [&](float* values) {
+			for (size_t k = 0; k < kFloats; ++k) {
+				std::lock_guard<std::mutex> lock(mutex);
+				values[k] = uniform(random);
+			}
+		});
+	}
+}
+
+BENCHMARK(Random_Floats_Batch);
+BENCHMARK(Random_Floats_Scalar);
+BENCHMARK(Random_Floats_StdRand);
+BENCHMARK(Random_Floats_Mt19937Mutex);
+BENCHMARK(Random_Contended_Local);
+BENCHMARK(Random_Contended_Mt19937Mutex);
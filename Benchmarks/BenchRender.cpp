@@ -0,0 +1,506 @@
+#include "Benchmark.h"
+#include "Actor.h"
+#include "Camera.h"
+#include "ParticleEmitter.h"
+#include "Render/LayerCache.h"
+#include "Render/LightClusters.h"
+#include "Render/ParticleSystem.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/ShapeBatcher.h"
+#include "Render/SpatialGrid.h"
+#include "Render/StaticGeometryCache.h"
+#include "ShapeFactory.h"
+#include "Tilemap.h"
+#include <vector>
+
+namespace {
+
+	constexpr size_t kDrawables = 4096; ///< Figuras por frame.
+	constexpr size_t kLayers = 4;       ///< Capas repartidas entre las figuras.
+	constexpr size_t kParticles = 100000;
+	constexpr uint32_t kMapTiles = 1024;     ///< Lado del mapa, en baldosas.
+	constexpr size_t kLights = 500;
+
+	/**
+	 * @brief Llenar y ordenar el buffer de un frame: lo que cuesta grabar antes de hablar con SFML.
+	 */
+	void
+	RenderCommands_RecordAndSort(Benchmark::State& state) {
+		std::vector<sf::CircleShape> shapes(kDrawables);
+		RenderCommandBuffer commands;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			commands.clear();
+			for (size_t n = 0; n < kDrawables; ++n) {
+				commands.draw(shapes[n], sf::Transform::Identity, static_cast<uint8_t>(n % kLayers));
+			}
+			commands.sort();
+			size_t count = 0;
+			commands.forEach([&count](const DrawCommand& command) { count += command.geometry != nullptr; });
+			Benchmark::doNotOptimize(count);
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con estados mezclados: 16 profundidades y 16 texturas por capa, como una
+	 *        escena con sprites. La clave de 64 bits los agrupa para cambiar menos de estado.
+	 */
+	void
+	RenderCommands_RecordAndSort_MixedStates(Benchmark::State& state) {
+		std::vector<sf::CircleShape> shapes(kDrawables);
+		std::vector<sf::Texture> textures(16);
+		RenderCommandBuffer commands;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			commands.clear();
+			for (size_t n = 0; n < kDrawables; ++n) {
+				DrawState drawState;
+				drawState.layer = static_cast<uint8_t>(n % kLayers);
+				drawState.depth = static_cast<uint16_t>((n * 7) % 16);
+				drawState.texture = &textures[(n * 13) % textures.size()];
+				commands.draw(shapes[n], sf::Transform::Identity, drawState);
+			}
+			commands.sort();
+			size_t changes = 0;
+			const sf::Texture* current = nullptr;
+			commands.forEach([&changes, &current](const DrawCommand& command) {
+				changes += command.texture != current;
+				current = command.texture;
+			});
+			Benchmark::doNotOptimize(changes);
+		}
+	}
+
+	/**
+	 * @brief Escena de figuras de `ShapeFactory` con su `Transform`, como la de `BaseApp`.
+	 */
+	struct ShapeScene {
+		std::vector<EngineUtilities::TIntrusivePtr<Transform>> transforms;
+		std::vector<EngineUtilities::TIntrusivePtr<ShapeFactory>> shapes;
+
+		ShapeScene() {
+			for (size_t n = 0; n < kDrawables; ++n) {
+				transforms.push_back(EngineUtilities::MakeIntrusive<Transform>());
+				transforms.back()->setPosition(static_cast<float>(n % 64) * 12.0f, static_cast<float>(n / 64) * 9.0f);
+				shapes.push_back(EngineUtilities::MakeIntrusive<ShapeFactory>(ShapeType::CIRCLE));
+				shapes.back()->createShape(n % 8 ? ShapeType::CIRCLE : ShapeType::TRIANGLE);
+				shapes.back()->setTransform(transforms.back().get());
+			}
+		}
+
+		void
+		record(RenderCommandBuffer& commands) {
+			commands.clear();
+			for (EngineUtilities::TIntrusivePtr<ShapeFactory>& shape : shapes) {
+				shape->render(commands);
+			}
+		}
+	};
+
+	/**
+	 * @brief Triangular todas las figuras del frame en CPU con los contornos compartidos.
+	 */
+	void
+	ShapeBatch_Tessellate_SharedOutline(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		scene.record(commands);
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			batcher.clear();
+			commands.forEach([&batcher](const DrawCommand& command) { batcher.append(command); });
+			Benchmark::doNotOptimize(batcher.vertices().data());
+		}
+	}
+
+	/**
+	 * @brief Grabar y triangular la escena vista de lejos (0.2 pxeles por unidad: crculos de
+	 *        2 pxeles de radio), con el nivel de detalle por tamao en pantalla.
+	 */
+	void
+	ShapeBatch_Tessellate_FarLod(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		commands.setPixelScale(0.2f);
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			scene.record(commands);
+			batcher.clear();
+			commands.forEach([&batcher](const DrawCommand& command) { batcher.append(command); });
+			Benchmark::doNotOptimize(batcher.vertices().data());
+		}
+	}
+
+	/**
+	 * @brief La misma escena lejana con los 30 puntos de siempre.
+	 */
+	void
+	ShapeBatch_Tessellate_FarFull(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			scene.record(commands);
+			batcher.clear();
+			commands.forEach([&batcher](const DrawCommand& command) { batcher.append(command); });
+			Benchmark::doNotOptimize(batcher.vertices().data());
+		}
+	}
+
+	/**
+	 * @brief Lo mismo pidiendo los puntos a cada figura (`getPoint`, un seno y un coseno por punto).
+	 */
+	void
+	ShapeBatch_Tessellate_GetPoint(Benchmark::State& state) {
+		std::vector<sf::CircleShape> shapes(kDrawables, sf::CircleShape(10.0f, 30));
+		RenderCommandBuffer commands;
+		for (size_t n = 0; n < kDrawables; ++n) {
+			commands.draw(shapes[n], sf::Transform().translate(static_cast<float>(n % 64) * 12.0f, 0.0f));
+		}
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			batcher.clear();
+			commands.forEach([&batcher](const DrawCommand& command) { batcher.append(command); });
+			Benchmark::doNotOptimize(batcher.vertices().data());
+		}
+	}
+
+	/**
+	 * @brief Enviar el frame a una `sf::RenderTexture`, una figura por draw call.
+	 */
+	void
+	ShapeSubmit_PerShape(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		scene.record(commands);
+		sf::RenderTexture target;
+		target.create(800, 600);
+		ShapeBatcher batcher;
+		batcher.setEnabled(false);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			target.clear();
+			batcher.submit(target, commands);
+			target.display();
+		}
+	}
+
+	/**
+	 * @brief Lo mismo en lotes: un draw call para todas las figuras sin textura.
+	 */
+	void
+	ShapeSubmit_Batched(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		scene.record(commands);
+		sf::RenderTexture target;
+		target.create(800, 600);
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			target.clear();
+			batcher.submit(target, commands);
+			target.display();
+		}
+	}
+
+	/**
+	 * @brief Decorado quieto dibujado como figuras normales: se graba y triangula cada frame.
+	 */
+	void
+	StaticScene_RecordEveryFrame(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		sf::RenderTexture target;
+		target.create(800, 600);
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			target.clear();
+			scene.record(commands);
+			batcher.submit(target, commands);
+			target.display();
+		}
+	}
+
+	/**
+	 * @brief El mismo decorado con `setStatic`: cada frame solo se revisa y se dibuja el bfer ya subido.
+	 */
+	void
+	StaticScene_VertexBufferCache(Benchmark::State& state) {
+		ShapeScene scene;
+		for (EngineUtilities::TIntrusivePtr<ShapeFactory>& shape : scene.shapes) {
+			shape->setStatic(true);
+		}
+		RenderCommandBuffer commands;
+		sf::RenderTexture target;
+		target.create(800, 600);
+		StaticGeometryCache& cache = EngineUtilities::TService<StaticGeometryCache>::instance();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			target.clear();
+			scene.record(commands);
+			cache.draw(target);
+			target.display();
+		}
+		Benchmark::doNotOptimize(cache.bakeCount());
+	}
+
+	/**
+	 * @brief Fondo que no cambia, dibujado de nuevo cada frame.
+	 */
+	void
+	BackgroundLayer_RedrawEveryFrame(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		sf::RenderTexture target;
+		target.create(800, 600);
+		ShapeBatcher batcher;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			target.clear();
+			scene.record(commands);
+			batcher.submit(target, commands);
+			target.display();
+		}
+	}
+
+	/**
+	 * @brief El mismo fondo en una capa de `LayerCache`: se dibuja una vez y cada frame solo se
+	 *        pega su textura.
+	 */
+	void
+	BackgroundLayer_Cached(Benchmark::State& state) {
+		ShapeScene scene;
+		RenderCommandBuffer commands;
+		sf::RenderTexture target;
+		target.create(800, 600);
+		ShapeBatcher batcher;
+		LayerCache layers;
+		layers.setCached(0, true);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			target.clear();
+			scene.record(commands);
+			layers.submit(target, commands, batcher);
+			target.display();
+		}
+		Benchmark::doNotOptimize(layers.redrawCount());
+	}
+
+	constexpr size_t kCullActors = 20000;                          ///< Actores del mundo.
+	const sf::FloatRect kCullWorld(0.0f, 0.0f, 8000.0f, 6000.0f);  ///< Mundo diez veces ms ancho y alto que la vista.
+	const sf::FloatRect kCullView(3600.0f, 2700.0f, 800.0f, 600.0f);
+
+	/**
+	 * @brief Actores repartidos por `kCullWorld`; uno de cada cien cae en la vista.
+	 */
+	struct CullScene {
+		std::vector<EngineUtilities::TSharedPointer<Actor>> actors;
+		SpatialGrid grid;
+
+		CullScene() {
+			actors.reserve(kCullActors);
+			for (size_t n = 0; n < kCullActors; ++n) {
+				EngineUtilities::TSharedPointer<Actor> actor = EngineUtilities::MakeShared<Actor>("Circle");
+				sf::FloatRect local = actor->findComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE)->getLocalBounds();
+				sf::Vector2f position(static_cast<float>((n * 7919) % 8000), static_cast<float>((n * 104729) % 6000));
+				actor->findComponent<Transform>()->setPosition(position);
+				grid.insert(*actor);
+				grid.updateBounds(*actor->getComponent<SpatialItem>(), sf::FloatRect(position + local.getPosition(), local.getSize()));
+				actors.push_back(std::move(actor));
+			}
+		}
+	};
+
+	/**
+	 * @brief Cada actor graba sus comandos, dentro o fuera de la vista.
+	 */
+	void
+	Cull_RecordAll(Benchmark::State& state) {
+		CullScene scene;
+		RenderCommandBuffer commands;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			commands.clear();
+			for (EngineUtilities::TSharedPointer<Actor>& actor : scene.actors) {
+				actor->render(commands);
+			}
+			Benchmark::doNotOptimize(commands.size());
+		}
+	}
+
+	/**
+	 * @brief Solo los que devuelve el `SpatialGrid` para la vista.
+	 */
+	void
+	Cull_RecordGridQuery(Benchmark::State& state) {
+		CullScene scene;
+		RenderCommandBuffer commands;
+		std::vector<Entity*> visible;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			commands.clear();
+			visible.clear();
+			scene.grid.query(kCullView, visible);
+			for (Entity* entity : visible) {
+				entity->render(commands);
+			}
+			Benchmark::doNotOptimize(commands.size());
+		}
+	}
+
+	/**
+	 * @brief La cmara se mueve cada frame: vista y vista-proyeccin se recalculan.
+	 */
+	void
+	Camera_MovingEveryFrame(Benchmark::State& state) {
+		Camera camera;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			camera.setPosition(sf::Vector3f(400.0f + static_cast<float>(i & 63), 300.0f, 520.0f));
+			Benchmark::doNotOptimize(camera.getUniforms());
+		}
+	}
+
+	/**
+	 * @brief Cmara quieta: las matrices salen de la cach.
+	 */
+	void
+	Camera_Still(Benchmark::State& state) {
+		Camera camera;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			Benchmark::doNotOptimize(camera.getUniforms());
+		}
+	}
+
+	/**
+	 * @brief Llena el sistema del servicio, que es donde lanzan los emisores.
+	 */
+	void
+	fillParticles(ParticleSystem& system, ParticleEmitter& emitter) {
+		system.clear();
+		system.setCapacity(kParticles);
+		emitter.setDirection(0.0f, 360.0f);
+		emitter.setLifetime(1.0f, 2.0f);
+		emitter.burst(kParticles);
+	}
+
+	/**
+	 * @brief Un paso de 100k partculas: integracin SIMD, bajas y reposicin.
+	 */
+	void
+	Particles_Update_100k(Benchmark::State& state) {
+		ParticleSystem& system = EngineUtilities::TService<ParticleSystem>::instance();
+		system.setGravity(sf::Vector2f(0.0f, 98.0f));
+		ParticleEmitter emitter;
+		fillParticles(system, emitter);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			system.update(1.0f / 60.0f);
+			emitter.burst(static_cast<uint32_t>(kParticles - system.size()));
+			Benchmark::doNotOptimize(system.size());
+		}
+	}
+
+	/**
+	 * @brief Los quads de 100k partculas, en un solo comando.
+	 */
+	void
+	Particles_Render_100k(Benchmark::State& state) {
+		ParticleSystem& system = EngineUtilities::TService<ParticleSystem>::instance();
+		ParticleEmitter emitter;
+		fillParticles(system, emitter);
+		RenderCommandBuffer commands;
+		sf::FloatRect visible(-400.0f, -300.0f, 800.0f, 600.0f);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			commands.clear();
+			system.render(commands, visible);
+			Benchmark::doNotOptimize(commands.size());
+		}
+	}
+
+	/**
+	 * @brief Mapa de `kMapTiles` x `kMapTiles` de un atlas de 16 x 16 baldosas, ya armado.
+	 */
+	struct TilemapScene {
+		sf::Texture tileset;
+		Tilemap map;
+		RenderCommandBuffer commands;
+
+		TilemapScene() {
+			tileset.create(256, 256);
+			map.resize(kMapTiles, kMapTiles);
+			map.setTileset(&tileset, 16);
+			for (uint32_t y = 0; y < kMapTiles; ++y) {
+				for (uint32_t x = 0; x < kMapTiles; ++x) {
+					map.setTile(x, y, static_cast<Tilemap::TileId>((x * 7 + y * 3) % 256));
+				}
+			}
+			commands.setVisibleArea(sf::FloatRect(0.0f, 0.0f, 800.0f, 600.0f));
+			map.render(commands);
+		}
+	};
+
+	/**
+	 * @brief Un frame de un milln de baldosas: solo los trozos que toca la vista, ya armados.
+	 */
+	void
+	Tilemap_RecordVisible(Benchmark::State& state) {
+		TilemapScene scene;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			scene.commands.clear();
+			scene.map.render(scene.commands);
+			Benchmark::doNotOptimize(scene.commands.size());
+		}
+	}
+
+	/**
+	 * @brief Lo mismo cambiando una baldosa por frame: se vuelve a armar un trozo.
+	 */
+	void
+	Tilemap_RecordOneEdit(Benchmark::State& state) {
+		TilemapScene scene;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			scene.map.setTile(static_cast<uint32_t>(i % 40), 5, static_cast<Tilemap::TileId>(i % 256));
+			scene.commands.clear();
+			scene.map.render(scene.commands);
+			Benchmark::doNotOptimize(scene.commands.size());
+		}
+	}
+
+	/**
+	 * @brief Repartir 500 luces pequeas por la escena en las celdas de una cmara en
+	 *        perspectiva: lo que se paga en CPU cada frame.
+	 */
+	void
+	LightClusters_Build_500(Benchmark::State& state) {
+		Camera camera;
+		camera.setPerspective(60.0f, 1.0f, 2000.0f);
+		camera.setAspect(16.0f / 9.0f);
+		camera.focus(sf::Vector2f(400.0f, 300.0f), 600.0f);
+		std::vector<PointLightData> lights(kLights);
+		for (size_t i = 0; i < kLights; ++i) {
+			lights[i].position[0] = static_cast<float>((i * 37) % 800);
+			lights[i].position[1] = static_cast<float>((i * 91) % 600);
+			lights[i].position[2] = 10.0f;
+			lights[i].position[3] = 40.0f;
+		}
+		CameraUniforms uniforms = camera.getUniforms();
+		LightClusters clusters;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			clusters.build(uniforms, lights);
+			Benchmark::doNotOptimize(clusters.lightIndices().size());
+		}
+	}
+}
+
+BENCHMARK(RenderCommands_RecordAndSort);
+BENCHMARK(RenderCommands_RecordAndSort_MixedStates);
+BENCHMARK(ShapeBatch_Tessellate_SharedOutline);
+BENCHMARK(ShapeBatch_Tessellate_GetPoint);
+BENCHMARK(ShapeBatch_Tessellate_FarLod);
+BENCHMARK(ShapeBatch_Tessellate_FarFull);
+BENCHMARK(ShapeSubmit_PerShape);
+BENCHMARK(ShapeSubmit_Batched);
+BENCHMARK(StaticScene_RecordEveryFrame);
+BENCHMARK(StaticScene_VertexBufferCache);
+BENCHMARK(BackgroundLayer_RedrawEveryFrame);
+BENCHMARK(BackgroundLayer_Cached);
+BENCHMARK(Cull_RecordAll);
+BENCHMARK(Cull_RecordGridQuery);
+BENCHMARK(Camera_MovingEveryFrame);
+BENCHMARK(Camera_Still);
+BENCHMARK(Particles_Update_100k);
+BENCHMARK(Particles_Render_100k);
+BENCHMARK(Tilemap_RecordVisible);
+BENCHMARK(Tilemap_RecordOneEdit);
+BENCHMARK(LightClusters_Build_500);
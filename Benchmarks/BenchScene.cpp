@@ -0,0 +1,217 @@
+#include "Benchmark.h"
+#include "Scene/SceneFile.h"
+#include "Scene/SceneWriter.h"
+#include "Render/MeshLoader.h"
+#include "Render/MeshOptimizer.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+	constexpr size_t kSceneActors = 100 * 1000; ///< Actores de un nivel grande.
+
+	struct Velocity {
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	/**
+	 * @brief Ruta temporal para los archivos de los benchmarks.
+	 */
+	std::string
+	scenePath(const char* file) {
+		return (std::filesystem::temp_directory_path() / file).string();
+	}
+
+	/**
+	 * @brief Escribe un nivel de `kSceneActors` actores con una velocidad cada uno.
+	 */
+	void
+	writeBinaryScene(const std::string& path) {
+		SceneWriter writer;
+		std::vector<uint32_t> owners;
+		std::vector<Velocity> velocities;
+		for (size_t n = 0; n < kSceneActors; ++n) {
+			SceneActorRecord record;
+			record.positionX = float(n % 1000);
+			record.positionY = float(n / 1000);
+			record.flags = kSceneActorActive;
+			owners.push_back(writer.addActor("Enemy", record));
+			velocities.push_back({ 0.0f, 40.0f });
+		}
+		writer.addComponents<Velocity>("Velocity", owners, velocities);
+		writer.write(path);
+	}
+
+	/**
+	 * @brief El mismo nivel como texto, una lnea por actor.
+	 */
+	void
+	writeTextScene(const std::string& path) {
+		std::ofstream file(path);
+		for (size_t n = 0; n < kSceneActors; ++n) {
+			file << "Enemy " << n % 1000 << ' ' << n / 1000 << " 0 1 1 4294967295 0 40\n";
+		}
+	}
+
+	/**
+	 * @brief Abrir el `.gscn` mapeado, validarlo y leer cada actor y su velocidad en su lugar.
+	 */
+	void
+	Scene_Load_MappedBinary(Benchmark::State& state) {
+		std::string path = scenePath("bench_scene.gscn");
+		writeBinaryScene(path);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			SceneFile scene;
+			scene.open(path);
+			float sum = 0.0f;
+			for (const SceneActorRecord& record : scene.actors()) {
+				sum += record.positionX + record.positionY;
+			}
+			for (const Velocity& velocity : scene.components<Velocity>("Velocity").values) {
+				sum += velocity.y;
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+		std::filesystem::remove(path);
+	}
+
+	/**
+	 * @brief Referencia: el mismo nivel parseado desde texto.
+	 */
+	void
+	Scene_Load_ParsedText(Benchmark::State& state) {
+		std::string path = scenePath("bench_scene.txt");
+		writeTextScene(path);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			std::ifstream file(path);
+			std::string name;
+			float x, y, rotation, scaleX, scaleY, velocityX, velocityY;
+			uint32_t color;
+			float sum = 0.0f;
+			while (file >> name >> x >> y >> rotation >> scaleX >> scaleY >> color >> velocityX >> velocityY) {
+				sum += x + y + velocityY;
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+		std::filesystem::remove(path);
+	}
+
+	constexpr int kObjGridSide = 256; ///< Malla de 256x256 vrtices y ~130 mil tringulos.
+
+	/**
+	 * @brief Texto `.obj` de una cuadrcula con normales, como exportan las herramientas.
+	 */
+	const std::string&
+	gridObj() {
+		static const std::string s_text = [] {
+			std::ostringstream out;
+			for (int y = 0; y < kObjGridSide; ++y) {
+				for (int x = 0; x < kObjGridSide; ++x) {
+					out << "v " << x * 0.5f << ' ' << y * 0.5f << ' ' << ((x * 7 + y * 3) % 11) * 0.1f << '\n';
+				}
+			}
+			out << "vn 0 0 1\n";
+			for (int y = 0; y + 1 < kObjGridSide; ++y) {
+				for (int x = 0; x + 1 < kObjGridSide; ++x) {
+					int corner = y * kObjGridSide + x + 1;
+					out << "f " << corner << "//1 " << corner + 1 << "//1 " << corner + kObjGridSide + 1 << "//1 "
+					    << corner + kObjGridSide << "//1\n";
+				}
+			}
+			return out.str();
+		}();
+		return s_text;
+	}
+
+	/**
+	 * @brief El cursor de `MeshLoader::parseObj` sobre el texto en memoria.
+	 */
+	void
+	Mesh_ParseObj_Cursor(Benchmark::State& state) {
+		const std::string& text = gridObj();
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			MeshLoader::parseObj(text.data(), text.size(), vertices, indices);
+			Benchmark::doNotOptimize(indices.size());
+		}
+	}
+
+	/**
+	 * @brief La misma cuadrcula ya optimizada y cuantizada en `.gmsh`, leda de memoria.
+	 */
+	void
+	Mesh_ParseGmsh_Quantized(Benchmark::State& state) {
+		const std::string& text = gridObj();
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		MeshLoader::parseObj(text.data(), text.size(), vertices, indices);
+		MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+		MeshOptimizer::optimizeVertexFetch(vertices, indices);
+		std::vector<unsigned char> bytes = MeshOptimizer::encode(vertices, indices);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			MeshLoader::parseMesh(bytes.data(), bytes.size(), vertices, indices);
+			Benchmark::doNotOptimize(indices.size());
+		}
+	}
+
+	/**
+	 * @brief Costo del paso de importacin: Forsyth sobre los ~130 mil tringulos.
+	 */
+	void
+	Mesh_OptimizeVertexCache(Benchmark::State& state) {
+		const std::string& text = gridObj();
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> original;
+		MeshLoader::parseObj(text.data(), text.size(), vertices, original);
+		std::vector<uint32_t> indices;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			indices = original;
+			MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+			Benchmark::doNotOptimize(indices.data());
+		}
+	}
+
+	/**
+	 * @brief Lo mismo con `std::istringstream`, un `std::string` por lnea y por token.
+	 */
+	void
+	Mesh_ParseObj_Stream(Benchmark::State& state) {
+		const std::string& text = gridObj();
+		std::vector<float> positions;
+		std::vector<uint32_t> indices;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			positions.clear();
+			indices.clear();
+			std::istringstream in(text);
+			std::string line;
+			while (std::getline(in, line)) {
+				std::istringstream tokens(line);
+				std::string kind;
+				tokens >> kind;
+				if (kind == "v") {
+					float x, y, z;
+					tokens >> x >> y >> z;
+					positions.insert(positions.end(), { x, y, z });
+				}
+				else if (kind == "f") {
+					std::string corner;
+					while (tokens >> corner) {
+						indices.push_back(static_cast<uint32_t>(std::stoul(corner.substr(0, corner.find('/')))) - 1);
+					}
+				}
+			}
+			Benchmark::doNotOptimize(indices.size());
+		}
+	}
+}
+
+BENCHMARK(Scene_Load_MappedBinary);
+BENCHMARK(Scene_Load_ParsedText);
+BENCHMARK(Mesh_ParseObj_Cursor);
+BENCHMARK(Mesh_ParseObj_Stream);
+BENCHMARK(Mesh_ParseGmsh_Quantized);
+BENCHMARK(Mesh_OptimizeVertexCache);
@@ -0,0 +1,205 @@
+#include "Benchmark.h"
+#include "Memory/TSharedPointer.h"
+#include "Memory/TWeakPointer.h"
+#include "Memory/TIntrusivePtr.h"
+#include <thread>
+
+using namespace EngineUtilities;
+
+namespace {
+
+	struct Payload {
+		int value = 0;
+	};
+
+	struct IntrusivePayload : public TRefCounted<> {
+		int value = 0;
+	};
+
+	constexpr unsigned kContendedThreads = 4; ///< Hilos que comparten el mismo contador.
+	constexpr size_t kHandleCount = 4096;     ///< Handles recorridos en los benchmarks de iteracin.
+
+	/**
+	 * @brief Copia y destruye un TSharedPointer; el costo es un incremento y un decremento.
+	 */
+	template<typename Policy>
+	void
+	copyDestroy(Benchmark::State& state) {
+		TSharedPointer<Payload, Policy> source = MakeSharedWithPolicy<Payload, Policy>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TSharedPointer<Payload, Policy> copy(source);
+			Benchmark::doNotOptimize(copy);
+		}
+	}
+
+	/**
+	 * @brief Igual que `copyDestroy`, pero varios hilos golpean el mismo contador atmico.
+	 *
+	 * El tiempo reportado es por operacin de un hilo, as que incluye el rebote de la
+	 * lnea de cach del contador entre ncleos.
+	 */
+	void
+	copyDestroyContended(Benchmark::State& state) {
+		TAtomicSharedPointer<Payload> source = MakeAtomicShared<Payload>();
+		uint64_t perThread = state.iterations();
+
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < kContendedThreads; ++t) {
+			workers.emplace_back([&source, perThread]() {
+				for (uint64_t i = 0; i < perThread; ++i) {
+					TAtomicSharedPointer<Payload> copy(source);
+					Benchmark::doNotOptimize(copy);
+				}
+			});
+		}
+		for (uint64_t i = 0; i < perThread; ++i) {
+			TAtomicSharedPointer<Payload> copy(source);
+			Benchmark::doNotOptimize(copy);
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	/**
+	 * @brief `MakeShared`: objeto y bloque de control en una sola reserva.
+	 */
+	void
+	SharedPointer_Create_MakeShared(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TSharedPointer<Payload> created = MakeShared<Payload>();
+			Benchmark::doNotOptimize(created);
+		}
+	}
+
+	/**
+	 * @brief `TSharedPointer(new T)`: una reserva para el objeto y otra para el bloque.
+	 */
+	void
+	SharedPointer_Create_FromRawPointer(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TSharedPointer<Payload> created(new Payload());
+			Benchmark::doNotOptimize(created);
+		}
+	}
+
+	/**
+	 * @brief Altas y bajas intercaladas de punteros, como componentes que se crean y destruyen.
+	 *
+	 * Se libera la mitad de los punteros en orden disperso y se vuelven a crear: con el
+	 * `ControlBlockPool` los bloques se reciclan desde la cach del hilo sin ir al heap.
+	 */
+	void
+	SharedPointer_Churn_FromRawPointer(Benchmark::State& state) {
+		constexpr size_t kLive = 4096;
+		std::vector<TSharedPointer<Payload>> live;
+		for (size_t n = 0; n < kLive; ++n) {
+			live.emplace_back(new Payload());
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			for (size_t n = (i & 1); n < kLive; n += 2) {
+				live[(n * 7919) % kLive] = TSharedPointer<Payload>(new Payload());
+			}
+			Benchmark::doNotOptimize(live.data());
+		}
+	}
+
+	/**
+	 * @brief `TWeakPointer::lock()` sobre un objeto vivo: un incremento condicional.
+	 */
+	template<typename Policy>
+	void
+	weakLock(Benchmark::State& state) {
+		TSharedPointer<Payload, Policy> owner = MakeSharedWithPolicy<Payload, Policy>();
+		TWeakPointer<Payload, Policy> observer(owner);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TSharedPointer<Payload, Policy> locked = observer.lock();
+			Benchmark::doNotOptimize(locked);
+		}
+	}
+
+	void
+	WeakPointer_Lock_SingleThreadPolicy(Benchmark::State& state) {
+		weakLock<SingleThreadRefCount>(state);
+	}
+
+	void
+	WeakPointer_Lock_AtomicPolicy(Benchmark::State& state) {
+		weakLock<AtomicRefCount>(state);
+	}
+
+	/**
+	 * @brief Recorre un arreglo de `TSharedPointer` (dos punteros por handle).
+	 */
+	void
+	SharedPointer_IterateHandles(Benchmark::State& state) {
+		std::vector<TSharedPointer<Payload>> handles;
+		for (size_t n = 0; n < kHandleCount; ++n) {
+			handles.push_back(MakeShared<Payload>());
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			int sum = 0;
+			for (const TSharedPointer<Payload>& handle : handles) {
+				sum += handle->value;
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Recorre un arreglo de `TIntrusivePtr` (un puntero por handle).
+	 */
+	void
+	IntrusivePtr_IterateHandles(Benchmark::State& state) {
+		std::vector<TIntrusivePtr<IntrusivePayload>> handles;
+		for (size_t n = 0; n < kHandleCount; ++n) {
+			handles.push_back(MakeIntrusive<IntrusivePayload>());
+		}
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			int sum = 0;
+			for (const TIntrusivePtr<IntrusivePayload>& handle : handles) {
+				sum += handle->value;
+			}
+			Benchmark::doNotOptimize(sum);
+		}
+	}
+
+	/**
+	 * @brief Copia y destruye un `TIntrusivePtr`; el contador est dentro del objeto.
+	 */
+	void
+	IntrusivePtr_CopyDestroy(Benchmark::State& state) {
+		TIntrusivePtr<IntrusivePayload> source = MakeIntrusive<IntrusivePayload>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TIntrusivePtr<IntrusivePayload> copy(source);
+			Benchmark::doNotOptimize(copy);
+		}
+	}
+
+	void
+	SharedPointer_CopyDestroy_SingleThreadPolicy(Benchmark::State& state) {
+		copyDestroy<SingleThreadRefCount>(state);
+	}
+
+	void
+	SharedPointer_CopyDestroy_AtomicPolicy(Benchmark::State& state) {
+		copyDestroy<AtomicRefCount>(state);
+	}
+
+	void
+	SharedPointer_CopyDestroy_AtomicPolicy_Contended(Benchmark::State& state) {
+		copyDestroyContended(state);
+	}
+}
+
+BENCHMARK(SharedPointer_Create_MakeShared);
+BENCHMARK(SharedPointer_Create_FromRawPointer);
+BENCHMARK(SharedPointer_Churn_FromRawPointer);
+BENCHMARK(SharedPointer_CopyDestroy_SingleThreadPolicy);
+BENCHMARK(SharedPointer_CopyDestroy_AtomicPolicy);
+BENCHMARK(SharedPointer_CopyDestroy_AtomicPolicy_Contended);
+BENCHMARK(WeakPointer_Lock_SingleThreadPolicy);
+BENCHMARK(WeakPointer_Lock_AtomicPolicy);
+BENCHMARK(SharedPointer_IterateHandles);
+BENCHMARK(IntrusivePtr_IterateHandles);
+BENCHMARK(IntrusivePtr_CopyDestroy);
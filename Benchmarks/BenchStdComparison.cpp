@@ -0,0 +1,289 @@
+#include "Benchmark.h"
+#include "Memory/TSharedPointer.h"
+#include "Memory/TWeakPointer.h"
+#include "Memory/TUniquePtr.h"
+#include <memory>
+#include <thread>
+
+using namespace EngineUtilities;
+
+/**
+ * @brief Comparacin de los punteros de `EngineUtilities` contra sus equivalentes de la STL.
+ *
+ * Cada operacin se mide tres veces con el mismo cuerpo:
+ * - `Engine`: `TSharedPointer` con la poltica por defecto (un solo hilo).
+ * - `EngineAtomic`: `TSharedPointer` con `AtomicRefCount`, la comparacin justa contra la STL.
+ * - `Std`: `std::shared_ptr` / `std::weak_ptr` / `std::unique_ptr`.
+ *
+ * Los nombres siguen `VsStd_<Operacin>_<Variante>` para poder filtrarlos juntos y
+ * compararlos en la salida JSON (`--json=archivo`).
+ *
+ * Ojo con libstdc++: mientras el proceso no haya creado hilos usa incrementos no atmicos,
+ * as que `Std` se parece a `Engine` hasta que corre el primer benchmark con hilos. Para
+ * comparar con `EngineAtomic` conviene filtrar `VsStd_CopyDestroyContended` primero o
+ * ejecutar por separado. MSVC siempre usa operaciones atmicas.
+ */
+namespace {
+
+	struct Base {
+		virtual ~Base() = default;
+		int value = 0;
+	};
+
+	struct Derived : public Base {
+		int extra = 0;
+	};
+
+	constexpr unsigned kContendedThreads = 4; ///< Hilos que comparten el mismo contador.
+
+	/**
+	 * @brief Punteros del motor con la poltica indicada.
+	 */
+	template<typename Policy>
+	struct EngineFlavor {
+		template<typename T>
+		using Shared = TSharedPointer<T, Policy>;
+
+		template<typename T>
+		using Weak = TWeakPointer<T, Policy>;
+
+		template<typename T>
+		static Shared<T> make() { return MakeSharedWithPolicy<T, Policy>(); }
+
+		template<typename T>
+		static Shared<T> fromRaw(T* raw) { return Shared<T>(raw); }
+
+		template<typename U, typename T>
+		static Shared<U> dynamicCast(const Shared<T>& ptr) { return ptr.template dynamic_pointer_cast<U>(); }
+
+		template<typename U, typename T>
+		static Shared<U> staticCast(const Shared<T>& ptr) { return ptr.template static_pointer_cast<U>(); }
+	};
+
+	/**
+	 * @brief Punteros de la STL con la misma interfaz que `EngineFlavor`.
+	 */
+	struct StdFlavor {
+		template<typename T>
+		using Shared = std::shared_ptr<T>;
+
+		template<typename T>
+		using Weak = std::weak_ptr<T>;
+
+		template<typename T>
+		static Shared<T> make() { return std::make_shared<T>(); }
+
+		template<typename T>
+		static Shared<T> fromRaw(T* raw) { return Shared<T>(raw); }
+
+		template<typename U, typename T>
+		static Shared<U> dynamicCast(const Shared<T>& ptr) { return std::dynamic_pointer_cast<U>(ptr); }
+
+		template<typename U, typename T>
+		static Shared<U> staticCast(const Shared<T>& ptr) { return std::static_pointer_cast<U>(ptr); }
+	};
+
+	using Engine = EngineFlavor<SingleThreadRefCount>;
+	using EngineAtomic = EngineFlavor<AtomicRefCount>;
+
+	template<typename F>
+	void
+	makeShared(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			typename F::template Shared<Derived> created = F::template make<Derived>();
+			Benchmark::doNotOptimize(created);
+		}
+	}
+
+	template<typename F>
+	void
+	fromRawPointer(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			typename F::template Shared<Derived> created = F::fromRaw(new Derived());
+			Benchmark::doNotOptimize(created);
+		}
+	}
+
+	template<typename F>
+	void
+	copyDestroy(Benchmark::State& state) {
+		typename F::template Shared<Derived> source = F::template make<Derived>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			typename F::template Shared<Derived> copy(source);
+			Benchmark::doNotOptimize(copy);
+		}
+	}
+
+	/**
+	 * @brief Mueve un puntero de ida y vuelta; no debera tocar el contador.
+	 */
+	template<typename F>
+	void
+	move(Benchmark::State& state) {
+		typename F::template Shared<Derived> a = F::template make<Derived>();
+		typename F::template Shared<Derived> b;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			b = std::move(a);
+			a = std::move(b);
+			Benchmark::doNotOptimize(a);
+		}
+	}
+
+	template<typename F>
+	void
+	weakLock(Benchmark::State& state) {
+		typename F::template Shared<Derived> owner = F::template make<Derived>();
+		typename F::template Weak<Derived> observer(owner);
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			typename F::template Shared<Derived> locked = observer.lock();
+			Benchmark::doNotOptimize(locked);
+		}
+	}
+
+	template<typename F>
+	void
+	dynamicCast(Benchmark::State& state) {
+		typename F::template Shared<Base> base = F::template make<Derived>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			typename F::template Shared<Derived> derived = F::template dynamicCast<Derived>(base);
+			Benchmark::doNotOptimize(derived);
+		}
+	}
+
+	template<typename F>
+	void
+	staticCast(Benchmark::State& state) {
+		typename F::template Shared<Base> base = F::template make<Derived>();
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			typename F::template Shared<Derived> derived = F::template staticCast<Derived>(base);
+			Benchmark::doNotOptimize(derived);
+		}
+	}
+
+	/**
+	 * @brief Varios hilos copian y destruyen el mismo puntero; mide el rebote del contador.
+	 */
+	template<typename F>
+	void
+	copyDestroyContended(Benchmark::State& state) {
+		typename F::template Shared<Derived> source = F::template make<Derived>();
+		uint64_t perThread = state.iterations();
+		auto work = [&source, perThread]() {
+			for (uint64_t i = 0; i < perThread; ++i) {
+				typename F::template Shared<Derived> copy(source);
+				Benchmark::doNotOptimize(copy);
+			}
+		};
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < kContendedThreads; ++t) {
+			workers.emplace_back(work);
+		}
+		work();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	void VsStd_MakeShared_Engine(Benchmark::State& state) { makeShared<Engine>(state); }
+	void VsStd_MakeShared_EngineAtomic(Benchmark::State& state) { makeShared<EngineAtomic>(state); }
+	void VsStd_MakeShared_Std(Benchmark::State& state) { makeShared<StdFlavor>(state); }
+
+	void VsStd_FromRawPointer_Engine(Benchmark::State& state) { fromRawPointer<Engine>(state); }
+	void VsStd_FromRawPointer_EngineAtomic(Benchmark::State& state) { fromRawPointer<EngineAtomic>(state); }
+	void VsStd_FromRawPointer_Std(Benchmark::State& state) { fromRawPointer<StdFlavor>(state); }
+
+	void VsStd_CopyDestroy_Engine(Benchmark::State& state) { copyDestroy<Engine>(state); }
+	void VsStd_CopyDestroy_EngineAtomic(Benchmark::State& state) { copyDestroy<EngineAtomic>(state); }
+	void VsStd_CopyDestroy_Std(Benchmark::State& state) { copyDestroy<StdFlavor>(state); }
+
+	void VsStd_Move_Engine(Benchmark::State& state) { move<Engine>(state); }
+	void VsStd_Move_EngineAtomic(Benchmark::State& state) { move<EngineAtomic>(state); }
+	void VsStd_Move_Std(Benchmark::State& state) { move<StdFlavor>(state); }
+
+	void VsStd_WeakLock_Engine(Benchmark::State& state) { weakLock<Engine>(state); }
+	void VsStd_WeakLock_EngineAtomic(Benchmark::State& state) { weakLock<EngineAtomic>(state); }
+	void VsStd_WeakLock_Std(Benchmark::State& state) { weakLock<StdFlavor>(state); }
+
+	void VsStd_DynamicCast_Engine(Benchmark::State& state) { dynamicCast<Engine>(state); }
+	void VsStd_DynamicCast_EngineAtomic(Benchmark::State& state) { dynamicCast<EngineAtomic>(state); }
+	void VsStd_DynamicCast_Std(Benchmark::State& state) { dynamicCast<StdFlavor>(state); }
+
+	void VsStd_StaticCast_Engine(Benchmark::State& state) { staticCast<Engine>(state); }
+	void VsStd_StaticCast_EngineAtomic(Benchmark::State& state) { staticCast<EngineAtomic>(state); }
+	void VsStd_StaticCast_Std(Benchmark::State& state) { staticCast<StdFlavor>(state); }
+
+	void VsStd_CopyDestroyContended_EngineAtomic(Benchmark::State& state) { copyDestroyContended<EngineAtomic>(state); }
+	void VsStd_CopyDestroyContended_Std(Benchmark::State& state) { copyDestroyContended<StdFlavor>(state); }
+
+	/**
+	 * @brief `MakeUnique` + destruccin frente a `std::make_unique`.
+	 */
+	void
+	VsStd_UniqueCreate_Engine(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			TUniquePtr<Derived> created = MakeUnique<Derived>();
+			Benchmark::doNotOptimize(created);
+		}
+	}
+
+	void
+	VsStd_UniqueCreate_Std(Benchmark::State& state) {
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			std::unique_ptr<Derived> created = std::make_unique<Derived>();
+			Benchmark::doNotOptimize(created);
+		}
+	}
+
+	/**
+	 * @brief Movimiento de ida y vuelta de un puntero nico, incluida la conversin a la base.
+	 */
+	void
+	VsStd_UniqueMove_Engine(Benchmark::State& state) {
+		TUniquePtr<Base> a = MakeUnique<Derived>();
+		TUniquePtr<Base> b;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			b = std::move(a);
+			a = std::move(b);
+			Benchmark::doNotOptimize(a);
+		}
+	}
+
+	void
+	VsStd_UniqueMove_Std(Benchmark::State& state) {
+		std::unique_ptr<Base> a = std::make_unique<Derived>();
+		std::unique_ptr<Base> b;
+		for (uint64_t i = 0; i < state.iterations(); ++i) {
+			b = std::move(a);
+			a = std::move(b);
+			Benchmark::doNotOptimize(a);
+		}
+	}
+}
+
+BENCHMARK(VsStd_MakeShared_Engine);
+BENCHMARK(VsStd_MakeShared_EngineAtomic);
+BENCHMARK(VsStd_MakeShared_Std);
+BENCHMARK(VsStd_FromRawPointer_Engine);
+BENCHMARK(VsStd_FromRawPointer_EngineAtomic);
+BENCHMARK(VsStd_FromRawPointer_Std);
+BENCHMARK(VsStd_CopyDestroy_Engine);
+BENCHMARK(VsStd_CopyDestroy_EngineAtomic);
+BENCHMARK(VsStd_CopyDestroy_Std);
+BENCHMARK(VsStd_Move_Engine);
+BENCHMARK(VsStd_Move_EngineAtomic);
+BENCHMARK(VsStd_Move_Std);
+BENCHMARK(VsStd_WeakLock_Engine);
+BENCHMARK(VsStd_WeakLock_EngineAtomic);
+BENCHMARK(VsStd_WeakLock_Std);
+BENCHMARK(VsStd_DynamicCast_Engine);
+BENCHMARK(VsStd_DynamicCast_EngineAtomic);
+BENCHMARK(VsStd_DynamicCast_Std);
+BENCHMARK(VsStd_StaticCast_Engine);
+BENCHMARK(VsStd_StaticCast_EngineAtomic);
+BENCHMARK(VsStd_StaticCast_Std);
+BENCHMARK(VsStd_CopyDestroyContended_EngineAtomic);
+BENCHMARK(VsStd_CopyDestroyContended_Std);
+BENCHMARK(VsStd_UniqueCreate_Engine);
+BENCHMARK(VsStd_UniqueCreate_Std);
+BENCHMARK(VsStd_UniqueMove_Engine);
+BENCHMARK(VsStd_UniqueMove_Std);
@@ -0,0 +1,86 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Arns mnimo de microbenchmarks del motor.
+ *
+ * Cada benchmark es una funcin `void(Benchmark::State&)` que repite la operacin medida
+ * `state.iterations()` veces. El ejecutable (`BenchMain.cpp`) calibra el nmero de
+ * iteraciones, toma varias muestras y reporta nanosegundos por operacin.
+ */
+namespace Benchmark {
+
+	/**
+	 * @brief Estado que recibe cada benchmark durante una muestra.
+	 */
+	class
+	State {
+	public:
+		explicit State(uint64_t iterations) : m_iterations(iterations) {}
+
+		/**
+		 * @brief Nmero de veces que el benchmark debe repetir la operacin medida.
+		 */
+		uint64_t
+		iterations() const { return m_iterations; }
+
+	private:
+		uint64_t m_iterations;
+	};
+
+	using BenchmarkFn = void(*)(State&);
+
+	/**
+	 * @brief Entrada del registro global de benchmarks.
+	 */
+	struct Registration {
+		std::string name;
+		BenchmarkFn fn;
+	};
+
+	/**
+	 * @brief Registro global; se llena antes de `main` mediante `BENCHMARK`.
+	 */
+	inline std::vector<Registration>&
+	registry() {
+		static std::vector<Registration> s_registry;
+		return s_registry;
+	}
+
+	/**
+	 * @brief Objeto esttico que aade un benchmark al registro al construirse.
+	 */
+	struct Registrar {
+		Registrar(const char* name, BenchmarkFn fn) {
+			registry().push_back({ name, fn });
+		}
+	};
+
+	/**
+	 * @brief Impide que el compilador elimine un clculo cuyo resultado no se usa.
+	 * @param value Valor que debe considerarse observado.
+	 */
+	template<typename T>
+	inline void
+	doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+		(void)*reinterpret_cast<const volatile char*>(&value);
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/**
+	 * @brief Reloj de alta resolucin usado por el arns.
+	 */
+	using Clock = std::chrono::steady_clock;
+}
+
+#define BENCHMARK(func) static Benchmark::Registrar s_benchRegistrar_##func(#func, func)
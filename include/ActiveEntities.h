@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Entity;
+
+/**
+ * @class ActiveEntities
+ * @brief Lista compacta de las entidades activas, la que recorren update y render.
+ *
+ * `Entity::setActive` agrega o quita la entidad en O(1): cada entidad guarda su ndice en la
+ * lista y al quitarla se mueve la ltima a su lugar. Los niveles con muchos actores dormidos
+ * (pools, zonas lejanas) no cuestan nada por frame. Activar o desactivar anota un cambio
+ * (`noteChange`): cambia lo que se dibuja.
+ *
+ * El orden no se conserva al desactivar. Un solo hilo: activar y desactivar son cambios
+ * estructurales, como crear entidades.
+ *
+ * Si existe el servicio `SpatialGrid`, tambin le registra y quita las entidades, para que el
+ * render pueda pedir solo las que caen en la vista.
+ *
+ * Es un servicio (`TService<ActiveEntities>`).
+ */
+class
+ActiveEntities {
+public:
+	static constexpr uint32_t kNotActive = UINT32_MAX; ///< ndice de una entidad inactiva.
+
+	/**
+	 * @brief Agrega `entity` si no estaba.
+	 */
+	void
+	add(Entity& entity);
+
+	/**
+	 * @brief Quita `entity` si estaba.
+	 */
+	void
+	remove(Entity& entity);
+
+	/**
+	 * @brief Entidades activas, sin orden garantizado.
+	 */
+	std::span<Entity* const>
+	entities() const { return m_entities; }
+
+	size_t
+	size() const { return m_entities.size(); }
+
+private:
+	std::vector<Entity*> m_entities; ///< Densa; cada entidad guarda su posicin.
+};
@@ -1,62 +1,84 @@
 #pragma once
-#include "TSharedPointer.h"
-
-namespace EngineUtilities {
-
-    /**
-     * @brief Clase diseada para observar objetos administrados por `TSharedPointer` sin interferir en la cantidad de referencias.
-     *
-     * `TWeakPointer` permite tener una referencia no intrusiva a un objeto manejado por `TSharedPointer`.
-     * Esto significa que puedes ver el objeto si an existe, pero no evitars que sea destruido cuando
-     * todas las referencias principales hayan sido liberadas. Si el objeto ha sido eliminado, este puntero
-     * dejar de ser vlido.
-     */
-    template<typename T>
-    class TWeakPointer
-    {
-    public:
-        /**
-         * @brief Inicializacin por defecto.
-         *
-         * Crea un `TWeakPointer` que no observa ningn objeto, con punteros nulos a la referencia del objeto y su contador.
-         */
-        TWeakPointer() : ptr(nullptr), refCount(nullptr) {}
-
-        /**
-         * @brief Crea un `TWeakPointer` basado en un `TSharedPointer`.
-         *
-         * Usa un `TSharedPointer` existente para crear un `TWeakPointer`, permitiendo que observes el objeto sin aumentar el recuento de referencias.
-         *
-         * @param sharedPtr El `TSharedPointer` del cual se deriva la observacin.
-         */
-        TWeakPointer(const TSharedPointer<T>& sharedPtr)
-            : ptr(sharedPtr.ptr), refCount(sharedPtr.refCount) {}
-
-        /**
-         * @brief Convierte el `TWeakPointer` en un `TSharedPointer`.
-         *
-         * Este mtodo intenta transformar el `TWeakPointer` en un `TSharedPointer`, pero solo si el objeto original an sigue existiendo.
-         * Si el objeto ha sido destruido, el `TWeakPointer` no puede convertirse en un `TSharedPointer` vlido.
-         *
-         * @return Un `TSharedPointer` vlido si el objeto todava existe, de lo contrario, un `TSharedPointer` nulo.
-         */
-        TSharedPointer<T> lock() const
-        {
-            // Si el contador de referencias es vlido y mayor que cero, el objeto an existe.
-            if (refCount && *refCount > 0)
-            {
-                return TSharedPointer<T>(ptr, refCount);  // Crea un nuevo `TSharedPointer` apuntando al mismo objeto.
-            }
-            return TSharedPointer<T>();  // Retorna un puntero nulo si el objeto ha sido destruido.
-        }
-
-        // Hacer que `TSharedPointer` sea amigo para que tenga acceso a los datos privados.
-        template<typename U>
-        friend class TSharedPointer;
-
-    private:
-        T* ptr;       ///< Referencia al objeto observado, pero no gestionado por este puntero.
-        int* refCount; ///< Puntero al contador de referencias del `TSharedPointer` asociado.
-    };
-
-}
+#include "Prerequisites.h"
+#include "Entity.h"
+#include "NameTable.h"
+#include "ShapeFactory.h"
+
+class RenderCommandBuffer;
+class ActorPool;
+
+/**
+ * @class Actor
+ * @brief Entidad de la escena con nombre propio y un componente de forma.
+ *
+ * Un Actor es la unidad que se coloca en la escena (el crculo que recorre los waypoints,
+ * el tringulo esttico). Al construirse agrega un `ShapeFactory`; el resto de los
+ * componentes se agregan segn se necesiten.
+ */
+class
+Actor : public Entity {
+public:
+	/**
+	 * @brief Constructor por defecto; el actor se llama "Actor".
+	 */
+	Actor();
+
+	/**
+	 * @brief Constructor con el nombre del actor.
+	 * @param actorName Nombre del actor; se interna en `NameTable`, sin copia propia.
+	 */
+	Actor(std::string_view actorName);
+
+	/**
+	 * @brief Destructor virtual.
+	 */
+	virtual
+	~Actor() = default;
+
+	/**
+	 * @brief Actualiza el actor.
+	 * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
+	 */
+	void
+	update(float deltaTime) override;
+
+	/**
+	 * @brief Agrega los dibujos de los componentes del actor.
+	 * @param commands Buffer de comandos del frame.
+	 */
+	void
+	render(RenderCommandBuffer& commands) override;
+
+	/**
+	 * @brief Destruye el actor. Si sali de un `ActorPool`, vuelve a l para reutilizarse.
+	 */
+	void
+	destroy();
+
+	/**
+	 * @brief Obtiene el nombre del actor.
+	 * @return Nombre del actor, guardado en `NameTable`.
+	 */
+	std::string_view
+	getName() const { return NameTable::instance().view(m_name); }
+
+	/**
+	 * @brief Id del nombre: para comparar con otro nombre internado sin leer texto.
+	 */
+	NameId
+	getNameId() const { return m_name; }
+
+	/**
+	 * @brief Un actor llamado `name`, por el ndice de `EntityRegistry`; nulo si no hay.
+	 *        Con varios, cualquiera (`EntityRegistry::allNamed` los da todos).
+	 */
+	static Actor*
+	find(std::string_view name);
+
+private:
+	friend class ActorPool;
+
+	NameId m_name = kNoName;      ///< Nombre del actor, internado.
+	ActorPool* m_pool = nullptr;  ///< Pool de origen, o nulo si se cre con `MakeShared`.
+	size_t m_poolSlot = 0;        ///< ndice dentro de `m_pool`.
+};
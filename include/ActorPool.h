@@ -0,0 +1,141 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Actor.h"
+#include "ShapeFactory.h"
+#include "ECS/World.h"
+
+/**
+ * @brief Pool de actores reutilizables para entidades que nacen y mueren muy seguido.
+ *
+ * Reserva los actores junto con su `Transform` y su `ShapeFactory` en bloques contiguos de
+ * `kActorsPerBlock` y los entrega como `TSharedPointer<Actor>` cuyo eliminador devuelve
+ * el actor al pool en lugar de hacer `delete`. Con figuras alojadas en el propio
+ * componente, crear y destruir un proyectil no toca el heap una vez calentado el pool.
+ *
+ * Ciclo de vida:
+ * - `spawn` saca un actor libre y el pool conserva una referencia mientras siga activo.
+ * - `Actor::destroy` (o `despawn`) suelta esa referencia.
+ * - Cuando se suelta la ltima referencia externa, el actor se reinicia y vuelve a la lista libre.
+ *
+ * Cada `spawn` da al actor un `EntityHandle` nuevo y reciclarlo lo invalida, as que un handle
+ * guardado de un proyectil ya destruido nunca encuentra al que reutiliz el mismo actor.
+ *
+ * El pool debe sobrevivir a todos los punteros que entrega.
+ */
+class
+ActorPool {
+public:
+	static constexpr size_t kActorsPerBlock = 64; ///< Actores por bloque contiguo.
+
+	/**
+	 * @brief Crea el pool con espacio para al menos `initialCapacity` actores.
+	 * @param initialCapacity Actores a preparar por adelantado.
+	 */
+	explicit
+	ActorPool(size_t initialCapacity = kActorsPerBlock);
+
+	/**
+	 * @brief Destruye todos los actores. No deben quedar punteros externos vivos.
+	 */
+	~ActorPool();
+
+	ActorPool(const ActorPool&) = delete;
+	ActorPool&
+	operator=(const ActorPool&) = delete;
+
+	/**
+	 * @brief Activa un actor del pool; crece un bloque si no quedan libres.
+	 * @param name Nombre del actor, ya internado.
+	 * @return Puntero compartido al actor, que ya tiene su `Transform`, su `ShapeFactory` (sin
+	 *         figura) y un `EntityHandle` nuevo.
+	 */
+	EngineUtilities::TSharedPointer<Actor>
+	spawn(NameId name);
+
+	/**
+	 * @brief Igual, internando `name` en `NameTable`.
+	 */
+	EngineUtilities::TSharedPointer<Actor>
+	spawn(std::string_view name) { return spawn(NameTable::instance().intern(name)); }
+
+	EngineUtilities::TSharedPointer<Actor>
+	spawn(const char* name) { return spawn(std::string_view(name)); }
+
+	/**
+	 * @brief Prepara bloques hasta que haya al menos `count` actores libres.
+	 */
+	void
+	reserve(size_t count);
+
+	/**
+	 * @brief Agrega al actor los tipos de datos `types` con una sola mudanza de arquetipo.
+	 *
+	 * Al reciclar el actor se le quitan todos los datos de arquetipo que recibi, por aqu o
+	 * con `Entity::addComponent`. Lo usa `ActorPrefab`.
+	 * @param slots Sale con la memoria sin construir de cada tipo (ver `World::changeComponents`).
+	 */
+	void
+	attachData(Actor& actor, ComponentSignature types, void* slots[kMaxComponentTypes]);
+
+	/**
+	 * @brief Suelta la referencia del pool a un actor activo. Lo llama `Actor::destroy`.
+	 * @param actor Actor entregado por este pool.
+	 */
+	void
+	despawn(Actor& actor);
+
+	/**
+	 * @brief Llama `fn(Actor&)` para cada actor activo.
+	 */
+	template<typename Fn>
+	void
+	forEachActive(Fn&& fn) {
+		for (EngineUtilities::TSharedPointer<Actor>& handle : m_active) {
+			if (!handle.isNull()) {
+				fn(*handle);
+			}
+		}
+	}
+
+	/**
+	 * @brief Actores activos o an referenciados desde fuera.
+	 */
+	size_t
+	inUseCount() const { return capacity() - m_free.size(); }
+
+	/**
+	 * @brief Actores preparados en total.
+	 */
+	size_t
+	capacity() const { return m_blocks.size() * kActorsPerBlock; }
+
+private:
+	/**
+	 * @brief Actor y sus componentes contiguos. Se declaran antes para destruirse despus.
+	 */
+	struct Slot {
+		Transform transform;
+		ShapeFactory shape;
+		Actor actor;
+	};
+
+	/**
+	 * @brief Eliminador de los punteros entregados: devuelve el actor a la lista libre.
+	 */
+	struct Recycler {
+		ActorPool* pool;
+
+		void
+		operator()(Actor* actor) const { pool->recycle(*actor); }
+	};
+
+	void
+	grow();
+
+	void
+	recycle(Actor& actor);
+
+	std::vector<EngineUtilities::TUniquePtr<Slot[]>> m_blocks;   ///< Bloques contiguos de actores.
+	std::vector<Actor*> m_free;                                  ///< Actores disponibles.
+	std::vector<EngineUtilities::TSharedPointer<Actor>> m_active; ///< Referencia del pool, por ndice de slot.
+};
@@ -0,0 +1,159 @@
+#pragma once
+#include "Prerequisites.h"
+#include "ActorPool.h"
+
+/**
+ * @class ActorPrefab
+ * @brief Plantilla de actor: forma, color, transformacin inicial y componentes de datos.
+ *
+ * Se describe una vez y se instancia muchas veces desde un `ActorPool`:
+ *
+ *     ActorPrefab enemy("Enemy", ShapeType::CIRCLE);
+ *     enemy.setFillColor(sf::Color::Red).addComponent(Velocity{ 0.0f, 40.0f });
+ *     enemy.instantiate(pool, 10000, wave, [](size_t i, Actor& actor) { ... });
+ *
+ * `instantiate` reserva en el pool y en `out` todo lo necesario antes de empezar, as que
+ * una oleada no reserva memoria por actor una vez calentado el pool. Los componentes de datos
+ * se copian de los valores de la plantilla, todos con una sola mudanza de arquetipo por actor.
+ * La plantilla no se modifica al instanciar; varias oleadas pueden usar la misma.
+ */
+class
+ActorPrefab {
+public:
+	/**
+	 * @param name Nombre que reciben las instancias.
+	 * @param shapeType Figura de las instancias.
+	 */
+	ActorPrefab(std::string_view name, ShapeType shapeType);
+
+	~ActorPrefab();
+
+	ActorPrefab(const ActorPrefab&) = delete;
+	ActorPrefab& operator=(const ActorPrefab&) = delete;
+
+	ActorPrefab&
+	setFillColor(const sf::Color& color) { m_fillColor = color; return *this; }
+
+	ActorPrefab&
+	setPosition(const sf::Vector2f& position) { m_position = position; return *this; }
+
+	ActorPrefab&
+	setRotation(float degrees) { m_rotation = degrees; return *this; }
+
+	ActorPrefab&
+	setScale(const sf::Vector2f& scale) { m_scale = scale; return *this; }
+
+	/**
+	 * @brief Textura compartida por todas las instancias; debe vivir ms que ellas.
+	 */
+	ActorPrefab&
+	setTexture(const sf::Texture* texture) { m_texture = texture; return *this; }
+
+	/**
+	 * @brief Etiquetas de las instancias (`Entity::setTags`).
+	 */
+	ActorPrefab&
+	setTags(EntityMask tags) { m_tags = tags; return *this; }
+
+	/**
+	 * @brief Capas de las instancias; por defecto `kDefaultLayers`.
+	 */
+	ActorPrefab&
+	setLayers(EntityMask layers) { m_layers = layers; return *this; }
+
+	/**
+	 * @brief Agrega (o reemplaza) un componente de datos que cada instancia recibe copiado.
+	 *
+	 * Solo tipos de arquetipo; los `SparseSet` se agregan a cada actor despus.
+	 */
+	template<typename T>
+	ActorPrefab&
+	addComponent(T value) {
+		static_assert(!std::is_base_of_v<Component, T>, "ActorPrefab copia solo componentes de datos");
+		static_assert(!kIsSparseComponent<T>, "Los tipos SparseSet se agregan a cada actor");
+		ComponentTypeId typeId = ComponentRegistry::idOf<T>();
+		DataComponent data{ typeId, &copyValue<T>, &deleteValue<T>, new T(std::move(value)) };
+		for (DataComponent& existing : m_data) {
+			if (existing.type == typeId) {
+				existing.destroy(existing.value);
+				existing = data;
+				return *this;
+			}
+		}
+		m_data.push_back(data);
+		m_dataTypes |= ComponentSignature(1) << typeId;
+		return *this;
+	}
+
+	/**
+	 * @brief Crea una instancia.
+	 */
+	EngineUtilities::TSharedPointer<Actor>
+	instantiate(ActorPool& pool) const;
+
+	/**
+	 * @brief Crea `count` instancias y las agrega al final de `out`.
+	 */
+	void
+	instantiate(ActorPool& pool, size_t count, std::vector<EngineUtilities::TSharedPointer<Actor>>& out) const {
+		instantiate(pool, count, out, [](size_t, Actor&) {});
+	}
+
+	/**
+	 * @brief Igual, llamando a `place(ndice, Actor&)` despus de configurar cada instancia
+	 *        (para repartir posiciones, por ejemplo).
+	 */
+	template<typename Fn>
+	void
+	instantiate(ActorPool& pool, size_t count, std::vector<EngineUtilities::TSharedPointer<Actor>>& out,
+		Fn&& place) const {
+		pool.reserve(count);
+		out.reserve(out.size() + count);
+		for (size_t index = 0; index < count; ++index) {
+			EngineUtilities::TSharedPointer<Actor> actor = pool.spawn(m_name);
+			configure(pool, *actor);
+			place(index, *actor);
+			out.push_back(std::move(actor));
+		}
+	}
+
+	std::string_view
+	getName() const { return NameTable::instance().view(m_name); }
+
+private:
+	/**
+	 * @brief Valor de un componente de datos y cmo copiarlo sin conocer el tipo.
+	 */
+	struct DataComponent {
+		ComponentTypeId type;
+		void (*copy)(void* slot, const void* value);
+		void (*destroy)(void* value);
+		void* value;
+	};
+
+	template<typename T>
+	static void
+	copyValue(void* slot, const void* value) { ::new (slot) T(*static_cast<const T*>(value)); }
+
+	template<typename T>
+	static void
+	deleteValue(void* value) { delete static_cast<T*>(value); }
+
+	/**
+	 * @brief Deja un actor recin sacado del pool como lo describe la plantilla.
+	 */
+	void
+	configure(ActorPool& pool, Actor& actor) const;
+
+	NameId m_name;                                   ///< Nombre de las instancias, internado una vez.
+	ShapeType m_shapeType;                           ///< Figura de las instancias.
+	sf::Color m_fillColor = sf::Color::White;
+	sf::Vector2f m_position;
+	float m_rotation = 0.0f;
+	sf::Vector2f m_scale{ 1.0f, 1.0f };
+	const sf::Texture* m_texture = nullptr;          ///< Compartida, no se copia.
+	EntityMask m_tags = 0;
+	EntityMask m_layers = kDefaultLayers;
+	std::vector<DataComponent> m_data;               ///< Componentes de datos, uno por tipo.
+	ComponentSignature m_dataTypes = 0;              ///< Tipos de `m_data`.
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Valor que anima una pista. Los huesos de un esqueleto seran ms canales del mismo tipo.
+ */
+enum class AnimationChannel : uint8_t {
+	PositionX,
+	PositionY,
+	Rotation,    ///< Grados.
+	ScaleX,
+	ScaleY,
+	ColorR,      ///< 0 a 255, como `sf::Color`.
+	ColorG,
+	ColorB,
+	ColorA,
+	Count,
+};
+
+constexpr uint32_t kAnimationChannelCount = static_cast<uint32_t>(AnimationChannel::Count);
+
+/**
+ * @brief Llave sin comprimir: el valor del canal a los `time` segundos.
+ */
+struct AnimationKey {
+	float time;
+	float value;
+};
+
+/**
+ * @brief Llaves de un canal, ordenadas por tiempo, tal como salen de la herramienta.
+ */
+struct AnimationCurve {
+	AnimationChannel channel;
+	std::vector<AnimationKey> keys;
+};
+
+/**
+ * @brief Pista comprimida: llaves de 16 bits en tiempo y en valor.
+ *
+ * El tiempo va en 1/65535 de la duracin del clip; el valor en el rango `[minimum,
+ * minimum + 65535 * scale]` de la pista. Solo quedan las llaves que la interpolacin lineal
+ * no reproduce dentro de la tolerancia.
+ */
+struct AnimationTrack {
+	AnimationChannel channel;
+	float minimum = 0.0f;
+	float scale = 0.0f;
+	std::vector<uint16_t> times;
+	std::vector<uint16_t> values;
+};
+
+/**
+ * @class AnimationClip
+ * @brief Animacin de varios canales, comprimida al armarla.
+ *
+ * `build` reduce cada curva a las llaves necesarias para no apartarse ms de `tolerance`
+ * (en las unidades del canal) y las cuantiza a 16 bits: una curva muestreada a 60 Hz que es
+ * casi recta queda en un puado de llaves de 4 bytes.
+ *
+ * `sampleBatch` evala una pista para muchos tiempos a la vez: la bsqueda de la llave es
+ * escalar, y la descompresin y la interpolacin van de cuatro en cuatro con SSE.
+ */
+class
+AnimationClip {
+public:
+	static constexpr float kDefaultTolerance = 0.05f;
+
+	/**
+	 * @brief Clip con `curves`; dura lo que la ltima llave de todas.
+	 */
+	static AnimationClip
+	build(std::span<const AnimationCurve> curves, bool loop = true, float tolerance = kDefaultTolerance);
+
+	/**
+	 * @brief Valores de la pista `track` en los tiempos `quantizedTimes[i]` (segundos por
+	 *        `timeScale`, dentro de `[0, 65535]`).
+	 */
+	void
+	sampleBatch(uint32_t track, const float* quantizedTimes, size_t count, float* out) const;
+
+	/**
+	 * @brief Tiempo dentro del clip tras avanzar `deltaTime` desde `time`: da la vuelta con
+	 *        `loop` y se queda al final sin l.
+	 */
+	float
+	advance(float time, float deltaTime) const;
+
+	float
+	duration() const { return m_duration; }
+
+	/**
+	 * @brief Llaves cuantizadas por segundo: `65535 / duration`.
+	 */
+	float
+	timeScale() const { return m_timeScale; }
+
+	bool
+	isLooping() const { return m_loop; }
+
+	const std::vector<AnimationTrack>&
+	tracks() const { return m_tracks; }
+
+	/**
+	 * @brief Bit `1 << canal` por cada canal con pista.
+	 */
+	uint32_t
+	channelMask() const { return m_channelMask; }
+
+	/**
+	 * @brief Memoria de las llaves.
+	 */
+	size_t
+	bytes() const;
+
+private:
+	std::vector<AnimationTrack> m_tracks;
+	float m_duration = 0.0f;
+	float m_timeScale = 0.0f;
+	uint32_t m_channelMask = 0;
+	bool m_loop = true;
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Containers/TSlotMap.h"
+#include "ECS/World.h"
+#include "Animation/AnimationClip.h"
+#include "Simulation/UpdateLod.h"
+
+class JobSystem;
+class ShapeFactory;
+class Transform;
+
+using AnimationHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Componente de datos de un actor que reproduce un clip de `AnimationLibrary` sobre su
+ *        `Transform` y el color de su `ShapeFactory`.
+ */
+struct AnimationPlayer {
+	AnimationHandle clip;
+	float time = 0.0f;       ///< Segundos dentro del clip.
+	float speed = 1.0f;      ///< 0 lo pausa.
+	float pending = 0.0f;    ///< Tiempo an no aplicado, de los frames en que no le toc.
+};
+
+/**
+ * @class AnimationLibrary
+ * @brief Clips de la escena, por handle, y la reproduccin por lotes de los `AnimationPlayer`.
+ *
+ * `animate` decide primero a quin le toca este frame con un `UpdateLod`: cada frame a lo que
+ * est a la vista, cada `kFarInterval` frames a lo que est lejos del centro y cada
+ * `kHiddenInterval` a lo que qued fuera (escalonados por entidad, para no caer todos en el
+ * mismo frame). Si aun as son
+ * ms que `setBudget`, el resto espera; el corte se mueve cada frame, as que no esperan
+ * siempre los mismos.
+ * El tiempo que no se aplic se acumula y se aplica junto, as que un actor lejano va al
+ * mismo ritmo, solo que a saltos.
+ *
+ * Los elegidos se ordenan por clip y cada clip se muestrea en lotes con
+ * `AnimationClip::sampleBatch`, repartidos en el `JobSystem`; cada actor escribe solo lo suyo.
+ *
+ * Es un servicio (`TService<AnimationLibrary>`); `create` y `release` no deben coincidir con
+ * `animate`.
+ */
+class
+AnimationLibrary {
+public:
+	static constexpr uint32_t kFarInterval = UpdateLod::kFarInterval;
+	static constexpr uint32_t kHiddenInterval = UpdateLod::kHiddenInterval;
+	static constexpr float kFarDistance = UpdateLod::kFarDistance;
+	static constexpr size_t kGrain = 256;
+
+	AnimationHandle
+	create(AnimationClip clip) { return m_clips.insert(std::move(clip)); }
+
+	void
+	release(AnimationHandle clip) { m_clips.erase(clip); }
+
+	const AnimationClip*
+	find(AnimationHandle clip) const { return m_clips.get(clip); }
+
+	/**
+	 * @brief Zona que se ve; lo de afuera se actualiza con `kHiddenInterval`.
+	 */
+	void
+	setVisibleArea(const sf::FloatRect& area) { m_lod.setVisibleArea(area); }
+
+	/**
+	 * @brief Vuelve a actualizar todo cada frame.
+	 */
+	void
+	clearVisibleArea() { m_lod.clearVisibleArea(); }
+
+	/**
+	 * @brief Mximo de actores muestreados por `animate`; 0 sin lmite.
+	 */
+	void
+	setBudget(size_t players) { m_budget = players; }
+
+	/**
+	 * @brief Avanza y aplica los `AnimationPlayer` de `world` a los que les toca este frame.
+	 */
+	void
+	animate(World& world, JobSystem& jobs, float deltaTime);
+
+	/**
+	 * @brief Actores muestreados en el ltimo `animate`.
+	 */
+	size_t
+	lastSampled() const { return m_lastSampled; }
+
+	size_t
+	size() const { return m_clips.size(); }
+
+private:
+	struct Due {
+		uint32_t clip;            ///< ndice de slot del handle, para ordenar.
+		AnimationPlayer* player;
+		Transform* transform;
+		ShapeFactory* shape;      ///< Solo si el clip tiene color.
+	};
+
+	/**
+	 * @brief Muestrea `[begin, end)` de `m_due`, todos con `clip`.
+	 */
+	void
+	sample(const AnimationClip& clip, size_t begin, size_t end);
+
+	EngineUtilities::TSlotMap<AnimationClip> m_clips;
+	std::vector<Due> m_due;          ///< Elegidos del frame; conserva su capacidad.
+	UpdateLod m_lod;
+	size_t m_budget = 0;
+	size_t m_budgetCursor = 0;       ///< Rota el punto de corte del presupuesto.
+	size_t m_lastSampled = 0;
+};
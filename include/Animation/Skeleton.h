@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Math/Mat4.h"
+#include "Math/Quat.h"
+#include "Math/Vec.h"
+
+/**
+ * @brief Pose local de un hueso: relativa a su padre, como sale de la herramienta.
+ */
+struct BonePose {
+	Vec3 translation;
+	Quat rotation;
+	Vec3 scale{ 1.0f, 1.0f, 1.0f };
+};
+
+/**
+ * @class Skeleton
+ * @brief Jerarqua de huesos de una malla con piel (`Mesh::setSkin`): el padre de cada uno y la
+ *        inversa de su matriz de mundo en la pose de reposo.
+ *
+ * Los huesos van con los padres antes que los hijos, as que la pose de mundo se arma en una
+ * sola pasada. Los ndices de los vrtices son de 8 bits: a lo ms `kMaxBones`.
+ */
+class
+Skeleton {
+public:
+	static constexpr uint32_t kMaxBones = 256;
+	static constexpr int32_t kNoParent = -1;
+
+	/**
+	 * @brief Agrega un hueso hijo de `parent` (anterior a l, o `kNoParent`).
+	 * @return Su ndice, o `kMaxBones` si ya no caben o el padre no es vlido.
+	 */
+	uint32_t
+	addBone(int32_t parent, const Mat4& inverseBind);
+
+	size_t
+	boneCount() const { return m_parents.size(); }
+
+	const std::vector<int32_t>&
+	parents() const { return m_parents; }
+
+	const std::vector<Mat4>&
+	inverseBind() const { return m_inverseBind; }
+
+	/**
+	 * @brief Matrices de piel de `pose`: la de mundo de cada hueso por su inversa de reposo,
+	 *        lo que el shader aplica a los vrtices. `out` tiene un lugar por hueso.
+	 */
+	void
+	skinningMatrices(std::span<const BonePose> pose, std::span<Mat4> out) const;
+
+private:
+	std::vector<int32_t> m_parents;
+	std::vector<Mat4> m_inverseBind;
+};
+
+/**
+ * @class SkeletalClip
+ * @brief Animacin de un esqueleto: la pose local de todos sus huesos muestreada a
+ *        `frameRate` cuadros por segundo.
+ *
+ * Se evala interpolando entre los dos cuadros vecinos, lineal en traslacin y escala y por el
+ * arco ms corto en rotacin. Con `loop` el ltimo cuadro vuelve al primero.
+ */
+class
+SkeletalClip {
+public:
+	SkeletalClip() = default;
+
+	SkeletalClip(uint32_t boneCount, float frameRate, bool loop = true)
+		: m_boneCount(boneCount), m_frameRate(frameRate > 0.0f ? frameRate : 30.0f), m_loop(loop) {}
+
+	/**
+	 * @brief Agrega el cuadro siguiente; `pose` tiene un lugar por hueso.
+	 */
+	void
+	addFrame(std::span<const BonePose> pose);
+
+	/**
+	 * @brief La pose a los `time` segundos, en `out` (un lugar por hueso).
+	 */
+	void
+	sample(float time, std::span<BonePose> out) const;
+
+	/**
+	 * @brief Como `AnimationClip::advance`: da la vuelta con `loop` y se queda al final sin l.
+	 */
+	float
+	advance(float time, float deltaTime) const;
+
+	/**
+	 * @brief Segundos; con `loop` cuenta el tramo del ltimo cuadro al primero.
+	 */
+	float
+	duration() const;
+
+	uint32_t
+	boneCount() const { return m_boneCount; }
+
+	uint32_t
+	frameCount() const { return m_boneCount ? static_cast<uint32_t>(m_poses.size() / m_boneCount) : 0; }
+
+	float
+	frameRate() const { return m_frameRate; }
+
+	bool
+	isLooping() const { return m_loop; }
+
+private:
+	uint32_t m_boneCount = 0;
+	float m_frameRate = 30.0f;
+	bool m_loop = true;
+	std::vector<BonePose> m_poses;    ///< Cuadro por cuadro, todos los huesos de cada uno.
+};
@@ -0,0 +1,299 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+#include "Audio/SoundCache.h"
+#include "Render/Mesh.h"
+#include "Scene/AssetGraph.h"
+#include "Scene/FileWatcher.h"
+#include "Scene/PackFormat.h"
+
+/**
+ * @class AssetManager
+ * @brief Un solo lugar para pedir texturas, fuentes, sonidos, shaders y mallas por ruta o por
+ *        `AssetId`: la misma ruta devuelve siempre la misma instancia.
+ *
+ * Cada tipo se carga con lo que el motor ya tiene para l: texturas por `TextureLoader` y
+ * mallas por `MeshLoader`, las dos en segundo plano (devuelven el objeto enseguida y lo llenan
+ * despus); sonidos por `SoundCache`; shaders compilados por `ShaderCache`; y las fuentes, que
+ * no tienen cargador propio, se leen aqu mismo.
+ *
+ * Las entradas son `TSharedPointer`. `evictUnused` suelta las que solo tiene este objeto: las
+ * fuentes y mallas se destruyen, y los sonidos vuelven a ser del `SoundCache`, que los saca
+ * por su presupuesto. Texturas y shaders siguen siendo de su cargador, que no los devuelve
+ * nunca: soltarlos aqu solo olvida el nombre, y pedirlos otra vez da los mismos.
+ *
+ * Con `setHotReload` (builds de desarrollo, `kHotReload`) un `FileWatcher` vigila los archivos
+ * de texturas y shaders pedidos, ms los que se registren con `watch`, y `update` recarga solo
+ * lo que depende del archivo que cambi: la textura cambia en el mismo objeto al subirse; el
+ * shader nuevo reemplaza al de la tabla si compila, y si no se queda el anterior. Cada recarga
+ * se publica como `AssetReloaded`, para que quien guarde un shader o dependa de un archivo
+ * registrado (una escena) lo vuelva a pedir. Fuentes, sonidos y mallas no se recargan. Lo
+ * declarado con `addDependency` (una escena que usa una malla, un material sus texturas) se
+ * recarga y se publica tambin, despus de lo que usa: solo lo afectado (`AssetGraph`).
+ *
+ * Una textura, malla o sonido de un paquete con el mismo contenido que otra ruta ya cargada
+ * (`PackedAsset::contentHash`) no se carga de nuevo: las dos rutas dan la misma instancia, que
+ * se guarda con el id de la primera.
+ *
+ * Texturas, sonidos y mallas tienen adems un presupuesto de memoria por categora
+ * (`setBudget`). `update` lo revisa cada frame: si una categora se pasa, suelta primero lo que
+ * nadie ms tiene y hace ms tiempo que no se pidi (LRU); las texturas vuelven al damero en el
+ * `TextureLoader` y las mallas se destruyen, y los sonidos se devuelven al `SoundCache`, que
+ * aplica el mismo presupuesto. Desde `kLodThreshold` del presupuesto de texturas, antes de
+ * pasarse, los `.dds` nuevos se cargan sin su mipmap ms grande y a los que siguen en uso se
+ * les suelta uno, del menos usado al ms, un cuarto de su memoria cada vez. `residency` dice
+ * cunto hay de cada una.
+ *
+ * Solo el hilo principal; `shader` adems con el contexto de la ventana activo, como
+ * `ShaderCache::shader`. Es un servicio (`TService<AssetManager>`).
+ */
+class
+AssetManager {
+public:
+	template<typename T>
+	using Handle = EngineUtilities::TSharedPointer<T>;
+
+	/**
+	 * @brief Lo que tiene presupuesto de memoria.
+	 */
+	enum class Category : uint8_t { Texture, Audio, Mesh };
+	static constexpr size_t kCategoryCount = 3;
+
+	static constexpr size_t kDefaultTextureBudget = 256u << 20;     ///< Bytes de video: 16 texturas de 2048 RGBA.
+	static constexpr size_t kDefaultAudioBudget = SoundCache::kDefaultBudget;
+	static constexpr size_t kDefaultMeshBudget = 64u << 20;         ///< Bytes: unos dos millones de vrtices.
+	static constexpr double kLodThreshold = 0.9;                    ///< Fraccin del presupuesto de texturas.
+
+	/**
+	 * @brief Cunta memoria ocupa una categora y qu solt su presupuesto.
+	 */
+	struct Residency {
+		size_t bytes = 0;            ///< Cargado: en la GPU las texturas, las muestras los sonidos.
+		size_t budget = 0;
+		size_t entries = 0;          ///< Pedidos que siguen en la tabla.
+		size_t referenced = 0;       ///< De esos, los que alguien ms tiene: no pueden soltarse.
+		uint64_t evicted = 0;        ///< Soltados por el presupuesto desde el principio.
+		uint64_t droppedLevels = 0;  ///< Mipmaps soltados de texturas en uso.
+	};
+
+	/**
+	 * @brief Muestra un damero hasta que `TextureLoader::isReady`.
+	 */
+	Handle<const sf::Texture>
+	texture(const std::string& path);
+
+	/**
+	 * @return Nulo si no pudo leerse.
+	 */
+	Handle<sf::Font>
+	font(const std::string& path);
+
+	/**
+	 * @brief No suena hasta que `SoundAsset::isReady`.
+	 */
+	Handle<SoundAsset>
+	sound(const std::string& path);
+
+	/**
+	 * @brief Vaca hasta el `MeshLoader::adoptFinished` que le entrega la geometra.
+	 */
+	Handle<Mesh>
+	mesh(const std::string& path);
+
+	/**
+	 * @brief Shader de los archivos `vertexPath` y `fragmentPath`; su id es el de las dos rutas
+	 *        unidas por `kShaderSeparator`.
+	 * @return Nulo si un archivo no pudo leerse o no compil.
+	 */
+	Handle<sf::Shader>
+	shader(const std::string& vertexPath, const std::string& fragmentPath);
+
+	static constexpr char kShaderSeparator = '|';
+
+	/**
+	 * @brief Lo que ya se pidi con ese id, sin cargar nada; nulo si no est.
+	 * @tparam T `const sf::Texture`, `sf::Font`, `SoundAsset`, `Mesh` o `sf::Shader`.
+	 */
+	template<typename T>
+	Handle<T>
+	find(AssetId id) const {
+		auto alias = m_aliases.find(id);
+		if (alias != m_aliases.end()) {
+			id = alias->second;
+		}
+		const auto& assets = table<T>();
+		auto found = assets.find(id);
+		return found != assets.end() ? found->second : Handle<T>();
+	}
+
+	/**
+	 * @brief Anota que `dependent` usa `dependency`, por sus ids: al recargarse `dependency`,
+	 *        `update` tambin recarga y publica `dependent`.
+	 * @return `false` si cerrara un ciclo.
+	 */
+	bool
+	addDependency(AssetId dependent, AssetId dependency) { return m_graph.addDependency(dependent, dependency); }
+
+	/**
+	 * @brief Pedidos que dieron lo ya cargado por otra ruta con el mismo contenido.
+	 */
+	uint64_t
+	sharedLoads() const { return m_sharedLoads; }
+
+	/**
+	 * @brief Suelta lo que nadie ms tiene.
+	 * @return Cuntas entradas salieron.
+	 */
+	size_t
+	evictUnused();
+
+	/**
+	 * @brief Enciende o apaga la vigilancia de los archivos de texturas, shaders y `watch`.
+	 * @return `false` si no pudo encenderse (`FileWatcher::start`).
+	 */
+	bool
+	setHotReload(bool enabled);
+
+	bool
+	isHotReload() const { return m_watcher.isRunning(); }
+
+	/**
+	 * @brief Registra un archivo que no carga este objeto; al cambiar solo se publica
+	 *        `AssetReloaded` con `assetId(path)`.
+	 */
+	void
+	watch(const std::string& path);
+
+	/**
+	 * @brief Recarga lo que cambi en disco y lo publica (con `setHotReload`) y aplica los
+	 *        presupuestos. Una vez por frame, con el contexto activo como `shader`.
+	 */
+	void
+	update();
+
+	/**
+	 * @brief Bytes que puede ocupar `category` antes de que `update` suelte algo.
+	 */
+	void
+	setBudget(Category category, size_t bytes);
+
+	size_t
+	budget(Category category) const { return m_budgets[static_cast<size_t>(category)]; }
+
+	Residency
+	residency(Category category) const;
+
+	/**
+	 * @brief Una lnea por categora con su `residency`.
+	 */
+	void
+	printResidency(std::ostream& out) const;
+
+	/**
+	 * @brief Entradas de todos los tipos.
+	 */
+	size_t
+	size() const;
+
+private:
+	template<typename T>
+	using Table = std::unordered_map<AssetId, Handle<T>>;
+
+	enum class SourceKind { Texture, Shader, Sound, Mesh, File };
+
+	/**
+	 * @brief Con qu se pidi un id, para recargarlo o soltarlo: la ruta o, de un shader, las
+	 *        dos unidas.
+	 */
+	struct Source {
+		std::string request;
+		SourceKind kind = SourceKind::File;
+		uint64_t lastUse = 0;         ///< De `m_useCounter`; el menor se suelta primero.
+	};
+
+	/**
+	 * @brief Anota de dnde sale `id` y que se acaba de pedir; si es nuevo y la vigilancia
+	 *        est encendida, vigila sus archivos.
+	 */
+	void
+	remember(AssetId id, const std::string& request, SourceKind kind);
+
+	/**
+	 * @brief Id con que se guarda `path` en `table<T>`: el de otra ruta ya cargada con el mismo
+	 *        contenido en un paquete, o el suyo.
+	 */
+	template<typename T>
+	AssetId
+	sharedId(AssetId id, const std::string& path);
+
+	/**
+	 * @brief Recarga lo que el `FileWatcher` vio cambiar, y lo que depende de ello, y lo publica.
+	 */
+	void
+	reloadChanged();
+
+	/**
+	 * @brief Suelta dentro de cada presupuesto y cuida el de texturas antes de llegar.
+	 */
+	void
+	enforceBudgets();
+
+	/**
+	 * @brief Ids de `assets` que solo tiene este objeto, del que hace ms que se pidi al que menos.
+	 */
+	template<typename T>
+	std::vector<AssetId>
+	unusedByAge(const Table<T>& assets) const;
+
+	/**
+	 * @brief Vigila los archivos de `source` y los liga a `id`.
+	 */
+	void
+	watchSource(AssetId id, const Source& source);
+
+	/**
+	 * @return `false` si todava no puede recargarse y hay que intentarlo en otro frame.
+	 */
+	bool
+	reload(AssetId id, const Source& source);
+
+	template<typename T>
+	Table<T>&
+	table();
+
+	template<typename T>
+	const Table<T>&
+	table() const { return const_cast<AssetManager*>(this)->table<T>(); }
+
+	Table<const sf::Texture> m_textures;
+	Table<sf::Font> m_fonts;
+	Table<SoundAsset> m_sounds;
+	Table<Mesh> m_meshes;
+	Table<sf::Shader> m_shaders;
+
+	FileWatcher m_watcher;
+	std::unordered_map<AssetId, Source> m_sources;
+	std::unordered_map<std::string, std::vector<AssetId>> m_dependents; ///< Ruta normalizada: ids que salen de ella.
+	std::vector<AssetId> m_retry;                                       ///< Cambiaron mientras se cargaban.
+	AssetGraph m_graph;                                                 ///< De `addDependency`.
+	std::unordered_map<uint64_t, AssetId> m_byContent;                  ///< `contentHash`: id que lo carg.
+	std::unordered_map<AssetId, AssetId> m_aliases;                     ///< Id de una ruta: el que tiene su contenido.
+	uint64_t m_sharedLoads = 0;
+
+	size_t m_budgets[kCategoryCount] = { kDefaultTextureBudget, kDefaultAudioBudget, kDefaultMeshBudget };
+	uint64_t m_evicted[kCategoryCount] = {};
+	uint64_t m_droppedLevels = 0;
+	uint64_t m_lodCursor = 0;                                           ///< `lastUse` de la ltima textura que solt un nivel.
+	uint64_t m_useCounter = 0;
+};
+
+template<> inline AssetManager::Table<const sf::Texture>& AssetManager::table<const sf::Texture>() { return m_textures; }
+template<> inline AssetManager::Table<sf::Font>& AssetManager::table<sf::Font>() { return m_fonts; }
+template<> inline AssetManager::Table<SoundAsset>& AssetManager::table<SoundAsset>() { return m_sounds; }
+template<> inline AssetManager::Table<Mesh>& AssetManager::table<Mesh>() { return m_meshes; }
+template<> inline AssetManager::Table<sf::Shader>& AssetManager::table<sf::Shader>() { return m_shaders; }
@@ -0,0 +1,187 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Prerequisites.h"
+#include "AssetManager.h"
+
+using StreamHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Qu tan pronto hace falta un recurso; el menor va primero.
+ */
+enum class StreamPriority : uint8_t {
+	Visible = 0,   ///< Se ve ahora.
+	Nearby = 1,    ///< A menos de `AssetStreamer::kNearDistance` de la vista.
+	Prefetch = 2   ///< Por si acaso; solo con lugar de sobra.
+};
+
+enum class AssetKind : uint8_t {
+	Texture,
+	Font,
+	Sound,
+	Mesh
+};
+
+enum class StreamState : uint8_t {
+	None,      ///< El pedido no existe: nunca se hizo o se cancel.
+	Queued,
+	Loading,
+	Ready,
+	Failed
+};
+
+/**
+ * @class AssetStreamer
+ * @brief Reparte las cargas de `AssetManager` por prioridad: pocas a la vez, las que se ven
+ *        primero, y las que ya no hacen falta se cancelan antes de empezar.
+ *
+ * Los cargadores empiezan a leer en cuanto se les pide, as que pedir un nivel entero llena
+ * los hilos de trabajo y lo que est a la vista espera detrs de todo lo dems. Aqu un pedido
+ * espera en cola hasta que `update` lo lanza: como mucho `maxInFlight` cargando a la vez, por
+ * prioridad y, entre iguales, por orden de llegada. Las `Prefetch` solo usan la mitad de los
+ * lugares, para que una `Visible` que llega no espere a que terminen.
+ *
+ * Un pedido con posicin (`requestAt`) cambia de prioridad solo segn `setVisibleArea`, como
+ * `UpdateLod`: la cmara se mueve y lo que entra en la vista pasa adelante en la cola.
+ * `cancel` saca un pedido de la cola; si ya est cargando, el trabajo termina igual (no se
+ * interrumpe una lectura) y el recurso queda en `AssetManager` hasta `evictUnused`.
+ *
+ * `update` es el punto de sincrona del frame: ve qu cargas terminaron y lanza las siguientes
+ * sin pasar de `dispatchBudget` (las fuentes se leen ah mismo). Lo que cada cargador entrega
+ * al frame tambin tiene su presupuesto: `TextureLoader::uploadBudget`,
+ * `SoundCache::uploadBudget`. Mientras un pedido est vivo, el recurso no sale de
+ * `AssetManager`.
+ *
+ * Solo el hilo principal. Es un servicio (`TService<AssetStreamer>`).
+ */
+class
+AssetStreamer {
+public:
+	static constexpr uint32_t kDefaultMaxInFlight = 8;
+	static constexpr float kNearDistance = 1000.0f;           ///< Desde el borde de la vista.
+	static constexpr float kDefaultDispatchBudget = 0.002f;   ///< Segundos de `update` por frame.
+
+	/**
+	 * @brief Pide `path` con una prioridad fija.
+	 */
+	StreamHandle
+	request(AssetKind kind, const std::string& path, StreamPriority priority);
+
+	/**
+	 * @brief Pide `path` para algo en `position`; la prioridad sale de la vista en cada `update`.
+	 */
+	StreamHandle
+	requestAt(AssetKind kind, const std::string& path, const sf::Vector2f& position);
+
+	/**
+	 * @brief Cambia la prioridad; el pedido deja de seguir a la vista.
+	 */
+	void
+	setPriority(StreamHandle handle, StreamPriority priority);
+
+	/**
+	 * @brief Mueve un pedido de `requestAt` a `position`.
+	 */
+	void
+	setPosition(StreamHandle handle, const sf::Vector2f& position);
+
+	/**
+	 * @brief Olvida el pedido, est donde est; el recurso ya cargado deja de retenerse.
+	 */
+	void
+	cancel(StreamHandle handle);
+
+	StreamState
+	state(StreamHandle handle) const;
+
+	/**
+	 * @brief El recurso, si el pedido est `Ready`; nulo si no.
+	 * @tparam T `const sf::Texture`, `sf::Font`, `SoundAsset` o `Mesh`, segn el `AssetKind`.
+	 */
+	template<typename T>
+	AssetManager::Handle<T>
+	asset(StreamHandle handle) const {
+		const Request* request = m_requests.get(handle);
+		if (!request || request->state != StreamState::Ready) {
+			return AssetManager::Handle<T>();
+		}
+		return EngineUtilities::TService<AssetManager>::instance().find<T>(assetId(request->path));
+	}
+
+	/**
+	 * @brief rea del mundo a la vista; de ella sale la prioridad de los pedidos con posicin.
+	 */
+	void
+	setVisibleArea(const sf::FloatRect& area) { m_visibleArea = area; m_hasVisibleArea = true; }
+
+	/**
+	 * @brief Recoge las cargas terminadas y lanza las siguientes; una vez por frame.
+	 */
+	void
+	update();
+
+	void
+	setMaxInFlight(uint32_t count) { m_maxInFlight = count > 0 ? count : 1; }
+
+	uint32_t
+	maxInFlight() const { return m_maxInFlight; }
+
+	void
+	setDispatchBudget(float seconds) { m_dispatchBudget = seconds; }
+
+	float
+	dispatchBudget() const { return m_dispatchBudget; }
+
+	/**
+	 * @brief Pedidos que esperan lugar.
+	 */
+	size_t
+	queuedCount() const { return m_requests.size() - m_inFlight - m_finished; }
+
+	/**
+	 * @brief Pedidos cargando ahora.
+	 */
+	uint32_t
+	loadingCount() const { return m_inFlight; }
+
+private:
+	struct Request {
+		AssetKind kind = AssetKind::Texture;
+		StreamPriority priority = StreamPriority::Prefetch;
+		StreamState state = StreamState::Queued;
+		bool placed = false;                       ///< La prioridad sale de `position` y la vista.
+		sf::Vector2f position;
+		uint64_t sequence = 0;                     ///< Orden de llegada, entre iguales.
+		std::string path;
+		AssetManager::Handle<const sf::Texture> texture;   ///< Solo el del `kind`; retiene el recurso.
+		AssetManager::Handle<sf::Font> font;
+		AssetManager::Handle<SoundAsset> sound;
+		AssetManager::Handle<Mesh> mesh;
+	};
+
+	StreamPriority
+	priorityAt(const sf::Vector2f& position) const;
+
+	/**
+	 * @brief Empieza la carga de `request` en su cargador.
+	 */
+	void
+	dispatch(Request& request);
+
+	/**
+	 * @brief `Ready` o `Failed` si la carga de `request` termin; `Loading` si no.
+	 */
+	StreamState
+	poll(const Request& request) const;
+
+	EngineUtilities::TSlotMap<Request> m_requests;
+	std::vector<uint32_t> m_ranked;                ///< Posiciones densas de los que esperan.
+	sf::FloatRect m_visibleArea;
+	bool m_hasVisibleArea = false;
+	uint32_t m_maxInFlight = kDefaultMaxInFlight;
+	uint32_t m_inFlight = 0;
+	size_t m_finished = 0;                         ///< `Ready` o `Failed`.
+	uint64_t m_sequence = 0;
+	float m_dispatchBudget = kDefaultDispatchBudget;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Cmo va el audio: para saber si un corte viene del hilo principal, del disco o de la
+ *        mezcla.
+ *
+ * Los cortes y los robos se cuentan desde el principio; los tiempos son del ltimo frame.
+ */
+struct AudioStats {
+	uint64_t underruns = 0;       ///< Veces que un stream (msica o mezcla) se qued sin muestras.
+	uint64_t steals = 0;          ///< Voces quitadas a una reproduccin para drsela a otra.
+	double refillMaxMs = 0.0;     ///< La recarga de stream ms lenta: lectura del disco o mezcla.
+	uint32_t refills = 0;
+	double latencyMaxMs = 0.0;    ///< Del `play` a tener voz, la peor de las que empezaron.
+	uint32_t started = 0;         ///< Reproducciones que recibieron su primera voz.
+	uint32_t voices = 0;          ///< Con voz de OpenAL al cerrar el frame.
+	uint32_t virtuals = 0;
+};
+
+/**
+ * @class AudioStatsCounter
+ * @brief Lo cuentan el hilo principal y los de los streams; `BaseApp` cierra el frame y se lo
+ *        pasa a `Window` para el overlay.
+ *
+ * Todo es atmico y sin bloqueos: los hilos de los streams de SFML no esperan al principal.
+ */
+class
+AudioStatsCounter {
+public:
+	static AudioStatsCounter&
+	instance();
+
+	void
+	countUnderrun() { m_underruns.fetch_add(1, std::memory_order_relaxed); }
+
+	void
+	countSteal() { m_steals.fetch_add(1, std::memory_order_relaxed); }
+
+	/**
+	 * @brief Una recarga de stream que tard `microseconds`.
+	 */
+	void
+	countRefill(uint32_t microseconds);
+
+	/**
+	 * @brief Una reproduccin que tard `microseconds` desde el `play` en sonar.
+	 */
+	void
+	countStart(uint32_t microseconds);
+
+	/**
+	 * @brief Lo contado; los tiempos vuelven a cero. En el hilo principal.
+	 */
+	AudioStats
+	endFrame();
+
+private:
+	/**
+	 * @brief `target = max(target, value)` sin bloquear.
+	 */
+	static void
+	raise(std::atomic<uint32_t>& target, uint32_t value);
+
+	std::atomic<uint64_t> m_underruns{ 0 };
+	std::atomic<uint64_t> m_steals{ 0 };
+	std::atomic<uint32_t> m_refillMax{ 0 };   ///< Microsegundos.
+	std::atomic<uint32_t> m_refills{ 0 };
+	std::atomic<uint32_t> m_latencyMax{ 0 };  ///< Microsegundos.
+	std::atomic<uint32_t> m_started{ 0 };
+};
+
+/**
+ * @class StreamWatch
+ * @brief Mide las recargas de un `sf::SoundStream` desde su `onGetData` y nota cundo llegaron
+ *        tan tarde que se acab lo encolado.
+ *
+ * SFML encola `kQueuedChunks` trozos: si entre dos recargas pasa ms de lo que duran, la fuente
+ * se qued callada. Solo del hilo del stream; `reset` al detenerlo o buscar, para que la pausa
+ * no cuente como corte.
+ */
+class
+StreamWatch {
+public:
+	static constexpr uint32_t kQueuedChunks = 3;
+
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Al empezar `onGetData`.
+	 */
+	void
+	begin();
+
+	/**
+	 * @brief Al terminar `onGetData`, con el trozo que entreg.
+	 */
+	void
+	end(size_t sampleCount, unsigned int channels, unsigned int sampleRate);
+
+	void
+	reset() { m_hasLast = false; }
+
+private:
+	Clock::time_point m_start;
+	Clock::time_point m_last;        ///< Fin de la recarga anterior.
+	double m_chunkSeconds = 0.0;     ///< Duracin del ltimo trozo.
+	bool m_hasLast = false;
+};
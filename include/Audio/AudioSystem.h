@@ -0,0 +1,296 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include "Prerequisites.h"
+#include "Audio/AudioStats.h"
+#include "ECS/World.h"
+#include "Scene/PackFile.h"
+
+class AudioSource;
+class JobSystem;
+
+using VoiceHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Cmo suena una reproduccin de `AudioSystem::play`.
+ */
+struct SoundParams {
+	float volume = 100.0f;        ///< De 0 a 100, como `sf::Sound`.
+	float pitch = 1.0f;
+	int32_t priority = 0;         ///< Pesa antes que lo fuerte que se oye al repartir las voces.
+	bool loop = false;
+	bool spatial = false;         ///< `false`: suena igual desde cualquier lado (interfaz, msica de un evento).
+	sf::Vector2f position;        ///< En el mundo, si `spatial`.
+	float minDistance = 200.0f;   ///< Hasta aqu suena a volumen completo.
+	float attenuation = 1.0f;     ///< Qu tan rpido baja despus de `minDistance`.
+};
+
+/**
+ * @class StreamedMusic
+ * @brief `sf::Music` que le cuenta a `AudioStatsCounter` cunto tarda en leer del disco y
+ *        cundo se qued sin muestras.
+ */
+class
+StreamedMusic : public sf::Music {
+protected:
+	bool
+	onGetData(Chunk& data) override;
+
+	void
+	onSeek(sf::Time timeOffset) override;
+
+private:
+	StreamWatch m_watch;
+};
+
+/**
+ * @class AudioSystem
+ * @brief Sonidos cortos en un grupo fijo de voces y pistas largas ledas del disco mientras
+ *        suenan.
+ *
+ * OpenAL tiene un mximo de fuentes y crear un `sf::Sound` por evento frena el frame, as que
+ * las `kVoiceCount` voces se crean una vez. Una reproduccin no es una voz: hasta
+ * `kMaxPlaybacks` pueden estar sonando a la vez, pero solo las que mejor se oyen tienen voz
+ * real. Las dems son virtuales: avanzan su posicin con el reloj, sin fuente de OpenAL, y
+ * `update` les da voz, desde donde van, cuando pasan a estar entre las que ms se oyen, y
+ * se la quita a la que qued fuera.
+ *
+ * Se ordenan por `priority` y, entre iguales, por lo fuerte que llegan al oyente (volumen por
+ * la cada con la distancia, como la calcula OpenAL). Lo que llega por debajo de
+ * `kAudibleGain` no recibe voz aunque sobren. La que ya tiene voz cuenta `kKeepBonus` veces
+ * ms fuerte, para que dos parecidas no se la pasen de un frame a otro. Un `VoiceHandle` es
+ * de la reproduccin; deja de valer cuando termina o la detienen.
+ *
+ * Los bferes son de quien llama, normalmente de `SoundCache`, y tienen que durar lo que sus
+ * reproducciones (`isUsing`, `stopAll`). La msica va por `sf::Music` en `kMusicTracks` pistas, para cruzar una con otra: `playMusic`
+ * empieza la nueva en la pista libre y `update` baja la anterior en `fadeSeconds`.
+ *
+ * Nada de esto llama a OpenAL donde se pide: `setPosition`, `setVolume`, `setListener` y
+ * `syncSources` solo anotan, y `update` calcula en el `JobSystem` lo que oye cada reproduccin
+ * y despus, en un solo punto, mueve el oyente y las voces que cambiaron.
+ *
+ * El mundo tiene y hacia abajo: el oyente mira hacia +z desde `kListenerDistance` delante del
+ * plano, con arriba hacia -y, para que la derecha de la pantalla suene a la derecha.
+ *
+ * Un solo hilo. Es un servicio (`TService<AudioSystem>`); pedirlo abre el dispositivo de
+ * audio, as que el modo servidor no lo pide.
+ */
+class
+AudioSystem {
+public:
+	static constexpr uint32_t kVoiceCount = 32;
+	static constexpr uint32_t kMaxPlaybacks = 4096;     ///< Reales ms virtuales.
+	static constexpr float kAudibleGain = 0.01f;        ///< De 0 a 1; menos, no merece voz.
+	static constexpr float kKeepBonus = 1.25f;
+	static constexpr size_t kBatchGrain = 256;          ///< Reproducciones por trabajo de `update`.
+	static constexpr uint32_t kMusicTracks = 2;
+	static constexpr float kListenerDistance = 300.0f; ///< Del oyente al plano z = 0.
+
+	AudioSystem();
+
+	AudioSystem(const AudioSystem&) = delete;
+	AudioSystem& operator=(const AudioSystem&) = delete;
+
+	/**
+	 * @brief Empieza a reproducir `sound`; con voz si se oye mejor que alguna de las que la
+	 *        tienen, si no virtual.
+	 * @return Nulo si ya hay `kMaxPlaybacks`.
+	 */
+	VoiceHandle
+	play(const sf::SoundBuffer& sound, const SoundParams& params = SoundParams());
+
+	/**
+	 * @brief Detiene la reproduccin y libera su voz; no hace nada si ya termin.
+	 */
+	void
+	stop(VoiceHandle voice);
+
+	/**
+	 * @brief Si la reproduccin sigue, con voz o virtual.
+	 */
+	bool
+	isPlaying(VoiceHandle voice) const;
+
+	/**
+	 * @brief Si la reproduccin tiene ahora una voz de OpenAL.
+	 */
+	bool
+	isAudible(VoiceHandle voice) const;
+
+	void
+	setPosition(VoiceHandle voice, const sf::Vector2f& position);
+
+	void
+	setVolume(VoiceHandle voice, float volume);
+
+	/**
+	 * @brief Detiene todo lo que usa `sound`, antes de que su dueo lo suelte.
+	 */
+	void
+	stopAll(const sf::SoundBuffer& sound);
+
+	/**
+	 * @brief Si alguna reproduccin usa `sound`.
+	 */
+	bool
+	isUsing(const sf::SoundBuffer& sound) const;
+
+	/**
+	 * @brief Lleva cada `AudioSource` espacial que suena a la posicin de su `Transform`; solo
+	 *        las que se movieron desde el tick `since`.
+	 */
+	void
+	syncSources(World& world, uint32_t since, JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief Punto del mundo desde el que se oye; normalmente el centro de la vista.
+	 */
+	void
+	setListener(const sf::Vector2f& position);
+
+	/**
+	 * @brief Empieza a leer `path` en la pista libre; la que sonaba baja hasta callar en
+	 *        `fadeSeconds` (0, de golpe).
+	 * @return `false` si el archivo no pudo abrirse; la msica de antes sigue.
+	 */
+	bool
+	playMusic(const std::string& path, bool loop = true, float fadeSeconds = 0.0f);
+
+	/**
+	 * @brief Baja la msica hasta callar en `fadeSeconds`.
+	 */
+	void
+	stopMusic(float fadeSeconds = 0.0f);
+
+	void
+	setMusicVolume(float volume);
+
+	bool
+	isMusicPlaying() const;
+
+	/**
+	 * @brief Avanza las reproducciones virtuales, reparte las voces, aplica lo anotado y avanza
+	 *        los cruces de msica; una vez por frame.
+	 * @param jobs Reparte el clculo por reproduccin; nulo, en este hilo.
+	 */
+	void
+	update(float deltaTime, JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief Voces sonando ahora.
+	 */
+	uint32_t
+	activeVoices() const;
+
+	/**
+	 * @brief Reproducciones sin voz ahora.
+	 */
+	uint32_t
+	virtualCount() const { return static_cast<uint32_t>(m_playbacks.size()) - activeVoices(); }
+
+	/**
+	 * @brief Veces que una reproduccin le quit la voz a otra desde el principio.
+	 */
+	uint64_t
+	stolenCount() const { return m_stolen; }
+
+	/**
+	 * @brief Reproducciones rechazadas por `kMaxPlaybacks` desde el principio.
+	 */
+	uint64_t
+	droppedCount() const { return m_dropped; }
+
+private:
+	static constexpr uint32_t kNoVoice = 0xFFFFFFFFu;
+
+	struct Playback {
+		const sf::SoundBuffer* sound = nullptr;
+		SoundParams params;
+		float elapsed = 0.0f;        ///< Segundos del bfer ya sonados; la virtual los cuenta sola.
+		float duration = 0.0f;
+		float gain = 0.0f;           ///< Lo que llega al oyente, de 0 a 1; de `update`.
+		uint32_t voice = kNoVoice;
+		bool chosen = false;         ///< Entre las que reciben voz; de `assignVoices`.
+		bool finished = false;       ///< De `advance`; `update` la borra.
+		bool dirty = false;          ///< Posicin o volumen sin pasar a su voz.
+		bool started = false;        ///< Ya tuvo voz alguna vez; `requested` ya se cont.
+		StreamWatch::Clock::time_point requested;
+	};
+
+	struct Voice {
+		sf::Sound sound;
+		VoiceHandle owner;           ///< Nulo si est libre.
+	};
+
+	struct Track {
+		std::vector<unsigned char> unpacked;   ///< Lo que lee `packed` si vena comprimido.
+		PackStream packed;           ///< Antes que `music`, que la lee mientras suena.
+		StreamedMusic music;
+		float volume = 0.0f;         ///< Del cruce, de 0 a 1.
+		float fadeSpeed = 0.0f;      ///< Por segundo; negativa baja.
+	};
+
+	/**
+	 * @brief Avanza las reproducciones `[begin, end)` y les calcula `gain`; sin OpenAL, para
+	 *        cualquier hilo.
+	 */
+	void
+	advance(size_t begin, size_t end, float deltaTime);
+
+	/**
+	 * @brief Lo que llega de `playback` al oyente, de 0 a 1.
+	 */
+	float
+	gainOf(const Playback& playback) const;
+
+	/**
+	 * @brief Si `a` merece voz antes que `b`.
+	 */
+	static bool
+	outranks(const Playback& a, const Playback& b);
+
+	/**
+	 * @brief Da a `handle` la voz `voice`, libre, desde donde va la reproduccin.
+	 */
+	void
+	promote(VoiceHandle handle, uint32_t voice);
+
+	/**
+	 * @brief Le quita la voz a `playback`, que sigue virtual desde donde iba.
+	 */
+	void
+	demote(Playback& playback);
+
+	/**
+	 * @brief Detiene la voz de `playback`, si tiene, y la deja libre.
+	 */
+	void
+	release(Playback& playback);
+
+	/**
+	 * @brief Voces para las que ms se oyen; a las dems se las quita.
+	 */
+	void
+	assignVoices();
+
+	/**
+	 * @brief Empieza a bajar `track` hasta callar en `fadeSeconds`.
+	 */
+	void
+	fadeOut(Track& track, float fadeSeconds);
+
+	std::vector<Voice> m_voices;                                          ///< Fijas desde el constructor.
+	EngineUtilities::TSlotMap<Playback> m_playbacks;
+	std::vector<uint32_t> m_ranked;                                       ///< Posiciones densas de `m_playbacks`.
+	std::vector<VoiceHandle> m_moved;                                     ///< De `syncSources`.
+	std::vector<sf::Vector2f> m_movedTo;
+	sf::Vector2f m_listener;
+	bool m_listenerDirty = true;
+	Track m_tracks[kMusicTracks];
+	uint32_t m_currentTrack = 0;                                          ///< La que sube o suena.
+	float m_musicVolume = 100.0f;
+	uint64_t m_stolen = 0;
+	uint64_t m_dropped = 0;
+};
@@ -0,0 +1,162 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include "Prerequisites.h"
+#include "Audio/AudioStats.h"
+#include "Audio/SoundCache.h"
+
+using MixHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Cmo suena una capa de `SoftwareMixer::play`.
+ */
+struct MixParams {
+	float gain = 1.0f;
+	float pan = 0.0f;             ///< De -1 (izquierda) a 1 (derecha).
+	float rate = 1.0f;            ///< Velocidad de lectura; cambia tambin el tono.
+	float lowPass = 1.0f;         ///< Coeficiente del filtro de un polo, de 0 a 1; 1 no filtra.
+	bool loop = true;
+};
+
+/**
+ * @class SoftwareMixer
+ * @brief Mezcla por software muchas capas de sonido en un solo `sf::SoundStream`: una sola
+ *        fuente de OpenAL para el ambiente, la lluvia o las mquinas de fondo.
+ *
+ * Cada capa lee las muestras de un `SoundAsset` listo, con su ganancia, paneo, velocidad
+ * (interpolacin lineal) y un filtro pasa bajos. La mezcla corre en el hilo del stream
+ * (`onGetData`), en bloques de `kBlockFrames` cuadros estreo: el remuestreo y el filtro van
+ * muestra por muestra, y la suma con ganancia y paneo y el paso a 16 bits, con SSE de cuatro en
+ * cuatro.
+ *
+ * Nada se bloquea entre los hilos. Los parmetros de una capa son atmicos que el hilo del
+ * stream lee al empezar cada bloque; el estado de la capa dice de quin es: el hilo principal
+ * llena una libre y la marca para empezar, el del stream la toma, y al terminar o detenerse la
+ * devuelve. `update`, en el hilo principal, suelta los sonidos de las que volvieron.
+ *
+ * Es aparte del grupo de voces de `AudioSystem` y no pasa por l: ocupa una fuente ms, no se
+ * ubica en el mundo y no virtualiza. Lo que necesite posicin va por `AudioSystem`.
+ *
+ * `play`, `stop`, `set...` y `update` van en el hilo principal. Es un servicio
+ * (`TService<SoftwareMixer>`).
+ */
+class
+SoftwareMixer : public sf::SoundStream {
+public:
+	static constexpr uint32_t kLayerCount = 64;
+	static constexpr unsigned int kSampleRate = 44100;
+	static constexpr size_t kBlockFrames = 1024;       ///< Unos 23 ms por bloque.
+
+	SoftwareMixer();
+
+	/**
+	 * @brief Detiene el stream antes de que se destruyan las capas que lee.
+	 */
+	~SoftwareMixer() override;
+
+	/**
+	 * @brief Empieza a mezclar `sound`, que tiene que estar listo.
+	 * @return Nulo si no estaba listo o no hay capa libre.
+	 */
+	MixHandle
+	play(const SoundRef& sound, const MixParams& params = MixParams());
+
+	/**
+	 * @brief Pide detener la capa; el hilo del stream la suelta en su prximo bloque.
+	 */
+	void
+	stop(MixHandle layer);
+
+	/**
+	 * @brief Si la capa sigue sonando o por empezar.
+	 */
+	bool
+	isPlaying(MixHandle layer) const;
+
+	void
+	setGain(MixHandle layer, float gain);
+
+	void
+	setPan(MixHandle layer, float pan);
+
+	void
+	setRate(MixHandle layer, float rate);
+
+	void
+	setLowPass(MixHandle layer, float coefficient);
+
+	/**
+	 * @brief Suelta los sonidos de las capas que terminaron; una vez por frame.
+	 */
+	void
+	update();
+
+	/**
+	 * @brief Capas ocupadas ahora.
+	 */
+	uint32_t
+	activeLayers() const;
+
+protected:
+	bool
+	onGetData(Chunk& data) override;
+
+	/**
+	 * @brief La mezcla no tiene posicin: buscar solo reinicia la cuenta de cortes.
+	 */
+	void
+	onSeek(sf::Time timeOffset) override { m_watch.reset(); }
+
+private:
+	enum class LayerState : uint8_t {
+		Free,         ///< Del hilo principal.
+		Starting,     ///< Lista para que el hilo del stream la tome.
+		Playing,
+		Stopping,     ///< El hilo principal pidi detenerla.
+		Finished,     ///< El stream la solt; `update` la libera.
+	};
+
+	/**
+	 * @brief Una capa. `sound`, `generation` y lo que no es atmico lo escribe el hilo
+	 *        principal solo mientras est libre; `position` y `filter`, solo el del stream.
+	 */
+	struct Layer {
+		std::atomic<LayerState> state{ LayerState::Free };
+		std::atomic<float> gain{ 1.0f };
+		std::atomic<float> pan{ 0.0f };
+		std::atomic<float> rate{ 1.0f };
+		std::atomic<float> lowPass{ 1.0f };
+		SoundRef sound;
+		const sf::Int16* samples = nullptr;
+		size_t frames = 0;
+		unsigned int channels = 1;
+		double step = 1.0;            ///< Cuadros de la fuente por cuadro de salida a `rate` 1.
+		bool loop = true;
+		uint32_t generation = 1;
+		StreamWatch::Clock::time_point requested;
+		double position = 0.0;
+		float filter[2] = { 0.0f, 0.0f };
+	};
+
+	Layer*
+	find(MixHandle handle);
+
+	const Layer*
+	find(MixHandle handle) const;
+
+	/**
+	 * @brief Suma `frames` cuadros de `layer` a `m_mix`.
+	 * @return `false` si la capa lleg al final sin bucle.
+	 */
+	bool
+	mixLayer(Layer& layer, size_t frames);
+
+	std::vector<Layer> m_layers;
+	alignas(16) float m_mix[kBlockFrames * 2];
+	alignas(16) float m_source[kBlockFrames * 2];           ///< Una capa remuestreada y filtrada.
+	alignas(16) sf::Int16 m_output[kBlockFrames * 2];
+	bool m_started = false;
+	StreamWatch m_watch;                                    ///< Del hilo del stream.
+};
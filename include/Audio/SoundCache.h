@@ -0,0 +1,185 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include "Prerequisites.h"
+#include "Jobs/JobSystem.h"
+#include "Scene/PackFile.h"
+
+/**
+ * @class SoundAsset
+ * @brief Un archivo de sonido decodificado una vez; todas las voces que lo reproducen usan el
+ *        mismo `sf::SoundBuffer`.
+ *
+ * Lo crea `SoundCache::load`. Hasta `isReady` el bfer est vaco: el archivo se decodifica en
+ * un trabajo y el cach lo pasa al bfer en su `update`.
+ */
+class
+SoundAsset : public EngineUtilities::TRefCounted<> {
+public:
+	bool
+	isReady() const { return m_ready; }
+
+	/**
+	 * @brief Si el archivo no pudo leerse; no va a estar listo nunca.
+	 */
+	bool
+	hasFailed() const { return m_failed; }
+
+	const sf::SoundBuffer&
+	buffer() const { return m_buffer; }
+
+	const std::string&
+	path() const { return m_path; }
+
+	/**
+	 * @brief Memoria de las muestras, la que cuenta contra el presupuesto del cach.
+	 */
+	size_t
+	bytes() const { return static_cast<size_t>(m_buffer.getSampleCount()) * sizeof(sf::Int16); }
+
+private:
+	friend class SoundCache;
+
+	std::string m_path;
+	PackedAsset m_packed;                ///< En un paquete montado; sin `found`, del disco.
+	sf::SoundBuffer m_buffer;
+	std::vector<sf::Int16> m_samples;    ///< Del trabajo; se sueltan al pasar al bfer.
+	unsigned int m_channels = 0;
+	unsigned int m_sampleRate = 0;
+	bool m_decoded = false;              ///< Del trabajo, antes de pasar por `m_decoded`.
+	bool m_ready = false;
+	bool m_failed = false;
+	uint64_t m_lastUse = 0;              ///< De `SoundCache::touch`; el menor se va primero.
+};
+
+using SoundRef = EngineUtilities::TIntrusivePtr<SoundAsset>;
+
+/**
+ * @class SoundCache
+ * @brief Sonidos compartidos por ruta: se decodifican en los hilos de `JobSystem`, se precargan
+ *        por bancos y se sueltan los menos usados cuando pasan del presupuesto.
+ *
+ * `load` devuelve enseguida el `SoundAsset` de la ruta, el mismo para cualquier emisor que la
+ * pida, y si es nuevo lanza un trabajo que lee las muestras (`sf::InputSoundFile`). `update`,
+ * en el hilo principal, pasa las ledas a su `sf::SoundBuffer` (el bfer de OpenAL se crea en
+ * ese hilo), hasta `uploadBudget` bytes por llamada para que un banco entero no frene un frame,
+ * y despus, si las listas ocupan ms de `budget` bytes, suelta las que hace
+ * ms tiempo nadie pidi ni reprodujo. Solo sale lo que nadie ms referencia y ninguna
+ * reproduccin de `AudioSystem` est usando; lo que queda referenciado puede pasar del
+ * presupuesto.
+ *
+ * `preload` es `load` de un banco entero (los sonidos de un nivel) sin quedarse con las
+ * referencias: quedan en el cach hasta que se usen o se necesite el lugar.
+ *
+ * Solo el hilo principal. Es un servicio (`TService<SoundCache>`).
+ */
+class
+SoundCache {
+public:
+	static constexpr size_t kDefaultBudget = 64u << 20; ///< Bytes: unos seis minutos de estreo a 44,1 kHz.
+	static constexpr size_t kDefaultUploadBudget = 4u << 20; ///< Bytes por `update`: unos 20 s de estreo.
+
+	SoundCache() : m_jobs(EngineUtilities::TService<JobSystem>::instance()) {}
+
+	/**
+	 * @brief Espera las decodificaciones en curso: sus trabajos escriben en los sonidos.
+	 */
+	~SoundCache();
+
+	SoundCache(const SoundCache&) = delete;
+	SoundCache& operator=(const SoundCache&) = delete;
+
+	/**
+	 * @brief Sonido de `path`, compartido; empieza a decodificarlo si es nuevo y cuenta como uso.
+	 */
+	SoundRef
+	load(const std::string& path);
+
+	/**
+	 * @brief Empieza a decodificar todos los de `bank` que no estn ya.
+	 */
+	void
+	preload(std::span<const std::string> bank);
+
+	/**
+	 * @brief Cuenta un uso de `sound`; lo llama quien lo reproduce.
+	 */
+	void
+	touch(SoundAsset& sound) { sound.m_lastUse = ++m_useCounter; }
+
+	/**
+	 * @brief Pasa decodificados a sus bferes, hasta `uploadBudget` bytes (al menos uno), y
+	 *        suelta los menos usados sobre el presupuesto; una vez por frame.
+	 */
+	void
+	update();
+
+	/**
+	 * @brief Espera todas las decodificaciones y las pasa a sus bferes.
+	 */
+	void
+	finishAll();
+
+	void
+	setBudget(size_t bytes) { m_budget = bytes; }
+
+	size_t
+	budget() const { return m_budget; }
+
+	void
+	setUploadBudget(size_t bytes) { m_uploadBudget = bytes; }
+
+	size_t
+	uploadBudget() const { return m_uploadBudget; }
+
+	/**
+	 * @brief Bytes de los sonidos listos.
+	 */
+	size_t
+	residentBytes() const { return m_resident; }
+
+	/**
+	 * @brief Sonidos pedidos que todava no estn listos.
+	 */
+	size_t
+	pendingCount() const { return m_pending; }
+
+	/**
+	 * @brief Sonidos soltados por el presupuesto desde el principio.
+	 */
+	uint64_t
+	evictedCount() const { return m_evicted; }
+
+private:
+	/**
+	 * @brief Pasa decodificados a sus bferes hasta `budget` bytes, al menos uno.
+	 */
+	void
+	upload(size_t budget);
+
+	/**
+	 * @brief Suelta los menos usados que se puedan hasta entrar en `m_budget`.
+	 */
+	void
+	evict();
+
+	JobSystem& m_jobs;
+	JobCounter m_counter;                                ///< Decodificaciones en curso.
+	std::unordered_map<std::string, SoundRef> m_byPath;
+	std::mutex m_queueMutex;
+	std::vector<SoundAsset*> m_decoded;                  ///< Ledos que `update` no tom.
+	std::vector<SoundAsset*> m_uploads;                  ///< Tomados que no entraron en el presupuesto.
+	size_t m_uploadFront = 0;
+	std::vector<SoundAsset*> m_candidates;               ///< De `evict`.
+	size_t m_budget = kDefaultBudget;
+	size_t m_uploadBudget = kDefaultUploadBudget;
+	size_t m_resident = 0;
+	size_t m_pending = 0;
+	uint64_t m_useCounter = 0;
+	uint64_t m_evicted = 0;
+};
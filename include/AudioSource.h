@@ -0,0 +1,104 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+#include "Audio/AudioSystem.h"
+#include "Audio/SoundCache.h"
+
+/**
+ * @class AudioSource
+ * @brief Componente que reproduce un sonido de `AudioSystem` desde su entidad.
+ *
+ * No tiene voz propia: `play` empieza una reproduccin en el sistema y guarda el
+ * `VoiceHandle`, as que mil fuentes calladas no cuestan nada, y de las que suenan solo las que
+ * ms se oyen ocupan una voz de OpenAL. Si es espacial, la reproduccin sigue a su
+ * `Transform` mientras suena, tenga voz o sea virtual: no aqu, sino todas juntas en
+ * `AudioSystem::syncSources`. Al destruirse corta la voz si est en bucle; un sonido
+ * corto (un golpe, una explosin) termina aunque la entidad ya no exista.
+ */
+class
+AudioSource : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::AUDIOSOURCE;
+
+	AudioSource() : Component(ComponentType::AUDIOSOURCE) {}
+
+	~AudioSource() override;
+
+	void
+	update(float deltaTime) override {}
+
+	void
+	render(RenderCommandBuffer& commands) override {}
+
+	/**
+	 * @brief Vincula el `Transform` de la misma entidad; sin l suena desde el origen.
+	 */
+	void
+	setTransform(const Transform* transform) { m_transform = transform; }
+
+	/**
+	 * @brief Sonido de `SoundCache::load`; mientras la fuente lo tenga, el cach no lo suelta.
+	 *        El que ya suena sigue con el anterior.
+	 */
+	void
+	setSound(SoundRef sound) { m_sound = std::move(sound); }
+
+	const SoundRef&
+	getSound() const { return m_sound; }
+
+	/**
+	 * @brief Volumen, tono, prioridad y dems para el prximo `play`.
+	 */
+	void
+	setParams(const SoundParams& params) { m_params = params; }
+
+	const SoundParams&
+	getParams() const { return m_params; }
+
+	/**
+	 * @brief Volumen de 0 a 100; tambin cambia el de la voz que est sonando.
+	 */
+	void
+	setVolume(float volume);
+
+	void
+	setLoop(bool loop) { m_params.loop = loop; }
+
+	/**
+	 * @brief Si suena desde la posicin de la entidad o igual desde cualquier lado.
+	 */
+	void
+	setSpatial(bool spatial) { m_params.spatial = spatial; }
+
+	void
+	setPriority(int32_t priority) { m_params.priority = priority; }
+
+	/**
+	 * @brief Reproduce el sonido; corta antes lo que esta fuente tena sonando.
+	 * @return `false` si no hay sonido, todava no se decodifica o el sistema ya tena todas
+	 *         las reproducciones que admite.
+	 */
+	bool
+	play();
+
+	void
+	stop();
+
+	bool
+	isPlaying() const;
+
+private:
+	friend class AudioSystem;
+
+	sf::Vector2f
+	worldPosition() const;
+
+	const Transform* m_transform = nullptr;
+	SoundRef m_sound;
+	SoundParams m_params;
+	VoiceHandle m_voice;
+};
@@ -1,8 +1,88 @@
 #pragma once
+#include <deque>
 #include "Prerequisites.h"
 #include "Window.h"
 #include "ShapeFactory.h"
+#include "MeshRenderer.h"
+#include "Camera.h"
 #include "Actor.h"
+#include "ActorPrefab.h"
+#include "ComponentUpdater.h"
+#include "Render/RenderCommandBuffer.h"
+#include "ECS/EntityCommandBuffer.h"
+#include "ECS/SaveJournal.h"
+#include "ECS/SystemScheduler.h"
+#include "Jobs/ParallelFor.h"
+#include "Jobs/TaskGraph.h"
+#include "Events/EventBus.h"
+#include "Events/EngineEvents.h"
+#include "Events/TimerWheel.h"
+#include "Scene/SceneFile.h"
+#include "Scene/SceneWriter.h"
+#include "Scene/SceneText.h"
+#include "ScalingReport.h"
+#include "Render/SpatialGrid.h"
+#include "Render/RenderCapture.h"
+#include "Render/RenderThread.h"
+#include "Render/FramePacer.h"
+#include "Render/MeshLoader.h"
+#include "Render/ParticleSystem.h"
+#include "ParticleEmitter.h"
+#include "Tilemap.h"
+#include "Sprite.h"
+#include "PointLight.h"
+#include "AudioSource.h"
+#include "Audio/SoftwareMixer.h"
+#include "Steering.h"
+#include "PathLibrary.h"
+#include "Navigation/Pathfinder.h"
+#include "Navigation/FlowField.h"
+#include "Physics/PhysicsWorld.h"
+#include "Simulation/InputLog.h"
+#include "Input/InputSystem.h"
+#include "Animation/AnimationLibrary.h"
+#include "Math/Random.h"
+#include "Picking.h"
+#include "AssetManager.h"
+#include "AssetStreamer.h"
+#include "Net/NetSession.h"
+#include "Memory/HeapTracker.h"
+#include "Profiling/Console.h"
+#include "Profiling/EntityCostProfiler.h"
+#include "Profiling/FrameTimeHistogram.h"
+#include "Profiling/Microbenchmark.h"
+#include "Profiling/PerfBaseline.h"
+#include "Profiling/HitchRecorder.h"
+#include "Profiling/TraceCapture.h"
+
+/**
+ * @brief Parmetros de `BaseApp::runScalingBenchmark`.
+ */
+struct ScalingBenchmarkOptions {
+    std::vector<size_t> actorCounts{ 1000, 10000, 100000, 1000000 }; ///< Tamaos de escena, en orden.
+    uint32_t warmupFrames = 30;     ///< Frames sin medir al empezar cada tamao.
+    uint32_t measuredFrames = 300;  ///< Frames medidos por tamao.
+    std::string outputPath = "scaling.csv"; ///< `.json` para JSON; CSV si no.
+    bool instancedRendering = false; ///< Figuras con `InstancedShapeRenderer` en vez de SFML.
+    bool sdfShapes = false;          ///< Crculos y polgonos con `SdfShapeRenderer`, un quad cada uno.
+    bool gpuCrowd = false;           ///< Los guardias como agentes de `GpuCrowd`, movidos y dibujados en la GPU, sin actores.
+    bool headless = false;           ///< Sin pantalla ni vsync (`Window` con `headless`).
+    bool renderThread = false;       ///< Dibujar en un `RenderThread`; render mide solo grabar y entregar.
+    std::vector<unsigned> threadCounts; ///< Hilos a probar en cada tamao, el principal incluido; `{0}` de 1 a todos; vaco, sin barrido.
+    BaselineOptions baseline;        ///< Guardar o comparar lo medido (`PerfBaseline`).
+};
+
+/**
+ * @brief Parmetros de `BaseApp::runRenderReplay`.
+ */
+struct RenderReplayOptions {
+    std::string capturePath;         ///< Archivo de `RenderCapture`.
+    uint32_t warmupLoops = 1;        ///< Vueltas a la captura sin medir.
+    uint32_t measuredLoops = 10;     ///< Vueltas medidas.
+    std::string outputPath = "render_replay.csv"; ///< Como el de `runScalingBenchmark`.
+    bool headless = false;
+    BaselineOptions baseline;
+};
 
 class BaseApp {
 public:
@@ -30,15 +110,401 @@ public:
      */
     int run();
 
+    /**
+     * @brief Modo de medicin: en vez del bucle normal, llena la escena con
+     *        `options.actorCounts[i]` actores que recorren los waypoints y mide cada tamao.
+     *
+     * Cada frame usa un paso fijo de 1/60 s, as que las corridas de dos versiones hacen el
+     * mismo trabajo. Por tamao guarda update y render promedio, percentiles del frame y la
+     * memoria del proceso, y al final escribe todo en `options.outputPath`.
+     *
+     * Con `options.threadCounts` repite cada tamao con esos hilos (`JobSystem::setActiveWorkers`)
+     * y mide adems update, movimiento, fsica y lista de dibujo por sus zonas del profiler, con
+     * la aceleracin, la eficiencia y la fraccin serial contra la primera corrida del tamao.
+     *
+     * @return 0 si pudo escribir los resultados, 2 si hubo regresiones contra la lnea base.
+     */
+    int runScalingBenchmark(const ScalingBenchmarkOptions& options);
+
+    /**
+     * @brief Modo de medicin de caminos calientes: `getComponent`, `addComponent`, `Seek`,
+     *        `BehaviorScheduler::tick`, `SceneGraph::update`, `Actor::render` con sus lotes y los punteros de `EngineUtilities`,
+     *        cada uno con cada tamao de `options` (`MicrobenchmarkSuite`). No abre ventana.
+     *
+     * @return 0 si pudo escribir los resultados, 2 si hubo regresiones contra la lnea base.
+     */
+    int runMicrobenchmarks(const MicrobenchmarkOptions& options);
+
+    /**
+     * @brief Modo de medicin del render solo: abre la ventana sin escena ni simulacin y dibuja
+     *        una y otra vez los frames de `options.capturePath` (`RenderCapture`).
+     *
+     * Por frame mide el envo y la GPU; el resultado sale como una fila de `ScalingReport`, con
+     * los comandos por frame en lugar de los actores, y se compara con `PerfBaseline` igual.
+     *
+     * @return 0 si pudo escribir los resultados, 1 si no pudo leer la captura o escribir, 2 si
+     *         hubo regresiones contra la lnea base.
+     */
+    int runRenderReplay(const RenderReplayOptions& options);
+
+    /**
+     * @brief Con `true`, `run` dibuja en un `RenderThread`: la simulacin del frame siguiente
+     *        corre mientras se enva y se muestra el actual. Se elige antes de `run`.
+     */
+    void setRenderThread(bool enabled) { m_useRenderThread = enabled; }
+
+    /**
+     * @brief Pasos de simulacin por segundo de `run`; 0 vuelve al paso variable (un `update`
+     *        por frame con el tiempo real).
+     *
+     * Con paso fijo, cada frame corre los pasos enteros que caben en el tiempo acumulado (a lo
+     * ms `kMaxStepsPerFrame`) y dibuja interpolando entre los dos ltimos estados
+     * (`Transform::getRenderTransform`). Simulacin y render dejan de depender entre s: 30 Hz
+     * de simulacin se ven fluidos a 144 Hz, y la misma entrada da siempre el mismo resultado.
+     */
+    void setSimulationRate(float hz) { m_simulationStep = hz > 0.0f ? 1.0f / hz : 0.0f; }
+
+    /**
+     * @brief Con `true`, `run` y `runScalingBenchmark` dibujan en una textura, con la ventana
+     *        oculta y sin vsync: para medir sin pantalla. Se elige antes de `run`.
+     */
+    void setHeadless(bool enabled) { m_headless = enabled; }
+
+    /**
+     * @brief Con `true`, la ventana nace en un `EventPump` y sus mensajes se atienden en ese
+     *        hilo: arrastrarla o cambiarle el tamao (el bucle modal de Windows) no detiene la
+     *        simulacin ni la red. Se elige antes de `run`.
+     */
+    void setEventThread(bool enabled) { m_eventThread = enabled; }
+
+    /**
+     * @brief Con `true`, `run` solo simula: no crea la ventana ni un contexto de OpenGL, no lee
+     *        eventos y no dibuja. Cada vuelta es un paso fijo (el de `setSimulationRate`, o
+     *        `kDefaultSimulationHz` si era variable), tan rpido como se pueda o, con `realtime`,
+     *        uno por paso de tiempo real. `setFrameLimit` cuenta pasos. Se elige antes de `run`.
+     */
+    void setServer(bool enabled, bool realtime = false) { m_server = enabled; m_serverRealtime = realtime; }
+
+    /**
+     * @brief `run` termina tras `frames` frames e imprime cuntos dibuj por segundo; 0 no
+     *        tiene lmite (sin pantalla, usa `kDefaultHeadlessFrames`).
+     */
+    void setFrameLimit(uint32_t frames) { m_frameLimit = frames; }
+
+    /**
+     * @brief Con la ventana, `run` no pasa de `hz` frames por segundo; 0 no tiene tope. Con el
+     *        refresco de la pantalla conocido, baja al divisor de l ms cercano
+     *        (`FramePacer::alignToRefresh`). Espera con `FramePacer`.
+     */
+    void setFrameCap(float hz) { m_frameCap = hz > 0.0f ? hz : 0.0f; }
+
+    /**
+     * @brief Refresco de la pantalla en Hz para alinear el tope; 0 (por defecto) lo pregunta al
+     *        sistema al arrancar, donde se pueda (`FramePacer::displayRefreshRate`).
+     */
+    void setDisplayRefresh(double hz) { m_refreshHz = hz > 0.0 ? hz : 0.0; }
+
+    /**
+     * @brief Con `true`, la ventana sin foco, o sin entrada ni componentes que cambien durante
+     *        `idleAfter` segundos, baja a `idleHz` frames por segundo; con `idleHz` en 0 duerme
+     *        hasta el prximo evento. Cualquier entrada despierta en el acto (`Window::waitForEvent`).
+     *        Sin pantalla no hace nada.
+     */
+    /**
+     * @brief Con `true`, `render` no graba, dibuja ni presenta los frames en que nada visible
+     *        cambi desde el ltimo presentado (`needsRedraw`); la simulacin sigue igual.
+     */
+    void setRedrawOnChange(bool enabled) { m_redrawOnChange = enabled; }
+
+    /**
+     * @brief Dibuja el prximo frame aunque no haya cambios; para lo que se ve distinto sin
+     *        pasar por `Component::markChanged`.
+     */
+    void requestRedraw() { m_redrawRequested = true; }
+
+    /**
+     * @brief Vistas con que se dibuja cada frame, en orden, cada una en su viewport: pantalla
+     *        dividida, minimapa, imagen dentro de imagen. Vaco, solo la vista de la ventana.
+     *
+     * Las entidades se recorren y se graban una sola vez para todas: el `SpatialGrid` se
+     * consulta con las reas de todas juntas, cada entidad que toca alguna graba sus comandos
+     * una vez, se ordenan una vez y `Window::submit` los dibuja con cada vista. El nivel de
+     * detalle es el de la vista que ms pxeles da por unidad.
+     */
+    void setViews(std::span<const sf::View> views) {
+        m_views.assign(views.begin(), views.end());
+        m_redrawRequested = true;
+    }
+
+    std::span<const sf::View> views() const { return m_views; }
+
+    void setIdleMode(bool enabled, float idleHz = kIdleHz, float idleAfter = kIdleAfterSeconds) {
+        m_idleMode = enabled;
+        m_idleHz = idleHz > 0.0f ? idleHz : 0.0f;
+        m_idleAfter = idleAfter;
+    }
+
+    /**
+     * @brief Cada `seconds` segundos `run` imprime los percentiles del frame, de update y de
+     *        render y los tirones del perodo (`FrameTimeMonitor`); el overlay los muestra siempre.
+     */
+    void setFrameTimeLog(double seconds) { m_frameTimes.setPeriod(seconds); m_frameTimeLog = seconds > 0.0; }
+
+    /**
+     * @brief Con `true`, `initialize` arma la pila de efectos de la ventana con un bloom a un
+     *        cuarto de resolucin y una correccin de color (`Window::postProcess`).
+     */
+    void setPostProcessing(bool enabled) { m_postProcessing = enabled; }
+
+    /**
+     * @brief Con un objetivo mayor que 0, `initialize` enciende la resolucin dinmica de la
+     *        ventana para sostener `targetMs` milisegundos de GPU por frame.
+     */
+    void setDynamicResolution(double targetMs) { m_dynamicResolutionMs = targetMs; }
+
+    /**
+     * @brief Con una carpeta, `run` guarda cada frame en ella como PNG (`FrameCapture`). F12
+     *        guarda una captura en cualquier momento.
+     */
+    void setRecordDirectory(const std::string& directory) { m_recordDirectory = directory; }
+
+    /**
+     * @brief `initialize` agrega `count` agentes que siguen al mouse por un `FlowField`, todos
+     *        con el mismo campo.
+     */
+    void setCrowdSize(uint32_t count) { m_crowdSize = count; }
+
+    /**
+     * @brief Con `true`, `run` simula en modo lockstep: el estado de cada paso depende solo de
+     *        la escena y de las entradas hasta ese paso, en cualquier corrida y mquina.
+     *
+     * El paso es fijo (el de `setSimulationRate`, o `kDefaultSimulationHz` si era variable),
+     * `update` lee la entrada de un `TickInput` y nunca del reloj, el punto flotante se fija con
+     * `Determinism`, `PhysicsWorld` va en modo determinista y los caminos pedidos en un paso se
+     * entregan en el siguiente, sin depender de cunto tardan los hilos. Al terminar imprime
+     * el `Determinism::checksum` del mundo, para comparar dos corridas.
+     */
+    void setLockstep(bool enabled) { m_lockstep = enabled; }
+
+    /**
+     * @brief Lockstep, agregando a `path` la entrada de cada paso y las rdenes escritas en la
+     *        consola a medida que se juegan (`InputLog`): si el juego se cae, queda hasta ah.
+     */
+    void setInputRecording(const std::string& path) { m_inputRecordPath = path; m_lockstep = true; }
+
+    /**
+     * @brief Lockstep, repitiendo las entradas de `path` con su paso; `run` termina cuando se acaban.
+     *        Con `setServer` no espera a nadie: es una carga de medicin tomada de una sesin real.
+     */
+    void setInputReplay(const std::string& path) { m_inputReplayPath = path; m_lockstep = true; }
+
+    /**
+     * @brief Al repetir en la ventana, pasos de simulacin por cada paso de tiempo real (hasta
+     *        `speed` veces `kMaxStepsPerFrame` por frame); 1 es tiempo real.
+     */
+    void setReplaySpeed(float speed) { m_replaySpeed = speed > 0.0f ? speed : 1.0f; }
+
+    /**
+     * @brief Con una frecuencia mayor que 0, `run` lee teclado y mouse en otro hilo esas veces
+     *        por segundo (`InputSystem::startSampling`).
+     */
+    void setInputSampleRate(float rate) { m_inputSampleRate = rate; }
+
+    /**
+     * @brief Con una ruta, al primer frame `run` imprime cunto tard cada tarea de
+     *        `initialize` y guarda la lnea de tiempo del arranque en ella (`TaskGraph::writeTrace`).
+     */
+    void setStartupTrace(const std::string& path) { m_startupTracePath = path; }
+
+    /**
+     * @brief Guarda las zonas del profiler de los primeros `frames` frames en `path`, para
+     *        `chrome://tracing` o Perfetto (`TraceCapture`). F4 hace lo mismo en cualquier momento.
+     */
+    void setProfileTrace(const std::string& path, uint32_t frames = TraceCapture::kDefaultFrames);
+
+    /**
+     * @brief Con `thresholdMs` mayor que 0, cada frame que tarde ms escribe los ltimos `seconds`
+     *        del profiler en `hitch_N.json` (`HitchRecorder`); deja el profiler encendido. 0 apaga.
+     */
+    void setHitchTrace(double thresholdMs, double seconds = HitchRecorder::kDefaultSeconds);
+
+    /**
+     * @brief Guarda los comandos de dibujo de los prximos `frames` frames en `path`, para
+     *        `runRenderReplay`. Sin hilo de render: las texturas se leen con su contexto.
+     */
+    void setRenderCapture(const std::string& path, uint32_t frames);
+
+    /**
+     * @brief Con una ruta, `initialize` devuelve a la escena los componentes de datos guardados
+     *        ah y `update` guarda lo que cambi cada `kCheckpointSteps` pasos (`SaveJournal`).
+     */
+    void setSaveJournal(const std::string& path) { m_journalPath = path; }
+
+    /**
+     * @brief `initialize` monta el paquete `path` (`PackLibrary`) antes de cargar nada; el
+     *        ltimo agregado tiene prioridad.
+     */
+    void addPack(const std::string& path) { m_packPaths.push_back(path); }
+
+    /**
+     * @brief Con `true` solo se carga lo cocido (`ContentCook`): la escena `kScenePath`, mallas
+     *        `.gmsh` y texturas `.dds`; las fuentes fallan en vez de convertirse al cargar.
+     */
+    void setCookedOnly(bool cookedOnly) { m_cookedOnly = cookedOnly; }
+
+    /**
+     * @brief Con un puerto, `update` manda los actores de la escena a los clientes que se
+     *        conecten ah (`NetSession::host`).
+     */
+    void setNetHost(unsigned short port) { m_netAddress.clear(); m_netPort = port; }
+
+    /**
+     * @brief `update` pone en los actores de la escena lo que manda el servidor de
+     *        `address:port`, interpolado; los dos deben cargar la misma escena.
+     */
+    void setNetConnect(const std::string& address, unsigned short port) { m_netAddress = address; m_netPort = port; }
+
+    /**
+     * @brief Al cerrar la red escribe en `path` lo que midi de cada conexin (`NetStats::write`).
+     */
+    void setNetStatsPath(const std::string& path) { m_net.setStatsPath(path); }
+
+    /**
+     * @brief rdenes de consola (`Console::execute`, separadas por `;`) que `initialize` corre
+     *        al terminar, como si se escribieran al abrir; se pueden agregar varias.
+     */
+    void addConsoleCommands(const std::string& line) { m_consoleCommands.push_back(line); }
+
+    /**
+     * @brief La consola de la aplicacin; la tecla de la tilde la abre en la ventana.
+     */
+    Console& console() { return m_console; }
+
+    static constexpr uint32_t kDefaultHeadlessFrames = 600;
+    static constexpr unsigned int kWindowWidth = 800;
+    static constexpr unsigned int kWindowHeight = 600; ///< Tambin el rea de la escena sin ventana.
+    static constexpr float kDefaultSimulationHz = 60.0f;
+    static constexpr uint32_t kMaxStepsPerFrame = 8; ///< Tras una pausa larga se descarta el resto en vez de ponerse al da.
+    static constexpr float kNavCellSize = 16.0f; ///< Unidades por celda del `NavGrid` de la escena.
+    static constexpr uint32_t kTrailSeed = 0x2545F491u; ///< Semilla de la estela del crculo.
+    static constexpr uint64_t kRandomSeed = RandomService::kDefaultSeed; ///< Semilla de `RandomService` en lockstep.
+    static constexpr size_t kAnimationBudget = 20000; ///< Actores animados muestreados por paso, como mximo.
+    static constexpr size_t kRecordGrain = 1024; ///< Entidades por trozo de `recordEntities` en paralelo.
+    static constexpr uint32_t kHeapWarmupFrames = 120; ///< Frames de carga antes de exigir cero reservas.
+    static constexpr uint32_t kHeapWarningFrames = 300; ///< Frames entre avisos de reservas del heap.
+    static constexpr uint32_t kCheckpointSteps = 60; ///< Pasos entre dos `SaveJournal::checkpoint`.
+    static constexpr float kIdleHz = 10.0f;          ///< Frames por segundo del modo ocioso.
+    static constexpr float kIdleAfterSeconds = 2.0f; ///< Quietud que lo activa con foco.
+
     /**
      * @brief Inicializa los componentes de la aplicacin.
      *
      * Realiza configuraciones iniciales, como la creacin de la ventana, actores y otros recursos necesarios para ejecutar la aplicacin.
+     * Cada paso es una tarea de `m_startup`: la ventana en este hilo, la escena y los sistemas
+     * a la vez en el `JobSystem`.
      *
      * @return `true` si la inicializacin es exitosa, `false` si ocurre algn fallo.
      */
     bool initialize();
 
+    /**
+     * @brief La ventana con sus efectos, grabacin y resolucin dinmica; nada en modo servidor.
+     */
+    void createWindow();
+
+    /**
+     * @brief Lo que la escena recin cargada necesita para correr: decorado esttico,
+     *        colisionadores y el recorrido y la estela del crculo. Al arrancar y al recargarla.
+     */
+    void setupScene();
+
+    /**
+     * @brief Sistemas por frame, eventos y actualizacin de los componentes.
+     */
+    void registerSystems();
+
+    /**
+     * @brief Variables y comandos de `m_console`: culling, lotes, instancing, SDF, nivel de
+     *        detalle, hilos, vsync, paso fijo, overlay, `spawn`, `despawn` y `capture`.
+     */
+    void registerConsole();
+
+    /**
+     * @brief Con la consola abierta, le pasa lo escrito en el frame y muestra su texto.
+     */
+    void updateConsole();
+
+    /**
+     * @brief Muestra u oculta el overlay; el profiler mide mientras se ve o hay una traza.
+     */
+    void showStats(bool visible);
+
+    /**
+     * @brief Tamao del rea de la escena: el de la ventana o, sin ella, `kWindowWidth` por `kWindowHeight`.
+     */
+    sf::Vector2u sceneSize() { return m_window ? m_window->presentTarget().getSize() : sf::Vector2u(kWindowWidth, kWindowHeight); }
+
+    /**
+     * @brief Anota el primer frame (o paso, en modo servidor) en `m_startup`, dice cunto tard
+     *        y, con `setStartupTrace`, guarda la lnea de tiempo.
+     */
+    void finishStartup();
+
+    /**
+     * @brief Cierra el frame del `Profiler`, con el overlay visible le pasa el desglose y, si
+     *        hay una traza en curso, le agrega el frame. Tambin cierra el de `m_entityCosts`.
+     */
+    void endProfileFrame();
+
+    /**
+     * @brief Suma en `report` lo que tardaron en el ltimo frame del profiler las zonas de
+     *        `ScalingReport::systemZone`.
+     */
+    void addScalingSystems(ScalingReport& report) const;
+
+    /**
+     * @brief Tiempos del frame que termin, en milisegundos; al cerrar un perodo los imprime
+     *        (con `setFrameTimeLog`) y se los pasa al overlay.
+     */
+    void recordFrameTimes(double frameMs, double updateMs, double renderMs);
+
+    /**
+     * @brief Avisa una vez por categora cuando el pico de `MemoryAccounting` pasa su presupuesto.
+     */
+    void checkMemoryBudgets();
+
+    /**
+     * @brief Con una captura en curso, agrega el frame de `commands` y la escribe al completarla.
+     */
+    void captureRenderFrame(const RenderCommandBuffer& commands, const sf::View& view);
+
+    /**
+     * @brief Con `ENGINE_HEAP_HOOKS`, pasados `kHeapWarmupFrames` marca el rgimen estable y avisa
+     *        (cada `kHeapWarningFrames` como mucho) si el ltimo frame reserv en el heap.
+     * @param frames Frames ya terminados de `run`.
+     */
+    void checkHeapAllocations(uint32_t frames);
+
+    /**
+     * @brief Con `setIdleMode`, si la aplicacin est ociosa: sin foco, o sin entrada ni cambios
+     *        de componentes (`lastChangeTick`) desde hace `m_idleAfter` segundos.
+     */
+    bool isIdle();
+
+    /**
+     * @brief Espera, al final de un frame con ventana, lo que falte hasta `nextFrame` segn el
+     *        tope o el modo ocioso, y lo avanza.
+     * @return `true` si durmi hasta un evento sin lmite: ese tiempo no se simula.
+     */
+    bool paceFrame(std::chrono::steady_clock::time_point& nextFrame);
+
+    /**
+     * @brief Deja en `m_input` la entrada del paso siguiente: del registro al repetir; si no,
+     *        del mouse, y en lockstep la anota.
+     * @return `false` cuando la repeticin se acab.
+     */
+    bool sampleInput();
+
     /**
      * @brief Actualiza el estado de la aplicacin en cada frame.
      *
@@ -53,6 +519,35 @@ public:
      */
     void render();
 
+    /**
+     * @brief Con `setRedrawOnChange`, si el frame puede verse distinto del ltimo presentado:
+     *        algn componente o columna escrito (`lastChangeTick`), entrada o eventos de la
+     *        ventana, otra vista, el overlay o la consola abiertos, partculas vivas, mallas o
+     *        texturas por llegar, una captura en curso o `requestRedraw`. Con paso fijo, lo que
+     *        cambi se redibuja hasta el paso siguiente, porque se sigue interpolando.
+     */
+    bool needsRedraw();
+
+    /**
+     * @brief Graba en `commands` los comandos de las entidades que se ven con alguna de `views`,
+     *        cada una una vez, y los ordena.
+     */
+    void recordVisible(RenderCommandBuffer& commands, std::span<const sf::View> views);
+
+    /**
+     * @brief Vistas del frame: las de `setViews` o, sin ellas, la de la ventana (o la del hilo de render).
+     */
+    std::span<const sf::View> frameViews();
+
+    /**
+     * @brief Graba los comandos de `entities` en `commands`, en el mismo orden que de a una.
+     *
+     * Con `r_parallel_record` y trabajo para ms de un trozo, cada trozo de entidades graba en
+     * su propio buffer de `m_recordBuffers` en un hilo del job system, y los buffers se juntan
+     * en orden. Con capas en `LayerCache` se graba en un hilo: sus `render` le anotan cambios.
+     */
+    void recordEntities(RenderCommandBuffer& commands, std::span<Entity* const> entities);
+
     /**
      * @brief Limpia los recursos utilizados por la aplicacin.
      *
@@ -61,33 +556,153 @@ public:
     void cleanup();
 
     /**
-     * @brief Actualiza el movimiento del crculo.
-     *
-     * Esta funcin maneja el movimiento de un actor circular basado en el `deltaTime` proporcionado.
-     * Puede incluir lgica de navegacin o movimiento basado en waypoints.
+     * @brief Actualiza en el `SpatialGrid` la caja de las entidades cuyo `Transform` o figura
+     *        cambiaron desde `since`; el resto no se revisa.
+     */
+    static void updateSpatialIndex(World& world, uint32_t since);
+
+    /**
+     * @brief Escena cocida que carga `initialize`. F5 la guarda.
+     */
+    static constexpr const char* kScenePath = "main.gscn";
+
+    /**
+     * @brief Escena en texto (`SceneText`) que carga `initialize` si es ms nueva que
+     *        `kScenePath` o si esa no existe; `--cook-scene` la convierte.
+     */
+    static constexpr const char* kSceneSourcePath = "main.scene";
+
+    /**
+     * @brief La que carga `initialize`: `kScenePath` o `kSceneSourcePath`, la ms nueva de
+     *        las que existen, o `kScenePath` si solo est en un paquete; vaca si no hay
+     *        ninguna. Con `setCookedOnly`, siempre `kScenePath`.
+     */
+    std::string scenePath() const;
+
+    static constexpr EntityMask kTagWaypointFollower = 1ull << 0; ///< Actor que recorre los waypoints (el crculo).
+    static constexpr EntityMask kTagScenery = 1ull << 1;          ///< Actor quieto de la escena (el tringulo).
+
+    /**
+     * @brief Carga los actores y waypoints de una escena `.gscn` (de un paquete montado o del
+     *        disco) o `.scene`, reemplazando los actuales.
+     * @return `false` si el archivo no existe o no es vlido; la escena actual no cambia.
+     */
+    bool loadScene(const std::string& path);
+
+    /**
+     * @brief Guarda los actores de la escena y los waypoints en `path`.
+     * @return `false` si no pudo escribirse.
+     */
+    bool saveScene(const std::string& path) const;
+
+    /**
+     * @brief Arenas de memoria temporal por frame.
      *
-     * @param deltaTime Tiempo transcurrido desde el ltimo frame, utilizado para asegurar un movimiento suave.
-     * @param circle Puntero compartido (`TSharedPointer`) al actor que representa el crculo que se actualizar.
+     * `run` la reinicia al inicio de cada frame. Vectores temporales, claves de ordenamiento y
+     * listas de comandos deben reservar aqu (`frameArena().allocator<T>()`) en vez del heap;
+     * lo reservado en un frame sigue vivo durante el siguiente para el hilo de render.
      */
-    void updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Actor> circle);
+    EngineUtilities::FrameArena& frameArena() { return m_frameArena; }
 
 private:
     sf::Clock clock; ///< Reloj utilizado para medir el tiempo entre frames.
     sf::Time deltaTime; ///< Almacena el tiempo transcurrido desde el ltimo frame.
 
-    Window* m_window; ///< Puntero a la ventana principal de la aplicacin.
+    Window* m_window = nullptr; ///< Puntero a la ventana principal de la aplicacin; nulo en modo servidor.
+
+    EngineUtilities::FrameArena m_frameArena{ EngineUtilities::LinearArena::kDefaultCapacity, EngineUtilities::MemoryCategory::Render }; ///< Memoria temporal de dos frames, alternada en `run`.
+
+    SystemScheduler m_systems{ EngineUtilities::TService<JobSystem>::instance() }; ///< Sistemas por frame; los que no chocan corren en paralelo.
+    std::vector<Entity*> m_visibleEntities; ///< Resultado de la consulta a `SpatialGrid` en `render`; conserva su capacidad.
+    std::deque<RenderCommandBuffer> m_recordBuffers; ///< Uno por trozo de `recordEntities`; conservan su capacidad.
+    bool m_parallelRecord = true; ///< `r_parallel_record`.
+    sf::FloatRect m_visibleArea; ///< Caja de lo que se vio en el ltimo `recordVisible`; gua el nivel de detalle de las animaciones.
+    std::vector<sf::View> m_views; ///< De `setViews`.
+    std::vector<sf::FloatRect> m_viewAreas; ///< Lo que ve cada vista del frame, para una sola consulta al `SpatialGrid`.
+    RenderThread m_renderThread; ///< Solo con `setRenderThread(true)`; se detiene antes de destruir la ventana.
+    sf::View m_renderView; ///< Vista de los frames del hilo de render; la de la ventana es suya mientras corre.
+    bool m_useRenderThread = false;
+    bool m_headless = false;
+    bool m_eventThread = false;         ///< `setEventThread`.
+    bool m_server = false;
+    bool m_serverRealtime = false;
+    bool m_postProcessing = false;
+    double m_dynamicResolutionMs = 0.0; ///< Objetivo de `Window::setDynamicResolution`; 0 apagada.
+    std::string m_recordDirectory;      ///< Vaca: sin grabar.
+    uint32_t m_screenshots = 0;         ///< Capturas de F12, para numerarlas.
+    uint32_t m_profileTraces = 0;       ///< Trazas de F4, para numerarlas.
+    TraceCapture m_profileTrace;
+    HitchRecorder m_hitches;
+    JobTelemetry m_jobTelemetry;        ///< De `JobSystem::collectTelemetry`, cada frame medido.
+    EntityCostProfiler m_entityCosts;   ///< `prof_entities`: lo que cuesta cada actor, muestreado.
+    EntityCostReport m_entityCostReport; ///< Lo ltimo que se pas al overlay; conserva su capacidad.
+    RenderCapture m_renderCapture;      ///< Frames grabados por `setRenderCapture`.
+    std::string m_renderCapturePath;
+    uint32_t m_renderCaptureFrames = 0; ///< Frames que faltan; 0 sin captura.
+    FrameTimeMonitor m_frameTimes;
+    bool m_frameTimeLog = false;        ///< De `setFrameTimeLog`.
+    uint32_t m_overBudget = 0;          ///< Un bit por `MemoryCategory` ya avisada.
+    uint32_t m_heapWarnedFrame = 0;     ///< Frame del ltimo aviso de `checkHeapAllocations`; 0 sin avisos.
+    uint32_t m_frameLimit = 0; ///< Frames de `run`; 0 sin lmite.
+    float m_frameCap = 0.0f; ///< De `setFrameCap`.
+    double m_refreshHz = 0.0; ///< De `setDisplayRefresh`, o el de la pantalla; 0 sin saberlo.
+    FramePacer m_framePacer; ///< Espera del tope de frames.
+    bool m_idleMode = false; ///< De `setIdleMode`.
+    float m_idleHz = kIdleHz;
+    float m_idleAfter = kIdleAfterSeconds;
+    bool m_redrawOnChange = false; ///< De `setRedrawOnChange`.
+    bool m_redrawRequested = false;
+    bool m_hasPresented = false; ///< Ya hay un frame presentado con que comparar.
+    bool m_skippedPresent = false; ///< El ltimo `render` no dibuj.
+    uint64_t m_skippedPresents = 0; ///< Frames que `render` no dibuj.
+    uint32_t m_redrawTick = 0; ///< Tick de cambios del `needsRedraw` anterior.
+    uint32_t m_redrawUntilStep = 0; ///< Con paso fijo, ltimo paso que se redibuja tras un cambio.
+    sf::View m_presentedView; ///< Vista del ltimo frame presentado.
+    std::chrono::steady_clock::time_point m_presentedInput; ///< `Window::lastInputTime` de ese frame.
+    bool m_idleWaited = false; ///< El frame anterior termin en una espera ociosa: el que sigue no cuenta como tirn.
+    uint32_t m_idleTick = 0; ///< Tick de cambios del frame anterior, para `isIdle`.
+    std::chrono::steady_clock::time_point m_lastActivity; ///< ltimo cambio de componentes visto.
+    float m_simulationStep = 1.0f / kDefaultSimulationHz; ///< Segundos por paso; 0 es paso variable.
+    float m_accumulator = 0.0f; ///< Tiempo real an no simulado.
+    RenderCommandBuffer m_renderCommands; ///< Dibujos del frame; conserva su capacidad entre frames.
+    ComponentUpdater m_componentUpdater; ///< `update` de los componentes de los actores, por lotes cuando el tipo lo registra.
+    SteeringSystem m_steering; ///< Mueve a los `SteeringAgent`; sus arreglos conservan la capacidad.
+    FlowField m_crowdField; ///< Campo hacia el mouse que siguen los `FlowFollower`.
+    UpdateLod m_aiLod; ///< A quin le toca decidir y girar en cada paso, segn la vista.
+    uint32_t m_crowdSize = 0; ///< Agentes de la multitud de `setCrowdSize`.
+    bool m_lockstep = false;
+    std::string m_inputRecordPath; ///< Vaca: sin guardar las entradas.
+    std::string m_inputReplayPath; ///< Vaca: entrada del mouse.
+    float m_replaySpeed = 1.0f; ///< Ver `setInputReplay`.
+    InputLog m_inputLog; ///< Lo que se graba o se repite.
+    TickInput m_input; ///< Entrada del paso que corre ahora.
+    Entity* m_hovered = nullptr; ///< Actor bajo el mouse en el ltimo paso; solo vale durante ese paso.
+    uint32_t m_tick = 0; ///< Pasos simulados en lockstep.
+    float m_inputSampleRate = 0.0f; ///< 0: la entrada llega solo con los eventos de la ventana.
+    TaskGraph m_startup; ///< Tareas de `initialize`; su lnea de tiempo sigue hasta el primer frame.
+    std::string m_startupTracePath; ///< Vaca: sin guardar la lnea de tiempo del arranque.
+    SaveJournal m_journal; ///< Abierto solo con `setSaveJournal`.
+    std::string m_journalPath; ///< Vaca: sin guardar la partida.
+    uint32_t m_stepsSinceCheckpoint = 0;
+    std::vector<std::string> m_packPaths; ///< De `addPack`, en orden.
+    bool m_cookedOnly = false;
+    NetSession m_net; ///< Abierta solo con `setNetHost` o `setNetConnect`.
+    std::string m_netAddress; ///< Vaca: servidor.
+    unsigned short m_netPort = 0; ///< 0: sin red.
+    NetStats m_netStats; ///< Para el overlay; conserva su capacidad.
+    Console m_console;
+    std::vector<std::string> m_consoleCommands; ///< De `addConsoleCommands`, en orden.
+    bool m_culling = true; ///< `r_culling`: sin l se dibujan todas las entidades activas.
+    bool m_lod = true; ///< `r_lod`: sin l la IA y las animaciones van cada paso.
+
+    ActorPool m_actors; ///< Actores de la escena; debe sobrevivir a los punteros de abajo.
+
+    std::vector<EngineUtilities::TSharedPointer<Actor>> m_sceneActors; ///< Todos los actores de la escena, en orden de archivo.
+    std::vector<EngineUtilities::TSharedPointer<Actor>> m_crowd; ///< La multitud; no se guarda con la escena.
+    std::vector<EngineUtilities::TSharedPointer<Actor>> m_spawned; ///< Del comando `spawn`; no se guardan con la escena.
 
     EngineUtilities::TSharedPointer<Actor> Triangle; ///< Actor que representa un tringulo en la escena.
     EngineUtilities::TSharedPointer<Actor> Circle; ///< Actor que representa un crculo en la escena.
 
-    // Variables para la actividad de bsqueda de waypoints
-    int currentWaypoint = 0; ///< ndice del waypoint actual hacia el que se dirige el actor.
-
-    // Lista de puntos (waypoints) que el actor seguir en la escena.
-    std::vector<sf::Vector2f> waypoints = {
-        {100.0f, 100.0f},
-        {400.0f, 100.0f},
-        {400.0f, 400.0f},
-        {100.0f, 400.0f}
-    };
+    PathHandle m_waypointPath; ///< Recorrido de la escena en `PathLibrary`; lo comparten el crculo y los guardias.
 };
@@ -0,0 +1,20 @@
+#pragma once
+#include "Behavior/Behavior.h"
+#include "EntityRegistry.h"
+#include "PathLibrary.h"
+
+/**
+ * @brief Lleva al actor `actor` hasta `destination` con su `SteeringAgent` (el sistema
+ *        `Steering` hace el movimiento) y termina al quedar dentro de `arriveRadius`.
+ *
+ * Termina tambin si el actor ya no existe o no tiene `SteeringAgent`.
+ */
+Behavior
+moveTo(EntityHandle actor, sf::Vector2f destination);
+
+/**
+ * @brief Recorre `path` punto a punto con `moveTo` y publica `WaypointReached` al llegar a
+ *        cada uno. Con `Path::loop` vuelve a empezar; si no, termina en el ltimo.
+ */
+Behavior
+patrol(EntityHandle actor, PathHandle path);
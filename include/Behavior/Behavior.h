@@ -0,0 +1,278 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+/**
+ * @class BehaviorFramePool
+ * @brief Memoria de los marcos de las corrutinas `Behavior`, por tamaos fijos.
+ *
+ * Cada marco va a la clase de `kMinSize` a `kMaxSize` bytes (potencias de 2) que le queda
+ * justa; los libres de cada clase forman una lista y los nuevos salen de trozos de `kChunkSize`
+ * bytes. Empezar una patrulla cuando ya termin otra del mismo tamao no toca el heap. Los
+ * marcos ms grandes que `kMaxSize` van a `operator new`.
+ *
+ * Un solo hilo: los comportamientos se crean, corren y terminan en el de la simulacin. La
+ * memoria se cuenta en `MemoryCategory::Scripting` y no vuelve al sistema.
+ */
+class
+BehaviorFramePool {
+public:
+	static constexpr size_t kMinSize = 64;
+	static constexpr size_t kMaxSize = 2048;
+	static constexpr size_t kChunkSize = 16 * 1024;
+	static constexpr size_t kClasses = 6;      ///< 64, 128, 256, 512, 1024 y 2048 bytes.
+
+	static void*
+	allocate(size_t size);
+
+	static void
+	deallocate(void* frame, size_t size);
+
+	/**
+	 * @brief Marcos entregados y an no devueltos.
+	 */
+	static size_t
+	liveFrames();
+
+	/**
+	 * @brief Bytes pedidos al sistema para los trozos.
+	 */
+	static size_t
+	reservedBytes();
+};
+
+/**
+ * @brief Lo que espera un comportamiento suspendido; lo llenan los awaitables y lo lee
+ *        `BehaviorScheduler` al recuperar el control.
+ *
+ * Hay uno por comportamiento raz: los anidados (`co_await otro()`) escriben en el de su raz,
+ * junto con cul de ellos hay que reanudar.
+ */
+struct BehaviorWait {
+	enum Kind : uint8_t {
+		NextTick,   ///< Seguir en el prximo `tick`.
+		Sleep,      ///< Dormir `seconds` de simulacin; no cuesta nada hasta entonces.
+		Until,      ///< Seguir cuando `ready(context)` sea verdadero; se pregunta en cada `tick`.
+		Done        ///< Termin.
+	};
+
+	Kind kind = NextTick;
+	bool cancelled = false;                     ///< Ver `BehaviorScheduler::stop`.
+	float seconds = 0.0f;                       ///< Para `Sleep`: cunto dormir.
+	bool (*ready)(void* context) = nullptr;
+	void* context = nullptr;                    ///< Vive en el marco del comportamiento suspendido.
+	std::coroutine_handle<> resume;             ///< El comportamiento ms anidado, el que sigue.
+};
+
+/**
+ * @class Behavior
+ * @brief Comportamiento de un actor (patrulla, cinemtica, secuencia de IA) escrito como
+ *        corrutina de C++20 y ejecutado por `BehaviorScheduler`.
+ *
+ * Empieza suspendido; `BehaviorScheduler::start` lo corre hasta su primera espera. Dentro se
+ * espera con `co_await`:
+ * - `Behavior::nextTick()`: al prximo paso de la simulacin.
+ * - `Behavior::sleep(segundos)`: tiempo de simulacin.
+ * - `Behavior::until(condicin)`: una funcin sin argumentos que devuelve `bool`.
+ * - Otro `Behavior`: corre dentro de este y sigue cuando termina.
+ *
+ * Los marcos salen de `BehaviorFramePool`. Mover un `Behavior` pasa la corrutina; destruirlo
+ * sin haberla entregado al scheduler la destruye.
+ */
+class
+Behavior {
+public:
+	struct promise_type {
+		BehaviorWait ownWait;                   ///< El de la raz; los anidados no lo usan.
+		BehaviorWait* wait = &ownWait;          ///< El de la raz de la cadena.
+		std::coroutine_handle<> continuation;   ///< Quien espera a este, si est anidado.
+
+		static void*
+		operator new(size_t size) { return BehaviorFramePool::allocate(size); }
+
+		static void
+		operator delete(void* frame, size_t size) { BehaviorFramePool::deallocate(frame, size); }
+
+		Behavior
+		get_return_object() { return Behavior(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+		std::suspend_always
+		initial_suspend() noexcept { return {}; }
+
+		/**
+		 * @brief Al terminar, sigue quien lo esperaba, o marca la raz como terminada.
+		 */
+		struct FinalAwaiter {
+			bool
+			await_ready() noexcept { return false; }
+
+			std::coroutine_handle<>
+			await_suspend(std::coroutine_handle<promise_type> finished) noexcept {
+				promise_type& promise = finished.promise();
+				if (promise.continuation) {
+					promise.wait->resume = promise.continuation;
+					return promise.continuation;
+				}
+				promise.wait->kind = BehaviorWait::Done;
+				return std::noop_coroutine();
+			}
+
+			void
+			await_resume() noexcept {}
+		};
+
+		FinalAwaiter
+		final_suspend() noexcept { return {}; }
+
+		void
+		return_void() {}
+
+		/**
+		 * @brief El motor no usa excepciones para el flujo: una que escape de un comportamiento es un error.
+		 */
+		void
+		unhandled_exception() { std::terminate(); }
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Behavior() = default;
+
+	Behavior(Behavior&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+	Behavior&
+	operator=(Behavior&& other) noexcept {
+		if (this != &other) {
+			reset();
+			m_handle = std::exchange(other.m_handle, nullptr);
+		}
+		return *this;
+	}
+
+	Behavior(const Behavior&) = delete;
+	Behavior&
+	operator=(const Behavior&) = delete;
+
+	~Behavior() { reset(); }
+
+	bool
+	isValid() const { return static_cast<bool>(m_handle); }
+
+	bool
+	isDone() const { return !m_handle || m_handle.done(); }
+
+	/**
+	 * @brief Entrega la corrutina; quien la recibe debe destruirla.
+	 */
+	Handle
+	release() { return std::exchange(m_handle, nullptr); }
+
+	/**
+	 * @brief `co_await` de un comportamiento anidado: corre dentro de quien lo espera, que
+	 *        sigue cuando termina.
+	 */
+	bool
+	await_ready() const noexcept { return isDone(); }
+
+	std::coroutine_handle<>
+	await_suspend(Handle parent) noexcept {
+		promise_type& child = m_handle.promise();
+		child.wait = parent.promise().wait;
+		child.continuation = parent;
+		child.wait->resume = m_handle;
+		return m_handle;
+	}
+
+	void
+	await_resume() const noexcept {}
+
+	/**
+	 * @brief Espera al prximo `tick`.
+	 */
+	struct NextTick {
+		bool
+		await_ready() const noexcept { return false; }
+
+		void
+		await_suspend(Handle waiting) const noexcept {
+			BehaviorWait& wait = *waiting.promise().wait;
+			wait.kind = BehaviorWait::NextTick;
+			wait.resume = waiting;
+		}
+
+		void
+		await_resume() const noexcept {}
+	};
+
+	static NextTick
+	nextTick() { return {}; }
+
+	/**
+	 * @brief Espera `seconds` de simulacin. 0 o menos no suspende.
+	 */
+	struct Sleep {
+		float seconds;
+
+		bool
+		await_ready() const noexcept { return seconds <= 0.0f; }
+
+		void
+		await_suspend(Handle waiting) const noexcept {
+			BehaviorWait& wait = *waiting.promise().wait;
+			wait.kind = BehaviorWait::Sleep;
+			wait.seconds = seconds;
+			wait.resume = waiting;
+		}
+
+		void
+		await_resume() const noexcept {}
+	};
+
+	static Sleep
+	sleep(float seconds) { return { seconds }; }
+
+	/**
+	 * @brief Espera a que `condition()` sea verdadera. Se evala al llegar y luego una vez por
+	 *        `tick`; vive en el marco de quien espera, sin memoria aparte.
+	 */
+	template<typename Fn>
+	struct Until {
+		Fn condition;
+
+		bool
+		await_ready() { return condition(); }
+
+		void
+		await_suspend(Handle waiting) noexcept {
+			BehaviorWait& wait = *waiting.promise().wait;
+			wait.kind = BehaviorWait::Until;
+			wait.ready = [](void* context) { return (*static_cast<Fn*>(context))(); };
+			wait.context = &condition;
+			wait.resume = waiting;
+		}
+
+		void
+		await_resume() const noexcept {}
+	};
+
+	template<typename Fn>
+	static Until<Fn>
+	until(Fn condition) { return { std::move(condition) }; }
+
+private:
+	explicit
+	Behavior(Handle handle) : m_handle(handle) {}
+
+	void
+	reset() {
+		if (m_handle) {
+			m_handle.destroy();
+			m_handle = nullptr;
+		}
+	}
+
+	Handle m_handle;
+};
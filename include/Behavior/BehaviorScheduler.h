@@ -0,0 +1,111 @@
+#pragma once
+#include <vector>
+#include "Behavior/Behavior.h"
+#include "EntityRegistry.h"
+
+/**
+ * @class BehaviorScheduler
+ * @brief Corre los `Behavior` de los actores una vez por paso de la simulacin. Es un servicio
+ *        (`TService<BehaviorScheduler>`) y lo avanza el sistema "Behaviors" de `BaseApp`.
+ *
+ * Cada `tick`:
+ * - Los dormidos cuya hora lleg (un montculo por hora de despertar) pasan a la lista activa;
+ *   mientras duermen no cuestan nada.
+ * - Los activos que esperaban `nextTick` siguen; los que esperan `until` siguen si su condicin
+ *   ya se cumple.
+ * - Los que terminaron se destruyen y su marco vuelve a `BehaviorFramePool`.
+ *
+ * Un comportamiento con dueo (`start(..., owner)`) se destruye sin seguir en cuanto el dueo
+ * deja de existir en `EntityRegistry`, as que puede guardar el `EntityHandle` del actor y
+ * confiar en que sigue vivo. Un solo hilo: `start`, `stop` y `tick` en el de la simulacin,
+ * tambin desde dentro de un comportamiento.
+ */
+class
+BehaviorScheduler {
+public:
+	BehaviorScheduler() = default;
+
+	/**
+	 * @brief Destruye los comportamientos que no terminaron.
+	 */
+	~BehaviorScheduler();
+
+	BehaviorScheduler(const BehaviorScheduler&) = delete;
+	BehaviorScheduler&
+	operator=(const BehaviorScheduler&) = delete;
+
+	/**
+	 * @brief Corre `behavior` hasta su primera espera y se queda con l.
+	 * @param owner Entidad a la que pertenece; nula para uno sin dueo.
+	 */
+	void
+	start(Behavior&& behavior, EntityHandle owner = {});
+
+	/**
+	 * @brief Detiene los comportamientos de `owner` sin dejarlos seguir. Los dormidos se
+	 *        destruyen ya; los activos, en el prximo `tick`.
+	 */
+	void
+	stop(EntityHandle owner);
+
+	/**
+	 * @brief Avanza `deltaTime` segundos de simulacin y corre los que toque.
+	 */
+	void
+	tick(float deltaTime);
+
+	/**
+	 * @brief Destruye todos los comportamientos.
+	 */
+	void
+	clear();
+
+	/**
+	 * @brief Comportamientos sin terminar, activos y dormidos.
+	 */
+	size_t
+	size() const { return m_running.size() + m_sleeping.size(); }
+
+	/**
+	 * @brief Segundos de simulacin desde el primer `tick`.
+	 */
+	double
+	time() const { return m_time; }
+
+	static BehaviorScheduler&
+	instance();
+
+private:
+	struct Task {
+		Behavior::Handle root;
+		EntityHandle owner;
+	};
+
+	struct Sleeper {
+		double wakeTime;
+		Task task;
+	};
+
+	/**
+	 * @brief Deja `task` donde va segn lo que espera, o lo destruye si termin o lo detuvieron.
+	 */
+	void
+	dispatch(Task task);
+
+	/**
+	 * @brief El dueo ya no existe.
+	 */
+	bool
+	orphaned(const Task& task) const;
+
+	/**
+	 * @brief Orden del montculo: el que despierta antes queda arriba.
+	 */
+	static bool
+	wakesLater(const Sleeper& a, const Sleeper& b);
+
+	std::vector<Task> m_running;    ///< Esperan `nextTick` o `until`.
+	std::vector<Task> m_polling;    ///< Los de `m_running` mientras `tick` los recorre.
+	std::vector<Sleeper> m_sleeping; ///< Montculo por `wakeTime`, el ms cercano arriba.
+	double m_time = 0.0;
+};
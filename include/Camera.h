@@ -0,0 +1,160 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+#include "Math/Mat4.h"
+#include "Render/RenderCommandBuffer.h"
+
+/**
+ * @class Camera
+ * @brief Componente de cmara 3D, en perspectiva u ortogrfica, con sus matrices de vista,
+ *        proyeccin y vista-proyeccin en cach.
+ *
+ * Usa las coordenadas del mundo 2D: x a la derecha, y hacia abajo, y z positivo hacia quien
+ * mira, como `MeshPipeline`. La vista se recalcula solo cuando cambian la posicin, el punto
+ * al que mira o el `Transform` que sigue; la proyeccin, solo con sus parmetros. `getVersion`
+ * sube con cada reclculo.
+ *
+ * `render` deja sus matrices en el buffer del frame (`RenderCommandBuffer::setCamera`), as
+ * que viajan en la foto de `RenderThread`; `MeshPipeline` las sube una vez por frame como
+ * bloque uniforme. Si varias cmaras graban, vale la ltima. Sin cmara, las mallas usan la
+ * `sf::View` de la ventana.
+ */
+class
+Camera : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::CAMERA;
+
+	enum class
+	Projection : uint8_t {
+		Perspective,
+		Orthographic,
+	};
+
+	Camera() : Component(ComponentType::CAMERA) {}
+
+	void
+	update(float deltaTime) override {}
+
+	/**
+	 * @brief Graba las matrices de la cmara en el buffer del frame.
+	 */
+	void
+	render(RenderCommandBuffer& commands) override;
+
+	/**
+	 * @param fovYDegrees Apertura vertical, en grados.
+	 */
+	void
+	setPerspective(float fovYDegrees, float nearPlane, float farPlane);
+
+	/**
+	 * @param height Alto visible, en unidades de mundo; el ancho sale del aspecto.
+	 */
+	void
+	setOrthographic(float height, float nearPlane, float farPlane);
+
+	/**
+	 * @brief Ancho sobre alto del destino; por defecto el de la ventana de 800x600.
+	 */
+	void
+	setAspect(float aspect);
+
+	/**
+	 * @brief Rayo de mundo que pasa por el pxel `pixel` de un destino de `targetSize`, para
+	 *        elegir con el mouse. `direction` sale con largo 1.
+	 */
+	void
+	screenRay(const sf::Vector2f& pixel, const sf::Vector2f& targetSize, sf::Vector3f& origin, sf::Vector3f& direction) const;
+
+	Projection
+	getProjectionType() const { return m_projectionType; }
+
+	void
+	setPosition(const sf::Vector3f& position);
+
+	/**
+	 * @brief Posicin con el desplazamiento del `Transform` seguido, si hay.
+	 */
+	sf::Vector3f
+	getPosition() const;
+
+	/**
+	 * @brief Punto al que mira; sigue al `Transform` igual que la posicin.
+	 */
+	void
+	setTarget(const sf::Vector3f& target);
+
+	/**
+	 * @brief Arriba de la cmara; por defecto (0, -1, 0), lo de arriba en la pantalla.
+	 */
+	void
+	setUp(const sf::Vector3f& up);
+
+	/**
+	 * @brief Coloca la cmara sobre `center`, a la distancia en que el plano z = 0 muestra
+	 *        `visibleHeight` unidades de alto, mirndolo de frente.
+	 */
+	void
+	focus(const sf::Vector2f& center, float visibleHeight);
+
+	/**
+	 * @brief Sigue a `transform`: posicin y punto de mira pasan a contarse desde su posicin
+	 *        interpolada (`Transform::getRenderTransform`). Nulo deja de seguirlo.
+	 */
+	void
+	setTransform(const Transform* transform);
+
+	const Mat4&
+	getView() const;
+
+	const Mat4&
+	getProjection() const;
+
+	const Mat4&
+	getViewProjection() const;
+
+	/**
+	 * @brief Sube cada vez que cambia alguna de las matrices.
+	 */
+	uint32_t
+	getVersion() const { getViewProjection(); return m_version; }
+
+	/**
+	 * @brief Las matrices y la posicin, con la disposicin `std140` del bloque del shader.
+	 */
+	CameraUniforms
+	getUniforms() const;
+
+private:
+	/**
+	 * @brief Desplazamiento actual del `Transform` seguido; si cambi, la vista queda sucia.
+	 */
+	sf::Vector3f
+	followOffset() const;
+
+	sf::Vector3f m_position{ 400.0f, 300.0f, 520.0f };
+	sf::Vector3f m_target{ 400.0f, 300.0f, 0.0f };
+	sf::Vector3f m_up{ 0.0f, -1.0f, 0.0f };
+	const Transform* m_transform = nullptr;  ///< Transform seguido, o nulo.
+
+	Projection m_projectionType = Projection::Perspective;
+	float m_fovY = 60.0f;
+	float m_height = 600.0f;                 ///< Alto visible de la ortogrfica.
+	float m_near = 10.0f;
+	float m_far = 5000.0f;
+	float m_aspect = 800.0f / 600.0f;
+
+	// Cach: se recalcula al pedirla si est sucia
+	mutable Mat4 m_view;
+	mutable Mat4 m_projection;
+	mutable Mat4 m_viewProjection;
+	mutable sf::Vector3f m_offset;           ///< Desplazamiento del `Transform` al calcular la vista.
+	mutable bool m_viewDirty = true;
+	mutable bool m_projectionDirty = true;
+	mutable bool m_viewProjectionDirty = true;
+	mutable uint32_t m_version = 0;
+};
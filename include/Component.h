@@ -1,12 +1,23 @@
 #pragma once
-class Window;
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Memory/TRefCounted.h"
+#include "ECS/ChangeTick.h"
+
+class RenderCommandBuffer;
 
 /**
  * @enum ComponentType
  * @brief Tipos de componentes disponibles en el juego.
+ *
+ * Los del motor son fijos; los que agrega el juego reciben un valor a partir de
+ * `kFirstUserComponentType` con `registerComponentType<T>()`.
  */
 enum 
-ComponentType {
+ComponentType : uint8_t {
 	NONE = 0, 
 	TRANSFORM = 1,
 	SPRITE = 2,
@@ -14,17 +25,86 @@ ComponentType {
 	PHYSICS = 4,
 	AUDIOSOURCE = 5,
 	SHAPE = 6,
+	CAMERA = 7,
+	PARTICLES = 8,
+	TILEMAP = 9,
+	LIGHT = 10,
 };
 
+constexpr size_t kFirstUserComponentType = 11; ///< Primer valor libre para tipos del juego.
+
+/**
+ * @brief Valores posibles de `ComponentType`, del motor y del juego; tamao del ndice por
+ *        tipo de `Entity`.
+ */
+constexpr size_t kComponentTypeCount = 16;
+
+/**
+ * @brief Conjunto de tipos de componente, un bit por `ComponentType`.
+ */
+using ComponentMask = uint32_t;
+
+/**
+ * @brief Bit de `type` dentro de un `ComponentMask`.
+ */
+constexpr ComponentMask
+componentBit(ComponentType type) { return ComponentMask(1) << type; }
+
+/**
+ * @brief Indica si un tipo de componente declara `static constexpr ComponentType StaticType`.
+ *
+ * Los componentes que lo declaran se buscan comparando `getType()` con `StaticType` y se
+ * convierten con `static_pointer_cast`, sin `dynamic_cast`. Los dems usan RTTI como respaldo.
+ * `StaticType` puede ser un valor del enum o uno de `registerComponentType<T>()`.
+ */
+template<typename T, typename = void>
+struct HasStaticComponentType : std::false_type {};
+
+template<typename T>
+struct HasStaticComponentType<T, std::void_t<decltype(T::StaticType)>> : std::true_type {};
+
+/**
+ * @brief Siguiente `ComponentType` libre para `registerComponentType`.
+ */
+inline std::atomic<uint32_t> g_nextComponentType{ kFirstUserComponentType };
+
+/**
+ * @brief `ComponentType` propio de `T`, repartido la primera vez que se pide y fijo el resto
+ *        de la ejecucin.
+ *
+ * As un componente del juego entra al ndice por tipo de `Entity` sin tocar el enum:
+ *
+ *     class Health : public Component {
+ *     public:
+ *         static inline const ComponentType StaticType = registerComponentType<Health>();
+ *         Health() : Component(StaticType) {}
+ *     };
+ *
+ * Los valores son densos, as que `ComponentUpdater` y `ComponentMask` los indexan igual que a
+ * los del motor. Caben `kComponentTypeCount - kFirstUserComponentType` tipos del juego.
+ */
+template<typename T>
+ComponentType
+registerComponentType() {
+	static const ComponentType s_type = [] {
+		uint32_t type = g_nextComponentType.fetch_add(1, std::memory_order_relaxed);
+		assert(type < kComponentTypeCount && "Demasiados tipos de componente; sube kComponentTypeCount");
+		return static_cast<ComponentType>(type);
+	}();
+	return s_type;
+}
+
 /**
  * @class Component
  * @brief Clase base abstracta para todos los componentes del juego.
  *
  * La clase Component define la interfaz bsica que todos los componentes deben implementar,
  * permitiendo actualizar y renderizar el componente, as como obtener su tipo.
+ * El conteo de referencias es intrusivo (`TRefCounted`): los componentes se crean con
+ * `MakeIntrusive` y se guardan en `TIntrusivePtr`.
  */
 class 
-Component {
+Component : public EngineUtilities::TRefCounted<> {
 public:
 	/**
 	 * @brief Constructor por defecto.
@@ -51,11 +131,13 @@ public:
 	update(float deltaTime) = 0;
 
 	/**
-	 * @brief Mtodo virtual puro para renderizar el componente.
-	 * @param Window Contexto del dispositivo para operaciones grficas.
+	 * @brief Agrega los dibujos del componente al buffer del frame.
+	 *
+	 * No dibuja: `Window::submit` ordena y enva todos los comandos juntos.
+	 * @param commands Buffer de comandos del frame.
 	 */
 	virtual void
-	render(Window window) = 0;
+	render(RenderCommandBuffer& commands) = 0;
 
 	/**
    * @brief Obtiene el tipo del componente.
@@ -64,6 +146,23 @@ public:
   ComponentType 
   getType() const { return m_type; }
 
+	/**
+	 * @brief Tick de la ltima modificacin (o de la creacin); lo comparan los sistemas
+	 *        reactivos con `WorldView::eachChanged`.
+	 */
+	uint32_t
+	getChangeTick() const { return m_changeTick; }
+
 protected:
-	ComponentType m_type; // Tipo de Componente.
+	/**
+	 * @brief Lo llaman las subclases en cada setter que cambia algo visible.
+	 */
+	void
+	markChanged() {
+		m_changeTick = currentChangeTick();
+		noteChange(m_changeTick);
+	}
+
+	ComponentType m_type = ComponentType::NONE; // Tipo de Componente.
+	uint32_t m_changeTick = currentChangeTick(); ///< Ver `getChangeTick`.
 };
\ No newline at end of file
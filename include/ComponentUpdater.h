@@ -0,0 +1,83 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "Component.h"
+
+class Entity;
+class EntityCostProfiler;
+
+/**
+ * @class ComponentUpdater
+ * @brief Actualiza los componentes de muchas entidades agrupados por tipo.
+ *
+ * Cada `ComponentType` puede registrar una funcin por lotes que recibe todos los
+ * componentes de ese tipo en un solo llamado, para recorrerlos en un bucle sin llamadas
+ * virtuales. Los tipos sin lote siguen usando `Component::update` uno por uno, y los
+ * registrados con `registerNoUpdate` se saltan.
+ *
+ * Los componentes se agrupan en cada `update` leyendo `getType()` (no virtual); los
+ * vectores de cada grupo conservan su capacidad entre frames. Los lotes corren en orden de
+ * `ComponentType` y despus los componentes sin lote, en el orden de las entidades.
+ */
+class
+ComponentUpdater {
+public:
+	/**
+	 * @brief Funcin por lotes: todos los componentes de un tipo, ya filtrados.
+	 *
+	 * Cada elemento es del tipo registrado y puede convertirse con `static_cast`.
+	 */
+	using BatchFunction = void (*)(std::span<Component* const> components, float deltaTime);
+
+	/**
+	 * @brief Registra la actualizacin por lotes del tipo `T` (debe declarar `StaticType`).
+	 */
+	template<typename T>
+	void
+	registerBatch(BatchFunction function) {
+		static_assert(HasStaticComponentType<T>::value, "T must declare StaticType");
+		Lane& lane = m_lanes[T::StaticType];
+		lane.batch = function;
+		lane.skip = false;
+	}
+
+	/**
+	 * @brief Marca `T` como tipo cuyo `update` no hace nada: no se llama en absoluto.
+	 */
+	template<typename T>
+	void
+	registerNoUpdate() {
+		static_assert(HasStaticComponentType<T>::value, "T must declare StaticType");
+		Lane& lane = m_lanes[T::StaticType];
+		lane.batch = nullptr;
+		lane.skip = true;
+	}
+
+	/**
+	 * @brief Indica si `type` se actualiza por lotes o se salta (no usa el camino virtual).
+	 */
+	bool
+	isMigrated(ComponentType type) const { return m_lanes[type].batch || m_lanes[type].skip; }
+
+	/**
+	 * @brief Actualiza los componentes de `entities`.
+	 * @param costs Si no es nulo, cronometra cada lote y cada componente sin lote y se los
+	 *        carga (ver `EntityCostProfiler`).
+	 */
+	void
+	update(std::span<Entity* const> entities, float deltaTime, EntityCostProfiler* costs = nullptr);
+
+private:
+	/**
+	 * @brief Estado de un `ComponentType`.
+	 */
+	struct Lane {
+		BatchFunction batch = nullptr;     ///< Funcin por lotes, o nula.
+		bool skip = false;                 ///< `update` vaco: no se llama.
+		std::vector<Component*> items;     ///< Componentes del frame actual.
+	};
+
+	Lane m_lanes[kComponentTypeCount];     ///< Un grupo por `ComponentType`.
+	std::vector<Component*> m_virtual;     ///< Componentes sin lote, en orden de entidad.
+	std::vector<Entity*> m_owners;         ///< La entidad de cada uno de `m_virtual`; solo al medir costos.
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Cola acotada sin candados para muchos productores y un consumidor.
+	 *
+	 * Anillo de Vyukov: cada celda lleva un nmero de secuencia que dice si est libre para
+	 * el productor de esa vuelta o lista para el consumidor. Los productores se reparten las
+	 * celdas con un compare-and-swap sobre la cola; el consumidor, que es uno solo, avanza la
+	 * cabeza sin competir con nadie.
+	 *
+	 * @tparam T Tipo construible por defecto y movible sin excepciones (por ejemplo, un evento).
+	 */
+	template<typename T>
+	class TMpscQueue
+	{
+		static_assert(std::is_default_constructible_v<T>, "TMpscQueue necesita T construible por defecto");
+		static_assert(std::is_nothrow_move_assignable_v<T>, "TMpscQueue necesita mover T sin excepciones");
+
+	public:
+		/**
+		 * @param capacity Elementos; se redondea a potencia de dos.
+		 */
+		explicit TMpscQueue(size_t capacity = 1024)
+		{
+			size_t rounded = 2;
+			while (rounded < capacity)
+			{
+				rounded <<= 1;
+			}
+			m_mask = rounded - 1;
+			m_cells = std::make_unique<Cell[]>(rounded);
+			for (size_t i = 0; i < rounded; ++i)
+			{
+				m_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		TMpscQueue(const TMpscQueue&) = delete;
+		TMpscQueue& operator=(const TMpscQueue&) = delete;
+
+		/**
+		 * @brief Cualquier hilo. Solo mueve `value` si lo encola.
+		 * @return `false` si la cola est llena.
+		 */
+		bool tryPush(T&& value)
+		{
+			size_t position = m_tail.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Cell& cell = m_cells[position & m_mask];
+				size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+				if (difference == 0)
+				{
+					if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						cell.value = std::move(value);
+						// release: el consumidor ve el valor al ver la secuencia
+						cell.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false; // La celda an guarda el valor de la vuelta anterior
+				}
+				else
+				{
+					position = m_tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool tryPush(const T& value)
+		{
+			T copy(value);
+			return tryPush(std::move(copy));
+		}
+
+		/**
+		 * @brief Solo el consumidor.
+		 * @return `false` si est vaca (o el siguiente productor an no termina de escribir).
+		 */
+		bool tryPop(T& out)
+		{
+			Cell& cell = m_cells[m_head & m_mask];
+			size_t sequence = cell.sequence.load(std::memory_order_acquire);
+			if (sequence != m_head + 1)
+			{
+				return false;
+			}
+			out = std::move(cell.value);
+			// La celda queda libre para la prxima vuelta de los productores
+			cell.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+			++m_head;
+			return true;
+		}
+
+		size_t capacity() const { return m_mask + 1; }
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence{ 0 };
+			T value{};
+		};
+
+		alignas(64) std::atomic<size_t> m_tail{ 0 }; ///< Prxima posicin de los productores.
+		alignas(64) size_t m_head = 0;               ///< Prxima posicin del consumidor.
+		std::unique_ptr<Cell[]> m_cells;             ///< Anillo.
+		size_t m_mask = 0;                           ///< Capacidad - 1.
+	};
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Referencia de 8 bytes a un elemento de un `TSlotMap`.
+	 *
+	 * No cuenta referencias: copiarla no cuesta nada y puede guardarse en otros actores
+	 * (objetivo a perseguir, padre). Si el elemento se borra, la generacin deja de coincidir
+	 * y la bsqueda devuelve nulo en lugar de un objeto equivocado.
+	 */
+	struct SlotHandle
+	{
+		uint32_t index = 0;      ///< Posicin en la tabla de slots.
+		uint32_t generation = 0; ///< Generacin del slot cuando se cre el handle; 0 = nulo.
+
+		bool isNull() const { return generation == 0; }
+
+		explicit operator bool() const { return generation != 0; }
+
+		bool operator==(const SlotHandle& other) const
+		{
+			return index == other.index && generation == other.generation;
+		}
+
+		bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+	};
+
+	static_assert(sizeof(SlotHandle) == 8, "SlotHandle debe ocupar 8 bytes");
+
+	/**
+	 * @brief Contenedor denso con handles generacionales.
+	 *
+	 * Los valores viven contiguos en `m_values` (se recorren como un `std::vector`); una
+	 * tabla de slots traduce cada handle a su posicin actual. Borrar mueve el ltimo
+	 * elemento al hueco, as que el arreglo nunca tiene agujeros.
+	 *
+	 * - Buscar un handle: una comprobacin de rango y una comparacin de generacin.
+	 * - Insertar y borrar: O(1).
+	 * - Los punteros a valores se invalidan al insertar o borrar; los handles no.
+	 *
+	 * @tparam T Tipo almacenado; debe poder moverse.
+	 */
+	template<typename T>
+	class TSlotMap
+	{
+	public:
+		/**
+		 * @brief Construye un valor en el contenedor.
+		 * @return Handle al nuevo valor.
+		 */
+		template<typename... Args>
+		SlotHandle emplace(Args&&... args)
+		{
+			uint32_t slotIndex;
+			if (m_freeHead != kNoSlot)
+			{
+				slotIndex = m_freeHead;
+				m_freeHead = m_slots[slotIndex].denseIndex;
+			}
+			else
+			{
+				slotIndex = static_cast<uint32_t>(m_slots.size());
+				m_slots.push_back({ 0, 1 });
+			}
+
+			Slot& slot = m_slots[slotIndex];
+			slot.denseIndex = static_cast<uint32_t>(m_values.size());
+			m_values.emplace_back(std::forward<Args>(args)...);
+			m_denseToSlot.push_back(slotIndex);
+			return { slotIndex, slot.generation };
+		}
+
+		SlotHandle insert(const T& value) { return emplace(value); }
+
+		SlotHandle insert(T&& value) { return emplace(std::move(value)); }
+
+		/**
+		 * @brief Borra el valor del handle; los handles a l quedan invlidos.
+		 * @return `false` si el handle ya no era vlido.
+		 */
+		bool erase(SlotHandle handle)
+		{
+			if (!contains(handle))
+			{
+				return false;
+			}
+			Slot& slot = m_slots[handle.index];
+			uint32_t hole = slot.denseIndex;
+			uint32_t last = static_cast<uint32_t>(m_values.size() - 1);
+			if (hole != last)
+			{
+				m_values[hole] = std::move(m_values[last]);
+				m_denseToSlot[hole] = m_denseToSlot[last];
+				m_slots[m_denseToSlot[hole]].denseIndex = hole;
+			}
+			m_values.pop_back();
+			m_denseToSlot.pop_back();
+
+			// Nueva generacin (nunca 0) y al frente de la lista libre
+			if (++slot.generation == 0)
+			{
+				slot.generation = 1;
+			}
+			slot.denseIndex = m_freeHead;
+			m_freeHead = handle.index;
+			return true;
+		}
+
+		/**
+		 * @brief Valor del handle, o `nullptr` si fue borrado.
+		 */
+		T* get(SlotHandle handle)
+		{
+			if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation)
+			{
+				return nullptr;
+			}
+			return &m_values[m_slots[handle.index].denseIndex];
+		}
+
+		const T* get(SlotHandle handle) const
+		{
+			return const_cast<TSlotMap*>(this)->get(handle);
+		}
+
+		/**
+		 * @brief Indica si el handle sigue apuntando a un valor vivo.
+		 */
+		bool contains(SlotHandle handle) const
+		{
+			return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+		}
+
+		/**
+		 * @brief Handle del valor que ocupa la posicin densa `denseIndex` (til al recorrer).
+		 */
+		SlotHandle handleAt(size_t denseIndex) const
+		{
+			assert(denseIndex < m_values.size());
+			uint32_t slotIndex = m_denseToSlot[denseIndex];
+			return { slotIndex, m_slots[slotIndex].generation };
+		}
+
+		size_t size() const { return m_values.size(); }
+
+		bool empty() const { return m_values.empty(); }
+
+		void reserve(size_t capacity)
+		{
+			m_values.reserve(capacity);
+			m_denseToSlot.reserve(capacity);
+			m_slots.reserve(capacity);
+		}
+
+		/**
+		 * @brief Borra todo; los handles emitidos quedan invlidos.
+		 */
+		void clear()
+		{
+			while (!m_values.empty())
+			{
+				erase(handleAt(m_values.size() - 1));
+			}
+		}
+
+		T* data() { return m_values.data(); }
+
+		T* begin() { return m_values.data(); }
+
+		T* end() { return m_values.data() + m_values.size(); }
+
+		const T* begin() const { return m_values.data(); }
+
+		const T* end() const { return m_values.data() + m_values.size(); }
+
+	private:
+		static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+
+		/**
+		 * @brief Entrada de la tabla: posicin densa si est ocupado, o el siguiente libre.
+		 */
+		struct Slot
+		{
+			uint32_t denseIndex;
+			uint32_t generation;
+		};
+
+		std::vector<T> m_values;             ///< Valores contiguos.
+		std::vector<uint32_t> m_denseToSlot; ///< Slot dueo de cada valor denso.
+		std::vector<Slot> m_slots;           ///< Tabla de slots.
+		uint32_t m_freeHead = kNoSlot;       ///< Primer slot libre.
+	};
+}
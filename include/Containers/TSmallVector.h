@@ -0,0 +1,269 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Vector con los primeros `N` elementos almacenados dentro del propio objeto.
+	 *
+	 * Mientras no supere `N` elementos no reserva memoria: los datos quedan en la misma lnea
+	 * de cach que el objeto que lo contiene. Al pasar de `N` se muda al heap y crece como
+	 * `std::vector`. `Entity::components` lo usa con `N = 4`, lo habitual por actor.
+	 *
+	 * Como en `std::vector`, insertar puede invalidar punteros e iteradores; adems, mover
+	 * un vector que an est en su almacenamiento interno mueve los elementos uno a uno.
+	 *
+	 * @tparam T Tipo de elemento.
+	 * @tparam N Elementos que caben sin reservar memoria.
+	 */
+	template<typename T, size_t N>
+	class TSmallVector
+	{
+		static_assert(N > 0, "TSmallVector necesita al menos un elemento interno");
+
+	public:
+		using value_type = T;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		TSmallVector() : m_data(inlineData()), m_size(0), m_capacity(N) {}
+
+		TSmallVector(std::initializer_list<T> values) : TSmallVector()
+		{
+			reserve(values.size());
+			for (const T& value : values)
+			{
+				push_back(value);
+			}
+		}
+
+		TSmallVector(const TSmallVector& other) : TSmallVector()
+		{
+			reserve(other.m_size);
+			std::uninitialized_copy(other.begin(), other.end(), m_data);
+			m_size = other.m_size;
+		}
+
+		TSmallVector(TSmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : TSmallVector()
+		{
+			takeFrom(other);
+		}
+
+		TSmallVector& operator=(const TSmallVector& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				reserve(other.m_size);
+				std::uninitialized_copy(other.begin(), other.end(), m_data);
+				m_size = other.m_size;
+			}
+			return *this;
+		}
+
+		TSmallVector& operator=(TSmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				clear();
+				releaseHeap();
+				takeFrom(other);
+			}
+			return *this;
+		}
+
+		~TSmallVector()
+		{
+			clear();
+			releaseHeap();
+		}
+
+		template<typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (m_size == m_capacity)
+			{
+				// `args` puede ser un elemento de este vector: se construye antes de mover los viejos
+				size_t newCapacity = m_capacity * 2;
+				T* newData = allocate(newCapacity);
+				T* slot;
+				try
+				{
+					slot = ::new (static_cast<void*>(newData + m_size)) T(std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					deallocate(newData);
+					throw;
+				}
+				adopt(newData, newCapacity);
+				++m_size;
+				return *slot;
+			}
+			T* slot = ::new (static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+			++m_size;
+			return *slot;
+		}
+
+		void push_back(const T& value) { emplace_back(value); }
+
+		void push_back(T&& value) { emplace_back(std::move(value)); }
+
+		void pop_back()
+		{
+			assert(m_size > 0);
+			--m_size;
+			m_data[m_size].~T();
+		}
+
+		/**
+		 * @brief Borra un elemento preservando el orden de los dems.
+		 * @return Iterador al elemento que ocup su lugar.
+		 */
+		iterator erase(iterator position)
+		{
+			assert(position >= begin() && position < end());
+			std::move(position + 1, end(), position);
+			pop_back();
+			return position;
+		}
+
+		/**
+		 * @brief Destruye todos los elementos; la capacidad no cambia.
+		 */
+		void clear()
+		{
+			std::destroy(begin(), end());
+			m_size = 0;
+		}
+
+		/**
+		 * @brief Asegura espacio para `capacity` elementos.
+		 */
+		void reserve(size_t capacity)
+		{
+			if (capacity > m_capacity)
+			{
+				grow(capacity);
+			}
+		}
+
+		T& operator[](size_t index)
+		{
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+		const T& operator[](size_t index) const
+		{
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+		T& back() { return (*this)[m_size - 1]; }
+
+		const T& back() const { return (*this)[m_size - 1]; }
+
+		size_t size() const { return m_size; }
+
+		size_t capacity() const { return m_capacity; }
+
+		bool empty() const { return m_size == 0; }
+
+		/**
+		 * @brief Indica si los elementos siguen en el almacenamiento interno.
+		 */
+		bool isInline() const { return m_data == inlineData(); }
+
+		T* data() { return m_data; }
+
+		const T* data() const { return m_data; }
+
+		iterator begin() { return m_data; }
+
+		iterator end() { return m_data + m_size; }
+
+		const_iterator begin() const { return m_data; }
+
+		const_iterator end() const { return m_data + m_size; }
+
+	private:
+		T* inlineData() { return std::launder(reinterpret_cast<T*>(m_inline)); }
+
+		const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(m_inline)); }
+
+		/**
+		 * @brief Muda los elementos a un bloque del heap de `newCapacity` elementos.
+		 */
+		static T* allocate(size_t capacity)
+		{
+			return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+		}
+
+		static void deallocate(T* data)
+		{
+			::operator delete(static_cast<void*>(data), std::align_val_t(alignof(T)));
+		}
+
+		void grow(size_t newCapacity)
+		{
+			adopt(allocate(newCapacity), newCapacity);
+		}
+
+		/**
+		 * @brief Mueve los elementos a `newData`, de `newCapacity` lugares, y suelta el bfer anterior.
+		 */
+		void adopt(T* newData, size_t newCapacity)
+		{
+			std::uninitialized_move(begin(), end(), newData);
+			std::destroy(begin(), end());
+			releaseHeap();
+			m_data = newData;
+			m_capacity = newCapacity;
+		}
+
+		void releaseHeap()
+		{
+			if (!isInline())
+			{
+				deallocate(m_data);
+				m_data = inlineData();
+				m_capacity = N;
+			}
+		}
+
+		/**
+		 * @brief Toma los elementos de `other` (este vector debe estar vaco y en modo interno).
+		 */
+		void takeFrom(TSmallVector& other)
+		{
+			if (other.isInline())
+			{
+				std::uninitialized_move(other.begin(), other.end(), m_data);
+				m_size = other.m_size;
+				other.clear();
+			}
+			else
+			{
+				m_data = other.m_data;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				other.m_data = other.inlineData();
+				other.m_size = 0;
+				other.m_capacity = N;
+			}
+		}
+
+		T* m_data;         ///< Almacenamiento interno o bloque del heap.
+		size_t m_size;     ///< Elementos construidos.
+		size_t m_capacity; ///< Elementos que caben en `m_data`.
+		alignas(T) unsigned char m_inline[N * sizeof(T)]; ///< Almacenamiento interno.
+	};
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Cola acotada sin candados para un productor y un consumidor.
+	 *
+	 * Cada lado escribe solo su propio ndice: el productor la cola y el consumidor la cabeza.
+	 * Cada uno guarda la ltima copia que ley del ndice del otro y solo la vuelve a leer
+	 * cuando con ella la cola parece llena (o vaca), as que en el camino comn ninguno toca la
+	 * lnea de cach del otro.
+	 *
+	 * @tparam T Tipo construible por defecto y movible sin excepciones. Lo que sale se mueve y
+	 *         deja en la celda el objeto movido (un `NetBuffer` nulo, por ejemplo).
+	 */
+	template<typename T>
+	class TSpscQueue
+	{
+		static_assert(std::is_default_constructible_v<T>, "TSpscQueue necesita T construible por defecto");
+		static_assert(std::is_nothrow_move_assignable_v<T>, "TSpscQueue necesita mover T sin excepciones");
+
+	public:
+		/**
+		 * @param capacity Elementos; se redondea a potencia de dos.
+		 */
+		explicit TSpscQueue(size_t capacity = 1024)
+		{
+			size_t rounded = 2;
+			while (rounded < capacity)
+			{
+				rounded <<= 1;
+			}
+			m_mask = rounded - 1;
+			m_items = std::make_unique<T[]>(rounded);
+		}
+
+		TSpscQueue(const TSpscQueue&) = delete;
+		TSpscQueue& operator=(const TSpscQueue&) = delete;
+
+		/**
+		 * @brief Solo el productor. Solo mueve `value` si lo encola.
+		 * @return `false` si la cola est llena.
+		 */
+		bool tryPush(T&& value)
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cachedHead > m_mask)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail - m_cachedHead > m_mask)
+				{
+					return false;
+				}
+			}
+			m_items[tail & m_mask] = std::move(value);
+			// release: el consumidor ve el valor al ver la cola
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Solo el consumidor.
+		 * @return `false` si est vaca.
+		 */
+		bool tryPop(T& out)
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cachedTail)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cachedTail)
+				{
+					return false;
+				}
+			}
+			out = std::move(m_items[head & m_mask]);
+			// La celda queda libre para el productor
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		size_t capacity() const { return m_mask + 1; }
+
+	private:
+		alignas(64) std::atomic<size_t> m_tail{ 0 }; ///< Prxima posicin del productor.
+		size_t m_cachedHead = 0;                     ///< Del productor: ltima cabeza que ley.
+		alignas(64) std::atomic<size_t> m_head{ 0 }; ///< Prxima posicin del consumidor.
+		size_t m_cachedTail = 0;                     ///< Del consumidor: ltima cola que ley.
+		alignas(64) std::unique_ptr<T[]> m_items;    ///< Anillo.
+		size_t m_mask = 0;                           ///< Capacidad - 1.
+	};
+}
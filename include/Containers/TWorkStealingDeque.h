@@ -0,0 +1,132 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Cola doble de Chase-Lev de capacidad fija, para robo de trabajo.
+	 *
+	 * Un solo hilo dueo hace `push` y `pop` por el fondo (LIFO, lo ms reciente sigue en
+	 * cach); cualquier otro hilo puede hacer `steal` por el tope (FIFO, lo ms antiguo,
+	 * que suele ser el trabajo ms grande). Sin mutex: el dueo solo compite con los
+	 * ladrones por el ltimo elemento, y lo resuelve un compare-and-swap.
+	 *
+	 * Sigue la versin C11 de L, Pop, Cohen y Zappa Nardelli (2013), sin crecimiento:
+	 * `push` falla si la cola est llena y quien llama decide qu hacer.
+	 *
+	 * @tparam T Tipo trivialmente copiable que cabe en un atmico (normalmente un puntero).
+	 */
+	template<typename T>
+	class TWorkStealingDeque
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "TWorkStealingDeque guarda valores trivialmente copiables");
+
+	public:
+		/**
+		 * @param capacity Elementos; se redondea a potencia de dos.
+		 */
+		explicit TWorkStealingDeque(size_t capacity = 4096)
+		{
+			size_t rounded = 1;
+			while (rounded < capacity)
+			{
+				rounded <<= 1;
+			}
+			m_mask = rounded - 1;
+			m_buffer = std::make_unique<std::atomic<T>[]>(rounded);
+		}
+
+		TWorkStealingDeque(const TWorkStealingDeque&) = delete;
+		TWorkStealingDeque& operator=(const TWorkStealingDeque&) = delete;
+
+		/**
+		 * @brief Solo el dueo. Agrega por el fondo.
+		 * @return `false` si la cola est llena.
+		 */
+		bool push(T item)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_acquire);
+			if (bottom - top > static_cast<int64_t>(m_mask))
+			{
+				return false;
+			}
+			m_buffer[bottom & m_mask].store(item, std::memory_order_relaxed);
+			// release: quien robe este elemento ve todo lo escrito antes de publicarlo
+			m_bottom.store(bottom + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Solo el dueo. Saca el elemento ms reciente.
+		 */
+		bool pop(T& out)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed); // Vaca
+				return false;
+			}
+			T item = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// ltimo elemento: gana el dueo o un ladrn, no ambos
+				bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				if (!won)
+				{
+					return false;
+				}
+			}
+			out = item;
+			return true;
+		}
+
+		/**
+		 * @brief Cualquier hilo. Toma el elemento ms antiguo.
+		 * @return `false` si estaba vaca o perdi la carrera contra otro hilo.
+		 */
+		bool steal(T& out)
+		{
+			int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_bottom.load(std::memory_order_acquire);
+			if (top >= bottom)
+			{
+				return false;
+			}
+			T item = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return false;
+			}
+			out = item;
+			return true;
+		}
+
+		/**
+		 * @brief Elementos aproximados (exacto solo para el dueo sin ladrones activos).
+		 */
+		size_t size() const
+		{
+			int64_t count = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+			return count > 0 ? static_cast<size_t>(count) : 0;
+		}
+
+		size_t capacity() const { return m_mask + 1; }
+
+	private:
+		alignas(64) std::atomic<int64_t> m_top{ 0 };    ///< Lo mueven los ladrones.
+		alignas(64) std::atomic<int64_t> m_bottom{ 0 }; ///< Lo mueve el dueo.
+		std::unique_ptr<std::atomic<T>[]> m_buffer;     ///< Anillo de elementos.
+		size_t m_mask = 0;                              ///< Capacidad - 1.
+	};
+}
@@ -0,0 +1,267 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include "ECS/ChangeTick.h"
+#include "ECS/ComponentRegistry.h"
+#include "Containers/TSlotMap.h"
+
+/**
+ * @brief Identificador de una entidad del `World`. Es un `SlotHandle`: 8 bytes con generacin,
+ *        as que un id de una entidad destruida nunca apunta a otra.
+ */
+using EntityId = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Alineacin mnima de cada columna: empiezan en una lnea de cach, as los trozos de
+ *        filas que ocupan lneas enteras no comparten lneas entre hilos.
+ */
+constexpr size_t kColumnAlignment = 64;
+
+/**
+ * @brief Filas consecutivas de una columna que comparten un tick de cambio.
+ */
+constexpr size_t kChangeBlockRows = 64;
+
+/**
+ * @class ComponentColumn
+ * @brief Arreglo contiguo de un solo tipo de componente, sin conocer el tipo en compilacin.
+ *
+ * Cada fila de un `Archetype` ocupa la misma posicin en todas sus columnas. Los tipos
+ * trivialmente reubicables (`ComponentTraits.h`) se mudan con `memcpy`; los dems con su
+ * constructor de movimiento.
+ *
+ * Junto a los datos guarda un tick de cambio (`ChangeTick.h`) por bloque de `kChangeBlockRows`
+ * filas, escrito en cada acceso para modificar, y el ms nuevo de todos, para saltar columnas
+ * enteras que no cambiaron. Marcar un recorrido completo cuesta una escritura por bloque, no
+ * por fila; a cambio, una fila cambiada hace ver cambiado a todo su bloque.
+ */
+class
+ComponentColumn {
+public:
+	ComponentColumn(ComponentTypeId typeId);
+
+	ComponentColumn(ComponentColumn&& other) noexcept;
+
+	ComponentColumn(const ComponentColumn&) = delete;
+	ComponentColumn& operator=(const ComponentColumn&) = delete;
+	ComponentColumn& operator=(ComponentColumn&&) = delete;
+
+	~ComponentColumn();
+
+	/**
+	 * @brief Agrega una fila sin construir; quien llama construye el componente en ella.
+	 *        Su bloque queda marcado como cambiado ahora.
+	 * @return Memoria de la nueva fila.
+	 */
+	void*
+	pushUninitialized();
+
+	/**
+	 * @brief Destruye la fila `row` y mueve la ltima a su lugar.
+	 */
+	void
+	swapRemove(size_t row);
+
+	void*
+	at(size_t row) { return m_data + row * m_info->size; }
+
+	const void*
+	at(size_t row) const { return m_data + row * m_info->size; }
+
+	template<typename T>
+	T*
+	data() { return std::launder(reinterpret_cast<T*>(m_data)); }
+
+	ComponentTypeId
+	typeId() const { return m_typeId; }
+
+	/**
+	 * @brief Tick de cambio del bloque `block` (filas `block * kChangeBlockRows` en adelante).
+	 */
+	uint32_t
+	blockTick(size_t block) const { return m_ticks[block]; }
+
+	/**
+	 * @brief Tick ms nuevo de la columna; si no es posterior a `since`, ningn bloque lo es.
+	 */
+	uint32_t
+	lastChangeTick() const { return m_lastChange.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Marca como cambiados ahora los bloques de las filas `[begin, end)`.
+	 *
+	 * Hilos distintos pueden marcar a la vez rangos que no compartan bloques.
+	 */
+	void
+	markChanged(size_t begin, size_t end) {
+		if (begin == end) {
+			return;
+		}
+		uint32_t now = currentChangeTick();
+		for (size_t block = begin / kChangeBlockRows; block <= (end - 1) / kChangeBlockRows; ++block) {
+			m_ticks[block] = now;
+		}
+		if (m_lastChange.load(std::memory_order_relaxed) != now) {
+			m_lastChange.store(now, std::memory_order_relaxed);
+		}
+		noteChange(now);
+	}
+
+	/**
+	 * @brief Marca como cambiado ahora el bloque de `row`.
+	 */
+	void
+	markChanged(size_t row) {
+		uint32_t now = currentChangeTick();
+		m_ticks[row / kChangeBlockRows] = now;
+		if (m_lastChange.load(std::memory_order_relaxed) != now) {
+			m_lastChange.store(now, std::memory_order_relaxed);
+		}
+		noteChange(now);
+	}
+
+	size_t
+	size() const { return m_size; }
+
+	void
+	reserve(size_t capacity);
+
+	/**
+	 * @brief Destruye todas las filas; conserva la memoria.
+	 */
+	void
+	clear();
+
+	/**
+	 * @brief Deja las mismas filas que `source`, del mismo tipo: de un `memcpy` si es trivial, y
+	 *        con su constructor de copia si no (`ComponentInfo::copyConstruct`, que no es nulo).
+	 *        Todas quedan marcadas como cambiadas ahora.
+	 */
+	void
+	copyFrom(const ComponentColumn& source);
+
+	/**
+	 * @brief Como `copyFrom`, pero solo los bloques cuyo tick en `changed` es posterior a `since`;
+	 *        ambas columnas ya tienen las mismas filas.
+	 * @param changed Columna cuyos ticks dicen qu bloques difieren: `source` o esta misma.
+	 * @return Bytes copiados.
+	 */
+	size_t
+	copyChangedBlocks(const ComponentColumn& source, const ComponentColumn& changed, uint32_t since);
+
+private:
+	ComponentTypeId m_typeId;      ///< Tipo guardado.
+	const ComponentInfo* m_info;   ///< Tamao, alineacin y funciones del tipo.
+	unsigned char* m_data = nullptr; ///< Filas contiguas.
+	uint32_t* m_ticks = nullptr;   ///< Tick de cambio de cada bloque de filas.
+	std::atomic<uint32_t> m_lastChange{ 0 }; ///< Tick ms nuevo escrito; ningn bloque es posterior.
+	size_t m_size = 0;             ///< Filas construidas.
+	size_t m_capacity = 0;         ///< Filas que caben en `m_data`.
+};
+
+/**
+ * @class Archetype
+ * @brief Tabla de todas las entidades que tienen exactamente el mismo conjunto de componentes.
+ *
+ * Una columna por tipo (posiciones juntas, velocidades juntas...) y una columna de ids.
+ * Recorrer un tipo es recorrer un arreglo; agregar o quitar un componente mueve la entidad
+ * al arquetipo vecino, que se recuerda en `m_addEdges` / `m_removeEdges`.
+ */
+class
+Archetype {
+public:
+	explicit Archetype(ComponentSignature signature);
+
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+	ComponentSignature
+	signature() const { return m_signature; }
+
+	bool
+	has(ComponentTypeId typeId) const { return (m_signature >> typeId) & 1; }
+
+	/**
+	 * @brief Columna de `typeId`, o nulo si el arquetipo no lo tiene. Una lectura indexada.
+	 */
+	ComponentColumn*
+	column(ComponentTypeId typeId) {
+		int index = m_columnIndex[typeId];
+		return index < 0 ? nullptr : &m_columns[index];
+	}
+
+	template<typename T>
+	T*
+	columnData() {
+		ComponentColumn* found = column(ComponentRegistry::idOf<T>());
+		return found ? found->data<T>() : nullptr;
+	}
+
+	std::vector<ComponentColumn>&
+	columns() { return m_columns; }
+
+	const std::vector<ComponentColumn>&
+	columns() const { return m_columns; }
+
+	/**
+	 * @brief Agrega el id de una fila nueva; las columnas las llena quien llama.
+	 * @return ndice de la fila.
+	 */
+	uint32_t
+	pushEntity(EntityId entity);
+
+	/**
+	 * @brief Destruye la fila `row` en todas las columnas y mueve la ltima a su lugar.
+	 * @return Entidad que ahora ocupa `row`, o un id nulo si `row` era la ltima.
+	 */
+	EntityId
+	removeRow(uint32_t row);
+
+	EntityId
+	entityAt(size_t row) const { return m_entities[row]; }
+
+	/**
+	 * @brief Id de cada fila; para copiar el arquetipo entero (`World::saveSnapshot`).
+	 */
+	const std::vector<EntityId>&
+	entities() const { return m_entities; }
+
+	/**
+	 * @brief Reemplaza los ids de las filas; las columnas las deja al mismo tamao quien llama.
+	 */
+	void
+	assignEntities(const std::vector<EntityId>& entities) { m_entities = entities; }
+
+	size_t
+	size() const { return m_entities.size(); }
+
+	Archetype*&
+	addEdge(ComponentTypeId typeId) { return m_addEdges[typeId]; }
+
+	Archetype*&
+	removeEdge(ComponentTypeId typeId) { return m_removeEdges[typeId]; }
+
+	/**
+	 * @brief ltimo cambio de varios tipos a la vez que sali de aqu (`World::changeComponents`).
+	 *
+	 * Las entidades de un arquetipo suelen recibir el mismo cambio en un frame; as la mayora
+	 * encuentra su destino sin buscar en el mapa de firmas.
+	 */
+	struct ChangeEdge {
+		ComponentSignature added = 0;
+		ComponentSignature removed = 0;
+		Archetype* target = nullptr;
+	};
+
+	ChangeEdge&
+	changeEdge() { return m_changeEdge; }
+
+private:
+	ComponentSignature m_signature;               ///< Tipos de este arquetipo.
+	std::vector<ComponentColumn> m_columns;       ///< Una columna por tipo, en orden de id.
+	int8_t m_columnIndex[kMaxComponentTypes];     ///< Columna de cada tipo, o -1.
+	std::vector<EntityId> m_entities;             ///< Id de cada fila.
+	ChangeEdge m_changeEdge;                      ///< Destino del ltimo cambio mltiple.
+	Archetype* m_addEdges[kMaxComponentTypes] = {};    ///< Arquetipo con un tipo ms.
+	Archetype* m_removeEdges[kMaxComponentTypes] = {}; ///< Arquetipo con un tipo menos.
+};
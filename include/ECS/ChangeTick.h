@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file ChangeTick.h
+ * @brief Reloj de cambios compartido por las columnas del `World` y los componentes.
+ *
+ * Cada escritura guarda el tick actual; cada vez que un sistema empieza, el reloj avanza y el
+ * sistema recuerda el tick en que empez. Un valor cambi desde la ltima vez si su tick es
+ * ms nuevo que ese. Las comparaciones son modulares (`isNewerTick`), as que el reloj puede
+ * dar la vuelta mientras nadie espere ms de 2^31 ticks entre dos ejecuciones.
+ */
+
+/**
+ * @brief Tick que recibe hoy una escritura. Empieza en 1: un sistema que nunca corri (0)
+ *        ve todo como cambiado.
+ */
+inline std::atomic<uint32_t> g_changeTick{ 1 };
+
+inline uint32_t
+currentChangeTick() { return g_changeTick.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Avanza el reloj.
+ * @return El tick anterior: lo que se escriba desde ahora es ms nuevo.
+ */
+inline uint32_t
+advanceChangeTick() { return g_changeTick.fetch_add(1, std::memory_order_relaxed); }
+
+/**
+ * @brief Tick de la ltima escritura de cualquier columna o componente, para saber sin
+ *        recorrer nada si el mundo cambi (el modo ocioso de `BaseApp`).
+ */
+inline std::atomic<uint32_t> g_lastChangeTick{ 0 };
+
+/**
+ * @brief Anota una escritura en el tick `now`. Solo escribe la primera vez de cada tick: las
+ *        dems son lecturas y la lnea de cach no rebota entre los hilos que escriben.
+ */
+inline void
+noteChange(uint32_t now) {
+	if (g_lastChangeTick.load(std::memory_order_relaxed) != now) {
+		g_lastChangeTick.store(now, std::memory_order_relaxed);
+	}
+}
+
+inline uint32_t
+lastChangeTick() { return g_lastChangeTick.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Indica si `tick` es posterior a `since`, aunque el reloj haya dado la vuelta.
+ */
+constexpr bool
+isNewerTick(uint32_t tick, uint32_t since) { return static_cast<int32_t>(tick - since) > 0; }
@@ -0,0 +1,224 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ECS/Archetype.h"
+#include "Memory/MemoryAccounting.h"
+#include "Memory/TUniquePtr.h"
+
+/**
+ * @brief Dnde guarda el `World` un tipo de componente de datos.
+ */
+enum class
+ComponentStorage {
+	Archetype, ///< Columna del arquetipo (por defecto): el recorrido ms rpido.
+	SparseSet  ///< `ComponentPool<T>` propio: agregar y quitar no mudan la entidad de arquetipo.
+};
+
+/**
+ * @brief Almacenamiento elegido por `T`.
+ *
+ * Un tipo lo elige declarando `static constexpr ComponentStorage kStorage`, o se especializa
+ * esta plantilla para tipos que no se pueden tocar. Sin ninguna de las dos, `Archetype`.
+ */
+template<typename T, typename = void>
+struct ComponentStorageOf : std::integral_constant<ComponentStorage, ComponentStorage::Archetype> {};
+
+template<typename T>
+struct ComponentStorageOf<T, std::void_t<decltype(T::kStorage)>>
+	: std::integral_constant<ComponentStorage, T::kStorage> {};
+
+template<typename T>
+constexpr bool kIsSparseComponent = ComponentStorageOf<T>::value == ComponentStorage::SparseSet;
+
+/**
+ * @class IComponentPool
+ * @brief Parte sin tipo de un `ComponentPool`, para que el `World` limpie entidades destruidas
+ *        y copie conjuntos enteros en sus fotos (`World::saveSnapshot`).
+ */
+class
+IComponentPool {
+public:
+	virtual
+	~IComponentPool() = default;
+
+	/**
+	 * @brief Quita el componente de la entidad.
+	 * @return `false` si no lo tena.
+	 */
+	virtual bool
+	remove(EntityId entity) = 0;
+
+	virtual size_t
+	size() const = 0;
+
+	/**
+	 * @brief `false` si el tipo no se copia: el `World` no puede tomar fotos.
+	 */
+	virtual bool
+	isCopyable() const = 0;
+
+	/**
+	 * @brief Conjunto nuevo con los mismos componentes.
+	 */
+	virtual EngineUtilities::TUniquePtr<IComponentPool>
+	clone() const = 0;
+
+	/**
+	 * @brief Deja los mismos componentes que `source`, del mismo tipo, reusando la memoria.
+	 */
+	virtual void
+	assign(const IComponentPool& source) = 0;
+
+	virtual void
+	clear() = 0;
+};
+
+/**
+ * @class ComponentPool
+ * @brief Conjunto disperso: componentes densos ms un ndice entidad -> posicin.
+ *
+ * - Agregar, quitar y buscar: O(1), sin mover la entidad de arquetipo.
+ * - Recorrer: un arreglo contiguo (`begin`/`end` o `each`).
+ * - Quitar mueve el ltimo componente al hueco; los punteros se invalidan, los ids no.
+ *
+ * Conviene para tipos que entran y salen seguido (fuentes de audio, marcas de fsica
+ * transitorias). El ndice disperso crece hasta el mayor `EntityId::index` usado.
+ *
+ * @tparam T Componente de datos.
+ */
+template<typename T>
+class
+ComponentPool final : public IComponentPool {
+public:
+	/**
+	 * @brief Agrega (o reemplaza) el componente de la entidad.
+	 */
+	template<typename... Args>
+	T&
+	emplace(EntityId entity, Args&&... args) {
+		if (T* existing = get(entity)) {
+			*existing = T(std::forward<Args>(args)...);
+			return *existing;
+		}
+		if (entity.index >= m_sparse.size()) {
+			m_sparse.resize(entity.index + 1, kNoIndex);
+		}
+		m_dense.emplace_back(std::forward<Args>(args)...);
+		m_denseEntities.push_back(entity);
+		m_sparse[entity.index] = static_cast<uint32_t>(m_dense.size() - 1);
+		return m_dense.back();
+	}
+
+	bool
+	remove(EntityId entity) override {
+		if (!contains(entity)) {
+			return false;
+		}
+		uint32_t hole = m_sparse[entity.index];
+		uint32_t last = static_cast<uint32_t>(m_dense.size() - 1);
+		if (hole != last) {
+			m_dense[hole] = std::move(m_dense[last]);
+			m_denseEntities[hole] = m_denseEntities[last];
+			m_sparse[m_denseEntities[hole].index] = hole;
+		}
+		m_dense.pop_back();
+		m_denseEntities.pop_back();
+		m_sparse[entity.index] = kNoIndex;
+		return true;
+	}
+
+	/**
+	 * @brief Componente de la entidad, o nulo. Una comprobacin de rango y una de generacin.
+	 */
+	T*
+	get(EntityId entity) {
+		return contains(entity) ? &m_dense[m_sparse[entity.index]] : nullptr;
+	}
+
+	bool
+	contains(EntityId entity) const {
+		if (entity.index >= m_sparse.size()) {
+			return false;
+		}
+		uint32_t dense = m_sparse[entity.index];
+		return dense != kNoIndex && m_denseEntities[dense] == entity;
+	}
+
+	/**
+	 * @brief Llama a `fn(EntityId, T&)` por cada componente, en orden denso.
+	 */
+	template<typename Fn>
+	void
+	each(Fn&& fn) {
+		for (size_t i = 0; i < m_dense.size(); ++i) {
+			fn(m_denseEntities[i], m_dense[i]);
+		}
+	}
+
+	size_t
+	size() const override { return m_dense.size(); }
+
+	bool
+	isCopyable() const override { return std::is_copy_constructible_v<T>; }
+
+	EngineUtilities::TUniquePtr<IComponentPool>
+	clone() const override {
+		EngineUtilities::TUniquePtr<ComponentPool<T>> copy = EngineUtilities::MakeUnique<ComponentPool<T>>();
+		copy->assign(*this);
+		return EngineUtilities::TUniquePtr<IComponentPool>(std::move(copy));
+	}
+
+	void
+	assign(const IComponentPool& source) override {
+		if constexpr (std::is_copy_constructible_v<T>) {
+			const ComponentPool<T>& other = static_cast<const ComponentPool<T>&>(source);
+			m_dense = other.m_dense;
+			m_denseEntities = other.m_denseEntities;
+			m_sparse = other.m_sparse;
+		}
+		else {
+			assert(false && "ComponentPool: el tipo no se copia");
+		}
+	}
+
+	void
+	clear() override {
+		m_dense.clear();
+		m_denseEntities.clear();
+		m_sparse.clear();
+	}
+
+	void
+	reserve(size_t capacity) {
+		m_dense.reserve(capacity);
+		m_denseEntities.reserve(capacity);
+	}
+
+	T*
+	data() { return m_dense.data(); }
+
+	/**
+	 * @brief Entidad duea de cada componente denso.
+	 */
+	const EntityId*
+	entities() const { return m_denseEntities.data(); }
+
+	T*
+	begin() { return m_dense.data(); }
+
+	T*
+	end() { return m_dense.data() + m_dense.size(); }
+
+private:
+	static constexpr uint32_t kNoIndex = 0xFFFFFFFFu;
+
+	template<typename U>
+	using Storage = EngineUtilities::TAccountedVector<U, EngineUtilities::MemoryCategory::Ecs>;
+
+	Storage<T> m_dense;                ///< Componentes contiguos.
+	Storage<EntityId> m_denseEntities; ///< Dueo de cada componente.
+	Storage<uint32_t> m_sparse;        ///< Posicin densa por `EntityId::index`, o `kNoIndex`.
+};
@@ -0,0 +1,142 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include "ECS/ComponentTraits.h"
+
+/**
+ * @brief Identificador de un tipo de componente de datos dentro del `World`.
+ *
+ * No confundir con `ComponentType`, la etiqueta de los componentes polimrficos: aqu cada
+ * struct de datos (`Position`, `Velocity`...) recibe un nmero propio la primera vez que se usa.
+ */
+using ComponentTypeId = uint32_t;
+
+/**
+ * @brief Mximo de tipos de componente de datos; uno por bit de `ComponentSignature`.
+ */
+constexpr size_t kMaxComponentTypes = 64;
+
+/**
+ * @brief Conjunto de tipos de componente de datos, un bit por `ComponentTypeId`.
+ */
+using ComponentSignature = uint64_t;
+
+/**
+ * @brief Lo que una columna necesita saber de un tipo para guardarlo sin conocerlo.
+ */
+struct ComponentInfo {
+	const char* name = nullptr;  ///< Nombre del tipo segn `typeid`.
+	size_t size = 0;             ///< `sizeof(T)`.
+	size_t alignment = 0;        ///< `alignof(T)`.
+	bool trivial = false;        ///< Trivialmente copiable: se mueve con `memcpy` y no se destruye.
+	bool relocatable = false;    ///< Se muda con `memcpy` (`kIsTriviallyRelocatable`).
+	bool triviallyDestructible = false; ///< El destructor no hace nada.
+	bool serializable = false;   ///< Sus bytes valen en otra corrida (`Serializable`).
+	void (*moveConstruct)(void* destination, void* source) = nullptr; ///< Construye en `destination` moviendo `source`.
+	void (*destroy)(void* object) = nullptr;                          ///< Llama al destructor.
+	void (*copyConstruct)(void* destination, const void* source) = nullptr; ///< Nulo si `T` no se copia.
+};
+
+/**
+ * @class ComponentRegistry
+ * @brief Asigna un `ComponentTypeId` a cada tipo de componente de datos.
+ *
+ * Los ids se reparten en orden de primer uso y no cambian durante la ejecucin. Registrar
+ * toma un mutex una sola vez por tipo; consultar `idOf<T>()` despus es una lectura esttica.
+ */
+class
+ComponentRegistry {
+public:
+	/**
+	 * @brief Id de `T`, registrndolo si es la primera vez.
+	 */
+	template<typename T>
+	static ComponentTypeId
+	idOf() {
+		static const ComponentTypeId s_id = registerType(makeInfo<T>());
+		return s_id;
+	}
+
+	/**
+	 * @brief Bit de `T` dentro de una `ComponentSignature`.
+	 */
+	template<typename T>
+	static ComponentSignature
+	bitOf() { return ComponentSignature(1) << idOf<T>(); }
+
+	/**
+	 * @brief Informacin del tipo `id`, que ya debe estar registrado.
+	 */
+	static const ComponentInfo&
+	info(ComponentTypeId id) {
+		assert(id < count());
+		return infos()[id];
+	}
+
+	/**
+	 * @brief Nmero de tipos registrados.
+	 */
+	static size_t
+	count() { return counter().load(std::memory_order_acquire); }
+
+private:
+	template<typename T>
+	static ComponentInfo
+	makeInfo() {
+		static_assert(std::is_nothrow_move_constructible_v<T>, "Los componentes de datos deben moverse sin excepciones");
+		ComponentInfo info;
+		info.name = typeid(T).name();
+		info.size = ComponentTraits<T>::size;
+		info.alignment = ComponentTraits<T>::alignment;
+		info.trivial = std::is_trivially_copyable_v<T>;
+		info.relocatable = ComponentTraits<T>::triviallyRelocatable;
+		info.triviallyDestructible = ComponentTraits<T>::triviallyDestructible;
+		info.serializable = ComponentTraits<T>::serializable;
+		info.moveConstruct = [](void* destination, void* source) {
+			::new (destination) T(std::move(*static_cast<T*>(source)));
+		};
+		info.destroy = [](void* object) { static_cast<T*>(object)->~T(); };
+		if constexpr (std::is_copy_constructible_v<T>) {
+			info.copyConstruct = [](void* destination, const void* source) {
+				::new (destination) T(*static_cast<const T*>(source));
+			};
+		}
+		return info;
+	}
+
+	static ComponentTypeId
+	registerType(const ComponentInfo& info) {
+		std::lock_guard<std::mutex> lock(mutex());
+		size_t id = counter().load(std::memory_order_relaxed);
+		assert(id < kMaxComponentTypes && "Demasiados tipos de componente de datos");
+		infos()[id] = info;
+		counter().store(id + 1, std::memory_order_release);
+		return static_cast<ComponentTypeId>(id);
+	}
+
+	static std::array<ComponentInfo, kMaxComponentTypes>&
+	infos() {
+		static std::array<ComponentInfo, kMaxComponentTypes> s_infos;
+		return s_infos;
+	}
+
+	static std::atomic<size_t>&
+	counter() {
+		static std::atomic<size_t> s_count{ 0 };
+		return s_count;
+	}
+
+	static std::mutex&
+	mutex() {
+		static std::mutex s_mutex;
+		return s_mutex;
+	}
+};
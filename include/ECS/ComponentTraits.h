@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @file ComponentTraits.h
+ * @brief Propiedades de un tipo de componente de datos conocidas en compilacin.
+ *
+ * `ComponentRegistry` las copia a `ComponentInfo` al registrar el tipo, y las columnas de los
+ * arquetipos eligen con ellas cmo mudar y destruir filas sin conocer el tipo.
+ */
+
+/**
+ * @brief Indica si un `T` puede mudarse de direccin copiando sus bytes y olvidando el original,
+ *        sin llamar a su constructor de movimiento ni a su destructor.
+ *
+ * Por defecto solo los trivialmente copiables. Un tipo que no lo es pero se muda bien con
+ * `memcpy` (no guarda punteros a s mismo; p. ej. uno que solo tiene un puntero a memoria
+ * propia) puede declararlo especializando:
+ *
+ *     template<> struct TriviallyRelocatable<Path> : std::true_type {};
+ */
+template<typename T>
+struct TriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+constexpr bool kIsTriviallyRelocatable = TriviallyRelocatable<T>::value;
+
+/**
+ * @brief Indica si los bytes de un `T` siguen valiendo en otra corrida: lo que `SaveJournal`
+ *        guarda en disco.
+ *
+ * Por defecto los `pod`. Uno que guarda punteros (`ComponentRef`) no, aunque se copie con
+ * `memcpy`; se declara especializando:
+ *
+ *     template<typename T> struct Serializable<ComponentRef<T>> : std::false_type {};
+ */
+template<typename T>
+struct Serializable : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>> {};
+
+/**
+ * @brief Rasgos de `T` como componente de datos.
+ */
+template<typename T>
+struct ComponentTraits {
+	static constexpr size_t size = sizeof(T);
+	static constexpr size_t alignment = alignof(T);
+
+	/** Se copia con `memcpy` y no necesita destructor (la serializacin lo exige). */
+	static constexpr bool pod = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>;
+
+	/** Las columnas lo mudan con `memcpy` al crecer o rellenar huecos. */
+	static constexpr bool triviallyRelocatable = kIsTriviallyRelocatable<T>;
+
+	/** Sus bytes se guardan tal cual en una partida (`Serializable`). */
+	static constexpr bool serializable = pod && Serializable<T>::value;
+
+	/** Quitar una fila no llama a nada. */
+	static constexpr bool triviallyDestructible = std::is_trivially_destructible_v<T>;
+};
@@ -0,0 +1,209 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ECS/World.h"
+#include "Memory/LinearArena.h"
+#include "Memory/TUniquePtr.h"
+
+/**
+ * @brief Entidad pedida con `EntityCommandBuffer::spawn`; existe recin despus de `playback`.
+ */
+struct PendingEntity {
+	uint32_t stream = 0; ///< Flujo del hilo que la pidi.
+	uint32_t index = 0;  ///< Orden dentro de ese flujo.
+};
+
+/**
+ * @class EntityCommandBuffer
+ * @brief Cambios estructurales diferidos: crear, destruir, agregar y quitar componentes.
+ *
+ * Los sistemas (tambin desde los hilos de trabajo) anotan aqu lo que haran con
+ * `World::createEntity`, `addComponent`, etc. mientras otros recorren el mundo. `playback`
+ * lo aplica todo junto en el punto de sincronizacin del frame: ordena los comandos por
+ * entidad, junta los de cada una y hace una sola mudanza de arquetipo por entidad, en vez de
+ * una por operacin.
+ *
+ * Cada hilo escribe en su propio flujo (sin candados despus del primer uso); los valores de
+ * los componentes se guardan en la `LinearArena` del flujo hasta la reproduccin. Dentro de
+ * una entidad, los comandos de un mismo hilo se aplican en el orden en que se anotaron: el
+ * ltimo `addComponent` de un tipo gana y `destroy` gana sobre todo lo dems.
+ *
+ * `playback` se llama en un solo hilo, sin nadie anotando a la vez.
+ *
+ * Es un servicio (`TService<EntityCommandBuffer>`).
+ */
+class
+EntityCommandBuffer {
+public:
+	EntityCommandBuffer();
+
+	~EntityCommandBuffer();
+
+	EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+	EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+	/**
+	 * @brief Pide una entidad nueva; se le pueden agregar componentes antes de que exista.
+	 */
+	PendingEntity
+	spawn();
+
+	/**
+	 * @brief Destruye la entidad al reproducir. Si ya no existe para entonces, no hace nada.
+	 */
+	void
+	destroy(EntityId entity);
+
+	/**
+	 * @brief Agrega (o reemplaza) el componente `T` al reproducir.
+	 *
+	 * El valor se construye ahora, en la memoria del flujo de este hilo.
+	 */
+	template<typename T, typename... Args>
+	void
+	addComponent(EntityId entity, Args&&... args) {
+		Stream& stream = localStream();
+		record(stream, entity, 0, Op::Add, ComponentRegistry::idOf<T>(), &opsFor<T>(),
+			payloadFor<T>(stream, std::forward<Args>(args)...));
+	}
+
+	template<typename T, typename... Args>
+	void
+	addComponent(PendingEntity entity, Args&&... args) {
+		Stream& stream = localStream();
+		record(stream, EntityId{}, pendingKey(entity), Op::Add, ComponentRegistry::idOf<T>(), &opsFor<T>(),
+			payloadFor<T>(stream, std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Quita el componente `T` al reproducir, si lo tiene para entonces.
+	 */
+	template<typename T>
+	void
+	removeComponent(EntityId entity) {
+		record(localStream(), entity, 0, Op::Remove, ComponentRegistry::idOf<T>(), &opsFor<T>(), nullptr);
+	}
+
+	/**
+	 * @brief Aplica todo lo anotado a `world` y vaca el bfer.
+	 */
+	void
+	playback(World& world);
+
+	/**
+	 * @brief Id que recibi `entity` en el ltimo `playback`.
+	 */
+	EntityId
+	resolve(PendingEntity entity) const;
+
+	/**
+	 * @brief Comandos anotados desde el ltimo `playback`. Solo sin nadie anotando a la vez.
+	 */
+	size_t
+	size() const;
+
+private:
+	enum class Op : uint8_t { Add, Remove, Destroy };
+
+	/**
+	 * @brief Lo que se necesita de `T` para reproducir sin conocer el tipo.
+	 */
+	struct PayloadOps {
+		bool sparse = false;                                       ///< Vive en un `ComponentPool`.
+		void (*construct)(void* slot, void* payload) = nullptr;    ///< Construye moviendo el valor.
+		void (*destroy)(void* payload) = nullptr;                  ///< Destruye el valor; nulo si es trivial.
+		void (*addSparse)(World&, EntityId, void* payload) = nullptr;
+		void (*removeSparse)(World&, EntityId) = nullptr;
+	};
+
+	struct Command {
+		EntityId entity;            ///< Destino; nulo si es una `PendingEntity`.
+		uint32_t pending = 0;       ///< `pendingKey` de la entidad pedida, o 0.
+		Op op = Op::Add;
+		ComponentTypeId type = 0;
+		const PayloadOps* ops = nullptr;
+		void* payload = nullptr;    ///< Valor de `Add`, en la arena del flujo.
+	};
+
+	/**
+	 * @brief Comandos de un hilo.
+	 */
+	struct Stream {
+		Stream(std::thread::id thread, uint32_t position) : owner(thread), index(position) {}
+
+		std::thread::id owner;
+		uint32_t index;             ///< Posicin en `m_streams`.
+		std::vector<Command> commands;
+		EngineUtilities::LinearArena arena{ 16 * 1024, EngineUtilities::MemoryCategory::Ecs };
+		uint32_t spawned = 0;       ///< `spawn` desde el ltimo `playback`.
+		std::vector<EntityId> ids;  ///< Ids de las entidades pedidas, tras el `playback`.
+	};
+
+	template<typename T>
+	static const PayloadOps&
+	opsFor() {
+		static const PayloadOps s_ops = [] {
+			PayloadOps ops;
+			ops.sparse = kIsSparseComponent<T>;
+			ops.construct = [](void* slot, void* payload) { ::new (slot) T(std::move(*static_cast<T*>(payload))); };
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				ops.destroy = [](void* payload) { static_cast<T*>(payload)->~T(); };
+			}
+			if constexpr (kIsSparseComponent<T>) {
+				ops.addSparse = [](World& world, EntityId entity, void* payload) {
+					world.addComponent<T>(entity, std::move(*static_cast<T*>(payload)));
+				};
+				ops.removeSparse = [](World& world, EntityId entity) { world.removeComponent<T>(entity); };
+			}
+			return ops;
+		}();
+		return s_ops;
+	}
+
+	template<typename T, typename... Args>
+	static void*
+	payloadFor(Stream& stream, Args&&... args) {
+		return ::new (stream.arena.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Clave de una entidad pedida: flujo en los 8 bits altos, ndice + 1 en el resto.
+	 */
+	static uint32_t
+	pendingKey(PendingEntity entity) { return (entity.stream << 24) | (entity.index + 1); }
+
+	static void
+	record(Stream& stream, EntityId entity, uint32_t pending, Op op, ComponentTypeId type, const PayloadOps* ops,
+		void* payload);
+
+	/**
+	 * @brief Comando en la posicin `sorted` del orden de reproduccin.
+	 */
+	const Command&
+	commandAt(size_t sorted) const {
+		uint64_t key = m_order[sorted];
+		return m_streams[(key >> 24) & 0xFF]->commands[key & 0xFFFFFF];
+	}
+
+	/**
+	 * @brief Destruye los valores que guardan los comandos de `stream`.
+	 */
+	static void
+	destroyPayloads(Stream& stream);
+
+	/**
+	 * @brief Flujo del hilo actual, crendolo la primera vez.
+	 */
+	Stream&
+	localStream();
+
+	std::vector<EngineUtilities::TUniquePtr<Stream>> m_streams; ///< Uno por hilo que anot algo.
+	mutable std::mutex m_streamsMutex;                          ///< Protege `m_streams` al crear flujos.
+	uint64_t m_id;                                              ///< Distingue bferes en la cach por hilo.
+	std::vector<uint64_t> m_order;                              ///< `ndice << 32 | flujo << 24 | posicin`, ordenado.
+};
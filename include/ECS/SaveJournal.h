@@ -0,0 +1,169 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ECS/WorldSnapshot.h"
+
+/**
+ * @class SaveJournal
+ * @brief Partida guardada por diferencias: cada `checkpoint` agrega al archivo solo los
+ *        componentes de datos que cambiaron desde el anterior, sin detener el bucle principal.
+ *
+ * En el hilo principal `checkpoint` solo llena un `WorldSnapshot`, que ya copia por
+ * diferencias (los ticks de `ChangeTick.h`); un hilo propio lee esa foto y escribe. Un
+ * arquetipo que sigue con las mismas entidades escribe solo los bloques de
+ * `kChangeBlockRows` filas que la foto recibi esta vez; uno que cambi de entidades se
+ * escribe entero. Mientras el hilo escribe, los `checkpoint` se saltan: lo que cambi queda
+ * para la foto siguiente, que lo acumula.
+ *
+ * El archivo es una fila de trozos, cada uno con cabecera (`"GSAV"`, si es completo, bytes y
+ * FNV-1a de lo que sigue). El primer trozo de cada `open`, y cada vez que las diferencias
+ * suman `kCompactRatio` veces el ltimo completo, el hilo escribe un trozo completo en
+ * `path.tmp` y lo renombra sobre el diario: compacta sin que un corte deje el archivo a medias.
+ * Al leer, un trozo truncado o que no coincide termina el diario en el anterior.
+ *
+ * Se guardan los tipos `ComponentInfo::serializable`, identificados por `sceneTypeHash` de su
+ * nombre. Las `ComponentRef` de los actores y los conjuntos dispersos no: la escena los
+ * vuelve a armar, con los mismos ids, y `load` les devuelve sus datos.
+ *
+ * `open`, `checkpoint`, `wait`, `close` y `load` desde el hilo principal.
+ */
+class
+SaveJournal {
+public:
+	static constexpr uint32_t kVersion = 1;
+	static constexpr size_t kCompactRatio = 2; ///< Diferencias sobre el ltimo trozo completo antes de compactar.
+
+	SaveJournal() = default;
+
+	~SaveJournal() { close(); }
+
+	SaveJournal(const SaveJournal&) = delete;
+	SaveJournal& operator=(const SaveJournal&) = delete;
+
+	/**
+	 * @brief Empieza a guardar en `path`; el primer `checkpoint` lo reemplaza por un trozo completo.
+	 * @return `false` si ya estaba abierto o no pudo crearse el archivo.
+	 */
+	bool
+	open(const std::string& path);
+
+	/**
+	 * @brief Espera lo que se est escribiendo y une el hilo.
+	 */
+	void
+	close();
+
+	bool
+	isOpen() const { return m_running; }
+
+	/**
+	 * @brief Copia lo que cambi de `world` y lo entrega al hilo para escribirlo.
+	 *
+	 * En un punto de sincronizacin, sin sistemas corriendo (`World::saveSnapshot`).
+	 * @return `false` si el hilo sigue con el anterior o algn tipo no se puede copiar; lo que
+	 *         cambi entra en el prximo.
+	 */
+	bool
+	checkpoint(World& world);
+
+	/**
+	 * @brief Espera a que el hilo termine de escribir lo entregado.
+	 */
+	void
+	wait();
+
+	/**
+	 * @brief Bytes escritos por el ltimo trozo, completo o de diferencias.
+	 */
+	size_t
+	lastChunkBytes() const;
+
+	/**
+	 * @brief Devuelve a las entidades vivas de `world` los componentes guardados en `path`.
+	 *
+	 * Las entidades que ya no existen se saltan, y los tipos que no estn registrados o
+	 * cambiaron de tamao tambin.
+	 * @return Entidades restauradas, o -1 si el archivo no existe o su primer trozo no vale.
+	 */
+	static int64_t
+	load(const std::string& path, World& world);
+
+private:
+	struct ChunkHeader {
+		char magic[4];
+		uint32_t version;
+		uint32_t flags;          ///< `kChunkFull`.
+		uint32_t recordCount;
+		uint64_t payloadBytes;   ///< Lo que sigue a la cabecera.
+		uint64_t checksum;       ///< FNV-1a de esos bytes.
+	};
+
+	/**
+	 * @brief Un arquetipo dentro de un trozo; le siguen sus ids, si se reemplaza, y sus columnas.
+	 */
+	struct Record {
+		uint32_t archetype;      ///< ndice en el `World` que lo escribi.
+		uint32_t flags;          ///< `kRecordReplaced`.
+		uint32_t rowCount;
+		uint32_t columnCount;
+	};
+
+	/**
+	 * @brief Una columna de un `Record`; le siguen `runCount` tramos `Run` con sus filas.
+	 */
+	struct Column {
+		uint64_t typeHash;       ///< `sceneTypeHash` del nombre del tipo.
+		uint32_t size;           ///< `sizeof` del tipo.
+		uint32_t runCount;
+	};
+
+	struct Run {
+		uint32_t firstRow;
+		uint32_t rows;
+	};
+
+	static constexpr uint32_t kChunkFull = 1u << 0;      ///< Trae el mundo entero: lo anterior se descarta.
+	static constexpr uint32_t kRecordReplaced = 1u << 0; ///< Trae sus entidades y todas sus filas.
+
+	void
+	writeLoop();
+
+	/**
+	 * @brief Arma en `m_payload` el trozo de la foto: entero o lo posterior a `since`.
+	 * @return Registros escritos.
+	 */
+	uint32_t
+	buildChunk(bool full, uint32_t since);
+
+	/**
+	 * @brief Escribe el trozo armado: agregado al diario o, si es completo, en su lugar.
+	 */
+	bool
+	writeChunk(bool full, uint32_t recordCount);
+
+	std::string m_path;
+	WorldSnapshot m_snapshot;            ///< La leen el hilo mientras `m_busy` y el principal si no.
+	uint32_t m_copyTick = 0;             ///< Tick con que la foto marc lo ltimo que copi.
+	std::thread m_thread;
+	mutable std::mutex m_mutex;          ///< Protege lo de abajo contra el hilo.
+	std::condition_variable m_wake;      ///< Foto nueva o `close`.
+	std::condition_variable m_idle;      ///< El hilo termin de escribir.
+	bool m_busy = false;                 ///< El hilo tiene una foto que escribir.
+	bool m_stopping = false;
+	bool m_running = false;
+	uint32_t m_since = 0;                ///< Tick de la foto que ya est escrita.
+	size_t m_lastChunk = 0;
+
+	// Solo del hilo
+	std::ofstream m_file;
+	std::vector<unsigned char> m_payload;                     ///< Trozo en armado; conserva su capacidad.
+	std::vector<std::vector<EntityId>> m_written;             ///< Entidades de cada arquetipo ya en el diario.
+	bool m_needFull = true;
+	size_t m_fullBytes = 0;              ///< Tamao del ltimo trozo completo.
+	size_t m_deltaBytes = 0;             ///< Diferencias agregadas desde entonces.
+};
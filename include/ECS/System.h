@@ -0,0 +1,158 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "Component.h"
+#include "ECS/ComponentRegistry.h"
+
+class World;
+
+/**
+ * @brief Tipos de componente que un sistema lee y escribe.
+ *
+ * Guarda por separado los componentes de datos del `World` (`ComponentSignature`) y los
+ * componentes polimrficos con etiqueta (`ComponentMask`, por `StaticType`).
+ */
+struct ComponentAccess {
+	ComponentSignature readData = 0;
+	ComponentSignature writeData = 0;
+	ComponentMask readTagged = 0;
+	ComponentMask writeTagged = 0;
+
+	/**
+	 * @brief Declara lectura de `T`.
+	 */
+	template<typename T>
+	ComponentAccess&
+	reads() {
+		if constexpr (std::is_base_of<Component, T>::value) {
+			readTagged |= componentBit(T::StaticType);
+		}
+		else {
+			readData |= ComponentRegistry::bitOf<T>();
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Declara escritura de `T` (incluye leerlo).
+	 */
+	template<typename T>
+	ComponentAccess&
+	writes() {
+		if constexpr (std::is_base_of<Component, T>::value) {
+			writeTagged |= componentBit(T::StaticType);
+		}
+		else {
+			writeData |= ComponentRegistry::bitOf<T>();
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Dos sistemas chocan si uno escribe algo que el otro lee o escribe.
+	 */
+	bool
+	conflictsWith(const ComponentAccess& other) const {
+		ComponentSignature dataMine = readData | writeData;
+		ComponentSignature dataTheirs = other.readData | other.writeData;
+		ComponentMask taggedMine = readTagged | writeTagged;
+		ComponentMask taggedTheirs = other.readTagged | other.writeTagged;
+		return (writeData & dataTheirs) || (other.writeData & dataMine) ||
+		       (writeTagged & taggedTheirs) || (other.writeTagged & taggedMine);
+	}
+};
+
+/**
+ * @class System
+ * @brief Lgica que corre una vez por frame sobre los componentes que declara en `access()`.
+ *
+ * `SystemScheduler` ejecuta al mismo tiempo los sistemas cuyos accesos no chocan. Durante
+ * `update` un sistema no debe crear ni destruir entidades ni agregar/quitar componentes:
+ * solo leer y escribir los valores de los tipos que declar.
+ */
+class
+System {
+public:
+	virtual
+	~System() = default;
+
+	/**
+	 * @brief Nombre para depuracin y perfiles.
+	 */
+	virtual const char*
+	getName() const = 0;
+
+	/**
+	 * @brief Ejecuta el sistema. Puede correr en un hilo de trabajo.
+	 * @param world Componentes de datos.
+	 * @param deltaTime Tiempo desde el frame anterior.
+	 */
+	virtual void
+	update(World& world, float deltaTime) = 0;
+
+	/**
+	 * @brief Componentes que lee y escribe; se consulta al armar el grafo de dependencias.
+	 */
+	const ComponentAccess&
+	access() const { return m_access; }
+
+	/**
+	 * @brief Tick en que empez la ejecucin anterior; 0 si es la primera.
+	 *
+	 * Durante `update`, `view.eachChanged(lastRunTick(), fn)` recorre solo lo que cambi desde
+	 * entonces, incluido lo que escribieron otros sistemas despus de que este termin.
+	 */
+	uint32_t
+	lastRunTick() const { return m_lastRunTick; }
+
+protected:
+	ComponentAccess m_access; ///< Lo declara cada sistema en su constructor.
+
+private:
+	friend class SystemScheduler;
+
+	uint32_t m_lastRunTick = 0; ///< Lo actualiza `SystemScheduler` al terminar cada ejecucin.
+};
+
+/**
+ * @class FunctionSystem
+ * @brief Sistema hecho de una funcin, para lgica corta de la aplicacin.
+ *
+ * La versin reactiva recibe adems `lastRunTick()`, para pasarlo a `eachChanged`.
+ */
+class
+FunctionSystem final : public System {
+public:
+	using Function = std::function<void(World&, float)>;
+	using ReactiveFunction = std::function<void(World&, float, uint32_t sinceTick)>;
+
+	FunctionSystem(std::string name, const ComponentAccess& access, Function function)
+		: m_name(std::move(name)), m_function(std::move(function)) {
+		m_access = access;
+	}
+
+	FunctionSystem(std::string name, const ComponentAccess& access, ReactiveFunction function)
+		: m_name(std::move(name)), m_reactive(std::move(function)) {
+		m_access = access;
+	}
+
+	const char*
+	getName() const override { return m_name.c_str(); }
+
+	void
+	update(World& world, float deltaTime) override {
+		if (m_reactive) {
+			m_reactive(world, deltaTime, lastRunTick());
+		}
+		else {
+			m_function(world, deltaTime);
+		}
+	}
+
+private:
+	std::string m_name;           ///< Nombre del sistema.
+	Function m_function;          ///< Cuerpo del sistema.
+	ReactiveFunction m_reactive;  ///< Cuerpo de un sistema reactivo; si est, se usa este.
+};
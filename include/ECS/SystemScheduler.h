@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include "ECS/System.h"
+#include "Jobs/JobSystem.h"
+#include "Memory/TUniquePtr.h"
+
+/**
+ * @class SystemScheduler
+ * @brief Ejecuta los sistemas de cada frame en paralelo respetando sus accesos.
+ *
+ * Al agregar sistemas se arma un grafo: si dos sistemas chocan (`ComponentAccess`), el que
+ * se agreg primero corre antes. Cada frame, `run` lanza en el `JobSystem` los sistemas
+ * sin dependencias pendientes y, al terminar cada uno, los que quedan listos. El hilo que
+ * llama ejecuta trabajos mientras espera el `JobCounter` del frame.
+ *
+ * Sin hilos de trabajo, corre todo en orden en el hilo que llama.
+ *
+ * Cada ejecucin de un sistema avanza el reloj de cambios (`ChangeTick.h`) y deja en el
+ * sistema el tick en que empez (`System::lastRunTick`).
+ */
+class
+SystemScheduler {
+public:
+	explicit
+	SystemScheduler(JobSystem& jobs);
+
+	SystemScheduler(const SystemScheduler&) = delete;
+	SystemScheduler&
+	operator=(const SystemScheduler&) = delete;
+
+	/**
+	 * @brief Agrega un sistema construido con `args`.
+	 * @return Referencia al sistema (el scheduler es su dueo).
+	 */
+	template<typename T, typename... Args>
+	T&
+	addSystem(Args&&... args) {
+		EngineUtilities::TUniquePtr<T> system = EngineUtilities::MakeUnique<T>(std::forward<Args>(args)...);
+		T& added = *system;
+		m_systems.push_back(std::move(system));
+		m_graphDirty = true;
+		return added;
+	}
+
+	/**
+	 * @brief Agrega un `FunctionSystem`.
+	 */
+	System&
+	addSystem(std::string name, const ComponentAccess& access, FunctionSystem::Function function) {
+		return addSystem<FunctionSystem>(std::move(name), access, std::move(function));
+	}
+
+	/**
+	 * @brief Agrega un `FunctionSystem` reactivo: `function(world, dt, sinceTick)`.
+	 */
+	System&
+	addReactiveSystem(std::string name, const ComponentAccess& access, FunctionSystem::ReactiveFunction function) {
+		return addSystem<FunctionSystem>(std::move(name), access, std::move(function));
+	}
+
+	/**
+	 * @brief Ejecuta todos los sistemas una vez y regresa cuando terminaron.
+	 */
+	void
+	run(World& world, float deltaTime);
+
+	size_t
+	systemCount() const { return m_systems.size(); }
+
+	/**
+	 * @brief Sistemas que deben terminar antes de que empiece `index`.
+	 */
+	size_t
+	dependencyCount(size_t index) const { return m_dependencyCount[index]; }
+
+private:
+	void
+	buildGraph();
+
+	/**
+	 * @brief Ejecuta el sistema `index` y libera a los que dependan de l.
+	 */
+	void
+	runSystem(size_t index);
+
+	/**
+	 * @brief Ejecuta un sistema avanzando el reloj de cambios.
+	 */
+	void
+	execute(System& system, World& world, float deltaTime);
+
+	JobSystem& m_jobs;                                          ///< Hilos donde corren los sistemas.
+	std::vector<EngineUtilities::TUniquePtr<System>> m_systems; ///< En orden de registro.
+	std::vector<std::vector<size_t>> m_dependents;              ///< Sistemas que esperan a cada uno.
+	std::vector<uint32_t> m_dependencyCount;                    ///< Dependencias de cada sistema.
+	std::vector<size_t> m_roots;                                ///< Sistemas sin dependencias.
+	bool m_graphDirty = false;                                  ///< Hay que rearmar el grafo.
+
+	// Estado del frame en curso
+	EngineUtilities::TUniquePtr<std::atomic<uint32_t>[]> m_pending; ///< Dependencias sin terminar.
+	JobCounter m_frame;                                         ///< Sistemas lanzados sin terminar.
+	World* m_world = nullptr;                                   ///< Argumentos de `run`.
+	float m_deltaTime = 0.0f;
+};
@@ -0,0 +1,331 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "Component.h"
+#include "ECS/Archetype.h"
+
+/**
+ * @brief Referencia a un componente polimrfico (`Component`) guardada como dato del `World`.
+ *
+ * `Entity::addComponent` agrega una por cada tipo con `StaticType`, as los actores entran
+ * en los arquetipos y `World::view<Transform, ShapeFactory>()` los encuentra. El componente
+ * sigue siendo de la entidad; la referencia vive lo mismo que ella.
+ */
+template<typename T>
+struct ComponentRef {
+	T* component = nullptr;
+};
+
+/**
+ * @brief Un puntero no sirve en otra corrida: las partidas no guardan referencias.
+ */
+template<typename T>
+struct Serializable<ComponentRef<T>> : std::false_type {};
+
+/**
+ * @brief Tipo que se guarda en las columnas para `T`: el propio `T`, o `ComponentRef<T>` si
+ *        `T` deriva de `Component`. `const T` se guarda igual que `T`.
+ */
+template<typename T>
+using StoredComponent = std::conditional_t<std::is_base_of<Component, T>::value,
+	ComponentRef<std::remove_const_t<T>>, std::remove_const_t<T>>;
+
+/**
+ * @brief Arquetipos que tienen todos los tipos de una consulta.
+ *
+ * El `World` guarda uno por conjunto de tipos consultado y le agrega cada arquetipo nuevo
+ * que coincida; las entidades que cambian de arquetipo no lo tocan, porque la lista es de
+ * arquetipos, no de entidades.
+ */
+struct QueryCache {
+	ComponentSignature required = 0;   ///< Tipos que deben estar.
+	std::vector<Archetype*> archetypes; ///< Arquetipos con todos los `required`.
+};
+
+/**
+ * @class WorldView
+ * @brief Rango de las entidades que tienen todos los `Ts`, sobre una `QueryCache`.
+ *
+ * Se recorre con `each(fn)` (un puntero por columna, lo ms rpido) o con un `for` de rango:
+ * `for (auto [entity, transform, shape] : world.view<Transform, ShapeFactory>())`. Los
+ * componentes polimrficos llegan como `T&`, los de datos como referencia a su columna.
+ *
+ * Un tipo de datos sin `const` cuenta como escrito: recorrerlo sube el tick de cambio de los
+ * bloques de filas visitados. Los que solo se leen van como `const T` (`view<const Velocity, Position>`)
+ * para no aparecer como cambiados. Los componentes polimrficos marcan sus propios cambios.
+ * `eachChanged` recorre solo las filas que cambiaron desde un tick, p. ej. la ltima vez que
+ * corri el sistema (`System::lastRunTick`).
+ *
+ * Mientras se recorre no deben agregarse ni quitarse componentes.
+ */
+template<typename... Ts>
+class
+WorldView {
+public:
+	using Row = std::tuple<EntityId, Ts&...>;
+
+	explicit
+	WorldView(const QueryCache& cache) : m_cache(&cache) {}
+
+	/**
+	 * @brief Llama a `fn(EntityId, Ts&...)` por cada entidad.
+	 */
+	template<typename Fn>
+	void
+	each(Fn&& fn) const {
+		for (Archetype* archetype : m_cache->archetypes) {
+			if (archetype->size() != 0) {
+				eachRow(*archetype, 0, archetype->size(), fn);
+			}
+		}
+	}
+
+	/**
+	 * @brief Llama a `fn(EntityId, Ts&...)` por las filas `[begin, end)` de `archetype`, que
+	 *        debe ser uno de `archetypes()`. Lo usan los recorridos por trozos en paralelo;
+	 *        trozos simultneos deben empezar en mltiplos de `kChangeBlockRows`.
+	 */
+	template<typename Fn>
+	static void
+	eachRow(Archetype& archetype, size_t begin, size_t end, Fn& fn) {
+		markWritten(archetype, begin, end);
+		auto columns = std::make_tuple(archetype.template columnData<StoredComponent<Ts>>()...);
+		for (size_t row = begin; row < end; ++row) {
+			fn(archetype.entityAt(row), resolve<Ts>(std::get<StoredComponent<Ts>*>(columns)[row])...);
+		}
+	}
+
+	/**
+	 * @brief Llama a `fn(EntityId, Ts&...)` solo por las entidades en las que alguno de los
+	 *        `Watched` (por defecto, todos los `Ts`) cambi despus de `since`.
+	 *
+	 * Los datos se comparan por bloque de filas: las columnas y los bloques sin cambios se
+	 * saltan enteros, y un bloque cambiado se recorre completo, as que pueden llegar vecinos
+	 * que no cambiaron. Los componentes polimrficos se revisan uno por uno con
+	 * `Component::getChangeTick`.
+	 */
+	template<typename... Watched, typename Fn>
+	void
+	eachChanged(uint32_t since, Fn&& fn) const {
+		if constexpr (sizeof...(Watched) == 0) {
+			eachChangedIn<Ts...>(since, fn);
+		}
+		else {
+			static_assert((isViewed<Watched> && ...), "eachChanged solo vigila tipos de la vista");
+			eachChangedIn<Watched...>(since, fn);
+		}
+	}
+
+	/**
+	 * @brief Arquetipos de la consulta, incluidos los vacos.
+	 */
+	const std::vector<Archetype*>&
+	archetypes() const { return m_cache->archetypes; }
+
+	/**
+	 * @brief Entidades en la vista; recorre la lista de arquetipos, no las entidades.
+	 */
+	size_t
+	size() const {
+		size_t count = 0;
+		for (Archetype* archetype : m_cache->archetypes) {
+			count += archetype->size();
+		}
+		return count;
+	}
+
+	bool
+	empty() const { return begin() == end(); }
+
+	class
+	iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Row;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = Row;
+
+		iterator() = default;
+
+		iterator(const std::vector<Archetype*>* archetypes, size_t archetype)
+			: m_archetypes(archetypes), m_archetype(archetype) {
+			skipEmpty();
+		}
+
+		Row
+		operator*() const {
+			Archetype& archetype = *(*m_archetypes)[m_archetype];
+			markWritten(archetype, m_row);
+			return Row(archetype.entityAt(m_row),
+			           resolve<Ts>(archetype.template columnData<StoredComponent<Ts>>()[m_row])...);
+		}
+
+		iterator&
+		operator++() {
+			if (++m_row >= (*m_archetypes)[m_archetype]->size()) {
+				++m_archetype;
+				m_row = 0;
+				skipEmpty();
+			}
+			return *this;
+		}
+
+		iterator
+		operator++(int) {
+			iterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		bool
+		operator==(const iterator& other) const { return m_archetype == other.m_archetype && m_row == other.m_row; }
+
+		bool
+		operator!=(const iterator& other) const { return !(*this == other); }
+
+	private:
+		void
+		skipEmpty() {
+			while (m_archetype < m_archetypes->size() && (*m_archetypes)[m_archetype]->size() == 0) {
+				++m_archetype;
+			}
+		}
+
+		const std::vector<Archetype*>* m_archetypes = nullptr;
+		size_t m_archetype = 0; ///< Arquetipo actual; `size()` al terminar.
+		size_t m_row = 0;       ///< Fila dentro del arquetipo.
+	};
+
+	iterator
+	begin() const { return iterator(&m_cache->archetypes, 0); }
+
+	iterator
+	end() const { return iterator(&m_cache->archetypes, m_cache->archetypes.size()); }
+
+private:
+	template<typename T>
+	static constexpr bool isViewed = (std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>> || ...);
+
+	/**
+	 * @brief Sube el tick de las filas `[begin, end)` en las columnas de datos sin `const`.
+	 */
+	static void
+	markWritten(Archetype& archetype, size_t begin, size_t end) {
+		(markColumn<Ts>(archetype, begin, end), ...);
+	}
+
+	static void
+	markWritten(Archetype& archetype, size_t row) {
+		(markColumn<Ts>(archetype, row, row + 1), ...);
+	}
+
+	template<typename T>
+	static void
+	markColumn(Archetype& archetype, size_t begin, size_t end) {
+		if constexpr (!std::is_const_v<T> && !std::is_base_of<Component, T>::value) {
+			ComponentColumn* column = archetype.column(ComponentRegistry::idOf<T>());
+			if (end == begin + 1) {
+				column->markChanged(begin);
+			}
+			else {
+				column->markChanged(begin, end);
+			}
+		}
+	}
+
+	/**
+	 * @brief Lee los ticks de cambio de `T` en un arquetipo: por bloque de la columna para los
+	 *        datos, de cada componente para los polimrficos.
+	 */
+	template<typename T, bool = std::is_base_of<Component, T>::value>
+	struct TickReader {
+		static constexpr bool kPerRow = false;
+
+		explicit
+		TickReader(Archetype& archetype) : column(archetype.column(ComponentRegistry::idOf<StoredComponent<T>>())) {}
+
+		bool
+		anyNewer(uint32_t since) const { return isNewerTick(column->lastChangeTick(), since); }
+
+		bool
+		blockNewer(size_t block, uint32_t since) const { return isNewerTick(column->blockTick(block), since); }
+
+		bool
+		rowNewer(size_t, uint32_t) const { return false; }
+
+		const ComponentColumn* column;
+	};
+
+	template<typename T>
+	struct TickReader<T, true> {
+		static constexpr bool kPerRow = true;
+
+		explicit
+		TickReader(Archetype& archetype) : refs(archetype.template columnData<StoredComponent<T>>()) {}
+
+		bool
+		anyNewer(uint32_t) const { return true; }
+
+		bool
+		blockNewer(size_t, uint32_t) const { return false; }
+
+		bool
+		rowNewer(size_t row, uint32_t since) const { return isNewerTick(refs[row].component->getChangeTick(), since); }
+
+		const StoredComponent<T>* refs;
+	};
+
+	template<typename... Watched, typename Fn>
+	void
+	eachChangedIn(uint32_t since, Fn& fn) const {
+		constexpr bool perRow = (TickReader<Watched>::kPerRow || ...);
+		for (Archetype* archetype : m_cache->archetypes) {
+			size_t rows = archetype->size();
+			if (rows == 0) {
+				continue;
+			}
+			std::tuple<TickReader<Watched>...> readers{ TickReader<Watched>(*archetype)... };
+			if (!(std::get<TickReader<Watched>>(readers).anyNewer(since) || ...)) {
+				continue;
+			}
+			auto columns = std::make_tuple(archetype->template columnData<StoredComponent<Ts>>()...);
+			for (size_t begin = 0; begin < rows; begin += kChangeBlockRows) {
+				size_t end = std::min(rows, begin + kChangeBlockRows);
+				size_t block = begin / kChangeBlockRows;
+				bool whole = (std::get<TickReader<Watched>>(readers).blockNewer(block, since) || ...);
+				if (whole) {
+					markWritten(*archetype, begin, end);
+				}
+				else if (!perRow) {
+					continue;
+				}
+				for (size_t row = begin; row < end; ++row) {
+					if (whole || (std::get<TickReader<Watched>>(readers).rowNewer(row, since) || ...)) {
+						if (!whole) {
+							markWritten(*archetype, row);
+						}
+						fn(archetype->entityAt(row), resolve<Ts>(std::get<StoredComponent<Ts>*>(columns)[row])...);
+					}
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	static T&
+	resolve(StoredComponent<T>& stored) {
+		if constexpr (std::is_base_of<Component, T>::value) {
+			return *stored.component;
+		}
+		else {
+			return stored;
+		}
+	}
+
+	const QueryCache* m_cache; ///< Lista que mantiene el `World`.
+};
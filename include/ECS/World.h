@@ -0,0 +1,329 @@
+#pragma once
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ECS/Archetype.h"
+#include "ECS/ComponentPool.h"
+#include "ECS/View.h"
+#include "Memory/TUniquePtr.h"
+
+class WorldSnapshot;
+
+/**
+ * @class World
+ * @brief Almacenamiento de componentes de datos por arquetipos (estructura de arreglos).
+ *
+ * Las entidades con el mismo conjunto de componentes comparten un `Archetype`, donde cada
+ * tipo es una columna contigua. Recorrer con `each<Position, Velocity>` toca solo esas
+ * columnas, fila por fila, sin saltar entre objetos del heap.
+ *
+ * Los componentes de datos son structs simples (sin herencia de `Component`) que se mueven
+ * sin excepciones. Los punteros que devuelven `addComponent`/`getComponent` se invalidan al
+ * agregar o quitar componentes de cualquier entidad del mismo arquetipo; los ids no.
+ *
+ * Cada columna lleva, por bloque de filas, el tick en que se escribi por ltima vez
+ * (`ChangeTick.h`): al agregar un componente, con `getComponent` y al recorrerla sin `const` en
+ * una vista. Mudar una entidad de arquetipo tambin cuenta como cambio. Los sistemas reactivos
+ * lo comparan con `WorldView::eachChanged`.
+ *
+ * Los tipos que declaran `kStorage = ComponentStorage::SparseSet` viven en cambio en un
+ * `ComponentPool<T>` propio: las mismas llamadas (`addComponent`, `getComponent`...) los
+ * enrutan ah sin mudar la entidad de arquetipo, y se recorren con `pool<T>().each(...)`.
+ *
+ * `Entity` lo usa como fachada: `Entity::addComponent<Position>(...)` guarda aqu el dato, y
+ * cada componente polimrfico con `StaticType` deja una `ComponentRef`, as que `view` tambin
+ * encuentra actores por sus componentes.
+ *
+ * Un solo hilo; los sistemas paralelos deben repartirse arquetipos, no compartir uno.
+ */
+class
+World {
+public:
+	World();
+
+	~World();
+
+	World(const World&) = delete;
+	World& operator=(const World&) = delete;
+
+	/**
+	 * @brief Crea una entidad sin componentes.
+	 */
+	EntityId
+	createEntity();
+
+	/**
+	 * @brief Destruye la entidad y sus componentes.
+	 * @return `false` si el id ya no era vlido.
+	 */
+	bool
+	destroyEntity(EntityId entity);
+
+	bool
+	isAlive(EntityId entity) const { return m_entities.contains(entity); }
+
+	/**
+	 * @brief Agrega (o reemplaza) el componente `T` de la entidad.
+	 * @return Referencia al componente dentro de su columna.
+	 */
+	template<typename T, typename... Args>
+	T&
+	addComponent(EntityId entity, Args&&... args) {
+		EntityLocation* location = m_entities.get(entity);
+		assert(location && "Entidad destruida");
+		ComponentTypeId typeId = ComponentRegistry::idOf<T>();
+		if constexpr (kIsSparseComponent<T>) {
+			touchStructure();
+			location->pooled |= ComponentSignature(1) << typeId;
+			return pool<T>().emplace(entity, std::forward<Args>(args)...);
+		}
+		if (ComponentColumn* column = location->archetype->column(typeId)) {
+			column->markChanged(location->row);
+			T& existing = column->data<T>()[location->row];
+			existing = T(std::forward<Args>(args)...);
+			return existing;
+		}
+		// Construir antes de mover la fila: si el constructor lanza, la entidad queda igual
+		T value(std::forward<Args>(args)...);
+		Archetype& target = withComponent(*location->archetype, typeId);
+		void* slot = moveEntity(entity, *location, target, typeId);
+		return *::new (slot) T(std::move(value));
+	}
+
+	/**
+	 * @brief Quita el componente `T` de la entidad.
+	 * @return `false` si no lo tena.
+	 */
+	template<typename T>
+	bool
+	removeComponent(EntityId entity) {
+		EntityLocation* location = m_entities.get(entity);
+		ComponentTypeId typeId = ComponentRegistry::idOf<T>();
+		if constexpr (kIsSparseComponent<T>) {
+			if (!location) {
+				return false;
+			}
+			touchStructure();
+			location->pooled &= ~(ComponentSignature(1) << typeId);
+			return pool<T>().remove(entity);
+		}
+		if (!location || !location->archetype->has(typeId)) {
+			return false;
+		}
+		moveEntity(entity, *location, withoutComponent(*location->archetype, typeId), typeId);
+		return true;
+	}
+
+	/**
+	 * @brief Componente `T` de la entidad, o nulo.
+	 *
+	 * Es un acceso para modificar: sube el tick de cambio de su bloque de filas (salvo en los
+	 * `SparseSet`, que no llevan ticks).
+	 */
+	template<typename T>
+	T*
+	getComponent(EntityId entity) {
+		if constexpr (kIsSparseComponent<T>) {
+			return pool<T>().get(entity);
+		}
+		EntityLocation* location = m_entities.get(entity);
+		if (!location) {
+			return nullptr;
+		}
+		ComponentColumn* column = location->archetype->column(ComponentRegistry::idOf<T>());
+		if (!column) {
+			return nullptr;
+		}
+		column->markChanged(location->row);
+		return column->data<T>() + location->row;
+	}
+
+	template<typename T>
+	bool
+	hasComponent(EntityId entity) const {
+		const EntityLocation* location = m_entities.get(entity);
+		if constexpr (kIsSparseComponent<T>) {
+			return location && ((location->pooled >> ComponentRegistry::idOf<T>()) & 1);
+		}
+		return location && location->archetype->has(ComponentRegistry::idOf<T>());
+	}
+
+	/**
+	 * @brief Tipos de arquetipo de la entidad (sin los `SparseSet`), o 0 si no existe.
+	 */
+	ComponentSignature
+	signatureOf(EntityId entity) const {
+		const EntityLocation* location = m_entities.get(entity);
+		return location ? location->archetype->signature() : 0;
+	}
+
+	/**
+	 * @brief Agrega y quita varios tipos de datos de una vez, con una sola mudanza de arquetipo.
+	 *
+	 * Lo usa `EntityCommandBuffer` al reproducir los cambios del frame. Los tipos de `removed`
+	 * que la entidad no tena se ignoran; los de `added` que ya tena se destruyen. Solo tipos
+	 * de arquetipo, no `SparseSet`.
+	 * @param slots Sale con `slots[typeId]` apuntando a memoria sin construir por cada tipo de
+	 *        `added`; quien llama debe construir ah cada componente antes de tocar el mundo.
+	 */
+	void
+	changeComponents(EntityId entity, ComponentSignature added, ComponentSignature removed,
+		void* slots[kMaxComponentTypes]);
+
+	/**
+	 * @brief Vista de las entidades que tienen todos los `Ts`.
+	 *
+	 * La lista de arquetipos que coinciden se calcula la primera vez que se pide esta
+	 * combinacin de tipos y luego se mantiene al crear arquetipos; pedir la vista cada frame
+	 * no vuelve a filtrar. `Ts` pueden ser datos o componentes con `StaticType`, con `const`
+	 * si solo se leen; no tipos `SparseSet`, que se recorren con `pool<T>().each`.
+	 */
+	template<typename... Ts>
+	WorldView<Ts...>
+	view() {
+		static_assert(sizeof...(Ts) > 0, "view necesita al menos un tipo de componente");
+		static_assert(!(kIsSparseComponent<Ts> || ...), "Los tipos SparseSet se recorren con pool<T>().each");
+		return WorldView<Ts...>(queryFor((ComponentRegistry::bitOf<StoredComponent<Ts>>() | ...)));
+	}
+
+	/**
+	 * @brief Llama a `fn(EntityId, Ts&...)` por cada entidad que tenga todos los `Ts`.
+	 *
+	 * Igual que `view<Ts...>().each(fn)`. `fn` no debe agregar ni quitar componentes ni
+	 * destruir entidades; para eso, anotarlas y hacerlo despus.
+	 */
+	template<typename... Ts, typename Fn>
+	void
+	each(Fn&& fn) {
+		view<Ts...>().each(fn);
+	}
+
+	/**
+	 * @brief Conjunto disperso de `T`, crendolo la primera vez.
+	 */
+	template<typename T>
+	ComponentPool<T>&
+	pool() {
+		static_assert(kIsSparseComponent<T>, "T no declara ComponentStorage::SparseSet");
+		EngineUtilities::TUniquePtr<IComponentPool>& slot = m_pools[ComponentRegistry::idOf<T>()];
+		if (!slot) {
+			slot = EngineUtilities::MakeUnique<ComponentPool<T>>();
+		}
+		return static_cast<ComponentPool<T>&>(*slot);
+	}
+
+	/**
+	 * @brief Guarda en `snapshot` todo el estado del mundo (ver `WorldSnapshot`).
+	 *
+	 * Avanza el reloj de cambios: lo que se escriba despus cuenta como posterior a la foto.
+	 * Va en un punto de sincronizacin, sin sistemas corriendo.
+	 * @return `false` si algn tipo guardado no se puede copiar; la foto queda vaca.
+	 */
+	bool
+	saveSnapshot(WorldSnapshot& snapshot);
+
+	/**
+	 * @brief Deja el mundo como en `snapshot`. Lo restaurado cuenta como cambiado ahora, para
+	 *        que los sistemas reactivos lo vuelvan a leer; los ids de entidades que no existan
+	 *        en la foto dejan de valer.
+	 * @return `false` si la foto est vaca o es de otro mundo.
+	 */
+	bool
+	restoreSnapshot(const WorldSnapshot& snapshot);
+
+	/**
+	 * @brief Nmero de entidades vivas.
+	 */
+	size_t
+	entityCount() const { return m_entities.size(); }
+
+	/**
+	 * @brief Nmero de arquetipos creados (incluido el vaco).
+	 */
+	size_t
+	archetypeCount() const { return m_archetypes.size(); }
+
+private:
+	friend class WorldSnapshot;
+
+	/**
+	 * @brief Dnde vive una entidad: su arquetipo y su fila.
+	 */
+	struct EntityLocation {
+		Archetype* archetype;
+		uint32_t row;
+		ComponentSignature pooled; ///< Tipos que la entidad tiene en conjuntos dispersos.
+	};
+
+	/**
+	 * @brief Cach de la consulta `required`, crendola si no existe.
+	 *
+	 * Puede llamarse desde varios sistemas a la vez (toma un candado de lectura).
+	 */
+	const QueryCache&
+	queryFor(ComponentSignature required);
+
+	/**
+	 * @brief Arquetipo con exactamente `signature`, crendolo si no existe.
+	 */
+	Archetype&
+	archetypeFor(ComponentSignature signature);
+
+	/**
+	 * @brief Vecino de `from` con `typeId` agregado; se guarda en la arista para la prxima vez.
+	 */
+	Archetype&
+	withComponent(Archetype& from, ComponentTypeId typeId);
+
+	/**
+	 * @brief Vecino de `from` sin `typeId`.
+	 */
+	Archetype&
+	withoutComponent(Archetype& from, ComponentTypeId typeId);
+
+	/**
+	 * @brief Muda la entidad a `target` moviendo los componentes comunes.
+	 * @param skipped Tipo que no viene de la fila vieja (el que se agrega) o que se descarta.
+	 * @return Memoria sin construir para `skipped` si `target` lo tiene; si no, nulo.
+	 */
+	void*
+	moveEntity(EntityId entity, EntityLocation& location, Archetype& target, ComponentTypeId skipped);
+
+	/**
+	 * @brief Como el anterior, pero sin mover ninguno de los tipos de `skipped`.
+	 * @param slots Sale con la memoria sin construir de cada tipo de `skipped` que `target` tiene.
+	 */
+	void
+	moveEntity(EntityId entity, EntityLocation& location, Archetype& target, ComponentSignature skipped,
+		void* slots[kMaxComponentTypes]);
+
+	/**
+	 * @brief Deja en `target` las filas de `source`, de la misma firma.
+	 *
+	 * Con `changed` no nulo (`source` o `target`) y las mismas entidades en el mismo orden, solo
+	 * copia los bloques que segn sus ticks cambiaron despus de `since`.
+	 * @param sameLayout Ya se sabe que tienen las mismas entidades en el mismo orden.
+	 * @return Bytes de componentes copiados.
+	 */
+	static size_t
+	copyRows(Archetype& target, const Archetype& source, const Archetype* changed, uint32_t since, bool sameLayout);
+
+	/**
+	 * @brief Anota un cambio de estructura: entidades, arquetipos de cada una o conjuntos dispersos.
+	 */
+	void
+	touchStructure() { m_structure = ++m_structureCounter; }
+
+	EngineUtilities::TSlotMap<EntityLocation> m_entities;                ///< Ubicacin de cada entidad.
+	std::vector<EngineUtilities::TUniquePtr<Archetype>> m_archetypes;    ///< Todos los arquetipos.
+	std::unordered_map<ComponentSignature, Archetype*> m_bySignature;    ///< Bsqueda por conjunto de tipos.
+	EngineUtilities::TUniquePtr<IComponentPool> m_pools[kMaxComponentTypes]; ///< Conjuntos dispersos por tipo.
+	Archetype* m_emptyArchetype = nullptr;                               ///< Entidades sin componentes.
+	uint64_t m_structure = 0;                                            ///< Estructura actual; dos iguales son la misma (lo usan las fotos).
+	uint64_t m_structureCounter = 0;                                     ///< Nunca baja: restaurar una foto no repite nmeros.
+	std::unordered_map<ComponentSignature, EngineUtilities::TUniquePtr<QueryCache>> m_queries; ///< Consultas hechas, por tipos.
+	std::shared_mutex m_queriesMutex;                                    ///< Protege `m_queries` entre sistemas paralelos.
+};
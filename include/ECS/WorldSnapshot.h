@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ECS/World.h"
+
+/**
+ * @class WorldSnapshot
+ * @brief Foto de todo el `World`: tabla de entidades, columnas de cada arquetipo y conjuntos
+ *        dispersos, copiados como bloques de memoria.
+ *
+ * `World::saveSnapshot` la llena y `World::restoreSnapshot` deja el mundo como estaba. Los
+ * tipos trivialmente copiables se copian de un `memcpy` por columna; los dems, con su
+ * constructor de copia. No hay recorrido entidad por entidad ni llamadas virtuales por fila.
+ *
+ * Cada foto conserva su memoria y recuerda el tick en que se tom. Un arquetipo que sigue con
+ * las mismas entidades en el mismo orden se copia por diferencias: al guardar de nuevo en la
+ * misma foto solo pasan los bloques de filas que cambiaron desde la vez anterior (los ticks de
+ * `ChangeTick.h`), y al restaurar solo los que cambiaron desde que se guard. Para rollback
+ * conviene un anillo de fotos, una por paso, que se van reusando: cada una copia solo lo que
+ * cambi desde su ltima vuelta. El resto se copia entero. Si desde entonces no se cre,
+ * destruy ni mud ninguna entidad, tampoco se copia la tabla de entidades.
+ *
+ * Los componentes polimrficos de los actores no viven en el `World`: la foto guarda sus
+ * `ComponentRef` (qu entidad tiene qu componente), no su estado.
+ */
+class
+WorldSnapshot {
+public:
+	WorldSnapshot() = default;
+
+	WorldSnapshot(const WorldSnapshot&) = delete;
+	WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+
+	WorldSnapshot(WorldSnapshot&&) = default;
+	WorldSnapshot& operator=(WorldSnapshot&&) = default;
+
+	bool
+	isEmpty() const { return m_world == nullptr; }
+
+	/**
+	 * @brief La prxima vez que se guarde se copia todo, sin diferencias.
+	 */
+	void
+	invalidate() { m_world = nullptr; }
+
+	/**
+	 * @brief Tick de `ChangeTick.h` en que se tom; lo escrito despus es ms nuevo.
+	 */
+	uint32_t
+	tick() const { return m_tick; }
+
+	size_t
+	entityCount() const { return m_entityCount; }
+
+	/**
+	 * @brief Bytes de componentes copiados por el ltimo `saveSnapshot` o `restoreSnapshot`.
+	 */
+	size_t
+	lastCopiedBytes() const { return m_lastCopied; }
+
+private:
+	friend class World;
+	friend class SaveJournal;
+
+	const World* m_world = nullptr;   ///< Mundo del que se tom; nulo si nunca o si se invalid.
+	uint32_t m_tick = 0;
+	uint64_t m_structure = 0;         ///< `World::m_structure` al tomarla.
+	size_t m_entityCount = 0;
+	size_t m_archetypeCount = 0;      ///< Arquetipos que existan al tomarla; los dems estaban vacos.
+	mutable size_t m_lastCopied = 0;
+	EngineUtilities::TSlotMap<World::EntityLocation> m_entities; ///< Ubicacin de cada entidad, tal cual.
+	std::vector<EngineUtilities::TUniquePtr<Archetype>> m_archetypes; ///< Mismo orden que en el `World`.
+	EngineUtilities::TUniquePtr<IComponentPool> m_pools[kMaxComponentTypes];
+};
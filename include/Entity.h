@@ -1,17 +1,54 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Component.h"
+#include "ActiveEntities.h"
+#include "EntityRegistry.h"
+#include "ECS/World.h"
 
-class Window;
+class RenderCommandBuffer;
 
+/**
+ * @class Entity
+ * @brief Clase base de todo objeto de la escena que agrupa componentes.
+ *
+ * Cada componente se guarda como un `TIntrusivePtr`, un solo puntero por componente:
+ * el contador vive dentro del propio componente.
+ *
+ * Los componentes de datos (structs que no derivan de `Component`, como posiciones o
+ * velocidades) no se guardan aqu: `addComponent<T>(args...)` los manda al `World` del
+ * motor, donde viven en columnas contiguas por arquetipo. La entidad obtiene su `EntityId`
+ * la primera vez que agrega uno.
+ *
+ * Al construirse recibe adems un `EntityHandle` del `EntityRegistry`, su identidad estable
+ * para que otros la referencien sin contar referencias.
+ */
 class 
-Entity {
+Entity : public EngineUtilities::TRefCounted<> {
 public:
+	Entity() : m_handle(EngineUtilities::TService<EntityRegistry>::instance().acquire(*this)) {}
+
+	Entity(const Entity&) = delete;
+	Entity& operator=(const Entity&) = delete;
+
 	/**
-   * @brief Destructor virtual.
+   * @brief Destructor virtual. Destruye tambin los componentes de datos en el `World`.
    */
 	virtual
-	~Entity() = default;
+	~Entity() {
+		if (isActive()) {
+			if (ActiveEntities* active = EngineUtilities::TService<ActiveEntities>::get()) {
+				active->remove(*this);
+			}
+		}
+		if (m_entityId) {
+			if (World* world = EngineUtilities::TService<World>::get()) {
+				world->destroyEntity(m_entityId);
+			}
+		}
+		if (EntityRegistry* registry = EngineUtilities::TService<EntityRegistry>::get()) {
+			registry->release(m_handle);
+		}
+	}
 
 	/**
    * @brief Mtodo virtual puro para actualizar la entidad.
@@ -21,46 +58,223 @@ public:
   update(float deltaTime) = 0;
 
 	/**
-   * @brief Mtodo virtual puro para renderizar la entidad.
-   * @param Window Contexto del dispositivo para operaciones grficas.
+   * @brief Mtodo virtual puro para agregar los dibujos de la entidad al buffer del frame.
+   * @param commands Buffer de comandos del frame.
    */
   virtual void 
-  render(Window& window) = 0;
+  render(RenderCommandBuffer& commands) = 0;
+
+  /**
+   * @brief Activa o desactiva la entidad; solo las activas estn en `ActiveEntities`, que es
+   *        lo que recorren update y render.
+   */
+  void
+  setActive(bool active) {
+    if (active == isActive()) {
+      return;
+    }
+    ActiveEntities& list = EngineUtilities::TService<ActiveEntities>::instance();
+    if (active) {
+      list.add(*this);
+    }
+    else {
+      list.remove(*this);
+    }
+  }
+
+  bool
+  isActive() const { return m_activeIndex != ActiveEntities::kNotActive; }
 
   /**
    * @brief Agrega un componente a la entidad.
    * @tparam T Tipo del componente, debe derivar de Component.
-   * @param component Puntero compartido al componente que se va a agregar.
+   * @param component Puntero intrusivo al componente que se va a agregar.
+   *
+   * Si `T` declara `StaticType` y es el primero de su tipo, tambin deja una `ComponentRef<T>`
+   * en el `World` para que la entidad aparezca en `world().view<T>()`.
    */
   template <typename T>
-  void addComponent(EngineUtilities::TSharedPointer<T> component) {
+  void addComponent(EngineUtilities::TIntrusivePtr<T> component) {
     static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
-    components.push_back(component.template dynamic_pointer_cast<Component>());
+    ComponentType type = component->getType();
+    if (type != ComponentType::NONE && !m_componentsByType[type]) {
+      m_componentsByType[type] = component.get();
+      m_componentMask |= componentBit(type);
+      if constexpr (HasStaticComponentType<T>::value) {
+        world().template addComponent<ComponentRef<T>>(getEntityId(), ComponentRef<T>{ component.get() });
+      }
+    }
+    components.push_back(EngineUtilities::TIntrusivePtr<Component>(std::move(component)));
   }
 
+  /**
+   * @brief Agrega (o reemplaza) un componente de datos, guardado en el `World`.
+   * @tparam T Struct de datos; no debe derivar de `Component`.
+   * @param args Argumentos para construir `T`.
+   * @return Referencia al componente dentro de su columna (vlida hasta el prximo cambio).
+   */
+  template<typename T, typename... Args,
+           typename = std::enable_if_t<!std::is_base_of<Component, T>::value>>
+  T& addComponent(Args&&... args) {
+    return world().template addComponent<T>(getEntityId(), std::forward<Args>(args)...);
+  }
 
+  /**
+   * @brief Quita un componente de datos.
+   * @return `false` si la entidad no lo tena.
+   */
+  template<typename T>
+  bool removeComponent() {
+    static_assert(!std::is_base_of<Component, T>::value, "Only data components can be removed");
+    return m_entityId && world().template removeComponent<T>(m_entityId);
+  }
 
   /**
    * @brief Obtiene un componente de la entidad.
+   *
+   * - Componente de datos: puntero a su fila en el `World`, o nullptr.
+   * - `T` con `StaticType`: una sola lectura del ndice por tipo y un `static_cast`, sin RTTI.
+   * - Otro `Component`: recorre los componentes con `dynamic_pointer_cast`. Los tipos del juego
+   *   lo evitan declarando `StaticType` con `registerComponentType<T>()`.
+   *
    * @tparam T Tipo del componente que se va a obtener.
-   * @return Puntero compartido al componente, o nullptr si no se encuentra.
+   * @return `T*` para datos; `TIntrusivePtr<T>` (nulo si no est) para componentes polimrficos.
    */
   template<typename T>
-  EngineUtilities::TSharedPointer<T>
+  auto
   getComponent() {
-    for (auto& component : components) {
-      EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-      if (specificComponent) {
-        return specificComponent;
+    if constexpr (!std::is_base_of<Component, T>::value) {
+      return m_entityId ? world().template getComponent<T>(m_entityId) : static_cast<T*>(nullptr);
+    }
+    else if constexpr (HasStaticComponentType<T>::value) {
+      return EngineUtilities::TIntrusivePtr<T>(findComponent<T>());
+    }
+    else {
+      for (auto& component : components) {
+        EngineUtilities::TIntrusivePtr<T> specificComponent = component.template dynamic_pointer_cast<T>();
+        if (specificComponent) {
+          return specificComponent;
+        }
       }
+      return EngineUtilities::TIntrusivePtr<T>();
     }
-    return EngineUtilities::TSharedPointer<T>();
   }
 
+  /**
+   * @brief Indica si la entidad tiene el componente de datos `T`.
+   */
+  template<typename T>
+  bool
+  hasComponent() const {
+    return m_entityId && world().template hasComponent<T>(m_entityId);
+  }
+
+  /**
+   * @brief Id de la entidad en el `World`; se crea la primera vez que se pide.
+   */
+  EntityId
+  getEntityId() {
+    if (!m_entityId) {
+      m_entityId = world().createEntity();
+    }
+    return m_entityId;
+  }
+
+  /**
+   * @brief Identidad estable de la entidad; se resuelve con `EntityRegistry::find`.
+   */
+  EntityHandle
+  getHandle() const { return m_handle; }
+
+  /**
+   * @brief Etiquetas de la entidad, guardadas en el `EntityRegistry` junto a su handle.
+   */
+  EntityMask
+  getTags() const { return registry().tags(m_handle); }
+
+  void
+  setTags(EntityMask tags) { registry().setTags(m_handle, tags); }
+
+  void
+  addTags(EntityMask tags) { setTags(getTags() | tags); }
+
+  void
+  removeTags(EntityMask tags) { setTags(getTags() & ~tags); }
+
+  /**
+   * @brief Indica si la entidad tiene todas las etiquetas de `tags`.
+   */
+  bool
+  hasTags(EntityMask tags) const { return (getTags() & tags) == tags; }
+
+  /**
+   * @brief Capas de la entidad (render, colisin...); una nueva est en `kDefaultLayers`.
+   */
+  EntityMask
+  getLayers() const { return registry().layers(m_handle); }
+
+  void
+  setLayers(EntityMask layers) { registry().setLayers(m_handle, layers); }
+
+  /**
+   * @brief `World` del motor, servicio compartido por todas las entidades.
+   */
+  static World&
+  world() { return EngineUtilities::TService<World>::instance(); }
+
+  /**
+   * @brief `EntityRegistry` del motor: handles, etiquetas y capas de todas las entidades.
+   */
+  static EntityRegistry&
+  registry() { return EngineUtilities::TService<EntityRegistry>::instance(); }
+
+  /**
+   * @brief Obtiene un componente sin tocar su contador de referencias.
+   *
+   * Para los bucles por frame: el puntero sigue siendo vlido mientras viva la entidad.
+   *
+   * @tparam T Tipo del componente; debe declarar `StaticType`.
+   * @return Puntero al primer componente de ese tipo, o nullptr.
+   */
+  template<typename T>
+  T*
+  findComponent() const {
+    static_assert(HasStaticComponentType<T>::value, "T must declare StaticType");
+    return static_cast<T*>(m_componentsByType[T::StaticType]);
+  }
+
+  /**
+   * @brief Indica si la entidad tiene todos los tipos de `mask`.
+   * @param mask Combinacin de `componentBit(...)`.
+   */
+  bool
+  hasComponents(ComponentMask mask) const { return (m_componentMask & mask) == mask; }
+
+  /**
+   * @brief Tipos de componente presentes, un bit por `ComponentType`.
+   */
+  ComponentMask
+  getComponentMask() const { return m_componentMask; }
+
 protected:
-	bool isActive;
+	friend class ComponentUpdater;
+	friend class ActiveEntities;
+	friend class ActorPool;
+
+	static constexpr size_t kInlineComponents = 4; ///< Componentes que caben dentro de la entidad.
+
+	uint32_t m_activeIndex = ActiveEntities::kNotActive; ///< Posicin en `ActiveEntities`.
+
+	EntityHandle m_handle; ///< Identidad en el `EntityRegistry`; cambia si la entidad se recicla.
+
+	/**
+	 * @brief Componentes de la entidad; los primeros `kInlineComponents` no reservan memoria.
+	 */
+	EngineUtilities::TSmallVector<EngineUtilities::TIntrusivePtr<Component>, kInlineComponents> components;
+
+	Component* m_componentsByType[kComponentTypeCount] = {}; ///< Primer componente de cada tipo; los posee `components`.
+	ComponentMask m_componentMask = 0;                        ///< Bits de los tipos presentes.
 
-	int id;
+	EntityId m_entityId; ///< Fila en el `World`, nulo hasta el primer componente de datos.
 
-	std::vector<EngineUtilities::TSharedPointer<Component>> components;
 };
@@ -0,0 +1,270 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "Containers/TSlotMap.h"
+#include "NameTable.h"
+
+class Entity;
+
+/**
+ * @brief Identificador estable de una entidad de la escena: ndice y generacin, 8 bytes.
+ *
+ * Es lo que guardan el gameplay, la red y las herramientas para referirse a un actor, en vez
+ * de un `TSharedPointer`. No mantiene viva a la entidad: si se destruye (o vuelve a su
+ * `ActorPool`), la generacin cambia y `EntityRegistry::find` devuelve nulo.
+ *
+ * No confundir con `EntityId`, la fila de la entidad en el `World`.
+ */
+using EntityHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Mscara de etiquetas o de capas de una entidad: un bit por etiqueta (enemigo,
+ *        decorado...) o por capa (render, colisin). El significado de cada bit lo pone el juego.
+ */
+using EntityMask = uint64_t;
+
+constexpr EntityMask kDefaultLayers = 1;      ///< Capa de una entidad nueva: la 0.
+constexpr EntityMask kAllLayers = ~EntityMask(0);
+
+/**
+ * @brief Bit de la capa `layer` (0 a 63).
+ */
+constexpr EntityMask
+layerBit(unsigned layer) { return EntityMask(1) << layer; }
+
+/**
+ * @brief Condicin de `EntityRegistry::forEachMatching`: "todos los enemigos de la capa 3" es
+ *        `{ kTagEnemy, 0, layerBit(3) }`.
+ */
+struct EntityFilter {
+	EntityMask allTags = 0;             ///< Etiquetas que deben estar todas.
+	EntityMask noTags = 0;              ///< Etiquetas que no deben estar.
+	EntityMask anyLayers = kAllLayers;  ///< Capas de las que basta una.
+};
+
+/**
+ * @class EntityRegistry
+ * @brief Reparte los `EntityHandle` y los traduce a su entidad en O(1).
+ *
+ * Una tabla densa por ndice: buscar es una comprobacin de rango, una comparacin de
+ * generacin y una lectura. Los ndices liberados se reutilizan con la generacin siguiente,
+ * as que un handle viejo nunca encuentra a la entidad que ocupa hoy su ndice.
+ *
+ * Cada ndice lleva tambin las etiquetas y capas de su entidad, en dos arreglos aparte
+ * (`uint64_t` contiguos, sin datos de componentes en medio). Filtrar toda la escena con
+ * `forEachMatching` compara 16 bytes por entidad en un bucle sin saltos que el compilador
+ * vectoriza, en vez de comparar nombres o visitar cada actor.
+ *
+ * Adems lleva un ndice de nombre (`NameId`) y de cada bit de etiqueta a sus handles, al da
+ * en cada `acquire`, `release`, `setName` y `setTags`: `findByName` y `withTag` no recorren
+ * nada. Dentro de cada lista el orden no est garantizado: quitar uno mueve al ltimo a su
+ * lugar.
+ *
+ * `Entity` pide su handle al construirse y lo libera al destruirse. Repartir, liberar y cambiar
+ * mscaras es un cambio estructural (un solo hilo); `find` y `forEachMatching` pueden llamarse
+ * desde varios hilos mientras tanto nadie cambie nada.
+ *
+ * Es un servicio (`TService<EntityRegistry>`).
+ */
+class
+EntityRegistry {
+public:
+	/**
+	 * @brief Da a `entity` un handle nuevo.
+	 */
+	EntityHandle
+	acquire(Entity& entity);
+
+	/**
+	 * @brief Invalida `handle`; su ndice queda libre para otra entidad.
+	 * @return `false` si ya no era vlido.
+	 */
+	bool
+	release(EntityHandle handle);
+
+	/**
+	 * @brief Entidad de `handle`, o nulo si ya no existe.
+	 */
+	Entity*
+	find(EntityHandle handle) const {
+		if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation) {
+			return nullptr;
+		}
+		return m_slots[handle.index].entity;
+	}
+
+	/**
+	 * @brief Igual, convertido a `T`. Quien llama debe saber que la entidad es un `T`
+	 *        (p. ej. los handles de actores de la escena); no se comprueba.
+	 */
+	template<typename T>
+	T*
+	find(EntityHandle handle) const {
+		static_assert(std::is_base_of<Entity, T>::value, "T debe derivar de Entity");
+		return static_cast<T*>(find(handle));
+	}
+
+	bool
+	contains(EntityHandle handle) const { return find(handle) != nullptr; }
+
+	/**
+	 * @brief Etiquetas de `handle`; 0 si ya no existe.
+	 */
+	EntityMask
+	tags(EntityHandle handle) const { return contains(handle) ? m_tags[handle.index] : 0; }
+
+	/**
+	 * @brief Capas de `handle`; 0 si ya no existe.
+	 */
+	EntityMask
+	layers(EntityHandle handle) const { return contains(handle) ? m_layers[handle.index] : 0; }
+
+	/**
+	 * @return `false` si el handle ya no existe.
+	 */
+	bool
+	setTags(EntityHandle handle, EntityMask tags);
+
+	/**
+	 * @return `false` si el handle ya no existe.
+	 */
+	bool
+	setLayers(EntityHandle handle, EntityMask layers);
+
+	/**
+	 * @brief Nombre de `handle` para el ndice; lo pone `Actor`. `kNoName` lo saca del ndice.
+	 * @return `false` si el handle ya no existe.
+	 */
+	bool
+	setName(EntityHandle handle, NameId name);
+
+	/**
+	 * @brief Nombre de `handle`; `kNoName` si no tiene o ya no existe.
+	 */
+	NameId
+	name(EntityHandle handle) const { return contains(handle) ? m_names[handle.index] : kNoName; }
+
+	/**
+	 * @brief Una entidad llamada `name`, o el handle nulo. Con varias, cualquiera de ellas.
+	 */
+	EntityHandle
+	findByName(NameId name) const {
+		std::span<const EntityHandle> named = allNamed(name);
+		return named.empty() ? EntityHandle{} : named.front();
+	}
+
+	/**
+	 * @brief Todas las entidades llamadas `name`. Vale hasta el prximo cambio del registro.
+	 */
+	std::span<const EntityHandle>
+	allNamed(NameId name) const {
+		auto it = m_byName.find(name);
+		return it != m_byName.end() ? std::span<const EntityHandle>(it->second) : std::span<const EntityHandle>();
+	}
+
+	/**
+	 * @brief Todas las entidades con la etiqueta `tag`, que debe ser un solo bit. Vale hasta el
+	 *        prximo cambio del registro.
+	 */
+	std::span<const EntityHandle>
+	withTag(EntityMask tag) const { return m_byTag[std::countr_zero(tag) & 63]; }
+
+	/**
+	 * @brief Llama a `fn(Entity&)` por cada entidad que cumple `filter`, en orden de ndice.
+	 *
+	 * Compara las mscaras de 64 entidades a la vez y solo despus visita las que coinciden.
+	 * Los ndices libres tienen capas 0, as que nunca coinciden. `fn` no debe crear ni
+	 * destruir entidades ni cambiar mscaras.
+	 */
+	template<typename Fn>
+	void
+	forEachMatching(const EntityFilter& filter, Fn&& fn) const {
+		const EntityMask* tags = m_tags.data();
+		const EntityMask* layers = m_layers.data();
+		size_t count = m_slots.size();
+		for (size_t base = 0; base < count; base += 64) {
+			size_t block = std::min<size_t>(64, count - base);
+			uint8_t hit[64];
+			for (size_t i = 0; i < block; ++i) {
+				EntityMask entityTags = tags[base + i];
+				hit[i] = ((entityTags & filter.allTags) == filter.allTags) & ((entityTags & filter.noTags) == 0) &
+				         ((layers[base + i] & filter.anyLayers) != 0);
+			}
+			for (size_t i = 0; i < block; ++i) {
+				if (hit[i]) {
+					fn(*m_slots[base + i].entity);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Entidades que cumplen `filter`.
+	 */
+	size_t
+	countMatching(const EntityFilter& filter) const {
+		size_t matches = 0;
+		forEachMatching(filter, [&matches](Entity&) { ++matches; });
+		return matches;
+	}
+
+	/**
+	 * @brief Entidades con handle.
+	 */
+	size_t
+	size() const { return m_count; }
+
+	void
+	reserve(size_t capacity) {
+		m_slots.reserve(capacity);
+		m_tags.reserve(capacity);
+		m_layers.reserve(capacity);
+		m_names.reserve(capacity);
+		m_namePositions.reserve(capacity);
+	}
+
+private:
+	static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+	/**
+	 * @brief Entrada de la tabla: la entidad si est ocupada, o el siguiente ndice libre.
+	 */
+	struct Slot {
+		Entity* entity = nullptr;
+		uint32_t generation = 1;    ///< Generacin vigente; nunca 0, que es el handle nulo.
+		uint32_t nextFree = kNoSlot;
+	};
+
+	/**
+	 * @brief Quita `handle` de `list`, donde est en `position`, moviendo al ltimo a su lugar.
+	 * @return El handle movido, o el nulo si era el ltimo.
+	 */
+	static EntityHandle
+	eraseAt(std::vector<EntityHandle>& list, uint32_t position);
+
+	/**
+	 * @brief Clave de la posicin de `index` en la lista de la etiqueta `bit`.
+	 */
+	static constexpr uint64_t
+	tagKey(uint32_t index, unsigned bit) { return (uint64_t(index) << 6) | bit; }
+
+	void
+	indexTags(EntityHandle handle, EntityMask added, EntityMask removed);
+
+	std::vector<Slot> m_slots;      ///< Una entrada por ndice repartido alguna vez.
+	std::vector<EntityMask> m_tags;   ///< Etiquetas por ndice; 0 en los libres.
+	std::vector<EntityMask> m_layers; ///< Capas por ndice; 0 en los libres.
+	std::vector<NameId> m_names;      ///< Nombre por ndice; `kNoName` en los libres.
+	std::vector<uint32_t> m_namePositions; ///< Posicin de cada ndice en su lista de `m_byName`.
+	std::unordered_map<NameId, std::vector<EntityHandle>> m_byName;
+	std::array<std::vector<EntityHandle>, 64> m_byTag;   ///< Por bit de etiqueta.
+	std::unordered_map<uint64_t, uint32_t> m_tagPositions; ///< Por `tagKey`: posicin en `m_byTag`.
+	uint32_t m_freeHead = kNoSlot;  ///< Primer ndice libre.
+	size_t m_count = 0;             ///< Entradas ocupadas.
+};
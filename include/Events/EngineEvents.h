@@ -0,0 +1,51 @@
+#pragma once
+#include "Prerequisites.h"
+#include "EntityRegistry.h"
+#include "Scene/PackFormat.h"
+
+/**
+ * @brief Un actor lleg a un punto de su recorrido. Lo publica `patrol` (Behavior/ActorBehaviors.h).
+ */
+struct WaypointReached {
+	EntityHandle actor;        ///< Actor que lleg.
+	int waypoint = 0;          ///< ndice del punto alcanzado.
+	sf::Vector2f position;     ///< Posicin del actor al llegar.
+};
+
+/**
+ * @brief Se presion una tecla. Lo publica `Window::handleEvents`.
+ */
+struct KeyPressed {
+	sf::Keyboard::Key key = sf::Keyboard::Unknown;
+};
+
+/**
+ * @brief Se presion un botn del mouse. Lo publica `Window::handleEvents`.
+ */
+struct MouseButtonPressed {
+	sf::Mouse::Button button = sf::Mouse::Left;
+	sf::Vector2i position;     ///< En pxeles de la ventana.
+};
+
+/**
+ * @brief Un recurso se recarg porque su archivo cambi en disco. Lo publica
+ *        `AssetManager::update`; para un archivo de `AssetManager::watch`, solo avisa.
+ */
+struct AssetReloaded {
+	AssetId id = 0;            ///< `assetId` de la ruta; de un shader, la de sus dos rutas unidas.
+};
+
+/**
+ * @brief Una regin termin de crear sus actores. Lo publica `WorldStreamer::update`.
+ */
+struct RegionActivated {
+	uint32_t region = 0;       ///< ndice en `SceneFile::regions()`.
+	uint32_t actors = 0;       ///< Actores creados.
+};
+
+/**
+ * @brief Una regin activada termin de destruir sus actores. Lo publica `WorldStreamer::update`.
+ */
+struct RegionUnloaded {
+	uint32_t region = 0;
+};
@@ -0,0 +1,203 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Containers/TMpscQueue.h"
+#include "Memory/TUniquePtr.h"
+
+/**
+ * @brief Mximo de tipos de evento distintos.
+ */
+constexpr size_t kMaxEventTypes = 64;
+
+/**
+ * @brief Lugares de la cola sin candados de un tipo de evento; 1024 salvo que el tipo declare
+ *        `static constexpr size_t kEventCapacity`. Lo que no cabe va al desborde con mutex.
+ */
+template<typename E, typename = void>
+struct EventCapacityOf : std::integral_constant<size_t, 1024> {};
+
+template<typename E>
+struct EventCapacityOf<E, std::void_t<decltype(E::kEventCapacity)>>
+	: std::integral_constant<size_t, E::kEventCapacity> {};
+
+/**
+ * @class EventBus
+ * @brief Bus de eventos tipados: se publican desde cualquier hilo y se despachan por lotes.
+ *
+ * Cada tipo de evento (un struct simple: `WaypointReached`, `KeyPressed`...) tiene su canal
+ * con una `TMpscQueue`. `publish` no toma candados mientras la cola tenga lugar; si se llena,
+ * el evento va a un vector de desborde con mutex, as que ninguno se pierde.
+ *
+ * `dispatch` se llama en puntos fijos del frame, en un solo hilo: vaca cada canal en un
+ * vector contiguo y llama a cada oyente una vez con todo el lote. Los eventos publicados por
+ * los oyentes durante `dispatch` se entregan en el siguiente.
+ *
+ * Es un servicio (`TService<EventBus>`).
+ */
+class
+EventBus {
+public:
+	using ListenerId = uint32_t;
+
+	EventBus() = default;
+
+	EventBus(const EventBus&) = delete;
+	EventBus& operator=(const EventBus&) = delete;
+
+	/**
+	 * @brief Publica `event`. Cualquier hilo.
+	 *
+	 * Los eventos de un mismo hilo llegan en el orden en que se publicaron: mientras haya
+	 * desborde, los siguientes tambin van al desborde, que se entrega despus de la cola.
+	 */
+	template<typename E>
+	void
+	publish(E event) {
+		Channel<E>& target = channel<E>();
+		if (!target.hasOverflow.load(std::memory_order_acquire) && target.queue.tryPush(std::move(event))) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(target.overflowMutex);
+		target.overflow.push_back(std::move(event));
+		target.hasOverflow.store(true, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Oyente que recibe los eventos de un `dispatch` juntos: `fn(std::span<const E>)`.
+	 *
+	 * Solo desde el hilo que llama a `dispatch`.
+	 */
+	template<typename E, typename Fn>
+	ListenerId
+	subscribeBatch(Fn&& fn) {
+		ListenerId id = ++m_nextListener;
+		channel<E>().listeners.push_back({ id, std::function<void(std::span<const E>)>(std::forward<Fn>(fn)) });
+		return id;
+	}
+
+	/**
+	 * @brief Oyente que recibe los eventos de uno en uno: `fn(const E&)`.
+	 */
+	template<typename E, typename Fn>
+	ListenerId
+	subscribe(Fn&& fn) {
+		return subscribeBatch<E>([listener = std::forward<Fn>(fn)](std::span<const E> events) mutable {
+			for (const E& event : events) {
+				listener(event);
+			}
+		});
+	}
+
+	/**
+	 * @brief Quita un oyente de `E`.
+	 * @return `false` si no exista.
+	 */
+	template<typename E>
+	bool
+	unsubscribe(ListenerId id) {
+		auto& listeners = channel<E>().listeners;
+		for (auto it = listeners.begin(); it != listeners.end(); ++it) {
+			if (it->first == id) {
+				listeners.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Entrega a sus oyentes todo lo publicado desde el `dispatch` anterior.
+	 *
+	 * Los canales se recorren en el orden en que se us cada tipo por primera vez.
+	 */
+	void
+	dispatch();
+
+private:
+	struct IChannel {
+		virtual
+		~IChannel() = default;
+
+		virtual void
+		dispatch() = 0;
+	};
+
+	template<typename E>
+	struct Channel final : IChannel {
+		EngineUtilities::TMpscQueue<E> queue{ EventCapacityOf<E>::value }; ///< Camino sin candados.
+		std::mutex overflowMutex;                                 ///< Protege `overflow`.
+		std::vector<E> overflow;                                  ///< Lo que no cupo en `queue`.
+		std::atomic<bool> hasOverflow{ false };                   ///< `overflow` tiene algo.
+		std::vector<E> batch;                                     ///< Lote del `dispatch` actual.
+		std::vector<std::pair<ListenerId, std::function<void(std::span<const E>)>>> listeners;
+
+		void
+		dispatch() override {
+			batch.clear();
+			E event;
+			while (queue.tryPop(event)) {
+				batch.push_back(std::move(event));
+			}
+			if (hasOverflow.load(std::memory_order_acquire)) {
+				std::lock_guard<std::mutex> lock(overflowMutex);
+				for (E& spilled : overflow) {
+					batch.push_back(std::move(spilled));
+				}
+				overflow.clear();
+				hasOverflow.store(false, std::memory_order_relaxed);
+			}
+			if (batch.empty()) {
+				return;
+			}
+			std::span<const E> events(batch);
+			for (size_t i = 0; i < listeners.size(); ++i) {
+				listeners[i].second(events);
+			}
+		}
+	};
+
+	/**
+	 * @brief Nmero de `E`, asignado la primera vez que se usa.
+	 */
+	template<typename E>
+	static size_t
+	typeIndex() {
+		static const size_t s_index = nextTypeIndex();
+		return s_index;
+	}
+
+	static size_t
+	nextTypeIndex();
+
+	/**
+	 * @brief Canal de `E`, crendolo si no existe; varios hilos pueden pedirlo a la vez.
+	 */
+	template<typename E>
+	Channel<E>&
+	channel() {
+		size_t index = typeIndex<E>();
+		if (IChannel* existing = m_channels[index].load(std::memory_order_acquire)) {
+			return static_cast<Channel<E>&>(*existing);
+		}
+		std::lock_guard<std::mutex> lock(m_createMutex);
+		if (IChannel* existing = m_channels[index].load(std::memory_order_relaxed)) {
+			return static_cast<Channel<E>&>(*existing);
+		}
+		m_owned[index] = EngineUtilities::MakeUnique<Channel<E>>();
+		m_order.push_back(index);
+		m_channels[index].store(m_owned[index].get(), std::memory_order_release);
+		return static_cast<Channel<E>&>(*m_owned[index]);
+	}
+
+	std::atomic<IChannel*> m_channels[kMaxEventTypes] = {};            ///< Lectura sin candado.
+	EngineUtilities::TUniquePtr<IChannel> m_owned[kMaxEventTypes];     ///< Dueos de los canales.
+	std::vector<size_t> m_order;                                       ///< Canales en orden de creacin.
+	std::mutex m_createMutex;                                          ///< Protege la creacin y `m_order`.
+	ListenerId m_nextListener = 0;                                     ///< ltimo id entregado.
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Containers/TSlotMap.h"
+
+using TimerHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @class TimerWheel
+ * @brief Temporizadores del motor (retrasos, repeticiones, tiempos lmite) sobre una rueda
+ *        jerrquica: agregar y cancelar cuestan O(1), y un paso sin nada que vencer no toca
+ *        ningn temporizador.
+ *
+ * Hay `kLevels` ruedas de `kSlots` casillas. Un temporizador que vence dentro de menos de 256
+ * pasos va a la casilla de su paso en la primera rueda; uno ms lejano va a la rueda cuya
+ * casilla abarca su paso (256, 65536... pasos por casilla). Cada vez que la primera rueda da
+ * la vuelta, la casilla siguiente de la de arriba se reparte hacia abajo: cada temporizador
+ * baja a lo ms `kLevels - 1` veces en toda su vida y vence justo en su paso. Ms all de
+ * 2^32 pasos espera en la ltima rueda y vuelve a ubicarse al bajar.
+ *
+ * Las funciones corren dentro de `advance`, en el hilo que la llama, en el orden en que se
+ * programaron los que vencen en el mismo paso; mientras corren, `now` es ese paso. Pueden
+ * programar y cancelar otros, y cancelarse a s mismas. Los pasos son los de la simulacin:
+ * `BaseApp::update` avanza uno por paso, y los segundos se convierten con `setTickSeconds`.
+ *
+ * Es un servicio (`TService<TimerWheel>`); va en el hilo principal.
+ */
+class
+TimerWheel {
+public:
+	using Callback = std::function<void()>;
+
+	static constexpr uint32_t kSlotBits = 8;
+	static constexpr uint32_t kSlots = 1u << kSlotBits;
+	static constexpr uint32_t kLevels = 4;
+
+	TimerWheel();
+
+	/**
+	 * @brief `callback` una vez, dentro de `ticks` pasos (0 cuenta como 1).
+	 */
+	TimerHandle
+	after(uint32_t ticks, Callback callback);
+
+	/**
+	 * @brief `callback` cada `ticks` pasos, empezando dentro de `ticks`, hasta `cancel`.
+	 */
+	TimerHandle
+	every(uint32_t ticks, Callback callback);
+
+	TimerHandle
+	afterSeconds(float seconds, Callback callback) { return after(ticksFor(seconds), std::move(callback)); }
+
+	TimerHandle
+	everySeconds(float seconds, Callback callback) { return every(ticksFor(seconds), std::move(callback)); }
+
+	/**
+	 * @return `false` si ya venci (sin repetirse) o se cancel antes.
+	 */
+	bool
+	cancel(TimerHandle timer);
+
+	/**
+	 * @brief `true` mientras el temporizador vaya a correr otra vez.
+	 */
+	bool
+	isPending(TimerHandle timer) const;
+
+	/**
+	 * @brief Avanza `ticks` pasos y corre lo que vence en cada uno.
+	 */
+	void
+	advance(uint32_t ticks = 1);
+
+	/**
+	 * @brief Segundos de un paso, para `afterSeconds` y `everySeconds`.
+	 */
+	void
+	setTickSeconds(float seconds) { m_tickSeconds = seconds; }
+
+	/**
+	 * @brief Pasos ms cercanos a `seconds`; al menos 1.
+	 */
+	uint32_t
+	ticksFor(float seconds) const;
+
+	uint64_t
+	now() const { return m_now; }
+
+	/**
+	 * @brief Temporizadores programados, incluido el que corre ahora.
+	 */
+	size_t
+	size() const { return m_count; }
+
+private:
+	enum class State : uint8_t { Free, Pending, Running };
+
+	/**
+	 * @brief Nodo de una lista circular doble por ndices. Los primeros `kLevels * kSlots + 1`
+	 *        son las cabezas de las casillas y de la lista que vence.
+	 */
+	struct Node {
+		uint32_t next;
+		uint32_t prev;
+		uint32_t generation = 1;
+		uint32_t period = 0;       ///< Pasos entre repeticiones; 0 corre una vez.
+		uint64_t deadline = 0;
+		State state = State::Free;
+		Callback callback;
+	};
+
+	static constexpr uint32_t kExpiring = kLevels * kSlots;   ///< Cabeza de lo que vence en este paso.
+	static constexpr uint32_t kFirstTimer = kExpiring + 1;
+
+	TimerHandle
+	schedule(uint32_t delay, uint32_t period, Callback callback);
+
+	/**
+	 * @brief Pone el nodo en la casilla que le toca segn `m_now`.
+	 */
+	void
+	place(uint32_t index);
+
+	/**
+	 * @brief Reparte la casilla `slot` del nivel `level` en los de abajo.
+	 * @return `slot`: si es 0, el nivel de arriba tambin dio la vuelta.
+	 */
+	uint32_t
+	cascade(uint32_t level, uint32_t slot);
+
+	void
+	link(uint32_t head, uint32_t index);
+
+	void
+	unlink(uint32_t index);
+
+	void
+	release(uint32_t index);
+
+	/**
+	 * @brief Nodo de `timer`, o nulo si el handle ya no vale.
+	 */
+	const Node*
+	nodeOf(TimerHandle timer) const;
+
+	std::vector<Node> m_nodes;
+	uint32_t m_free = 0;           ///< Primer nodo libre; 0 si no hay (el 0 es una cabeza).
+	uint64_t m_now = 0;
+	size_t m_count = 0;
+	float m_tickSeconds = 1.0f / 60.0f;
+};
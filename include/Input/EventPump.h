@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "Prerequisites.h"
+#include "Containers/TSpscQueue.h"
+
+/**
+ * @class EventPump
+ * @brief Hilo dueo de la ventana del sistema: la crea, saca sus mensajes y pasa los eventos
+ *        al hilo principal por una `TSpscQueue`.
+ *
+ * En Windows, arrastrar o cambiar el tamao de la ventana mete al hilo que la cre en un bucle
+ * modal del sistema hasta soltar el mouse; si ese hilo es el de la simulacin, el juego y la
+ * red se congelan. Con la bomba los mensajes son de otro hilo: el modal solo detiene a este, y
+ * el principal sigue simulando y dibujando con lo que ya tiene.
+ *
+ * Los mensajes de una ventana van al hilo que la cre, as que la ventana nace aqu (`start`) y
+ * se destruye aqu (`stop`). El contexto de OpenGL se suelta al crearla para que lo active el
+ * hilo principal, o el `RenderThread`. El hilo mira la cola del sistema cada `kPollSlice`; si
+ * la cola hacia el principal se llena, lo que no entra espera en un vector propio del hilo: no
+ * se pierde ningn evento ni se deja de atender al sistema.
+ *
+ * Al sacar un `Resized`, SFML vuelve a fijar la vista actual de la ventana desde este hilo;
+ * quien dibuja la recalcula con el evento, como sin la bomba.
+ */
+class
+EventPump {
+public:
+	static constexpr size_t kQueueCapacity = 1024;
+	static constexpr std::chrono::milliseconds kPollSlice{ 1 };
+
+	using CreateFunction = std::function<sf::RenderWindow*()>;
+
+	EventPump() = default;
+
+	EventPump(const EventPump&) = delete;
+	EventPump& operator=(const EventPump&) = delete;
+
+	~EventPump() { stop(); }
+
+	/**
+	 * @brief Arranca el hilo, que crea la ventana con `create` y empieza a sacar sus eventos.
+	 * @return La ventana, sin contexto activo en ningn hilo; nula si `create` fall.
+	 */
+	sf::RenderWindow*
+	start(CreateFunction create);
+
+	/**
+	 * @brief Destruye la ventana en su hilo y lo termina. Su contexto no debe estar activo en
+	 *        otro hilo.
+	 */
+	void
+	stop();
+
+	bool
+	isRunning() const { return m_thread.joinable(); }
+
+	/**
+	 * @brief Solo el hilo principal.
+	 * @return `false` si no hay eventos.
+	 */
+	bool
+	tryPop(sf::Event& event) { return m_events.tryPop(event); }
+
+private:
+	void
+	loop(CreateFunction create);
+
+	std::thread m_thread;
+	std::atomic<bool> m_stop{ false };
+	std::atomic<sf::RenderWindow*> m_window{ nullptr };
+	std::atomic<bool> m_created{ false };             ///< `m_window` ya tiene lo que devolvi `create`.
+	EngineUtilities::TSpscQueue<sf::Event> m_events{ kQueueCapacity };
+	std::vector<sf::Event> m_overflow;                ///< Solo el hilo de la bomba.
+};
@@ -0,0 +1,283 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Prerequisites.h"
+#include "Containers/TMpscQueue.h"
+
+enum class InputEventType : uint8_t {
+	KeyDown,
+	KeyUp,
+	MouseDown,
+	MouseUp,
+	MouseMove,
+	MouseWheel,
+	JoystickDown,
+	JoystickUp,
+	JoystickAxis,
+	Text,
+};
+
+/**
+ * @brief Un cambio de la entrada, con el momento en que se vio.
+ */
+struct InputEvent {
+	uint64_t timeUs = 0;       ///< Microsegundos desde que se cre el `InputSystem`.
+	InputEventType type = InputEventType::KeyDown;
+	uint8_t joystick = 0;
+	uint32_t code = 0;         ///< Tecla, botn, eje o carcter Unicode, segn `type`.
+	float x = 0.0f;            ///< Posicin del mouse, giro de la rueda o valor del eje.
+	float y = 0.0f;
+};
+
+/**
+ * @brief De dnde sale una accin: una tecla, un botn o un eje pasado de `threshold`.
+ */
+struct InputBinding {
+	enum class Source : uint8_t { Key, MouseButton, JoystickButton, JoystickAxis };
+
+	Source source = Source::Key;
+	uint8_t joystick = 0;
+	uint32_t code = 0;
+	float threshold = 50.0f;   ///< Ejes, de -100 a 100; negativo cuenta hacia el lado negativo.
+};
+
+/**
+ * @class InputSystem
+ * @brief Entrada del motor: los eventos de cada frame en un bfer con su momento, el estado de
+ *        teclado, mouse y joysticks guardado, y acciones con nombre.
+ *
+ * `Window::handleEvents` saca todos los eventos de SFML una vez por frame (`beginFrame`,
+ * `handle`, `endFrame`); el resto del motor lee de aqu y no le pregunta al sistema
+ * operativo. La posicin del mouse sale de sus eventos de movimiento. `wasKeyPressed` y
+ * compaa cubren el frame entero: un toque que empieza y termina entre dos frames no se
+ * pierde. Al perder el foco se sueltan todas las teclas y botones.
+ *
+ * Una accin (`addAction`) est abajo si alguna de sus teclas, botones o ejes lo est; se
+ * consulta por su id sin buscar nombres.
+ *
+ * SFML solo entrega los eventos de la ventana al hilo que la cre. Con `startSampling`, otro
+ * hilo lee el teclado, los botones y el mouse `rate` veces por segundo y encola los cambios
+ * con el momento en que los vio: a 1000 Hz la marca de tiempo est a un milisegundo del
+ * toque, no a un frame, y el estado ya est al da cuando empieza el frame. Mientras tanto,
+ * de SFML solo se toman la rueda, el texto, los joysticks y el foco.
+ *
+ * Es un servicio (`TService<InputSystem>`); todo menos el muestreo va en el hilo principal.
+ */
+class
+InputSystem {
+public:
+	using ActionId = uint32_t;
+
+	static constexpr ActionId kNoAction = ~0u;
+	static constexpr float kDefaultSampleRate = 1000.0f;
+	static constexpr size_t kSampleQueueCapacity = 4096;
+
+	InputSystem();
+	~InputSystem();
+
+	InputSystem(const InputSystem&) = delete;
+	InputSystem& operator=(const InputSystem&) = delete;
+
+	/**
+	 * @brief Ventana de la que se leen el mouse y el muestreo; toma la posicin del mouse una vez.
+	 */
+	void
+	attach(const sf::Window& window);
+
+	/**
+	 * @brief Termina el muestreo y suelta la ventana; antes de destruirla.
+	 */
+	void
+	detach();
+
+	/**
+	 * @brief Empieza un frame: vaca el bfer y olvida lo que se presion y solt en el anterior.
+	 */
+	void
+	beginFrame();
+
+	/**
+	 * @brief Anota un evento de SFML; los que no son de entrada se ignoran.
+	 */
+	void
+	handle(const sf::Event& event);
+
+	/**
+	 * @brief Junta lo que encol el muestreo y pone al da las acciones.
+	 */
+	void
+	endFrame();
+
+	/**
+	 * @brief Lee la entrada en otro hilo `rate` veces por segundo; necesita `attach`.
+	 */
+	void
+	startSampling(float rate = kDefaultSampleRate);
+
+	void
+	stopSampling();
+
+	bool
+	isSampling() const { return m_sampler.joinable(); }
+
+	/**
+	 * @brief Eventos de este frame, en el orden en que llegaron.
+	 */
+	const std::vector<InputEvent>&
+	events() const { return m_events; }
+
+	bool
+	isKeyDown(sf::Keyboard::Key key) const { return key >= 0 && key < sf::Keyboard::KeyCount && (m_keys[key] & kDown); }
+
+	bool
+	wasKeyPressed(sf::Keyboard::Key key) const { return key >= 0 && key < sf::Keyboard::KeyCount && (m_keys[key] & kPressed); }
+
+	bool
+	wasKeyReleased(sf::Keyboard::Key key) const { return key >= 0 && key < sf::Keyboard::KeyCount && (m_keys[key] & kReleased); }
+
+	bool
+	isMouseDown(sf::Mouse::Button button) const { return (m_mouseButtons[button] & kDown) != 0; }
+
+	bool
+	wasMousePressed(sf::Mouse::Button button) const { return (m_mouseButtons[button] & kPressed) != 0; }
+
+	bool
+	wasMouseReleased(sf::Mouse::Button button) const { return (m_mouseButtons[button] & kReleased) != 0; }
+
+	/**
+	 * @brief En pxeles de la ventana.
+	 */
+	sf::Vector2i
+	mousePosition() const { return m_mousePosition; }
+
+	/**
+	 * @brief Giro de la rueda vertical en este frame.
+	 */
+	float
+	wheelDelta() const { return m_wheelDelta; }
+
+	bool
+	isJoystickConnected(uint32_t joystick) const { return joystick < sf::Joystick::Count && m_joystickConnected[joystick]; }
+
+	bool
+	isJoystickDown(uint32_t joystick, uint32_t button) const;
+
+	/**
+	 * @brief De -100 a 100, como en SFML.
+	 */
+	float
+	joystickAxis(uint32_t joystick, sf::Joystick::Axis axis) const;
+
+	/**
+	 * @brief Accin nueva sin entradas, o la que ya tena ese nombre.
+	 */
+	ActionId
+	addAction(const std::string& name);
+
+	/**
+	 * @return `kNoAction` si no existe.
+	 */
+	ActionId
+	findAction(const std::string& name) const;
+
+	void
+	bind(ActionId action, const InputBinding& binding);
+
+	void
+	bindKey(ActionId action, sf::Keyboard::Key key) { bind(action, { InputBinding::Source::Key, 0, static_cast<uint32_t>(key) }); }
+
+	void
+	bindMouse(ActionId action, sf::Mouse::Button button) {
+		bind(action, { InputBinding::Source::MouseButton, 0, static_cast<uint32_t>(button) });
+	}
+
+	/**
+	 * @brief Quita todas las entradas de la accin, para volver a asignarlas.
+	 */
+	void
+	unbindAll(ActionId action) { m_actions[action].bindings.clear(); }
+
+	bool
+	isActionDown(ActionId action) const { return m_actions[action].down; }
+
+	/**
+	 * @brief Pas a estar abajo en este frame, o alguna de sus entradas se presion y solt en l.
+	 */
+	bool
+	wasActionPressed(ActionId action) const { return m_actions[action].pressed; }
+
+	bool
+	wasActionReleased(ActionId action) const { return m_actions[action].released; }
+
+	/**
+	 * @brief De 0 a 1: 1 con una tecla o botn abajo, y lo que pase del umbral en un eje.
+	 */
+	float
+	actionValue(ActionId action) const { return m_actions[action].value; }
+
+	/**
+	 * @brief Microsegundos desde que se cre, en la escala de `InputEvent::timeUs`.
+	 */
+	uint64_t
+	now() const;
+
+private:
+	enum StateFlags : uint8_t {
+		kDown = 1,
+		kPressed = 2,      ///< Baj en este frame.
+		kReleased = 4,     ///< Subi en este frame.
+	};
+
+	struct Action {
+		std::string name;
+		std::vector<InputBinding> bindings;
+		float value = 0.0f;
+		bool down = false;
+		bool pressed = false;
+		bool released = false;
+	};
+
+	/**
+	 * @brief Anota `event` en el bfer y en el estado.
+	 */
+	void
+	apply(const InputEvent& event);
+
+	static void
+	press(uint8_t& state, bool down);
+
+	/**
+	 * @brief Suelta todo lo que est abajo, como si se hubiera soltado ahora.
+	 */
+	void
+	releaseAll();
+
+	void
+	updateActions();
+
+	void
+	sampleLoop(float rate);
+
+	std::chrono::steady_clock::time_point m_epoch;
+	const sf::Window* m_window = nullptr;
+	std::vector<InputEvent> m_events;
+	uint8_t m_keys[sf::Keyboard::KeyCount] = {};           ///< `StateFlags` de cada tecla.
+	uint8_t m_mouseButtons[sf::Mouse::ButtonCount] = {};
+	uint8_t m_joystickButtons[sf::Joystick::Count][sf::Joystick::ButtonCount] = {};
+	float m_joystickAxes[sf::Joystick::Count][sf::Joystick::AxisCount] = {};
+	bool m_joystickConnected[sf::Joystick::Count] = {};
+	sf::Vector2i m_mousePosition;
+	float m_wheelDelta = 0.0f;
+	std::vector<Action> m_actions;
+
+	std::thread m_sampler;
+	std::atomic<bool> m_stopSampling{ false };
+	bool m_sampledKeys[sf::Keyboard::KeyCount] = {};         ///< Del hilo de muestreo mientras corre.
+	bool m_sampledButtons[sf::Mouse::ButtonCount] = {};
+	sf::Vector2i m_sampledMouse;
+	EngineUtilities::TMpscQueue<InputEvent> m_samples{ kSampleQueueCapacity };
+};
@@ -0,0 +1,334 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Containers/TWorkStealingDeque.h"
+#include "Memory/TUniquePtr.h"
+#include "Profiling/TracyBridge.h"
+
+/**
+ * @class JobCounter
+ * @brief Cuenta los trabajos de un grupo que an no terminan; `JobSystem::wait` espera a cero.
+ *
+ * Un trabajo que lanza otros del mismo grupo antes de terminar mantiene el contador por
+ * encima de cero, as que esperar el contador espera al grupo completo.
+ */
+class
+JobCounter {
+public:
+	JobCounter() = default;
+
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	bool
+	isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+	uint32_t
+	pending() const { return m_pending.load(std::memory_order_relaxed); }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> m_pending{ 0 }; ///< Trabajos del grupo sin terminar.
+};
+
+/**
+ * @brief Lo que hizo un hilo con cola propia entre dos `JobSystem::collectTelemetry`.
+ */
+struct JobWorkerStats {
+	uint64_t jobs = 0;             ///< Trabajos ejecutados.
+	uint64_t stealAttempts = 0;    ///< Colas ajenas probadas.
+	uint64_t steals = 0;           ///< Y las que dieron trabajo.
+	double busyMs = 0.0;           ///< Ejecutando trabajos; solo con el profiler encendido.
+	double waitMs = 0.0;           ///< En `wait` sin trabajo que ejecutar; dem.
+	uint32_t queued = 0;           ///< En su cola al tomar la muestra.
+};
+
+/**
+ * @brief Muestra de `JobSystem::collectTelemetry`.
+ */
+struct JobTelemetry {
+	double ms = 0.0;                       ///< Desde la muestra anterior.
+	uint32_t externalQueued = 0;           ///< En la cola de los hilos ajenos.
+	std::vector<JobWorkerStats> workers;   ///< 0 = hilo creador; 1.. = hilos de trabajo.
+
+	/**
+	 * @brief Todos los hilos sumados; `queued` incluye la cola de los ajenos.
+	 */
+	JobWorkerStats
+	total() const;
+
+	/**
+	 * @brief Parte del tiempo de la muestra que los hilos pasaron ejecutando, de 0 a 1.
+	 */
+	double
+	utilization() const;
+};
+
+/**
+ * @class JobSystem
+ * @brief Sistema de trabajos del motor: un hilo por ncleo y robo de trabajo.
+ *
+ * Cada hilo (los de trabajo y el que construy el sistema, normalmente el principal) tiene
+ * su `TWorkStealingDeque`: encola y desencola por su lado sin candados, y cuando se queda sin
+ * trabajo roba del tope de otro. Los hilos ajenos encolan en una cola compartida con mutex.
+ *
+ * Los trabajos son funciones pequeas guardadas dentro de un `Job` de 64 bytes, tomado de un
+ * anillo por hilo: lanzar un trabajo no reserva memoria. Si el anillo o la cola se llenan,
+ * el trabajo se ejecuta en el acto en el hilo que lo lanz.
+ *
+ * Es un servicio (`TService<JobSystem>`): planificador de sistemas, carga de assets, fsica y
+ * armado de comandos de render comparten los mismos hilos en lugar de crear los suyos.
+ *
+ * Cada hilo con cola propia cuenta sus trabajos y robos (`collectTelemetry`); mientras el
+ * profiler mide, tambin el tiempo ejecutando y el que pasa en `wait` sin nada que hacer, con
+ * dos lecturas del reloj por trabajo. Un escalado pobre se ve ah: mucho robo y poco tiempo
+ * ocupado son trabajos demasiado chicos, espera alta con hilos ociosos es un camino serial.
+ */
+class
+JobSystem {
+public:
+	/**
+	 * @brief Crea `workerCount` hilos; por defecto uno menos que los ncleos, porque el hilo
+	 *        que construye tambin ejecuta trabajos mientras espera.
+	 */
+	explicit
+	JobSystem(unsigned workerCount = defaultWorkerCount());
+
+	/**
+	 * @brief Espera a que los hilos terminen lo pendiente y los une.
+	 */
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/**
+	 * @brief Lanza `function()` en algn hilo.
+	 * @param counter Grupo al que pertenece, o nulo.
+	 */
+	template<typename Fn>
+	void
+	run(Fn&& function, JobCounter* counter = nullptr) {
+		using Callable = std::decay_t<Fn>;
+		static_assert(sizeof(Callable) <= Job::kPayloadSize, "Captura demasiado grande para un Job; capturar por referencia");
+		static_assert(alignof(Callable) <= alignof(void*), "Captura con alineacin no soportada");
+
+		if (counter) {
+			counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+		Job* job = m_inline.load(std::memory_order_relaxed) ? nullptr : allocateJob();
+		if (!job) {
+			// Sin espacio, o en modo de un hilo: ejecutar aqu mismo
+			function();
+			finish(counter);
+			return;
+		}
+		::new (static_cast<void*>(job->payload)) Callable(std::forward<Fn>(function));
+		job->invoke = [](Job& self) {
+			Callable* callable = std::launder(reinterpret_cast<Callable*>(self.payload));
+			(*callable)();
+			callable->~Callable();
+		};
+		job->counter = counter;
+		enqueue(job);
+	}
+
+	/**
+	 * @brief Ejecuta `function(begin, end)` sobre `[0, count)` partido en lotes de al menos
+	 *        `minBatch` elementos, y regresa cuando terminan todos.
+	 */
+	template<typename Fn>
+	void
+	parallelFor(size_t count, size_t minBatch, Fn&& function) {
+		if (count == 0) {
+			return;
+		}
+		size_t threads = activeWorkers() + 1;
+		size_t batch = std::max<size_t>(minBatch ? minBatch : 1, (count + threads * 4 - 1) / (threads * 4));
+		if (batch >= count) {
+			function(size_t(0), count);
+			return;
+		}
+		JobCounter counter;
+		for (size_t begin = 0; begin < count; begin += batch) {
+			size_t end = std::min(count, begin + batch);
+			run([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+		wait(counter);
+	}
+
+	/**
+	 * @brief Espera a que el grupo termine ejecutando trabajos mientras tanto.
+	 */
+	void
+	wait(const JobCounter& counter);
+
+	/**
+	 * @brief Ejecuta un trabajo pendiente en el hilo actual, si encuentra alguno.
+	 */
+	bool
+	runPendingJob();
+
+	unsigned
+	workerCount() const { return static_cast<unsigned>(m_workers.size() - 1); }
+
+	/**
+	 * @brief Deja tomar trabajo solo a los primeros `count` hilos de trabajo (hasta `workerCount`);
+	 *        los dems duermen hasta que vuelva a subir. Con 0, los que tienen camino de un hilo
+	 *        (`activeWorkers() == 0`) lo toman. Para medir cmo escala el motor con 1, 2, ... hilos
+	 *        sin reconstruir el sistema. Desde el hilo creador, entre frames.
+	 */
+	void
+	setActiveWorkers(unsigned count);
+
+	/**
+	 * @brief Hilos de trabajo que toman trabajo; `workerCount` si no se limit.
+	 */
+	unsigned
+	activeWorkers() const { return m_active.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Con `true`, cada trabajo corre en el acto en el hilo que lo lanza: todo el motor
+	 *        (sistemas, `parallelFor`, cargas) queda en un hilo sin reconstruir el sistema.
+	 *        Para comparar con y sin hilos; los hilos de trabajo solo terminan lo ya encolado.
+	 */
+	void
+	setInline(bool enabled) { m_inline.store(enabled, std::memory_order_relaxed); }
+
+	bool
+	isInline() const { return m_inline.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Lo de cada hilo desde la llamada anterior (o desde el arranque). Desde un solo hilo.
+	 *        Los trabajos que ejecutan los hilos ajenos no se cuentan.
+	 */
+	void
+	collectTelemetry(JobTelemetry& out);
+
+	static unsigned
+	defaultWorkerCount();
+
+private:
+	/**
+	 * @brief Trabajo: funcin con sus capturas guardadas en lnea.
+	 */
+	struct alignas(64) Job {
+		static constexpr size_t kPayloadSize = 40;
+
+		void (*invoke)(Job&) = nullptr;               ///< Llama y destruye la funcin guardada.
+		JobCounter* counter = nullptr;                ///< Grupo a descontar al terminar.
+		std::atomic<bool> running{ false };           ///< Ocupado desde que se lanza hasta que termina.
+		bool external = false;                        ///< Reservado con new por un hilo ajeno.
+		alignas(void*) unsigned char payload[kPayloadSize]; ///< Funcin y capturas.
+	};
+
+	static_assert(sizeof(void*) != 8 || sizeof(Job) == 64, "Job debe ocupar una lnea de cach");
+
+	static constexpr size_t kJobsPerThread = 4096; ///< Tamao del anillo y de la cola de cada hilo.
+
+	/**
+	 * @brief Totales de un hilo. Solo l los escribe, con `add`; `collectTelemetry` los lee.
+	 */
+	struct Counters {
+		std::atomic<uint64_t> jobs{ 0 };
+		std::atomic<uint64_t> stealAttempts{ 0 };
+		std::atomic<uint64_t> steals{ 0 };
+		std::atomic<int64_t> busyNs{ 0 };
+		std::atomic<int64_t> waitNs{ 0 };
+
+		/**
+		 * @brief Suma sin instruccin atmica de lectura y escritura: no hay otro que escriba.
+		 */
+		template<typename T>
+		static void
+		add(std::atomic<T>& total, T value) {
+			total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * @brief Lo de `Counters` en la muestra anterior.
+	 */
+	struct Reported {
+		uint64_t jobs = 0;
+		uint64_t stealAttempts = 0;
+		uint64_t steals = 0;
+		int64_t busyNs = 0;
+		int64_t waitNs = 0;
+	};
+
+	/**
+	 * @brief Estado de un hilo que posee cola propia.
+	 */
+	struct Worker {
+		Worker() : queue(kJobsPerThread), jobs(EngineUtilities::MakeUnique<Job[]>(kJobsPerThread)) {}
+
+		EngineUtilities::TWorkStealingDeque<Job*> queue;  ///< Trabajos lanzados por este hilo.
+		EngineUtilities::TUniquePtr<Job[]> jobs;          ///< Anillo de `Job`.
+		size_t nextJob = 0;                               ///< Prxima entrada del anillo.
+		uint32_t random = 0;                              ///< Estado del xorshift para elegir vctima.
+		uint32_t depth = 0;                               ///< Trabajos en curso, uno dentro de otro (`wait`).
+		std::thread thread;                               ///< Vaco para el hilo que construy el sistema.
+		alignas(64) Counters counters;                    ///< Aparte: los ladrones leen la cola, no esto.
+		Reported reported;                                ///< Solo de `collectTelemetry`.
+	};
+
+	/**
+	 * @brief `Worker` del hilo actual en este sistema, o nulo si es un hilo ajeno.
+	 */
+	Worker*
+	currentWorker() const;
+
+	Job*
+	allocateJob();
+
+	void
+	enqueue(Job* job);
+
+	/**
+	 * @brief Busca trabajo: cola propia, cola compartida y, por ltimo, robo.
+	 */
+	Job*
+	findJob(Worker* self);
+
+	/**
+	 * @param self Quien lo ejecuta, para contarlo; nulo en un hilo ajeno.
+	 */
+	void
+	execute(Job* job, Worker* self);
+
+	static void
+	finish(JobCounter* counter) {
+		if (counter) {
+			counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	void
+	workerLoop(unsigned index);
+
+	std::vector<EngineUtilities::TUniquePtr<Worker>> m_workers; ///< 0 = hilo creador; 1.. = hilos de trabajo.
+	std::deque<Job*> m_external;                                ///< Trabajos de hilos ajenos (reservados con new).
+	ENGINE_MUTEX(m_externalMutex);                              ///< Protege `m_external`.
+	std::atomic<size_t> m_externalCount{ 0 };                   ///< Tamao de `m_external` sin tomar el mutex.
+	std::atomic<int64_t> m_queued{ 0 };                         ///< Trabajos encolados sin tomar.
+	std::atomic<unsigned> m_sleeping{ 0 };                      ///< Hilos dormidos esperando trabajo.
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_resume;                           ///< Para los hilos por encima de `m_active`.
+	std::atomic<unsigned> m_active{ 0 };                        ///< De `setActiveWorkers`.
+	std::atomic<bool> m_stopping{ false };
+	std::atomic<bool> m_inline{ false };                        ///< De `setInline`.
+	int64_t m_lastTelemetry = 0;                                ///< `Profiler::now` de la muestra anterior.
+};
@@ -0,0 +1,151 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include "ECS/ComponentPool.h"
+#include "ECS/View.h"
+#include "Jobs/JobSystem.h"
+
+/**
+ * @file ParallelFor.h
+ * @brief Recorridos en paralelo sobre arreglos de componentes, partidos en trozos del job system.
+ *
+ * Los trozos tienen un nmero de elementos que ocupa lneas de cach enteras (y al menos
+ * `grainSize`), as que si el arreglo empieza en una lnea dos hilos nunca escriben en la
+ * misma; las columnas de los arquetipos siempre empiezan en una (`kColumnAlignment`).
+ *
+ * Los lmites de los trozos dependen solo del nmero de elementos y de `grainSize`, no de
+ * cuntos hilos hay ni de quin termina primero: una reduccin que guarda un resultado por
+ * `chunkIndex` y los suma en orden da lo mismo en cada ejecucin.
+ */
+
+constexpr size_t kCacheLineSize = 64; ///< Bytes por lnea de cach.
+
+/**
+ * @brief Elementos por trozo: al menos `grainSize`, redondeado a lneas de cach completas.
+ */
+constexpr size_t
+chunkSizeFor(size_t elementSize, size_t grainSize) {
+	size_t lineStep = kCacheLineSize / std::gcd(elementSize, kCacheLineSize);
+	size_t grain = grainSize ? grainSize : 1;
+	return (grain + lineStep - 1) / lineStep * lineStep;
+}
+
+/**
+ * @brief Trozos en que `parallelForChunks` parte `count` elementos de tipo `T`.
+ */
+template<typename T>
+constexpr size_t
+chunkCountFor(size_t count, size_t grainSize) {
+	size_t chunk = chunkSizeFor(sizeof(T), grainSize);
+	return (count + chunk - 1) / chunk;
+}
+
+/**
+ * @brief Llama a `fn(std::span<T> chunk, size_t chunkIndex)` por cada trozo de `items`, en
+ *        paralelo, y regresa cuando terminaron todos. El hilo que llama tambin trabaja.
+ */
+template<typename T, typename Fn>
+void
+parallelForChunks(JobSystem& jobs, std::span<T> items, size_t grainSize, Fn&& fn) {
+	size_t chunk = chunkSizeFor(sizeof(T), grainSize);
+	size_t chunks = (items.size() + chunk - 1) / chunk;
+	auto chunkAt = [items, chunk](size_t index) {
+		return items.subspan(index * chunk, std::min(chunk, items.size() - index * chunk));
+	};
+	if (chunks <= 1 || jobs.activeWorkers() == 0) {
+		for (size_t index = 0; index < chunks; ++index) {
+			fn(chunkAt(index), index);
+		}
+		return;
+	}
+	JobCounter counter;
+	for (size_t index = 1; index < chunks; ++index) {
+		jobs.run([&fn, &chunkAt, index]() { fn(chunkAt(index), index); }, &counter);
+	}
+	fn(chunkAt(0), size_t(0));
+	jobs.wait(counter);
+}
+
+/**
+ * @brief Llama a `fn(T&)` por cada elemento de `items`, en trozos paralelos.
+ */
+template<typename T, typename Fn>
+void
+parallelForEach(JobSystem& jobs, std::span<T> items, size_t grainSize, Fn&& fn) {
+	parallelForChunks(jobs, items, grainSize, [&fn](std::span<T> chunk, size_t) {
+		for (T& item : chunk) {
+			fn(item);
+		}
+	});
+}
+
+/**
+ * @brief Llama a `fn(EntityId, T&)` por cada componente de un conjunto disperso, en trozos
+ *        paralelos del arreglo denso.
+ */
+template<typename T, typename Fn>
+void
+parallelForEach(JobSystem& jobs, ComponentPool<T>& pool, size_t grainSize, Fn&& fn) {
+	T* first = pool.data();
+	const EntityId* entities = pool.entities();
+	parallelForChunks(jobs, std::span<T>(first, pool.size()), grainSize,
+		[&fn, first, entities](std::span<T> chunk, size_t) {
+			const EntityId* owner = entities + (chunk.data() - first);
+			for (size_t i = 0; i < chunk.size(); ++i) {
+				fn(owner[i], chunk[i]);
+			}
+		});
+}
+
+/**
+ * @brief Llama a `fn(Archetype&, begin, end)` por trozos de filas de cada arquetipo de `view`,
+ *        en paralelo; trozos del mismo tamao que `parallelForEach`.
+ *
+ * Para los sistemas que procesan un trozo entero a la vez (juntar columnas en arreglos y
+ * pasarlas por un kernel SIMD, por ejemplo). Dentro, `WorldView<Ts...>::eachRow` recorre las
+ * filas y marca las columnas escritas.
+ */
+template<typename... Ts, typename Fn>
+void
+parallelForRows(JobSystem& jobs, const WorldView<Ts...>& view, size_t grainSize, Fn&& fn) {
+	size_t chunk = std::max({ chunkSizeFor(sizeof(StoredComponent<Ts>), grainSize)... });
+	chunk = (chunk + kChangeBlockRows - 1) / kChangeBlockRows * kChangeBlockRows;
+	if (jobs.activeWorkers() == 0) {
+		for (Archetype* archetype : view.archetypes()) {
+			for (size_t begin = 0; begin < archetype->size(); begin += chunk) {
+				fn(*archetype, begin, std::min(archetype->size(), begin + chunk));
+			}
+		}
+		return;
+	}
+	JobCounter counter;
+	for (Archetype* archetype : view.archetypes()) {
+		size_t rows = archetype->size();
+		for (size_t begin = 0; begin < rows; begin += chunk) {
+			size_t end = std::min(rows, begin + chunk);
+			jobs.run([&fn, archetype, begin, end]() { fn(*archetype, begin, end); }, &counter);
+		}
+	}
+	jobs.wait(counter);
+}
+
+/**
+ * @brief Llama a `fn(EntityId, Ts&...)` por cada entidad de `view`, en trozos paralelos de
+ *        filas de cada arquetipo.
+ *
+ * El tamao de trozo sirve para todas las columnas a la vez y es mltiplo de
+ * `kChangeBlockRows`, as que dos trozos nunca marcan el mismo bloque de ticks de cambio. `fn` no debe hacer cambios estructurales; para eso
+ * est `EntityCommandBuffer`.
+ */
+template<typename... Ts, typename Fn>
+void
+parallelForEach(JobSystem& jobs, const WorldView<Ts...>& view, size_t grainSize, Fn&& fn) {
+	if (jobs.activeWorkers() == 0) {
+		view.each(fn);
+		return;
+	}
+	parallelForRows(jobs, view, grainSize,
+		[&fn](Archetype& archetype, size_t begin, size_t end) { WorldView<Ts...>::eachRow(archetype, begin, end, fn); });
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Memory/TUniquePtr.h"
+
+class JobSystem;
+
+/**
+ * @class TaskGraph
+ * @brief Tareas que corren una vez, cada una cuando terminan las que declar antes; las
+ *        independientes, a la vez en el `JobSystem`. Anota cundo corri cada una.
+ *
+ * Cada tarea solo puede depender de tareas ya agregadas, as que no hay ciclos. Las marcadas
+ * `Affinity::Main` corren en el hilo que llama a `run` (la ventana y el contexto de OpenGL son
+ * de ese hilo); las dems, en cualquiera. Mientras espera, `run` ejecuta trabajos pendientes.
+ *
+ * La lnea de tiempo cuenta desde la primera llamada a `run` o `mark` e incluye las marcas
+ * sueltas (el primer frame, por ejemplo). `writeTrace` la guarda en el formato de eventos de
+ * Chrome (`chrome://tracing`, Perfetto), un carril por hilo.
+ *
+ * Las tareas que tocan lo mismo (el mundo, un servicio de un solo hilo) deben encadenarse: el
+ * grafo no revisa accesos como `SystemScheduler`. `add`, `run`, `mark` y las consultas, desde
+ * un solo hilo.
+ */
+class
+TaskGraph {
+public:
+	using TaskId = uint32_t;
+
+	enum class Affinity : uint8_t {
+		Any,
+		Main   ///< En el hilo de `run`.
+	};
+
+	/**
+	 * @brief Una tarea o una marca de la lnea de tiempo; la marca empieza y termina a la vez.
+	 */
+	struct Timing {
+		const char* name = nullptr;
+		double startMs = 0.0;     ///< Desde el origen de la lnea de tiempo.
+		double endMs = 0.0;
+		uint32_t thread = 0;      ///< 0 el hilo de `run`; los dems, en orden de aparicin.
+		bool isMark = false;
+	};
+
+	TaskGraph() = default;
+
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+	/**
+	 * @brief Agrega `function`, que corre despus de las tareas `after`.
+	 * @param name Literal; se guarda el puntero.
+	 */
+	TaskId
+	add(const char* name, std::function<void()> function, std::initializer_list<TaskId> after = {},
+	    Affinity affinity = Affinity::Any);
+
+	/**
+	 * @brief Corre todas las tareas agregadas desde el ltimo `run` y regresa cuando terminan.
+	 */
+	void
+	run(JobSystem& jobs);
+
+	/**
+	 * @brief Anota `name` en la lnea de tiempo, ahora.
+	 */
+	void
+	mark(const char* name);
+
+	/**
+	 * @brief Milisegundos desde el origen de la lnea de tiempo; 0 si an no empez.
+	 */
+	double
+	elapsedMs() const;
+
+	/**
+	 * @brief Tareas ya corridas y marcas, en el orden en que terminaron.
+	 */
+	const std::vector<Timing>&
+	timeline() const { return m_timeline; }
+
+	/**
+	 * @brief Guarda la lnea de tiempo como JSON de eventos de Chrome.
+	 * @return `false` si no pudo escribirse.
+	 */
+	bool
+	writeTrace(const std::string& path) const;
+
+	/**
+	 * @brief Una lnea por tarea y marca: cundo empez, cunto dur y en qu hilo.
+	 */
+	void
+	print(std::ostream& out) const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+	static constexpr TaskId kNoTask = ~TaskId(0);
+
+	struct Task {
+		const char* name = nullptr;
+		std::function<void()> function;
+		std::vector<TaskId> dependents;
+		uint32_t dependencies = 0;
+		Affinity affinity = Affinity::Any;
+		Clock::time_point start;
+		Clock::time_point end;
+		std::thread::id thread;
+	};
+
+	/**
+	 * @brief Corre la tarea `index` y suelta a las que la esperaban.
+	 */
+	void
+	execute(TaskId index);
+
+	/**
+	 * @brief Encola la tarea `index`, ya sin dependencias pendientes.
+	 */
+	void
+	dispatch(TaskId index);
+
+	void
+	startClock();
+
+	double
+	toMs(Clock::time_point time) const;
+
+	/**
+	 * @brief Carril de `thread`; asigna el siguiente si es nuevo.
+	 */
+	uint32_t
+	lane(std::thread::id thread);
+
+	std::vector<Task> m_tasks;
+	size_t m_firstPending = 0;                                   ///< Las anteriores ya corrieron.
+	EngineUtilities::TUniquePtr<std::atomic<uint32_t>[]> m_waiting; ///< Dependencias sin terminar, durante `run`.
+	std::atomic<size_t> m_left{ 0 };                              ///< Tareas de este `run` sin terminar.
+	std::vector<TaskId> m_mainReady;                              ///< Listas para el hilo de `run`.
+	std::mutex m_mainMutex;
+	JobSystem* m_jobs = nullptr;
+	Clock::time_point m_origin;
+	bool m_started = false;
+	std::vector<Timing> m_timeline;
+	std::vector<std::thread::id> m_lanes;                         ///< ndice = carril.
+};
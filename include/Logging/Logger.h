@@ -0,0 +1,242 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Containers/TSpscQueue.h"
+#include "Memory/TUniquePtr.h"
+
+enum class LogLevel : uint8_t {
+	Trace = 0,
+	Debug = 1,
+	Info = 2,
+	Warning = 3,
+	Error = 4
+};
+
+/**
+ * @brief Nivel mnimo que se compila: lo de abajo no genera cdigo. `Debug` en las builds de
+ *        desarrollo (sin `NDEBUG`) e `Info` en las dems; definir `ENGINE_LOG_LEVEL` (0 a 4)
+ *        en el proyecto para elegirlo.
+ */
+#ifndef ENGINE_LOG_LEVEL
+#ifdef NDEBUG
+#define ENGINE_LOG_LEVEL 2
+#else
+#define ENGINE_LOG_LEVEL 1
+#endif
+#endif
+
+constexpr LogLevel kMinLogLevel = static_cast<LogLevel>(ENGINE_LOG_LEVEL);
+
+/**
+ * @brief Un dato con nombre de un mensaje; se guarda tal cual y se formatea en el hilo que escribe.
+ */
+struct LogArg {
+	enum class Type : uint8_t { Int, UInt, Double, Text };
+
+	const char* key = nullptr;   ///< Literal.
+	Type type = Type::Int;
+	union {
+		int64_t i;
+		uint64_t u;
+		double d;
+		const char* text;        ///< Literal o algo que viva tanto como el programa.
+	};
+
+	LogArg() : i(0) {}
+
+	template<typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, int> = 0>
+	LogArg(const char* name, T value) : key(name) {
+		if constexpr (std::is_floating_point_v<T>) {
+			type = Type::Double;
+			d = static_cast<double>(value);
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			type = Type::Int;
+			i = static_cast<int64_t>(value);
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			type = Type::Int;
+			i = static_cast<int64_t>(value);
+		}
+		else {
+			type = Type::UInt;
+			u = static_cast<uint64_t>(value);
+		}
+	}
+
+	LogArg(const char* name, const char* value) : key(name), type(Type::Text), text(value) {}
+};
+
+/**
+ * @brief Un mensaje sin formatear: punteros a literales, datos y hora.
+ */
+struct LogRecord {
+	static constexpr size_t kMaxArgs = 4;
+
+	int64_t time = 0;             ///< Nanosegundos desde que arranc el logger.
+	const char* category = nullptr;
+	const char* method = nullptr;
+	const char* message = nullptr;
+	LogArg args[kMaxArgs];
+	uint32_t thread = 0;          ///< En orden de su primer mensaje.
+	LogLevel level = LogLevel::Info;
+	uint8_t argCount = 0;
+};
+
+/**
+ * @class Logger
+ * @brief Mensajes de todo el motor, escritos en la consola y en un archivo por un hilo propio.
+ *
+ * Quien anota solo copia punteros y nmeros en la `TSpscQueue` de su hilo, sin candados ni
+ * formato (el nico candado es el de la primera vez de cada hilo, que registra su cola). El hilo
+ * del logger vaca las colas cada `kWriteIntervalMilliseconds`, ordena por hora, formatea y
+ * escribe; un `Error` lo despierta enseguida. Si una cola se llena el mensaje se descarta y se
+ * avisa cuntos se perdieron.
+ *
+ * Con `setFile` tambin escribe en un archivo que rota al pasar `maxBytes`: el actual pasa a
+ * `.1`, el `.1` a `.2` y as hasta `keep`. Los textos (categora, mtodo, mensaje y los `Text`
+ * de los datos) se guardan como punteros: deben ser literales.
+ */
+class
+Logger {
+public:
+	static constexpr size_t kQueueCapacity = 1024;        ///< Mensajes por hilo entre dos escrituras.
+	static constexpr int kWriteIntervalMilliseconds = 10;
+	static constexpr size_t kDefaultMaxBytes = 4 * 1024 * 1024;
+	static constexpr uint32_t kDefaultKeep = 3;
+
+	static Logger&
+	instance() {
+		static Logger s_logger;
+		return s_logger;
+	}
+
+	/**
+	 * @brief Anota un mensaje del hilo actual; lo escribe el hilo del logger. Se usa con `LOG_INFO`
+	 *        y las dems macros, que descartan al compilar lo de menos de `kMinLogLevel`.
+	 */
+	void
+	log(LogLevel level, const char* category, const char* method, const char* message,
+	    std::initializer_list<LogArg> args = {});
+
+	/**
+	 * @brief Nivel mnimo desde ahora, por encima del que se compil.
+	 */
+	void
+	setLevel(LogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+
+	/**
+	 * @brief Desde qu nivel se escribe tambin en la consola (`std::cerr`).
+	 */
+	void
+	setConsoleLevel(LogLevel level) { m_consoleLevel.store(level, std::memory_order_relaxed); }
+
+	/**
+	 * @brief Escribe tambin en `path`, que se abre al final y rota al pasar `maxBytes`.
+	 * @return `false` si no pudo abrirse.
+	 */
+	bool
+	setFile(const std::string& path, size_t maxBytes = kDefaultMaxBytes, uint32_t keep = kDefaultKeep);
+
+	/**
+	 * @brief Escribe ya todo lo anotado hasta ahora, desde el hilo que llama.
+	 */
+	void
+	flush();
+
+	/**
+	 * @brief Escribe lo pendiente y detiene el hilo; lo que se anote despus se escribe en el
+	 *        momento, desde quien lo anota.
+	 */
+	void
+	shutdown();
+
+	~Logger() { shutdown(); }
+
+	Logger(const Logger&) = delete;
+	Logger& operator=(const Logger&) = delete;
+
+private:
+	struct ThreadBuffer {
+		EngineUtilities::TSpscQueue<LogRecord> records{ kQueueCapacity };
+		uint32_t thread = 0;
+		std::atomic<uint64_t> dropped{ 0 };   ///< Lo escribe su hilo, lo lee quien escribe.
+		uint64_t reported = 0;
+	};
+
+	Logger();
+
+	ThreadBuffer&
+	threadBuffer();
+
+	void
+	run();
+
+	/**
+	 * @brief Vaca todas las colas y escribe; con `m_writeMutex` tomado.
+	 */
+	void
+	drain();
+
+	void
+	write(const LogRecord& record);
+
+	/**
+	 * @brief Escribe `line` en el archivo, rotndolo antes si no entra.
+	 */
+	void
+	writeFile(const char* line, size_t length);
+
+	void
+	rotate();
+
+	int64_t
+	now() const;
+
+	static inline thread_local ThreadBuffer* t_buffer = nullptr;
+
+	std::atomic<LogLevel> m_level{ kMinLogLevel };
+	std::atomic<LogLevel> m_consoleLevel{ LogLevel::Trace };
+	std::mutex m_threadsMutex;
+	std::vector<EngineUtilities::TUniquePtr<ThreadBuffer>> m_threads;   ///< Nunca se borran.
+	std::mutex m_writeMutex;                                            ///< Lo de abajo, de quien escribe.
+	std::vector<ThreadBuffer*> m_drain;
+	std::vector<LogRecord> m_batch;
+	std::string m_line;
+	std::FILE* m_file = nullptr;
+	std::string m_path;
+	size_t m_fileBytes = 0;
+	size_t m_maxBytes = kDefaultMaxBytes;
+	uint32_t m_keep = kDefaultKeep;
+	std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wake;
+	std::atomic<bool> m_urgent{ false };
+	std::atomic<bool> m_running{ false };
+	std::thread m_thread;
+};
+
+/**
+ * @brief `message` con nivel `level` de `category::method`, y despus los datos `{ "clave", valor }`.
+ */
+#define ENGINE_LOG(level, category, method, message, ...)                              \
+	do {                                                                                \
+		if constexpr ((level) >= kMinLogLevel) {                                        \
+			::Logger::instance().log((level), category, method, message, { __VA_ARGS__ }); \
+		}                                                                               \
+	} while (0)
+
+#define LOG_TRACE(category, method, message, ...) ENGINE_LOG(LogLevel::Trace, category, method, message, __VA_ARGS__)
+#define LOG_DEBUG(category, method, message, ...) ENGINE_LOG(LogLevel::Debug, category, method, message, __VA_ARGS__)
+#define LOG_INFO(category, method, message, ...) ENGINE_LOG(LogLevel::Info, category, method, message, __VA_ARGS__)
+#define LOG_WARNING(category, method, message, ...) ENGINE_LOG(LogLevel::Warning, category, method, message, __VA_ARGS__)
+#define LOG_ERROR(category, method, message, ...) ENGINE_LOG(LogLevel::Error, category, method, message, __VA_ARGS__)
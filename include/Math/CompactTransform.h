@@ -0,0 +1,130 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Math/Quat.h"
+
+/**
+ * @brief Posicin, rotacin y escala en 16 bytes, contra los 48 de `Vec3` + `Quat` + `Vec3`.
+ *
+ * La posicin va en 16 bits por eje relativa al origen de su `CompactTransformChunk`, la
+ * rotacin en "smallest three" (el componente mayor se deduce de los otros tres, que van en
+ * 10 bits cada uno) y la escala en half floats. Para poblaciones enormes que casi no se
+ * mueven o estn lejos: recorrerlas cuesta un tercio del ancho de banda.
+ */
+struct alignas(16) CompactTransform {
+	uint16_t position[3];   ///< Pasos de `CompactTransformChunk::getStep` desde el origen.
+	uint16_t scale[3];      ///< Half floats (IEEE 754 binary16).
+	uint32_t rotation;      ///< `packRotation`.
+};
+
+static_assert(sizeof(CompactTransform) == 16, "CompactTransform debe ocupar un registro");
+
+/**
+ * @brief `value` como half float, redondeado al par ms cercano. Lo que no cabe queda en el
+ *        mayor finito (65504) con su signo; NaN sigue siendo NaN.
+ */
+uint16_t
+floatToHalf(float value);
+
+float
+halfToFloat(uint16_t half);
+
+/**
+ * @brief Cuaternin unitario en 32 bits: ndice del componente mayor en los 2 bits altos y
+ *        los otros tres en 10 bits cada uno (en el orden x, y, z, w que sigue al mayor). El
+ *        mayor se guarda positivo (q y -q son la misma rotacin). Error de ~0.001 por componente.
+ */
+uint32_t
+packRotation(const Quat& rotation);
+
+Quat
+unpackRotation(uint32_t packed);
+
+/**
+ * @class CompactTransformChunk
+ * @brief Transforms compactos de un cubo del mundo: origen y lado comunes a todos.
+ *
+ * Con lado `extent` la posicin tiene un paso de `extent / 65535`: un bloque de 1024 unidades
+ * guarda posiciones con ~0.016 de error. Lo que cae fuera del cubo se lleva al borde; quien
+ * reparte el mundo en bloques elige el bloque con `contains`.
+ *
+ * Se decodifica al leer: `decode` arma la matriz de uno, `decodeMatrices` y `decodePositions`
+ * las de un rango. El desempaque de posicin y escala es vectorial (SSE2, F16C si est, NEON)
+ * y la matriz se arma con los registros de `Vec.h`.
+ */
+class
+CompactTransformChunk {
+public:
+	CompactTransformChunk(const Vec3& origin, float extent);
+
+	/**
+	 * @brief Agrega un transform y devuelve su ndice.
+	 */
+	uint32_t
+	add(const Vec3& translation, const Quat& rotation, const Vec3& scale);
+
+	void
+	set(uint32_t index, const Vec3& translation, const Quat& rotation, const Vec3& scale);
+
+	void
+	clear() { m_transforms.clear(); }
+
+	void
+	reserve(size_t count) { m_transforms.reserve(count); }
+
+	size_t
+	size() const { return m_transforms.size(); }
+
+	const CompactTransform*
+	data() const { return m_transforms.data(); }
+
+	const Vec3&
+	getOrigin() const { return m_origin; }
+
+	float
+	getExtent() const { return m_extent; }
+
+	/**
+	 * @brief Distancia entre dos posiciones representables: el error mximo es la mitad.
+	 */
+	float
+	getStep() const { return m_step; }
+
+	/**
+	 * @brief Indica si `position` cae dentro del cubo, sin llevarse al borde.
+	 */
+	bool
+	contains(const Vec3& position) const;
+
+	Vec3
+	decodePosition(uint32_t index) const;
+
+	/**
+	 * @brief La matriz de mundo del transform `index`, como `composeTransform`.
+	 */
+	Mat4
+	decode(uint32_t index) const;
+
+	/**
+	 * @brief Matrices de los transforms `[first, first + count)`.
+	 */
+	void
+	decodeMatrices(size_t first, size_t count, Mat4* out) const;
+
+	/**
+	 * @brief Solo las posiciones de `[first, first + count)`: para cortar por distancia o
+	 *        vista sin armar matrices.
+	 */
+	void
+	decodePositions(size_t first, size_t count, Vec3* out) const;
+
+private:
+	CompactTransform
+	encode(const Vec3& translation, const Quat& rotation, const Vec3& scale) const;
+
+	Vec3 m_origin;
+	float m_extent;
+	float m_step;                              ///< `m_extent / 65535`.
+	std::vector<CompactTransform> m_transforms;
+};
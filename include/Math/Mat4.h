@@ -0,0 +1,294 @@
+#pragma once
+#include <cmath>
+#include "Prerequisites.h"
+#include "Math/Simd.h"
+
+#define MAT4_SSE MATH_SSE
+
+/**
+ * @brief Matriz 4x4 de floats por columnas, como la espera OpenGL (`glUniformMatrix4fv` sin
+ *        transponer) y como la devuelve `sf::Transform::getMatrix`.
+ *
+ * El elemento de la fila `r` y la columna `c` es `m[c * 4 + r]`; los vectores son columnas y
+ * `a * b` aplica primero `b`. Alineada a 16 bytes: con SSE o NEON cada columna es un registro y
+ * el producto son 16 multiplicaciones-suma de 4 floats; sin ellos se hace escalar.
+ */
+struct alignas(16) Mat4 {
+	float m[16] = { 1.0f, 0.0f, 0.0f, 0.0f,
+	                0.0f, 1.0f, 0.0f, 0.0f,
+	                0.0f, 0.0f, 1.0f, 0.0f,
+	                0.0f, 0.0f, 0.0f, 1.0f };
+
+	const float*
+	data() const { return m; }
+
+	static Mat4
+	identity() { return Mat4(); }
+
+	static Mat4
+	fromColumns(const float* values) {
+		Mat4 result;
+		for (int i = 0; i < 16; ++i) {
+			result.m[i] = values[i];
+		}
+		return result;
+	}
+
+	/**
+	 * @brief La matriz 2D de SFML en el plano z = 0; z pasa sin cambios.
+	 */
+	static Mat4
+	fromTransform(const sf::Transform& transform) { return fromColumns(transform.getMatrix()); }
+
+	/**
+	 * @brief Lo contrario de `fromTransform`: x, y y la ltima fila; lo que toca a z se pierde.
+	 */
+	sf::Transform
+	toTransform() const {
+		return sf::Transform(m[0], m[4], m[12],
+		                     m[1], m[5], m[13],
+		                     m[3], m[7], m[15]);
+	}
+
+	static Mat4
+	translation(float x, float y, float z) {
+		Mat4 result;
+		result.m[12] = x;
+		result.m[13] = y;
+		result.m[14] = z;
+		return result;
+	}
+
+	static Mat4
+	scale(float x, float y, float z) {
+		Mat4 result;
+		result.m[0] = x;
+		result.m[5] = y;
+		result.m[10] = z;
+		return result;
+	}
+
+	/**
+	 * @brief Giros en grados alrededor de cada eje, con la regla de la mano derecha.
+	 */
+	static Mat4
+	rotationX(float degrees) {
+		float c, s;
+		sinCos(degrees, s, c);
+		Mat4 result;
+		result.m[5] = c;
+		result.m[6] = s;
+		result.m[9] = -s;
+		result.m[10] = c;
+		return result;
+	}
+
+	static Mat4
+	rotationY(float degrees) {
+		float c, s;
+		sinCos(degrees, s, c);
+		Mat4 result;
+		result.m[0] = c;
+		result.m[2] = -s;
+		result.m[8] = s;
+		result.m[10] = c;
+		return result;
+	}
+
+	static Mat4
+	rotationZ(float degrees) {
+		float c, s;
+		sinCos(degrees, s, c);
+		Mat4 result;
+		result.m[0] = c;
+		result.m[1] = s;
+		result.m[4] = -s;
+		result.m[5] = c;
+		return result;
+	}
+
+	/**
+	 * @brief Proyeccin ortogrfica al cubo [-1, 1] de OpenGL; z mira hacia la pantalla, as
+	 *        que `-near` queda delante y `-far` detrs.
+	 */
+	static Mat4
+	orthographic(float left, float right, float bottom, float top, float nearPlane, float farPlane) {
+		Mat4 result;
+		result.m[0] = 2.0f / (right - left);
+		result.m[5] = 2.0f / (top - bottom);
+		result.m[10] = -2.0f / (farPlane - nearPlane);
+		result.m[12] = -(right + left) / (right - left);
+		result.m[13] = -(top + bottom) / (top - bottom);
+		result.m[14] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+		return result;
+	}
+
+	/**
+	 * @brief Vista de una cmara en `eye` que mira a `target`, para un mundo de mano derecha
+	 *        (x a la derecha, y arriba, z hacia quien mira): la cmara mira hacia su -z.
+	 */
+	static Mat4
+	lookAt(const sf::Vector3f& eye, const sf::Vector3f& target, const sf::Vector3f& up) {
+		sf::Vector3f forward = normalized(target - eye);
+		sf::Vector3f side = normalized(cross(forward, up));
+		sf::Vector3f cameraUp = cross(side, forward);
+		Mat4 result;
+		result.m[0] = side.x;
+		result.m[4] = side.y;
+		result.m[8] = side.z;
+		result.m[1] = cameraUp.x;
+		result.m[5] = cameraUp.y;
+		result.m[9] = cameraUp.z;
+		result.m[2] = -forward.x;
+		result.m[6] = -forward.y;
+		result.m[10] = -forward.z;
+		result.m[12] = -dot(side, eye);
+		result.m[13] = -dot(cameraUp, eye);
+		result.m[14] = dot(forward, eye);
+		return result;
+	}
+
+	/**
+	 * @brief Proyeccin en perspectiva al cubo [-1, 1] de OpenGL.
+	 * @param fovYDegrees Apertura vertical, en grados.
+	 */
+	static Mat4
+	perspective(float fovYDegrees, float aspect, float nearPlane, float farPlane) {
+		float focal = 1.0f / std::tan(fovYDegrees * 3.14159265f / 360.0f);
+		Mat4 result;
+		result.m[0] = focal / aspect;
+		result.m[5] = focal;
+		result.m[10] = (farPlane + nearPlane) / (nearPlane - farPlane);
+		result.m[11] = -1.0f;
+		result.m[14] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+		result.m[15] = 0.0f;
+		return result;
+	}
+
+	Mat4
+	operator*(const Mat4& other) const {
+		Mat4 result;
+#if MAT4_SSE
+		// Columna j del resultado: las columnas de esta matriz pesadas por la columna j de `other`
+		const __m128 c0 = _mm_load_ps(m);
+		const __m128 c1 = _mm_load_ps(m + 4);
+		const __m128 c2 = _mm_load_ps(m + 8);
+		const __m128 c3 = _mm_load_ps(m + 12);
+		for (int column = 0; column < 4; ++column) {
+			const float* weights = other.m + column * 4;
+			__m128 sum = _mm_mul_ps(c0, _mm_set1_ps(weights[0]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(weights[1])));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(weights[2])));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_set1_ps(weights[3])));
+			_mm_store_ps(result.m + column * 4, sum);
+		}
+#elif MATH_NEON
+		const float32x4_t c0 = vld1q_f32(m);
+		const float32x4_t c1 = vld1q_f32(m + 4);
+		const float32x4_t c2 = vld1q_f32(m + 8);
+		const float32x4_t c3 = vld1q_f32(m + 12);
+		for (int column = 0; column < 4; ++column) {
+			const float* weights = other.m + column * 4;
+			float32x4_t sum = vmulq_n_f32(c0, weights[0]);
+			sum = vmlaq_n_f32(sum, c1, weights[1]);
+			sum = vmlaq_n_f32(sum, c2, weights[2]);
+			sum = vmlaq_n_f32(sum, c3, weights[3]);
+			vst1q_f32(result.m + column * 4, sum);
+		}
+#else
+		for (int column = 0; column < 4; ++column) {
+			for (int row = 0; row < 4; ++row) {
+				float sum = 0.0f;
+				for (int k = 0; k < 4; ++k) {
+					sum += m[k * 4 + row] * other.m[column * 4 + k];
+				}
+				result.m[column * 4 + row] = sum;
+			}
+		}
+#endif
+		return result;
+	}
+
+	bool
+	operator==(const Mat4& other) const {
+		for (int i = 0; i < 16; ++i) {
+			if (m[i] != other.m[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool
+	operator!=(const Mat4& other) const { return !(*this == other); }
+
+	sf::Vector3f
+	transformPoint(const sf::Vector3f& p) const {
+		return sf::Vector3f(m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+		                    m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+		                    m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+	}
+
+	/**
+	 * @brief Como `transformPoint`, sin la traslacin.
+	 */
+	sf::Vector3f
+	transformVector(const sf::Vector3f& v) const {
+		return sf::Vector3f(m[0] * v.x + m[4] * v.y + m[8] * v.z,
+		                    m[1] * v.x + m[5] * v.y + m[9] * v.z,
+		                    m[2] * v.x + m[6] * v.y + m[10] * v.z);
+	}
+
+	/**
+	 * @brief Inversa de una matriz sin proyeccin (ltima fila 0, 0, 0, 1): la de un objeto en
+	 *        el mundo. Una parte 3x3 sin inversa da la identidad.
+	 */
+	Mat4
+	inverseAffine() const {
+		float c00 = m[5] * m[10] - m[9] * m[6];
+		float c01 = m[8] * m[6] - m[4] * m[10];
+		float c02 = m[4] * m[9] - m[8] * m[5];
+		float determinant = m[0] * c00 + m[1] * c01 + m[2] * c02;
+		Mat4 result;
+		if (determinant == 0.0f) {
+			return result;
+		}
+		float inverse = 1.0f / determinant;
+		result.m[0] = c00 * inverse;
+		result.m[4] = c01 * inverse;
+		result.m[8] = c02 * inverse;
+		result.m[1] = (m[9] * m[2] - m[1] * m[10]) * inverse;
+		result.m[5] = (m[0] * m[10] - m[8] * m[2]) * inverse;
+		result.m[9] = (m[8] * m[1] - m[0] * m[9]) * inverse;
+		result.m[2] = (m[1] * m[6] - m[5] * m[2]) * inverse;
+		result.m[6] = (m[4] * m[2] - m[0] * m[6]) * inverse;
+		result.m[10] = (m[0] * m[5] - m[4] * m[1]) * inverse;
+		sf::Vector3f translation = result.transformVector(sf::Vector3f(m[12], m[13], m[14]));
+		result.m[12] = -translation.x;
+		result.m[13] = -translation.y;
+		result.m[14] = -translation.z;
+		return result;
+	}
+
+private:
+	static void
+	sinCos(float degrees, float& s, float& c) {
+		float radians = degrees * 3.14159265f / 180.0f;
+		s = std::sin(radians);
+		c = std::cos(radians);
+	}
+
+	static float
+	dot(const sf::Vector3f& a, const sf::Vector3f& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+	static sf::Vector3f
+	cross(const sf::Vector3f& a, const sf::Vector3f& b) {
+		return sf::Vector3f(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+	}
+
+	static sf::Vector3f
+	normalized(const sf::Vector3f& v) {
+		float length = std::sqrt(dot(v, v));
+		return length > 0.0f ? v / length : v;
+	}
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <cmath>
+#include "Math/Mat4.h"
+#include "Math/Vec.h"
+
+/**
+ * @brief Cuaternin unitario para rotaciones 3D, `w + xi + yj + zk`, alineado a 16 bytes.
+ *
+ * `a * b` rota primero por `b`, como `Mat4`. Componer y rotar no acumulan el gimbal lock de
+ * los ngulos de Euler, e interpolar con `slerp` sigue el arco ms corto a velocidad
+ * constante; para dibujar, `toMat4`.
+ */
+struct alignas(16) Quat {
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float w = 1.0f;
+
+	Quat() = default;
+
+	Quat(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+
+	static Quat
+	identity() { return Quat(); }
+
+	/**
+	 * @brief Giro de `degrees` grados alrededor de `axis` (se normaliza), con la regla de la
+	 *        mano derecha, como `Mat4::rotationX` y compaa.
+	 */
+	static Quat
+	fromAxisAngle(const Vec3& axis, float degrees) {
+		float half = degrees * 3.14159265f / 360.0f;
+		Vec3 unit = ::normalized(axis) * std::sin(half);
+		return Quat(unit.x, unit.y, unit.z, std::cos(half));
+	}
+
+	Quat
+	operator*(const Quat& o) const {
+		return Quat(w * o.x + x * o.w + y * o.z - z * o.y,
+		            w * o.y - x * o.z + y * o.w + z * o.x,
+		            w * o.z + x * o.y - y * o.x + z * o.w,
+		            w * o.w - x * o.x - y * o.y - z * o.z);
+	}
+
+	/**
+	 * @brief La inversa de un cuaternin unitario.
+	 */
+	Quat
+	conjugate() const { return Quat(-x, -y, -z, w); }
+
+	float
+	dot(const Quat& o) const { return MathSimd::dot(reg(), o.reg()); }
+
+	Quat
+	normalized() const {
+		float squared = dot(*this);
+		if (squared <= 0.0f) {
+			return Quat();
+		}
+		return apply(MathSimd::mul(reg(), MathSimd::splat(1.0f / std::sqrt(squared))));
+	}
+
+	/**
+	 * @brief `v` rotado: `v + 2w (q x v) + 2 q x (q x v)`, sin armar la matriz.
+	 */
+	Vec3
+	rotate(const Vec3& v) const {
+		Vec3 axis(x, y, z);
+		Vec3 t = cross(axis, v) * 2.0f;
+		return v + t * w + cross(axis, t);
+	}
+
+	/**
+	 * @brief La misma rotacin como matriz por columnas.
+	 */
+	Mat4
+	toMat4() const {
+		float xx = x * x, yy = y * y, zz = z * z;
+		float xy = x * y, xz = x * z, yz = y * z;
+		float wx = w * x, wy = w * y, wz = w * z;
+		Mat4 result;
+		result.m[0] = 1.0f - 2.0f * (yy + zz);
+		result.m[1] = 2.0f * (xy + wz);
+		result.m[2] = 2.0f * (xz - wy);
+		result.m[4] = 2.0f * (xy - wz);
+		result.m[5] = 1.0f - 2.0f * (xx + zz);
+		result.m[6] = 2.0f * (yz + wx);
+		result.m[8] = 2.0f * (xz + wy);
+		result.m[9] = 2.0f * (yz - wx);
+		result.m[10] = 1.0f - 2.0f * (xx + yy);
+		return result;
+	}
+
+	/**
+	 * @brief De `a` a `b` por el arco ms corto; muy cerca uno del otro, lineal y normalizado.
+	 */
+	static Quat
+	slerp(const Quat& a, const Quat& b, float t) {
+		float cosine = a.dot(b);
+		Quat target = b;
+		if (cosine < 0.0f) {
+			// q y -q son la misma rotacin: por el otro lado el camino es ms corto
+			cosine = -cosine;
+			target = Quat(-b.x, -b.y, -b.z, -b.w);
+		}
+		float wa = 1.0f - t;
+		float wb = t;
+		if (cosine < 0.9995f) {
+			float angle = std::acos(cosine);
+			float inverseSin = 1.0f / std::sin(angle);
+			wa = std::sin(wa * angle) * inverseSin;
+			wb = std::sin(wb * angle) * inverseSin;
+		}
+		Quat result = apply(MathSimd::add(MathSimd::mul(a.reg(), MathSimd::splat(wa)),
+		                                  MathSimd::mul(target.reg(), MathSimd::splat(wb))));
+		return cosine < 0.9995f ? result : result.normalized();
+	}
+
+	MathSimd::Register
+	reg() const { return MathSimd::load(&x); }
+
+	static Quat
+	apply(MathSimd::Register r) {
+		Quat result;
+		MathSimd::store(&result.x, r);
+		return result;
+	}
+};
+
+static_assert(sizeof(Quat) == 16, "Quat debe ocupar un registro");
+
+/**
+ * @brief Escala, despus rotacin, despus traslacin: la matriz de un objeto en el mundo.
+ */
+inline Mat4
+composeTransform(const Vec3& translation, const Quat& rotation, const Vec3& scale) {
+	Mat4 result = rotation.toMat4();
+	for (int row = 0; row < 3; ++row) {
+		result.m[row] *= scale.x;
+		result.m[4 + row] *= scale.y;
+		result.m[8 + row] *= scale.z;
+	}
+	result.m[12] = translation.x;
+	result.m[13] = translation.y;
+	result.m[14] = translation.z;
+	return result;
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Prerequisites.h"
+
+/**
+ * @class Random
+ * @brief Generador xoshiro128+: 128 bits de estado, un puado de sumas, xor y rotaciones por
+ *        nmero, sin candados ni estado compartido.
+ *
+ * Los bits bajos de xoshiro128+ son los ms dbiles, as que los floats salen de los 24 altos
+ * y `below` multiplica en vez de tomar el resto. La semilla pasa por splitmix64: semillas
+ * parecidas (0, 1, 2...) dan secuencias sin relacin.
+ */
+class
+Random {
+public:
+	Random() { seed(0); }
+
+	explicit Random(uint64_t value) { seed(value); }
+
+	void
+	seed(uint64_t value);
+
+	uint32_t
+	next() {
+		uint32_t result = m_state[0] + m_state[3];
+		uint32_t t = m_state[1] << 9;
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= t;
+		m_state[3] = (m_state[3] << 11) | (m_state[3] >> 21);
+		return result;
+	}
+
+	/**
+	 * @brief Nmero en [0, 1); 24 bits, todos exactos en un float.
+	 */
+	float
+	nextFloat() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+	float
+	range(float minimum, float maximum) { return minimum + (maximum - minimum) * nextFloat(); }
+
+	/**
+	 * @brief Entero en [0, count); `count` no puede ser 0.
+	 */
+	uint32_t
+	below(uint32_t count) { return static_cast<uint32_t>((static_cast<uint64_t>(next()) * count) >> 32); }
+
+private:
+	uint32_t m_state[4];
+};
+
+/**
+ * @class RandomBatch
+ * @brief Cuatro generadores xoshiro128+ independientes que avanzan juntos: con SSE2 cada
+ *        paso da cuatro nmeros en un registro.
+ *
+ * Para llenar arreglos de una vez (partculas, puntos de aparicin). Sin SSE2 se hace lo
+ * mismo escalar, con los mismos nmeros: la salida no depende del compilador.
+ */
+class alignas(16)
+RandomBatch {
+public:
+	RandomBatch() { seed(0); }
+
+	explicit RandomBatch(uint64_t value) { seed(value); }
+
+	void
+	seed(uint64_t value);
+
+	/**
+	 * @brief Escribe `count` nmeros en [0, 1). Si `count` no es mltiplo de 4, los que
+	 *        sobran del ltimo paso se descartan.
+	 */
+	void
+	fillUniform(float* out, size_t count);
+
+	/**
+	 * @brief Como `fillUniform`, en [minimum, maximum).
+	 */
+	void
+	fillRange(float* out, size_t count, float minimum, float maximum);
+
+private:
+	uint32_t m_state[4][4]; ///< `m_state[palabra][generador]`: cada palabra es un registro.
+};
+
+/**
+ * @class RandomService
+ * @brief Nmeros al azar del motor: un `Random` por hilo sin candados y flujos con clave para
+ *        lo que tiene que repetirse.
+ *
+ * `local` da el generador del hilo que llama; lo que salga depende de qu hilo hizo el
+ * trabajo, as que sirve para lo que no afecta la simulacin. Lo que s la afecta pide
+ * `stream(clave)` con una clave estable (entidad, tick, emisor): la misma semilla y la misma
+ * clave dan los mismos nmeros en cualquier hilo y con cualquier nmero de hilos.
+ *
+ * `setSeed` cambia la semilla de todo; cada hilo vuelve a sembrar su `local` la prxima vez
+ * que lo pide. Es un servicio (`TService<RandomService>`).
+ */
+class
+RandomService {
+public:
+	static constexpr uint64_t kDefaultSeed = 0x853C49E6748FEA9Bull;
+
+	void
+	setSeed(uint64_t value);
+
+	uint64_t
+	seed() const { return m_seed.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Generador del hilo que llama; no se comparte con ningn otro.
+	 */
+	Random&
+	local();
+
+	/**
+	 * @brief Generador que depende solo de la semilla y de `key`.
+	 */
+	Random
+	stream(uint64_t key) const { return Random(mix(key)); }
+
+	RandomBatch
+	batch(uint64_t key) const { return RandomBatch(mix(key)); }
+
+private:
+	uint64_t
+	mix(uint64_t key) const { return seed() ^ (key * 0x9E3779B97F4A7C15ull); }
+
+	std::atomic<uint64_t> m_seed{ kDefaultSeed };
+	std::atomic<uint32_t> m_epoch{ 1 };      ///< Sube con cada `setSeed`; los `local` viejos se resiembran.
+	std::atomic<uint32_t> m_nextThread{ 0 };
+};
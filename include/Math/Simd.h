@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * @file Simd.h
+ * @brief Qu juego de instrucciones vectoriales usa la biblioteca de matemticas, elegido al
+ *        compilar: `MATH_SSE` en x86 (siempre en x64), adems `MATH_AVX` con `/arch:AVX` o
+ *        `-mavx`, y `MATH_NEON` en ARM de 64 bits. Sin ninguno, todo va por el camino escalar.
+ *        `MATH_SSE2` (enteros de 128 bits) y `MATH_F16C` (half floats) los usa quien desempaca.
+ */
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MATH_SSE 1
+#else
+#define MATH_SSE 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MATH_SSE2 1
+#else
+#define MATH_SSE2 0
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MATH_AVX 1
+#else
+#define MATH_AVX 0
+#endif
+
+// MSVC no avisa de F16C por separado; todo lo que tiene AVX2 lo tiene
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define MATH_F16C 1
+#else
+#define MATH_F16C 0
+#endif
+
+// Solo AArch64: los caminos NEON usan divisin y raz vectoriales, que ARMv7 no tiene
+#if !MATH_SSE && ((defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define MATH_NEON 1
+#else
+#define MATH_NEON 0
+#endif
@@ -0,0 +1,128 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <span>
+
+/**
+ * @file UnitShapes.h
+ * @brief Vértices de polígonos regulares inscritos en el círculo unidad, calculados al
+ *        compilar: armar la geometría de una figura es escalar una tabla, sin `sin` ni `cos`.
+ *
+ * El punto `i` de `count` está en el ángulo `2π i / count - π/2`, el mismo orden que
+ * `sf::CircleShape::getPoint` (el primero arriba, en sentido horario en pantalla), pero
+ * centrado en el origen: para el de SFML, `p * radius + radius`.
+ */
+namespace UnitShapes {
+
+	struct Point {
+		float x;
+		float y;
+	};
+
+	namespace detail {
+		constexpr double kPi = 3.14159265358979323846;
+
+		/**
+		 * @brief Serie de Taylor hasta x^17; en [-π/4, π/4] el error queda bajo 1e-16.
+		 */
+		constexpr double
+		sinSeries(double x) {
+			double term = x;
+			double sum = x;
+			for (int n = 1; n <= 8; ++n) {
+				term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+				sum += term;
+			}
+			return sum;
+		}
+
+		constexpr double
+		cosSeries(double x) {
+			double term = 1.0;
+			double sum = 1.0;
+			for (int n = 1; n <= 8; ++n) {
+				term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+				sum += term;
+			}
+			return sum;
+		}
+
+		/**
+		 * @brief Coseno y seno de `numerator / denominator` vueltas. La fracción se reduce en
+		 *        enteros al cuadrante más cercano, así que los ángulos rectos salen exactos.
+		 */
+		constexpr Point
+		turn(long long numerator, long long denominator) {
+			numerator %= denominator;
+			if (numerator < 0) {
+				numerator += denominator;
+			}
+			// Cuadrante más cercano y lo que sobra, en [-1/8, 1/8] de vuelta
+			long long quadrant = (numerator * 4 + denominator / 2) / denominator;
+			double rest = static_cast<double>(numerator * 4 - quadrant * denominator) / static_cast<double>(denominator * 4);
+			double angle = rest * 2.0 * kPi;
+			double c = cosSeries(angle);
+			double s = sinSeries(angle);
+			switch (quadrant & 3) {
+			case 0: return Point{ static_cast<float>(c), static_cast<float>(s) };
+			case 1: return Point{ static_cast<float>(-s), static_cast<float>(c) };
+			case 2: return Point{ static_cast<float>(-c), static_cast<float>(-s) };
+			default: return Point{ static_cast<float>(s), static_cast<float>(-c) };
+			}
+		}
+
+		template<size_t N>
+		constexpr std::array<Point, N>
+		makePolygon() {
+			std::array<Point, N> points{};
+			for (size_t i = 0; i < N; ++i) {
+				// 2π i / N - π/2 son (4i - N) / 4N vueltas
+				points[i] = turn(static_cast<long long>(4 * i) - static_cast<long long>(N), static_cast<long long>(4 * N));
+			}
+			return points;
+		}
+	}
+
+	/**
+	 * @brief Los `N` vértices del polígono regular unidad.
+	 */
+	template<size_t N>
+	inline constexpr std::array<Point, N> kPolygon = detail::makePolygon<N>();
+
+	/**
+	 * @brief `1 - cos(π / count)`: la flecha de cada lado de un polígono de `count` puntos en
+	 *        un círculo de radio 1. Con radio `r`, el contorno se aleja del círculo hasta `r` veces esto.
+	 */
+	constexpr float
+	sagitta(size_t count) {
+		return static_cast<float>(1.0 - static_cast<double>(detail::turn(1, 2 * static_cast<long long>(count)).x));
+	}
+
+	/**
+	 * @brief Elige en ejecución una de las tablas horneadas: las de los niveles de detalle de
+	 *        `ShapeFactory` (6 a 64), el triángulo, el cuadrado y los 30 puntos de SFML.
+	 * @return Vacío para cualquier otro número de puntos.
+	 */
+	constexpr std::span<const Point>
+	polygon(size_t count) {
+		switch (count) {
+		case 3: return kPolygon<3>;
+		case 4: return kPolygon<4>;
+		case 6: return kPolygon<6>;
+		case 8: return kPolygon<8>;
+		case 12: return kPolygon<12>;
+		case 16: return kPolygon<16>;
+		case 24: return kPolygon<24>;
+		case 30: return kPolygon<30>;
+		case 32: return kPolygon<32>;
+		case 48: return kPolygon<48>;
+		case 64: return kPolygon<64>;
+		default: return {};
+		}
+	}
+
+	static_assert(kPolygon<4>[0].x == 0.0f && kPolygon<4>[0].y == -1.0f && kPolygon<4>[1].x == 1.0f,
+	              "El primer punto va arriba y el segundo a la derecha, como en SFML");
+	static_assert(kPolygon<6>[1].x > 0.866025f && kPolygon<6>[1].x < 0.866026f && kPolygon<6>[1].y == -0.5f,
+	              "Serie de Taylor desajustada");
+}
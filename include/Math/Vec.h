@@ -0,0 +1,258 @@
+#pragma once
+#include <cmath>
+#include "Prerequisites.h"
+#include "Math/Mat4.h"
+#include "Math/Simd.h"
+
+/**
+ * @brief Registro de 4 floats con las operaciones que usan `Vec3`, `Vec4` y `Quat`: SSE, NEON o
+ *        cuatro floats sueltos, segn `Math/Simd.h`.
+ */
+namespace MathSimd {
+#if MATH_SSE
+	using Register = __m128;
+
+	inline Register load(const float* p) { return _mm_load_ps(p); }
+	inline void store(float* p, Register r) { _mm_store_ps(p, r); }
+	inline Register splat(float value) { return _mm_set1_ps(value); }
+	inline Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+	inline Register sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+	inline Register mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+	inline Register minimum(Register a, Register b) { return _mm_min_ps(a, b); }
+	inline Register maximum(Register a, Register b) { return _mm_max_ps(a, b); }
+
+	/**
+	 * @brief Suma de los cuatro carriles de `a * b`.
+	 */
+	inline float
+	dot(Register a, Register b) {
+		Register product = _mm_mul_ps(a, b);
+		Register swapped = _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1));
+		Register pairs = _mm_add_ps(product, swapped);
+		Register high = _mm_movehl_ps(pairs, pairs);
+		return _mm_cvtss_f32(_mm_add_ss(pairs, high));
+	}
+#elif MATH_NEON
+	using Register = float32x4_t;
+
+	inline Register load(const float* p) { return vld1q_f32(p); }
+	inline void store(float* p, Register r) { vst1q_f32(p, r); }
+	inline Register splat(float value) { return vdupq_n_f32(value); }
+	inline Register add(Register a, Register b) { return vaddq_f32(a, b); }
+	inline Register sub(Register a, Register b) { return vsubq_f32(a, b); }
+	inline Register mul(Register a, Register b) { return vmulq_f32(a, b); }
+	inline Register minimum(Register a, Register b) { return vminq_f32(a, b); }
+	inline Register maximum(Register a, Register b) { return vmaxq_f32(a, b); }
+
+	inline float
+	dot(Register a, Register b) {
+		Register product = vmulq_f32(a, b);
+		float32x2_t pairs = vadd_f32(vget_low_f32(product), vget_high_f32(product));
+		return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+	}
+#else
+	struct Register {
+		float v[4];
+	};
+
+	inline Register load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+	inline void store(float* p, Register r) { p[0] = r.v[0]; p[1] = r.v[1]; p[2] = r.v[2]; p[3] = r.v[3]; }
+	inline Register splat(float value) { return { { value, value, value, value } }; }
+	inline Register add(Register a, Register b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+	inline Register sub(Register a, Register b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+	inline Register mul(Register a, Register b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+	inline Register minimum(Register a, Register b) {
+		return { { std::fmin(a.v[0], b.v[0]), std::fmin(a.v[1], b.v[1]), std::fmin(a.v[2], b.v[2]), std::fmin(a.v[3], b.v[3]) } };
+	}
+	inline Register maximum(Register a, Register b) {
+		return { { std::fmax(a.v[0], b.v[0]), std::fmax(a.v[1], b.v[1]), std::fmax(a.v[2], b.v[2]), std::fmax(a.v[3], b.v[3]) } };
+	}
+
+	inline float
+	dot(Register a, Register b) { return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3]; }
+#endif
+}
+
+/**
+ * @brief Vector de 4 floats alineado a 16 bytes: un registro de SSE o NEON.
+ *
+ * Para puntos y direcciones en coordenadas homogneas (`w` 1 o 0) y lo que se multiplica por
+ * una `Mat4`. Las operaciones cargan, operan y guardan en un registro; en los bucles que hacen
+ * muchas, los arreglos separados de `VectorBatch` rinden ms.
+ */
+struct alignas(16) Vec4 {
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float w = 0.0f;
+
+	Vec4() = default;
+
+	Vec4(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+
+	/**
+	 * @brief Un punto del plano: z = 0, w = 1.
+	 */
+	explicit
+	Vec4(const sf::Vector2f& point) : x(point.x), y(point.y), z(0.0f), w(1.0f) {}
+
+	const float*
+	data() const { return &x; }
+
+	float*
+	data() { return &x; }
+
+	sf::Vector2f
+	toVector2() const { return sf::Vector2f(x, y); }
+
+	Vec4 operator+(const Vec4& o) const { return apply(MathSimd::add(reg(), o.reg())); }
+	Vec4 operator-(const Vec4& o) const { return apply(MathSimd::sub(reg(), o.reg())); }
+	Vec4 operator*(const Vec4& o) const { return apply(MathSimd::mul(reg(), o.reg())); }
+	Vec4 operator*(float s) const { return apply(MathSimd::mul(reg(), MathSimd::splat(s))); }
+	Vec4 operator-() const { return apply(MathSimd::sub(MathSimd::splat(0.0f), reg())); }
+	Vec4& operator+=(const Vec4& o) { return *this = *this + o; }
+	Vec4& operator-=(const Vec4& o) { return *this = *this - o; }
+	Vec4& operator*=(float s) { return *this = *this * s; }
+
+	bool operator==(const Vec4& o) const { return x == o.x && y == o.y && z == o.z && w == o.w; }
+	bool operator!=(const Vec4& o) const { return !(*this == o); }
+
+	MathSimd::Register
+	reg() const { return MathSimd::load(&x); }
+
+	static Vec4
+	apply(MathSimd::Register r) {
+		Vec4 result;
+		MathSimd::store(&result.x, r);
+		return result;
+	}
+};
+
+static_assert(sizeof(Vec4) == 16, "Vec4 debe ocupar un registro");
+
+/**
+ * @brief Vector de 3 floats en 16 bytes: el cuarto carril queda en 0 para que las operaciones
+ *        sean las de `Vec4` sin cargas ni mezclas de ms.
+ *
+ * Posiciones, direcciones y escalas del camino 3D. Se convierte con `sf::Vector2f` (z = 0) y
+ * `sf::Vector3f`.
+ */
+struct alignas(16) Vec3 {
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float pad = 0.0f;  ///< Siempre 0, para `dot` y `length` con los 4 carriles.
+
+	Vec3() = default;
+
+	Vec3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+
+	explicit
+	Vec3(const sf::Vector2f& v, float z_ = 0.0f) : x(v.x), y(v.y), z(z_) {}
+
+	explicit
+	Vec3(const sf::Vector3f& v) : x(v.x), y(v.y), z(v.z) {}
+
+	sf::Vector2f
+	toVector2() const { return sf::Vector2f(x, y); }
+
+	sf::Vector3f
+	toVector3() const { return sf::Vector3f(x, y, z); }
+
+	/**
+	 * @brief Como punto (w = 1) o como direccin (w = 0).
+	 */
+	Vec4
+	toVec4(float w) const { return Vec4(x, y, z, w); }
+
+	Vec3 operator+(const Vec3& o) const { return apply(MathSimd::add(reg(), o.reg())); }
+	Vec3 operator-(const Vec3& o) const { return apply(MathSimd::sub(reg(), o.reg())); }
+	Vec3 operator*(const Vec3& o) const { return apply(MathSimd::mul(reg(), o.reg())); }
+	Vec3 operator*(float s) const { return apply(MathSimd::mul(reg(), MathSimd::splat(s))); }
+	Vec3 operator/(float s) const { return *this * (1.0f / s); }
+	Vec3 operator-() const { return apply(MathSimd::sub(MathSimd::splat(0.0f), reg())); }
+	Vec3& operator+=(const Vec3& o) { return *this = *this + o; }
+	Vec3& operator-=(const Vec3& o) { return *this = *this - o; }
+	Vec3& operator*=(float s) { return *this = *this * s; }
+
+	bool operator==(const Vec3& o) const { return x == o.x && y == o.y && z == o.z; }
+	bool operator!=(const Vec3& o) const { return !(*this == o); }
+
+	MathSimd::Register
+	reg() const { return MathSimd::load(&x); }
+
+	/**
+	 * @brief De un registro; el cuarto carril se descarta.
+	 */
+	static Vec3
+	apply(MathSimd::Register r) {
+		alignas(16) float lanes[4];
+		MathSimd::store(lanes, r);
+		return Vec3(lanes[0], lanes[1], lanes[2]);
+	}
+};
+
+static_assert(sizeof(Vec3) == 16, "Vec3 debe ocupar un registro");
+
+inline Vec3 operator*(float s, const Vec3& v) { return v * s; }
+inline Vec4 operator*(float s, const Vec4& v) { return v * s; }
+
+inline float
+dot(const Vec3& a, const Vec3& b) { return MathSimd::dot(a.reg(), b.reg()); }
+
+inline float
+dot(const Vec4& a, const Vec4& b) { return MathSimd::dot(a.reg(), b.reg()); }
+
+inline Vec3
+cross(const Vec3& a, const Vec3& b) {
+	return Vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+inline float
+lengthSquared(const Vec3& v) { return dot(v, v); }
+
+inline float
+length(const Vec3& v) { return std::sqrt(dot(v, v)); }
+
+/**
+ * @brief `v` con largo 1; el vector nulo queda nulo.
+ */
+inline Vec3
+normalized(const Vec3& v) {
+	float squared = dot(v, v);
+	return squared > 0.0f ? v * (1.0f / std::sqrt(squared)) : v;
+}
+
+inline Vec3
+lerp(const Vec3& a, const Vec3& b, float t) { return a + (b - a) * t; }
+
+inline Vec3
+componentMin(const Vec3& a, const Vec3& b) { return Vec3::apply(MathSimd::minimum(a.reg(), b.reg())); }
+
+inline Vec3
+componentMax(const Vec3& a, const Vec3& b) { return Vec3::apply(MathSimd::maximum(a.reg(), b.reg())); }
+
+/**
+ * @brief `matrix` aplicada a `v`: las columnas pesadas por cada componente, 4 multiplicaciones-suma.
+ */
+inline Vec4
+operator*(const Mat4& matrix, const Vec4& v) {
+	using namespace MathSimd;
+	Register sum = mul(load(matrix.m), splat(v.x));
+	sum = add(sum, mul(load(matrix.m + 4), splat(v.y)));
+	sum = add(sum, mul(load(matrix.m + 8), splat(v.z)));
+	sum = add(sum, mul(load(matrix.m + 12), splat(v.w)));
+	return Vec4::apply(sum);
+}
+
+inline Vec3
+transformPoint(const Mat4& matrix, const Vec3& p) {
+	Vec4 result = matrix * p.toVec4(1.0f);
+	return Vec3(result.x, result.y, result.z);
+}
+
+inline Vec3
+transformVector(const Mat4& matrix, const Vec3& v) {
+	Vec4 result = matrix * v.toVec4(0.0f);
+	return Vec3(result.x, result.y, result.z);
+}
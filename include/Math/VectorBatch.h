@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include "Math/Mat4.h"
+
+/**
+ * @class VectorBatch
+ * @brief Operaciones de `Vec3` y `Mat4` sobre muchos vectores guardados en arreglos separados
+ *        (un arreglo de x, otro de y, otro de z), como los de `PhysicsWorld` y `seekBatch`.
+ *
+ * Con los componentes separados cada registro lleva el mismo componente de 4 vectores (8 con
+ * AVX), as que no hay mezclas entre carriles ni carriles desperdiciados como en `Vec3`. Lo que
+ * no llena un registro va por el camino escalar, con el mismo resultado. Los arreglos no
+ * necesitan alineacin; los de salida pueden ser los de entrada.
+ */
+class
+VectorBatch {
+public:
+	/**
+	 * @brief `out = matrix * (x, y, z, 1)` para cada punto; sin proyeccin (la parte afn).
+	 */
+	static void
+	transformPoints(const Mat4& matrix, const float* x, const float* y, const float* z,
+	                float* outX, float* outY, float* outZ, size_t count);
+
+	/**
+	 * @brief Como `transformPoints` en el plano z = 0, en el lugar: para los `sf::Vector2f` del
+	 *        camino 2D con una matriz de `Mat4::fromTransform`.
+	 */
+	static void
+	transformPoints2D(const Mat4& matrix, float* x, float* y, size_t count);
+
+	/**
+	 * @brief `values[i] += delta[i] * scale`: posiciones ms velocidades por el paso.
+	 */
+	static void
+	addScaled(float* values, const float* delta, float scale, size_t count);
+
+	/**
+	 * @brief Deja cada `(x, y, z)` con largo 1 y escribe el largo que tena en `lengths` (puede
+	 *        ser nulo). Los vectores nulos quedan nulos.
+	 */
+	static void
+	normalize(float* x, float* y, float* z, float* lengths, size_t count);
+
+	/**
+	 * @brief Matrices afines 2D (las de `sf::Transform`) en arreglos separados: cada una lleva
+	 *        `x' = a x + c y + tx` e `y' = b x + d y + ty`.
+	 */
+	struct Affine2DArrays {
+		float* a;
+		float* b;
+		float* c;
+		float* d;
+		float* tx;
+		float* ty;
+	};
+
+	/**
+	 * @brief `out[i] = parents[i] * locals[i]`: la matriz de mundo de cada hijo a partir de la
+	 *        de su padre, como hace `SceneGraph` por niveles. `out` no puede ser ninguna de las otras.
+	 */
+	static void
+	composeAffine2D(const Affine2DArrays& parents, const Affine2DArrays& locals, const Affine2DArrays& out, size_t count);
+};
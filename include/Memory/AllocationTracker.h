@@ -0,0 +1,186 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+#include "MemoryAccounting.h"
+
+/**
+ * @brief Activa el registro de reservas por tipo en `MakeShared`, `MakeUnique` y `TService`.
+ *
+ * Desactivado por defecto: los ganchos quedan en ramas `if constexpr` descartadas y no
+ * generan cdigo. Definir `ENGINE_TRACK_ALLOCATIONS=1` en el proyecto para activarlo.
+ */
+#ifndef ENGINE_TRACK_ALLOCATIONS
+#define ENGINE_TRACK_ALLOCATIONS 0
+#endif
+
+namespace EngineUtilities {
+
+	constexpr bool kTrackAllocations = ENGINE_TRACK_ALLOCATIONS != 0;
+
+	/**
+	 * @brief Contadores de un tipo. Hay uno por `T` registrado, con vida de programa.
+	 */
+	struct AllocationRecord
+	{
+		AllocationRecord(const char* name, size_t size, MemoryCategory memoryCategory)
+			: typeName(name), typeSize(size), category(memoryCategory) {}
+
+		void onAllocate()
+		{
+			liveCount.fetch_add(1, std::memory_order_relaxed);
+			totalAllocations.fetch_add(1, std::memory_order_relaxed);
+			frameAllocations.fetch_add(1, std::memory_order_relaxed);
+			MemoryAccounting::onAllocate(category, typeSize);
+		}
+
+		void onFree()
+		{
+			liveCount.fetch_sub(1, std::memory_order_relaxed);
+			MemoryAccounting::onFree(category, typeSize);
+		}
+
+		const char* typeName;  ///< Nombre del tipo segn `typeid`.
+		size_t typeSize;       ///< `sizeof(T)`.
+		MemoryCategory category; ///< De `memoryCategoryOf<T>`; recibe `typeSize` por objeto.
+		std::atomic<size_t> liveCount{ 0 };          ///< Objetos vivos.
+		std::atomic<size_t> totalAllocations{ 0 };   ///< Objetos creados desde el inicio.
+		std::atomic<size_t> frameAllocations{ 0 };   ///< Creados en el frame en curso.
+		std::atomic<size_t> lastFrameAllocations{ 0 }; ///< Creados en el frame anterior.
+		AllocationRecord* next = nullptr;             ///< Siguiente registro de la lista global.
+	};
+
+	/**
+	 * @brief Copia de los contadores de un tipo en un instante dado.
+	 */
+	struct AllocationStats
+	{
+		const char* typeName;
+		size_t liveCount;
+		size_t liveBytes;
+		size_t totalAllocations;
+		size_t totalBytes;
+		size_t allocationsLastFrame;
+	};
+
+	/**
+	 * @brief Registro global de reservas por tipo.
+	 *
+	 * Sirve para encontrar qu actores o componentes generan ms altas y bajas de memoria
+	 * sin un perfilador externo. Los contadores son atmicos relajados: los totales son
+	 * exactos, pero una consulta concurrente puede ver un frame a medio contar.
+	 */
+	class AllocationTracker
+	{
+	public:
+		/**
+		 * @brief Registro de `T`; se crea y enlaza la primera vez que se pide.
+		 */
+		template<typename T>
+		static AllocationRecord& recordFor()
+		{
+			static AllocationRecord* s_record = registerRecord(new AllocationRecord(typeid(T).name(), sizeof(T), memoryCategoryOf<T>()));
+			return *s_record;
+		}
+
+		/**
+		 * @brief Anota la creacin de un `T` gestionado. No hace nada si el registro est desactivado.
+		 */
+		template<typename T>
+		static void trackAllocation()
+		{
+			if constexpr (kTrackAllocations)
+			{
+				recordFor<T>().onAllocate();
+			}
+		}
+
+		/**
+		 * @brief Anota la destruccin de un `T` gestionado.
+		 */
+		template<typename T>
+		static void trackFree()
+		{
+			if constexpr (kTrackAllocations)
+			{
+				recordFor<T>().onFree();
+			}
+		}
+
+		/**
+		 * @brief Cierra el frame: las reservas del frame pasan a "frame anterior". Lo llama `BaseApp::run`.
+		 */
+		static void beginFrame()
+		{
+			if constexpr (kTrackAllocations)
+			{
+				for (AllocationRecord* record = head().load(std::memory_order_acquire); record; record = record->next)
+				{
+					record->lastFrameAllocations.store(
+						record->frameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * @brief Contadores de todos los tipos registrados, ordenados por bytes vivos.
+		 */
+		static std::vector<AllocationStats> snapshot()
+		{
+			std::vector<AllocationStats> result;
+			for (AllocationRecord* record = head().load(std::memory_order_acquire); record; record = record->next)
+			{
+				size_t live = record->liveCount.load(std::memory_order_relaxed);
+				size_t total = record->totalAllocations.load(std::memory_order_relaxed);
+				result.push_back({ record->typeName, live, live * record->typeSize, total,
+				                   total * record->typeSize,
+				                   record->lastFrameAllocations.load(std::memory_order_relaxed) });
+			}
+			std::sort(result.begin(), result.end(),
+				[](const AllocationStats& a, const AllocationStats& b) { return a.liveBytes > b.liveBytes; });
+			return result;
+		}
+
+		/**
+		 * @brief Escribe la tabla de contadores. `BaseApp::cleanup` la vuelca a `std::cerr`.
+		 */
+		static void dump(std::ostream& out)
+		{
+			if constexpr (!kTrackAllocations)
+			{
+				return;
+			}
+			out << "AllocationTracker : [live / live bytes / total / total bytes / last frame]\n";
+			for (const AllocationStats& stats : snapshot())
+			{
+				out << "  " << std::left << std::setw(40) << stats.typeName << std::right
+				    << std::setw(10) << stats.liveCount
+				    << std::setw(12) << stats.liveBytes
+				    << std::setw(12) << stats.totalAllocations
+				    << std::setw(14) << stats.totalBytes
+				    << std::setw(8) << stats.allocationsLastFrame << "\n";
+			}
+		}
+
+	private:
+		static std::atomic<AllocationRecord*>& head()
+		{
+			static std::atomic<AllocationRecord*> s_head{ nullptr };
+			return s_head;
+		}
+
+		static AllocationRecord* registerRecord(AllocationRecord* record)
+		{
+			std::atomic<AllocationRecord*>& list = head();
+			record->next = list.load(std::memory_order_relaxed);
+			while (!list.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+			return record;
+		}
+	};
+}
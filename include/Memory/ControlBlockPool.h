@@ -0,0 +1,294 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "MemoryAccounting.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Pool de bloques de tamao fijo para los bloques de control de `TSharedPointer`.
+	 *
+	 * En vez de un `new` por cada contador, los bloques salen de trozos grandes (`kBlocksPerChunk`
+	 * bloques contiguos) y se reciclan mediante listas libres:
+	 * - Cada hilo tiene una cach local sin locks; es el camino rpido de `allocate`/`deallocate`.
+	 * - Una lista global protegida por mutex recibe y entrega lotes de `kBatchSize` bloques
+	 *   cuando una cach local se llena o se vaca, y al terminar un hilo.
+	 *
+	 * La memoria nunca vuelve al sistema mientras el programa corre, lo que evita que las
+	 * altas y bajas de componentes fragmenten el heap en sesiones largas.
+	 */
+	class ControlBlockPool
+	{
+	public:
+		static constexpr size_t kBlockSize = 32;       ///< Tamao de cada bloque en bytes.
+		static constexpr size_t kBlocksPerChunk = 1024; ///< Bloques por reserva al sistema.
+		static constexpr size_t kBatchSize = 64;        ///< Bloques movidos entre cach local y global.
+
+		/**
+		 * @brief Estadsticas del pool para dimensionarlo.
+		 */
+		struct Stats
+		{
+			size_t liveBlocks;      ///< Bloques entregados y an no devueltos.
+			size_t highWaterMark;   ///< Mximo de bloques vivos a la vez.
+			size_t reservedBlocks;  ///< Bloques reservados al sistema (vivos + libres).
+		};
+
+		/**
+		 * @brief Entrega un bloque de `kBlockSize` bytes.
+		 */
+		static void* allocate()
+		{
+			Global& g = global();
+			ThreadCache* cache = threadCache();
+			FreeNode* node;
+			if (cache)
+			{
+				if (!cache->head)
+				{
+					g.refill(*cache);
+				}
+				node = cache->head;
+				cache->head = node->next;
+				--cache->count;
+			}
+			else
+			{
+				node = g.takeOne();
+			}
+
+			size_t live = g.liveBlocks.fetch_add(1, std::memory_order_relaxed) + 1;
+			size_t high = g.highWaterMark.load(std::memory_order_relaxed);
+			while (live > high && !g.highWaterMark.compare_exchange_weak(high, live, std::memory_order_relaxed))
+			{
+			}
+			return node;
+		}
+
+		/**
+		 * @brief Devuelve un bloque a la cach del hilo actual.
+		 * @param block Bloque obtenido con `allocate`.
+		 */
+		static void deallocate(void* block)
+		{
+			Global& g = global();
+			FreeNode* node = static_cast<FreeNode*>(block);
+			g.liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+
+			ThreadCache* cache = threadCache();
+			if (!cache)
+			{
+				g.putOne(node);
+				return;
+			}
+			node->next = cache->head;
+			cache->head = node;
+			++cache->count;
+			if (cache->count >= 2 * kBatchSize)
+			{
+				g.giveBack(*cache, kBatchSize);
+			}
+		}
+
+		/**
+		 * @brief Estadsticas actuales del pool.
+		 */
+		static Stats stats()
+		{
+			Global& g = global();
+			std::lock_guard<std::mutex> lock(g.mutex);
+			return { g.liveBlocks.load(std::memory_order_relaxed),
+			         g.highWaterMark.load(std::memory_order_relaxed),
+			         g.chunks.size() * kBlocksPerChunk };
+		}
+
+	private:
+		struct FreeNode
+		{
+			FreeNode* next;
+		};
+
+		/**
+		 * @brief Cach por hilo. Es trivialmente destructible para seguir siendo accesible
+		 * despus de `CacheFlusher`, cuando otros destructores del hilo an sueltan punteros.
+		 */
+		struct ThreadCache
+		{
+			FreeNode* head;
+			size_t count;
+			bool registered; ///< Ya existe el `CacheFlusher` de este hilo.
+			bool flushed;    ///< El hilo est terminando; usar la lista global.
+		};
+
+		/**
+		 * @brief Devuelve la cach del hilo a la lista global cuando el hilo termina.
+		 */
+		struct CacheFlusher
+		{
+			~CacheFlusher()
+			{
+				ThreadCache& cache = threadCacheStorage();
+				global().giveBack(cache, cache.count);
+				cache.flushed = true;
+			}
+		};
+
+		struct Global
+		{
+			std::mutex mutex;
+			FreeNode* head = nullptr;
+			std::vector<void*> chunks;
+			std::atomic<size_t> liveBlocks{ 0 };
+			std::atomic<size_t> highWaterMark{ 0 };
+
+			~Global()
+			{
+				// Solo se libera si nadie conserva bloques (p. ej. punteros estticos an vivos).
+				if (liveBlocks.load(std::memory_order_relaxed) == 0)
+				{
+					for (void* chunk : chunks)
+					{
+						::operator delete(chunk);
+					}
+				}
+			}
+
+			/**
+			 * @brief Pasa un lote de bloques libres a la cach local, reservando un trozo si hace falta.
+			 */
+			void refill(ThreadCache& cache)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!head)
+				{
+					char* chunk = static_cast<char*>(::operator new(kBlockSize * kBlocksPerChunk));
+					chunks.push_back(chunk);
+					MemoryAccounting::onAllocate(MemoryCategory::Other, kBlockSize * kBlocksPerChunk);
+					for (size_t i = 0; i < kBlocksPerChunk; ++i)
+					{
+						FreeNode* node = reinterpret_cast<FreeNode*>(chunk + i * kBlockSize);
+						node->next = head;
+						head = node;
+					}
+				}
+				for (size_t i = 0; i < kBatchSize && head; ++i)
+				{
+					FreeNode* node = head;
+					head = node->next;
+					node->next = cache.head;
+					cache.head = node;
+					++cache.count;
+				}
+			}
+
+			/**
+			 * @brief Devuelve hasta `amount` bloques de la cach local a la lista global.
+			 */
+			void giveBack(ThreadCache& cache, size_t amount)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				for (size_t i = 0; i < amount && cache.head; ++i)
+				{
+					FreeNode* node = cache.head;
+					cache.head = node->next;
+					--cache.count;
+					node->next = head;
+					head = node;
+				}
+			}
+
+			/**
+			 * @brief Camino lento sin cach local: un bloque directo de la lista global.
+			 */
+			FreeNode* takeOne()
+			{
+				ThreadCache single{ nullptr, 0, true, true };
+				refill(single);
+				FreeNode* node = single.head;
+				single.head = node->next;
+				--single.count;
+				giveBack(single, single.count);
+				return node;
+			}
+
+			/**
+			 * @brief Camino lento sin cach local: devuelve un bloque a la lista global.
+			 */
+			void putOne(FreeNode* node)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				node->next = head;
+				head = node;
+			}
+		};
+
+		static Global& global()
+		{
+			static Global s_global;
+			return s_global;
+		}
+
+		static ThreadCache& threadCacheStorage()
+		{
+			thread_local ThreadCache t_cache{ nullptr, 0, false, false };
+			return t_cache;
+		}
+
+		/**
+		 * @brief Cach del hilo actual, o `nullptr` si el hilo ya la vaci al terminar.
+		 */
+		static ThreadCache* threadCache()
+		{
+			ThreadCache& cache = threadCacheStorage();
+			if (!cache.registered)
+			{
+				thread_local CacheFlusher t_flusher;
+				(void)t_flusher;
+				cache.registered = true;
+			}
+			return cache.flushed ? nullptr : &cache;
+		}
+	};
+
+	/**
+	 * @brief Base que redirige `new`/`delete` de un bloque de control al `ControlBlockPool`.
+	 *
+	 * Los bloques que caben en `kBlockSize` salen del pool; los ms grandes (objetos grandes
+	 * alojados en lnea por `MakeShared`) siguen usando el heap normal.
+	 */
+	struct PooledControlBlockAllocation
+	{
+		static void* operator new(size_t size)
+		{
+			if (size <= ControlBlockPool::kBlockSize)
+			{
+				return ControlBlockPool::allocate();
+			}
+			return ::operator new(size);
+		}
+
+		static void operator delete(void* block, size_t size)
+		{
+			if (size <= ControlBlockPool::kBlockSize)
+			{
+				ControlBlockPool::deallocate(block);
+				return;
+			}
+			::operator delete(block);
+		}
+
+		// Los tipos sobrealineados no caben en el pool: van al heap con su alineacin.
+		static void* operator new(size_t size, std::align_val_t alignment)
+		{
+			return ::operator new(size, alignment);
+		}
+
+		static void operator delete(void* block, size_t, std::align_val_t alignment)
+		{
+			::operator delete(block, alignment);
+		}
+	};
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Cola de objetos cuya ltima referencia ya se solt pero an no se destruyeron.
+	 *
+	 * Los punteros con una poltica `TDeferredRelease<...>` no destruyen el objeto en el
+	 * momento en que el contador llega a cero (que puede ser en medio de `BaseApp::update`),
+	 * sino que lo encolan aqu. `flush()` ejecuta las destrucciones pendientes: `BaseApp::run`
+	 * la llama al final de cada frame, pero tambin puede llamarse desde un hilo de fondo
+	 * si los objetos usan conteo atmico.
+	 *
+	 * As la destruccin de escenas grandes (actores, componentes, texturas) deja de causar
+	 * picos en mitad del frame y se puede repartir con un presupuesto por frame.
+	 */
+	class DeferredReleaseQueue
+	{
+	public:
+		/**
+		 * @brief Funcin que completa la liberacin de un objeto encolado.
+		 */
+		using ReleaseFn = void (*)(const void* object);
+
+		/**
+		 * @brief Encola un objeto para destruirlo en el prximo `flush()`.
+		 */
+		static void push(const void* object, ReleaseFn release)
+		{
+			std::lock_guard<std::mutex> lock(state().mutex);
+			state().pending.push_back({ object, release });
+		}
+
+		/**
+		 * @brief Destruye los objetos pendientes.
+		 *
+		 * Los destructores se ejecutan fuera del lock, as que pueden soltar ms objetos
+		 * diferidos; esos tambin se procesan en esta llamada si caben en el presupuesto.
+		 *
+		 * @param maxReleases Mximo de objetos a destruir; el resto queda para la siguiente vez.
+		 * @return Nmero de objetos destruidos.
+		 */
+		static size_t flush(size_t maxReleases = size_t(-1))
+		{
+			size_t released = 0;
+			std::vector<Entry> batch;
+			while (released < maxReleases)
+			{
+				{
+					std::lock_guard<std::mutex> lock(state().mutex);
+					if (state().pending.empty())
+					{
+						break;
+					}
+					size_t take = state().pending.size();
+					if (take > maxReleases - released)
+					{
+						take = maxReleases - released;
+					}
+					auto first = state().pending.end() - static_cast<std::ptrdiff_t>(take);
+					batch.assign(first, state().pending.end());
+					state().pending.erase(first, state().pending.end());
+				}
+				for (const Entry& entry : batch)
+				{
+					entry.release(entry.object);
+				}
+				released += batch.size();
+				batch.clear();
+			}
+			return released;
+		}
+
+		/**
+		 * @brief Nmero de objetos esperando destruccin.
+		 */
+		static size_t pendingCount()
+		{
+			std::lock_guard<std::mutex> lock(state().mutex);
+			return state().pending.size();
+		}
+
+	private:
+		struct Entry
+		{
+			const void* object;
+			ReleaseFn release;
+		};
+
+		struct State
+		{
+			std::mutex mutex;
+			std::vector<Entry> pending;
+		};
+
+		static State& state()
+		{
+			static State s_state;
+			return s_state;
+		}
+	};
+}
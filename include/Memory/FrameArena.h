@@ -0,0 +1,61 @@
+#pragma once
+#include "LinearArena.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Par de arenas lineales alternadas por frame.
+	 *
+	 * `beginFrame()` se llama al inicio de cada vuelta del bucle principal: cambia a la otra
+	 * arena y la reinicia. Lo reservado en el frame N sigue siendo vlido durante el frame
+	 * N + 1 (`previous()`), lo que permite que el hilo de render consuma los datos de un frame
+	 * mientras la lgica ya prepara el siguiente.
+	 */
+	class FrameArena
+	{
+	public:
+		/**
+		 * @param capacityPerFrame Capacidad inicial de cada una de las dos arenas.
+		 * @param category Subsistema al que se cargan las dos.
+		 */
+		explicit FrameArena(size_t capacityPerFrame = LinearArena::kDefaultCapacity,
+		                    MemoryCategory category = MemoryCategory::Other)
+			: m_arenas{ LinearArena(capacityPerFrame, category), LinearArena(capacityPerFrame, category) } {}
+
+		/**
+		 * @brief Empieza un frame: la arena de hace dos frames se reinicia y pasa a ser la actual.
+		 */
+		void beginFrame()
+		{
+			m_current ^= 1;
+			m_arenas[m_current].reset();
+			++m_frameIndex;
+		}
+
+		/**
+		 * @brief Arena del frame en curso.
+		 */
+		LinearArena& current() { return m_arenas[m_current]; }
+
+		/**
+		 * @brief Arena del frame anterior; sus datos siguen vivos hasta el prximo `beginFrame()`.
+		 */
+		LinearArena& previous() { return m_arenas[m_current ^ 1]; }
+
+		/**
+		 * @brief Adaptador STL sobre la arena del frame en curso.
+		 */
+		template<typename T>
+		TArenaAllocator<T> allocator() { return TArenaAllocator<T>(current()); }
+
+		/**
+		 * @brief Nmero de frames iniciados.
+		 */
+		uint64_t frameIndex() const { return m_frameIndex; }
+
+	private:
+		LinearArena m_arenas[2]; ///< Arenas alternadas.
+		int m_current = 0;       ///< ndice de la arena actual.
+		uint64_t m_frameIndex = 0;
+	};
+}
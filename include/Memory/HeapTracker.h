@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Reemplaza los `operator new` y `operator delete` globales por unos que cuentan cada
+ *        reserva del heap por frame y por hilo.
+ *
+ * Desactivado por defecto: sin la bandera no hay reemplazo y `HeapTracker` no cuenta nada.
+ * Con `ENGINE_HEAP_HOOKS=1` cada reserva cuesta un par de atmicos relajados del hilo que la
+ * hace, adems de `malloc`; con la captura de pilas encendida, tambin un recorrido de pila.
+ */
+#ifndef ENGINE_HEAP_HOOKS
+#define ENGINE_HEAP_HOOKS 0
+#endif
+
+namespace EngineUtilities {
+
+	constexpr bool kHeapHooks = ENGINE_HEAP_HOOKS != 0;
+
+	/**
+	 * @brief Reservas de un hilo en un frame.
+	 */
+	struct HeapThreadFrame
+	{
+		const char* name = "";      ///< De `HeapTracker::setThreadName`; vive con el programa.
+		size_t allocations = 0;
+		size_t bytes = 0;
+		size_t frees = 0;
+	};
+
+	/**
+	 * @brief Reservas de todos los hilos en un frame.
+	 */
+	struct HeapFrame
+	{
+		size_t allocations = 0;
+		size_t bytes = 0;
+		size_t frees = 0;
+		uint32_t worstThread = 0;   ///< El que ms reserv; ndice de `HeapTracker::lastThread`.
+	};
+
+	/**
+	 * @class HeapTracker
+	 * @brief Cuntas reservas del heap hay por frame y quin las hace, para llegar a cero en el
+	 *        frame estable.
+	 *
+	 * Cada hilo cuenta en su propia ranura (hasta `kMaxThreads`; los que sobran comparten la
+	 * ltima), sin candados. `beginFrame`, al inicio de cada frame de `BaseApp::run`, pasa lo
+	 * contado a `lastFrame`. Cuando la aplicacin ya lleg al rgimen estable (`setSteady`),
+	 * `BaseApp` avisa si un frame reserv algo, y con `setStackCapture` cada reserva guarda su
+	 * pila en una tabla de `kMaxStackSites` lugares; `dump` escribe los que ms reservaron.
+	 *
+	 * `Scope` deja de contar en el hilo actual mientras vive: lo usan el propio reporte y lo
+	 * que no es del frame (escribir un archivo de resultados, por ejemplo).
+	 */
+	class HeapTracker
+	{
+	public:
+		static constexpr uint32_t kMaxThreads = 64;
+		static constexpr size_t kMaxStackDepth = 16;
+		static constexpr size_t kMaxStackSites = 512;
+		static constexpr size_t kNameLength = 32;
+
+		/**
+		 * @brief Mientras vive, las reservas del hilo actual no se cuentan.
+		 */
+		class Scope
+		{
+		public:
+			Scope();
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		};
+
+		/**
+		 * @brief Anota una reserva de `bytes`; la llaman los `operator new` reemplazados.
+		 */
+		static void onAllocate(size_t bytes);
+
+		static void onFree();
+
+		/**
+		 * @brief Cierra el frame: lo de cada hilo pasa a `lastFrame` y `lastThread`.
+		 */
+		static void beginFrame();
+
+		static HeapFrame lastFrame();
+
+		/**
+		 * @brief Lo del hilo `index` en el ltimo frame cerrado.
+		 */
+		static HeapThreadFrame lastThread(uint32_t index);
+
+		/**
+		 * @brief Hilos que reservaron algo desde el inicio.
+		 */
+		static uint32_t threadCount();
+
+		/**
+		 * @brief Nombre del hilo actual en los reportes; se copia (`kNameLength` como mucho).
+		 */
+		static void setThreadName(const char* name);
+
+		/**
+		 * @brief Con `true`, el frame ya debera no reservar; solo entonces se capturan pilas.
+		 */
+		static void setSteady(bool steady);
+
+		static bool isSteady();
+
+		/**
+		 * @brief Guarda la pila de cada reserva del rgimen estable.
+		 * @return `false` si esta plataforma no sabe recorrer la pila.
+		 */
+		static bool setStackCapture(bool enabled);
+
+		/**
+		 * @brief Totales desde el inicio y, si hubo captura, los `top` lugares que ms reservaron.
+		 */
+		static void dump(std::ostream& out, size_t top = 10);
+	};
+}
@@ -0,0 +1,237 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Activa el registro de vida de cada objeto creado con `MakeShared` o `MakeUnique`.
+ *
+ * Pensado para builds de depuracin y pruebas de carga: cada creacin anota tipo, direccin,
+ * sitio de la llamada y frame en un anillo sin bloqueos; cada destruccin borra su entrada.
+ * Al cerrar, `LifetimeTracker::reportLive` lista lo que sigue vivo. Desactivado, no genera cdigo.
+ */
+#ifndef ENGINE_TRACK_LIFETIMES
+#define ENGINE_TRACK_LIFETIMES 0
+#endif
+
+/**
+ * @brief Entradas del anillo (potencia de dos). Si hay ms objetos vivos que entradas,
+ *        los ms antiguos se pierden del informe y se cuentan aparte.
+ */
+#ifndef ENGINE_LIFETIME_RING_SIZE
+#define ENGINE_LIFETIME_RING_SIZE 65536
+#endif
+
+#if defined(_MSC_VER)
+#define ENGINE_NOINLINE __declspec(noinline)
+#define ENGINE_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define ENGINE_NOINLINE __attribute__((noinline))
+#define ENGINE_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+namespace EngineUtilities {
+
+	constexpr bool kTrackLifetimes = ENGINE_TRACK_LIFETIMES != 0;
+
+	/**
+	 * @brief Identifica la entrada de un objeto en el anillo; 0 = sin registrar.
+	 */
+	using LifetimeTicket = uint32_t;
+
+	/**
+	 * @brief Objeto vivo segn el anillo.
+	 */
+	struct LiveObject
+	{
+		const char* typeName; ///< Nombre del tipo segn `typeid`.
+		size_t typeSize;      ///< `sizeof(T)`.
+		const void* object;   ///< Direccin del objeto.
+		const void* site;     ///< Direccin de retorno dentro de quien llam a `MakeShared`/`MakeUnique`.
+		uint64_t frame;       ///< Frame en que se cre.
+		LifetimeTicket ticket;
+	};
+
+	/**
+	 * @brief Registro de vida de objetos gestionados, para encontrar fugas sin sanitizadores.
+	 *
+	 * Crear cuesta un `fetch_add` y unas cuantas escrituras; destruir, un compare-and-swap.
+	 * Nada reserva memoria ni toma un mutex, as que puede quedar activo en pruebas de carga.
+	 *
+	 * El sitio se guarda como direccin de retorno: en builds optimizadas `MakeShared` se
+	 * expande en quien lo llama y la direccin cae en esa funcin (se resuelve con el
+	 * depurador o `addr2line`). Sin optimizar apunta a `MakeShared<T>`; el tipo sigue siendo exacto.
+	 */
+	class LifetimeTracker
+	{
+	public:
+		static constexpr size_t kRingSize = ENGINE_LIFETIME_RING_SIZE;
+
+		static_assert((kRingSize & (kRingSize - 1)) == 0, "ENGINE_LIFETIME_RING_SIZE debe ser potencia de dos");
+
+		/**
+		 * @brief Anota la creacin de `object`. Las funciones de creacin la llaman directamente
+		 *        para que la direccin de retorno sea la de quien las us.
+		 * @return Ticket a entregar a `onDestroy`.
+		 */
+		template<typename T>
+		ENGINE_NOINLINE static LifetimeTicket onCreate(const T* object)
+		{
+			return record(object, typeid(T).name(), sizeof(T), ENGINE_RETURN_ADDRESS());
+		}
+
+		/**
+		 * @brief Borra la entrada del ticket. Si el anillo ya la reutiliz, no hace nada.
+		 */
+		static void onDestroy(LifetimeTicket ticket)
+		{
+			if (ticket == 0)
+			{
+				return;
+			}
+			LifetimeTicket expected = ticket;
+			ring()[ticket & (kRingSize - 1)].ticket.compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Avanza el nmero de frame que se guarda con cada creacin. Lo llama `BaseApp::run`.
+		 */
+		static void beginFrame()
+		{
+			if constexpr (kTrackLifetimes)
+			{
+				frameCounter().fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * @brief Objetos vivos en orden de creacin.
+		 */
+		static std::vector<LiveObject> liveObjects()
+		{
+			std::vector<LiveObject> result;
+			if constexpr (kTrackLifetimes)
+			{
+				for (Entry& entry : ring())
+				{
+					LifetimeTicket ticket = entry.ticket.load(std::memory_order_acquire);
+					if (ticket != 0)
+					{
+						result.push_back({ entry.typeName.load(std::memory_order_relaxed),
+						                   entry.typeSize.load(std::memory_order_relaxed),
+						                   entry.object.load(std::memory_order_relaxed),
+						                   entry.site.load(std::memory_order_relaxed),
+						                   entry.frame.load(std::memory_order_relaxed), ticket });
+					}
+				}
+				std::sort(result.begin(), result.end(),
+					[](const LiveObject& a, const LiveObject& b) { return a.ticket < b.ticket; });
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Entradas vivas que el anillo sobrescribi por falta de espacio.
+		 */
+		static size_t overwrittenCount() { return overwritten().load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Escribe los objetos que siguen vivos. `BaseApp::cleanup` lo llama al final,
+		 *        cuando ya no debera quedar ninguno.
+		 * @return Nmero de objetos vivos.
+		 */
+		static size_t reportLive(std::ostream& out, size_t maxListed = 64)
+		{
+			if constexpr (!kTrackLifetimes)
+			{
+				return 0;
+			}
+			std::vector<LiveObject> live = liveObjects();
+			out << "LifetimeTracker : " << live.size() << " objects still alive at shutdown\n";
+			for (size_t i = 0; i < live.size() && i < maxListed; ++i)
+			{
+				const LiveObject& object = live[i];
+				out << "  " << object.typeName << " (" << object.typeSize << " bytes) at " << object.object
+				    << ", created at " << object.site << " in frame " << object.frame << "\n";
+			}
+			if (live.size() > maxListed)
+			{
+				out << "  ... " << live.size() - maxListed << " more\n";
+			}
+			if (size_t lost = overwrittenCount())
+			{
+				out << "  " << lost << " live entries were overwritten; raise ENGINE_LIFETIME_RING_SIZE\n";
+			}
+			return live.size();
+		}
+
+	private:
+		/**
+		 * @brief Entrada del anillo. Los campos son atmicos relajados porque dos hilos pueden
+		 *        caer en la misma entrada cuando el anillo da la vuelta; en x86 cuestan lo mismo.
+		 */
+		struct Entry
+		{
+			std::atomic<LifetimeTicket> ticket{ 0 }; ///< Ticket del objeto vivo, o 0 si est libre.
+			std::atomic<const char*> typeName{ nullptr };
+			std::atomic<size_t> typeSize{ 0 };
+			std::atomic<const void*> object{ nullptr };
+			std::atomic<const void*> site{ nullptr };
+			std::atomic<uint64_t> frame{ 0 };
+		};
+
+		static LifetimeTicket record(const void* object, const char* typeName, size_t typeSize, const void* site)
+		{
+			LifetimeTicket ticket = cursor().fetch_add(1, std::memory_order_relaxed);
+			if (ticket == 0)
+			{
+				ticket = cursor().fetch_add(1, std::memory_order_relaxed); // El contador dio la vuelta
+			}
+
+			Entry& entry = ring()[ticket & (kRingSize - 1)];
+			if (entry.ticket.load(std::memory_order_relaxed) != 0)
+			{
+				overwritten().fetch_add(1, std::memory_order_relaxed);
+			}
+			entry.typeName.store(typeName, std::memory_order_relaxed);
+			entry.typeSize.store(typeSize, std::memory_order_relaxed);
+			entry.object.store(object, std::memory_order_relaxed);
+			entry.site.store(site, std::memory_order_relaxed);
+			entry.frame.store(frameCounter().load(std::memory_order_relaxed), std::memory_order_relaxed);
+			entry.ticket.store(ticket, std::memory_order_release);
+			return ticket;
+		}
+
+		static Entry (&ring())[kRingSize]
+		{
+			static Entry s_ring[kRingSize];
+			return s_ring;
+		}
+
+		static std::atomic<LifetimeTicket>& cursor()
+		{
+			static std::atomic<LifetimeTicket> s_cursor{ 1 };
+			return s_cursor;
+		}
+
+		static std::atomic<uint64_t>& frameCounter()
+		{
+			static std::atomic<uint64_t> s_frame{ 0 };
+			return s_frame;
+		}
+
+		static std::atomic<size_t>& overwritten()
+		{
+			static std::atomic<size_t> s_overwritten{ 0 };
+			return s_overwritten;
+		}
+	};
+}
@@ -0,0 +1,234 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MemoryAccounting.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Asignador lineal ("bump allocator") para datos temporales.
+	 *
+	 * Reservar es avanzar un desplazamiento dentro de un bloque contiguo; no existe liberacin
+	 * individual: `reset()` devuelve toda la memoria de golpe. Est pensado para datos que
+	 * viven un frame (vectores temporales, claves de ordenamiento, listas de comandos).
+	 *
+	 * Si un frame pide ms de la capacidad, el exceso se sirve desde bloques de desborde en
+	 * el heap y, en el siguiente `reset()`, el bloque principal crece para cubrir el pico. As
+	 * la arena nunca falla y tras unos frames deja de tocar el heap.
+	 *
+	 * `reset()` no ejecuta destructores: solo deben alojarse tipos trivialmente destructibles
+	 * o contenedores cuyo destructor ya se haya ejecutado antes del reinicio.
+	 *
+	 * No es segura entre hilos; cada arena la usa un solo hilo a la vez. Sus bloques se cargan a
+	 * la `MemoryCategory` del constructor.
+	 */
+	class LinearArena
+	{
+	public:
+		static constexpr size_t kDefaultCapacity = 256 * 1024; ///< Capacidad inicial en bytes.
+		static constexpr size_t kBufferAlignment = 64;         ///< Alineacin del bloque principal.
+
+		/**
+		 * @brief Crea la arena con un bloque principal de `capacity` bytes.
+		 * @param capacity Capacidad inicial del bloque principal.
+		 * @param category Subsistema al que se carga lo reservado.
+		 */
+		explicit LinearArena(size_t capacity = kDefaultCapacity, MemoryCategory category = MemoryCategory::Other)
+			: m_category(category), m_buffer(allocateBuffer(capacity)), m_capacity(capacity) {}
+
+		~LinearArena()
+		{
+			releaseOverflow();
+			freeBuffer(m_buffer);
+		}
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		/**
+		 * @brief Reserva `size` bytes alineados a `alignment` (potencia de dos).
+		 * @return Puntero a la memoria; vlido hasta el prximo `reset()`.
+		 */
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer);
+			uintptr_t aligned = (base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+			size_t end = static_cast<size_t>(aligned - base) + size;
+			if (end <= m_capacity)
+			{
+				m_offset = end;
+				return reinterpret_cast<void*>(aligned);
+			}
+			return allocateOverflow(size, alignment);
+		}
+
+		/**
+		 * @brief Construye un `T` dentro de la arena.
+		 *
+		 * Solo admite tipos trivialmente destructibles, ya que `reset()` no llama destructores.
+		 */
+		template<typename T, typename... Args>
+		T* create(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>,
+				"LinearArena::create: reset() no ejecuta destructores");
+			return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Libera todo lo reservado desde el ltimo reinicio.
+		 *
+		 * Si hubo desborde, el bloque principal crece hasta la siguiente potencia de dos que
+		 * cubra el pico de uso, para que los siguientes frames no vuelvan a desbordar.
+		 */
+		void reset()
+		{
+			size_t peak = m_offset + m_overflowBytes;
+			if (peak > m_highWaterMark)
+			{
+				m_highWaterMark = peak;
+			}
+			if (m_overflowBytes > 0)
+			{
+				releaseOverflow();
+				size_t newCapacity = m_capacity;
+				while (newCapacity < peak)
+				{
+					newCapacity *= 2;
+				}
+				freeBuffer(m_buffer);
+				m_buffer = allocateBuffer(newCapacity);
+				m_capacity = newCapacity;
+			}
+			m_offset = 0;
+		}
+
+		/**
+		 * @brief Bytes ocupados desde el ltimo reinicio (incluido el desborde).
+		 */
+		size_t used() const { return m_offset + m_overflowBytes; }
+
+		/**
+		 * @brief Capacidad actual del bloque principal.
+		 */
+		size_t capacity() const { return m_capacity; }
+
+		/**
+		 * @brief Mximo de bytes usado entre dos reinicios.
+		 */
+		size_t highWaterMark() const { return m_highWaterMark; }
+
+	private:
+		unsigned char* allocateBuffer(size_t capacity)
+		{
+			unsigned char* buffer = static_cast<unsigned char*>(::operator new(capacity, std::align_val_t(kBufferAlignment)));
+			MemoryAccounting::onAllocate(m_category, capacity, buffer);
+			return buffer;
+		}
+
+		/**
+		 * @brief Libera el bloque principal de `m_capacity` bytes.
+		 */
+		void freeBuffer(unsigned char* buffer)
+		{
+			MemoryAccounting::onFree(m_category, m_capacity, buffer);
+			::operator delete(buffer, std::align_val_t(kBufferAlignment));
+		}
+
+		void* allocateOverflow(size_t size, size_t alignment)
+		{
+			unsigned char* block = static_cast<unsigned char*>(::operator new(size + alignment));
+			m_overflow.push_back({ block, size + alignment });
+			m_overflowBytes += size;
+			MemoryAccounting::onAllocate(m_category, size + alignment, block);
+			uintptr_t aligned = (reinterpret_cast<uintptr_t>(block) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		void releaseOverflow()
+		{
+			for (const OverflowBlock& overflow : m_overflow)
+			{
+				MemoryAccounting::onFree(m_category, overflow.bytes, overflow.block);
+				::operator delete(overflow.block);
+			}
+			m_overflow.clear();
+			m_overflowBytes = 0;
+		}
+
+		struct OverflowBlock
+		{
+			unsigned char* block;
+			size_t bytes;
+		};
+
+		MemoryCategory m_category;               ///< A quin se cargan los bloques.
+		unsigned char* m_buffer;                 ///< Bloque principal.
+		size_t m_capacity;                       ///< Tamao del bloque principal.
+		size_t m_offset = 0;                     ///< Siguiente byte libre del bloque principal.
+		std::vector<OverflowBlock> m_overflow;   ///< Bloques de desborde del frame actual.
+		size_t m_overflowBytes = 0;              ///< Bytes servidos desde el desborde.
+		size_t m_highWaterMark = 0;              ///< Pico de uso observado.
+	};
+
+	/**
+	 * @brief Adaptador compatible con la STL que reserva desde una `LinearArena`.
+	 *
+	 * `deallocate` no hace nada: la memoria vuelve con el `reset()` de la arena. El contenedor
+	 * debe destruirse (o dejar de usarse) antes de ese reinicio.
+	 *
+	 * @tparam T Tipo de elemento.
+	 */
+	template<typename T>
+	class TArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		explicit TArenaAllocator(LinearArena& arena) noexcept : m_arena(&arena) {}
+
+		template<typename U>
+		TArenaAllocator(const TArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+		T* allocate(size_t count)
+		{
+			if (count > size_t(-1) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+			return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t) noexcept {}
+
+		/**
+		 * @brief Arena de la que sale la memoria.
+		 */
+		LinearArena* arena() const noexcept { return m_arena; }
+
+	private:
+		LinearArena* m_arena; ///< Arena de origen.
+	};
+
+	template<typename T, typename U>
+	bool operator==(const TArenaAllocator<T>& a, const TArenaAllocator<U>& b) noexcept
+	{
+		return a.arena() == b.arena();
+	}
+
+	template<typename T, typename U>
+	bool operator!=(const TArenaAllocator<T>& a, const TArenaAllocator<U>& b) noexcept
+	{
+		return a.arena() != b.arena();
+	}
+
+	/**
+	 * @brief `std::vector` cuyos elementos viven en una `LinearArena`.
+	 */
+	template<typename T>
+	using TArenaVector = std::vector<T, TArenaAllocator<T>>;
+}
@@ -0,0 +1,267 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <ostream>
+#include <vector>
+#include "Profiling/TracyBridge.h"
+
+/**
+ * @brief Activa la cuenta de memoria por subsistema de arenas, pools y contenedores marcados.
+ *
+ * Activada por defecto: se anota por bloque reservado, no por objeto, as que cuesta un par
+ * de atmicos relajados cuando una arena crece o un pool pide otro trozo. Lo que sale de
+ * `MakeShared`, `MakeUnique` y `TService` se suma adems solo con `ENGINE_TRACK_ALLOCATIONS`.
+ */
+#ifndef ENGINE_MEMORY_ACCOUNTING
+#define ENGINE_MEMORY_ACCOUNTING 1
+#endif
+
+namespace EngineUtilities {
+
+	constexpr bool kMemoryAccounting = ENGINE_MEMORY_ACCOUNTING != 0;
+
+	/**
+	 * @brief Subsistema al que se le carga una reserva.
+	 */
+	enum class MemoryCategory : uint8_t
+	{
+		Ecs,        ///< Entidades, componentes y sus pools, comandos diferidos.
+		Render,     ///< Listas de dibujo, lotes y memoria temporal del frame.
+		Audio,      ///< Muestras de sonido cargadas.
+		Assets,     ///< Texturas subidas y lo ledo de paquetes.
+		Network,    ///< Bferes de mensajes.
+		Scripting,
+		Other,      ///< Lo que no dijo a quin pertenece.
+		Count
+	};
+
+	constexpr size_t kMemoryCategoryCount = static_cast<size_t>(MemoryCategory::Count);
+
+	/**
+	 * @brief Categora de `T`: la de su `static constexpr MemoryCategory kMemoryCategory` (que
+	 *        se hereda, as que `Component` cubre a todos los componentes), u `Other`.
+	 */
+	template<typename T>
+	constexpr MemoryCategory memoryCategoryOf()
+	{
+		if constexpr (requires { { T::kMemoryCategory } -> std::convertible_to<MemoryCategory>; })
+		{
+			return T::kMemoryCategory;
+		}
+		else
+		{
+			return MemoryCategory::Other;
+		}
+	}
+
+	/**
+	 * @brief Copia de lo de una categora en un instante dado.
+	 */
+	struct MemoryUsage
+	{
+		MemoryCategory category = MemoryCategory::Other;
+		size_t currentBytes = 0;
+		size_t peakBytes = 0;       ///< Desde el inicio.
+		size_t allocations = 0;     ///< Reservas anotadas desde el inicio.
+		size_t budgetBytes = 0;     ///< 0 sin presupuesto.
+
+		bool overBudget() const { return budgetBytes != 0 && peakBytes > budgetBytes; }
+	};
+
+	/**
+	 * @brief Bytes vivos y pico de cada `MemoryCategory`, desde cualquier hilo.
+	 *
+	 * Quien reserva dice de qu categora es (`LinearArena`, `NetBufferPool`, `TAccountedAllocator`,
+	 * el tipo en `AllocationTracker`). El overlay muestra lo actual y el pico de cada una contra su
+	 * presupuesto (`setBudget`), y `BaseApp::cleanup` escribe la tabla al cerrar. Los contadores
+	 * son atmicos relajados: el pico puede perder una carrera de unos bytes, nunca un bloque.
+	 */
+	class MemoryAccounting
+	{
+	public:
+		/**
+		 * @param pointer Con `ENGINE_TRACY`, la reserva tambin va a Tracy, en el grupo de `category`;
+		 *        nulo si no es un bloque propio (lo de SFML, por ejemplo).
+		 */
+		static void onAllocate(MemoryCategory category, size_t bytes, const void* pointer = nullptr)
+		{
+			if (pointer)
+			{
+				ENGINE_TRACY_ALLOC(pointer, bytes, name(category));
+			}
+			if constexpr (kMemoryAccounting)
+			{
+				Counters& counters = countersOf(category);
+				size_t current = counters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+				counters.allocations.fetch_add(1, std::memory_order_relaxed);
+				size_t peak = counters.peak.load(std::memory_order_relaxed);
+				while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+				{
+				}
+			}
+		}
+
+		static void onFree(MemoryCategory category, size_t bytes, const void* pointer = nullptr)
+		{
+			if (pointer)
+			{
+				ENGINE_TRACY_FREE(pointer, name(category));
+			}
+			if constexpr (kMemoryAccounting)
+			{
+				countersOf(category).current.fetch_sub(bytes, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * @brief Presupuesto de `category` para esta plataforma; 0 lo quita.
+		 */
+		static void setBudget(MemoryCategory category, size_t bytes)
+		{
+			countersOf(category).budget.store(bytes, std::memory_order_relaxed);
+		}
+
+		static MemoryUsage usage(MemoryCategory category)
+		{
+			Counters& counters = countersOf(category);
+			return { category, counters.current.load(std::memory_order_relaxed), counters.peak.load(std::memory_order_relaxed),
+			         counters.allocations.load(std::memory_order_relaxed), counters.budget.load(std::memory_order_relaxed) };
+		}
+
+		static std::array<MemoryUsage, kMemoryCategoryCount> snapshot()
+		{
+			std::array<MemoryUsage, kMemoryCategoryCount> result;
+			for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+			{
+				result[i] = usage(static_cast<MemoryCategory>(i));
+			}
+			return result;
+		}
+
+		static const char* name(MemoryCategory category)
+		{
+			static constexpr const char* kNames[kMemoryCategoryCount] = { "ecs", "render", "audio", "assets", "network",
+			                                                              "scripting", "other" };
+			return kNames[static_cast<size_t>(category)];
+		}
+
+		/**
+		 * @brief Categora por su `name`.
+		 * @return `false` si no hay una con ese nombre.
+		 */
+		static bool parse(const char* text, size_t length, MemoryCategory& out)
+		{
+			for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+			{
+				const char* candidate = name(static_cast<MemoryCategory>(i));
+				size_t at = 0;
+				while (at < length && candidate[at] == text[at])
+				{
+					++at;
+				}
+				if (at == length && candidate[at] == '\0')
+				{
+					out = static_cast<MemoryCategory>(i);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Escribe la tabla en MiB; marca con `!` lo que pas su presupuesto.
+		 */
+		static void dump(std::ostream& out)
+		{
+			if constexpr (!kMemoryAccounting)
+			{
+				return;
+			}
+			out << "MemoryAccounting : [current / peak / budget MiB, allocations]\n";
+			char line[128];
+			for (const MemoryUsage& usage : snapshot())
+			{
+				std::snprintf(line, sizeof(line), "  %-10s %10.2f %10.2f %10.2f %12zu%s\n", name(usage.category),
+				              usage.currentBytes / 1048576.0, usage.peakBytes / 1048576.0, usage.budgetBytes / 1048576.0,
+				              usage.allocations, usage.overBudget() ? "  !" : "");
+				out << line;
+			}
+		}
+
+	private:
+		struct Counters
+		{
+			alignas(64) std::atomic<size_t> current{ 0 };   ///< Una lnea por categora: no se pisan entre subsistemas.
+			std::atomic<size_t> peak{ 0 };
+			std::atomic<size_t> allocations{ 0 };
+			std::atomic<size_t> budget{ 0 };
+		};
+
+		static Counters& countersOf(MemoryCategory category)
+		{
+			static Counters s_counters[kMemoryCategoryCount];
+			return s_counters[static_cast<size_t>(category)];
+		}
+	};
+
+	/**
+	 * @brief Adaptador de la STL sobre el heap que carga lo que reserva a `Category`.
+	 *
+	 * Para los contenedores grandes de un subsistema (`ComponentPool`, por ejemplo); solo cambia
+	 * el tipo del contenedor, no cmo se usa.
+	 */
+	template<typename T, MemoryCategory Category>
+	class TAccountedAllocator
+	{
+	public:
+		using value_type = T;
+
+		template<typename U>
+		struct rebind { using other = TAccountedAllocator<U, Category>; };
+
+		TAccountedAllocator() noexcept = default;
+
+		template<typename U>
+		TAccountedAllocator(const TAccountedAllocator<U, Category>&) noexcept {}
+
+		T* allocate(size_t count)
+		{
+			if (count > size_t(-1) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+			T* items = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+			MemoryAccounting::onAllocate(Category, count * sizeof(T), items);
+			return items;
+		}
+
+		void deallocate(T* items, size_t count) noexcept
+		{
+			MemoryAccounting::onFree(Category, count * sizeof(T), items);
+			::operator delete(items, std::align_val_t(alignof(T)));
+		}
+	};
+
+	template<typename T, typename U, MemoryCategory Category>
+	bool operator==(const TAccountedAllocator<T, Category>&, const TAccountedAllocator<U, Category>&) noexcept
+	{
+		return true;
+	}
+
+	template<typename T, typename U, MemoryCategory Category>
+	bool operator!=(const TAccountedAllocator<T, Category>&, const TAccountedAllocator<U, Category>&) noexcept
+	{
+		return false;
+	}
+
+	/**
+	 * @brief `std::vector` cuya memoria se carga a `Category`.
+	 */
+	template<typename T, MemoryCategory Category>
+	using TAccountedVector = std::vector<T, TAccountedAllocator<T, Category>>;
+}
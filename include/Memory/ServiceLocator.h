@@ -0,0 +1,158 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "AllocationTracker.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Registro global de servicios (renderer, audio, cach de assets, sistema de tareas...).
+	 *
+	 * Cada servicio se guarda en su `TService<T>`; este registro solo conoce el orden en que
+	 * se crearon para destruirlos en orden inverso con `shutdownAll()`. As un servicio que
+	 * usa a otro durante su creacin (p. ej. el cach de assets que usa el sistema de tareas)
+	 * se destruye antes que su dependencia.
+	 */
+	class ServiceLocator
+	{
+	public:
+		/**
+		 * @brief Destruye todos los servicios, del ltimo creado al primero.
+		 *
+		 * Lo llama `BaseApp::cleanup`. Despus de esto los servicios pueden volver a crearse.
+		 */
+		static void shutdownAll()
+		{
+			for (;;)
+			{
+				void (*teardown)() = nullptr;
+				{
+					std::lock_guard<std::recursive_mutex> lock(mutex());
+					if (teardowns().empty())
+					{
+						return;
+					}
+					teardown = teardowns().back();
+					teardowns().pop_back();
+				}
+				// Fuera del lock: el destructor de un servicio puede consultar a otros.
+				teardown();
+			}
+		}
+
+	private:
+		template<typename T>
+		friend class TService;
+
+		/**
+		 * @brief Recursivo: el constructor de un servicio puede pedir otros servicios.
+		 */
+		static std::recursive_mutex& mutex()
+		{
+			static std::recursive_mutex s_mutex;
+			return s_mutex;
+		}
+
+		static std::vector<void (*)()>& teardowns()
+		{
+			static std::vector<void (*)()> s_teardowns;
+			return s_teardowns;
+		}
+	};
+
+	/**
+	 * @brief Punto de acceso a la instancia nica de un servicio `T`.
+	 *
+	 * Sustituye a `TStaticPtr`: la creacin est protegida, de modo que subsistemas que
+	 * arrancan desde hilos de trabajo no compiten al iniciarse, y una vez creado el
+	 * servicio `get()` es una nica lectura atmica sin locks.
+	 *
+	 * @tparam T Tipo del servicio.
+	 */
+	template<typename T>
+	class TService
+	{
+	public:
+		/**
+		 * @brief Instancia actual, o `nullptr` si an no existe. Camino rpido: una sola lectura.
+		 */
+		static T* get()
+		{
+			return s_instance.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Instancia del servicio, crendola con `args` si an no existe.
+		 *
+		 * Si varios hilos llegan a la vez, solo uno construye el servicio; el resto recibe esa
+		 * misma instancia y sus argumentos se descartan.
+		 */
+		template<typename... Args>
+		static T& instance(Args&&... args)
+		{
+			if (T* existing = s_instance.load(std::memory_order_acquire))
+			{
+				return *existing;
+			}
+			return create(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Indica si el servicio ya fue creado.
+		 */
+		static bool isAvailable()
+		{
+			return get() != nullptr;
+		}
+
+		/**
+		 * @brief Destruye el servicio ahora, sin esperar a `ServiceLocator::shutdownAll()`.
+		 *
+		 * Quien lo llame debe garantizar que ningn otro hilo lo est usando.
+		 */
+		static void shutdown()
+		{
+			std::lock_guard<std::recursive_mutex> lock(ServiceLocator::mutex());
+			std::vector<void (*)()>& teardowns = ServiceLocator::teardowns();
+			for (auto it = teardowns.begin(); it != teardowns.end(); ++it)
+			{
+				if (*it == &destroy)
+				{
+					teardowns.erase(it);
+					break;
+				}
+			}
+			destroy();
+		}
+
+	private:
+		template<typename... Args>
+		static T& create(Args&&... args)
+		{
+			std::lock_guard<std::recursive_mutex> lock(ServiceLocator::mutex());
+			if (T* existing = s_instance.load(std::memory_order_relaxed))
+			{
+				return *existing;
+			}
+			T* created = new T(std::forward<Args>(args)...);
+			AllocationTracker::trackAllocation<T>();
+			ServiceLocator::teardowns().push_back(&destroy);
+			s_instance.store(created, std::memory_order_release);
+			return *created;
+		}
+
+		static void destroy()
+		{
+			T* old = s_instance.exchange(nullptr, std::memory_order_acq_rel);
+			if (old)
+			{
+				AllocationTracker::trackFree<T>();
+				delete old;
+			}
+		}
+
+		static inline std::atomic<T*> s_instance{ nullptr }; ///< Servicio creado, o nulo.
+	};
+}
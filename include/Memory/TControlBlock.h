@@ -0,0 +1,225 @@
+#pragma once
+#include <new>
+#include <utility>
+#include "TRefCountPolicy.h"
+#include "ControlBlockPool.h"
+#include "AllocationTracker.h"
+#include "LifetimeTracker.h"
+#include "DeferredReleaseQueue.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Bloque de control compartido por todos los `TSharedPointer` de un mismo objeto.
+	 *
+	 * Guarda dos contadores y sabe cmo destruir el objeto y liberarse a s mismo:
+	 * - `strongCount`: referencias de `TSharedPointer`. Al llegar a cero se destruye el objeto.
+	 * - `weakCount`: referencias de `TWeakPointer`, ms una mientras exista alguna fuerte.
+	 *   Al llegar a cero se libera el bloque. As un `TWeakPointer` siempre puede leer el
+	 *   bloque, aunque el objeto ya no exista.
+	 *
+	 * Las dos variantes concretas cubren los dos caminos de creacin:
+	 * - `TPointerControlBlock`: el objeto se cre aparte (`TSharedPointer(new T)`).
+	 * - `TInplaceControlBlock`: el objeto vive dentro del bloque (`MakeShared`), una sola reserva.
+	 *
+	 * Los bloques que caben en `ControlBlockPool::kBlockSize` se reservan en el pool, as que
+	 * crear y soltar punteros no dispersa reservas pequeas por el heap.
+	 *
+	 * @tparam Policy Poltica de conteo de referencias.
+	 */
+	template<typename Policy>
+	class TControlBlock : public PooledControlBlockAllocation
+	{
+	public:
+		using CounterType = typename Policy::CounterType;
+
+		TControlBlock() : strongCount(1), weakCount(1) {}
+
+		virtual ~TControlBlock() = default;
+
+		TControlBlock(const TControlBlock&) = delete;
+		TControlBlock& operator=(const TControlBlock&) = delete;
+
+		/**
+		 * @brief Aade una referencia fuerte.
+		 */
+		void addStrong() { Policy::increment(strongCount); }
+
+		/**
+		 * @brief Quita una referencia fuerte; destruye el objeto si era la ltima.
+		 *
+		 * Las referencias fuertes comparten una referencia dbil implcita, que se suelta
+		 * aqu para que el bloque se libere cuando tampoco queden `TWeakPointer`.
+		 */
+		void releaseStrong()
+		{
+			if (Policy::decrement(strongCount))
+			{
+				if constexpr (Policy::kDeferDestruction)
+				{
+					DeferredReleaseQueue::push(this, &finishRelease);
+				}
+				else
+				{
+					finishRelease(this);
+				}
+			}
+		}
+
+		/**
+		 * @brief Intenta obtener una referencia fuerte desde un `TWeakPointer`.
+		 * @return `true` si el objeto segua vivo y se sum una referencia.
+		 */
+		bool tryAddStrong() { return Policy::incrementIfNotZero(strongCount); }
+
+		/**
+		 * @brief Aade una referencia dbil.
+		 */
+		void addWeak() { Policy::increment(weakCount); }
+
+		/**
+		 * @brief Quita una referencia dbil; libera el bloque si era la ltima.
+		 */
+		void releaseWeak()
+		{
+			if (Policy::decrement(weakCount))
+			{
+				destroyBlock();
+			}
+		}
+
+		/**
+		 * @brief Nmero de referencias fuertes vivas.
+		 */
+		int strongRefs() const { return Policy::load(strongCount); }
+
+		/**
+		 * @brief Nmero de referencias dbiles (incluida la implcita de las fuertes).
+		 */
+		int weakRefs() const { return Policy::load(weakCount); }
+
+	protected:
+		/**
+		 * @brief Destruye el objeto y suelta la referencia dbil implcita de las fuertes.
+		 */
+		static void finishRelease(const void* block)
+		{
+			TControlBlock* self = static_cast<TControlBlock*>(const_cast<void*>(block));
+			self->destroyObject();
+			self->releaseWeak();
+		}
+
+		/**
+		 * @brief Ejecuta el destructor del objeto gestionado.
+		 */
+		virtual void destroyObject() = 0;
+
+		/**
+		 * @brief Libera la memoria del propio bloque.
+		 */
+		virtual void destroyBlock() = 0;
+
+		CounterType strongCount; ///< Referencias fuertes (`TSharedPointer`).
+		CounterType weakCount;   ///< Referencias dbiles (`TWeakPointer`) + 1 si hay fuertes.
+	};
+
+	/**
+	 * @brief Bloque de control para un objeto reservado por separado.
+	 *
+	 * Es el camino de `TSharedPointer(T*)`: se conserva para cdigo que ya tiene un puntero
+	 * crudo (por ejemplo, objetos creados por bibliotecas externas).
+	 */
+	template<typename T, typename Policy>
+	class TPointerControlBlock final : public TControlBlock<Policy>
+	{
+	public:
+		explicit TPointerControlBlock(T* object) : m_object(object) {}
+
+	protected:
+		void destroyObject() override { delete m_object; }
+
+		void destroyBlock() override { delete this; }
+
+	private:
+		T* m_object; ///< Objeto gestionado.
+	};
+
+	/**
+	 * @brief Bloque de control que libera el objeto con un eliminador propio.
+	 *
+	 * Es el camino de `TSharedPointer(T*, deleter)`: objetos que pertenecen a un pool o a una
+	 * arena y que, al soltarse la ltima referencia, deben volver a su dueo en vez de `delete`.
+	 */
+	template<typename T, typename Deleter, typename Policy>
+	class TDeleterControlBlock final : public TControlBlock<Policy>
+	{
+	public:
+		TDeleterControlBlock(T* object, Deleter deleter)
+			: m_object(object), m_deleter(std::move(deleter)) {}
+
+	protected:
+		void destroyObject() override { m_deleter(m_object); }
+
+		void destroyBlock() override { delete this; }
+
+	private:
+		T* m_object;       ///< Objeto gestionado.
+		Deleter m_deleter; ///< Devuelve el objeto a su dueo.
+	};
+
+	/**
+	 * @brief Bloque de control que aloja el objeto en su propio almacenamiento.
+	 *
+	 * `MakeShared` lo usa para que el objeto y su contador compartan una nica reserva y
+	 * queden contiguos en memoria, igual que `std::make_shared`.
+	 */
+	template<typename T, typename Policy>
+	class TInplaceControlBlock final : public TControlBlock<Policy>
+	{
+	public:
+		template<typename... Args>
+		explicit TInplaceControlBlock(Args&&... args)
+		{
+			::new (static_cast<void*>(m_storage)) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Puntero al objeto alojado dentro del bloque.
+		 */
+		T* object() { return std::launder(reinterpret_cast<T*>(m_storage)); }
+
+		/**
+		 * @brief Uso interno de `MakeShared`: guarda la entrada del objeto en `LifetimeTracker`.
+		 */
+		void setLifetimeTicket(LifetimeTicket ticket)
+		{
+#if ENGINE_TRACK_LIFETIMES
+			m_lifetimeTicket = ticket;
+#else
+			(void)ticket;
+#endif
+		}
+
+	protected:
+		void destroyObject() override
+		{
+			object()->~T();
+			AllocationTracker::trackFree<T>();
+#if ENGINE_TRACK_LIFETIMES
+			LifetimeTracker::onDestroy(m_lifetimeTicket);
+#endif
+		}
+
+		void destroyBlock() override
+		{
+			ENGINE_TRACY_FREE(this, MemoryAccounting::name(memoryCategoryOf<T>()));
+			delete this;
+		}
+
+	private:
+		alignas(T) unsigned char m_storage[sizeof(T)]; ///< Almacenamiento del objeto.
+#if ENGINE_TRACK_LIFETIMES
+		LifetimeTicket m_lifetimeTicket = 0; ///< Entrada en `LifetimeTracker`.
+#endif
+	};
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include <cassert>
+#include <utility>
+#include "TRefCounted.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Puntero compartido para objetos que heredan de `TRefCounted`.
+	 *
+	 * Ocupa exactamente un puntero: el contador est dentro del objeto. Acceder al objeto
+	 * no requiere pasar por un bloque de control, lo que lo hace adecuado para colecciones
+	 * que se recorren cada frame, como `Entity::components`.
+	 *
+	 * @tparam T Tipo gestionado; debe heredar de `TRefCounted`.
+	 */
+	template<typename T>
+	class TIntrusivePtr
+	{
+	public:
+		/**
+		 * @brief Constructor vaco.
+		 */
+		TIntrusivePtr() : ptr(nullptr) {}
+
+		/**
+		 * @brief Toma un objeto y suma una referencia.
+		 * @param rawPtr Objeto a gestionar (puede ser nulo).
+		 */
+		explicit TIntrusivePtr(T* rawPtr) : ptr(rawPtr)
+		{
+			if (ptr)
+			{
+				ptr->addRef();
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia.
+		 * @param other Otro `TIntrusivePtr`.
+		 */
+		TIntrusivePtr(const TIntrusivePtr<T>& other) : ptr(other.ptr)
+		{
+			if (ptr)
+			{
+				ptr->addRef();
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia desde un tipo derivado.
+		 * @param other `TIntrusivePtr` de un tipo convertible a `T`.
+		 */
+		template<typename U>
+		TIntrusivePtr(const TIntrusivePtr<U>& other) : ptr(other.get())
+		{
+			if (ptr)
+			{
+				ptr->addRef();
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento; no toca el contador.
+		 * @param other Otro `TIntrusivePtr`, que queda vaco.
+		 */
+		TIntrusivePtr(TIntrusivePtr<T>&& other) noexcept : ptr(other.ptr)
+		{
+			other.ptr = nullptr;
+		}
+
+		/**
+		 * @brief Constructor de movimiento desde un tipo derivado.
+		 * @param other `TIntrusivePtr` de un tipo convertible a `T`, que queda vaco.
+		 */
+		template<typename U>
+		TIntrusivePtr(TIntrusivePtr<U>&& other) noexcept : ptr(other.detach()) {}
+
+		/**
+		 * @brief Asignacin por copia.
+		 * @param other Otro `TIntrusivePtr`.
+		 * @return Referencia a este puntero.
+		 */
+		TIntrusivePtr<T>& operator=(const TIntrusivePtr<T>& other)
+		{
+			TIntrusivePtr<T>(other).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Asignacin por movimiento.
+		 * @param other Otro `TIntrusivePtr`, que queda vaco.
+		 * @return Referencia a este puntero.
+		 */
+		TIntrusivePtr<T>& operator=(TIntrusivePtr<T>&& other) noexcept
+		{
+			TIntrusivePtr<T>(std::move(other)).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor; suelta la referencia.
+		 */
+		~TIntrusivePtr()
+		{
+			if (ptr)
+			{
+				ptr->releaseRef();
+			}
+		}
+
+		T& operator*() const { return *ptr; }
+
+		T* operator->() const { return ptr; }
+
+		/**
+		 * @brief Obtener el puntero crudo gestionado.
+		 */
+		T* get() const { return ptr; }
+
+		/**
+		 * @brief Verificar si el puntero es nulo.
+		 */
+		bool isNull() const { return ptr == nullptr; }
+
+		explicit operator bool() const { return ptr != nullptr; }
+
+		/**
+		 * @brief Suelta el objeto actual y deja el puntero vaco.
+		 */
+		void reset()
+		{
+			TIntrusivePtr<T>().swap(*this);
+		}
+
+		/**
+		 * @brief Entrega el puntero crudo sin soltar la referencia; el llamador la hereda.
+		 */
+		T* detach()
+		{
+			T* oldPtr = ptr;
+			ptr = nullptr;
+			return oldPtr;
+		}
+
+		/**
+		 * @brief Intercambia el contenido con otro `TIntrusivePtr`.
+		 */
+		void swap(TIntrusivePtr<T>& other) noexcept
+		{
+			T* tmp = ptr;
+			ptr = other.ptr;
+			other.ptr = tmp;
+		}
+
+		/**
+		 * @brief Convierte el puntero a otro tipo usando `dynamic_cast`.
+		 * @tparam U Tipo destino.
+		 * @return `TIntrusivePtr<U>` al mismo objeto, o nulo si la conversin falla.
+		 */
+		template<typename U>
+		TIntrusivePtr<U> dynamic_pointer_cast() const
+		{
+			return TIntrusivePtr<U>(dynamic_cast<U*>(ptr));
+		}
+
+		/**
+		 * @brief Convierte el puntero a otro tipo con `static_cast`, sin RTTI.
+		 *
+		 * El llamador garantiza el tipo (por ejemplo, comparando `Component::getType()` con
+		 * `U::StaticType`). En builds de depuracin se verifica con `dynamic_cast`.
+		 *
+		 * @tparam U Tipo destino.
+		 * @return `TIntrusivePtr<U>` al mismo objeto.
+		 */
+		template<typename U>
+		TIntrusivePtr<U> static_pointer_cast() const
+		{
+			assert(ptr == nullptr || dynamic_cast<U*>(ptr) != nullptr);
+			return TIntrusivePtr<U>(static_cast<U*>(ptr));
+		}
+
+	private:
+		T* ptr; ///< Objeto gestionado.
+	};
+
+	/**
+	 * @brief Crea un objeto `TRefCounted` y lo entrega en un `TIntrusivePtr`.
+	 *
+	 * @tparam T Tipo a crear.
+	 * @param args Argumentos para el constructor; se reenvan sin copias.
+	 * @return `TIntrusivePtr` que gestiona el nuevo objeto.
+	 */
+	template<typename T, typename... Args>
+	TIntrusivePtr<T> MakeIntrusive(Args&&... args)
+	{
+		return TIntrusivePtr<T>(new T(std::forward<Args>(args)...));
+	}
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Poltica de conteo de referencias para uso en un solo hilo.
+	 *
+	 * Es la poltica por defecto de `TSharedPointer`. El contador es un `int` normal,
+	 * por lo que incrementar y decrementar cuesta una sola instruccin. Solo debe usarse
+	 * cuando todas las copias del puntero viven en el mismo hilo (el bucle principal).
+	 */
+	struct SingleThreadRefCount
+	{
+		using CounterType = int;
+
+		static constexpr bool kDeferDestruction = false; ///< Destruye en cuanto el contador llega a cero.
+
+		/**
+		 * @brief Incrementa el contador.
+		 * @param counter Contador de referencias.
+		 */
+		static void increment(CounterType& counter) { ++counter; }
+
+		/**
+		 * @brief Decrementa el contador.
+		 * @param counter Contador de referencias.
+		 * @return `true` si el contador lleg a cero y el objeto debe liberarse.
+		 */
+		static bool decrement(CounterType& counter) { return --counter == 0; }
+
+		/**
+		 * @brief Lee el valor actual del contador.
+		 * @param counter Contador de referencias.
+		 * @return Nmero de referencias vivas.
+		 */
+		static int load(const CounterType& counter) { return counter; }
+
+		/**
+		 * @brief Incrementa el contador solo si todava no lleg a cero.
+		 * @param counter Contador de referencias.
+		 * @return `true` si se obtuvo una nueva referencia.
+		 */
+		static bool incrementIfNotZero(CounterType& counter)
+		{
+			if (counter == 0)
+			{
+				return false;
+			}
+			++counter;
+			return true;
+		}
+	};
+
+	/**
+	 * @brief Poltica de conteo de referencias segura entre hilos.
+	 *
+	 * Los incrementos son `relaxed`: quien copia ya tiene una referencia vlida, as que
+	 * no necesita sincronizarse con nadie. El decremento usa `release` para publicar las
+	 * escrituras hechas sobre el objeto y, solo cuando llega a cero, una barrera `acquire`
+	 * antes de destruirlo. Es el mismo esquema que usa `std::shared_ptr`.
+	 */
+	struct AtomicRefCount
+	{
+		using CounterType = std::atomic<int>;
+
+		static constexpr bool kDeferDestruction = false; ///< Destruye en cuanto el contador llega a cero.
+
+		/**
+		 * @brief Incrementa el contador de forma atmica.
+		 * @param counter Contador de referencias.
+		 */
+		static void increment(CounterType& counter)
+		{
+			counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Decrementa el contador de forma atmica.
+		 * @param counter Contador de referencias.
+		 * @return `true` si este hilo liber la ltima referencia.
+		 */
+		static bool decrement(CounterType& counter)
+		{
+			if (counter.fetch_sub(1, std::memory_order_release) == 1)
+			{
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Lee el valor actual del contador.
+		 * @param counter Contador de referencias.
+		 * @return Nmero de referencias vivas (aproximado si otros hilos lo modifican).
+		 */
+		static int load(const CounterType& counter)
+		{
+			return counter.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Incrementa el contador solo si todava no lleg a cero.
+		 *
+		 * Es un nico compare-and-swap en el caso comn. Si otro hilo solt la ltima
+		 * referencia entre la lectura y el intercambio, el bucle ve el cero y falla.
+		 *
+		 * @param counter Contador de referencias.
+		 * @return `true` si se obtuvo una nueva referencia.
+		 */
+		static bool incrementIfNotZero(CounterType& counter)
+		{
+			int expected = counter.load(std::memory_order_relaxed);
+			while (expected != 0)
+			{
+				if (counter.compare_exchange_weak(expected, expected + 1,
+				                                  std::memory_order_acquire,
+				                                  std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * @brief Variante de una poltica que difiere la destruccin a `DeferredReleaseQueue`.
+	 *
+	 * Cuenta igual que `Base`, pero cuando el contador llega a cero el objeto se encola en
+	 * lugar de destruirse. Para objetos con destructores caros (actores con muchos
+	 * componentes, recursos grficos), por ejemplo
+	 * `MakeSharedWithPolicy<Actor, TDeferredRelease<AtomicRefCount>>()`.
+	 *
+	 * Mientras espera en la cola el objeto ya no es alcanzable: `TWeakPointer::lock()` falla.
+	 *
+	 * @tparam Base `SingleThreadRefCount` o `AtomicRefCount`. Con `SingleThreadRefCount`,
+	 *              `flush()` debe llamarse desde el mismo hilo que usa los punteros.
+	 */
+	template<typename Base>
+	struct TDeferredRelease : Base
+	{
+		static constexpr bool kDeferDestruction = true;
+	};
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "TRefCountPolicy.h"
+#include "DeferredReleaseQueue.h"
+
+namespace EngineUtilities {
+
+	/**
+	 * @brief Base opcional para objetos que guardan su propio contador de referencias.
+	 *
+	 * Una clase que hereda de `TRefCounted` se gestiona con `TIntrusivePtr`: el contador vive
+	 * dentro del objeto, as que el puntero ocupa lo mismo que un puntero crudo y no hay
+	 * bloque de control aparte. `Component` y `Entity` heredan de ella.
+	 *
+	 * Un mismo objeto debe gestionarse con `TIntrusivePtr` o con `TSharedPointer`, nunca con
+	 * ambos: cada uno llevara su propio conteo y lo destruiran dos veces.
+	 *
+	 * @tparam Policy Poltica de conteo (`SingleThreadRefCount` o `AtomicRefCount`).
+	 */
+	template<typename Policy = SingleThreadRefCount>
+	class TRefCounted
+	{
+	public:
+		TRefCounted() : m_refCount(0) {}
+
+		/**
+		 * @brief La copia de un objeto empieza sin referencias; el contador no se copia.
+		 */
+		TRefCounted(const TRefCounted&) : m_refCount(0) {}
+
+		/**
+		 * @brief Asignar no cambia quin referencia a este objeto.
+		 */
+		TRefCounted& operator=(const TRefCounted&) { return *this; }
+
+		/**
+		 * @brief Suma una referencia. Lo llama `TIntrusivePtr`.
+		 */
+		void addRef() const { Policy::increment(m_refCount); }
+
+		/**
+		 * @brief Quita una referencia y destruye el objeto si era la ltima.
+		 */
+		void releaseRef() const
+		{
+			if (Policy::decrement(m_refCount))
+			{
+				if constexpr (Policy::kDeferDestruction)
+				{
+					DeferredReleaseQueue::push(this, &destroy);
+				}
+				else
+				{
+					delete this;
+				}
+			}
+		}
+
+		/**
+		 * @brief Nmero de `TIntrusivePtr` que apuntan al objeto.
+		 */
+		int refCount() const { return Policy::load(m_refCount); }
+
+	protected:
+		static void destroy(const void* object)
+		{
+			delete static_cast<const TRefCounted*>(object);
+		}
+
+		/**
+		 * @brief Destructor virtual: `releaseRef` destruye siempre el tipo ms derivado.
+		 */
+		virtual ~TRefCounted() = default;
+
+	private:
+		mutable typename Policy::CounterType m_refCount; ///< Referencias vivas.
+	};
+}
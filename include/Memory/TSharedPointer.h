@@ -1,7 +1,13 @@
 #pragma once
+#include <cassert>
+#include <type_traits>
+#include "TControlBlock.h"
 
 namespace EngineUtilities {
 
+	template<typename T, typename Policy>
+	class TWeakPointer;
+
 	/**
 	 * @brief Clase que facilita la gestin compartida de memoria para objetos.
 	 *
@@ -9,11 +15,21 @@ namespace EngineUtilities {
 	 * de tu programa sin duplicarlo. TSharedPointer gestiona este objeto y se asegura de
 	 * que, cuando ya no se necesite, la memoria se libere correctamente. Tambin lleva un
 	 * conteo de cuntos TSharedPointer estn compartiendo el mismo objeto.
+	 *
+	 * El conteo vive en un `TControlBlock`. Con `MakeShared` el objeto se construye dentro
+	 * del propio bloque, as que crear un puntero compartido cuesta una sola reserva.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Policy Poltica de conteo de referencias. `SingleThreadRefCount` (por defecto)
+	 *         usa un contador normal para el hilo principal; `AtomicRefCount` permite
+	 *         compartir el objeto entre hilos (ver `TAtomicSharedPointer`).
 	 */
-	template<typename T>
+	template<typename T, typename Policy = SingleThreadRefCount>
 	class TSharedPointer
 	{
 	public:
+		using ControlBlockType = TControlBlock<Policy>;
+
 		/**
 		 * @brief Constructor vaco.
 		 *
@@ -29,26 +45,57 @@ namespace EngineUtilities {
 		 *
 		 * @param rawPtr Puntero al objeto que quieres que sea gestionado.
 		 */
-		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(new int(1)) {}
+		explicit TSharedPointer(T* rawPtr)
+			: ptr(rawPtr), refCount(rawPtr ? new TPointerControlBlock<T, Policy>(rawPtr) : nullptr) {}
+
+		/**
+		 * @brief Constructor a partir de un puntero y el eliminador que lo liberar.
+		 *
+		 * Cuando se suelta la ltima referencia se llama `deleter(rawPtr)` en vez de `delete`;
+		 * as un pool puede recuperar sus objetos (ver `ActorPool`).
+		 *
+		 * @param rawPtr Puntero al objeto que quieres que sea gestionado.
+		 * @param deleter Objeto funcin que recibe el puntero al final de su vida.
+		 */
+		template<typename Deleter,
+		         typename = std::enable_if_t<!std::is_convertible_v<Deleter, ControlBlockType*>>>
+		TSharedPointer(T* rawPtr, Deleter deleter)
+			: ptr(rawPtr),
+			  refCount(rawPtr ? new TDeleterControlBlock<T, Deleter, Policy>(rawPtr, std::move(deleter)) : nullptr) {}
 
 		/**
-		 * @brief Constructor que toma tanto un puntero como un conteo de referencias.
+		 * @brief Constructor que toma tanto un puntero como un bloque de control.
 		 *
 		 * En este caso, usas un puntero y un conteo de referencias que ya existan previamente.
 		 * Esto es til si deseas crear una nueva instancia de TSharedPointer que comparta un
 		 * objeto que ya estaba siendo gestionado por otro TSharedPointer.
 		 *
 		 * @param rawPtr Puntero al objeto.
-		 * @param existingRefCount Puntero al contador de referencias ya existente.
+		 * @param existingRefCount Bloque de control ya existente.
 		 */
-		TSharedPointer(T* rawPtr, int* existingRefCount) : ptr(rawPtr), refCount(existingRefCount)
+		TSharedPointer(T* rawPtr, ControlBlockType* existingRefCount) : ptr(rawPtr), refCount(existingRefCount)
 		{
 			if (refCount)
 			{
-				++(*refCount); // Aumenta el contador si ya existe.
+				refCount->addStrong(); // Aumenta el contador si ya existe.
 			}
 		}
 
+		/**
+		 * @brief Etiqueta para adoptar un bloque recin creado sin incrementar su contador.
+		 */
+		struct AdoptRef {};
+
+		/**
+		 * @brief Adopta un bloque de control cuyo contador ya vale 1.
+		 *
+		 * Lo usan las funciones de creacin (`MakeShared`) despus de construir el bloque.
+		 *
+		 * @param rawPtr Puntero al objeto.
+		 * @param newBlock Bloque de control recin creado.
+		 */
+		TSharedPointer(T* rawPtr, ControlBlockType* newBlock, AdoptRef) : ptr(rawPtr), refCount(newBlock) {}
+
 		/**
 		 * @brief Constructor de copia.
 		 *
@@ -57,11 +104,28 @@ namespace EngineUtilities {
 		 *
 		 * @param other Otro TSharedPointer que gestiona el mismo tipo de objeto.
 		 */
-		TSharedPointer(const TSharedPointer<T>& other) : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(const TSharedPointer<T, Policy>& other) : ptr(other.ptr), refCount(other.refCount)
 		{
 			if (refCount)
 			{
-				++(*refCount); // El contador de referencias aumenta.
+				refCount->addStrong(); // El contador de referencias aumenta.
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia desde un tipo derivado.
+		 *
+		 * Permite asignar un `TSharedPointer<Derivada>` a un `TSharedPointer<Base>` sin
+		 * pasar por `dynamic_pointer_cast`; ambos comparten el mismo contador.
+		 *
+		 * @param other TSharedPointer de un tipo convertible a `T`.
+		 */
+		template<typename U>
+		TSharedPointer(const TSharedPointer<U, Policy>& other) : ptr(other.ptr), refCount(other.refCount)
+		{
+			if (refCount)
+			{
+				refCount->addStrong();
 			}
 		}
 
@@ -73,7 +137,7 @@ namespace EngineUtilities {
 		 *
 		 * @param other Otro TSharedPointer que ser vaciado.
 		 */
-		TSharedPointer(TSharedPointer<T>&& other) noexcept : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(TSharedPointer<T, Policy>&& other) noexcept : ptr(other.ptr), refCount(other.refCount)
 		{
 			// Vaciamos el otro TSharedPointer
 			other.ptr = nullptr;
@@ -89,23 +153,20 @@ namespace EngineUtilities {
 		 * @param other Otro TSharedPointer del mismo tipo.
 		 * @return Referencia al propio TSharedPointer.
 		 */
-		TSharedPointer<T>& operator=(const TSharedPointer<T>& other)
+		TSharedPointer<T, Policy>& operator=(const TSharedPointer<T, Policy>& other)
 		{
 			if (this != &other)
 			{
-				// Primero liberamos lo que est gestionado actualmente.
-				if (refCount && --(*refCount) == 0)
+				// Incrementamos primero por si `other` y este puntero comparten objeto.
+				if (other.refCount)
 				{
-					delete ptr;
-					delete refCount;
+					other.refCount->addStrong();
 				}
+				// Liberamos lo que est gestionado actualmente.
+				release();
 				// Ahora copiamos el nuevo puntero y su conteo de referencias.
 				ptr = other.ptr;
 				refCount = other.refCount;
-				if (refCount)
-				{
-					++(*refCount); // Incrementa el contador de referencias.
-				}
 			}
 			return *this;
 		}
@@ -119,16 +180,12 @@ namespace EngineUtilities {
 		 * @param other Otro TSharedPointer que ser vaciado.
 		 * @return Referencia al propio TSharedPointer.
 		 */
-		TSharedPointer<T>& operator=(TSharedPointer<T>&& other) noexcept
+		TSharedPointer<T, Policy>& operator=(TSharedPointer<T, Policy>&& other) noexcept
 		{
 			if (this != &other)
 			{
 				// Liberamos el puntero actual antes de hacer el cambio.
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
+				release();
 				// Transferimos los datos del otro TSharedPointer.
 				ptr = other.ptr;
 				refCount = other.refCount;
@@ -146,21 +203,179 @@ namespace EngineUtilities {
 		 */
 		~TSharedPointer()
 		{
-			if (refCount && --(*refCount) == 0)
+			release();
+		}
+
+		/**
+		 * @brief Operador de desreferenciacin.
+		 * @return Referencia al objeto gestionado.
+		 */
+		T& operator*() const { return *ptr; }
+
+		/**
+		 * @brief Operador de acceso a miembros.
+		 * @return Puntero al objeto gestionado.
+		 */
+		T* operator->() const { return ptr; }
+
+		/**
+		 * @brief Obtener el puntero crudo gestionado.
+		 * @return Puntero crudo al objeto, sin transferir la propiedad.
+		 */
+		T* get() const { return ptr; }
+
+		/**
+		 * @brief Verificar si el puntero gestionado es nulo.
+		 * @return `true` si no gestiona ningn objeto.
+		 */
+		bool isNull() const { return ptr == nullptr; }
+
+		/**
+		 * @brief Permite usar el puntero en condiciones (`if (ptr)`).
+		 * @return `true` si gestiona un objeto.
+		 */
+		explicit operator bool() const { return ptr != nullptr; }
+
+		/**
+		 * @brief Nmero de TSharedPointer que comparten el objeto.
+		 * @return Conteo de referencias actual, o 0 si el puntero es nulo.
+		 */
+		int useCount() const { return refCount ? refCount->strongRefs() : 0; }
+
+		/**
+		 * @brief Suelta el objeto actual y deja el puntero vaco.
+		 */
+		void reset()
+		{
+			release();
+			ptr = nullptr;
+			refCount = nullptr;
+		}
+
+		/**
+		 * @brief Intercambia el contenido con otro TSharedPointer.
+		 * @param other TSharedPointer con el que se intercambia.
+		 */
+		void swap(TSharedPointer<T, Policy>& other) noexcept
+		{
+			T* tmpPtr = ptr;
+			ControlBlockType* tmpCount = refCount;
+			ptr = other.ptr;
+			refCount = other.refCount;
+			other.ptr = tmpPtr;
+			other.refCount = tmpCount;
+		}
+
+		/**
+		 * @brief Convierte el puntero a otro tipo usando `dynamic_cast`.
+		 *
+		 * El resultado comparte el contador con este puntero. Si la conversin falla,
+		 * se devuelve un TSharedPointer nulo.
+		 *
+		 * @tparam U Tipo destino de la conversin.
+		 * @return TSharedPointer al mismo objeto visto como `U`, o nulo.
+		 */
+		template<typename U>
+		TSharedPointer<U, Policy> dynamic_pointer_cast() const
+		{
+			U* castPtr = dynamic_cast<U*>(ptr);
+			if (castPtr)
 			{
-				delete ptr;
-				delete refCount;
+				return TSharedPointer<U, Policy>(castPtr, refCount);
 			}
+			return TSharedPointer<U, Policy>();
 		}
 
-		// Resto de la implementacin similar...
+		/**
+		 * @brief Convierte el puntero a otro tipo con `static_cast`, sin RTTI.
+		 *
+		 * El llamador garantiza el tipo; en builds de depuracin se verifica con `dynamic_cast`.
+		 * El resultado comparte el contador con este puntero.
+		 *
+		 * @tparam U Tipo destino de la conversin.
+		 * @return TSharedPointer al mismo objeto visto como `U`.
+		 */
+		template<typename U>
+		TSharedPointer<U, Policy> static_pointer_cast() const
+		{
+			assert(ptr == nullptr || dynamic_cast<U*>(ptr) != nullptr);
+			return TSharedPointer<U, Policy>(static_cast<U*>(ptr), refCount);
+		}
+
+		// Hacer amigos al resto de instancias y a `TWeakPointer` para compartir el contador.
+		template<typename U, typename P>
+		friend class TSharedPointer;
+
+		template<typename U, typename P>
+		friend class TWeakPointer;
 
+	private:
+		/**
+		 * @brief Decrementa el contador y destruye el objeto si era la ltima referencia.
+		 */
+		void release()
+		{
+			if (refCount)
+			{
+				refCount->releaseStrong();
+			}
+		}
+
+		T* ptr;                  ///< Puntero al objeto gestionado.
+		ControlBlockType* refCount; ///< Bloque de control con el contador compartido.
 	};
 
+	/**
+	 * @brief TSharedPointer con conteo atmico, seguro para compartir entre hilos.
+	 *
+	 * salo para objetos que se entregan a hilos de trabajo (actores y componentes
+	 * procesados en paralelo). En el hilo principal conviene el `TSharedPointer` normal,
+	 * que evita el costo de las operaciones atmicas.
+	 */
+	template<typename T>
+	using TAtomicSharedPointer = TSharedPointer<T, AtomicRefCount>;
+
+	/**
+	 * @brief Crea un TSharedPointer con la poltica de conteo indicada.
+	 *
+	 * El objeto se construye dentro de su bloque de control: una sola reserva de memoria
+	 * y el contador queda junto al objeto.
+	 *
+	 * @tparam T Tipo del objeto a crear.
+	 * @tparam Policy Poltica de conteo (`SingleThreadRefCount` o `AtomicRefCount`).
+	 * @param args Argumentos para el constructor del objeto; se reenvan sin copias.
+	 * @return Un TSharedPointer que gestiona el nuevo objeto.
+	 */
+	template<typename T, typename Policy, typename... Args>
+	TSharedPointer<T, Policy> MakeSharedWithPolicy(Args&&... args)
+	{
+		auto* block = new TInplaceControlBlock<T, Policy>(std::forward<Args>(args)...);
+		ENGINE_TRACY_ALLOC(block, sizeof(*block), MemoryAccounting::name(memoryCategoryOf<T>()));
+		AllocationTracker::trackAllocation<T>();
+		if constexpr (kTrackLifetimes)
+		{
+			block->setLifetimeTicket(LifetimeTracker::onCreate(block->object()));
+		}
+		return TSharedPointer<T, Policy>(block->object(), block, typename TSharedPointer<T, Policy>::AdoptRef{});
+	}
+
 	// Funcin para crear un TSharedPointer de manera ms sencilla.
 	template<typename T, typename... Args>
-	TSharedPointer<T> MakeShared(Args... args)
+	TSharedPointer<T> MakeShared(Args&&... args)
+	{
+		return MakeSharedWithPolicy<T, SingleThreadRefCount>(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Crea un TAtomicSharedPointer de manera sencilla.
+	 *
+	 * @tparam T Tipo del objeto a crear.
+	 * @param args Argumentos para el constructor del objeto.
+	 * @return Un TAtomicSharedPointer que gestiona el nuevo objeto.
+	 */
+	template<typename T, typename... Args>
+	TAtomicSharedPointer<T> MakeAtomicShared(Args&&... args)
 	{
-		return TSharedPointer<T>(new T(args...));
+		return MakeSharedWithPolicy<T, AtomicRefCount>(std::forward<Args>(args)...);
 	}
 }
@@ -1,7 +1,96 @@
 #pragma once
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "AllocationTracker.h"
+#include "LifetimeTracker.h"
 
 namespace EngineUtilities {
 
+    /**
+     * @brief Eliminador por defecto de `TUniquePtr`: llama a `delete`.
+     */
+    template<typename T>
+    struct TDefaultDelete
+    {
+        TDefaultDelete() = default;
+
+        /**
+         * @brief Permite convertir el eliminador de un tipo derivado al de su base.
+         */
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        TDefaultDelete(const TDefaultDelete<U>&) {}
+
+        void operator()(T* object) const { delete object; }
+    };
+
+    /**
+     * @brief Eliminador por defecto para arreglos: llama a `delete[]`.
+     */
+    template<typename T>
+    struct TDefaultDelete<T[]>
+    {
+        void operator()(T* objects) const { delete[] objects; }
+    };
+
+    /**
+     * @brief Eliminador de arreglos creados por `MakeUniqueAligned`.
+     *
+     * Destruye los `count` elementos y devuelve la memoria con la misma alineacin con la que
+     * se reserv. `TUniquePtr<T[]>` le pasa el nmero de elementos que guarda.
+     */
+    template<typename T>
+    struct TAlignedArrayDelete
+    {
+        TAlignedArrayDelete() = default;
+
+        explicit TAlignedArrayDelete(size_t alignmentBytes) : alignment(alignmentBytes) {}
+
+        void operator()(T* objects, size_t count) const
+        {
+            std::destroy_n(objects, count);
+            ::operator delete(static_cast<void*>(objects), std::align_val_t(alignment));
+        }
+
+        size_t alignment = alignof(T); ///< Alineacin usada al reservar.
+    };
+
+    /**
+     * @brief Eliminador para objetos creados con un asignador estilo STL.
+     *
+     * Destruye el objeto y devuelve su memoria al mismo asignador que la entreg, de modo
+     * que objetos en arenas o pools pueden tener dueo RAII. Guarda una copia del asignador:
+     * si este no tiene estado, el eliminador no ocupa espacio dentro de `TUniquePtr`.
+     *
+     * @tparam T Tipo del objeto.
+     * @tparam Alloc Asignador compatible con `std::allocator_traits`.
+     */
+    template<typename T, typename Alloc>
+    struct TAllocatorDelete : private std::allocator_traits<Alloc>::template rebind_alloc<T>
+    {
+        using AllocatorType = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+        using Traits = std::allocator_traits<AllocatorType>;
+
+        TAllocatorDelete() = default;
+
+        explicit TAllocatorDelete(const Alloc& alloc) : AllocatorType(alloc) {}
+
+        void operator()(T* object)
+        {
+            AllocatorType& alloc = *this;
+            Traits::destroy(alloc, object);
+            Traits::deallocate(alloc, object, 1);
+        }
+
+        /**
+         * @brief Asignador que recibir la memoria.
+         */
+        const AllocatorType& allocator() const { return *this; }
+    };
+
     /**
      * @brief Clase que gestiona la memoria de un objeto de forma exclusiva.
      *
@@ -9,17 +98,27 @@ namespace EngineUtilities {
      * gestionar un objeto en cualquier momento dado, garantizando as que la
      * memoria asociada no ser compartida. Esta clase es til cuando se desea
      * un control exclusivo sobre el ciclo de vida de un objeto.
+     *
+     * El eliminador se guarda como base vaca, as que con `TDefaultDelete` (o cualquier
+     * eliminador sin estado) `TUniquePtr` ocupa exactamente lo mismo que un puntero crudo.
+     *
+     * @tparam T Tipo del objeto gestionado.
+     * @tparam Deleter Objeto funcin que libera el puntero; debe ser un tipo clase.
      */
-    template<typename T>
+    template<typename T, typename Deleter = TDefaultDelete<T>>
     class TUniquePtr
     {
+        static_assert(std::is_class_v<Deleter>, "TUniquePtr: el eliminador debe ser un tipo clase");
+
     public:
+        using DeleterType = Deleter;
+
         /**
          * @brief Constructor por defecto que inicializa el puntero a nullptr.
          *
          * Crea un `TUniquePtr` vaco que no posee ningn objeto.
          */
-        TUniquePtr() : ptr(nullptr) {}
+        TUniquePtr() : storage(nullptr) {}
 
         /**
          * @brief Constructor que toma un puntero crudo.
@@ -27,7 +126,15 @@ namespace EngineUtilities {
          * @param rawPtr Un puntero crudo al objeto que se va a gestionar.
          * Crea un `TUniquePtr` que gestiona el objeto apuntado por `rawPtr`.
          */
-        explicit TUniquePtr(T* rawPtr) : ptr(rawPtr) {}
+        explicit TUniquePtr(T* rawPtr) : storage(rawPtr) {}
+
+        /**
+         * @brief Constructor que toma un puntero crudo y el eliminador que lo liberar.
+         *
+         * @param rawPtr Un puntero crudo al objeto que se va a gestionar.
+         * @param deleter Eliminador a usar (por ejemplo, uno que devuelve el objeto a una arena).
+         */
+        TUniquePtr(T* rawPtr, const Deleter& deleter) : storage(rawPtr, deleter) {}
 
         /**
          * @brief Constructor de movimiento.
@@ -37,8 +144,23 @@ namespace EngineUtilities {
          *
          * @param other Otro `TUniquePtr` desde el cual se transfiere el objeto.
          */
-        TUniquePtr(TUniquePtr<T>&& other) noexcept : ptr(other.ptr) {
-            other.ptr = nullptr;
+        TUniquePtr(TUniquePtr&& other) noexcept
+            : storage(other.storage.ptr, std::move(other.getDeleter())) {
+            other.storage.ptr = nullptr;
+            takeTracking(other);
+        }
+
+        /**
+         * @brief Constructor de movimiento desde un tipo derivado.
+         *
+         * @param other `TUniquePtr` de un tipo convertible a `T`, que queda nulo.
+         */
+        template<typename U, typename E,
+                 typename = std::enable_if_t<std::is_convertible_v<U*, T*> && std::is_constructible_v<Deleter, E&&>>>
+        TUniquePtr(TUniquePtr<U, E>&& other) noexcept
+            : storage(other.storage.ptr, std::move(other.getDeleter())) {
+            other.storage.ptr = nullptr;
+            takeTracking(other);
         }
 
         /**
@@ -50,14 +172,14 @@ namespace EngineUtilities {
          * @param other Otro `TUniquePtr` desde el cual se transfiere el objeto.
          * @return Referencia al `TUniquePtr` actual.
          */
-        TUniquePtr<T>& operator=(TUniquePtr<T>&& other) noexcept {
+        TUniquePtr& operator=(TUniquePtr&& other) noexcept {
             if (this != &other) {
-                // Liberar el objeto actual
-                delete ptr;
-
-                // Transferir el puntero exclusivo
-                ptr = other.ptr;
-                other.ptr = nullptr;
+                // Liberar el objeto actual y transferir el puntero exclusivo
+                reset();
+                storage.ptr = other.storage.ptr;
+                other.storage.ptr = nullptr;
+                getDeleter() = std::move(other.getDeleter());
+                takeTracking(other);
             }
             return *this;
         }
@@ -68,7 +190,10 @@ namespace EngineUtilities {
          * Si el `TUniquePtr` todava gestiona un objeto, este ser eliminado.
          */
         ~TUniquePtr() {
-            delete ptr;
+            if (storage.ptr) {
+                untrack();
+                getDeleter()(storage.ptr);
+            }
         }
 
         /**
@@ -77,7 +202,7 @@ namespace EngineUtilities {
          * Esto asegura que no se puede copiar un `TUniquePtr`, ya que sera peligroso
          * permitir que ms de un puntero gestione el mismo objeto.
          */
-        TUniquePtr(const TUniquePtr<T>&) = delete;
+        TUniquePtr(const TUniquePtr&) = delete;
 
         /**
          * @brief Prohibir la asignacin por copia de `TUniquePtr`.
@@ -85,28 +210,28 @@ namespace EngineUtilities {
          * Al igual que el constructor de copia, la asignacin por copia est deshabilitada
          * para garantizar que no haya mltiples gestores del mismo objeto.
          */
-        TUniquePtr<T>& operator=(const TUniquePtr<T>&) = delete;
+        TUniquePtr& operator=(const TUniquePtr&) = delete;
 
         /**
          * @brief Operador de desreferenciacin.
          *
          * @return Referencia al objeto gestionado.
          */
-        T& operator*() const { return *ptr; }
+        T& operator*() const { return *storage.ptr; }
 
         /**
          * @brief Operador de acceso a miembros.
          *
          * @return Puntero al objeto gestionado.
          */
-        T* operator->() const { return ptr; }
+        T* operator->() const { return storage.ptr; }
 
         /**
          * @brief Obtener el puntero crudo gestionado.
          *
          * @return El puntero crudo al objeto gestionado por este `TUniquePtr`.
          */
-        T* get() const { return ptr; }
+        T* get() const { return storage.ptr; }
 
         /**
          * @brief Liberar la propiedad del puntero crudo.
@@ -115,8 +240,9 @@ namespace EngineUtilities {
          * El `TUniquePtr` queda nulo despus de esta operacin.
          */
         T* release() {
-            T* oldPtr = ptr;
-            ptr = nullptr;
+            untrack();
+            T* oldPtr = storage.ptr;
+            storage.ptr = nullptr;
             return oldPtr;
         }
 
@@ -129,8 +255,12 @@ namespace EngineUtilities {
          * @param rawPtr Puntero crudo al nuevo objeto que se va a gestionar (por defecto nullptr).
          */
         void reset(T* rawPtr = nullptr) {
-            delete ptr;
-            ptr = rawPtr;
+            T* oldPtr = storage.ptr;
+            storage.ptr = rawPtr;
+            untrack();
+            if (oldPtr) {
+                getDeleter()(oldPtr);
+            }
         }
 
         /**
@@ -139,14 +269,261 @@ namespace EngineUtilities {
          * @return `true` si el puntero gestionado es nulo, `false` en caso contrario.
          */
         bool isNull() const {
-            return ptr == nullptr;
+            return storage.ptr == nullptr;
+        }
+
+        explicit operator bool() const { return storage.ptr != nullptr; }
+
+        /**
+         * @brief Acceso al eliminador que liberar el objeto.
+         */
+        Deleter& getDeleter() { return storage; }
+
+        const Deleter& getDeleter() const { return storage; }
+
+        /**
+         * @brief Uso interno de `MakeUnique`: anota el objeto en el registro de su tipo.
+         *
+         * Solo tiene efecto con `ENGINE_TRACK_ALLOCATIONS`; la baja se anota al destruirlo,
+         * al reemplazarlo con `reset` o al soltarlo con `release`.
+         */
+        void setAllocationRecord(AllocationRecord& record) {
+#if ENGINE_TRACK_ALLOCATIONS
+            record.onAllocate();
+            storage.record = &record;
+#else
+            (void)record;
+#endif
+        }
+
+        /**
+         * @brief Uso interno de `MakeUnique`: guarda la entrada del objeto en `LifetimeTracker`.
+         */
+        void setLifetimeTicket(LifetimeTicket ticket) {
+#if ENGINE_TRACK_LIFETIMES
+            storage.lifetimeTicket = ticket;
+#else
+            (void)ticket;
+#endif
+        }
+
+        template<typename U, typename E>
+        friend class TUniquePtr;
+
+    private:
+        /**
+         * @brief Anota la baja del objeto actual si vena de `MakeUnique`.
+         */
+        void untrack() {
+#if ENGINE_TRACK_ALLOCATIONS
+            if (storage.record) {
+                storage.record->onFree();
+                storage.record = nullptr;
+            }
+#endif
+#if ENGINE_TRACK_LIFETIMES
+            LifetimeTracker::onDestroy(storage.lifetimeTicket);
+            storage.lifetimeTicket = 0;
+#endif
+        }
+
+        /**
+         * @brief Hereda el registro de otro `TUniquePtr` junto con su objeto.
+         */
+        template<typename U, typename E>
+        void takeTracking(TUniquePtr<U, E>& other) {
+#if ENGINE_TRACK_ALLOCATIONS
+            storage.record = other.storage.record;
+            other.storage.record = nullptr;
+#endif
+#if ENGINE_TRACK_LIFETIMES
+            storage.lifetimeTicket = other.storage.lifetimeTicket;
+            other.storage.lifetimeTicket = 0;
+#endif
+            (void)other;
+        }
+
+        /**
+         * @brief Puntero y eliminador juntos; el eliminador vaco no ocupa espacio (EBO).
+         */
+        struct Storage : Deleter {
+            Storage(T* rawPtr) : Deleter(), ptr(rawPtr) {}
+
+            template<typename D>
+            Storage(T* rawPtr, D&& deleter) : Deleter(std::forward<D>(deleter)), ptr(rawPtr) {}
+
+            // Puntero al objeto gestionado.
+            T* ptr;
+#if ENGINE_TRACK_ALLOCATIONS
+            // Registro del tipo creado por `MakeUnique`, o nulo.
+            AllocationRecord* record = nullptr;
+#endif
+#if ENGINE_TRACK_LIFETIMES
+            // Entrada en `LifetimeTracker`, o 0.
+            LifetimeTicket lifetimeTicket = 0;
+#endif
+        };
+
+        Storage storage;
+    };
+
+    /**
+     * @brief Especializacin de `TUniquePtr` para arreglos de tamao conocido en ejecucin.
+     *
+     * Guarda el nmero de elementos junto al puntero, ofrece `operator[]` y se puede recorrer
+     * con `for` por rango. Pensado para buffers SoA (posiciones, velocidades) que los kernels
+     * vectorizados recorren de forma contigua.
+     *
+     * Si el eliminador acepta `(T*, size_t)`, recibe tambin el nmero de elementos (as lo usa
+     * `TAlignedArrayDelete`); si no, se llama solo con el puntero.
+     *
+     * @tparam T Tipo de elemento.
+     * @tparam Deleter Objeto funcin que libera el arreglo; debe ser un tipo clase.
+     */
+    template<typename T, typename Deleter>
+    class TUniquePtr<T[], Deleter>
+    {
+        static_assert(std::is_class_v<Deleter>, "TUniquePtr: el eliminador debe ser un tipo clase");
+
+    public:
+        using DeleterType = Deleter;
+
+        /**
+         * @brief Arreglo vaco.
+         */
+        TUniquePtr() : storage(nullptr), count(0) {}
+
+        /**
+         * @brief Toma un arreglo creado con `new T[elementCount]`.
+         * @param rawPtr Primer elemento.
+         * @param elementCount Nmero de elementos.
+         */
+        TUniquePtr(T* rawPtr, size_t elementCount) : storage(rawPtr), count(elementCount) {}
+
+        /**
+         * @brief Toma un arreglo y el eliminador que lo liberar.
+         */
+        TUniquePtr(T* rawPtr, size_t elementCount, const Deleter& deleter)
+            : storage(rawPtr, deleter), count(elementCount) {}
+
+        TUniquePtr(TUniquePtr&& other) noexcept
+            : storage(other.storage.ptr, std::move(other.getDeleter())), count(other.count) {
+            other.storage.ptr = nullptr;
+            other.count = 0;
+        }
+
+        TUniquePtr& operator=(TUniquePtr&& other) noexcept {
+            if (this != &other) {
+                reset();
+                storage.ptr = other.storage.ptr;
+                count = other.count;
+                other.storage.ptr = nullptr;
+                other.count = 0;
+                getDeleter() = std::move(other.getDeleter());
+            }
+            return *this;
+        }
+
+        TUniquePtr(const TUniquePtr&) = delete;
+        TUniquePtr& operator=(const TUniquePtr&) = delete;
+
+        ~TUniquePtr() {
+            destroy(storage.ptr, count);
+        }
+
+        /**
+         * @brief Acceso a un elemento; en depuracin se verifica el rango.
+         */
+        T& operator[](size_t index) const {
+            assert(index < count);
+            return storage.ptr[index];
+        }
+
+        /**
+         * @brief Primer elemento del arreglo.
+         */
+        T* get() const { return storage.ptr; }
+
+        /**
+         * @brief Nmero de elementos.
+         */
+        size_t size() const { return count; }
+
+        T* begin() const { return storage.ptr; }
+
+        T* end() const { return storage.ptr + count; }
+
+        /**
+         * @brief Suelta la propiedad del arreglo; el llamador debe liberarlo.
+         */
+        T* release() {
+            T* oldPtr = storage.ptr;
+            storage.ptr = nullptr;
+            count = 0;
+            return oldPtr;
+        }
+
+        /**
+         * @brief Libera el arreglo actual y toma otro.
+         */
+        void reset(T* rawPtr = nullptr, size_t elementCount = 0) {
+            T* oldPtr = storage.ptr;
+            size_t oldCount = count;
+            storage.ptr = rawPtr;
+            count = elementCount;
+            destroy(oldPtr, oldCount);
         }
 
+        bool isNull() const { return storage.ptr == nullptr; }
+
+        explicit operator bool() const { return storage.ptr != nullptr; }
+
+        Deleter& getDeleter() { return storage; }
+
+        const Deleter& getDeleter() const { return storage; }
+
     private:
-        // Puntero al objeto gestionado.
-        T* ptr;
+        void destroy(T* objects, size_t elementCount) {
+            if (!objects) {
+                return;
+            }
+            if constexpr (std::is_invocable_v<Deleter&, T*, size_t>) {
+                getDeleter()(objects, elementCount);
+            }
+            else {
+                (void)elementCount;
+                getDeleter()(objects);
+            }
+        }
+
+        struct Storage : Deleter {
+            Storage(T* rawPtr) : Deleter(), ptr(rawPtr) {}
+
+            template<typename D>
+            Storage(T* rawPtr, D&& deleter) : Deleter(std::forward<D>(deleter)), ptr(rawPtr) {}
+
+            // Primer elemento del arreglo.
+            T* ptr;
+        };
+
+        Storage storage;
+        // Nmero de elementos.
+        size_t count;
     };
 
+    /**
+     * @brief Indica si la lista de argumentos empieza por `std::allocator_arg`.
+     *
+     * Sirve para que `MakeUnique(std::allocator_arg, alloc, ...)` elija siempre la
+     * sobrecarga con asignador y no intente pasar la etiqueta al constructor de `T`.
+     */
+    template<typename... Args>
+    struct IsAllocatorArgFirst : std::false_type {};
+
+    template<typename First, typename... Rest>
+    struct IsAllocatorArgFirst<First, Rest...>
+        : std::is_same<std::decay_t<First>, std::allocator_arg_t> {};
+
     /**
      * @brief Funcin de utilidad para crear un `TUniquePtr`.
      *
@@ -155,11 +532,100 @@ namespace EngineUtilities {
      *
      * @tparam T Tipo del objeto a crear.
      * @tparam Args Tipos de los argumentos necesarios para el constructor del objeto.
-     * @param args Argumentos para el constructor del objeto.
+     * @param args Argumentos para el constructor del objeto; se reenvan sin copias.
      * @return Un nuevo `TUniquePtr` gestionando el objeto creado.
      */
-    template<typename T, typename... Args>
-    TUniquePtr<T> MakeUnique(Args... args) {
-        return TUniquePtr<T>(new T(args...));
+    template<typename T, typename... Args,
+             typename = std::enable_if_t<!std::is_array_v<T> && !IsAllocatorArgFirst<Args...>::value>>
+    TUniquePtr<T> MakeUnique(Args&&... args) {
+        TUniquePtr<T> result(new T(std::forward<Args>(args)...));
+        if constexpr (kTrackAllocations) {
+            result.setAllocationRecord(AllocationTracker::recordFor<T>());
+        }
+        if constexpr (kTrackLifetimes) {
+            result.setLifetimeTicket(LifetimeTracker::onCreate(result.get()));
+        }
+        return result;
     }
+
+    /**
+     * @brief Crea un objeto con un asignador y lo gestiona con un `TUniquePtr`.
+     *
+     * Sigue la convencin de la STL: el primer argumento es `std::allocator_arg`. El objeto
+     * se construye en memoria del asignador y, al destruirse el `TUniquePtr`, la memoria
+     * vuelve a l. Sirve para arenas por frame y pools con propiedad RAII.
+     *
+     * @tparam T Tipo del objeto a crear.
+     * @param alloc Asignador estilo STL (se reasocia a `T` si es de otro tipo).
+     * @param args Argumentos para el constructor del objeto; se reenvan sin copias.
+     * @return Un `TUniquePtr` cuyo eliminador devuelve la memoria a `alloc`.
+     */
+    template<typename T, typename Alloc, typename... Args>
+    TUniquePtr<T, TAllocatorDelete<T, Alloc>> MakeUnique(std::allocator_arg_t, const Alloc& alloc, Args&&... args) {
+        using DeleterType = TAllocatorDelete<T, Alloc>;
+        typename DeleterType::AllocatorType typedAlloc(alloc);
+        T* memory = DeleterType::Traits::allocate(typedAlloc, 1);
+        try {
+            ::new (static_cast<void*>(memory)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            DeleterType::Traits::deallocate(typedAlloc, memory, 1);
+            throw;
+        }
+        TUniquePtr<T, DeleterType> result(memory, DeleterType(alloc));
+        if constexpr (kTrackAllocations) {
+            result.setAllocationRecord(AllocationTracker::recordFor<T>());
+        }
+        if constexpr (kTrackLifetimes) {
+            result.setLifetimeTicket(LifetimeTracker::onCreate(result.get()));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Crea un arreglo de `count` elementos inicializados por valor.
+     *
+     * @tparam T Tipo arreglo, por ejemplo `float[]`.
+     * @param count Nmero de elementos.
+     */
+    template<typename T, typename = std::enable_if_t<std::is_array_v<T> && std::extent_v<T> == 0>>
+    TUniquePtr<T> MakeUnique(size_t count) {
+        using Element = std::remove_extent_t<T>;
+        return TUniquePtr<T>(new Element[count](), count);
+    }
+
+    /**
+     * @brief Crea un arreglo de `count` elementos con el inicio alineado a `alignment` bytes.
+     *
+     * Para buffers que se procesan con SSE/AVX (16, 32 o 64 bytes). Los elementos se
+     * inicializan por valor; una alineacin menor que `alignof(T)` se eleva a esta.
+     *
+     * @tparam T Tipo arreglo, por ejemplo `float[]`.
+     * @param count Nmero de elementos.
+     * @param alignment Alineacin en bytes; debe ser potencia de dos.
+     */
+    template<typename T, typename = std::enable_if_t<std::is_array_v<T> && std::extent_v<T> == 0>>
+    TUniquePtr<T, TAlignedArrayDelete<std::remove_extent_t<T>>> MakeUniqueAligned(size_t count, size_t alignment) {
+        using Element = std::remove_extent_t<T>;
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        if (alignment < alignof(Element)) {
+            alignment = alignof(Element);
+        }
+        if (count > size_t(-1) / sizeof(Element)) {
+            throw std::bad_array_new_length();
+        }
+        void* memory = ::operator new(count * sizeof(Element), std::align_val_t(alignment));
+        Element* elements = static_cast<Element*>(memory);
+        try {
+            std::uninitialized_value_construct_n(elements, count);
+        }
+        catch (...) {
+            ::operator delete(memory, std::align_val_t(alignment));
+            throw;
+        }
+        return TUniquePtr<T, TAlignedArrayDelete<Element>>(elements, count, TAlignedArrayDelete<Element>(alignment));
+    }
+
+    static_assert(kTrackAllocations || kTrackLifetimes || sizeof(TUniquePtr<int>) == sizeof(int*),
+                  "TUniquePtr con el eliminador por defecto debe ocupar un puntero");
 }
@@ -9,11 +9,19 @@ namespace EngineUtilities {
      * `TWeakPointer` ofrece una forma segura de observar un objeto gestionado por un `TSharedPointer`
      * sin prolongar su vida til. A diferencia de `TSharedPointer`, no afecta el conteo de referencias.
      * Si el objeto gestionado se ha destruido, el `TWeakPointer` se considerar "expirado" y no proporcionar acceso al objeto.
+     *
+     * Cada `TWeakPointer` mantiene vivo el bloque de control (cuenta dbil), nunca el objeto.
+     * Por eso `lock()` puede consultar el bloque aunque el objeto ya se haya destruido, y los
+     * punteros dbiles sirven para cachs y tablas de bsqueda por frame.
+     *
+     * @tparam Policy Debe coincidir con la poltica de conteo del `TSharedPointer` observado.
      */
-    template<typename T>
+    template<typename T, typename Policy = SingleThreadRefCount>
     class TWeakPointer
     {
     public:
+        using ControlBlockType = TControlBlock<Policy>;
+
         /**
          * @brief Constructor por defecto que inicializa el puntero y el recuento de referencias a nullptr.
          */
@@ -27,8 +35,94 @@ namespace EngineUtilities {
          *
          * @param sharedPtr El `TSharedPointer` a partir del cual se observar el objeto.
          */
-        TWeakPointer(const TSharedPointer<T>& sharedPtr)
-            : ptr(sharedPtr.ptr), refCount(sharedPtr.refCount) {}
+        TWeakPointer(const TSharedPointer<T, Policy>& sharedPtr)
+            : ptr(sharedPtr.ptr), refCount(sharedPtr.refCount)
+        {
+            if (refCount)
+            {
+                refCount->addWeak();
+            }
+        }
+
+        /**
+         * @brief Constructor de copia; suma una referencia dbil.
+         * @param other Otro `TWeakPointer`.
+         */
+        TWeakPointer(const TWeakPointer<T, Policy>& other)
+            : ptr(other.ptr), refCount(other.refCount)
+        {
+            if (refCount)
+            {
+                refCount->addWeak();
+            }
+        }
+
+        /**
+         * @brief Constructor de movimiento; el original queda vaco.
+         * @param other Otro `TWeakPointer`.
+         */
+        TWeakPointer(TWeakPointer<T, Policy>&& other) noexcept
+            : ptr(other.ptr), refCount(other.refCount)
+        {
+            other.ptr = nullptr;
+            other.refCount = nullptr;
+        }
+
+        /**
+         * @brief Asignacin por copia.
+         * @param other Otro `TWeakPointer`.
+         * @return Referencia a este `TWeakPointer`.
+         */
+        TWeakPointer<T, Policy>& operator=(const TWeakPointer<T, Policy>& other)
+        {
+            if (this != &other)
+            {
+                if (other.refCount)
+                {
+                    other.refCount->addWeak();
+                }
+                release();
+                ptr = other.ptr;
+                refCount = other.refCount;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Asignacin por movimiento.
+         * @param other Otro `TWeakPointer`, que queda vaco.
+         * @return Referencia a este `TWeakPointer`.
+         */
+        TWeakPointer<T, Policy>& operator=(TWeakPointer<T, Policy>&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                ptr = other.ptr;
+                refCount = other.refCount;
+                other.ptr = nullptr;
+                other.refCount = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Asignacin desde un `TSharedPointer`.
+         * @param sharedPtr Puntero compartido a observar.
+         * @return Referencia a este `TWeakPointer`.
+         */
+        TWeakPointer<T, Policy>& operator=(const TSharedPointer<T, Policy>& sharedPtr)
+        {
+            return *this = TWeakPointer<T, Policy>(sharedPtr);
+        }
+
+        /**
+         * @brief Destructor; suelta la referencia dbil y, si era la ltima, el bloque.
+         */
+        ~TWeakPointer()
+        {
+            release();
+        }
 
         /**
          * @brief Convertir el `TWeakPointer` a un `TSharedPointer`.
@@ -36,25 +130,57 @@ namespace EngineUtilities {
          * Este mtodo intenta crear un `TSharedPointer` a partir del `TWeakPointer`.
          * Si el objeto gestionado an existe (es decir, no ha sido destruido),
          * se devuelve un `TSharedPointer` vlido. Si no, se devuelve un `TSharedPointer` nulo.
+         * La comprobacin y el incremento son una sola operacin, as que no hay ventana
+         * en la que otro hilo destruya el objeto entre ambos pasos.
          *
          * @return Un `TSharedPointer` al objeto gestionado, o nullptr si el objeto ha sido destruido.
          */
-        TSharedPointer<T> lock() const
+        TSharedPointer<T, Policy> lock() const
         {
-            // Si el objeto an existe (el recuento de referencias es mayor que cero)
-            if (refCount && *refCount > 0)
+            if (refCount && refCount->tryAddStrong())
             {
-                return TSharedPointer<T>(ptr, refCount);
+                using Shared = TSharedPointer<T, Policy>;
+                return Shared(ptr, refCount, typename Shared::AdoptRef{});
             }
-            return TSharedPointer<T>();
+            return TSharedPointer<T, Policy>();
+        }
+
+        /**
+         * @brief Indica si el objeto observado ya fue destruido.
+         * @return `true` si no hay objeto, o si ya no quedan referencias fuertes.
+         */
+        bool expired() const
+        {
+            return !refCount || refCount->strongRefs() == 0;
+        }
+
+        /**
+         * @brief Deja de observar el objeto.
+         */
+        void reset()
+        {
+            release();
+            ptr = nullptr;
+            refCount = nullptr;
         }
 
         // Hacer que `TSharedPointer` sea amigo para que pueda acceder a los miembros privados.
-        template<typename U>
+        template<typename U, typename P>
         friend class TSharedPointer;
 
     private:
+        /**
+         * @brief Suelta la referencia dbil actual, si la hay.
+         */
+        void release()
+        {
+            if (refCount)
+            {
+                refCount->releaseWeak();
+            }
+        }
+
         T* ptr;       ///< Puntero al objeto observado.
-        int* refCount; ///< Puntero al recuento de referencias del `TSharedPointer` original.
+        ControlBlockType* refCount; ///< Bloque de control con el recuento del `TSharedPointer` original.
     };
 }
@@ -0,0 +1,114 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+#include "Math/Mat4.h"
+#include "Render/Material.h"
+#include "Render/Mesh.h"
+#include "Physics/AabbTree.h"
+
+/**
+ * @class MeshRenderer
+ * @brief Componente que dibuja una malla 3D (`Mesh`) con `MeshPipeline`.
+ *
+ * La malla se comparte: muchos actores pueden dibujar la misma y solo se sube una vez. Su
+ * matriz de mundo es la del `Transform` vinculado (interpolada, en el plano z = 0) por la
+ * matriz local del componente, que pone la profundidad, los giros fuera del plano y la escala
+ * en z.
+ *
+ * `Picking` guarda la sombra de su caja en el plano para encontrarla con rayos.
+ */
+class
+MeshRenderer : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::RENDERER;
+
+	MeshRenderer() : Component(ComponentType::RENDERER) {}
+
+	/**
+	 * @brief Sale de `Picking` si todava estaba.
+	 */
+	~MeshRenderer() override;
+
+	void
+	update(float deltaTime) override {}
+
+	/**
+	 * @brief Agrega la malla con `RenderCommandBuffer::drawMesh`, si tiene.
+	 */
+	void
+	render(RenderCommandBuffer& commands) override;
+
+	void
+	setMesh(EngineUtilities::TSharedPointer<Mesh> mesh) { m_mesh = std::move(mesh); markChanged(); }
+
+	const EngineUtilities::TSharedPointer<Mesh>&
+	getMesh() const { return m_mesh; }
+
+	/**
+	 * @brief Material compartido; sin l la malla es blanca. `setColor` lo tie.
+	 */
+	void
+	setMaterial(EngineUtilities::TSharedPointer<Material> material) { m_material = std::move(material); markChanged(); }
+
+	const EngineUtilities::TSharedPointer<Material>&
+	getMaterial() const { return m_material; }
+
+	/**
+	 * @brief Vincula el `Transform` de la misma entidad; sin l la malla se dibuja solo con la
+	 *        matriz local.
+	 */
+	void
+	setTransform(Transform* transform) { m_transform = transform; markChanged(); }
+
+	void
+	setLocalMatrix(const Mat4& local) { m_local = local; markChanged(); }
+
+	const Mat4&
+	getLocalMatrix() const { return m_local; }
+
+	void
+	setColor(sf::Color color) { m_color = color; markChanged(); }
+
+	sf::Color
+	getColor() const { return m_color; }
+
+	/**
+	 * @brief Marca la malla como fija (paredes, terreno): se graba con
+	 *        `RenderCommandBuffer::drawStaticMesh` y su sombra se guarda entre frames. Moverla
+	 *        sigue funcionando, pero rehace las sombras estticas de todas.
+	 */
+	void
+	setStatic(bool isStatic) { m_static = isStatic; markChanged(); }
+
+	bool
+	isStatic() const { return m_static; }
+
+	/**
+	 * @brief Matriz de mundo con el `Transform` del paso, sin interpolar: la de las consultas.
+	 */
+	Mat4
+	getWorldMatrix() const { return m_transform ? Mat4::fromTransform(m_transform->getWorldTransform()) * m_local : m_local; }
+
+	/**
+	 * @brief Corte ms cercano del rayo de mundo `origin + t * direction` con la malla, con `t`
+	 *        en [0, `maxDistance`].
+	 */
+	bool
+	raycast(const sf::Vector3f& origin, const sf::Vector3f& direction, float maxDistance, float& distance) const;
+
+private:
+	friend class Picking;
+
+	EngineUtilities::TSharedPointer<Mesh> m_mesh;
+	EngineUtilities::TSharedPointer<Material> m_material;
+	Transform* m_transform = nullptr;   ///< Transform de la misma entidad, o nulo.
+	Mat4 m_local;                       ///< Se aplica antes que la matriz del `Transform`.
+	sf::Color m_color = sf::Color::White;
+	bool m_static = false;
+	uint32_t m_pickProxy = AabbTree::kNullNode; ///< Hoja en el rbol de `Picking`, si est.
+	Aabb m_pickBounds;                  ///< Sombra de la caja en el plano en el ltimo `syncMeshes`.
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Nombre internado en `NameTable`: comparar dos es comparar enteros. 0 es ningn nombre.
+ */
+using NameId = uint32_t;
+
+constexpr NameId kNoName = 0;
+
+/**
+ * @brief FNV-1a de 32 bits de `name`, sin el 0 (reservado para `kNoName`). Es el id que
+ *        `NameTable::intern` da a un nombre mientras no choque con otro.
+ */
+constexpr NameId
+nameHash(std::string_view name) {
+	uint32_t hash = 0x811C9DC5u;
+	for (char c : name) {
+		hash = (hash ^ static_cast<unsigned char>(c)) * 0x01000193u;
+	}
+	return hash == kNoName ? 1u : hash;
+}
+
+/**
+ * @class NameTable
+ * @brief Tabla global de nombres internados (actores, prefabs, etiquetas).
+ *
+ * Cada texto distinto se guarda una sola vez y recibe un `NameId`: su `nameHash`, salvo que
+ * otro texto ya tenga ese valor. Esos choques se detectan comparando el texto y se resuelven
+ * probando el siguiente id libre, as que dos nombres distintos nunca comparten id; el precio
+ * es que el id de un nombre que choc depende del orden en que se intern. Los ids valen
+ * dentro de la ejecucin: a disco y a la red va el texto.
+ *
+ * Los textos no se mueven ni se borran, as que las `std::string_view` de `view` valen
+ * mientras viva la tabla. Internar un nombre nuevo toma el candado exclusivo; buscar y leer,
+ * el compartido. Es un servicio (`TService<NameTable>`).
+ */
+class
+NameTable {
+public:
+	/**
+	 * @brief Id de `name`, agregndolo si es nuevo.
+	 */
+	NameId
+	intern(std::string_view name);
+
+	/**
+	 * @brief Id de `name` si ya se intern, o `kNoName`. No agrega nada.
+	 */
+	NameId
+	find(std::string_view name) const;
+
+	/**
+	 * @brief Texto de `id`; vaco para `kNoName` o un id que no sali de esta tabla.
+	 */
+	std::string_view
+	view(NameId id) const;
+
+	/**
+	 * @brief Nombres distintos internados.
+	 */
+	size_t
+	size() const;
+
+	/**
+	 * @brief Nombres cuyo `nameHash` ya estaba tomado por otro texto.
+	 */
+	uint32_t
+	collisions() const;
+
+	/**
+	 * @brief La tabla del motor.
+	 */
+	static NameTable&
+	instance();
+
+private:
+	/**
+	 * @brief Id de `name` o el primer id libre de su sonda, con el candado ya tomado.
+	 * @param found Sale en verdadero si `name` ya estaba.
+	 */
+	NameId
+	probe(std::string_view name, bool& found) const;
+
+	std::unordered_map<NameId, std::string_view> m_names;  ///< Apuntan a `m_storage`.
+	std::deque<std::string> m_storage;                     ///< `deque`: los textos no se mueven al crecer.
+	uint32_t m_collisions = 0;
+	mutable std::shared_mutex m_mutex;
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Navigation/NavGrid.h"
+
+class JobSystem;
+
+/**
+ * @brief Componente de datos de un agente que sigue un `FlowField`: el sistema que lo mueve
+ *        apunta su `SteeringAgent::target` a `lookahead` unidades en la direccin del campo.
+ */
+struct FlowFollower {
+	float lookahead = 32.0f;
+};
+
+/**
+ * @class FlowField
+ * @brief Campo de direcciones hacia un solo destino sobre el `NavGrid`: cualquier nmero de
+ *        agentes lo consulta en O(1), sin buscar caminos propios.
+ *
+ * Un Dijkstra desde la celda destino (8 vecinos, sin cortar esquinas, con los costos de la
+ * grilla) deja en cada celda el costo hasta el destino; luego cada celda guarda hacia cul
+ * de sus vecinos baja ms, como un ndice de 0 a 7. Esa segunda pasada va por filas en el
+ * `JobSystem`.
+ *
+ * La construccin es incremental: cada `update` expande a lo ms `budget` celdas, sobre una
+ * copia de la grilla, y mientras tanto `direction` sigue respondiendo con el campo anterior.
+ * Cambiar el destino dentro de la misma celda no reconstruye nada; cambiarlo a otra, o que
+ * cambie `NavGrid::version`, empieza de nuevo.
+ *
+ * `setTarget` y `update` van en un solo hilo; `direction` puede llamarse desde varios
+ * mientras no corra `update`.
+ */
+class
+FlowField {
+public:
+	static constexpr uint8_t kNoDirection = 0xFF;   ///< Celda destino, bloqueada o sin camino.
+	static constexpr size_t kDefaultBudget = 16384; ///< Celdas de Dijkstra por `update`.
+
+	/**
+	 * @brief Pide un campo hacia `target`; se arma en los `update` siguientes.
+	 */
+	void
+	setTarget(const sf::Vector2f& target) { m_requested = target; m_hasRequest = true; }
+
+	/**
+	 * @brief Avanza la construccin sobre `grid`.
+	 * @return `true` si en esta llamada qued listo un campo nuevo.
+	 */
+	bool
+	update(const NavGrid& grid, JobSystem& jobs, size_t budget = kDefaultBudget);
+
+	/**
+	 * @brief Direccin unitaria del campo en `position`; cero fuera de la grilla, en la celda
+	 *        destino o donde el destino no se alcanza.
+	 */
+	sf::Vector2f
+	direction(const sf::Vector2f& position) const;
+
+	/**
+	 * @brief Hay un campo terminado para consultar.
+	 */
+	bool
+	isReady() const { return !m_ready.directions.empty(); }
+
+	bool
+	isBuilding() const { return m_building; }
+
+	/**
+	 * @brief Destino del campo listo.
+	 */
+	const sf::Vector2f&
+	target() const { return m_ready.target; }
+
+private:
+	/**
+	 * @brief Campo terminado, con las medidas de la grilla de la que sali.
+	 */
+	struct Field {
+		std::vector<uint8_t> directions;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		float cellSize = 1.0f;
+		sf::Vector2f origin;
+		sf::Vector2f target;
+		uint32_t targetCell = 0;
+		uint32_t version = 0;    ///< `NavGrid::version` de la grilla.
+	};
+
+	struct Open {
+		float cost;
+		uint32_t cell;
+	};
+
+	/**
+	 * @brief Empieza un Dijkstra nuevo desde `cell` sobre una copia de `grid`.
+	 */
+	void
+	beginBuild(const NavGrid& grid, uint32_t cell, const sf::Vector2f& target);
+
+	/**
+	 * @brief Elige la direccin de cada celda y publica el campo.
+	 */
+	void
+	finishBuild(JobSystem& jobs);
+
+	Field m_ready;
+	sf::Vector2f m_requested;
+	bool m_hasRequest = false;
+
+	NavGrid m_grid;                  ///< Copia de la grilla que se est recorriendo.
+	std::vector<float> m_cost;       ///< Costo hasta el destino; infinito sin visitar.
+	std::vector<Open> m_open;        ///< Montculo binario por `cost`.
+	std::vector<uint8_t> m_buildDirections; ///< Direcciones del campo en construccin.
+	sf::Vector2f m_buildTarget;
+	uint32_t m_buildCell = 0;
+	bool m_building = false;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+
+/**
+ * @class NavGrid
+ * @brief Cuadrcula de navegacin: un costo por celda, 0 si no se puede pasar.
+ *
+ * Las celdas son cuadradas, de `cellSize` unidades de mundo, y la `(0, 0)` empieza en
+ * `origin`. El costo multiplica lo que cuesta entrar a la celda (1 es terreno normal). Cada
+ * cambio sube `version`, para que los resultados calculados sobre la grilla anterior se
+ * reconozcan.
+ *
+ * Un solo hilo la modifica; `Pathfinder` busca sobre una copia. Es un servicio
+ * (`TService<NavGrid>`).
+ */
+class
+NavGrid {
+public:
+	static constexpr uint8_t kBlocked = 0;
+	static constexpr uint8_t kDefaultCost = 1;
+
+	NavGrid() = default;
+
+	NavGrid(uint32_t width, uint32_t height, float cellSize, const sf::Vector2f& origin = sf::Vector2f()) {
+		resize(width, height, cellSize, origin);
+	}
+
+	/**
+	 * @brief `width` x `height` celdas de costo `kDefaultCost`.
+	 */
+	void
+	resize(uint32_t width, uint32_t height, float cellSize, const sf::Vector2f& origin = sf::Vector2f());
+
+	void
+	setCost(uint32_t x, uint32_t y, uint8_t cost);
+
+	/**
+	 * @brief Pone `cost` en todas las celdas que toca `area` (en coordenadas de mundo).
+	 */
+	void
+	fill(const sf::FloatRect& area, uint8_t cost);
+
+	uint8_t
+	cost(uint32_t x, uint32_t y) const { return m_costs[indexOf(x, y)]; }
+
+	uint8_t
+	costAt(uint32_t index) const { return m_costs[index]; }
+
+	/**
+	 * @brief Dentro de la grilla y con costo distinto de 0.
+	 */
+	bool
+	isWalkable(int32_t x, int32_t y) const {
+		return x >= 0 && y >= 0 && uint32_t(x) < m_width && uint32_t(y) < m_height && m_costs[indexOf(x, y)] != kBlocked;
+	}
+
+	/**
+	 * @brief Celda que contiene `position`.
+	 * @return `false` si cae fuera de la grilla.
+	 */
+	bool
+	cellAt(const sf::Vector2f& position, uint32_t& x, uint32_t& y) const;
+
+	uint32_t
+	indexOf(uint32_t x, uint32_t y) const { return y * m_width + x; }
+
+	/**
+	 * @brief Centro de la celda, en coordenadas de mundo.
+	 */
+	sf::Vector2f
+	centerOf(uint32_t x, uint32_t y) const {
+		return sf::Vector2f(m_origin.x + (float(x) + 0.5f) * m_cellSize, m_origin.y + (float(y) + 0.5f) * m_cellSize);
+	}
+
+	uint32_t
+	width() const { return m_width; }
+
+	uint32_t
+	height() const { return m_height; }
+
+	size_t
+	cellCount() const { return m_costs.size(); }
+
+	float
+	cellSize() const { return m_cellSize; }
+
+	const sf::Vector2f&
+	origin() const { return m_origin; }
+
+	/**
+	 * @brief Sube con cada cambio de tamao o de costo.
+	 */
+	uint32_t
+	version() const { return m_version; }
+
+private:
+	std::vector<uint8_t> m_costs;
+	uint32_t m_width = 0;
+	uint32_t m_height = 0;
+	float m_cellSize = 1.0f;
+	sf::Vector2f m_origin;
+	uint32_t m_version = 0;
+};
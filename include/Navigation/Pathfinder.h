@@ -0,0 +1,191 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+#include "Jobs/JobSystem.h"
+#include "Navigation/NavGrid.h"
+#include "PathLibrary.h"
+
+/**
+ * @class Pathfinder
+ * @brief Bsquedas A* sobre el `NavGrid` en los hilos de `JobSystem`; el resultado llega al
+ *        `Path` de quien lo pidi.
+ *
+ * `request` solo anota el pedido. `dispatch` junta los del frame en un lote: los que ya estn
+ * en la cach se resuelven ah mismo y el resto se reparte en trabajos de
+ * `kRequestsPerJob`, todos sobre una copia de la grilla, as que cambiarla despus no afecta
+ * a las bsquedas en curso. `collect` entrega los lotes terminados con
+ * `PathLibrary::setPoints`: hasta entonces los agentes siguen su recorrido anterior y el
+ * bucle principal nunca espera.
+ *
+ * Cada bsqueda usa un `SearchNodes` de una reserva (uno por trabajo en curso) con los
+ * arreglos ya del tamao de la grilla: un sello por bsqueda evita limpiarlos. La lista
+ * abierta es un montculo binario con entradas viejas que se saltan al salir. Los vecinos
+ * son los 8 alrededor sin cortar esquinas; la heurstica es la distancia octil.
+ *
+ * La cach LRU guarda los ltimos `kCacheCapacity` caminos por par de celdas (inicio y
+ * destino); un cambio de `NavGrid::version` la vaca. Un par repetido dentro del lote se
+ * busca una vez.
+ *
+ * `request`, `dispatch` y `collect` van en el hilo principal; es un servicio
+ * (`TService<Pathfinder>`).
+ */
+class
+Pathfinder {
+public:
+	static constexpr size_t kRequestsPerJob = 8;
+	static constexpr size_t kCacheCapacity = 256;
+
+	Pathfinder() : m_jobs(EngineUtilities::TService<JobSystem>::instance()) {}
+
+	/**
+	 * @brief Espera los lotes en curso: sus trabajos escriben en este objeto.
+	 */
+	~Pathfinder();
+
+	Pathfinder(const Pathfinder&) = delete;
+	Pathfinder& operator=(const Pathfinder&) = delete;
+
+	/**
+	 * @brief Pide un camino de `start` a `goal`; al encontrarse reemplaza los puntos de `into`.
+	 * @return `false` si alguno de los dos cae fuera de la grilla o en una celda bloqueada.
+	 */
+	bool
+	request(const sf::Vector2f& start, const sf::Vector2f& goal, PathHandle into);
+
+	/**
+	 * @brief Lanza los pedidos anotados desde el ltimo `dispatch`.
+	 */
+	void
+	dispatch();
+
+	/**
+	 * @brief Entrega los caminos de los lotes terminados.
+	 * @return Cuntos `Path` se actualizaron; los pedidos sin camino dejan el suyo igual.
+	 */
+	size_t
+	collect();
+
+	/**
+	 * @brief Lanza lo anotado, espera todos los lotes y los entrega.
+	 */
+	void
+	finishAll();
+
+	/**
+	 * @brief Pedidos anotados o en curso, sin entregar.
+	 */
+	size_t
+	pendingCount() const;
+
+	size_t
+	cacheHits() const { return m_cacheHits; }
+
+	size_t
+	cacheMisses() const { return m_cacheMisses; }
+
+	/**
+	 * @brief Memoria de una bsqueda, reutilizable entre bsquedas sobre la misma grilla.
+	 */
+	struct SearchNodes {
+		std::vector<float> cost;        ///< Costo desde el inicio.
+		std::vector<uint32_t> parent;
+		std::vector<uint32_t> stamp;    ///< Bsqueda en la que se toc el nodo; otro valor es "sin visitar".
+		std::vector<uint8_t> closed;
+		struct Open {
+			float priority;
+			uint32_t node;
+		};
+		std::vector<Open> open;         ///< Montculo binario por `priority`.
+		std::vector<uint32_t> cells;    ///< Camino de la ltima bsqueda de `solve`.
+		uint32_t search = 0;
+	};
+
+	/**
+	 * @brief A* de la celda `start` a la `goal` (ndices de `grid`).
+	 * @return `false` si no hay camino; si no, `cells` trae las celdas desde `start` hasta
+	 *         `goal`, incluidas.
+	 */
+	static bool
+	findPath(const NavGrid& grid, uint32_t start, uint32_t goal, SearchNodes& nodes, std::vector<uint32_t>& cells);
+
+private:
+	static constexpr uint32_t kNoQuery = ~0u;
+
+	struct Query {
+		uint32_t startCell = 0;
+		uint32_t goalCell = 0;
+		sf::Vector2f goal;
+		PathHandle into;
+		uint32_t sameAs = kNoQuery;        ///< Otro pedido del lote con el mismo par, que se busca por los dos.
+		bool found = false;
+		std::vector<sf::Vector2f> points;  ///< Centros de las celdas donde cambia la direccin.
+	};
+
+	/**
+	 * @brief Pedidos lanzados juntos, con la grilla como estaba al lanzarlos.
+	 */
+	struct Batch {
+		NavGrid grid;
+		std::vector<Query> queries;
+		std::atomic<uint32_t> remaining{ 0 };  ///< Trabajos sin terminar; 0 es listo.
+	};
+
+	static uint64_t
+	cacheKey(uint32_t startCell, uint32_t goalCell) { return (uint64_t(startCell) << 32) | goalCell; }
+
+	/**
+	 * @brief Resuelve `query` con A* sobre `grid`.
+	 */
+	static void
+	solve(const NavGrid& grid, Query& query, SearchNodes& nodes);
+
+	SearchNodes*
+	acquireNodes();
+
+	void
+	releaseNodes(SearchNodes* nodes);
+
+	/**
+	 * @brief Guarda el camino del par; si la cach est llena, olvida el menos usado.
+	 */
+	void
+	remember(uint64_t key, const std::vector<sf::Vector2f>& points);
+
+	/**
+	 * @brief Camino guardado del par, marcado como el ms reciente; nulo si no est.
+	 */
+	const std::vector<sf::Vector2f>*
+	recall(uint64_t key);
+
+	/**
+	 * @brief Pone `points` en `query.into`, con el ltimo punto en el destino exacto.
+	 */
+	static bool
+	deliver(const Query& query, const std::vector<sf::Vector2f>& points);
+
+	struct CacheEntry {
+		uint64_t key;
+		std::vector<sf::Vector2f> points;
+	};
+
+	JobSystem& m_jobs;
+	JobCounter m_counter;                                      ///< Trabajos de bsqueda en curso.
+	std::vector<Query> m_queued;                               ///< Anotados desde el ltimo `dispatch`.
+	std::vector<Query> m_ready;                                ///< Resueltos por la cach en `dispatch`.
+	std::vector<EngineUtilities::TUniquePtr<Batch>> m_batches; ///< En curso o sin entregar.
+
+	std::mutex m_nodesMutex;                                   ///< Protege `m_freeNodes`.
+	std::vector<EngineUtilities::TUniquePtr<SearchNodes>> m_nodes;
+	std::vector<SearchNodes*> m_freeNodes;
+
+	std::list<CacheEntry> m_cache;                             ///< Del ms reciente al ms viejo.
+	std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> m_cacheIndex;
+	uint32_t m_cacheVersion = 0;                               ///< `NavGrid::version` de lo que hay en la cach.
+	size_t m_cacheHits = 0;
+	size_t m_cacheMisses = 0;
+};
@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file BitStream.h
+ * @brief Escritura y lectura de campos de cualquier nmero de bits sobre un bfer de bytes,
+ *        para los mensajes de red: un bool ocupa un bit y una posicin cuantizada, los que pida.
+ *
+ * Los bits se acomodan del menos significativo al ms significativo de cada byte, en el orden
+ * en que se escriben. El bfer es del que llama y no crece: escribir o leer ms all de
+ * su capacidad no toca memoria ajena, solo marca `overflowed` y deja el mensaje invlido.
+ */
+
+/**
+ * @brief `value` en `[min, max]` a un entero de `bits` bits, al ms cercano.
+ */
+inline uint32_t
+quantizeRange(float value, float min, float max, unsigned bits) {
+	uint32_t steps = bits >= 32 ? UINT32_MAX : (1u << bits) - 1;
+	float unit = (std::clamp(value, min, max) - min) / (max - min);
+	return static_cast<uint32_t>(std::lround(unit * static_cast<float>(steps)));
+}
+
+/**
+ * @brief Inverso de `quantizeRange`.
+ */
+inline float
+dequantizeRange(uint32_t quantized, float min, float max, unsigned bits) {
+	uint32_t steps = bits >= 32 ? UINT32_MAX : (1u << bits) - 1;
+	return min + (max - min) * static_cast<float>(quantized) / static_cast<float>(steps);
+}
+
+/**
+ * @class BitWriter
+ * @brief Escribe campos de bits en `[data, data + capacity)`.
+ */
+class
+BitWriter {
+public:
+	BitWriter(unsigned char* data, size_t capacity) : m_data(data), m_capacity(capacity) {}
+
+	/**
+	 * @brief Los `bits` bits bajos de `value` (de 1 a 32).
+	 */
+	void
+	write(uint32_t value, unsigned bits) {
+		if (m_bits + bits > m_capacity * 8) {
+			m_overflowed = true;
+			return;
+		}
+		uint64_t masked = bits >= 32 ? value : value & ((1u << bits) - 1);
+		while (bits > 0) {
+			size_t byte = m_bits >> 3;
+			unsigned offset = static_cast<unsigned>(m_bits & 7);
+			unsigned taken = std::min(bits, 8 - offset);
+			if (offset == 0) {
+				m_data[byte] = 0;
+			}
+			m_data[byte] |= static_cast<unsigned char>((masked & ((1u << taken) - 1)) << offset);
+			masked >>= taken;
+			bits -= taken;
+			m_bits += taken;
+		}
+	}
+
+	void
+	writeBool(bool value) { write(value ? 1u : 0u, 1); }
+
+	/**
+	 * @brief `value` en complemento a dos de `bits` bits; debe caber (`fitsSigned`).
+	 */
+	void
+	writeSigned(int32_t value, unsigned bits) { write(static_cast<uint32_t>(value), bits); }
+
+	/**
+	 * @brief Entero sin signo con 2 bits de tamao: 4, 8, 16 o 32 bits segn lo que ocupe.
+	 *        Los conteos y distancias entre ids suelen caber en los primeros.
+	 */
+	void
+	writeVarint(uint32_t value) {
+		unsigned size = value < (1u << 4) ? 0 : value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : 3;
+		write(size, 2);
+		write(value, 4u << size);
+	}
+
+	void
+	writeFloat(float value, float min, float max, unsigned bits) { write(quantizeRange(value, min, max, bits), bits); }
+
+	/**
+	 * @brief Bytes usados, contando el ltimo a medias.
+	 */
+	size_t
+	bytes() const { return (m_bits + 7) >> 3; }
+
+	size_t
+	bits() const { return m_bits; }
+
+	bool
+	overflowed() const { return m_overflowed; }
+
+	static bool
+	fitsSigned(int64_t value, unsigned bits) {
+		int64_t limit = int64_t(1) << (bits - 1);
+		return value >= -limit && value < limit;
+	}
+
+private:
+	unsigned char* m_data;
+	size_t m_capacity;
+	size_t m_bits = 0;
+	bool m_overflowed = false;
+};
+
+/**
+ * @class BitReader
+ * @brief Lee lo que escribi un `BitWriter`, en el mismo orden.
+ */
+class
+BitReader {
+public:
+	BitReader(const unsigned char* data, size_t size) : m_data(data), m_size(size) {}
+
+	/**
+	 * @brief Los siguientes `bits` bits (de 1 a 32); 0 si se acab el mensaje.
+	 */
+	uint32_t
+	read(unsigned bits) {
+		if (m_bits + bits > m_size * 8) {
+			m_overflowed = true;
+			return 0;
+		}
+		uint64_t value = 0;
+		unsigned done = 0;
+		while (done < bits) {
+			size_t byte = m_bits >> 3;
+			unsigned offset = static_cast<unsigned>(m_bits & 7);
+			unsigned taken = std::min(bits - done, 8 - offset);
+			value |= static_cast<uint64_t>((m_data[byte] >> offset) & ((1u << taken) - 1)) << done;
+			done += taken;
+			m_bits += taken;
+		}
+		return static_cast<uint32_t>(value);
+	}
+
+	bool
+	readBool() { return read(1) != 0; }
+
+	int32_t
+	readSigned(unsigned bits) {
+		uint32_t value = read(bits);
+		uint32_t sign = 1u << (bits - 1);
+		return bits >= 32 ? static_cast<int32_t>(value) : static_cast<int32_t>((value ^ sign) - sign);
+	}
+
+	uint32_t
+	readVarint() { return read(4u << read(2)); }
+
+	float
+	readFloat(float min, float max, unsigned bits) { return dequantizeRange(read(bits), min, max, bits); }
+
+	size_t
+	bits() const { return m_bits; }
+
+	/**
+	 * @brief Si se pidi ms de lo que haba: lo ledo no vale.
+	 */
+	bool
+	overflowed() const { return m_overflowed; }
+
+private:
+	const unsigned char* m_data;
+	size_t m_size;
+	size_t m_bits = 0;
+	bool m_overflowed = false;
+};
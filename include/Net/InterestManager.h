@@ -0,0 +1,85 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include "Net/Replication.h"
+
+/**
+ * @class InterestManager
+ * @brief Elige, para cada cliente, qu actores de la foto le tocan: los de su zona de inters
+ *        y, de ellos, los que ms lo necesitan dentro de los bytes que tiene por foto.
+ *
+ * La zona es lo que el cliente ve (`setArea`) ms `kDefaultMargin` por lado; lo que sale de
+ * ella deja de mandarse y el cliente lo da por ido. Un actor de la zona que no cambi desde lo
+ * ltimo que se le mand no cuesta nada y se queda como estaba. Los que cambiaron acumulan
+ * prioridad en cada foto (ms cuanto ms cerca del centro, y el doble si el cliente todava no
+ * los tiene) y se mandan de mayor a menor hasta llenar el presupuesto; el que se mand vuelve
+ * a cero y el que no, se queda con el estado anterior y sigue acumulando. As lo cercano se
+ * actualiza casi en cada foto y lo lejano cada tanto, pero nada se queda atrs para siempre.
+ *
+ * El costo por cliente crece con lo que hay en su zona, no con toda la escena: los ids
+ * relevantes salen del `SpatialGrid` (`NetSession`).
+ */
+class
+InterestManager {
+public:
+	using ClientId = ReplicationServer::ClientId;
+
+	static constexpr float kDefaultMargin = 128.0f;
+	static constexpr size_t kNewActorBytes = 16;      ///< Estimado de un actor que el cliente no tiene.
+	static constexpr size_t kChangedActorBytes = 6;   ///< Y de uno que solo cambi.
+	static constexpr float kNewActorBoost = 2.0f;
+
+	/**
+	 * @brief Zona del cliente `client`; sin llamarla, recibe todo (dentro del presupuesto).
+	 */
+	void
+	setArea(ClientId client, const sf::FloatRect& area);
+
+	/**
+	 * @brief La zona con su margen, o vaca si el cliente no dijo cul es.
+	 */
+	sf::FloatRect
+	interestArea(ClientId client) const;
+
+	bool
+	hasArea(ClientId client) const { return client < m_clients.size() && m_clients[client].hasArea; }
+
+	void
+	removeClient(ClientId client);
+
+	void
+	setMargin(float margin) { m_margin = margin; }
+
+	/**
+	 * @brief Lo que recibe `client` de `current` (por id), en `view` (por id).
+	 *
+	 * @param relevant Ids de la zona, por id; todos los de `current` sin zona.
+	 * @param byteBudget Bytes de la foto para este cliente, estimados.
+	 */
+	void
+	select(ClientId client, std::span<const NetActorState> current, std::span<const uint32_t> relevant, size_t byteBudget,
+		std::vector<NetActorState>& view);
+
+private:
+	struct Client {
+		sf::FloatRect area;
+		bool hasArea = false;
+		std::vector<NetActorState> sent;   ///< Lo ltimo elegido, por id.
+		std::vector<float> priority;       ///< Acumulada, por id.
+	};
+
+	struct Candidate {
+		uint32_t id = 0;
+		float priority = 0.0f;
+		size_t cost = 0;
+	};
+
+	Client&
+	client(ClientId client);
+
+	std::vector<Client> m_clients;
+	std::vector<Candidate> m_candidates;   ///< De `select`; conservan su capacidad.
+	std::vector<uint32_t> m_chosen;
+	float m_margin = kDefaultMargin;
+};
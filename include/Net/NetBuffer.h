@@ -0,0 +1,332 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Net/BitStream.h"
+#include "Profiling/TracyBridge.h"
+
+class NetBufferPool;
+
+/**
+ * @class NetBuffer
+ * @brief Mensaje de red en un bloque de `NetBufferPool`: se escribe en su sitio y pasa al
+ *        transporte sin copiarse.
+ *
+ * Copiar un `NetBuffer` comparte el bloque (el servidor manda la misma foto a todos los
+ * clientes que confirmaron la misma base); el bloque vuelve al pool con el ltimo. Se escribe
+ * antes de compartirlo: despus es de solo lectura.
+ *
+ * `<<` escribe como `sf::Packet` (enteros en orden de red, `float` por sus bits, `bool` en un
+ * byte, cadenas con su largo en 32 bits) y `bits` da un `BitWriter` sobre lo que queda libre,
+ * que `commit` suma al mensaje. Pasarse de la capacidad no escribe nada y marca `overflowed`.
+ */
+class
+NetBuffer {
+public:
+	NetBuffer() = default;
+
+	NetBuffer(const NetBuffer& other) : m_block(other.m_block) { addRef(); }
+
+	NetBuffer(NetBuffer&& other) noexcept : m_block(other.m_block) { other.m_block = nullptr; }
+
+	NetBuffer&
+	operator=(NetBuffer other) noexcept {
+		std::swap(m_block, other.m_block);
+		return *this;
+	}
+
+	~NetBuffer() { release(); }
+
+	/**
+	 * @brief Un bloque de al menos `capacity` bytes del pool del motor; nulo si no hay clase
+	 *        tan grande (`NetBufferPool::kLargeBytes`).
+	 */
+	static NetBuffer
+	acquire(size_t capacity);
+
+	explicit operator bool() const { return m_block != nullptr; }
+
+	const unsigned char*
+	data() const { return m_block ? m_block->bytes() : nullptr; }
+
+	unsigned char*
+	data() { return m_block ? m_block->bytes() : nullptr; }
+
+	size_t
+	size() const { return m_block ? m_block->size : 0; }
+
+	size_t
+	capacity() const { return m_block ? m_block->capacity : 0; }
+
+	std::span<const unsigned char>
+	bytes() const { return { data(), size() }; }
+
+	bool
+	overflowed() const { return m_block && m_block->overflowed; }
+
+	/**
+	 * @brief Vaca el mensaje para volver a escribirlo; el bloque sigue siendo el mismo.
+	 */
+	void
+	clear() {
+		if (m_block) {
+			m_block->size = 0;
+			m_block->overflowed = false;
+		}
+	}
+
+	/**
+	 * @brief `size` bytes al final del mensaje, para escribirlos ah; nulo si no caben.
+	 */
+	unsigned char*
+	extend(size_t size) {
+		if (!m_block || m_block->size + size > m_block->capacity) {
+			if (m_block) {
+				m_block->overflowed = true;
+			}
+			return nullptr;
+		}
+		unsigned char* at = m_block->bytes() + m_block->size;
+		m_block->size += size;
+		return at;
+	}
+
+	void
+	append(const void* data, size_t size) {
+		if (unsigned char* at = extend(size)) {
+			std::memcpy(at, data, size);
+		}
+	}
+
+	/**
+	 * @brief Escritor de bits desde el final del mensaje hasta la capacidad.
+	 */
+	BitWriter
+	bits() {
+		if (!m_block) {
+			return BitWriter(nullptr, 0);
+		}
+		return BitWriter(m_block->bytes() + m_block->size, m_block->capacity - m_block->size);
+	}
+
+	/**
+	 * @brief Suma al mensaje lo que escribi `writer`, que sali de `bits`.
+	 */
+	void
+	commit(const BitWriter& writer) {
+		if (writer.overflowed()) {
+			if (m_block) {
+				m_block->overflowed = true;
+			}
+			return;
+		}
+		extend(writer.bytes());
+	}
+
+	template<typename T> requires std::is_arithmetic_v<T>
+	NetBuffer&
+	operator<<(T value) {
+		if constexpr (std::is_same_v<T, bool>) {
+			return *this << static_cast<uint8_t>(value ? 1 : 0);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+			return *this << std::bit_cast<Bits>(value);
+		}
+		else {
+			if (unsigned char* at = extend(sizeof(T))) {
+				auto bits = static_cast<std::make_unsigned_t<T>>(value);
+				for (size_t i = 0; i < sizeof(T); ++i) {
+					at[i] = static_cast<unsigned char>(bits >> (8 * (sizeof(T) - 1 - i)));
+				}
+			}
+			return *this;
+		}
+	}
+
+	NetBuffer&
+	operator<<(std::string_view text) {
+		*this << static_cast<uint32_t>(text.size());
+		append(text.data(), text.size());
+		return *this;
+	}
+
+	/**
+	 * @brief Referencias al bloque; con 1, este es su nico dueo.
+	 */
+	uint32_t
+	useCount() const { return m_block ? m_block->references.load(std::memory_order_relaxed) : 0; }
+
+private:
+	friend class NetBufferPool;
+
+	struct Block {
+		NetBufferPool* pool = nullptr;
+		std::atomic<uint32_t> references{ 0 };
+		size_t capacity = 0;
+		size_t size = 0;
+		bool overflowed = false;
+		uint8_t sizeClass = 0;
+
+		unsigned char*
+		bytes() { return reinterpret_cast<unsigned char*>(this + 1); }
+
+		const unsigned char*
+		bytes() const { return reinterpret_cast<const unsigned char*>(this + 1); }
+	};
+
+	explicit NetBuffer(Block* block) : m_block(block) { addRef(); }
+
+	void
+	addRef() {
+		if (m_block) {
+			m_block->references.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void
+	release();
+
+	Block* m_block = nullptr;
+};
+
+/**
+ * @class NetReader
+ * @brief Lee en orden lo que se escribi con `NetBuffer::operator<<`, sin copiar.
+ *
+ * Como `sf::Packet`, pasa a falso (`operator bool`) si se pidi ms de lo que haba, y lo
+ * que se lee de ah en adelante vale cero.
+ */
+class
+NetReader {
+public:
+	explicit NetReader(std::span<const unsigned char> bytes) : m_bytes(bytes) {}
+
+	explicit operator bool() const { return !m_overflowed; }
+
+	/**
+	 * @brief Lo que falta leer.
+	 */
+	std::span<const unsigned char>
+	remaining() const { return m_bytes.subspan(m_offset); }
+
+	/**
+	 * @brief `size` bytes siguientes; vaco y sin valor si no los hay.
+	 */
+	std::span<const unsigned char>
+	take(size_t size) {
+		if (m_overflowed || size > m_bytes.size() - m_offset) {
+			m_overflowed = true;
+			return {};
+		}
+		std::span<const unsigned char> taken = m_bytes.subspan(m_offset, size);
+		m_offset += size;
+		return taken;
+	}
+
+	/**
+	 * @brief Lector de bits sobre lo que falta; `skip(reader)` lo da por ledo.
+	 */
+	BitReader
+	bits() const {
+		std::span<const unsigned char> rest = remaining();
+		return BitReader(rest.data(), rest.size());
+	}
+
+	void
+	skip(const BitReader& reader) {
+		if (reader.overflowed()) {
+			m_overflowed = true;
+			return;
+		}
+		take((reader.bits() + 7) >> 3);
+	}
+
+	template<typename T> requires std::is_arithmetic_v<T>
+	NetReader&
+	operator>>(T& value) {
+		if constexpr (std::is_same_v<T, bool>) {
+			uint8_t byte = 0;
+			*this >> byte;
+			value = byte != 0;
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+			Bits bits = 0;
+			*this >> bits;
+			value = std::bit_cast<T>(bits);
+		}
+		else {
+			std::span<const unsigned char> at = take(sizeof(T));
+			std::make_unsigned_t<T> bits = 0;
+			for (unsigned char byte : at) {
+				bits = static_cast<std::make_unsigned_t<T>>((uint64_t(bits) << 8) | byte);
+			}
+			value = static_cast<T>(bits);
+		}
+		return *this;
+	}
+
+	NetReader&
+	operator>>(std::string& text) {
+		uint32_t size = 0;
+		*this >> size;
+		std::span<const unsigned char> at = take(size);
+		text.assign(reinterpret_cast<const char*>(at.data()), at.size());
+		return *this;
+	}
+
+private:
+	std::span<const unsigned char> m_bytes;
+	size_t m_offset = 0;
+	bool m_overflowed = false;
+};
+
+/**
+ * @class NetBufferPool
+ * @brief Bloques de tamao fijo para `NetBuffer`, en dos clases: uno que cabe en un datagrama y
+ *        uno para un mensaje que se parte en fragmentos. Los que se sueltan se reusan sin
+ *        volver a pedir memoria.
+ *
+ * De cualquier hilo. Ningn `NetBuffer` debe sobrevivir a su pool.
+ */
+class
+NetBufferPool {
+public:
+	static constexpr size_t kSmallBytes = 1536;        ///< Ms que `UdpTransport::kMtu`.
+	static constexpr size_t kLargeBytes = 80 * 1024;   ///< Ms que `UdpTransport::kMaxMessageBytes`.
+
+	struct Stats {
+		size_t live = 0;        ///< Prestados ahora.
+		size_t allocated = 0;   ///< Pedidos al sistema desde el principio.
+	};
+
+	NetBufferPool() = default;
+	~NetBufferPool();
+
+	NetBufferPool(const NetBufferPool&) = delete;
+	NetBufferPool& operator=(const NetBufferPool&) = delete;
+
+	NetBuffer
+	acquire(size_t capacity);
+
+	Stats
+	stats() const;
+
+private:
+	friend class NetBuffer;
+
+	void
+	recycle(NetBuffer::Block* block);
+
+	mutable ENGINE_MUTEX(m_mutex);
+	std::vector<NetBuffer::Block*> m_free[2];
+	Stats m_stats;
+};
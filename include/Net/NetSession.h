@@ -0,0 +1,226 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include "Net/InterestManager.h"
+#include "Net/NetStats.h"
+#include "Net/NetThread.h"
+#include "Net/Replication.h"
+#include "Net/SnapshotInterpolator.h"
+#include "Memory/TSharedPointer.h"
+
+class Actor;
+class Entity;
+
+/**
+ * @class NetSession
+ * @brief Un servidor que manda los actores de la escena a sus clientes, o un cliente que los
+ *        muestra, sobre un `UdpTransport`.
+ *
+ * El id de red de un actor es su posicin en la lista de la escena ms uno: servidor y cliente
+ * cargan la misma escena y la lista sale en orden de archivo. El servidor manda
+ * `kSnapshotHz` fotos por segundo contra la que confirm cada cliente (`ReplicationServer`),
+ * sin reintentos; el cliente las lee, confirma y las pasa a un `SnapshotInterpolator`, del que
+ * sale lo que se aplica a los actores en cada frame. Los eventos (`sendEvent`) van aparte, como
+ * `Reliable`, y llegan al manejador de `setEventHandler` del otro lado.
+ *
+ * El socket lo atiende un `NetThread`: `update` solo lee y deja mensajes en sus colas, y ni las
+ * llamadas al sistema ni un cliente lento retrasan el frame. Un mensaje empieza con un byte de
+ * tipo; la foto lleva despus la hora del servidor en milisegundos.
+ *
+ * El cliente manda con cada confirmacin lo que ve (`setInterestArea`), y el servidor le manda
+ * solo lo de esa zona que entra en su parte de `setBandwidth` (`InterestManager`); los actores
+ * de la zona salen del `SpatialGrid`.
+ *
+ * `stats` junta lo que mide el transporte de cada par con lo que la sesin mand y recibi de
+ * cada tipo de mensaje; con `setStatsPath`, `close` lo escribe en un archivo.
+ */
+class
+NetSession {
+public:
+	using EventHandler = std::function<void(UdpTransport::PeerId, std::span<const unsigned char>)>;
+
+	static constexpr float kSnapshotHz = 20.0f;
+	static constexpr size_t kDefaultBandwidth = 64 * 1024;   ///< Bytes por segundo y cliente.
+
+	/**
+	 * @brief Escucha en `port` y acepta clientes.
+	 */
+	bool
+	host(unsigned short port);
+
+	/**
+	 * @brief Se conecta al servidor de `address:port` desde un puerto libre.
+	 */
+	bool
+	connect(const sf::IpAddress& address, unsigned short port);
+
+	void
+	close();
+
+	bool
+	isOpen() const { return m_role != Role::None; }
+
+	bool
+	isHost() const { return m_role == Role::Host; }
+
+	/**
+	 * @brief Un paso de red, despus de simular: el servidor lee confirmaciones y, si toca,
+	 *        manda la foto de `actors`; el cliente lee fotos y pone en `actors` el estado
+	 *        interpolado. `deltaTime` es el del paso simulado.
+	 */
+	void
+	update(std::span<const EngineUtilities::TSharedPointer<Actor>> actors, float deltaTime);
+
+	/**
+	 * @brief Del servidor: como `update`, pero manda `states` (por id) en vez de los de unos
+	 *        actores, para una simulacin que no usa la escena (`SessionHost`). La zona de
+	 *        cada cliente se busca en la foto, sin `SpatialGrid`.
+	 */
+	void
+	update(std::span<const NetActorState> states, float deltaTime);
+
+	/**
+	 * @brief Clientes conectados, del servidor.
+	 */
+	size_t
+	clientCount() const;
+
+	/**
+	 * @brief Manda `bytes` como `Reliable`: del servidor a todos los clientes, del cliente al servidor.
+	 * @return `false` si no cupo en la cola de alguno.
+	 */
+	bool
+	sendEvent(std::span<const unsigned char> bytes);
+
+	void
+	setEventHandler(EventHandler handler) { m_onEvent = std::move(handler); }
+
+	SnapshotInterpolator&
+	interpolator() { return m_interpolator; }
+
+	/**
+	 * @brief Del cliente: la zona que ve, que va al servidor con cada confirmacin.
+	 */
+	void
+	setInterestArea(const sf::FloatRect& area) { m_interestArea = area; }
+
+	/**
+	 * @brief Del servidor: bytes por segundo de fotos para cada cliente; 0 es sin lmite.
+	 */
+	void
+	setBandwidth(size_t bytesPerSecond) { m_bandwidth = bytesPerSecond; }
+
+	void
+	setInterestMargin(float margin) { m_interest.setMargin(margin); }
+
+	/**
+	 * @brief Lo medido de cada par y su suma, en `out` (conserva su capacidad).
+	 */
+	void
+	stats(NetStats& out) const;
+
+	/**
+	 * @brief Archivo donde `close` escribe `stats` (`NetStats::write`); vaco para no escribirlo.
+	 */
+	void
+	setStatsPath(const std::string& path) { m_statsPath = path; }
+
+private:
+	enum class Role : uint8_t { None, Host, Client };
+
+	static constexpr uint8_t kSnapshotMessage = 1;
+	static constexpr uint8_t kAckMessage = 2;
+	static constexpr uint8_t kEventMessage = 3;
+	static constexpr size_t kSnapshotHeaderBytes = 5;   ///< Tipo y hora.
+	static constexpr size_t kAckBytes = 3 + 4 * sizeof(float);   ///< Tipo, secuencia y zona.
+	static constexpr ReplicationServer::ClientId kNoClient = ~ReplicationServer::ClientId(0);
+
+	using Clock = std::chrono::steady_clock;
+
+	void
+	updateHost(std::span<const EngineUtilities::TSharedPointer<Actor>> actors, float deltaTime);
+
+	/**
+	 * @brief Del servidor: conexiones, confirmaciones y eventos.
+	 */
+	void
+	receiveHost();
+
+	/**
+	 * @brief Avanza el reloj del servidor `deltaTime`; `true` si toca foto.
+	 */
+	bool
+	snapshotDue(float deltaTime);
+
+	/**
+	 * @brief Manda `m_states` a cada cliente.
+	 */
+	void
+	sendSnapshot();
+
+	/**
+	 * @brief Del servidor: decide qu parte de la foto actual recibe `client`.
+	 */
+	void
+	selectView(ReplicationServer::ClientId client);
+
+	void
+	updateClient(std::span<const EngineUtilities::TSharedPointer<Actor>> actors);
+
+	void
+	handleEvent(UdpTransport::PeerId peer, std::span<const unsigned char> bytes);
+
+	/**
+	 * @brief Cuenta un mensaje de `peer` por su tipo; `outgoing` si lo mand la sesin.
+	 */
+	void
+	countMessage(UdpTransport::PeerId peer, std::span<const unsigned char> bytes, bool outgoing);
+
+	bool
+	isPeer(UdpTransport::PeerId peer) const;
+
+	/**
+	 * @brief Todos los pares abiertos tienen un `PeerId` menor.
+	 */
+	size_t
+	peerLimit() const;
+
+	/**
+	 * @brief Una vez por segundo, los bytes por segundo de los datagramas de todos los pares.
+	 */
+	void
+	updateRates();
+
+	double
+	localTime() const { return std::chrono::duration<double>(Clock::now() - m_start).count(); }
+
+	Role m_role = Role::None;
+	UdpTransport m_transport;                           ///< Del hilo de red mientras est abierta.
+	NetThread m_thread;
+	UdpTransport::PeerId m_server = 0;                  ///< Del cliente.
+	ReplicationServer m_replication;
+	std::vector<ReplicationServer::ClientId> m_clients;  ///< Por `PeerId`; `kNoClient` si no hay.
+	std::vector<NetActorState> m_states;                 ///< Foto o estado interpolado; conserva su capacidad.
+	InterestManager m_interest;
+	std::unordered_map<const Entity*, uint32_t> m_ids;   ///< Id de red de los actores de la foto.
+	std::vector<Entity*> m_found;                        ///< Del `SpatialGrid`; conserva su capacidad.
+	std::vector<uint32_t> m_relevant;
+	std::vector<NetActorState> m_view;
+	size_t m_bandwidth = kDefaultBandwidth;
+	sf::FloatRect m_interestArea;                        ///< Del cliente.
+	double m_serverTime = 0.0;                           ///< Segundos simulados del servidor.
+	float m_sinceSnapshot = 0.0f;
+	ReplicationClient m_replicated;
+	SnapshotInterpolator m_interpolator;
+	Clock::time_point m_start = Clock::now();
+	EventHandler m_onEvent;
+	std::vector<NetPeerStats> m_traffic;                 ///< Por `PeerId`; el enlace lo pone `stats`.
+	double m_rateStart = 0.0;
+	uint64_t m_rateBytesOut = 0;                         ///< De todos los pares, al empezar el segundo.
+	uint64_t m_rateBytesIn = 0;
+	float m_bytesOutPerSecond = 0.0f;
+	float m_bytesInPerSecond = 0.0f;
+	std::string m_statsPath;
+};
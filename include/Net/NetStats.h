@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Lo que mide `UdpTransport` de un par: datagramas, ida y vuelta y prdida.
+ *
+ * Los bytes son los del datagrama entero, con su cabecera. Un datagrama se da por perdido
+ * cuando el otro lado ya confirm uno 33 ms nuevo sin confirmarlo a l (o se reusa su lugar).
+ */
+struct NetLinkStats {
+	uint64_t datagramsOut = 0;
+	uint64_t datagramsIn = 0;
+	uint64_t bytesOut = 0;
+	uint64_t bytesIn = 0;
+	uint64_t acked = 0;           ///< Datagramas propios confirmados.
+	uint64_t lost = 0;
+	uint64_t resends = 0;         ///< Mensajes `Reliable` mandados otra vez.
+	float rttMs = 0.0f;           ///< Suavizado.
+	float jitterMs = 0.0f;        ///< Variacin media entre dos medidas seguidas del ida y vuelta.
+
+	/**
+	 * @brief Fraccin de los datagramas propios que se perdieron, de 0 a 1.
+	 */
+	float
+	loss() const { return acked + lost ? static_cast<float>(lost) / static_cast<float>(acked + lost) : 0.0f; }
+};
+
+/**
+ * @brief Un par de `NetSession`: su enlace y lo que se mand y recibi por tipo de mensaje.
+ */
+struct NetPeerStats {
+	static constexpr size_t kMessageTypes = 3;   ///< Foto, confirmacin y evento, en ese orden.
+
+	uint32_t peer = 0;
+	NetLinkStats link;
+	std::array<uint64_t, kMessageTypes> messagesOut{};
+	std::array<uint64_t, kMessageTypes> messagesIn{};
+	std::array<uint64_t, kMessageTypes> bytesOut{};   ///< De los mensajes, sin cabeceras del transporte.
+	std::array<uint64_t, kMessageTypes> bytesIn{};
+	uint32_t snapshotBytes = 0;                       ///< La ltima foto mandada o recibida.
+	uint32_t snapshotBytesMax = 0;
+};
+
+/**
+ * @brief Lo de todos los pares de una `NetSession` y su suma, para el overlay (`Window`) o
+ *        para un archivo (`write`).
+ *
+ * Los contadores son desde que se abri la sesin; `bytesOutPerSecond` y `bytesInPerSecond`,
+ * del ltimo segundo, de los datagramas. En `total`, el ida y vuelta y su variacin son el
+ * promedio de los pares.
+ */
+struct NetStats {
+	NetPeerStats total;
+	std::vector<NetPeerStats> peers;
+	float bytesOutPerSecond = 0.0f;
+	float bytesInPerSecond = 0.0f;
+
+	/**
+	 * @brief Una fila (o un objeto) por par y una ms con `total`; JSON si `path` termina en
+	 *        `.json`, CSV si no.
+	 * @return `false` si no pudo escribirse.
+	 */
+	bool
+	write(const std::string& path) const;
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Containers/TSpscQueue.h"
+#include "Net/UdpTransport.h"
+
+/**
+ * @brief Lo que el hilo de red entrega a la simulacin.
+ */
+struct NetIncoming {
+	enum class Kind : uint8_t {
+		Message,
+		Connected,      ///< Apareci `peer` (servidor).
+		Disconnected    ///< `peer` dej de responder.
+	};
+
+	Kind kind = Kind::Message;
+	UdpTransport::PeerId peer = 0;
+	NetDelivery delivery = NetDelivery::Unreliable;
+	NetBuffer bytes;    ///< Del mensaje; un bloque del pool.
+};
+
+/**
+ * @brief Lo que la simulacin deja para el hilo de red.
+ */
+struct NetOutgoing {
+	enum class Kind : uint8_t { Send, Flush, Disconnect };
+
+	Kind kind = Kind::Send;
+	UdpTransport::PeerId peer = 0;
+	NetDelivery delivery = NetDelivery::Unreliable;
+	NetBuffer bytes;
+};
+
+/**
+ * @class NetThread
+ * @brief Corre un `UdpTransport` en un hilo propio: las llamadas al socket, el armado de
+ *        datagramas y los reenvos salen del frame.
+ *
+ * El hilo duerme en el `sf::SocketSelector` del transporte hasta que llega un datagrama o
+ * pasan `kWaitMilliseconds` (`kIdleWaitMilliseconds` si no hay pares); lee todo, entrega cada
+ * mensaje por una `TSpscQueue` y atiende lo que dej la simulacin en la otra. La simulacin nunca espera: `send` y `flush` solo
+ * encolan, y `poll` solo lee lo que ya est. Si la cola de entrada se llena (la simulacin se
+ * atras), el hilo guarda lo recibido en su lado y lo entrega despus, sin dejar de leer el
+ * socket; de lo `Unreliable` guarda como mucho `kMaxBacklog`.
+ *
+ * Mientras corre, el transporte es del hilo: no se lo toca desde afuera entre `start` y `stop`.
+ * Lo que mide de cada par lo copia el hilo en cada `flush` y se lee con `linkStats`.
+ */
+class
+NetThread {
+public:
+	static constexpr size_t kQueueCapacity = 4096;
+	static constexpr size_t kMaxBacklog = 65536;
+	static constexpr int kWaitMilliseconds = 2;     ///< Tambin el mayor retraso de un `send`.
+	static constexpr int kIdleWaitMilliseconds = 100;   ///< Sin pares: solo espera el primer datagrama.
+	static constexpr float kFlushInterval = 0.01f;  ///< Reenvos y confirmaciones sin `flush`.
+
+	NetThread() = default;
+	~NetThread() { stop(); }
+
+	NetThread(const NetThread&) = delete;
+	NetThread& operator=(const NetThread&) = delete;
+
+	/**
+	 * @brief Arranca el hilo sobre `transport`, ya abierto y con sus pares.
+	 */
+	void
+	start(UdpTransport& transport);
+
+	/**
+	 * @brief Manda lo que qued encolado y detiene el hilo; lo no ledo se descarta.
+	 */
+	void
+	stop();
+
+	bool
+	isRunning() const { return m_thread.joinable(); }
+
+	/**
+	 * @brief Solo la simulacin. Encola `message` para `peer`.
+	 * @return `false` si la cola de salida est llena.
+	 */
+	bool
+	send(UdpTransport::PeerId peer, NetBuffer message, NetDelivery delivery);
+
+	bool
+	disconnect(UdpTransport::PeerId peer);
+
+	/**
+	 * @brief Fin de lo que la simulacin manda en este paso: el hilo arma los datagramas ya.
+	 */
+	void
+	flush();
+
+	/**
+	 * @brief Solo la simulacin. El siguiente mensaje o aviso recibido.
+	 * @return `false` si no hay.
+	 */
+	bool
+	poll(NetIncoming& out) { return m_incoming.tryPop(out); }
+
+	/**
+	 * @brief Lo medido de `peer` hasta el ltimo `flush` del hilo. Desde cualquier hilo.
+	 */
+	NetLinkStats
+	linkStats(UdpTransport::PeerId peer) const;
+
+private:
+	void
+	run();
+
+	/**
+	 * @brief Del hilo: lo recibido del ltimo `receive`, a la cola o al atraso.
+	 */
+	void
+	deliverReceived();
+
+	/**
+	 * @brief Del hilo: atiende lo que encol la simulacin.
+	 * @return `true` si pidi `flush`.
+	 */
+	bool
+	drainOutgoing();
+
+	/**
+	 * @brief Del hilo: copia lo que midi el transporte para `linkStats`.
+	 */
+	void
+	publishStats();
+
+	UdpTransport* m_transport = nullptr;
+	std::thread m_thread;
+	std::atomic<bool> m_stop{ false };
+	EngineUtilities::TSpscQueue<NetOutgoing> m_outgoing{ kQueueCapacity };
+	EngineUtilities::TSpscQueue<NetIncoming> m_incoming{ kQueueCapacity };
+	std::vector<NetIncoming> m_backlog;   ///< Del hilo, en orden.
+	size_t m_backlogFirst = 0;
+	mutable std::mutex m_statsMutex;
+	std::vector<NetLinkStats> m_linkStats;   ///< Por `PeerId`.
+};
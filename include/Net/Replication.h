@@ -0,0 +1,281 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <SFML/Network.hpp>
+#include "Prerequisites.h"
+#include "Net/NetBuffer.h"
+
+class Actor;
+
+/**
+ * @brief Estado de red de un actor: su `Transform` y su figura ya cuantizados, que es lo que
+ *        viaja y lo que se compara para saber qu cambi.
+ *
+ * Posicin en 1/`kPositionScale` de unidad (65536 unidades), rotacin en `kRotationBits` bits
+ * de vuelta y escala en 1/`kScaleScale`. Dos estados iguales aqu se ven igual en el cliente,
+ * as que un actor que se movi menos de un paso no se enva.
+ */
+struct NetActorState {
+	static constexpr float kPositionScale = 32.0f;
+	static constexpr unsigned kPositionBits = 22;
+	static constexpr unsigned kPositionDeltaBits = 10;  ///< Un movimiento de menos de 16 unidades en un eje.
+	static constexpr unsigned kRotationBits = 12;
+	static constexpr float kScaleScale = 256.0f;
+	static constexpr unsigned kScaleBits = 16;
+
+	uint32_t id = 0;          ///< De red, el que elige el servidor; no el `EntityId`.
+	int32_t x = 0;
+	int32_t y = 0;
+	uint16_t rotation = 0;
+	int16_t scaleX = 0;
+	int16_t scaleY = 0;
+	uint8_t shape = EMPTY;    ///< `ShapeType`.
+	uint8_t layer = 0;
+	uint32_t color = 0;       ///< `sf::Color::toInteger`.
+
+	/**
+	 * @brief Lo de `actor` que se enva; sin `Transform` queda en el origen y sin figura, vaco.
+	 */
+	static NetActorState
+	capture(uint32_t id, const Actor& actor);
+
+	/**
+	 * @brief Pone este estado en el `Transform` y la figura de `actor`, si los tiene; la figura
+	 *        se crea de nuevo solo si cambi de tipo.
+	 */
+	void
+	apply(Actor& actor) const;
+
+	sf::Vector2f
+	position() const { return { x / kPositionScale, y / kPositionScale }; }
+
+	float
+	degrees() const;
+
+	sf::Vector2f
+	scale() const { return { scaleX / kScaleScale, scaleY / kScaleScale }; }
+
+	bool
+	operator==(const NetActorState&) const = default;
+};
+
+/**
+ * @class ReplicationServer
+ * @brief Enva a cada cliente el estado de los actores de red, codificado contra el ltimo que
+ *        ese cliente confirm.
+ *
+ * Cada `capture` guarda una foto numerada (`sequence`) en un anillo de `kHistory`. Para un
+ * cliente que confirm la foto `b` (`acknowledge`), `write` escribe solo la diferencia con
+ * `b`: los actores nuevos enteros, los que cambiaron con una mscara de campos (y la posicin
+ * como desplazamiento si es chico) y los que ya no estn como ids; los que no cambiaron no
+ * ocupan nada. Sin confirmacin, o si `b` ya sali del anillo, la foto va entera. Lo perdido
+ * no se reenva: la prxima diferencia sigue siendo contra lo ltimo que el cliente tiene.
+ *
+ * El costo no crece con los clientes sino con las bases distintas: los que confirmaron la misma
+ * foto reciben el mismo `NetBuffer` (`message`), codificado una vez por `capture` directo en
+ * un bloque del pool y compartido sin copiarse hasta el datagrama.
+ *
+ * Con `setClientView` un cliente recibe solo una parte de la foto (`InterestManager`); sus
+ * partes se guardan en un anillo propio, que es contra lo que se codifican sus diferencias.
+ * Desde su primera parte, un cliente sin parte en una foto la recibe entera.
+ *
+ * Todo en el hilo que simula.
+ */
+class
+ReplicationServer {
+public:
+	using ClientId = uint32_t;
+
+	static constexpr uint16_t kHistory = 32;
+
+	/**
+	 * @brief Foto nueva con `actors`, en cualquier orden y con ids distintos. `header` va delante
+	 *        de cada mensaje de esta foto (el tipo de mensaje y la hora, por ejemplo).
+	 */
+	void
+	capture(std::span<const NetActorState> actors, std::span<const unsigned char> header = {});
+
+	uint16_t
+	sequence() const { return m_sequence; }
+
+	ClientId
+	addClient();
+
+	void
+	removeClient(ClientId client);
+
+	/**
+	 * @brief El cliente tiene la foto `sequence`; las ms viejas que la ya confirmada se ignoran.
+	 */
+	void
+	acknowledge(ClientId client, uint16_t sequence);
+
+	/**
+	 * @brief Lee la confirmacin que el cliente escribi con `ReplicationClient::writeAck`.
+	 */
+	bool
+	readAck(ClientId client, sf::Packet& packet);
+
+	bool
+	readAck(ClientId client, NetReader& reader);
+
+	/**
+	 * @brief Lo que `client` recibe de la foto actual, por id, en vez de la foto entera. Despus
+	 *        de `capture` y antes de `message`.
+	 */
+	void
+	setClientView(ClientId client, std::span<const NetActorState> view);
+
+	/**
+	 * @brief Actores de la foto actual, por id.
+	 */
+	std::span<const NetActorState>
+	current() const;
+
+	/**
+	 * @brief La ltima foto para `client`, con su `header` y como diferencia si se puede; el mismo
+	 *        bloque para todos los clientes con la misma base. Nulo si el cliente no existe o la foto
+	 *        no cabe en `NetBufferPool::kLargeBytes`.
+	 */
+	NetBuffer
+	message(ClientId client);
+
+	/**
+	 * @brief Agrega `message(client)` a `packet`.
+	 * @return Bytes agregados.
+	 */
+	size_t
+	write(ClientId client, sf::Packet& packet);
+
+	/**
+	 * @brief Escribe la foto actual contra la `baseline` del anillo (nula: entera) en `bytes`.
+	 *        Es lo que usa `write`; sirve para medir o mandar por otro canal.
+	 */
+	void
+	encode(const std::vector<NetActorState>* baseline, uint16_t baselineSequence, std::vector<unsigned char>& bytes) const;
+
+private:
+	struct Counts {
+		uint32_t changed = 0;
+		uint32_t removed = 0;
+
+		size_t
+		bound() const;   ///< Bytes que alcanzan para codificarlos.
+	};
+
+	static Counts
+	count(std::span<const NetActorState> actors, std::span<const NetActorState> baseline);
+
+	void
+	encode(std::span<const NetActorState> actors, const std::vector<NetActorState>* baseline, uint16_t baselineSequence,
+		Counts counts, BitWriter& writer) const;
+
+	/**
+	 * @brief `actors` contra `baseline` en un bloque nuevo, detrs del `header` de la foto.
+	 */
+	NetBuffer
+	encodeMessage(std::span<const NetActorState> actors, const std::vector<NetActorState>* baseline, uint16_t baselineSequence) const;
+
+	struct Snapshot {
+		uint16_t sequence = 0;
+		bool valid = false;
+		std::vector<NetActorState> actors;    ///< Por id.
+	};
+
+	struct Client {
+		uint16_t acked = 0;
+		bool hasAck = false;
+		bool active = false;
+		std::vector<Snapshot> views;          ///< Anillo de `setClientView`; vaco si recibe todo.
+	};
+
+	/**
+	 * @brief Lo ya codificado esta foto para una base; `full` sin ella.
+	 */
+	struct Encoded {
+		uint16_t baseline = 0;
+		bool full = false;
+		NetBuffer buffer;
+	};
+
+	/**
+	 * @brief La foto `sequence` si sigue en el anillo, o nula.
+	 */
+	const Snapshot*
+	find(uint16_t sequence) const;
+
+	std::array<Snapshot, kHistory> m_history;
+	uint16_t m_sequence = 0;                  ///< De la ltima `capture`.
+	std::vector<Client> m_clients;
+	std::vector<ClientId> m_freeClients;
+	std::vector<Encoded> m_encoded;           ///< De la foto actual.
+	size_t m_encodedCount = 0;
+	std::vector<unsigned char> m_header;      ///< De `capture`.
+};
+
+/**
+ * @class ReplicationClient
+ * @brief Lee las fotos de un `ReplicationServer` y guarda las recibidas, que son las bases
+ *        contra las que llegan las siguientes.
+ *
+ * Un mensaje ms viejo que el ltimo ledo, o contra una base que no est, se descarta; la
+ * confirmacin (`writeAck`) sigue siendo la del ltimo que s se ley y el servidor codifica
+ * contra ella.
+ */
+class
+ReplicationClient {
+public:
+	static constexpr uint16_t kHistory = ReplicationServer::kHistory;
+
+	/**
+	 * @brief Lee una foto escrita por `ReplicationServer::write`; lo que hay en `packet` es el
+	 *        mensaje entero.
+	 * @return `false` si se descart.
+	 */
+	bool
+	read(const sf::Packet& packet);
+
+	/**
+	 * @brief Lee una foto de `[data, data + size)`.
+	 */
+	bool
+	read(const unsigned char* data, size_t size);
+
+	/**
+	 * @brief Agrega a `packet` la confirmacin de la ltima foto leda.
+	 * @return `false` si todava no se ley ninguna.
+	 */
+	bool
+	writeAck(sf::Packet& packet) const;
+
+	bool
+	writeAck(NetBuffer& buffer) const;
+
+	bool
+	hasSnapshot() const { return m_hasLatest; }
+
+	uint16_t
+	sequence() const { return m_latest; }
+
+	/**
+	 * @brief Actores de la ltima foto leda, por id.
+	 */
+	std::span<const NetActorState>
+	actors() const;
+
+private:
+	struct Snapshot {
+		uint16_t sequence = 0;
+		bool valid = false;
+		std::vector<NetActorState> actors;
+	};
+
+	std::array<Snapshot, kHistory> m_history;
+	uint16_t m_latest = 0;
+	bool m_hasLatest = false;
+	std::vector<NetActorState> m_changed;     ///< De `read`; conservan su capacidad.
+	std::vector<uint32_t> m_removed;
+	std::vector<NetActorState> m_decoded;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <span>
+#include <vector>
+#include "Net/Replication.h"
+
+/**
+ * @class SnapshotInterpolator
+ * @brief Fotos del servidor con su hora, para dibujar en el cliente un instante un poco en el
+ *        pasado interpolando entre las dos que lo rodean.
+ *
+ * Las fotos llegan a 20 o 30 por segundo y con retrasos distintos; aplicarlas al llegar se ve a
+ * saltos. Con `delay` de retraso casi siempre hay una foto antes y otra despus del instante que
+ * se dibuja, y entre ellas posicin, rotacin (por el lado corto) y escala se mezclan; figura,
+ * capa y color son los de la anterior. Si falta la de despus, se queda en la ltima en vez de
+ * adivinar hacia adelante.
+ *
+ * La hora del servidor se estima de la ms adelantada de las que llegan: si una llega antes de
+ * lo esperado la estimacin salta hasta ella, y si llegan tarde baja de a poco, para seguir al
+ * reloj del servidor sin saltar con cada retraso.
+ */
+class
+SnapshotInterpolator {
+public:
+	static constexpr size_t kCapacity = 32;
+	static constexpr float kDefaultDelay = 0.1f;     ///< Dos fotos a 20 por segundo.
+	static constexpr double kClockFollow = 0.01;     ///< Lo que baja la estimacin por foto tarda.
+
+	/**
+	 * @brief Segundos de atraso de lo que se dibuja respecto de la ltima foto esperada.
+	 */
+	void
+	setDelay(float seconds) { m_delay = seconds; }
+
+	float
+	delay() const { return m_delay; }
+
+	/**
+	 * @brief Guarda la foto `actors` (por id) de la hora `serverTime`, recibida en `localTime`;
+	 *        una ms vieja que la ltima se descarta.
+	 */
+	void
+	push(double serverTime, std::span<const NetActorState> actors, double localTime);
+
+	/**
+	 * @brief El estado de cada actor en `localTime - delay`, por id, en `out`.
+	 * @return `false` si todava no lleg ninguna foto.
+	 */
+	bool
+	sample(double localTime, std::vector<NetActorState>& out) const;
+
+	void
+	clear() { m_count = 0; m_hasOffset = false; }
+
+	size_t
+	size() const { return m_count; }
+
+private:
+	struct Snapshot {
+		double serverTime = 0.0;
+		std::vector<NetActorState> actors;
+	};
+
+	const Snapshot&
+	at(size_t index) const { return m_ring[(m_first + index) % kCapacity]; }
+
+	std::array<Snapshot, kCapacity> m_ring;   ///< Conservan su capacidad al reemplazarse.
+	size_t m_first = 0;
+	size_t m_count = 0;
+	double m_offset = 0.0;                    ///< Hora del servidor menos hora local.
+	bool m_hasOffset = false;
+	float m_delay = kDefaultDelay;
+};
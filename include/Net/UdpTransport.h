@@ -0,0 +1,296 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Network.hpp>
+#include "Net/NetBuffer.h"
+#include "Net/NetStats.h"
+
+/**
+ * @brief Cmo se entrega un mensaje de `UdpTransport`.
+ */
+enum class NetDelivery : uint8_t {
+	Unreliable,    ///< Una vez; si se pierde, el siguiente trae lo nuevo (fotos, entrada).
+	Reliable       ///< Se reenva hasta que llega, y se entrega en el orden en que se mand.
+};
+
+/**
+ * @class UdpTransport
+ * @brief Mensajes sobre un `sf::UdpSocket`: los de un frame salen juntos en datagramas de
+ *        hasta `kMtu` bytes, y solo los crticos se reenvan.
+ *
+ * Cada datagrama lleva su nmero de secuencia y confirma los del otro lado: el ltimo recibido
+ * y, en 32 bits, los 32 anteriores. As un datagrama perdido no detiene a los siguientes (con
+ * TCP, un segmento perdido retiene todo lo que viene atrs) y los mensajes `Reliable` que
+ * viajaban en l se vuelven a mandar, en otro datagrama, pasado un tiempo de ida y vuelta.
+ * Se entregan en orden: uno que llega antes que el anterior espera en una ventana de
+ * `kReliableWindow`. Los `Unreliable` ms grandes que un datagrama se parten en fragmentos y se
+ * arman del otro lado; si falta uno, se descarta el mensaje entero.
+ *
+ * `send` solo encola, y un `NetBuffer` se encola sin copiarse: sus bytes pasan una sola vez,
+ * del bloque del pool al datagrama. `flush` arma y manda los datagramas de cada par, y
+ * `receive` lee todo lo que lleg sin bloquear. Los mensajes recibidos valen hasta el siguiente `receive`. Un par
+ * existe desde `connect` o, si `setAcceptingPeers`, desde su primer datagrama; deja de
+ * existir con `disconnect` o tras `kTimeoutSeconds` sin recibir nada. Sin mensajes que
+ * mandar, `flush` manda cada `kKeepAliveSeconds` un datagrama vaco, que tambin confirma.
+ *
+ * Todo en un hilo, el que llama o el de un `NetThread`.
+ */
+class
+UdpTransport {
+public:
+	using PeerId = uint32_t;
+
+	static constexpr size_t kMtu = 1200;                  ///< Cabe en cualquier ruta sin que IP lo parta.
+	static constexpr size_t kHeaderBytes = 12;            ///< Protocolo, secuencia, confirmacin y sus bits.
+	static constexpr size_t kMaxFragments = 64;
+	static constexpr size_t kReliableWindow = 256;
+	static constexpr size_t kMaxPendingReliable = 1024;   ///< Por par, sin confirmar.
+	static constexpr float kTimeoutSeconds = 5.0f;
+	static constexpr float kKeepAliveSeconds = 0.25f;
+	static constexpr float kMinResendSeconds = 0.05f;
+	static constexpr uint32_t kProtocolId = 0x54454E47;   ///< "GNET": descarta datagramas de otros programas.
+	static constexpr size_t kFragmentBytes = kMtu - kHeaderBytes - 7;
+	static constexpr size_t kMaxMessageBytes = kMaxFragments * kFragmentBytes;   ///< De un `Unreliable`.
+
+	/**
+	 * @brief Un mensaje recibido; sus bytes, con `bytes`.
+	 */
+	struct Received {
+		PeerId peer = 0;
+		NetDelivery delivery = NetDelivery::Unreliable;
+		size_t offset = 0;
+		size_t size = 0;
+	};
+
+	UdpTransport() = default;
+
+	UdpTransport(const UdpTransport&) = delete;
+	UdpTransport& operator=(const UdpTransport&) = delete;
+
+	/**
+	 * @brief Abre el socket en `port` (cualquiera libre con `sf::Socket::AnyPort`).
+	 */
+	bool
+	bind(unsigned short port);
+
+	/**
+	 * @brief Cierra el socket y olvida a todos los pares, sin avisarles.
+	 */
+	void
+	unbind();
+
+	unsigned short
+	localPort() const { return m_socket.getLocalPort(); }
+
+	/**
+	 * @brief Con `true`, un datagrama de un remitente desconocido crea un par (servidor).
+	 */
+	void
+	setAcceptingPeers(bool accepting) { m_accepting = accepting; }
+
+	/**
+	 * @brief Par hacia `address:port`; el mismo si ya exista.
+	 */
+	PeerId
+	connect(const sf::IpAddress& address, unsigned short port);
+
+	void
+	disconnect(PeerId peer);
+
+	bool
+	isConnected(PeerId peer) const { return peer < m_peers.size() && m_peers[peer].active; }
+
+	/**
+	 * @brief Encola `message` para el prximo `flush`.
+	 * @return `false` si el par no existe, un `Reliable` no cabe en un datagrama, un
+	 *         `Unreliable` necesita ms de `kMaxFragments` o hay demasiados sin confirmar.
+	 */
+	bool
+	send(PeerId peer, NetBuffer message, NetDelivery delivery);
+
+	/**
+	 * @brief Copia `message` en un `NetBuffer` y lo encola.
+	 */
+	bool
+	send(PeerId peer, std::span<const unsigned char> message, NetDelivery delivery);
+
+	/**
+	 * @brief Manda lo encolado de cada par, en tantos datagramas como haga falta.
+	 */
+	void
+	flush();
+
+	/**
+	 * @brief Lee los datagramas que llegaron y descarta los pares vencidos.
+	 */
+	void
+	receive();
+
+	/**
+	 * @brief Duerme hasta que llegue un datagrama o pasen `seconds` (`sf::SocketSelector`).
+	 * @return `true` si hay algo que leer.
+	 */
+	bool
+	wait(float seconds);
+
+	/**
+	 * @brief Mensajes del ltimo `receive`, en el orden en que se pueden entregar.
+	 */
+	std::span<const Received>
+	received() const { return m_received; }
+
+	std::span<const unsigned char>
+	bytes(const Received& message) const { return std::span<const unsigned char>(m_inbox).subspan(message.offset, message.size); }
+
+	/**
+	 * @brief Pares que aparecieron y que se fueron en el ltimo `receive`.
+	 */
+	std::span<const PeerId>
+	connected() const { return m_connected; }
+
+	std::span<const PeerId>
+	disconnected() const { return m_disconnected; }
+
+	/**
+	 * @brief Tiempo de ida y vuelta suavizado de `peer`, de sus confirmaciones.
+	 */
+	float
+	roundTripSeconds(PeerId peer) const { return isConnected(peer) ? m_peers[peer].rtt : 0.0f; }
+
+	/**
+	 * @brief Lo medido de `peer` desde que apareci; vaco si no existe.
+	 */
+	NetLinkStats
+	linkStats(PeerId peer) const;
+
+	/**
+	 * @brief Lmite de los `PeerId`: todos son menores.
+	 */
+	size_t
+	peerSlots() const { return m_peers.size(); }
+
+	size_t
+	peerCount() const { return m_byEndpoint.size(); }
+
+	/**
+	 * @brief Mayor carga til de un mensaje `Reliable`.
+	 */
+	static constexpr size_t
+	maxPayload() { return kMtu - kHeaderBytes - kReliableHeaderBytes; }
+
+private:
+	static constexpr size_t kMessageHeaderBytes = 3;      ///< Tipo y tamao.
+	static constexpr size_t kReliableHeaderBytes = kMessageHeaderBytes + 2;
+	static constexpr size_t kFragmentHeaderBytes = kMessageHeaderBytes + 4;
+	static_assert(kFragmentBytes == kMtu - kHeaderBytes - kFragmentHeaderBytes);
+	static_assert(kMaxMessageBytes <= NetBufferPool::kLargeBytes && kMtu <= NetBufferPool::kSmallBytes);
+	static constexpr size_t kSentHistory = 256;
+	static constexpr size_t kMaxReliablePerDatagram = 16;
+
+	using Clock = std::chrono::steady_clock;
+
+	struct Sent {
+		uint16_t sequence = 0;
+		bool valid = false;
+		bool acked = false;
+		double time = 0.0;
+		uint8_t reliableCount = 0;
+		std::array<uint16_t, kMaxReliablePerDatagram> reliable{};
+	};
+
+	struct PendingReliable {
+		uint16_t id = 0;
+		double lastSent = -1.0;                          ///< Negativo: no sali todava.
+		NetBuffer bytes;
+	};
+
+	struct Queued {
+		NetBuffer buffer;                                 ///< Compartido por los fragmentos de un mensaje.
+		size_t offset = 0;
+		size_t size = 0;
+		uint16_t group = 0;                               ///< De fragmentos; `count` 0 si es entero.
+		uint8_t index = 0;
+		uint8_t count = 0;
+	};
+
+	struct Peer {
+		sf::IpAddress address;
+		unsigned short port = 0;
+		bool active = false;
+		uint16_t localSequence = 0;
+		uint16_t remoteSequence = 0;
+		uint32_t remoteBits = 0;                          ///< Bit i: lleg `remoteSequence - 1 - i`.
+		bool hasRemote = false;
+		bool ackPending = false;                          ///< Lleg algo que todava no se confirm.
+		double lastReceived = 0.0;
+		double lastSent = 0.0;
+		float rtt = 0.1f;
+		float lastRttSample = -1.0f;                      ///< Negativo: todava ninguna.
+		NetLinkStats stats;                               ///< Sin `rttMs`, que sale de `rtt`.
+		std::array<Sent, kSentHistory> sent;
+		std::deque<PendingReliable> reliableOut;
+		uint16_t nextReliableId = 0;
+		uint16_t nextExpected = 0;                        ///< Siguiente `Reliable` a entregar.
+		std::array<std::vector<unsigned char>, kReliableWindow> reliableIn;
+		std::array<bool, kReliableWindow> reliableInValid{};
+		std::vector<Queued> queued;
+		uint16_t nextGroup = 0;
+		uint16_t assemblingGroup = 0;                     ///< Fragmentos que se estn juntando.
+		uint8_t assemblingCount = 0;
+		uint64_t assemblingMask = 0;
+		size_t assemblingSize = 0;
+		std::vector<unsigned char> assembling;
+	};
+
+	double
+	now() const { return std::chrono::duration<double>(Clock::now() - m_start).count(); }
+
+	static uint64_t
+	endpointKey(const sf::IpAddress& address, unsigned short port) { return (uint64_t(address.toInteger()) << 16) | port; }
+
+	PeerId
+	addPeer(const sf::IpAddress& address, unsigned short port, double time);
+
+	void
+	processDatagram(PeerId peer, const unsigned char* data, size_t size, double time);
+
+	/**
+	 * @brief Marca confirmado el datagrama `sequence` de `peer` y suelta sus `Reliable`.
+	 */
+	void
+	acknowledge(Peer& peer, uint16_t sequence, double time);
+
+	/**
+	 * @brief Da por perdido el datagrama `sequence` de `peer` si sigue sin confirmar.
+	 */
+	static void
+	expire(Peer& peer, uint16_t sequence);
+
+	void
+	deliver(PeerId peer, NetDelivery delivery, const unsigned char* data, size_t size);
+
+	/**
+	 * @brief Arma y manda los datagramas de un par.
+	 */
+	void
+	flushPeer(Peer& peer, double time);
+
+	sf::UdpSocket m_socket;
+	sf::SocketSelector m_selector;
+	bool m_bound = false;
+	bool m_accepting = false;
+	Clock::time_point m_start = Clock::now();
+	std::vector<Peer> m_peers;                           ///< Por `PeerId`; los libres, inactivos.
+	std::vector<PeerId> m_freePeers;
+	std::unordered_map<uint64_t, PeerId> m_byEndpoint;
+	std::vector<unsigned char> m_inbox;
+	std::vector<Received> m_received;
+	std::vector<PeerId> m_connected;
+	std::vector<PeerId> m_disconnected;
+	std::array<unsigned char, kMtu> m_datagram{};
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+#include "Math/Random.h"
+
+class ParticleSystem;
+
+/**
+ * @class ParticleEmitter
+ * @brief Componente que lanza partculas al `ParticleSystem` desde la posicin de su actor.
+ *
+ * Cada `update` suma `rate * deltaTime` al acumulado y crea las partculas enteras que salen,
+ * con direccin, velocidad, vida y tamao al azar dentro de sus rangos; el resto queda para el
+ * siguiente paso, as que 30 por segundo son 30 por segundo a cualquier paso. La direccin se
+ * mide en grados desde la rotacin del `Transform`. Las partculas no siguen al actor
+ * despus de salir; si el sistema est lleno, se pierden. Los nmeros al azar de cada tanda
+ * salen juntos de un `RandomBatch`, cuatro por partcula.
+ */
+class
+ParticleEmitter : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::PARTICLES;
+
+	ParticleEmitter() : Component(ComponentType::PARTICLES) {}
+
+	/**
+	 * @brief Crea las partculas que tocan en `deltaTime`.
+	 */
+	void
+	update(float deltaTime) override;
+
+	void
+	render(RenderCommandBuffer& commands) override {}
+
+	/**
+	 * @brief Vincula el `Transform` de la misma entidad; sin l las partculas salen del origen.
+	 */
+	void
+	setTransform(const Transform* transform) { m_transform = transform; }
+
+	/**
+	 * @brief Partculas por segundo; 0 lo detiene.
+	 */
+	void
+	setRate(float perSecond) { m_rate = perSecond; }
+
+	float
+	getRate() const { return m_rate; }
+
+	/**
+	 * @brief Crea `count` partculas ya, adems del ritmo (explosiones, impactos).
+	 */
+	void
+	burst(uint32_t count);
+
+	/**
+	 * @param degrees Direccin central, sumada a la rotacin del actor.
+	 * @param spreadDegrees Ancho total del cono.
+	 */
+	void
+	setDirection(float degrees, float spreadDegrees) { m_direction = degrees; m_spread = spreadDegrees; }
+
+	void
+	setSpeed(float minimum, float maximum) { m_speedMin = minimum; m_speedMax = maximum; }
+
+	/**
+	 * @brief Segundos de vida de cada partcula, al azar entre los dos.
+	 */
+	void
+	setLifetime(float minimum, float maximum) { m_lifetimeMin = minimum; m_lifetimeMax = maximum; }
+
+	void
+	setSize(float minimum, float maximum) { m_sizeMin = minimum; m_sizeMax = maximum; }
+
+	void
+	setColor(sf::Color color) { m_color = color; }
+
+	/**
+	 * @brief Reinicia los nmeros al azar del emisor: la misma semilla da las mismas partculas.
+	 */
+	void
+	setSeed(uint32_t seed) { m_random.seed(seed); }
+
+private:
+	static constexpr uint32_t kSpawnBatch = 64; ///< Partculas cuyos nmeros se piden de una vez.
+
+	/**
+	 * @param random Cuatro nmeros en [0, 1): direccin, velocidad, vida y tamao.
+	 */
+	void
+	spawn(ParticleSystem& system, const sf::Vector2f& origin, float baseDegrees, const float* random);
+
+	const Transform* m_transform = nullptr;
+	float m_rate = 0.0f;
+	float m_pending = 0.0f;          ///< Fraccin de partcula acumulada entre pasos.
+	float m_direction = -90.0f;      ///< Hacia arriba.
+	float m_spread = 30.0f;
+	float m_speedMin = 40.0f;
+	float m_speedMax = 80.0f;
+	float m_lifetimeMin = 0.5f;
+	float m_lifetimeMax = 1.5f;
+	float m_sizeMin = 2.0f;
+	float m_sizeMax = 4.0f;
+	sf::Color m_color = sf::Color::White;
+	RandomBatch m_random{ 0x9E3779B9u ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this)) }; ///< Distinto por emisor hasta `setSeed`.
+};
@@ -0,0 +1,159 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Prerequisites.h"
+#include "Containers/TSlotMap.h"
+#include "ECS/World.h"
+
+class JobSystem;
+
+using PathHandle = EngineUtilities::SlotHandle;
+
+/**
+ * @brief Forma del recorrido entre los puntos de un `Path`.
+ */
+enum class PathCurve : uint8_t {
+	Linear,      ///< Tramos rectos.
+	CatmullRom,  ///< Curva que pasa por todos los puntos.
+	Bezier,      ///< Cbicas: punto, dos de control, punto, dos de control... (3k + 1 puntos; 3k con `loop`).
+};
+
+/**
+ * @brief Recorrido compartido: una lista de puntos que siguen todos los `PathFollower` y
+ *        `SplineFollower` que lo nombran.
+ *
+ * `PathLibrary` arma la tabla de longitud de arco al crearlo o cambiar sus puntos: `samples`
+ * son puntos de la curva a la misma distancia entre s, medida sobre la curva. Avanzar a
+ * velocidad constante es entonces sumar distancia y leer la tabla, sin buscar el parmetro de
+ * la curva en cada paso.
+ */
+struct Path {
+	std::vector<sf::Vector2f> points;
+	bool loop = true; ///< Al llegar al ltimo vuelve al primero; si no, se queda ah.
+	PathCurve curve = PathCurve::Linear;
+
+	std::vector<sf::Vector2f> samples; ///< El primero en el inicio y el ltimo en el final (con `loop`, otra vez el inicio).
+	float length = 0.0f;
+	float sampleStep = 0.0f; ///< Distancia entre dos muestras: `length / (samples.size() - 1)`.
+
+	static constexpr float kSampleSpacing = 4.0f; ///< Distancia buscada entre muestras; `sampleStep` la reparte exacta.
+	static constexpr uint32_t kSubdivisions = 32; ///< Puntos por tramo al medir la curva.
+
+	/**
+	 * @brief Punto a `distance` unidades del inicio por la curva. Con `loop` da vueltas; si no,
+	 *        se queda en los extremos.
+	 */
+	sf::Vector2f
+	pointAt(float distance) const {
+		if (samples.size() < 2) {
+			return samples.empty() ? sf::Vector2f() : samples.front();
+		}
+		if (loop) {
+			distance = std::fmod(distance, length);
+			distance = distance < 0.0f ? distance + length : distance;
+		}
+		else {
+			distance = std::clamp(distance, 0.0f, length);
+		}
+		float position = distance / sampleStep;
+		size_t index = std::min(static_cast<size_t>(position), samples.size() - 2);
+		float t = position - static_cast<float>(index);
+		return samples[index] + (samples[index + 1] - samples[index]) * t;
+	}
+};
+
+/**
+ * @brief Componente de datos de un actor que recorre un `Path` de `PathLibrary`.
+ *
+ * Son 16 bytes: mil guardias en el mismo recorrido lo comparten en vez de copiarlo.
+ */
+struct PathFollower {
+	PathHandle path;
+	uint32_t index = 0;      ///< Punto hacia el que va.
+	float progress = 0.0f;   ///< Vueltas hechas: cada punto alcanzado suma 1 / puntos; sin `loop` termina en 1.
+};
+
+/**
+ * @brief Componente de datos de un actor que recorre un `Path` a velocidad constante, sin
+ *        `SeekTarget`: `PathLibrary::ride` le escribe la posicin.
+ */
+struct SplineFollower {
+	PathHandle path;
+	float distance = 0.0f;  ///< Unidades recorridas desde el inicio.
+	float speed = 100.0f;   ///< Unidades por segundo.
+};
+
+/**
+ * @class PathLibrary
+ * @brief Recorridos de la escena, por handle, y el avance por lotes de quienes los siguen.
+ *
+ * `follow` corre sobre `view<PathFollower, SeekTarget, const Transform>()` en paralelo: al
+ * llegar a `SeekTarget::range` del punto actual (comparando distancias al cuadrado) pasa al
+ * siguiente y apunta `target` ah; el movimiento lo hace `SeekMovement`. `ride` mueve a los
+ * `SplineFollower` por la tabla de cada recorrido. Crear o cambiar recorridos no debe
+ * coincidir con `follow` ni con `ride`.
+ *
+ * Es un servicio (`TService<PathLibrary>`).
+ */
+class
+PathLibrary {
+public:
+	/**
+	 * @brief Guarda un recorrido nuevo y devuelve su handle.
+	 */
+	PathHandle
+	create(std::vector<sf::Vector2f> points, bool loop = true, PathCurve curve = PathCurve::Linear);
+
+	/**
+	 * @brief Cambia los puntos de `path` y rehace su tabla; los actores que lo siguen lo ven en
+	 *        su prximo paso.
+	 * @return `false` si el handle ya no existe.
+	 */
+	bool
+	setPoints(PathHandle path, std::span<const sf::Vector2f> points);
+
+	/**
+	 * @brief Borra el recorrido; quienes lo seguan se quedan quietos.
+	 */
+	void
+	release(PathHandle path) { m_paths.erase(path); }
+
+	const Path*
+	find(PathHandle path) const { return m_paths.get(path); }
+
+	size_t
+	size() const { return m_paths.size(); }
+
+	/**
+	 * @brief Si `position` est a `radius` o menos del punto actual de `follower`, pasa al
+	 *        siguiente.
+	 * @return `true` si alcanz un punto; `follower.index` ya apunta al que sigue.
+	 */
+	static bool
+	advance(PathFollower& follower, const Path& path, const sf::Vector2f& position, float radius);
+
+	/**
+	 * @brief Avanza a todos los `PathFollower` con `SeekTarget` de `world`.
+	 */
+	void
+	follow(World& world, JobSystem& jobs) const;
+
+	/**
+	 * @brief Avanza `speed * deltaTime` a todos los `SplineFollower` de `world` y los pone en su
+	 *        punto del recorrido.
+	 */
+	void
+	ride(World& world, JobSystem& jobs, float deltaTime) const;
+
+	/**
+	 * @brief Rehace `samples`, `length` y `sampleStep` de `path` a partir de sus puntos.
+	 */
+	static void
+	bake(Path& path);
+
+private:
+	EngineUtilities::TSlotMap<Path> m_paths;
+};
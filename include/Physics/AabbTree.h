@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Containers/TSmallVector.h"
+
+/**
+ * @brief Caja alineada a los ejes, por sus esquinas.
+ */
+struct Aabb {
+	float minX = 0.0f;
+	float minY = 0.0f;
+	float maxX = 0.0f;
+	float maxY = 0.0f;
+
+	static Aabb
+	fromRect(const sf::FloatRect& rect) { return { rect.left, rect.top, rect.left + rect.width, rect.top + rect.height }; }
+
+	bool
+	overlaps(const Aabb& other) const {
+		return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+	}
+
+	bool
+	contains(const Aabb& other) const {
+		return minX <= other.minX && minY <= other.minY && other.maxX <= maxX && other.maxY <= maxY;
+	}
+
+	/**
+	 * @brief Permetro: el costo de un nodo al elegir dnde insertar.
+	 */
+	float
+	perimeter() const { return 2.0f * ((maxX - minX) + (maxY - minY)); }
+
+	/**
+	 * @brief Si el segmento de `from` a `from + delta` toca la caja; `inverse` es `1 / delta`
+	 *        por eje (infinito en un eje sin movimiento).
+	 */
+	bool
+	intersectsSegment(const sf::Vector2f& from, const sf::Vector2f& inverse) const {
+		float enter = 0.0f;
+		float exit = 1.0f;
+		// En un eje quieto basta con que el punto est dentro: el borde dara 0 * infinito
+		if (std::isinf(inverse.x)) {
+			if (from.x < minX || from.x > maxX) {
+				return false;
+			}
+		}
+		else {
+			float t0 = (minX - from.x) * inverse.x;
+			float t1 = (maxX - from.x) * inverse.x;
+			enter = std::max(enter, std::min(t0, t1));
+			exit = std::min(exit, std::max(t0, t1));
+		}
+		if (std::isinf(inverse.y)) {
+			if (from.y < minY || from.y > maxY) {
+				return false;
+			}
+		}
+		else {
+			float t0 = (minY - from.y) * inverse.y;
+			float t1 = (maxY - from.y) * inverse.y;
+			enter = std::max(enter, std::min(t0, t1));
+			exit = std::min(exit, std::max(t0, t1));
+		}
+		return enter <= exit;
+	}
+
+	static Aabb
+	merge(const Aabb& a, const Aabb& b) {
+		return { std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY) };
+	}
+};
+
+/**
+ * @class AabbTree
+ * @brief rbol binario dinmico de cajas para encontrar qu se toca sin comparar todo con todo.
+ *
+ * Cada hoja (un "proxy") guarda una caja gorda: la del objeto ms `kMargin` por lado y, al
+ * moverse, estirada `kDisplacementFactor` veces el desplazamiento en esa direccin.
+ * `moveProxy` solo toca el rbol cuando la caja real sale de la gorda, as que lo que se mueve
+ * poco (y lo que no se mueve nunca) no cuesta nada por frame.
+ *
+ * Insertar baja por el hermano que menos agranda el permetro y sube rotando para mantener la
+ * altura; los nodos viven en un arreglo con lista libre y los ndices de proxy no cambian
+ * hasta `destroyProxy`. `query` usa una pila local sin pedir memoria para rboles de altura
+ * normal. `raycast` baja igual, por los nodos que toca un segmento.
+ *
+ * No es seguro entre hilos; varias `query` y `raycast` a la vez s, sin cambios en medio.
+ */
+class
+AabbTree {
+public:
+	static constexpr uint32_t kNullNode = ~0u;
+	static constexpr float kMargin = 4.0f;              ///< Unidades que agranda cada lado de la caja gorda.
+	static constexpr float kDisplacementFactor = 4.0f;  ///< Frames de movimiento que anticipa la caja gorda.
+
+	/**
+	 * @brief Agrega una hoja con `aabb` y `userData`.
+	 * @return ndice del proxy, fijo hasta `destroyProxy`.
+	 */
+	uint32_t
+	createProxy(const Aabb& aabb, void* userData);
+
+	void
+	destroyProxy(uint32_t proxy);
+
+	/**
+	 * @brief Actualiza la caja del proxy tras moverse `displacement`.
+	 * @return `true` si sali de su caja gorda y se reinsert.
+	 */
+	bool
+	moveProxy(uint32_t proxy, const Aabb& aabb, const sf::Vector2f& displacement);
+
+	/**
+	 * @brief Llama a `fn(proxy)` por cada hoja cuya caja gorda toca `aabb`. Si `fn` devuelve
+	 *        `false`, la bsqueda termina ah.
+	 */
+	template<typename Fn>
+	void
+	query(const Aabb& aabb, Fn&& fn) const {
+		if (m_root == kNullNode) {
+			return;
+		}
+		EngineUtilities::TSmallVector<uint32_t, 64> stack;
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			uint32_t index = stack.back();
+			stack.pop_back();
+			const Node& node = m_nodes[index];
+			if (!node.aabb.overlaps(aabb)) {
+				continue;
+			}
+			if (node.isLeaf()) {
+				if (!fn(index)) {
+					return;
+				}
+				continue;
+			}
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+
+	/**
+	 * @brief Llama a `fn(proxy)` por cada hoja cuya caja gorda toca el segmento de `from` a
+	 *        `to`, sin orden. Si `fn` devuelve `false`, la bsqueda termina ah.
+	 */
+	template<typename Fn>
+	void
+	raycast(const sf::Vector2f& from, const sf::Vector2f& to, Fn&& fn) const {
+		if (m_root == kNullNode) {
+			return;
+		}
+		sf::Vector2f inverse(1.0f / (to.x - from.x), 1.0f / (to.y - from.y));
+		EngineUtilities::TSmallVector<uint32_t, 64> stack;
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			uint32_t index = stack.back();
+			stack.pop_back();
+			const Node& node = m_nodes[index];
+			if (!node.aabb.intersectsSegment(from, inverse)) {
+				continue;
+			}
+			if (node.isLeaf()) {
+				if (!fn(index)) {
+					return;
+				}
+				continue;
+			}
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+
+	const Aabb&
+	fatAabb(uint32_t proxy) const { return m_nodes[proxy].aabb; }
+
+	void*
+	userData(uint32_t proxy) const { return m_nodes[proxy].userData; }
+
+	/**
+	 * @brief Altura del rbol; 0 vaco o con una hoja.
+	 */
+	int32_t
+	height() const { return m_root == kNullNode ? 0 : m_nodes[m_root].height; }
+
+	size_t
+	proxyCount() const { return m_proxyCount; }
+
+private:
+	struct Node {
+		Aabb aabb;
+		void* userData = nullptr;
+		uint32_t parent = kNullNode;   ///< Tambin el siguiente libre, si el nodo est libre.
+		uint32_t child1 = kNullNode;
+		uint32_t child2 = kNullNode;
+		int32_t height = -1;           ///< 0 en las hojas; -1 libre.
+
+		bool
+		isLeaf() const { return child1 == kNullNode; }
+	};
+
+	uint32_t
+	allocateNode();
+
+	void
+	freeNode(uint32_t index);
+
+	void
+	insertLeaf(uint32_t leaf);
+
+	void
+	removeLeaf(uint32_t leaf);
+
+	/**
+	 * @brief Rota alrededor de `index` si sus hijos difieren en altura ms de 1.
+	 * @return El nodo que qued en su lugar.
+	 */
+	uint32_t
+	balance(uint32_t index);
+
+	std::vector<Node> m_nodes;
+	uint32_t m_root = kNullNode;
+	uint32_t m_freeList = kNullNode;
+	size_t m_proxyCount = 0;
+};
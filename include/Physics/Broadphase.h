@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Physics/AabbTree.h"
+
+/**
+ * @brief Dos proxies cuyas cajas gordas se tocan, con `a < b`.
+ */
+struct ProxyPair {
+	uint32_t a;
+	uint32_t b;
+
+	bool
+	operator==(const ProxyPair& other) const { return a == other.a && b == other.b; }
+
+	bool
+	operator<(const ProxyPair& other) const { return a != other.a ? a < other.a : b < other.b; }
+};
+
+/**
+ * @class Broadphase
+ * @brief Pares de objetos que pueden estar en contacto, sobre un `AabbTree`, recalculando
+ *        solo lo que se movi.
+ *
+ * Cuando un proxy nuevo entra o uno sale de su caja gorda queda anotado en el buffer de
+ * movimiento. `updatePairs` busca en el rbol solo con esos: los pares de los dems se
+ * conservan del frame anterior, as que con decenas de miles de colisionadores quietos el
+ * costo depende de cuntos se mueven. Los pares entre dos proxies estticos no se buscan.
+ *
+ * `pairs` es la lista completa, ordenada; `beganPairs` y `endedPairs` son las diferencias con
+ * la anterior. Todos los arreglos conservan su capacidad entre frames.
+ */
+class
+Broadphase {
+public:
+	/**
+	 * @brief Agrega un objeto con caja `aabb`; uno esttico no se espera que se mueva.
+	 */
+	uint32_t
+	createProxy(const Aabb& aabb, void* userData, bool isStatic);
+
+	/**
+	 * @brief Lo quita del rbol; sus pares pasan a `endedPairs` en el prximo `updatePairs`.
+	 */
+	void
+	destroyProxy(uint32_t proxy);
+
+	/**
+	 * @brief Caja nueva del objeto tras moverse `displacement`.
+	 */
+	void
+	moveProxy(uint32_t proxy, const Aabb& aabb, const sf::Vector2f& displacement);
+
+	/**
+	 * @brief Rehace los pares de los proxies anotados desde el ltimo `updatePairs`.
+	 */
+	void
+	updatePairs();
+
+	const std::vector<ProxyPair>&
+	pairs() const { return m_pairs; }
+
+	/**
+	 * @brief Pares que empezaron en el ltimo `updatePairs`.
+	 */
+	const std::vector<ProxyPair>&
+	beganPairs() const { return m_began; }
+
+	/**
+	 * @brief Pares que terminaron en el ltimo `updatePairs`.
+	 */
+	const std::vector<ProxyPair>&
+	endedPairs() const { return m_ended; }
+
+	/**
+	 * @brief Dato del proxy; nulo si se destruy, aunque siga en `endedPairs`.
+	 */
+	void*
+	userData(uint32_t proxy) const { return (m_flags[proxy] & kDestroyed) ? nullptr : m_tree.userData(proxy); }
+
+	const AabbTree&
+	tree() const { return m_tree; }
+
+	/**
+	 * @brief Proxies buscados en el ltimo `updatePairs`.
+	 */
+	size_t
+	lastMoveCount() const { return m_lastMoveCount; }
+
+private:
+	enum ProxyFlags : uint8_t {
+		kStatic = 1,
+		kMoved = 2,      ///< En `m_moveBuffer`.
+		kDestroyed = 4,  ///< Sus pares se quitan en el prximo `updatePairs`.
+	};
+
+	void
+	bufferMove(uint32_t proxy);
+
+	AabbTree m_tree;
+	std::vector<uint8_t> m_flags;          ///< `ProxyFlags` de cada proxy.
+	std::vector<uint32_t> m_moveBuffer;
+	std::vector<uint32_t> m_destroyed;     ///< Libres para el rbol despus de `updatePairs`.
+	std::vector<ProxyPair> m_pairs;
+	std::vector<ProxyPair> m_next;         ///< `m_pairs` del frame siguiente, mientras se arma.
+	std::vector<ProxyPair> m_began;
+	std::vector<ProxyPair> m_ended;
+	size_t m_lastMoveCount = 0;
+};
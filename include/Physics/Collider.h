@@ -0,0 +1,108 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "ECS/Archetype.h"
+#include "Physics/AabbTree.h"
+
+/**
+ * @class Collider
+ * @brief Componente de fsica: la caja con la que la entidad entra al `Broadphase` de
+ *        `PhysicsWorld`.
+ *
+ * La caja est en coordenadas locales y se lleva al mundo con el `Transform` de la entidad.
+ * `PhysicsWorld::syncColliders` la registra la primera vez que la ve y la actualiza cuando
+ * cambia el `Transform` o el propio colisionador; al destruirse sale sola del broadphase.
+ * Uno esttico (paredes, decorado) no busca pares con otros estticos. Con masa y sin ser
+ * esttico es un cuerpo rgido: `PhysicsWorld::step` mueve su `Transform`.
+ */
+class
+Collider : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::PHYSICS;
+
+	Collider() : Component(ComponentType::PHYSICS) {}
+
+	/**
+	 * @brief Sale del broadphase si todava estaba.
+	 */
+	~Collider() override;
+
+	void
+	update(float deltaTime) override {}
+
+	void
+	render(RenderCommandBuffer& commands) override {}
+
+	/**
+	 * @brief Caja en coordenadas locales de la entidad.
+	 */
+	void
+	setBounds(const sf::FloatRect& bounds) { m_bounds = bounds; markChanged(); }
+
+	const sf::FloatRect&
+	getBounds() const { return m_bounds; }
+
+	/**
+	 * @brief Se elige antes de que `PhysicsWorld` lo registre.
+	 */
+	void
+	setStatic(bool isStatic) { m_static = isStatic; }
+
+	bool
+	isStatic() const { return m_static; }
+
+	/**
+	 * @brief Masa del cuerpo; 0 (el valor inicial) no es un cuerpo, solo empuja a los que
+	 *        toca. Se elige antes de que `PhysicsWorld` lo registre.
+	 */
+	void
+	setMass(float mass) { m_mass = mass; }
+
+	float
+	getMass() const { return m_mass; }
+
+	/**
+	 * @brief Fraccin de la velocidad que conserva al rebotar, de 0 a 1.
+	 */
+	void
+	setRestitution(float restitution) { m_restitution = restitution; }
+
+	float
+	getRestitution() const { return m_restitution; }
+
+	/**
+	 * @brief Cuerpo en `PhysicsWorld`; `PhysicsWorld::kNoBody` si no es uno.
+	 */
+	uint32_t
+	getBody() const { return m_body; }
+
+	/**
+	 * @brief Caja de mundo del ltimo `syncColliders`.
+	 */
+	const Aabb&
+	getWorldBounds() const { return m_worldBounds; }
+
+	/**
+	 * @brief Entidad del `World` duea del colisionador; nula antes de registrarse.
+	 */
+	EntityId
+	getEntity() const { return m_entity; }
+
+	uint32_t
+	getProxy() const { return m_proxy; }
+
+private:
+	friend class PhysicsWorld;
+
+	sf::FloatRect m_bounds{ -10.0f, -10.0f, 20.0f, 20.0f };
+	Aabb m_worldBounds;
+	EntityId m_entity;
+	uint32_t m_proxy = AabbTree::kNullNode;
+	uint32_t m_body = ~0u;
+	float m_mass = 0.0f;
+	float m_restitution = 0.2f;
+	bool m_static = false;
+};
@@ -0,0 +1,290 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "ECS/World.h"
+#include "Physics/Broadphase.h"
+#include "Physics/Collider.h"
+
+class JobSystem;
+class Transform;
+
+/**
+ * @class PhysicsWorld
+ * @brief Mdulo de fsica del motor: lleva los `Collider` del `World` a su `Broadphase` y
+ *        mueve los cuerpos rgidos.
+ *
+ * `syncColliders` recorre solo los colisionadores cuyo `Transform` o `Collider` cambi desde
+ * `since` (`WorldView::eachChanged`): registra los nuevos y mueve los dems, con el
+ * desplazamiento del centro para estirar sus cajas gordas. Lo que no se mueve no se visita.
+ * Un `Collider` con masa y no esttico se vuelve un cuerpo: desde ah su `Transform` lo
+ * escribe `step`.
+ *
+ * Los cuerpos viven en arreglos separados (SoA), con los despiertos al principio: `step`
+ * integra con SSE solo ese tramo. Los que se tocan forman islas; una isla cuyos cuerpos van
+ * ms lento que `kSleepSpeed` durante `kTimeToSleep` segundos se duerme entera y pasa al
+ * final de los arreglos, donde no cuesta nada. Despierta cuando un cuerpo despierto o un
+ * colisionador que se mueve por su `Transform` la toca, cuando desaparece algo que tocaba,
+ * o con `setVelocity`.
+ *
+ * Los contactos son entre cajas alineadas a los ejes, a lo largo del eje de menor
+ * penetracin, y se resuelven con impulsos secuenciales acumulados (cada contacto solo
+ * empuja, pero puede devolver lo que empuj de ms en una iteracin anterior) y una
+ * correccin de posicin. Cada contacto empieza con el impulso que termin usando en el paso
+ * anterior, si sigue con la misma normal: sin eso una pila no converge en
+ * `kVelocityIterations` y nunca llega a quedarse quieta.
+ *
+ * Las islas despiertas no comparten cuerpos, as que con un `JobSystem` se resuelven a la
+ * vez. Una isla de `kColoringThreshold` contactos o ms se parte adems por colores: ningn
+ * par de contactos del mismo color toca el mismo cuerpo, y cada color se reparte entre los
+ * hilos. Los contactos de la isla quedan ordenados por color tambin al resolverla en un
+ * hilo, de modo que el resultado no depende de cuntos hilos hay. Fuera del modo
+ * determinista, una mquina sin hilos extra no colorea: ahorra el trabajo y conserva el
+ * orden de los pares, que converge un poco mejor, a cambio de no dar los mismos bits que una
+ * con hilos.
+ *
+ * Es un servicio (`TService<PhysicsWorld>`); va en el hilo principal.
+ */
+class
+PhysicsWorld {
+public:
+	using BodyId = uint32_t;
+
+	static constexpr BodyId kNoBody = ~0u;
+	static constexpr uint32_t kVelocityIterations = 8;
+	static constexpr float kBounceSpeed = 30.0f;     ///< Choques ms lentos no rebotan: as un montn puede quedarse quieto.
+	static constexpr float kSleepSpeed = 2.0f;       ///< Unidades por segundo bajo las que un cuerpo cuenta como quieto.
+	static constexpr float kTimeToSleep = 0.5f;      ///< Segundos quieta antes de dormir una isla.
+	static constexpr float kLinearDamping = 0.05f;   ///< Fraccin de la velocidad que se pierde por segundo.
+	static constexpr float kPenetrationSlop = 0.5f;  ///< Penetracin que se tolera sin corregir.
+	static constexpr float kCorrection = 0.4f;       ///< Fraccin de la penetracin que se corrige por paso.
+	static constexpr uint32_t kColoringThreshold = 128; ///< Contactos desde los que una isla se colorea.
+	static constexpr uint32_t kMaxColors = 64;       ///< Los contactos que no caben van a un ltimo color, en serie.
+	static constexpr size_t kContactGrain = 64;      ///< Contactos de un color por trabajo.
+	static constexpr size_t kIslandGrain = 8;        ///< Islas sin colorear por trabajo.
+
+	/**
+	 * @brief Pone al da el broadphase con lo que cambi desde el tick `since`.
+	 */
+	void
+	syncColliders(World& world, uint32_t since);
+
+	/**
+	 * @brief Un paso de `deltaTime` segundos: pares, contactos, integracin y sueo.
+	 * @param jobs Si no es nulo, las islas se resuelven en sus hilos.
+	 */
+	void
+	step(float deltaTime, JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief Con `true` las islas grandes se colorean siempre: el mismo estado da los mismos
+	 *        bits con o sin `JobSystem`, con cualquier nmero de hilos.
+	 */
+	void
+	setDeterministic(bool deterministic) { m_deterministic = deterministic; }
+
+	bool
+	isDeterministic() const { return m_deterministic; }
+
+	/**
+	 * @brief Saca `collider` del broadphase, y su cuerpo si tiene; lo llama su destructor.
+	 */
+	void
+	removeCollider(Collider& collider);
+
+	/**
+	 * @brief Agrega un cuerpo con caja `localBox` alrededor de `position`.
+	 * @param transform Si no es nulo, `step` le escribe la posicin.
+	 */
+	BodyId
+	createBody(const sf::Vector2f& position, const Aabb& localBox, float mass, float restitution,
+		Collider* owner = nullptr, Transform* transform = nullptr);
+
+	void
+	destroyBody(BodyId body);
+
+	/**
+	 * @brief Agrega una caja que no se mueve y no es un cuerpo.
+	 */
+	uint32_t
+	createStatic(const Aabb& bounds);
+
+	sf::Vector2f
+	position(BodyId body) const { uint32_t slot = m_slotOfBody[body]; return { m_x[slot], m_y[slot] }; }
+
+	sf::Vector2f
+	velocity(BodyId body) const { uint32_t slot = m_slotOfBody[body]; return { m_vx[slot], m_vy[slot] }; }
+
+	/**
+	 * @brief Cambia la velocidad del cuerpo y despierta su isla.
+	 */
+	void
+	setVelocity(BodyId body, const sf::Vector2f& velocity);
+
+	bool
+	isAwake(BodyId body) const { return m_slotOfBody[body] < m_awakeCount; }
+
+	void
+	setGravity(const sf::Vector2f& gravity) { m_gravity = gravity; }
+
+	size_t
+	bodyCount() const { return m_x.size(); }
+
+	size_t
+	awakeCount() const { return m_awakeCount; }
+
+	/**
+	 * @brief Contactos del ltimo `step` con algn cuerpo despierto.
+	 */
+	size_t
+	contactCount() const { return m_contacts.size(); }
+
+	const Broadphase&
+	broadphase() const { return m_broadphase; }
+
+	/**
+	 * @brief Colisionador de un proxy de `broadphase`; nulo si ya se destruy o es un cuerpo
+	 *        sin `Collider`.
+	 */
+	Collider*
+	colliderOf(uint32_t proxy) const { return static_cast<Collider*>(m_broadphase.userData(proxy)); }
+
+private:
+	static constexpr uint32_t kNoSlot = ~0u;
+	static constexpr uint32_t kNoIsland = ~0u;
+
+	struct Contact {
+		ProxyPair pair;
+		uint32_t a;          ///< Cuerpo (ndice de arreglo) o `kNoSlot` si es fijo.
+		uint32_t b;
+		float normalX;       ///< De `a` hacia `b`.
+		float normalY;
+		float depth;
+		float bounce;        ///< Velocidad de separacin buscada, por la restitucin.
+		float impulse;       ///< Acumulado en las iteraciones; nunca negativo.
+	};
+
+	/**
+	 * @brief Contactos `[begin, end)` de `m_order` que comparten cuerpos.
+	 *
+	 * Si `colorCount` no es cero, el tramo va ordenado por color y el color `k` ocupa
+	 * `[m_colorStart[firstColor + k], m_colorStart[firstColor + k + 1])`.
+	 */
+	struct Island {
+		uint32_t begin;
+		uint32_t end;
+		uint32_t firstColor;
+		uint32_t colorCount;
+		bool overflow;       ///< El ltimo color toca cuerpos repetidos y va en serie.
+	};
+
+	/**
+	 * @brief Deja los arreglos por proxy del tamao de `proxy`.
+	 */
+	void
+	trackProxy(uint32_t proxy, const Aabb& bounds, BodyId body);
+
+	/**
+	 * @brief Caja real de un proxy: la del cuerpo donde est ahora, o la del ltimo `syncColliders`.
+	 */
+	Aabb
+	boundsOf(uint32_t proxy) const;
+
+	/**
+	 * @brief Despierta la isla dormida del cuerpo en `slot`.
+	 */
+	void
+	wake(uint32_t slot);
+
+	void
+	buildContacts();
+
+	/**
+	 * @brief Junta los despiertos que se tocan en islas y agrupa sus contactos en `m_order`.
+	 */
+	void
+	buildIslands(bool coloring);
+
+	/**
+	 * @brief Reparte los contactos de `island` en colores con el primero libre de sus cuerpos.
+	 */
+	void
+	colorIsland(Island& island);
+
+	/**
+	 * @brief `function(begin, end)` sobre los contactos de la isla: de una vez, o color por
+	 *        color en `jobs` si est coloreada.
+	 */
+	template<typename Fn>
+	void
+	forEachBatch(const Island& island, JobSystem* jobs, Fn&& function);
+
+	/**
+	 * @brief `function(island, jobs)` para cada isla; las que no tienen colores van en paralelo.
+	 */
+	template<typename Fn>
+	void
+	forEachIsland(JobSystem* jobs, Fn&& function);
+
+	/**
+	 * @brief Aplica a los cuerpos el impulso inicial de los contactos `[begin, end)` de `m_order`.
+	 */
+	void
+	warmStart(uint32_t begin, uint32_t end);
+
+	/**
+	 * @brief Una iteracin de impulsos sobre `[begin, end)` de `m_order`.
+	 */
+	void
+	solveVelocities(uint32_t begin, uint32_t end);
+
+	void
+	correctPositions(uint32_t begin, uint32_t end);
+
+	/**
+	 * @brief Duerme las islas que llevan quietas `kTimeToSleep`.
+	 */
+	void
+	updateSleep(float deltaTime);
+
+	void
+	swapSlots(uint32_t a, uint32_t b);
+
+	uint32_t
+	findIsland(uint32_t slot);
+
+	Broadphase m_broadphase;
+	std::vector<BodyId> m_bodyOfProxy;    ///< `kNoBody` para los que no son cuerpos.
+	std::vector<Aabb> m_boundsOfProxy;    ///< Caja real de los que no son cuerpos.
+
+	// Cuerpos por ndice de arreglo: [0, m_awakeCount) despiertos, el resto dormidos
+	std::vector<float> m_x, m_y, m_vx, m_vy;
+	std::vector<float> m_inverseMass;
+	std::vector<float> m_restitution;
+	std::vector<float> m_stillTime;       ///< Segundos seguidos bajo `kSleepSpeed`.
+	std::vector<Aabb> m_localBox;
+	std::vector<uint32_t> m_proxy;
+	std::vector<uint32_t> m_island;       ///< Isla de los dormidos; `kNoIsland` despiertos.
+	std::vector<Transform*> m_transform;
+	std::vector<BodyId> m_bodyOfSlot;
+	std::vector<uint32_t> m_slotOfBody;   ///< `kNoSlot` para ids libres.
+	std::vector<BodyId> m_freeBodies;
+	uint32_t m_awakeCount = 0;
+	uint32_t m_nextIsland = 0;
+
+	std::vector<Contact> m_contacts;      ///< Del paso actual, en el orden de `Broadphase::pairs`.
+	std::vector<Contact> m_lastContacts;  ///< Los del paso anterior, para empezar con sus impulsos.
+	std::vector<uint32_t> m_order;        ///< ndices de `m_contacts` agrupados por isla.
+	std::vector<uint32_t> m_scratch;      ///< Tramo de `m_order` mientras se ordena por color.
+	std::vector<uint32_t> m_contactColor; ///< Isla de cada contacto al armarlas; luego, color de cada posicin de `m_order`.
+	std::vector<Island> m_islands;        ///< Sin colorear.
+	std::vector<Island> m_coloredIslands;
+	std::vector<uint32_t> m_colorStart;
+	std::vector<uint64_t> m_colorMask;    ///< Colores usados por cada despierto; en cero fuera de `colorIsland`.
+	std::vector<uint32_t> m_islandIndex;  ///< Isla de cada raz, mientras se arman.
+	std::vector<uint32_t> m_islandParent; ///< Unin y bsqueda por ndice de despierto.
+	std::vector<float> m_islandStill;     ///< Menor `m_stillTime` de cada raz.
+	std::vector<uint32_t> m_islandId;     ///< Isla dormida asignada a cada raz.
+	sf::Vector2f m_gravity;
+	bool m_deterministic = false;
+};
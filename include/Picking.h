@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Prerequisites.h"
+#include "ECS/World.h"
+#include "Physics/AabbTree.h"
+
+class Entity;
+class JobSystem;
+class MeshRenderer;
+
+/**
+ * @brief Rayo de mundo `origin + t * direction`, con `t` en [0, `maxDistance`].
+ */
+struct PickRay {
+	sf::Vector3f origin;
+	sf::Vector3f direction;
+	float maxDistance = 100000.0f;
+};
+
+/**
+ * @brief Malla ms cercana que cort un rayo; `mesh` nulo si ninguna.
+ */
+struct PickHit {
+	MeshRenderer* mesh = nullptr;
+	float distance = 0.0f;
+};
+
+/**
+ * @class Picking
+ * @brief Elegir con el mouse o un rayo sin preguntarle a cada actor: los actores 2D por las
+ *        celdas del `SpatialGrid` y las mallas 3D por un `AabbTree` propio.
+ *
+ * Las figuras viven en el plano z = 0, as que un rayo sobre ellas es un punto: `pickActor` y
+ * `queryActors` van directo a `SpatialGrid::pickPoint` y `SpatialGrid::queryArea`. Para las
+ * mallas, `syncMeshes` pone en el rbol la sombra en el plano de la caja de mundo de cada
+ * `MeshRenderer` que cambi; un rayo que toca la malla toca esa sombra, as que `raycast`
+ * recorre el rbol con el segmento que el rayo proyecta en el plano y prueba los tringulos
+ * solo de lo que encuentra. Con la cmara de frente ese segmento es corto.
+ *
+ * Las consultas no cambian nada: varios hilos pueden hacerlas a la vez mientras nadie registre
+ * ni mueva cosas, y las `...Batch` reparten una lista de consultas en un `JobSystem`. Cambiar la
+ * geometra de una `Mesh` no marca su `MeshRenderer`: hay que marcarlo para que la sombra se
+ * rehaga.
+ *
+ * Es un servicio (`TService<Picking>`); `syncMeshes` va en el hilo principal.
+ */
+class
+Picking {
+public:
+	static constexpr size_t kBatchGrain = 64; ///< Consultas por trabajo en las `...Batch`.
+
+	/**
+	 * @brief Pone al da el rbol con las mallas cuyo `Transform` o `MeshRenderer` cambi desde
+	 *        el tick `since`.
+	 */
+	void
+	syncMeshes(World& world, uint32_t since);
+
+	/**
+	 * @brief Saca `mesh` del rbol; lo llama su destructor.
+	 */
+	void
+	removeMesh(MeshRenderer& mesh);
+
+	/**
+	 * @brief Malla ms cercana que corta `ray`.
+	 * @return `false` si no cort ninguna; `hit` queda igual.
+	 */
+	bool
+	raycast(const PickRay& ray, PickHit& hit) const;
+
+	/**
+	 * @brief Agrega a `out` las mallas cuya sombra toca `area`, para seleccionar con un
+	 *        recuadro. No vaca `out`.
+	 */
+	void
+	queryMeshes(const sf::FloatRect& area, std::vector<MeshRenderer*>& out) const;
+
+	/**
+	 * @brief Actor con figura bajo `point`; el de caja ms chica si hay varios.
+	 */
+	Entity*
+	pickActor(const sf::Vector2f& point) const;
+
+	/**
+	 * @brief Agrega a `out` los actores con figura que tocan `area`. No vaca `out`.
+	 */
+	void
+	queryActors(const sf::FloatRect& area, std::vector<Entity*>& out) const;
+
+	/**
+	 * @brief `hits[i]` es el `raycast` de `rays[i]`, con los hilos de `jobs` si no es nulo.
+	 */
+	void
+	raycastBatch(std::span<const PickRay> rays, std::span<PickHit> hits, JobSystem* jobs = nullptr) const;
+
+	/**
+	 * @brief `hits[i]` es el `pickActor` de `points[i]`, con los hilos de `jobs` si no es nulo.
+	 */
+	void
+	pickActorBatch(std::span<const sf::Vector2f> points, std::span<Entity*> hits, JobSystem* jobs = nullptr) const;
+
+	size_t
+	meshCount() const { return m_tree.proxyCount(); }
+
+private:
+	AabbTree m_tree;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+
+/**
+ * @class PointLight
+ * @brief Componente de luz puntual para las mallas 3D: color, intensidad y radio de alcance.
+ *
+ * Est en la posicin (interpolada) del `Transform` vinculado, a `height` unidades del plano
+ * z = 0 hacia quien mira. Su luz baja suave hasta cero en `radius`: fuera de l no toca nada,
+ * y `MeshPipeline` solo la suma en las celdas de pantalla que alcanza (`LightClusters`). No
+ * ilumina las figuras 2D.
+ */
+class
+PointLight : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::LIGHT;
+
+	PointLight() : Component(ComponentType::LIGHT) {}
+
+	void
+	update(float deltaTime) override {}
+
+	/**
+	 * @brief Agrega la luz al frame con `RenderCommandBuffer::addLight`.
+	 */
+	void
+	render(RenderCommandBuffer& commands) override;
+
+	/**
+	 * @brief Vincula el `Transform` de la misma entidad; sin l la luz est en el origen.
+	 */
+	void
+	setTransform(const Transform* transform) { m_transform = transform; markChanged(); }
+
+	void
+	setColor(sf::Color color) { m_color = color; markChanged(); }
+
+	sf::Color
+	getColor() const { return m_color; }
+
+	/**
+	 * @brief Multiplica el color; ms de 1 satura de cerca.
+	 */
+	void
+	setIntensity(float intensity) { m_intensity = intensity; markChanged(); }
+
+	float
+	getIntensity() const { return m_intensity; }
+
+	/**
+	 * @brief Distancia a la que la luz llega a cero, en unidades de mundo.
+	 */
+	void
+	setRadius(float radius) { m_radius = radius; markChanged(); }
+
+	float
+	getRadius() const { return m_radius; }
+
+	/**
+	 * @brief Altura sobre el plano z = 0.
+	 */
+	void
+	setHeight(float height) { m_height = height; markChanged(); }
+
+	float
+	getHeight() const { return m_height; }
+
+private:
+	const Transform* m_transform = nullptr;
+	sf::Color m_color = sf::Color::White;
+	float m_intensity = 1.0f;
+	float m_radius = 100.0f;
+	float m_height = 20.0f;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 // Librerias STD
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -9,10 +10,15 @@
 
 // Third Parties
 #include <SFML/Graphics.hpp>
-#include "Memory\TSharedPointer.h"
-#include "Memory\TWeakPointer.h"
-#include "Memory\TStaticPtr.h"
-#include "Memory\TUniquePtr.h"
+#include "Memory/TSharedPointer.h"
+#include "Memory/TWeakPointer.h"
+#include "Memory/ServiceLocator.h"
+#include "Memory/TUniquePtr.h"
+#include "Memory/TIntrusivePtr.h"
+#include "Memory/FrameArena.h"
+#include "Containers/TSlotMap.h"
+#include "Containers/TSmallVector.h"
+#include "Logging/Logger.h"
 // Enums
 enum 
 ShapeType {
@@ -25,19 +31,16 @@ ShapeType {
 // MACRO for safe release of resources
 #define SAFE_PTR_RELEASE(x) if(x != nullptr) { delete x; x = nullptr; }
 
-#define MESSAGE(classObj, method, state)                      \
-{                                                             \
-    std::ostringstream os_;                                   \
-    os_ << classObj << "::" << method << " : "                \
-        << "[CREATION OF RESOURCE" << ": " << state "] \n";\
-    std::cerr << os_.str();                                   \
+// Aviso recuperable; lo escribe el hilo del `Logger`. Los tres argumentos, literales
+#define MESSAGE(classObj, method, state)                          \
+{                                                                 \
+    LOG_WARNING(classObj, method, state);                         \
 }
 
+// Error fatal: escribe todo lo pendiente antes de salir
 #define ERROR(classObj, method, errorMSG)                         \
 {                                                                 \
-    std::ostringstream os_;                                       \
-    os_ << "ERROR : " << classObj << "::" << method << " : "      \
-        << "  Error in data from params [" << errorMSG"] \n"; \
-    std::cerr << os_.str();                                       \
+    LOG_ERROR(classObj, method, errorMSG);                        \
+    ::Logger::instance().shutdown();                              \
     exit(1);                                                      \
-}
\ No newline at end of file
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class Console
+ * @brief Consola del motor: variables con nombre que se leen y cambian al correr, y comandos.
+ *
+ * Una lnea es `nombre` (muestra la variable), `nombre valor` (la cambia) o `comando args...`;
+ * varias van separadas por `;`. `help` lista todo lo registrado. Las variables no guardan
+ * nada: cada una es un par de funciones del dueo del estado (`BaseApp` registra el culling,
+ * los lotes, el nivel de detalle, los hilos, el vsync, el paso fijo y el overlay), as que
+ * cambiarla es lo mismo que llamar al setter. Con eso se compara una funcin encendida y
+ * apagada en la misma corrida, sin recompilar.
+ *
+ * En la ventana se abre con la tecla de la tilde: lo escrito llega por `type` y el texto a
+ * mostrar sale de `text`. Todo lo que se imprime tambin va a `std::cout`. Un solo hilo.
+ */
+class
+Console {
+public:
+	using Arguments = std::span<const std::string_view>;
+
+	/**
+	 * @brief Ejecuta un comando con lo que sigue a su nombre.
+	 * @return `false` si los argumentos no sirven; la consola imprime el uso.
+	 */
+	using Command = std::function<bool(Arguments arguments)>;
+
+	static constexpr size_t kMaxLines = 256;       ///< Historial de salida.
+	static constexpr size_t kVisibleLines = 12;    ///< Las ltimas, en `text`.
+	static constexpr size_t kMaxInputChars = 256;
+
+	/**
+	 * @brief Variable con su texto: `set` recibe el valor escrito y devuelve `false` si no sirve.
+	 */
+	void
+	addVariable(std::string name, std::string help, std::function<std::string()> get,
+	            std::function<bool(std::string_view)> set);
+
+	/**
+	 * @brief Variable de s o no; acepta `1`, `0`, `on`, `off`, `true` y `false`.
+	 */
+	void
+	addBool(std::string name, std::string help, std::function<bool()> get, std::function<void(bool)> set);
+
+	/**
+	 * @brief Variable numrica; `set` puede rechazar el valor devolviendo `false`.
+	 */
+	void
+	addFloat(std::string name, std::string help, std::function<float()> get, std::function<bool(float)> set);
+
+	/**
+	 * @param usage Argumentos, como los ve quien pide `help` (por ejemplo `<cantidad> [figura]`).
+	 */
+	void
+	addCommand(std::string name, std::string usage, std::string help, Command command);
+
+	/**
+	 * @brief Ejecuta `line`, una o varias rdenes separadas por `;`.
+	 * @return `false` si alguna no exista o fall.
+	 */
+	bool
+	execute(std::string_view line);
+
+	/**
+	 * @brief Agrega `text` a la salida (una lnea por cada `\n`) y lo escribe en `std::cout`.
+	 */
+	void
+	print(std::string_view text);
+
+	void
+	setOpen(bool open) { m_open = open; }
+
+	bool
+	isOpen() const { return m_open; }
+
+	/**
+	 * @brief Un carcter escrito con la consola abierta: imprimibles a la lnea, retroceso
+	 *        borra, Enter ejecuta y la tilde se ignora (es la que la abre y la cierra).
+	 */
+	void
+	type(uint32_t unicode);
+
+	/**
+	 * @brief `hook(lnea)` antes de ejecutar cada orden escrita con `type`; no las de `execute`.
+	 *        `BaseApp` las graba en el `InputLog` para repetirlas.
+	 */
+	void
+	setTypedHook(std::function<void(std::string_view line)> hook) { m_typedHook = std::move(hook); }
+
+	/**
+	 * @brief Lleva a la lnea la orden anterior (`-1`) o siguiente (`1`) del historial.
+	 */
+	void
+	recall(int direction);
+
+	/**
+	 * @brief Las ltimas `kVisibleLines` de la salida y la lnea en curso.
+	 */
+	std::string
+	text() const;
+
+	const std::vector<std::string>&
+	lines() const { return m_lines; }
+
+	/**
+	 * @brief Lee `true` o `false` de `text`.
+	 * @return `false` si no es ninguna de las formas de `addBool`.
+	 */
+	static bool
+	parseBool(std::string_view text, bool& out);
+
+	static bool
+	parseFloat(std::string_view text, float& out);
+
+private:
+	struct Variable {
+		std::string name;
+		std::string help;
+		std::function<std::string()> get;
+		std::function<bool(std::string_view)> set;
+	};
+
+	struct Entry {
+		std::string name;
+		std::string usage;
+		std::string help;
+		Command command;
+	};
+
+	/**
+	 * @brief Una orden ya separada en palabras.
+	 */
+	bool
+	run(std::span<const std::string_view> words);
+
+	void
+	printHelp();
+
+	std::vector<Variable> m_variables;
+	std::vector<Entry> m_commands;
+	std::vector<std::string> m_lines;      ///< Salida, la ms vieja primero.
+	std::vector<std::string> m_history;    ///< rdenes escritas, la ms vieja primero.
+	size_t m_recalled = 0;                 ///< Posicin en `m_history`; su tamao si no se volvi atrs.
+	std::string m_input;
+	std::function<void(std::string_view)> m_typedHook;
+	bool m_open = false;
+};
@@ -0,0 +1,151 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Component.h"
+#include "EntityRegistry.h"
+
+class Entity;
+
+/**
+ * @brief Lo que cuesta una entidad, en promedio de los frames medidos.
+ */
+struct EntityCost {
+	EntityHandle entity;
+	NameId name = kNoName;       ///< Del `EntityRegistry` al armar el informe; `kNoName` si no tiene o ya no existe.
+	double updateMs = 0.0;       ///< Sus componentes sin lote.
+	double renderMs = 0.0;       ///< Su `render`.
+
+	double
+	totalMs() const { return updateMs + renderMs; }
+};
+
+/**
+ * @brief Informe de `EntityCostProfiler`.
+ */
+struct EntityCostReport {
+	uint64_t samples = 0;                                   ///< Frames medidos desde que se encendi.
+	uint32_t sampleEvery = 0;
+	std::vector<EntityCost> top;                            ///< Las ms caras primero.
+	std::array<double, kComponentTypeCount> componentMs{};  ///< `update` de cada tipo, lotes incluidos.
+};
+
+/**
+ * @class EntityCostProfiler
+ * @brief Reparte el tiempo de update y de render entre las entidades y los tipos de componente,
+ *        para saber qu actores hacen lento un frame y no solo qu sistema.
+ *
+ * Medir cada entidad cuesta dos lecturas del reloj por componente y por `render`, as que solo
+ * se mide uno de cada `sampleEvery` frames (`isSampling`); los dems no pagan nada ms que
+ * leer esa bandera. En un frame medido `ComponentUpdater` cronometra cada componente sin lote
+ * (a su entidad y a su tipo) y cada lote entero (solo a su tipo: no hay una entidad a quien
+ * cargarlo), y `BaseApp::recordEntities` graba de a una para cronometrar cada `render`.
+ *
+ * `endFrame` pasa lo medido a un promedio exponencial por entidad (`kSmoothing`); una entidad
+ * que deja de aparecer se va apagando y, tras `kForgetSamples` frames medidos sin aparecer, se
+ * olvida. Las entidades se guardan por `EntityHandle` en una tabla por ndice, como la del
+ * `EntityRegistry`: una entidad reciclada empieza de cero.
+ *
+ * Un solo hilo, el del bucle principal.
+ */
+class
+EntityCostProfiler {
+public:
+	static constexpr uint32_t kDefaultSampleEvery = 8;
+	static constexpr double kSmoothing = 0.125;      ///< Peso de cada frame medido en el promedio.
+	static constexpr uint32_t kForgetSamples = 64;
+	static constexpr size_t kDefaultTop = 10;
+
+	/**
+	 * @brief Encendido mide el prximo frame; apagado suelta todo lo acumulado.
+	 */
+	void
+	setEnabled(bool enabled);
+
+	bool
+	isEnabled() const { return m_enabled; }
+
+	/**
+	 * @param frames Uno de cada tantos se mide; 1 mide todos.
+	 */
+	void
+	setSampleEvery(uint32_t frames) { m_sampleEvery = frames ? frames : 1; }
+
+	uint32_t
+	sampleEvery() const { return m_sampleEvery; }
+
+	/**
+	 * @brief `true` si el frame en curso se mide.
+	 */
+	bool
+	isSampling() const { return m_sampling; }
+
+	/**
+	 * @brief `update` de un componente de `entity`, de tipo `type`, que tard `ns`.
+	 */
+	void
+	addUpdate(const Entity& entity, ComponentType type, int64_t ns);
+
+	/**
+	 * @brief Un lote de `ComponentUpdater`, de tipo `type`, que tard `ns`.
+	 */
+	void
+	addBatch(ComponentType type, int64_t ns) { m_frameComponentNs[type] += ns; }
+
+	/**
+	 * @brief `render` de `entity`, que tard `ns`.
+	 */
+	void
+	addRender(const Entity& entity, int64_t ns);
+
+	/**
+	 * @brief Cierra el frame y decide si se mide el siguiente.
+	 * @return `true` si el frame era medido y el promedio cambi.
+	 */
+	bool
+	endFrame();
+
+	/**
+	 * @brief Las `count` entidades ms caras y el costo de cada tipo de componente.
+	 */
+	void
+	report(EntityCostReport& out, size_t count = kDefaultTop) const;
+
+	/**
+	 * @brief Nombre corto de `type`, para el overlay; los del juego son `type N`.
+	 */
+	static const char*
+	componentTypeName(ComponentType type);
+
+private:
+	/**
+	 * @brief Lo de una entidad, en el ndice de su handle.
+	 */
+	struct Slot {
+		uint32_t generation = 0;     ///< 0 si el lugar no sigue a nadie.
+		int64_t updateNs = 0;        ///< Del frame medido en curso.
+		int64_t renderNs = 0;
+		double updateMs = 0.0;       ///< Promedio.
+		double renderMs = 0.0;
+		uint64_t lastSample = 0;     ///< ltimo frame medido en que apareci.
+		bool touched = false;        ///< Ya est en `m_touched` en este frame.
+		bool tracked = false;        ///< Ya est en `m_tracked`.
+	};
+
+	/**
+	 * @brief El lugar de `handle`, que empieza de cero si era de otra generacin.
+	 */
+	Slot&
+	slot(EntityHandle handle);
+
+	bool m_enabled = false;
+	bool m_sampling = false;
+	uint32_t m_sampleEvery = kDefaultSampleEvery;
+	uint32_t m_frame = 0;                                     ///< Frames desde el ltimo medido.
+	uint64_t m_samples = 0;
+	std::vector<Slot> m_slots;
+	std::vector<uint32_t> m_touched;                          ///< ndices con tiempo en el frame en curso.
+	std::vector<uint32_t> m_tracked;                          ///< ndices con promedio, sin repetir.
+	std::array<int64_t, kComponentTypeCount> m_frameComponentNs{};
+	std::array<double, kComponentTypeCount> m_componentMs{};
+};
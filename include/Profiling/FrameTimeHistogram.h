@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/**
+ * @class FrameTimeHistogram
+ * @brief Cuenta tiempos en cubetas de `kBucketMs` hasta `kBuckets * kBucketMs`; lo de ms va a
+ *        la ltima. Agregar cuesta una suma y los percentiles salen sin ordenar nada.
+ */
+class
+FrameTimeHistogram {
+public:
+	static constexpr double kBucketMs = 0.1;
+	static constexpr uint32_t kBuckets = 1000;   ///< Hasta 100 ms; el mximo exacto se guarda aparte.
+
+	void
+	add(double ms);
+
+	void
+	reset();
+
+	uint32_t
+	count() const { return m_count; }
+
+	double
+	maxMs() const { return m_maxMs; }
+
+	/**
+	 * @brief El tiempo bajo el que queda la fraccin `p` de lo agregado (el extremo superior de
+	 *        su cubeta, sin pasar el mximo); 0 si est vaco.
+	 */
+	double
+	percentile(double p) const;
+
+	/**
+	 * @brief Cuntos tiempos pasaron de `ms`, con la resolucin de las cubetas.
+	 */
+	uint32_t
+	countAbove(double ms) const;
+
+private:
+	std::array<uint32_t, kBuckets> m_buckets{};
+	uint32_t m_count = 0;
+	double m_maxMs = 0.0;
+};
+
+/**
+ * @brief Percentiles de una fase en un perodo.
+ */
+struct FramePhaseTimes {
+	double p50Ms = 0.0;
+	double p95Ms = 0.0;
+	double p99Ms = 0.0;
+	double maxMs = 0.0;
+};
+
+/**
+ * @brief Lo de un perodo de `FrameTimeMonitor`.
+ */
+struct FrameTimeReport {
+	uint32_t frames = 0;
+	double seconds = 0.0;
+	FramePhaseTimes frame;     ///< Entre dos vueltas del bucle.
+	FramePhaseTimes update;    ///< Todos los pasos de `update` del frame.
+	FramePhaseTimes render;
+	uint32_t hitches = 0;      ///< Frames de ms de `kHitchFactor` veces la mediana.
+};
+
+/**
+ * @class FrameTimeMonitor
+ * @brief Lleva un histograma del frame y de cada fase y, cada `period` segundos de frames,
+ *        cierra un `FrameTimeReport` y vuelve a empezar.
+ *
+ * El promedio esconde los tirones: lo que se mira son los percentiles y cuntos frames
+ * tardaron mucho ms que la mediana del perodo.
+ */
+class
+FrameTimeMonitor {
+public:
+	static constexpr double kDefaultPeriod = 5.0;
+	static constexpr double kHitchFactor = 2.0;
+
+	void
+	setPeriod(double seconds) { m_period = seconds; }
+
+	double
+	period() const { return m_period; }
+
+	/**
+	 * @brief Tiempos de un frame, en milisegundos.
+	 * @return `true` si con este se cerr un perodo; el resultado queda en `lastReport`.
+	 */
+	bool
+	addFrame(double frameMs, double updateMs, double renderMs);
+
+	const FrameTimeReport&
+	lastReport() const { return m_report; }
+
+private:
+	static FramePhaseTimes
+	summarize(const FrameTimeHistogram& histogram);
+
+	FrameTimeHistogram m_frame;
+	FrameTimeHistogram m_update;
+	FrameTimeHistogram m_render;
+	double m_elapsedMs = 0.0;
+	double m_period = kDefaultPeriod;
+	FrameTimeReport m_report;
+};
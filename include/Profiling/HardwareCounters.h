@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Contadores del procesador del hilo actual, acumulados desde que se abrieron. Una zona
+ *        guarda la diferencia entre su fin y su comienzo.
+ */
+struct HardwareCounterValues {
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+	uint64_t cacheMisses = 0;      ///< Del ltimo nivel de cach.
+	uint64_t branchMisses = 0;
+
+	HardwareCounterValues&
+	operator+=(const HardwareCounterValues& other) {
+		cycles += other.cycles;
+		instructions += other.instructions;
+		cacheMisses += other.cacheMisses;
+		branchMisses += other.branchMisses;
+		return *this;
+	}
+
+	HardwareCounterValues
+	operator-(const HardwareCounterValues& other) const {
+		return { cycles - other.cycles, instructions - other.instructions, cacheMisses - other.cacheMisses,
+		         branchMisses - other.branchMisses };
+	}
+
+	/**
+	 * @brief Instrucciones por ciclo; 0 sin ciclos.
+	 */
+	double
+	ipc() const { return cycles ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0; }
+};
+
+/**
+ * @class HardwareCounters
+ * @brief Ciclos, instrucciones, fallos de cach y de prediccin de saltos del hilo actual, para
+ *        que las zonas de `PROFILE_SCOPE` muestren por qu tardan y no solo cunto.
+ *
+ * En Linux cada hilo abre, la primera vez que lee, un grupo de `perf_event_open` con los cuatro
+ * contadores (solo modo usuario), que se lee entero con una llamada. En Windows no hay acceso
+ * a la PMU sin un driver o una sesin de ETW con permisos de administrador: solo se cuentan los
+ * ciclos del hilo (`QueryThreadCycleTime`) y `available` lo dice. Cada lectura es una llamada
+ * al sistema, as que con los contadores encendidos una zona cuesta un par de microsegundos
+ * ms: sirven para comparar un camino contra otro, no para medir zonas de nanosegundos.
+ *
+ * Apagados (por defecto), `ProfileScope` no los lee.
+ */
+class
+HardwareCounters {
+public:
+	/**
+	 * @brief Qu contadores da esta plataforma.
+	 */
+	enum Available : uint32_t {
+		kCycles = 1u << 0,
+		kInstructions = 1u << 1,
+		kCacheMisses = 1u << 2,
+		kBranchMisses = 1u << 3
+	};
+
+	/**
+	 * @brief Con `true`, prueba abrir los contadores en el hilo actual.
+	 * @return `false` si esta plataforma o sus permisos no lo dejan (en Linux,
+	 *         `/proc/sys/kernel/perf_event_paranoid`); siguen apagados.
+	 */
+	static bool
+	setEnabled(bool enabled);
+
+	static bool
+	isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Lo contado por el hilo actual hasta ahora; los abre la primera vez.
+	 * @return `false` si no pudieron abrirse en este hilo; `out` queda en 0.
+	 */
+	static bool
+	read(HardwareCounterValues& out);
+
+	/**
+	 * @brief Bits de `Available` de lo que `read` llena.
+	 */
+	static uint32_t
+	available();
+
+private:
+	static inline std::atomic<bool> s_enabled{ false };
+};
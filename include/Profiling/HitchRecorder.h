@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Prerequisites.h"
+#include "Jobs/JobSystem.h"
+#include "Profiling/Profiler.h"
+#include "Profiling/TraceCapture.h"
+
+/**
+ * @class HitchRecorder
+ * @brief Guarda los ltimos segundos del `Profiler` en un anillo y, cuando un frame tarda ms
+ *        que el umbral, los escribe como traza con ese frame marcado.
+ *
+ * Los tirones de una partida real casi nunca se repiten a mano: la traza tiene que salir del
+ * momento en que pasan. Cada `addFrame` copia las zonas y contadores del frame a su lugar del
+ * anillo (`kMaxFrames` frames, que reciclan su memoria). Con un tirn, los frames de los
+ * ltimos `seconds` pasan a una `TraceCapture` (`markHitch` marca el culpable) y un trabajo de
+ * `JobSystem` la escribe en `hitch_000.json`, `hitch_001.json` y as, en la carpeta elegida;
+ * escribir no demora al frame siguiente. Mientras un archivo se escribe, los tirones nuevos se
+ * cuentan en `skipped` sin traza. Los primeros `kWarmupFrames` frames despus de encender (la
+ * carga, la creacin de la ventana) tampoco cuentan como tirones.
+ *
+ * Un solo hilo, el de `Profiler::endFrame`.
+ */
+class
+HitchRecorder {
+public:
+	static constexpr size_t kMaxFrames = 1024;        ///< A 144 Hz, unos 7 s.
+	static constexpr double kDefaultSeconds = 5.0;
+	static constexpr size_t kWarmupFrames = 60;       ///< Los primeros, siempre lentos, no cuentan.
+
+	HitchRecorder() : m_jobs(EngineUtilities::TService<JobSystem>::instance()) {}
+
+	/**
+	 * @brief Espera a que se escriba la traza en curso.
+	 */
+	~HitchRecorder();
+
+	HitchRecorder(const HitchRecorder&) = delete;
+	HitchRecorder& operator=(const HitchRecorder&) = delete;
+
+	/**
+	 * @brief Con `thresholdMs` mayor que 0 empieza a guardar; 0 apaga y suelta el anillo.
+	 * @param seconds Lo que se escribe antes del tirn, l incluido.
+	 * @param directory Carpeta de las trazas; debe existir.
+	 */
+	void
+	setThreshold(double thresholdMs, double seconds = kDefaultSeconds, const std::string& directory = ".");
+
+	bool
+	isEnabled() const { return m_thresholdMs > 0.0; }
+
+	double
+	thresholdMs() const { return m_thresholdMs; }
+
+	/**
+	 * @brief Guarda el ltimo frame de `profiler`, despus de su `endFrame`.
+	 * @return `true` si fue un tirn y se empez a escribir su traza (`lastPath`).
+	 */
+	bool
+	addFrame(const Profiler& profiler);
+
+	const std::string&
+	lastPath() const { return m_lastPath; }
+
+	uint32_t
+	dumps() const { return m_dumps; }
+
+	uint32_t
+	skipped() const { return m_skipped; }
+
+	/**
+	 * @brief Trazas que no pudieron escribirse.
+	 */
+	uint32_t
+	failed() const { return m_failed.load(std::memory_order_relaxed); }
+
+private:
+	struct Frame {
+		std::vector<ProfileZone> zones;
+		std::vector<ProfileCounter> counters;
+		int64_t start = 0;
+		int64_t end = 0;
+	};
+
+	/**
+	 * @brief Pasa a `m_dump` los frames del anillo que terminan en los ltimos `m_seconds` y lanza
+	 *        su escritura.
+	 */
+	void
+	dump(const Profiler& profiler, const Frame& hitch);
+
+	JobSystem& m_jobs;
+	JobCounter m_writing;          ///< La traza en escritura.
+	TraceCapture m_dump;           ///< De `m_writing` mientras no termine.
+	std::vector<Frame> m_ring;
+	size_t m_next = 0;             ///< Lugar del prximo frame.
+	size_t m_count = 0;            ///< Frames guardados, hasta `kMaxFrames`.
+	double m_thresholdMs = 0.0;
+	double m_seconds = kDefaultSeconds;
+	std::string m_directory = ".";
+	std::string m_lastPath;
+	uint32_t m_dumps = 0;
+	uint32_t m_skipped = 0;
+	std::atomic<uint32_t> m_failed{ 0 };
+};
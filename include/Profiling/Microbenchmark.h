@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "Profiling/PerfBaseline.h"
+
+/**
+ * @brief Cmo corre `MicrobenchmarkSuite::run`.
+ */
+struct MicrobenchmarkOptions {
+	std::vector<size_t> sizes{ 100, 10000 };   ///< Elementos por repeticin; cada caso corre con todos.
+	uint32_t warmupSamples = 3;                ///< Muestras sin guardar antes de medir.
+	uint32_t samples = 20;                     ///< Muestras medidas por caso y tamao.
+	double minSampleMs = 5.0;                  ///< Cada muestra repite el caso hasta durar al menos esto.
+	std::string filter;                        ///< Solo los casos cuyo nombre lo contiene; vaco, todos.
+	std::string outputPath = "microbench.json"; ///< `.json` para JSON; CSV si no.
+	BaselineOptions baseline;                  ///< Guardar o comparar lo medido (`PerfBaseline`).
+};
+
+/**
+ * @brief Un caso con un tamao: nanosegundos por elemento de cada muestra y su resumen.
+ */
+struct MicrobenchmarkResult {
+	std::string name;
+	size_t size = 0;
+	uint64_t repetitions = 0;        ///< Por muestra.
+	double medianNs = 0.0;
+	double meanNs = 0.0;
+	double stddevNs = 0.0;
+	double minNs = 0.0;
+	double maxNs = 0.0;
+	double madNs = 0.0;              ///< Desviacin absoluta mediana: la dispersin sin los picos.
+	double ci95Ns = 0.0;             ///< Medio ancho del intervalo de 95% de la media.
+	uint32_t outliers = 0;           ///< Muestras a ms de 3 MAD de la mediana.
+	std::vector<double> samplesNs;   ///< En el orden en que se midieron.
+};
+
+/**
+ * @class MicrobenchmarkSuite
+ * @brief Mide casos chicos del motor con varios tamaos y los escribe en JSON o CSV.
+ *
+ * Cada caso es una funcin que, dado un tamao, prepara sus datos (sin medir) y devuelve la
+ * operacin a medir, que procesa ese nmero de elementos. La suite calibra cuntas veces
+ * repetirla para que una muestra dure `minSampleMs` (as el reloj no pesa), descarta
+ * `warmupSamples` muestras y guarda `samples`. El resultado principal es la mediana, que no
+ * se mueve con una interrupcin del sistema; la media, la desviacin y el intervalo quedan
+ * para comparar corridas.
+ */
+class
+MicrobenchmarkSuite {
+public:
+	using Operation = std::function<void()>;
+	using Prepare = std::function<Operation(size_t size)>;
+
+	/**
+	 * @param name Literal, como `"Entity::getComponent"`.
+	 */
+	void
+	add(const char* name, Prepare prepare);
+
+	/**
+	 * @brief Corre los casos que pasan el filtro con cada tamao e imprime una lnea por
+	 *        resultado en `out`.
+	 */
+	const std::vector<MicrobenchmarkResult>&
+	run(const MicrobenchmarkOptions& options, std::ostream& out);
+
+	const std::vector<MicrobenchmarkResult>&
+	results() const { return m_results; }
+
+	/**
+	 * @brief Escribe los resultados; JSON si `path` termina en `.json`, CSV si no.
+	 * @return `false` si no pudo escribirse.
+	 */
+	bool
+	write(const std::string& path) const;
+
+	/**
+	 * @brief Hace que el compilador crea que `value` se usa, para que no borre el trabajo medido.
+	 */
+	template<typename T>
+	static void
+	keep(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const void* volatile s_sink;
+		s_sink = &value;
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+
+private:
+	struct Case {
+		const char* name;
+		Prepare prepare;
+	};
+
+	static MicrobenchmarkResult
+	summarize(const char* name, size_t size, uint64_t repetitions, std::vector<double> samples);
+
+	std::vector<Case> m_cases;
+	std::vector<MicrobenchmarkResult> m_results;
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct MicrobenchmarkResult;
+struct ScalingSample;
+
+/**
+ * @brief Lnea base de un modo de medicin: guardar lo medido con un nombre, compararlo con
+ *        una anterior, o las dos cosas.
+ */
+struct BaselineOptions {
+	std::string save;            ///< Nombre (`baselines/<nombre>.json`) o ruta `.json`; vaco, no guarda.
+	std::string compare;         ///< Igual, contra cul comparar; vaco, no compara.
+	double threshold = 0.05;     ///< Cambio relativo de la mediana desde el que cuenta.
+	double alpha = 0.01;         ///< Nivel de la prueba de Mann-Whitney cuando hay muestras.
+};
+
+/**
+ * @brief Un valor medido; con `samples`, la diferencia se prueba adems de medirse.
+ */
+struct PerfMetric {
+	std::string name;
+	double value = 0.0;
+	std::vector<double> samples;
+};
+
+/**
+ * @brief Lo de un caso con un tamao (`Entity::getComponent/10000`, `scaling/100000`).
+ */
+struct PerfRecord {
+	std::string key;
+	std::vector<PerfMetric> metrics;
+};
+
+/**
+ * @class PerfBaseline
+ * @brief Lee los JSON de `MicrobenchmarkSuite` y `ScalingReport` y marca las regresiones.
+ *
+ * Una mtrica empeor si su valor subi ms de `threshold` y, cuando las dos corridas tienen
+ * muestras (los microbenchmarks), adems la prueba de Mann-Whitney de dos colas da p < `alpha`:
+ * un cambio grande en una muestra ruidosa no alcanza. Sin muestras (el escalado, un valor por
+ * tamao) basta el umbral. Lo que mejor se informa igual, sin fallar.
+ */
+class
+PerfBaseline {
+public:
+	static constexpr const char* kDirectory = "baselines";
+
+	/**
+	 * @brief `name` si ya es una ruta `.json`; si no, `baselines/<name>.json`.
+	 */
+	static std::string
+	pathOf(const std::string& name);
+
+	/**
+	 * @brief Lee un archivo `.json` de resultados.
+	 * @return `false` si no pudo abrirse o no es un arreglo de objetos.
+	 */
+	static bool
+	read(const std::string& path, std::vector<PerfRecord>& out);
+
+	static std::vector<PerfRecord>
+	records(const std::vector<MicrobenchmarkResult>& results);
+
+	static std::vector<PerfRecord>
+	records(const std::vector<ScalingSample>& samples);
+
+	/**
+	 * @brief Compara `current` con `baseline`, mtrica por mtrica, e imprime el resumen en `out`.
+	 * @return Regresiones.
+	 */
+	static size_t
+	compare(const std::vector<PerfRecord>& baseline, const std::vector<PerfRecord>& current,
+	        const BaselineOptions& options, std::ostream& out);
+
+	/**
+	 * @brief Lo que piden `options` despus de medir: guarda con `writeJson` y compara `current`.
+	 * @return 0, 1 si algn archivo fall o 2 si hubo regresiones.
+	 */
+	static int
+	apply(const BaselineOptions& options, const std::vector<PerfRecord>& current,
+	      const std::function<bool(const std::string&)>& writeJson, std::ostream& out);
+
+	/**
+	 * @brief p de dos colas de la prueba U de Mann-Whitney (aproximacin normal, con empates).
+	 */
+	static double
+	mannWhitneyP(const std::vector<double>& a, const std::vector<double>& b);
+};
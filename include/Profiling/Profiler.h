@@ -0,0 +1,298 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Containers/TSpscQueue.h"
+#include "Memory/TUniquePtr.h"
+#include "Profiling/HardwareCounters.h"
+#include "Profiling/TracyBridge.h"
+
+/**
+ * @brief Zonas de `PROFILE_SCOPE`. Encendidas por defecto, tambin en las builds optimizadas
+ *        para medir; definir `ENGINE_PROFILE=0` en la build que se entrega para que la macro
+ *        no genere cdigo.
+ */
+#ifndef ENGINE_PROFILE
+#define ENGINE_PROFILE 1
+#endif
+
+constexpr bool kProfiling = ENGINE_PROFILE != 0;
+
+/**
+ * @brief Una zona terminada: de cundo a cundo, en nanosegundos de `Profiler::now`.
+ */
+struct ProfileZone {
+	const char* name = nullptr;
+	int64_t start = 0;
+	int64_t end = 0;
+	uint32_t depth = 0;       ///< Zonas abiertas por fuera en el mismo hilo.
+	uint32_t thread = 0;      ///< Carril del hilo, en orden de su primera zona.
+	HardwareCounterValues counters;   ///< Lo que cont el procesador en la zona; 0 con `HardwareCounters` apagado.
+};
+
+/**
+ * @brief Un valor que cambia con el tiempo (`PROFILE_COUNTER`), como una serie en la traza.
+ */
+struct ProfileCounter {
+	const char* name = nullptr;
+	int64_t time = 0;
+	double value = 0.0;
+};
+
+/**
+ * @brief Una lnea del desglose: las zonas con el mismo nombre bajo el mismo padre, sumadas.
+ */
+struct ProfileNode {
+	const char* name = nullptr;
+	uint32_t depth = 0;
+	uint32_t calls = 0;
+	double ms = 0.0;
+	HardwareCounterValues counters;   ///< Sumados, como `ms`.
+};
+
+/**
+ * @brief Lo de un hilo que no es el que cierra los frames.
+ */
+struct ProfileThread {
+	uint32_t thread = 0;
+	uint32_t zones = 0;
+	double busyMs = 0.0;      ///< Suma de sus zonas de primer nivel.
+};
+
+/**
+ * @brief Desglose de un frame.
+ */
+struct ProfileFrame {
+	uint64_t frame = 0;
+	double frameMs = 0.0;                ///< Entre este `endFrame` y el anterior.
+	int64_t end = 0;                     ///< Cundo cerr, en nanosegundos de `Profiler::now`.
+	std::vector<ProfileNode> nodes;      ///< Del hilo de `endFrame`, en preorden.
+	std::vector<ProfileThread> threads;  ///< Los dems hilos con zonas en el frame.
+	uint64_t dropped = 0;                ///< Zonas que no cupieron en su hilo desde el frame anterior.
+};
+
+/**
+ * @class Profiler
+ * @brief Junta las zonas de `PROFILE_SCOPE` de todos los hilos y arma, en cada frame, el
+ *        desglose por jerarqua del hilo principal.
+ *
+ * Cada hilo escribe sus zonas en su propia `TSpscQueue`, sin candados: el nico candado es el
+ * de la primera zona de cada hilo, que registra su cola. `endFrame` las vaca desde el hilo
+ * que cierra los frames, y una cola llena descarta la zona y la cuenta en `dropped`. Apagado
+ * (`setEnabled`), una zona cuesta una lectura atmica; encendido, dos lecturas del reloj y un
+ * `tryPush`.
+ *
+ * El nombre de una zona o de un contador se guarda como puntero: un literal o algo que viva
+ * tanto como el profiler (el `getName` de un `System`, por ejemplo). Los contadores van por
+ * la misma va, en una cola aparte de cada hilo.
+ *
+ * Con `HardwareCounters` encendido, cada zona tambin guarda los ciclos, instrucciones y fallos
+ * de cach y de saltos de su hilo entre el comienzo y el fin (las de adentro incluidas, como el
+ * tiempo).
+ */
+class
+Profiler {
+public:
+	static constexpr size_t kZonesPerThread = 16384;   ///< Por frame y por hilo.
+	static constexpr size_t kCountersPerThread = 1024;
+
+	using Clock = std::chrono::steady_clock;
+
+	static Profiler&
+	instance() {
+		static Profiler s_profiler;
+		return s_profiler;
+	}
+
+	void
+	setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+	bool
+	isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+	static int64_t
+	now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count(); }
+
+	/**
+	 * @brief Una zona del hilo actual que ya termin. La llama `ProfileScope`.
+	 */
+	void
+	record(const char* name, int64_t start, int64_t end, uint32_t depth, const HardwareCounterValues& counters = {});
+
+	/**
+	 * @brief Anota que `name` vale `value` ahora, desde el hilo actual. La llama `PROFILE_COUNTER`.
+	 */
+	void
+	counter(const char* name, double value);
+
+	/**
+	 * @brief Nombre del hilo actual en las trazas; una vez, al arrancarlo.
+	 */
+	void
+	setThreadName(const std::string& name);
+
+	/**
+	 * @brief El de `setThreadName` del hilo con carril `thread`, o vaco.
+	 */
+	std::string
+	threadName(uint32_t thread) const;
+
+	/**
+	 * @brief Cierra el frame: vaca las colas de todos los hilos y arma `lastFrame`. Siempre
+	 *        desde el mismo hilo, fuera de toda zona.
+	 */
+	void
+	endFrame();
+
+	/**
+	 * @brief Del hilo de `endFrame`.
+	 */
+	const ProfileFrame&
+	lastFrame() const { return m_frame; }
+
+	/**
+	 * @brief Todas las zonas del ltimo frame, de todos los hilos, por hilo y por comienzo.
+	 */
+	const std::vector<ProfileZone>&
+	lastZones() const { return m_zones; }
+
+	/**
+	 * @brief Los contadores del ltimo frame, por tiempo.
+	 */
+	const std::vector<ProfileCounter>&
+	lastCounters() const { return m_counters; }
+
+private:
+	struct ThreadBuffer {
+		EngineUtilities::TSpscQueue<ProfileZone> zones{ kZonesPerThread };
+		EngineUtilities::TSpscQueue<ProfileCounter> counters{ kCountersPerThread };
+		uint32_t thread = 0;
+		std::thread::id id;
+		std::atomic<uint64_t> dropped{ 0 };   ///< Lo escribe su hilo, lo lee `endFrame`.
+		uint64_t reported = 0;                ///< De `endFrame`: `dropped` ya contado.
+	};
+
+	struct TreeNode {
+		const char* name = nullptr;
+		uint32_t depth = 0;
+		uint32_t calls = 0;
+		int64_t nanoseconds = 0;
+		HardwareCounterValues counters;
+		uint32_t firstChild = kNoNode;
+		uint32_t lastChild = kNoNode;
+		uint32_t nextSibling = kNoNode;
+	};
+
+	static constexpr uint32_t kNoNode = ~uint32_t(0);
+
+	Profiler() = default;
+
+	/**
+	 * @brief Cola del hilo actual; la registra la primera vez.
+	 */
+	ThreadBuffer&
+	threadBuffer();
+
+	/**
+	 * @brief Arma `m_frame.nodes` con las zonas de `thread`, ya ordenadas.
+	 */
+	void
+	buildTree(uint32_t thread);
+
+	static inline thread_local ThreadBuffer* t_buffer = nullptr;
+
+	std::atomic<bool> m_enabled{ false };
+	mutable std::mutex m_threadsMutex;
+	std::vector<EngineUtilities::TUniquePtr<ThreadBuffer>> m_threads;   ///< Nunca se borran.
+	std::vector<std::pair<std::thread::id, std::string>> m_threadNames; ///< De `setThreadName`.
+	std::vector<ThreadBuffer*> m_drain;                                 ///< De `endFrame`; copia de `m_threads`.
+	std::vector<ProfileZone> m_zones;
+	std::vector<ProfileCounter> m_counters;
+	std::vector<TreeNode> m_tree;
+	std::vector<std::pair<uint32_t, int64_t>> m_open;                   ///< Nodo y fin de las zonas abiertas.
+	ProfileFrame m_frame;
+	int64_t m_lastFrameEnd = 0;
+	uint64_t m_frameCount = 0;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Mide desde su construccin hasta su destruccin; se usa con `PROFILE_SCOPE`.
+ */
+class
+ProfileScope {
+public:
+	explicit
+	ProfileScope(const char* name) {
+		Profiler& profiler = Profiler::instance();
+		if (profiler.isEnabled()) {
+			m_name = name;
+			m_depth = s_depth++;
+			m_start = Profiler::now();
+			m_counting = HardwareCounters::isEnabled() && HardwareCounters::read(m_counters);
+		}
+	}
+
+	~ProfileScope() {
+		if (m_name) {
+			// Primero los contadores: lo de clock y record no es de la zona
+			HardwareCounterValues counters;
+			if (m_counting) {
+				HardwareCounters::read(counters);
+				counters = counters - m_counters;
+			}
+			int64_t end = Profiler::now();
+			--s_depth;
+			Profiler::instance().record(m_name, m_start, end, m_depth, counters);
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	static inline thread_local uint32_t s_depth = 0;
+
+	const char* m_name = nullptr;   ///< Nulo si el profiler estaba apagado.
+	int64_t m_start = 0;
+	uint32_t m_depth = 0;
+	bool m_counting = false;          ///< `m_counters` es del comienzo.
+	HardwareCounterValues m_counters;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if ENGINE_PROFILE
+/**
+ * @brief Zona con nombre `name`, un literal, hasta el final del bloque; con `ENGINE_TRACY`,
+ *        tambin en Tracy.
+ */
+#define PROFILE_SCOPE(name)                                         \
+	::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name);    \
+	ENGINE_TRACY_ZONE(name)
+
+/**
+ * @brief Como `PROFILE_SCOPE`, con un nombre que no es literal pero vive ms que la zona.
+ */
+#define PROFILE_SCOPE_DYNAMIC(name)                                 \
+	::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name);    \
+	ENGINE_TRACY_ZONE_DYNAMIC(name)
+
+/**
+ * @brief Valor `value` del contador `name`, ahora.
+ */
+#define PROFILE_COUNTER(name, value)                                        \
+	do {                                                                    \
+		::Profiler::instance().counter(name, static_cast<double>(value));   \
+		ENGINE_TRACY_PLOT(name, value);                                     \
+	} while (0)
+#else
+#define PROFILE_SCOPE(name) ENGINE_TRACY_ZONE(name)
+#define PROFILE_SCOPE_DYNAMIC(name) ENGINE_TRACY_ZONE_DYNAMIC(name)
+#define PROFILE_COUNTER(name, value) ENGINE_TRACY_PLOT(name, value)
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "Profiling/Profiler.h"
+
+/**
+ * @class TraceCapture
+ * @brief Junta las zonas y contadores del `Profiler` durante unos frames y los escribe en el
+ *        formato de eventos de Chrome (`chrome://tracing`, Perfetto).
+ *
+ * Cada hilo es un carril con el nombre de `Profiler::setThreadName`; cada contador, una serie;
+ * y el fin de cada frame, una marca. Los tiempos van en microsegundos desde la primera zona de
+ * la captura. Se escribe todo junto al terminar, as que el nico frame que se demora es el
+ * ltimo. Los frames marcados con `markHitch` salen adems como una zona que los abarca.
+ */
+class
+TraceCapture {
+public:
+	static constexpr uint32_t kDefaultFrames = 300;
+
+	/**
+	 * @brief Empieza a juntar los prximos `frames` frames para `path`; descarta lo que hubiera.
+	 */
+	void
+	start(const std::string& path, uint32_t frames = kDefaultFrames);
+
+	bool
+	isActive() const { return m_remaining > 0; }
+
+	const std::string&
+	path() const { return m_path; }
+
+	/**
+	 * @brief Agrega el ltimo frame de `profiler`, despus de su `endFrame`.
+	 * @return `true` si con este se juntaron todos; falta `write`.
+	 */
+	bool
+	addFrame(const Profiler& profiler);
+
+	/**
+	 * @brief Igual, con lo de un frame guardado aparte (`HitchRecorder`).
+	 * @param end Cundo cerr el frame, en nanosegundos de `Profiler::now`.
+	 */
+	bool
+	addFrame(std::span<const ProfileZone> zones, std::span<const ProfileCounter> counters, int64_t end);
+
+	/**
+	 * @brief Marca el frame de `start` a `end` como un tirn: sale como una zona `Hitch` en el
+	 *        carril 0 que abarca el frame, con su duracin como argumento.
+	 */
+	void
+	markHitch(int64_t start, int64_t end);
+
+	/**
+	 * @brief Escribe lo juntado en `path()` con los nombres de hilo de `profiler`.
+	 */
+	bool
+	write(const Profiler& profiler) const;
+
+private:
+	std::string m_path;
+	uint32_t m_remaining = 0;
+	uint32_t m_threads = 0;                 ///< Carriles vistos.
+	std::vector<ProfileZone> m_zones;
+	std::vector<ProfileCounter> m_counters;
+	std::vector<int64_t> m_frameEnds;
+	std::vector<std::pair<int64_t, int64_t>> m_hitches;   ///< Comienzo y fin de cada frame marcado.
+};
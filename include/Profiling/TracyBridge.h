@@ -0,0 +1,72 @@
+#pragma once
+#include <mutex>
+
+/**
+ * @brief Conecta el motor con el profiler Tracy. Apagado por defecto: las macros de abajo no
+ *        generan cdigo y no hace falta Tracy para compilar.
+ *
+ * Con `ENGINE_TRACY=1` la build necesita las cabeceras de Tracy en la ruta de inclusin
+ * (`<tracy/Tracy.hpp>`) y `TracyClient.cpp` en el proyecto, compilado con `TRACY_ENABLE`.
+ * Entonces cada `PROFILE_SCOPE` es tambin una zona de Tracy, cada `PROFILE_COUNTER` un
+ * grfico, `Window::display` marca el frame, `GpuTimer` manda sus pases como zonas de GPU,
+ * `MemoryAccounting` cada bloque como reserva de su subsistema y los `EngineMutex` sus
+ * esperas. Un cliente de Tracy se conecta al proceso en vivo, tambin desde otra mquina.
+ */
+#ifndef ENGINE_TRACY
+#define ENGINE_TRACY 0
+#endif
+
+constexpr bool kTracy = ENGINE_TRACY != 0;
+
+#if ENGINE_TRACY
+#ifndef TRACY_ENABLE
+#define TRACY_ENABLE
+#endif
+#include <tracy/Tracy.hpp>
+#include <tracy/TracyC.h>
+
+#define ENGINE_TRACY_CONCAT_INNER(a, b) a##b
+#define ENGINE_TRACY_CONCAT(a, b) ENGINE_TRACY_CONCAT_INNER(a, b)
+
+/**
+ * @brief Zona de Tracy hasta el final del bloque; `name` es un literal.
+ */
+#define ENGINE_TRACY_ZONE(name) ZoneNamedN(ENGINE_TRACY_CONCAT(tracyZone, __LINE__), name, true)
+
+/**
+ * @brief Como `ENGINE_TRACY_ZONE`, con un nombre que se arma al correr (se copia en cada zona).
+ */
+#define ENGINE_TRACY_ZONE_DYNAMIC(name) ZoneTransientN(ENGINE_TRACY_CONCAT(tracyZone, __LINE__), name, true)
+
+#define ENGINE_TRACY_PLOT(name, value) TracyPlot(name, static_cast<double>(value))
+#define ENGINE_TRACY_FRAME() FrameMark
+#define ENGINE_TRACY_THREAD_NAME(name) ::tracy::SetThreadName(name)
+
+/**
+ * @brief Reserva y liberacin de `pointer` en el grupo `pool`, un literal con vida de programa.
+ */
+#define ENGINE_TRACY_ALLOC(pointer, bytes, pool) TracyAllocN(pointer, bytes, pool)
+#define ENGINE_TRACY_FREE(pointer, pool) TracyFreeN(pointer, pool)
+
+/**
+ * @brief Un `std::mutex` que Tracy ve: quin lo tiene, quin espera y cunto.
+ */
+using EngineMutex = tracy::Lockable<std::mutex>;
+
+/**
+ * @brief Declara un `EngineMutex` con su nombre en Tracy.
+ */
+#define ENGINE_MUTEX(name) TracyLockableN(std::mutex, name, #name)
+#else
+#define ENGINE_TRACY_ZONE(name) ((void)0)
+#define ENGINE_TRACY_ZONE_DYNAMIC(name) ((void)0)
+#define ENGINE_TRACY_PLOT(name, value) ((void)0)
+#define ENGINE_TRACY_FRAME() ((void)0)
+#define ENGINE_TRACY_THREAD_NAME(name) ((void)0)
+#define ENGINE_TRACY_ALLOC(pointer, bytes, pool) ((void)0)
+#define ENGINE_TRACY_FREE(pointer, pool) ((void)0)
+
+using EngineMutex = std::mutex;
+
+#define ENGINE_MUTEX(name) std::mutex name
+#endif
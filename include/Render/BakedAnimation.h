@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Math/Mat4.h"
+
+class MeshPipeline;
+class Skeleton;
+class SkeletalClip;
+
+/**
+ * @brief Una instancia de `RenderCommandBuffer::drawSkinnedInstances`: su matriz de mundo y en
+ *        qu segundo de la animacin va. Cinco `vec4`, como los lee el shader.
+ */
+struct SkinnedInstance {
+	Mat4 model;
+	float time = 0.0f;
+	float reserved[3] = {};
+};
+
+static_assert(sizeof(SkinnedInstance) == 80, "SkinnedInstance debe ser cinco vec4");
+
+/**
+ * @class BakedAnimation
+ * @brief Un clip de esqueleto horneado: las matrices de piel de todos sus huesos en cada
+ *        cuadro, listas para el shader.
+ *
+ * `MeshPipeline` la sube una vez a un bfer de textura que vive en la GPU entre frames, y las
+ * multitudes (`drawSkinnedInstances`) solo mandan por instancia su matriz y su tiempo: el
+ * shader busca los dos cuadros vecinos y mezcla sus matrices. Nada se evala en la CPU por
+ * personaje ni por frame.
+ *
+ * Como `Mesh`: un comando la guarda por puntero, as que no debe cambiar ni destruirse hasta
+ * que se dibuje.
+ */
+class
+BakedAnimation {
+public:
+	static constexpr float kDefaultFrameRate = 30.0f;
+
+	BakedAnimation() = default;
+
+	/**
+	 * @brief Libera su tramo en la GPU, si lo tiene.
+	 */
+	~BakedAnimation();
+
+	BakedAnimation(const BakedAnimation&) = delete;
+	BakedAnimation& operator=(const BakedAnimation&) = delete;
+
+	/**
+	 * @brief Evala `clip` sobre `skeleton` a `frameRate` cuadros por segundo; se vuelve a
+	 *        subir en el prximo dibujo.
+	 */
+	void
+	bake(const Skeleton& skeleton, const SkeletalClip& clip, float frameRate = kDefaultFrameRate);
+
+	uint32_t
+	boneCount() const { return m_boneCount; }
+
+	uint32_t
+	frameCount() const { return m_frameCount; }
+
+	float
+	frameRate() const { return m_frameRate; }
+
+	bool
+	isLooping() const { return m_loop; }
+
+	/**
+	 * @brief `frameCount() * boneCount()` matrices, cuadro por cuadro.
+	 */
+	const std::vector<Mat4>&
+	matrices() const { return m_matrices; }
+
+	size_t
+	bytes() const { return m_matrices.size() * sizeof(Mat4); }
+
+	uint32_t
+	version() const { return m_version; }
+
+private:
+	friend class MeshPipeline;
+
+	std::vector<Mat4> m_matrices;
+	uint32_t m_boneCount = 0;
+	uint32_t m_frameCount = 0;
+	float m_frameRate = kDefaultFrameRate;
+	bool m_loop = true;
+	uint32_t m_version = 0;
+
+	// Tramo en el bfer de `m_pipeline`; no es parte de la animacin
+	mutable MeshPipeline* m_pipeline = nullptr;
+	mutable uint32_t m_uploadedVersion = 0;
+	mutable uint32_t m_firstMatrix = 0;
+	mutable uint32_t m_residentIndex = 0;
+};
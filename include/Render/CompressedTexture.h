@@ -0,0 +1,138 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Prerequisites.h"
+
+/**
+ * @brief Formatos de bloques de 4x4 pxeles que la GPU lee sin descomprimir.
+ */
+enum class BlockFormat : uint8_t {
+	Bc1,   ///< DXT1: 8 bytes por bloque, sin alfa; 1/8 de RGBA.
+	Bc3,   ///< DXT5: 16 bytes, con alfa; 1/4 de RGBA.
+	Bc7    ///< 16 bytes, mejor calidad; solo se carga, el cocinado no lo produce.
+};
+
+/**
+ * @brief Una imagen en bloques, con sus niveles de mipmap uno tras otro en `data`.
+ */
+struct CompressedImage {
+	struct Level {
+		size_t offset = 0;
+		size_t size = 0;
+		unsigned int width = 0;
+		unsigned int height = 0;
+	};
+
+	BlockFormat format = BlockFormat::Bc1;
+	bool srgb = false;
+	unsigned int width = 0;
+	unsigned int height = 0;
+	std::vector<Level> levels;       ///< El 0 es el de tamao completo.
+	std::vector<unsigned char> data;
+
+	bool
+	empty() const { return levels.empty(); }
+};
+
+/**
+ * @class CompressedTexture
+ * @brief Texturas BC1/BC3/BC7 en `.dds`: las lee, las sube a un `sf::Texture` con
+ *        `glCompressedTexImage2D` y, fuera del juego, cocina BC1/BC3 desde cualquier imagen.
+ *
+ * Subida, la textura sigue siendo un `sf::Texture` como cualquier otro (figuras, sprites,
+ * `TextureLoader`): `upload` la crea del tamao de la imagen y reemplaza su almacenamiento por
+ * los bloques, con sus mipmaps. Ocupa de 4 a 8 veces menos memoria de video y ancho de banda
+ * de subida que RGBA. Lo que lee los pxeles de vuelta (`copyToImage`, `update`) ya no sirve
+ * sobre ella, y `setSmooth` quita el filtro de mipmaps.
+ *
+ * Si el driver no tiene el formato (`isSupported`), BC1 y BC3 se descomprimen en la CPU y se
+ * suben como RGBA; BC7 no tiene ese respaldo y falla.
+ *
+ * `parseDds`, `encode`, `decode` y `cookFile` sirven en cualquier hilo; `isSupported`,
+ * `upload` y `uploadedBytes`, con el contexto de la ventana activo.
+ */
+class
+CompressedTexture {
+public:
+	/**
+	 * @brief Bytes de un bloque de 4x4 en `format`.
+	 */
+	static constexpr size_t
+	blockBytes(BlockFormat format) { return format == BlockFormat::Bc1 ? 8 : 16; }
+
+	/**
+	 * @brief Si `bytes` empiezan como un `.dds`.
+	 */
+	static bool
+	isDds(std::span<const unsigned char> bytes);
+
+	/**
+	 * @brief Si `path` termina en `.dds`, sin distinguir maysculas.
+	 */
+	static bool
+	hasDdsExtension(std::string_view path);
+
+	/**
+	 * @brief Lee un `.dds` 2D de BC1, BC3 o BC7 (`DXT1`, `DXT5` o cabecera DX10), con sus mipmaps.
+	 * @return `false` si es otro formato, un arreglo o un cubo, o est truncado.
+	 */
+	static bool
+	parseDds(std::span<const unsigned char> bytes, CompressedImage& image);
+
+	/**
+	 * @brief `image` como `.dds`: `DXT1`/`DXT5` sin sRGB; cabecera DX10 con sRGB o BC7.
+	 */
+	static std::vector<unsigned char>
+	writeDds(const CompressedImage& image);
+
+	/**
+	 * @brief Comprime `source` a BC1 o BC3, con todos sus mipmaps si `mipmaps`.
+	 *
+	 * Por bloque, los extremos son la caja de colores recortada un dieciseisavo por lado y
+	 * cada pxel toma el ms cercano de la paleta: rpido y sin sorpresas, no el ptimo.
+	 *
+	 * @return `false` si `format` es BC7.
+	 */
+	static bool
+	encode(const sf::Image& source, BlockFormat format, bool mipmaps, CompressedImage& image);
+
+	/**
+	 * @brief Descomprime el nivel 0 de `image` a RGBA.
+	 * @return `false` si es BC7.
+	 */
+	static bool
+	decode(const CompressedImage& image, sf::Image& out);
+
+	/**
+	 * @brief Cocina `sourcePath` (PNG, JPG, TGA...) en un `.dds` con mipmaps. Sin formato
+	 *        explcito, BC3 si algn pxel es transparente y BC1 si no.
+	 */
+	static bool
+	cookFile(const std::string& sourcePath, const std::string& ddsPath, const BlockFormat* format = nullptr);
+
+	/**
+	 * @brief Si el driver lee `format` en bloques.
+	 */
+	static bool
+	isSupported(BlockFormat format);
+
+	/**
+	 * @brief Deja en `texture` la imagen de `image`: en bloques si `isSupported`, descomprimida
+	 *        si no (BC1 y BC3).
+	 * @param skipLevels Mipmaps grandes que no se suben (siempre queda el ltimo). La textura
+	 *        conserva el tamao de `image`, as que los rectngulos en pxeles no cambian: solo
+	 *        se ve con menos detalle. Descomprimida se sube entera.
+	 * @return `false` si no pudo crearse.
+	 */
+	static bool
+	upload(sf::Texture& texture, const CompressedImage& image, size_t skipLevels = 0);
+
+	/**
+	 * @brief Bytes que ocupa `image` en la GPU subida con `skipLevels`.
+	 */
+	static size_t
+	uploadedBytes(const CompressedImage& image, size_t skipLevels = 0);
+};
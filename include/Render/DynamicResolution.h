@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include "Prerequisites.h"
+
+/**
+ * @class DynamicResolution
+ * @brief Escala de la resolucin de la escena que se ajusta sola para que el tiempo de GPU
+ *        del frame no pase de un objetivo.
+ *
+ * `update` recibe el tiempo de GPU de cada frame (`GpuTimings::totalMs`) y lo suaviza. Si el
+ * promedio pasa del objetivo, la escala baja de una vez lo necesario (los pxeles, y casi todo
+ * el costo, van con el cuadrado de la escala); si queda por debajo del objetivo menos
+ * `headroom`, sube un paso. Entre las dos bandas no cambia, y tras cada cambio espera
+ * `cooldownFrames` frames: los tiempos llegan con retraso y la textura de la escena se recrea
+ * con cada tamao nuevo, as que no debe oscilar.
+ *
+ * La escala va siempre en mltiplos de `step`, entre `minScale` y `maxScale`.
+ */
+class
+DynamicResolution {
+public:
+	struct Settings {
+		double targetMs = 1000.0 / 60.0;  ///< Tiempo de GPU por frame que se quiere sostener.
+		float minScale = 0.5f;
+		float maxScale = 1.0f;
+		float step = 1.0f / 16.0f;        ///< Cunto sube de una vez, y granularidad de la escala.
+		double headroom = 0.15;           ///< Fraccin del objetivo que debe sobrar para subir.
+		uint32_t cooldownFrames = 30;
+	};
+
+	DynamicResolution() = default;
+
+	/**
+	 * @brief Cambia los lmites y vuelve a la escala mxima.
+	 */
+	void
+	setSettings(const Settings& settings);
+
+	const Settings&
+	settings() const { return m_settings; }
+
+	/**
+	 * @brief Cuenta un frame que tom `gpuMs` en la GPU.
+	 * @return `true` si la escala cambi.
+	 */
+	bool
+	update(double gpuMs);
+
+	/**
+	 * @brief Fraccin del tamao de la ventana con que se dibuja la escena, por lado.
+	 */
+	float
+	scale() const { return m_scale; }
+
+	/**
+	 * @brief Tiempo de GPU suavizado con que se decidi la escala.
+	 */
+	double
+	averageMs() const { return m_averageMs; }
+
+	/**
+	 * @brief Vuelve a la escala mxima y olvida los tiempos medidos.
+	 */
+	void
+	reset();
+
+	static constexpr double kSmoothing = 0.1; ///< Peso de cada frame nuevo en el promedio.
+
+private:
+	float
+	quantize(float scale) const;
+
+	Settings m_settings;
+	float m_scale = 1.0f;
+	double m_averageMs = 0.0;
+	uint32_t m_framesSinceChange = 0;
+	bool m_hasAverage = false;
+};
@@ -0,0 +1,150 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Prerequisites.h"
+#include "Jobs/JobSystem.h"
+#include "Render/GlFunctions.h"
+
+/**
+ * @class FrameCapture
+ * @brief Capturas de pantalla y grabacin de frames sin frenar el render: la lectura va por
+ *        un anillo de pixel buffer objects y la codificacin a PNG, en `JobSystem`.
+ *
+ * `sf::Texture::copyToImage` espera a que la GPU termine el frame y copie los pxeles. Aqu
+ * `capture` solo encola un `glReadPixels` hacia un PBO, con una valla (`glFenceSync`), y sigue:
+ * `kRingSize` frames despus, cuando la valla ya pas, el PBO se mapea, se copia a memoria y un
+ * trabajo da vuelta las filas y escribe el PNG. Ninguna llamada espera a la GPU: si la copia
+ * ms vieja no est lista cuando hace falta su PBO, o hay `kMaxPendingEncodes` PNG por
+ * escribir, el frame nuevo no se captura y se cuenta en `droppedFrames`.
+ *
+ * `requestScreenshot` y `setRecording` van desde cualquier hilo; `capture`, `initialize` y
+ * `release` en el hilo del contexto (`Window::display`). Grabar escribe una secuencia
+ * `frame_000000.png`, `frame_000001.png` y as en la carpeta, que cualquier editor arma como video.
+ */
+class
+FrameCapture {
+public:
+	static constexpr size_t kRingSize = 3;            ///< Frames de retraso entre leer y copiar.
+	static constexpr size_t kMaxPendingEncodes = 8;   ///< PNG en cola; ms, y se descartan frames.
+
+	FrameCapture() : m_jobs(EngineUtilities::TService<JobSystem>::instance()) {}
+
+	/**
+	 * @brief Espera a que se escriban los PNG en curso; los PBO se borran con `release`.
+	 */
+	~FrameCapture();
+
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator=(const FrameCapture&) = delete;
+
+	/**
+	 * @brief Crea los PBO con el contexto activo.
+	 * @return `false` si el contexto no tiene OpenGL 3.3.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_slots[0].buffer != 0; }
+
+	/**
+	 * @brief Borra los PBO y vallas; las lecturas pendientes se pierden.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Guarda el prximo frame en `path` (PNG).
+	 */
+	void
+	requestScreenshot(const std::string& path);
+
+	/**
+	 * @brief Con `true`, guarda cada frame en `directory` (que debe existir) hasta apagarlo.
+	 */
+	void
+	setRecording(bool enabled, const std::string& directory = ".");
+
+	bool
+	isRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Hay algo que capturar: `Window::display` solo llama `capture` entonces, o si
+	 *        quedan lecturas en vuelo.
+	 */
+	bool
+	isActive() const;
+
+	/**
+	 * @brief Encola la lectura de `target` si se pidi este frame y copia las lecturas
+	 *        anteriores que ya terminaron. `target` debe estar activo y ya dibujado.
+	 */
+	void
+	capture(sf::RenderTarget& target);
+
+	/**
+	 * @brief Espera a que se escriban todos los PNG encolados.
+	 */
+	void
+	finishEncoding();
+
+	size_t
+	capturedFrames() const { return m_captured.load(std::memory_order_relaxed); }
+
+	size_t
+	droppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	/**
+	 * @brief Un PBO del anillo y la lectura que lleva.
+	 */
+	struct Slot {
+		GLuint buffer = 0;
+		size_t capacity = 0;       ///< Bytes reservados en el PBO.
+		GlSync fence = nullptr;    ///< Lectura en vuelo; nulo si el PBO est libre.
+		sf::Vector2u size;
+		std::string path;
+	};
+
+	/**
+	 * @brief Un PNG por escribir: el trabajo lo llena y marca `done`.
+	 */
+	struct Encode {
+		std::vector<uint8_t> pixels;
+		sf::Vector2u size;
+		std::string path;
+		std::atomic<bool> done{ true };
+	};
+
+	/**
+	 * @brief Copia `slot` a un `Encode` libre y lanza su trabajo, si la valla ya pas.
+	 * @return `false` si la GPU todava no termina la lectura.
+	 */
+	bool
+	collect(Slot& slot);
+
+	/**
+	 * @brief Un `Encode` que no est en uso, o nulo si hay `kMaxPendingEncodes` en curso.
+	 */
+	Encode*
+	freeEncode();
+
+	JobSystem& m_jobs;
+	JobCounter m_counter;                                      ///< PNG en curso.
+	std::array<Slot, kRingSize> m_slots;
+	size_t m_next = 0;                                         ///< Slot de la prxima lectura.
+	std::vector<EngineUtilities::TUniquePtr<Encode>> m_encodes; ///< Se reutilizan con su memoria.
+
+	mutable std::mutex m_mutex;                                ///< Lo de abajo se pide desde otros hilos.
+	std::vector<std::string> m_screenshots;
+	std::string m_recordDirectory;
+	std::atomic<bool> m_recording{ false };
+	uint32_t m_recordFrame = 0;
+
+	std::atomic<size_t> m_captured{ 0 };
+	std::atomic<size_t> m_dropped{ 0 };
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Qu tan tarde despert `FramePacer` desde el ltimo `takeStats`.
+ */
+struct PacingStats {
+	uint32_t frames = 0;
+	double meanLateUs = 0.0;
+	double maxLateUs = 0.0;
+	double spinUs = 0.0;        ///< Margen de espera activa al tomar la muestra.
+};
+
+/**
+ * @class FramePacer
+ * @brief Espera hasta un instante con precisin de microsegundos: duerme lo grueso y gira lo
+ *        ltimo.
+ *
+ * Dormir hasta el lmite despierta tarde lo que tarde el temporizador del sistema (en Windows
+ * sin nada ms, hasta 15 ms; en Linux, decenas de microsegundos con carga), y eso es lo que
+ * hace temblar el ritmo de `sf::Window::setFramerateLimit`. `waitUntil` duerme hasta `spin`
+ * antes del lmite y el resto espera activa con la instruccin de pausa del procesador. El
+ * margen se adapta a lo que se pasa cada dormida: sube de una vez hasta cubrir el peor caso
+ * visto y baja despacio, entre `kMinSpin` y `kMaxSpin`.
+ *
+ * En Windows duerme con un temporizador de alta resolucin (`CREATE_WAITABLE_TIMER_HIGH_RESOLUTION`,
+ * Windows 10 1803 o posterior; si no, uno comn); en el resto, `sleep_until` sobre el reloj
+ * montono.
+ *
+ * Un solo hilo.
+ */
+class
+FramePacer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr Clock::duration kMinSpin = std::chrono::microseconds(200);
+	static constexpr Clock::duration kMaxSpin = std::chrono::milliseconds(4);
+
+	FramePacer();
+
+	/**
+	 * @brief Cierra el temporizador.
+	 */
+	~FramePacer();
+
+	FramePacer(const FramePacer&) = delete;
+	FramePacer& operator=(const FramePacer&) = delete;
+
+	/**
+	 * @brief Vuelve cuando llega `deadline`, o en el acto si ya pas.
+	 */
+	void
+	waitUntil(Clock::time_point deadline);
+
+	/**
+	 * @brief Con `false` solo duerme, sin girar: para comparar el ritmo con y sin.
+	 */
+	void
+	setSpinEnabled(bool enabled) { m_spinEnabled = enabled; }
+
+	bool
+	isSpinEnabled() const { return m_spinEnabled; }
+
+	Clock::duration
+	spin() const { return m_spin; }
+
+	/**
+	 * @brief Lo que se atrasaron las esperas desde la llamada anterior, y vuelve a contar.
+	 */
+	PacingStats
+	takeStats();
+
+	/**
+	 * @brief Frecuencia de la pantalla principal, o 0 si esta plataforma no la da.
+	 */
+	static double
+	displayRefreshRate();
+
+	/**
+	 * @brief El divisor entero de `refreshHz` ms cercano a `hz` sin pasarlo, para que cada frame
+	 *        caiga siempre en el mismo refresco: 100 en una pantalla de 144 Hz da 72. Sin
+	 *        refresco conocido, o con `hz` mayor o igual que l, `hz`.
+	 */
+	static double
+	alignToRefresh(double hz, double refreshHz);
+
+private:
+	/**
+	 * @brief Duerme hasta `until`, con lo que tenga la plataforma.
+	 */
+	void
+	sleepUntil(Clock::time_point until);
+
+	Clock::duration m_spin = std::chrono::milliseconds(1);
+	bool m_spinEnabled = true;
+	void* m_timer = nullptr;        ///< `HANDLE` del temporizador en Windows.
+	uint32_t m_frames = 0;
+	int64_t m_lateNs = 0;
+	int64_t m_maxLateNs = 0;
+};
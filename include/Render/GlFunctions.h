@@ -0,0 +1,254 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <SFML/OpenGL.hpp>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+/**
+ * @file GlFunctions.h
+ * @brief Las funciones de OpenGL 3.3 que usan los renderers propios, pedidas a SFML con
+ *        `sf::Context::getFunction`: no hace falta un cargador aparte.
+ *
+ * La cabecera del sistema (1.1 en Windows) no trae nada posterior, as que aqu tambin estn
+ * las constantes que se usan. Se cargan una vez, con algn contexto activo; las direcciones
+ * sirven para todos los contextos del mismo driver.
+ */
+
+constexpr GLenum kGlArrayBuffer = 0x8892;
+constexpr GLenum kGlElementArrayBuffer = 0x8893;
+constexpr GLenum kGlCopyReadBuffer = 0x8F36;
+constexpr GLenum kGlCopyWriteBuffer = 0x8F37;
+constexpr GLenum kGlUniformBuffer = 0x8A11;
+constexpr GLenum kGlStreamDraw = 0x88E0;
+constexpr GLenum kGlStaticDraw = 0x88E4;
+constexpr GLenum kGlFragmentShader = 0x8B30;
+constexpr GLenum kGlVertexShader = 0x8B31;
+constexpr GLenum kGlCompileStatus = 0x8B81;
+constexpr GLenum kGlLinkStatus = 0x8B82;
+constexpr GLenum kGlProgramBinaryRetrievableHint = 0x8257;
+constexpr GLenum kGlProgramBinaryLength = 0x8741;
+constexpr GLenum kGlTimestamp = 0x8E28;
+constexpr GLenum kGlQueryResult = 0x8866;
+constexpr GLenum kGlQueryResultAvailable = 0x8867;
+constexpr GLenum kGlTextureBuffer = 0x8C2A;
+constexpr GLenum kGlTexture0 = 0x84C0;
+constexpr GLenum kGlRgba32f = 0x8814;
+constexpr GLenum kGlRg32ui = 0x823C;
+constexpr GLenum kGlR32ui = 0x8236;
+constexpr GLenum kGlPixelPackBuffer = 0x88EB;
+constexpr GLenum kGlStreamRead = 0x88E1;
+constexpr GLbitfield kGlMapReadBit = 0x0001;
+constexpr GLbitfield kGlMapWriteBit = 0x0002;
+constexpr GLbitfield kGlMapInvalidateRangeBit = 0x0004;
+constexpr GLbitfield kGlMapUnsynchronizedBit = 0x0020;
+constexpr GLbitfield kGlMapPersistentBit = 0x0040;
+constexpr GLbitfield kGlMapCoherentBit = 0x0080;
+constexpr GLbitfield kGlSyncFlushCommandsBit = 0x0001;
+constexpr GLenum kGlSyncGpuCommandsComplete = 0x9117;
+constexpr GLenum kGlAlreadySignaled = 0x911A;
+constexpr GLenum kGlConditionSatisfied = 0x911C;
+constexpr GLenum kGlWaitFailed = 0x911D;
+constexpr GLenum kGlTextureMaxLevel = 0x813D;
+constexpr GLenum kGlNumCompressedTextureFormats = 0x86A2;
+constexpr GLenum kGlCompressedTextureFormats = 0x86A3;
+constexpr GLenum kGlCompressedRgbaS3tcDxt1 = 0x83F1;
+constexpr GLenum kGlCompressedRgbaS3tcDxt5 = 0x83F3;
+constexpr GLenum kGlCompressedSrgbAlphaS3tcDxt1 = 0x8C4D;
+constexpr GLenum kGlCompressedSrgbAlphaS3tcDxt5 = 0x8C4F;
+constexpr GLenum kGlCompressedRgbaBptcUnorm = 0x8E8C;
+constexpr GLenum kGlCompressedSrgbAlphaBptcUnorm = 0x8E8D;
+constexpr GLenum kGlComputeShader = 0x91B9;
+constexpr GLenum kGlShaderStorageBuffer = 0x90D2;
+constexpr GLenum kGlDynamicCopy = 0x88EA;
+constexpr GLbitfield kGlShaderStorageBarrierBit = 0x2000;
+constexpr GLenum kGlFramebuffer = 0x8D40;
+constexpr GLenum kGlReadFramebuffer = 0x8CA8;
+constexpr GLenum kGlDrawFramebuffer = 0x8CA9;
+constexpr GLenum kGlFramebufferBinding = 0x8CA6;
+constexpr GLenum kGlFramebufferComplete = 0x8CD5;
+constexpr GLenum kGlDepthAttachment = 0x8D00;
+constexpr GLenum kGlDepthComponent24 = 0x81A6;
+constexpr GLenum kGlDepthClamp = 0x864F;
+constexpr GLenum kGlClampToEdge = 0x812F;
+constexpr GLenum kGlTextureCompareMode = 0x884C;
+constexpr GLenum kGlTextureCompareFunc = 0x884D;
+constexpr GLenum kGlCompareRefToTexture = 0x884E;
+
+/**
+ * @brief `GLsync` de OpenGL 3.2, que la cabecera del sistema no trae.
+ */
+using GlSync = struct GlSyncObject*;
+
+struct GlFunctions {
+	void (APIENTRY* genVertexArrays)(GLsizei, GLuint*);
+	void (APIENTRY* bindVertexArray)(GLuint);
+	void (APIENTRY* deleteVertexArrays)(GLsizei, const GLuint*);
+	void (APIENTRY* genBuffers)(GLsizei, GLuint*);
+	void (APIENTRY* bindBuffer)(GLenum, GLuint);
+	void (APIENTRY* bufferData)(GLenum, std::ptrdiff_t, const void*, GLenum);
+	void (APIENTRY* bufferSubData)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*);
+	void (APIENTRY* copyBufferSubData)(GLenum, GLenum, std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+	void (APIENTRY* deleteBuffers)(GLsizei, const GLuint*);
+	void (APIENTRY* vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+	void (APIENTRY* enableVertexAttribArray)(GLuint);
+	void (APIENTRY* vertexAttribDivisor)(GLuint, GLuint);
+	void (APIENTRY* drawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei);
+	void (APIENTRY* drawElementsBaseVertex)(GLenum, GLsizei, GLenum, const void*, GLint);
+	void (APIENTRY* drawElementsInstancedBaseVertex)(GLenum, GLsizei, GLenum, const void*, GLsizei, GLint);
+	GLuint (APIENTRY* createShader)(GLenum);
+	void (APIENTRY* shaderSource)(GLuint, GLsizei, const char* const*, const GLint*);
+	void (APIENTRY* compileShader)(GLuint);
+	void (APIENTRY* getShaderiv)(GLuint, GLenum, GLint*);
+	void (APIENTRY* deleteShader)(GLuint);
+	GLuint (APIENTRY* createProgram)();
+	void (APIENTRY* attachShader)(GLuint, GLuint);
+	void (APIENTRY* linkProgram)(GLuint);
+	void (APIENTRY* getProgramiv)(GLuint, GLenum, GLint*);
+	void (APIENTRY* deleteProgram)(GLuint);
+	void (APIENTRY* useProgram)(GLuint);
+	GLint (APIENTRY* getUniformLocation)(GLuint, const char*);
+	void (APIENTRY* uniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+	void (APIENTRY* uniform4fv)(GLint, GLsizei, const GLfloat*);
+	void (APIENTRY* uniform1i)(GLint, GLint);
+	void (APIENTRY* uniform1f)(GLint, GLfloat);
+	void (APIENTRY* activeTexture)(GLenum);
+	GLuint (APIENTRY* getUniformBlockIndex)(GLuint, const char*);
+	void (APIENTRY* uniformBlockBinding)(GLuint, GLuint, GLuint);
+	void (APIENTRY* bindBufferBase)(GLenum, GLuint, GLuint);
+	void* (APIENTRY* mapBufferRange)(GLenum, std::ptrdiff_t, std::ptrdiff_t, GLbitfield);
+	GLboolean (APIENTRY* unmapBuffer)(GLenum);
+	GlSync (APIENTRY* fenceSync)(GLenum, GLbitfield);
+	GLenum (APIENTRY* clientWaitSync)(GlSync, GLbitfield, uint64_t);
+	void (APIENTRY* deleteSync)(GlSync);
+
+	// De OpenGL 4.1 o ARB_get_program_binary: pueden quedar nulas sin que falle la carga
+	void (APIENTRY* programParameteri)(GLuint, GLenum, GLint);
+	void (APIENTRY* getProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+	void (APIENTRY* programBinary)(GLuint, GLenum, const void*, GLsizei);
+
+	// De ARB_timer_query (ncleo en 3.3, pero hay drivers que no la exponen): `GpuTimer`
+	void (APIENTRY* genQueries)(GLsizei, GLuint*);
+	void (APIENTRY* deleteQueries)(GLsizei, const GLuint*);
+	void (APIENTRY* queryCounter)(GLuint, GLenum);
+	void (APIENTRY* getQueryObjectiv)(GLuint, GLenum, GLint*);
+	void (APIENTRY* getQueryObjectui64v)(GLuint, GLenum, uint64_t*);
+
+	// De OpenGL 3.1: bferes de textura para las luces de `MeshPipeline`
+	void (APIENTRY* texBuffer)(GLenum, GLenum, GLuint);
+
+	// De OpenGL 1.3, fuera de la cabecera 1.1 de Windows: `CompressedTexture`
+	void (APIENTRY* compressedTexImage2D)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*);
+
+	// De OpenGL 4.3 o ARB_compute_shader: `GpuCrowd`
+	void (APIENTRY* dispatchCompute)(GLuint, GLuint, GLuint);
+	void (APIENTRY* memoryBarrier)(GLbitfield);
+
+	// De OpenGL 3.0 o ARB_framebuffer_object: sombras de `MeshPipeline`
+	void (APIENTRY* genFramebuffers)(GLsizei, GLuint*);
+	void (APIENTRY* deleteFramebuffers)(GLsizei, const GLuint*);
+	void (APIENTRY* bindFramebuffer)(GLenum, GLuint);
+	void (APIENTRY* framebufferTexture2D)(GLenum, GLenum, GLenum, GLuint, GLint);
+	GLenum (APIENTRY* checkFramebufferStatus)(GLenum);
+	void (APIENTRY* blitFramebuffer)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum);
+
+	// De OpenGL 4.2 o ARB_base_instance: el ndice de cada draw de `MeshPipeline`, sin uniformes
+	void (APIENTRY* drawElementsInstancedBaseVertexBaseInstance)(GLenum, GLsizei, GLenum, const void*, GLsizei, GLint, GLuint);
+
+	// De ARB_bindless_texture: texturas de los materiales de `MeshPipeline` sin enlazarlas
+	uint64_t (APIENTRY* getTextureHandleARB)(GLuint);
+	void (APIENTRY* makeTextureHandleResidentARB)(uint64_t);
+
+	// De OpenGL 4.4 o ARB_buffer_storage: el bfer mapeado para siempre de `StreamBuffer`
+	void (APIENTRY* bufferStorage)(GLenum, std::ptrdiff_t, const void*, GLbitfield);
+};
+
+/**
+ * @brief Funciones cargadas por `loadGlFunctions`.
+ */
+extern GlFunctions gl;
+
+/**
+ * @brief Carga `gl` la primera vez. Debe haber un contexto activo.
+ * @return `false` si al driver le falta alguna: no hay que usar `gl`.
+ */
+bool
+loadGlFunctions();
+
+/**
+ * @brief Indica si el driver puede devolver y recibir binarios de programa
+ *        (`ShaderCache`). Despus de `loadGlFunctions`.
+ */
+inline bool
+hasGlProgramBinaries() { return gl.programParameteri && gl.getProgramBinary && gl.programBinary; }
+
+/**
+ * @brief Indica si el driver tiene consultas de tiempo (`GpuTimer`). Despus de `loadGlFunctions`.
+ */
+inline bool
+hasGlTimerQueries() {
+	return gl.genQueries && gl.deleteQueries && gl.queryCounter && gl.getQueryObjectiv && gl.getQueryObjectui64v;
+}
+
+/**
+ * @brief Indica si el driver tiene bferes de textura (luces de `MeshPipeline`). Despus de
+ *        `loadGlFunctions`.
+ */
+inline bool
+hasGlTextureBuffers() { return gl.texBuffer != nullptr; }
+
+/**
+ * @brief Indica si el driver tiene compute shaders (`GpuCrowd`). Despus de `loadGlFunctions`;
+ *        aun as el shader `#version 430` puede no compilar en un contexto ms viejo.
+ */
+inline bool
+hasGlComputeShaders() { return gl.dispatchCompute && gl.memoryBarrier; }
+
+/**
+ * @brief Indica si el driver tiene framebuffers propios (sombras de `MeshPipeline`). Despus
+ *        de `loadGlFunctions`.
+ */
+inline bool
+hasGlFramebuffers() {
+	return gl.genFramebuffers && gl.deleteFramebuffers && gl.bindFramebuffer && gl.framebufferTexture2D &&
+	       gl.checkFramebufferStatus && gl.blitFramebuffer;
+}
+
+/**
+ * @brief Indica si el driver dibuja con instancia base (ndice de draw de `MeshPipeline`).
+ *        Despus de `loadGlFunctions`.
+ */
+inline bool
+hasGlBaseInstance() { return gl.drawElementsInstancedBaseVertexBaseInstance != nullptr; }
+
+/**
+ * @brief Indica si el driver tiene texturas sin enlace (materiales de `MeshPipeline`).
+ *        Despus de `loadGlFunctions`.
+ */
+inline bool
+hasGlBindlessTextures() { return gl.getTextureHandleARB && gl.makeTextureHandleResidentARB; }
+
+/**
+ * @brief Indica si el driver crea bferes inmutables que se pueden dejar mapeados
+ *        (`StreamBuffer`). Despus de `loadGlFunctions`.
+ */
+inline bool
+hasGlBufferStorage() { return gl.bufferStorage != nullptr; }
+
+/**
+ * @brief Compila y enlaza un programa con esos dos shaders.
+ * @param retrievable Pide al driver que guarde el binario para `getProgramBinary`.
+ * @return El programa, o 0 si algo no compil.
+ */
+GLuint
+linkGlProgram(const char* vertexSource, const char* fragmentSource, bool retrievable = false);
+
+/**
+ * @brief Compila y enlaza un programa de cmputo.
+ * @param retrievable Pide al driver que guarde el binario para `getProgramBinary`.
+ * @return El programa, o 0 si no compil.
+ */
+GLuint
+linkGlComputeProgram(const char* source, bool retrievable = false);
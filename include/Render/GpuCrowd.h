@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include "Prerequisites.h"
+
+/**
+ * @brief Un agente de `GpuCrowd`, con la disposicin `std430` que leen los shaders.
+ */
+struct GpuAgent {
+	float x = 0.0f;
+	float y = 0.0f;
+	float targetX = 0.0f;
+	float targetY = 0.0f;
+	float speed = 100.0f;      ///< Unidades por segundo.
+	float range = 1.0f;        ///< A esta distancia del objetivo se detiene, o pasa al punto siguiente.
+	uint32_t waypoint = 0;     ///< Punto del recorrido al que va; sin recorrido no se usa.
+	uint32_t color = 0xFFFFFFFFu; ///< RGBA, como `sf::Color::toInteger`.
+};
+
+static_assert(sizeof(GpuAgent) == 32 && std::is_trivially_copyable_v<GpuAgent>, "Disposicin std430 de GpuCrowd cambiada");
+
+/**
+ * @class GpuCrowd
+ * @brief Multitudes que viven en la GPU: el paso de `ShapeFactory::seekBatch` en un compute
+ *        shader sobre un SSBO de agentes, y el dibujo instanciado leyendo ese mismo bfer.
+ *
+ * Con millones de agentes, mover en la CPU y subir 28 bytes por figura cada frame
+ * (`InstancedShapeRenderer`) es lo que pesa. Aqu los agentes se suben una vez con `upload`;
+ * `step` avanza todos con un `glDispatchCompute` (256 por grupo) y `draw` los dibuja con un
+ * `glDrawArraysInstanced` cuyo vertex shader toma posicin y color del SSBO por
+ * `gl_InstanceID`. Entre los dos solo hay una barrera de memoria: nada vuelve a la CPU.
+ *
+ * El paso es el de `seekStep`: avanzar `speed * dt` hacia el objetivo mientras est ms lejos
+ * que `range`. Con recorrido (`upload` con puntos), el que llega pasa al punto siguiente, en
+ * ciclo, como una patrulla. Los agentes no chocan entre s ni con la escena, y la simulacin
+ * de la CPU no los ve: son para multitudes de fondo y para medir.
+ *
+ * Necesita OpenGL 4.3 (compute shaders y SSBO); si falta, `initialize` devuelve `false`. Un
+ * solo hilo, el del contexto de la ventana.
+ */
+class
+GpuCrowd {
+public:
+	static constexpr uint32_t kGroupSize = 256;     ///< `local_size_x` del compute shader.
+	static constexpr uint32_t kOutlinePoints = 8;   ///< Lados del polgono de cada agente.
+
+	GpuCrowd() = default;
+
+	GpuCrowd(const GpuCrowd&) = delete;
+	GpuCrowd& operator=(const GpuCrowd&) = delete;
+
+	/**
+	 * @brief Carga las funciones de OpenGL, compila los programas y sube la malla. El contexto
+	 *        de destino debe estar activo.
+	 * @return `false` si el contexto no tiene compute shaders.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_stepProgram != 0; }
+
+	/**
+	 * @brief Libera los objetos de OpenGL. Debe llamarse con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Reemplaza los agentes y el recorrido que siguen; vaco, cada uno va a su objetivo.
+	 */
+	void
+	upload(std::span<const GpuAgent> agents, std::span<const sf::Vector2f> path = {});
+
+	/**
+	 * @brief Avanza todos los agentes `deltaTime` segundos en la GPU.
+	 */
+	void
+	step(float deltaTime);
+
+	/**
+	 * @brief Dibuja los agentes en `target`, cada uno un polgono de radio `radius`.
+	 */
+	void
+	draw(sf::RenderTarget& target);
+
+	void
+	setRadius(float radius) { m_radius = radius; }
+
+	float
+	radius() const { return m_radius; }
+
+	/**
+	 * @brief Agentes en la GPU.
+	 */
+	uint32_t
+	size() const { return m_count; }
+
+private:
+	uint32_t m_stepProgram = 0;
+	uint32_t m_drawProgram = 0;
+	uint32_t m_vertexArray = 0;
+	uint32_t m_meshBuffer = 0;          ///< Tringulos del polgono unitario.
+	uint32_t m_agentBuffer = 0;         ///< SSBO de `GpuAgent`, binding 0.
+	uint32_t m_pathBuffer = 0;          ///< SSBO de puntos del recorrido, binding 1.
+	int32_t m_deltaTimeLocation = -1;
+	int32_t m_countLocation = -1;
+	int32_t m_pathCountLocation = -1;
+	int32_t m_viewLocation = -1;
+	int32_t m_radiusLocation = -1;
+	uint32_t m_count = 0;
+	uint32_t m_pathCount = 0;
+	float m_radius = 3.0f;
+};
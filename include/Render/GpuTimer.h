@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Prerequisites.h"
+
+/**
+ * @brief Milisegundos de GPU de cada pase de un frame.
+ */
+struct GpuTimings {
+	double clearMs = 0.0;
+	double meshesMs = 0.0;    ///< `MeshPipeline`.
+	double worldMs = 0.0;     ///< Geometra esttica y figuras.
+	double postProcessMs = 0.0; ///< `PostProcessStack`.
+	double overlayMs = 0.0;   ///< Estadsticas en pantalla.
+	double totalMs = 0.0;     ///< Del inicio del primer pase al final del ltimo.
+	bool valid = false;       ///< `false` mientras no haya llegado ningn resultado.
+};
+
+/**
+ * @class GpuTimer
+ * @brief Tiempo de GPU de cada pase con marcas `GL_TIMESTAMP`, ledas unos frames despus.
+ *
+ * `begin(pase)` pone una marca antes del pase (en el orden de `Pass`) y `endFrame` una al
+ * final; cada pase dura hasta la marca siguiente, as que los pases no se anidan y uno que no
+ * hubo en un frame vale 0.
+ * Hay `kLatencyFrames` juegos de consultas en anillo: `endFrame` lee el frame ms viejo solo
+ * si la GPU ya lo termin (`GL_QUERY_RESULT_AVAILABLE`), nunca espera. Si todava no, se
+ * descarta y los ltimos tiempos quedan como estaban.
+ *
+ * Con esto se ve si un frame lento es de CPU (`BaseApp::update`, la grabacin) o de GPU (los
+ * draws). Un solo hilo, el del contexto; necesita `ARB_timer_query`. Con `ENGINE_TRACY`, cada
+ * pase ledo va adems a Tracy como zona de GPU, con sus marcas.
+ */
+class
+GpuTimer {
+public:
+	enum Pass : uint8_t {
+		Clear,
+		Meshes,
+		World,
+		PostProcess,
+		Overlay,
+		kPassCount
+	};
+
+	static constexpr size_t kLatencyFrames = 4;
+
+	GpuTimer() = default;
+
+	GpuTimer(const GpuTimer&) = delete;
+	GpuTimer& operator=(const GpuTimer&) = delete;
+
+	/**
+	 * @brief Crea las consultas. El contexto debe estar activo.
+	 * @return `false` si el driver no tiene consultas de tiempo.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_queries[0][0] != 0; }
+
+	/**
+	 * @brief Borra las consultas. Con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Marca el inicio de `pass` en el frame en curso; sin `initialize`, nada.
+	 */
+	void
+	begin(Pass pass);
+
+	/**
+	 * @brief Marca el final del frame, pasa al siguiente juego y lee el ms viejo si ya est.
+	 */
+	void
+	endFrame();
+
+	/**
+	 * @brief Los tiempos del frame ms reciente que la GPU termin.
+	 */
+	const GpuTimings&
+	latest() const { return m_latest; }
+
+private:
+	static constexpr size_t kMarks = kPassCount + 1; ///< Una por pase y la del final.
+
+	/**
+	 * @brief Lee el juego `frame` si la GPU ya lo termin.
+	 */
+	void
+	collect(size_t frame);
+
+	/**
+	 * @brief Con `ENGINE_TRACY`, manda los pases marcados de `frame` como zonas de GPU.
+	 */
+	void
+	emitTracyZones(size_t frame, const std::array<uint64_t, kMarks>& stamps);
+
+	std::array<std::array<uint32_t, kMarks>, kLatencyFrames> m_queries{};
+	std::array<std::array<bool, kMarks>, kLatencyFrames> m_marked{};  ///< Marcas puestas en cada juego.
+	std::array<bool, kLatencyFrames> m_inFlight{};                    ///< Juego cerrado y sin leer.
+	size_t m_frame = 0;                                               ///< Juego del frame en curso.
+	GpuTimings m_latest;
+	int m_tracyContext = -1;                                          ///< Contexto de GPU en Tracy; -1 sin crear.
+	uint16_t m_tracyQuery = 0;                                        ///< Siguiente id de consulta para Tracy.
+};
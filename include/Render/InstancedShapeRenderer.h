@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/StreamBuffer.h"
+
+class RenderCommandBuffer;
+class ShapeBatcher;
+struct DrawCommand;
+
+/**
+ * @class InstancedShapeRenderer
+ * @brief Dibuja las figuras repetidas con instancing de OpenGL: una malla compartida por tipo
+ *        de figura y un `glDrawArraysInstanced` por tipo y capa.
+ *
+ * Casi todos los actores son el mismo crculo o tringulo de `ShapeFactory::createShape` con
+ * otra posicin y otro color. Sus comandos traen el contorno compartido de
+ * `ShapeFactory::getLocalOutline`, que aqu identifica la malla: se sube una sola vez a la
+ * GPU, y por figura solo viajan su matriz de mundo (2x3) y su color, 28 bytes. Las instancias
+ * de cada capa se escriben juntas en un `StreamBuffer`, sin volver a crear el bfer.
+ *
+ * Entran las figuras sin textura, shader, mezcla propia ni contorno que tienen contorno
+ * compartido; el resto sigue por `ShapeBatcher`. Capas y profundidades se respetan: al cambiar
+ * de una a otra se dibuja lo pendiente. Dentro de una misma, las figuras instanciadas se dibujan
+ * despus de las dems y agrupadas por tipo.
+ *
+ * Necesita OpenGL 3.3 (VAO, shaders GLSL 330 e instancing). Las funciones se piden con
+ * `sf::Context::getFunction`; si falta alguna, `initialize` devuelve `false` y la ventana sigue
+ * con el camino de SFML. Un solo hilo, el del contexto de la ventana.
+ */
+class
+InstancedShapeRenderer {
+public:
+	InstancedShapeRenderer() = default;
+
+	InstancedShapeRenderer(const InstancedShapeRenderer&) = delete;
+	InstancedShapeRenderer& operator=(const InstancedShapeRenderer&) = delete;
+
+	/**
+	 * @brief Carga las funciones de OpenGL y compila el shader. El contexto de destino debe
+	 *        estar activo.
+	 * @return `false` si el contexto no alcanza; no hay que llamar a `submit`.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_program != 0; }
+
+	/**
+	 * @brief Libera los objetos de OpenGL. Debe llamarse con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Ordena `commands` y los dibuja en `target`: las figuras repetidas instanciadas, el
+	 *        resto con `batcher`.
+	 */
+	void
+	submit(sf::RenderTarget& target, RenderCommandBuffer& commands, ShapeBatcher& batcher);
+
+	/**
+	 * @brief Indica si `command` puede dibujarse instanciado.
+	 */
+	static bool
+	isInstanceable(const DrawCommand& command);
+
+	/**
+	 * @brief `glDrawArraysInstanced` del ltimo `submit`.
+	 */
+	size_t
+	drawCalls() const { return m_drawCalls; }
+
+	/**
+	 * @brief Figuras dibujadas instanciadas en el ltimo `submit`.
+	 */
+	size_t
+	instanceCount() const { return m_instanceTotal; }
+
+private:
+	/**
+	 * @brief Datos de una figura para el shader: filas de su matriz de mundo y color.
+	 */
+	struct Instance {
+		float row0[3];
+		float row1[3];
+		uint8_t color[4];
+	};
+
+	/**
+	 * @brief Malla de un contorno compartido y las instancias del frame que la usan.
+	 */
+	struct Mesh {
+		const sf::Vector2f* outline = nullptr;  ///< Clave: el contorno de `ShapeFactory`.
+		uint32_t vertexBuffer = 0;
+		uint32_t vertexCount = 0;
+		std::vector<Instance> pending;          ///< Instancias de la capa en curso.
+	};
+
+	/**
+	 * @brief Malla de `command.outline`, crendola la primera vez.
+	 */
+	Mesh&
+	meshFor(const DrawCommand& command);
+
+	/**
+	 * @brief Sube y dibuja las instancias pendientes de todas las mallas.
+	 */
+	void
+	flush(sf::RenderTarget& target);
+
+	std::vector<Mesh> m_meshes;           ///< Pocas (una por tipo de figura): bsqueda lineal.
+	std::vector<Instance> m_upload;       ///< Todas las instancias de un `flush`, contiguas.
+	uint32_t m_program = 0;
+	uint32_t m_vertexArray = 0;
+	StreamBuffer m_instances;             ///< Instancias del frame, en anillo.
+	int32_t m_viewLocation = -1;
+	size_t m_drawCalls = 0;
+	size_t m_instanceTotal = 0;
+};
@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+
+class RenderCommandBuffer;
+class ShapeBatcher;
+
+/**
+ * @class LayerCache
+ * @brief Capas que se dibujan en su propia `sf::RenderTexture` y solo se vuelven a dibujar
+ *        cuando algo en ellas cambia.
+ *
+ * Fondos, decorado y HUD cambian unas pocas veces por segundo, pero `BaseApp::render` limpia y
+ * vuelve a dibujar todo cada frame. Una capa marcada con `setCached` guarda su ltimo dibujo:
+ * mientras siga limpia, sus comandos del frame se descartan y en su lugar (en el orden de las
+ * capas) se pega la textura con un solo `draw`.
+ *
+ * Una capa se ensucia:
+ * - con `markDirty(layer)`, entera, o `markDirty(layer, rea)`: solo ese rectngulo de mundo
+ *   se limpia y se vuelve a dibujar (los comandos fuera de l los recorta el viewport);
+ * - sola, cuando una figura suya cambi o se movi desde el ltimo dibujo (`noteChange`, que
+ *   llama `ShapeFactory::render`), o cuando cambia cuntos comandos trae (alguien entr o sali);
+ * - toda, si cambia el tamao o la vista del destino.
+ *
+ * Si solo se mueve el padre de un `Transform`, no se nota: hay que marcarla a mano. Con alguna
+ * capa en cach, `Window::submit` dibuja todo por `ShapeBatcher`, sin instancing ni SDF.
+ *
+ * Un solo hilo, el de render. Es un servicio (`TService<LayerCache>`).
+ */
+class
+LayerCache {
+public:
+	/**
+	 * @brief Guarda o deja de guardar la capa `layer` en una textura.
+	 */
+	void
+	setCached(uint8_t layer, bool cached);
+
+	bool
+	isCached(uint8_t layer) const { return (m_cachedMask[layer >> 6] >> (layer & 63)) & 1; }
+
+	/**
+	 * @brief Capas en cach.
+	 */
+	size_t
+	cachedCount() const { return m_layers.size(); }
+
+	/**
+	 * @brief Vuelve a dibujar la capa entera en el prximo `submit`.
+	 */
+	void
+	markDirty(uint8_t layer);
+
+	/**
+	 * @brief Vuelve a dibujar solo `area` (en coordenadas de mundo) de la capa; varias reas
+	 *        en un frame se juntan en la caja que las contiene.
+	 */
+	void
+	markDirty(uint8_t layer, const sf::FloatRect& area);
+
+	/**
+	 * @brief Ensucia la capa entera si `changeTick` es posterior a su ltimo dibujo.
+	 */
+	void
+	noteChange(uint8_t layer, uint32_t changeTick);
+
+	bool
+	isDirty(uint8_t layer) const;
+
+	/**
+	 * @brief Ordena `commands` y los dibuja en `target`: los de las capas sin cach con
+	 *        `batcher`, los de las sucias en su textura, y pega cada capa en cach en su lugar.
+	 */
+	void
+	submit(sf::RenderTarget& target, RenderCommandBuffer& commands, ShapeBatcher& batcher);
+
+	/**
+	 * @brief Veces que se volvi a dibujar alguna capa, para comprobar que no pasa cada frame.
+	 */
+	size_t
+	redrawCount() const { return m_redraws; }
+
+private:
+	/**
+	 * @brief Textura de una capa y lo que se saba de ella al dibujarla.
+	 */
+	struct Layer {
+		uint8_t id = 0;
+		sf::RenderTexture texture;
+		bool dirty = true;              ///< Se redibuja entera.
+		bool regionDirty = false;       ///< Se redibuja `region`.
+		sf::FloatRect region;           ///< rea sucia, en coordenadas de mundo.
+		uint32_t drawnTick = 0;         ///< Tick de cambio al dibujarla (`ChangeTick.h`).
+		uint32_t commandCount = 0;      ///< Comandos que trajo la ltima vez.
+	};
+
+	Layer*
+	find(uint8_t layer);
+
+	const Layer*
+	find(uint8_t layer) const;
+
+	/**
+	 * @brief Ajusta las texturas al tamao y la vista de `target`; si cambiaron, todas sucias.
+	 */
+	void
+	syncTarget(const sf::RenderTarget& target);
+
+	/**
+	 * @brief Prepara `layer` para redibujarla: limpia la textura o el rea sucia y deja la vista
+	 *        que recorta a esa rea.
+	 * @return `false` si no hay nada que redibujar (el rea cae fuera de la textura).
+	 */
+	bool
+	beginRedraw(Layer& layer);
+
+	/**
+	 * @brief Cierra el redibujado de `layer` y la deja limpia.
+	 */
+	void
+	endRedraw(Layer& layer);
+
+	/**
+	 * @brief Pega la textura de `layer` en `target`, sobre lo ya dibujado.
+	 */
+	void
+	composite(sf::RenderTarget& target, Layer& layer);
+
+	std::vector<EngineUtilities::TUniquePtr<Layer>> m_layers; ///< Una por capa en cach.
+	std::array<uint64_t, 4> m_cachedMask{};                    ///< Bit por capa en cach, para `isCached`.
+	sf::Vector2u m_size;                                       ///< Tamao de las texturas.
+	sf::View m_view;                                           ///< Vista con que se dibujaron.
+	size_t m_redraws = 0;
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Render/RenderCommandBuffer.h"
+
+/**
+ * @class LightClusters
+ * @brief Reparte las luces del frame en una rejilla de `kTilesX` x `kTilesY` x `kSlices`
+ *        celdas de la pirmide de la cmara, para que cada pxel recorra solo las suyas.
+ *
+ * Cada luz se lleva a la vista, y la caja de su esfera se proyecta a la pantalla y a las
+ * rebanadas de profundidad que toca; queda anotada en todas las celdas de ese bloque (de ms,
+ * nunca de menos). El resultado es una lista compacta: por celda, dnde empiezan sus luces y
+ * cuntas son, y despus los ndices de luz de todas las celdas seguidos. Se arma en dos
+ * pasadas, contar y llenar, sin memoria por celda.
+ *
+ * Las rebanadas crecen con la distancia en perspectiva (logartmicas entre los planos cercano
+ * y lejano) y son iguales en ortogrfica. `MeshPipeline` sube la lista a bferes de textura y
+ * su shader elige la celda con `gl_FragCoord` y la profundidad de vista, con `sliceScale`,
+ * `sliceBias` e `isLogarithmic`.
+ */
+class
+LightClusters {
+public:
+	static constexpr uint32_t kTilesX = 16;
+	static constexpr uint32_t kTilesY = 9;
+	static constexpr uint32_t kSlices = 24;
+	static constexpr uint32_t kClusterCount = kTilesX * kTilesY * kSlices;
+	static constexpr size_t kMaxLights = 4096; ///< Las que sobran no iluminan.
+
+	/**
+	 * @brief Las luces de una celda: `lightIndices()[offset, offset + count)`.
+	 */
+	struct Range {
+		uint32_t offset = 0;
+		uint32_t count = 0;
+	};
+
+	LightClusters() : m_clusters(kClusterCount) {}
+
+	/**
+	 * @brief Reparte `lights` con la vista y la proyeccin de `camera`.
+	 */
+	void
+	build(const CameraUniforms& camera, std::span<const PointLightData> lights);
+
+	const std::vector<Range>&
+	clusters() const { return m_clusters; }
+
+	const std::vector<uint32_t>&
+	lightIndices() const { return m_indices; }
+
+	/**
+	 * @brief Luces repartidas en el ltimo `build` (a lo ms `kMaxLights`).
+	 */
+	size_t
+	lightCount() const { return m_lightCount; }
+
+	/**
+	 * @brief Rebanada de una profundidad de vista `d` (distancia delante de la cmara):
+	 *        `(isLogarithmic() ? log(d) : d) * sliceScale() + sliceBias()`, truncada.
+	 */
+	float
+	sliceScale() const { return m_sliceScale; }
+
+	float
+	sliceBias() const { return m_sliceBias; }
+
+	bool
+	isLogarithmic() const { return m_logarithmic; }
+
+	/**
+	 * @brief Celda de un punto en coordenadas normalizadas de pantalla ([-1, 1]) y profundidad
+	 *        de vista, como la calcula el shader.
+	 */
+	uint32_t
+	clusterOf(float ndcX, float ndcY, float viewDepth) const;
+
+private:
+	/**
+	 * @brief Bloque de celdas que toca una luz, inclusivo; vaco si queda fuera.
+	 */
+	struct Bounds {
+		uint32_t x0, y0, z0, x1, y1, z1;
+	};
+
+	bool
+	boundsOf(const CameraUniforms& camera, const PointLightData& light, Bounds& out) const;
+
+	uint32_t
+	sliceOf(float viewDepth) const;
+
+	std::vector<Range> m_clusters;
+	std::vector<uint32_t> m_indices;
+	std::vector<Bounds> m_bounds;         ///< Bloque de cada luz, entre las dos pasadas; `x1 < x0` si no toca.
+	size_t m_lightCount = 0;
+	float m_near = 0.0f;                  ///< Profundidades de vista de los planos de la proyeccin.
+	float m_far = 1.0f;
+	float m_sliceScale = 0.0f;
+	float m_sliceBias = 0.0f;
+	bool m_logarithmic = false;
+	bool m_perspective = false;
+};
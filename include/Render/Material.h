@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Prerequisites.h"
+
+class MeshPipeline;
+struct AtlasRegion;
+
+/**
+ * @class Material
+ * @brief Cmo se ve una malla de `MeshPipeline`: color base, emisin y una textura opcional
+ *        con el rectngulo que cubren sus coordenadas de textura.
+ *
+ * Todas las mallas usan el mismo shader; el material son sus parmetros. `MeshPipeline` guarda
+ * los de todos los materiales en uso seguidos en un bfer de textura que solo se vuelve a
+ * subir cuando uno cambia, y cada draw lleva el ndice del suyo: dibujar mil mallas con cien
+ * materiales distintos no fija ni un uniforme por material. La textura, con texturas sin
+ * enlace (`ARB_bindless_texture`), va en el mismo bfer; si no, se enlaza solo cuando cambia
+ * entre un draw y el siguiente. Con `setTexture(AtlasRegion)` muchos materiales comparten una
+ * pgina de `TextureAtlas` y no cambian de textura nunca.
+ *
+ * Un `.material` es texto, una propiedad por lnea y `#` comenta:
+ *
+ *     color 255 200 160        # R G B [A], de 0 a 255; o 0xRRGGBB[AA]
+ *     emissive 0 0 0           # lo que suma sin luz
+ *     texture rocks.png        # la ruta es el resto de la lnea; la carga `TextureLoader`
+ *     uv 0 0 1 1               # rectngulo de la textura, en fracciones, para uv de 0 a 1
+ *
+ * Como `Mesh`: un comando lo guarda por puntero, as que no debe destruirse hasta que se
+ * dibuje, y su textura debe vivir tanto como l. Con texturas sin enlace la textura queda
+ * inmutable al primer dibujo: no hay que cambiarle el filtro ni el tamao despus.
+ */
+class
+Material {
+public:
+	static constexpr std::string_view kExtension = ".material";
+
+	Material() = default;
+
+	/**
+	 * @brief Libera su lugar en el bfer de materiales, si lo tiene.
+	 */
+	~Material();
+
+	Material(const Material&) = delete;
+	Material& operator=(const Material&) = delete;
+
+	void
+	setColor(sf::Color color);
+
+	sf::Color
+	color() const { return m_color; }
+
+	/**
+	 * @brief Color que se suma al iluminado; el alfa no se usa.
+	 */
+	void
+	setEmissive(sf::Color emissive);
+
+	sf::Color
+	emissive() const { return m_emissive; }
+
+	/**
+	 * @param texture Nula quita la textura.
+	 * @param rect Parte de la textura, en fracciones, que cubren las uv de 0 a 1 de la malla.
+	 */
+	void
+	setTexture(const sf::Texture* texture, const sf::FloatRect& rect = sf::FloatRect(0.0f, 0.0f, 1.0f, 1.0f));
+
+	/**
+	 * @brief La regin de un `TextureAtlas`, ya construido.
+	 */
+	void
+	setTexture(const AtlasRegion& region);
+
+	const sf::Texture*
+	texture() const { return m_texture; }
+
+	const sf::FloatRect&
+	textureRect() const { return m_textureRect; }
+
+	/**
+	 * @brief `true` si las mallas con este material van en el paso opaco.
+	 */
+	bool
+	isOpaque() const { return m_color.a == 255; }
+
+	/**
+	 * @brief Lee las propiedades de `text`; las que no dice quedan como estaban. Una textura
+	 *        se pide a `TextureLoader`, si el servicio existe.
+	 * @param error Si no es nulo y falla, la lnea y lo que estaba mal.
+	 */
+	bool
+	parse(std::string_view text, std::string* error = nullptr);
+
+	bool
+	loadFromFile(const std::string& path, std::string* error = nullptr);
+
+	/**
+	 * @brief Sube con cada cambio.
+	 */
+	uint32_t
+	version() const { return m_version; }
+
+private:
+	friend class MeshPipeline;
+
+	sf::Color m_color = sf::Color::White;
+	sf::Color m_emissive = sf::Color::Black;
+	const sf::Texture* m_texture = nullptr;
+	sf::FloatRect m_textureRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+	uint32_t m_version = 0;
+
+	// Lugar en el bfer de `m_pipeline`; no es parte del material
+	mutable MeshPipeline* m_pipeline = nullptr;
+	mutable uint32_t m_uploadedVersion = 0;
+	mutable uint32_t m_uploadedTexture = 0;  ///< Nombre de GL de la textura al empaquetar: cambia con `TextureLoader`.
+	mutable uint32_t m_residentIndex = 0;
+};
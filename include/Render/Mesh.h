@@ -0,0 +1,141 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+
+class MeshPipeline;
+
+/**
+ * @brief Vrtice de malla intercalado: lo que lee el shader de `MeshPipeline`, 32 bytes.
+ */
+struct MeshVertex {
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+/**
+ * @brief Piel de un vrtice: hasta cuatro huesos de `Skeleton` y cunto pesa cada uno (los
+ *        pesos suman 255). 8 bytes, en un bfer aparte de `MeshVertex`.
+ */
+struct MeshSkin {
+	uint8_t joints[4] = {};
+	uint8_t weights[4] = { 255, 0, 0, 0 };
+};
+
+/**
+ * @class Mesh
+ * @brief Malla 3D indexada: vrtices intercalados e ndices de 32 bits.
+ *
+ * Guarda la copia de CPU; `MeshPipeline` la sube la primera vez que se dibuja y otra vez solo
+ * si `setGeometry` cambi la versin. En la GPU vive en un tramo de los bferes compartidos del
+ * pipeline, que se libera al destruir la malla.
+ *
+ * Un comando de `RenderCommandBuffer::drawMesh` la guarda por puntero: no debe cambiar ni
+ * destruirse hasta que se dibuje (con `RenderThread`, hasta el frame siguiente).
+ */
+class
+Mesh {
+public:
+	static constexpr EngineUtilities::MemoryCategory kMemoryCategory = EngineUtilities::MemoryCategory::Assets;
+
+	Mesh() = default;
+
+	/**
+	 * @brief Libera su tramo en la GPU, si lo tiene.
+	 */
+	~Mesh();
+
+	Mesh(const Mesh&) = delete;
+	Mesh& operator=(const Mesh&) = delete;
+
+	/**
+	 * @brief Reemplaza la geometra; se vuelve a subir en el prximo dibujo.
+	 * @param indices Tringulos, tres ndices cada uno, sobre `vertices`.
+	 */
+	void
+	setGeometry(std::vector<MeshVertex> vertices, std::vector<uint32_t> indices);
+
+	/**
+	 * @brief Piel de la malla, una por vrtice; vaca, la malla es rgida. Se vuelve a subir en
+	 *        el prximo dibujo.
+	 */
+	void
+	setSkin(std::vector<MeshSkin> skin);
+
+	const std::vector<MeshSkin>&
+	skin() const { return m_skin; }
+
+	bool
+	isSkinned() const { return !m_skin.empty() && m_skin.size() == m_vertices.size(); }
+
+	/**
+	 * @brief Caja centrada en el origen, con normales por cara y 24 vrtices.
+	 */
+	void
+	makeBox(const sf::Vector3f& halfExtents);
+
+	const std::vector<MeshVertex>&
+	vertices() const { return m_vertices; }
+
+	const std::vector<uint32_t>&
+	indices() const { return m_indices; }
+
+	/**
+	 * @brief Centro de la caja de los vrtices, en coordenadas locales; `MeshPipeline` ordena
+	 *        las mallas por su profundidad.
+	 */
+	const sf::Vector3f&
+	center() const { return m_center; }
+
+	/**
+	 * @brief Esquinas de la caja de los vrtices, en coordenadas locales.
+	 */
+	const sf::Vector3f&
+	boundsMin() const { return m_boundsMin; }
+
+	const sf::Vector3f&
+	boundsMax() const { return m_boundsMax; }
+
+	/**
+	 * @brief Tringulo ms cercano que corta el rayo `origin + t * direction`, en
+	 *        coordenadas locales, con `t` en [0, `maxDistance`]. La caja descarta primero.
+	 * @param distance El `t` del corte, si hay.
+	 */
+	bool
+	raycast(const sf::Vector3f& origin, const sf::Vector3f& direction, float maxDistance, float& distance) const;
+
+	/**
+	 * @brief Memoria de la geometra: la copia de CPU, que es lo mismo que ocupa en la GPU.
+	 */
+	size_t
+	bytes() const {
+		return m_vertices.size() * sizeof(MeshVertex) + m_indices.size() * sizeof(uint32_t) + m_skin.size() * sizeof(MeshSkin);
+	}
+
+	/**
+	 * @brief Sube con cada `setGeometry`.
+	 */
+	uint32_t
+	version() const { return m_version; }
+
+private:
+	friend class MeshPipeline;
+
+	std::vector<MeshVertex> m_vertices;
+	std::vector<uint32_t> m_indices;
+	std::vector<MeshSkin> m_skin;
+	sf::Vector3f m_center;
+	sf::Vector3f m_boundsMin;
+	sf::Vector3f m_boundsMax;
+	uint32_t m_version = 0;
+
+	// Tramo en los bferes de `m_pipeline`; no es parte de la geometra
+	mutable MeshPipeline* m_pipeline = nullptr;  ///< Quien la tiene subida, o nulo.
+	mutable uint32_t m_uploadedVersion = 0;
+	mutable uint32_t m_baseVertex = 0;
+	mutable uint32_t m_vertexCapacity = 0;
+	mutable uint32_t m_firstIndex = 0;
+	mutable uint32_t m_indexCapacity = 0;
+	mutable uint32_t m_residentIndex = 0;        ///< Posicin en la lista del pipeline.
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @file MeshFormat.h
+ * @brief Formato binario de mallas (`.gmsh`) que escribe `MeshOptimizer` y lee `MeshLoader`.
+ *
+ * Disposicin, todo en little-endian:
+ * - `MeshFileHeader` al inicio.
+ * - `vertexCount` vrtices `PackedMeshVertex`.
+ * - `indexCount` ndices de 16 bits si `kMeshIndices16`, si no de 32, alineados a 4 bytes.
+ *
+ * Los vrtices van cuantizados: posicin con 16 bits por eje dentro de la caja de la malla,
+ * normal en 10-10-10 con signo y coordenadas de textura con 16 bits dentro de su rango. Son
+ * 16 bytes en vez de los 32 de `MeshVertex`. Un cambio de disposicin sube `kMeshVersion`.
+ */
+
+static_assert(std::endian::native == std::endian::little, "El formato de malla es little-endian");
+
+constexpr uint32_t kMeshMagic = 0x48534D47;          ///< "GMSH" ledo como uint32.
+constexpr uint32_t kMeshVersion = 1;
+constexpr uint32_t kMeshIndices16 = 1u << 0;         ///< ndices de 16 bits.
+
+struct MeshFileHeader {
+	uint32_t magic = kMeshMagic;
+	uint32_t version = kMeshVersion;
+	uint32_t vertexCount = 0;
+	uint32_t indexCount = 0;
+	uint32_t flags = 0;
+	uint32_t reserved = 0;
+	float positionMin[3] = {};   ///< Esquina menor de la caja de la malla.
+	float positionScale[3] = {}; ///< Lado de la caja en cada eje.
+	float uvMin[2] = {};         ///< Lo mismo para las coordenadas de textura.
+	float uvScale[2] = {};
+};
+
+struct PackedMeshVertex {
+	uint16_t position[3];
+	uint16_t padding;
+	uint32_t normal;        ///< `packNormal`.
+	uint16_t uv[2];
+};
+
+static_assert(sizeof(MeshFileHeader) == 64 && sizeof(PackedMeshVertex) == 16, "Disposicin de malla cambiada");
+static_assert(std::is_trivially_copyable_v<MeshFileHeader> && std::is_trivially_copyable_v<PackedMeshVertex>);
+
+/**
+ * @brief `value` entre `min` y `min + scale` a 16 bits, redondeado.
+ */
+inline uint16_t
+quantizeUnorm16(float value, float min, float scale) {
+	float t = scale > 0.0f ? (value - min) / scale : 0.0f;
+	return static_cast<uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+}
+
+inline float
+dequantizeUnorm16(uint16_t value, float min, float scale) {
+	return min + static_cast<float>(value) * (scale / 65535.0f);
+}
+
+/**
+ * @brief Normal unitaria en 10 bits con signo por eje (x en los bits bajos); los 2 de arriba
+ *        quedan en 0.
+ */
+inline uint32_t
+packNormal(const float normal[3]) {
+	uint32_t packed = 0;
+	for (int axis = 0; axis < 3; ++axis) {
+		int32_t value = static_cast<int32_t>(std::lround(std::clamp(normal[axis], -1.0f, 1.0f) * 511.0f));
+		packed |= (static_cast<uint32_t>(value) & 0x3FFu) << (axis * 10);
+	}
+	return packed;
+}
+
+inline void
+unpackNormal(uint32_t packed, float normal[3]) {
+	for (int axis = 0; axis < 3; ++axis) {
+		// Extiende el signo de los 10 bits
+		int32_t value = static_cast<int32_t>((packed >> (axis * 10)) << 22) >> 22;
+		normal[axis] = std::max(static_cast<float>(value) / 511.0f, -1.0f);
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Prerequisites.h"
+#include "Jobs/JobSystem.h"
+#include "Scene/PackFile.h"
+#include "Render/Mesh.h"
+
+/**
+ * @class MeshLoader
+ * @brief Carga mallas `.obj` o `.gmsh` en los hilos de `JobSystem`, sin frenar el bucle
+ *        principal.
+ *
+ * `load` devuelve enseguida la malla, vaca, y lanza un trabajo que mapea el archivo
+ * (`MappedFile`) y lo lee con `parseObj` o `parseMesh` (segn empiece con `kMeshMagic`)
+ * directo a `MeshVertex` intercalados: ya es la disposicin del bfer de vrtices de
+ * `MeshPipeline`, as que subirla es una sola copia.
+ *
+ * Las mallas terminadas se entregan en `adoptFinished`, que `BaseApp::render` llama antes de
+ * grabar el frame (con `RenderThread`, despus de `acquireFrame`, cuando el hilo de render ya
+ * no lee la foto anterior). Ah la geometra pasa a la malla y el siguiente `Window::submit`
+ * la sube a la GPU en el hilo del contexto. Mientras tanto la malla puede estar en un
+ * `MeshRenderer`: sin geometra no dibuja nada.
+ *
+ * `load` y `adoptFinished` van en el hilo principal; es un servicio (`TService<MeshLoader>`).
+ */
+class
+MeshLoader {
+public:
+	MeshLoader() : m_jobs(EngineUtilities::TService<JobSystem>::instance()) {}
+
+	/**
+	 * @brief Espera las cargas en curso: sus trabajos escriben en este objeto.
+	 */
+	~MeshLoader();
+
+	MeshLoader(const MeshLoader&) = delete;
+	MeshLoader& operator=(const MeshLoader&) = delete;
+
+	/**
+	 * @brief Empieza a cargar `path` en un hilo de trabajo.
+	 * @return La malla que recibir la geometra en algn `adoptFinished` posterior.
+	 */
+	EngineUtilities::TSharedPointer<Mesh>
+	load(const std::string& path);
+
+	/**
+	 * @brief Pasa a sus mallas la geometra de las cargas terminadas.
+	 * @return Cuntas se entregaron; las que fallaron se anuncian con `MESSAGE` y quedan vacas.
+	 */
+	size_t
+	adoptFinished();
+
+	/**
+	 * @brief Espera a que terminen todas las cargas y las entrega.
+	 */
+	void
+	finishAll();
+
+	/**
+	 * @brief Cargas lanzadas y todava no entregadas.
+	 */
+	size_t
+	pendingCount() const { return m_requests.size(); }
+
+	/**
+	 * @brief Con `true` solo lee `.gmsh`: un `.obj` falla en vez de convertirse aqu
+	 *        (`BaseApp::setCookedOnly`). Antes de los `load` a los que aplica.
+	 */
+	void
+	setCookedOnly(bool cookedOnly) { m_cookedOnly = cookedOnly; }
+
+	/**
+	 * @brief Si `mesh` espera todava la geometra de una carga.
+	 */
+	bool
+	isPending(const Mesh* mesh) const;
+
+	/**
+	 * @brief Lee un `.obj`: `v`, `vt`, `vn` y caras `f` de tres o ms esquinas (en abanico),
+	 *        con ndices `v`, `v/vt`, `v//vn` o `v/vt/vn`, tambin negativos.
+	 *
+	 * No reserva por token: recorre el texto con un cursor y convierte los nmeros con
+	 * `std::from_chars`. Cada combinacin distinta de ndices de una esquina es un vrtice. Sin
+	 * `vn`, las normales se promedian de las caras. El resto de las lneas se ignora.
+	 *
+	 * @return `false` si una cara apunta fuera de lo ledo; `vertices` e `indices` quedan a medias.
+	 */
+	static bool
+	parseObj(const char* text, size_t size, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+
+	/**
+	 * @brief Lee un `.gmsh` de `MeshOptimizer` (`MeshFormat.h`), descuantizando los vrtices.
+	 * @return `false` si no es un `.gmsh` de esta versin, est truncado o un ndice apunta fuera.
+	 */
+	static bool
+	parseMesh(const unsigned char* data, size_t size, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+
+private:
+	/**
+	 * @brief Una carga: el trabajo llena la geometra y marca `done`; la malla solo la toca el
+	 *        hilo principal (su conteo de referencias no es atmico).
+	 */
+	struct Request {
+		EngineUtilities::TSharedPointer<Mesh> mesh;
+		std::string path;
+		PackedAsset packed;           ///< En un paquete montado; sin `found`, del disco.
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		bool loaded = false;
+		std::atomic<bool> done{ false };
+	};
+
+	JobSystem& m_jobs;
+	JobCounter m_counter;                                          ///< Trabajos de carga en curso.
+	bool m_cookedOnly = false;
+	std::vector<EngineUtilities::TUniquePtr<Request>> m_requests;  ///< En curso o sin entregar.
+};
@@ -0,0 +1,451 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Prerequisites.h"
+#include "Math/Mat4.h"
+#include "Render/LightClusters.h"
+#include "Render/OcclusionCuller.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/ShadowCascades.h"
+
+class BakedAnimation;
+class Material;
+class Mesh;
+
+/**
+ * @class MeshPipeline
+ * @brief Dibuja las mallas 3D de `RenderCommandBuffer::drawMesh` con OpenGL propio: bferes de
+ *        vrtices intercalados e ndices, un VAO y test de profundidad.
+ *
+ * Todas las mallas comparten un bfer de vrtices y uno de ndices que viven en la GPU entre
+ * frames: cada malla ocupa un tramo y se dibuja con `glDrawElementsBaseVertex`, sin cambiar de
+ * bfer ni de VAO. Las mallas nuevas o cambiadas del frame se suben juntas antes de dibujar,
+ * con `glBufferSubData` sobre su tramo. Si no caben, los bferes crecen al doble y lo ya subido
+ * se copia dentro de la GPU (`glCopyBufferSubData`); si los tramos libres pasan de la mitad, se
+ * vuelven a empaquetar desde las copias de CPU.
+ *
+ * Las mallas se dibujan antes que las figuras 2D, con la cmara del frame (`Camera`). Sin
+ * cmara se usa la vista de la ventana en x e y y `kDepthRange` unidades de profundidad a cada
+ * lado del plano z = 0 (z positivo, ms cerca). Las matrices van al shader en un bloque
+ * uniforme (`CameraUniforms`), que se sube solo en los frames en que cambian. La ventana pide
+ * un bfer de profundidad de 24 bits; sin l las mallas se dibujan en orden.
+ *
+ * Las mallas de color opaco (alfa 255) se dibujan primero, de la ms cercana a la ms lejana
+ * segn la profundidad del centro de su caja, sin mezcla: lo tapado falla el test de
+ * profundidad antes de sombrearse. Con `setDepthPrePass` antes pasan una vez solo por la
+ * profundidad, con un shader vaco, y el paso de color sombrea cada pxel una sola vez, a
+ * cambio de procesar los vrtices dos veces. Las transparentes van al final, de la ms lejana a
+ * la ms cercana, mezcladas y sin escribir profundidad.
+ *
+ * Con `setOcclusionCulling`, antes de dibujar se descartan las mallas fuera de la pantalla o
+ * tapadas: las opacas ms cercanas y con pocos tringulos se rasterizan en la CPU
+ * (`OcclusionCuller`) y las cajas de todas se prueban contra esa profundidad.
+ *
+ * Las luces puntuales del frame (`PointLight`) se reparten en celdas de la pirmide de la
+ * cmara con `LightClusters` y se suben a tres bferes de textura; cada pxel suma solo las de
+ * su celda, as que cientos de luces pequeas cuestan lo que las pocas que lo tocan. Sin
+ * bferes de textura en el driver, las mallas se ven solo con la luz fija.
+ *
+ * Las mallas con piel (`Mesh::setSkin`) se deforman en el shader de vrtices: con
+ * `drawSkinnedMesh` cada una trae su paleta de huesos, que se sube con las de todo el frame a un
+ * bfer de textura; con `drawSkinnedInstances` una `BakedAnimation`, residente en la GPU entre
+ * frames, se dibuja en un solo draw instanciado para toda una multitud. Tambin necesitan
+ * bferes de textura: sin ellos quedan en la pose de reposo. Nunca ocluyen ni se descartan por
+ * oclusin, porque su caja es la de reposo.
+ *
+ * Con `setShadows`, la luz direccional del frame (`RenderCommandBuffer::setSunLight`) da
+ * sombras en cascadas (`ShadowCascades`). Las mallas de `drawStaticMesh` se dibujan en un atlas
+ * de profundidad guardado solo cuando cambian la luz, el conjunto esttico o la caja de una
+ * cascada; cada frame ese atlas se copia dentro de la GPU y las que se mueven se dibujan
+ * encima. Sin ninguna que se mueva, se usa el guardado tal cual. Sin framebuffers en el
+ * driver, todo queda iluminado.
+ *
+ * Lo propio de cada comando (matriz, color, ndice del material y datos de piel) se sube una
+ * vez por frame a un bfer de textura, y los parmetros de los materiales en uso (`Material`)
+ * a otro que solo cambia cuando cambia uno de ellos. Un draw solo dice su ndice: con
+ * `ARB_base_instance` como instancia base, leda en un atributo por instancia, y si no en un
+ * nico uniforme entero. La textura del material va por handle en el bfer con
+ * `ARB_bindless_texture`; sin l se enlaza solo cuando cambia de un draw al siguiente. Sin
+ * bferes de textura, matriz y color van en uniformes por draw y los materiales solo tien.
+ *
+ * Necesita OpenGL 3.3, como `InstancedShapeRenderer`. Un solo hilo, el del contexto.
+ */
+class
+MeshPipeline {
+public:
+	static constexpr float kDepthRange = 1000.0f;
+
+	MeshPipeline() = default;
+
+	MeshPipeline(const MeshPipeline&) = delete;
+	MeshPipeline& operator=(const MeshPipeline&) = delete;
+
+	~MeshPipeline() { detachAll(); }
+
+	/**
+	 * @brief Carga las funciones de OpenGL, compila el shader y crea los bferes. El contexto
+	 *        de destino debe estar activo.
+	 * @return `false` si el contexto no alcanza; no hay que llamar a `submit`.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_colorPrograms[0].program != 0; }
+
+	/**
+	 * @brief Libera los objetos de OpenGL; las mallas se volvern a subir si se inicializa de
+	 *        nuevo. Debe llamarse con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Sube las mallas pendientes y dibuja las de `commands` en `target`.
+	 */
+	void
+	submit(sf::RenderTarget& target, const RenderCommandBuffer& commands);
+
+	/**
+	 * @brief Con `true`, las mallas opacas se dibujan antes solo en el bfer de profundidad.
+	 *        Conviene con mucha superposicin y poco vrtice (pantallas grandes, GPUs
+	 *        integradas); apagado por defecto.
+	 */
+	void
+	setDepthPrePass(bool enabled) { m_depthPrePass = enabled; }
+
+	bool
+	isDepthPrePass() const { return m_depthPrePass; }
+
+	/**
+	 * @brief Con `true`, las mallas fuera de la pantalla o detrs de otras no se envan.
+	 *        Conviene en escenas densas (ciudades, interiores); apagado por defecto.
+	 */
+	void
+	setOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; }
+
+	bool
+	isOcclusionCulling() const { return m_occlusionCulling; }
+
+	/**
+	 * @brief Con `true`, la luz direccional da sombras; apagado por defecto.
+	 */
+	void
+	setShadows(bool enabled) { m_shadows = enabled; }
+
+	bool
+	isShadows() const { return m_shadows; }
+
+	/**
+	 * @brief `true` si el driver alcanza para las sombras; si no, `setShadows` no hace nada.
+	 */
+	bool
+	hasShadows() const { return m_shadowFramebuffers[0] != 0; }
+
+	/**
+	 * @brief Las cascadas, para ajustar su alcance (`ShadowCascades::setMaxDistance`).
+	 */
+	ShadowCascades&
+	shadowCascades() { return m_cascades; }
+
+	const ShadowCascades&
+	shadowCascades() const { return m_cascades; }
+
+	/**
+	 * @brief Draws del ltimo `submit` en el atlas de sombras, estticos y de lo que se mueve.
+	 */
+	size_t
+	shadowDrawCalls() const { return m_shadowDrawCalls; }
+
+	/**
+	 * @brief Cascadas cuyo contenido esttico el ltimo `submit` tuvo que volver a dibujar.
+	 */
+	uint32_t
+	shadowRebuilds() const { return m_shadowRebuilds; }
+
+	/**
+	 * @brief Mallas que el ltimo `submit` no envi por estar fuera o tapadas.
+	 */
+	size_t
+	culledMeshes() const { return m_culledMeshes; }
+
+	const OcclusionCuller&
+	occlusionCuller() const { return m_occlusion; }
+
+	/**
+	 * @brief Olvida el tramo de `mesh`; lo llama su destructor.
+	 */
+	void
+	evict(const Mesh& mesh);
+
+	/**
+	 * @brief Olvida `animation`; lo llama su destructor.
+	 */
+	void
+	evict(const BakedAnimation& animation);
+
+	/**
+	 * @brief Olvida `material`; lo llama su destructor.
+	 */
+	void
+	evict(const Material& material);
+
+	/**
+	 * @brief `true` si las mallas con piel se deforman; si no, se dibujan en reposo.
+	 */
+	bool
+	hasSkinning() const { return m_boneBuffer != 0; }
+
+	size_t
+	drawCalls() const { return m_drawCalls; }
+
+	/**
+	 * @brief Bytes subidos en el ltimo `submit`; cero mientras ninguna malla cambie.
+	 */
+	size_t
+	uploadedBytes() const { return m_uploadedBytes; }
+
+	/**
+	 * @brief Vrtices e ndices ocupados en los bferes compartidos, contando tramos libres.
+	 */
+	uint32_t
+	usedVertices() const { return m_vertexEnd; }
+
+	uint32_t
+	usedIndices() const { return m_indexEnd; }
+
+	/**
+	 * @brief Celdas y luces del ltimo frame con luces.
+	 */
+	const LightClusters&
+	lightClusters() const { return m_clusters; }
+
+private:
+	/**
+	 * @brief Un programa del shader de mallas con sus uniformes; -1 los que no usa.
+	 */
+	struct ProgramVariant {
+		uint32_t program = 0;
+		int32_t model = -1;       ///< Sin bfer de comandos.
+		int32_t color = -1;
+		int32_t drawIndex = -1;   ///< Con bfer de comandos y sin instancia base.
+		int32_t clusterParams = -1;
+		int32_t viewport = -1;
+		int32_t sunDirection = -1;
+		int32_t sunColor = -1;
+		int32_t shadowMatrices = -1;
+		int32_t shadowSplits = -1;
+		int32_t lightViewProjection = -1;
+	};
+
+	/**
+	 * @brief Compila el programa de `ShaderCache`, busca sus uniformes y fija sus unidades de
+	 *        textura.
+	 * @return `false` si no compil; `variant` queda vaca.
+	 */
+	bool
+	loadProgram(ProgramVariant& variant, const char* vertexSource, const char* fragmentSource, const std::string& defines,
+		int32_t bonesUnit);
+
+	/**
+	 * @brief Compila las variantes con piel y crea sus bferes de textura; sin error si no se
+	 *        puede, solo sin piel.
+	 */
+	void
+	initializeSkinning(const std::string& drawDefines, const std::string& colorDefines);
+
+	/**
+	 * @brief Crea los bferes de textura de los comandos y de los materiales.
+	 */
+	void
+	initializeDraws();
+
+	/**
+	 * @brief Compila los programas del pase de sombras y crea el atlas guardado y el del
+	 *        frame; sin error si no se puede, solo sin sombras.
+	 */
+	void
+	initializeShadows(const std::string& drawDefines);
+
+	/**
+	 * @brief Dibuja `command`, el nmero `index` del frame, con el programa de `programs` que
+	 *        toca a su piel (rgida, paleta, horneada), cambiando de programa solo si no es
+	 *        `currentProgram`.
+	 */
+	void
+	drawCommand(const MeshCommand& command, uint32_t index, const ProgramVariant* programs, bool withColor,
+		const sf::BlendMode& blend, uint32_t& currentProgram);
+
+	/**
+	 * @brief Acomoda las cascadas, rehace lo esttico que haga falta y dibuja encima lo que se
+	 *        mueve, con la cmara ya subida.
+	 * @return El atlas a muestrear, o 0 sin sombras.
+	 */
+	uint32_t
+	renderShadows(std::span<const MeshCommand> meshes, const RenderCommandBuffer& commands);
+
+	/**
+	 * @brief Deja la luz direccional y, con `shadowed`, las matrices y tramos de las cascadas
+	 *        en los programas de color.
+	 */
+	void
+	uploadSun(const RenderCommandBuffer& commands, bool shadowed);
+
+	/**
+	 * @brief Sube las paletas e instancias del frame y las animaciones horneadas nuevas, y
+	 *        deja sus texturas en sus unidades.
+	 */
+	void
+	uploadSkinning(const RenderCommandBuffer& commands);
+
+	/**
+	 * @brief Anota `animation` como residente; se vuelve a empaquetar todo si es nueva o cambi.
+	 */
+	void
+	makeResident(const BakedAnimation& animation);
+
+	/**
+	 * @brief Sube los comandos del frame y los materiales que cambiaron, y deja sus texturas en
+	 *        sus unidades; con la piel ya subida.
+	 */
+	void
+	uploadDraws(std::span<const MeshCommand> meshes);
+
+	/**
+	 * @brief Empaqueta de nuevo todos los materiales residentes si alguno es nuevo o cambi.
+	 */
+	void
+	uploadMaterials();
+
+	/**
+	 * @brief Anota `material` como residente; se vuelve a empaquetar todo si es nuevo o cambi.
+	 */
+	void
+	makeResident(const Material& material);
+
+	/**
+	 * @brief Sube al bloque uniforme la cmara de `commands`, o la de la vista de `target`, si
+	 *        cambi desde la ltima subida.
+	 */
+	void
+	uploadCamera(const sf::RenderTarget& target, const RenderCommandBuffer& commands);
+
+	/**
+	 * @brief Reparte las luces de `commands` con la cmara ya subida, sube las listas y deja
+	 *        los uniformes de las celdas en el programa de color.
+	 */
+	void
+	uploadLights(const sf::RenderTarget& target, const RenderCommandBuffer& commands);
+
+	/**
+	 * @brief Llena `m_order`: opacas de adelante hacia atrs y despus transparentes de atrs
+	 *        hacia adelante, con la cmara ya subida.
+	 * @return Cuntas son opacas.
+	 */
+	size_t
+	sortCommands(std::span<const MeshCommand> meshes);
+
+	/**
+	 * @brief Rasteriza los oclusores de `m_order` y quita de ah las mallas que no se ven.
+	 * @return Cuntas opacas quedan.
+	 */
+	size_t
+	cullOccluded(std::span<const MeshCommand> meshes, size_t opaqueCount);
+
+	/**
+	 * @brief Da a `mesh` un tramo al da en los bferes y la anota para subir.
+	 */
+	void
+	makeResident(const Mesh& mesh);
+
+	/**
+	 * @brief Tramo nuevo al final para `mesh`, agrandando los bferes si hace falta.
+	 */
+	void
+	allocate(const Mesh& mesh);
+
+	/**
+	 * @brief Agranda los bferes a por lo menos esas capacidades, conservando lo subido.
+	 */
+	void
+	grow(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+	/**
+	 * @brief Vuelve a empaquetar todas las mallas desde el inicio de los bferes.
+	 */
+	void
+	compact();
+
+	/**
+	 * @brief Apunta los atributos del VAO al bfer de vrtices actual.
+	 */
+	void
+	bindAttributes();
+
+	void
+	detachAll();
+
+	ProgramVariant m_colorPrograms[3];   ///< Por piel: rgida, con paleta y horneada.
+	ProgramVariant m_depthPrograms[3];   ///< Pre-paso de profundidad; vacos si no compilaron.
+	ProgramVariant m_shadowPrograms[3];  ///< Pase de sombras, con la matriz de la luz.
+	uint32_t m_vertexArray = 0;
+	uint32_t m_vertexBuffer = 0;
+	uint32_t m_indexBuffer = 0;
+	uint32_t m_cameraBuffer = 0;    ///< Bloque uniforme `CameraBlock`.
+	bool m_depthPrePass = false;
+	bool m_occlusionCulling = false;
+	OcclusionCuller m_occlusion;
+	uint32_t m_lightBuffers[3] = {};    ///< Luces, celdas e ndices; 0 sin bferes de textura.
+	uint32_t m_lightTextures[3] = {};   ///< Una textura de bfer sobre cada uno.
+	LightClusters m_clusters;
+
+	uint32_t m_skinBuffer = 0;       ///< Huesos y pesos, a la par de `m_vertexBuffer`.
+	uint32_t m_boneBuffer = 0;       ///< Paletas del frame; 0 sin piel.
+	uint32_t m_boneTexture = 0;
+	uint32_t m_instanceBuffer = 0;   ///< `SkinnedInstance` del frame.
+	uint32_t m_instanceTexture = 0;
+	uint32_t m_bakedBuffer = 0;      ///< Todas las `BakedAnimation` residentes, seguidas.
+	uint32_t m_bakedTexture = 0;
+	std::vector<const BakedAnimation*> m_bakedResident;
+	bool m_bakedDirty = false;
+
+	uint32_t m_drawBuffer = 0;       ///< Comandos del frame; 0 sin bferes de textura.
+	uint32_t m_drawTexture = 0;
+	uint32_t m_materialBuffer = 0;   ///< Materiales residentes, detrs del blanco por defecto.
+	uint32_t m_materialTexture = 0;
+	uint32_t m_drawIndexBuffer = 0;  ///< 0, 1, 2...: el atributo del ndice con instancia base.
+	uint32_t m_drawIndexCapacity = 0;
+	std::vector<float> m_drawData;
+	std::vector<float> m_materialData;
+	std::vector<const Material*> m_materialResident;
+	bool m_materialsDirty = true;
+	bool m_bindless = false;
+	std::unordered_set<uint64_t> m_residentHandles;  ///< Handles de textura ya residentes.
+	uint32_t m_boundMaterialTexture = 0;             ///< En su unidad, sin texturas sin enlace.
+
+	bool m_shadows = false;
+	ShadowCascades m_cascades;
+	uint32_t m_shadowTextures[2] = {};      ///< Atlas esttico guardado y el del frame.
+	uint32_t m_shadowFramebuffers[2] = {};  ///< Uno sobre cada atlas; 0 sin sombras.
+	size_t m_shadowDrawCalls = 0;
+	uint32_t m_shadowRebuilds = 0;
+
+	CameraUniforms m_camera;        ///< Lo que tiene `m_cameraBuffer`.
+	bool m_cameraUploaded = false;
+
+	uint32_t m_vertexCapacity = 0;  ///< En vrtices.
+	uint32_t m_indexCapacity = 0;   ///< En ndices.
+	uint32_t m_vertexEnd = 0;       ///< Primer vrtice sin repartir.
+	uint32_t m_indexEnd = 0;
+	uint32_t m_freeVertices = 0;    ///< Vrtices en tramos que ya nadie usa.
+
+	std::vector<const Mesh*> m_resident;  ///< Mallas con tramo; la malla guarda su posicin.
+	std::vector<const Mesh*> m_uploads;  ///< Mallas a subir en este `submit`.
+	std::vector<uint64_t> m_order;       ///< Clave de orden del frame: opaca o no, profundidad e ndice del comando.
+	size_t m_drawCalls = 0;
+	size_t m_culledMeshes = 0;
+	size_t m_uploadedBytes = 0;
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Math/Mat4.h"
+
+class Mesh;
+
+/**
+ * @class OcclusionCuller
+ * @brief Oclusin por software para `MeshPipeline`: las mallas grandes y cercanas del frame se
+ *        rasterizan en la CPU a un bfer de profundidad pequeo, y las cajas de todas se
+ *        prueban contra l antes de enviarlas.
+ *
+ * El bfer (`kWidth` x `kHeight`, profundidad normalizada de -1 a 1) se reduce a una pirmide
+ * en la que cada texel guarda la profundidad ms lejana de los cuatro de abajo. Una caja se
+ * proyecta a un rectngulo de pantalla y a su profundidad ms cercana; est tapada si en el
+ * nivel donde el rectngulo ocupa pocos texels todos estn ms cerca que ella. El rectngulo
+ * crece un texel por lado, as que los bordes de los oclusores, rasterizados por centros de
+ * texel, no tapan de ms; una rendija ms angosta que un texel s puede perderse.
+ *
+ * Se usa la cmara del mismo frame, sin la latencia ni la espera de leer la profundidad de la
+ * GPU. Un oclusor debe ser opaco y con pocos tringulos (paredes, edificios, terreno): el
+ * presupuesto `kMaxOccluderTriangles` limita lo que cuesta por frame. Los tringulos que cruzan
+ * el plano cercano no ocluyen, y una caja que lo cruza siempre es visible.
+ */
+class
+OcclusionCuller {
+public:
+	static constexpr uint32_t kWidth = 256;
+	static constexpr uint32_t kHeight = 128;
+	static constexpr uint32_t kMaxOccluderTriangles = 16384;   ///< Por frame.
+	static constexpr uint32_t kMaxMeshTriangles = 2048;        ///< Una malla con ms no ocluye.
+	static constexpr float kMinOccluderArea = 0.01f;           ///< Fraccin de la pantalla que debe cubrir su caja.
+
+	/**
+	 * @brief Rectngulo de pantalla, en texels del nivel 0, y profundidad ms cercana de una caja.
+	 */
+	struct ScreenBounds {
+		float minX = 0.0f;
+		float minY = 0.0f;
+		float maxX = 0.0f;
+		float maxY = 0.0f;
+		float nearestDepth = 0.0f;
+		bool crossesNear = false;   ///< Alguna esquina detrs de la cmara: el resto no vale.
+	};
+
+	OcclusionCuller();
+
+	/**
+	 * @brief Vaca el bfer para un frame con esta vista-proyeccin.
+	 */
+	void
+	begin(const Mat4& viewProjection);
+
+	/**
+	 * @brief Rasteriza `mesh` con la matriz de mundo `model` si es buen oclusor y queda
+	 *        presupuesto.
+	 * @return `false` si se descart.
+	 */
+	bool
+	addOccluder(const Mesh& mesh, const Mat4& model);
+
+	/**
+	 * @brief Arma la pirmide con los oclusores agregados; antes de `isVisible`.
+	 */
+	void
+	finish();
+
+	/**
+	 * @brief `false` si la caja local `[boundsMin, boundsMax]` con `model` queda fuera de la
+	 *        pantalla o detrs de los oclusores.
+	 */
+	bool
+	isVisible(const sf::Vector3f& boundsMin, const sf::Vector3f& boundsMax, const Mat4& model) const;
+
+	/**
+	 * @brief Proyecta la caja; `false` si queda entera fuera de la pantalla, detrs del plano
+	 *        cercano o ms all del lejano.
+	 */
+	bool
+	project(const sf::Vector3f& boundsMin, const sf::Vector3f& boundsMax, const Mat4& model, ScreenBounds& bounds) const;
+
+	uint32_t
+	occluderCount() const { return m_occluders; }
+
+	uint32_t
+	occluderTriangles() const { return m_triangles; }
+
+	/**
+	 * @brief Profundidad del nivel 0, por filas desde abajo; 1 donde no hay oclusor.
+	 */
+	const float*
+	depth() const { return m_depth.data(); }
+
+private:
+	struct Level {
+		uint32_t offset = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	void
+	rasterize(const float* a, const float* b, const float* c);
+
+	/**
+	 * @brief Profundidad ms lejana de los texels de nivel 0 en `[x0, x1] x [y0, y1]`.
+	 */
+	float
+	farthestIn(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const;
+
+	Mat4 m_viewProjection;
+	std::vector<float> m_depth;       ///< Todos los niveles seguidos; el 0 es el bfer.
+	std::vector<Level> m_levels;
+	std::vector<float> m_projected;   ///< Vrtices de la malla en curso: x e y en texels, z y si sirve.
+	uint32_t m_occluders = 0;
+	uint32_t m_triangles = 0;
+};
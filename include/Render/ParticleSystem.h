@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+
+class RenderCommandBuffer;
+class JobSystem;
+
+/**
+ * @class ParticleSystem
+ * @brief Todas las partculas del juego en arreglos paralelos (posicin, velocidad, vida,
+ *        tamao, color), integradas con SIMD y dibujadas con un solo draw.
+ *
+ * Una partcula como `Actor` con `ShapeFactory` cuesta una entidad, varios componentes y un
+ * comando por frame; aqu son 32 bytes repartidos en arreglos de floats. `update` integra de a
+ * cuatro con SSE (posicin, velocidad con `gravity` y vida) y retira las muertas cambindolas
+ * por la ltima, sin mover las dems: el orden de las partculas no importa. `render` escribe
+ * un quad por partcula en un arreglo de vrtices, en paralelo con `JobSystem`, y lo agrega
+ * como un comando; las que caen fuera de la vista quedan como quads vacos.
+ *
+ * Hay dos arreglos de vrtices que se alternan por frame, como `FrameArena`: con
+ * `RenderThread`, el del frame anterior sigue vivo mientras se dibuja.
+ *
+ * `ParticleEmitter` las crea desde un actor. Un solo hilo, el principal. Es un servicio
+ * (`TService<ParticleSystem>`).
+ */
+class
+ParticleSystem {
+public:
+	static constexpr size_t kDefaultCapacity = 1u << 18;
+	static constexpr uint8_t kDefaultLayer = 16;
+
+	/**
+	 * @brief Una partcula nueva.
+	 */
+	struct Particle {
+		sf::Vector2f position;
+		sf::Vector2f velocity;        ///< Unidades por segundo.
+		float lifetime = 1.0f;        ///< Segundos; el alfa baja hasta 0 al terminar.
+		float size = 2.0f;            ///< Lado del quad.
+		sf::Color color = sf::Color::White;
+	};
+
+	ParticleSystem() { setCapacity(kDefaultCapacity); }
+
+	ParticleSystem(const ParticleSystem&) = delete;
+	ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+	/**
+	 * @brief Cuntas partculas caben; las que sobran al reducirla se descartan.
+	 */
+	void
+	setCapacity(size_t capacity);
+
+	size_t
+	capacity() const { return m_capacity; }
+
+	size_t
+	size() const { return m_count; }
+
+	/**
+	 * @brief Aceleracin de todas las partculas.
+	 */
+	void
+	setGravity(const sf::Vector2f& gravity) { m_gravity = gravity; }
+
+	void
+	setLayer(uint8_t layer) { m_layer = layer; }
+
+	/**
+	 * @brief Agrega una partcula.
+	 * @return `false` si ya no caben; no se agrega.
+	 */
+	bool
+	emit(const Particle& particle);
+
+	/**
+	 * @brief Avanza `deltaTime` y retira las partculas que terminaron su vida.
+	 */
+	void
+	update(float deltaTime);
+
+	/**
+	 * @brief Escribe los quads del frame y los agrega a `commands`; las partculas fuera de
+	 *        `visibleArea` no ocupan pxeles.
+	 */
+	void
+	render(RenderCommandBuffer& commands, const sf::FloatRect& visibleArea);
+
+	/**
+	 * @brief Quita todas las partculas.
+	 */
+	void
+	clear() { m_count = 0; }
+
+private:
+	static constexpr size_t kLanes = 4;          ///< Floats por registro SSE; la capacidad se redondea a esto.
+	static constexpr size_t kVerticesPerParticle = 6;
+
+	/**
+	 * @brief Integracin de `[0, m_count)`, redondeado a `kLanes` (el relleno no se lee).
+	 */
+	void
+	integrate(float deltaTime);
+
+	// Un arreglo por campo: el bucle de integracin lee solo lo que usa
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	std::vector<float> m_life;             ///< Segundos que le quedan.
+	std::vector<float> m_inverseLifetime;  ///< Para el alfa: vida / duracin sin dividir.
+	std::vector<float> m_size;
+	std::vector<uint32_t> m_color;         ///< RGBA empaquetado como `sf::Color::toInteger`.
+	size_t m_count = 0;
+	size_t m_capacity = 0;
+	sf::Vector2f m_gravity;
+	uint8_t m_layer = kDefaultLayer;
+	sf::VertexArray m_frames[2]{ sf::VertexArray(sf::Triangles), sf::VertexArray(sf::Triangles) };
+	int m_frame = 0;                       ///< Arreglo del prximo `render`.
+};
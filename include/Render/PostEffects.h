@@ -0,0 +1,112 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Render/PostProcessStack.h"
+
+/**
+ * @class BlurEffect
+ * @brief Desenfoque gaussiano separable: un pase horizontal y uno vertical en texturas
+ *        reducidas, y la imagen se estira al dibujarla en `output`.
+ *
+ * Cada pase lee 9 texeles con 5 lecturas (aprovechando el filtro lineal). A la mitad o a un
+ * cuarto el mismo shader cubre un radio 2 o 4 veces mayor en pantalla.
+ */
+class
+BlurEffect : public PostEffect {
+public:
+	explicit BlurEffect(Resolution resolution = Half) : PostEffect(resolution) {}
+
+	bool
+	apply(PostProcessStack& stack, const sf::Texture& source, sf::RenderTarget& output) override;
+
+	/**
+	 * @brief Separacin entre las lecturas, en texeles de la textura reducida; de 1 en adelante.
+	 */
+	void
+	setRadius(float radius) { m_radius = radius; }
+
+	float
+	radius() const { return m_radius; }
+
+	/**
+	 * @brief Desenfoca `source` en `destination` (del mismo tamao que `scratch`) pasando por
+	 *        `scratch`; lo usa tambin `BloomEffect`.
+	 * @return `false` si el shader no compil.
+	 */
+	static bool
+	blur(const sf::Texture& source, sf::RenderTexture& scratch, sf::RenderTexture& destination, float radius);
+
+private:
+	float m_radius = 1.0f;
+};
+
+/**
+ * @class BloomEffect
+ * @brief Brillo alrededor de lo ms claro: extrae lo que pasa de `threshold`, lo desenfoca a
+ *        resolucin reducida y lo suma a la imagen con `intensity`.
+ */
+class
+BloomEffect : public PostEffect {
+public:
+	explicit BloomEffect(Resolution resolution = Quarter) : PostEffect(resolution) {}
+
+	bool
+	apply(PostProcessStack& stack, const sf::Texture& source, sf::RenderTarget& output) override;
+
+	/**
+	 * @brief Luminancia (0 a 1) desde la que un pxel brilla.
+	 */
+	void
+	setThreshold(float threshold) { m_threshold = threshold; }
+
+	void
+	setIntensity(float intensity) { m_intensity = intensity; }
+
+	void
+	setRadius(float radius) { m_radius = radius; }
+
+private:
+	float m_threshold = 0.7f;
+	float m_intensity = 1.0f;
+	float m_radius = 1.5f;
+};
+
+/**
+ * @class ColorGradingEffect
+ * @brief Exposicin, contraste, saturacin y tinte en un solo pase, a resolucin completa
+ *        (no hay nada que se pueda reducir).
+ */
+class
+ColorGradingEffect : public PostEffect {
+public:
+	ColorGradingEffect() = default;
+
+	bool
+	apply(PostProcessStack& stack, const sf::Texture& source, sf::RenderTarget& output) override;
+
+	/**
+	 * @brief Multiplica los colores antes de lo dems; 1 los deja igual.
+	 */
+	void
+	setExposure(float exposure) { m_exposure = exposure; }
+
+	/**
+	 * @brief Aleja (ms de 1) o acerca (menos de 1) los colores del gris medio.
+	 */
+	void
+	setContrast(float contrast) { m_contrast = contrast; }
+
+	/**
+	 * @brief 0 da blanco y negro, 1 los colores originales.
+	 */
+	void
+	setSaturation(float saturation) { m_saturation = saturation; }
+
+	void
+	setTint(const sf::Color& tint) { m_tint = tint; }
+
+private:
+	float m_exposure = 1.0f;
+	float m_contrast = 1.0f;
+	float m_saturation = 1.0f;
+	sf::Color m_tint = sf::Color::White;
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/RenderTargetPool.h"
+#include "Render/RenderGraph.h"
+
+class PostProcessStack;
+
+/**
+ * @class PostEffect
+ * @brief Un efecto de pantalla completa de `PostProcessStack`: lee la imagen del efecto
+ *        anterior y dibuja la suya en `output`.
+ *
+ * `resolution` es el tamao de sus texturas intermedias respecto a la imagen: un desenfoque o
+ * un bloom a la mitad o a un cuarto cuestan 4 o 16 veces menos pxeles y, como igual se
+ * suavizan, no se nota. El resultado en `output` siempre es de tamao completo.
+ */
+class
+PostEffect {
+public:
+	enum Resolution : uint8_t {
+		Full = 1,
+		Half = 2,
+		Quarter = 4
+	};
+
+	explicit PostEffect(Resolution resolution = Full) : m_resolution(resolution) {}
+
+	virtual ~PostEffect() = default;
+
+	PostEffect(const PostEffect&) = delete;
+	PostEffect& operator=(const PostEffect&) = delete;
+
+	/**
+	 * @brief Dibuja el efecto sobre `source` en `output`, que lo cubre entero. Las texturas
+	 *        intermedias se piden a `stack` y se devuelven antes de salir.
+	 * @return `false` si no pudo (un shader no compil); la pila copia `source` tal cual.
+	 */
+	virtual bool
+	apply(PostProcessStack& stack, const sf::Texture& source, sf::RenderTarget& output) = 0;
+
+	void
+	setEnabled(bool enabled) { m_enabled = enabled; }
+
+	bool
+	isEnabled() const { return m_enabled; }
+
+	void
+	setResolution(Resolution resolution) { m_resolution = resolution; }
+
+	Resolution
+	resolution() const { return m_resolution; }
+
+private:
+	Resolution m_resolution;
+	bool m_enabled = true;
+};
+
+/**
+ * @class PostProcessStack
+ * @brief Efectos que se aplican en orden a la imagen del frame antes de mostrarla.
+ *
+ * `Window` dibuja la escena en una textura y agrega los efectos a su `RenderGraph` con
+ * `addPasses`, con la ventana como destino; `apply` hace lo mismo con un grafo propio. Cada
+ * efecto es un pase que lee la imagen del anterior y escribe una transitoria de tamao
+ * completo; el ltimo escribe directo en el destino. Como el grafo reparte las transitorias
+ * por vida, la pila usa a lo ms dos de tamao completo, que se alternan, ms las reducidas
+ * de cada efecto, todas del mismo `pool()` y reutilizadas de un frame a otro.
+ *
+ * Los efectos compilan sus shaders (`ShaderCache::shader`) en su primer `apply`, en el hilo que
+ * dibuja. Un solo hilo.
+ */
+class
+PostProcessStack {
+public:
+	PostProcessStack() = default;
+
+	PostProcessStack(const PostProcessStack&) = delete;
+	PostProcessStack& operator=(const PostProcessStack&) = delete;
+
+	/**
+	 * @brief Agrega un efecto al final de la pila.
+	 */
+	template<typename T, typename... Args>
+	T&
+	add(Args&&... args) {
+		EngineUtilities::TUniquePtr<T> effect = EngineUtilities::MakeUnique<T>(std::forward<Args>(args)...);
+		T& added = *effect;
+		m_effects.push_back(std::move(effect));
+		return added;
+	}
+
+	void
+	clear() { m_effects.clear(); }
+
+	size_t
+	size() const { return m_effects.size(); }
+
+	PostEffect&
+	effect(size_t index) { return *m_effects[index]; }
+
+	/**
+	 * @brief Hay algn efecto activo: sin ninguno, `Window` dibuja directo en la ventana.
+	 */
+	bool
+	isActive() const;
+
+	/**
+	 * @brief Aplica los efectos activos a `source` y deja el resultado en `output`, estirado si
+	 *        es ms grande (resolucin dinmica). Sin efectos activos, copia `source`.
+	 *
+	 * `source` debe venir de una `sf::RenderTexture`: los efectos asumen que todas sus
+	 * texturas tienen la misma orientacin.
+	 */
+	void
+	apply(const sf::Texture& source, sf::RenderTarget& output);
+
+	/**
+	 * @brief Agrega a `graph` un pase por efecto activo, de `source` a `output` (o uno que copia
+	 *        si no hay ninguno). `graph` debe usar `pool()`.
+	 */
+	void
+	addPasses(RenderGraph& graph, RenderGraph::ResourceId source, RenderGraph::ResourceId output);
+
+	/**
+	 * @brief Una textura intermedia de la imagen en curso dividida entre `divisor` (al menos un
+	 *        pxel por lado).
+	 * @return `nullptr` si no pudo crearse.
+	 */
+	sf::RenderTexture*
+	acquire(uint32_t divisor = PostEffect::Full);
+
+	void
+	release(sf::RenderTexture* target) { m_pool.release(target); }
+
+	/**
+	 * @brief Dibuja `source` estirada para cubrir `destination`, con `shader` si hay;
+	 *        `sf::Shader::CurrentTexture` es `source`. Lo que haba se reemplaza.
+	 */
+	static void
+	blit(const sf::Texture& source, sf::RenderTarget& destination, const sf::Shader* shader = nullptr,
+	     const sf::BlendMode& blend = sf::BlendNone);
+
+	/**
+	 * @brief Vrtices de los shaders de los efectos: solo pasa posicin y coordenadas.
+	 */
+	static const char* const kVertexSource;
+
+	RenderTargetPool&
+	pool() { return m_pool; }
+
+	/**
+	 * @brief El grafo de `apply`, con sus estadsticas del ltimo frame.
+	 */
+	const RenderGraph&
+	graph() const { return m_graph; }
+
+private:
+	std::vector<EngineUtilities::TUniquePtr<PostEffect>> m_effects;
+	RenderTargetPool m_pool;
+	RenderGraph m_graph{ m_pool };  ///< Solo de `apply`.
+	sf::Vector2u m_size;            ///< De la imagen de los pases en curso.
+};
@@ -0,0 +1,212 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/Mesh.h"
+#include "Render/RenderCommandBuffer.h"
+
+/**
+ * @class RenderCapture
+ * @brief Los comandos de dibujo de uno o varios frames, copiados por valor para repetirlos sin
+ *        la simulacin que los grab.
+ *
+ * `record` toma un `RenderCommandBuffer` ya lleno y guarda de cada comando la geometra (los
+ * puntos de la figura, o los vrtices de un `sf::VertexArray`), su matriz con la propia de la
+ * figura ya aplicada, su capa, profundidad y mezcla; de cada textura y malla que aparece, una
+ * sola copia de sus pxeles o vrtices. Con eso el archivo (`write`) no depende de la escena:
+ * `read` lo carga, sube texturas y mallas una vez y `replay` vuelve a llenar un buffer con los
+ * mismos comandos, que `Window::submit` dibuja como cualquier otro frame. As se mide la GPU y
+ * el driver con una escena real y siempre igual (`BaseApp::runRenderReplay`).
+ *
+ * Lo que no es figura, vrtices ni malla (un `sf::Text`, por ejemplo) y los shaders propios no
+ * se guardan: se cuentan en `skippedCommands`.
+ *
+ * La geometra igual (la misma figura en otro lugar, un trozo de `Tilemap` que no cambi) se
+ * guarda una vez para todos los frames: lo que crece por frame son las matrices.
+ *
+ * El archivo es una cabecera (`"GRCS"`, versin y cantidades) seguida de cada tabla tal cual.
+ * Un solo hilo; `read` y `replay` con un contexto de OpenGL activo.
+ */
+class
+RenderCapture {
+public:
+	static constexpr uint32_t kVersion = 1;
+
+	/**
+	 * @brief Vaca la captura, tambin lo cargado por `read`.
+	 */
+	void
+	clear();
+
+	/**
+	 * @brief Agrega un frame con los comandos de `commands` y la vista con que se dibujan.
+	 *        Las texturas nuevas se leen de la GPU (`sf::Texture::copyToImage`).
+	 */
+	void
+	record(const RenderCommandBuffer& commands, const sf::View& view);
+
+	size_t
+	frameCount() const { return m_frames.size(); }
+
+	/**
+	 * @brief Comandos que `record` no supo copiar.
+	 */
+	uint32_t
+	skippedCommands() const { return m_skipped; }
+
+	/**
+	 * @return `false` si no pudo escribirse.
+	 */
+	bool
+	write(const std::string& path) const;
+
+	/**
+	 * @brief Carga una captura y arma lo que `replay` dibuja.
+	 * @return `false` si el archivo no existe o no es una captura vlida; la actual no cambia.
+	 */
+	bool
+	read(const std::string& path);
+
+	/**
+	 * @brief Deja en `out` los comandos de `frame`, que debe venir de `read` (`out` se vaca antes).
+	 *        Los comandos apuntan a geometra de la captura: vive mientras esta no cambie.
+	 */
+	void
+	replay(size_t frame, RenderCommandBuffer& out) const;
+
+	/**
+	 * @brief Vista con que se grab `frame`.
+	 */
+	sf::View
+	viewOf(size_t frame) const;
+
+	/**
+	 * @brief Comandos de figuras y vrtices de `frame`, sin contar las mallas.
+	 */
+	size_t
+	commandCount(size_t frame) const { return m_frames[frame].commandCount; }
+
+private:
+	enum class Kind : uint8_t {
+		Shape,
+		Vertices
+	};
+
+	/**
+	 * @brief Una figura o un arreglo de vrtices: `first` y `count` son puntos de `m_points` o
+	 *        vrtices de `m_vertices`. Los comandos iguales de todos los frames comparten una.
+	 */
+	struct Geometry {
+		Kind kind = Kind::Shape;
+		uint8_t primitive = 0;             ///< `sf::PrimitiveType` de los vrtices.
+		uint16_t reserved = 0;             ///< Sin huecos: `geometryIndex` compara los bytes.
+		int32_t texture = -1;              ///< De la figura; ndice en `m_textures`, -1 sin textura.
+		uint32_t first = 0;
+		uint32_t count = 0;
+		uint32_t fillColor = 0;            ///< `sf::Color::toInteger`.
+		uint32_t outlineColor = 0;
+		float outlineThickness = 0.0f;
+		int32_t textureRect[4] = {};
+	};
+
+	struct Command {
+		uint32_t geometry = 0;             ///< ndice en `m_geometries`.
+		int32_t texture = -1;              ///< Material del comando, en `m_textures`.
+		uint16_t depth = 0;
+		uint8_t layer = 0;
+		uint8_t blend[6] = {};             ///< Factores y ecuaciones de `sf::BlendMode`, en su orden.
+		float transform[9] = {};           ///< Matriz de mundo por la local de la figura, fila a fila.
+	};
+
+	struct MeshDraw {
+		uint32_t mesh = 0;                 ///< ndice en `m_meshes`.
+		Mat4 model;
+		uint32_t color = 0;
+	};
+
+	struct Frame {
+		float center[2] = {};
+		float size[2] = {};
+		float rotation = 0.0f;
+		float viewport[4] = {};
+		uint32_t firstCommand = 0;
+		uint32_t commandCount = 0;
+		uint32_t firstMesh = 0;
+		uint32_t meshCount = 0;
+		uint32_t firstLight = 0;
+		uint32_t lightCount = 0;
+		uint32_t hasCamera = 0;
+		CameraUniforms camera;
+	};
+
+	struct TextureData {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t smooth = 0;
+		uint32_t repeated = 0;
+		std::vector<uint8_t> pixels;       ///< RGBA, fila a fila.
+	};
+
+	struct MeshData {
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t frames;
+		uint32_t commands;
+		uint32_t geometries;
+		uint32_t meshDraws;
+		uint32_t lights;
+		uint32_t points;
+		uint32_t vertices;
+		uint32_t textures;
+		uint32_t meshes;
+	};
+
+	/**
+	 * @brief ndice de `texture` en `m_textures`; la copia la primera vez que aparece.
+	 */
+	int32_t
+	textureIndex(const sf::Texture* texture);
+
+	uint32_t
+	meshIndex(const Mesh& mesh);
+
+	/**
+	 * @brief ndice de `geometry`, cuyos datos son los ltimos de `m_points` o `m_vertices`; si ya
+	 *        haba una igual, los quita y devuelve la anterior.
+	 */
+	uint32_t
+	geometryIndex(const Geometry& geometry);
+
+	/**
+	 * @brief Texturas, mallas, figuras y arreglos de vrtices de lo cargado.
+	 */
+	void
+	prepare();
+
+	std::vector<Frame> m_frames;
+	std::vector<Command> m_commands;
+	std::vector<Geometry> m_geometries;
+	std::vector<MeshDraw> m_meshDraws;
+	std::vector<PointLightData> m_lights;
+	std::vector<sf::Vector2f> m_points;
+	std::vector<sf::Vertex> m_vertices;
+	std::vector<TextureData> m_textures;
+	std::vector<MeshData> m_meshes;
+	std::vector<std::pair<const sf::Texture*, int32_t>> m_textureIds;   ///< Solo al grabar.
+	std::vector<std::pair<const Mesh*, uint32_t>> m_meshIds;
+	std::unordered_multimap<uint64_t, uint32_t> m_geometryIds;         ///< Hash de la geometra, ndice.
+	uint32_t m_skipped = 0;
+
+	std::vector<EngineUtilities::TUniquePtr<sf::Texture>> m_replayTextures;   ///< Lo de abajo, de `prepare`.
+	std::vector<EngineUtilities::TUniquePtr<Mesh>> m_replayMeshes;
+	std::vector<sf::ConvexShape> m_replayShapes;       ///< Una por geometra; vaca la de los vrtices.
+	std::vector<sf::VertexArray> m_replayVertices;     ///< Uno por geometra; vaco el de las figuras.
+};
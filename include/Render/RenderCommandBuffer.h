@@ -0,0 +1,383 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Prerequisites.h"
+#include "Math/Mat4.h"
+#include "Memory/MemoryAccounting.h"
+#include "Render/BakedAnimation.h"
+#include "Render/Material.h"
+
+class JobSystem;
+class Mesh;
+
+/**
+ * @brief Estado de GL con que se dibuja un comando, y su lugar en el orden del frame.
+ *
+ * Los campos entran en la clave de ordenamiento de ms a menos importante: capa, profundidad,
+ * shader, textura y mezcla. Capa y profundidad deciden qu queda encima; el resto solo agrupa
+ * los comandos que comparten estado para cambiarlo menos veces.
+ */
+struct DrawState {
+	uint8_t layer = 0;                     ///< Las bajas se dibujan primero.
+	uint16_t depth = 0;                    ///< Dentro de la capa, las bajas se dibujan primero.
+	const sf::Texture* texture = nullptr;  ///< Material; nulo usa el de la geometra.
+	const sf::Shader* shader = nullptr;    ///< Nulo dibuja sin shader.
+	sf::BlendMode blendMode = sf::BlendAlpha;
+};
+
+/**
+ * @brief Un dibujo pendiente: qu geometra, con qu matriz y qu material.
+ *
+ * La geometra se guarda por puntero: debe seguir viva hasta que se enve el buffer, lo que
+ * se cumple para las figuras de los componentes durante el frame.
+ */
+struct DrawCommand {
+	const sf::Drawable* geometry = nullptr; ///< Figura o malla a dibujar.
+	const sf::Shape* shape = nullptr;       ///< La misma geometra si es una `sf::Shape`: se puede juntar en lotes.
+	const sf::Vector2f* outline = nullptr;  ///< Puntos locales de `shape` ya calculados, o nulo.
+	uint32_t outlineCount = 0;
+	sf::Transform transform;                ///< Matriz de mundo.
+	sf::Color color = sf::Color::White;     ///< Relleno de `shape`; en las compartidas no es el de la figura.
+	bool sharedShape = false;               ///< `shape` es inmutable y vive ms que el frame (`drawShared`).
+	sf::IntRect textureRect;                ///< Con ancho, reemplaza el de `shape` (`drawSprite`).
+	const sf::Texture* texture = nullptr;   ///< Material; nulo usa el de la geometra.
+	const sf::Shader* shader = nullptr;
+	sf::BlendMode blendMode = sf::BlendAlpha;
+	uint64_t sortKey = 0;                   ///< Ver `RenderCommandBuffer::sortKeyOf`.
+
+	/**
+	 * @brief `sf::RenderStates` del comando. La textura nula se deja as: la pone la figura.
+	 */
+	sf::RenderStates
+	renderStates() const { return sf::RenderStates(blendMode, transform, texture, shader); }
+};
+
+/**
+ * @brief Una malla 3D pendiente, para `MeshPipeline`.
+ */
+struct MeshCommand {
+	const Mesh* mesh = nullptr;             ///< Debe vivir y no cambiar hasta el envo.
+	Mat4 model;                             ///< Matriz de mundo; con instancias, la de la primera.
+	sf::Color color = sf::Color::White;     ///< Tie el color del material.
+	const Material* material = nullptr;     ///< Nulo es blanco, sin textura.
+	uint32_t firstBone = 0;                 ///< Con piel: sus matrices en `bonePalette()`.
+	uint32_t boneCount = 0;                 ///< 0 es rgida.
+	const BakedAnimation* baked = nullptr;  ///< Multitud con animacin horneada, o nulo.
+	uint32_t firstInstance = 0;             ///< Con `baked`: sus instancias en `skinnedInstances()`.
+	uint32_t instanceCount = 0;
+	bool isStatic = false;                  ///< No se mueve entre frames: su sombra se guarda.
+
+	bool
+	isSkinned() const { return boneCount != 0 || baked != nullptr; }
+
+	/**
+	 * @brief `true` si va en el paso opaco: sin alfa en el color ni en el material.
+	 */
+	bool
+	isOpaque() const { return color.a == 255 && (!material || material->isOpaque()); }
+};
+
+/**
+ * @brief Matrices de la cmara del frame, con la disposicin `std140` del bloque uniforme de
+ *        `MeshPipeline`: se suben tal cual.
+ */
+struct CameraUniforms {
+	Mat4 view;
+	Mat4 projection;
+	Mat4 viewProjection;
+	float position[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  ///< Posicin de la cmara; w = 1.
+};
+
+/**
+ * @brief Luz puntual del frame, como la lee el shader de `MeshPipeline`: dos `vec4`.
+ */
+struct PointLightData {
+	float position[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  ///< Posicin de mundo; w = radio de alcance.
+	float color[4] = { 1.0f, 1.0f, 1.0f, 0.0f };     ///< Color lineal por intensidad; w sin uso.
+};
+
+/**
+ * @brief Luz direccional del frame (el sol), como la lee el shader de `MeshPipeline`. Por
+ *        defecto la luz fija de siempre: de arriba y de frente, con un mnimo de ambiente.
+ */
+struct DirectionalLightData {
+	float direction[4] = { -0.303f, 0.505f, -0.808f, 0.0f };  ///< Hacia dnde viaja la luz; w sin uso.
+	float color[4] = { 0.65f, 0.65f, 0.65f, 0.35f };         ///< Color lineal; w = ambiente.
+};
+
+/**
+ * @class RenderCommandBuffer
+ * @brief Lista de dibujos de un frame que los componentes llenan en `Component::render`.
+ *
+ * Recorrer componentes y hablar con SFML quedan separados: cada componente solo agrega
+ * comandos, y `Window::submit` los ordena por clave y los dibuja todos juntos. La clave de
+ * 64 bits (`sortKeyOf`) junta los comandos con el mismo shader, textura y mezcla dentro de
+ * cada capa y profundidad, as que el orden en que se recorrieron los actores no decide
+ * cuntas veces cambia el estado de GL. Los vectores conservan su capacidad entre frames, as
+ * que llenar y ordenar el buffer no reserva memoria una vez estable.
+ *
+ * Un solo hilo. Para grabar en paralelo, cada hilo llena un buffer propio y despus se juntan
+ * con `append` en el orden en que se repartieron las entidades.
+ */
+class
+RenderCommandBuffer {
+public:
+	/**
+	 * @brief Agrega un dibujo.
+	 * @param geometry Geometra; debe vivir hasta el envo.
+	 * @param transform Matriz de mundo.
+	 * @param layer Capa: las bajas se dibujan primero.
+	 * @param texture Material, o nulo.
+	 */
+	void
+	draw(const sf::Drawable& geometry, const sf::Transform& transform, uint8_t layer = 0, const sf::Texture* texture = nullptr);
+
+	/**
+	 * @brief Igual, para una figura: `ShapeBatcher` la junta con las vecinas del mismo material.
+	 * @param outline Puntos locales de la figura (`sf::Shape::getPoint`), si quien llama ya los
+	 *        tiene; vaco los pide a la figura al enviar. Deben vivir hasta el envo.
+	 */
+	void
+	draw(const sf::Shape& shape, const sf::Transform& transform, uint8_t layer = 0, const sf::Texture* texture = nullptr,
+		std::span<const sf::Vector2f> outline = {});
+
+	/**
+	 * @brief Agrega un dibujo con profundidad, shader o mezcla propios.
+	 */
+	void
+	draw(const sf::Drawable& geometry, const sf::Transform& transform, const DrawState& state);
+
+	void
+	draw(const sf::Shape& shape, const sf::Transform& transform, const DrawState& state,
+		std::span<const sf::Vector2f> outline = {});
+
+	/**
+	 * @brief Dibuja una figura compartida (`ShapeGeometryLibrary`) con el color de quien la usa.
+	 *
+	 * La figura no se modifica ni se destruye durante el programa, as que `copyShapes` no la
+	 * copia: el comando lleva el color y la matriz, que es todo lo propio de cada actor.
+	 */
+	void
+	drawShared(const sf::Shape& shape, const sf::Transform& transform, sf::Color color, uint8_t layer = 0,
+		std::span<const sf::Vector2f> outline = {});
+
+	/**
+	 * @brief Dibuja un sprite: la figura compartida `square` estirada por `transform`, con el
+	 *        rectngulo `textureRect` de `texture`.
+	 *
+	 * Con `texture` una pgina de `TextureAtlas`, todos los sprites de la capa que la comparten
+	 * quedan seguidos en el orden y `ShapeBatcher` los junta en un solo lote.
+	 */
+	void
+	drawSprite(const sf::Shape& square, const sf::Transform& transform, const sf::Texture* texture,
+		const sf::IntRect& textureRect, sf::Color color, uint8_t layer = 0, std::span<const sf::Vector2f> outline = {});
+
+	/**
+	 * @brief Agrega una malla 3D. Las mallas no entran en el orden por clave: `Window::submit`
+	 *        las dibuja antes que las figuras, con test de profundidad.
+	 * @param material Debe vivir hasta el envo, como la malla; nulo es blanco.
+	 */
+	void
+	drawMesh(const Mesh& mesh, const Mat4& model, sf::Color color = sf::Color::White, const Material* material = nullptr);
+
+	/**
+	 * @brief Igual, para una malla que no se mueve ni cambia: `MeshPipeline` guarda su sombra
+	 *        y no la vuelve a dibujar mientras el conjunto esttico y la luz sigan iguales.
+	 */
+	void
+	drawStaticMesh(const Mesh& mesh, const Mat4& model, sf::Color color = sf::Color::White, const Material* material = nullptr);
+
+	/**
+	 * @brief Agrega una malla con piel en la pose de `palette` (una matriz de piel por hueso,
+	 *        `Skeleton::skinningMatrices`). Las paletas del frame se copian seguidas y se suben
+	 *        juntas, una vez.
+	 */
+	void
+	drawSkinnedMesh(const Mesh& mesh, const Mat4& model, std::span<const Mat4> palette, sf::Color color = sf::Color::White,
+		const Material* material = nullptr);
+
+	/**
+	 * @brief Agrega una multitud de la misma malla con piel, animada con `animation`: un solo
+	 *        draw instanciado, en el que cada instancia lleva su matriz y su tiempo.
+	 */
+	void
+	drawSkinnedInstances(const Mesh& mesh, const BakedAnimation& animation, std::span<const SkinnedInstance> instances,
+		sf::Color color = sf::Color::White, const Material* material = nullptr);
+
+	/**
+	 * @brief Pxeles de pantalla por unidad de mundo con la vista del frame; lo usan los
+	 *        componentes para elegir su nivel de detalle. 0 (por defecto) es desconocido.
+	 *        `clear` lo conserva.
+	 */
+	void
+	setPixelScale(float pixelsPerUnit) { m_pixelScale = pixelsPerUnit; }
+
+	float
+	pixelScale() const { return m_pixelScale; }
+
+	/**
+	 * @brief Rectngulo de mundo que muestra la vista del frame, para que los componentes con
+	 *        muchas partes (`Tilemap`) graben solo las que se ven. Vaco (por defecto) es
+	 *        desconocido. `clear` lo conserva.
+	 */
+	void
+	setVisibleArea(const sf::FloatRect& area) { m_visibleArea = area; }
+
+	const sf::FloatRect&
+	visibleArea() const { return m_visibleArea; }
+
+	/**
+	 * @brief Cmara con que se dibujan las mallas del frame (la graba `Camera::render`).
+	 */
+	void
+	setCamera(const CameraUniforms& camera) { m_camera = camera; m_hasCamera = true; }
+
+	/**
+	 * @brief La cmara del frame, o nulo si ninguna grab.
+	 */
+	const CameraUniforms*
+	camera() const { return m_hasCamera ? &m_camera : nullptr; }
+
+	/**
+	 * @brief Agrega una luz que ilumina las mallas del frame (la graba `PointLight::render`).
+	 */
+	void
+	addLight(const PointLightData& light) { m_lights.push_back(light); }
+
+	std::span<const PointLightData>
+	lights() const { return m_lights; }
+
+	/**
+	 * @brief Cambia la luz direccional del frame; `clear` vuelve a la de por defecto.
+	 */
+	void
+	setSunLight(const DirectionalLightData& light) { m_sun = light; }
+
+	const DirectionalLightData&
+	sunLight() const { return m_sun; }
+
+	/**
+	 * @brief Agrega al final los comandos, mallas y luces de `other`, como si se hubieran
+	 *        grabado aqu a continuacin. Su cmara, si grab una, reemplaza a la de este.
+	 *
+	 * `other` no debe haber pasado por `copyShapes`: sus comandos apuntaran a sus copias.
+	 */
+	void
+	append(const RenderCommandBuffer& other);
+
+	/**
+	 * @brief Ordena los comandos por clave con un radix sort de 8 bits por pasada; a igual
+	 *        clave se respeta el orden en que llegaron. Si no se agreg nada desde el ltimo
+	 *        `sort`, no hace nada.
+	 *
+	 * Las pasadas en que todas las claves tienen el mismo byte (por ejemplo, todas en la capa 0
+	 * y sin shader) se saltan, as que un frame con pocos estados distintos cuesta unas pocas
+	 * pasadas lineales.
+	 *
+	 * @param jobs Con muchos comandos, cada pasada cuenta y reparte en trozos paralelos; el
+	 *        resultado es el mismo que sin l.
+	 */
+	void
+	sort(JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief Clave de ordenamiento de `state`: capa en los bits 56-63, profundidad en 40-55,
+	 *        shader en 28-39, textura en 8-27 y mezcla en 0-7.
+	 *
+	 * Shader, textura y mezcla se resumen a hashes de su ancho: dos distintos pueden compartir
+	 * valor y quedar intercalados, lo que solo cuesta cambios de estado de ms, no un dibujo
+	 * equivocado.
+	 */
+	static uint64_t
+	sortKeyOf(const DrawState& state);
+
+	/**
+	 * @brief Capa guardada en una clave de `sortKeyOf`.
+	 */
+	static constexpr uint8_t
+	layerOf(uint64_t sortKey) { return static_cast<uint8_t>(sortKey >> 56); }
+
+	/**
+	 * @brief Comandos en orden de dibujo (despus de `sort`) o de llegada.
+	 */
+	template<typename Fn>
+	void
+	forEach(Fn&& fn) const {
+		if (m_sorted) {
+			for (uint32_t index : m_order) {
+				fn(m_commands[index]);
+			}
+		}
+		else {
+			for (const DrawCommand& command : m_commands) {
+				fn(command);
+			}
+		}
+	}
+
+	/**
+	 * @brief Copia al buffer las figuras de los comandos (`sf::CircleShape`, `sf::RectangleShape`
+	 *        y `sf::ConvexShape`) y apunta los comandos a las copias.
+	 *
+	 * Despus el buffer ya no depende de los componentes que lo llenaron: es la foto del frame
+	 * que `RenderThread` dibuja mientras la simulacin sigue. Las figuras compartidas
+	 * (`drawShared`) no cambian y no se copian; los dems `sf::Drawable` se quedan por puntero y
+	 * no deben cambiar hasta que se dibujen. Las copias reciclan su memoria entre
+	 * frames.
+	 */
+	void
+	copyShapes();
+
+	/**
+	 * @brief Vaca el buffer para el siguiente frame.
+	 */
+	void
+	clear();
+
+	size_t
+	size() const { return m_commands.size(); }
+
+	bool
+	empty() const { return m_commands.empty(); }
+
+	std::span<const DrawCommand>
+	commands() const { return m_commands; }
+
+	std::span<const MeshCommand>
+	meshCommands() const { return m_meshes; }
+
+	/**
+	 * @brief Matrices de piel de las mallas de `drawSkinnedMesh`, seguidas.
+	 */
+	std::span<const Mat4>
+	bonePalette() const { return m_bones; }
+
+	std::span<const SkinnedInstance>
+	skinnedInstances() const { return m_skinnedInstances; }
+
+private:
+	template<typename T>
+	using Storage = EngineUtilities::TAccountedVector<T, EngineUtilities::MemoryCategory::Render>;
+
+	Storage<DrawCommand> m_commands;   ///< En orden de llegada.
+	Storage<MeshCommand> m_meshes;     ///< Mallas 3D, en orden de llegada.
+	Storage<uint32_t> m_order;         ///< ndices en `m_commands`, en orden de dibujo.
+	Storage<uint64_t> m_keys;          ///< Clave de cada entrada de `m_order` durante `sort`.
+	Storage<uint32_t> m_scratchOrder;  ///< Destino de cada pasada del radix sort.
+	Storage<uint64_t> m_scratchKeys;
+	Storage<std::array<uint32_t, 256>> m_chunkOffsets; ///< Por trozo de un `sort` en paralelo.
+	Storage<sf::CircleShape> m_circles;       ///< Copias de `copyShapes`.
+	Storage<sf::RectangleShape> m_rectangles;
+	Storage<sf::ConvexShape> m_convexShapes;
+	Storage<PointLightData> m_lights;
+	Storage<Mat4> m_bones;                    ///< Paletas de `drawSkinnedMesh`.
+	Storage<SkinnedInstance> m_skinnedInstances;
+	CameraUniforms m_camera;
+	DirectionalLightData m_sun;
+	float m_pixelScale = 0.0f;             ///< Ver `setPixelScale`.
+	sf::FloatRect m_visibleArea;           ///< Ver `setVisibleArea`.
+	bool m_hasCamera = false;
+	bool m_sorted = false;                 ///< `m_order` est al da.
+};
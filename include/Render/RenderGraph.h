@@ -0,0 +1,204 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Prerequisites.h"
+
+class RenderTargetPool;
+
+/**
+ * @class RenderGraph
+ * @brief Pases de un frame declarados con lo que leen y lo que escriben; el grafo descarta los
+ *        que no aportan a la salida, los ordena y reparte las texturas intermedias.
+ *
+ * Cada frame se declara de nuevo (`reset`, recursos, `addPass`) y se corre con `execute`:
+ *
+ * - Los recursos son destinos importados (la ventana), texturas importadas (la escena) o
+ *   texturas transitorias de un tamao, que solo existen mientras algn pase las usa.
+ * - Un pase sobrevive si escribe un destino importado o algo que lee un pase que sobrevive; el
+ *   resto no corre. Un pase que lee una transitoria que nadie escribi antes tambin se
+ *   descarta.
+ * - Los pases corren en el orden en que se agregaron, que debe respetar sus dependencias
+ *   (quien escribe algo va antes que quien lo lee), como en `SystemScheduler`.
+ * - Cada transitoria toma una textura de `RenderTargetPool` antes de su primer pase y la
+ *   devuelve tras el ltimo: dos transitorias del mismo tamao que no viven a la vez usan la
+ *   misma memoria. Tras escribirlas se cierran con `display` para poder leerlas.
+ *
+ * `execute` cierra el frame del pool (`RenderTargetPool::endFrame`): un solo grafo por pool y
+ * frame. Un solo hilo, el que dibuja.
+ */
+class
+RenderGraph {
+public:
+	using ResourceId = uint32_t;
+	static constexpr ResourceId kInvalidResource = ~ResourceId(0);
+
+	/**
+	 * @brief Lo que un pase ve al correr: sus recursos ya creados.
+	 */
+	class
+	PassContext {
+	public:
+		/**
+		 * @brief Dnde dibujar `resource` (destino importado o transitoria).
+		 */
+		sf::RenderTarget&
+		target(ResourceId resource) const;
+
+		/**
+		 * @brief La imagen de `resource` (textura importada o transitoria ya escrita).
+		 */
+		const sf::Texture&
+		texture(ResourceId resource) const;
+
+	private:
+		friend class RenderGraph;
+		explicit PassContext(RenderGraph& graph) : m_graph(graph) {}
+
+		RenderGraph& m_graph;
+	};
+
+	/**
+	 * @brief Declara los accesos de un pase mientras se agrega.
+	 */
+	class
+	PassBuilder {
+	public:
+		PassBuilder&
+		read(ResourceId resource);
+
+		PassBuilder&
+		write(ResourceId resource);
+
+	private:
+		friend class RenderGraph;
+		PassBuilder(RenderGraph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+		RenderGraph& m_graph;
+		uint32_t m_pass;
+	};
+
+	using Execute = std::function<void(PassContext&)>;
+
+	explicit RenderGraph(RenderTargetPool& pool) : m_pool(pool) {}
+
+	RenderGraph(const RenderGraph&) = delete;
+	RenderGraph& operator=(const RenderGraph&) = delete;
+
+	/**
+	 * @brief Olvida pases y recursos del frame anterior; las listas conservan su capacidad.
+	 */
+	void
+	reset();
+
+	ResourceId
+	importTarget(const char* name, sf::RenderTarget& target);
+
+	ResourceId
+	importTexture(const char* name, const sf::Texture& texture);
+
+	/**
+	 * @brief Una textura transitoria de `size`; se crea (o se reutiliza) al correr.
+	 */
+	ResourceId
+	createTexture(const char* name, sf::Vector2u size);
+
+	/**
+	 * @brief Tamao de `resource`, importado o transitorio.
+	 */
+	sf::Vector2u
+	size(ResourceId resource) const;
+
+	/**
+	 * @brief Agrega un pase: `setup` declara lo que lee y escribe, `execute` lo dibuja.
+	 */
+	template<typename Setup>
+	void
+	addPass(const char* name, Setup&& setup, Execute execute) {
+		uint32_t index = beginPass(name, std::move(execute));
+		PassBuilder builder(*this, index);
+		setup(builder);
+	}
+
+	/**
+	 * @brief Descarta, ordena, reparte las transitorias y corre los pases que quedan.
+	 */
+	void
+	execute();
+
+	size_t
+	passCount() const { return m_passes.size(); }
+
+	/**
+	 * @brief Pases que el ltimo `execute` descart.
+	 */
+	size_t
+	culledCount() const { return m_culled; }
+
+	/**
+	 * @brief Transitorias vivas a la vez en el peor momento del ltimo `execute`: las texturas
+	 *        que hicieron falta, contra `transientCount` sin compartir.
+	 */
+	size_t
+	peakTransients() const { return m_peakTransients; }
+
+	size_t
+	transientCount() const;
+
+private:
+	enum class Kind : uint8_t {
+		Target,
+		Texture,
+		Transient
+	};
+
+	struct Resource {
+		const char* name = nullptr;
+		Kind kind = Kind::Transient;
+		sf::Vector2u size;
+		sf::RenderTarget* target = nullptr;         ///< Destino importado.
+		const sf::Texture* texture = nullptr;       ///< Textura importada.
+		sf::RenderTexture* physical = nullptr;      ///< Transitoria: la del pool mientras vive.
+		uint32_t firstPass = 0;
+		uint32_t lastPass = 0;
+		bool needed = false;
+		bool written = false;
+	};
+
+	struct Pass {
+		const char* name = nullptr;
+		Execute execute;
+		uint32_t firstAccess = 0;   ///< En `m_accesses`.
+		uint32_t accessCount = 0;
+		bool alive = false;
+	};
+
+	struct Access {
+		ResourceId resource;
+		bool write;
+	};
+
+	uint32_t
+	beginPass(const char* name, Execute execute);
+
+	void
+	addAccess(uint32_t pass, ResourceId resource, bool write);
+
+	/**
+	 * @brief Marca los pases vivos, del ltimo al primero, y la vida de cada transitoria.
+	 */
+	void
+	cull();
+
+	ResourceId
+	addResource(Resource resource);
+
+	RenderTargetPool& m_pool;
+	std::vector<Resource> m_resources;
+	std::vector<Pass> m_passes;
+	std::vector<Access> m_accesses;    ///< De todos los pases, contiguos por pase.
+	std::vector<bool> m_readable;      ///< De `cull`: el recurso ya tiene contenido.
+	std::vector<bool> m_valid;         ///< De `cull`: el pase tiene todo lo que lee.
+	size_t m_culled = 0;
+	size_t m_peakTransients = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Prerequisites.h"
+
+/**
+ * @brief Lo que cost dibujar un frame.
+ */
+struct RenderStats {
+	size_t drawCalls = 0;
+	size_t vertices = 0;       ///< Vrtices enviados, contando los de cada instancia.
+	size_t stateChanges = 0;   ///< Draws con textura, shader, mezcla o programa distintos del anterior.
+	size_t textureBinds = 0;   ///< Draws con una textura distinta de la anterior.
+	size_t uploadBytes = 0;    ///< Bytes subidos a bferes y texturas.
+	size_t clears = 0;
+};
+
+/**
+ * @class RenderStatsCounter
+ * @brief Cuenta lo que dibuja el hilo que lo llama; `Window::display` cierra el frame.
+ *
+ * `Window::draw`, `clear`, `display`, `ShapeBatcher` y los renderers de OpenGL propio llaman a
+ * `countDraw` y `countUpload` junto a cada draw y subida. Los cambios de estado se estiman
+ * comparando cada draw con el anterior del mismo hilo, igual que decide SFML si vuelve a
+ * aplicar textura, shader y mezcla. As se comprueba en cualquier build que el batching y el
+ * culling hacen lo que prometen.
+ *
+ * Hay un contador por hilo: con `RenderThread`, el de render. Cuesta unas sumas por draw.
+ */
+class
+RenderStatsCounter {
+public:
+	/**
+	 * @brief El contador del hilo que llama.
+	 */
+	static RenderStatsCounter&
+	current();
+
+	/**
+	 * @brief Un draw de `vertices` vrtices con ese estado; `glProgram` es el de los renderers
+	 *        con OpenGL propio (0 para los de SFML).
+	 */
+	void
+	countDraw(size_t vertices, const sf::Texture* texture, const sf::Shader* shader = nullptr,
+		const sf::BlendMode& blendMode = sf::BlendAlpha, uint32_t glProgram = 0);
+
+	void
+	countUpload(size_t bytes) { m_frame.uploadBytes += bytes; }
+
+	void
+	countClear() { ++m_frame.clears; }
+
+	/**
+	 * @brief Lo contado en el frame en curso.
+	 */
+	const RenderStats&
+	frame() const { return m_frame; }
+
+	/**
+	 * @brief Cierra el frame: devuelve lo contado y empieza de cero.
+	 */
+	RenderStats
+	endFrame();
+
+	/**
+	 * @brief Vrtices con que SFML dibuja `drawable`: figuras, sprites, textos y arreglos de
+	 *        vrtices; 0 si no se sabe.
+	 */
+	static size_t
+	vertexCount(const sf::Drawable& drawable);
+
+private:
+	RenderStats m_frame;
+	const sf::Texture* m_lastTexture = nullptr;
+	const sf::Shader* m_lastShader = nullptr;
+	sf::BlendMode m_lastBlendMode = sf::BlendAlpha;
+	uint32_t m_lastProgram = 0;
+	bool m_hasLast = false;    ///< Hubo algn draw en el frame.
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+
+/**
+ * @class RenderTargetPool
+ * @brief `sf::RenderTexture` intermedias que se piden por tamao y se devuelven al terminar,
+ *        para que los pases de un frame no creen ni destruyan texturas.
+ *
+ * `acquire` da una libre del mismo tamao o crea una; `release` la deja para el siguiente que
+ * pida ese tamao, en este frame o en otro. Las que llevan `kIdleFrames` frames sin usarse se
+ * destruyen en `endFrame`: si cambia la resolucin, las del tamao viejo no se quedan.
+ *
+ * Las texturas tienen filtro lineal, para que leer una ms chica al dibujar en otra ms grande
+ * la suavice. Un solo hilo, el que dibuja.
+ */
+class
+RenderTargetPool {
+public:
+	static constexpr uint32_t kIdleFrames = 120;
+
+	RenderTargetPool() = default;
+
+	RenderTargetPool(const RenderTargetPool&) = delete;
+	RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+	/**
+	 * @brief Una textura de `size` que nadie ms usa hasta `release`; su contenido es el que
+	 *        haya quedado.
+	 * @return `nullptr` si no pudo crearse.
+	 */
+	sf::RenderTexture*
+	acquire(sf::Vector2u size);
+
+	/**
+	 * @brief Devuelve una textura de `acquire`.
+	 */
+	void
+	release(sf::RenderTexture* target);
+
+	/**
+	 * @brief Cierra el frame y destruye las libres que no se usaron en `kIdleFrames` frames.
+	 */
+	void
+	endFrame();
+
+	/**
+	 * @brief Destruye todas; ninguna debe estar en uso.
+	 */
+	void
+	clear() { m_entries.clear(); }
+
+	/**
+	 * @brief Texturas creadas, en uso o no.
+	 */
+	size_t
+	size() const { return m_entries.size(); }
+
+	/**
+	 * @brief Veces que `acquire` tuvo que crear una textura.
+	 */
+	size_t
+	createdCount() const { return m_created; }
+
+private:
+	struct Entry {
+		EngineUtilities::TUniquePtr<sf::RenderTexture> target;
+		sf::Vector2u size;
+		uint32_t lastUsed = 0;    ///< Frame del ltimo `acquire`.
+		bool inUse = false;
+	};
+
+	std::vector<Entry> m_entries;
+	uint32_t m_frame = 0;
+	size_t m_created = 0;
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/RenderCommandBuffer.h"
+
+class Window;
+
+/**
+ * @class RenderThread
+ * @brief Hilo dueo del contexto de la ventana: dibuja la foto de un frame mientras la
+ *        simulacin arma el siguiente.
+ *
+ * El hilo principal sigue con los eventos, `update` y la grabacin de comandos. Cada frame pide
+ * un buffer libre (`acquireFrame`), lo llena y lo entrega (`submitFrame`), que copia las figuras
+ * (`RenderCommandBuffer::copyShapes`) para que la foto no dependa de los componentes. El hilo
+ * de render limpia, dibuja con `Window::submit` y espera el `display` y el vsync por su cuenta:
+ * esa espera ya no frena la simulacin.
+ *
+ * Hay dos fotos y una sola en vuelo. `acquireFrame` espera a que el hilo de render haya
+ * terminado de *enviar* la anterior, no de mostrarla: las cachs compartidas
+ * (`StaticGeometryCache`, `LayerCache`) se tocan al grabar y al enviar, nunca a la vez. As,
+ * update N+1 corre junto con el envo de N, y la grabacin de N+1 junto con su `display`.
+ *
+ * Mientras corre, solo el hilo de render toca el contexto y la vista de la ventana; las vistas de
+ * cada frame viajan en la foto.
+ */
+class
+RenderThread {
+public:
+	/**
+	 * @brief Lo que el hilo de render necesita para dibujar un frame.
+	 */
+	struct Frame {
+		RenderCommandBuffer commands;
+		std::vector<sf::View> views;   ///< Una o ms (`Window::submit` con vistas); la primera queda en la ventana.
+	};
+
+	RenderThread() = default;
+
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+	~RenderThread() { stop(); }
+
+	/**
+	 * @brief Le pasa el contexto de `window` a un hilo nuevo y empieza a esperar frames.
+	 */
+	void
+	start(Window& window);
+
+	/**
+	 * @brief Dibuja el frame pendiente, termina el hilo y devuelve el contexto al que llama.
+	 */
+	void
+	stop();
+
+	bool
+	isRunning() const { return m_thread.joinable(); }
+
+	/**
+	 * @brief Espera a que el frame anterior se haya enviado y devuelve la foto libre, vaca.
+	 */
+	Frame&
+	acquireFrame();
+
+	/**
+	 * @brief Cierra la foto de `acquireFrame` y se la pasa al hilo de render.
+	 */
+	void
+	submitFrame();
+
+	/**
+	 * @brief Milisegundos que `acquireFrame` esper al hilo de render en el ltimo frame.
+	 */
+	double
+	lastWaitMs() const { return m_lastWaitMs; }
+
+private:
+	void
+	loop();
+
+	Window* m_window = nullptr;
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;   ///< Hay un frame pendiente o hay que parar.
+	std::condition_variable m_idle;   ///< El frame pendiente ya se envi.
+	Frame m_frames[2];
+	int m_writeIndex = 0;             ///< Foto que llena la simulacin.
+	int m_pending = -1;               ///< Foto entregada que el hilo de render no tom.
+	bool m_submitting = false;        ///< El hilo de render est enviando comandos.
+	bool m_stop = false;
+	double m_lastWaitMs = 0.0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/StreamBuffer.h"
+
+class RenderCommandBuffer;
+class ShapeBatcher;
+struct DrawCommand;
+
+/**
+ * @class SdfShapeRenderer
+ * @brief Dibuja crculos y polgonos regulares como un quad cada uno: el borde lo calcula el
+ *        fragment shader con su campo de distancias, con antialiasing analtico.
+ *
+ * Un `sf::CircleShape` de 30 puntos son 30 tringulos y su borde se ve facetado al
+ * agrandarlo. Aqu cada figura son los 4 vrtices de un quad compartido ms 40 bytes de
+ * instancia (matriz 2x3, radio, margen, lados y color); el shader mide la distancia de cada
+ * pxel al borde exacto y la convierte en cobertura con `fwidth`, as que el borde queda suave
+ * a cualquier escala. Los `sf::CircleShape` de menos de `kMinCirclePoints` puntos son
+ * polgonos regulares (el tringulo de `ShapeFactory`), con un vrtice hacia arriba como SFML;
+ * los dems, crculos verdaderos.
+ *
+ * Entran los `sf::CircleShape` sin textura, shader, mezcla propia ni contorno; el resto sigue
+ * por `ShapeBatcher`. Capas y profundidades se respetan como en `InstancedShapeRenderer`.
+ *
+ * Necesita OpenGL 3.3; si falta algo, `initialize` devuelve `false`. Un solo hilo, el del
+ * contexto de la ventana.
+ */
+class
+SdfShapeRenderer {
+public:
+	static constexpr size_t kMinCirclePoints = 12;
+	static constexpr float kEdgeMarginPixels = 1.5f; ///< Lo que el quad sobresale de la figura, para el borde suave.
+
+	SdfShapeRenderer() = default;
+
+	SdfShapeRenderer(const SdfShapeRenderer&) = delete;
+	SdfShapeRenderer& operator=(const SdfShapeRenderer&) = delete;
+
+	/**
+	 * @brief Carga las funciones de OpenGL, compila el shader y sube el quad. El contexto de
+	 *        destino debe estar activo.
+	 * @return `false` si el contexto no alcanza; no hay que llamar a `submit`.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_program != 0; }
+
+	/**
+	 * @brief Libera los objetos de OpenGL. Debe llamarse con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Ordena `commands` y los dibuja en `target`: crculos y polgonos como quads, el
+	 *        resto con `batcher`.
+	 */
+	void
+	submit(sf::RenderTarget& target, RenderCommandBuffer& commands, ShapeBatcher& batcher);
+
+	/**
+	 * @brief Indica si `command` puede dibujarse como quad.
+	 */
+	static bool
+	isSdfShape(const DrawCommand& command);
+
+	/**
+	 * @brief `glDrawArraysInstanced` del ltimo `submit`.
+	 */
+	size_t
+	drawCalls() const { return m_drawCalls; }
+
+	/**
+	 * @brief Figuras dibujadas como quad en el ltimo `submit`.
+	 */
+	size_t
+	shapeCount() const { return m_shapeTotal; }
+
+private:
+	/**
+	 * @brief Datos de una figura para el shader.
+	 */
+	struct Instance {
+		float row0[3];     ///< Filas de la matriz de mundo.
+		float row1[3];
+		float radius;      ///< Radio local; el centro es (radio, radio), como en SFML.
+		float margin;      ///< `kEdgeMarginPixels` en unidades locales.
+		float sides;       ///< 0 para un crculo.
+		uint8_t color[4];
+	};
+
+	/**
+	 * @brief Sube y dibuja las figuras pendientes.
+	 */
+	void
+	flush(sf::RenderTarget& target);
+
+	std::vector<Instance> m_pending;      ///< Figuras de la capa y profundidad en curso.
+	uint32_t m_program = 0;
+	uint32_t m_vertexArray = 0;
+	uint32_t m_quadBuffer = 0;
+	StreamBuffer m_instances;             ///< Instancias del frame, en anillo.
+	int32_t m_viewLocation = -1;
+	size_t m_drawCalls = 0;
+	size_t m_shapeTotal = 0;
+};
@@ -0,0 +1,187 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/GlFunctions.h"
+
+/**
+ * @class ShaderCache
+ * @brief Programas de OpenGL y `sf::Shader` compilados una sola vez, con los binarios del
+ *        driver guardados en disco para que el siguiente arranque no compile nada.
+ *
+ * Cada programa se identifica por el FNV-1a de sus fuentes, sus `defines` y el driver
+ * (`GL_VENDOR`, `GL_RENDERER`, `GL_VERSION`): dos renderers con las mismas fuentes comparten
+ * programa, y un binario de otro driver nunca se carga. Con `glGetProgramBinary` disponible,
+ * cada programa compilado se escribe en `binaryDirectory()/<clave>.bin`; al pedirlo otra vez se
+ * intenta `glProgramBinary` y, si el driver lo rechaza (se actualiz), se compila y se
+ * reescribe.
+ *
+ * Las variantes se compilan al pedirlas por primera vez. `precompile` adelanta una lista en
+ * un hilo propio con un `sf::Context` compartido: si alguien pide una variante mientras ese
+ * hilo la compila, espera a que termine en vez de compilarla dos veces.
+ *
+ * `program` y `release` van en un hilo con contexto activo (el de la ventana o el de render).
+ * `shader` crea objetos de SFML y va siempre en un mismo hilo con contexto. Es un servicio
+ * (`TService<ShaderCache>`).
+ */
+class
+ShaderCache {
+public:
+	static constexpr const char* kDefaultBinaryDirectory = "shadercache";
+
+	/**
+	 * @brief Una variante por compilar. Las fuentes deben vivir hasta que se compile.
+	 */
+	struct Variant {
+		const char* vertexSource = nullptr;
+		const char* fragmentSource = nullptr;
+		std::string defines;          ///< Lneas de preprocesador (`#define X 1\n`), tras `#version`.
+		const char* computeSource = nullptr;   ///< Si no es nulo, un programa de cmputo; las otras dos no se usan.
+	};
+
+	ShaderCache() = default;
+
+	/**
+	 * @brief Espera a que termine `precompile`; los programas son del contexto y se borran con
+	 *        `release`.
+	 */
+	~ShaderCache();
+
+	ShaderCache(const ShaderCache&) = delete;
+	ShaderCache& operator=(const ShaderCache&) = delete;
+
+	/**
+	 * @brief Carpeta de los binarios; vaca, no se leen ni se escriben.
+	 */
+	void
+	setBinaryDirectory(const std::string& directory) { m_directory = directory; }
+
+	const std::string&
+	binaryDirectory() const { return m_directory; }
+
+	/**
+	 * @brief El programa de esas fuentes y `defines`: del cach, del binario en disco o recin
+	 *        compilado.
+	 * @return 0 si no compil; se anuncia con `MESSAGE` y no se reintenta.
+	 */
+	GLuint
+	program(const char* vertexSource, const char* fragmentSource, std::string_view defines = {});
+
+	/**
+	 * @brief Igual, un programa de cmputo; 0 tambin si el driver no tiene compute shaders.
+	 */
+	GLuint
+	computeProgram(const char* source, std::string_view defines = {});
+
+	/**
+	 * @brief Compila `variants` en un hilo aparte. Si ya hay una precompilacin en curso,
+	 *        espera a que termine antes de lanzar esta.
+	 */
+	void
+	precompile(std::vector<Variant> variants);
+
+	/**
+	 * @brief Espera a que termine `precompile`.
+	 */
+	void
+	waitPrecompile();
+
+	/**
+	 * @brief Un `sf::Shader` de esas fuentes y `defines`, cargado una sola vez; SFML no deja
+	 *        darle un binario, as que solo se deduplica.
+	 * @return `nullptr` si no compil.
+	 */
+	sf::Shader*
+	shader(const std::string& vertexSource, const std::string& fragmentSource, std::string_view defines = {});
+
+	/**
+	 * @brief Borra todos los programas. Con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Programas compilados desde las fuentes, contando los de `precompile`.
+	 */
+	size_t
+	compileCount() const { return m_compiles.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Programas cargados de un binario en disco.
+	 */
+	size_t
+	binaryLoadCount() const { return m_binaryLoads.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Clave de un programa: FNV-1a de `defines` y las dos fuentes, a partir de `seed`.
+	 */
+	static uint64_t
+	hashSources(uint64_t seed, std::string_view defines, std::string_view vertexSource, std::string_view fragmentSource);
+
+	/**
+	 * @brief `source` con `defines` insertados despus de su lnea `#version`, o al inicio.
+	 */
+	static std::string
+	withDefines(std::string_view source, std::string_view defines);
+
+private:
+	/**
+	 * @brief Un programa ya hecho o que algn hilo est haciendo (`building`).
+	 */
+	struct Entry {
+		GLuint program = 0;
+		bool building = true;
+	};
+
+	/**
+	 * @brief Clave de `variant` con la semilla del driver.
+	 */
+	static uint64_t
+	keyOf(uint64_t seed, const Variant& variant);
+
+	/**
+	 * @brief Busca la clave o la reserva y la hace; si otro hilo la est haciendo, espera.
+	 * @param finish Terminar el programa en la GPU antes de publicarlo, para que otro contexto
+	 *        pueda usarlo (el hilo de `precompile`).
+	 */
+	GLuint
+	find(const Variant& variant, uint64_t key, bool finish);
+
+	/**
+	 * @brief Carga el binario de `key` o compila `variant` y guarda el binario.
+	 */
+	GLuint
+	build(const Variant& variant, uint64_t key);
+
+	bool
+	loadBinary(GLuint program, uint64_t key);
+
+	void
+	saveBinary(GLuint program, uint64_t key);
+
+	std::string
+	binaryPath(uint64_t key) const;
+
+	/**
+	 * @brief FNV-1a de los textos del driver, para la clave. En un hilo con contexto.
+	 */
+	uint64_t
+	driverSeed();
+
+	std::mutex m_mutex;
+	std::condition_variable m_built;                  ///< Algn `Entry` dej de estar en `building`.
+	std::unordered_map<uint64_t, Entry> m_programs;
+	std::unordered_map<uint64_t, EngineUtilities::TUniquePtr<sf::Shader>> m_shaders;
+	std::thread m_precompiler;
+	std::string m_directory = kDefaultBinaryDirectory;
+	std::atomic<uint64_t> m_driverSeed{ 0 };
+	std::atomic<size_t> m_compiles{ 0 };
+	std::atomic<size_t> m_binaryLoads{ 0 };
+};
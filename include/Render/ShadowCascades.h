@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include "Prerequisites.h"
+#include "Math/Mat4.h"
+
+struct CameraUniforms;
+
+/**
+ * @class ShadowCascades
+ * @brief Las cascadas de sombra de la luz direccional de `MeshPipeline`: en qu tramo de
+ *        profundidad de la cmara va cada una, su vista-proyeccin ortogrfica y cundo hay
+ *        que volver a dibujar en ellas lo esttico.
+ *
+ * La cmara se corta en `kCascades` tramos, ms finos cerca (mezcla `splitBlend` de reparto
+ * logartmico y parejo) hasta `maxDistance`. Cada tramo se envuelve en una esfera, que no
+ * cambia al girar la cmara, y la caja de la luz sobre ella crece `kMargin` por lado. Mientras
+ * la esfera del frame quepa en la caja anterior, la cascada conserva su matriz y sus sombras
+ * estticas guardadas siguen sirviendo; solo se rehace si se sale, si la caja queda ms del
+ * doble de grande que la esfera (se acerc la cmara y la resolucin ya no alcanza), si cambia
+ * la direccin de la luz o si cambia el conjunto esttico (`staticKey`).
+ *
+ * Las cuatro cascadas comparten un atlas de `kAtlasSize` texels por lado, en cuadrantes. Los
+ * oclusores ms all del plano cercano de la caja se aplastan contra l (`GL_DEPTH_CLAMP`),
+ * as que la caja no necesita llegar hasta la luz.
+ */
+class
+ShadowCascades {
+public:
+	static constexpr uint32_t kCascades = 4;
+	static constexpr uint32_t kResolution = 1024;             ///< Texels por lado de cada cascada.
+	static constexpr uint32_t kAtlasSize = 2 * kResolution;    ///< Las cuatro, en 2 x 2.
+	static constexpr float kMargin = 0.25f;                   ///< Lo que crece la caja sobre la esfera.
+
+	/**
+	 * @brief Profundidad de vista hasta la que hay sombras; ms lejos, todo iluminado.
+	 */
+	void
+	setMaxDistance(float distance) { m_maxDistance = distance > 0.0f ? distance : m_maxDistance; }
+
+	float
+	maxDistance() const { return m_maxDistance; }
+
+	/**
+	 * @brief 0 reparte los tramos parejo, 1 en proporcin logartmica; por defecto 0.75.
+	 */
+	void
+	setSplitBlend(float blend) { m_splitBlend = blend < 0.0f ? 0.0f : blend > 1.0f ? 1.0f : blend; }
+
+	/**
+	 * @brief Acomoda las cascadas a la cmara y a la luz del frame.
+	 * @param direction Hacia dnde viaja la luz, en el mundo.
+	 * @param staticKey Resumen del conjunto esttico: otro valor lo vuelve a dibujar todo.
+	 * @return Un bit por cascada cuya cach esttica hay que volver a dibujar.
+	 */
+	uint32_t
+	update(const CameraUniforms& camera, const sf::Vector3f& direction, uint64_t staticKey);
+
+	/**
+	 * @brief Olvida las cajas: el prximo `update` las rehace todas.
+	 */
+	void
+	invalidate() { m_valid = 0; }
+
+	/**
+	 * @brief Vista-proyeccin de la luz con que se dibuja la cascada, en su cuadrante.
+	 */
+	const Mat4&
+	viewProjection(uint32_t cascade) const { return m_cascades[cascade].viewProjection; }
+
+	/**
+	 * @brief Del mundo a coordenadas del atlas (x e y de 0 a 1) y profundidad de 0 a 1: la que
+	 *        usa el shader para buscar la sombra.
+	 */
+	Mat4
+	shadowMatrix(uint32_t cascade) const;
+
+	/**
+	 * @brief Profundidad de vista donde termina la cascada.
+	 */
+	float
+	splitDistance(uint32_t cascade) const { return m_cascades[cascade].split; }
+
+	/**
+	 * @brief Esquina inferior izquierda del cuadrante de la cascada, en texels del atlas.
+	 */
+	static uint32_t
+	atlasX(uint32_t cascade) { return (cascade & 1u) * kResolution; }
+
+	static uint32_t
+	atlasY(uint32_t cascade) { return (cascade >> 1) * kResolution; }
+
+	/**
+	 * @brief `false` si la caja local `[boundsMin, boundsMax]` con `model` no puede dar sombra
+	 *        dentro de la cascada: fuera de su rectngulo o toda detrs de su plano lejano.
+	 */
+	bool
+	overlaps(uint32_t cascade, const sf::Vector3f& boundsMin, const sf::Vector3f& boundsMax, const Mat4& model) const;
+
+	/**
+	 * @brief Cascadas rehechas desde el inicio, para medir cunto dura la cach.
+	 */
+	uint64_t
+	rebuilds() const { return m_rebuilds; }
+
+private:
+	struct Cascade {
+		Mat4 viewProjection;
+		sf::Vector3f center;        ///< De la caja, en el espacio de la luz.
+		float halfExtent = 0.0f;    ///< Medio lado de la caja.
+		float nearDepth = 0.0f;     ///< Planos de la caja, en distancia a lo largo de la luz.
+		float farDepth = 0.0f;
+		float split = 0.0f;
+	};
+
+	Cascade m_cascades[kCascades];
+	Mat4 m_lightView;
+	sf::Vector3f m_direction;
+	uint64_t m_staticKey = 0;
+	uint32_t m_valid = 0;          ///< Un bit por cascada con caja.
+	float m_maxDistance = 2000.0f;
+	float m_splitBlend = 0.75f;
+	uint64_t m_rebuilds = 0;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/StreamBuffer.h"
+
+class RenderCommandBuffer;
+struct DrawCommand;
+
+/**
+ * @class ShapeBatcher
+ * @brief Dibuja los comandos de un frame juntando figuras vecinas en un solo arreglo de vrtices.
+ *
+ * Cada `sf::Shape` dibujada por separado es un draw call y un cambio de estado de GL. Aqu,
+ * en el orden de `RenderCommandBuffer::sort`, las figuras seguidas con la misma textura, shader
+ * y mezcla se triangulan en CPU con su matriz de mundo ya aplicada y se envan juntas con un
+ * solo `draw` de tringulos. El orden de dibujo no cambia: un comando que no se puede juntar
+ * (no es figura, o tiene contorno) cierra el lote en curso y se dibuja solo.
+ *
+ * El arreglo de vrtices conserva su capacidad entre frames. Con `setStreaming`, los lotes sin
+ * textura ni shader y los arreglos de tringulos sueltos (las partculas de `ParticleSystem`)
+ * se escriben en un `StreamBuffer` y se dibujan con un shader propio, en vez de que SFML los
+ * copie desde la memoria del proceso en cada draw.
+ */
+class
+ShapeBatcher {
+public:
+	/**
+	 * @brief Ordena `commands` y los dibuja en `target`.
+	 */
+	void
+	submit(sf::RenderTarget& target, RenderCommandBuffer& commands);
+
+	/**
+	 * @brief Envo por partes, para quien recorre los comandos por su cuenta: `begin`, un `add`
+	 *        por comando en orden de dibujo y `end` (que dibuja el ltimo lote). `end` tambin
+	 *        sirve para cerrar el lote en curso antes de dibujar algo por fuera.
+	 */
+	void
+	begin();
+
+	void
+	add(sf::RenderTarget& target, const DrawCommand& command);
+
+	void
+	end(sf::RenderTarget& target) { flush(target); }
+
+	/**
+	 * @brief Con `false`, cada comando se dibuja solo (para comparar).
+	 */
+	void
+	setEnabled(bool enabled) { m_enabled = enabled; }
+
+	bool
+	isEnabled() const { return m_enabled; }
+
+	/**
+	 * @brief Activa o libera el camino por `StreamBuffer`. El contexto de destino debe estar
+	 *        activo, tambin para apagarlo.
+	 * @return `false` si el contexto no soporta OpenGL 3.3; se sigue dibujando con SFML.
+	 */
+	bool
+	setStreaming(bool enabled);
+
+	bool
+	isStreaming() const { return m_program != 0; }
+
+	/**
+	 * @brief Draw calls del ltimo `submit`.
+	 */
+	size_t
+	drawCalls() const { return m_drawCalls; }
+
+	/**
+	 * @brief Figuras que entraron en algn lote en el ltimo `submit`.
+	 */
+	size_t
+	batchedShapes() const { return m_batchedShapes; }
+
+	/**
+	 * @brief Agrega los tringulos de `command` (una figura sin contorno) al lote en curso.
+	 */
+	void
+	append(const DrawCommand& command);
+
+	/**
+	 * @brief Descarta el lote en curso sin dibujarlo.
+	 */
+	void
+	clear() { m_vertices.clear(); }
+
+	/**
+	 * @brief Vrtices del lote en curso.
+	 */
+	const std::vector<sf::Vertex>&
+	vertices() const { return m_vertices; }
+
+	/**
+	 * @brief Indica si `command` puede ir en un lote.
+	 */
+	static bool
+	isBatchable(const DrawCommand& command);
+
+private:
+	/**
+	 * @brief Dibuja el lote en curso, si hay, y lo vaca.
+	 */
+	void
+	flush(sf::RenderTarget& target);
+
+	/**
+	 * @brief Escribe `count` vrtices (tringulos sin textura, mezcla alfa) en `m_stream` y los
+	 *        dibuja con `transform`.
+	 */
+	void
+	drawStreamed(sf::RenderTarget& target, const sf::Vertex* vertices, size_t count, const sf::Transform& transform);
+
+	std::vector<sf::Vertex> m_vertices;        ///< Tringulos del lote en curso, en coordenadas de mundo.
+	std::vector<sf::Vector2f> m_points;        ///< Puntos de una figura sin `outline` precalculado.
+	const sf::Texture* m_batchTexture = nullptr; ///< Textura del lote en curso.
+	const sf::Shader* m_batchShader = nullptr;   ///< Shader del lote en curso.
+	sf::BlendMode m_batchBlendMode = sf::BlendAlpha;
+	size_t m_drawCalls = 0;
+	size_t m_batchedShapes = 0;
+	bool m_enabled = true;
+	StreamBuffer m_stream;                     ///< Vrtices del frame, en anillo; solo con `setStreaming`.
+	uint32_t m_program = 0;
+	uint32_t m_vertexArray = 0;
+	int32_t m_viewLocation = -1;
+};
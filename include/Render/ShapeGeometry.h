@@ -0,0 +1,64 @@
+#pragma once
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include "Prerequisites.h"
+
+/**
+ * @brief Geometra de una figura compartida por todas las del mismo tipo, tamao y textura.
+ *
+ * No cambia ni se destruye mientras exista `ShapeGeometryLibrary`: quien la dibuja pone su
+ * propia matriz y color (`RenderCommandBuffer::drawShared`).
+ */
+struct ShapeGeometry {
+	const sf::Shape* shape = nullptr;       ///< Blanca, sin contorno y con la matriz identidad.
+	std::span<const sf::Vector2f> outline;  ///< Puntos locales de `shape`, en su orden.
+};
+
+/**
+ * @class ShapeGeometryLibrary
+ * @brief Figuras inmutables de `ShapeFactory`, una por tipo, tamao y textura (flyweights).
+ *
+ * Cada componente guardaba su `sf::CircleShape` y su `sf::RectangleShape`, con su arreglo de
+ * vrtices en el heap, aunque mil actores tuvieran el mismo crculo. Aqu hay una por clave,
+ * creada la primera vez que se pide; los puntos salen de las tablas de `Math/UnitShapes.h`.
+ * Los niveles de detalle de los crculos siguen siendo contornos compartidos de
+ * `ShapeFactory`: el `sf::CircleShape` de 30 puntos es el mismo para todos.
+ *
+ * Buscar toma un candado: se hace al crear la figura o cambiarle la textura, no por frame.
+ * Es un servicio (`TService<ShapeGeometryLibrary>`).
+ */
+class
+ShapeGeometryLibrary {
+public:
+	/**
+	 * @brief La geometra de `type`, crendola si hace falta.
+	 * @param size Radio en `x` para crculos y tringulos; ancho y alto para rectngulos.
+	 * @param pointCount Puntos de crculos y tringulos; debe tener tabla en `UnitShapes::polygon`.
+	 * @param texture Textura estirada sobre la caja de la figura, o nula.
+	 * @return Nulo para `EMPTY` o un nmero de puntos sin tabla.
+	 */
+	const ShapeGeometry*
+	find(ShapeType type, const sf::Vector2f& size, size_t pointCount, const sf::Texture* texture);
+
+	/**
+	 * @brief Geometras distintas creadas hasta ahora.
+	 */
+	size_t
+	size() const;
+
+private:
+	struct Entry {
+		ShapeType type;
+		sf::Vector2f size;
+		size_t pointCount;
+		const sf::Texture* texture;
+		std::unique_ptr<sf::Shape> shape;
+		std::vector<sf::Vector2f> points;
+		ShapeGeometry geometry;
+	};
+
+	std::deque<Entry> m_entries;            ///< `deque`: las direcciones no cambian al crecer.
+	mutable std::mutex m_mutex;
+};
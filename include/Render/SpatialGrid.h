@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+
+class Entity;
+
+/**
+ * @brief Posicin de una entidad en el `SpatialGrid`; componente de datos que el grid agrega
+ *        al registrarla, para encontrarla desde las filas del `World`.
+ */
+struct SpatialItem {
+	uint32_t index = 0;
+};
+
+/**
+ * @class SpatialGrid
+ * @brief Cuadrcula uniforme con las cajas de las entidades activas, para dibujar solo lo que
+ *        cae dentro de la vista.
+ *
+ * `ActiveEntities` registra aqu cada entidad que se activa y la quita al desactivarse. Al
+ * principio no tiene caja y se considera siempre visible; `updateBounds` le pone la caja de
+ * mundo de su figura y la reparte en las celdas que toca. El sistema `SpatialIndex` de
+ * `BaseApp` lo llama solo para las entidades cuyo `Transform` o `ShapeFactory` cambiaron
+ * (`WorldView::eachChanged`), as que lo que no se mueve no cuesta nada.
+ *
+ * `query` junta las celdas que toca un rectngulo y revisa las cajas ah, ms las entidades
+ * sin caja. Las cajas demasiado grandes para repartirse (ms de `kMaxCellsPerItem` celdas) van
+ * a una lista aparte que se revisa completa.
+ *
+ * `queryPoint`, `pickPoint` y `queryArea` son para elegir con el mouse: no devuelven las entidades sin caja
+ * y no marcan nada, as que varios hilos pueden llamarlas a la vez mientras nadie registre ni
+ * actualice cajas. Un solo hilo para lo dems: registrar y actualizar son cambios
+ * estructurales de la escena. Si solo se mueve
+ * el padre de un `Transform`, la caja del hijo no se actualiza sola: hay que marcar el hijo.
+ *
+ * Es un servicio (`TService<SpatialGrid>`).
+ */
+class
+SpatialGrid {
+public:
+	static constexpr float kDefaultCellSize = 128.0f;  ///< Unidades de mundo por celda.
+	static constexpr uint32_t kMaxCellsPerItem = 64;   ///< Ms que esto va a la lista de grandes.
+
+	explicit
+	SpatialGrid(float cellSize = kDefaultCellSize) : m_cellSize(cellSize) {}
+
+	/**
+	 * @brief Registra `entity` sin caja (siempre visible) y le agrega su `SpatialItem`.
+	 */
+	void
+	insert(Entity& entity);
+
+	/**
+	 * @brief Saca a `entity` y le quita su `SpatialItem`.
+	 */
+	void
+	remove(Entity& entity);
+
+	/**
+	 * @brief Nueva caja de mundo de la entidad `item`; una caja vaca la deja siempre visible.
+	 */
+	void
+	updateBounds(SpatialItem item, const sf::FloatRect& bounds);
+
+	/**
+	 * @brief Agrega a `out` las entidades cuya caja toca `area` y las que no tienen caja, cada
+	 *        una una vez y sin orden. No vaca `out`.
+	 */
+	void
+	query(const sf::FloatRect& area, std::vector<Entity*>& out) { query(std::span<const sf::FloatRect>(&area, 1), out); }
+
+	/**
+	 * @brief Igual con varias reas, las de varias vistas: cada entidad sale una vez aunque
+	 *        toque ms de una, y una caja en las celdas donde las reas se pisan se revisa una
+	 *        sola vez.
+	 */
+	void
+	query(std::span<const sf::FloatRect> areas, std::vector<Entity*>& out);
+
+	/**
+	 * @brief Agrega a `out` las entidades con caja que contiene `point`. No vaca `out`.
+	 */
+	void
+	queryPoint(const sf::Vector2f& point, std::vector<Entity*>& out) const;
+
+	/**
+	 * @brief La entidad de caja ms chica que contiene `point`, la ms precisa bajo el mouse;
+	 *        nulo si ninguna.
+	 */
+	Entity*
+	pickPoint(const sf::Vector2f& point) const;
+
+	/**
+	 * @brief Agrega a `out` las entidades con caja que toca `area`, cada una una vez. Una caja
+	 *        en varias celdas sale solo desde la primera que comparte con `area`.
+	 */
+	void
+	queryArea(const sf::FloatRect& area, std::vector<Entity*>& out) const;
+
+	size_t
+	size() const { return m_items.size(); }
+
+	/**
+	 * @brief Entidades sin caja, que `query` siempre devuelve.
+	 */
+	size_t
+	unboundedCount() const { return m_unbounded.size(); }
+
+private:
+	/**
+	 * @brief Dnde vive una entidad del grid.
+	 */
+	enum class Placement : uint8_t {
+		Unbounded,  ///< En `m_unbounded`.
+		Cells,      ///< En las celdas `[x0, x1] x [y0, y1]`.
+		Large,      ///< En `m_large`.
+	};
+
+	struct Item {
+		Entity* entity = nullptr;
+		sf::FloatRect bounds;
+		int32_t x0 = 0, y0 = 0, x1 = -1, y1 = -1;  ///< Celdas que ocupa, si `Cells`.
+		uint32_t listIndex = 0;                    ///< Posicin en `m_unbounded` o `m_large`.
+		uint32_t queryStamp = 0;                   ///< ltimo `query` que la devolvi.
+		Placement placement = Placement::Unbounded;
+	};
+
+	static uint64_t
+	cellKey(int32_t x, int32_t y) { return (uint64_t(uint32_t(x)) << 32) | uint32_t(y); }
+
+	int32_t
+	cellOf(float coordinate) const { return static_cast<int32_t>(std::floor(coordinate / m_cellSize)); }
+
+	/**
+	 * @brief Saca el item `index` de donde est (celdas o listas), sin borrarlo.
+	 */
+	void
+	unplace(uint32_t index);
+
+	/**
+	 * @brief Pone el item `index` donde corresponde a su caja.
+	 */
+	void
+	place(uint32_t index);
+
+	static void
+	eraseFromList(std::vector<uint32_t>& list, std::vector<Item>& items, uint32_t listIndex);
+
+	float m_cellSize;
+	std::vector<Item> m_items;                                   ///< Densa, como `ActiveEntities`.
+	std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells; ///< Items por celda; las celdas vacas se conservan.
+	std::vector<uint32_t> m_unbounded;                           ///< Items sin caja.
+	std::vector<uint32_t> m_large;                               ///< Items que tocan demasiadas celdas.
+	uint32_t m_queryStamp = 0;
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <vector>
+#include "Prerequisites.h"
+#include "Render/ShapeBatcher.h"
+
+class ShapeFactory;
+
+/**
+ * @class StaticGeometryCache
+ * @brief Figuras que no se mueven, horneadas una vez en bferes de vrtices de la GPU.
+ *
+ * Fondos, decorado y geometra de nivel no cambian de un frame a otro, pero dibujarlas como
+ * cualquier figura las vuelve a triangular cada frame. Una figura marcada con
+ * `ShapeFactory::setStatic` deja de grabar comandos: solo avisa en su `render` que sigue
+ * visible, y la cach dibuja todas las estticas con un `sf::VertexBuffer` (`Static`) por
+ * textura, antes de los comandos del frame (debajo de todo).
+ *
+ * Los bferes se vuelven a subir solo cuando cambia el conjunto: una figura entra o sale,
+ * su actor se activa o desactiva, cambia la figura (`getChangeTick`) o su matriz de mundo
+ * (tambin si se mueve un padre). Revisarlo cuesta unas lecturas por figura, sin tocar
+ * vrtices. Sin soporte de bferes de vrtices en el driver, se dibujan desde memoria.
+ *
+ * Un solo hilo. Es un servicio (`TService<StaticGeometryCache>`).
+ */
+class
+StaticGeometryCache {
+public:
+	/**
+	 * @brief Agrega `shape`. La llama `ShapeFactory::setStatic`.
+	 * @return `false` si la figura no puede hornearse (tiene contorno); se sigue dibujando normal.
+	 */
+	bool
+	add(ShapeFactory& shape);
+
+	/**
+	 * @brief Quita `shape`, si estaba.
+	 */
+	void
+	remove(ShapeFactory& shape);
+
+	/**
+	 * @brief La figura se dibuja este frame. La llama `ShapeFactory::render`.
+	 */
+	void
+	markVisible(const ShapeFactory& shape);
+
+	/**
+	 * @brief Hornea de nuevo en el prximo `draw` aunque nada parezca cambiado.
+	 */
+	void
+	invalidate() { m_dirty = true; }
+
+	/**
+	 * @brief Triangula de nuevo en CPU si algo cambi; la subida a la GPU queda para `draw`.
+	 *
+	 * Lee las figuras, as que va en el hilo de la simulacin: `RenderThread` la llama al cerrar
+	 * cada frame, antes de pasarlo al hilo de render. Sin llamarla la hace `draw`.
+	 */
+	void
+	prepare();
+
+	/**
+	 * @brief Dibuja las figuras estticas visibles este frame, horneando antes si cambiaron.
+	 */
+	void
+	draw(sf::RenderTarget& target);
+
+	size_t
+	size() const { return m_entries.size(); }
+
+	/**
+	 * @brief Veces que se hornearon los bferes, para comprobar que no pasa cada frame.
+	 */
+	size_t
+	bakeCount() const { return m_bakes; }
+
+private:
+	static constexpr uint32_t kNotStatic = UINT32_MAX; ///< ndice de una figura que no est.
+
+	/**
+	 * @brief Una figura y lo que se saba de ella al hornear.
+	 */
+	struct Entry {
+		ShapeFactory* shape = nullptr;
+		uint32_t visibleFrame = 0;     ///< ltimo frame en que su `render` avis.
+		uint32_t worldVersion = 0;     ///< Versin de la matriz de mundo horneada.
+		bool baked = false;            ///< Est en los bferes actuales.
+	};
+
+	/**
+	 * @brief Vrtices de una textura.
+	 */
+	struct Batch {
+		const sf::Texture* texture = nullptr;
+		sf::VertexBuffer buffer{ sf::Triangles, sf::VertexBuffer::Static };
+		std::vector<sf::Vertex> vertices;  ///< Triangulados por `bake`; se dibujan de aqu sin `sf::VertexBuffer::isAvailable()`.
+		size_t vertexCount = 0;
+		bool uploaded = false;             ///< `buffer` tiene `vertices`.
+	};
+
+	/**
+	 * @brief Indica si algo cambi desde el ltimo horneado.
+	 */
+	bool
+	needsBake() const;
+
+	/**
+	 * @brief Vuelve a triangular las figuras visibles y sube los bferes.
+	 */
+	void
+	bake();
+
+	std::vector<Entry> m_entries;  ///< Densa; cada figura guarda su posicin.
+	std::vector<Batch> m_batches;  ///< Uno por textura; conservan su bfer entre horneados.
+	ShapeBatcher m_tessellator;    ///< Solo para triangular: no dibuja.
+	uint32_t m_frame = 1;          ///< Frame actual; sube en cada `draw`.
+	uint32_t m_bakedTick = 0;      ///< Tick de cambio al hornear (`ChangeTick.h`).
+	size_t m_bakes = 0;
+	bool m_dirty = false;          ///< Entr o sali una figura.
+	bool m_prepared = false;       ///< `prepare` ya corri este frame.
+};
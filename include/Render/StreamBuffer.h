@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Prerequisites.h"
+
+struct GlSyncObject;
+
+/**
+ * @class StreamBuffer
+ * @brief Bfer de vrtices para lo que se vuelve a subir cada frame, repartido como anillo en
+ *        tres regiones.
+ *
+ * Subir con `glBufferData` cada frame deja al driver hurfano el bfer anterior o, si no puede,
+ * esperando a que la GPU termine de leerlo. Aqu cada `write` copia a la regin en curso, a
+ * continuacin de lo anterior, y `beginFrame` la cierra con un fence y pasa a la siguiente: la
+ * CPU escribe un frame mientras la GPU lee los dos anteriores, y solo espera si va tres por
+ * delante. Con `ARB_buffer_storage` el bfer queda mapeado para siempre (persistente y
+ * coherente) y `write` es una copia a memoria que la GPU ve; si no, cada `write` mapea su rango
+ * sin sincronizar, que los fences ya cubren.
+ *
+ * Si un `write` no entra en lo que queda de la regin, se pasa antes a la siguiente; si no
+ * entra en una regin vaca, el bfer se recrea con regiones ms grandes. Lo escrito vale hasta
+ * el draw que lo usa: el desplazamiento es del bfer actual. Un solo hilo, el del contexto.
+ */
+class
+StreamBuffer {
+public:
+	static constexpr uint32_t kRegionCount = 3;
+
+	/**
+	 * @param regionBytes Tamao inicial de cada regin.
+	 */
+	explicit StreamBuffer(size_t regionBytes = size_t(1) << 20) : m_regionBytes(regionBytes) {}
+
+	~StreamBuffer() = default;
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	/**
+	 * @brief Crea el bfer. Despus de `loadGlFunctions`, con el contexto activo.
+	 */
+	bool
+	initialize();
+
+	bool
+	isInitialized() const { return m_buffer != 0; }
+
+	/**
+	 * @brief Libera el bfer y los fences. Debe llamarse con el contexto todava vivo.
+	 */
+	void
+	release();
+
+	/**
+	 * @brief Cierra la regin del frame anterior, si se escribi algo, y pasa a la siguiente.
+	 */
+	void
+	beginFrame();
+
+	/**
+	 * @brief Copia `bytes` de `data` al bfer, que queda enlazado a `GL_ARRAY_BUFFER`.
+	 * @return Desplazamiento de la copia en el bfer, para `glVertexAttribPointer`.
+	 */
+	size_t
+	write(const void* data, size_t bytes);
+
+	uint32_t
+	buffer() const { return m_buffer; }
+
+	/**
+	 * @brief `true` si el bfer est mapeado para siempre.
+	 */
+	bool
+	isPersistent() const { return m_mapped != nullptr; }
+
+	size_t
+	regionBytes() const { return m_regionBytes; }
+
+	/**
+	 * @brief Veces que `beginFrame` o `write` tuvieron que esperar a la GPU.
+	 */
+	uint64_t
+	stalls() const { return m_stalls; }
+
+private:
+	/**
+	 * @brief Crea el bfer con el tamao actual de regin.
+	 */
+	bool
+	allocate();
+
+	/**
+	 * @brief Borra el bfer y los fences.
+	 */
+	void
+	destroy();
+
+	/**
+	 * @brief Pone un fence en la regin en curso y espera el de la siguiente.
+	 */
+	void
+	advance();
+
+	uint32_t m_buffer = 0;
+	uint8_t* m_mapped = nullptr;                     ///< Todo el bfer, si es persistente.
+	GlSyncObject* m_fences[kRegionCount] = {};       ///< Lectura pendiente de cada regin.
+	size_t m_regionBytes;
+	size_t m_used = 0;                               ///< Lo escrito en la regin en curso.
+	uint32_t m_region = 0;
+	uint64_t m_stalls = 0;
+};
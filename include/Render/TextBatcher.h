@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Prerequisites.h"
+
+/**
+ * @class TextBatcher
+ * @brief Texto de HUD y depuracin: los glifos de un atlas por tamao y todas las cadenas del
+ *        frame en un solo arreglo de vrtices por tamao.
+ *
+ * Cada `sf::Text` vuelve a maquetar su cadena al cambiar y se dibuja con su propio draw call.
+ * Aqu `prepare` rasteriza de antemano los glifos ASCII de un tamao en la textura de ese
+ * tamao de la fuente (el atlas que mantiene SFML), y `add` escribe los quads de cada cadena,
+ * ya en su posicin y color, en el lote de su tamao; `draw` enva cada lote con un draw. Las
+ * cadenas fijas se maquetan una vez con `cacheLayout` y despus solo se copian desplazadas.
+ *
+ * El texto viene en UTF-8. La fuente debe vivir mientras se use. Un solo hilo, el que dibuja.
+ */
+class
+TextBatcher {
+public:
+	using LayoutId = uint32_t;
+
+	static constexpr char32_t kFirstPreparedGlyph = 32;
+	static constexpr char32_t kLastPreparedGlyph = 126;
+
+	TextBatcher() = default;
+
+	explicit TextBatcher(const sf::Font& font) : m_font(&font) {}
+
+	/**
+	 * @brief Cambia la fuente; las maquetaciones guardadas dejan de valer y se descartan.
+	 */
+	void
+	setFont(const sf::Font& font);
+
+	const sf::Font*
+	font() const { return m_font; }
+
+	/**
+	 * @brief Rasteriza los glifos ASCII de `characterSize`, para que el primer frame que los
+	 *        usa no lo haga a mitad de camino.
+	 */
+	void
+	prepare(unsigned int characterSize);
+
+	/**
+	 * @brief Maqueta `text` una vez y la guarda; `add(id, ...)` la dibuja sin volver a hacerlo.
+	 */
+	LayoutId
+	cacheLayout(std::string_view text, unsigned int characterSize);
+
+	/**
+	 * @brief Cambia el texto de una maquetacin guardada (mismo tamao).
+	 */
+	void
+	updateLayout(LayoutId layout, std::string_view text);
+
+	/**
+	 * @brief Agrega `text` con su esquina superior izquierda en `position`.
+	 */
+	void
+	add(std::string_view text, unsigned int characterSize, const sf::Vector2f& position, sf::Color color);
+
+	/**
+	 * @brief Agrega una maquetacin guardada.
+	 */
+	void
+	add(LayoutId layout, const sf::Vector2f& position, sf::Color color);
+
+	/**
+	 * @brief Tamao en pxeles de `text` maquetado (ancho de la lnea ms larga, alto de las lneas).
+	 */
+	sf::Vector2f
+	measure(std::string_view text, unsigned int characterSize) const;
+
+	/**
+	 * @brief Dibuja los lotes en `target` con su vista actual y los vaca.
+	 */
+	void
+	draw(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	/**
+	 * @brief Draw calls del ltimo `draw`: uno por tamao usado.
+	 */
+	size_t
+	drawCalls() const { return m_drawCalls; }
+
+private:
+	/**
+	 * @brief Quads de una cadena, en blanco y relativos a su esquina.
+	 */
+	struct Layout {
+		unsigned int characterSize = 0;
+		std::vector<sf::Vertex> vertices;
+	};
+
+	/**
+	 * @brief Vrtices del frame de un tamao, que comparten textura.
+	 */
+	struct Batch {
+		unsigned int characterSize = 0;
+		std::vector<sf::Vertex> vertices;   ///< Conserva su capacidad entre frames.
+	};
+
+	/**
+	 * @brief Escribe los quads de `text` en `out`, con la esquina en `origin`.
+	 * @return Ancho y alto de lo maquetado.
+	 */
+	sf::Vector2f
+	layout(std::string_view text, unsigned int characterSize, const sf::Vector2f& origin, sf::Color color,
+		std::vector<sf::Vertex>* out) const;
+
+	Batch&
+	batchFor(unsigned int characterSize);
+
+	const sf::Font* m_font = nullptr;
+	std::vector<Layout> m_layouts;
+	std::vector<Batch> m_batches;
+	size_t m_drawCalls = 0;
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+
+/**
+ * @brief Dnde qued una imagen dentro de un `TextureAtlas`.
+ */
+struct AtlasRegion {
+	const sf::Texture* texture = nullptr; ///< Pgina del atlas; nula si la imagen no entr.
+	sf::IntRect rect;                     ///< En pxeles de la pgina, sin el borde.
+};
+
+/**
+ * @class TextureAtlas
+ * @brief Junta muchas imgenes chicas en unas pocas texturas grandes (pginas), para que los
+ *        sprites que comparten pgina se dibujen en un solo lote.
+ *
+ * `add` encola una imagen y devuelve su id enseguida; `build` acomoda las pendientes, de la ms
+ * alta a la ms baja, con un horizonte (skyline) por pgina: cada imagen va en el punto ms
+ * bajo, y a igual altura el ms a la izquierda, donde cabe sobre el perfil de lo ya puesto. Si
+ * no cabe en ninguna pgina abre otra de `pageSize` por lado. Se puede volver a llamar con
+ * imgenes nuevas: las ya puestas no se mueven.
+ *
+ * Cada imagen lleva alrededor un borde de `max(padding, 2^mipLevels)` pxeles con sus propios
+ * bordes estirados hacia afuera, y empieza en un mltiplo de `2^mipLevels`: el filtro lineal y
+ * los mipmaps hasta ese nivel mezclan solo pxeles de la misma imagen, nunca de la vecina.
+ * Con `mipLevels` mayor que 0 las pginas generan sus mipmaps al terminar `build`.
+ *
+ * `build` sube a la GPU: va en el hilo que tiene el contexto. Las pginas no cambian de
+ * direccin mientras viva el atlas, as que los sprites pueden guardar la regin.
+ */
+class
+TextureAtlas {
+public:
+	static constexpr uint32_t kInvalidRegion = 0xFFFFFFFFu;
+
+	struct Settings {
+		uint32_t pageSize = 2048;  ///< Lado de cada pgina, en pxeles.
+		uint32_t padding = 1;      ///< Borde mnimo alrededor de cada imagen.
+		uint32_t mipLevels = 0;    ///< Niveles de mipmap que no deben mezclar imgenes.
+		bool smooth = true;
+	};
+
+	TextureAtlas() = default;
+
+	explicit TextureAtlas(const Settings& settings) : m_settings(settings) {}
+
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	/**
+	 * @brief Encola una imagen para el prximo `build`. Un nombre repetido devuelve el id de la
+	 *        primera y descarta la nueva.
+	 */
+	uint32_t
+	add(std::string_view name, const sf::Image& image);
+
+	/**
+	 * @brief Como `add`, leyendo `path`; el nombre es la ruta. `kInvalidRegion` si no se pudo leer.
+	 */
+	uint32_t
+	addFile(const std::string& path);
+
+	/**
+	 * @brief Acomoda y sube las imgenes pendientes.
+	 * @return `false` si alguna no entra ni en una pgina vaca; esa queda sin textura.
+	 */
+	bool
+	build();
+
+	/**
+	 * @brief Id de la imagen `name`, o `kInvalidRegion`.
+	 */
+	uint32_t
+	find(std::string_view name) const;
+
+	/**
+	 * @brief Regin de `id`; sin textura si no existe o an no pas por `build`.
+	 */
+	const AtlasRegion&
+	region(uint32_t id) const { return id < m_regions.size() ? m_regions[id] : m_missing; }
+
+	size_t
+	regionCount() const { return m_regions.size(); }
+
+	size_t
+	pageCount() const { return m_pages.size(); }
+
+	const sf::Texture&
+	page(size_t index) const { return m_pages[index].texture; }
+
+	/**
+	 * @brief Fraccin del rea de las pginas ocupada por imgenes y sus bordes.
+	 */
+	float
+	occupancy() const;
+
+	const Settings&
+	settings() const { return m_settings; }
+
+private:
+	struct Segment {
+		uint32_t x = 0;
+		uint32_t y = 0;      ///< Altura del perfil sobre este tramo.
+		uint32_t width = 0;
+	};
+
+	struct Page {
+		sf::Texture texture;
+		std::vector<Segment> skyline;
+		uint64_t usedArea = 0;
+	};
+
+	struct Pending {
+		uint32_t id = 0;
+		sf::Image image;
+	};
+
+	/**
+	 * @brief Borde por lado y alineacin de las posiciones, segn `padding` y `mipLevels`.
+	 */
+	uint32_t
+	border() const;
+
+	uint32_t
+	alignment() const { return 1u << m_settings.mipLevels; }
+
+	/**
+	 * @brief Mejor lugar para un rectngulo de `width` x `height` en `page`.
+	 * @return ndice del segmento donde empieza, o -1 si no cabe; `outY` es su altura.
+	 */
+	int
+	findPosition(const Page& page, uint32_t width, uint32_t height, uint32_t& outY) const;
+
+	/**
+	 * @brief Sube el perfil de `page` sobre `[x, x + width)` hasta `top`.
+	 */
+	static void
+	placeSegment(Page& page, size_t index, uint32_t width, uint32_t top);
+
+	/**
+	 * @brief Copia `image` con su borde estirado a `page`, con la esquina del borde en `(x, y)`.
+	 */
+	void
+	upload(Page& page, const sf::Image& image, uint32_t x, uint32_t y);
+
+	Settings m_settings;
+	std::deque<Page> m_pages;              ///< Deque: las texturas no cambian de direccin.
+	std::vector<AtlasRegion> m_regions;
+	std::vector<Pending> m_pending;
+	std::unordered_map<std::string, uint32_t> m_names;
+	AtlasRegion m_missing;
+};
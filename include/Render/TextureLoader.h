@@ -0,0 +1,217 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+#include "Jobs/JobSystem.h"
+#include "Render/CompressedTexture.h"
+#include "Scene/PackFile.h"
+
+/**
+ * @class TextureLoader
+ * @brief Carga texturas sin frenar el bucle principal: decodifica en los hilos de `JobSystem`
+ *        y sube a la GPU en el hilo de render, unos cuantos bytes por frame.
+ *
+ * `load` devuelve enseguida una textura de direccin estable y lanza un trabajo que decodifica
+ * el archivo (`sf::Image::loadFromFile`); un `.dds` en bloques BC1/BC3/BC7 solo se lee
+ * (`CompressedTexture`) y se sube de una vez, que ya son de 4 a 8 veces menos bytes. Las
+ * decodificadas esperan en una cola que
+ * `uploadPending` vaca al inicio de cada `Window::submit`, en el hilo dueo del contexto:
+ * copia filas a una textura aparte hasta gastar `uploadBudget` bytes y, cuando la imagen est
+ * completa, la intercambia (`sf::Texture::swap`) con la que ya tienen las figuras. Hasta
+ * entonces se ve un damero de `kPlaceholderSize` pxeles, as que un nivel lleno de texturas
+ * aparece en unos frames en vez de congelar la ventana varios segundos.
+ *
+ * Los contextos de SFML comparten sus objetos, as que la textura subida en el hilo de render
+ * sirve en cualquier otro. El rectngulo de textura de una figura se toma del tamao del
+ * momento: si se asigna antes de `isReady`, hay que darle uno explcito
+ * (`sf::Shape::setTextureRect`).
+ *
+ * `reload` vuelve a leer el archivo de una textura ya cargada: las figuras siguen viendo la
+ * imagen anterior hasta que la nueva est subida, y entonces cambia en el mismo objeto.
+ *
+ * Para el presupuesto de memoria (`AssetManager`): `release` devuelve una textura al damero y
+ * el prximo `load` la vuelve a leer; `dropLevel` la vuelve a subir sin su mipmap ms grande,
+ * un cuarto de la memoria, y `setDroppedLevels` hace lo mismo con las cargas nuevas. Solo los
+ * `.dds` tienen mipmaps que soltar. `residentBytes` cuenta lo subido a la GPU.
+ *
+ * `load`, `reload`, `release`, `dropLevel`, `isReady` y `finishAll` van en el hilo principal;
+ * `uploadPending`, en el de render.
+ * Es un servicio (`TService<TextureLoader>`).
+ */
+class
+TextureLoader {
+public:
+	static constexpr size_t kDefaultUploadBudget = 8u << 20; ///< Bytes por frame: media textura de 2048 RGBA.
+	static constexpr unsigned int kPlaceholderSize = 2;
+
+	TextureLoader() : m_jobs(EngineUtilities::TService<JobSystem>::instance()) {}
+
+	/**
+	 * @brief Espera las decodificaciones en curso: sus trabajos escriben en este objeto.
+	 */
+	~TextureLoader();
+
+	TextureLoader(const TextureLoader&) = delete;
+	TextureLoader& operator=(const TextureLoader&) = delete;
+
+	/**
+	 * @brief Empieza a cargar `path`; pedir otra vez la misma ruta devuelve la misma textura.
+	 * @return Textura que vive lo que este objeto; muestra el damero hasta `isReady`.
+	 */
+	const sf::Texture*
+	load(const std::string& path);
+
+	/**
+	 * @brief Vuelve a leer `path`, que cambi en disco; la textura es la misma de `load`.
+	 * @return `false` si nunca se carg o su carga anterior no ha terminado: hay que pedirlo
+	 *         otra vez ms tarde.
+	 */
+	bool
+	reload(const std::string& path);
+
+	/**
+	 * @brief Deja el damero en la textura de `path` y suelta su imagen de la GPU; el prximo
+	 *        `load` la vuelve a leer en el mismo objeto.
+	 * @return `false` si nunca se carg, ya estaba suelta o su carga no ha terminado.
+	 */
+	bool
+	release(const std::string& path);
+
+	/**
+	 * @brief Vuelve a cargar `path` con un mipmap grande menos; se sigue viendo como est
+	 *        hasta que termina.
+	 * @return `false` si no est lista o le queda un solo nivel (no es un `.dds` con mipmaps).
+	 */
+	bool
+	dropLevel(const std::string& path);
+
+	/**
+	 * @brief Mipmaps grandes que se saltan las cargas nuevas de un `.dds`; las que ya estn
+	 *        no cambian.
+	 */
+	void
+	setDroppedLevels(unsigned int levels) { m_droppedLevels = levels; }
+
+	unsigned int
+	droppedLevels() const { return m_droppedLevels; }
+
+	/**
+	 * @brief Con `true` solo lee `.dds`: otra imagen se queda con el damero en vez de
+	 *        decodificarse aqu (`BaseApp::setCookedOnly`). Antes de los `load` a los que aplica.
+	 */
+	void
+	setCookedOnly(bool cookedOnly) { m_cookedOnly = cookedOnly; }
+
+	/**
+	 * @brief Memoria de video de la imagen de `path`; 0 si no est cargada.
+	 */
+	size_t
+	bytes(const std::string& path) const;
+
+	/**
+	 * @brief Memoria de video de todas las imgenes subidas; el damero no cuenta.
+	 */
+	size_t
+	residentBytes() const { return m_residentBytes.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Indica si `texture` ya tiene la imagen de su archivo.
+	 */
+	bool
+	isReady(const sf::Texture* texture) const;
+
+	/**
+	 * @brief Indica si `texture` se qued con el damero porque su archivo no pudo leerse.
+	 */
+	bool
+	hasFailed(const sf::Texture* texture) const;
+
+	/**
+	 * @brief Texturas todava no subidas, incluidas las que no han terminado de decodificarse.
+	 */
+	size_t
+	pendingCount() const { return m_pendingCount.load(std::memory_order_relaxed); }
+
+	void
+	setUploadBudget(size_t bytes) { m_uploadBudget = bytes; }
+
+	size_t
+	uploadBudget() const { return m_uploadBudget; }
+
+	/**
+	 * @brief Pone el damero a las texturas nuevas y sube las decodificadas, hasta gastar
+	 *        `uploadBudget` bytes (al menos una fila). En el hilo del contexto de la ventana.
+	 * @return Bytes subidos.
+	 */
+	size_t
+	uploadPending();
+
+	/**
+	 * @brief Espera todas las decodificaciones y las sube sin lmite. En el hilo del contexto,
+	 *        sin `RenderThread` corriendo.
+	 */
+	void
+	finishAll();
+
+private:
+	/**
+	 * @brief Una textura. `texture` y `staging` solo los toca el hilo de render; `image` la
+	 *        escribe el trabajo antes de pasar la entrada por `m_decoded`.
+	 */
+	struct Entry {
+		std::string path;
+		PackedAsset packed;           ///< En un paquete montado; sin `found`, del disco.
+		sf::Texture texture;          ///< La que tienen las figuras.
+		sf::Texture staging;          ///< Recibe las filas; se intercambia al terminar.
+		sf::Image image;
+		CompressedImage blocks;       ///< En vez de `image`, si el archivo era un `.dds`.
+		unsigned int uploadedRows = 0;
+		unsigned int skipLevels = 0;  ///< Mipmaps grandes que no se suben; del hilo principal.
+		bool decoded = false;         ///< `false` si el archivo no pudo leerse.
+		bool resident = true;         ///< `false` tras `release`; del hilo principal.
+		std::atomic<bool> ready{ false };
+		std::atomic<bool> failed{ false };   ///< Del hilo de render, al descartarla.
+		std::atomic<size_t> bytes{ 0 };      ///< En la GPU, de la ltima imagen completa.
+		std::atomic<uint32_t> levels{ 0 };   ///< Niveles subidos en la ltima imagen completa.
+	};
+
+	/**
+	 * @brief Lanza el trabajo que lee el archivo de `entry` y la pasa a `m_decoded`.
+	 */
+	void
+	decode(Entry* entry);
+
+	/**
+	 * @brief Sube filas de `entry` sin pasar de `budget` bytes.
+	 * @return Bytes subidos; `entry.ready` queda en `true` al completar la imagen.
+	 */
+	size_t
+	uploadRows(Entry& entry, size_t budget);
+
+	/**
+	 * @brief Entrega `entry.staging`, ya completa, a las figuras y suelta lo ledo.
+	 * @param bytes Memoria de video de la imagen nueva; `levels`, sus niveles.
+	 */
+	void
+	complete(Entry& entry, size_t bytes, uint32_t levels);
+
+	JobSystem& m_jobs;
+	JobCounter m_counter;                                        ///< Decodificaciones en curso.
+	std::vector<EngineUtilities::TUniquePtr<Entry>> m_entries;   ///< Todas, para que las direcciones no cambien.
+	std::unordered_map<std::string, Entry*> m_byPath;
+	std::mutex m_queueMutex;
+	std::vector<Entry*> m_created;                               ///< Sin damero todava.
+	std::vector<Entry*> m_decoded;                               ///< Decodificadas que el hilo de render no tom.
+	std::vector<Entry*> m_released;                              ///< De `release`, sin damero todava.
+	std::vector<Entry*> m_uploads;                               ///< Tomadas y sin terminar, en orden; solo el hilo de render.
+	size_t m_uploadFront = 0;                                    ///< Primera de `m_uploads` sin terminar.
+	std::atomic<size_t> m_pendingCount{ 0 };
+	std::atomic<size_t> m_residentBytes{ 0 };
+	size_t m_uploadBudget = kDefaultUploadBudget;
+	unsigned int m_droppedLevels = 0;
+	bool m_cookedOnly = false;
+};
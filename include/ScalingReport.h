@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Partes del frame que `BaseApp::runScalingBenchmark` mide por separado al barrer hilos:
+ *        update completo, movimiento, fsica y armado de la lista de dibujo.
+ */
+constexpr size_t kScalingSystems = 4;
+
+/**
+ * @brief Resultado de una corrida de `BaseApp::runScalingBenchmark` con un nmero de actores.
+ */
+struct ScalingSample {
+	size_t actors = 0;
+	unsigned threads = 0;       ///< Hilos que tomaron trabajo, el principal incluido; 0 sin barrido.
+	uint32_t frames = 0;
+	double updateMs = 0.0;      ///< Promedio de `BaseApp::update`.
+	double renderMs = 0.0;      ///< Promedio de `BaseApp::render`.
+	double gpuMs = 0.0;         ///< Promedio de GPU del frame (`GpuTimer`); 0 si no se midi.
+	double frameP50Ms = 0.0;    ///< Percentiles del frame completo.
+	double frameP90Ms = 0.0;
+	double frameP99Ms = 0.0;
+	double frameMaxMs = 0.0;
+	size_t memoryBytes = 0;     ///< Memoria residente del proceso al terminar; 0 si no se sabe.
+
+	// Solo con barrido de hilos, por parte (`ScalingReport::systemName`), contra la primera corrida
+	// del mismo tamao
+	std::array<double, kScalingSystems> systemMs{};       ///< Promedio por frame.
+	std::array<double, kScalingSystems> speedup{};        ///< Tiempo de la referencia entre este.
+	std::array<double, kScalingSystems> efficiency{};     ///< `speedup` por hilo agregado: 1 es lineal.
+	std::array<double, kScalingSystems> serialFraction{}; ///< Karp-Flatt; 0 en la referencia.
+};
+
+/**
+ * @class ScalingReport
+ * @brief Junta los tiempos de cada tamao de escena y los escribe en CSV o JSON.
+ *
+ * Por cada tamao: `beginSample`, un `addFrame` por frame medido y `endSample`. Los archivos
+ * tienen una fila (o un objeto) por tamao, en el orden en que se midieron, para poder
+ * comparar corridas de dos versiones del motor con cualquier hoja de clculo.
+ *
+ * Con hilos (`beginSample(actors, threads)` y un `addSystems` por frame), cada corrida se compara
+ * con la primera del mismo tamao: aceleracin, eficiencia y la fraccin serial de Karp-Flatt,
+ * `(1/S - 1/p) / (1 - 1/p)` con `p` los hilos relativos a la referencia. Si esa fraccin crece con
+ * los hilos, lo que frena no es el cdigo serial de Amdahl sino la sincronizacin o la memoria.
+ */
+class
+ScalingReport {
+public:
+	void
+	beginSample(size_t actors, unsigned threads = 0);
+
+	/**
+	 * @brief Tiempos de un frame, en milisegundos; `gpuMs` negativo si no hay medida de GPU.
+	 */
+	void
+	addFrame(double updateMs, double renderMs, double frameMs, double gpuMs = -1.0);
+
+	/**
+	 * @brief Tiempos de cada parte en el frame, en milisegundos, por el orden de `systemName`.
+	 */
+	void
+	addSystems(const std::array<double, kScalingSystems>& ms);
+
+	/**
+	 * @brief Cierra el tamao actual: promedios, percentiles y memoria del proceso.
+	 */
+	const ScalingSample&
+	endSample();
+
+	const std::vector<ScalingSample>&
+	samples() const { return m_samples; }
+
+	/**
+	 * @brief Escribe los resultados; JSON si `path` termina en `.json`, CSV si no.
+	 * @return `false` si no pudo escribirse.
+	 */
+	bool
+	write(const std::string& path) const;
+
+	/**
+	 * @brief Memoria residente del proceso (working set en Windows), o 0 si la plataforma no
+	 *        la expone.
+	 */
+	static size_t
+	processMemoryBytes();
+
+	/**
+	 * @brief Nombre de la parte `index` en los archivos: `update`, `movement`, `physics`, `render_list`.
+	 */
+	static const char*
+	systemName(size_t index);
+
+	/**
+	 * @brief Zona del `Profiler` que mide la parte `index`.
+	 */
+	static const char*
+	systemZone(size_t index);
+
+private:
+	std::vector<ScalingSample> m_samples;
+	std::vector<double> m_frameMs;  ///< Frames del tamao actual; conserva su capacidad.
+	double m_updateTotal = 0.0;
+	double m_renderTotal = 0.0;
+	double m_gpuTotal = 0.0;
+	uint32_t m_gpuFrames = 0;       ///< Frames con medida de GPU.
+	std::array<double, kScalingSystems> m_systemTotal{};
+	uint32_t m_systemFrames = 0;
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Scene/AssetGraph.h"
+
+class JobSystem;
+
+/**
+ * @class AssetCooker
+ * @brief Cocina una lista de recursos en un `.gpak`, rehaciendo solo lo que cambi y lo que
+ *        depende de ello.
+ *
+ * Cada recurso se cocina con lo que el motor ya tiene: texturas a `.dds` (`CompressedTexture`),
+ * mallas `.obj` a `.gmsh` (`MeshOptimizer`) y escenas `.scene` a `.gscn` (`SceneText`); los
+ * materiales, shaders y dems archivos van tal cual. Lo cocido se guarda en una carpeta cach
+ * con el nombre de su clave: el FNV-1a del tipo, del contenido de la fuente y de las claves de
+ * lo que usa (`uses`). Cambiar una textura cambia su clave y la de cada material, malla y
+ * escena que la usan, directo o no, y solo esos se cocinan otra vez; el resto sale de la cach.
+ * Dos rutas con el mismo contenido tienen la misma clave, se cocinan una vez y `PackWriter`
+ * las guarda una vez.
+ *
+ * Con un `JobSystem`, las fuentes se leen y lo que falta se cocina en todos sus hilos; en orden
+ * solo van las claves, que esperan a las de lo que usan, y la escritura del paquete, as que
+ * el `.gpak` sale idntico con o sin hilos.
+ *
+ * La lista es texto, una instruccin por lnea, con `#` para comentar:
+ *
+ *     texture  tiles.png            # tipo y ruta: texture, mesh, scene, material, shader o file
+ *     mesh     rock.obj
+ *     material rock.mat
+ *     scene    main.scene
+ *     uses     rock.mat tiles.png   # el primero usa los dems
+ *     uses     rock.obj rock.mat
+ *     uses     main.scene rock.obj
+ *
+ * En el paquete cada recurso conserva la ruta de la lista, que es la que piden los cargadores;
+ * los `.scene` pasan a llamarse `.gscn`, como los que lee `BaseApp::loadScene`.
+ */
+class
+AssetCooker {
+public:
+	static constexpr uint32_t kVersion = 1;   ///< Sube si cambia cmo se cocina: invalida la cach.
+
+	enum class Kind : uint8_t { File, Scene, Mesh, Material, Texture, Shader };
+
+	struct Report {
+		size_t assets = 0;
+		size_t cooked = 0;           ///< Cocinados ahora.
+		size_t reused = 0;           ///< Sacados de la cach.
+		size_t copied = 0;           ///< Que van tal cual.
+		size_t uniqueBlobs = 0;      ///< Contenidos distintos en el paquete.
+		uint64_t sharedBytes = 0;    ///< Bytes que no se guardaron por repetir otro contenido.
+	};
+
+	/**
+	 * @brief Agrega `source`; si ya estaba, cambia su tipo.
+	 */
+	void
+	add(Kind kind, const std::string& source);
+
+	/**
+	 * @brief Anota que `dependent` usa `dependency`; los dos deben agregarse antes de `cook`.
+	 * @return `false` si cerrara un ciclo.
+	 */
+	bool
+	addDependency(const std::string& dependent, const std::string& dependency);
+
+	/**
+	 * @brief Agrega lo que dice la lista `text` (el formato de arriba).
+	 * @param error Si no es nulo y falla, la lnea y lo que estaba mal.
+	 */
+	bool
+	parse(std::string_view text, std::string* error = nullptr);
+
+	bool
+	parseFile(const std::string& path, std::string* error = nullptr);
+
+	/**
+	 * @brief Cocina lo que falte en `cacheDirectory` y escribe el paquete en `packPath`.
+	 * @param jobs Si no es nulo, lee y cocina en sus hilos.
+	 */
+	bool
+	cook(const std::string& packPath, const std::string& cacheDirectory, Report* report = nullptr,
+		std::string* error = nullptr, JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief Nombre de `source` en el paquete.
+	 */
+	static std::string
+	packName(Kind kind, const std::string& source);
+
+private:
+	struct Asset {
+		Kind kind = Kind::File;
+		std::string source;
+		uint64_t key = 0;            ///< Clave de coccin; la calcula `cook`.
+	};
+
+	enum class Outcome : uint8_t { Failed, Copied, Reused, Cooked };
+
+	/**
+	 * @brief Deja en `bytes` lo cocido de `asset`, de la cach o cocinndolo ah. Desde
+	 *        cualquier hilo, con `asset.key` ya calculada y distinta de la de los dems en curso.
+	 * @param error Si falla, qu no se pudo cocinar.
+	 */
+	static Outcome
+	cookAsset(const Asset& asset, const std::vector<unsigned char>& source, const std::string& cacheDirectory,
+		std::vector<unsigned char>& bytes, std::string& error);
+
+	std::vector<Asset> m_assets;                      ///< En el orden de la lista.
+	std::unordered_map<AssetId, size_t> m_byId;        ///< `assetId` de la fuente: su ndice.
+	AssetGraph m_graph;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Scene/PackFormat.h"
+
+/**
+ * @class AssetGraph
+ * @brief Qu recurso usa a qu otro (escena a malla, malla a material, material a textura y
+ *        shader), para rehacer solo lo que depende de lo que cambi.
+ *
+ * Los nodos son `AssetId` y aparecen al nombrarlos en una dependencia. No admite ciclos:
+ * `addDependency` rechaza la arista que cerrara uno, as que siempre hay un orden en que cada
+ * recurso va despus de todo lo que usa. Lo usan `AssetCooker`, para cocinar de nuevo solo lo
+ * afectado, y `AssetManager`, para recargarlo.
+ */
+class
+AssetGraph {
+public:
+	/**
+	 * @brief Anota que `dependent` usa `dependency`.
+	 * @return `false` si `dependency` ya usa `dependent`, directo o no; no se anota.
+	 */
+	bool
+	addDependency(AssetId dependent, AssetId dependency);
+
+	/**
+	 * @brief Quita lo que usa `dependent`, para volver a declararlo; sus dependientes siguen.
+	 */
+	void
+	clearDependencies(AssetId dependent);
+
+	/**
+	 * @brief Lo que `id` usa directamente, en el orden en que se anot.
+	 */
+	std::span<const AssetId>
+	dependencies(AssetId id) const;
+
+	/**
+	 * @brief Lo que usa directamente a `id`.
+	 */
+	std::span<const AssetId>
+	dependents(AssetId id) const;
+
+	/**
+	 * @brief `changed` y todo lo que depende de ellos, directo o no, sin repetir: cada uno
+	 *        despus de los que usa.
+	 */
+	void
+	affected(std::span<const AssetId> changed, std::vector<AssetId>& ordered) const;
+
+	size_t
+	size() const { return m_nodes.size(); }
+
+	void
+	clear() { m_nodes.clear(); }
+
+private:
+	struct Node {
+		std::vector<AssetId> dependencies;
+		std::vector<AssetId> dependents;
+	};
+
+	/**
+	 * @brief Si desde `from`, siguiendo lo que usa, se llega a `target`.
+	 */
+	bool
+	uses(AssetId from, AssetId target) const;
+
+	/**
+	 * @brief Agrega a `ordered` lo que usa `id` que est en `wanted` (o todo, si es nulo) y
+	 *        luego a `id`, una vez cada uno.
+	 */
+	void
+	visit(AssetId id, const std::unordered_set<AssetId>* wanted, std::unordered_set<AssetId>& done,
+		std::vector<AssetId>& ordered) const;
+
+	std::unordered_map<AssetId, Node> m_nodes;
+};
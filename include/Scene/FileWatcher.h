@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Recarga de assets al cambiar en disco (`FileWatcher`, `AssetManager::setHotReload`).
+ *
+ * Encendida en las builds de desarrollo (sin `NDEBUG`); definir `ENGINE_HOT_RELOAD=0` o `1` en
+ * el proyecto para forzarla. Apagada, `FileWatcher::start` no hace nada.
+ */
+#ifndef ENGINE_HOT_RELOAD
+#ifdef NDEBUG
+#define ENGINE_HOT_RELOAD 0
+#else
+#define ENGINE_HOT_RELOAD 1
+#endif
+#endif
+
+constexpr bool kHotReload = ENGINE_HOT_RELOAD != 0;
+
+/**
+ * @class FileWatcher
+ * @brief Avisa qu archivos registrados cambiaron, con lo que el sistema ofrece para eso
+ *        (inotify, `ReadDirectoryChangesW`), sin revisar el disco cada frame.
+ *
+ * Se vigilan las carpetas de los archivos registrados con `watch`, sin subcarpetas. Un hilo
+ * propio duerme hasta que el sistema avisa y anota el cambio; `takeChanges` solo toma lo
+ * anotado, as que llamarlo cada frame no toca el disco. Los editores escriben un archivo en
+ * varios pasos (truncar, escribir, renombrar): un archivo se entrega cuando pasaron
+ * `kSettleSeconds` sin otro aviso suyo, una sola vez por tanda.
+ *
+ * Las rutas se comparan normalizadas (`normalize`); `takeChanges` las entrega as. En Windows
+ * hay lugar para `kMaxDirectories` carpetas.
+ *
+ * `start`, `watch`, `takeChanges` y `stop` desde un solo hilo.
+ */
+class
+FileWatcher {
+public:
+	static constexpr double kSettleSeconds = 0.1;
+	static constexpr size_t kMaxDirectories = 63; ///< Lo que cabe en un `WaitForMultipleObjects`.
+
+	FileWatcher() = default;
+
+	~FileWatcher() { stop(); }
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	/**
+	 * @brief Empieza a escuchar al sistema en un hilo.
+	 * @return `false` si la build no tiene recarga (`kHotReload`) o el sistema no pudo.
+	 */
+	bool
+	start();
+
+	/**
+	 * @brief Deja de escuchar y une el hilo; lo registrado se olvida.
+	 */
+	void
+	stop();
+
+	bool
+	isRunning() const { return m_running; }
+
+	/**
+	 * @brief Registra `path`; puede no existir todava, crearlo tambin avisa.
+	 * @return `false` si no est corriendo o su carpeta no pudo vigilarse.
+	 */
+	bool
+	watch(const std::string& path);
+
+	/**
+	 * @brief Agrega a `changed` los archivos registrados que cambiaron y ya se asentaron.
+	 */
+	void
+	takeChanges(std::vector<std::string>& changed);
+
+	/**
+	 * @brief `path` sin `.` ni `..` y con `/` entre carpetas; `a.png` y `./a.png` son iguales.
+	 */
+	static std::string
+	normalize(const std::string& path);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Directory {
+		std::string path;              ///< Normalizada; vaca es la carpeta actual.
+#ifdef _WIN32
+		void* handle = nullptr;        ///< HANDLE de la carpeta.
+		void* overlapped = nullptr;    ///< OVERLAPPED con su evento, de la lectura en curso.
+		std::vector<unsigned char> buffer;
+		bool armed = false;            ///< Si hay un `ReadDirectoryChangesW` pendiente.
+#else
+		int descriptor = -1;           ///< De `inotify_add_watch`.
+#endif
+	};
+
+	/**
+	 * @brief Anota que `directory/name` cambi, si est registrado. Con `m_mutex` tomado.
+	 */
+	void
+	record(const std::string& directory, const char* name, size_t length);
+
+	void
+	listen();
+
+	std::thread m_thread;
+	std::mutex m_mutex;                                       ///< Protege lo de abajo contra el hilo.
+	std::vector<Directory> m_directories;
+	std::unordered_set<std::string> m_files;                  ///< Registrados, normalizados.
+	std::unordered_map<std::string, Clock::time_point> m_pending; ///< ltimo aviso de cada archivo.
+	std::atomic<bool> m_stopping{ false };
+	bool m_running = false;
+#ifdef _WIN32
+	void* m_wake = nullptr;                                   ///< Evento: carpetas nuevas o `stop`.
+#else
+	int m_inotify = -1;
+	int m_wake[2] = { -1, -1 };                               ///< Tubo para despertar al hilo.
+#endif
+};
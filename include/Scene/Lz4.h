@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Lz4
+ * @brief Bloques LZ4 (el formato de bloque de la especificacin, sin el marco): comprime al
+ *        armar un paquete y descomprime al cargar, a varios GB/s por hilo.
+ *
+ * El compresor es voraz, con una tabla de hash de 4 bytes: comprime menos que el modo HC de
+ * la biblioteca de referencia, pero lo que produce lo lee cualquier descompresor LZ4. El
+ * descompresor comprueba cada longitud y distancia contra los dos bferes: un bloque daado
+ * falla sin leer ni escribir fuera de ellos.
+ */
+class
+Lz4 {
+public:
+	/**
+	 * @brief Lo ms que puede ocupar comprimido un bloque de `size` bytes.
+	 */
+	static constexpr size_t
+	compressBound(size_t size) { return size + size / 255 + 16; }
+
+	/**
+	 * @return Bytes escritos en `destination`; 0 si no cupieron en `capacity`.
+	 */
+	static size_t
+	compress(const unsigned char* source, size_t size, unsigned char* destination, size_t capacity);
+
+	/**
+	 * @brief Descomprime `source` en exactamente `size` bytes de `destination`.
+	 * @return `false` si el bloque est daado o no da justo `size` bytes.
+	 */
+	static bool
+	decompress(const unsigned char* source, size_t sourceSize, unsigned char* destination, size_t size);
+};
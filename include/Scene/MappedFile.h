@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Archivo de solo lectura mapeado en memoria.
+ *
+ * El sistema carga las pginas a medida que se leen; abrir una escena grande no copia nada
+ * hasta que se toca. El puntero de `data()` est alineado a pgina y vale hasta `close()`.
+ */
+class
+MappedFile {
+public:
+	MappedFile() = default;
+
+	~MappedFile() { close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * @brief Mapea `path` completo.
+	 * @return `false` si no existe, est vaco o el sistema no pudo mapearlo.
+	 */
+	bool
+	open(const std::string& path);
+
+	void
+	close();
+
+	const unsigned char*
+	data() const { return m_data; }
+
+	size_t
+	size() const { return m_size; }
+
+	bool
+	isOpen() const { return m_data != nullptr; }
+
+private:
+	const unsigned char* m_data = nullptr; ///< Inicio del mapeo.
+	size_t m_size = 0;                     ///< Bytes mapeados.
+#ifdef _WIN32
+	void* m_file = nullptr;                ///< HANDLE del archivo.
+	void* m_mapping = nullptr;             ///< HANDLE del objeto de mapeo.
+#endif
+};
+
+/**
+ * @class MappedFileWriter
+ * @brief Archivo mapeado en memoria para escribir al final, que crece por trozos.
+ *
+ * `append` copia en el mapeo: no hay llamada al sistema por escritura, y si el proceso se cae
+ * lo copiado ya est en las pginas del sistema, que las termina de escribir igual. Cuando no
+ * entra se agranda el archivo (al doble, al menos `kGrowBytes`) y se vuelve a mapear. Lo que
+ * queda del ltimo trozo son ceros hasta `close`, que recorta el archivo a lo escrito; quien
+ * lee un archivo que no se cerr debe reconocer el final por su formato.
+ */
+class
+MappedFileWriter {
+public:
+	static constexpr size_t kGrowBytes = 1u << 20;
+
+	MappedFileWriter() = default;
+
+	~MappedFileWriter() { close(); }
+
+	MappedFileWriter(const MappedFileWriter&) = delete;
+	MappedFileWriter& operator=(const MappedFileWriter&) = delete;
+
+	/**
+	 * @brief Crea `path` (o lo vaca) y lo mapea con espacio para `reserve` bytes.
+	 * @return `false` si no pudo crearse o mapearse.
+	 */
+	bool
+	open(const std::string& path, size_t reserve = kGrowBytes);
+
+	/**
+	 * @brief Recorta el archivo a lo escrito y lo cierra.
+	 */
+	void
+	close();
+
+	/**
+	 * @return `false` si haca falta crecer y no se pudo; no se escribe nada.
+	 */
+	bool
+	append(const void* data, size_t bytes);
+
+	/**
+	 * @brief Bytes escritos.
+	 */
+	size_t
+	size() const { return m_size; }
+
+	bool
+	isOpen() const { return m_data != nullptr; }
+
+private:
+	/**
+	 * @brief Agranda el archivo a `capacity` bytes y lo vuelve a mapear.
+	 */
+	bool
+	remap(size_t capacity);
+
+	unsigned char* m_data = nullptr;       ///< Inicio del mapeo.
+	size_t m_size = 0;                     ///< Bytes escritos.
+	size_t m_capacity = 0;                 ///< Bytes mapeados.
+#ifdef _WIN32
+	void* m_file = nullptr;                ///< HANDLE del archivo.
+	void* m_mapping = nullptr;             ///< HANDLE del objeto de mapeo.
+#else
+	int m_file = -1;                       ///< Descriptor; hace falta para crecer.
+#endif
+};
@@ -0,0 +1,204 @@
+#pragma once
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Prerequisites.h"
+#include "Scene/MappedFile.h"
+#include "Scene/PackFormat.h"
+
+class JobSystem;
+
+/**
+ * @brief Un recurso encontrado en un paquete, tal como est guardado.
+ *
+ * Sin compresin, `view` es el contenido sobre el mapeo y no se copia nada. Comprimido, hay
+ * que pasarlo a un bfer: `unpackInto` descomprime cada trozo directo en su lugar del destino,
+ * repartidos en el `JobSystem` si se le da (tambin desde un trabajo: `wait` ejecuta otros
+ * mientras espera).
+ */
+struct PackedAsset {
+	std::span<const unsigned char> stored;   ///< Sobre el mapeo del paquete.
+	uint64_t size = 0;                       ///< Descomprimido.
+	uint64_t contentHash = 0;                ///< Igual en las rutas que comparten contenido.
+	PackCompression compression = PackCompression::None;
+	bool found = false;
+
+	bool
+	isCompressed() const { return compression != PackCompression::None; }
+
+	/**
+	 * @brief El contenido sin copiar; vaco si est comprimido.
+	 */
+	std::span<const unsigned char>
+	view() const { return isCompressed() ? std::span<const unsigned char>() : stored; }
+
+	/**
+	 * @brief Descomprime (o copia) el contenido en `destination`, de `size` bytes.
+	 * @return `false` si el tamao no es `size` o algn trozo est daado.
+	 */
+	bool
+	unpackInto(std::span<unsigned char> destination, JobSystem* jobs = nullptr) const;
+
+	/**
+	 * @brief El contenido: `view` si no est comprimido y, si lo est, descomprimido en `scratch`.
+	 * @return Vaco si algn trozo est daado.
+	 */
+	std::span<const unsigned char>
+	bytes(std::vector<unsigned char>& scratch, JobSystem* jobs = nullptr) const;
+};
+
+/**
+ * @class PackFile
+ * @brief Paquete `.gpak` abierto: mapea el archivo, lo valida una vez y da cada recurso como
+ *        una vista sobre el mapeo.
+ *
+ * Buscar es una bsqueda binaria en la tabla; leer no abre ni busca en el disco, el sistema
+ * trae las pginas al tocarlas. Los comprimidos se leen con `PackedAsset::unpackInto`. Las
+ * vistas valen mientras el `PackFile` siga abierto.
+ */
+class
+PackFile {
+public:
+	PackFile() = default;
+
+	PackFile(const PackFile&) = delete;
+	PackFile& operator=(const PackFile&) = delete;
+
+	/**
+	 * @brief Mapea y valida `path`.
+	 * @return `false` si no existe o no es un paquete vlido de esta versin.
+	 */
+	bool
+	open(const std::string& path);
+
+	/**
+	 * @brief Valida un paquete ya en memoria (alineado a `kPackBlobAlignment`), sin copiarlo ni
+	 *        aduearse.
+	 */
+	bool
+	openMemory(const unsigned char* data, size_t size);
+
+	void
+	close() { reset(); }
+
+	bool
+	isOpen() const { return m_data != nullptr; }
+
+	/**
+	 * @brief El recurso `id`; sin `found` si no est.
+	 */
+	PackedAsset
+	find(AssetId id) const;
+
+	PackedAsset
+	find(std::string_view path) const { return find(assetId(path)); }
+
+	std::span<const PackEntry>
+	entries() const { return m_entries; }
+
+	/**
+	 * @brief Ruta con que se agreg `entry`, apuntando dentro del archivo.
+	 */
+	std::string_view
+	entryName(const PackEntry& entry) const { return m_names.substr(entry.nameOffset, entry.nameLength); }
+
+private:
+	void
+	reset();
+
+	bool
+	validate();
+
+	MappedFile m_file;
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+	std::span<const PackEntry> m_entries;
+	std::string_view m_names;
+};
+
+/**
+ * @class PackStream
+ * @brief `sf::InputStream` sobre un recurso de un paquete, para los `loadFromStream` y
+ *        `openFromStream` de SFML.
+ *
+ * Lee del mapeo: sin abrir archivos ni llamar al sistema por cada `read`. Vale mientras el
+ * paquete siga abierto; `sf::Music` la lee mientras suena, as que tiene que durar lo mismo.
+ * Solo sobre contenido ya descomprimido (`PackedAsset::bytes`).
+ */
+class
+PackStream : public sf::InputStream {
+public:
+	PackStream() = default;
+
+	explicit PackStream(std::span<const unsigned char> data) : m_data(data) {}
+
+	void
+	open(std::span<const unsigned char> data) { m_data = data; m_position = 0; }
+
+	sf::Int64
+	read(void* data, sf::Int64 size) override;
+
+	sf::Int64
+	seek(sf::Int64 position) override;
+
+	sf::Int64
+	tell() override { return m_position; }
+
+	sf::Int64
+	getSize() override { return static_cast<sf::Int64>(m_data.size()); }
+
+private:
+	std::span<const unsigned char> m_data;
+	sf::Int64 m_position = 0;
+};
+
+/**
+ * @class PackLibrary
+ * @brief Los paquetes montados; los cargadores le preguntan por cada ruta antes de ir al disco.
+ *
+ * `TextureLoader`, `MeshLoader`, `SoundCache`, `AssetManager` y la msica de `AudioSystem`
+ * buscan aqu la ruta que les piden; si algn paquete la tiene, leen de l. El ltimo montado
+ * tiene prioridad, as que un parche puede reemplazar archivos de otro.
+ *
+ * Solo el hilo principal; los cargadores buscan al pedir y sus trabajos leen la vista, as que
+ * montar mientras hay cargas en curso es seguro, pero `unmountAll` no. Es un servicio
+ * (`TService<PackLibrary>`).
+ */
+class
+PackLibrary {
+public:
+	/**
+	 * @return `false` si `path` no es un paquete vlido; no se monta.
+	 */
+	bool
+	mount(const std::string& path);
+
+	/**
+	 * @brief Cierra todos los paquetes. Sin cargas en curso ni recursos ledos de ellos en uso.
+	 */
+	void
+	unmountAll() { m_packs.clear(); }
+
+	/**
+	 * @brief `path` en el ltimo paquete que lo tenga; sin `found` si ninguno.
+	 */
+	PackedAsset
+	find(std::string_view path) const;
+
+	size_t
+	packCount() const { return m_packs.size(); }
+
+	/**
+	 * @brief `find` en la biblioteca si alguien la cre; vaco si no, sin crearla.
+	 */
+	static PackedAsset
+	lookup(std::string_view path) {
+		PackLibrary* library = EngineUtilities::TService<PackLibrary>::get();
+		return library ? library->find(path) : PackedAsset();
+	}
+
+private:
+	std::vector<EngineUtilities::TUniquePtr<PackFile>> m_packs;   ///< Direcciones estables para las vistas.
+};
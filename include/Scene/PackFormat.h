@@ -0,0 +1,95 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @file PackFormat.h
+ * @brief Formato de paquetes de recursos (`.gpak`): muchos archivos en uno solo, para mapearlo
+ *        una vez y leer cada uno en su lugar.
+ *
+ * Disposicin del archivo, todo en little-endian:
+ * - `PackHeader` al inicio.
+ * - Tabla de `PackEntry` justo despus, ordenada por `id`.
+ * - Los nombres, concatenados y sin terminador.
+ * - El contenido de cada archivo, alineado a `kPackBlobAlignment`: tal cual estaba en disco o,
+ *   con `PackCompression::Lz4`, en trozos de `kPackChunkSize` bytes comprimidos cada uno por
+ *   su lado. Delante de los trozos va un `uint32_t` por trozo con lo que ocupa comprimido; si
+ *   ocupa lo mismo que descomprimido, se guard tal cual.
+ *
+ * Cada entrada lleva el FNV-1a de su contenido (`contentHash`). Dos rutas con el mismo
+ * contenido comparten `offset`: se guarda y se lee una sola vez.
+ *
+ * Un cambio de disposicin sube `kPackVersion`.
+ */
+
+static_assert(std::endian::native == std::endian::little, "El formato de paquete es little-endian");
+
+constexpr uint32_t kPackMagic = 0x4B415047;           ///< "GPAK" ledo como uint32.
+constexpr uint32_t kPackVersion = 3;
+constexpr uint64_t kPackBlobAlignment = 64;           ///< Cada archivo empieza en su propia lnea de cach.
+constexpr uint64_t kPackChunkSize = 256u << 10;       ///< Trozos independientes: se descomprimen en paralelo.
+
+enum class PackCompression : uint32_t {
+	None = 0,
+	Lz4 = 1        ///< Bloques LZ4 (`Lz4`), uno por trozo.
+};
+
+/**
+ * @brief Identificador de un recurso: FNV-1a de su ruta, para guardarlo en vez del texto.
+ */
+using AssetId = uint64_t;
+
+constexpr AssetId
+assetId(std::string_view path) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (char c : path) {
+		hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+/**
+ * @brief FNV-1a del contenido sin comprimir de un recurso; igual en dos rutas, mismo contenido.
+ */
+inline uint64_t
+contentHash(const unsigned char* data, size_t size) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (size_t i = 0; i < size; ++i) {
+		hash = (hash ^ data[i]) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+struct PackHeader {
+	uint32_t magic = kPackMagic;
+	uint32_t version = kPackVersion;
+	uint32_t entryCount = 0;
+	uint32_t namesSize = 0;    ///< Bytes de los nombres.
+	uint64_t fileSize = 0;     ///< Tamao total; un archivo truncado no pasa la validacin.
+	uint64_t namesOffset = 0;
+};
+
+/**
+ * @brief Un archivo del paquete.
+ */
+struct PackEntry {
+	AssetId id = 0;            ///< `assetId` de la ruta con que se agreg.
+	uint64_t offset = 0;       ///< Desde el inicio del archivo.
+	uint64_t size = 0;         ///< Descomprimido.
+	uint64_t storedSize = 0;   ///< Lo que ocupa en el archivo; `size` sin compresin.
+	uint32_t nameOffset = 0;   ///< En los nombres.
+	uint32_t nameLength = 0;
+	PackCompression compression = PackCompression::None;
+	uint32_t reserved = 0;
+	uint64_t contentHash = 0;  ///< `contentHash` de lo descomprimido.
+};
+
+/**
+ * @brief Trozos de un contenido de `size` bytes comprimido.
+ */
+constexpr uint64_t
+packChunkCount(uint64_t size) { return (size + kPackChunkSize - 1) / kPackChunkSize; }
+
+static_assert(sizeof(PackHeader) == 32 && sizeof(PackEntry) == 56, "Disposicin de paquete cambiada");
@@ -0,0 +1,75 @@
+#pragma once
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Scene/PackFormat.h"
+
+/**
+ * @class PackWriter
+ * @brief Arma un paquete `.gpak` en memoria y lo escribe de una vez.
+ *
+ * Cada recurso se agrega con la ruta con que el juego lo va a pedir; `build` ordena la tabla y
+ * alinea cada contenido para que `PackFile` lo lea en su lugar. Lo que se pide comprimido se
+ * guarda en trozos LZ4, salvo que as no ocupe menos: lo ya comprimido (PNG, OGG) conviene
+ * agregarlo sin compresin y ahorrarse el intento.
+ *
+ * Los recursos con el mismo contenido (`contentHash` y mismos bytes) se guardan una sola vez,
+ * con la compresin del primero que se agreg, y sus entradas apuntan ah.
+ */
+class
+PackWriter {
+public:
+	/**
+	 * @brief Agrega `bytes` como el recurso `name`; si ya estaba, lo reemplaza.
+	 */
+	void
+	add(std::string_view name, std::span<const unsigned char> bytes, PackCompression compression = PackCompression::None);
+
+	/**
+	 * @brief Agrega el archivo `diskPath` como el recurso `name`.
+	 * @return `false` si no pudo leerse.
+	 */
+	bool
+	addFile(std::string_view name, const std::string& diskPath, PackCompression compression = PackCompression::None);
+
+	size_t
+	size() const { return m_blobs.size(); }
+
+	/**
+	 * @brief Lo que ahorr guardar una vez el contenido repetido.
+	 */
+	struct Stats {
+		size_t entries = 0;
+		size_t uniqueBlobs = 0;      ///< Contenidos distintos que se guardaron.
+		uint64_t sharedBytes = 0;    ///< Bytes sin comprimir de las entradas que reusan uno anterior.
+	};
+
+	/**
+	 * @brief El paquete completo, listo para escribir.
+	 */
+	std::vector<unsigned char>
+	build(Stats* stats = nullptr) const;
+
+	/**
+	 * @brief Escribe el paquete en `path`.
+	 * @return `false` si el archivo no pudo escribirse completo.
+	 */
+	bool
+	write(const std::string& path, Stats* stats = nullptr) const;
+
+private:
+	struct Blob {
+		std::string name;
+		std::vector<unsigned char> bytes;
+		PackCompression compression = PackCompression::None;
+	};
+
+	/**
+	 * @brief `bytes` en trozos LZ4 con su tabla delante; vaco si as no ocupa menos.
+	 */
+	static std::vector<unsigned char>
+	compress(const std::vector<unsigned char>& bytes);
+
+	std::vector<Blob> m_blobs;
+};
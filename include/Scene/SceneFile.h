@@ -0,0 +1,145 @@
+#pragma once
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Scene/MappedFile.h"
+#include "Scene/SceneFormat.h"
+
+/**
+ * @brief Componentes de un tipo guardados en la escena: `values[i]` pertenece al actor `owners[i]`.
+ */
+template<typename T>
+struct SceneComponents {
+	std::span<const uint32_t> owners; ///< ndices en `SceneFile::actors()`.
+	std::span<const T> values;
+};
+
+/**
+ * @class SceneFile
+ * @brief Escena `.gscn` abierta: mapea el archivo, lo valida una vez y expone sus secciones.
+ *
+ * No hay parseo: `actors()`, `waypoints()` y `components<T>()` son vistas sobre el mapeo,
+ * vlidas mientras el `SceneFile` siga abierto. Quien necesite los datos despus los copia
+ * (un `memcpy` por seccin). La validacin revisa versin, tamao, lmites y alineacin de
+ * cada seccin, as que un archivo truncado o de otra versin se rechaza con `false`.
+ */
+class
+SceneFile {
+public:
+	SceneFile() = default;
+
+	SceneFile(const SceneFile&) = delete;
+	SceneFile& operator=(const SceneFile&) = delete;
+
+	/**
+	 * @brief Mapea y valida `path`.
+	 * @return `false` si no existe o no es una escena vlida de esta versin.
+	 */
+	bool
+	open(const std::string& path);
+
+	/**
+	 * @brief Valida una escena ya en memoria (alineada a 16 bytes), sin copiarla ni aduearse.
+	 */
+	bool
+	openMemory(const unsigned char* data, size_t size);
+
+	/**
+	 * @brief Suelta el mapeo; las vistas entregadas dejan de valer.
+	 */
+	void
+	close() { reset(); }
+
+	std::span<const SceneActorRecord>
+	actors() const { return m_actors; }
+
+	/**
+	 * @brief Nombre de `actor`, apuntando dentro del archivo.
+	 */
+	std::string_view
+	actorName(const SceneActorRecord& actor) const {
+		return std::string_view(m_strings.data() + actor.nameOffset, actor.nameLength);
+	}
+
+	std::span<const ScenePoint>
+	waypoints() const { return m_waypoints; }
+
+	/**
+	 * @brief Regiones de la escena, ordenadas por su primer actor; vaco si se carga completa.
+	 */
+	std::span<const SceneRegionRecord>
+	regions() const { return m_regions; }
+
+	/**
+	 * @brief Recursos de `region`.
+	 */
+	std::span<const SceneRegionAsset>
+	regionAssets(const SceneRegionRecord& region) const { return m_regionAssets.subspan(region.firstAsset, region.assetCount); }
+
+	/**
+	 * @brief Ruta de `asset`, apuntando dentro del archivo.
+	 */
+	std::string_view
+	assetPath(const SceneRegionAsset& asset) const {
+		return std::string_view(m_strings.data() + asset.pathOffset, asset.pathLength);
+	}
+
+	/**
+	 * @brief Componentes del tipo `typeName` (el mismo nombre que us `SceneWriter`).
+	 *
+	 * Vaco si la escena no los tiene o si el tamao guardado no coincide con `sizeof(T)`.
+	 */
+	template<typename T>
+	SceneComponents<T>
+	components(std::string_view typeName) const {
+		static_assert(std::is_trivially_copyable_v<T>, "Solo componentes trivialmente copiables");
+		uint64_t hash = sceneTypeHash(typeName);
+		for (size_t i = 1; i < m_sections.size(); ++i) {
+			const SceneSection& data = m_sections[i];
+			if (data.kind != SceneSectionKind::ComponentData || data.typeHash != hash) {
+				continue;
+			}
+			if (data.elementSize != sizeof(T) || (data.offset % alignof(T)) != 0) {
+				return {};
+			}
+			const SceneSection& owners = m_sections[i - 1];
+			return {
+				std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(m_data + owners.offset), owners.count),
+				std::span<const T>(reinterpret_cast<const T*>(m_data + data.offset), data.count)
+			};
+		}
+		return {};
+	}
+
+	size_t
+	size() const { return m_size; }
+
+private:
+	/**
+	 * @brief Revisa cabecera y secciones y prepara las vistas; deja todo vaco si falla.
+	 */
+	bool
+	validate();
+
+	void
+	reset();
+
+	template<typename T>
+	std::span<const T>
+	sectionSpan(const SceneSection& section) const {
+		return std::span<const T>(reinterpret_cast<const T*>(m_data + section.offset), section.count);
+	}
+
+	MappedFile m_file;                           ///< Vaco con `openMemory`.
+	const unsigned char* m_data = nullptr;       ///< Inicio de la escena.
+	size_t m_size = 0;
+	std::span<const SceneSection> m_sections;
+	std::span<const SceneActorRecord> m_actors;
+	std::span<const ScenePoint> m_waypoints;
+	std::span<const SceneRegionRecord> m_regions;
+	std::span<const SceneRegionAsset> m_regionAssets;
+	std::string_view m_strings;
+};
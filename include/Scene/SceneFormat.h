@@ -0,0 +1,135 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @file SceneFormat.h
+ * @brief Formato binario de escenas (`.gscn`), pensado para mapearse en memoria y leerse en su lugar.
+ *
+ * Disposicin del archivo, todo en little-endian:
+ * - `SceneHeader` al inicio.
+ * - Tabla de `SceneSection` justo despus.
+ * - Los datos de cada seccin, alineados a `kSceneSectionAlignment`.
+ *
+ * Cada seccin es un arreglo de elementos de tamao fijo. Los registros son structs simples
+ * de campos de 4 bytes, sin punteros ni relleno, as que se leen directamente desde el mapeo
+ * o se copian con un solo `memcpy` por seccin. Un cambio de disposicin sube `kSceneVersion`.
+ */
+
+static_assert(std::endian::native == std::endian::little, "El formato de escena es little-endian");
+
+constexpr uint32_t kSceneMagic = 0x4E435347;          ///< "GSCN" ledo como uint32.
+constexpr uint32_t kSceneVersion = 1;                 ///< Versin de la disposicin.
+constexpr uint64_t kSceneSectionAlignment = 16;       ///< Alineacin del inicio de cada seccin.
+
+/**
+ * @brief Tipo de contenido de una seccin.
+ */
+enum class SceneSectionKind : uint32_t {
+	Actors = 1,          ///< `SceneActorRecord`.
+	Strings = 2,         ///< Bytes de los nombres, sin terminador.
+	Waypoints = 3,       ///< `ScenePoint`.
+	ComponentOwners = 4, ///< `uint32_t`: actor de cada elemento de la seccin `ComponentData` siguiente.
+	ComponentData = 5,   ///< Componentes de datos trivialmente copiables de un tipo (`typeHash`).
+	Regions = 6,         ///< `SceneRegionRecord`, ordenadas por `firstActor`.
+	RegionAssets = 7,    ///< `SceneRegionAsset`.
+};
+
+struct SceneHeader {
+	uint32_t magic = kSceneMagic;
+	uint32_t version = kSceneVersion;
+	uint32_t sectionCount = 0;
+	uint32_t flags = 0;
+	uint64_t fileSize = 0;  ///< Tamao total; un archivo truncado no pasa la validacin.
+	uint64_t reserved = 0;
+};
+
+struct SceneSection {
+	SceneSectionKind kind;
+	uint32_t elementSize = 0;  ///< `sizeof` de cada elemento.
+	uint64_t count = 0;        ///< Nmero de elementos.
+	uint64_t offset = 0;       ///< Desde el inicio del archivo.
+	uint64_t typeHash = 0;     ///< Tipo de componente (`sceneTypeHash`); 0 en las dems.
+};
+
+/**
+ * @brief Un actor de la escena: figura, color y transformacin inicial.
+ */
+struct SceneActorRecord {
+	uint32_t nameOffset = 0;   ///< En la seccin `Strings`.
+	uint32_t nameLength = 0;
+	uint32_t shapeType = 0;    ///< Valor de `ShapeType`.
+	uint32_t fillColor = 0xFFFFFFFFu; ///< RGBA, como `sf::Color::toInteger`.
+	float positionX = 0.0f;
+	float positionY = 0.0f;
+	float rotation = 0.0f;     ///< Grados.
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+	uint32_t flags = 0;        ///< `kSceneActorActive`.
+};
+
+constexpr uint32_t kSceneActorActive = 1u << 0; ///< El actor empieza activo.
+
+/**
+ * @brief Etiquetas y capas de un actor (`EntityRegistry`). Se guardan como componente
+ *        `"EntityMasks"`, as que las escenas anteriores siguen siendo vlidas sin ellas.
+ */
+struct SceneActorMasks {
+	uint64_t tags = 0;
+	uint64_t layers = 1;
+};
+
+struct ScenePoint {
+	float x = 0.0f;
+	float y = 0.0f;
+};
+
+/**
+ * @brief Una parte del mundo que se carga y descarga entera (`WorldStreamer`): un tramo
+ *        contiguo de actores y los recursos que usan.
+ *
+ * Los actores de una regin no se crean al cargar la escena; los que no estn en ninguna,
+ * s. Una escena sin secciones de regiones es una escena de antes: se carga completa.
+ */
+struct SceneRegionRecord {
+	float minX = 0.0f;         ///< Lmites en el mundo.
+	float minY = 0.0f;
+	float maxX = 0.0f;
+	float maxY = 0.0f;
+	uint32_t firstActor = 0;   ///< Actores `[firstActor, firstActor + actorCount)`.
+	uint32_t actorCount = 0;
+	uint32_t firstAsset = 0;   ///< En la seccin `RegionAssets`.
+	uint32_t assetCount = 0;
+};
+
+/**
+ * @brief Un recurso que una regin pide a `AssetStreamer` antes de activar sus actores.
+ */
+struct SceneRegionAsset {
+	uint32_t kind = 0;         ///< Valor de `AssetKind`.
+	uint32_t pathOffset = 0;   ///< En la seccin `Strings`.
+	uint32_t pathLength = 0;
+	uint32_t reserved = 0;
+};
+
+static_assert(sizeof(SceneHeader) == 32 && sizeof(SceneSection) == 32, "Disposicin de escena cambiada");
+static_assert(sizeof(SceneActorRecord) == 40 && sizeof(ScenePoint) == 8, "Disposicin de escena cambiada");
+static_assert(std::is_trivially_copyable_v<SceneActorRecord> && std::is_trivially_copyable_v<ScenePoint>);
+static_assert(sizeof(SceneActorMasks) == 16 && std::is_trivially_copyable_v<SceneActorMasks>);
+static_assert(sizeof(SceneRegionRecord) == 32 && sizeof(SceneRegionAsset) == 16, "Disposicin de escena cambiada");
+
+/**
+ * @brief Identificador estable de un tipo de componente en el archivo: FNV-1a de su nombre.
+ *
+ * No se usa `ComponentTypeId`, que depende del orden de registro de cada ejecucin.
+ */
+constexpr uint64_t
+sceneTypeHash(std::string_view name) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (char c : name) {
+		hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+	}
+	return hash;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "Scene/SceneWriter.h"
+
+/**
+ * @class SceneText
+ * @brief Escenas escritas a mano (`.scene`): texto que se lee a un `SceneWriter`, el mismo que
+ *        arma un `.gscn`.
+ *
+ * Una instruccin por lnea; `#` comenta hasta el final de la lnea:
+ *
+ *     waypoint 100 100          # punto del recorrido, en orden
+ *     actor Circle              # empieza un actor; el nombre es el resto de la lnea
+ *       shape circle            # empty, circle, rectangle o triangle
+ *       color 0 0 255           # R G B [A], de 0 a 255; o 0xRRGGBB[AA]
+ *       position 200 200
+ *       rotation 0              # grados
+ *       scale 1 1
+ *       tags 0x1                # mscara de `EntityRegistry`, decimal o 0x
+ *       layers 1
+ *       active false            # empieza activo si no se dice
+ *     region 0 0 2048 2048      # minX minY maxX maxY: los actores que siguen son de la regin
+ *       asset texture rocks.png # texture, font, sound o mesh; la ruta es el resto de la lnea
+ *     actor Rock
+ *     endregion                 # los actores que siguen ya no son de ninguna
+ *
+ * Lo que no se dice queda como en `SceneActorRecord`. Los actores de una regin los crea
+ * `WorldStreamer` cuando la regin queda cerca de la vista. En desarrollo `BaseApp::loadScene` lee
+ * el texto directo; para distribuir se cocina a `.gscn` (`cookFile`) y se mapea sin parsear.
+ */
+class
+SceneText {
+public:
+	static constexpr std::string_view kExtension = ".scene";
+
+	/**
+	 * @brief Si `path` termina en `kExtension`.
+	 */
+	static bool
+	hasTextExtension(std::string_view path);
+
+	/**
+	 * @brief Agrega a `writer` los actores, etiquetas y waypoints de `text`.
+	 * @param error Si no es nulo y falla, la lnea y lo que estaba mal.
+	 * @return `false` en la primera lnea que no se entiende; `writer` puede quedar a medias.
+	 */
+	static bool
+	parse(std::string_view text, SceneWriter& writer, std::string* error = nullptr);
+
+	static bool
+	parseFile(const std::string& path, SceneWriter& writer, std::string* error = nullptr);
+
+	/**
+	 * @brief Lee `textPath` y escribe la escena cocida en `scenePath`.
+	 */
+	static bool
+	cookFile(const std::string& textPath, const std::string& scenePath, std::string* error = nullptr);
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Scene/SceneFormat.h"
+
+/**
+ * @class SceneWriter
+ * @brief Arma una escena `.gscn` en memoria y la escribe de una vez.
+ *
+ * Se agregan actores, waypoints, regiones y arreglos de componentes de datos; `build` calcula los
+ * desplazamientos y deja cada seccin alineada para que `SceneFile` la lea en su lugar.
+ */
+class
+SceneWriter {
+public:
+	/**
+	 * @brief Agrega un actor; `record.nameOffset`/`nameLength` se llenan aqu.
+	 * @return ndice del actor, el que usan los dueos de `addComponents`.
+	 */
+	uint32_t
+	addActor(std::string_view name, SceneActorRecord record);
+
+	/**
+	 * @brief Actores agregados; el ndice del prximo.
+	 */
+	uint32_t
+	actorCount() const { return static_cast<uint32_t>(m_actors.size()); }
+
+	void
+	setWaypoints(std::span<const ScenePoint> waypoints) { m_waypoints.assign(waypoints.begin(), waypoints.end()); }
+
+	/**
+	 * @brief Agrega una regin con los actores `[firstActor, firstActor + actorCount)`.
+	 *
+	 * Las regiones van en orden de actores y sin pisarse; `record.firstAsset`/`assetCount`
+	 * se llenan en `build` con lo que se agregue con `addRegionAsset`.
+	 * @return ndice de la regin.
+	 */
+	uint32_t
+	addRegion(SceneRegionRecord record);
+
+	/**
+	 * @brief Agrega a `region` un recurso de tipo `kind` (valor de `AssetKind`).
+	 */
+	void
+	addRegionAsset(uint32_t region, uint32_t kind, std::string_view path);
+
+	/**
+	 * @brief Guarda `values[i]` como componente `typeName` del actor `owners[i]`.
+	 *
+	 * `typeName` identifica el tipo en el archivo; al leer se pide con el mismo nombre.
+	 */
+	template<typename T>
+	void
+	addComponents(std::string_view typeName, std::span<const uint32_t> owners, std::span<const T> values) {
+		static_assert(std::is_trivially_copyable_v<T>, "Solo componentes trivialmente copiables");
+		static_assert(alignof(T) <= kSceneSectionAlignment, "Alineacin mayor que la de las secciones");
+		assert(owners.size() == values.size() && "Un dueo por componente");
+		ComponentBlock& block = m_components.emplace_back();
+		block.typeHash = sceneTypeHash(typeName);
+		block.elementSize = sizeof(T);
+		block.owners.assign(owners.begin(), owners.end());
+		block.bytes.resize(values.size_bytes());
+		if (!values.empty()) {
+			std::memcpy(block.bytes.data(), values.data(), values.size_bytes());
+		}
+	}
+
+	/**
+	 * @brief La escena completa, lista para escribir.
+	 */
+	std::vector<unsigned char>
+	build() const;
+
+	/**
+	 * @brief Escribe la escena en `path`.
+	 * @return `false` si el archivo no pudo escribirse completo.
+	 */
+	bool
+	write(const std::string& path) const;
+
+private:
+	struct ComponentBlock {
+		uint64_t typeHash = 0;
+		uint32_t elementSize = 0;
+		std::vector<uint32_t> owners;
+		std::vector<unsigned char> bytes;
+	};
+
+	std::vector<SceneActorRecord> m_actors;
+	std::string m_strings;                   ///< Nombres concatenados.
+	std::vector<ScenePoint> m_waypoints;
+	std::vector<SceneRegionRecord> m_regions;
+	std::vector<std::vector<SceneRegionAsset>> m_regionAssets;   ///< Por regin.
+	std::vector<ComponentBlock> m_components;
+};
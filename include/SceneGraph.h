@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include "Prerequisites.h"
+#include "EntityRegistry.h"
+#include "Transform.h"
+
+class Actor;
+
+/**
+ * @class SceneGraph
+ * @brief Jerarquas de actores (un arma en la mano de un personaje, una etiqueta sobre un
+ *        actor) guardadas como un arreglo plano ordenado por profundidad. Es un servicio
+ *        (`TService<SceneGraph>`) y lo avanza el sistema "SceneGraph" de `BaseApp`.
+ *
+ * Los nodos van primero los de profundidad 0, despus sus hijos, y as: `update` calcula las
+ * matrices de mundo de un tirn, cada nivel con los de arriba ya listos, sin subir por punteros
+ * a los padres. En cada nivel junta los nodos sucios (cambi su `Transform` o el de algn
+ * ancestro) en arreglos separados y los compone por lotes con `VectorBatch::composeAffine2D`;
+ * las ramas que no se movieron no se tocan. El resultado queda en la cach de cada `Transform`,
+ * as que `getWorldTransform` solo lo lee.
+ *
+ * `attach` tambin cuelga el `Transform` (`Transform::setParent`), as que quien pida la
+ * matriz antes de `update` la obtiene igual, por el camino perezoso; un padre puesto a mano
+ * con `setParent` se suelta al entrar el actor al grafo. Cambiar la jerarqua
+ * reordena el arreglo en el siguiente `update`; mover actores no.
+ *
+ * Un nodo guarda el `EntityHandle` del actor y una referencia a su `Transform`: si el actor
+ * muere (o su pool lo recicla), el siguiente `update` lo quita y sus hijos quedan sueltos en
+ * la posicin local que tenan. Un solo hilo.
+ */
+class
+SceneGraph {
+public:
+	static constexpr uint32_t kNoParent = ~0u;
+
+	/**
+	 * @brief Cuelga `child` de `parent`; si ya tena padre, se cambia. Su posicin, rotacin
+	 *        y escala pasan a ser relativas al padre.
+	 * @return Falso si alguno no tiene `Transform` o si `parent` cuelga de `child` (un ciclo).
+	 */
+	bool
+	attach(Actor& child, Actor& parent);
+
+	/**
+	 * @brief Descuelga `child` de su padre, si tena. Sus hijos siguen con l.
+	 */
+	void
+	detach(Actor& child);
+
+	/**
+	 * @brief Padre de `child` en la jerarqua, o un handle nulo.
+	 */
+	EntityHandle
+	parentOf(const Actor& child) const;
+
+	/**
+	 * @brief Deja al da las matrices de mundo de todos los nodos sucios.
+	 */
+	void
+	update();
+
+	/**
+	 * @brief Actores en alguna jerarqua (con padre o con hijos).
+	 */
+	size_t
+	size() const { return m_nodes.size(); }
+
+	/**
+	 * @brief Profundidad mxima ms uno, segn el ltimo `update`.
+	 */
+	size_t
+	levels() const { return m_levelStart.empty() ? 0 : m_levelStart.size() - 1; }
+
+	/**
+	 * @brief Nodos recalculados en el ltimo `update`.
+	 */
+	size_t
+	lastRecomputed() const { return m_lastRecomputed; }
+
+	static SceneGraph&
+	instance();
+
+private:
+	struct Node {
+		EngineUtilities::TIntrusivePtr<Transform> transform;
+		EntityHandle entity;
+		const Transform* parentTransform = nullptr; ///< La fuente de verdad al reordenar.
+		uint32_t parent = kNoParent;                ///< ndice en `m_nodes`, vlido tras `rebuild`.
+		uint32_t children = 0;
+		uint32_t depth = 0;
+		uint32_t seenLocal = 0;                     ///< `Transform::getLocalVersion` usada en la ltima matriz.
+	};
+
+	/**
+	 * @brief ndice del nodo de `actor`, crendolo si no estaba; `kNoParent` sin `Transform`.
+	 *        Un nodo de otro actor con el mismo `Transform` debe haberse quitado antes.
+	 */
+	uint32_t
+	nodeOf(Actor& actor);
+
+	/**
+	 * @brief Quita los nodos de actores muertos y los sueltos, y reordena por profundidad.
+	 */
+	void
+	rebuild();
+
+	std::vector<Node> m_nodes;                                 ///< Ordenados por profundidad tras `rebuild`.
+	std::unordered_map<const Transform*, uint32_t> m_lookup;   ///< `Transform` a ndice en `m_nodes`.
+	std::vector<uint32_t> m_levelStart;                        ///< Primer nodo de cada nivel, y el total al final.
+	std::vector<uint8_t> m_dirty;                              ///< Por nodo, durante `update`.
+	std::vector<uint32_t> m_batch;                             ///< Nodos sucios del nivel en curso.
+	std::array<std::vector<float>, 6> m_world;                 ///< Matriz de mundo de cada nodo: a, b, c, d, tx, ty.
+	std::array<std::vector<float>, 18> m_scratch;              ///< Padres, locales y resultados del lote.
+	bool m_structureChanged = false;
+	size_t m_lastRecomputed = 0;
+};
@@ -1,20 +1,60 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Component.h"
-#include "Window.h"
+#include "Transform.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/ShapeGeometry.h"
+
+/**
+ * @brief Dato para mover actores hacia un punto, como `ShapeFactory::Seek`, pero en lote.
+ *
+ * El sistema de movimiento recorre `view<const SeekTarget, Transform>()` en paralelo; quien decide el
+ * destino (p. ej. el recorrido de waypoints) solo escribe `target`.
+ */
+struct SeekTarget {
+	sf::Vector2f target;     ///< Punto al que se dirige.
+	float speed = 200.0f;    ///< Unidades por segundo.
+	float range = 10.0f;     ///< Distancia a la que deja de moverse.
+};
 
 class 
 ShapeFactory : public Component {
 public:
-	ShapeFactory() = default;
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::SHAPE;
 
+	ShapeFactory() : Component(ComponentType::SHAPE) {}
+
+	/**
+	 * @brief Sale de `StaticGeometryCache` si era esttica.
+	 */
 	virtual
-	~ShapeFactory() = default;
+	~ShapeFactory();
 
-	ShapeFactory(ShapeType shapeType) : 
-	m_shape(nullptr), m_shapeType(ShapeType::EMPTY), Component(ComponentType::SHAPE) {}
+	/**
+	 * @brief No se copia: `StaticGeometryCache` guarda la direccin de las figuras estticas.
+	 */
+	ShapeFactory(const ShapeFactory&) = delete;
+	ShapeFactory&
+	operator=(const ShapeFactory&) = delete;
+
+	ShapeFactory(ShapeType shapeType) :
+	Component(ComponentType::SHAPE), m_geometry(nullptr), m_shapeType(shapeType) {}
 
-	sf::Shape* 
+	/**
+	 * @brief Configura la figura del componente.
+	 *
+	 * La geometra es compartida (`ShapeGeometryLibrary`): el componente solo guarda un
+	 * puntero a ella, su color, su textura y su posicin si no tiene `Transform`. Crear una
+	 * figura no reserva memoria salvo la primera de su tipo. El color vuelve a blanco y la
+	 * textura a ninguna. `EMPTY` deja el componente sin figura.
+	 *
+	 * @param shapeType Tipo de figura.
+	 * @return La figura compartida, de solo lectura, o `nullptr` para `EMPTY`.
+	 */
+	const sf::Shape* 
 	createShape(ShapeType shapeType);
 
 	/**
@@ -25,29 +65,160 @@ public:
   update(float deltaTime) override {}
 
   /**
-   * @brief Renderiza el componente de malla.
-   * @param deviceContext Contexto del dispositivo para operaciones grficas.
+   * @brief Agrega la figura con la matriz de su `Transform` interpolada para el render
+   *        (`Transform::getRenderTransform`), o en su posicin propia.
+   * @param commands Buffer de comandos del frame.
    */
   void 
-  render(Window window) override {}
+  render(RenderCommandBuffer& commands) override;
 
+  /**
+   * @brief Mueve la figura: al `Transform` vinculado si lo hay, si no a su posicin propia.
+   */
   void 
   setPosition(float x, float y);
 
   void 
   setPosition(const sf::Vector2f& position);
 
+  /**
+   * @brief Color de esta figura; la geometra compartida sigue blanca.
+   */
   void 
   setFillColor(const sf::Color& color);
 
+  const sf::Color&
+  getFillColor() const { return m_fillColor; }
+
+  /**
+   * @brief Textura estirada sobre la figura, o nula. Cambia a la geometra compartida con
+   *        esa textura.
+   */
+  void
+  setTexture(const sf::Texture* texture);
+
+  const sf::Texture*
+  getTexture() const { return m_texture; }
+
+  /**
+   * @brief Posicin actual: la del `Transform` vinculado, o la propia.
+   */
+  sf::Vector2f
+  getPosition() const;
+
+  /**
+   * @brief Matriz de mundo de la figura: la del `Transform` vinculado, o su posicin propia.
+   */
+  sf::Transform
+  getWorldTransform() const;
+
   void 
   Seek(const sf::Vector2f& targetPosition, float speed, float deltaTime, float range);
 
-  sf::Shape* 
-  getShape() {
-    return m_shape;
-  }
+  /**
+   * @brief Un paso de `Seek` sin estado: la posicin siguiente desde `position`.
+   */
+  static sf::Vector2f
+  seekStep(const sf::Vector2f& position, const sf::Vector2f& targetPosition, float speed, float deltaTime, float range);
+
+  /**
+   * @brief `seekStep` para `count` agentes guardados en arreglos separados; `x` e `y` se
+   *        actualizan en el lugar, en una sola pasada.
+   *
+   * Con SSE avanza 4 agentes por instruccin (8 con AVX). La direccin se normaliza con
+   * `rsqrt` y un paso de Newton, que deja un error relativo cercano a 1e-6 frente a `sqrt`;
+   * los agentes dentro de su rango no se mueven. Lo que no llena un registro va por el camino
+   * escalar.
+   */
+  static void
+  seekBatch(float* x, float* y, const float* targetX, const float* targetY, const float* speed, const float* range,
+            size_t count, float deltaTime);
+
+  /**
+   * @brief Vincula el `Transform` de la misma entidad; la figura se dibuja con su matriz
+   *        de mundo y deja de guardar posicin propia.
+   */
+  void
+  setTransform(Transform* transform) { m_transform = transform; markChanged(); }
+
+  Transform*
+  getTransform() const { return m_transform; }
+
+  ShapeType
+  getShapeType() const { return m_shapeType; }
+
+  /**
+   * @brief Geometra compartida de la figura, sin color ni posicin: es la misma para todas
+   *        las de su tipo y no se modifica. Nula sin figura.
+   */
+  const sf::Shape*
+  getShape() const { return m_geometry ? m_geometry->shape : nullptr; }
+
+  /**
+   * @brief Puntos locales de la figura, compartidos por todas las de su tipo, para que
+   *        `ShapeBatcher` no los recalcule cada frame. Vaco sin figura.
+   */
+  std::span<const sf::Vector2f>
+  getLocalOutline() const;
+
+  /**
+   * @brief Marca la figura como esttica: en vez de grabar un comando cada frame, se hornea en
+   *        `StaticGeometryCache` y se dibuja desde la GPU, debajo de las dems.
+   *
+   * Para lo que no se mueve despus de cargar la escena. Moverla o cambiarla sigue
+   * funcionando, pero vuelve a subir el bfer entero. Las figuras con contorno no pueden
+   * hornearse y siguen dibujndose normal.
+   */
+  void
+  setStatic(bool isStatic);
+
+  bool
+  isStatic() const { return m_staticIndex != UINT32_MAX; }
+
+  /**
+   * @brief Capa en que se dibuja la figura (`DrawState::layer`); si est en `LayerCache`, la
+   *        figura la ensucia cuando cambia o se mueve.
+   */
+  void
+  setLayer(uint8_t layer) { m_layer = layer; markChanged(); }
+
+  uint8_t
+  getLayer() const { return m_layer; }
+
+  /**
+   * @brief Niveles de detalle de los crculos, de 6 a 64 puntos.
+   *
+   * Con la escala de pantalla del buffer (`RenderCommandBuffer::setPixelScale`), `render`
+   * elige cuntos puntos dibuja un crculo segn su radio en pxeles: los que mantienen el
+   * error del contorno bajo medio pxel. Para no alternar cuando el radio ronda un lmite, se
+   * sube de nivel al pasarlo por `kLodHysteresis` y se baja al quedar esa fraccin por debajo.
+   * Los contornos de cada nivel son compartidos, as que los lotes y el instancing juntan todos
+   * los crculos del mismo nivel. Sin escala de pantalla se dibujan los 30 puntos de siempre.
+   */
+  static constexpr uint8_t kCircleLodLevels = 8;
+  static constexpr float kLodHysteresis = 0.2f;
+
+  /**
+   * @brief Puntos con que se dibuj el crculo la ltima vez, o 0 si no se eligi nivel.
+   */
+  size_t
+  getLodPointCount() const;
 private:
-	sf::Shape* m_shape;
-	ShapeType m_shapeType;
+  /**
+   * @brief Contorno del nivel de detalle para `transform` con `pixelScale` pxeles por unidad.
+   */
+  std::span<const sf::Vector2f>
+  selectCircleLod(const sf::Transform& transform, float pixelScale);
+
+	friend class StaticGeometryCache;
+
+	const ShapeGeometry* m_geometry = nullptr; ///< Geometra compartida, o nula sin figura.
+	ShapeType m_shapeType = ShapeType::EMPTY;
+	Transform* m_transform = nullptr;          ///< Transform de la misma entidad, o nulo.
+	const sf::Texture* m_texture = nullptr;
+	sf::Color m_fillColor = sf::Color::White;
+	sf::Vector2f m_position;                   ///< Solo sin `Transform` vinculado.
+	uint32_t m_staticIndex = UINT32_MAX;       ///< Posicin en `StaticGeometryCache`, o ninguna.
+	uint8_t m_layer = 0;                       ///< Ver `setLayer`.
+	uint8_t m_lod = UINT8_MAX;                 ///< Nivel de detalle del crculo, o ninguno todava.
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+class World;
+
+/**
+ * @class Determinism
+ * @brief Lo que hace falta para que la simulacin d los mismos bits en cada corrida y en
+ *        cada mquina con el mismo ejecutable.
+ *
+ * La simulacin no lee el reloj: `BaseApp::update` recibe pasos fijos y su entrada de un
+ * `TickInput`. Los nmeros al azar salen de semillas fijas (`ParticleEmitter::setSeed`, el
+ * ruido de `SteeringSystem` por entidad y paso), el `World` se recorre en el orden de sus
+ * arquetipos y `PhysicsWorld` colorea igual con cualquier nmero de hilos. Lo que queda es
+ * el punto flotante: `configureFloatingPoint` fija el modo de SSE y quita las rutas con FMA
+ * de la biblioteca de MSVC, que cambian segn el procesador. Un ejecutable compilado con
+ * matemtica rpida (`/fp:fast`, `-ffast-math`) reordena operaciones y no puede usarse as.
+ */
+class
+Determinism {
+public:
+	/**
+	 * @brief Redondeo al ms cercano, sin poner en cero los subnormales. En el hilo principal,
+	 *        despus de crear la ventana: hay drivers que cambian el modo al crear el contexto.
+	 *        Los hilos de `JobSystem` ya empezaron con el modo de arranque, que es este mismo.
+	 */
+	static void
+	configureFloatingPoint();
+
+	/**
+	 * @brief `false` si el ejecutable se compil con matemtica rpida.
+	 */
+	static bool
+	isSupported();
+
+	/**
+	 * @brief FNV-1a de los `Transform` del mundo con sus entidades: dos corridas con la misma
+	 *        entrada deben dar lo mismo en el mismo paso.
+	 */
+	static uint64_t
+	checksum(World& world);
+};
@@ -0,0 +1,166 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Scene/MappedFile.h"
+
+/**
+ * @brief Entrada de un paso de simulacin: todo lo de afuera que `BaseApp::update` lee.
+ */
+struct TickInput {
+	float mouseX = 0.0f;
+	float mouseY = 0.0f;
+};
+
+static_assert(std::is_trivially_copyable_v<TickInput>, "TickInput se guarda byte a byte");
+
+/**
+ * @brief Qu lleva un `TickEvent`.
+ */
+enum class TickEventType : uint16_t {
+	ConsoleLine = 1,    ///< Una orden escrita en la consola, que se vuelve a ejecutar al repetir.
+};
+
+/**
+ * @brief Algo de afuera que no es de todos los pasos y cambia la simulacin. Al repetir,
+ *        `data` apunta dentro del archivo mapeado y vale hasta el siguiente `InputLog::next`.
+ */
+struct TickEvent {
+	TickEventType type = TickEventType::ConsoleLine;
+	std::span<const unsigned char> data;
+
+	std::string_view
+	text() const { return std::string_view(reinterpret_cast<const char*>(data.data()), data.size()); }
+};
+
+/**
+ * @class InputLog
+ * @brief Entradas de una corrida determinista: un `TickInput` por paso, con los eventos de
+ *        ese paso, escritas a medida que se juegan y ledas de un archivo mapeado al repetir.
+ *
+ * Con la simulacin en modo lockstep, el estado del paso `n` depende solo del estado inicial
+ * y de las entradas `[0, n]`: guardar esto basta para repetir la corrida (para reproducir un
+ * error de una sesin real, o como carga de medicin repetible) o para que otra mquina la
+ * siga paso a paso, sin mandar el estado.
+ *
+ * Al grabar, cada `record` agrega su paso con `MappedFileWriter`: una copia en memoria, sin
+ * llamadas al sistema, y si el juego se cae el archivo tiene todo hasta el ltimo paso. Al
+ * repetir, `next` recorre el archivo mapeado con `MappedFile`, sin copiarlo.
+ *
+ * El archivo es una cabecera (`"GINP"`, versin y segundos por paso) y despus, por paso, un
+ * `TickHeader` (el nmero de paso ms uno, cuntos eventos y cuntos bytes ocupan), el
+ * `TickInput` y los eventos, cada uno con su tipo, su largo y los datos, rellenados a 4 bytes.
+ * Un paso con nmero 0 o que no entra es el final: los ceros que quedan de un archivo que no
+ * se cerr lo son.
+ */
+class
+InputLog {
+public:
+	static constexpr uint32_t kVersion = 2;
+
+	InputLog() = default;
+
+	InputLog(const InputLog&) = delete;
+	InputLog&
+	operator=(const InputLog&) = delete;
+
+	/**
+	 * @brief Empieza a grabar en `path`, que se crea o se vaca.
+	 * @param step Segundos por paso; la repeticin usa los mismos.
+	 * @return `false` si el archivo no pudo crearse.
+	 */
+	bool
+	create(const std::string& path, float step);
+
+	/**
+	 * @brief Guarda un evento para el prximo `record`. Sin grabacin abierta no hace nada.
+	 */
+	void
+	recordEvent(TickEventType type, std::string_view data);
+
+	/**
+	 * @brief Agrega un paso con `input` y los eventos guardados desde el anterior.
+	 * @return `false` si no est grabando o ya no pudo escribir.
+	 */
+	bool
+	record(const TickInput& input);
+
+	/**
+	 * @brief Abre `path` para repetirlo desde el primer paso.
+	 * @return `false` si el archivo no existe o no es un registro vlido.
+	 */
+	bool
+	open(const std::string& path);
+
+	/**
+	 * @brief Lee el paso siguiente: su entrada en `input` y sus eventos en `events()`.
+	 * @return `false` al final del registro.
+	 */
+	bool
+	next(TickInput& input);
+
+	/**
+	 * @brief Eventos del ltimo paso ledo con `next`.
+	 */
+	const std::vector<TickEvent>&
+	events() const { return m_events; }
+
+	/**
+	 * @brief Cierra lo que estuviera abierto; una grabacin queda recortada a lo escrito.
+	 */
+	void
+	close();
+
+	bool
+	isRecording() const { return m_writer.isOpen(); }
+
+	bool
+	isReplaying() const { return m_reader.isOpen(); }
+
+	/**
+	 * @brief Pasos grabados o ledos hasta ahora.
+	 */
+	uint32_t
+	ticks() const { return m_ticks; }
+
+	/**
+	 * @brief Segundos por paso con que se grab; la repeticin debe usar los mismos.
+	 */
+	float
+	step() const { return m_step; }
+
+private:
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		float step;
+		uint32_t reserved;
+	};
+
+	struct TickHeader {
+		uint32_t tick;          ///< Nmero de paso ms uno; 0 es el final.
+		uint16_t eventCount;
+		uint16_t reserved;
+		uint32_t eventBytes;    ///< Lo que ocupan los eventos detrs del `TickInput`.
+	};
+
+	struct EventHeader {
+		uint16_t type;
+		uint16_t reserved;
+		uint32_t bytes;         ///< Datos, sin el relleno.
+	};
+
+	MappedFileWriter m_writer;
+	std::vector<unsigned char> m_pending;   ///< Eventos para el prximo `record`, ya con sus cabeceras.
+	uint16_t m_pendingCount = 0;
+
+	MappedFile m_reader;
+	size_t m_cursor = 0;                    ///< Prximo paso en `m_reader`.
+	std::vector<TickEvent> m_events;
+
+	uint32_t m_ticks = 0;
+	float m_step = 0.0f;
+};
@@ -0,0 +1,166 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "ECS/SystemScheduler.h"
+#include "ECS/World.h"
+#include "Jobs/JobSystem.h"
+#include "Memory/TUniquePtr.h"
+#include "Net/NetSession.h"
+
+/**
+ * @class HostedSession
+ * @brief Una partida de un `SessionHost`: su propio `World`, sus sistemas y su `NetSession`
+ *        en su puerto.
+ *
+ * Lo que ven los clientes lo arma `setCapture` despus de cada paso, desde el `World` de la
+ * partida; ni la escena ni los servicios por mundo (`SpatialGrid`, `EntityCommandBuffer`) son
+ * suyos, as que sus sistemas solo tocan `world`. Los recursos de solo lectura (mallas,
+ * navegacin, tablas) se comparten entre todas las partidas del proceso.
+ */
+class
+HostedSession {
+public:
+	using Capture = std::function<void(World&, std::vector<NetActorState>&)>;
+
+	explicit
+	HostedSession(JobSystem& jobs) : m_systems(jobs) {}
+
+	HostedSession(const HostedSession&) = delete;
+	HostedSession& operator=(const HostedSession&) = delete;
+
+	World&
+	world() { return m_world; }
+
+	SystemScheduler&
+	systems() { return m_systems; }
+
+	NetSession&
+	net() { return m_net; }
+
+	/**
+	 * @brief Llena la foto de la partida (por id); sin ella, los clientes no reciben actores.
+	 */
+	void
+	setCapture(Capture capture) { m_capture = std::move(capture); }
+
+	/**
+	 * @brief Con `true` simula aunque no tenga clientes.
+	 */
+	void
+	setAlwaysActive(bool active) { m_alwaysActive = active; }
+
+	/**
+	 * @brief Sin clientes ni `setAlwaysActive`: no simula y solo se revisa si alguien se conect.
+	 */
+	bool
+	isIdle() const { return !m_alwaysActive && m_net.clientCount() == 0; }
+
+	uint64_t
+	steps() const { return m_steps; }
+
+private:
+	friend class SessionHost;
+
+	/**
+	 * @brief Un paso: sistemas, foto y red. En un hilo de trabajo.
+	 */
+	void
+	step(float deltaTime);
+
+	/**
+	 * @brief Solo la red, sin simular: conexiones de una partida quieta.
+	 */
+	void
+	poll() { m_net.update(std::span<const NetActorState>(), 0.0f); }
+
+	World m_world;
+	SystemScheduler m_systems;
+	NetSession m_net;
+	Capture m_capture;
+	std::vector<NetActorState> m_states;   ///< Conserva su capacidad.
+	bool m_alwaysActive = false;
+	uint64_t m_steps = 0;
+	double m_nextStep = 0.0;               ///< Segundos del `SessionHost`.
+};
+
+/**
+ * @class SessionHost
+ * @brief Muchas partidas independientes en un proceso sin ventana, repartidas en el
+ *        `JobSystem` del motor.
+ *
+ * Cada `tick` junta las partidas a las que les toca un paso y lanza cada una como un trabajo;
+ * sus sistemas reparten a su vez en los mismos hilos, as que diez partidas chicas llenan los
+ * ncleos igual que una grande y ninguna tiene hilos propios de simulacin. Una partida sin
+ * clientes no simula: cada `kIdlePollSeconds` se leen sus conexiones y nada ms, y su hilo de
+ * red duerme en el socket. Entre turnos, `run` duerme hasta el prximo paso que toque.
+ *
+ * Un proceso por partida duplica en cada uno los recursos cargados y deja ncleos ociosos
+ * cuando las partidas tienen poco que hacer; aqu se cargan una vez.
+ */
+class
+SessionHost {
+public:
+	static constexpr float kDefaultStepHz = 30.0f;
+	static constexpr double kIdlePollSeconds = 0.1;
+
+	/**
+	 * @param jobs Hilos donde corren las partidas; normalmente `TService<JobSystem>`.
+	 */
+	explicit
+	SessionHost(JobSystem& jobs, float stepHz = kDefaultStepHz);
+
+	~SessionHost() { closeAll(); }
+
+	SessionHost(const SessionHost&) = delete;
+	SessionHost& operator=(const SessionHost&) = delete;
+
+	/**
+	 * @brief Una partida nueva que escucha en `port`.
+	 * @return Nula si el puerto no pudo abrirse.
+	 */
+	HostedSession*
+	open(unsigned short port);
+
+	void
+	close(HostedSession& session);
+
+	void
+	closeAll();
+
+	size_t
+	sessionCount() const { return m_sessions.size(); }
+
+	/**
+	 * @brief Partidas que simularon en el ltimo `tick`.
+	 */
+	size_t
+	activeCount() const { return m_due.size(); }
+
+	/**
+	 * @brief Un turno: revisa las partidas quietas que toca y simula en paralelo las que
+	 *        tienen un paso pendiente; regresa cuando terminaron.
+	 * @return Segundos hasta el prximo turno con algo que hacer.
+	 */
+	double
+	tick();
+
+	/**
+	 * @brief `tick` y dormir, hasta que `stop` sea `true`.
+	 */
+	void
+	run(const std::atomic<bool>& stop);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	double
+	now() const { return std::chrono::duration<double>(Clock::now() - m_start).count(); }
+
+	JobSystem& m_jobs;
+	float m_step;
+	Clock::time_point m_start = Clock::now();
+	std::vector<EngineUtilities::TUniquePtr<HostedSession>> m_sessions;
+	std::vector<HostedSession*> m_due;     ///< Del turno; conserva su capacidad.
+};
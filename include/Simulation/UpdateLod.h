@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include "Prerequisites.h"
+
+/**
+ * @class UpdateLod
+ * @brief Nivel de detalle por frecuencia: cada cuntos pasos le toca a una entidad segn dnde
+ *        est respecto de la vista.
+ *
+ * Lo que est a la vista va cada paso, lo que est a ms de `kFarDistance` del centro cada
+ * `kFarInterval` y lo que qued fuera cada `kHiddenInterval`. Cada entidad cae en el cubo
+ * `(paso + ndice) % intervalo`, as que los lejanos se reparten parejo entre los pasos en vez
+ * de tocarles todos juntos. Quien la salta sigue con lo ltimo que calcul (la velocidad, la
+ * pose) y al tocarle aplica de una vez el tiempo de los pasos saltados.
+ *
+ * Sin `setVisibleArea` todo va cada paso. La decisin depende de la vista: lo que cambia la
+ * simulacin no debe usarla en lockstep.
+ */
+class
+UpdateLod {
+public:
+	static constexpr uint32_t kFarInterval = 4;
+	static constexpr uint32_t kHiddenInterval = 8;
+	static constexpr float kFarDistance = 1500.0f; ///< Desde el centro de la vista.
+
+	void
+	setVisibleArea(const sf::FloatRect& area) { m_visibleArea = area; m_hasVisibleArea = true; }
+
+	/**
+	 * @brief Vuelve a ir todo cada paso.
+	 */
+	void
+	clearVisibleArea() { m_hasVisibleArea = false; }
+
+	bool
+	hasVisibleArea() const { return m_hasVisibleArea; }
+
+	/**
+	 * @brief Pasa al paso siguiente; cambia a quin le toca.
+	 */
+	void
+	advance() { ++m_step; }
+
+	uint32_t
+	step() const { return m_step; }
+
+	/**
+	 * @brief Pasos entre dos actualizaciones de algo en `position`.
+	 */
+	uint32_t
+	intervalAt(const sf::Vector2f& position) const {
+		if (!m_hasVisibleArea) {
+			return 1;
+		}
+		if (!m_visibleArea.contains(position)) {
+			return kHiddenInterval;
+		}
+		sf::Vector2f center(m_visibleArea.left + 0.5f * m_visibleArea.width, m_visibleArea.top + 0.5f * m_visibleArea.height);
+		sf::Vector2f offset = position - center;
+		return offset.x * offset.x + offset.y * offset.y > kFarDistance * kFarDistance ? kFarInterval : 1;
+	}
+
+	/**
+	 * @brief Si a la entidad `index` le toca este paso con `interval`.
+	 */
+	bool
+	isDue(uint32_t index, uint32_t interval) const { return (m_step + index) % interval == 0; }
+
+	/**
+	 * @brief Pasos que cubre la entidad `index` en `position` si le toca este paso; 0 si no.
+	 */
+	uint32_t
+	dueInterval(uint32_t index, const sf::Vector2f& position) const {
+		uint32_t interval = intervalAt(position);
+		return isDue(index, interval) ? interval : 0;
+	}
+
+private:
+	sf::FloatRect m_visibleArea;
+	bool m_hasVisibleArea = false;
+	uint32_t m_step = 0;
+};
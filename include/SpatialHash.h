@@ -0,0 +1,148 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Prerequisites.h"
+
+/**
+ * @class SpatialHash
+ * @brief Puntos repartidos en celdas uniformes para preguntar quin est cerca, sin recorrer
+ *        todos los puntos.
+ *
+ * `build` recibe las posiciones del frame en dos arreglos (x e y, el punto `i` es el elemento
+ * `i`) y las ordena por cubeta con un conteo: una pasada para contar, una suma acumulada y
+ * otra pasada para repartir. Las celdas van a cubetas por hash, el doble de cubetas que de
+ * puntos, as que el mundo no necesita lmites. Cada entrada ordenada guarda su celda y su
+ * posicin, para que las consultas no salten a los arreglos de quien lo arm.
+ *
+ * `forEachInRadius` y `forEachInBox` llaman a una funcin por cada punto encontrado y no
+ * piden memoria; una celda distinta que cae en la misma cubeta se descarta por sus
+ * coordenadas. Tras el primer `build` con `n` puntos, los siguientes con hasta `n` tampoco
+ * piden memoria.
+ *
+ * Se arma en un hilo; despus las consultas pueden correr en varios a la vez.
+ */
+class
+SpatialHash {
+public:
+	/**
+	 * @brief Rehace el ndice con los puntos `(x[i], y[i])` en celdas de `cellSize` de lado.
+	 *        `x` e `y` deben tener el mismo largo.
+	 */
+	void
+	build(std::span<const float> x, std::span<const float> y, float cellSize);
+
+	/**
+	 * @brief Llama a `fn(item, distanceSq)` por cada punto a menos de `radius` de `center`.
+	 *        Si `fn` devuelve `false`, la bsqueda termina ah.
+	 */
+	template<typename Fn>
+	void
+	forEachInRadius(const sf::Vector2f& center, float radius, Fn&& fn) const {
+		if (m_items.empty()) {
+			return;
+		}
+		float radiusSq = radius * radius;
+		int32_t x0 = cellOf(center.x - radius), x1 = cellOf(center.x + radius);
+		int32_t y0 = cellOf(center.y - radius), y1 = cellOf(center.y + radius);
+		for (int32_t cy = y0; cy <= y1; ++cy) {
+			for (int32_t cx = x0; cx <= x1; ++cx) {
+				uint32_t bucket = bucketOf(cx, cy);
+				for (uint32_t k = m_bucketStart[bucket]; k < m_bucketStart[bucket + 1]; ++k) {
+					const Entry& entry = m_entries[k];
+					if (entry.cellX != cx || entry.cellY != cy) {
+						continue;
+					}
+					float dx = entry.x - center.x;
+					float dy = entry.y - center.y;
+					float distanceSq = dx * dx + dy * dy;
+					if (distanceSq < radiusSq && !fn(m_items[k], distanceSq)) {
+						return;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Llama a `fn(item)` por cada punto dentro de `box`. Si `fn` devuelve `false`, la
+	 *        bsqueda termina ah.
+	 */
+	template<typename Fn>
+	void
+	forEachInBox(const sf::FloatRect& box, Fn&& fn) const {
+		if (m_items.empty()) {
+			return;
+		}
+		float right = box.left + box.width;
+		float bottom = box.top + box.height;
+		int32_t x0 = cellOf(box.left), x1 = cellOf(right);
+		int32_t y0 = cellOf(box.top), y1 = cellOf(bottom);
+		for (int32_t cy = y0; cy <= y1; ++cy) {
+			for (int32_t cx = x0; cx <= x1; ++cx) {
+				uint32_t bucket = bucketOf(cx, cy);
+				for (uint32_t k = m_bucketStart[bucket]; k < m_bucketStart[bucket + 1]; ++k) {
+					const Entry& entry = m_entries[k];
+					if (entry.cellX != cx || entry.cellY != cy ||
+					    entry.x < box.left || entry.x >= right || entry.y < box.top || entry.y >= bottom) {
+						continue;
+					}
+					if (!fn(m_items[k])) {
+						return;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Copia en `out` los puntos a menos de `radius` de `center`, hasta llenarlo.
+	 * @return Cuntos se escribieron.
+	 */
+	size_t
+	queryRadius(const sf::Vector2f& center, float radius, std::span<uint32_t> out) const;
+
+	/**
+	 * @brief Copia en `out` los puntos dentro de `box`, hasta llenarlo.
+	 * @return Cuntos se escribieron.
+	 */
+	size_t
+	queryBox(const sf::FloatRect& box, std::span<uint32_t> out) const;
+
+	/**
+	 * @brief Puntos del ltimo `build`.
+	 */
+	size_t
+	size() const { return m_items.size(); }
+
+	float
+	cellSize() const { return m_cellSize; }
+
+	/**
+	 * @brief Celda de la coordenada `value` sobre cualquiera de los dos ejes.
+	 */
+	int32_t
+	cellOf(float value) const { return static_cast<int32_t>(std::floor(value * m_inverseCellSize)); }
+
+private:
+	struct Entry {
+		int32_t cellX;
+		int32_t cellY;
+		float x;
+		float y;
+	};
+
+	uint32_t
+	bucketOf(int32_t cellX, int32_t cellY) const {
+		return (uint32_t(cellX) * 73856093u ^ uint32_t(cellY) * 19349663u) & m_bucketMask;
+	}
+
+	std::vector<Entry> m_entries;         ///< Ordenadas por cubeta.
+	std::vector<uint32_t> m_items;        ///< Elemento de cada entrada de `m_entries`.
+	std::vector<uint32_t> m_bucketOfItem; ///< Cubeta de cada elemento, entre las dos pasadas.
+	std::vector<uint32_t> m_bucketStart;  ///< `m_entries[m_bucketStart[b], m_bucketStart[b + 1])`.
+	uint32_t m_bucketMask = 0;
+	float m_cellSize = 1.0f;
+	float m_inverseCellSize = 1.0f;
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+#include "Render/TextureAtlas.h"
+
+struct ShapeGeometry;
+
+/**
+ * @class Sprite
+ * @brief Componente que dibuja una imagen de un `TextureAtlas` como un rectngulo.
+ *
+ * No guarda figura ni textura propias: dibuja el cuadrado unidad compartido de
+ * `ShapeGeometryLibrary`, estirado a su tamao por la matriz, con el rectngulo de su regin en
+ * la pgina del atlas (`RenderCommandBuffer::drawSprite`). Los sprites de una capa que usan la
+ * misma pgina se dibujan en un solo lote, sin cambiar de textura entre uno y otro.
+ *
+ * El tamao es el de la imagen en pxeles salvo que se d otro con `setSize`; el origen es la
+ * fraccin del rectngulo que cae en la posicin del `Transform` (por defecto el centro).
+ */
+class
+Sprite : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::SPRITE;
+
+	Sprite() : Component(ComponentType::SPRITE) {}
+
+	void
+	update(float deltaTime) override {}
+
+	/**
+	 * @brief Agrega el sprite, si su regin tiene pgina.
+	 */
+	void
+	render(RenderCommandBuffer& commands) override;
+
+	/**
+	 * @brief Vincula el `Transform` de la misma entidad; sin l el sprite queda en el origen.
+	 */
+	void
+	setTransform(const Transform* transform) { m_transform = transform; }
+
+	/**
+	 * @param atlas Debe vivir mientras el sprite se dibuje.
+	 * @param region Id de `TextureAtlas::add`.
+	 */
+	void
+	setImage(const TextureAtlas* atlas, uint32_t region);
+
+	/**
+	 * @brief Como `setImage`, buscando la regin por nombre.
+	 * @return `false` si el atlas no la tiene; el sprite queda sin imagen.
+	 */
+	bool
+	setImage(const TextureAtlas* atlas, std::string_view name);
+
+	const TextureAtlas*
+	getAtlas() const { return m_atlas; }
+
+	uint32_t
+	getRegion() const { return m_region; }
+
+	/**
+	 * @brief Tamao en unidades del mundo; `(0, 0)` vuelve al de la imagen.
+	 */
+	void
+	setSize(const sf::Vector2f& size);
+
+	sf::Vector2f
+	getSize() const;
+
+	/**
+	 * @brief Punto del rectngulo que va en la posicin, de `(0, 0)` (arriba a la izquierda)
+	 *        a `(1, 1)`.
+	 */
+	void
+	setOrigin(const sf::Vector2f& origin);
+
+	const sf::Vector2f&
+	getOrigin() const { return m_origin; }
+
+	void
+	setColor(sf::Color color);
+
+	sf::Color
+	getColor() const { return m_color; }
+
+	void
+	setLayer(uint8_t layer);
+
+	uint8_t
+	getLayer() const { return m_layer; }
+
+private:
+	const Transform* m_transform = nullptr;
+	const TextureAtlas* m_atlas = nullptr;
+	const ShapeGeometry* m_square = nullptr;   ///< Cuadrado unidad de `ShapeGeometryLibrary`.
+	uint32_t m_region = TextureAtlas::kInvalidRegion;
+	sf::Vector2f m_size;                        ///< `(0, 0)`: el de la imagen.
+	sf::Vector2f m_origin{ 0.5f, 0.5f };
+	sf::Color m_color = sf::Color::White;
+	uint8_t m_layer = 0;
+};
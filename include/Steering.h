@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Prerequisites.h"
+#include "ECS/World.h"
+#include "SpatialHash.h"
+#include "Simulation/UpdateLod.h"
+
+class JobSystem;
+class Transform;
+
+/**
+ * @brief Peso de cada comportamiento en la mezcla de `SteeringAgent`; 0 lo apaga.
+ */
+struct SteeringWeights {
+	float seek = 0.0f;        ///< Hacia `target` a toda velocidad.
+	float flee = 0.0f;        ///< Lejos de `target`.
+	float arrive = 0.0f;      ///< Hacia `target`, frenando dentro de `slowingRadius`.
+	float pursue = 0.0f;      ///< Hacia donde estar `quarry`.
+	float evade = 0.0f;       ///< Lejos de donde estar `quarry`.
+	float wander = 0.0f;      ///< Paseo al azar, sin cambios bruscos.
+	float separation = 0.0f;  ///< Lejos de los vecinos, ms cuanto ms cerca.
+	float alignment = 0.0f;   ///< Hacia la velocidad media de los vecinos.
+	float cohesion = 0.0f;    ///< Hacia el centro de los vecinos.
+};
+
+/**
+ * @brief Componente de datos de un agente que se mueve con `SteeringSystem`.
+ *
+ * Quien decide a dnde ir (un recorrido, la IA) escribe `target`, `quarry` y los pesos; el
+ * sistema escribe `velocity` y la posicin del `Transform`. Cada comportamiento pide una
+ * fuerza (velocidad deseada menos la actual), se suman con sus pesos y el total se recorta a
+ * `maxForce`.
+ */
+struct SteeringAgent {
+	SteeringWeights weights;
+	sf::Vector2f target;            ///< Punto de seek, flee y arrive.
+	EntityId quarry;                ///< Entidad del `World` para pursue y evade; nula las apaga.
+	sf::Vector2f velocity;          ///< Unidades por segundo; la escribe el sistema.
+	float maxSpeed = 200.0f;        ///< Unidades por segundo.
+	float maxForce = 400.0f;        ///< Cambio de velocidad por segundo.
+	float arriveRadius = 10.0f;     ///< Dentro, arrive pide quedarse quieto.
+	float slowingRadius = 80.0f;    ///< Dentro, arrive frena en proporcin a la distancia.
+	float neighborRadius = 48.0f;   ///< Alcance de separation, alignment y cohesion.
+	float wanderRadius = 24.0f;     ///< Crculo del que sale el punto de wander.
+	float wanderDistance = 48.0f;   ///< Distancia del crculo por delante del agente.
+	float wanderJitter = 4.0f;      ///< Radianes por segundo que puede girar el punto.
+	float wanderAngle = 0.0f;       ///< Posicin del punto en el crculo; la escribe el sistema.
+};
+
+/**
+ * @class SteeringSystem
+ * @brief Mueve todas las entidades con `SteeringAgent` y `Transform` mezclando sus
+ *        comportamientos, por lotes y en paralelo.
+ *
+ * Cada `update` junta posiciones y velocidades en arreglos separados (SoA), reparte a los
+ * agentes en un `SpatialHash` (celdas del tamao del mayor `neighborRadius`, sin memoria
+ * nueva una vez que crecieron los arreglos) y calcula las fuerzas en trozos de
+ * `kGrain` agentes en el `JobSystem`. Las velocidades nuevas van a otro arreglo, as que
+ * todos ven a sus vecinos como estaban al empezar el frame. Al final escribe velocidad,
+ * `wanderAngle` y posicin.
+ *
+ * Los vecinos de un agente son los que estn a menos de `neighborRadius`, a lo ms
+ * `kMaxNeighbors`. La presa de pursue y evade se busca entre los agentes del lote; si no es
+ * uno, se usa su `Transform` quieto.
+ *
+ * Con un `UpdateLod`, a los agentes lejanos o fuera de la vista les toca calcular fuerzas
+ * solo cada tantos pasos. Entre medio siguen con su ltima velocidad, y al tocarles la
+ * fuerza se aplica por todo lo que saltaron: giran igual de rpido, a saltos. Siguen contando
+ * como vecinos de los dems.
+ *
+ * No hace cambios estructurales; el `World` no debe cambiar durante `update`.
+ */
+class
+SteeringSystem {
+public:
+	static constexpr size_t kGrain = 256;          ///< Agentes por trabajo.
+	static constexpr uint32_t kMaxNeighbors = 16;  ///< Vecinos que cuenta cada agente.
+	static constexpr float kMaxPrediction = 1.0f;  ///< Segundos que pursue y evade miran adelante.
+
+	/**
+	 * @brief Un paso de `deltaTime` segundos para todos los agentes de `world`.
+	 * @param lod Si no es nulo, decide a quin le toca calcular fuerzas este paso.
+	 */
+	void
+	update(World& world, JobSystem& jobs, float deltaTime, const UpdateLod* lod = nullptr);
+
+	/**
+	 * @brief Agentes del ltimo `update`.
+	 */
+	size_t
+	agentCount() const { return m_agents.size(); }
+
+	/**
+	 * @brief Agentes que calcularon fuerzas en el ltimo `update`.
+	 */
+	size_t
+	steeredCount() const { return m_steeredCount; }
+
+private:
+	/**
+	 * @brief Llena los arreglos con los agentes de `world` y resuelve sus presas.
+	 */
+	void
+	gather(World& world, const UpdateLod* lod);
+
+	/**
+	 * @brief Rehace `m_neighbors` con las posiciones del frame.
+	 */
+	void
+	buildNeighborGrid();
+
+	/**
+	 * @brief Fuerzas y velocidades nuevas de los agentes `[begin, end)`.
+	 */
+	void
+	steer(size_t begin, size_t end, float deltaTime);
+
+	std::vector<EntityId> m_ids;
+	std::vector<SteeringAgent*> m_agents;
+	std::vector<Transform*> m_transforms;
+	std::vector<float> m_x, m_y, m_vx, m_vy;     ///< Estado al empezar el frame.
+	std::vector<float> m_nextVx, m_nextVy;       ///< Velocidades nuevas.
+	std::vector<uint32_t> m_interval;            ///< Pasos que cubre la fuerza de cada agente; 0 si no le toca.
+	std::vector<float> m_quarryX, m_quarryY;     ///< Presa de cada agente, si tiene.
+	std::vector<float> m_quarryVx, m_quarryVy;
+	SpatialHash m_neighbors;                     ///< Agentes por celda; el elemento es el ndice del agente.
+	std::vector<uint32_t> m_slotOfEntity;        ///< Agente de cada `EntityId::index`, para las presas.
+	uint32_t m_frame = 0;                        ///< Semilla de wander.
+	size_t m_steeredCount = 0;
+};
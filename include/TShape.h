@@ -0,0 +1,114 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include "Prerequisites.h"
+#include "ECS/World.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/ShapeGeometry.h"
+
+/**
+ * @brief Medidas de cada tipo de figura, conocidas al compilar.
+ *
+ * `kWidth` y `kHeight` son el tamao que se pide a `ShapeGeometryLibrary` (radio para crculos
+ * y tringulos, lados para rectngulos); `kReach` es la mayor distancia de un punto de la
+ * figura a su origen local (la esquina de arriba a la izquierda, como en SFML), para descartar
+ * sin mirar los puntos. `ShapeFactory` y `TShape` sacan de aqu las mismas figuras.
+ */
+template<ShapeType Type>
+struct ShapeTraits;
+
+template<>
+struct ShapeTraits<CIRCLE> {
+	static constexpr float kWidth = 10.0f;
+	static constexpr float kHeight = 10.0f;
+	static constexpr size_t kPointCount = 30;
+	static constexpr float kReach = 2.0f * kWidth;
+};
+
+template<>
+struct ShapeTraits<RECTANGLE> {
+	static constexpr float kWidth = 100.0f;
+	static constexpr float kHeight = 50.0f;
+	static constexpr size_t kPointCount = 4;
+	static constexpr float kReach = 111.804f;   ///< La diagonal, redondeada hacia arriba.
+};
+
+template<>
+struct ShapeTraits<TRIANGLE> {
+	static constexpr float kWidth = 50.0f;
+	static constexpr float kHeight = 50.0f;
+	static constexpr size_t kPointCount = 3;
+	static constexpr float kReach = 2.0f * kWidth;
+};
+
+/**
+ * @brief Geometra compartida del tipo `Type` con `texture`. Toma el candado de la biblioteca:
+ *        una vez por figura creada o por recorrido, no por figura dibujada.
+ */
+template<ShapeType Type>
+const ShapeGeometry*
+findShapeGeometry(const sf::Texture* texture = nullptr) {
+	using Traits = ShapeTraits<Type>;
+	return EngineUtilities::TService<ShapeGeometryLibrary>::instance().find(Type,
+		sf::Vector2f(Traits::kWidth, Traits::kHeight), Traits::kPointCount, texture);
+}
+
+/**
+ * @brief Figura como dato del `World`, sin `Actor` ni `ShapeFactory`: para multitudes de
+ *        figuras que solo se dibujan.
+ *
+ * Cada tipo es un componente distinto, as que las figuras de un tipo quedan juntas en las
+ * columnas de sus arquetipos, y `recordShapes<Type>` las recorre en un bucle sin llamadas
+ * virtuales ni `switch`: la geometra, el contorno y el alcance para descartar son del tipo.
+ *
+ *     EntityId id = world.createEntity();
+ *     world.addComponent<TShape<CIRCLE>>(id, TShape<CIRCLE>{ { 40.0f, 60.0f } });
+ */
+template<ShapeType Type>
+struct TShape {
+	using Traits = ShapeTraits<Type>;
+
+	sf::Vector2f position;                  ///< Del origen local, como `sf::Transformable`.
+	float rotation = 0.0f;                  ///< Grados.
+	float scale = 1.0f;
+	sf::Color color = sf::Color::White;
+	uint8_t layer = 0;                      ///< `DrawState::layer`.
+
+	sf::Transform
+	transform() const {
+		sf::Transform result;
+		result.translate(position).rotate(rotation).scale(scale, scale);
+		return result;
+	}
+};
+
+/**
+ * @brief Graba las `TShape<Type>` de `world` que tocan `commands.visibleArea()` (todas si no
+ *        se conoce).
+ */
+template<ShapeType Type>
+void
+recordShapes(World& world, RenderCommandBuffer& commands) {
+	const ShapeGeometry* geometry = findShapeGeometry<Type>();
+	if (!geometry) {
+		return;
+	}
+	const sf::FloatRect& visible = commands.visibleArea();
+	bool cull = visible.width > 0.0f && visible.height > 0.0f;
+	float right = visible.left + visible.width;
+	float bottom = visible.top + visible.height;
+	world.view<const TShape<Type>>().each([&](EntityId, const TShape<Type>& shape) {
+		float reach = ShapeTraits<Type>::kReach * std::abs(shape.scale);
+		if (cull && (shape.position.x + reach < visible.left || shape.position.x - reach > right ||
+		             shape.position.y + reach < visible.top || shape.position.y - reach > bottom)) {
+			return;
+		}
+		commands.drawShared(*geometry->shape, shape.transform(), shape.color, shape.layer, geometry->outline);
+	});
+}
+
+/**
+ * @brief `recordShapes` de los tres tipos.
+ */
+void
+recordShapeInstances(World& world, RenderCommandBuffer& commands);
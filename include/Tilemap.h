@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Transform.h"
+
+/**
+ * @class Tilemap
+ * @brief Componente que dibuja un mapa de baldosas de un tileset, partido en trozos de
+ *        `kChunkTiles` x `kChunkTiles` con su arreglo de vrtices ya armado.
+ *
+ * Un mapa de 1000 x 1000 con un `ShapeFactory` por baldosa son un milln de entidades; aqu es
+ * un componente y, por frame, un comando por trozo visible. Cada trozo guarda sus tringulos en
+ * coordenadas del mapa y solo se vuelve a armar cuando cambia una de sus baldosas (o el tileset
+ * o el tamao), en el siguiente `render`. Los trozos fuera de
+ * `RenderCommandBuffer::visibleArea` no se graban; si el buffer no la conoce, se graban todos.
+ *
+ * La baldosa `id` es la celda `id` del tileset, contando de izquierda a derecha y de arriba
+ * abajo; `kEmptyTile` no dibuja nada. La posicin, el giro y la escala del mapa salen del
+ * `Transform` vinculado. Un trozo que acaba de armarse ensucia su capa en `LayerCache`.
+ */
+class
+Tilemap : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::TILEMAP;
+
+	using TileId = uint16_t;
+
+	static constexpr TileId kEmptyTile = 0xFFFF;
+	static constexpr uint32_t kChunkTiles = 32; ///< Baldosas por lado de un trozo.
+
+	Tilemap() : Component(ComponentType::TILEMAP) {}
+
+	void
+	update(float deltaTime) override {}
+
+	/**
+	 * @brief Arma los trozos visibles que cambiaron y agrega un comando por cada uno con baldosas.
+	 */
+	void
+	render(RenderCommandBuffer& commands) override;
+
+	/**
+	 * @brief Vincula el `Transform` de la misma entidad; sin l el mapa empieza en el origen.
+	 */
+	void
+	setTransform(const Transform* transform) { m_transform = transform; }
+
+	/**
+	 * @brief Redimensiona el mapa a `width` x `height` baldosas, todas vacas.
+	 */
+	void
+	resize(uint32_t width, uint32_t height);
+
+	uint32_t
+	getWidth() const { return m_width; }
+
+	uint32_t
+	getHeight() const { return m_height; }
+
+	/**
+	 * @param texture Atlas de baldosas; debe vivir mientras el mapa se dibuje.
+	 * @param tilePixels Lado de una baldosa en el atlas, en pxeles.
+	 */
+	void
+	setTileset(const sf::Texture* texture, uint32_t tilePixels);
+
+	/**
+	 * @brief Lado de una baldosa en unidades del mapa.
+	 */
+	void
+	setTileSize(float size);
+
+	float
+	getTileSize() const { return m_tileSize; }
+
+	void
+	setLayer(uint8_t layer) { m_layer = layer; markChanged(); }
+
+	/**
+	 * @brief Cambia una baldosa; fuera del mapa no hace nada. Solo su trozo se vuelve a armar.
+	 */
+	void
+	setTile(uint32_t x, uint32_t y, TileId tile);
+
+	TileId
+	getTile(uint32_t x, uint32_t y) const;
+
+	/**
+	 * @brief Todas las baldosas, fila por fila (`width * height`); si no alcanza, el resto
+	 *        queda vaco.
+	 */
+	void
+	setTiles(std::span<const TileId> tiles);
+
+	/**
+	 * @brief Trozos armados desde el principio, para comprobar que no pasa cada frame.
+	 */
+	size_t
+	rebuildCount() const { return m_rebuilds; }
+
+private:
+	struct Chunk {
+		sf::VertexArray vertices{ sf::Triangles };
+		bool dirty = true;
+	};
+
+	/**
+	 * @brief Vuelve a armar los tringulos del trozo `(chunkX, chunkY)`.
+	 */
+	void
+	rebuild(uint32_t chunkX, uint32_t chunkY);
+
+	void
+	markAllDirty();
+
+	const Transform* m_transform = nullptr;
+	const sf::Texture* m_tileset = nullptr;
+	uint32_t m_tilePixels = 16;
+	uint32_t m_tilesetColumns = 0;        ///< Baldosas por fila del atlas.
+	float m_tileSize = 16.0f;
+	uint32_t m_width = 0;
+	uint32_t m_height = 0;
+	uint32_t m_chunksX = 0;
+	uint32_t m_chunksY = 0;
+	std::vector<TileId> m_tiles;          ///< Fila por fila.
+	std::vector<Chunk> m_chunks;          ///< Fila por fila de trozos.
+	uint8_t m_layer = 0;
+	size_t m_rebuilds = 0;
+};
@@ -0,0 +1,217 @@
+#pragma once
+#include <span>
+#include "Prerequisites.h"
+#include "Component.h"
+#include "Render/RenderCommandBuffer.h"
+
+/**
+ * @class Transform
+ * @brief Posicin, rotacin y escala de una entidad, con sus matrices en cach.
+ *
+ * Las matrices local y de mundo solo se recalculan cuando cambi algo: cambiar la posicin,
+ * la rotacin o la escala marca la local como sucia, y la de mundo se recalcula cuando la
+ * local est sucia o cuando el padre recalcul la suya (cada `Transform` lleva una versin
+ * que sube con cada reclculo de su matriz de mundo). Un actor que no se mueve no paga nada.
+ *
+ * Las matrices se recalculan al pedirlas, as que un `Transform` no debe leerse desde un
+ * hilo mientras otro lo modifica. Las jerarquas de actores (`SceneGraph`) dejan las de mundo
+ * calculadas una vez por frame, en orden y por lotes, sin subir por los padres al pedirlas.
+ *
+ * Cada setter que cambia algo sube su `getChangeTick`, para `WorldView::eachChanged`. Mover el
+ * padre no lo sube: quien necesite la matriz de mundo tambin debe mirar la jerarqua.
+ *
+ * Con paso fijo (`BaseApp::setSimulationRate`) el render cae entre dos pasos de simulacin.
+ * El primer cambio de cada paso guarda el estado anterior, y `getRenderTransform` interpola
+ * entre ese y el actual con `setRenderAlpha`; lo que no se movi en el ltimo paso no paga nada.
+ */
+class
+Transform : public Component {
+public:
+	/**
+	 * @brief Etiqueta de tipo usada por `Entity::getComponent` para evitar `dynamic_cast`.
+	 */
+	static constexpr ComponentType StaticType = ComponentType::TRANSFORM;
+
+	Transform() : Component(ComponentType::TRANSFORM) {}
+
+	virtual
+	~Transform() = default;
+
+	/**
+	 * @brief Deja al da las matrices en cach, para que el render solo las lea.
+	 */
+	void
+	update(float deltaTime) override { getWorldTransform(); }
+
+	/**
+	 * @brief Versin por lotes de `update` para `ComponentUpdater`: mismo trabajo, sin
+	 *        llamada virtual por componente.
+	 * @param components Todos de tipo `Transform`.
+	 */
+	static void
+	updateBatch(std::span<Component* const> components, float deltaTime);
+
+	void
+	render(RenderCommandBuffer& commands) override {}
+
+	void
+	setPosition(float x, float y) { setPosition(sf::Vector2f(x, y)); }
+
+	void
+	setPosition(const sf::Vector2f& position);
+
+	const sf::Vector2f&
+	getPosition() const { return m_position; }
+
+	/**
+	 * @brief Desplaza la posicin actual.
+	 */
+	void
+	move(const sf::Vector2f& offset) { setPosition(m_position + offset); }
+
+	/**
+	 * @param degrees ngulo en grados, igual que `sf::Transformable`.
+	 */
+	void
+	setRotation(float degrees);
+
+	float
+	getRotation() const { return m_rotation; }
+
+	void
+	rotate(float degrees) { setRotation(m_rotation + degrees); }
+
+	void
+	setScale(float x, float y) { setScale(sf::Vector2f(x, y)); }
+
+	void
+	setScale(const sf::Vector2f& scale);
+
+	const sf::Vector2f&
+	getScale() const { return m_scale; }
+
+	/**
+	 * @brief Cuelga este transform de otro; la matriz de mundo pasa a ser padre * local.
+	 * @param parent Transform padre, o nulo. Debe seguir vivo mientras sea el padre.
+	 */
+	void
+	setParent(const Transform* parent);
+
+	const Transform*
+	getParent() const { return m_parent; }
+
+	/**
+	 * @brief Matriz local (posicin, rotacin y escala), recalculada solo si cambi.
+	 */
+	const sf::Transform&
+	getLocalTransform() const;
+
+	/**
+	 * @brief Matriz de mundo, recalculada solo si cambi la local o la del padre.
+	 */
+	const sf::Transform&
+	getWorldTransform() const;
+
+	/**
+	 * @brief Sube cada vez que cambia la matriz de mundo (tambin por un padre). Quien guarda
+	 *        algo calculado con ella la compara para saber si sigue valiendo.
+	 */
+	uint32_t
+	getWorldVersion() const { getWorldTransform(); return m_worldVersion; }
+
+	/**
+	 * @brief Matriz de mundo para dibujar: entre el estado del paso anterior y el actual,
+	 *        segn `setRenderAlpha`. Sin moverse en el ltimo paso es `getWorldTransform`.
+	 */
+	sf::Transform
+	getRenderTransform() const;
+
+	/**
+	 * @brief Los cambios de este paso no se interpolan: la entidad aparece ya en su lugar.
+	 *        Para lo recin creado o sacado de un pool, y para teletransportes.
+	 */
+	void
+	snapInterpolation();
+
+	/**
+	 * @brief Empieza un paso de simulacin; lo llama el bucle de paso fijo antes de cada `update`.
+	 */
+	static void
+	beginSimulationStep() { ++s_simulationStep; }
+
+	static uint32_t
+	getSimulationStep() { return s_simulationStep; }
+
+	/**
+	 * @brief Fraccin del paso siguiente ya transcurrida al dibujar, en [0, 1]; 1 dibuja el
+	 *        estado actual sin interpolar.
+	 */
+	static void
+	setRenderAlpha(float alpha) { s_renderAlpha = alpha; }
+
+	static float
+	getRenderAlpha() { return s_renderAlpha; }
+
+	/**
+	 * @brief Indica si la matriz local debe recalcularse.
+	 */
+	bool
+	isDirty() const { return m_localDirty; }
+
+	/**
+	 * @brief Sube con cada cambio de posicin, rotacin o escala.
+	 */
+	uint32_t
+	getLocalVersion() const { return m_localVersion; }
+
+private:
+	friend class SceneGraph;
+
+	/**
+	 * @brief Deja `world` como matriz de mundo ya calculada; lo llama `SceneGraph` despus de
+	 *        actualizar al padre, as que no hace falta volver a subir por l.
+	 */
+	void
+	setWorldTransform(const sf::Transform& world) const;
+
+	/**
+	 * @brief Antes de un cambio: el primero del paso guarda el estado anterior.
+	 */
+	void
+	keepPrevious() {
+		if (m_previousStep != s_simulationStep) {
+			m_previousStep = s_simulationStep;
+			m_previousPosition = m_position;
+			m_previousRotation = m_rotation;
+			m_previousScale = m_scale;
+		}
+	}
+
+	/**
+	 * @brief Despus de un cambio: marca la matriz y, si el paso no se interpola, lo sigue.
+	 */
+	void
+	changed();
+
+	inline static uint32_t s_simulationStep = 1; ///< Paso de simulacin actual.
+	inline static float s_renderAlpha = 1.0f;    ///< Ver `setRenderAlpha`.
+
+	sf::Vector2f m_position{ 0.0f, 0.0f };
+	float m_rotation = 0.0f;                   ///< Grados.
+	sf::Vector2f m_scale{ 1.0f, 1.0f };
+	const Transform* m_parent = nullptr;       ///< Padre en la jerarqua, o nulo.
+
+	sf::Vector2f m_previousPosition{ 0.0f, 0.0f }; ///< Estado antes del paso `m_previousStep`.
+	float m_previousRotation = 0.0f;
+	sf::Vector2f m_previousScale{ 1.0f, 1.0f };
+	uint32_t m_previousStep = 0;               ///< Paso en que se guard el estado anterior.
+	uint32_t m_snapStep = s_simulationStep;    ///< Paso cuyos cambios no se interpolan; el de creacin.
+
+	mutable sf::Transform m_local;             ///< Cach de la matriz local.
+	mutable sf::Transform m_world;             ///< Cach de la matriz de mundo.
+	mutable bool m_localDirty = true;          ///< Cambi posicin, rotacin o escala.
+	mutable bool m_worldDirty = true;          ///< Cambi la local o el padre.
+	mutable uint32_t m_worldVersion = 0;       ///< Sube cada vez que se recalcula `m_world`.
+	mutable uint32_t m_parentVersion = 0;      ///< Versin del padre usada en `m_world`.
+	uint32_t m_localVersion = 0;               ///< Ver `getLocalVersion`.
+};
@@ -1,16 +1,84 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <vector>
 #include "Prerequisites.h"
+#include "Render/ShapeBatcher.h"
+#include "Render/InstancedShapeRenderer.h"
+#include "Render/GpuCrowd.h"
+#include "Render/SdfShapeRenderer.h"
+#include "Render/MeshPipeline.h"
+#include "Render/RenderStats.h"
+#include "Render/GpuTimer.h"
+#include "Render/TextBatcher.h"
+#include "Render/PostEffects.h"
+#include "Render/DynamicResolution.h"
+#include "Render/FrameCapture.h"
+#include "Audio/AudioStats.h"
+#include "Input/EventPump.h"
+#include "Jobs/JobSystem.h"
+#include "Net/NetStats.h"
+#include "Profiling/EntityCostProfiler.h"
+#include "Profiling/FrameTimeHistogram.h"
+#include "Profiling/Profiler.h"
+
+class RenderCommandBuffer;
 
 class 
 Window {
 public:
 	Window() = default;
-	Window(int width, int height, const std::string& title);
+	/**
+	 * @param headless Dibujar en una `sf::RenderTexture` con la ventana oculta y sin vsync, para
+	 *        medir sin pantalla y sin el tope del monitor.
+	 * @param eventThread Crear la ventana en un `EventPump` y leer sus eventos de su cola: mover o
+	 *        cambiar el tamao de la ventana no frena la simulacin. Sin efecto con `headless`.
+	 */
+	Window(int width, int height, const std::string& title, bool headless = false, bool eventThread = false);
 	~Window();
 
+	/**
+	 * @brief No se copia: es duea de `m_window` y la destruye al destruirse.
+	 */
+	Window(const Window&) = delete;
+	Window&
+	operator=(const Window&) = delete;
+
 	void
 	handleEvents();
 
+	/**
+	 * @brief Duerme hasta que llegue un evento de la ventana o pase `timeout`; el evento queda
+	 *        para el prximo `handleEvents`. Con `timeout` negativo espera sin lmite
+	 *        (`sf::Window::waitEvent`); con lmite se mira la cola cada `kEventPollSlice`, as
+	 *        que la entrada despierta casi en el acto.
+	 * @return `true` si lleg un evento.
+	 */
+	bool
+	waitForEvent(std::chrono::steady_clock::duration timeout);
+
+	static constexpr std::chrono::milliseconds kEventPollSlice{ 4 };
+
+	/**
+	 * @brief `true` si los eventos llegan de un `EventPump`.
+	 */
+	bool
+	hasEventThread() const { return m_eventPump.isRunning(); }
+
+	/**
+	 * @brief La ventana tiene el foco; siempre `true` sin pantalla.
+	 */
+	bool
+	hasFocus() const { return m_offscreen || (m_window && m_window->hasFocus()); }
+
+	/**
+	 * @brief Cundo lleg el ltimo evento de teclado, mouse, toque o mando (o la ventana cambi).
+	 */
+	std::chrono::steady_clock::time_point
+	lastInputTime() const { return m_lastInput; }
+
 	/**
 	 * @brief Limpia el contenido de la ventana con el color predeterminado.
 	 */
@@ -18,7 +86,9 @@ public:
 	clear();
 
 	/**
-	 * @brief Muestra el contenido de la ventana en la pantalla.
+	 * @brief Muestra el contenido de la ventana en la pantalla y cierra las estadsticas del
+	 *        frame (`stats`). La escena pasa antes por `postProcess`; con el overlay activo, las
+	 *        estadsticas se dibujan encima, sin efectos.
 	 */
 	void 
 	display();
@@ -26,7 +96,8 @@ public:
 	/**
 	 * @brief Verifica si la ventana sigue abierta.
 	 *
-	 * @return true si la ventana est abierta, false en caso contrario.
+	 * @return true si la ventana est abierta, false en caso contrario. Cerrarla desde el
+	 *         sistema da `false` enseguida, pero la ventana se cierra al destruirse.
 	 */
 	bool 
 	isOpen() const;
@@ -35,9 +106,29 @@ public:
 	 * @brief Dibuja un objeto que puede ser dibujado en la ventana.
 	 *
 	 * @param drawable Referencia a un objeto SFML que puede ser dibujado.
+	 * @param states Estados de render; el de una entidad lleva la matriz de su `Transform`.
 	 */
 	void 
-	draw(const sf::Drawable& drawable);
+	draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	/**
+	 * @brief Ordena los comandos del frame y los dibuja todos: primero las mallas 3D
+	 *        (`MeshPipeline`), despus las figuras en lotes (`ShapeBatcher`). Las capas en
+	 *        `LayerCache` se pegan desde su textura si no cambiaron.
+	 *
+	 * @param commands Comandos agregados por los componentes; el buffer no se vaca.
+	 */
+	void
+	submit(RenderCommandBuffer& commands);
+
+	/**
+	 * @brief `submit` una vez por vista con los mismos comandos, grabados y ordenados una sola
+	 *        vez: pantalla dividida, minimapa o imagen dentro de imagen. El viewport de cada vista
+	 *        elige dnde se dibuja, en orden, as que lo que va encima va ltimo. Al terminar el
+	 *        destino vuelve a la vista que tena. Otra `Window` puede dibujar el mismo buffer.
+	 */
+	void
+	submit(RenderCommandBuffer& commands, std::span<const sf::View> views);
 
 	/**
 	 * @brief Obtiene el objeto interno SFML RenderWindow.
@@ -47,6 +138,250 @@ public:
 	sf::RenderWindow* 
 	getWindow();
 
+	/**
+	 * @brief Donde se dibuja la escena: su propia textura si hay efectos activos o la resolucin
+	 *        est reducida; si no, la de `headless` o la ventana. Vista y tamao del dibujo se
+	 *        toman de aqu, del hilo que dibuja.
+	 */
+	sf::RenderTarget&
+	getTarget();
+
+	/**
+	 * @brief Lo que `display` muestra: la textura de `headless` o la ventana. Dueo del contexto.
+	 */
+	sf::RenderTarget&
+	presentTarget();
+
+	/**
+	 * @brief Efectos de pantalla completa sobre la escena, antes del overlay. Con alguno activo,
+	 *        `clear` crea una textura del tamao de la ventana para la escena y `display` la pasa
+	 *        por la pila. Con `RenderThread`, se arma antes de empezar.
+	 */
+	PostProcessStack&
+	postProcess() { return m_postProcess; }
+
+	/**
+	 * @brief Pases del ltimo `display` (efectos, escalado, overlay), para ver cuntos se
+	 *        descartaron y cuntas texturas compartieron.
+	 */
+	const RenderGraph&
+	frameGraph() const { return m_frameGraph; }
+
+	/**
+	 * @brief Capturas y grabacin del frame mostrado, overlay incluido; se leen sin esperar a la
+	 *        GPU. Se piden desde cualquier hilo.
+	 */
+	FrameCapture&
+	frameCapture() { return m_capture; }
+
+	/**
+	 * @brief Ajusta sola la resolucin de la escena (`DynamicResolution`) con el tiempo de GPU de
+	 *        cada frame; `display` la estira a la ventana. Enciende `setGpuTiming`. Con `RenderThread`,
+	 *        se elige antes de empezar.
+	 * @return `false` si el driver no tiene consultas de tiempo; se sigue a resolucin completa.
+	 */
+	bool
+	setDynamicResolution(bool enabled, const DynamicResolution::Settings& settings = {});
+
+	bool
+	isDynamicResolution() const { return m_dynamicResolutionEnabled; }
+
+	/**
+	 * @brief Escala de la escena respecto a `presentTarget`, por lado. Desde cualquier hilo.
+	 */
+	float
+	resolutionScale() const { return m_resolutionScale.load(std::memory_order_relaxed); }
+
+	bool
+	isHeadless() const { return m_offscreen != nullptr; }
+
+	/**
+	 * @brief Lotes de `submit`: estadsticas del ltimo frame y opcin de desactivarlos.
+	 */
+	ShapeBatcher&
+	shapeBatcher() { return m_batcher; }
+
+	/**
+	 * @brief Escribe los lotes sin textura y las partculas en un bfer en anillo en vez de
+	 *        dejrselos a SFML (`ShapeBatcher::setStreaming`).
+	 * @return `false` si el contexto no soporta OpenGL 3.3; `submit` sigue con SFML.
+	 */
+	bool
+	setStreaming(bool enabled);
+
+	bool
+	isStreaming() const { return m_batcher.isStreaming(); }
+
+	/**
+	 * @brief Dibuja las figuras repetidas con instancing de OpenGL (`InstancedShapeRenderer`).
+	 * @return `false` si el contexto no soporta OpenGL 3.3; `submit` sigue con SFML.
+	 */
+	bool
+	setInstancing(bool enabled);
+
+	bool
+	isInstancing() const { return m_instancing; }
+
+	const InstancedShapeRenderer&
+	instancedRenderer() const { return m_instanced; }
+
+	/**
+	 * @brief Reemplaza la multitud de `GpuCrowd` por `agents`, que siguen `path` en ciclo. Los
+	 *        agentes viven solo en la GPU: `submit` los avanza y los dibuja sobre las figuras.
+	 *        Sin agentes, la multitud se vaca.
+	 * @return `false` si el contexto no tiene compute shaders (OpenGL 4.3).
+	 */
+	bool
+	setGpuCrowd(std::span<const GpuAgent> agents, std::span<const sf::Vector2f> path = {});
+
+	/**
+	 * @brief Suma `deltaTime` al prximo paso de la multitud; se llama desde la simulacin, y
+	 *        el `submit` siguiente avanza lo acumulado de una vez.
+	 */
+	void
+	advanceGpuCrowd(float deltaTime);
+
+	const GpuCrowd&
+	gpuCrowd() const { return m_gpuCrowd; }
+
+	/**
+	 * @brief Dibuja crculos y polgonos regulares como un quad con borde calculado en el shader
+	 *        (`SdfShapeRenderer`); tiene prioridad sobre el instancing.
+	 * @return `false` si el contexto no soporta OpenGL 3.3; `submit` sigue como antes.
+	 */
+	bool
+	setSdfShapes(bool enabled);
+
+	bool
+	isSdfShapes() const { return m_sdfShapes; }
+
+	const SdfShapeRenderer&
+	sdfRenderer() const { return m_sdf; }
+
+	/**
+	 * @brief Camino de las mallas 3D; se inicializa con la primera malla que llega a `submit`.
+	 */
+	const MeshPipeline&
+	meshPipeline() const { return m_meshes; }
+
+	/**
+	 * @brief Pre-paso de profundidad para las mallas opacas (`MeshPipeline::setDepthPrePass`).
+	 *        Con `RenderThread`, se elige antes de empezar.
+	 */
+	void
+	setDepthPrePass(bool enabled) { m_meshes.setDepthPrePass(enabled); }
+
+	/**
+	 * @brief Oclusin por software para las mallas (`MeshPipeline::setOcclusionCulling`).
+	 *        Con `RenderThread`, se elige antes de empezar.
+	 */
+	void
+	setOcclusionCulling(bool enabled) { m_meshes.setOcclusionCulling(enabled); }
+
+	/**
+	 * @brief Sombras en cascadas de la luz direccional (`MeshPipeline::setShadows`), con lo
+	 *        esttico guardado entre frames. Con `RenderThread`, se elige antes de empezar.
+	 */
+	void
+	setShadows(bool enabled) { m_meshes.setShadows(enabled); }
+
+	/**
+	 * @brief Draw calls, vrtices, cambios de estado y bytes subidos del ltimo frame mostrado.
+	 *        Se puede leer desde cualquier hilo.
+	 */
+	RenderStats
+	stats() const;
+
+	/**
+	 * @brief Muestra u oculta las estadsticas en una esquina. La fuente se carga la primera
+	 *        vez desde `fontPath`.
+	 * @return `false` si la fuente no pudo cargarse; el overlay queda oculto.
+	 */
+	bool
+	setStatsOverlay(bool enabled, const std::string& fontPath = kStatsFontPath);
+
+	bool
+	isStatsOverlay() const { return m_statsOverlay.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Texto de la consola (`Console::text`), abajo y sobre todo lo dems; vaco la
+	 *        oculta. Desde cualquier hilo. La fuente es la del overlay.
+	 * @return `false` si la fuente no pudo cargarse.
+	 */
+	bool
+	setConsoleText(const std::string& text, const std::string& fontPath = kStatsFontPath);
+
+	/**
+	 * @brief Sincroniza cada `display` con el refresco de la pantalla. En el hilo que dibuja.
+	 */
+	void
+	setVerticalSync(bool enabled);
+
+	bool
+	isVerticalSync() const { return m_verticalSync; }
+
+	/**
+	 * @brief Lo ltimo del audio, para mostrarlo debajo de las estadsticas de dibujo. Desde
+	 *        cualquier hilo; sin llamarlo el overlay no tiene esas lneas.
+	 */
+	void
+	setAudioStats(const AudioStats& stats);
+
+	AudioStats
+	audioStats() const;
+
+	/**
+	 * @brief Lo ltimo de la red (`NetSession::stats`), debajo del audio. Desde cualquier hilo;
+	 *        sin llamarlo el overlay no tiene esas lneas.
+	 */
+	void
+	setNetStats(const NetStats& stats);
+
+	/**
+	 * @brief Desglose del ltimo frame (`Profiler::lastFrame`), en la esquina superior derecha.
+	 *        Desde cualquier hilo; sin llamarlo el overlay no lo muestra.
+	 */
+	void
+	setProfileFrame(const ProfileFrame& frame);
+
+	/**
+	 * @brief Trabajo de cada hilo del `JobSystem` en el ltimo frame, bajo el desglose. Desde
+	 *        cualquier hilo.
+	 */
+	void
+	setJobTelemetry(const JobTelemetry& telemetry);
+
+	/**
+	 * @brief Percentiles del ltimo perodo (`FrameTimeMonitor`), arriba a la derecha. Desde
+	 *        cualquier hilo.
+	 */
+	void
+	setFrameTimeReport(const FrameTimeReport& report);
+
+	/**
+	 * @brief Los actores ms caros y el costo de cada tipo de componente (`EntityCostProfiler`),
+	 *        bajo el desglose. Desde cualquier hilo; uno sin frames medidos lo saca del overlay.
+	 */
+	void
+	setEntityCosts(const EntityCostReport& report);
+
+	/**
+	 * @brief Mide el tiempo de GPU de cada pase (`GpuTimer`).
+	 * @return `false` si el driver no tiene consultas de tiempo.
+	 */
+	bool
+	setGpuTiming(bool enabled);
+
+	/**
+	 * @brief Tiempos de GPU ms recientes, con unos frames de retraso. Desde cualquier hilo.
+	 */
+	GpuTimings
+	gpuTimings() const;
+
+	static constexpr unsigned int kStatsTextSize = 14;
+	static constexpr const char* kStatsFontPath = "tuffy.ttf"; ///< Junto al ejecutable.
+	static constexpr unsigned int kDepthBits = 24; ///< Bfer de profundidad que se pide para las mallas.
+
 	// Funcion de inicializacion
 	void
 	init();
@@ -63,5 +398,95 @@ public:
 	destroy();
 
 private:
-	sf::RenderWindow* m_window;
+	/**
+	 * @brief Carga la fuente del overlay la primera vez.
+	 */
+	bool
+	loadStatsFont(const std::string& fontPath);
+
+	/**
+	 * @brief Maqueta una vez los nombres del overlay; en el hilo que dibuja.
+	 */
+	void
+	prepareStatsText();
+
+	/**
+	 * @brief Siguiente evento de la ventana, de la cola del `EventPump` si lo hay.
+	 * @return `false` si no hay.
+	 */
+	bool
+	nextEvent(sf::Event& event);
+
+	/**
+	 * @brief Dibuja `text` en una franja oscura al pie de la ventana.
+	 */
+	void
+	drawConsole(const std::string& text);
+
+	/**
+	 * @brief Dibuja `stats` en la esquina superior izquierda y, debajo, el audio y la red si hay;
+	 *        los percentiles del frame y el desglose del profiler, a la derecha.
+	 */
+	void
+	drawStatsOverlay(const RenderStats& stats);
+
+	/**
+	 * @brief Crea, ajusta al tamao de la ventana por la escala o destruye `m_sceneTarget` segn
+	 *        haya efectos activos o resolucin reducida; la vista se conserva.
+	 */
+	void
+	syncSceneTarget();
+
+	sf::RenderWindow* m_window = nullptr;
+	sf::RenderTexture* m_offscreen = nullptr; ///< Solo sin pantalla; se destruye antes que `m_window`.
+	sf::RenderTexture* m_sceneTarget = nullptr; ///< La escena antes de `m_postProcess`; solo con efectos activos.
+	PostProcessStack m_postProcess;
+	RenderGraph m_frameGraph{ m_postProcess.pool() }; ///< Pases de `display`; se declaran de nuevo cada frame.
+	bool m_postProcessUnsupported = false; ///< `m_sceneTarget` no pudo crearse: se dibuja sin efectos.
+	DynamicResolution m_dynamicResolution; ///< Del hilo que dibuja; lo alimenta `display`.
+	bool m_dynamicResolutionEnabled = false;
+	FrameCapture m_capture; ///< Sus PBO viven con `m_window`; se crean con la primera captura.
+	bool m_captureUnsupported = false;
+	std::atomic<float> m_resolutionScale{ 1.0f }; ///< Copia de la escala de `m_sceneTarget`, para leerla desde otros hilos.
+	ShapeBatcher m_batcher; ///< Junta las figuras de `submit`; conserva su memoria entre frames.
+	InstancedShapeRenderer m_instanced; ///< Camino instanciado; sus objetos de GL viven con `m_window`.
+	GpuCrowd m_gpuCrowd; ///< Agentes en la GPU; sus objetos de GL viven con `m_window`.
+	std::atomic<float> m_gpuCrowdTime{ 0.0f }; ///< Segundos de `advanceGpuCrowd` que `submit` todava no avanz.
+	SdfShapeRenderer m_sdf; ///< Crculos y polgonos por distancia; sus objetos de GL viven con `m_window`.
+	MeshPipeline m_meshes; ///< Mallas 3D; sus objetos de GL viven con `m_window`.
+	bool m_instancing = false;
+	bool m_sdfShapes = false;
+	bool m_meshesUnsupported = false; ///< `m_meshes` no pudo inicializarse: las mallas no se dibujan.
+	bool m_closeRequested = false; ///< El usuario cerr la ventana; `isOpen` ya da `false`.
+	std::vector<sf::Event> m_pendingEvents; ///< Los que sac `waitForEvent`.
+	EventPump m_eventPump; ///< Con `eventThread`: duea de `m_window` y de sus mensajes.
+	std::chrono::steady_clock::time_point m_lastInput = std::chrono::steady_clock::now();
+	bool m_verticalSync = false;
+	mutable ENGINE_MUTEX(m_statsMutex);
+	RenderStats m_lastStats; ///< Del ltimo `display`; lo escribe el hilo que dibuja.
+	GpuTimer m_gpuTimer; ///< Solo con `setGpuTiming(true)`; sus consultas viven con `m_window`.
+	GpuTimings m_lastGpuTimings; ///< Copia de `m_gpuTimer.latest()` en el ltimo `display`.
+	AudioStats m_audioStats; ///< De `setAudioStats`.
+	bool m_hasAudioStats = false;
+	NetStats m_netStats; ///< De `setNetStats`.
+	bool m_hasNetStats = false;
+	ProfileFrame m_profileFrame; ///< De `setProfileFrame`.
+	bool m_hasProfileFrame = false;
+	JobTelemetry m_jobTelemetry; ///< De `setJobTelemetry`.
+	bool m_hasJobTelemetry = false;
+	FrameTimeReport m_frameTimes; ///< De `setFrameTimeReport`.
+	bool m_hasFrameTimes = false;
+	EntityCostReport m_entityCosts; ///< De `setEntityCosts`; sin frames medidos no se muestra.
+	std::string m_consoleText; ///< De `setConsoleText`.
+	sf::Font m_statsFont; ///< Se carga una vez; despus solo la lee el hilo que dibuja.
+	bool m_statsFontLoaded = false;
+	TextBatcher m_statsText; ///< Del hilo que dibuja, como todo lo de abajo.
+	TextBatcher::LayoutId m_statsLabels = 0;
+	TextBatcher::LayoutId m_audioLabels = 0;
+	TextBatcher::LayoutId m_netLabels = 0;
+	float m_statsValuesX = 0.0f; ///< Columna de los valores, a la derecha de los nombres.
+	float m_audioTop = 0.0f; ///< Desde la esquina, debajo de las lneas de dibujo.
+	float m_audioHeight = 0.0f; ///< De las lneas de audio; las de red van debajo si las hay.
+	bool m_statsTextReady = false;
+	std::atomic<bool> m_statsOverlay{ false };
 };
\ No newline at end of file
@@ -0,0 +1,220 @@
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+#include "Prerequisites.h"
+#include "AssetStreamer.h"
+#include "Jobs/JobSystem.h"
+#include "Scene/SceneFile.h"
+
+class Actor;
+class ActorPool;
+class SceneWriter;
+
+/**
+ * @brief En qu va una regin de `WorldStreamer`.
+ */
+enum class RegionState : uint8_t {
+	Unloaded,
+	Loading,       ///< Sus pginas se leen en un hilo de trabajo y sus recursos esperan en `AssetStreamer`.
+	Activating,    ///< Sus actores se crean, unos pocos por frame.
+	Active,
+	Unloading      ///< Sus actores se destruyen, unos pocos por frame.
+};
+
+/**
+ * @class WorldStreamer
+ * @brief Mundos grandes partidos en regiones (`SceneRegionRecord`) que se cargan alrededor de
+ *        la cmara o de los jugadores y se descargan cuando quedan lejos. Es un servicio
+ *        (`TService<WorldStreamer>`) y lo avanza `BaseApp::update`.
+ *
+ * La escena queda abierta: los registros de cada regin se leen en su lugar desde el mapeo,
+ * as que lo que no est cerca no ocupa ms que sus pginas en disco. Una regin que entra a
+ * `loadMargin` de alguna de las reas de `setFoci` (las ms cercanas primero, como mucho
+ * `maxLoading` a la vez) pasa por:
+ * - `Loading`: un trabajo de `JobSystem` toca las pginas de sus registros y nombres, para que
+ *   el hilo principal no se frene en fallos de pgina, y sus recursos se piden a
+ *   `AssetStreamer` con la posicin de la regin, as que se ordenan con el resto de la cola.
+ * - `Activating`: cuando ambos terminaron (un recurso que falla no la detiene), `update` crea
+ *   sus actores sin pasar de `activationBudget` segundos por frame, y al final publica
+ *   `RegionActivated`.
+ * Lejos (ms all de `unloadMargin`, mayor que `loadMargin` para no ir y volver en el borde)
+ * se cancelan sus pedidos y sus actores se destruyen con el mismo presupuesto.
+ *
+ * Los actores sin regin los crea `BaseApp::loadScene` como siempre. Solo el hilo principal.
+ */
+class
+WorldStreamer {
+public:
+	static constexpr float kDefaultLoadMargin = 512.0f;            ///< Desde el borde de las reas.
+	static constexpr float kDefaultUnloadMargin = 1024.0f;
+	static constexpr uint32_t kDefaultMaxLoading = 2;
+	static constexpr float kDefaultActivationBudget = 0.001f;      ///< Segundos de `update` por frame.
+
+	WorldStreamer() = default;
+
+	~WorldStreamer() { close(); }
+
+	WorldStreamer(const WorldStreamer&) = delete;
+	WorldStreamer&
+	operator=(const WorldStreamer&) = delete;
+
+	/**
+	 * @brief Mapea la escena `path` y toma sus regiones, todas descargadas.
+	 * @return `false` si no es una escena vlida; una escena sin regiones se abre igual.
+	 */
+	bool
+	open(const std::string& path);
+
+	/**
+	 * @brief Igual, con una escena en memoria que debe vivir hasta `close`.
+	 */
+	bool
+	openMemory(const unsigned char* data, size_t size);
+
+	/**
+	 * @brief Igual, aduendose de `bytes`.
+	 */
+	bool
+	openMemory(std::vector<unsigned char> bytes);
+
+	/**
+	 * @brief Destruye de una vez los actores de todas las regiones y cierra la escena.
+	 */
+	void
+	close();
+
+	bool
+	isOpen() const { return m_scene.size() != 0; }
+
+	/**
+	 * @brief reas del mundo alrededor de las que se cargan regiones: la vista, un jugador.
+	 *        Sin ninguna, todas se descargan.
+	 */
+	void
+	setFoci(std::span<const sf::FloatRect> areas) { m_foci.assign(areas.begin(), areas.end()); }
+
+	/**
+	 * @brief Empieza y termina cargas y crea o destruye actores en `pool`; una vez por frame,
+	 *        antes de `AssetStreamer::update`.
+	 */
+	void
+	update(ActorPool& pool);
+
+	/**
+	 * @brief Activa de una vez todas las regiones descargadas, sin presupuesto y sin esperar
+	 *        sus recursos. Para lockstep, donde cundo aparece un actor no puede depender de
+	 *        la vista ni del disco; despus no se llama a `update`.
+	 */
+	void
+	loadAll(ActorPool& pool);
+
+	/**
+	 * @brief Crea en `pool` el actor de `record`: nombre, transformacin, figura y si est activo.
+	 *        Las etiquetas y capas van aparte (`"EntityMasks"`).
+	 */
+	static EngineUtilities::TSharedPointer<Actor>
+	spawnActor(ActorPool& pool, const SceneFile& scene, const SceneActorRecord& record);
+
+	/**
+	 * @brief Agrega a `writer` las regiones con sus actores y recursos tal como estn en la
+	 *        escena abierta; las mscaras de esos actores van a `owners` y `masks`.
+	 */
+	void
+	save(SceneWriter& writer, std::vector<uint32_t>& owners, std::vector<SceneActorMasks>& masks) const;
+
+	size_t
+	regionCount() const { return m_regions.size(); }
+
+	RegionState
+	state(uint32_t region) const { return region < m_regions.size() ? m_regions[region].state : RegionState::Unloaded; }
+
+	/**
+	 * @brief Actores de regiones vivos ahora.
+	 */
+	size_t
+	actorCount() const { return m_actorCount; }
+
+	void
+	setLoadMargin(float distance) { m_loadMargin = distance; }
+
+	float
+	loadMargin() const { return m_loadMargin; }
+
+	void
+	setUnloadMargin(float distance) { m_unloadMargin = distance; }
+
+	float
+	unloadMargin() const { return m_unloadMargin; }
+
+	void
+	setMaxLoading(uint32_t count) { m_maxLoading = count > 0 ? count : 1; }
+
+	uint32_t
+	maxLoading() const { return m_maxLoading; }
+
+	void
+	setActivationBudget(float seconds) { m_activationBudget = seconds; }
+
+	float
+	activationBudget() const { return m_activationBudget; }
+
+	static WorldStreamer&
+	instance();
+
+private:
+	static constexpr uint32_t kNoMask = ~0u;
+
+	struct Region {
+		RegionState state = RegionState::Unloaded;
+		bool announced = false;                     ///< Public `RegionActivated`.
+		float distance = 0.0f;                      ///< Al rea ms cercana, en el ltimo `update`.
+		uint32_t next = 0;                          ///< Prximo registro a activar.
+		JobCounter prefetch;
+		std::vector<StreamHandle> assets;
+		std::vector<EngineUtilities::TSharedPointer<Actor>> actors;
+	};
+
+	/**
+	 * @brief Prepara las regiones de la escena recin abierta.
+	 */
+	void
+	adopt();
+
+	/**
+	 * @brief Distancia de `region` al rea ms cercana de `setFoci`.
+	 */
+	float
+	distanceTo(const SceneRegionRecord& region) const;
+
+	void
+	beginLoading(uint32_t index);
+
+	/**
+	 * @brief Crea el prximo actor de `region`.
+	 */
+	void
+	activateNext(Region& region, const SceneRegionRecord& record, ActorPool& pool);
+
+	/**
+	 * @brief Deja activa la regin `index` y publica `RegionActivated`.
+	 */
+	void
+	finishActivation(uint32_t index);
+
+	void
+	cancelAssets(Region& region);
+
+	SceneFile m_scene;
+	std::vector<unsigned char> m_bytes;                ///< La escena, si es de `openMemory` con dueo.
+	std::vector<Region> m_regions;                     ///< Una por `SceneFile::regions()`, en el mismo orden.
+	SceneComponents<SceneActorMasks> m_masks;
+	std::vector<uint32_t> m_maskOf;                    ///< Por actor de la escena: ndice en `m_masks`, o `kNoMask`.
+	std::vector<sf::FloatRect> m_foci;
+	std::vector<uint32_t> m_order;                     ///< Regiones por atender en el `update` en curso.
+	size_t m_actorCount = 0;
+	float m_loadMargin = kDefaultLoadMargin;
+	float m_unloadMargin = kDefaultUnloadMargin;
+	uint32_t m_maxLoading = kDefaultMaxLoading;
+	float m_activationBudget = kDefaultActivationBudget;
+};
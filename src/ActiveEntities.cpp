@@ -0,0 +1,34 @@
+#include "ActiveEntities.h"
+#include "Entity.h"
+#include "ECS/ChangeTick.h"
+#include "Render/SpatialGrid.h"
+
+void
+ActiveEntities::add(Entity& entity) {
+	if (entity.m_activeIndex != kNotActive) {
+		return;
+	}
+	entity.m_activeIndex = static_cast<uint32_t>(m_entities.size());
+	m_entities.push_back(&entity);
+	noteChange(currentChangeTick());
+	if (SpatialGrid* grid = EngineUtilities::TService<SpatialGrid>::get()) {
+		grid->insert(entity);
+	}
+}
+
+void
+ActiveEntities::remove(Entity& entity) {
+	uint32_t index = entity.m_activeIndex;
+	if (index == kNotActive) {
+		return;
+	}
+	if (SpatialGrid* grid = EngineUtilities::TService<SpatialGrid>::get()) {
+		grid->remove(entity);
+	}
+	Entity* last = m_entities.back();
+	m_entities[index] = last;
+	last->m_activeIndex = index;
+	m_entities.pop_back();
+	entity.m_activeIndex = kNotActive;
+	noteChange(currentChangeTick());
+}
@@ -1,15 +1,28 @@
 #include "Actor.h"
+#include "ActorPool.h"
 
-Actor::Actor(std::string actorName) {
+Actor::Actor() {
+	// El nombre por defecto se interna una vez para todos
+	static const NameId s_defaultName = NameTable::instance().intern("Actor");
+	m_name = s_defaultName;
+	registry().setName(m_handle, m_name);
+}
+
+Actor::Actor(std::string_view actorName) {
 	// Setup Actor Name
-	m_name = actorName;
+	m_name = NameTable::instance().intern(actorName);
+	registry().setName(m_handle, m_name);
+	setActive(true);
+
+	// Setup Transform
+	EngineUtilities::TIntrusivePtr<Transform> transform = EngineUtilities::MakeIntrusive<Transform>();
+	addComponent(transform);
 
 	// Setup Shape
-	EngineUtilities::TSharedPointer<ShapeFactory> shape = EngineUtilities::MakeShared<ShapeFactory>();
+	EngineUtilities::TIntrusivePtr<ShapeFactory> shape = EngineUtilities::MakeIntrusive<ShapeFactory>();
+	shape->setTransform(transform.get());
 	addComponent(shape);
 
-	// Setup Transform
-
 	// Setup Sprite
 }
 
@@ -17,13 +30,25 @@ void Actor::update(float deltaTime)
 {
 }
 
-void Actor::render(Window& window)
+void Actor::render(RenderCommandBuffer& commands)
 {
 	for (unsigned int i = 0; i < components.size(); i++) {
-		window.draw(*components[i].dynamic_pointer_cast<ShapeFactory>()->getShape());
+		components[i]->render(commands);
 	}
 }
 
+Actor*
+Actor::find(std::string_view name) {
+	NameId id = NameTable::instance().find(name);
+	if (id == kNoName) {
+		return nullptr;
+	}
+	return registry().find<Actor>(registry().findByName(id));
+}
+
 void Actor::destroy()
 {
+	if (m_pool) {
+		m_pool->despawn(*this);
+	}
 }
@@ -0,0 +1,117 @@
+#include "ActorPool.h"
+#include <cassert>
+
+ActorPool::ActorPool(size_t initialCapacity) {
+	while (capacity() < initialCapacity) {
+		grow();
+	}
+}
+
+ActorPool::~ActorPool() {
+	// Soltar las referencias del pool devuelve los actores a la lista libre
+	m_active.clear();
+	assert(m_free.size() == capacity() && "ActorPool destruido con actores an referenciados");
+}
+
+EngineUtilities::TSharedPointer<Actor>
+ActorPool::spawn(NameId name) {
+	if (m_free.empty()) {
+		grow();
+	}
+	Actor* actor = m_free.back();
+	m_free.pop_back();
+
+	actor->m_name = name;
+	EntityRegistry& registry = EngineUtilities::TService<EntityRegistry>::instance();
+	actor->m_handle = registry.acquire(*actor);
+	registry.setName(actor->m_handle, name);
+	actor->setActive(true);
+	// Lo que le pongan al sacarlo aparece ya en su lugar, sin interpolar desde donde qued
+	if (Transform* transform = actor->findComponent<Transform>()) {
+		transform->snapInterpolation();
+	}
+
+	EngineUtilities::TSharedPointer<Actor> handle(actor, Recycler{ this });
+	m_active[actor->m_poolSlot] = handle;
+	return handle;
+}
+
+void
+ActorPool::reserve(size_t count) {
+	while (m_free.size() < count) {
+		grow();
+	}
+}
+
+void
+ActorPool::attachData(Actor& actor, ComponentSignature types, void* slots[kMaxComponentTypes]) {
+	assert(actor.m_pool == this);
+	Entity::world().changeComponents(actor.getEntityId(), types, 0, slots);
+}
+
+void
+ActorPool::despawn(Actor& actor) {
+	assert(actor.m_pool == this);
+	actor.setActive(false);
+	// Puede ser la ltima referencia: en ese caso recycle() se ejecuta aqu mismo
+	m_active[actor.m_poolSlot].reset();
+}
+
+void
+ActorPool::grow() {
+	size_t firstSlot = capacity();
+	EngineUtilities::TUniquePtr<Slot[]> block = EngineUtilities::MakeUnique<Slot[]>(kActorsPerBlock);
+	for (size_t i = 0; i < kActorsPerBlock; ++i) {
+		Slot& slot = block[i];
+		// Referencias permanentes del pool: los componentes viven en el bloque, nunca se hace delete
+		slot.transform.addRef();
+		slot.actor.addComponent(EngineUtilities::TIntrusivePtr<Transform>(&slot.transform));
+		slot.shape.addRef();
+		slot.shape.setTransform(&slot.transform);
+		slot.actor.addComponent(EngineUtilities::TIntrusivePtr<ShapeFactory>(&slot.shape));
+		slot.actor.m_pool = this;
+		slot.actor.m_poolSlot = firstSlot + i;
+		// Los libres no tienen identidad; spawn les da una nueva
+		EngineUtilities::TService<EntityRegistry>::instance().release(slot.actor.m_handle);
+		slot.actor.m_handle = EntityHandle{};
+	}
+	// Se apilan al revs para que spawn() entregue primero los de menor ndice
+	for (size_t i = kActorsPerBlock; i-- > 0;) {
+		m_free.push_back(&block[i].actor);
+	}
+	m_blocks.push_back(std::move(block));
+	m_active.resize(capacity());
+}
+
+void
+ActorPool::recycle(Actor& actor) {
+	actor.setActive(false);
+	EngineUtilities::TIntrusivePtr<ShapeFactory> shape = actor.getComponent<ShapeFactory>();
+	if (shape) {
+		shape->setStatic(false);
+		shape->createShape(ShapeType::EMPTY);
+	}
+	if (Transform* transform = actor.findComponent<Transform>()) {
+		transform->setParent(nullptr);
+		transform->setPosition(0.0f, 0.0f);
+		transform->setRotation(0.0f);
+		transform->setScale(1.0f, 1.0f);
+	}
+	// Los datos que recibi en esta vida se van; quedan las referencias de sus componentes.
+	// Sin World (ya cerrado) se fueron con l
+	if (World* world = EngineUtilities::TService<World>::get()) {
+		ComponentSignature kept = ComponentRegistry::bitOf<ComponentRef<Transform>>() |
+			ComponentRegistry::bitOf<ComponentRef<ShapeFactory>>();
+		ComponentSignature added = world->signatureOf(actor.getEntityId()) & ~kept;
+		if (added) {
+			void* slots[kMaxComponentTypes];
+			world->changeComponents(actor.getEntityId(), 0, added, slots);
+		}
+	}
+	// Quien guard el handle de esta vida ya no encuentra al actor
+	if (EntityRegistry* registry = EngineUtilities::TService<EntityRegistry>::get()) {
+		registry->release(actor.m_handle);
+	}
+	actor.m_handle = EntityHandle{};
+	m_free.push_back(&actor);
+}
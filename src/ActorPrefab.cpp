@@ -0,0 +1,45 @@
+#include "ActorPrefab.h"
+
+ActorPrefab::ActorPrefab(std::string_view name, ShapeType shapeType)
+	: m_name(NameTable::instance().intern(name)), m_shapeType(shapeType) {
+}
+
+ActorPrefab::~ActorPrefab() {
+	for (DataComponent& data : m_data) {
+		data.destroy(data.value);
+	}
+}
+
+EngineUtilities::TSharedPointer<Actor>
+ActorPrefab::instantiate(ActorPool& pool) const {
+	EngineUtilities::TSharedPointer<Actor> actor = pool.spawn(m_name);
+	configure(pool, *actor);
+	return actor;
+}
+
+void
+ActorPrefab::configure(ActorPool& pool, Actor& actor) const {
+	actor.setTags(m_tags);
+	actor.setLayers(m_layers);
+
+	if (Transform* transform = actor.findComponent<Transform>()) {
+		transform->setPosition(m_position);
+		transform->setRotation(m_rotation);
+		transform->setScale(m_scale);
+	}
+
+	if (ShapeFactory* shape = actor.findComponent<ShapeFactory>()) {
+		if (shape->createShape(m_shapeType)) {
+			shape->setFillColor(m_fillColor);
+			shape->setTexture(m_texture);
+		}
+	}
+
+	if (m_dataTypes) {
+		void* slots[kMaxComponentTypes];
+		pool.attachData(actor, m_dataTypes, slots);
+		for (const DataComponent& data : m_data) {
+			data.copy(slots[data.type], data.value);
+		}
+	}
+}
@@ -0,0 +1,159 @@
+#include "Animation/AnimationClip.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ANIMATION_SSE 1
+#endif
+
+namespace {
+	constexpr float kQuantizedMax = 65535.0f;
+	constexpr size_t kBlock = 256;
+
+	/**
+	 * @brief ndices de las llaves de `keys` que hacen falta para que la interpolacin lineal
+	 *        entre ellas no se aparte ms de `tolerance` de ninguna llave.
+	 */
+	std::vector<size_t>
+	reduceKeys(const std::vector<AnimationKey>& keys, float tolerance) {
+		std::vector<size_t> kept;
+		if (keys.empty()) {
+			return kept;
+		}
+		kept.push_back(0);
+		size_t start = 0;
+		for (size_t end = 2; end < keys.size(); ++end) {
+			// Todas las del medio caen sobre la recta de `start` a `end`?
+			const AnimationKey& a = keys[start];
+			const AnimationKey& b = keys[end];
+			float span = b.time - a.time;
+			bool fits = true;
+			for (size_t k = start + 1; k < end && fits; ++k) {
+				float t = span > 0.0f ? (keys[k].time - a.time) / span : 0.0f;
+				fits = std::abs(a.value + (b.value - a.value) * t - keys[k].value) <= tolerance;
+			}
+			if (!fits) {
+				start = end - 1;
+				kept.push_back(start);
+			}
+		}
+		if (keys.size() > 1) {
+			kept.push_back(keys.size() - 1);
+		}
+		return kept;
+	}
+}
+
+AnimationClip
+AnimationClip::build(std::span<const AnimationCurve> curves, bool loop, float tolerance) {
+	AnimationClip clip;
+	clip.m_loop = loop;
+	for (const AnimationCurve& curve : curves) {
+		if (!curve.keys.empty()) {
+			clip.m_duration = std::max(clip.m_duration, curve.keys.back().time);
+		}
+	}
+	clip.m_timeScale = clip.m_duration > 0.0f ? kQuantizedMax / clip.m_duration : 0.0f;
+
+	// La cuantizacin suma a lo ms medio paso de error: la reduccin usa lo que queda
+	for (const AnimationCurve& curve : curves) {
+		if (curve.keys.empty() || curve.channel >= AnimationChannel::Count) {
+			continue;
+		}
+		std::vector<size_t> kept = reduceKeys(curve.keys, tolerance * 0.5f);
+		AnimationTrack track;
+		track.channel = curve.channel;
+		float low = curve.keys[kept.front()].value;
+		float high = low;
+		for (size_t index : kept) {
+			low = std::min(low, curve.keys[index].value);
+			high = std::max(high, curve.keys[index].value);
+		}
+		track.minimum = low;
+		track.scale = (high - low) / kQuantizedMax;
+		for (size_t index : kept) {
+			const AnimationKey& key = curve.keys[index];
+			auto time = static_cast<uint16_t>(std::lround(std::clamp(key.time * clip.m_timeScale, 0.0f, kQuantizedMax)));
+			auto value = static_cast<uint16_t>(track.scale > 0.0f ? std::lround((key.value - low) / track.scale) : 0);
+			// Dos llaves en el mismo tiempo cuantizado: gana la ltima
+			if (!track.times.empty() && track.times.back() == time) {
+				track.values.back() = value;
+				continue;
+			}
+			track.times.push_back(time);
+			track.values.push_back(value);
+		}
+		clip.m_channelMask |= 1u << static_cast<uint32_t>(curve.channel);
+		clip.m_tracks.push_back(std::move(track));
+	}
+	return clip;
+}
+
+void
+AnimationClip::sampleBatch(uint32_t trackIndex, const float* quantizedTimes, size_t count, float* out) const {
+	const AnimationTrack& track = m_tracks[trackIndex];
+	const uint16_t* times = track.times.data();
+	const uint16_t* values = track.values.data();
+	size_t keys = track.times.size();
+	if (keys == 1) {
+		std::fill(out, out + count, track.minimum + track.scale * values[0]);
+		return;
+	}
+
+	float from[kBlock], to[kBlock], fraction[kBlock];
+	for (size_t first = 0; first < count; first += kBlock) {
+		size_t n = std::min(kBlock, count - first);
+		// Llave anterior a cada tiempo: `upper_bound` sobre las de 16 bits
+		for (size_t i = 0; i < n; ++i) {
+			float time = quantizedTimes[first + i];
+			size_t next = static_cast<size_t>(std::upper_bound(times, times + keys, time,
+				[](float t, uint16_t key) { return t < static_cast<float>(key); }) - times);
+			next = std::clamp<size_t>(next, 1, keys - 1);
+			float start = static_cast<float>(times[next - 1]);
+			float span = static_cast<float>(times[next]) - start;
+			from[i] = static_cast<float>(values[next - 1]);
+			to[i] = static_cast<float>(values[next]);
+			fraction[i] = std::clamp((time - start) / span, 0.0f, 1.0f);
+		}
+
+		// minimum + scale * (a + (b - a) * t)
+		float* result = out + first;
+		size_t i = 0;
+#if ANIMATION_SSE
+		__m128 minimum = _mm_set1_ps(track.minimum);
+		__m128 scale = _mm_set1_ps(track.scale);
+		for (; i + 4 <= n; i += 4) {
+			__m128 a = _mm_loadu_ps(from + i);
+			__m128 b = _mm_loadu_ps(to + i);
+			__m128 value = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_loadu_ps(fraction + i)));
+			_mm_storeu_ps(result + i, _mm_add_ps(minimum, _mm_mul_ps(scale, value)));
+		}
+#endif
+		for (; i < n; ++i) {
+			result[i] = track.minimum + track.scale * (from[i] + (to[i] - from[i]) * fraction[i]);
+		}
+	}
+}
+
+float
+AnimationClip::advance(float time, float deltaTime) const {
+	time += deltaTime;
+	if (m_duration <= 0.0f) {
+		return 0.0f;
+	}
+	if (!m_loop) {
+		return std::clamp(time, 0.0f, m_duration);
+	}
+	time = std::fmod(time, m_duration);
+	return time < 0.0f ? time + m_duration : time;
+}
+
+size_t
+AnimationClip::bytes() const {
+	size_t total = 0;
+	for (const AnimationTrack& track : m_tracks) {
+		total += sizeof(AnimationTrack) + (track.times.size() + track.values.size()) * sizeof(uint16_t);
+	}
+	return total;
+}
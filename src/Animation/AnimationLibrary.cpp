@@ -0,0 +1,106 @@
+#include "Animation/AnimationLibrary.h"
+#include <algorithm>
+#include "Jobs/JobSystem.h"
+#include "ShapeFactory.h"
+#include "Transform.h"
+
+void
+AnimationLibrary::animate(World& world, JobSystem& jobs, float deltaTime) {
+	m_lod.advance();
+	m_due.clear();
+	world.view<AnimationPlayer, const Transform>().each([this, &world, deltaTime](EntityId entity, AnimationPlayer& player, const Transform& transform) {
+		const AnimationClip* clip = m_clips.get(player.clip);
+		if (!clip || player.speed == 0.0f) {
+			return;
+		}
+		player.pending += deltaTime;
+		if (m_lod.dueInterval(entity.index, transform.getPosition()) == 0) {
+			return;
+		}
+		ComponentRef<Transform>* ref = world.getComponent<ComponentRef<Transform>>(entity);
+		if (!ref) {
+			return;
+		}
+		ShapeFactory* shape = nullptr;
+		if (clip->channelMask() >> static_cast<uint32_t>(AnimationChannel::ColorR)) {
+			ComponentRef<ShapeFactory>* shapeRef = world.getComponent<ComponentRef<ShapeFactory>>(entity);
+			shape = shapeRef && shapeRef->component->getShape() ? shapeRef->component : nullptr;
+		}
+		m_due.push_back({ player.clip.index, &player, ref->component, shape });
+	});
+
+	// Presupuesto: se corta en otro punto cada frame; los que quedan fuera acumulan su tiempo
+	if (m_budget != 0 && m_due.size() > m_budget) {
+		m_budgetCursor %= m_due.size();
+		std::rotate(m_due.begin(), m_due.begin() + m_budgetCursor, m_due.end());
+		m_due.resize(m_budget);
+		m_budgetCursor += m_budget;
+	}
+	m_lastSampled = m_due.size();
+
+	std::stable_sort(m_due.begin(), m_due.end(), [](const Due& a, const Due& b) { return a.clip < b.clip; });
+	for (size_t begin = 0; begin < m_due.size();) {
+		size_t end = begin + 1;
+		while (end < m_due.size() && m_due[end].clip == m_due[begin].clip) {
+			++end;
+		}
+		const AnimationClip& clip = *m_clips.get(m_due[begin].player->clip);
+		jobs.parallelFor(end - begin, kGrain, [this, &clip, begin](size_t first, size_t last) {
+			sample(clip, begin + first, begin + last);
+		});
+		begin = end;
+	}
+}
+
+void
+AnimationLibrary::sample(const AnimationClip& clip, size_t begin, size_t end) {
+	constexpr size_t kBlock = 256;
+	float times[kBlock];
+	float channels[kAnimationChannelCount][kBlock];
+	const std::vector<AnimationTrack>& tracks = clip.tracks();
+	uint32_t mask = clip.channelMask();
+	auto has = [mask](AnimationChannel channel) { return (mask >> static_cast<uint32_t>(channel)) & 1u; };
+
+	for (size_t first = begin; first < end; first += kBlock) {
+		size_t n = std::min(kBlock, end - first);
+		for (size_t i = 0; i < n; ++i) {
+			AnimationPlayer& player = *m_due[first + i].player;
+			player.time = clip.advance(player.time, player.pending * player.speed);
+			player.pending = 0.0f;
+			times[i] = player.time * clip.timeScale();
+		}
+		for (uint32_t track = 0; track < tracks.size(); ++track) {
+			clip.sampleBatch(track, times, n, channels[static_cast<uint32_t>(tracks[track].channel)]);
+		}
+
+		// Los canales sin pista conservan lo que el actor ya tena
+		for (size_t i = 0; i < n; ++i) {
+			const Due& due = m_due[first + i];
+			Transform& transform = *due.transform;
+			if (has(AnimationChannel::PositionX) || has(AnimationChannel::PositionY)) {
+				sf::Vector2f position = transform.getPosition();
+				position.x = has(AnimationChannel::PositionX) ? channels[static_cast<uint32_t>(AnimationChannel::PositionX)][i] : position.x;
+				position.y = has(AnimationChannel::PositionY) ? channels[static_cast<uint32_t>(AnimationChannel::PositionY)][i] : position.y;
+				transform.setPosition(position);
+			}
+			if (has(AnimationChannel::Rotation)) {
+				transform.setRotation(channels[static_cast<uint32_t>(AnimationChannel::Rotation)][i]);
+			}
+			if (has(AnimationChannel::ScaleX) || has(AnimationChannel::ScaleY)) {
+				sf::Vector2f scale = transform.getScale();
+				scale.x = has(AnimationChannel::ScaleX) ? channels[static_cast<uint32_t>(AnimationChannel::ScaleX)][i] : scale.x;
+				scale.y = has(AnimationChannel::ScaleY) ? channels[static_cast<uint32_t>(AnimationChannel::ScaleY)][i] : scale.y;
+				transform.setScale(scale);
+			}
+			if (due.shape) {
+				sf::Color color = due.shape->getFillColor();
+				auto channel = [&](AnimationChannel c, sf::Uint8 current) {
+					return has(c) ? static_cast<sf::Uint8>(std::clamp(channels[static_cast<uint32_t>(c)][i] + 0.5f, 0.0f, 255.0f)) : current;
+				};
+				color = sf::Color(channel(AnimationChannel::ColorR, color.r), channel(AnimationChannel::ColorG, color.g),
+					channel(AnimationChannel::ColorB, color.b), channel(AnimationChannel::ColorA, color.a));
+				due.shape->setFillColor(color);
+			}
+		}
+	}
+}
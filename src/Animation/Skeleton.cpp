@@ -0,0 +1,79 @@
+#include "Animation/Skeleton.h"
+#include <algorithm>
+#include <cmath>
+
+uint32_t
+Skeleton::addBone(int32_t parent, const Mat4& inverseBind) {
+	uint32_t index = static_cast<uint32_t>(m_parents.size());
+	if (index >= kMaxBones || parent < kNoParent || parent >= static_cast<int32_t>(index)) {
+		return kMaxBones;
+	}
+	m_parents.push_back(parent);
+	m_inverseBind.push_back(inverseBind);
+	return index;
+}
+
+void
+Skeleton::skinningMatrices(std::span<const BonePose> pose, std::span<Mat4> out) const {
+	size_t count = std::min({ m_parents.size(), pose.size(), out.size() });
+	// Mundo de cada hueso sobre el de su padre, que ya est en `out`
+	for (size_t i = 0; i < count; ++i) {
+		Mat4 local = composeTransform(pose[i].translation, pose[i].rotation, pose[i].scale);
+		out[i] = m_parents[i] == kNoParent ? local : out[m_parents[i]] * local;
+	}
+	// Recin ahora, sin padres pendientes, la inversa de reposo
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = out[i] * m_inverseBind[i];
+	}
+}
+
+void
+SkeletalClip::addFrame(std::span<const BonePose> pose) {
+	size_t first = m_poses.size();
+	m_poses.resize(first + m_boneCount);
+	std::copy_n(pose.begin(), std::min<size_t>(pose.size(), m_boneCount), m_poses.begin() + first);
+}
+
+float
+SkeletalClip::duration() const {
+	uint32_t frames = frameCount();
+	if (frames == 0) {
+		return 0.0f;
+	}
+	return static_cast<float>(m_loop ? frames : frames - 1) / m_frameRate;
+}
+
+float
+SkeletalClip::advance(float time, float deltaTime) const {
+	float length = duration();
+	time += deltaTime;
+	if (length <= 0.0f) {
+		return 0.0f;
+	}
+	if (m_loop) {
+		time = std::fmod(time, length);
+		return time < 0.0f ? time + length : time;
+	}
+	return std::clamp(time, 0.0f, length);
+}
+
+void
+SkeletalClip::sample(float time, std::span<BonePose> out) const {
+	uint32_t frames = frameCount();
+	size_t count = std::min<size_t>(out.size(), m_boneCount);
+	if (frames == 0) {
+		std::fill_n(out.begin(), count, BonePose{});
+		return;
+	}
+	float frame = advance(time, 0.0f) * m_frameRate;
+	uint32_t frame0 = std::min(static_cast<uint32_t>(frame), frames - 1);
+	uint32_t frame1 = m_loop ? (frame0 + 1) % frames : std::min(frame0 + 1, frames - 1);
+	float t = std::clamp(frame - static_cast<float>(frame0), 0.0f, 1.0f);
+	const BonePose* a = &m_poses[size_t(frame0) * m_boneCount];
+	const BonePose* b = &m_poses[size_t(frame1) * m_boneCount];
+	for (size_t i = 0; i < count; ++i) {
+		out[i].translation = lerp(a[i].translation, b[i].translation, t);
+		out[i].rotation = Quat::slerp(a[i].rotation, b[i].rotation, t);
+		out[i].scale = lerp(a[i].scale, b[i].scale, t);
+	}
+}
@@ -0,0 +1,492 @@
+#include "AssetManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include "Render/MeshLoader.h"
+#include "Render/ShaderCache.h"
+#include "Events/EngineEvents.h"
+#include "Events/EventBus.h"
+#include "Render/TextureLoader.h"
+#include "Scene/PackFile.h"
+
+namespace {
+	/**
+	 * @brief Handle de algo que es de otro cargador: soltarlo no lo destruye.
+	 */
+	template<typename T>
+	EngineUtilities::TSharedPointer<T>
+	borrowed(T* object) {
+		return EngineUtilities::TSharedPointer<T>(object, [](T*) {});
+	}
+
+	/**
+	 * @brief Elimina las entradas de `assets` que no tienen ms referencias que la suya.
+	 */
+	template<typename Table>
+	size_t
+	eraseUnused(Table& assets) {
+		size_t erased = 0;
+		for (auto it = assets.begin(); it != assets.end();) {
+			if (it->second.useCount() == 1) {
+				it = assets.erase(it);
+				++erased;
+			}
+			else {
+				++it;
+			}
+		}
+		return erased;
+	}
+
+	bool
+	readText(const std::string& path, std::string& text) {
+		PackedAsset packed = PackLibrary::lookup(path);
+		if (packed.found) {
+			std::vector<unsigned char> unpacked;
+			std::span<const unsigned char> bytes = packed.bytes(unpacked, EngineUtilities::TService<JobSystem>::get());
+			text.assign(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			return !bytes.empty() || packed.size == 0;
+		}
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		std::ostringstream contents;
+		contents << file.rdbuf();
+		text = contents.str();
+		return true;
+	}
+}
+
+template<typename T>
+AssetId
+AssetManager::sharedId(AssetId id, const std::string& path) {
+	const Table<T>& assets = table<T>();
+	if (assets.count(id)) {
+		return id;
+	}
+	auto alias = m_aliases.find(id);
+	if (alias != m_aliases.end() && assets.count(alias->second)) {
+		++m_sharedLoads;
+		return alias->second;
+	}
+	PackedAsset packed = PackLibrary::lookup(path);
+	if (!packed.found) {
+		return id;
+	}
+	auto [owner, inserted] = m_byContent.emplace(packed.contentHash, id);
+	if (!inserted && owner->second != id && assets.count(owner->second)) {
+		m_aliases[id] = owner->second;
+		++m_sharedLoads;
+		return owner->second;
+	}
+	// El que lo tena se solt: esta ruta lo carga y las dems la siguen a ella
+	owner->second = id;
+	m_aliases.erase(id);
+	return id;
+}
+
+AssetManager::Handle<const sf::Texture>
+AssetManager::texture(const std::string& path) {
+	AssetId id = sharedId<const sf::Texture>(assetId(path), path);
+	Handle<const sf::Texture>& entry = m_textures[id];
+	if (!entry) {
+		entry = borrowed(EngineUtilities::TService<TextureLoader>::instance().load(path));
+	}
+	remember(id, path, SourceKind::Texture);
+	return entry;
+}
+
+AssetManager::Handle<sf::Font>
+AssetManager::font(const std::string& path) {
+	AssetId id = assetId(path);
+	auto found = m_fonts.find(id);
+	if (found != m_fonts.end()) {
+		return found->second;
+	}
+	// La fuente lee del archivo mientras se usa: desde el paquete, lee del mapeo y, si est
+	// comprimida, de una copia descomprimida que se va con ella
+	PackedAsset packed = PackLibrary::lookup(path);
+	Handle<sf::Font> font;
+	bool loaded = false;
+	if (!packed.found) {
+		font = EngineUtilities::MakeShared<sf::Font>();
+		loaded = font->loadFromFile(path);
+	}
+	else if (!packed.isCompressed()) {
+		font = EngineUtilities::MakeShared<sf::Font>();
+		loaded = font->loadFromMemory(packed.stored.data(), packed.stored.size());
+	}
+	else {
+		std::vector<unsigned char>* unpacked = new std::vector<unsigned char>();
+		font = Handle<sf::Font>(new sf::Font(), [unpacked](sf::Font* owned) {
+			delete owned;
+			delete unpacked;
+		});
+		std::span<const unsigned char> bytes = packed.bytes(*unpacked, EngineUtilities::TService<JobSystem>::get());
+		loaded = !bytes.empty() && font->loadFromMemory(bytes.data(), bytes.size());
+	}
+	if (!loaded) {
+		MESSAGE("AssetManager", "font", "could not read a font file");
+		return Handle<sf::Font>();
+	}
+	m_fonts.emplace(id, font);
+	return font;
+}
+
+AssetManager::Handle<SoundAsset>
+AssetManager::sound(const std::string& path) {
+	AssetId id = sharedId<SoundAsset>(assetId(path), path);
+	Handle<SoundAsset>& entry = m_sounds[id];
+	remember(id, path, SourceKind::Sound);
+	if (!entry) {
+		// El handle tiene una referencia del cach mientras viva
+		SoundAsset* loaded = EngineUtilities::TService<SoundCache>::instance().load(path).get();
+		loaded->addRef();
+		entry = Handle<SoundAsset>(loaded, [](SoundAsset* sound) { sound->releaseRef(); });
+	}
+	return entry;
+}
+
+AssetManager::Handle<Mesh>
+AssetManager::mesh(const std::string& path) {
+	AssetId id = sharedId<Mesh>(assetId(path), path);
+	Handle<Mesh>& entry = m_meshes[id];
+	if (!entry) {
+		entry = EngineUtilities::TService<MeshLoader>::instance().load(path);
+	}
+	remember(id, path, SourceKind::Mesh);
+	return entry;
+}
+
+AssetManager::Handle<sf::Shader>
+AssetManager::shader(const std::string& vertexPath, const std::string& fragmentPath) {
+	AssetId id = assetId(vertexPath + kShaderSeparator + fragmentPath);
+	auto found = m_shaders.find(id);
+	if (found != m_shaders.end()) {
+		return found->second;
+	}
+	std::string vertexSource;
+	std::string fragmentSource;
+	if (!readText(vertexPath, vertexSource) || !readText(fragmentPath, fragmentSource)) {
+		MESSAGE("AssetManager", "shader", "could not read a shader file");
+		return Handle<sf::Shader>();
+	}
+	sf::Shader* compiled = EngineUtilities::TService<ShaderCache>::instance().shader(vertexSource, fragmentSource);
+	if (!compiled) {
+		return Handle<sf::Shader>();
+	}
+	Handle<sf::Shader> shader = borrowed(compiled);
+	m_shaders.emplace(id, shader);
+	remember(id, vertexPath + kShaderSeparator + fragmentPath, SourceKind::Shader);
+	return shader;
+}
+
+bool
+AssetManager::setHotReload(bool enabled) {
+	if (!enabled) {
+		m_watcher.stop();
+		m_dependents.clear();
+		m_retry.clear();
+		return true;
+	}
+	if (m_watcher.isRunning()) {
+		return true;
+	}
+	if (!m_watcher.start()) {
+		return false;
+	}
+	for (const auto& [id, source] : m_sources) {
+		watchSource(id, source);
+	}
+	return true;
+}
+
+void
+AssetManager::watch(const std::string& path) {
+	remember(assetId(path), path, SourceKind::File);
+}
+
+void
+AssetManager::remember(AssetId id, const std::string& request, SourceKind kind) {
+	auto found = m_sources.find(id);
+	if (found == m_sources.end()) {
+		found = m_sources.emplace(id, Source{ request, kind }).first;
+		if (m_watcher.isRunning()) {
+			watchSource(id, found->second);
+		}
+	}
+	found->second.lastUse = ++m_useCounter;
+}
+
+void
+AssetManager::watchSource(AssetId id, const Source& source) {
+	if (source.kind == SourceKind::Sound || source.kind == SourceKind::Mesh) {
+		return;
+	}
+	size_t separator = source.kind == SourceKind::Shader ? source.request.find(kShaderSeparator) : std::string::npos;
+	std::string paths[2] = { source.request.substr(0, separator), std::string() };
+	if (separator != std::string::npos) {
+		paths[1] = source.request.substr(separator + 1);
+	}
+	for (const std::string& path : paths) {
+		if (path.empty()) {
+			continue;
+		}
+		std::vector<AssetId>& ids = m_dependents[FileWatcher::normalize(path)];
+		if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+			ids.push_back(id);
+		}
+		if (!m_watcher.watch(path)) {
+			MESSAGE("AssetManager", "watchSource", "could not watch the folder of an asset, it will not hot reload");
+		}
+	}
+}
+
+void
+AssetManager::update() {
+	if (m_watcher.isRunning()) {
+		reloadChanged();
+	}
+	enforceBudgets();
+}
+
+void
+AssetManager::reloadChanged() {
+	std::vector<std::string> changed;
+	m_watcher.takeChanges(changed);
+	if (changed.empty() && m_retry.empty()) {
+		return;
+	}
+	// Un archivo de dos shaders o un shader con sus dos archivos cambiados: una recarga por id
+	std::vector<AssetId> ids;
+	ids.swap(m_retry);
+	for (const std::string& path : changed) {
+		auto found = m_dependents.find(path);
+		if (found != m_dependents.end()) {
+			ids.insert(ids.end(), found->second.begin(), found->second.end());
+		}
+	}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	std::vector<AssetId> affected;
+	m_graph.affected(ids, affected);
+
+	// Lo que usa algo que todava no pudo recargarse espera con ello: vuelve a salir al reintentarlo
+	std::vector<AssetId> waiting;
+	EventBus& events = EngineUtilities::TService<EventBus>::instance();
+	for (AssetId id : affected) {
+		std::span<const AssetId> uses = m_graph.dependencies(id);
+		if (std::any_of(uses.begin(), uses.end(),
+			[&waiting](AssetId used) { return std::find(waiting.begin(), waiting.end(), used) != waiting.end(); })) {
+			waiting.push_back(id);
+			continue;
+		}
+		auto source = m_sources.find(id);
+		if (source != m_sources.end() && !reload(id, source->second)) {
+			m_retry.push_back(id);
+			waiting.push_back(id);
+			continue;
+		}
+		events.publish(AssetReloaded{ id });
+	}
+}
+
+bool
+AssetManager::reload(AssetId id, const Source& source) {
+	switch (source.kind) {
+	case SourceKind::Texture:
+		// Sigue siendo del `TextureLoader` aunque `evictUnused` la haya sacado de la tabla
+		return EngineUtilities::TService<TextureLoader>::instance().reload(source.request);
+	case SourceKind::Shader: {
+		// Soltado por `evictUnused`: nadie lo usa, se compilar al pedirlo
+		if (!m_shaders.count(id)) {
+			return true;
+		}
+		size_t separator = source.request.find(kShaderSeparator);
+		std::string vertexSource;
+		std::string fragmentSource;
+		if (!readText(source.request.substr(0, separator), vertexSource) ||
+		    !readText(source.request.substr(separator + 1), fragmentSource)) {
+			MESSAGE("AssetManager", "reload", "could not read a changed shader file, it keeps the previous shader");
+			return true;
+		}
+		sf::Shader* compiled = EngineUtilities::TService<ShaderCache>::instance().shader(vertexSource, fragmentSource);
+		if (!compiled) {
+			MESSAGE("AssetManager", "reload", "a changed shader did not compile, it keeps the previous shader");
+			return true;
+		}
+		m_shaders[id] = borrowed(compiled);
+		return true;
+	}
+	case SourceKind::Sound:
+	case SourceKind::Mesh:
+	case SourceKind::File:
+		return true;
+	}
+	return true;
+}
+
+template<typename T>
+std::vector<AssetId>
+AssetManager::unusedByAge(const Table<T>& assets) const {
+	std::vector<std::pair<uint64_t, AssetId>> unused;
+	for (const auto& [id, handle] : assets) {
+		if (handle.useCount() == 1) {
+			auto source = m_sources.find(id);
+			unused.emplace_back(source != m_sources.end() ? source->second.lastUse : 0, id);
+		}
+	}
+	std::sort(unused.begin(), unused.end());
+	std::vector<AssetId> ids;
+	ids.reserve(unused.size());
+	for (const auto& [lastUse, id] : unused) {
+		ids.push_back(id);
+	}
+	return ids;
+}
+
+void
+AssetManager::enforceBudgets() {
+	if (TextureLoader* textures = EngineUtilities::TService<TextureLoader>::get()) {
+		// `release` descuenta enseguida, as que el total ya dice cundo parar
+		size_t budget = m_budgets[static_cast<size_t>(Category::Texture)];
+		if (textures->residentBytes() > budget) {
+			for (AssetId id : unusedByAge(m_textures)) {
+				if (textures->residentBytes() <= budget) {
+					break;
+				}
+				if (textures->release(m_sources[id].request)) {
+					m_textures.erase(id);
+					++m_evicted[static_cast<size_t>(Category::Texture)];
+				}
+			}
+		}
+
+		// Cerca del lmite se pierde detalle antes que texturas en uso. Un nivel a la vez y con
+		// todo subido: lo que est por subir todava no cuenta en el total
+		bool nearBudget = textures->residentBytes() > static_cast<size_t>(budget * kLodThreshold);
+		textures->setDroppedLevels(nearBudget ? 1 : 0);
+		if (nearBudget && textures->pendingCount() == 0) {
+			std::vector<std::pair<uint64_t, AssetId>> byAge;
+			for (const auto& [id, handle] : m_textures) {
+				byAge.emplace_back(m_sources[id].lastUse, id);
+			}
+			std::sort(byAge.begin(), byAge.end());
+			// En ronda desde la menos usada: no se le quitan todos los niveles a una sola
+			auto next = std::upper_bound(byAge.begin(), byAge.end(), std::make_pair(m_lodCursor, ~AssetId(0)));
+			std::rotate(byAge.begin(), next, byAge.end());
+			for (const auto& [lastUse, id] : byAge) {
+				if (textures->dropLevel(m_sources[id].request)) {
+					m_lodCursor = lastUse;
+					++m_droppedLevels;
+					break;
+				}
+			}
+		}
+	}
+
+	if (SoundCache* sounds = EngineUtilities::TService<SoundCache>::get()) {
+		// El cach suelta en su `update` lo que ya nadie tiene; aqu solo se le devuelve lo de la tabla
+		size_t budget = m_budgets[static_cast<size_t>(Category::Audio)];
+		if (sounds->residentBytes() > budget) {
+			size_t excess = sounds->residentBytes() - budget;
+			size_t returned = 0;
+			for (AssetId id : unusedByAge(m_sounds)) {
+				if (returned >= excess) {
+					break;
+				}
+				auto found = m_sounds.find(id);
+				returned += found->second->bytes();
+				m_sounds.erase(found);
+			}
+		}
+	}
+
+	size_t budget = m_budgets[static_cast<size_t>(Category::Mesh)];
+	size_t meshBytes = 0;
+	for (const auto& [id, mesh] : m_meshes) {
+		meshBytes += mesh->bytes();
+	}
+	if (meshBytes > budget) {
+		for (AssetId id : unusedByAge(m_meshes)) {
+			if (meshBytes <= budget) {
+				break;
+			}
+			auto found = m_meshes.find(id);
+			meshBytes -= found->second->bytes();
+			m_meshes.erase(found);
+			++m_evicted[static_cast<size_t>(Category::Mesh)];
+		}
+	}
+}
+
+void
+AssetManager::setBudget(Category category, size_t bytes) {
+	m_budgets[static_cast<size_t>(category)] = bytes;
+	if (category == Category::Audio) {
+		EngineUtilities::TService<SoundCache>::instance().setBudget(bytes);
+	}
+}
+
+AssetManager::Residency
+AssetManager::residency(Category category) const {
+	Residency residency;
+	residency.budget = m_budgets[static_cast<size_t>(category)];
+	residency.evicted = m_evicted[static_cast<size_t>(category)];
+	auto countReferenced = [&residency](const auto& assets) {
+		residency.entries = assets.size();
+		for (const auto& [id, handle] : assets) {
+			residency.referenced += handle.useCount() > 1 ? 1 : 0;
+		}
+	};
+	switch (category) {
+	case Category::Texture:
+		if (const TextureLoader* textures = EngineUtilities::TService<TextureLoader>::get()) {
+			residency.bytes = textures->residentBytes();
+		}
+		residency.droppedLevels = m_droppedLevels;
+		countReferenced(m_textures);
+		break;
+	case Category::Audio:
+		if (const SoundCache* sounds = EngineUtilities::TService<SoundCache>::get()) {
+			residency.bytes = sounds->residentBytes();
+			residency.evicted = sounds->evictedCount();
+		}
+		countReferenced(m_sounds);
+		break;
+	case Category::Mesh:
+		for (const auto& [id, mesh] : m_meshes) {
+			residency.bytes += mesh->bytes();
+		}
+		countReferenced(m_meshes);
+		break;
+	}
+	return residency;
+}
+
+void
+AssetManager::printResidency(std::ostream& out) const {
+	static constexpr const char* kNames[kCategoryCount] = { "texturas", "sonidos", "mallas" };
+	char line[160];
+	for (size_t i = 0; i < kCategoryCount; ++i) {
+		Residency residency = this->residency(static_cast<Category>(i));
+		std::snprintf(line, sizeof(line), "  %-9s %8.1f MB de %8.1f MB  %5zu entradas (%zu en uso)  %llu soltadas  %llu mipmaps\n",
+		              kNames[i], residency.bytes / 1048576.0, residency.budget / 1048576.0, residency.entries, residency.referenced,
+		              static_cast<unsigned long long>(residency.evicted), static_cast<unsigned long long>(residency.droppedLevels));
+		out << line;
+	}
+}
+
+size_t
+AssetManager::evictUnused() {
+	return eraseUnused(m_textures) + eraseUnused(m_fonts) + eraseUnused(m_sounds) + eraseUnused(m_meshes) +
+	       eraseUnused(m_shaders);
+}
+
+size_t
+AssetManager::size() const {
+	return m_textures.size() + m_fonts.size() + m_sounds.size() + m_meshes.size() + m_shaders.size();
+}
@@ -0,0 +1,167 @@
+#include "AssetStreamer.h"
+#include <algorithm>
+#include "Render/MeshLoader.h"
+#include "Render/TextureLoader.h"
+
+StreamHandle
+AssetStreamer::request(AssetKind kind, const std::string& path, StreamPriority priority) {
+	Request request;
+	request.kind = kind;
+	request.priority = priority;
+	request.sequence = ++m_sequence;
+	request.path = path;
+	return m_requests.insert(std::move(request));
+}
+
+StreamHandle
+AssetStreamer::requestAt(AssetKind kind, const std::string& path, const sf::Vector2f& position) {
+	StreamHandle handle = request(kind, path, priorityAt(position));
+	Request* request = m_requests.get(handle);
+	request->placed = true;
+	request->position = position;
+	return handle;
+}
+
+void
+AssetStreamer::setPriority(StreamHandle handle, StreamPriority priority) {
+	if (Request* request = m_requests.get(handle)) {
+		request->priority = priority;
+		request->placed = false;
+	}
+}
+
+void
+AssetStreamer::setPosition(StreamHandle handle, const sf::Vector2f& position) {
+	if (Request* request = m_requests.get(handle); request && request->placed) {
+		request->position = position;
+	}
+}
+
+void
+AssetStreamer::cancel(StreamHandle handle) {
+	const Request* request = m_requests.get(handle);
+	if (!request) {
+		return;
+	}
+	if (request->state == StreamState::Loading) {
+		--m_inFlight;
+	}
+	else if (request->state != StreamState::Queued) {
+		--m_finished;
+	}
+	m_requests.erase(handle);
+}
+
+StreamState
+AssetStreamer::state(StreamHandle handle) const {
+	const Request* request = m_requests.get(handle);
+	return request ? request->state : StreamState::None;
+}
+
+StreamPriority
+AssetStreamer::priorityAt(const sf::Vector2f& position) const {
+	if (!m_hasVisibleArea || m_visibleArea.contains(position)) {
+		return StreamPriority::Visible;
+	}
+	// Distancia al borde de la vista, no al centro: una vista ancha no deja lejos sus costados
+	float dx = std::max({ m_visibleArea.left - position.x, 0.0f, position.x - (m_visibleArea.left + m_visibleArea.width) });
+	float dy = std::max({ m_visibleArea.top - position.y, 0.0f, position.y - (m_visibleArea.top + m_visibleArea.height) });
+	return dx * dx + dy * dy <= kNearDistance * kNearDistance ? StreamPriority::Nearby : StreamPriority::Prefetch;
+}
+
+void
+AssetStreamer::update() {
+	sf::Clock clock;
+
+	for (Request& request : m_requests) {
+		if (request.state == StreamState::Loading) {
+			request.state = poll(request);
+			if (request.state != StreamState::Loading) {
+				--m_inFlight;
+				++m_finished;
+			}
+		}
+	}
+
+	m_ranked.clear();
+	for (size_t i = 0; i < m_requests.size(); ++i) {
+		Request& request = m_requests.data()[i];
+		if (request.state != StreamState::Queued) {
+			continue;
+		}
+		if (request.placed) {
+			request.priority = priorityAt(request.position);
+		}
+		m_ranked.push_back(static_cast<uint32_t>(i));
+	}
+	std::sort(m_ranked.begin(), m_ranked.end(), [this](uint32_t a, uint32_t b) {
+		const Request& first = m_requests.data()[a];
+		const Request& second = m_requests.data()[b];
+		return first.priority != second.priority ? first.priority < second.priority : first.sequence < second.sequence;
+	});
+
+	uint32_t prefetchSlots = std::max(1u, m_maxInFlight / 2);
+	for (uint32_t index : m_ranked) {
+		Request& request = m_requests.data()[index];
+		uint32_t slots = request.priority == StreamPriority::Prefetch ? prefetchSlots : m_maxInFlight;
+		// Ordenados: si esta no entra, las que siguen tampoco
+		if (m_inFlight >= slots || clock.getElapsedTime().asSeconds() > m_dispatchBudget) {
+			break;
+		}
+		dispatch(request);
+	}
+}
+
+void
+AssetStreamer::dispatch(Request& request) {
+	AssetManager& assets = EngineUtilities::TService<AssetManager>::instance();
+	switch (request.kind) {
+	case AssetKind::Texture:
+		request.texture = assets.texture(request.path);
+		break;
+	case AssetKind::Font:
+		// Sin cargador propio: se lee aqu, dentro del presupuesto
+		request.font = assets.font(request.path);
+		request.state = request.font ? StreamState::Ready : StreamState::Failed;
+		++m_finished;
+		return;
+	case AssetKind::Sound:
+		request.sound = assets.sound(request.path);
+		break;
+	case AssetKind::Mesh:
+		request.mesh = assets.mesh(request.path);
+		break;
+	}
+	request.state = StreamState::Loading;
+	++m_inFlight;
+}
+
+StreamState
+AssetStreamer::poll(const Request& request) const {
+	switch (request.kind) {
+	case AssetKind::Texture: {
+		const TextureLoader* loader = EngineUtilities::TService<TextureLoader>::get();
+		if (!loader || loader->hasFailed(request.texture.get())) {
+			return StreamState::Failed;
+		}
+		return loader->isReady(request.texture.get()) ? StreamState::Ready : StreamState::Loading;
+	}
+	case AssetKind::Sound:
+		if (!request.sound || request.sound->hasFailed()) {
+			return StreamState::Failed;
+		}
+		return request.sound->isReady() ? StreamState::Ready : StreamState::Loading;
+	case AssetKind::Mesh: {
+		const MeshLoader* loader = EngineUtilities::TService<MeshLoader>::get();
+		if (!request.mesh) {
+			return StreamState::Failed;
+		}
+		if (loader && loader->isPending(request.mesh.get())) {
+			return StreamState::Loading;
+		}
+		return request.mesh->indices().empty() ? StreamState::Failed : StreamState::Ready;
+	}
+	default:
+		return request.font ? StreamState::Ready : StreamState::Failed;
+	}
+}
@@ -0,0 +1,56 @@
+#include "Audio/AudioStats.h"
+
+AudioStatsCounter&
+AudioStatsCounter::instance() {
+	static AudioStatsCounter counter;
+	return counter;
+}
+
+void
+AudioStatsCounter::countRefill(uint32_t microseconds) {
+	m_refills.fetch_add(1, std::memory_order_relaxed);
+	raise(m_refillMax, microseconds);
+}
+
+void
+AudioStatsCounter::countStart(uint32_t microseconds) {
+	m_started.fetch_add(1, std::memory_order_relaxed);
+	raise(m_latencyMax, microseconds);
+}
+
+AudioStats
+AudioStatsCounter::endFrame() {
+	AudioStats stats;
+	stats.underruns = m_underruns.load(std::memory_order_relaxed);
+	stats.steals = m_steals.load(std::memory_order_relaxed);
+	stats.refillMaxMs = m_refillMax.exchange(0, std::memory_order_relaxed) / 1000.0;
+	stats.refills = m_refills.exchange(0, std::memory_order_relaxed);
+	stats.latencyMaxMs = m_latencyMax.exchange(0, std::memory_order_relaxed) / 1000.0;
+	stats.started = m_started.exchange(0, std::memory_order_relaxed);
+	return stats;
+}
+
+void
+AudioStatsCounter::raise(std::atomic<uint32_t>& target, uint32_t value) {
+	uint32_t current = target.load(std::memory_order_relaxed);
+	while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+	}
+}
+
+void
+StreamWatch::begin() {
+	m_start = Clock::now();
+	// Lo encolado alcanzaba hasta el fin de la recarga anterior ms sus trozos
+	if (m_hasLast && std::chrono::duration<double>(m_start - m_last).count() > m_chunkSeconds * kQueuedChunks) {
+		AudioStatsCounter::instance().countUnderrun();
+	}
+}
+
+void
+StreamWatch::end(size_t sampleCount, unsigned int channels, unsigned int sampleRate) {
+	m_last = Clock::now();
+	m_hasLast = sampleCount > 0;
+	m_chunkSeconds = channels > 0 && sampleRate > 0 ? static_cast<double>(sampleCount) / (channels * sampleRate) : 0.0;
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(m_last - m_start).count();
+	AudioStatsCounter::instance().countRefill(static_cast<uint32_t>(elapsed));
+}
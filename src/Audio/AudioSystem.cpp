@@ -0,0 +1,436 @@
+#include "Audio/AudioSystem.h"
+#include <algorithm>
+#include <cmath>
+#include "AudioSource.h"
+#include "Jobs/JobSystem.h"
+#include "Transform.h"
+
+bool
+StreamedMusic::onGetData(Chunk& data) {
+	m_watch.begin();
+	bool more = sf::Music::onGetData(data);
+	m_watch.end(data.sampleCount, getChannelCount(), getSampleRate());
+	return more;
+}
+
+void
+StreamedMusic::onSeek(sf::Time timeOffset) {
+	sf::Music::onSeek(timeOffset);
+	m_watch.reset();
+}
+
+AudioSystem::AudioSystem() : m_voices(kVoiceCount) {
+	sf::Listener::setDirection(0.0f, 0.0f, 1.0f);
+	sf::Listener::setUpVector(0.0f, -1.0f, 0.0f);
+	sf::Listener::setPosition(0.0f, 0.0f, -kListenerDistance);
+	m_listenerDirty = false;
+}
+
+VoiceHandle
+AudioSystem::play(const sf::SoundBuffer& sound, const SoundParams& params) {
+	if (m_playbacks.size() >= kMaxPlaybacks) {
+		++m_dropped;
+		return VoiceHandle();
+	}
+	Playback playback;
+	playback.sound = &sound;
+	playback.params = params;
+	playback.duration = sound.getDuration().asSeconds();
+	playback.gain = gainOf(playback);
+	playback.requested = StreamWatch::Clock::now();
+	VoiceHandle handle = m_playbacks.insert(playback);
+	if (playback.gain < kAudibleGain) {
+		return handle;
+	}
+
+	// Con voz desde ya si hay una libre o una que se oye menos; si no, `update` decide
+	Playback* weakest = nullptr;
+	for (uint32_t i = 0; i < m_voices.size(); ++i) {
+		Playback* owner = m_playbacks.get(m_voices[i].owner);
+		if (!owner) {
+			promote(handle, i);
+			return handle;
+		}
+		if (!weakest || outranks(*weakest, *owner)) {
+			weakest = owner;
+		}
+	}
+	if (outranks(playback, *weakest)) {
+		uint32_t voice = weakest->voice;
+		demote(*weakest);
+		++m_stolen;
+		AudioStatsCounter::instance().countSteal();
+		promote(handle, voice);
+	}
+	return handle;
+}
+
+void
+AudioSystem::stop(VoiceHandle handle) {
+	if (Playback* playback = m_playbacks.get(handle)) {
+		release(*playback);
+		m_playbacks.erase(handle);
+	}
+}
+
+bool
+AudioSystem::isPlaying(VoiceHandle handle) const {
+	return m_playbacks.contains(handle);
+}
+
+bool
+AudioSystem::isAudible(VoiceHandle handle) const {
+	const Playback* playback = m_playbacks.get(handle);
+	return playback && playback->voice != kNoVoice;
+}
+
+void
+AudioSystem::setPosition(VoiceHandle handle, const sf::Vector2f& position) {
+	Playback* playback = m_playbacks.get(handle);
+	if (!playback) {
+		return;
+	}
+	playback->params.position = position;
+	playback->dirty = true;
+}
+
+void
+AudioSystem::setVolume(VoiceHandle handle, float volume) {
+	Playback* playback = m_playbacks.get(handle);
+	if (!playback) {
+		return;
+	}
+	playback->params.volume = volume;
+	playback->dirty = true;
+}
+
+void
+AudioSystem::stopAll(const sf::SoundBuffer& sound) {
+	for (size_t i = m_playbacks.size(); i-- > 0;) {
+		Playback& playback = m_playbacks.begin()[i];
+		if (playback.sound == &sound) {
+			release(playback);
+			m_playbacks.erase(m_playbacks.handleAt(i));
+		}
+	}
+	// Las voces libres conservan el ltimo bfer que usaron
+	for (Voice& voice : m_voices) {
+		if (voice.sound.getBuffer() == &sound) {
+			voice.sound.resetBuffer();
+		}
+	}
+}
+
+bool
+AudioSystem::isUsing(const sf::SoundBuffer& sound) const {
+	for (const Playback& playback : m_playbacks) {
+		if (playback.sound == &sound) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+AudioSystem::syncSources(World& world, uint32_t since, JobSystem* jobs) {
+	m_moved.clear();
+	m_movedTo.clear();
+	world.view<const Transform, const AudioSource>().eachChanged<Transform>(since,
+		[this](EntityId, const Transform& transform, const AudioSource& source) {
+			if (source.m_params.spatial && m_playbacks.contains(source.m_voice)) {
+				m_moved.push_back(source.m_voice);
+				m_movedTo.push_back(transform.getWorldTransform().transformPoint(0.0f, 0.0f));
+			}
+		});
+	// Cada fuente escribe solo su reproduccin; la tabla no cambia mientras tanto
+	auto work = [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			Playback& playback = *m_playbacks.get(m_moved[i]);
+			playback.params.position = m_movedTo[i];
+			playback.dirty = true;
+		}
+	};
+	if (!jobs) {
+		work(0, m_moved.size());
+		return;
+	}
+	jobs->parallelFor(m_moved.size(), kBatchGrain, work);
+}
+
+void
+AudioSystem::setListener(const sf::Vector2f& position) {
+	m_listenerDirty = m_listenerDirty || position != m_listener;
+	m_listener = position;
+}
+
+bool
+AudioSystem::playMusic(const std::string& path, bool loop, float fadeSeconds) {
+	uint32_t next = (m_currentTrack + 1) % kMusicTracks;
+	Track& track = m_tracks[next];
+	track.music.stop();
+	PackedAsset packed = PackLibrary::lookup(path);
+	bool opened = false;
+	if (!packed.found) {
+		opened = track.music.openFromFile(path);
+	}
+	else {
+		std::span<const unsigned char> bytes = packed.bytes(track.unpacked, EngineUtilities::TService<JobSystem>::get());
+		track.packed.open(bytes);
+		opened = !bytes.empty() && track.music.openFromStream(track.packed);
+	}
+	if (!opened) {
+		MESSAGE("AudioSystem", "playMusic", "could not open a music file");
+		return false;
+	}
+	fadeOut(m_tracks[m_currentTrack], fadeSeconds);
+	m_currentTrack = next;
+	track.music.setLoop(loop);
+	track.music.setRelativeToListener(true);
+	track.music.setPosition(0.0f, 0.0f, 0.0f);
+	track.music.setAttenuation(0.0f);
+	// Sube en el mismo tiempo en que baja la otra
+	track.volume = fadeSeconds > 0.0f ? 0.0f : 1.0f;
+	track.fadeSpeed = fadeSeconds > 0.0f ? 1.0f / fadeSeconds : 0.0f;
+	track.music.setVolume(m_musicVolume * track.volume);
+	track.music.play();
+	return true;
+}
+
+void
+AudioSystem::stopMusic(float fadeSeconds) {
+	for (Track& track : m_tracks) {
+		fadeOut(track, fadeSeconds);
+	}
+}
+
+void
+AudioSystem::setMusicVolume(float volume) {
+	m_musicVolume = volume;
+	for (Track& track : m_tracks) {
+		track.music.setVolume(m_musicVolume * track.volume);
+	}
+}
+
+bool
+AudioSystem::isMusicPlaying() const {
+	for (const Track& track : m_tracks) {
+		if (track.music.getStatus() == sf::SoundSource::Playing) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+AudioSystem::update(float deltaTime, JobSystem* jobs) {
+	// Las que tienen voz dicen por dnde van; son pocas y preguntan a OpenAL
+	for (Voice& voice : m_voices) {
+		if (Playback* playback = m_playbacks.get(voice.owner)) {
+			playback->finished = voice.sound.getStatus() == sf::SoundSource::Stopped;
+			playback->elapsed = voice.sound.getPlayingOffset().asSeconds();
+		}
+	}
+	// Las virtuales avanzan con el reloj y todas calculan cunto se oyen, en paralelo
+	if (jobs) {
+		jobs->parallelFor(m_playbacks.size(), kBatchGrain,
+			[this, deltaTime](size_t begin, size_t end) { advance(begin, end, deltaTime); });
+	}
+	else {
+		advance(0, m_playbacks.size(), deltaTime);
+	}
+	for (size_t i = m_playbacks.size(); i-- > 0;) {
+		Playback& playback = m_playbacks.begin()[i];
+		if (playback.finished) {
+			release(playback);
+			m_playbacks.erase(m_playbacks.handleAt(i));
+		}
+	}
+	assignVoices();
+
+	// Punto de sincronizacin: lo anotado en el frame llega a OpenAL de una vez
+	if (m_listenerDirty) {
+		sf::Listener::setPosition(m_listener.x, m_listener.y, -kListenerDistance);
+		m_listenerDirty = false;
+	}
+	for (Voice& voice : m_voices) {
+		Playback* playback = m_playbacks.get(voice.owner);
+		if (!playback || !playback->dirty) {
+			continue;
+		}
+		if (playback->params.spatial) {
+			voice.sound.setPosition(playback->params.position.x, playback->params.position.y, 0.0f);
+		}
+		voice.sound.setVolume(playback->params.volume);
+		playback->dirty = false;
+	}
+
+	for (Track& track : m_tracks) {
+		if (track.fadeSpeed == 0.0f || track.music.getStatus() == sf::SoundSource::Stopped) {
+			continue;
+		}
+		track.volume = std::clamp(track.volume + track.fadeSpeed * deltaTime, 0.0f, 1.0f);
+		track.music.setVolume(m_musicVolume * track.volume);
+		if (track.volume == 0.0f) {
+			track.music.stop();
+			track.fadeSpeed = 0.0f;
+		}
+		else if (track.volume == 1.0f && track.fadeSpeed > 0.0f) {
+			track.fadeSpeed = 0.0f;
+		}
+	}
+}
+
+uint32_t
+AudioSystem::activeVoices() const {
+	uint32_t active = 0;
+	for (const Voice& voice : m_voices) {
+		active += voice.owner.isNull() ? 0 : 1;
+	}
+	return active;
+}
+
+void
+AudioSystem::advance(size_t begin, size_t end, float deltaTime) {
+	Playback* playbacks = m_playbacks.begin();
+	for (size_t i = begin; i < end; ++i) {
+		Playback& playback = playbacks[i];
+		if (playback.voice == kNoVoice) {
+			playback.elapsed += deltaTime * playback.params.pitch;
+			if (playback.elapsed >= playback.duration) {
+				playback.finished = !playback.params.loop || playback.duration <= 0.0f;
+				playback.elapsed = playback.finished ? playback.duration : std::fmod(playback.elapsed, playback.duration);
+			}
+		}
+		playback.gain = gainOf(playback);
+	}
+}
+
+float
+AudioSystem::gainOf(const Playback& playback) const {
+	const SoundParams& params = playback.params;
+	float gain = std::clamp(params.volume / 100.0f, 0.0f, 1.0f);
+	if (!params.spatial) {
+		return gain;
+	}
+	// La cada de OpenAL por omisin: inversa a la distancia, completa hasta `minDistance`
+	float dx = params.position.x - m_listener.x;
+	float dy = params.position.y - m_listener.y;
+	float distance = std::sqrt(dx * dx + dy * dy + kListenerDistance * kListenerDistance);
+	float minDistance = std::max(params.minDistance, 1.0f);
+	distance = std::max(distance, minDistance);
+	return gain * minDistance / (minDistance + params.attenuation * (distance - minDistance));
+}
+
+bool
+AudioSystem::outranks(const Playback& a, const Playback& b) {
+	if (a.params.priority != b.params.priority) {
+		return a.params.priority > b.params.priority;
+	}
+	float scoreA = a.voice != kNoVoice ? a.gain * kKeepBonus : a.gain;
+	float scoreB = b.voice != kNoVoice ? b.gain * kKeepBonus : b.gain;
+	return scoreA > scoreB;
+}
+
+void
+AudioSystem::promote(VoiceHandle handle, uint32_t voice) {
+	Playback& playback = *m_playbacks.get(handle);
+	const SoundParams& params = playback.params;
+	m_voices[voice].owner = handle;
+	playback.voice = voice;
+
+	sf::Sound& source = m_voices[voice].sound;
+	source.setBuffer(*playback.sound);
+	source.setVolume(params.volume);
+	source.setPitch(params.pitch);
+	source.setLoop(params.loop);
+	source.setRelativeToListener(!params.spatial);
+	if (params.spatial) {
+		source.setPosition(params.position.x, params.position.y, 0.0f);
+		source.setMinDistance(params.minDistance);
+		source.setAttenuation(params.attenuation);
+	}
+	else {
+		source.setPosition(0.0f, 0.0f, 0.0f);
+		source.setAttenuation(0.0f);
+	}
+	source.setPlayingOffset(sf::seconds(playback.elapsed));
+	source.play();
+	playback.dirty = false;
+	if (!playback.started) {
+		playback.started = true;
+		auto waited = std::chrono::duration_cast<std::chrono::microseconds>(StreamWatch::Clock::now() - playback.requested);
+		AudioStatsCounter::instance().countStart(static_cast<uint32_t>(waited.count()));
+	}
+}
+
+void
+AudioSystem::demote(Playback& playback) {
+	playback.elapsed = m_voices[playback.voice].sound.getPlayingOffset().asSeconds();
+	release(playback);
+}
+
+void
+AudioSystem::release(Playback& playback) {
+	if (playback.voice == kNoVoice) {
+		return;
+	}
+	Voice& voice = m_voices[playback.voice];
+	voice.sound.stop();
+	voice.owner = VoiceHandle();
+	playback.voice = kNoVoice;
+}
+
+void
+AudioSystem::assignVoices() {
+	m_ranked.clear();
+	Playback* playbacks = m_playbacks.begin();
+	for (uint32_t i = 0; i < m_playbacks.size(); ++i) {
+		playbacks[i].chosen = false;
+		if (playbacks[i].gain >= kAudibleGain) {
+			m_ranked.push_back(i);
+		}
+	}
+	size_t chosen = std::min<size_t>(kVoiceCount, m_ranked.size());
+	if (chosen < m_ranked.size()) {
+		std::nth_element(m_ranked.begin(), m_ranked.begin() + chosen, m_ranked.end(),
+			[playbacks](uint32_t a, uint32_t b) { return outranks(playbacks[a], playbacks[b]); });
+	}
+	for (size_t i = 0; i < chosen; ++i) {
+		playbacks[m_ranked[i]].chosen = true;
+	}
+
+	// Primero se sueltan: las voces que quedan libres son las que reciben a las nuevas
+	for (uint32_t i = 0; i < m_playbacks.size(); ++i) {
+		if (playbacks[i].voice != kNoVoice && !playbacks[i].chosen) {
+			if (playbacks[i].gain >= kAudibleGain) {
+				++m_stolen;
+				AudioStatsCounter::instance().countSteal();
+			}
+			demote(playbacks[i]);
+		}
+	}
+	uint32_t free = 0;
+	for (size_t i = 0; i < chosen; ++i) {
+		if (playbacks[m_ranked[i]].voice != kNoVoice) {
+			continue;
+		}
+		while (!m_voices[free].owner.isNull()) {
+			++free;
+		}
+		promote(m_playbacks.handleAt(m_ranked[i]), free);
+	}
+}
+
+void
+AudioSystem::fadeOut(Track& track, float fadeSeconds) {
+	if (track.music.getStatus() == sf::SoundSource::Stopped) {
+		return;
+	}
+	if (fadeSeconds <= 0.0f) {
+		track.music.stop();
+		track.volume = 0.0f;
+		track.fadeSpeed = 0.0f;
+		return;
+	}
+	track.fadeSpeed = -1.0f / fadeSeconds;
+}
@@ -0,0 +1,299 @@
+#include "Audio/SoftwareMixer.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIXER_SSE2 1
+#else
+#define MIXER_SSE2 0
+#endif
+
+namespace {
+	constexpr float kSampleScale = 1.0f / 32768.0f;
+
+	/**
+	 * @brief Suma `frames` muestras mono a la mezcla estreo con ganancias `left` y `right`.
+	 */
+	void
+	accumulateMono(float* mix, const float* mono, size_t frames, float left, float right) {
+		size_t i = 0;
+#if MIXER_SSE2
+		__m128 gains = _mm_setr_ps(left, right, left, right);
+		for (; i + 4 <= frames; i += 4) {
+			__m128 samples = _mm_load_ps(mono + i);
+			__m128 low = _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gains);
+			__m128 high = _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gains);
+			_mm_store_ps(mix + 2 * i, _mm_add_ps(_mm_load_ps(mix + 2 * i), low));
+			_mm_store_ps(mix + 2 * i + 4, _mm_add_ps(_mm_load_ps(mix + 2 * i + 4), high));
+		}
+#endif
+		for (; i < frames; ++i) {
+			mix[2 * i] += mono[i] * left;
+			mix[2 * i + 1] += mono[i] * right;
+		}
+	}
+
+	/**
+	 * @brief Suma `frames` cuadros estreo a la mezcla con ganancias `left` y `right`.
+	 */
+	void
+	accumulateStereo(float* mix, const float* stereo, size_t frames, float left, float right) {
+		size_t i = 0;
+		size_t count = frames * 2;
+#if MIXER_SSE2
+		__m128 gains = _mm_setr_ps(left, right, left, right);
+		for (; i + 4 <= count; i += 4) {
+			_mm_store_ps(mix + i, _mm_add_ps(_mm_load_ps(mix + i), _mm_mul_ps(_mm_load_ps(stereo + i), gains)));
+		}
+#endif
+		for (; i < count; i += 2) {
+			mix[i] += stereo[i] * left;
+			mix[i + 1] += stereo[i + 1] * right;
+		}
+	}
+
+	/**
+	 * @brief Recorta la mezcla a [-1, 1] y la pasa a 16 bits.
+	 */
+	void
+	toPcm(const float* mix, sf::Int16* out, size_t count) {
+		size_t i = 0;
+#if MIXER_SSE2
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 minusOne = _mm_set1_ps(-1.0f);
+		__m128 scale = _mm_set1_ps(32767.0f);
+		for (; i + 8 <= count; i += 8) {
+			// Recortar antes: fuera de rango la conversin da el mnimo, tambin para los positivos
+			__m128 low = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_load_ps(mix + i), minusOne), one), scale);
+			__m128 high = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_load_ps(mix + i + 4), minusOne), one), scale);
+			_mm_store_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high)));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = static_cast<sf::Int16>(std::lrint(std::clamp(mix[i], -1.0f, 1.0f) * 32767.0f));
+		}
+	}
+}
+
+SoftwareMixer::SoftwareMixer() : m_layers(kLayerCount) {
+	initialize(2, kSampleRate);
+	setRelativeToListener(true);
+	setAttenuation(0.0f);
+}
+
+SoftwareMixer::~SoftwareMixer() {
+	sf::SoundStream::stop();
+}
+
+MixHandle
+SoftwareMixer::play(const SoundRef& sound, const MixParams& params) {
+	if (!sound || !sound->isReady()) {
+		return MixHandle();
+	}
+	const sf::SoundBuffer& buffer = sound->buffer();
+	unsigned int channels = buffer.getChannelCount();
+	if ((channels != 1 && channels != 2) || buffer.getSampleCount() < channels) {
+		return MixHandle();
+	}
+	for (uint32_t i = 0; i < m_layers.size(); ++i) {
+		Layer& layer = m_layers[i];
+		if (layer.state.load(std::memory_order_acquire) != LayerState::Free) {
+			continue;
+		}
+		// Libre: el hilo del stream no la mira hasta que pase a Starting
+		layer.sound = sound;
+		layer.samples = buffer.getSamples();
+		layer.channels = channels;
+		layer.frames = static_cast<size_t>(buffer.getSampleCount()) / channels;
+		layer.step = static_cast<double>(buffer.getSampleRate()) / kSampleRate;
+		layer.loop = params.loop;
+		++layer.generation;
+		layer.requested = StreamWatch::Clock::now();
+		layer.gain.store(params.gain, std::memory_order_relaxed);
+		layer.pan.store(params.pan, std::memory_order_relaxed);
+		layer.rate.store(params.rate, std::memory_order_relaxed);
+		layer.lowPass.store(params.lowPass, std::memory_order_relaxed);
+		layer.state.store(LayerState::Starting, std::memory_order_release);
+		if (!m_started) {
+			sf::SoundStream::play();
+			m_started = true;
+		}
+		return MixHandle{ i, layer.generation };
+	}
+	return MixHandle();
+}
+
+void
+SoftwareMixer::stop(MixHandle handle) {
+	Layer* layer = find(handle);
+	if (!layer) {
+		return;
+	}
+	LayerState expected = LayerState::Playing;
+	if (!layer->state.compare_exchange_strong(expected, LayerState::Stopping, std::memory_order_acq_rel)) {
+		expected = LayerState::Starting;
+		layer->state.compare_exchange_strong(expected, LayerState::Stopping, std::memory_order_acq_rel);
+	}
+}
+
+bool
+SoftwareMixer::isPlaying(MixHandle handle) const {
+	const Layer* layer = find(handle);
+	if (!layer) {
+		return false;
+	}
+	LayerState state = layer->state.load(std::memory_order_acquire);
+	return state == LayerState::Starting || state == LayerState::Playing;
+}
+
+void
+SoftwareMixer::setGain(MixHandle handle, float gain) {
+	if (Layer* layer = find(handle)) {
+		layer->gain.store(gain, std::memory_order_relaxed);
+	}
+}
+
+void
+SoftwareMixer::setPan(MixHandle handle, float pan) {
+	if (Layer* layer = find(handle)) {
+		layer->pan.store(pan, std::memory_order_relaxed);
+	}
+}
+
+void
+SoftwareMixer::setRate(MixHandle handle, float rate) {
+	if (Layer* layer = find(handle)) {
+		layer->rate.store(rate, std::memory_order_relaxed);
+	}
+}
+
+void
+SoftwareMixer::setLowPass(MixHandle handle, float coefficient) {
+	if (Layer* layer = find(handle)) {
+		layer->lowPass.store(coefficient, std::memory_order_relaxed);
+	}
+}
+
+void
+SoftwareMixer::update() {
+	for (Layer& layer : m_layers) {
+		if (layer.state.load(std::memory_order_acquire) == LayerState::Finished) {
+			layer.sound = SoundRef();
+			layer.samples = nullptr;
+			layer.state.store(LayerState::Free, std::memory_order_release);
+		}
+	}
+}
+
+uint32_t
+SoftwareMixer::activeLayers() const {
+	uint32_t active = 0;
+	for (const Layer& layer : m_layers) {
+		active += layer.state.load(std::memory_order_relaxed) != LayerState::Free ? 1 : 0;
+	}
+	return active;
+}
+
+bool
+SoftwareMixer::onGetData(Chunk& data) {
+	m_watch.begin();
+	std::fill(std::begin(m_mix), std::end(m_mix), 0.0f);
+	for (Layer& layer : m_layers) {
+		LayerState state = layer.state.load(std::memory_order_acquire);
+		if (state == LayerState::Starting) {
+			if (layer.state.compare_exchange_strong(state, LayerState::Playing, std::memory_order_acq_rel)) {
+				layer.position = 0.0;
+				layer.filter[0] = layer.filter[1] = 0.0f;
+				state = LayerState::Playing;
+				auto waited = std::chrono::duration_cast<std::chrono::microseconds>(StreamWatch::Clock::now() - layer.requested);
+				AudioStatsCounter::instance().countStart(static_cast<uint32_t>(waited.count()));
+			}
+		}
+		if (state == LayerState::Stopping) {
+			layer.state.store(LayerState::Finished, std::memory_order_release);
+			continue;
+		}
+		if (state != LayerState::Playing) {
+			continue;
+		}
+		if (!mixLayer(layer, kBlockFrames)) {
+			// Si justo la pidieron detener, igual termina
+			layer.state.store(LayerState::Finished, std::memory_order_release);
+		}
+	}
+	toPcm(m_mix, m_output, kBlockFrames * 2);
+
+	// La mezcla no termina: sin capas manda silencio y la fuente sigue tomada
+	data.samples = m_output;
+	data.sampleCount = kBlockFrames * 2;
+	m_watch.end(data.sampleCount, 2, kSampleRate);
+	return true;
+}
+
+SoftwareMixer::Layer*
+SoftwareMixer::find(MixHandle handle) {
+	if (handle.isNull() || handle.index >= m_layers.size()) {
+		return nullptr;
+	}
+	Layer& layer = m_layers[handle.index];
+	if (layer.generation != handle.generation || layer.state.load(std::memory_order_acquire) == LayerState::Free) {
+		return nullptr;
+	}
+	return &layer;
+}
+
+const SoftwareMixer::Layer*
+SoftwareMixer::find(MixHandle handle) const {
+	return const_cast<SoftwareMixer*>(this)->find(handle);
+}
+
+bool
+SoftwareMixer::mixLayer(Layer& layer, size_t frames) {
+	// Los parmetros se leen una vez por bloque
+	float gain = std::max(layer.gain.load(std::memory_order_relaxed), 0.0f);
+	float pan = std::clamp(layer.pan.load(std::memory_order_relaxed), -1.0f, 1.0f);
+	double step = layer.step * std::max(layer.rate.load(std::memory_order_relaxed), 0.0f);
+	float alpha = std::clamp(layer.lowPass.load(std::memory_order_relaxed), 0.0f, 1.0f);
+	// Paneo de potencia constante: en el centro cada lado va a 0,707
+	float angle = (pan + 1.0f) * 0.785398163f;
+	float left = gain * std::cos(angle);
+	float right = gain * std::sin(angle);
+
+	const sf::Int16* samples = layer.samples;
+	const size_t count = layer.frames;
+	const unsigned int channels = layer.channels;
+	double position = layer.position;
+	size_t produced = frames;
+	bool ended = false;
+	for (size_t i = 0; i < frames; ++i) {
+		if (position >= static_cast<double>(count)) {
+			if (!layer.loop) {
+				produced = i;
+				ended = true;
+				break;
+			}
+			position = std::fmod(position, static_cast<double>(count));
+		}
+		size_t first = static_cast<size_t>(position);
+		size_t second = first + 1 < count ? first + 1 : (layer.loop ? 0 : first);
+		float fraction = static_cast<float>(position - static_cast<double>(first));
+		for (unsigned int channel = 0; channel < channels; ++channel) {
+			float a = samples[first * channels + channel];
+			float b = samples[second * channels + channel];
+			float sample = (a + (b - a) * fraction) * kSampleScale;
+			layer.filter[channel] += alpha * (sample - layer.filter[channel]);
+			m_source[i * channels + channel] = layer.filter[channel];
+		}
+		position += step;
+	}
+	layer.position = position;
+
+	if (channels == 1) {
+		accumulateMono(m_mix, m_source, produced, left, right);
+	}
+	else {
+		accumulateStereo(m_mix, m_source, produced, left, right);
+	}
+	return !ended;
+}
@@ -0,0 +1,125 @@
+#include "Audio/SoundCache.h"
+#include <algorithm>
+#include "Audio/AudioSystem.h"
+#include "Memory/MemoryAccounting.h"
+
+SoundCache::~SoundCache() {
+	m_jobs.wait(m_counter);
+}
+
+SoundRef
+SoundCache::load(const std::string& path) {
+	auto found = m_byPath.find(path);
+	if (found != m_byPath.end()) {
+		touch(*found->second);
+		return found->second;
+	}
+	SoundRef sound = EngineUtilities::MakeIntrusive<SoundAsset>();
+	sound->m_path = path;
+	sound->m_packed = PackLibrary::lookup(path);
+	touch(*sound);
+	m_byPath.emplace(path, sound);
+	++m_pending;
+
+	// El cach tiene una referencia hasta que est listo, as que el trabajo puede usar el puntero
+	SoundAsset* loading = sound.get();
+	m_jobs.run([this, loading]() {
+		sf::InputSoundFile file;
+		// Lo descomprimido tiene que durar lo que la lectura
+		std::vector<unsigned char> unpacked;
+		std::span<const unsigned char> bytes = loading->m_packed.bytes(unpacked, &m_jobs);
+		bool opened = !loading->m_packed.found
+			? file.openFromFile(loading->m_path)
+			: !bytes.empty() && file.openFromMemory(bytes.data(), bytes.size());
+		if (opened) {
+			loading->m_samples.resize(static_cast<size_t>(file.getSampleCount()));
+			loading->m_samples.resize(static_cast<size_t>(file.read(loading->m_samples.data(), loading->m_samples.size())));
+			loading->m_channels = file.getChannelCount();
+			loading->m_sampleRate = file.getSampleRate();
+			loading->m_decoded = true;
+		}
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_decoded.push_back(loading);
+	}, &m_counter);
+	return sound;
+}
+
+void
+SoundCache::preload(std::span<const std::string> bank) {
+	for (const std::string& path : bank) {
+		load(path);
+	}
+}
+
+void
+SoundCache::update() {
+	upload(m_uploadBudget);
+	if (m_resident > m_budget) {
+		evict();
+	}
+}
+
+void
+SoundCache::finishAll() {
+	m_jobs.wait(m_counter);
+	upload(SIZE_MAX);
+	if (m_resident > m_budget) {
+		evict();
+	}
+}
+
+void
+SoundCache::upload(size_t budget) {
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_uploads.insert(m_uploads.end(), m_decoded.begin(), m_decoded.end());
+		m_decoded.clear();
+	}
+	size_t uploaded = 0;
+	while (m_uploadFront < m_uploads.size() && (uploaded == 0 || uploaded < budget)) {
+		SoundAsset* sound = m_uploads[m_uploadFront++];
+		uploaded += sound->m_samples.size() * sizeof(sf::Int16) + 1;
+		--m_pending;
+		if (!sound->m_decoded || sound->m_samples.empty() ||
+		    !sound->m_buffer.loadFromSamples(sound->m_samples.data(), sound->m_samples.size(), sound->m_channels, sound->m_sampleRate)) {
+			MESSAGE("SoundCache", "update", "could not decode a sound file");
+			sound->m_failed = true;
+		}
+		else {
+			sound->m_ready = true;
+			m_resident += sound->bytes();
+			EngineUtilities::MemoryAccounting::onAllocate(EngineUtilities::MemoryCategory::Audio, sound->bytes());
+		}
+		// El bfer de OpenAL tiene su copia
+		std::vector<sf::Int16>().swap(sound->m_samples);
+	}
+	if (m_uploadFront == m_uploads.size()) {
+		m_uploads.clear();
+		m_uploadFront = 0;
+	}
+}
+
+void
+SoundCache::evict() {
+	const AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get();
+	m_candidates.clear();
+	for (const auto& [path, sound] : m_byPath) {
+		// Una referencia es la del cach; otra, de alguien que piensa reproducirlo
+		if (sound->m_ready && sound->refCount() == 1 && !(audio && audio->isUsing(sound->m_buffer))) {
+			m_candidates.push_back(sound.get());
+		}
+	}
+	std::sort(m_candidates.begin(), m_candidates.end(),
+		[](const SoundAsset* a, const SoundAsset* b) { return a->m_lastUse < b->m_lastUse; });
+	for (SoundAsset* sound : m_candidates) {
+		if (m_resident <= m_budget) {
+			break;
+		}
+		m_resident -= sound->bytes();
+		EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Audio, sound->bytes());
+		++m_evicted;
+		// Borrar la entrada suelta la ltima referencia, y con ella la ruta del sonido
+		std::string path = sound->m_path;
+		m_byPath.erase(path);
+	}
+}
@@ -0,0 +1,53 @@
+#include "AudioSource.h"
+
+AudioSource::~AudioSource() {
+	if (!m_params.loop) {
+		return;
+	}
+	if (AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get()) {
+		audio->stop(m_voice);
+	}
+}
+
+void
+AudioSource::setVolume(float volume) {
+	m_params.volume = volume;
+	if (AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get()) {
+		audio->setVolume(m_voice, volume);
+	}
+}
+
+bool
+AudioSource::play() {
+	if (!m_sound || !m_sound->isReady()) {
+		return false;
+	}
+	if (SoundCache* cache = EngineUtilities::TService<SoundCache>::get()) {
+		cache->touch(*m_sound);
+	}
+	AudioSystem& audio = EngineUtilities::TService<AudioSystem>::instance();
+	audio.stop(m_voice);
+	SoundParams params = m_params;
+	params.position = worldPosition();
+	m_voice = audio.play(m_sound->buffer(), params);
+	return !m_voice.isNull();
+}
+
+void
+AudioSource::stop() {
+	if (AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get()) {
+		audio->stop(m_voice);
+	}
+	m_voice = VoiceHandle();
+}
+
+bool
+AudioSource::isPlaying() const {
+	AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get();
+	return audio && audio->isPlaying(m_voice);
+}
+
+sf::Vector2f
+AudioSource::worldPosition() const {
+	return m_transform ? m_transform->getRenderTransform().transformPoint(0.0f, 0.0f) : sf::Vector2f();
+}
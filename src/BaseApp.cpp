@@ -27,98 +27,2005 @@
  * SOFTWARE.
 */
 #include "BaseApp.h"
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include "Math/Quat.h"
+#include "Math/VectorBatch.h"
+#include "Render/LayerCache.h"
+#include "TShape.h"
+#include "Render/TextureLoader.h"
+#include "Simulation/Determinism.h"
+#include "Behavior/ActorBehaviors.h"
+#include "Behavior/BehaviorScheduler.h"
+#include "SceneGraph.h"
+#include "WorldStreamer.h"
 
 int
 BaseApp::run() {
+	m_startup.mark("Run");
+	Profiler::instance().setThreadName("Main");
+	if (m_lockstep) {
+		if (!m_inputReplayPath.empty()) {
+			if (!m_inputLog.open(m_inputReplayPath)) {
+				MESSAGE("BaseApp", "run", "could not read the input log");
+				return 1;
+			}
+			m_simulationStep = m_inputLog.step();
+		}
+		else {
+			m_simulationStep = m_simulationStep > 0.0f ? m_simulationStep : 1.0f / kDefaultSimulationHz;
+			if (!m_inputRecordPath.empty() && !m_inputLog.create(m_inputRecordPath, m_simulationStep)) {
+				MESSAGE("BaseApp", "run", "could not create the input log");
+			}
+		}
+		if (!Determinism::isSupported()) {
+			MESSAGE("BaseApp", "run", "built with fast floating point math, lockstep runs may diverge");
+		}
+	}
+	if (m_server && m_simulationStep <= 0.0f) {
+		m_simulationStep = 1.0f / kDefaultSimulationHz;
+	}
+	// En lockstep todos los pares arrancan con la misma semilla; si no, cada corrida es otra
+	EngineUtilities::TService<RandomService>::instance().setSeed(m_lockstep ? kRandomSeed
+		: static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
 	if (!initialize()) {
 		ERROR("BaseApp", "run", "Initializes result on a false statemente, check method validations");
 	}
-	while (m_window->isOpen()) {
+	if (m_lockstep) {
+		Determinism::configureFloatingPoint();
+	}
+	// Con paso variable un paso de los temporizadores es un frame: se cuenta como uno a 60 Hz
+	EngineUtilities::TService<TimerWheel>::instance().setTickSeconds(
+		m_simulationStep > 0.0f ? m_simulationStep : 1.0f / kDefaultSimulationHz);
+	if (m_useRenderThread && m_window) {
+		m_renderView = m_window->getTarget().getView();
+		m_renderThread.start(*m_window);
+	}
+	if (m_inputSampleRate > 0.0f && m_window) {
+		EngineUtilities::TService<InputSystem>::instance().startSampling(m_inputSampleRate);
+	}
+	uint32_t frameLimit = m_frameLimit == 0 && m_headless ? kDefaultHeadlessFrames : m_frameLimit;
+	uint32_t frames = 0;
+	sf::Clock runClock;
+	bool replayFinished = false;
+	using Clock = std::chrono::steady_clock;
+	const Clock::duration tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(m_simulationStep));
+	Clock::time_point nextTick = Clock::now();
+	Clock::time_point lastStep = Clock::now();
+	Clock::time_point nextFrame = Clock::now();
+	m_lastActivity = Clock::now();
+	if (m_refreshHz == 0.0 && m_window && !m_headless) {
+		m_refreshHz = FramePacer::displayRefreshRate();
+	}
+	auto elapsedMs = [](Clock::time_point from, Clock::time_point to) {
+		return std::chrono::duration<double, std::milli>(to - from).count();
+	};
+	while ((m_server || m_window->isOpen()) && (frameLimit == 0 || frames < frameLimit) && !replayFinished) {
+		m_frameArena.beginFrame();
+		EngineUtilities::AllocationTracker::beginFrame();
+		EngineUtilities::HeapTracker::beginFrame();
+		EngineUtilities::LifetimeTracker::beginFrame();
+		if (m_server) {
+			// Un paso por vuelta, sin eventos ni dibujo
+			if (!sampleInput()) {
+				break;
+			}
+			Transform::beginSimulationStep();
+			deltaTime = sf::seconds(m_simulationStep);
+			Clock::time_point updateStart = Clock::now();
+			update();
+			Clock::time_point updateEnd = Clock::now();
+			EngineUtilities::DeferredReleaseQueue::flush();
+			endProfileFrame();
+			// Sin dibujo, el frame es la vuelta entera, con la espera del paso anterior
+			recordFrameTimes(elapsedMs(lastStep, updateEnd), elapsedMs(updateStart, updateEnd), 0.0);
+			checkMemoryBudgets();
+			checkHeapAllocations(frames);
+			lastStep = updateEnd;
+			if (++frames == 1) {
+				finishStartup();
+			}
+			if (m_serverRealtime) {
+				// Atrasado por ms de un paso, sigue desde ahora en vez de ponerse al da de golpe
+				nextTick += tickDuration;
+				Clock::time_point now = Clock::now();
+				if (nextTick + tickDuration < now) {
+					nextTick = now;
+				}
+				std::this_thread::sleep_until(nextTick);
+			}
+			continue;
+		}
 		m_window->handleEvents();
-		deltaTime = clock.restart();
-		update();
+		updateConsole();
+		sf::Time frameTime = clock.restart();
+		Clock::time_point updateStart = Clock::now();
+		if (m_simulationStep > 0.0f) {
+			// Pasos fijos enteros; lo que sobra se dibuja interpolado. Repitiendo, `m_replaySpeed` por paso real
+			float speed = m_inputLog.isReplaying() ? m_replaySpeed : 1.0f;
+			uint32_t maxSteps = kMaxStepsPerFrame * static_cast<uint32_t>(std::ceil(speed));
+			m_accumulator += frameTime.asSeconds() * speed;
+			uint32_t steps = 0;
+			while (m_accumulator >= m_simulationStep && steps < maxSteps) {
+				if (!sampleInput()) {
+					replayFinished = true;
+					break;
+				}
+				Transform::beginSimulationStep();
+				deltaTime = sf::seconds(m_simulationStep);
+				update();
+				m_accumulator -= m_simulationStep;
+				++steps;
+			}
+			if (steps == maxSteps) {
+				m_accumulator = std::fmod(m_accumulator, m_simulationStep);
+			}
+			Transform::setRenderAlpha(m_accumulator / m_simulationStep);
+		}
+		else {
+			deltaTime = frameTime;
+			sampleInput();
+			update();
+			Transform::setRenderAlpha(1.0f);
+		}
+		Clock::time_point renderStart = Clock::now();
 		render();
+		Clock::time_point renderEnd = Clock::now();
+
+		// Destrucciones diferidas (TDeferredRelease) fuera de update/render
+		EngineUtilities::DeferredReleaseQueue::flush();
+		endProfileFrame();
+		// El que sigue a una espera ociosa la lleva adentro: no es un frame lento
+		if (!m_idleWaited) {
+			recordFrameTimes(frameTime.asMicroseconds() / 1000.0, elapsedMs(updateStart, renderStart), elapsedMs(renderStart, renderEnd));
+		}
+		checkMemoryBudgets();
+		checkHeapAllocations(frames);
+		if (++frames == 1) {
+			finishStartup();
+		}
+		if (!m_headless && paceFrame(nextFrame)) {
+			// Lo dormido hasta el evento no se simula
+			clock.restart();
+		}
 	}
 
+	m_renderThread.stop();
+	if (frameLimit != 0) {
+		float seconds = runClock.getElapsedTime().asSeconds();
+		const char* unit = m_server ? " pasos" : " frames";
+		std::cout << frames << unit << " en " << seconds << " s: " << (seconds > 0.0f ? frames / seconds : 0.0f)
+		          << unit << "/s\n";
+		if (m_redrawOnChange) {
+			std::cout << m_skippedPresents << " frames sin cambios no se dibujaron\n";
+		}
+	}
+	if (m_lockstep) {
+		std::cout << "paso " << m_tick << ", estado " << std::hex << Determinism::checksum(Entity::world()) << std::dec << "\n";
+		if (m_inputLog.isRecording()) {
+			std::cout << m_inputLog.ticks() << " pasos grabados en " << m_inputRecordPath << "\n";
+		}
+		m_inputLog.close();
+	}
 	cleanup();
 	return 0;
 }
 
+int
+BaseApp::runScalingBenchmark(const ScalingBenchmarkOptions& options) {
+	m_headless = options.headless;
+	if (!initialize()) {
+		ERROR("BaseApp", "runScalingBenchmark", "Initializes result on a false statemente, check method validations");
+	}
+
+	if (options.instancedRendering && !m_window->setInstancing(true)) {
+		MESSAGE("BaseApp", "runScalingBenchmark", "OpenGL 3.3 not available, using the SFML path");
+	}
+	if (options.sdfShapes && !m_window->setSdfShapes(true)) {
+		MESSAGE("BaseApp", "runScalingBenchmark", "OpenGL 3.3 not available, circles stay tessellated");
+	}
+	// Los agentes se suben desde el hilo del contexto, que el hilo de render se llevara
+	bool gpuCrowd = options.gpuCrowd;
+	if (gpuCrowd && !m_window->setGpuCrowd({})) {
+		MESSAGE("BaseApp", "runScalingBenchmark", "OpenGL 4.3 not available, using actors");
+		gpuCrowd = false;
+	}
+	else if (gpuCrowd && options.renderThread) {
+		MESSAGE("BaseApp", "runScalingBenchmark", "the GPU crowd draws on the main thread, render thread ignored");
+	}
+	// Sin consultas de tiempo la columna de GPU queda en 0
+	m_window->setGpuTiming(true);
+	if (options.renderThread && !gpuCrowd) {
+		m_renderView = m_window->getTarget().getView();
+		m_renderThread.start(*m_window);
+	}
+
+	// Todos los guardias siguen el mismo recorrido, sin copiarlo, a velocidad constante por su tabla
+	const Path& route = *EngineUtilities::TService<PathLibrary>::instance().find(m_waypointPath);
+	ActorPrefab patrolPrefab("Patrol", ShapeType::CIRCLE);
+	patrolPrefab.setFillColor(sf::Color::Green).addComponent(SplineFollower{ m_waypointPath, 0.0f, 200.0f });
+
+	using Clock = std::chrono::steady_clock;
+	auto elapsedMs = [](Clock::time_point from, Clock::time_point to) {
+		return std::chrono::duration<double, std::milli>(to - from).count();
+	};
+
+	// Con barrido, de un hilo (solo el principal) a todos los del sistema de trabajos
+	JobSystem& jobs = EngineUtilities::TService<JobSystem>::instance();
+	std::vector<unsigned> threadCounts;
+	for (unsigned threads : options.threadCounts) {
+		if (threads == 0) {
+			for (unsigned all = 1; all <= jobs.workerCount() + 1; ++all) {
+				threadCounts.push_back(all);
+			}
+		}
+		else {
+			threadCounts.push_back(std::min(threads, jobs.workerCount() + 1));
+		}
+	}
+	bool sweep = !threadCounts.empty();
+	if (!sweep) {
+		threadCounts.push_back(0);
+	}
+	else {
+		Profiler::instance().setEnabled(true);
+	}
+
+	ScalingReport report;
+	std::vector<EngineUtilities::TSharedPointer<Actor>> patrols;
+	std::vector<GpuAgent> agents;
+	for (size_t count : options.actorCounts) {
+		if (!m_window->isOpen()) {
+			break;
+		}
+		// Repartidos a lo largo de todo el recorrido
+		if (gpuCrowd) {
+			// Las muestras de la tabla, a distancias iguales, son los puntos que siguen en la GPU
+			uint32_t samples = static_cast<uint32_t>(route.samples.size());
+			agents.assign(count, GpuAgent{});
+			for (size_t index = 0; index < count && samples != 0; ++index) {
+				GpuAgent& agent = agents[index];
+				uint32_t at = static_cast<uint32_t>((index % 997) * samples / 997);
+				agent.waypoint = (at + 1) % samples;
+				agent.x = route.samples[at].x;
+				agent.y = route.samples[at].y;
+				agent.targetX = route.samples[agent.waypoint].x;
+				agent.targetY = route.samples[agent.waypoint].y;
+				agent.speed = 200.0f;
+				agent.range = route.sampleStep;
+				agent.color = sf::Color::Green.toInteger();
+			}
+			m_window->setGpuCrowd(agents, route.samples);
+		}
+		else {
+			patrolPrefab.instantiate(m_actors, count, patrols, [&route](size_t index, Actor& actor) {
+				float distance = route.length * static_cast<float>(index % 997) / 997.0f;
+				actor.getComponent<SplineFollower>()->distance = distance;
+				actor.findComponent<Transform>()->setPosition(route.pointAt(distance));
+			});
+		}
+
+		for (unsigned threads : threadCounts) {
+			if (sweep) {
+				jobs.setActiveWorkers(threads - 1);
+			}
+			report.beginSample(count, threads);
+			for (uint32_t frame = 0; frame < options.warmupFrames + options.measuredFrames && m_window->isOpen(); ++frame) {
+				Clock::time_point start = Clock::now();
+				m_frameArena.beginFrame();
+				EngineUtilities::AllocationTracker::beginFrame();
+				EngineUtilities::HeapTracker::beginFrame();
+				EngineUtilities::LifetimeTracker::beginFrame();
+				m_window->handleEvents();
+				deltaTime = sf::seconds(1.0f / 60.0f);
+				Clock::time_point updateStart = Clock::now();
+				Transform::beginSimulationStep();
+				sampleInput();
+				update();
+				if (gpuCrowd) {
+					m_window->advanceGpuCrowd(deltaTime.asSeconds());
+				}
+				Clock::time_point renderStart = Clock::now();
+				render();
+				Clock::time_point renderEnd = Clock::now();
+				EngineUtilities::DeferredReleaseQueue::flush();
+				if (sweep) {
+					endProfileFrame();
+				}
+				if (frame < options.warmupFrames) {
+					continue;
+				}
+				GpuTimings gpu = m_window->gpuTimings();
+				report.addFrame(elapsedMs(updateStart, renderStart), elapsedMs(renderStart, renderEnd),
+				                elapsedMs(start, Clock::now()), gpu.valid ? gpu.totalMs : -1.0);
+				if (sweep) {
+					addScalingSystems(report);
+				}
+			}
+			const ScalingSample& sample = report.endSample();
+			std::cout << sample.actors << " actores";
+			if (sweep) {
+				std::cout << ", " << sample.threads << " hilos";
+			}
+			std::cout << ": update " << sample.updateMs << " ms, render " << sample.renderMs
+			          << " ms, gpu " << sample.gpuMs << " ms, frame p50 " << sample.frameP50Ms << " / p99 " << sample.frameP99Ms << " ms, "
+			          << sample.memoryBytes / (1024 * 1024) << " MB\n";
+			for (size_t i = 0; sweep && i < kScalingSystems; ++i) {
+				std::cout << "  " << ScalingReport::systemName(i) << " " << sample.systemMs[i] << " ms, x" << sample.speedup[i]
+				          << ", eficiencia " << sample.efficiency[i] * 100.0 << "%, serial " << sample.serialFraction[i] * 100.0 << "%\n";
+			}
+		}
+
+		// De vuelta al pool: el siguiente tamao reutiliza sus actores
+		for (EngineUtilities::TSharedPointer<Actor>& actor : patrols) {
+			actor->destroy();
+		}
+		patrols.clear();
+		EngineUtilities::DeferredReleaseQueue::flush();
+	}
+	if (gpuCrowd) {
+		m_window->setGpuCrowd({});
+	}
+
+	m_renderThread.stop();
+	jobs.setActiveWorkers(jobs.workerCount());
+	bool written = report.write(options.outputPath);
+	if (!written) {
+		MESSAGE("BaseApp", "runScalingBenchmark", "could not write the results file");
+	}
+	cleanup();
+	int baseline = PerfBaseline::apply(options.baseline, PerfBaseline::records(report.samples()),
+		[&](const std::string& path) { return report.write(path); }, std::cout);
+	return written ? baseline : 1;
+}
+
+int
+BaseApp::runRenderReplay(const RenderReplayOptions& options) {
+	m_headless = options.headless;
+	createWindow();
+	// Sin consultas de tiempo la columna de GPU queda en 0
+	m_window->setGpuTiming(true);
+	RenderCapture capture;
+	if (!capture.read(options.capturePath) || capture.frameCount() == 0) {
+		MESSAGE("BaseApp", "runRenderReplay", "could not read the render capture");
+		delete m_window;
+		m_window = nullptr;
+		return 1;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	auto elapsedMs = [](Clock::time_point from, Clock::time_point to) {
+		return std::chrono::duration<double, std::milli>(to - from).count();
+	};
+	size_t commands = 0;
+	for (size_t frame = 0; frame < capture.frameCount(); ++frame) {
+		commands += capture.commandCount(frame);
+	}
+
+	ScalingReport report;
+	report.beginSample(commands / capture.frameCount());
+	for (uint32_t loop = 0; loop < options.warmupLoops + options.measuredLoops && m_window->isOpen(); ++loop) {
+		for (size_t frame = 0; frame < capture.frameCount() && m_window->isOpen(); ++frame) {
+			Clock::time_point start = Clock::now();
+			m_window->handleEvents();
+			capture.replay(frame, m_renderCommands);
+			Clock::time_point renderStart = Clock::now();
+			m_window->clear();
+			m_window->getTarget().setView(capture.viewOf(frame));
+			m_window->submit(m_renderCommands);
+			m_window->display();
+			Clock::time_point renderEnd = Clock::now();
+			if (loop >= options.warmupLoops) {
+				GpuTimings gpu = m_window->gpuTimings();
+				report.addFrame(0.0, elapsedMs(renderStart, renderEnd), elapsedMs(start, renderEnd), gpu.valid ? gpu.totalMs : -1.0);
+			}
+		}
+	}
+	const ScalingSample& sample = report.endSample();
+	std::cout << capture.frameCount() << " frames, " << sample.actors << " comandos por frame: render " << sample.renderMs
+	          << " ms, gpu " << sample.gpuMs << " ms, frame p50 " << sample.frameP50Ms << " / p99 " << sample.frameP99Ms << " ms\n";
+
+	m_renderCommands.clear();
+	capture.clear();
+	delete m_window;
+	m_window = nullptr;
+	bool written = report.write(options.outputPath);
+	if (!written) {
+		MESSAGE("BaseApp", "runRenderReplay", "could not write the results file");
+	}
+	int baseline = PerfBaseline::apply(options.baseline, PerfBaseline::records(report.samples()),
+		[&](const std::string& path) { return report.write(path); }, std::cout);
+	return written ? baseline : 1;
+}
+
+int
+BaseApp::runMicrobenchmarks(const MicrobenchmarkOptions& options) {
+	using EngineUtilities::TSharedPointer;
+	MicrobenchmarkSuite suite;
+	std::vector<TSharedPointer<Actor>> actors;
+	const float dt = 1.0f / 60.0f;
+
+	// Solo un caso tiene actores a la vez: cada uno devuelve los del anterior al pool
+	auto spawn = [this, &actors](const ActorPrefab& prefab, size_t count) {
+		for (TSharedPointer<Actor>& actor : actors) {
+			actor->destroy();
+		}
+		actors.clear();
+		EngineUtilities::DeferredReleaseQueue::flush();
+		prefab.instantiate(m_actors, count, actors, [](size_t index, Actor& actor) {
+			actor.findComponent<Transform>()->setPosition(sf::Vector2f(float(index % 1000), float(index / 1000)));
+		});
+	};
+
+	ActorPrefab agentPrefab("Agent", ShapeType::CIRCLE);
+	agentPrefab.addComponent(SteeringAgent{});
+	suite.add("Entity::getComponent", [&](size_t size) -> MicrobenchmarkSuite::Operation {
+		spawn(agentPrefab, size);
+		return [&actors]() {
+			for (TSharedPointer<Actor>& actor : actors) {
+				MicrobenchmarkSuite::keep(actor->getComponent<SteeringAgent>());
+			}
+		};
+	});
+	// Agregar y quitar: cada par mueve la fila entre dos arquetipos y vuelve
+	suite.add("Entity::addComponent", [&](size_t size) -> MicrobenchmarkSuite::Operation {
+		spawn(agentPrefab, size);
+		return [&actors]() {
+			for (TSharedPointer<Actor>& actor : actors) {
+				MicrobenchmarkSuite::keep(actor->addComponent<SeekTarget>(SeekTarget{ sf::Vector2f(1.0f, 1.0f) }));
+				actor->removeComponent<SeekTarget>();
+			}
+		};
+	});
+
+	// El destino cambia en cada vuelta para que nadie llegue y deje de moverse
+	ActorPrefab shapePrefab("Shape", ShapeType::CIRCLE);
+	suite.add("ShapeFactory::Seek", [&](size_t size) -> MicrobenchmarkSuite::Operation {
+		spawn(shapePrefab, size);
+		return [&actors, dt, flip = false]() mutable {
+			flip = !flip;
+			sf::Vector2f target = flip ? sf::Vector2f(-500.0f, -500.0f) : sf::Vector2f(1500.0f, 1500.0f);
+			for (TSharedPointer<Actor>& actor : actors) {
+				actor->findComponent<ShapeFactory>()->Seek(target, 200.0f, dt, 1.0f);
+			}
+		};
+	});
+	struct SeekArrays {
+		std::vector<float> x, y, targetX, targetY, speed, range;
+	};
+	auto seekArrays = EngineUtilities::MakeShared<SeekArrays>();
+	suite.add("ShapeFactory::seekBatch", [seekArrays, dt](size_t size) -> MicrobenchmarkSuite::Operation {
+		SeekArrays& arrays = *seekArrays;
+		arrays.x.assign(size, 0.0f);
+		arrays.y.assign(size, 0.0f);
+		arrays.targetX.assign(size, 1500.0f);
+		arrays.targetY.assign(size, 1500.0f);
+		arrays.speed.assign(size, 200.0f);
+		arrays.range.assign(size, 1.0f);
+		return [&arrays, size, dt]() {
+			ShapeFactory::seekBatch(arrays.x.data(), arrays.y.data(), arrays.targetX.data(), arrays.targetY.data(),
+			                        arrays.speed.data(), arrays.range.data(), size, dt);
+			arrays.targetX.swap(arrays.x);   // El destino nuevo queda lejos otra vez
+			MicrobenchmarkSuite::keep(arrays.x[0]);
+		};
+	});
+
+	// La misma matriz sobre los mismos puntos: un `Vec3` por vez contra arreglos separados
+	struct PointArrays {
+		std::vector<Vec3> points;
+		std::vector<float> x, y, z;
+	};
+	auto pointArrays = EngineUtilities::MakeShared<PointArrays>();
+	const Mat4 pointMatrix = composeTransform(Vec3(10.0f, 20.0f, 0.0f), Quat::fromAxisAngle(Vec3(0.0f, 0.0f, 1.0f), 0.5f), Vec3(1.0f, 1.0f, 1.0f));
+	suite.add("Vec3 transformPoint", [pointArrays, pointMatrix](size_t size) -> MicrobenchmarkSuite::Operation {
+		pointArrays->points.assign(size, Vec3(1.0f, 2.0f, 3.0f));
+		return [&points = pointArrays->points, pointMatrix]() {
+			for (Vec3& point : points) {
+				point = transformPoint(pointMatrix, point);
+			}
+			MicrobenchmarkSuite::keep(points[0].x);
+		};
+	});
+	suite.add("VectorBatch::transformPoints", [pointArrays, pointMatrix](size_t size) -> MicrobenchmarkSuite::Operation {
+		PointArrays& arrays = *pointArrays;
+		arrays.x.assign(size, 1.0f);
+		arrays.y.assign(size, 2.0f);
+		arrays.z.assign(size, 3.0f);
+		return [&arrays, size, pointMatrix]() {
+			VectorBatch::transformPoints(pointMatrix, arrays.x.data(), arrays.y.data(), arrays.z.data(),
+			                             arrays.x.data(), arrays.y.data(), arrays.z.data(), size);
+			MicrobenchmarkSuite::keep(arrays.x[0]);
+		};
+	});
+
+	// El recorrido de la escena normal; si no se carg, uno igual
+	PathLibrary& paths = EngineUtilities::TService<PathLibrary>::instance();
+	PathHandle route = paths.find(m_waypointPath) ? m_waypointPath
+		: paths.create({ { 100.0f, 100.0f }, { 400.0f, 100.0f }, { 400.0f, 400.0f }, { 100.0f, 400.0f } });
+	ActorPrefab followerPrefab("Follower", ShapeType::CIRCLE);
+	followerPrefab.addComponent(SteeringAgent{});
+	BehaviorScheduler patrols;
+	suite.add("BehaviorScheduler::tick", [&](size_t size) -> MicrobenchmarkSuite::Operation {
+		patrols.clear();
+		spawn(followerPrefab, size);
+		for (TSharedPointer<Actor>& actor : actors) {
+			patrols.start(patrol(actor->getHandle(), route), actor->getHandle());
+		}
+		return [&patrols, dt]() {
+			patrols.tick(dt);
+			MicrobenchmarkSuite::keep(patrols.size());
+		};
+	});
+
+	// Un rbol de 4 hijos por nodo cuya raz gira: cada paso recalcula todas las matrices de mundo
+	SceneGraph hierarchy;
+	suite.add("SceneGraph::update", [&](size_t size) -> MicrobenchmarkSuite::Operation {
+		spawn(shapePrefab, size);
+		for (size_t i = 1; i < actors.size(); ++i) {
+			hierarchy.attach(*actors[i], *actors[(i - 1) / 4]);
+		}
+		hierarchy.update();
+		return [&hierarchy, &actors]() {
+			actors.front()->findComponent<Transform>()->rotate(1.0f);
+			hierarchy.update();
+			MicrobenchmarkSuite::keep(hierarchy.lastRecomputed());
+		};
+	});
+
+	// Grabar, ordenar y triangular en lotes como `ShapeBatcher::submit`, sin el draw de GL
+	RenderCommandBuffer commands;
+	ShapeBatcher batcher;
+	suite.add("Actor::render", [&](size_t size) -> MicrobenchmarkSuite::Operation {
+		spawn(shapePrefab, size);
+		return [&actors, &commands, &batcher]() {
+			commands.clear();
+			for (TSharedPointer<Actor>& actor : actors) {
+				actor->render(commands);
+			}
+			commands.sort();
+			batcher.clear();
+			commands.forEach([&batcher](const DrawCommand& command) {
+				if (ShapeBatcher::isBatchable(command)) {
+					batcher.append(command);
+				}
+			});
+			MicrobenchmarkSuite::keep(batcher.vertices().size());
+		};
+	});
+
+	struct Payload {
+		uint64_t value = 0;
+	};
+	auto shared = EngineUtilities::MakeShared<std::vector<TSharedPointer<Payload>>>();
+	auto weak = EngineUtilities::MakeShared<std::vector<EngineUtilities::TWeakPointer<Payload>>>();
+	suite.add("MakeShared", [](size_t size) -> MicrobenchmarkSuite::Operation {
+		return [size]() {
+			for (size_t i = 0; i < size; ++i) {
+				MicrobenchmarkSuite::keep(EngineUtilities::MakeShared<Payload>(Payload{ i }));
+			}
+		};
+	});
+	suite.add("TSharedPointer::copy", [shared](size_t size) -> MicrobenchmarkSuite::Operation {
+		shared->clear();
+		for (size_t i = 0; i < size; ++i) {
+			shared->push_back(EngineUtilities::MakeShared<Payload>(Payload{ i }));
+		}
+		return [shared]() {
+			for (const TSharedPointer<Payload>& pointer : *shared) {
+				TSharedPointer<Payload> copy = pointer;
+				MicrobenchmarkSuite::keep(copy);
+			}
+		};
+	});
+	suite.add("TWeakPointer::lock", [shared, weak](size_t size) -> MicrobenchmarkSuite::Operation {
+		shared->clear();
+		weak->clear();
+		for (size_t i = 0; i < size; ++i) {
+			shared->push_back(EngineUtilities::MakeShared<Payload>(Payload{ i }));
+			weak->emplace_back(shared->back());
+		}
+		return [weak]() {
+			for (const EngineUtilities::TWeakPointer<Payload>& pointer : *weak) {
+				MicrobenchmarkSuite::keep(pointer.lock());
+			}
+		};
+	});
+	suite.add("MakeUnique", [](size_t size) -> MicrobenchmarkSuite::Operation {
+		return [size]() {
+			for (size_t i = 0; i < size; ++i) {
+				MicrobenchmarkSuite::keep(EngineUtilities::MakeUnique<Payload>(Payload{ i }));
+			}
+		};
+	});
+
+	suite.run(options, std::cout);
+	patrols.clear();
+	for (TSharedPointer<Actor>& actor : actors) {
+		actor->destroy();
+	}
+	actors.clear();
+	EngineUtilities::DeferredReleaseQueue::flush();
+	if (route != m_waypointPath) {
+		paths.release(route);
+	}
+
+	bool written = suite.write(options.outputPath);
+	if (!written) {
+		MESSAGE("BaseApp", "runMicrobenchmarks", "could not write the results file");
+	}
+	int baseline = PerfBaseline::apply(options.baseline, PerfBaseline::records(suite.results()),
+		[&](const std::string& path) { return suite.write(path); }, std::cout);
+	return written ? baseline : 1;
+}
+
 bool
 BaseApp::initialize() {
-	m_window = new Window(800, 600, "Galvan Engine");
+	// La ventana y su contexto en este hilo mientras los trabajos arman la escena. Lo que toca
+	// el mundo, los actores o el ndice va en una sola cadena: el mundo es de un hilo a la vez
+	using TaskId = TaskGraph::TaskId;
+	for (const std::string& pack : m_packPaths) {
+		EngineUtilities::TService<PackLibrary>::instance().mount(pack);
+	}
+	if (m_cookedOnly) {
+		EngineUtilities::TService<MeshLoader>::instance().setCookedOnly(true);
+		EngineUtilities::TService<TextureLoader>::instance().setCookedOnly(true);
+	}
+	TaskId window = m_startup.add("Window", [this]() { createWindow(); }, {}, TaskGraph::Affinity::Main);
+	TaskId index = m_startup.add("SpatialIndex", []() {
+		// ndice de lo que se dibuja; las entidades activas desde antes tambin entran
+		SpatialGrid& grid = EngineUtilities::TService<SpatialGrid>::instance();
+		for (Entity* entity : EngineUtilities::TService<ActiveEntities>::instance().entities()) {
+			grid.insert(*entity);
+		}
+	});
+	TaskId waypoints = m_startup.add("Waypoints", [this]() {
+		// Recorrido de reserva; la escena trae el suyo
+		PathLibrary& paths = EngineUtilities::TService<PathLibrary>::instance();
+		if (!paths.find(m_waypointPath)) {
+			m_waypointPath = paths.create({ { 100.0f, 100.0f }, { 400.0f, 100.0f }, { 400.0f, 400.0f }, { 100.0f, 400.0f } },
+				true, PathCurve::CatmullRom);
+		}
+	});
+	TaskId scene = m_startup.add("Scene", [this]() {
+		// La escena sale del archivo; sin ninguno empieza vaca
+		std::string path = scenePath();
+		if (path.empty() || !loadScene(path)) {
+			MESSAGE("BaseApp", "initialize", "no valid scene file, the scene starts empty");
+		}
+	}, { index, waypoints });
+	TaskId setup = m_startup.add("SceneSetup", [this]() { setupScene(); }, { scene });
+	m_startup.add("NavGrid", [this]() {
+		// Grilla de navegacin del tamao de la ventana, sin obstculos; `Pathfinder` busca en ella
+		sf::Vector2u viewSize = sceneSize();
+		EngineUtilities::TService<NavGrid>::instance().resize(
+			static_cast<uint32_t>(std::ceil(viewSize.x / kNavCellSize)), static_cast<uint32_t>(std::ceil(viewSize.y / kNavCellSize)), kNavCellSize);
+	}, { window });
+	m_startup.add("Crowd", [this]() {
+		// Multitud: seek hacia adelante en el campo y separacin entre vecinos
+		if (m_crowdSize > 0) {
+			SteeringAgent steering;
+			steering.weights.seek = 1.0f;
+			steering.weights.separation = 1.5f;
+			steering.maxSpeed = 120.0f;
+			steering.neighborRadius = 12.0f;
+			ActorPrefab crowdPrefab("Crowd", ShapeType::CIRCLE);
+			crowdPrefab.setFillColor(sf::Color(255, 160, 60)).setScale(sf::Vector2f(0.3f, 0.3f))
+				.addComponent(steering).addComponent(FlowFollower{});
+			sf::Vector2f area(static_cast<float>(sceneSize().x), static_cast<float>(sceneSize().y));
+			crowdPrefab.instantiate(m_actors, m_crowdSize, m_crowd, [area](size_t index, Actor& actor) {
+				// Repartidos en una malla casi uniforme, sin nmeros aleatorios
+				float u = std::fmod(static_cast<float>(index) * 0.618034f, 1.0f);
+				float v = std::fmod(static_cast<float>(index) * 0.381966f + 0.5f * u, 1.0f);
+				actor.findComponent<Transform>()->setPosition(u * area.x, v * area.y);
+			});
+		}
+	}, { window, setup });
+	m_startup.add("Systems", [this]() { registerSystems(); });
+	m_startup.run(EngineUtilities::TService<JobSystem>::instance());
+
+	// En desarrollo, editar una textura, un shader o la escena se ve sin reiniciar
+	if (kHotReload) {
+		AssetManager& assets = EngineUtilities::TService<AssetManager>::instance();
+		if (assets.setHotReload(true)) {
+			assets.watch(kScenePath);
+			assets.watch(kSceneSourcePath);
+		}
+		else {
+			MESSAGE("BaseApp", "initialize", "the file watcher could not start, assets will not hot reload");
+		}
+	}
+
+	// La escena ya dio los mismos ids que en la corrida guardada: solo falta su estado
+	if (!m_journalPath.empty()) {
+		if (SaveJournal::load(m_journalPath, Entity::world()) < 0 && std::filesystem::exists(m_journalPath)) {
+			MESSAGE("BaseApp", "initialize", "the save journal is not valid, starting from the scene");
+		}
+		if (!m_journal.open(m_journalPath)) {
+			MESSAGE("BaseApp", "initialize", "could not open the save journal");
+		}
+	}
+
+	// Despus de la escena: los ids de red salen de su orden
+	if (m_netPort != 0) {
+		bool opened = m_netAddress.empty() ? m_net.host(m_netPort) : m_net.connect(sf::IpAddress(m_netAddress), m_netPort);
+		if (!opened) {
+			MESSAGE("BaseApp", "initialize", "could not open the network socket");
+		}
+	}
+
+	registerConsole();
+	// Las rdenes escritas cambian la simulacin: van al registro con el paso que sigue
+	m_console.setTypedHook([this](std::string_view line) { m_inputLog.recordEvent(TickEventType::ConsoleLine, line); });
+	for (const std::string& line : m_consoleCommands) {
+		m_console.execute(line);
+	}
+	return m_server || m_window;
+}
+
+void
+BaseApp::setupScene() {
+	// El decorado no se mueve: se hornea una vez en la GPU en vez de triangularse cada frame
+	for (const EngineUtilities::TSharedPointer<Actor>& actor : m_sceneActors) {
+		if (ShapeFactory* shape = actor->hasTags(kTagScenery) ? actor->findComponent<ShapeFactory>() : nullptr) {
+			shape->setStatic(true);
+		}
+	}
+
+	// Cada figura de la escena entra al broadphase con su caja; el decorado, como esttico
+	EngineUtilities::TService<PhysicsWorld>::instance().setDeterministic(m_lockstep);
+	for (const EngineUtilities::TSharedPointer<Actor>& actor : m_sceneActors) {
+		const ShapeFactory* shape = actor->findComponent<ShapeFactory>();
+		if (shape && shape->getShape() && !actor->findComponent<Collider>()) {
+			EngineUtilities::TIntrusivePtr<Collider> collider = EngineUtilities::MakeIntrusive<Collider>();
+			collider->setBounds(shape->getShape()->getLocalBounds());
+			collider->setStatic(actor->hasTags(kTagScenery));
+			actor->addComponent(collider);
+		}
+	}
+
+	// El crculo se mueve con `SteeringSystem` (arrive y un poco de wander); su patrulla
+	// solo le cambia el destino
+	if (Circle) {
+		SteeringAgent steering;
+		steering.target = EngineUtilities::TService<PathLibrary>::instance().find(m_waypointPath)->points.front();
+		steering.weights.arrive = 1.0f;
+		steering.weights.wander = 0.2f;
+		Circle->addComponent<SteeringAgent>(steering);
+		BehaviorScheduler& behaviors = BehaviorScheduler::instance();
+		behaviors.stop(Circle->getHandle());
+		behaviors.start(patrol(Circle->getHandle(), m_waypointPath), Circle->getHandle());
+
+		// Estela: las partculas se quedan donde salieron mientras el crculo avanza
+		EngineUtilities::TService<ParticleSystem>::instance();
+		EngineUtilities::TIntrusivePtr<ParticleEmitter> trail = EngineUtilities::MakeIntrusive<ParticleEmitter>();
+		trail->setTransform(Circle->findComponent<Transform>());
+		trail->setRate(120.0f);
+		trail->setDirection(0.0f, 360.0f);
+		trail->setSpeed(5.0f, 20.0f);
+		trail->setColor(sf::Color(120, 160, 255));
+		trail->setSeed(kTrailSeed);
+		Circle->addComponent(trail);
+	}
+}
+
+void
+BaseApp::createWindow() {
+	// Sin ventana no hay nada que dibujar: ni contexto, ni efectos, ni capturas
+	m_window = m_server ? nullptr : new Window(kWindowWidth, kWindowHeight, "Galvan Engine", m_headless, m_eventThread);
+	if (!m_server && !m_window) {
+		ERROR("BaseApp", "createWindow", "Error on window creation, var is null");
+		return;
+	}
+	if (m_postProcessing && m_window) {
+		PostProcessStack& effects = m_window->postProcess();
+		effects.add<BloomEffect>(PostEffect::Quarter).setThreshold(0.6f);
+		effects.add<ColorGradingEffect>().setSaturation(1.1f);
+	}
+	if (!m_recordDirectory.empty() && m_window) {
+		m_window->frameCapture().setRecording(true, m_recordDirectory);
+	}
+	if (m_dynamicResolutionMs > 0.0 && m_window) {
+		DynamicResolution::Settings resolution;
+		resolution.targetMs = m_dynamicResolutionMs;
+		if (!m_window->setDynamicResolution(true, resolution)) {
+			MESSAGE("BaseApp", "createWindow", "GPU timer queries are not available, dynamic resolution is off");
+		}
+	}
+	// Tracy muestra los pases de GPU aunque el overlay est oculto
+	if (kTracy && m_window) {
+		m_window->setGpuTiming(true);
+	}
+}
+
+void
+BaseApp::registerSystems() {
+	// Sistemas por frame
+	m_systems.addSystem("Behaviors", ComponentAccess().writes<SteeringAgent>().reads<Transform>(),
+		[](World&, float dt) { BehaviorScheduler::instance().tick(dt); });
+	m_systems.addSystem("PathFollow", ComponentAccess().writes<PathFollower>().writes<SeekTarget>().reads<Transform>(),
+		[](World& world, float) {
+			EngineUtilities::TService<PathLibrary>::instance().follow(world, EngineUtilities::TService<JobSystem>::instance());
+		});
+	m_systems.addSystem("SplineFollow", ComponentAccess().writes<SplineFollower>().writes<Transform>(),
+		[](World& world, float dt) {
+			EngineUtilities::TService<PathLibrary>::instance().ride(world, EngineUtilities::TService<JobSystem>::instance(), dt);
+		});
+	EngineUtilities::TService<AnimationLibrary>::instance().setBudget(kAnimationBudget);
+	m_systems.addSystem("Animation", ComponentAccess().writes<AnimationPlayer>().writes<Transform>().writes<ShapeFactory>(),
+		[this](World& world, float dt) {
+			AnimationLibrary& animations = EngineUtilities::TService<AnimationLibrary>::instance();
+			// Antes del primer frame dibujado no hay zona: todo cuenta como a la vista
+			if (!m_lod) {
+				animations.clearVisibleArea();
+			}
+			else if (m_visibleArea.width > 0.0f) {
+				animations.setVisibleArea(m_visibleArea);
+			}
+			animations.animate(world, EngineUtilities::TService<JobSystem>::instance(), dt);
+		});
+	m_systems.addSystem("SeekMovement", ComponentAccess().reads<SeekTarget>().writes<Transform>(),
+		[](World& world, float dt) {
+			// Cada trozo se junta en arreglos, pasa por el kernel SIMD y vuelve a los `Transform`
+			using SeekView = WorldView<const SeekTarget, Transform>;
+			parallelForRows(EngineUtilities::TService<JobSystem>::instance(), world.view<const SeekTarget, Transform>(), 256,
+				[dt](Archetype& archetype, size_t begin, size_t end) {
+					constexpr size_t kBlock = 256;
+					float x[kBlock], y[kBlock], targetX[kBlock], targetY[kBlock], speed[kBlock], range[kBlock];
+					for (size_t first = begin; first < end; first += kBlock) {
+						size_t last = std::min(end, first + kBlock);
+						size_t n = 0;
+						auto gather = [&](EntityId, const SeekTarget& seek, Transform& transform) {
+							x[n] = transform.getPosition().x;
+							y[n] = transform.getPosition().y;
+							targetX[n] = seek.target.x;
+							targetY[n] = seek.target.y;
+							speed[n] = seek.speed;
+							range[n] = seek.range;
+							++n;
+						};
+						SeekView::eachRow(archetype, first, last, gather);
+						ShapeFactory::seekBatch(x, y, targetX, targetY, speed, range, n, dt);
+						n = 0;
+						auto scatter = [&](EntityId, const SeekTarget&, Transform& transform) {
+							transform.setPosition(x[n], y[n]);
+							++n;
+						};
+						SeekView::eachRow(archetype, first, last, scatter);
+					}
+				});
+		});
+	m_systems.addSystem("FlowFollow", ComponentAccess().reads<FlowFollower>().writes<SteeringAgent>().reads<Transform>(),
+		[this](World& world, float) {
+			if (!m_crowdField.isReady()) {
+				return;
+			}
+			const FlowField& field = m_crowdField;
+			const UpdateLod& lod = m_aiLod;
+			parallelForEach(EngineUtilities::TService<JobSystem>::instance(), world.view<const FlowFollower, SteeringAgent, const Transform>(), 256,
+				[&field, &lod](EntityId entity, const FlowFollower& follower, SteeringAgent& steering, const Transform& transform) {
+					// Lejos de la vista el destino se refresca cuando le toca al steering
+					if (lod.dueInterval(entity.index, transform.getPosition()) == 0) {
+						return;
+					}
+					// Sin direccin (la celda del destino, o sin camino) va derecho al destino
+					sf::Vector2f direction = field.direction(transform.getPosition());
+					if (direction.x == 0.0f && direction.y == 0.0f) {
+						steering.target = field.target();
+					}
+					else {
+						steering.target = transform.getPosition() + direction * follower.lookahead;
+					}
+				});
+		});
+	m_systems.addSystem("Steering", ComponentAccess().writes<SteeringAgent>().writes<Transform>(),
+		[this](World& world, float dt) { m_steering.update(world, EngineUtilities::TService<JobSystem>::instance(), dt, &m_aiLod); });
+	m_systems.addReactiveSystem("Broadphase", ComponentAccess().reads<Transform>().writes<Collider>(),
+		[](World& world, float, uint32_t since) { EngineUtilities::TService<PhysicsWorld>::instance().syncColliders(world, since); });
+	m_systems.addSystem("Physics", ComponentAccess().writes<Collider>().writes<Transform>(),
+		[](World&, float dt) {
+			EngineUtilities::TService<PhysicsWorld>::instance().step(dt, &EngineUtilities::TService<JobSystem>::instance());
+		});
+	// Despus de todo lo que mueve: las matrices de mundo de las jerarquas quedan listas para el render
+	m_systems.addSystem("SceneGraph", ComponentAccess().writes<Transform>(),
+		[](World&, float) { SceneGraph::instance().update(); });
+	m_systems.addReactiveSystem("SpatialIndex",
+		ComponentAccess().reads<Transform>().reads<ShapeFactory>().reads<SpatialItem>(),
+		[](World& world, float, uint32_t since) { updateSpatialIndex(world, since); });
+	m_systems.addReactiveSystem("Picking", ComponentAccess().reads<Transform>().writes<MeshRenderer>(),
+		[](World& world, float, uint32_t since) { EngineUtilities::TService<Picking>::instance().syncMeshes(world, since); });
+	// Solo si algo pidi el audio: el modo servidor no abre el dispositivo
+	m_systems.addReactiveSystem("AudioSources", ComponentAccess().reads<Transform>().reads<AudioSource>(),
+		[](World& world, float, uint32_t since) {
+			if (AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get()) {
+				audio->syncSources(world, since, &EngineUtilities::TService<JobSystem>::instance());
+			}
+		});
+
+	// Eventos: el crculo cambia de color en cada waypoint, sin revisar su posicin cada frame
+	EventBus& events = EngineUtilities::TService<EventBus>::instance();
+	events.subscribe<WaypointReached>([this](const WaypointReached& reached) {
+		static const sf::Color palette[] = { sf::Color::Blue, sf::Color::Cyan, sf::Color::Magenta, sf::Color::Yellow };
+		if (ShapeFactory* shape = Circle ? Circle->findComponent<ShapeFactory>() : nullptr) {
+			shape->setFillColor(palette[reached.waypoint % 4]);
+		}
+	});
+
+	// La escena cambi en disco: se vuelve a armar desde l, la multitud se queda
+	events.subscribe<AssetReloaded>([this](const AssetReloaded& reloaded) {
+		if (reloaded.id != assetId(kScenePath) && reloaded.id != assetId(kSceneSourcePath)) {
+			return;
+		}
+		std::string path = scenePath();
+		if (!path.empty() && loadScene(path)) {
+			setupScene();
+		}
+	});
+
+	events.subscribe<KeyPressed>([this](const KeyPressed& pressed) {
+		if (pressed.key == sf::Keyboard::F5 && !saveScene(kScenePath)) {
+			MESSAGE("BaseApp", "saveScene", "could not write the scene file");
+		}
+		if (pressed.key == sf::Keyboard::F3) {
+			showStats(!m_window->isStatsOverlay());
+		}
+		if (pressed.key == sf::Keyboard::Tilde) {
+			m_console.setOpen(!m_console.isOpen());
+		}
+		if (m_console.isOpen() && (pressed.key == sf::Keyboard::Up || pressed.key == sf::Keyboard::Down)) {
+			m_console.recall(pressed.key == sf::Keyboard::Up ? -1 : 1);
+		}
+		if (pressed.key == sf::Keyboard::F4 && !m_profileTrace.isActive()) {
+			setProfileTrace("trace_" + std::to_string(m_profileTraces++) + ".json");
+		}
+		if (pressed.key == sf::Keyboard::F12) {
+			m_window->frameCapture().requestScreenshot("screenshot_" + std::to_string(m_screenshots++) + ".png");
+		}
+	});
+
+	// Componentes: Transform por lotes; ShapeFactory, MeshRenderer, Camera, Tilemap, PointLight, Collider y AudioSource no tienen nada que actualizar
+	m_componentUpdater.registerBatch<Transform>(&Transform::updateBatch);
+	m_componentUpdater.registerNoUpdate<ShapeFactory>();
+	m_componentUpdater.registerNoUpdate<MeshRenderer>();
+	m_componentUpdater.registerNoUpdate<Camera>();
+	m_componentUpdater.registerNoUpdate<Tilemap>();
+	m_componentUpdater.registerNoUpdate<PointLight>();
+	m_componentUpdater.registerNoUpdate<Collider>();
+	m_componentUpdater.registerNoUpdate<AudioSource>();
+}
+
+void
+BaseApp::registerConsole() {
+	JobSystem& jobs = EngineUtilities::TService<JobSystem>::instance();
+	m_console.addBool("r_culling", "solo se graba lo que toca la vista (SpatialGrid)",
+		[this]() { return m_culling; }, [this](bool enabled) { m_culling = enabled; });
+	m_console.addBool("r_parallel_record", "graba los comandos de las entidades en trozos del job system",
+		[this]() { return m_parallelRecord; }, [this](bool enabled) { m_parallelRecord = enabled; });
+	m_console.addBool("r_lod", "la IA y las animaciones lejanas van cada varios pasos",
+		[this]() { return m_lod; }, [this](bool enabled) { m_lod = enabled; });
+	m_console.addBool("jobs_threads", "sistemas, parallelFor y cargas en los hilos de trabajo",
+		[&jobs]() { return !jobs.isInline(); }, [&jobs](bool enabled) { jobs.setInline(!enabled); });
+	m_console.addFloat("sim_hz", "pasos de simulacin por segundo; 0 es paso variable",
+		[this]() { return m_simulationStep > 0.0f ? 1.0f / m_simulationStep : 0.0f; },
+		[this](float hz) {
+			// El registro y los pares de lockstep dependen del paso, y el servidor no tiene paso variable
+			if (hz < 0.0f || m_lockstep || (m_server && hz == 0.0f)) {
+				return false;
+			}
+			setSimulationRate(hz);
+			m_accumulator = 0.0f;
+			EngineUtilities::TService<TimerWheel>::instance().setTickSeconds(hz > 0.0f ? 1.0f / hz : 1.0f / kDefaultSimulationHz);
+			return true;
+		});
+	m_console.addFloat("world_budget_ms", "milisegundos por frame para crear y destruir actores de regiones (WorldStreamer)",
+		[]() { return WorldStreamer::instance().activationBudget() * 1000.0f; },
+		[](float ms) {
+			if (ms < 0.0f) {
+				return false;
+			}
+			WorldStreamer::instance().setActivationBudget(ms / 1000.0f);
+			return true;
+		});
+	m_console.addCommand("spawn", "<cantidad> [circles|rectangles|triangles]", "actores que recorren los waypoints",
+		[this](Console::Arguments arguments) {
+			size_t count = 0;
+			if (arguments.empty() || arguments.size() > 2 ||
+			    std::from_chars(arguments[0].data(), arguments[0].data() + arguments[0].size(), count).ec != std::errc()) {
+				return false;
+			}
+			std::string_view kind = arguments.size() > 1 ? arguments[1] : "circles";
+			ShapeType shape = kind == "circles" ? ShapeType::CIRCLE : kind == "rectangles" ? ShapeType::RECTANGLE
+				: kind == "triangles" ? ShapeType::TRIANGLE : ShapeType::EMPTY;
+			const Path* route = EngineUtilities::TService<PathLibrary>::instance().find(m_waypointPath);
+			if (shape == ShapeType::EMPTY || !route) {
+				return false;
+			}
+			// Como en `runScalingBenchmark`: repartidos por el recorrido, a velocidad constante
+			ActorPrefab prefab("Spawned", shape);
+			prefab.setFillColor(sf::Color::Green).addComponent(SplineFollower{ m_waypointPath, 0.0f, 200.0f });
+			prefab.instantiate(m_actors, count, m_spawned, [route](size_t index, Actor& actor) {
+				float distance = route->length * static_cast<float>(index % 997) / 997.0f;
+				actor.getComponent<SplineFollower>()->distance = distance;
+				actor.findComponent<Transform>()->setPosition(route->pointAt(distance));
+			});
+			m_console.print(std::to_string(m_spawned.size()) + " actores de spawn");
+			return true;
+		});
+	m_console.addCommand("despawn", "", "quita todo lo de spawn", [this](Console::Arguments arguments) {
+		if (!arguments.empty()) {
+			return false;
+		}
+		for (EngineUtilities::TSharedPointer<Actor>& actor : m_spawned) {
+			actor->destroy();
+		}
+		m_spawned.clear();
+		return true;
+	});
+	m_console.addCommand("find", "<nombre>", "cuntos actores se llaman as y dnde est uno (ndice de EntityRegistry)",
+		[this](Console::Arguments arguments) {
+			if (arguments.size() != 1) {
+				return false;
+			}
+			NameId name = NameTable::instance().find(arguments[0]);
+			std::span<const EntityHandle> named = Entity::registry().allNamed(name);
+			Actor* actor = Actor::find(arguments[0]);
+			Transform* transform = actor ? actor->findComponent<Transform>() : nullptr;
+			std::string found = std::to_string(named.size()) + " actores";
+			if (transform) {
+				found += "; uno en (" + std::to_string(transform->getPosition().x) + ", " +
+					std::to_string(transform->getPosition().y) + ")";
+			}
+			m_console.print(found);
+			return true;
+		});
+	m_console.addCommand("capture", "trace [frames] | screenshot | render <archivo> [frames]",
+		"traza del profiler, captura de pantalla o comandos de dibujo para --replay-render",
+		[this](Console::Arguments arguments) {
+			if (!arguments.empty() && arguments[0] == "trace" && arguments.size() <= 2) {
+				uint32_t frames = TraceCapture::kDefaultFrames;
+				if (arguments.size() == 2 &&
+				    std::from_chars(arguments[1].data(), arguments[1].data() + arguments[1].size(), frames).ec != std::errc()) {
+					return false;
+				}
+				if (m_profileTrace.isActive()) {
+					m_console.print("ya hay una traza en curso: " + m_profileTrace.path());
+					return true;
+				}
+				setProfileTrace("trace_" + std::to_string(m_profileTraces++) + ".json", frames);
+				m_console.print("traza de " + std::to_string(frames) + " frames en " + m_profileTrace.path());
+				return true;
+			}
+			if (arguments.size() >= 2 && arguments.size() <= 3 && arguments[0] == "render") {
+				uint32_t frames = 1;
+				if (arguments.size() == 3 &&
+				    std::from_chars(arguments[2].data(), arguments[2].data() + arguments[2].size(), frames).ec != std::errc()) {
+					return false;
+				}
+				setRenderCapture(std::string(arguments[1]), frames);
+				return true;
+			}
+			if (arguments.size() == 1 && arguments[0] == "screenshot" && m_window) {
+				m_window->frameCapture().requestScreenshot("screenshot_" + std::to_string(m_screenshots++) + ".png");
+				return true;
+			}
+			return false;
+		});
+	m_console.addFloat("hitch_ms", "milisegundos desde los que un frame escribe su traza (hitch_N.json); 0 apaga",
+		[this]() { return static_cast<float>(m_hitches.thresholdMs()); },
+		[this](float ms) {
+			if (ms < 0.0f) {
+				return false;
+			}
+			setHitchTrace(ms);
+			return true;
+		});
+	m_console.addBool("prof_entities", "tiempo de update y render de cada actor y cada tipo de componente, muestreado",
+		[this]() { return m_entityCosts.isEnabled(); },
+		[this](bool enabled) {
+			m_entityCosts.setEnabled(enabled);
+			if (m_window) {
+				m_window->setEntityCosts(EntityCostReport{});
+			}
+		});
+	m_console.addFloat("prof_entities_every", "prof_entities mide uno de cada tantos frames",
+		[this]() { return static_cast<float>(m_entityCosts.sampleEvery()); },
+		[this](float frames) {
+			if (frames < 1.0f) {
+				return false;
+			}
+			m_entityCosts.setSampleEvery(static_cast<uint32_t>(frames));
+			return true;
+		});
+	m_console.addBool("prof_hw_counters", "ciclos, instrucciones y fallos de cach por zona (HardwareCounters)",
+		[]() { return HardwareCounters::isEnabled(); },
+		[this](bool enabled) {
+			if (!HardwareCounters::setEnabled(enabled)) {
+				m_console.print("esta plataforma o sus permisos no dan los contadores (perf_event_paranoid)");
+			}
+		});
+
 	if (!m_window) {
-		ERROR("BaseApp", "initialize", "Error on window creation, var is null");
+		return;
+	}
+	// Lo que toca el contexto de OpenGL solo se cambia con l en este hilo
+	auto needsContext = [this]() {
+		if (m_renderThread.isRunning()) {
+			m_console.print("con el hilo de render activo no; r_render_thread 0 primero");
+			return false;
+		}
+		return true;
+	};
+	m_console.addBool("r_batching", "junta las figuras iguales en un draw call (ShapeBatcher)",
+		[this]() { return m_window->shapeBatcher().isEnabled(); },
+		[this](bool enabled) { m_window->shapeBatcher().setEnabled(enabled); });
+	m_console.addBool("r_instancing", "figuras con instancing de OpenGL",
+		[this]() { return m_window->isInstancing(); },
+		[this, needsContext](bool enabled) {
+			if (needsContext() && !m_window->setInstancing(enabled)) {
+				m_console.print("OpenGL 3.3 no disponible");
+			}
+		});
+	m_console.addBool("r_stream", "lotes sin textura y partculas por un bfer en anillo mapeado",
+		[this]() { return m_window->isStreaming(); },
+		[this, needsContext](bool enabled) {
+			if (needsContext() && !m_window->setStreaming(enabled)) {
+				m_console.print("OpenGL 3.3 no disponible");
+			}
+		});
+	m_console.addBool("r_sdf", "crculos y polgonos por distancia, un quad cada uno",
+		[this]() { return m_window->isSdfShapes(); },
+		[this, needsContext](bool enabled) {
+			if (needsContext() && !m_window->setSdfShapes(enabled)) {
+				m_console.print("OpenGL 3.3 no disponible");
+			}
+		});
+	m_console.addBool("r_vsync", "espera el refresco de la pantalla en cada frame",
+		[this]() { return m_window->isVerticalSync(); },
+		[this, needsContext](bool enabled) {
+			if (needsContext()) {
+				m_window->setVerticalSync(enabled);
+			}
+		});
+	m_console.addBool("r_render_thread", "dibuja en un RenderThread mientras se simula el frame siguiente",
+		[this]() { return m_renderThread.isRunning(); },
+		[this](bool enabled) {
+			if (enabled && !m_renderThread.isRunning()) {
+				m_renderView = m_window->getTarget().getView();
+				m_renderThread.start(*m_window);
+			}
+			else if (!enabled) {
+				m_renderThread.stop();
+			}
+		});
+	m_console.addBool("stats", "overlay de estadsticas y profiler (F3)",
+		[this]() { return m_window->isStatsOverlay(); }, [this](bool enabled) { showStats(enabled); });
+	m_console.addFloat("fps_max", "tope de frames por segundo; 0 sin tope",
+		[this]() { return m_frameCap; },
+		[this](float hz) {
+			if (hz < 0.0f) {
+				return false;
+			}
+			setFrameCap(hz);
+			return true;
+		});
+	m_console.addBool("r_redraw_on_change", "no dibuja ni presenta los frames sin cambios visibles",
+		[this]() { return m_redrawOnChange; }, [this](bool enabled) { setRedrawOnChange(enabled); });
+	m_console.addBool("fps_spin", "el tope gira los ltimos microsegundos en vez de solo dormir (FramePacer)",
+		[this]() { return m_framePacer.isSpinEnabled(); }, [this](bool enabled) { m_framePacer.setSpinEnabled(enabled); });
+	m_console.addBool("idle", "sin foco o sin cambios baja a idle_hz frames por segundo",
+		[this]() { return m_idleMode; }, [this](bool enabled) { setIdleMode(enabled, m_idleHz, m_idleAfter); });
+	m_console.addFloat("idle_hz", "frames por segundo del modo ocioso; 0 duerme hasta el prximo evento",
+		[this]() { return m_idleHz; },
+		[this](float hz) {
+			if (hz < 0.0f) {
+				return false;
+			}
+			setIdleMode(m_idleMode, hz, m_idleAfter);
+			return true;
+		});
+}
+
+void
+BaseApp::updateConsole() {
+	EngineUtilities::HeapTracker::Scope heapScope;
+	if (!m_console.isOpen()) {
+		m_window->setConsoleText(std::string());
+		return;
+	}
+	for (const InputEvent& event : EngineUtilities::TService<InputSystem>::instance().events()) {
+		if (event.type == InputEventType::Text) {
+			m_console.type(event.code);
+		}
+	}
+	if (!m_window->setConsoleText(m_console.text())) {
+		m_console.setOpen(false);
+	}
+}
+
+void
+BaseApp::showStats(bool visible) {
+	// El profiler solo mide mientras alguien mira, hay una traza en curso o se esperan tirones
+	bool enabled = m_window->setStatsOverlay(visible) && m_window->isStatsOverlay();
+	Profiler::instance().setEnabled(enabled || m_profileTrace.isActive() || m_hitches.isEnabled());
+}
+
+std::string
+BaseApp::scenePath() const {
+	if (m_cookedOnly) {
+		return kScenePath;
+	}
+	std::error_code error;
+	bool cooked = std::filesystem::exists(kScenePath, error);
+	bool source = std::filesystem::exists(kSceneSourcePath, error);
+	if (cooked && source) {
+		// Con los dos, el ltimo que se toc: el texto recin editado o lo guardado con F5
+		std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(kScenePath, error);
+		std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(kSceneSourcePath, error);
+		return error || cookedTime >= sourceTime ? kScenePath : kSceneSourcePath;
+	}
+	return cooked || (!source && PackLibrary::lookup(kScenePath).found) ? kScenePath : source ? kSceneSourcePath : std::string();
+}
+
+void
+BaseApp::endProfileFrame() {
+	// Aparte del profiler: se enciende solo con `prof_entities`
+	if (m_entityCosts.endFrame() && m_window && m_window->isStatsOverlay()) {
+		m_entityCosts.report(m_entityCostReport);
+		m_window->setEntityCosts(m_entityCostReport);
+	}
+	Profiler& profiler = Profiler::instance();
+	if (!profiler.isEnabled()) {
+		return;
+	}
+	// Antes de `endFrame`, para que los contadores caigan en este frame de la traza
+	EngineUtilities::TService<JobSystem>::instance().collectTelemetry(m_jobTelemetry);
+	JobWorkerStats jobs = m_jobTelemetry.total();
+	PROFILE_COUNTER("JobsExecuted", jobs.jobs);
+	PROFILE_COUNTER("JobUtilization", m_jobTelemetry.utilization() * 100.0);
+	PROFILE_COUNTER("JobSteals", jobs.steals);
+	PROFILE_COUNTER("JobStealAttempts", jobs.stealAttempts);
+	PROFILE_COUNTER("JobWaitMs", jobs.waitMs);
+	PROFILE_COUNTER("JobsQueued", jobs.queued);
+	profiler.endFrame();
+	bool overlay = m_window && m_window->isStatsOverlay();
+	if (overlay) {
+		m_window->setProfileFrame(profiler.lastFrame());
+		m_window->setJobTelemetry(m_jobTelemetry);
+	}
+	if (m_profileTrace.isActive() && m_profileTrace.addFrame(profiler)) {
+		if (m_profileTrace.write(profiler)) {
+			std::cout << "traza del profiler en " << m_profileTrace.path() << "\n";
+		}
+		else {
+			MESSAGE("BaseApp", "endProfileFrame", "could not write the profiler trace");
+		}
+		profiler.setEnabled(overlay || m_hitches.isEnabled());
+	}
+	if (!m_idleWaited && m_hitches.addFrame(profiler)) {
+		std::cout << "tirn de " << profiler.lastFrame().frameMs << " ms: traza en " << m_hitches.lastPath() << "\n";
+	}
+}
+
+void
+BaseApp::addScalingSystems(ScalingReport& report) const {
+	std::array<double, kScalingSystems> ms{};
+	for (const ProfileZone& zone : Profiler::instance().lastZones()) {
+		for (size_t i = 0; i < kScalingSystems; ++i) {
+			if (std::strcmp(zone.name, ScalingReport::systemZone(i)) == 0) {
+				ms[i] += (zone.end - zone.start) / 1.0e6;
+			}
+		}
+	}
+	report.addSystems(ms);
+}
+
+void
+BaseApp::checkMemoryBudgets() {
+	if constexpr (!EngineUtilities::kMemoryAccounting) {
+		return;
+	}
+	for (const EngineUtilities::MemoryUsage& usage : EngineUtilities::MemoryAccounting::snapshot()) {
+		uint32_t bit = 1u << static_cast<uint32_t>(usage.category);
+		if (usage.overBudget() && !(m_overBudget & bit)) {
+			m_overBudget |= bit;
+			LOG_WARNING("BaseApp", "checkMemoryBudgets", "memory budget exceeded",
+				{ "category", EngineUtilities::MemoryAccounting::name(usage.category) }, { "peak", usage.peakBytes },
+				{ "budget", usage.budgetBytes });
+		}
+	}
+}
+
+void
+BaseApp::setRenderCapture(const std::string& path, uint32_t frames) {
+	m_renderCapture.clear();
+	m_renderCapturePath = path;
+	m_renderCaptureFrames = frames;
+}
+
+void
+BaseApp::captureRenderFrame(const RenderCommandBuffer& commands, const sf::View& view) {
+	if (m_renderCaptureFrames == 0) {
+		return;
+	}
+	if (m_renderThread.isRunning()) {
+		// Leer las texturas pide el contexto, que es del hilo de render
+		MESSAGE("BaseApp", "captureRenderFrame", "render capture needs the render thread off");
+		m_renderCaptureFrames = 0;
+		m_renderCapture.clear();
+		return;
+	}
+	m_renderCapture.record(commands, view);
+	if (--m_renderCaptureFrames != 0) {
+		return;
+	}
+	if (m_renderCapture.write(m_renderCapturePath)) {
+		std::cout << "captura de render: " << m_renderCapture.frameCount() << " frames en " << m_renderCapturePath
+		          << ", " << m_renderCapture.skippedCommands() << " comandos sin guardar\n";
+	}
+	else {
+		MESSAGE("BaseApp", "captureRenderFrame", "could not write the render capture");
+	}
+	m_renderCapture.clear();
+}
+
+void
+BaseApp::checkHeapAllocations(uint32_t frames) {
+	if constexpr (!EngineUtilities::kHeapHooks) {
+		return;
+	}
+	if (frames < kHeapWarmupFrames) {
+		return;
+	}
+	EngineUtilities::HeapTracker::setSteady(true);
+	EngineUtilities::HeapFrame heap = EngineUtilities::HeapTracker::lastFrame();
+	if (heap.allocations == 0 || (m_heapWarnedFrame != 0 && frames - m_heapWarnedFrame < kHeapWarningFrames)) {
+		return;
+	}
+	m_heapWarnedFrame = frames;
+	LOG_WARNING("BaseApp", "checkHeapAllocations", "the steady-state frame allocated on the heap",
+		{ "allocations", heap.allocations }, { "bytes", heap.bytes },
+		{ "thread", EngineUtilities::HeapTracker::lastThread(heap.worstThread).name });
+}
+
+void
+BaseApp::recordFrameTimes(double frameMs, double updateMs, double renderMs) {
+	if (!m_frameTimes.addFrame(frameMs, updateMs, renderMs)) {
+		return;
+	}
+	const FrameTimeReport& report = m_frameTimes.lastReport();
+	if (m_frameTimeLog) {
+		char line[256];
+		std::snprintf(line, sizeof(line),
+		              "%u frames en %.1f s: frame p50 %.2f / p95 %.2f / p99 %.2f / max %.2f ms, %u tirones; "
+		              "update p99 %.2f ms, render p99 %.2f ms\n",
+		              report.frames, report.seconds, report.frame.p50Ms, report.frame.p95Ms, report.frame.p99Ms,
+		              report.frame.maxMs, report.hitches, report.update.p99Ms, report.render.p99Ms);
+		std::cout << line;
+		if (m_frameCap > 0.0f) {
+			PacingStats pacing = m_framePacer.takeStats();
+			std::snprintf(line, sizeof(line), "ritmo a %.2f Hz: %u esperas, tarde %.1f us de media / %.1f us max, giro %.0f us\n",
+			              FramePacer::alignToRefresh(m_frameCap, m_refreshHz), pacing.frames, pacing.meanLateUs,
+			              pacing.maxLateUs, pacing.spinUs);
+			std::cout << line;
+		}
+	}
+	if (m_window) {
+		m_window->setFrameTimeReport(report);
+	}
+}
+
+void
+BaseApp::setProfileTrace(const std::string& path, uint32_t frames) {
+	m_profileTrace.start(path, frames);
+	if (frames > 0) {
+		Profiler::instance().setEnabled(true);
+	}
+}
+
+bool
+BaseApp::isIdle() {
+	if (!m_idleMode || m_headless || !m_window) {
 		return false;
 	}
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	// Lo escrito desde el frame anterior es ms nuevo que su tick
+	if (isNewerTick(lastChangeTick(), m_idleTick)) {
+		m_lastActivity = now;
+	}
+	m_idleTick = advanceChangeTick();
+	if (!m_window->hasFocus()) {
+		return true;
+	}
+	std::chrono::steady_clock::time_point active = std::max(m_lastActivity, m_window->lastInputTime());
+	return now - active >= std::chrono::duration<float>(m_idleAfter);
+}
 
-	// Triangle Actor
-	Circle = EngineUtilities::MakeShared<Actor>("Circle");
-	if (!Circle.isNull()) {
-		Circle->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
-		Circle->getComponent<ShapeFactory>()->setPosition(200.0f, 200.0f);
-		Circle->getComponent<ShapeFactory>()->setFillColor(sf::Color::Blue);
+bool
+BaseApp::paceFrame(std::chrono::steady_clock::time_point& nextFrame) {
+	using Clock = std::chrono::steady_clock;
+	bool idle = isIdle();
+	m_idleWaited = idle;
+	if (idle && m_idleHz == 0.0f) {
+		m_window->waitForEvent(Clock::duration(-1));
+		nextFrame = Clock::now();
+		return true;
+	}
+	double hz = idle ? m_idleHz : FramePacer::alignToRefresh(m_frameCap, m_refreshHz);
+	// Sin presentar, el vsync ya no marca el ritmo: se espera como si lo hubiera hecho
+	if (hz <= 0.0 && m_skippedPresent && m_window->isVerticalSync()) {
+		hz = m_refreshHz > 0.0 ? m_refreshHz : kDefaultSimulationHz;
 	}
+	Clock::time_point now = Clock::now();
+	if (hz <= 0.0) {
+		nextFrame = now;
+		return false;
+	}
+	const Clock::duration interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+	nextFrame += interval;
+	// Atrasado por ms de un frame, sigue desde ahora en vez de apurar los siguientes
+	if (nextFrame + interval < now) {
+		nextFrame = now;
+	}
+	if (idle) {
+		if (m_window->waitForEvent(std::max(Clock::duration::zero(), nextFrame - now))) {
+			nextFrame = Clock::now();
+		}
+	}
+	else {
+		m_framePacer.waitUntil(nextFrame);
+	}
+	return false;
+}
 
-	// Triangle Actor
-	Triangle = EngineUtilities::MakeShared<Actor>("Triangle");
-	if (!Triangle.isNull()) {
-		Triangle->getComponent<ShapeFactory>()->createShape(ShapeType::TRIANGLE);
+void
+BaseApp::setHitchTrace(double thresholdMs, double seconds) {
+	m_hitches.setThreshold(thresholdMs, seconds);
+	bool overlay = m_window && m_window->isStatsOverlay();
+	Profiler::instance().setEnabled(overlay || m_profileTrace.isActive() || m_hitches.isEnabled());
+}
+
+void
+BaseApp::finishStartup() {
+	m_startup.mark(m_server ? "FirstStep" : "FirstFrame");
+	std::cout << (m_server ? "primer paso" : "primer frame") << " a los " << m_startup.elapsedMs() << " ms\n";
+	if (m_startupTracePath.empty()) {
+		return;
+	}
+	m_startup.print(std::cout);
+	if (!m_startup.writeTrace(m_startupTracePath)) {
+		MESSAGE("BaseApp", "finishStartup", "could not write the startup trace");
+	}
+}
+
+bool
+BaseApp::loadScene(const std::string& path) {
+	// El texto se arma en memoria como un `.gscn` y se lee igual que uno cocido
+	SceneFile scene;
+	std::vector<unsigned char> built;
+	std::span<const unsigned char> bytes;
+	PackedAsset packed = SceneText::hasTextExtension(path) ? PackedAsset() : PackLibrary::lookup(path);
+	if (packed.found) {
+		// El paquete queda montado y alinea cada archivo: sin comprimir, se lee en su lugar
+		bytes = packed.bytes(built);
+		if (bytes.empty() || !scene.openMemory(bytes.data(), bytes.size())) {
+			return false;
+		}
+	}
+	else if (SceneText::hasTextExtension(path)) {
+		if (m_cookedOnly) {
+			MESSAGE("BaseApp", "loadScene", "only cooked scenes are loaded, the text scene is ignored");
+			return false;
+		}
+		SceneWriter writer;
+		std::string error;
+		if (!SceneText::parseFile(path, writer, &error)) {
+			std::cerr << path << ": " << error << "\n";
+			return false;
+		}
+		built = writer.build();
+		if (!scene.openMemory(built.data(), built.size())) {
+			return false;
+		}
+	}
+	else if (!scene.open(path)) {
+		return false;
+	}
+
+	for (EngineUtilities::TSharedPointer<Actor>& actor : m_sceneActors) {
+		actor->destroy();
+	}
+	m_sceneActors.clear();
+	WorldStreamer::instance().close();
+	Circle.reset();
+	Triangle.reset();
+	// Lo que solo usaba la escena anterior deja de estar cargado
+	if (AssetManager* assets = EngineUtilities::TService<AssetManager>::get()) {
+		assets->evictUnused();
+	}
+
+	// Los registros se leen en su lugar desde el mapeo; el archivo se cierra al salir.
+	// Los actores de una regin los crea `WorldStreamer`, que se queda con la escena
+	std::span<const SceneActorRecord> records = scene.actors();
+	std::span<const SceneRegionRecord> regions = scene.regions();
+	std::vector<uint32_t> placed(records.size(), ~0u);   // ndice en `m_sceneActors` de cada registro
+	size_t streamed = 0;
+	for (const SceneRegionRecord& region : regions) {
+		streamed += region.actorCount;
+	}
+	m_actors.reserve(records.size() - streamed);
+	m_sceneActors.reserve(records.size() - streamed);
+	for (uint32_t i = 0, region = 0; i < records.size(); ++i) {
+		while (region < regions.size() && i >= regions[region].firstActor + regions[region].actorCount) {
+			++region;
+		}
+		if (region < regions.size() && i >= regions[region].firstActor) {
+			continue;
+		}
+		EngineUtilities::TSharedPointer<Actor> actor = WorldStreamer::spawnActor(m_actors, scene, records[i]);
+
+		// Escenas sin mscaras guardadas: las etiquetas salen del nombre, solo esta vez
+		if (actor->getName() == "Circle") {
+			actor->setTags(kTagWaypointFollower);
+		}
+		else if (actor->getName() == "Triangle") {
+			actor->setTags(kTagScenery);
+		}
+		placed[i] = static_cast<uint32_t>(m_sceneActors.size());
+		m_sceneActors.push_back(std::move(actor));
 	}
 
+	SceneComponents<SceneActorMasks> masks = scene.components<SceneActorMasks>("EntityMasks");
+	for (size_t i = 0; i < masks.owners.size(); ++i) {
+		if (uint32_t at = placed[masks.owners[i]]; at != ~0u) {
+			m_sceneActors[at]->setTags(masks.values[i].tags);
+			m_sceneActors[at]->setLayers(masks.values[i].layers);
+		}
+	}
+
+	for (const EngineUtilities::TSharedPointer<Actor>& actor : m_sceneActors) {
+		if (!Circle && actor->hasTags(kTagWaypointFollower)) {
+			Circle = actor;
+		}
+		else if (!Triangle && actor->hasTags(kTagScenery)) {
+			Triangle = actor;
+		}
+	}
+
+	// ScenePoint y sf::Vector2f son dos floats: una sola copia
+	static_assert(sizeof(ScenePoint) == sizeof(sf::Vector2f));
+	std::span<const ScenePoint> points = scene.waypoints();
+	if (!points.empty()) {
+		EngineUtilities::TService<PathLibrary>::instance().setPoints(m_waypointPath,
+			std::span<const sf::Vector2f>(reinterpret_cast<const sf::Vector2f*>(points.data()), points.size()));
+	}
+
+	// Las regiones se leen de la misma escena, que queda abierta: un paquete sin comprimir sigue
+	// montado, lo armado en memoria pasa a `WorldStreamer` y un archivo suelto se vuelve a mapear
+	if (!regions.empty()) {
+		WorldStreamer& world = WorldStreamer::instance();
+		bool opened = !built.empty() ? world.openMemory(std::move(built))
+		            : packed.found   ? world.openMemory(bytes.data(), bytes.size())
+		                             : world.open(path);
+		if (!opened) {
+			MESSAGE("BaseApp", "loadScene", "the scene regions could not be opened, they stay unloaded");
+		}
+		// En lockstep cundo aparece un actor no puede depender de la vista: se cargan todas
+		else if (m_lockstep) {
+			world.loadAll(m_actors);
+		}
+	}
+	return true;
+}
+
+bool
+BaseApp::saveScene(const std::string& path) const {
+	SceneWriter writer;
+	std::vector<uint32_t> owners;
+	std::vector<SceneActorMasks> masks;
+	for (const EngineUtilities::TSharedPointer<Actor>& actor : m_sceneActors) {
+		SceneActorRecord record;
+		if (const Transform* transform = actor->findComponent<Transform>()) {
+			record.positionX = transform->getPosition().x;
+			record.positionY = transform->getPosition().y;
+			record.rotation = transform->getRotation();
+			record.scaleX = transform->getScale().x;
+			record.scaleY = transform->getScale().y;
+		}
+		if (const ShapeFactory* shape = actor->findComponent<ShapeFactory>()) {
+			record.shapeType = static_cast<uint32_t>(shape->getShapeType());
+			if (shape->getShape()) {
+				record.fillColor = shape->getFillColor().toInteger();
+			}
+		}
+		record.flags = actor->isActive() ? kSceneActorActive : 0;
+		owners.push_back(writer.addActor(actor->getName(), record));
+		masks.push_back({ actor->getTags(), actor->getLayers() });
+	}
+	// Las regiones, como estaban en la escena cargada: sus actores van y vienen
+	if (const WorldStreamer* world = EngineUtilities::TService<WorldStreamer>::get(); world && world->isOpen()) {
+		world->save(writer, owners, masks);
+	}
+	writer.addComponents<SceneActorMasks>("EntityMasks", owners, masks);
+	if (const Path* route = EngineUtilities::TService<PathLibrary>::instance().find(m_waypointPath)) {
+		std::vector<ScenePoint> points(route->points.size());
+		std::memcpy(static_cast<void*>(points.data()), route->points.data(), points.size() * sizeof(ScenePoint));
+		writer.setWaypoints(points);
+	}
+	return writer.write(path);
+}
+
+bool
+BaseApp::sampleInput() {
+	if (m_inputLog.isReplaying()) {
+		if (!m_inputLog.next(m_input)) {
+			return false;
+		}
+		// Lo que se escribi en la consola antes de este paso, en el mismo lugar
+		for (const TickEvent& event : m_inputLog.events()) {
+			if (event.type == TickEventType::ConsoleLine) {
+				m_console.execute(event.text());
+			}
+		}
+		++m_tick;
+		return true;
+	}
+	// La de los eventos del frame: no le pregunta al sistema operativo
+	sf::Vector2i mousePosition = EngineUtilities::TService<InputSystem>::instance().mousePosition();
+	m_input.mouseX = static_cast<float>(mousePosition.x);
+	m_input.mouseY = static_cast<float>(mousePosition.y);
+	if (m_lockstep) {
+		if (m_inputLog.isRecording() && !m_inputLog.record(m_input)) {
+			MESSAGE("BaseApp", "sampleInput", "could not append to the input log, recording stopped");
+			m_inputLog.close();
+		}
+		++m_tick;
+	}
 	return true;
 }
 
 void
 BaseApp::update() {
-	// Mouse Position
-	sf::Vector2i mousePosition = sf::Mouse::getPosition(*m_window->getWindow());
-	sf::Vector2f mousePosF(static_cast<float>(mousePosition.x),
-		static_cast<float>(mousePosition.y));
+	PROFILE_SCOPE("Update");
+	// Mouse Position, de la entrada del paso
+	sf::Vector2f mousePosF(m_input.mouseX, m_input.mouseY);
+	// Lo que est bajo el mouse sale de las celdas, no de revisar cada figura
+	m_hovered = EngineUtilities::TService<Picking>::instance().pickActor(mousePosF);
+
+	// La IA lejana va ms lento; en lockstep no, porque la vista no es parte de la simulacin
+	m_aiLod.advance();
+	if (!m_lockstep && m_lod && m_visibleArea.width > 0.0f) {
+		m_aiLod.setVisibleArea(m_visibleArea);
+	}
+	else if (!m_lod) {
+		m_aiLod.clearVisibleArea();
+	}
+
+	if (Pathfinder* pathfinder = EngineUtilities::TService<Pathfinder>::get()) {
+		PROFILE_SCOPE("Pathfinding");
+		// En lockstep lo pedido en el paso anterior llega completo en este, aunque haya que esperar
+		if (m_lockstep) {
+			pathfinder->finishAll();
+		}
+		// Caminos que terminaron de buscarse y los pedidos del frame anterior; nunca espera
+		else {
+			pathfinder->collect();
+			pathfinder->dispatch();
+		}
+	}
+
+	// El campo de la multitud sigue al mouse; se arma por partes en varios frames
+	if (m_crowdSize > 0) {
+		m_crowdField.setTarget(mousePosF);
+		m_crowdField.update(EngineUtilities::TService<NavGrid>::instance(), EngineUtilities::TService<JobSystem>::instance());
+	}
 
-	if (!Circle.isNull()) {
-		/*Circle->getComponent<ShapeFactory>()->Seek(mousePosF,
-																							 200.0f,
-																							 deltaTime.asSeconds(),
-																							 10.0f);*/
-		updateMovement(deltaTime.asSeconds(), Circle);
+	/*Circle->getComponent<ShapeFactory>()->Seek(mousePosF,
+																						 200.0f,
+																						 deltaTime.asSeconds(),
+																						 10.0f);*/
+
+	m_systems.run(Entity::world(), deltaTime.asSeconds());
+
+	// Punto de sincronizacin: los cambios estructurales que anotaron los sistemas, juntos
+	{
+		PROFILE_SCOPE("CommandPlayback");
+		EngineUtilities::TService<EntityCommandBuffer>::instance().playback(Entity::world());
 	}
 
+	// El servidor manda lo que se simul; en el cliente lo recibido pisa lo simulado
+	if (m_net.isOpen()) {
+		PROFILE_SCOPE("Net");
+		// El cliente pide lo que ve; al servidor no le cambia nada
+		if (!m_net.isHost() && m_visibleArea.width > 0.0f) {
+			m_net.setInterestArea(m_visibleArea);
+		}
+		m_net.update(m_sceneActors, deltaTime.asSeconds());
+		if (m_window && m_window->isStatsOverlay()) {
+			m_net.stats(m_netStats);
+			m_window->setNetStats(m_netStats);
+		}
+	}
+
+	// Solo copia lo que cambi; el archivo lo escribe el hilo del diario
+	if (m_journal.isOpen() && ++m_stepsSinceCheckpoint >= kCheckpointSteps && m_journal.checkpoint(Entity::world())) {
+		m_stepsSinceCheckpoint = 0;
+	}
+
+	// Archivos que cambiaron en disco; sus `AssetReloaded` se entregan enseguida
+	if (AssetManager* assets = EngineUtilities::TService<AssetManager>::get()) {
+		assets->update();
+	}
+
+	// Punto de entrega del frame: entrada de la ventana y eventos de los sistemas
+	EngineUtilities::TService<EventBus>::instance().dispatch();
+
+	// Temporizadores que vencen en este paso, despus de los eventos que pudieron programarlos
+	EngineUtilities::TService<TimerWheel>::instance().advance();
+
+	// Solo las entidades activas; los actores dormidos no cuestan nada
+	{
+		PROFILE_SCOPE("Components");
+		PROFILE_COUNTER("ActiveEntities", EngineUtilities::TService<ActiveEntities>::instance().entities().size());
+		m_componentUpdater.update(EngineUtilities::TService<ActiveEntities>::instance().entities(), deltaTime.asSeconds(),
+			m_entityCosts.isSampling() ? &m_entityCosts : nullptr);
+	}
+
+	// Despus de los emisores: las partculas de este paso ya avanzan
+	if (ParticleSystem* particles = EngineUtilities::TService<ParticleSystem>::get()) {
+		particles->update(deltaTime.asSeconds());
+	}
+
+	// Regiones alrededor de la vista; sus recursos entran en la cola de este mismo paso.
+	// En lockstep se cargaron todas con la escena
+	if (WorldStreamer* world = EngineUtilities::TService<WorldStreamer>::get(); world && world->isOpen() && !m_lockstep) {
+		PROFILE_SCOPE("WorldStreaming");
+		if (m_visibleArea.width > 0.0f) {
+			world->setFoci(std::span<const sf::FloatRect>(&m_visibleArea, 1));
+		}
+		world->update(m_actors);
+	}
+
+	// Las cargas que tocan segn la vista de este paso; antes que los cargadores entreguen lo suyo
+	if (AssetStreamer* streamer = EngineUtilities::TService<AssetStreamer>::get()) {
+		if (m_visibleArea.width > 0.0f) {
+			streamer->setVisibleArea(m_visibleArea);
+		}
+		streamer->update();
+	}
+
+	// Los sonidos decodificados en el frame pasan a sus bferes antes de que se repartan las voces
+	if (SoundCache* sounds = EngineUtilities::TService<SoundCache>::get()) {
+		sounds->update();
+	}
+	if (AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get()) {
+		PROFILE_SCOPE("Audio");
+		if (m_visibleArea.width > 0.0f) {
+			audio->setListener(sf::Vector2f(m_visibleArea.left + 0.5f * m_visibleArea.width, m_visibleArea.top + 0.5f * m_visibleArea.height));
+		}
+		audio->update(deltaTime.asSeconds(), &EngineUtilities::TService<JobSystem>::instance());
+	}
+	if (SoftwareMixer* mixer = EngineUtilities::TService<SoftwareMixer>::get()) {
+		mixer->update();
+	}
+	// Junto a las de dibujo en el overlay; sin audio no hay nada que mostrar
+	if (AudioSystem* audio = EngineUtilities::TService<AudioSystem>::get(); audio && m_window) {
+		AudioStats stats = AudioStatsCounter::instance().endFrame();
+		stats.voices = audio->activeVoices();
+		stats.virtuals = audio->virtualCount();
+		m_window->setAudioStats(stats);
+	}
 }
 
 void
 BaseApp::render() {
+	PROFILE_SCOPE("Render");
+	m_skippedPresent = m_redrawOnChange && !needsRedraw();
+	if (m_skippedPresent) {
+		++m_skippedPresents;
+		return;
+	}
+	// Con hilo de render: se graba la foto del frame y se entrega; l la dibuja
+	if (m_renderThread.isRunning()) {
+		RenderThread::Frame& frame = m_renderThread.acquireFrame();
+		// El hilo de render ya no lee las mallas del frame anterior
+		if (MeshLoader* loader = EngineUtilities::TService<MeshLoader>::get()) {
+			loader->adoptFinished();
+		}
+		std::span<const sf::View> views = frameViews();
+		frame.views.assign(views.begin(), views.end());
+		recordVisible(frame.commands, views);
+		captureRenderFrame(frame.commands, views.front());
+		m_renderThread.submitFrame();
+		return;
+	}
+
+	if (MeshLoader* loader = EngineUtilities::TService<MeshLoader>::get()) {
+		loader->adoptFinished();
+	}
+	std::span<const sf::View> views = frameViews();
+	m_renderCommands.clear();
+	recordVisible(m_renderCommands, views);
+	captureRenderFrame(m_renderCommands, views.front());
 	m_window->clear();
-	Circle->render(*m_window);
-	Triangle->render(*m_window);
+	m_window->submit(m_renderCommands, views);
 	m_window->display();
 }
 
-void
-BaseApp::cleanup() {
-	m_window->destroy();
-	delete m_window;
+std::span<const sf::View>
+BaseApp::frameViews() {
+	if (!m_views.empty()) {
+		return m_views;
+	}
+	const sf::View& view = m_renderThread.isRunning() ? m_renderView : m_window->getTarget().getView();
+	return std::span<const sf::View>(&view, 1);
+}
+
+bool
+BaseApp::needsRedraw() {
+	const sf::View& view = m_renderThread.isRunning() ? m_renderView : m_window->getTarget().getView();
+	// Lo escrito desde el `needsRedraw` anterior es ms nuevo que su tick
+	bool changed = isNewerTick(lastChangeTick(), m_redrawTick);
+	m_redrawTick = advanceChangeTick();
+	if (changed) {
+		m_redrawUntilStep = Transform::getSimulationStep() + 1;
+	}
+	auto sameView = [](const sf::View& a, const sf::View& b) {
+		return a.getCenter() == b.getCenter() && a.getSize() == b.getSize() && a.getRotation() == b.getRotation() &&
+		       a.getViewport() == b.getViewport();
+	};
+	MeshLoader* meshes = EngineUtilities::TService<MeshLoader>::get();
+	TextureLoader* textures = EngineUtilities::TService<TextureLoader>::get();
+	ParticleSystem* particles = EngineUtilities::TService<ParticleSystem>::get();
+	bool redraw = changed || !m_hasPresented || m_redrawRequested ||
+	              (m_simulationStep > 0.0f && !isNewerTick(Transform::getSimulationStep(), m_redrawUntilStep)) ||
+	              m_window->lastInputTime() != m_presentedInput || !sameView(view, m_presentedView) ||
+	              m_window->isStatsOverlay() || m_console.isOpen() || m_window->frameCapture().isActive() ||
+	              m_renderCaptureFrames > 0 || (meshes && meshes->pendingCount() > 0) ||
+	              (textures && textures->pendingCount() > 0) || (particles && particles->size() > 0);
+	if (redraw) {
+		m_hasPresented = true;
+		m_redrawRequested = false;
+		m_presentedView = view;
+		m_presentedInput = m_window->lastInputTime();
+	}
+	return redraw;
 }
 
 void
-BaseApp::updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Actor> circle) {
-	// Verificar si el Circle es nulo
-	if (!circle || circle.isNull()) return;
+BaseApp::recordVisible(RenderCommandBuffer& commands, std::span<const sf::View> views) {
+	PROFILE_SCOPE("RecordVisible");
+	// Con cuntos pxeles se ve cada unidad, para el nivel de detalle de las figuras; con varias
+	// vistas, la que ms pide. Con resolucin dinmica la escena tiene menos pxeles que la ventana
+	float targetHeight = static_cast<float>(m_window->presentTarget().getSize().y) * m_window->resolutionScale();
+	float pixelScale = 0.0f;
+	m_viewAreas.clear();
+	for (const sf::View& view : views) {
+		pixelScale = std::max(pixelScale, targetHeight * view.getViewport().height / std::abs(view.getSize().y));
+		m_viewAreas.push_back(view.getInverseTransform().transformRect(sf::FloatRect(-1.0f, -1.0f, 2.0f, 2.0f)));
+	}
+	commands.setPixelScale(pixelScale);
+
+	// Las partculas y las figuras del `World` descartan contra la caja de todas las vistas
+	sf::FloatRect visibleArea = m_viewAreas.front();
+	for (const sf::FloatRect& area : m_viewAreas) {
+		float right = std::max(visibleArea.left + visibleArea.width, area.left + area.width);
+		float bottom = std::max(visibleArea.top + visibleArea.height, area.top + area.height);
+		visibleArea.left = std::min(visibleArea.left, area.left);
+		visibleArea.top = std::min(visibleArea.top, area.top);
+		visibleArea.width = right - visibleArea.left;
+		visibleArea.height = bottom - visibleArea.top;
+	}
+	commands.setVisibleArea(visibleArea);
+	m_visibleArea = visibleArea;
+	if (ParticleSystem* particles = EngineUtilities::TService<ParticleSystem>::get()) {
+		particles->render(commands, visibleArea);
+	}
+
+	// Cada entidad visible agrega sus comandos; la ventana los ordena y dibuja juntos
+	if (SpatialGrid* grid = m_culling ? EngineUtilities::TService<SpatialGrid>::get() : nullptr) {
+		m_visibleEntities.clear();
+		grid->query(m_viewAreas, m_visibleEntities);
+		recordEntities(commands, m_visibleEntities);
+	}
+	else {
+		recordEntities(commands, EngineUtilities::TService<ActiveEntities>::instance().entities());
+	}
+	// Las figuras que son solo datos del `World`, un bucle por tipo
+	recordShapeInstances(Entity::world(), commands);
+	// Ordenado aqu, en paralelo: `Window::submit` (o el hilo de render) ya lo recibe listo
+	commands.sort(&EngineUtilities::TService<JobSystem>::instance());
+}
 
-	// Posicin actual del destino (punto de recorrido)
-	sf::Vector2f targetPos = waypoints[currentWaypoint];
+void
+BaseApp::recordEntities(RenderCommandBuffer& commands, std::span<Entity* const> entities) {
+	PROFILE_SCOPE("RecordEntities");
+	JobSystem& jobs = EngineUtilities::TService<JobSystem>::instance();
+	LayerCache* layers = EngineUtilities::TService<LayerCache>::get();
+	size_t chunks = (entities.size() + kRecordGrain - 1) / kRecordGrain;
+	if (m_entityCosts.isSampling()) {
+		// Frame medido: de a una y en este hilo, para cargarle a cada entidad su `render`
+		for (Entity* entity : entities) {
+			int64_t start = Profiler::now();
+			entity->render(commands);
+			m_entityCosts.addRender(*entity, Profiler::now() - start);
+		}
+		return;
+	}
+	if (!m_parallelRecord || chunks <= 1 || jobs.activeWorkers() == 0 || (layers && layers->cachedCount() != 0)) {
+		for (Entity* entity : entities) {
+			entity->render(commands);
+		}
+		return;
+	}
 
-	// Llamar al Seek hacia el punto de recorrido actual
-	circle->getComponent<ShapeFactory>()->Seek(targetPos, 200.0f, deltaTime, 10.0f);
+	// Trozos fijos y juntados en orden: el buffer queda igual que grabado de a una
+	if (m_recordBuffers.size() < chunks) {
+		m_recordBuffers.resize(chunks);
+	}
+	jobs.parallelFor(chunks, 1, [this, &commands, entities](size_t first, size_t last) {
+		for (size_t chunk = first; chunk < last; ++chunk) {
+			RenderCommandBuffer& buffer = m_recordBuffers[chunk];
+			buffer.clear();
+			buffer.setPixelScale(commands.pixelScale());
+			buffer.setVisibleArea(commands.visibleArea());
+			size_t end = std::min(entities.size(), (chunk + 1) * kRecordGrain);
+			for (size_t i = chunk * kRecordGrain; i < end; ++i) {
+				entities[i]->render(buffer);
+			}
+		}
+	});
+	for (size_t chunk = 0; chunk < chunks; ++chunk) {
+		commands.append(m_recordBuffers[chunk]);
+	}
+}
 
-	// Obtener la posicin actual del actor
-	sf::Vector2f currentPos = circle->getComponent<ShapeFactory>()->getShape()->getPosition();
+void
+BaseApp::cleanup() {
+	m_net.close();
 
-	// Comprobar si el actor ha alcanzado el destino (o est cerca)
-	float distanceToTarget = std::sqrt(std::pow(targetPos.x - currentPos.x, 2) + std::pow(targetPos.y - currentPos.y, 2));
+	// Lo ltimo que cambi, antes de destruir los actores
+	if (m_journal.isOpen()) {
+		m_journal.wait();
+		m_journal.checkpoint(Entity::world());
+		m_journal.close();
+	}
 
-	if (distanceToTarget < 10.0f) { // Umbral para considerar que ha llegado
-		// Pasar al siguiente waypoint
-		currentWaypoint = (currentWaypoint + 1) % waypoints.size(); // Ciclar a travs de los puntos
+	// Vuelven al pool antes de cerrar los servicios que usa al reciclarlos
+	for (EngineUtilities::TSharedPointer<Actor>& actor : m_sceneActors) {
+		actor->destroy();
 	}
+	m_sceneActors.clear();
+	if (WorldStreamer* world = EngineUtilities::TService<WorldStreamer>::get()) {
+		world->close();
+	}
+	Circle.reset();
+	Triangle.reset();
+
+	delete m_window;
+	m_window = nullptr;
+
+	EngineUtilities::DeferredReleaseQueue::flush();
+	EngineUtilities::ServiceLocator::shutdownAll();
+	EngineUtilities::DeferredReleaseQueue::flush();
+
+	// Solo escriben algo si el proyecto define ENGINE_TRACK_ALLOCATIONS=1 / ENGINE_TRACK_LIFETIMES=1 / ENGINE_HEAP_HOOKS=1
+	EngineUtilities::AllocationTracker::dump(std::cerr);
+	EngineUtilities::LifetimeTracker::reportLive(std::cerr);
+	EngineUtilities::MemoryAccounting::dump(std::cerr);
+	EngineUtilities::HeapTracker::dump(std::cerr);
+}
+
+void
+BaseApp::updateSpatialIndex(World& world, uint32_t since) {
+	SpatialGrid& grid = EngineUtilities::TService<SpatialGrid>::instance();
+	world.view<const Transform, const ShapeFactory, const SpatialItem>().eachChanged<Transform, ShapeFactory, SpatialItem>(since,
+		[&grid](EntityId, const Transform& transform, const ShapeFactory& shape, const SpatialItem& item) {
+			const sf::Shape* drawn = shape.getShape();
+			if (!drawn) {
+				grid.updateBounds(item, sf::FloatRect());
+				return;
+			}
+			grid.updateBounds(item, transform.getWorldTransform().transformRect(drawn->getLocalBounds()));
+		});
 }
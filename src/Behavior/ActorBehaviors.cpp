@@ -0,0 +1,71 @@
+#include "Behavior/ActorBehaviors.h"
+#include "Actor.h"
+#include "Steering.h"
+#include "Transform.h"
+#include "Events/EngineEvents.h"
+#include "Events/EventBus.h"
+#include "Memory/ServiceLocator.h"
+
+namespace {
+	/**
+	 * @brief Posicin del actor, o falso si ya no existe.
+	 */
+	bool
+	positionOf(EntityHandle handle, sf::Vector2f& position) {
+		Actor* actor = EngineUtilities::TService<EntityRegistry>::instance().find<Actor>(handle);
+		Transform* transform = actor ? actor->findComponent<Transform>() : nullptr;
+		if (!transform) {
+			return false;
+		}
+		position = transform->getPosition();
+		return true;
+	}
+}
+
+Behavior
+moveTo(EntityHandle actor, sf::Vector2f destination) {
+	Actor* mover = EngineUtilities::TService<EntityRegistry>::instance().find<Actor>(actor);
+	SteeringAgent* steering = mover ? mover->getComponent<SteeringAgent>() : nullptr;
+	if (!steering) {
+		co_return;
+	}
+	steering->target = destination;
+	float radius = steering->arriveRadius;
+
+	// El componente puede mudarse de arquetipo entre ticks: cada vez se busca de nuevo
+	co_await Behavior::until([actor, destination, radius]() {
+		sf::Vector2f position;
+		if (!positionOf(actor, position)) {
+			return true;
+		}
+		sf::Vector2f offset = destination - position;
+		return offset.x * offset.x + offset.y * offset.y <= radius * radius;
+	});
+}
+
+Behavior
+patrol(EntityHandle actor, PathHandle path) {
+	PathLibrary& paths = EngineUtilities::TService<PathLibrary>::instance();
+	for (uint32_t index = 0;; ++index) {
+		// El recorrido pudo cambiar o acortarse desde el ltimo punto
+		const Path* route = paths.find(path);
+		if (!route || route->points.empty()) {
+			co_return;
+		}
+		if (index >= route->points.size()) {
+			if (!route->loop) {
+				co_return;
+			}
+			index = 0;
+		}
+
+		co_await moveTo(actor, route->points[index]);
+
+		sf::Vector2f position;
+		if (!positionOf(actor, position)) {
+			co_return;
+		}
+		EngineUtilities::TService<EventBus>::instance().publish(
+			WaypointReached{ actor, static_cast<int>(index), position });
+	}
+}
@@ -0,0 +1,93 @@
+#include "Behavior/Behavior.h"
+#include <array>
+#include <bit>
+#include <new>
+#include <vector>
+#include "Memory/MemoryAccounting.h"
+
+namespace {
+	struct FreeFrame {
+		FreeFrame* next;
+	};
+
+	struct FramePool {
+		std::array<FreeFrame*, BehaviorFramePool::kClasses> free{};
+		std::vector<void*> chunks;
+		size_t live = 0;
+
+		~FramePool() {
+			// Con marcos an vivos (un comportamiento esttico sin terminar) no se suelta nada
+			if (live == 0) {
+				for (void* chunk : chunks) {
+					::operator delete(chunk);
+				}
+			}
+		}
+	};
+
+	FramePool&
+	pool() {
+		static FramePool s_pool;
+		return s_pool;
+	}
+
+	/**
+	 * @brief Clase de `size`: 0 para hasta 64 bytes, 1 hasta 128, etc.
+	 */
+	size_t
+	classOf(size_t size) {
+		size_t rounded = std::bit_ceil(size < BehaviorFramePool::kMinSize ? BehaviorFramePool::kMinSize : size);
+		return static_cast<size_t>(std::countr_zero(rounded) - std::countr_zero(BehaviorFramePool::kMinSize));
+	}
+}
+
+void*
+BehaviorFramePool::allocate(size_t size) {
+	if (size > kMaxSize) {
+		EngineUtilities::MemoryAccounting::onAllocate(EngineUtilities::MemoryCategory::Scripting, size);
+		return ::operator new(size);
+	}
+	FramePool& frames = pool();
+	size_t sizeClass = classOf(size);
+	if (!frames.free[sizeClass]) {
+		// Un trozo nuevo, partido entero en marcos de esta clase
+		size_t frameSize = kMinSize << sizeClass;
+		char* chunk = static_cast<char*>(::operator new(kChunkSize));
+		EngineUtilities::MemoryAccounting::onAllocate(EngineUtilities::MemoryCategory::Scripting, kChunkSize, chunk);
+		frames.chunks.push_back(chunk);
+		for (size_t offset = kChunkSize; offset >= frameSize; offset -= frameSize) {
+			FreeFrame* frame = reinterpret_cast<FreeFrame*>(chunk + offset - frameSize);
+			frame->next = frames.free[sizeClass];
+			frames.free[sizeClass] = frame;
+		}
+	}
+	FreeFrame* frame = frames.free[sizeClass];
+	frames.free[sizeClass] = frame->next;
+	++frames.live;
+	return frame;
+}
+
+void
+BehaviorFramePool::deallocate(void* frame, size_t size) {
+	if (size > kMaxSize) {
+		EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Scripting, size);
+		::operator delete(frame);
+		return;
+	}
+	FramePool& frames = pool();
+	size_t sizeClass = classOf(size);
+	FreeFrame* freed = static_cast<FreeFrame*>(frame);
+	freed->next = frames.free[sizeClass];
+	frames.free[sizeClass] = freed;
+	--frames.live;
+}
+
+size_t
+BehaviorFramePool::liveFrames() {
+	return pool().live;
+}
+
+size_t
+BehaviorFramePool::reservedBytes() {
+	return pool().chunks.size() * kChunkSize;
+}
@@ -0,0 +1,120 @@
+#include "Behavior/BehaviorScheduler.h"
+#include <algorithm>
+#include "Memory/ServiceLocator.h"
+
+BehaviorScheduler::~BehaviorScheduler() {
+	clear();
+}
+
+void
+BehaviorScheduler::start(Behavior&& behavior, EntityHandle owner) {
+	Behavior::Handle root = behavior.release();
+	if (!root) {
+		return;
+	}
+	root.resume();
+	dispatch(Task{ root, owner });
+}
+
+void
+BehaviorScheduler::stop(EntityHandle owner) {
+	for (Task& task : m_running) {
+		if (task.owner == owner) {
+			task.root.promise().ownWait.cancelled = true;
+		}
+	}
+	for (Task& task : m_polling) {
+		if (task.owner == owner) {
+			task.root.promise().ownWait.cancelled = true;
+		}
+	}
+	// Los dormidos no estn en ningn recorrido: se van ya, sin esperar a su hora
+	auto asleep = std::remove_if(m_sleeping.begin(), m_sleeping.end(), [owner](const Sleeper& sleeper) {
+		if (sleeper.task.owner != owner) {
+			return false;
+		}
+		sleeper.task.root.destroy();
+		return true;
+	});
+	if (asleep != m_sleeping.end()) {
+		m_sleeping.erase(asleep, m_sleeping.end());
+		std::make_heap(m_sleeping.begin(), m_sleeping.end(), wakesLater);
+	}
+}
+
+void
+BehaviorScheduler::tick(float deltaTime) {
+	m_time += deltaTime;
+
+	// Los que ya despiertan pasan a correr en este mismo tick
+	while (!m_sleeping.empty() && m_sleeping.front().wakeTime <= m_time) {
+		std::pop_heap(m_sleeping.begin(), m_sleeping.end(), wakesLater);
+		Task task = m_sleeping.back().task;
+		m_sleeping.pop_back();
+		task.root.promise().ownWait.kind = BehaviorWait::NextTick;
+		m_running.push_back(task);
+	}
+
+	// Lo que se agregue mientras tanto (`start`, o uno que vuelve a esperar) va a `m_running`
+	std::swap(m_running, m_polling);
+	for (Task& task : m_polling) {
+		BehaviorWait& wait = task.root.promise().ownWait;
+		if (wait.cancelled || orphaned(task)) {
+			task.root.destroy();
+			continue;
+		}
+		if (wait.kind == BehaviorWait::Until && !wait.ready(wait.context)) {
+			m_running.push_back(task);
+			continue;
+		}
+		wait.resume.resume();
+		dispatch(task);
+	}
+	m_polling.clear();
+}
+
+void
+BehaviorScheduler::clear() {
+	for (Task& task : m_running) {
+		task.root.destroy();
+	}
+	for (Task& task : m_polling) {
+		task.root.destroy();
+	}
+	for (Sleeper& sleeper : m_sleeping) {
+		sleeper.task.root.destroy();
+	}
+	m_running.clear();
+	m_polling.clear();
+	m_sleeping.clear();
+}
+
+void
+BehaviorScheduler::dispatch(Task task) {
+	BehaviorWait& wait = task.root.promise().ownWait;
+	if (wait.kind == BehaviorWait::Done || wait.cancelled) {
+		task.root.destroy();
+		return;
+	}
+	if (wait.kind == BehaviorWait::Sleep) {
+		m_sleeping.push_back(Sleeper{ m_time + wait.seconds, task });
+		std::push_heap(m_sleeping.begin(), m_sleeping.end(), wakesLater);
+		return;
+	}
+	m_running.push_back(task);
+}
+
+bool
+BehaviorScheduler::orphaned(const Task& task) const {
+	return !task.owner.isNull() && !EngineUtilities::TService<EntityRegistry>::instance().contains(task.owner);
+}
+
+bool
+BehaviorScheduler::wakesLater(const Sleeper& a, const Sleeper& b) {
+	return a.wakeTime > b.wakeTime;
+}
+
+BehaviorScheduler&
+BehaviorScheduler::instance() {
+	return EngineUtilities::TService<BehaviorScheduler>::instance();
+}
@@ -0,0 +1,193 @@
+#include "Camera.h"
+
+namespace {
+	/**
+	 * @brief y hacia abajo a y hacia arriba: el mundo de SFML queda de mano derecha para `lookAt`.
+	 */
+	sf::Vector3f
+	flipY(const sf::Vector3f& v) { return sf::Vector3f(v.x, -v.y, v.z); }
+
+	sf::Vector3f
+	cross(const sf::Vector3f& a, const sf::Vector3f& b) {
+		return sf::Vector3f(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+	}
+
+	sf::Vector3f
+	normalized(const sf::Vector3f& v) {
+		float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+		return length > 0.0f ? v / length : v;
+	}
+}
+
+void
+Camera::render(RenderCommandBuffer& commands) {
+	commands.setCamera(getUniforms());
+}
+
+void
+Camera::setPerspective(float fovYDegrees, float nearPlane, float farPlane) {
+	m_projectionType = Projection::Perspective;
+	m_fovY = fovYDegrees;
+	m_near = nearPlane;
+	m_far = farPlane;
+	m_projectionDirty = true;
+	markChanged();
+}
+
+void
+Camera::setOrthographic(float height, float nearPlane, float farPlane) {
+	m_projectionType = Projection::Orthographic;
+	m_height = height;
+	m_near = nearPlane;
+	m_far = farPlane;
+	m_projectionDirty = true;
+	markChanged();
+}
+
+void
+Camera::setAspect(float aspect) {
+	if (aspect == m_aspect) {
+		return;
+	}
+	m_aspect = aspect;
+	m_projectionDirty = true;
+	markChanged();
+}
+
+void
+Camera::setPosition(const sf::Vector3f& position) {
+	m_position = position;
+	m_viewDirty = true;
+	markChanged();
+}
+
+sf::Vector3f
+Camera::getPosition() const {
+	return m_position + followOffset();
+}
+
+void
+Camera::setTarget(const sf::Vector3f& target) {
+	m_target = target;
+	m_viewDirty = true;
+	markChanged();
+}
+
+void
+Camera::setUp(const sf::Vector3f& up) {
+	m_up = up;
+	m_viewDirty = true;
+	markChanged();
+}
+
+void
+Camera::focus(const sf::Vector2f& center, float visibleHeight) {
+	float distance = m_projectionType == Projection::Perspective
+		? visibleHeight * 0.5f / std::tan(m_fovY * 3.14159265f / 360.0f)
+		: m_near + (m_far - m_near) * 0.5f;
+	if (m_projectionType == Projection::Orthographic && m_height != visibleHeight) {
+		m_height = visibleHeight;
+		m_projectionDirty = true;
+	}
+	m_position = sf::Vector3f(center.x, center.y, distance);
+	m_target = sf::Vector3f(center.x, center.y, 0.0f);
+	m_up = sf::Vector3f(0.0f, -1.0f, 0.0f);
+	m_viewDirty = true;
+	markChanged();
+}
+
+void
+Camera::setTransform(const Transform* transform) {
+	m_transform = transform;
+	m_viewDirty = true;
+	markChanged();
+}
+
+void
+Camera::screenRay(const sf::Vector2f& pixel, const sf::Vector2f& targetSize, sf::Vector3f& origin, sf::Vector3f& direction) const {
+	// Los mismos ejes que `Mat4::lookAt`, en el mundo con y hacia arriba
+	sf::Vector3f offset = followOffset();
+	sf::Vector3f eye = flipY(m_position + offset);
+	sf::Vector3f forward = normalized(flipY(m_target + offset) - eye);
+	sf::Vector3f side = normalized(cross(forward, flipY(m_up)));
+	sf::Vector3f up = cross(side, forward);
+	float x = 2.0f * pixel.x / targetSize.x - 1.0f;
+	float y = 1.0f - 2.0f * pixel.y / targetSize.y;
+	if (m_projectionType == Projection::Perspective) {
+		float halfHeight = std::tan(m_fovY * 3.14159265f / 360.0f);
+		origin = flipY(eye);
+		direction = flipY(normalized(forward + side * (x * halfHeight * m_aspect) + up * (y * halfHeight)));
+		return;
+	}
+	float halfHeight = m_height * 0.5f;
+	origin = flipY(eye + side * (x * halfHeight * m_aspect) + up * (y * halfHeight));
+	direction = flipY(forward);
+}
+
+const Mat4&
+Camera::getView() const {
+	sf::Vector3f offset = followOffset();
+	if (m_viewDirty) {
+		m_view = Mat4::lookAt(flipY(m_position + offset), flipY(m_target + offset), flipY(m_up)) * Mat4::scale(1.0f, -1.0f, 1.0f);
+		m_offset = offset;
+		m_viewDirty = false;
+		m_viewProjectionDirty = true;
+	}
+	return m_view;
+}
+
+const Mat4&
+Camera::getProjection() const {
+	if (m_projectionDirty) {
+		if (m_projectionType == Projection::Perspective) {
+			m_projection = Mat4::perspective(m_fovY, m_aspect, m_near, m_far);
+		}
+		else {
+			float halfHeight = m_height * 0.5f;
+			float halfWidth = halfHeight * m_aspect;
+			m_projection = Mat4::orthographic(-halfWidth, halfWidth, -halfHeight, halfHeight, m_near, m_far);
+		}
+		m_projectionDirty = false;
+		m_viewProjectionDirty = true;
+	}
+	return m_projection;
+}
+
+const Mat4&
+Camera::getViewProjection() const {
+	const Mat4& view = getView();
+	const Mat4& projection = getProjection();
+	if (m_viewProjectionDirty) {
+		m_viewProjection = projection * view;
+		m_viewProjectionDirty = false;
+		++m_version;
+	}
+	return m_viewProjection;
+}
+
+CameraUniforms
+Camera::getUniforms() const {
+	CameraUniforms uniforms;
+	uniforms.viewProjection = getViewProjection();
+	uniforms.view = m_view;
+	uniforms.projection = m_projection;
+	sf::Vector3f position = getPosition();
+	uniforms.position[0] = position.x;
+	uniforms.position[1] = position.y;
+	uniforms.position[2] = position.z;
+	uniforms.position[3] = 1.0f;
+	return uniforms;
+}
+
+sf::Vector3f
+Camera::followOffset() const {
+	if (!m_transform) {
+		return sf::Vector3f();
+	}
+	sf::Vector2f moved = m_transform->getRenderTransform().transformPoint(0.0f, 0.0f);
+	sf::Vector3f offset(moved.x, moved.y, 0.0f);
+	if (offset != m_offset) {
+		m_viewDirty = true;
+	}
+	return offset;
+}
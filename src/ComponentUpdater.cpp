@@ -0,0 +1,55 @@
+#include "ComponentUpdater.h"
+#include "Entity.h"
+#include "Profiling/EntityCostProfiler.h"
+#include "Profiling/Profiler.h"
+
+void
+ComponentUpdater::update(std::span<Entity* const> entities, float deltaTime, EntityCostProfiler* costs) {
+	for (Lane& lane : m_lanes) {
+		lane.items.clear();
+	}
+	m_virtual.clear();
+	m_owners.clear();
+
+	for (Entity* entity : entities) {
+		for (EngineUtilities::TIntrusivePtr<Component>& component : entity->components) {
+			Lane& lane = m_lanes[component->getType()];
+			if (lane.batch) {
+				lane.items.push_back(component.get());
+			}
+			else if (!lane.skip) {
+				m_virtual.push_back(component.get());
+				if (costs) {
+					m_owners.push_back(entity);
+				}
+			}
+		}
+	}
+
+	if (costs) {
+		// Frame medido: el mismo orden, con el reloj entre cada llamada
+		for (size_t type = 0; type < kComponentTypeCount; ++type) {
+			Lane& lane = m_lanes[type];
+			if (lane.batch && !lane.items.empty()) {
+				int64_t start = Profiler::now();
+				lane.batch(lane.items, deltaTime);
+				costs->addBatch(static_cast<ComponentType>(type), Profiler::now() - start);
+			}
+		}
+		for (size_t i = 0; i < m_virtual.size(); ++i) {
+			int64_t start = Profiler::now();
+			m_virtual[i]->update(deltaTime);
+			costs->addUpdate(*m_owners[i], m_virtual[i]->getType(), Profiler::now() - start);
+		}
+		return;
+	}
+
+	for (Lane& lane : m_lanes) {
+		if (lane.batch && !lane.items.empty()) {
+			lane.batch(lane.items, deltaTime);
+		}
+	}
+	for (Component* component : m_virtual) {
+		component->update(deltaTime);
+	}
+}
@@ -0,0 +1,206 @@
+#include "ECS/Archetype.h"
+#include <algorithm>
+#include <cstring>
+#include "Memory/MemoryAccounting.h"
+
+namespace {
+	/**
+	 * @brief Lo que ocupa una columna de `capacity` filas de `rowBytes`, con sus ticks.
+	 */
+	size_t
+	columnBytes(size_t capacity, size_t rowBytes) {
+		return capacity * rowBytes + (capacity + kChangeBlockRows - 1) / kChangeBlockRows * sizeof(uint32_t);
+	}
+}
+
+ComponentColumn::ComponentColumn(ComponentTypeId typeId)
+	: m_typeId(typeId), m_info(&ComponentRegistry::info(typeId)) {
+}
+
+ComponentColumn::ComponentColumn(ComponentColumn&& other) noexcept
+	: m_typeId(other.m_typeId), m_info(other.m_info), m_data(other.m_data), m_ticks(other.m_ticks),
+	  m_lastChange(other.m_lastChange.load(std::memory_order_relaxed)), m_size(other.m_size), m_capacity(other.m_capacity) {
+	other.m_data = nullptr;
+	other.m_ticks = nullptr;
+	other.m_size = 0;
+	other.m_capacity = 0;
+}
+
+ComponentColumn::~ComponentColumn() {
+	if (!m_info->triviallyDestructible) {
+		for (size_t row = 0; row < m_size; ++row) {
+			m_info->destroy(at(row));
+		}
+	}
+	::operator delete(m_data, std::align_val_t(std::max(m_info->alignment, kColumnAlignment)));
+	::operator delete(m_ticks, std::align_val_t(kColumnAlignment));
+	EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Ecs, columnBytes(m_capacity, m_info->size));
+}
+
+void*
+ComponentColumn::pushUninitialized() {
+	if (m_size == m_capacity) {
+		reserve(m_capacity ? m_capacity * 2 : 16);
+	}
+	markChanged(m_size);
+	return at(m_size++);
+}
+
+void
+ComponentColumn::swapRemove(size_t row) {
+	assert(row < m_size);
+	size_t last = m_size - 1;
+	// La fila que llega trae su cambio al bloque nuevo
+	size_t block = row / kChangeBlockRows;
+	if (isNewerTick(m_ticks[last / kChangeBlockRows], m_ticks[block])) {
+		m_ticks[block] = m_ticks[last / kChangeBlockRows];
+	}
+	if (m_info->relocatable) {
+		// Se destruye la fila quitada y la ltima se muda a su lugar sin constructores
+		if (!m_info->triviallyDestructible) {
+			m_info->destroy(at(row));
+		}
+		if (row != last) {
+			std::memcpy(at(row), at(last), m_info->size);
+		}
+	}
+	else {
+		m_info->destroy(at(row));
+		if (row != last) {
+			m_info->moveConstruct(at(row), at(last));
+			m_info->destroy(at(last));
+		}
+	}
+	m_size = last;
+}
+
+void
+ComponentColumn::reserve(size_t capacity) {
+	if (capacity <= m_capacity) {
+		return;
+	}
+	unsigned char* data = static_cast<unsigned char*>(
+		::operator new(capacity * m_info->size, std::align_val_t(std::max(m_info->alignment, kColumnAlignment))));
+	if (m_info->relocatable) {
+		if (m_size) {
+			std::memcpy(data, m_data, m_size * m_info->size);
+		}
+	}
+	else {
+		for (size_t row = 0; row < m_size; ++row) {
+			m_info->moveConstruct(data + row * m_info->size, at(row));
+			m_info->destroy(at(row));
+		}
+	}
+	::operator delete(m_data, std::align_val_t(std::max(m_info->alignment, kColumnAlignment)));
+	m_data = data;
+
+	size_t blocks = (capacity + kChangeBlockRows - 1) / kChangeBlockRows;
+	size_t usedBlocks = (m_size + kChangeBlockRows - 1) / kChangeBlockRows;
+	uint32_t* ticks = static_cast<uint32_t*>(
+		::operator new(blocks * sizeof(uint32_t), std::align_val_t(kColumnAlignment)));
+	if (usedBlocks) {
+		std::memcpy(ticks, m_ticks, usedBlocks * sizeof(uint32_t));
+	}
+	std::fill(ticks + usedBlocks, ticks + blocks, 0u);
+	::operator delete(m_ticks, std::align_val_t(kColumnAlignment));
+	m_ticks = ticks;
+	EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Ecs, columnBytes(m_capacity, m_info->size));
+	EngineUtilities::MemoryAccounting::onAllocate(EngineUtilities::MemoryCategory::Ecs, columnBytes(capacity, m_info->size));
+	m_capacity = capacity;
+}
+
+void
+ComponentColumn::clear() {
+	if (!m_info->triviallyDestructible) {
+		for (size_t row = 0; row < m_size; ++row) {
+			m_info->destroy(at(row));
+		}
+	}
+	m_size = 0;
+}
+
+void
+ComponentColumn::copyFrom(const ComponentColumn& source) {
+	assert(source.m_typeId == m_typeId);
+	clear();
+	reserve(source.m_size);
+	if (m_info->trivial) {
+		if (source.m_size) {
+			std::memcpy(m_data, source.m_data, source.m_size * m_info->size);
+		}
+	}
+	else {
+		for (size_t row = 0; row < source.m_size; ++row) {
+			m_info->copyConstruct(at(row), source.at(row));
+		}
+	}
+	m_size = source.m_size;
+	markChanged(0, m_size);
+}
+
+size_t
+ComponentColumn::copyChangedBlocks(const ComponentColumn& source, const ComponentColumn& changed, uint32_t since) {
+	assert(source.m_typeId == m_typeId && source.m_size == m_size && changed.m_size == m_size);
+	if (!isNewerTick(changed.lastChangeTick(), since)) {
+		return 0;
+	}
+	size_t copied = 0;
+	size_t blocks = (m_size + kChangeBlockRows - 1) / kChangeBlockRows;
+	for (size_t block = 0; block < blocks; ++block) {
+		if (!isNewerTick(changed.m_ticks[block], since)) {
+			continue;
+		}
+		// Bloques seguidos van en una sola copia
+		size_t first = block;
+		while (block + 1 < blocks && isNewerTick(changed.m_ticks[block + 1], since)) {
+			++block;
+		}
+		size_t begin = first * kChangeBlockRows;
+		size_t end = std::min(m_size, (block + 1) * kChangeBlockRows);
+		if (m_info->trivial) {
+			std::memcpy(at(begin), source.at(begin), (end - begin) * m_info->size);
+		}
+		else {
+			for (size_t row = begin; row < end; ++row) {
+				m_info->destroy(at(row));
+				m_info->copyConstruct(at(row), source.at(row));
+			}
+		}
+		markChanged(begin, end);
+		copied += (end - begin) * m_info->size;
+	}
+	return copied;
+}
+
+Archetype::Archetype(ComponentSignature signature) : m_signature(signature) {
+	for (size_t typeId = 0; typeId < kMaxComponentTypes; ++typeId) {
+		m_columnIndex[typeId] = -1;
+		if ((signature >> typeId) & 1) {
+			m_columnIndex[typeId] = static_cast<int8_t>(m_columns.size());
+			m_columns.emplace_back(static_cast<ComponentTypeId>(typeId));
+		}
+	}
+}
+
+uint32_t
+Archetype::pushEntity(EntityId entity) {
+	m_entities.push_back(entity);
+	return static_cast<uint32_t>(m_entities.size() - 1);
+}
+
+EntityId
+Archetype::removeRow(uint32_t row) {
+	assert(row < m_entities.size());
+	for (ComponentColumn& column : m_columns) {
+		column.swapRemove(row);
+	}
+	uint32_t last = static_cast<uint32_t>(m_entities.size() - 1);
+	EntityId moved;
+	if (row != last) {
+		m_entities[row] = m_entities[last];
+		moved = m_entities[row];
+	}
+	m_entities.pop_back();
+	return moved;
+}
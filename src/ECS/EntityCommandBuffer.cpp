@@ -0,0 +1,195 @@
+#include "ECS/EntityCommandBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+namespace {
+	/**
+	 * @brief ltimo flujo usado por este hilo; evita el candado en cada comando.
+	 */
+	struct StreamCache {
+		uint64_t buffer = 0;
+		void* stream = nullptr;
+	};
+
+	thread_local StreamCache t_streamCache;
+
+	std::atomic<uint64_t> s_nextBufferId{ 1 };
+}
+
+EntityCommandBuffer::EntityCommandBuffer()
+	: m_id(s_nextBufferId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+EntityCommandBuffer::~EntityCommandBuffer() {
+	// Lo anotado y nunca reproducido tambin se destruye
+	for (EngineUtilities::TUniquePtr<Stream>& stream : m_streams) {
+		destroyPayloads(*stream);
+	}
+}
+
+PendingEntity
+EntityCommandBuffer::spawn() {
+	Stream& stream = localStream();
+	assert(stream.spawned < (1u << 24) - 1 && "Demasiadas entidades pedidas en un frame");
+	return { stream.index, stream.spawned++ };
+}
+
+void
+EntityCommandBuffer::destroy(EntityId entity) {
+	record(localStream(), entity, 0, Op::Destroy, 0, nullptr, nullptr);
+}
+
+void
+EntityCommandBuffer::record(Stream& stream, EntityId entity, uint32_t pending, Op op, ComponentTypeId type,
+	const PayloadOps* ops, void* payload) {
+	assert(stream.commands.size() < (1u << 24) && "Demasiados comandos en un frame");
+	Command& command = stream.commands.emplace_back();
+	command.entity = entity;
+	command.pending = pending;
+	command.op = op;
+	command.type = type;
+	command.ops = ops;
+	command.payload = payload;
+}
+
+void
+EntityCommandBuffer::destroyPayloads(Stream& stream) {
+	for (const Command& command : stream.commands) {
+		if (command.payload && command.ops->destroy) {
+			command.ops->destroy(command.payload);
+		}
+	}
+}
+
+EntityCommandBuffer::Stream&
+EntityCommandBuffer::localStream() {
+	if (t_streamCache.buffer == m_id) {
+		return *static_cast<Stream*>(t_streamCache.stream);
+	}
+	std::thread::id self = std::this_thread::get_id();
+	std::lock_guard<std::mutex> lock(m_streamsMutex);
+	Stream* found = nullptr;
+	for (EngineUtilities::TUniquePtr<Stream>& stream : m_streams) {
+		if (stream->owner == self) {
+			found = stream.get();
+			break;
+		}
+	}
+	if (!found) {
+		assert(m_streams.size() < 256 && "Demasiados hilos anotando comandos");
+		m_streams.push_back(EngineUtilities::MakeUnique<Stream>(self, static_cast<uint32_t>(m_streams.size())));
+		found = m_streams.back().get();
+	}
+	t_streamCache = { m_id, found };
+	return *found;
+}
+
+void
+EntityCommandBuffer::playback(World& world) {
+	std::lock_guard<std::mutex> lock(m_streamsMutex);
+
+	// Primero existen las entidades pedidas, para poder ordenar todo por id
+	for (EngineUtilities::TUniquePtr<Stream>& stream : m_streams) {
+		stream->ids.clear();
+		for (uint32_t i = 0; i < stream->spawned; ++i) {
+			stream->ids.push_back(world.createEntity());
+		}
+	}
+
+	m_order.clear();
+	for (EngineUtilities::TUniquePtr<Stream>& stream : m_streams) {
+		for (uint32_t position = 0; position < stream->commands.size(); ++position) {
+			Command& command = stream->commands[position];
+			if (command.pending) {
+				command.entity = m_streams[command.pending >> 24]->ids[(command.pending & 0xFFFFFF) - 1];
+			}
+			// A igual ndice, los de un flujo quedan en el orden en que se anotaron
+			m_order.push_back((uint64_t(command.entity.index) << 32) | (uint64_t(stream->index) << 24) | position);
+		}
+	}
+	if (!std::is_sorted(m_order.begin(), m_order.end())) {
+		std::sort(m_order.begin(), m_order.end());
+	}
+
+	// Cada entidad junta sus comandos y se muda de arquetipo una sola vez
+	void* slots[kMaxComponentTypes];
+	const Command* latest[kMaxComponentTypes];
+	for (size_t begin = 0; begin < m_order.size();) {
+		EntityId entity = commandAt(begin).entity;
+		bool alive = world.isAlive(entity);
+		bool destroyed = false;
+		ComponentSignature added = 0;
+		ComponentSignature removed = 0;
+		size_t end = begin;
+		// Un ndice con dos generaciones (un id viejo y uno nuevo) se parte en dos grupos
+		for (; end < m_order.size() && commandAt(end).entity == entity; ++end) {
+			const Command& command = commandAt(end);
+			if (!alive || destroyed) {
+				continue;
+			}
+			ComponentSignature bit = ComponentSignature(1) << command.type;
+			switch (command.op) {
+			case Op::Destroy:
+				destroyed = true;
+				break;
+			case Op::Add:
+				if (command.ops->sparse) {
+					command.ops->addSparse(world, entity, command.payload);
+					break;
+				}
+				added |= bit;
+				removed &= ~bit;
+				latest[command.type] = &command;
+				break;
+			case Op::Remove:
+				if (command.ops->sparse) {
+					command.ops->removeSparse(world, entity);
+					break;
+				}
+				removed |= bit;
+				added &= ~bit;
+				break;
+			}
+		}
+		if (destroyed) {
+			world.destroyEntity(entity);
+		}
+		else if (alive && (added | removed)) {
+			world.changeComponents(entity, added, removed, slots);
+			for (ComponentSignature pending = added; pending; pending &= pending - 1) {
+				ComponentTypeId typeId = static_cast<ComponentTypeId>(std::countr_zero(pending));
+				latest[typeId]->ops->construct(slots[typeId], latest[typeId]->payload);
+			}
+		}
+		begin = end;
+	}
+
+	// Los valores anotados, movidos o descartados, se destruyen antes de reiniciar la arena
+	m_order.clear();
+	for (EngineUtilities::TUniquePtr<Stream>& stream : m_streams) {
+		destroyPayloads(*stream);
+		stream->commands.clear();
+		stream->arena.reset();
+		stream->spawned = 0;
+	}
+}
+
+EntityId
+EntityCommandBuffer::resolve(PendingEntity entity) const {
+	std::lock_guard<std::mutex> lock(m_streamsMutex);
+	if (entity.stream >= m_streams.size() || entity.index >= m_streams[entity.stream]->ids.size()) {
+		return EntityId{};
+	}
+	return m_streams[entity.stream]->ids[entity.index];
+}
+
+size_t
+EntityCommandBuffer::size() const {
+	std::lock_guard<std::mutex> lock(m_streamsMutex);
+	size_t total = 0;
+	for (const EngineUtilities::TUniquePtr<Stream>& stream : m_streams) {
+		total += stream->commands.size();
+	}
+	return total;
+}
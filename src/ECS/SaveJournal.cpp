@@ -0,0 +1,403 @@
+#include "ECS/SaveJournal.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include "Scene/SceneFormat.h"
+
+namespace {
+	uint64_t
+	fnv1a(const unsigned char* data, size_t bytes) {
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (size_t i = 0; i < bytes; ++i) {
+			hash = (hash ^ data[i]) * 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	template<typename T>
+	void
+	append(std::vector<unsigned char>& out, const T& value) {
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+		out.insert(out.end(), bytes, bytes + sizeof(T));
+	}
+
+	void
+	appendBytes(std::vector<unsigned char>& out, const void* data, size_t bytes) {
+		const unsigned char* start = static_cast<const unsigned char*>(data);
+		out.insert(out.end(), start, start + bytes);
+	}
+
+	/**
+	 * @brief Lee un `T` de `[at, end)` y avanza; `false` si no alcanza.
+	 */
+	template<typename T>
+	bool
+	take(const unsigned char*& at, const unsigned char* end, T& value) {
+		if (static_cast<size_t>(end - at) < sizeof(T)) {
+			return false;
+		}
+		std::memcpy(&value, at, sizeof(T));
+		at += sizeof(T);
+		return true;
+	}
+
+	/**
+	 * @brief Lo que el diario dice del mundo hasta el trozo ledo, arquetipo por arquetipo.
+	 */
+	struct SavedColumn {
+		uint64_t typeHash = 0;
+		uint32_t size = 0;
+		std::vector<unsigned char> data;
+	};
+
+	struct SavedArchetype {
+		std::vector<EntityId> entities;
+		std::vector<SavedColumn> columns;
+	};
+}
+
+bool
+SaveJournal::open(const std::string& path) {
+	if (m_running) {
+		return false;
+	}
+	// Se abre para agregar: lo de una corrida anterior sigue ah hasta el primer trozo completo
+	m_file.open(path, std::ios::binary | std::ios::app);
+	if (!m_file) {
+		return false;
+	}
+	m_path = path;
+	m_snapshot.invalidate();
+	m_copyTick = 0;
+	m_written.clear();
+	m_needFull = true;
+	m_fullBytes = 0;
+	m_deltaBytes = 0;
+	m_stopping = false;
+	m_busy = false;
+	m_running = true;
+	m_thread = std::thread([this]() { writeLoop(); });
+	return true;
+}
+
+void
+SaveJournal::close() {
+	if (!m_running) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_one();
+	m_thread.join();
+	m_file.close();
+	m_running = false;
+}
+
+bool
+SaveJournal::checkpoint(World& world) {
+	if (!m_running) {
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_busy) {
+			return false;
+		}
+	}
+	uint32_t since = m_copyTick;
+	if (!world.saveSnapshot(m_snapshot)) {
+		// La foto qued vaca: la prxima se copia entera, toda marcada, y as se escribe
+		return false;
+	}
+	// Lo copiado qued marcado con el tick de ahora; lo de fotos anteriores, con uno ms viejo
+	m_copyTick = currentChangeTick();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_since = since;
+		m_busy = true;
+	}
+	m_wake.notify_one();
+	return true;
+}
+
+void
+SaveJournal::wait() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]() { return !m_busy; });
+}
+
+size_t
+SaveJournal::lastChunkBytes() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_lastChunk;
+}
+
+void
+SaveJournal::writeLoop() {
+	for (;;) {
+		uint32_t since = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this]() { return m_busy || m_stopping; });
+			if (!m_busy) {
+				return;
+			}
+			since = m_since;
+		}
+		// Compactar es escribir el mundo entero en vez de las diferencias
+		bool full = m_needFull || m_deltaBytes > kCompactRatio * m_fullBytes;
+		uint32_t records = buildChunk(full, since);
+		bool empty = !full && records == 0;
+		bool written = empty || writeChunk(full, records);
+		if (!written) {
+			// Lo que falt no est en el archivo: el siguiente lo reemplaza entero
+			m_needFull = true;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_lastChunk = written && !empty ? sizeof(ChunkHeader) + m_payload.size() : 0;
+			m_busy = false;
+		}
+		m_idle.notify_all();
+	}
+}
+
+uint32_t
+SaveJournal::buildChunk(bool full, uint32_t since) {
+	m_payload.clear();
+	uint32_t records = 0;
+	if (full) {
+		m_written.clear();
+	}
+	m_written.resize(m_snapshot.m_archetypeCount);
+	for (size_t i = 0; i < m_snapshot.m_archetypeCount; ++i) {
+		const Archetype& archetype = *m_snapshot.m_archetypes[i];
+		size_t columnCount = 0;
+		for (const ComponentColumn& column : archetype.columns()) {
+			columnCount += ComponentRegistry::info(column.typeId()).serializable;
+		}
+		if (columnCount == 0) {
+			continue;
+		}
+		bool replaced = full || m_written[i] != archetype.entities();
+		size_t recordStart = m_payload.size();
+		Record record{ static_cast<uint32_t>(i), replaced ? kRecordReplaced : 0u,
+			static_cast<uint32_t>(archetype.size()), 0 };
+		append(m_payload, record);
+		if (replaced) {
+			appendBytes(m_payload, archetype.entities().data(), archetype.size() * sizeof(EntityId));
+			m_written[i] = archetype.entities();
+		}
+
+		size_t blocks = (archetype.size() + kChangeBlockRows - 1) / kChangeBlockRows;
+		for (const ComponentColumn& column : archetype.columns()) {
+			const ComponentInfo& info = ComponentRegistry::info(column.typeId());
+			if (!info.serializable || (!replaced && !isNewerTick(column.lastChangeTick(), since))) {
+				continue;
+			}
+			size_t columnStart = m_payload.size();
+			Column header{ sceneTypeHash(info.name), static_cast<uint32_t>(info.size), 0 };
+			append(m_payload, header);
+			for (size_t block = 0; block < blocks; ++block) {
+				if (!replaced && !isNewerTick(column.blockTick(block), since)) {
+					continue;
+				}
+				// Bloques seguidos van en un solo tramo
+				size_t first = block;
+				while (block + 1 < blocks && (replaced || isNewerTick(column.blockTick(block + 1), since))) {
+					++block;
+				}
+				size_t begin = first * kChangeBlockRows;
+				size_t end = std::min(archetype.size(), (block + 1) * kChangeBlockRows);
+				append(m_payload, Run{ static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin) });
+				appendBytes(m_payload, column.at(begin), (end - begin) * info.size);
+				++header.runCount;
+			}
+			if (header.runCount == 0 && !replaced) {
+				m_payload.resize(columnStart);
+				continue;
+			}
+			std::memcpy(m_payload.data() + columnStart, &header, sizeof(header));
+			++record.columnCount;
+		}
+		if (record.columnCount == 0 && !replaced) {
+			m_payload.resize(recordStart);
+			continue;
+		}
+		std::memcpy(m_payload.data() + recordStart, &record, sizeof(record));
+		++records;
+	}
+	return records;
+}
+
+bool
+SaveJournal::writeChunk(bool full, uint32_t recordCount) {
+	ChunkHeader header = { { 'G', 'S', 'A', 'V' }, kVersion, full ? kChunkFull : 0u, recordCount,
+		m_payload.size(), fnv1a(m_payload.data(), m_payload.size()) };
+	if (!full) {
+		m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		m_file.write(reinterpret_cast<const char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+		m_file.flush();
+		if (!m_file) {
+			m_file.clear();
+			return false;
+		}
+		m_deltaBytes += sizeof(header) + m_payload.size();
+		return true;
+	}
+
+	// Aparte y luego renombrado: un corte a medias deja el diario anterior entero
+	std::string temporary = m_path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+		if (!file.flush()) {
+			return false;
+		}
+	}
+	m_file.close();
+	std::error_code error;
+	std::filesystem::rename(temporary, m_path, error);
+	m_file.open(m_path, std::ios::binary | std::ios::app);
+	if (error || !m_file) {
+		return false;
+	}
+	m_needFull = false;
+	m_fullBytes = sizeof(header) + m_payload.size();
+	m_deltaBytes = 0;
+	return true;
+}
+
+int64_t
+SaveJournal::load(const std::string& path, World& world) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return -1;
+	}
+	std::vector<unsigned char> bytes(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+		return -1;
+	}
+
+	// Cada trozo se revisa entero antes de aplicarlo: uno que no encaja termina el diario
+	std::vector<SavedArchetype> saved;
+	bool any = false;
+	const unsigned char* at = bytes.data();
+	const unsigned char* fileEnd = bytes.data() + bytes.size();
+	for (;;) {
+		ChunkHeader header;
+		if (!take(at, fileEnd, header) || std::memcmp(header.magic, "GSAV", 4) != 0 || header.version != kVersion ||
+		    header.payloadBytes > static_cast<uint64_t>(fileEnd - at) ||
+		    fnv1a(at, static_cast<size_t>(header.payloadBytes)) != header.checksum ||
+		    (!any && !(header.flags & kChunkFull))) {
+			break;
+		}
+		const unsigned char* chunkEnd = at + header.payloadBytes;
+		std::vector<SavedArchetype> next = (header.flags & kChunkFull) ? std::vector<SavedArchetype>() : saved;
+		bool valid = true;
+		for (uint32_t r = 0; r < header.recordCount && valid; ++r) {
+			Record record;
+			valid = take(at, chunkEnd, record);
+			if (!valid) {
+				break;
+			}
+			if (record.archetype >= next.size()) {
+				next.resize(record.archetype + 1);
+			}
+			SavedArchetype& archetype = next[record.archetype];
+			if (record.flags & kRecordReplaced) {
+				valid = static_cast<size_t>(chunkEnd - at) / sizeof(EntityId) >= record.rowCount;
+				if (!valid) {
+					break;
+				}
+				archetype.entities.resize(record.rowCount);
+				std::memcpy(archetype.entities.data(), at, record.rowCount * sizeof(EntityId));
+				at += record.rowCount * sizeof(EntityId);
+				archetype.columns.clear();
+			}
+			valid = archetype.entities.size() == record.rowCount;
+			for (uint32_t c = 0; c < record.columnCount && valid; ++c) {
+				Column columnHeader;
+				valid = take(at, chunkEnd, columnHeader) && columnHeader.size > 0;
+				if (!valid) {
+					break;
+				}
+				SavedColumn* column = nullptr;
+				for (SavedColumn& existing : archetype.columns) {
+					if (existing.typeHash == columnHeader.typeHash) {
+						column = &existing;
+					}
+				}
+				if (!column) {
+					column = &archetype.columns.emplace_back();
+					column->typeHash = columnHeader.typeHash;
+					column->size = columnHeader.size;
+					column->data.resize(static_cast<size_t>(record.rowCount) * columnHeader.size);
+				}
+				valid = column->size == columnHeader.size;
+				for (uint32_t k = 0; k < columnHeader.runCount && valid; ++k) {
+					Run run;
+					valid = take(at, chunkEnd, run) && run.firstRow <= record.rowCount &&
+						run.rows <= record.rowCount - run.firstRow &&
+						static_cast<size_t>(chunkEnd - at) >= static_cast<size_t>(run.rows) * columnHeader.size;
+					if (valid) {
+						std::memcpy(column->data.data() + static_cast<size_t>(run.firstRow) * columnHeader.size, at,
+							static_cast<size_t>(run.rows) * columnHeader.size);
+						at += static_cast<size_t>(run.rows) * columnHeader.size;
+					}
+				}
+			}
+		}
+		if (!valid || at != chunkEnd) {
+			break;
+		}
+		saved = std::move(next);
+		any = true;
+	}
+	if (!any) {
+		return -1;
+	}
+
+	// Los ids de tipo son de esta corrida; el nombre y el tamao, de cualquiera
+	std::unordered_map<uint64_t, ComponentTypeId> types;
+	for (size_t typeId = 0; typeId < ComponentRegistry::count(); ++typeId) {
+		const ComponentInfo& info = ComponentRegistry::info(static_cast<ComponentTypeId>(typeId));
+		if (info.serializable) {
+			types[sceneTypeHash(info.name)] = static_cast<ComponentTypeId>(typeId);
+		}
+	}
+	int64_t restored = 0;
+	void* slots[kMaxComponentTypes];
+	for (const SavedArchetype& archetype : saved) {
+		ComponentSignature added = 0;
+		std::vector<std::pair<ComponentTypeId, const SavedColumn*>> columns;
+		for (const SavedColumn& column : archetype.columns) {
+			auto found = types.find(column.typeHash);
+			if (found != types.end() && ComponentRegistry::info(found->second).size == column.size) {
+				added |= ComponentSignature(1) << found->second;
+				columns.emplace_back(found->second, &column);
+			}
+		}
+		if (added == 0) {
+			continue;
+		}
+		for (size_t row = 0; row < archetype.entities.size(); ++row) {
+			EntityId entity = archetype.entities[row];
+			if (!world.isAlive(entity)) {
+				continue;
+			}
+			// Una sola mudanza por entidad; los tipos que ya tena se reemplazan en su lugar
+			world.changeComponents(entity, added, 0, slots);
+			for (const auto& [typeId, column] : columns) {
+				std::memcpy(slots[typeId], column->data.data() + row * column->size, column->size);
+			}
+			++restored;
+		}
+	}
+	return restored;
+}
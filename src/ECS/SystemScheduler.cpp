@@ -0,0 +1,78 @@
+#include "ECS/SystemScheduler.h"
+#include "ECS/World.h"
+#include "Profiling/Profiler.h"
+
+SystemScheduler::SystemScheduler(JobSystem& jobs) : m_jobs(jobs) {
+}
+
+void
+SystemScheduler::buildGraph() {
+	size_t count = m_systems.size();
+	m_dependents.assign(count, {});
+	m_dependencyCount.assign(count, 0);
+	m_roots.clear();
+	for (size_t later = 0; later < count; ++later) {
+		for (size_t earlier = 0; earlier < later; ++earlier) {
+			if (m_systems[earlier]->access().conflictsWith(m_systems[later]->access())) {
+				m_dependents[earlier].push_back(later);
+				++m_dependencyCount[later];
+			}
+		}
+		if (m_dependencyCount[later] == 0) {
+			m_roots.push_back(later);
+		}
+	}
+	m_pending = EngineUtilities::MakeUnique<std::atomic<uint32_t>[]>(count);
+	m_graphDirty = false;
+}
+
+void
+SystemScheduler::run(World& world, float deltaTime) {
+	PROFILE_SCOPE("Systems");
+	if (m_graphDirty) {
+		buildGraph();
+	}
+	if (m_systems.empty()) {
+		return;
+	}
+
+	// Sin hilos de trabajo: el orden de registro ya respeta todas las dependencias
+	if (m_jobs.activeWorkers() == 0) {
+		for (EngineUtilities::TUniquePtr<System>& system : m_systems) {
+			execute(*system, world, deltaTime);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < m_systems.size(); ++i) {
+		m_pending[i].store(m_dependencyCount[i], std::memory_order_relaxed);
+	}
+	m_world = &world;
+	m_deltaTime = deltaTime;
+	for (size_t root : m_roots) {
+		m_jobs.run([this, root]() { runSystem(root); }, &m_frame);
+	}
+	m_jobs.wait(m_frame);
+}
+
+void
+SystemScheduler::execute(System& system, World& world, float deltaTime) {
+	// Lo que se escriba desde aqu, tambin por este sistema, es ms nuevo que `started`
+	uint32_t started = advanceChangeTick();
+	PROFILE_SCOPE_DYNAMIC(system.getName());
+	system.update(world, deltaTime);
+	system.m_lastRunTick = started;
+}
+
+void
+SystemScheduler::runSystem(size_t index) {
+	execute(*m_systems[index], *m_world, m_deltaTime);
+
+	// Los dependientes entran al grupo antes de que este trabajo lo descuente
+	for (size_t dependent : m_dependents[index]) {
+		// acq_rel: el siguiente sistema ve lo que escribi este
+		if (m_pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			m_jobs.run([this, dependent]() { runSystem(dependent); }, &m_frame);
+		}
+	}
+}
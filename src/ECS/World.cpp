@@ -0,0 +1,291 @@
+#include "ECS/World.h"
+#include <bit>
+#include <cstring>
+#include "ECS/WorldSnapshot.h"
+
+World::World() {
+	m_emptyArchetype = &archetypeFor(0);
+}
+
+World::~World() {
+	// Las columnas destruyen sus componentes al destruirse cada arquetipo
+	m_queries.clear();
+	m_bySignature.clear();
+	m_archetypes.clear();
+}
+
+EntityId
+World::createEntity() {
+	touchStructure();
+	EntityId entity = m_entities.insert({ m_emptyArchetype, 0, 0 });
+	m_entities.get(entity)->row = m_emptyArchetype->pushEntity(entity);
+	return entity;
+}
+
+bool
+World::destroyEntity(EntityId entity) {
+	EntityLocation* location = m_entities.get(entity);
+	if (!location) {
+		return false;
+	}
+	touchStructure();
+	for (ComponentSignature pooled = location->pooled; pooled; pooled &= pooled - 1) {
+		m_pools[std::countr_zero(pooled)]->remove(entity);
+	}
+	EntityId moved = location->archetype->removeRow(location->row);
+	if (moved) {
+		m_entities.get(moved)->row = location->row;
+	}
+	m_entities.erase(entity);
+	return true;
+}
+
+Archetype&
+World::archetypeFor(ComponentSignature signature) {
+	auto found = m_bySignature.find(signature);
+	if (found != m_bySignature.end()) {
+		return *found->second;
+	}
+	m_archetypes.push_back(EngineUtilities::MakeUnique<Archetype>(signature));
+	Archetype* created = m_archetypes.back().get();
+	m_bySignature.emplace(signature, created);
+
+	// Cambio estructural: ningn sistema corre a la vez, no hace falta el candado
+	for (auto& [required, query] : m_queries) {
+		if ((signature & required) == required) {
+			query->archetypes.push_back(created);
+		}
+	}
+	return *created;
+}
+
+const QueryCache&
+World::queryFor(ComponentSignature required) {
+	{
+		std::shared_lock<std::shared_mutex> lock(m_queriesMutex);
+		auto found = m_queries.find(required);
+		if (found != m_queries.end()) {
+			return *found->second;
+		}
+	}
+	std::unique_lock<std::shared_mutex> lock(m_queriesMutex);
+	EngineUtilities::TUniquePtr<QueryCache>& query = m_queries[required];
+	if (!query) {
+		query = EngineUtilities::MakeUnique<QueryCache>();
+		query->required = required;
+		for (EngineUtilities::TUniquePtr<Archetype>& archetype : m_archetypes) {
+			if ((archetype->signature() & required) == required) {
+				query->archetypes.push_back(archetype.get());
+			}
+		}
+	}
+	return *query;
+}
+
+Archetype&
+World::withComponent(Archetype& from, ComponentTypeId typeId) {
+	Archetype*& edge = from.addEdge(typeId);
+	if (!edge) {
+		edge = &archetypeFor(from.signature() | (ComponentSignature(1) << typeId));
+		edge->removeEdge(typeId) = &from;
+	}
+	return *edge;
+}
+
+Archetype&
+World::withoutComponent(Archetype& from, ComponentTypeId typeId) {
+	Archetype*& edge = from.removeEdge(typeId);
+	if (!edge) {
+		edge = &archetypeFor(from.signature() & ~(ComponentSignature(1) << typeId));
+		edge->addEdge(typeId) = &from;
+	}
+	return *edge;
+}
+
+void
+World::changeComponents(EntityId entity, ComponentSignature added, ComponentSignature removed,
+	void* slots[kMaxComponentTypes]) {
+	EntityLocation* location = m_entities.get(entity);
+	assert(location && "Entidad destruida");
+	assert(!(added & removed) && "Un tipo no puede agregarse y quitarse a la vez");
+	Archetype& source = *location->archetype;
+	ComponentSignature signature = (source.signature() | added) & ~removed;
+	if (signature == source.signature()) {
+		// Solo reemplazos: se rehacen en su lugar, sin mudar la fila
+		for (ComponentSignature pending = added; pending; pending &= pending - 1) {
+			ComponentTypeId typeId = static_cast<ComponentTypeId>(std::countr_zero(pending));
+			ComponentColumn* column = source.column(typeId);
+			column->markChanged(location->row);
+			void* slot = column->at(location->row);
+			ComponentRegistry::info(typeId).destroy(slot);
+			slots[typeId] = slot;
+		}
+		return;
+	}
+	Archetype::ChangeEdge& edge = source.changeEdge();
+	if (!edge.target || edge.added != added || edge.removed != removed) {
+		edge = { added, removed, &archetypeFor(signature) };
+	}
+	moveEntity(entity, *location, *edge.target, added, slots);
+}
+
+void*
+World::moveEntity(EntityId entity, EntityLocation& location, Archetype& target, ComponentTypeId skipped) {
+	void* slots[kMaxComponentTypes];
+	moveEntity(entity, location, target, ComponentSignature(1) << skipped, slots);
+	return target.has(skipped) ? slots[skipped] : nullptr;
+}
+
+void
+World::moveEntity(EntityId entity, EntityLocation& location, Archetype& target, ComponentSignature skipped,
+	void* slots[kMaxComponentTypes]) {
+	touchStructure();
+	Archetype& source = *location.archetype;
+	uint32_t oldRow = location.row;
+	uint32_t newRow = target.pushEntity(entity);
+
+	for (ComponentColumn& column : target.columns()) {
+		void* slot = column.pushUninitialized();
+		if ((skipped >> column.typeId()) & 1) {
+			slots[column.typeId()] = slot;
+			continue;
+		}
+		const ComponentInfo& info = ComponentRegistry::info(column.typeId());
+		if (info.trivial) {
+			std::memcpy(slot, source.column(column.typeId())->at(oldRow), info.size);
+		}
+		else {
+			info.moveConstruct(slot, source.column(column.typeId())->at(oldRow));
+		}
+	}
+
+	// La fila vieja queda con objetos ya movidos (y los descartados); removeRow los destruye
+	EntityId moved = source.removeRow(oldRow);
+	if (moved) {
+		m_entities.get(moved)->row = oldRow;
+	}
+	location.archetype = &target;
+	location.row = newRow;
+}
+
+bool
+World::saveSnapshot(WorldSnapshot& snapshot) {
+	for (EngineUtilities::TUniquePtr<Archetype>& archetype : m_archetypes) {
+		for (const ComponentColumn& column : archetype->columns()) {
+			const ComponentInfo& info = ComponentRegistry::info(column.typeId());
+			if (!info.trivial && !info.copyConstruct) {
+				snapshot.invalidate();
+				return false;
+			}
+		}
+	}
+	for (EngineUtilities::TUniquePtr<IComponentPool>& pool : m_pools) {
+		if (pool && !pool->isCopyable()) {
+			snapshot.invalidate();
+			return false;
+		}
+	}
+
+	// Lo escrito desde aqu es ms nuevo que la foto; lo de antes, hasta este tick, entra
+	bool incremental = snapshot.m_world == this;
+	bool sameLayout = incremental && snapshot.m_structure == m_structure;
+	uint32_t since = snapshot.m_tick;
+	snapshot.m_tick = advanceChangeTick();
+	snapshot.m_world = this;
+
+	size_t copied = 0;
+	for (size_t i = 0; i < m_archetypes.size(); ++i) {
+		const Archetype& source = *m_archetypes[i];
+		if (i == snapshot.m_archetypes.size()) {
+			snapshot.m_archetypes.push_back(EngineUtilities::MakeUnique<Archetype>(source.signature()));
+		}
+		copied += copyRows(*snapshot.m_archetypes[i], source, incremental ? &source : nullptr, since, sameLayout);
+	}
+	snapshot.m_archetypeCount = m_archetypes.size();
+	if (!sameLayout) {
+		snapshot.m_entities = m_entities;
+	}
+	snapshot.m_entityCount = m_entities.size();
+	snapshot.m_structure = m_structure;
+
+	for (size_t typeId = 0; typeId < kMaxComponentTypes; ++typeId) {
+		EngineUtilities::TUniquePtr<IComponentPool>& saved = snapshot.m_pools[typeId];
+		if (!m_pools[typeId]) {
+			saved.reset();
+		}
+		else if (!saved) {
+			saved = m_pools[typeId]->clone();
+		}
+		else {
+			saved->assign(*m_pools[typeId]);
+		}
+	}
+	snapshot.m_lastCopied = copied;
+	return true;
+}
+
+bool
+World::restoreSnapshot(const WorldSnapshot& snapshot) {
+	if (snapshot.m_world != this) {
+		return false;
+	}
+	// Los arquetipos no se destruyen: los punteros de las ubicaciones guardadas siguen valiendo
+	bool sameLayout = snapshot.m_structure == m_structure;
+	size_t copied = 0;
+	for (size_t i = 0; i < m_archetypes.size(); ++i) {
+		Archetype& target = *m_archetypes[i];
+		if (i < snapshot.m_archetypeCount) {
+			copied += copyRows(target, *snapshot.m_archetypes[i], &target, snapshot.m_tick, sameLayout);
+		}
+		else {
+			for (ComponentColumn& column : target.columns()) {
+				column.clear();
+			}
+			target.assignEntities({});
+		}
+	}
+	if (!sameLayout) {
+		m_entities = snapshot.m_entities;
+		m_structure = snapshot.m_structure;
+	}
+
+	for (size_t typeId = 0; typeId < kMaxComponentTypes; ++typeId) {
+		const EngineUtilities::TUniquePtr<IComponentPool>& saved = snapshot.m_pools[typeId];
+		if (!saved) {
+			if (m_pools[typeId]) {
+				m_pools[typeId]->clear();
+			}
+		}
+		else if (!m_pools[typeId]) {
+			m_pools[typeId] = saved->clone();
+		}
+		else {
+			m_pools[typeId]->assign(*saved);
+		}
+	}
+	snapshot.m_lastCopied = copied;
+	return true;
+}
+
+size_t
+World::copyRows(Archetype& target, const Archetype& source, const Archetype* changed, uint32_t since,
+	bool sameLayout) {
+	// Mismas entidades en el mismo orden: las filas solo difieren en lo que se escribi
+	bool sameRows = changed && (sameLayout || target.entities() == source.entities());
+	if (!sameRows) {
+		target.assignEntities(source.entities());
+	}
+	std::vector<ComponentColumn>& columns = target.columns();
+	const std::vector<ComponentColumn>& sourceColumns = source.columns();
+	size_t copied = 0;
+	for (size_t i = 0; i < columns.size(); ++i) {
+		if (sameRows) {
+			copied += columns[i].copyChangedBlocks(sourceColumns[i], changed->columns()[i], since);
+		}
+		else {
+			columns[i].copyFrom(sourceColumns[i]);
+			copied += sourceColumns[i].size() * ComponentRegistry::info(sourceColumns[i].typeId()).size;
+		}
+	}
+	return copied;
+}
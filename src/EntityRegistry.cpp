@@ -0,0 +1,124 @@
+#include "EntityRegistry.h"
+
+EntityHandle
+EntityRegistry::acquire(Entity& entity) {
+	uint32_t index;
+	if (m_freeHead != kNoSlot) {
+		index = m_freeHead;
+		m_freeHead = m_slots[index].nextFree;
+	}
+	else {
+		index = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+		m_tags.push_back(0);
+		m_layers.push_back(0);
+		m_names.push_back(kNoName);
+		m_namePositions.push_back(0);
+	}
+	m_tags[index] = 0;
+	m_layers[index] = kDefaultLayers;
+	Slot& slot = m_slots[index];
+	slot.entity = &entity;
+	slot.nextFree = kNoSlot;
+	++m_count;
+	return { index, slot.generation };
+}
+
+bool
+EntityRegistry::release(EntityHandle handle) {
+	if (!find(handle)) {
+		return false;
+	}
+	setName(handle, kNoName);
+	indexTags(handle, 0, m_tags[handle.index]);
+	Slot& slot = m_slots[handle.index];
+	slot.entity = nullptr;
+	m_tags[handle.index] = 0;
+	m_layers[handle.index] = 0;
+	// Nueva generacin (nunca 0) y al frente de la lista libre
+	if (++slot.generation == 0) {
+		slot.generation = 1;
+	}
+	slot.nextFree = m_freeHead;
+	m_freeHead = handle.index;
+	--m_count;
+	return true;
+}
+
+bool
+EntityRegistry::setTags(EntityHandle handle, EntityMask tags) {
+	if (!contains(handle)) {
+		return false;
+	}
+	EntityMask previous = m_tags[handle.index];
+	indexTags(handle, tags & ~previous, previous & ~tags);
+	m_tags[handle.index] = tags;
+	return true;
+}
+
+bool
+EntityRegistry::setLayers(EntityHandle handle, EntityMask layers) {
+	if (!contains(handle)) {
+		return false;
+	}
+	m_layers[handle.index] = layers;
+	return true;
+}
+
+bool
+EntityRegistry::setName(EntityHandle handle, NameId name) {
+	if (!contains(handle)) {
+		return false;
+	}
+	NameId previous = m_names[handle.index];
+	if (previous == name) {
+		return true;
+	}
+	if (previous != kNoName) {
+		auto it = m_byName.find(previous);
+		EntityHandle moved = eraseAt(it->second, m_namePositions[handle.index]);
+		if (!moved.isNull()) {
+			m_namePositions[moved.index] = m_namePositions[handle.index];
+		}
+		if (it->second.empty()) {
+			m_byName.erase(it);
+		}
+	}
+	m_names[handle.index] = name;
+	if (name != kNoName) {
+		std::vector<EntityHandle>& named = m_byName[name];
+		m_namePositions[handle.index] = static_cast<uint32_t>(named.size());
+		named.push_back(handle);
+	}
+	return true;
+}
+
+EntityHandle
+EntityRegistry::eraseAt(std::vector<EntityHandle>& list, uint32_t position) {
+	EntityHandle last = list.back();
+	list.pop_back();
+	if (position == list.size()) {
+		return EntityHandle{};
+	}
+	list[position] = last;
+	return last;
+}
+
+void
+EntityRegistry::indexTags(EntityHandle handle, EntityMask added, EntityMask removed) {
+	for (; removed; removed &= removed - 1) {
+		unsigned bit = static_cast<unsigned>(std::countr_zero(removed));
+		auto it = m_tagPositions.find(tagKey(handle.index, bit));
+		uint32_t position = it->second;
+		m_tagPositions.erase(it);
+		EntityHandle moved = eraseAt(m_byTag[bit], position);
+		if (!moved.isNull()) {
+			m_tagPositions[tagKey(moved.index, bit)] = position;
+		}
+	}
+	for (; added; added &= added - 1) {
+		unsigned bit = static_cast<unsigned>(std::countr_zero(added));
+		m_tagPositions[tagKey(handle.index, bit)] = static_cast<uint32_t>(m_byTag[bit].size());
+		m_byTag[bit].push_back(handle);
+	}
+}
@@ -0,0 +1,28 @@
+#include "Events/EventBus.h"
+#include <cassert>
+
+void
+EventBus::dispatch() {
+	// Copia del orden: un oyente puede usar un tipo nuevo y crear su canal
+	size_t count;
+	{
+		std::lock_guard<std::mutex> lock(m_createMutex);
+		count = m_order.size();
+	}
+	for (size_t i = 0; i < count; ++i) {
+		size_t index;
+		{
+			std::lock_guard<std::mutex> lock(m_createMutex);
+			index = m_order[i];
+		}
+		m_channels[index].load(std::memory_order_acquire)->dispatch();
+	}
+}
+
+size_t
+EventBus::nextTypeIndex() {
+	static std::atomic<size_t> s_next{ 0 };
+	size_t index = s_next.fetch_add(1, std::memory_order_relaxed);
+	assert(index < kMaxEventTypes && "Demasiados tipos de evento");
+	return index;
+}
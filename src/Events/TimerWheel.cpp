@@ -0,0 +1,184 @@
+#include "Events/TimerWheel.h"
+#include <cmath>
+
+TimerWheel::TimerWheel()
+	: m_nodes(kFirstTimer) {
+	for (uint32_t head = 0; head < kFirstTimer; ++head) {
+		m_nodes[head].next = head;
+		m_nodes[head].prev = head;
+	}
+}
+
+TimerHandle
+TimerWheel::after(uint32_t ticks, Callback callback) {
+	return schedule(ticks, 0, std::move(callback));
+}
+
+TimerHandle
+TimerWheel::every(uint32_t ticks, Callback callback) {
+	ticks = ticks == 0 ? 1 : ticks;
+	return schedule(ticks, ticks, std::move(callback));
+}
+
+bool
+TimerWheel::cancel(TimerHandle timer) {
+	if (!nodeOf(timer)) {
+		return false;
+	}
+	// El que corre ya no est en ninguna lista: `advance` ve el cambio de generacin y no lo repite
+	if (m_nodes[timer.index].state == State::Pending) {
+		unlink(timer.index);
+	}
+	release(timer.index);
+	return true;
+}
+
+bool
+TimerWheel::isPending(TimerHandle timer) const {
+	const Node* node = nodeOf(timer);
+	return node && (node->state == State::Pending || node->period != 0);
+}
+
+void
+TimerWheel::advance(uint32_t ticks) {
+	for (uint32_t step = 0; step < ticks; ++step) {
+		// Primero el paso al que se llega: lo que vence en l corre con `now` igual a su plazo
+		++m_now;
+
+		// Cuando la primera rueda da la vuelta baja la casilla siguiente de cada nivel que la dio
+		uint32_t slot = static_cast<uint32_t>(m_now & (kSlots - 1));
+		for (uint32_t level = 1; slot == 0 && level < kLevels; ++level) {
+			slot = cascade(level, static_cast<uint32_t>((m_now >> (level * kSlotBits)) & (kSlots - 1)));
+		}
+
+		// La casilla pasa entera a la lista que vence: lo que se programe desde las funciones,
+		// repeticiones incluidas, vence despus de `m_now` y cae en otra casilla, o en esta para
+		// la vuelta siguiente
+		uint32_t head = static_cast<uint32_t>(m_now & (kSlots - 1));
+		if (m_nodes[head].next != head) {
+			Node& expiring = m_nodes[kExpiring];
+			expiring.next = m_nodes[head].next;
+			expiring.prev = m_nodes[head].prev;
+			m_nodes[expiring.next].prev = kExpiring;
+			m_nodes[expiring.prev].next = kExpiring;
+			m_nodes[head].next = head;
+			m_nodes[head].prev = head;
+		}
+		while (m_nodes[kExpiring].next != kExpiring) {
+			uint32_t index = m_nodes[kExpiring].next;
+			unlink(index);
+			Node& node = m_nodes[index];
+			node.state = State::Running;
+			uint32_t generation = node.generation;
+			// La funcin sale del nodo: puede cancelarse, y los nodos pueden moverse al crecer
+			Callback callback = std::move(node.callback);
+			callback();
+			Node& after = m_nodes[index];
+			if (after.generation != generation) {
+				continue;
+			}
+			if (after.period == 0) {
+				release(index);
+				continue;
+			}
+			after.callback = std::move(callback);
+			after.deadline += after.period;
+			after.state = State::Pending;
+			place(index);
+		}
+	}
+}
+
+uint32_t
+TimerWheel::ticksFor(float seconds) const {
+	float ticks = std::round(seconds / m_tickSeconds);
+	return ticks < 1.0f ? 1u : ticks >= 4294967295.0f ? 0xFFFFFFFFu : static_cast<uint32_t>(ticks);
+}
+
+TimerHandle
+TimerWheel::schedule(uint32_t delay, uint32_t period, Callback callback) {
+	uint32_t index;
+	if (m_free != 0) {
+		index = m_free;
+		m_free = m_nodes[index].next;
+	}
+	else {
+		index = static_cast<uint32_t>(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+	Node& node = m_nodes[index];
+	node.period = period;
+	node.deadline = m_now + (delay == 0 ? 1 : delay);
+	node.state = State::Pending;
+	node.callback = std::move(callback);
+	place(index);
+	++m_count;
+	return { index, node.generation };
+}
+
+void
+TimerWheel::place(uint32_t index) {
+	uint64_t deadline = m_nodes[index].deadline;
+	uint64_t delta = deadline - m_now;
+	uint32_t level = 0;
+	while (level + 1 < kLevels && delta >= (uint64_t(1) << ((level + 1) * kSlotBits))) {
+		++level;
+	}
+	// Ms lejos de lo que abarcan las ruedas: la ltima casilla posible, y se vuelve a ubicar al bajar
+	if (delta >= (uint64_t(1) << (kLevels * kSlotBits))) {
+		deadline = m_now + (uint64_t(1) << (kLevels * kSlotBits)) - 1;
+	}
+	uint32_t slot = static_cast<uint32_t>((deadline >> (level * kSlotBits)) & (kSlots - 1));
+	link(level * kSlots + slot, index);
+}
+
+uint32_t
+TimerWheel::cascade(uint32_t level, uint32_t slot) {
+	uint32_t head = level * kSlots + slot;
+	while (m_nodes[head].next != head) {
+		uint32_t index = m_nodes[head].next;
+		unlink(index);
+		place(index);
+	}
+	return slot;
+}
+
+void
+TimerWheel::link(uint32_t head, uint32_t index) {
+	// Al final: los que vencen en el mismo paso corren en el orden en que llegaron
+	uint32_t last = m_nodes[head].prev;
+	m_nodes[index].prev = last;
+	m_nodes[index].next = head;
+	m_nodes[last].next = index;
+	m_nodes[head].prev = index;
+}
+
+void
+TimerWheel::unlink(uint32_t index) {
+	Node& node = m_nodes[index];
+	m_nodes[node.prev].next = node.next;
+	m_nodes[node.next].prev = node.prev;
+	node.next = index;
+	node.prev = index;
+}
+
+void
+TimerWheel::release(uint32_t index) {
+	Node& node = m_nodes[index];
+	node.state = State::Free;
+	node.callback = nullptr;
+	node.period = 0;
+	node.generation = node.generation + 1 == 0 ? 1 : node.generation + 1;
+	node.next = m_free;
+	m_free = index;
+	--m_count;
+}
+
+const TimerWheel::Node*
+TimerWheel::nodeOf(TimerHandle timer) const {
+	if (timer.index < kFirstTimer || timer.index >= m_nodes.size()) {
+		return nullptr;
+	}
+	const Node& node = m_nodes[timer.index];
+	return node.state != State::Free && node.generation == timer.generation ? &node : nullptr;
+}
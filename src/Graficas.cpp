@@ -27,9 +27,554 @@
  * SOFTWARE.
 */
 #include "BaseApp.h"
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include "Render/CompressedTexture.h"
+#include "Render/MeshOptimizer.h"
+#include "Scene/AssetCooker.h"
+#include "Simulation/SessionHost.h"
 
+namespace {
+
+	/**
+	 * @brief Lo que simula cada partida de `--rooms`: crculos que giran alrededor de un centro.
+	 */
+	struct RoomOrbit {
+		uint32_t netId = 0;
+		float centerX = 0.0f;
+		float centerY = 0.0f;
+		float radius = 0.0f;
+		float angle = 0.0f;
+		float speed = 0.0f;      ///< Radianes por segundo.
+	};
+
+	constexpr uint32_t kRoomActors = 64;
+
+	/**
+	 * @brief Lee una lista como `1000,10000` en `sizes`, que se vaca antes.
+	 */
+	void
+	parseSizes(const char* list, std::vector<size_t>& sizes) {
+		sizes.clear();
+		for (const char* cursor = list; *cursor; ) {
+			char* end = nullptr;
+			unsigned long long count = std::strtoull(cursor, &end, 10);
+			if (end == cursor) {
+				break;
+			}
+			sizes.push_back(static_cast<size_t>(count));
+			cursor = *end == ',' ? end + 1 : end;
+		}
+	}
+
+	/**
+	 * @brief Si `arg` es una opcin de lnea base (`--save-baseline`, `--baseline`, `--threshold`
+	 *        en por ciento o `--alpha`), la pone en `baseline`.
+	 */
+	bool
+	parseBaseline(const char* arg, BaselineOptions& baseline) {
+		if (std::strncmp(arg, "--save-baseline=", 16) == 0) {
+			baseline.save = arg + 16;
+		}
+		else if (std::strncmp(arg, "--baseline=", 11) == 0) {
+			baseline.compare = arg + 11;
+		}
+		else if (std::strncmp(arg, "--threshold=", 12) == 0) {
+			baseline.threshold = std::strtod(arg + 12, nullptr) / 100.0;
+		}
+		else if (std::strncmp(arg, "--alpha=", 8) == 0) {
+			baseline.alpha = std::strtod(arg + 8, nullptr);
+		}
+		else {
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Lee presupuestos como `ecs:64,render:32` (MiB por `MemoryCategory`) en `MemoryAccounting`.
+	 */
+	void
+	parseMemoryBudgets(const char* list) {
+		for (const char* cursor = list; *cursor; ) {
+			const char* colon = std::strchr(cursor, ':');
+			EngineUtilities::MemoryCategory category;
+			if (!colon || !EngineUtilities::MemoryAccounting::parse(cursor, static_cast<size_t>(colon - cursor), category)) {
+				MESSAGE("Graficas", "parseMemoryBudgets", "unknown memory category");
+				return;
+			}
+			char* end = nullptr;
+			double megabytes = std::strtod(colon + 1, &end);
+			EngineUtilities::MemoryAccounting::setBudget(category, static_cast<size_t>(megabytes * 1048576.0));
+			cursor = *end == ',' ? end + 1 : end;
+		}
+	}
+
+	void
+	setupRoom(HostedSession& session, uint32_t room) {
+		World& world = session.world();
+		for (uint32_t i = 0; i < kRoomActors; ++i) {
+			EntityId entity = world.createEntity();
+			float spread = static_cast<float>((i * 37 + room * 11) % 100) / 100.0f;
+			world.addComponent<RoomOrbit>(entity, RoomOrbit{ i + 1, 100.0f + (i % 8) * 80.0f, 100.0f + (i / 8) * 60.0f,
+				20.0f + 30.0f * spread, spread * 6.2831853f, 0.5f + spread + 0.1f * room });
+		}
+		session.systems().addSystem("RoomOrbit", ComponentAccess().writes<RoomOrbit>(), [](World& world, float deltaTime) {
+			world.each<RoomOrbit>([deltaTime](EntityId, RoomOrbit& orbit) {
+				orbit.angle = std::fmod(orbit.angle + orbit.speed * deltaTime, 6.2831853f);
+			});
+		});
+		session.setCapture([](World& world, std::vector<NetActorState>& states) {
+			world.each<RoomOrbit>([&states](EntityId, RoomOrbit& orbit) {
+				NetActorState& state = states.emplace_back();
+				state.id = orbit.netId;
+				state.x = static_cast<int32_t>(std::lround((orbit.centerX + orbit.radius * std::cos(orbit.angle)) * NetActorState::kPositionScale));
+				state.y = static_cast<int32_t>(std::lround((orbit.centerY + orbit.radius * std::sin(orbit.angle)) * NetActorState::kPositionScale));
+				state.scaleX = static_cast<int16_t>(NetActorState::kScaleScale);
+				state.scaleY = static_cast<int16_t>(NetActorState::kScaleScale);
+				state.shape = CIRCLE;
+				state.color = 0xFFFFFFFFu;
+			});
+			// La foto va por id
+			std::sort(states.begin(), states.end(), [](const NetActorState& a, const NetActorState& b) { return a.id < b.id; });
+		});
+	}
+
+} // namespace
+
+/**
+ * @brief Sin argumentos abre la escena normal:
+ *
+ *     Graficas [--render-thread] [--sim-hz=60] [--headless] [--frames=600] [--post]
+ *              [--dynamic-res=16.6] [--record=carpeta] [--crowd=5000]
+ *              [--lockstep] [--record-input=entrada.ginp] [--replay=entrada.ginp] [--replay-speed=4] [--input-hz=1000]
+ *              [--server] [--server-realtime] [--startup-trace=arranque.json] [--save=partida.gsav]
+ *              [--pack=recursos.gpak] [--cooked] [--host=7777] [--connect=servidor:7777] [--net-stats=red.csv]
+ *              [--profile-trace=traza.json:300] [--frame-times=5] [--log=motor.log]
+ *              [--memory-budget=ecs:64,render:32] [--console="r_culling 0; spawn 10000 circles"]
+ *              [--heap-stacks] [--capture-render=captura.grcs:60] [--hw-counters] [--hitch-trace=33:5]
+ *              [--fps-max=60] [--refresh=144] [--idle=10] [--redraw-on-change] [--event-thread]
+ *
+ * `--render-thread` la dibuja en un `RenderThread`; `--sim-hz` elige los pasos de simulacin
+ * por segundo (0 para paso variable). `--headless` dibuja en una textura sin vsync y
+ * `--frames` termina tras ese nmero de frames, con los frames por segundo en la salida. `--post` agrega
+ * bloom y correccin de color; `--dynamic-res` baja la resolucin de la escena para no pasar de
+ * esos milisegundos de GPU por frame. `--record` guarda cada frame como PNG en la carpeta. `--crowd` agrega
+ * esa cantidad de agentes que siguen al mouse por un `FlowField`. `--lockstep` simula de forma determinista
+ * (`BaseApp::setLockstep`); `--record-input` adems agrega al archivo la entrada de cada paso y lo escrito en
+ * la consola mientras se juega, y `--replay` lo repite: `--replay-speed` veces ms rpido en la ventana, o
+ * tan rpido como se pueda con `--server`.
+ * `--input-hz` lee teclado y mouse en un hilo aparte esas veces por segundo. `--server` solo simula, sin
+ * ventana ni OpenGL, tan rpido como puede; `--server-realtime` a un paso por paso de tiempo real.
+ * `--startup-trace` imprime cunto tard cada tarea del arranque y guarda su lnea de tiempo para
+ * `chrome://tracing`. `--profile-trace=traza.json[:frames]` guarda las zonas del profiler de los
+ * primeros frames (300 si no se dice) para `chrome://tracing` o Perfetto; F4 guarda otra traza as en
+ * cualquier momento. `--frame-times` imprime cada esos segundos los percentiles del frame, de update y de
+ * render y los tirones. `--log` tambin escribe los mensajes del motor en ese archivo, que rota a los
+ * 4 MiB (`Logger`). `--memory-budget` da los MiB de cada subsistema (`ecs`, `render`, `audio`, `assets`,
+ * `network`, `scripting`, `other`), en cualquier modo: el overlay marca el que pas el suyo, se avisa una
+ * vez y la tabla de `MemoryAccounting` sale al cerrar. `--console` corre esas rdenes de la consola
+ * (`Console`, la tecla de la tilde en la ventana; `help` las lista) al terminar el arranque. Compilado con
+ * `ENGINE_HEAP_HOOKS=1`, `--heap-stacks` guarda la pila de cada reserva del frame estable y al cerrar
+ * escribe las que ms reservaron (`HeapTracker`). `--capture-render=captura.grcs[:frames]` guarda los
+ * comandos de dibujo de los primeros frames (1 si no se dice) para `--replay-render`. `--hw-counters`
+ * agrega a cada zona del profiler sus ciclos, instrucciones y fallos de cach y de saltos (`HardwareCounters`).
+ * `--hitch-trace=ms[:segundos]` guarda siempre los ltimos segundos del profiler (5 si no se dice) y
+ * los escribe en `hitch_N.json` cuando un frame tarda ms de esos milisegundos (`HitchRecorder`).
+ * `--fps-max` pone un tope de frames por segundo a la ventana, que duerme y gira lo ltimo
+ * (`FramePacer`) y se alinea a un divisor del refresco de `--refresh` (o el de la pantalla, si el
+ * sistema lo da). `--idle[=hz]` la baja a esos frames
+ * por segundo (10 si no se dice; 0 duerme hasta el prximo evento) sin foco o tras dos segundos sin
+ * entrada ni cambios en los componentes. `--redraw-on-change` no dibuja los frames en que nada
+ * visible cambi (`BaseApp::needsRedraw`). `--save` guarda la partida por diferencias en ese archivo y la retoma al abrir.
+ * `--event-thread` atiende los mensajes de la ventana en un hilo propio (`EventPump`): arrastrarla o
+ * cambiarle el tamao no congela la simulacin ni la red.
+ * `--pack` monta un paquete (se puede repetir); los cargadores leen de l antes que del disco.
+ * `--cooked` solo carga lo cocido, sin leer ni convertir fuentes (`BaseApp::setCookedOnly`).
+ * `--host` manda los actores de la escena por UDP a los clientes que se conecten a ese puerto;
+ * `--connect` los muestra como los manda ese servidor, interpolados (`NetSession`). `--net-stats` escribe
+ * al cerrar los bytes, el ida y vuelta y la prdida de cada conexin en CSV (o JSON si termina en `.json`).
+ * Con `--scaling` corre `BaseApp::runScalingBenchmark`:
+ *
+ *     Graficas --scaling [--sizes=1000,10000,100000] [--frames=300] [--warmup=30] [--out=scaling.json] [--instanced]
+ *                        [--sdf] [--gpu-crowd] [--render-thread] [--headless] [--threads[=1,2,4]]
+ *
+ * `--gpu-crowd` cambia los actores por agentes de `GpuCrowd` que se mueven en un compute shader y
+ * se dibujan desde el mismo bfer: mide la GPU sola, sin simulacin ni subida por frame.
+ * `--threads` repite cada tamao con 1 hilo, 2, y as hasta todos (o con los de la lista) y agrega
+ * por update, movimiento, fsica y lista de dibujo la aceleracin, la eficiencia y la fraccin serial.
+ *
+ * Con `--bench` corre `BaseApp::runMicrobenchmarks`, sin ventana; `--filter` deja solo los casos cuyo
+ * nombre contiene ese texto y `--min-ms` es lo que dura cada muestra como mnimo:
+ *
+ *     Graficas --bench [--sizes=100,10000] [--samples=20] [--warmup=3] [--min-ms=5] [--filter=Entity]
+ *                      [--out=microbench.json]
+ *
+ * Con `--replay-render` dibuja en bucle una captura de `--capture-render` (`BaseApp::runRenderReplay`),
+ * sin escena ni simulacin, y mide el envo y la GPU de cada frame:
+ *
+ *     Graficas --replay-render captura.grcs [--loops=10] [--warmup=1] [--out=render_replay.json] [--headless]
+ *
+ * Los tres modos aceptan adems `--save-baseline=nombre`, que guarda lo medido en `baselines/nombre.json`,
+ * y `--baseline=nombre`, que lo compara con esa lnea base (`PerfBaseline`) y sale con 2 si algo empeor
+ * ms de `--threshold` por ciento (5 si no se dice) con p < `--alpha` (0.01). `--compare` hace lo mismo
+ * con dos archivos ya escritos:
+ *
+ *     Graficas --compare base.json actual.json [--threshold=5] [--alpha=0.01]
+ *
+ * Con `--optimize-mesh` convierte un `.obj` en un `.gmsh` optimizado (`MeshOptimizer`) y sale:
+ *
+ *     Graficas --optimize-mesh modelo.obj modelo.gmsh
+ *
+ * Con `--cook-texture` comprime una imagen en un `.dds` con mipmaps (`CompressedTexture`), en
+ * BC1 o BC3; sin formato elige BC3 solo si hay transparencia:
+ *
+ *     Graficas --cook-texture imagen.png imagen.dds [bc1|bc3]
+ *
+ * Con `--cook-scene` convierte una escena en texto (`SceneText`) en un `.gscn`:
+ *
+ *     Graficas --cook-scene main.scene main.gscn
+ *
+ * Con `--cook-pack` cocina los recursos de una lista (`AssetCooker`) en un `.gpak`; lo que no
+ * cambi, ni nada de lo que usa, sale de la carpeta cach (`.cook-cache` si no se dice), en
+ * todos los ncleos. La herramienta `ContentCook` de la solucin hace lo mismo sin el juego:
+ *
+ *     Graficas --cook-pack recursos.txt recursos.gpak [cach]
+ *
+ * Con `--rooms` sirve esa cantidad de partidas independientes en un solo proceso sin ventana
+ * (`SessionHost`), cada una en su puerto a partir del dado y con su propio mundo, durante esos
+ * segundos (0 para siempre). Un `--connect` a cualquiera de los puertos la ve:
+ *
+ *     Graficas --rooms 8 7777 [segundos]
+ */
 int 
-main() {
+main(int argc, char** argv) {
+	for (int i = 1; i < argc; ++i) {
+		if (std::strncmp(argv[i], "--memory-budget=", 16) == 0) {
+			parseMemoryBudgets(argv[i] + 16);
+		}
+	}
+	if (argc >= 4 && std::strcmp(argv[1], "--optimize-mesh") == 0) {
+		MeshOptimizer::Report report;
+		if (!MeshOptimizer::optimizeFile(argv[2], argv[3], &report)) {
+			std::cout << "no se pudo convertir " << argv[2] << "\n";
+			return 1;
+		}
+		std::cout << report.vertices << " vrtices, " << report.triangles << " tringulos; ACMR "
+		          << report.cacheMissRatioBefore << " -> " << report.cacheMissRatioAfter << "; "
+		          << report.bytesBefore << " -> " << report.bytesAfter << " bytes\n";
+		return 0;
+	}
+	if (argc >= 4 && std::strcmp(argv[1], "--compare") == 0) {
+		BaselineOptions options;
+		for (int i = 4; i < argc; ++i) {
+			parseBaseline(argv[i], options);
+		}
+		std::vector<PerfRecord> baseline;
+		std::vector<PerfRecord> current;
+		if (!PerfBaseline::read(argv[2], baseline) || !PerfBaseline::read(argv[3], current)) {
+			std::cout << "no se pudo leer " << argv[2] << " o " << argv[3] << "\n";
+			return 1;
+		}
+		return PerfBaseline::compare(baseline, current, options, std::cout) > 0 ? 2 : 0;
+	}
+	if (argc >= 4 && std::strcmp(argv[1], "--cook-texture") == 0) {
+		BlockFormat format = BlockFormat::Bc1;
+		bool explicitFormat = argc >= 5;
+		if (explicitFormat && std::strcmp(argv[4], "bc3") == 0) {
+			format = BlockFormat::Bc3;
+		}
+		else if (explicitFormat && std::strcmp(argv[4], "bc1") != 0) {
+			std::cout << "formato desconocido " << argv[4] << ", se usa bc1 o bc3\n";
+			return 1;
+		}
+		if (!CompressedTexture::cookFile(argv[2], argv[3], explicitFormat ? &format : nullptr)) {
+			std::cout << "no se pudo cocinar " << argv[2] << "\n";
+			return 1;
+		}
+		return 0;
+	}
+	if (argc >= 4 && std::strcmp(argv[1], "--cook-scene") == 0) {
+		std::string error;
+		if (!SceneText::cookFile(argv[2], argv[3], &error)) {
+			std::cout << "no se pudo cocinar " << argv[2] << ": " << error << "\n";
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc >= 4 && std::strcmp(argv[1], "--cook-pack") == 0) {
+		AssetCooker cooker;
+		AssetCooker::Report report;
+		std::string error;
+		if (!cooker.parseFile(argv[2], &error) || !cooker.cook(argv[3], argc >= 5 ? argv[4] : ".cook-cache", &report, &error,
+			&EngineUtilities::TService<JobSystem>::instance())) {
+			std::cout << "no se pudo cocinar " << argv[2] << ": " << error << "\n";
+			return 1;
+		}
+		std::cout << report.assets << " recursos: " << report.cooked << " cocinados, " << report.reused << " de la cach, "
+		          << report.copied << " tal cual; " << report.uniqueBlobs << " contenidos distintos, "
+		          << report.sharedBytes << " bytes repetidos sin guardar\n";
+		return 0;
+	}
+
+	if (argc >= 4 && std::strcmp(argv[1], "--rooms") == 0) {
+		uint32_t rooms = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+		unsigned short port = static_cast<unsigned short>(std::strtoul(argv[3], nullptr, 10));
+		double seconds = argc >= 5 ? std::strtod(argv[4], nullptr) : 0.0;
+		SessionHost host(EngineUtilities::TService<JobSystem>::instance());
+		for (uint32_t room = 0; room < rooms; ++room) {
+			if (HostedSession* session = host.open(static_cast<unsigned short>(port + room))) {
+				setupRoom(*session, room);
+			}
+		}
+		std::cout << host.sessionCount() << " partidas desde el puerto " << port << "\n";
+		auto start = std::chrono::steady_clock::now();
+		while (seconds <= 0.0 || std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < seconds) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(host.tick()));
+		}
+		host.closeAll();
+		EngineUtilities::ServiceLocator::shutdownAll();
+		return 0;
+	}
+
 	BaseApp app;
-	return app.run();
+	if (argc >= 3 && std::strcmp(argv[1], "--replay-render") == 0) {
+		RenderReplayOptions options;
+		options.capturePath = argv[2];
+		for (int i = 3; i < argc; ++i) {
+			if (std::strncmp(argv[i], "--loops=", 8) == 0) {
+				options.measuredLoops = static_cast<uint32_t>(std::strtoul(argv[i] + 8, nullptr, 10));
+			}
+			else if (std::strncmp(argv[i], "--warmup=", 9) == 0) {
+				options.warmupLoops = static_cast<uint32_t>(std::strtoul(argv[i] + 9, nullptr, 10));
+			}
+			else if (std::strncmp(argv[i], "--out=", 6) == 0) {
+				options.outputPath = argv[i] + 6;
+			}
+			else if (std::strcmp(argv[i], "--headless") == 0) {
+				options.headless = true;
+			}
+			else {
+				parseBaseline(argv[i], options.baseline);
+			}
+		}
+		return app.runRenderReplay(options);
+	}
+	if (argc >= 2 && std::strcmp(argv[1], "--bench") == 0) {
+		MicrobenchmarkOptions options;
+		for (int i = 2; i < argc; ++i) {
+			if (std::strncmp(argv[i], "--sizes=", 8) == 0) {
+				parseSizes(argv[i] + 8, options.sizes);
+			}
+			else if (std::strncmp(argv[i], "--samples=", 10) == 0) {
+				options.samples = static_cast<uint32_t>(std::strtoul(argv[i] + 10, nullptr, 10));
+			}
+			else if (std::strncmp(argv[i], "--warmup=", 9) == 0) {
+				options.warmupSamples = static_cast<uint32_t>(std::strtoul(argv[i] + 9, nullptr, 10));
+			}
+			else if (std::strncmp(argv[i], "--min-ms=", 9) == 0) {
+				options.minSampleMs = std::strtod(argv[i] + 9, nullptr);
+			}
+			else if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+				options.filter = argv[i] + 9;
+			}
+			else if (std::strncmp(argv[i], "--out=", 6) == 0) {
+				options.outputPath = argv[i] + 6;
+			}
+			else {
+				parseBaseline(argv[i], options.baseline);
+			}
+		}
+		return app.runMicrobenchmarks(options);
+	}
+	if (argc < 2 || std::strcmp(argv[1], "--scaling") != 0) {
+		for (int i = 1; i < argc; ++i) {
+			if (std::strcmp(argv[i], "--render-thread") == 0) {
+				app.setRenderThread(true);
+			}
+			else if (std::strncmp(argv[i], "--sim-hz=", 9) == 0) {
+				app.setSimulationRate(std::strtof(argv[i] + 9, nullptr));
+			}
+			else if (std::strcmp(argv[i], "--headless") == 0) {
+				app.setHeadless(true);
+			}
+			else if (std::strcmp(argv[i], "--event-thread") == 0) {
+				app.setEventThread(true);
+			}
+			else if (std::strncmp(argv[i], "--frames=", 9) == 0) {
+				app.setFrameLimit(static_cast<uint32_t>(std::strtoul(argv[i] + 9, nullptr, 10)));
+			}
+			else if (std::strcmp(argv[i], "--post") == 0) {
+				app.setPostProcessing(true);
+			}
+			else if (std::strncmp(argv[i], "--dynamic-res=", 14) == 0) {
+				app.setDynamicResolution(std::strtod(argv[i] + 14, nullptr));
+			}
+			else if (std::strncmp(argv[i], "--record=", 9) == 0) {
+				app.setRecordDirectory(argv[i] + 9);
+			}
+			else if (std::strncmp(argv[i], "--console=", 10) == 0) {
+				app.addConsoleCommands(argv[i] + 10);
+			}
+			else if (std::strncmp(argv[i], "--capture-render=", 17) == 0) {
+				// archivo[:frames]
+				std::string path = argv[i] + 17;
+				uint32_t frames = 1;
+				size_t colon = path.rfind(':');
+				if (colon != std::string::npos && colon + 1 < path.size() && std::isdigit(static_cast<unsigned char>(path[colon + 1]))) {
+					frames = static_cast<uint32_t>(std::strtoul(path.c_str() + colon + 1, nullptr, 10));
+					path.resize(colon);
+				}
+				app.setRenderCapture(path, frames);
+			}
+			else if (std::strcmp(argv[i], "--hw-counters") == 0) {
+				if (!HardwareCounters::setEnabled(true)) {
+					MESSAGE("Graficas", "main", "hardware counters are not available on this platform or with these permissions");
+				}
+			}
+			else if (std::strcmp(argv[i], "--heap-stacks") == 0) {
+				if (!EngineUtilities::kHeapHooks || !EngineUtilities::HeapTracker::setStackCapture(true)) {
+					MESSAGE("Graficas", "main", "heap stacks need ENGINE_HEAP_HOOKS=1 and a platform that can walk the stack");
+				}
+			}
+			else if (std::strncmp(argv[i], "--crowd=", 8) == 0) {
+				app.setCrowdSize(static_cast<uint32_t>(std::strtoul(argv[i] + 8, nullptr, 10)));
+			}
+			else if (std::strcmp(argv[i], "--lockstep") == 0) {
+				app.setLockstep(true);
+			}
+			else if (std::strncmp(argv[i], "--record-input=", 15) == 0) {
+				app.setInputRecording(argv[i] + 15);
+			}
+			else if (std::strncmp(argv[i], "--replay=", 9) == 0) {
+				app.setInputReplay(argv[i] + 9);
+			}
+			else if (std::strncmp(argv[i], "--replay-speed=", 15) == 0) {
+				app.setReplaySpeed(std::strtof(argv[i] + 15, nullptr));
+			}
+			else if (std::strcmp(argv[i], "--server") == 0) {
+				app.setServer(true);
+			}
+			else if (std::strcmp(argv[i], "--server-realtime") == 0) {
+				app.setServer(true, true);
+			}
+			else if (std::strncmp(argv[i], "--input-hz=", 11) == 0) {
+				app.setInputSampleRate(std::strtof(argv[i] + 11, nullptr));
+			}
+			else if (std::strncmp(argv[i], "--startup-trace=", 16) == 0) {
+				app.setStartupTrace(argv[i] + 16);
+			}
+			else if (std::strncmp(argv[i], "--log=", 6) == 0) {
+				if (!Logger::instance().setFile(argv[i] + 6)) {
+					MESSAGE("Graficas", "main", "could not open the log file");
+				}
+			}
+			else if (std::strncmp(argv[i], "--frame-times=", 14) == 0) {
+				app.setFrameTimeLog(std::strtod(argv[i] + 14, nullptr));
+			}
+			else if (std::strncmp(argv[i], "--profile-trace=", 16) == 0) {
+				// archivo[:frames]
+				std::string path = argv[i] + 16;
+				uint32_t frames = TraceCapture::kDefaultFrames;
+				size_t colon = path.rfind(':');
+				if (colon != std::string::npos && colon + 1 < path.size() && std::isdigit(static_cast<unsigned char>(path[colon + 1]))) {
+					frames = static_cast<uint32_t>(std::strtoul(path.c_str() + colon + 1, nullptr, 10));
+					path.resize(colon);
+				}
+				app.setProfileTrace(path, frames);
+			}
+			else if (std::strncmp(argv[i], "--fps-max=", 10) == 0) {
+				app.setFrameCap(std::strtof(argv[i] + 10, nullptr));
+			}
+			else if (std::strncmp(argv[i], "--refresh=", 10) == 0) {
+				app.setDisplayRefresh(std::strtod(argv[i] + 10, nullptr));
+			}
+			else if (std::strcmp(argv[i], "--redraw-on-change") == 0) {
+				app.setRedrawOnChange(true);
+			}
+			else if (std::strcmp(argv[i], "--idle") == 0) {
+				app.setIdleMode(true);
+			}
+			else if (std::strncmp(argv[i], "--idle=", 7) == 0) {
+				app.setIdleMode(true, std::strtof(argv[i] + 7, nullptr));
+			}
+			else if (std::strncmp(argv[i], "--hitch-trace=", 14) == 0) {
+				// ms[:segundos]
+				char* end = nullptr;
+				double ms = std::strtod(argv[i] + 14, &end);
+				double seconds = *end == ':' ? std::strtod(end + 1, nullptr) : HitchRecorder::kDefaultSeconds;
+				app.setHitchTrace(ms, seconds);
+			}
+			else if (std::strncmp(argv[i], "--save=", 7) == 0) {
+				app.setSaveJournal(argv[i] + 7);
+			}
+			else if (std::strncmp(argv[i], "--pack=", 7) == 0) {
+				app.addPack(argv[i] + 7);
+			}
+			else if (std::strcmp(argv[i], "--cooked") == 0) {
+				app.setCookedOnly(true);
+			}
+			else if (std::strncmp(argv[i], "--host=", 7) == 0) {
+				app.setNetHost(static_cast<unsigned short>(std::strtoul(argv[i] + 7, nullptr, 10)));
+			}
+			else if (std::strncmp(argv[i], "--net-stats=", 12) == 0) {
+				app.setNetStatsPath(argv[i] + 12);
+			}
+			else if (std::strncmp(argv[i], "--connect=", 10) == 0) {
+				// servidor:puerto
+				const char* address = argv[i] + 10;
+				const char* colon = std::strrchr(address, ':');
+				if (colon && colon > address) {
+					app.setNetConnect(std::string(address, colon), static_cast<unsigned short>(std::strtoul(colon + 1, nullptr, 10)));
+				}
+			}
+		}
+		return app.run();
+	}
+
+	ScalingBenchmarkOptions options;
+	for (int i = 2; i < argc; ++i) {
+		if (std::strncmp(argv[i], "--sizes=", 8) == 0) {
+			parseSizes(argv[i] + 8, options.actorCounts);
+		}
+		else if (std::strncmp(argv[i], "--frames=", 9) == 0) {
+			options.measuredFrames = static_cast<uint32_t>(std::strtoul(argv[i] + 9, nullptr, 10));
+		}
+		else if (std::strncmp(argv[i], "--warmup=", 9) == 0) {
+			options.warmupFrames = static_cast<uint32_t>(std::strtoul(argv[i] + 9, nullptr, 10));
+		}
+		else if (std::strncmp(argv[i], "--out=", 6) == 0) {
+			options.outputPath = argv[i] + 6;
+		}
+		else if (std::strcmp(argv[i], "--instanced") == 0) {
+			options.instancedRendering = true;
+		}
+		else if (std::strcmp(argv[i], "--sdf") == 0) {
+			options.sdfShapes = true;
+		}
+		else if (std::strcmp(argv[i], "--gpu-crowd") == 0) {
+			options.gpuCrowd = true;
+		}
+		else if (std::strcmp(argv[i], "--render-thread") == 0) {
+			options.renderThread = true;
+		}
+		else if (std::strcmp(argv[i], "--headless") == 0) {
+			options.headless = true;
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0) {
+			options.threadCounts = { 0 };
+		}
+		else if (std::strncmp(argv[i], "--threads=", 10) == 0) {
+			std::vector<size_t> threads;
+			parseSizes(argv[i] + 10, threads);
+			options.threadCounts.assign(threads.begin(), threads.end());
+		}
+		else {
+			parseBaseline(argv[i], options.baseline);
+		}
+	}
+	return app.runScalingBenchmark(options);
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "Input/EventPump.h"
+#include "Profiling/Profiler.h"
+
+sf::RenderWindow*
+EventPump::start(CreateFunction create) {
+	if (isRunning()) {
+		return m_window.load(std::memory_order_acquire);
+	}
+	m_stop.store(false, std::memory_order_relaxed);
+	m_created.store(false, std::memory_order_relaxed);
+	m_window.store(nullptr, std::memory_order_relaxed);
+	m_thread = std::thread([this, create = std::move(create)]() { loop(create); });
+	m_created.wait(false, std::memory_order_acquire);
+	sf::RenderWindow* window = m_window.load(std::memory_order_acquire);
+	if (!window) {
+		m_thread.join();
+	}
+	return window;
+}
+
+void
+EventPump::stop() {
+	if (!isRunning()) {
+		return;
+	}
+	m_stop.store(true, std::memory_order_relaxed);
+	m_thread.join();
+	m_window.store(nullptr, std::memory_order_relaxed);
+	// Lo que no se ley era de la ventana que ya no existe
+	sf::Event event;
+	while (m_events.tryPop(event)) {
+	}
+}
+
+void
+EventPump::loop(CreateFunction create) {
+	Profiler::instance().setThreadName("Events");
+	sf::RenderWindow* window = create();
+	if (window) {
+		// El contexto naci activo aqu; lo toma quien dibuja
+		window->setActive(false);
+	}
+	m_window.store(window, std::memory_order_release);
+	m_created.store(true, std::memory_order_release);
+	m_created.notify_one();
+	if (!window) {
+		return;
+	}
+
+	while (!m_stop.load(std::memory_order_relaxed)) {
+		// Primero lo que esperaba lugar, para no desordenar los eventos
+		size_t flushed = 0;
+		while (flushed < m_overflow.size() && m_events.tryPush(sf::Event(m_overflow[flushed]))) {
+			++flushed;
+		}
+		m_overflow.erase(m_overflow.begin(), m_overflow.begin() + static_cast<std::ptrdiff_t>(flushed));
+
+		sf::Event event;
+		while (window->pollEvent(event)) {
+			if (!m_overflow.empty() || !m_events.tryPush(sf::Event(event))) {
+				m_overflow.push_back(event);
+			}
+		}
+		std::this_thread::sleep_for(kPollSlice);
+	}
+	delete window;
+}
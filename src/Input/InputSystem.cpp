@@ -0,0 +1,362 @@
+#include "Input/InputSystem.h"
+#include <algorithm>
+
+InputSystem::InputSystem()
+	: m_epoch(std::chrono::steady_clock::now()) {
+}
+
+InputSystem::~InputSystem() {
+	stopSampling();
+}
+
+void
+InputSystem::attach(const sf::Window& window) {
+	stopSampling();
+	m_window = &window;
+	m_mousePosition = sf::Mouse::getPosition(window);
+}
+
+void
+InputSystem::detach() {
+	stopSampling();
+	m_window = nullptr;
+}
+
+void
+InputSystem::beginFrame() {
+	m_events.clear();
+	m_wheelDelta = 0.0f;
+	for (uint8_t& key : m_keys) {
+		key &= kDown;
+	}
+	for (uint8_t& button : m_mouseButtons) {
+		button &= kDown;
+	}
+	for (auto& joystick : m_joystickButtons) {
+		for (uint8_t& button : joystick) {
+			button &= kDown;
+		}
+	}
+}
+
+void
+InputSystem::handle(const sf::Event& event) {
+	// Con el muestreo, teclas, botones y mouse ya llegan de su hilo
+	bool sampled = isSampling();
+	InputEvent input;
+	input.timeUs = now();
+	switch (event.type) {
+	case sf::Event::KeyPressed:
+	case sf::Event::KeyReleased:
+		if (sampled || event.key.code == sf::Keyboard::Unknown) {
+			return;
+		}
+		input.type = event.type == sf::Event::KeyPressed ? InputEventType::KeyDown : InputEventType::KeyUp;
+		input.code = static_cast<uint32_t>(event.key.code);
+		break;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+		if (sampled) {
+			return;
+		}
+		input.type = event.type == sf::Event::MouseButtonPressed ? InputEventType::MouseDown : InputEventType::MouseUp;
+		input.code = static_cast<uint32_t>(event.mouseButton.button);
+		input.x = static_cast<float>(event.mouseButton.x);
+		input.y = static_cast<float>(event.mouseButton.y);
+		break;
+	case sf::Event::MouseMoved:
+		if (sampled) {
+			return;
+		}
+		input.type = InputEventType::MouseMove;
+		input.x = static_cast<float>(event.mouseMove.x);
+		input.y = static_cast<float>(event.mouseMove.y);
+		break;
+	case sf::Event::MouseWheelScrolled:
+		if (event.mouseWheelScroll.wheel != sf::Mouse::VerticalWheel) {
+			return;
+		}
+		input.type = InputEventType::MouseWheel;
+		input.x = event.mouseWheelScroll.delta;
+		break;
+	case sf::Event::TextEntered:
+		input.type = InputEventType::Text;
+		input.code = event.text.unicode;
+		break;
+	case sf::Event::JoystickButtonPressed:
+	case sf::Event::JoystickButtonReleased:
+		input.type = event.type == sf::Event::JoystickButtonPressed ? InputEventType::JoystickDown : InputEventType::JoystickUp;
+		input.joystick = static_cast<uint8_t>(event.joystickButton.joystickId);
+		input.code = event.joystickButton.button;
+		break;
+	case sf::Event::JoystickMoved:
+		input.type = InputEventType::JoystickAxis;
+		input.joystick = static_cast<uint8_t>(event.joystickMove.joystickId);
+		input.code = static_cast<uint32_t>(event.joystickMove.axis);
+		input.x = event.joystickMove.position;
+		break;
+	case sf::Event::JoystickConnected:
+		if (event.joystickConnect.joystickId < sf::Joystick::Count) {
+			m_joystickConnected[event.joystickConnect.joystickId] = true;
+		}
+		return;
+	case sf::Event::JoystickDisconnected:
+		if (event.joystickConnect.joystickId < sf::Joystick::Count) {
+			uint32_t joystick = event.joystickConnect.joystickId;
+			m_joystickConnected[joystick] = false;
+			std::fill(std::begin(m_joystickAxes[joystick]), std::end(m_joystickAxes[joystick]), 0.0f);
+			for (uint8_t& button : m_joystickButtons[joystick]) {
+				press(button, false);
+			}
+		}
+		return;
+	case sf::Event::LostFocus:
+		// Lo que se suelte sin foco no llega: mejor soltarlo ya que dejarlo trabado
+		releaseAll();
+		return;
+	default:
+		return;
+	}
+	apply(input);
+}
+
+void
+InputSystem::endFrame() {
+	InputEvent sample;
+	while (m_samples.tryPop(sample)) {
+		apply(sample);
+	}
+	updateActions();
+}
+
+void
+InputSystem::startSampling(float rate) {
+	if (isSampling() || m_window == nullptr || rate <= 0.0f) {
+		return;
+	}
+	// Las teclas que ya estn abajo no cuentan como presionadas al empezar
+	for (uint32_t key = 0; key < sf::Keyboard::KeyCount; ++key) {
+		m_sampledKeys[key] = (m_keys[key] & kDown) != 0;
+	}
+	for (uint32_t button = 0; button < sf::Mouse::ButtonCount; ++button) {
+		m_sampledButtons[button] = (m_mouseButtons[button] & kDown) != 0;
+	}
+	m_sampledMouse = m_mousePosition;
+	m_stopSampling.store(false, std::memory_order_relaxed);
+	m_sampler = std::thread([this, rate]() { sampleLoop(rate); });
+}
+
+void
+InputSystem::stopSampling() {
+	if (!isSampling()) {
+		return;
+	}
+	m_stopSampling.store(true, std::memory_order_relaxed);
+	m_sampler.join();
+	// Lo que qued en la cola ya est en el estado del hilo: se aplica en el prximo `endFrame`
+}
+
+bool
+InputSystem::isJoystickDown(uint32_t joystick, uint32_t button) const {
+	return joystick < sf::Joystick::Count && button < sf::Joystick::ButtonCount &&
+	       (m_joystickButtons[joystick][button] & kDown) != 0;
+}
+
+float
+InputSystem::joystickAxis(uint32_t joystick, sf::Joystick::Axis axis) const {
+	return joystick < sf::Joystick::Count ? m_joystickAxes[joystick][axis] : 0.0f;
+}
+
+InputSystem::ActionId
+InputSystem::addAction(const std::string& name) {
+	ActionId existing = findAction(name);
+	if (existing != kNoAction) {
+		return existing;
+	}
+	Action action;
+	action.name = name;
+	m_actions.push_back(std::move(action));
+	return static_cast<ActionId>(m_actions.size() - 1);
+}
+
+InputSystem::ActionId
+InputSystem::findAction(const std::string& name) const {
+	for (size_t i = 0; i < m_actions.size(); ++i) {
+		if (m_actions[i].name == name) {
+			return static_cast<ActionId>(i);
+		}
+	}
+	return kNoAction;
+}
+
+void
+InputSystem::bind(ActionId action, const InputBinding& binding) {
+	if (action >= m_actions.size()) {
+		MESSAGE("InputSystem", "bind", "unknown action");
+		return;
+	}
+	m_actions[action].bindings.push_back(binding);
+}
+
+uint64_t
+InputSystem::now() const {
+	return static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_epoch).count());
+}
+
+void
+InputSystem::apply(const InputEvent& event) {
+	switch (event.type) {
+	case InputEventType::KeyDown:
+	case InputEventType::KeyUp:
+		if (event.code >= sf::Keyboard::KeyCount) {
+			return;
+		}
+		press(m_keys[event.code], event.type == InputEventType::KeyDown);
+		break;
+	case InputEventType::MouseDown:
+	case InputEventType::MouseUp:
+		if (event.code >= sf::Mouse::ButtonCount) {
+			return;
+		}
+		press(m_mouseButtons[event.code], event.type == InputEventType::MouseDown);
+		break;
+	case InputEventType::MouseMove:
+		m_mousePosition = sf::Vector2i(static_cast<int>(event.x), static_cast<int>(event.y));
+		break;
+	case InputEventType::MouseWheel:
+		m_wheelDelta += event.x;
+		break;
+	case InputEventType::JoystickDown:
+	case InputEventType::JoystickUp:
+		if (event.joystick >= sf::Joystick::Count || event.code >= sf::Joystick::ButtonCount) {
+			return;
+		}
+		m_joystickConnected[event.joystick] = true;
+		press(m_joystickButtons[event.joystick][event.code], event.type == InputEventType::JoystickDown);
+		break;
+	case InputEventType::JoystickAxis:
+		if (event.joystick >= sf::Joystick::Count || event.code >= sf::Joystick::AxisCount) {
+			return;
+		}
+		m_joystickConnected[event.joystick] = true;
+		m_joystickAxes[event.joystick][event.code] = event.x;
+		break;
+	case InputEventType::Text:
+		break;
+	}
+	m_events.push_back(event);
+}
+
+void
+InputSystem::press(uint8_t& state, bool down) {
+	if (down && !(state & kDown)) {
+		state |= kDown | kPressed;
+	}
+	else if (!down && (state & kDown)) {
+		state = static_cast<uint8_t>((state & ~kDown) | kReleased);
+	}
+}
+
+void
+InputSystem::releaseAll() {
+	for (uint32_t key = 0; key < sf::Keyboard::KeyCount; ++key) {
+		if (m_keys[key] & kDown) {
+			apply({ now(), InputEventType::KeyUp, 0, key });
+		}
+	}
+	for (uint32_t button = 0; button < sf::Mouse::ButtonCount; ++button) {
+		if (m_mouseButtons[button] & kDown) {
+			apply({ now(), InputEventType::MouseUp, 0, button, static_cast<float>(m_mousePosition.x),
+			        static_cast<float>(m_mousePosition.y) });
+		}
+	}
+}
+
+void
+InputSystem::updateActions() {
+	for (Action& action : m_actions) {
+		bool wasDown = action.down;
+		bool tapped = false;
+		float value = 0.0f;
+		for (const InputBinding& binding : action.bindings) {
+			uint8_t state = 0;
+			switch (binding.source) {
+			case InputBinding::Source::Key:
+				state = binding.code < sf::Keyboard::KeyCount ? m_keys[binding.code] : 0;
+				break;
+			case InputBinding::Source::MouseButton:
+				state = binding.code < sf::Mouse::ButtonCount ? m_mouseButtons[binding.code] : 0;
+				break;
+			case InputBinding::Source::JoystickButton:
+				state = binding.joystick < sf::Joystick::Count && binding.code < sf::Joystick::ButtonCount
+				      ? m_joystickButtons[binding.joystick][binding.code] : 0;
+				break;
+			case InputBinding::Source::JoystickAxis: {
+				if (binding.joystick >= sf::Joystick::Count || binding.code >= sf::Joystick::AxisCount) {
+					break;
+				}
+				// Lo que pasa del umbral, de 0 a 1 al llegar al tope del eje
+				float position = m_joystickAxes[binding.joystick][binding.code];
+				float threshold = std::abs(binding.threshold);
+				float along = binding.threshold < 0.0f ? -position : position;
+				if (along > threshold) {
+					value = std::max(value, threshold < 100.0f ? (along - threshold) / (100.0f - threshold) : 1.0f);
+				}
+				continue;
+			}
+			}
+			if (state & kDown) {
+				value = 1.0f;
+			}
+			tapped = tapped || (state & kPressed) != 0;
+		}
+		action.value = std::min(value, 1.0f);
+		action.down = value > 0.0f;
+		action.pressed = (action.down && !wasDown) || tapped;
+		action.released = (!action.down && wasDown) || (tapped && !action.down);
+	}
+}
+
+void
+InputSystem::sampleLoop(float rate) {
+	bool* keys = m_sampledKeys;
+	bool* buttons = m_sampledButtons;
+	sf::Vector2i& mouse = m_sampledMouse;
+	auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+	auto next = std::chrono::steady_clock::now();
+	while (!m_stopSampling.load(std::memory_order_relaxed)) {
+		// Sin foco no se lee: el teclado es de todo el sistema, no de la ventana
+		if (m_window->hasFocus()) {
+			uint64_t time = now();
+			for (uint32_t key = 0; key < sf::Keyboard::KeyCount; ++key) {
+				bool down = sf::Keyboard::isKeyPressed(static_cast<sf::Keyboard::Key>(key));
+				if (down != keys[key]) {
+					keys[key] = down;
+					m_samples.tryPush({ time, down ? InputEventType::KeyDown : InputEventType::KeyUp, 0, key });
+				}
+			}
+			sf::Vector2i position = sf::Mouse::getPosition(*m_window);
+			if (position != mouse) {
+				mouse = position;
+				m_samples.tryPush({ time, InputEventType::MouseMove, 0, 0, static_cast<float>(position.x),
+				                    static_cast<float>(position.y) });
+			}
+			for (uint32_t button = 0; button < sf::Mouse::ButtonCount; ++button) {
+				bool down = sf::Mouse::isButtonPressed(static_cast<sf::Mouse::Button>(button));
+				if (down != buttons[button]) {
+					buttons[button] = down;
+					m_samples.tryPush({ time, down ? InputEventType::MouseDown : InputEventType::MouseUp, 0, button,
+					                    static_cast<float>(position.x), static_cast<float>(position.y) });
+				}
+			}
+		}
+		else {
+			std::fill(keys, keys + sf::Keyboard::KeyCount, false);
+			std::fill(buttons, buttons + sf::Mouse::ButtonCount, false);
+		}
+		// Tras una pausa larga no se pone al da de golpe
+		next = std::max(next + interval, std::chrono::steady_clock::now());
+		std::this_thread::sleep_until(next);
+	}
+}
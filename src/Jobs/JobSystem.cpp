@@ -0,0 +1,312 @@
+#include "Jobs/JobSystem.h"
+#include <string>
+#include "Profiling/Profiler.h"
+
+namespace {
+	/**
+	 * @brief Sistema y cola propia del hilo actual.
+	 */
+	struct ThreadIdentity {
+		const JobSystem* system = nullptr;
+		void* worker = nullptr;
+	};
+
+	thread_local ThreadIdentity t_identity;
+
+	constexpr int kSpinsBeforeSleep = 64; ///< Intentos de encontrar trabajo antes de dormir.
+}
+
+JobWorkerStats
+JobTelemetry::total() const {
+	JobWorkerStats sum;
+	for (const JobWorkerStats& worker : workers) {
+		sum.jobs += worker.jobs;
+		sum.stealAttempts += worker.stealAttempts;
+		sum.steals += worker.steals;
+		sum.busyMs += worker.busyMs;
+		sum.waitMs += worker.waitMs;
+		sum.queued += worker.queued;
+	}
+	sum.queued += externalQueued;
+	return sum;
+}
+
+double
+JobTelemetry::utilization() const {
+	if (workers.empty() || ms <= 0.0) {
+		return 0.0;
+	}
+	return std::min(1.0, total().busyMs / (ms * static_cast<double>(workers.size())));
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+	// Primero todas las colas: los hilos roban de cualquiera desde que arrancan
+	m_workers.reserve(workerCount + 1);
+	for (unsigned i = 0; i <= workerCount; ++i) {
+		m_workers.push_back(EngineUtilities::MakeUnique<Worker>());
+		m_workers.back()->random = 0x9E3779B9u * (i + 1);
+	}
+	t_identity = { this, m_workers[0].get() };
+	m_active.store(workerCount);
+	for (unsigned i = 1; i <= workerCount; ++i) {
+		m_workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+	}
+}
+
+JobSystem::~JobSystem() {
+	while (runPendingJob()) {
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stopping.store(true);
+	}
+	m_wake.notify_all();
+	m_resume.notify_all();
+	for (size_t i = 1; i < m_workers.size(); ++i) {
+		m_workers[i]->thread.join();
+	}
+	// Lo que se haya lanzado mientras los hilos salan
+	while (runPendingJob()) {
+	}
+	if (t_identity.system == this) {
+		t_identity = {};
+	}
+}
+
+void
+JobSystem::wait(const JobCounter& counter) {
+	if (counter.isDone()) {
+		return;
+	}
+	PROFILE_SCOPE("JobSystem::wait");
+	Worker* self = currentWorker();
+	bool timed = self && Profiler::instance().isEnabled();
+	while (!counter.isDone()) {
+		if (runPendingJob()) {
+			continue;
+		}
+		// Solo lo que pasa sin nada que ejecutar es espera
+		int64_t start = timed ? Profiler::now() : 0;
+		std::this_thread::yield();
+		if (timed) {
+			Counters::add(self->counters.waitNs, Profiler::now() - start);
+		}
+	}
+}
+
+bool
+JobSystem::runPendingJob() {
+	Worker* self = currentWorker();
+	Job* job = findJob(self);
+	if (!job) {
+		return false;
+	}
+	execute(job, self);
+	return true;
+}
+
+void
+JobSystem::collectTelemetry(JobTelemetry& out) {
+	int64_t now = Profiler::now();
+	out.ms = m_lastTelemetry ? (now - m_lastTelemetry) / 1.0e6 : 0.0;
+	m_lastTelemetry = now;
+	out.externalQueued = static_cast<uint32_t>(m_externalCount.load(std::memory_order_relaxed));
+	out.workers.resize(m_workers.size());
+	for (size_t i = 0; i < m_workers.size(); ++i) {
+		Worker& worker = *m_workers[i];
+		Reported current{ worker.counters.jobs.load(std::memory_order_relaxed),
+		                  worker.counters.stealAttempts.load(std::memory_order_relaxed),
+		                  worker.counters.steals.load(std::memory_order_relaxed),
+		                  worker.counters.busyNs.load(std::memory_order_relaxed),
+		                  worker.counters.waitNs.load(std::memory_order_relaxed) };
+		JobWorkerStats& stats = out.workers[i];
+		stats.jobs = current.jobs - worker.reported.jobs;
+		stats.stealAttempts = current.stealAttempts - worker.reported.stealAttempts;
+		stats.steals = current.steals - worker.reported.steals;
+		stats.busyMs = (current.busyNs - worker.reported.busyNs) / 1.0e6;
+		stats.waitMs = (current.waitNs - worker.reported.waitNs) / 1.0e6;
+		stats.queued = static_cast<uint32_t>(worker.queue.size());
+		worker.reported = current;
+	}
+}
+
+void
+JobSystem::setActiveWorkers(unsigned count) {
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_active.store(std::min(count, workerCount()));
+	}
+	m_resume.notify_all();
+}
+
+unsigned
+JobSystem::defaultWorkerCount() {
+	unsigned cores = std::thread::hardware_concurrency();
+	return cores > 1 ? cores - 1 : 0;
+}
+
+JobSystem::Worker*
+JobSystem::currentWorker() const {
+	return t_identity.system == this ? static_cast<Worker*>(t_identity.worker) : nullptr;
+}
+
+JobSystem::Job*
+JobSystem::allocateJob() {
+	Worker* self = currentWorker();
+	if (!self) {
+		Job* job = new Job();
+		job->external = true;
+		return job;
+	}
+	Job& job = self->jobs[self->nextJob];
+	// acquire: lo que hizo quien ejecut el trabajo anterior de esta entrada ya termin
+	if (job.running.load(std::memory_order_acquire)) {
+		return nullptr;
+	}
+	self->nextJob = (self->nextJob + 1) & (kJobsPerThread - 1);
+	job.running.store(true, std::memory_order_relaxed);
+	return &job;
+}
+
+void
+JobSystem::enqueue(Job* job) {
+	Worker* self = currentWorker();
+	if (self) {
+		if (!self->queue.push(job)) {
+			execute(job, self); // Cola llena
+			return;
+		}
+	}
+	else {
+		std::lock_guard<EngineMutex> lock(m_externalMutex);
+		m_external.push_back(job);
+		m_externalCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// seq_cst con `m_sleeping`: o el hilo que se duerme ve el trabajo, o aqu se ve que duerme
+	m_queued.fetch_add(1);
+	if (m_sleeping.load() > 0) {
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_wake.notify_one();
+	}
+}
+
+JobSystem::Job*
+JobSystem::findJob(Worker* self) {
+	Job* job = nullptr;
+	if (self && self->queue.pop(job)) {
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+		return job;
+	}
+
+	if (m_externalCount.load(std::memory_order_relaxed) > 0) {
+		std::lock_guard<EngineMutex> lock(m_externalMutex);
+		if (!m_external.empty()) {
+			job = m_external.front();
+			m_external.pop_front();
+			m_externalCount.fetch_sub(1, std::memory_order_relaxed);
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+
+	// Robo: empieza en una vctima al azar para no cargar siempre la misma
+	size_t count = m_workers.size();
+	size_t start = 0;
+	if (self) {
+		uint32_t x = self->random;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		self->random = x;
+		start = x % count;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		Worker* victim = m_workers[(start + i) % count].get();
+		if (victim == self) {
+			continue;
+		}
+		if (self) {
+			Counters::add(self->counters.stealAttempts, uint64_t(1));
+		}
+		if (victim->queue.steal(job)) {
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			if (self) {
+				Counters::add(self->counters.steals, uint64_t(1));
+			}
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+void
+JobSystem::execute(Job* job, Worker* self) {
+	if (self) {
+		Counters::add(self->counters.jobs, uint64_t(1));
+	}
+	if (self && self->depth == 0 && Profiler::instance().isEnabled()) {
+		// Solo el de afuera: los que corre adentro mientras espera ya estn en su tiempo
+		int64_t start = Profiler::now();
+		int64_t waited = self->counters.waitNs.load(std::memory_order_relaxed);
+		++self->depth;
+		job->invoke(*job);
+		--self->depth;
+		waited = self->counters.waitNs.load(std::memory_order_relaxed) - waited;
+		Counters::add(self->counters.busyNs, Profiler::now() - start - waited);
+	}
+	else if (self) {
+		++self->depth;
+		job->invoke(*job);
+		--self->depth;
+	}
+	else {
+		job->invoke(*job);
+	}
+	JobCounter* counter = job->counter;
+	if (job->external) {
+		delete job;
+	}
+	else {
+		// release: el dueo puede volver a usar la entrada del anillo
+		job->running.store(false, std::memory_order_release);
+	}
+	// ltimo acceso al grupo: quien espera puede destruir el contador al verlo en cero
+	finish(counter);
+}
+
+void
+JobSystem::workerLoop(unsigned index) {
+	Worker* self = m_workers[index].get();
+	t_identity = { this, self };
+	Profiler::instance().setThreadName("Worker " + std::to_string(index));
+
+	int idle = 0;
+	for (;;) {
+		if (index > m_active.load(std::memory_order_relaxed)) {
+			// Aparte de `m_wake`: un aviso de trabajo nuevo no debe despertar a uno que no lo toma.
+			// Lo que quede en su cola lo roban los dems.
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_resume.wait(lock, [this, index]() { return m_stopping.load() || index <= m_active.load(); });
+			idle = 0;
+		}
+		if (Job* job = findJob(self)) {
+			execute(job, self);
+			idle = 0;
+			continue;
+		}
+		if (m_stopping.load(std::memory_order_acquire)) {
+			return;
+		}
+		if (++idle < kSpinsBeforeSleep) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleeping.fetch_add(1);
+		m_wake.wait(lock, [this]() { return m_stopping.load() || m_queued.load() > 0; });
+		m_sleeping.fetch_sub(1);
+		idle = 0;
+	}
+}
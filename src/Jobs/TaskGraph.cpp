@@ -0,0 +1,181 @@
+#include "Jobs/TaskGraph.h"
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
+#include "Jobs/JobSystem.h"
+#include "Prerequisites.h"
+
+TaskGraph::TaskId
+TaskGraph::add(const char* name, std::function<void()> function, std::initializer_list<TaskId> after, Affinity affinity) {
+	TaskId id = static_cast<TaskId>(m_tasks.size());
+	Task task;
+	task.name = name;
+	task.function = std::move(function);
+	task.affinity = affinity;
+	for (TaskId dependency : after) {
+		if (dependency >= id) {
+			ERROR("TaskGraph", "add", "a task can only depend on tasks added before it");
+		}
+		// Las que ya corrieron en otro `run` no se esperan
+		if (dependency >= m_firstPending) {
+			m_tasks[dependency].dependents.push_back(id);
+			++task.dependencies;
+		}
+	}
+	m_tasks.push_back(std::move(task));
+	return id;
+}
+
+void
+TaskGraph::run(JobSystem& jobs) {
+	startClock();
+	size_t first = m_firstPending;
+	size_t count = m_tasks.size() - first;
+	if (count == 0) {
+		return;
+	}
+	m_jobs = &jobs;
+	m_waiting = EngineUtilities::MakeUnique<std::atomic<uint32_t>[]>(count);
+	m_left.store(count, std::memory_order_relaxed);
+	if (m_lanes.empty()) {
+		m_lanes.push_back(std::this_thread::get_id());
+	}
+	for (size_t i = 0; i < count; ++i) {
+		m_waiting[i].store(m_tasks[first + i].dependencies, std::memory_order_relaxed);
+	}
+	for (size_t i = first; i < m_tasks.size(); ++i) {
+		if (m_tasks[i].dependencies == 0) {
+			dispatch(static_cast<TaskId>(i));
+		}
+	}
+
+	// Las del hilo principal en cuanto se liberan; mientras, ayuda con las dems
+	while (m_left.load(std::memory_order_acquire) > 0) {
+		TaskId next = kNoTask;
+		{
+			std::lock_guard<std::mutex> lock(m_mainMutex);
+			if (!m_mainReady.empty()) {
+				next = m_mainReady.back();
+				m_mainReady.pop_back();
+			}
+		}
+		if (next != kNoTask) {
+			execute(next);
+		}
+		else if (!jobs.runPendingJob()) {
+			std::this_thread::yield();
+		}
+	}
+
+	// Ordenadas por fin: as se lee qu tarea dej esperando a la siguiente
+	std::vector<TaskId> finished;
+	finished.reserve(count);
+	for (size_t i = first; i < m_tasks.size(); ++i) {
+		finished.push_back(static_cast<TaskId>(i));
+		m_tasks[i].function = nullptr;
+	}
+	std::sort(finished.begin(), finished.end(), [this](TaskId a, TaskId b) { return m_tasks[a].end < m_tasks[b].end; });
+	for (TaskId index : finished) {
+		const Task& task = m_tasks[index];
+		m_timeline.push_back({ task.name, toMs(task.start), toMs(task.end), lane(task.thread), false });
+	}
+	m_firstPending = m_tasks.size();
+	m_waiting.reset();
+	m_jobs = nullptr;
+}
+
+void
+TaskGraph::execute(TaskId index) {
+	Task& task = m_tasks[index];
+	task.thread = std::this_thread::get_id();
+	task.start = Clock::now();
+	task.function();
+	task.end = Clock::now();
+	for (TaskId dependent : task.dependents) {
+		if (m_waiting[dependent - m_firstPending].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			dispatch(dependent);
+		}
+	}
+	// Al final: el hilo de `run` sale en cuanto llega a cero
+	m_left.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void
+TaskGraph::dispatch(TaskId index) {
+	if (m_tasks[index].affinity == Affinity::Main) {
+		std::lock_guard<std::mutex> lock(m_mainMutex);
+		m_mainReady.push_back(index);
+		return;
+	}
+	m_jobs->run([this, index]() { execute(index); });
+}
+
+void
+TaskGraph::mark(const char* name) {
+	startClock();
+	double now = toMs(Clock::now());
+	m_timeline.push_back({ name, now, now, 0, true });
+}
+
+double
+TaskGraph::elapsedMs() const {
+	return m_started ? toMs(Clock::now()) : 0.0;
+}
+
+void
+TaskGraph::startClock() {
+	if (!m_started) {
+		m_origin = Clock::now();
+		m_started = true;
+	}
+}
+
+double
+TaskGraph::toMs(Clock::time_point time) const {
+	return std::chrono::duration<double, std::milli>(time - m_origin).count();
+}
+
+uint32_t
+TaskGraph::lane(std::thread::id thread) {
+	for (size_t i = 0; i < m_lanes.size(); ++i) {
+		if (m_lanes[i] == thread) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+	m_lanes.push_back(thread);
+	return static_cast<uint32_t>(m_lanes.size() - 1);
+}
+
+bool
+TaskGraph::writeTrace(const std::string& path) const {
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if (!file) {
+		return false;
+	}
+	// Microsegundos; las marcas son eventos instantneos de todo el proceso
+	std::fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	for (size_t i = 0; i < m_timeline.size(); ++i) {
+		const Timing& timing = m_timeline[i];
+		const char* separator = i + 1 < m_timeline.size() ? "," : "";
+		if (!timing.isMark) {
+			std::fprintf(file, "  {\"name\": \"%s\", \"ph\": \"X\", \"ts\": %.1f, \"dur\": %.1f, \"pid\": 1, \"tid\": %u}%s\n",
+			             timing.name, timing.startMs * 1000.0, (timing.endMs - timing.startMs) * 1000.0, timing.thread, separator);
+		}
+		else {
+			std::fprintf(file, "  {\"name\": \"%s\", \"ph\": \"i\", \"s\": \"g\", \"ts\": %.1f, \"pid\": 1, \"tid\": %u}%s\n",
+			             timing.name, timing.startMs * 1000.0, timing.thread, separator);
+		}
+	}
+	std::fprintf(file, "]}\n");
+	return std::fclose(file) == 0;
+}
+
+void
+TaskGraph::print(std::ostream& out) const {
+	char line[160];
+	for (const Timing& timing : m_timeline) {
+		std::snprintf(line, sizeof(line), "  %-20s %9.2f ms  %9.2f ms  hilo %u\n", timing.name, timing.startMs,
+		              timing.endMs - timing.startMs, timing.thread);
+		out << line;
+	}
+}
@@ -0,0 +1,241 @@
+#include "Logging/Logger.h"
+#include <algorithm>
+#include <cinttypes>
+#include <iostream>
+
+namespace {
+	const char*
+	levelName(LogLevel level) {
+		switch (level) {
+		case LogLevel::Trace: return "TRACE";
+		case LogLevel::Debug: return "DEBUG";
+		case LogLevel::Info: return "INFO";
+		case LogLevel::Warning: return "WARNING";
+		case LogLevel::Error: return "ERROR";
+		}
+		return "";
+	}
+}
+
+Logger::Logger() {
+	m_running.store(true, std::memory_order_relaxed);
+	m_thread = std::thread([this]() { run(); });
+}
+
+Logger::ThreadBuffer&
+Logger::threadBuffer() {
+	if (!t_buffer) {
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		m_threads.push_back(EngineUtilities::MakeUnique<ThreadBuffer>());
+		t_buffer = m_threads.back().get();
+		t_buffer->thread = static_cast<uint32_t>(m_threads.size() - 1);
+	}
+	return *t_buffer;
+}
+
+int64_t
+Logger::now() const {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void
+Logger::log(LogLevel level, const char* category, const char* method, const char* message,
+            std::initializer_list<LogArg> args) {
+	if (level < m_level.load(std::memory_order_relaxed)) {
+		return;
+	}
+	LogRecord record;
+	record.time = now();
+	record.category = category;
+	record.method = method;
+	record.message = message;
+	record.level = level;
+	for (const LogArg& arg : args) {
+		if (record.argCount == LogRecord::kMaxArgs) {
+			break;
+		}
+		record.args[record.argCount++] = arg;
+	}
+	ThreadBuffer& buffer = threadBuffer();
+	record.thread = buffer.thread;
+	if (!m_running.load(std::memory_order_acquire)) {
+		// Sin hilo (al salir): se escribe aqu mismo
+		std::lock_guard<std::mutex> lock(m_writeMutex);
+		write(record);
+		return;
+	}
+	if (!buffer.records.tryPush(std::move(record))) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (level >= LogLevel::Error) {
+		m_urgent.store(true, std::memory_order_relaxed);
+		m_wake.notify_one();
+	}
+}
+
+bool
+Logger::setFile(const std::string& path, size_t maxBytes, uint32_t keep) {
+	std::lock_guard<std::mutex> lock(m_writeMutex);
+	if (m_file) {
+		std::fclose(m_file);
+	}
+	m_file = std::fopen(path.c_str(), "a");
+	if (!m_file) {
+		m_path.clear();
+		return false;
+	}
+	m_path = path;
+	m_maxBytes = maxBytes;
+	m_keep = keep;
+	std::fseek(m_file, 0, SEEK_END);
+	long size = std::ftell(m_file);
+	m_fileBytes = size > 0 ? static_cast<size_t>(size) : 0;
+	return true;
+}
+
+void
+Logger::flush() {
+	std::lock_guard<std::mutex> lock(m_writeMutex);
+	drain();
+}
+
+void
+Logger::shutdown() {
+	if (m_running.exchange(false, std::memory_order_acq_rel)) {
+		m_wake.notify_one();
+		m_thread.join();
+	}
+	std::lock_guard<std::mutex> lock(m_writeMutex);
+	drain();
+	if (m_file) {
+		std::fclose(m_file);
+		m_file = nullptr;
+	}
+}
+
+void
+Logger::run() {
+	while (m_running.load(std::memory_order_acquire)) {
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_wake.wait_for(lock, std::chrono::milliseconds(kWriteIntervalMilliseconds), [this]() {
+				return m_urgent.load(std::memory_order_relaxed) || !m_running.load(std::memory_order_relaxed);
+			});
+		}
+		m_urgent.store(false, std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(m_writeMutex);
+		drain();
+	}
+}
+
+void
+Logger::drain() {
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		m_drain.clear();
+		for (EngineUtilities::TUniquePtr<ThreadBuffer>& buffer : m_threads) {
+			m_drain.push_back(buffer.get());
+		}
+	}
+	m_batch.clear();
+	uint64_t dropped = 0;
+	LogRecord record;
+	for (ThreadBuffer* buffer : m_drain) {
+		while (buffer->records.tryPop(record)) {
+			m_batch.push_back(record);
+		}
+		uint64_t total = buffer->dropped.load(std::memory_order_relaxed);
+		dropped += total - buffer->reported;
+		buffer->reported = total;
+	}
+	// Cada cola ya est en orden; juntas, por hora
+	std::stable_sort(m_batch.begin(), m_batch.end(),
+		[](const LogRecord& a, const LogRecord& b) { return a.time < b.time; });
+	for (const LogRecord& batched : m_batch) {
+		write(batched);
+	}
+	if (dropped) {
+		LogRecord lost;
+		lost.time = now();
+		lost.category = "Logger";
+		lost.method = "drain";
+		lost.message = "messages dropped, a thread queue was full";
+		lost.level = LogLevel::Warning;
+		lost.args[0] = LogArg("count", dropped);
+		lost.argCount = 1;
+		write(lost);
+	}
+	if (m_file) {
+		std::fflush(m_file);
+	}
+}
+
+void
+Logger::write(const LogRecord& record) {
+	char number[64];
+	std::snprintf(number, sizeof(number), "%10.3f [%s] #%u ", record.time / 1.0e9, levelName(record.level), record.thread);
+	m_line.assign(number);
+	m_line.append(record.category ? record.category : "");
+	m_line.append("::");
+	m_line.append(record.method ? record.method : "");
+	m_line.append(" : ");
+	m_line.append(record.message ? record.message : "");
+	for (uint8_t i = 0; i < record.argCount; ++i) {
+		const LogArg& arg = record.args[i];
+		switch (arg.type) {
+		case LogArg::Type::Int:
+			std::snprintf(number, sizeof(number), "%" PRId64, arg.i);
+			break;
+		case LogArg::Type::UInt:
+			std::snprintf(number, sizeof(number), "%" PRIu64, arg.u);
+			break;
+		case LogArg::Type::Double:
+			std::snprintf(number, sizeof(number), "%g", arg.d);
+			break;
+		case LogArg::Type::Text:
+			number[0] = '\0';
+			break;
+		}
+		m_line.append(" ");
+		m_line.append(arg.key ? arg.key : "");
+		m_line.append("=");
+		m_line.append(arg.type == LogArg::Type::Text ? (arg.text ? arg.text : "") : number);
+	}
+	m_line.append("\n");
+	if (record.level >= m_consoleLevel.load(std::memory_order_relaxed)) {
+		std::cerr << m_line;
+	}
+	if (m_file) {
+		writeFile(m_line.data(), m_line.size());
+	}
+}
+
+void
+Logger::writeFile(const char* line, size_t length) {
+	if (m_maxBytes && m_fileBytes > 0 && m_fileBytes + length > m_maxBytes) {
+		rotate();
+		if (!m_file) {
+			return;
+		}
+	}
+	m_fileBytes += std::fwrite(line, 1, length, m_file);
+}
+
+void
+Logger::rotate() {
+	std::fclose(m_file);
+	// El ms viejo se pisa; los dems suben un nmero
+	for (uint32_t i = m_keep; i > 1; --i) {
+		std::string from = m_path + "." + std::to_string(i - 1);
+		std::string to = m_path + "." + std::to_string(i);
+		std::remove(to.c_str());
+		std::rename(from.c_str(), to.c_str());
+	}
+	if (m_keep > 0) {
+		std::string first = m_path + ".1";
+		std::remove(first.c_str());
+		std::rename(m_path.c_str(), first.c_str());
+	}
+	m_file = std::fopen(m_path.c_str(), "w");
+	m_fileBytes = 0;
+}
@@ -0,0 +1,215 @@
+#include "Math/CompactTransform.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include "Math/Simd.h"
+
+namespace {
+	constexpr float kSqrt2 = 1.41421356f;
+	constexpr float kRotationSteps = 511.0f;   ///< 10 bits con el 0 exacto: [-511, 511] + 511.
+
+#if MATH_SSE2 && !MATH_F16C
+	/**
+	 * @brief `halfToFloat` de 4 halves, uno en los 16 bits bajos de cada carril de 32.
+	 */
+	inline __m128
+	halfToFloat4(__m128i halves) {
+		const __m128i magnitudeMask = _mm_set1_epi32(0x7FFF);
+		const __m128 rebias = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+		const __m128i largestFinite = _mm_set1_epi32(0x7BFF);
+		const __m128 infinityExponent = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+		__m128i magnitude = _mm_and_si128(halves, magnitudeMask);
+		__m128i sign = _mm_slli_epi32(_mm_xor_si128(halves, magnitude), 16);
+		__m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), rebias);
+		__m128 special = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(magnitude, largestFinite)), infinityExponent);
+		return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), special));
+	}
+#endif
+
+	/**
+	 * @brief La posición de `t` en el mundo; el cuarto carril no vale nada.
+	 */
+	inline MathSimd::Register
+	unpackPosition(const CompactTransform& t, const Vec3& origin, float step) {
+#if MATH_SSE2
+		__m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&t));
+		__m128 steps = _mm_cvtepi32_ps(_mm_unpacklo_epi16(raw, _mm_setzero_si128()));
+		return _mm_add_ps(_mm_mul_ps(steps, _mm_set1_ps(step)), origin.reg());
+#elif MATH_NEON
+		uint16x4_t raw = vld1_u16(t.position);
+		return vmlaq_n_f32(origin.reg(), vcvtq_f32_u32(vmovl_u16(raw)), step);
+#else
+		alignas(16) float lanes[4] = { origin.x + t.position[0] * step,
+		                               origin.y + t.position[1] * step,
+		                               origin.z + t.position[2] * step,
+		                               0.0f };
+		return MathSimd::load(lanes);
+#endif
+	}
+
+	/**
+	 * @brief La escala de `t`; el cuarto carril no vale nada.
+	 */
+	inline MathSimd::Register
+	unpackScale(const CompactTransform& t) {
+#if MATH_SSE2
+		__m128i halves = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(t.scale));
+#if MATH_F16C
+		return _mm_cvtph_ps(halves);
+#else
+		return halfToFloat4(_mm_unpacklo_epi16(halves, _mm_setzero_si128()));
+#endif
+#elif MATH_NEON
+		return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(t.scale)));
+#else
+		alignas(16) float lanes[4] = { halfToFloat(t.scale[0]), halfToFloat(t.scale[1]), halfToFloat(t.scale[2]), 0.0f };
+		return MathSimd::load(lanes);
+#endif
+	}
+
+	inline Mat4
+	decodeMatrix(const CompactTransform& t, const Vec3& origin, float step) {
+		using namespace MathSimd;
+		Mat4 result = unpackRotation(t.rotation).toMat4();
+		alignas(16) float scale[4];
+		store(scale, unpackScale(t));
+		store(result.m, mul(load(result.m), splat(scale[0])));
+		store(result.m + 4, mul(load(result.m + 4), splat(scale[1])));
+		store(result.m + 8, mul(load(result.m + 8), splat(scale[2])));
+		store(result.m + 12, unpackPosition(t, origin, step));
+		result.m[15] = 1.0f;
+		return result;
+	}
+}
+
+uint16_t
+floatToHalf(float value) {
+	uint32_t bits = std::bit_cast<uint32_t>(value);
+	uint32_t sign = (bits >> 16) & 0x8000u;
+	bits &= 0x7FFFFFFFu;
+	if (bits > 0x7F800000u) {
+		return static_cast<uint16_t>(sign | 0x7E00u);
+	}
+	if (bits >= 0x477FF000u) {
+		// Redondearía a 65536 o más: el mayor finito
+		return static_cast<uint16_t>(sign | 0x7BFFu);
+	}
+	if (bits < 0x38800000u) {
+		// Subnormal o cero: sumar 0.5 deja los bits de la mantisa redondeados en su lugar
+		float shifted = std::bit_cast<float>(bits) + 0.5f;
+		return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(shifted) - 0x3F000000u));
+	}
+	uint32_t odd = (bits >> 13) & 1u;
+	bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + odd;
+	return static_cast<uint16_t>(sign | (bits >> 13));
+}
+
+float
+halfToFloat(uint16_t half) {
+	uint32_t magnitude = half & 0x7FFFu;
+	uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+	// Multiplicar por 2^112 corrige el exponente y también normaliza los subnormales
+	float scaled = std::bit_cast<float>(magnitude << 13) * std::bit_cast<float>(static_cast<uint32_t>(254 - 15) << 23);
+	uint32_t bits = std::bit_cast<uint32_t>(scaled) | sign;
+	if (magnitude > 0x7BFFu) {
+		bits |= 0x7F800000u;
+	}
+	return std::bit_cast<float>(bits);
+}
+
+uint32_t
+packRotation(const Quat& rotation) {
+	Quat unit = rotation.normalized();
+	const float components[4] = { unit.x, unit.y, unit.z, unit.w };
+	uint32_t largest = 0;
+	for (uint32_t i = 1; i < 4; ++i) {
+		if (std::fabs(components[i]) > std::fabs(components[largest])) {
+			largest = i;
+		}
+	}
+	// Los otros tres quedan en [-1/√2, 1/√2]: escalados por √2 usan todo el rango. Van en el
+	// orden que sigue al mayor, así desempacar no pregunta cuál falta
+	float sign = components[largest] < 0.0f ? -kSqrt2 : kSqrt2;
+	uint32_t packed = largest << 30;
+	for (uint32_t k = 0; k < 3; ++k) {
+		float value = std::clamp(components[(largest + 1 + k) & 3] * sign, -1.0f, 1.0f);
+		packed |= static_cast<uint32_t>(std::lround(value * kRotationSteps + kRotationSteps)) << (20 - 10 * k);
+	}
+	return packed;
+}
+
+Quat
+unpackRotation(uint32_t packed) {
+	constexpr float kScale = 1.0f / (kRotationSteps * kSqrt2);
+	uint32_t largest = packed >> 30;
+	float a = (static_cast<float>((packed >> 20) & 0x3FFu) - kRotationSteps) * kScale;
+	float b = (static_cast<float>((packed >> 10) & 0x3FFu) - kRotationSteps) * kScale;
+	float c = (static_cast<float>(packed & 0x3FFu) - kRotationSteps) * kScale;
+	float components[4];
+	components[largest] = std::sqrt(std::max(0.0f, 1.0f - a * a - b * b - c * c));
+	components[(largest + 1) & 3] = a;
+	components[(largest + 2) & 3] = b;
+	components[(largest + 3) & 3] = c;
+	return Quat(components[0], components[1], components[2], components[3]);
+}
+
+CompactTransformChunk::CompactTransformChunk(const Vec3& origin, float extent)
+	: m_origin(origin), m_extent(extent), m_step(extent / 65535.0f) {}
+
+CompactTransform
+CompactTransformChunk::encode(const Vec3& translation, const Quat& rotation, const Vec3& scale) const {
+	CompactTransform result;
+	const float offsets[3] = { translation.x - m_origin.x, translation.y - m_origin.y, translation.z - m_origin.z };
+	const float scales[3] = { scale.x, scale.y, scale.z };
+	for (int axis = 0; axis < 3; ++axis) {
+		float steps = m_step > 0.0f ? offsets[axis] / m_step : 0.0f;
+		result.position[axis] = static_cast<uint16_t>(std::lround(std::clamp(steps, 0.0f, 65535.0f)));
+		result.scale[axis] = floatToHalf(scales[axis]);
+	}
+	result.rotation = packRotation(rotation);
+	return result;
+}
+
+uint32_t
+CompactTransformChunk::add(const Vec3& translation, const Quat& rotation, const Vec3& scale) {
+	m_transforms.push_back(encode(translation, rotation, scale));
+	return static_cast<uint32_t>(m_transforms.size() - 1);
+}
+
+void
+CompactTransformChunk::set(uint32_t index, const Vec3& translation, const Quat& rotation, const Vec3& scale) {
+	m_transforms[index] = encode(translation, rotation, scale);
+}
+
+bool
+CompactTransformChunk::contains(const Vec3& position) const {
+	Vec3 offset = position - m_origin;
+	return offset.x >= 0.0f && offset.y >= 0.0f && offset.z >= 0.0f &&
+	       offset.x <= m_extent && offset.y <= m_extent && offset.z <= m_extent;
+}
+
+Vec3
+CompactTransformChunk::decodePosition(uint32_t index) const {
+	return Vec3::apply(unpackPosition(m_transforms[index], m_origin, m_step));
+}
+
+Mat4
+CompactTransformChunk::decode(uint32_t index) const {
+	return decodeMatrix(m_transforms[index], m_origin, m_step);
+}
+
+void
+CompactTransformChunk::decodeMatrices(size_t first, size_t count, Mat4* out) const {
+	const CompactTransform* transforms = m_transforms.data() + first;
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = decodeMatrix(transforms[i], m_origin, m_step);
+	}
+}
+
+void
+CompactTransformChunk::decodePositions(size_t first, size_t count, Vec3* out) const {
+	const CompactTransform* transforms = m_transforms.data() + first;
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = Vec3::apply(unpackPosition(transforms[i], m_origin, m_step));
+	}
+}
@@ -0,0 +1,147 @@
+#include "Math/Random.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RANDOM_SSE2 1
+#else
+#define RANDOM_SSE2 0
+#endif
+
+namespace {
+	constexpr uint64_t kThreadKeys = 0x8000000000000000ull; ///< Claves de los `local`, lejos de las que usa el juego.
+
+	inline uint64_t
+	splitMix(uint64_t& state) {
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * @brief Llena `words` desde `value`; un estado todo en cero no avanzara nunca.
+	 */
+	void
+	seedWords(uint32_t* words, size_t count, uint64_t value) {
+		uint64_t state = value;
+		for (size_t i = 0; i < count; i += 2) {
+			uint64_t bits = splitMix(state);
+			words[i] = static_cast<uint32_t>(bits);
+			words[i + 1] = static_cast<uint32_t>(bits >> 32);
+		}
+		uint32_t any = 0;
+		for (size_t i = 0; i < count; ++i) {
+			any |= words[i];
+		}
+		if (any == 0) {
+			words[0] = 1;
+		}
+	}
+
+	struct LocalRandom {
+		Random random;
+		uint32_t epoch = 0;
+		uint32_t thread = ~0u;
+	};
+}
+
+void
+Random::seed(uint64_t value) {
+	seedWords(m_state, 4, value);
+}
+
+void
+RandomBatch::seed(uint64_t value) {
+	uint32_t words[16];
+	seedWords(words, 16, value);
+	for (int lane = 0; lane < 4; ++lane) {
+		for (int word = 0; word < 4; ++word) {
+			m_state[word][lane] = words[lane * 4 + word];
+		}
+	}
+	for (int lane = 0; lane < 4; ++lane) {
+		if ((m_state[0][lane] | m_state[1][lane] | m_state[2][lane] | m_state[3][lane]) == 0) {
+			m_state[0][lane] = 1;
+		}
+	}
+}
+
+void
+RandomBatch::fillUniform(float* out, size_t count) {
+	fillRange(out, count, 0.0f, 1.0f);
+}
+
+void
+RandomBatch::fillRange(float* out, size_t count, float minimum, float maximum) {
+	float scale = (maximum - minimum) * (1.0f / 16777216.0f);
+#if RANDOM_SSE2
+	__m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_state[0]));
+	__m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_state[1]));
+	__m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_state[2]));
+	__m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_state[3]));
+	__m128 scaleV = _mm_set1_ps(scale);
+	__m128 minimumV = _mm_set1_ps(minimum);
+	for (size_t i = 0; i < count; i += 4) {
+		__m128i result = _mm_add_epi32(s0, s3);
+		__m128i t = _mm_slli_epi32(s1, 9);
+		s2 = _mm_xor_si128(s2, s0);
+		s3 = _mm_xor_si128(s3, s1);
+		s1 = _mm_xor_si128(s1, s2);
+		s0 = _mm_xor_si128(s0, s3);
+		s2 = _mm_xor_si128(s2, t);
+		s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+		// 24 bits altos: caben en un int positivo, as que la conversin con signo no estorba
+		__m128 values = _mm_add_ps(minimumV, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), scaleV));
+		if (i + 4 <= count) {
+			_mm_storeu_ps(out + i, values);
+		}
+		else {
+			alignas(16) float last[4];
+			_mm_store_ps(last, values);
+			for (size_t k = 0; i + k < count; ++k) {
+				out[i + k] = last[k];
+			}
+		}
+	}
+	_mm_store_si128(reinterpret_cast<__m128i*>(m_state[0]), s0);
+	_mm_store_si128(reinterpret_cast<__m128i*>(m_state[1]), s1);
+	_mm_store_si128(reinterpret_cast<__m128i*>(m_state[2]), s2);
+	_mm_store_si128(reinterpret_cast<__m128i*>(m_state[3]), s3);
+#else
+	for (size_t i = 0; i < count; i += 4) {
+		for (size_t lane = 0; lane < 4; ++lane) {
+			uint32_t result = m_state[0][lane] + m_state[3][lane];
+			uint32_t t = m_state[1][lane] << 9;
+			m_state[2][lane] ^= m_state[0][lane];
+			m_state[3][lane] ^= m_state[1][lane];
+			m_state[1][lane] ^= m_state[2][lane];
+			m_state[0][lane] ^= m_state[3][lane];
+			m_state[2][lane] ^= t;
+			m_state[3][lane] = (m_state[3][lane] << 11) | (m_state[3][lane] >> 21);
+			if (i + lane < count) {
+				out[i + lane] = minimum + static_cast<float>(static_cast<int32_t>(result >> 8)) * scale;
+			}
+		}
+	}
+#endif
+}
+
+void
+RandomService::setSeed(uint64_t value) {
+	m_seed.store(value, std::memory_order_relaxed);
+	m_epoch.fetch_add(1, std::memory_order_release);
+}
+
+Random&
+RandomService::local() {
+	thread_local LocalRandom t_local;
+	uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+	if (t_local.epoch != epoch) {
+		if (t_local.thread == ~0u) {
+			t_local.thread = m_nextThread.fetch_add(1, std::memory_order_relaxed);
+		}
+		t_local.random.seed(mix(kThreadKeys + t_local.thread));
+		t_local.epoch = epoch;
+	}
+	return t_local.random;
+}
@@ -0,0 +1,247 @@
+#include "Math/VectorBatch.h"
+#include <cmath>
+#include "Math/Simd.h"
+
+void
+VectorBatch::transformPoints(const Mat4& matrix, const float* x, const float* y, const float* z,
+                             float* outX, float* outY, float* outZ, size_t count) {
+	const float* m = matrix.m;
+	size_t i = 0;
+#if MATH_AVX
+	for (; i + 8 <= count; i += 8) {
+		__m256 px = _mm256_loadu_ps(x + i);
+		__m256 py = _mm256_loadu_ps(y + i);
+		__m256 pz = _mm256_loadu_ps(z + i);
+		for (int row = 0; row < 3; ++row) {
+			__m256 sum = _mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(m[row])), _mm256_set1_ps(m[12 + row]));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(py, _mm256_set1_ps(m[4 + row])));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(pz, _mm256_set1_ps(m[8 + row])));
+			_mm256_storeu_ps((row == 0 ? outX : row == 1 ? outY : outZ) + i, sum);
+		}
+	}
+#endif
+#if MATH_SSE
+	for (; i + 4 <= count; i += 4) {
+		__m128 px = _mm_loadu_ps(x + i);
+		__m128 py = _mm_loadu_ps(y + i);
+		__m128 pz = _mm_loadu_ps(z + i);
+		for (int row = 0; row < 3; ++row) {
+			__m128 sum = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m[row])), _mm_set1_ps(m[12 + row]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(py, _mm_set1_ps(m[4 + row])));
+			sum = _mm_add_ps(sum, _mm_mul_ps(pz, _mm_set1_ps(m[8 + row])));
+			_mm_storeu_ps((row == 0 ? outX : row == 1 ? outY : outZ) + i, sum);
+		}
+	}
+#elif MATH_NEON
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t px = vld1q_f32(x + i);
+		float32x4_t py = vld1q_f32(y + i);
+		float32x4_t pz = vld1q_f32(z + i);
+		for (int row = 0; row < 3; ++row) {
+			float32x4_t sum = vmlaq_n_f32(vdupq_n_f32(m[12 + row]), px, m[row]);
+			sum = vmlaq_n_f32(sum, py, m[4 + row]);
+			sum = vmlaq_n_f32(sum, pz, m[8 + row]);
+			vst1q_f32((row == 0 ? outX : row == 1 ? outY : outZ) + i, sum);
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		float px = x[i];
+		float py = y[i];
+		float pz = z[i];
+		outX[i] = px * m[0] + m[12] + py * m[4] + pz * m[8];
+		outY[i] = px * m[1] + m[13] + py * m[5] + pz * m[9];
+		outZ[i] = px * m[2] + m[14] + py * m[6] + pz * m[10];
+	}
+}
+
+void
+VectorBatch::transformPoints2D(const Mat4& matrix, float* x, float* y, size_t count) {
+	const float* m = matrix.m;
+	size_t i = 0;
+#if MATH_AVX
+	__m256 a0 = _mm256_set1_ps(m[0]), a1 = _mm256_set1_ps(m[1]);
+	__m256 b0 = _mm256_set1_ps(m[4]), b1 = _mm256_set1_ps(m[5]);
+	__m256 t0 = _mm256_set1_ps(m[12]), t1 = _mm256_set1_ps(m[13]);
+	for (; i + 8 <= count; i += 8) {
+		__m256 px = _mm256_loadu_ps(x + i);
+		__m256 py = _mm256_loadu_ps(y + i);
+		_mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, a0), t0), _mm256_mul_ps(py, b0)));
+		_mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, a1), t1), _mm256_mul_ps(py, b1)));
+	}
+#endif
+#if MATH_SSE
+	__m128 c0 = _mm_set1_ps(m[0]), c1 = _mm_set1_ps(m[1]);
+	__m128 d0 = _mm_set1_ps(m[4]), d1 = _mm_set1_ps(m[5]);
+	__m128 u0 = _mm_set1_ps(m[12]), u1 = _mm_set1_ps(m[13]);
+	for (; i + 4 <= count; i += 4) {
+		__m128 px = _mm_loadu_ps(x + i);
+		__m128 py = _mm_loadu_ps(y + i);
+		_mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, c0), u0), _mm_mul_ps(py, d0)));
+		_mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, c1), u1), _mm_mul_ps(py, d1)));
+	}
+#elif MATH_NEON
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t px = vld1q_f32(x + i);
+		float32x4_t py = vld1q_f32(y + i);
+		vst1q_f32(x + i, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[12]), px, m[0]), py, m[4]));
+		vst1q_f32(y + i, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m[13]), px, m[1]), py, m[5]));
+	}
+#endif
+	for (; i < count; ++i) {
+		float px = x[i];
+		float py = y[i];
+		x[i] = px * m[0] + m[12] + py * m[4];
+		y[i] = px * m[1] + m[13] + py * m[5];
+	}
+}
+
+void
+VectorBatch::addScaled(float* values, const float* delta, float scale, size_t count) {
+	size_t i = 0;
+#if MATH_AVX
+	__m256 wide = _mm256_set1_ps(scale);
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(_mm256_loadu_ps(delta + i), wide)));
+	}
+#endif
+#if MATH_SSE
+	__m128 factor = _mm_set1_ps(scale);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(delta + i), factor)));
+	}
+#elif MATH_NEON
+	for (; i + 4 <= count; i += 4) {
+		vst1q_f32(values + i, vmlaq_n_f32(vld1q_f32(values + i), vld1q_f32(delta + i), scale));
+	}
+#endif
+	for (; i < count; ++i) {
+		values[i] += delta[i] * scale;
+	}
+}
+
+void
+VectorBatch::normalize(float* x, float* y, float* z, float* lengths, size_t count) {
+	size_t i = 0;
+	// Raz y divisin exactas, no rsqrt: el largo sale igual que por el camino escalar
+#if MATH_AVX
+	__m256 zero8 = _mm256_setzero_ps();
+	__m256 one8 = _mm256_set1_ps(1.0f);
+	for (; i + 8 <= count; i += 8) {
+		__m256 px = _mm256_loadu_ps(x + i);
+		__m256 py = _mm256_loadu_ps(y + i);
+		__m256 pz = _mm256_loadu_ps(z + i);
+		__m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py)), _mm256_mul_ps(pz, pz)));
+		__m256 nonZero = _mm256_cmp_ps(length, zero8, _CMP_GT_OQ);
+		__m256 inverse = _mm256_and_ps(nonZero, _mm256_div_ps(one8, length));
+		_mm256_storeu_ps(x + i, _mm256_mul_ps(px, inverse));
+		_mm256_storeu_ps(y + i, _mm256_mul_ps(py, inverse));
+		_mm256_storeu_ps(z + i, _mm256_mul_ps(pz, inverse));
+		if (lengths) {
+			_mm256_storeu_ps(lengths + i, length);
+		}
+	}
+#endif
+#if MATH_SSE
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4) {
+		__m128 px = _mm_loadu_ps(x + i);
+		__m128 py = _mm_loadu_ps(y + i);
+		__m128 pz = _mm_loadu_ps(z + i);
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py)), _mm_mul_ps(pz, pz)));
+		__m128 inverse = _mm_and_ps(_mm_cmpgt_ps(length, zero), _mm_div_ps(one, length));
+		_mm_storeu_ps(x + i, _mm_mul_ps(px, inverse));
+		_mm_storeu_ps(y + i, _mm_mul_ps(py, inverse));
+		_mm_storeu_ps(z + i, _mm_mul_ps(pz, inverse));
+		if (lengths) {
+			_mm_storeu_ps(lengths + i, length);
+		}
+	}
+#elif MATH_NEON
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t px = vld1q_f32(x + i);
+		float32x4_t py = vld1q_f32(y + i);
+		float32x4_t pz = vld1q_f32(z + i);
+		float32x4_t length = vsqrtq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(px, px), py, py), pz, pz));
+		uint32x4_t nonZero = vcgtq_f32(length, vdupq_n_f32(0.0f));
+		float32x4_t inverse = vreinterpretq_f32_u32(vandq_u32(nonZero, vreinterpretq_u32_f32(vdivq_f32(vdupq_n_f32(1.0f), length))));
+		vst1q_f32(x + i, vmulq_f32(px, inverse));
+		vst1q_f32(y + i, vmulq_f32(py, inverse));
+		vst1q_f32(z + i, vmulq_f32(pz, inverse));
+		if (lengths) {
+			vst1q_f32(lengths + i, length);
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		float length = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+		float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+		x[i] *= inverse;
+		y[i] *= inverse;
+		z[i] *= inverse;
+		if (lengths) {
+			lengths[i] = length;
+		}
+	}
+}
+
+void
+VectorBatch::composeAffine2D(const Affine2DArrays& parents, const Affine2DArrays& locals, const Affine2DArrays& out, size_t count) {
+	const Affine2DArrays& p = parents;
+	const Affine2DArrays& l = locals;
+	size_t i = 0;
+#if MATH_AVX
+	for (; i + 8 <= count; i += 8) {
+		__m256 pa = _mm256_loadu_ps(p.a + i), pb = _mm256_loadu_ps(p.b + i);
+		__m256 pc = _mm256_loadu_ps(p.c + i), pd = _mm256_loadu_ps(p.d + i);
+		__m256 la = _mm256_loadu_ps(l.a + i), lb = _mm256_loadu_ps(l.b + i);
+		__m256 lc = _mm256_loadu_ps(l.c + i), ld = _mm256_loadu_ps(l.d + i);
+		__m256 lx = _mm256_loadu_ps(l.tx + i), ly = _mm256_loadu_ps(l.ty + i);
+		_mm256_storeu_ps(out.a + i, _mm256_add_ps(_mm256_mul_ps(pa, la), _mm256_mul_ps(pc, lb)));
+		_mm256_storeu_ps(out.b + i, _mm256_add_ps(_mm256_mul_ps(pb, la), _mm256_mul_ps(pd, lb)));
+		_mm256_storeu_ps(out.c + i, _mm256_add_ps(_mm256_mul_ps(pa, lc), _mm256_mul_ps(pc, ld)));
+		_mm256_storeu_ps(out.d + i, _mm256_add_ps(_mm256_mul_ps(pb, lc), _mm256_mul_ps(pd, ld)));
+		_mm256_storeu_ps(out.tx + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pa, lx), _mm256_mul_ps(pc, ly)), _mm256_loadu_ps(p.tx + i)));
+		_mm256_storeu_ps(out.ty + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pb, lx), _mm256_mul_ps(pd, ly)), _mm256_loadu_ps(p.ty + i)));
+	}
+#endif
+#if MATH_SSE
+	for (; i + 4 <= count; i += 4) {
+		__m128 pa = _mm_loadu_ps(p.a + i), pb = _mm_loadu_ps(p.b + i);
+		__m128 pc = _mm_loadu_ps(p.c + i), pd = _mm_loadu_ps(p.d + i);
+		__m128 la = _mm_loadu_ps(l.a + i), lb = _mm_loadu_ps(l.b + i);
+		__m128 lc = _mm_loadu_ps(l.c + i), ld = _mm_loadu_ps(l.d + i);
+		__m128 lx = _mm_loadu_ps(l.tx + i), ly = _mm_loadu_ps(l.ty + i);
+		_mm_storeu_ps(out.a + i, _mm_add_ps(_mm_mul_ps(pa, la), _mm_mul_ps(pc, lb)));
+		_mm_storeu_ps(out.b + i, _mm_add_ps(_mm_mul_ps(pb, la), _mm_mul_ps(pd, lb)));
+		_mm_storeu_ps(out.c + i, _mm_add_ps(_mm_mul_ps(pa, lc), _mm_mul_ps(pc, ld)));
+		_mm_storeu_ps(out.d + i, _mm_add_ps(_mm_mul_ps(pb, lc), _mm_mul_ps(pd, ld)));
+		_mm_storeu_ps(out.tx + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa, lx), _mm_mul_ps(pc, ly)), _mm_loadu_ps(p.tx + i)));
+		_mm_storeu_ps(out.ty + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(pb, lx), _mm_mul_ps(pd, ly)), _mm_loadu_ps(p.ty + i)));
+	}
+#elif MATH_NEON
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t pa = vld1q_f32(p.a + i), pb = vld1q_f32(p.b + i);
+		float32x4_t pc = vld1q_f32(p.c + i), pd = vld1q_f32(p.d + i);
+		float32x4_t la = vld1q_f32(l.a + i), lb = vld1q_f32(l.b + i);
+		float32x4_t lc = vld1q_f32(l.c + i), ld = vld1q_f32(l.d + i);
+		float32x4_t lx = vld1q_f32(l.tx + i), ly = vld1q_f32(l.ty + i);
+		vst1q_f32(out.a + i, vmlaq_f32(vmulq_f32(pa, la), pc, lb));
+		vst1q_f32(out.b + i, vmlaq_f32(vmulq_f32(pb, la), pd, lb));
+		vst1q_f32(out.c + i, vmlaq_f32(vmulq_f32(pa, lc), pc, ld));
+		vst1q_f32(out.d + i, vmlaq_f32(vmulq_f32(pb, lc), pd, ld));
+		vst1q_f32(out.tx + i, vaddq_f32(vmlaq_f32(vmulq_f32(pa, lx), pc, ly), vld1q_f32(p.tx + i)));
+		vst1q_f32(out.ty + i, vaddq_f32(vmlaq_f32(vmulq_f32(pb, lx), pd, ly), vld1q_f32(p.ty + i)));
+	}
+#endif
+	for (; i < count; ++i) {
+		float pa = p.a[i], pb = p.b[i], pc = p.c[i], pd = p.d[i];
+		out.a[i] = pa * l.a[i] + pc * l.b[i];
+		out.b[i] = pb * l.a[i] + pd * l.b[i];
+		out.c[i] = pa * l.c[i] + pc * l.d[i];
+		out.d[i] = pb * l.c[i] + pd * l.d[i];
+		out.tx[i] = pa * l.tx[i] + pc * l.ty[i] + p.tx[i];
+		out.ty[i] = pb * l.tx[i] + pd * l.ty[i] + p.ty[i];
+	}
+}
@@ -0,0 +1,410 @@
+#include "Memory/HeapTracker.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <malloc.h>
+#elif defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define ENGINE_HEAP_BACKTRACE 1
+#endif
+
+namespace {
+	using EngineUtilities::HeapTracker;
+
+	/**
+	 * @brief Lo de un hilo; solo l escribe, `beginFrame` lo vaca desde el principal.
+	 */
+	struct alignas(64) ThreadSlot
+	{
+		std::atomic<size_t> allocations{ 0 };
+		std::atomic<size_t> bytes{ 0 };
+		std::atomic<size_t> frees{ 0 };
+		std::atomic<size_t> totalAllocations{ 0 };
+		std::atomic<size_t> totalBytes{ 0 };
+		char name[HeapTracker::kNameLength] = {};
+	};
+
+	/**
+	 * @brief Un lugar de la tabla de pilas; `hash` distinto de 0 lo ocupa, `ready` dice que
+	 *        `frames` ya est escrito.
+	 */
+	struct StackSite
+	{
+		std::atomic<uint64_t> hash{ 0 };
+		std::atomic<bool> ready{ false };
+		void* frames[HeapTracker::kMaxStackDepth] = {};
+		uint32_t depth = 0;
+		std::atomic<size_t> allocations{ 0 };
+		std::atomic<size_t> bytes{ 0 };
+	};
+
+	// Todo con inicializacin constante: los `operator new` corren antes que los constructores globales
+	ThreadSlot g_threads[HeapTracker::kMaxThreads];
+	EngineUtilities::HeapThreadFrame g_lastThreads[HeapTracker::kMaxThreads];
+	EngineUtilities::HeapFrame g_lastFrame;
+	std::atomic<uint32_t> g_threadCount{ 0 };
+	std::atomic<bool> g_steady{ false };
+	std::atomic<bool> g_captureStacks{ false };
+	StackSite g_sites[HeapTracker::kMaxStackSites];
+	std::atomic<size_t> g_droppedStacks{ 0 };   ///< Reservas cuya pila no entr en la tabla.
+
+	thread_local int t_slot = -1;
+	thread_local int t_muted = 0;
+
+	ThreadSlot&
+	currentSlot()
+	{
+		if (t_slot < 0)
+		{
+			uint32_t slot = g_threadCount.fetch_add(1, std::memory_order_relaxed);
+			t_slot = static_cast<int>(std::min(slot, HeapTracker::kMaxThreads - 1));
+		}
+		return g_threads[t_slot];
+	}
+
+	uint32_t
+	captureStack(void** frames)
+	{
+#ifdef _WIN32
+		return CaptureStackBackTrace(3, static_cast<DWORD>(HeapTracker::kMaxStackDepth), frames, nullptr);
+#elif defined(ENGINE_HEAP_BACKTRACE)
+		return static_cast<uint32_t>(backtrace(frames, static_cast<int>(HeapTracker::kMaxStackDepth)));
+#else
+		(void)frames;
+		return 0;
+#endif
+	}
+
+	void
+	recordStack(size_t bytes)
+	{
+		void* frames[HeapTracker::kMaxStackDepth];
+		uint32_t depth = captureStack(frames);
+		if (depth == 0)
+		{
+			return;
+		}
+		// FNV-1a de las direcciones; 0 marca un lugar libre
+		uint64_t hash = 1469598103934665603ull;
+		for (uint32_t i = 0; i < depth; ++i)
+		{
+			hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ull;
+		}
+		hash |= 1;
+		for (size_t probe = 0; probe < 32; ++probe)
+		{
+			StackSite& site = g_sites[(hash + probe) % HeapTracker::kMaxStackSites];
+			uint64_t owner = site.hash.load(std::memory_order_acquire);
+			if (owner == 0 && site.hash.compare_exchange_strong(owner, hash, std::memory_order_acq_rel))
+			{
+				std::memcpy(site.frames, frames, depth * sizeof(void*));
+				site.depth = depth;
+				site.ready.store(true, std::memory_order_release);
+				owner = hash;
+			}
+			if (owner == hash)
+			{
+				site.allocations.fetch_add(1, std::memory_order_relaxed);
+				site.bytes.fetch_add(bytes, std::memory_order_relaxed);
+				return;
+			}
+		}
+		g_droppedStacks.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+namespace EngineUtilities {
+
+	HeapTracker::Scope::Scope()
+	{
+		++t_muted;
+	}
+
+	HeapTracker::Scope::~Scope()
+	{
+		--t_muted;
+	}
+
+	void
+	HeapTracker::onAllocate(size_t bytes)
+	{
+		if (t_muted)
+		{
+			return;
+		}
+		ThreadSlot& slot = currentSlot();
+		slot.allocations.fetch_add(1, std::memory_order_relaxed);
+		slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+		slot.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+		slot.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+		if (g_captureStacks.load(std::memory_order_relaxed) && g_steady.load(std::memory_order_relaxed))
+		{
+			// Recorrer la pila puede reservar la primera vez: eso no se cuenta
+			++t_muted;
+			recordStack(bytes);
+			--t_muted;
+		}
+	}
+
+	void
+	HeapTracker::onFree()
+	{
+		if (!t_muted)
+		{
+			currentSlot().frees.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void
+	HeapTracker::beginFrame()
+	{
+		HeapFrame frame;
+		size_t worstBytes = 0;
+		uint32_t count = threadCount();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			ThreadSlot& slot = g_threads[i];
+			HeapThreadFrame& last = g_lastThreads[i];
+			last.name = slot.name;
+			last.allocations = slot.allocations.exchange(0, std::memory_order_relaxed);
+			last.bytes = slot.bytes.exchange(0, std::memory_order_relaxed);
+			last.frees = slot.frees.exchange(0, std::memory_order_relaxed);
+			frame.allocations += last.allocations;
+			frame.bytes += last.bytes;
+			frame.frees += last.frees;
+			if (last.bytes > worstBytes)
+			{
+				worstBytes = last.bytes;
+				frame.worstThread = i;
+			}
+		}
+		g_lastFrame = frame;
+	}
+
+	HeapFrame
+	HeapTracker::lastFrame()
+	{
+		return g_lastFrame;
+	}
+
+	HeapThreadFrame
+	HeapTracker::lastThread(uint32_t index)
+	{
+		return index < threadCount() ? g_lastThreads[index] : HeapThreadFrame();
+	}
+
+	uint32_t
+	HeapTracker::threadCount()
+	{
+		return std::min(g_threadCount.load(std::memory_order_relaxed), kMaxThreads);
+	}
+
+	void
+	HeapTracker::setThreadName(const char* name)
+	{
+		ThreadSlot& slot = currentSlot();
+		size_t length = std::min(std::strlen(name), kNameLength - 1);
+		std::memcpy(slot.name, name, length);
+		slot.name[length] = '\0';
+	}
+
+	void
+	HeapTracker::setSteady(bool steady)
+	{
+		g_steady.store(steady, std::memory_order_relaxed);
+	}
+
+	bool
+	HeapTracker::isSteady()
+	{
+		return g_steady.load(std::memory_order_relaxed);
+	}
+
+	bool
+	HeapTracker::setStackCapture(bool enabled)
+	{
+		void* frames[kMaxStackDepth];
+		Scope scope;
+		// La primera llamada carga lo que necesita para recorrer la pila; mejor ahora que en un frame
+		if (enabled && captureStack(frames) == 0)
+		{
+			return false;
+		}
+		g_captureStacks.store(enabled, std::memory_order_relaxed);
+		return true;
+	}
+
+	void
+	HeapTracker::dump(std::ostream& out, size_t top)
+	{
+		if constexpr (!kHeapHooks)
+		{
+			return;
+		}
+		Scope scope;
+		out << "HeapTracker : [thread, allocations, MiB since start]\n";
+		for (uint32_t i = 0; i < threadCount(); ++i)
+		{
+			const ThreadSlot& slot = g_threads[i];
+			out << "  " << (slot.name[0] ? slot.name : "?") << " " << slot.totalAllocations.load(std::memory_order_relaxed)
+			    << " " << slot.totalBytes.load(std::memory_order_relaxed) / 1048576.0 << "\n";
+		}
+
+		std::vector<const StackSite*> sites;
+		for (const StackSite& site : g_sites)
+		{
+			if (site.ready.load(std::memory_order_acquire))
+			{
+				sites.push_back(&site);
+			}
+		}
+		if (sites.empty())
+		{
+			return;
+		}
+		std::sort(sites.begin(), sites.end(),
+			[](const StackSite* a, const StackSite* b) { return a->bytes.load(std::memory_order_relaxed) > b->bytes.load(std::memory_order_relaxed); });
+		out << "HeapTracker : steady-state allocation sites [allocations, bytes]";
+		if (size_t dropped = g_droppedStacks.load(std::memory_order_relaxed))
+		{
+			out << ", " << dropped << " allocations did not fit in the table";
+		}
+		out << "\n";
+		for (size_t i = 0; i < std::min(top, sites.size()); ++i)
+		{
+			const StackSite& site = *sites[i];
+			out << "  " << site.allocations.load(std::memory_order_relaxed) << " " << site.bytes.load(std::memory_order_relaxed) << "\n";
+#ifdef ENGINE_HEAP_BACKTRACE
+			char** symbols = backtrace_symbols(site.frames, static_cast<int>(site.depth));
+			for (uint32_t frame = 0; frame < site.depth; ++frame)
+			{
+				out << "    " << (symbols ? symbols[frame] : "?") << "\n";
+			}
+			std::free(symbols);
+#else
+			// Sin smbolos: las direcciones se resuelven con el .pdb
+			for (uint32_t frame = 0; frame < site.depth; ++frame)
+			{
+				out << "    " << site.frames[frame] << "\n";
+			}
+#endif
+		}
+	}
+}
+
+#if ENGINE_HEAP_HOOKS
+
+namespace {
+	void*
+	allocate(size_t size, bool nothrow)
+	{
+		size = size ? size : 1;
+		void* block;
+		while ((block = std::malloc(size)) == nullptr)
+		{
+			std::new_handler handler = std::get_new_handler();
+			if (!handler)
+			{
+				if (nothrow)
+				{
+					return nullptr;
+				}
+				throw std::bad_alloc();
+			}
+			handler();
+		}
+		HeapTracker::onAllocate(size);
+		return block;
+	}
+
+	void*
+	allocateAligned(size_t size, std::align_val_t alignment, bool nothrow)
+	{
+		size_t align = static_cast<size_t>(alignment);
+		size = (std::max<size_t>(size, 1) + align - 1) / align * align;
+		void* block;
+		while (true)
+		{
+#ifdef _WIN32
+			block = _aligned_malloc(size, align);
+#else
+			block = nullptr;
+			if (posix_memalign(&block, std::max(align, sizeof(void*)), size) != 0)
+			{
+				block = nullptr;
+			}
+#endif
+			if (block)
+			{
+				break;
+			}
+			std::new_handler handler = std::get_new_handler();
+			if (!handler)
+			{
+				if (nothrow)
+				{
+					return nullptr;
+				}
+				throw std::bad_alloc();
+			}
+			handler();
+		}
+		HeapTracker::onAllocate(size);
+		return block;
+	}
+
+	void
+	release(void* block)
+	{
+		if (block)
+		{
+			HeapTracker::onFree();
+			std::free(block);
+		}
+	}
+
+	void
+	releaseAligned(void* block)
+	{
+		if (block)
+		{
+			HeapTracker::onFree();
+#ifdef _WIN32
+			_aligned_free(block);
+#else
+			std::free(block);
+#endif
+		}
+	}
+}
+
+void* operator new(size_t size) { return allocate(size, false); }
+void* operator new[](size_t size) { return allocate(size, false); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, true); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, true); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment, false); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment, false); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment, true); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment, true); }
+
+void operator delete(void* block) noexcept { release(block); }
+void operator delete[](void* block) noexcept { release(block); }
+void operator delete(void* block, size_t) noexcept { release(block); }
+void operator delete[](void* block, size_t) noexcept { release(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { release(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { release(block); }
+void operator delete(void* block, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(block); }
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(block); }
+
+#endif
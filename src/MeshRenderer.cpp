@@ -0,0 +1,33 @@
+#include "MeshRenderer.h"
+#include "Picking.h"
+
+MeshRenderer::~MeshRenderer() {
+	if (m_pickProxy != AabbTree::kNullNode) {
+		if (Picking* picking = EngineUtilities::TService<Picking>::get()) {
+			picking->removeMesh(*this);
+		}
+	}
+}
+
+void
+MeshRenderer::render(RenderCommandBuffer& commands) {
+	if (!m_mesh) {
+		return;
+	}
+	Mat4 model = m_transform ? Mat4::fromTransform(m_transform->getRenderTransform()) * m_local : m_local;
+	if (m_static) {
+		commands.drawStaticMesh(*m_mesh, model, m_color, m_material.get());
+		return;
+	}
+	commands.drawMesh(*m_mesh, model, m_color, m_material.get());
+}
+
+bool
+MeshRenderer::raycast(const sf::Vector3f& origin, const sf::Vector3f& direction, float maxDistance, float& distance) const {
+	if (!m_mesh) {
+		return false;
+	}
+	// Sin normalizar la direccin local, el t de la malla es el t del mundo
+	Mat4 toLocal = getWorldMatrix().inverseAffine();
+	return m_mesh->raycast(toLocal.transformPoint(origin), toLocal.transformVector(direction), maxDistance, distance);
+}
@@ -0,0 +1,76 @@
+#include "NameTable.h"
+#include <mutex>
+#include "Memory/ServiceLocator.h"
+
+NameId
+NameTable::probe(std::string_view name, bool& found) const {
+	NameId id = nameHash(name);
+	for (;;) {
+		auto it = m_names.find(id);
+		if (it == m_names.end()) {
+			found = false;
+			return id;
+		}
+		if (it->second == name) {
+			found = true;
+			return id;
+		}
+		// Mismo hash, otro texto: el siguiente id, saltando `kNoName`
+		id = id + 1 == kNoName ? 1u : id + 1;
+	}
+}
+
+NameId
+NameTable::intern(std::string_view name) {
+	bool found = false;
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		NameId id = probe(name, found);
+		if (found) {
+			return id;
+		}
+	}
+	std::unique_lock<std::shared_mutex> lock(m_mutex);
+	// Otro hilo pudo internarlo entre los dos candados
+	NameId id = probe(name, found);
+	if (found) {
+		return id;
+	}
+	if (id != nameHash(name)) {
+		++m_collisions;
+	}
+	m_names.emplace(id, m_storage.emplace_back(name));
+	return id;
+}
+
+NameId
+NameTable::find(std::string_view name) const {
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	bool found = false;
+	NameId id = probe(name, found);
+	return found ? id : kNoName;
+}
+
+std::string_view
+NameTable::view(NameId id) const {
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	auto it = m_names.find(id);
+	return it != m_names.end() ? it->second : std::string_view();
+}
+
+size_t
+NameTable::size() const {
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	return m_names.size();
+}
+
+uint32_t
+NameTable::collisions() const {
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	return m_collisions;
+}
+
+NameTable&
+NameTable::instance() {
+	return EngineUtilities::TService<NameTable>::instance();
+}
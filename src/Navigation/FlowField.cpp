@@ -0,0 +1,170 @@
+#include "Navigation/FlowField.h"
+#include <algorithm>
+#include <limits>
+#include "Jobs/JobSystem.h"
+
+namespace {
+	constexpr float kDiagonalStep = 1.41421356f;
+	constexpr float kUnreached = std::numeric_limits<float>::infinity();
+	constexpr size_t kRowsPerJob = 8;
+
+	/**
+	 * @brief Los 8 vecinos, en el orden de los ndices que guarda el campo.
+	 */
+	constexpr int32_t kOffsets[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+	/**
+	 * @brief `kOffsets` como vectores unitarios: consultar el campo no calcula races.
+	 */
+	const sf::Vector2f kDirections[8] = {
+		{ 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+		{ 0.70710678f, 0.70710678f }, { 0.70710678f, -0.70710678f },
+		{ -0.70710678f, 0.70710678f }, { -0.70710678f, -0.70710678f }
+	};
+
+	/**
+	 * @brief Se puede pasar de `(x, y)` a su vecino `offset`: bloqueos y esquinas.
+	 */
+	inline bool
+	canStep(const NavGrid& grid, int32_t x, int32_t y, const int32_t* offset) {
+		if (!grid.isWalkable(x + offset[0], y + offset[1])) {
+			return false;
+		}
+		if (offset[0] != 0 && offset[1] != 0) {
+			return grid.isWalkable(x + offset[0], y) && grid.isWalkable(x, y + offset[1]);
+		}
+		return true;
+	}
+}
+
+bool
+FlowField::update(const NavGrid& grid, JobSystem& jobs, size_t budget) {
+	uint32_t cellX, cellY;
+	if (m_hasRequest && grid.cellAt(m_requested, cellX, cellY) && grid.isWalkable(int32_t(cellX), int32_t(cellY))) {
+		uint32_t cell = grid.indexOf(cellX, cellY);
+		if (m_building ? cell != m_buildCell : (!isReady() || cell != m_ready.targetCell)) {
+			beginBuild(grid, cell, m_requested);
+		}
+		else if (m_building) {
+			m_buildTarget = m_requested;
+		}
+		else {
+			// Misma celda: el campo sirve igual, solo se corre el punto final
+			m_ready.target = m_requested;
+		}
+	}
+	m_hasRequest = false;
+
+	// La grilla cambi debajo del campo: se arma otra vez hacia el mismo destino
+	if (m_building ? m_grid.version() != grid.version() : (isReady() && m_ready.version != grid.version())) {
+		sf::Vector2f target = m_building ? m_buildTarget : m_ready.target;
+		if (grid.cellAt(target, cellX, cellY) && grid.isWalkable(int32_t(cellX), int32_t(cellY))) {
+			beginBuild(grid, grid.indexOf(cellX, cellY), target);
+		}
+		else {
+			m_building = false;
+			m_ready = Field();
+		}
+	}
+	if (!m_building) {
+		return false;
+	}
+
+	uint32_t width = m_grid.width();
+	auto lowerFirst = [](const Open& a, const Open& b) { return a.cost > b.cost; };
+	for (size_t expanded = 0; expanded < budget && !m_open.empty();) {
+		std::pop_heap(m_open.begin(), m_open.end(), lowerFirst);
+		Open open = m_open.back();
+		m_open.pop_back();
+		// Entrada vieja: la celda ya sali con un costo menor
+		if (open.cost > m_cost[open.cell]) {
+			continue;
+		}
+		++expanded;
+		int32_t x = static_cast<int32_t>(open.cell % width);
+		int32_t y = static_cast<int32_t>(open.cell / width);
+		for (const int32_t* offset : kOffsets) {
+			if (!canStep(m_grid, x, y, offset)) {
+				continue;
+			}
+			// El agente ir del vecino a esta celda: paga la entrada a esta
+			uint32_t next = m_grid.indexOf(uint32_t(x + offset[0]), uint32_t(y + offset[1]));
+			bool diagonal = offset[0] != 0 && offset[1] != 0;
+			float cost = open.cost + (diagonal ? kDiagonalStep : 1.0f) * m_grid.costAt(open.cell);
+			if (cost < m_cost[next]) {
+				m_cost[next] = cost;
+				m_open.push_back({ cost, next });
+				std::push_heap(m_open.begin(), m_open.end(), lowerFirst);
+			}
+		}
+	}
+	if (!m_open.empty()) {
+		return false;
+	}
+	finishBuild(jobs);
+	return true;
+}
+
+sf::Vector2f
+FlowField::direction(const sf::Vector2f& position) const {
+	const Field& field = m_ready;
+	float cellX = std::floor((position.x - field.origin.x) / field.cellSize);
+	float cellY = std::floor((position.y - field.origin.y) / field.cellSize);
+	if (cellX < 0.0f || cellY < 0.0f || cellX >= float(field.width) || cellY >= float(field.height)) {
+		return sf::Vector2f();
+	}
+	uint8_t index = field.directions[size_t(cellY) * field.width + size_t(cellX)];
+	return index == kNoDirection ? sf::Vector2f() : kDirections[index];
+}
+
+void
+FlowField::beginBuild(const NavGrid& grid, uint32_t cell, const sf::Vector2f& target) {
+	m_grid = grid;
+	m_cost.assign(m_grid.cellCount(), kUnreached);
+	m_open.clear();
+	m_cost[cell] = 0.0f;
+	m_open.push_back({ 0.0f, cell });
+	m_buildCell = cell;
+	m_buildTarget = target;
+	m_building = true;
+}
+
+void
+FlowField::finishBuild(JobSystem& jobs) {
+	uint32_t width = m_grid.width();
+	uint32_t height = m_grid.height();
+	m_buildDirections.resize(m_grid.cellCount());
+	// Cada fila solo lee costos y escribe sus propias celdas
+	jobs.parallelFor(height, kRowsPerJob, [this, width](size_t begin, size_t end) {
+		for (size_t row = begin; row < end; ++row) {
+			int32_t y = static_cast<int32_t>(row);
+			for (uint32_t column = 0; column < width; ++column) {
+				int32_t x = static_cast<int32_t>(column);
+				uint32_t cell = m_grid.indexOf(column, uint32_t(row));
+				uint8_t best = kNoDirection;
+				float bestCost = m_cost[cell];
+				for (uint8_t k = 0; k < 8; ++k) {
+					if (!canStep(m_grid, x, y, kOffsets[k])) {
+						continue;
+					}
+					float cost = m_cost[m_grid.indexOf(uint32_t(x + kOffsets[k][0]), uint32_t(y + kOffsets[k][1]))];
+					if (cost < bestCost) {
+						bestCost = cost;
+						best = k;
+					}
+				}
+				m_buildDirections[cell] = best;
+			}
+		}
+	});
+
+	m_ready.directions.swap(m_buildDirections);
+	m_ready.width = width;
+	m_ready.height = height;
+	m_ready.cellSize = m_grid.cellSize();
+	m_ready.origin = m_grid.origin();
+	m_ready.target = m_buildTarget;
+	m_ready.targetCell = m_buildCell;
+	m_ready.version = m_grid.version();
+	m_building = false;
+}
@@ -0,0 +1,54 @@
+#include "Navigation/NavGrid.h"
+#include <algorithm>
+
+void
+NavGrid::resize(uint32_t width, uint32_t height, float cellSize, const sf::Vector2f& origin) {
+	m_width = width;
+	m_height = height;
+	m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+	m_origin = origin;
+	m_costs.assign(size_t(width) * height, kDefaultCost);
+	++m_version;
+}
+
+void
+NavGrid::setCost(uint32_t x, uint32_t y, uint8_t cost) {
+	uint8_t& cell = m_costs[indexOf(x, y)];
+	if (cell != cost) {
+		cell = cost;
+		++m_version;
+	}
+}
+
+void
+NavGrid::fill(const sf::FloatRect& area, uint8_t cost) {
+	if (m_width == 0 || m_height == 0) {
+		return;
+	}
+	auto clampCell = [this](float coordinate, float origin, uint32_t count) {
+		float cell = std::floor((coordinate - origin) / m_cellSize);
+		return static_cast<int64_t>(std::clamp(cell, -1.0f, static_cast<float>(count)));
+	};
+	int64_t x0 = std::max<int64_t>(0, clampCell(area.left, m_origin.x, m_width));
+	int64_t y0 = std::max<int64_t>(0, clampCell(area.top, m_origin.y, m_height));
+	int64_t x1 = std::min<int64_t>(m_width - 1, clampCell(area.left + area.width, m_origin.x, m_width));
+	int64_t y1 = std::min<int64_t>(m_height - 1, clampCell(area.top + area.height, m_origin.y, m_height));
+	for (int64_t y = y0; y <= y1; ++y) {
+		for (int64_t x = x0; x <= x1; ++x) {
+			m_costs[indexOf(uint32_t(x), uint32_t(y))] = cost;
+		}
+	}
+	++m_version;
+}
+
+bool
+NavGrid::cellAt(const sf::Vector2f& position, uint32_t& x, uint32_t& y) const {
+	float cellX = std::floor((position.x - m_origin.x) / m_cellSize);
+	float cellY = std::floor((position.y - m_origin.y) / m_cellSize);
+	if (cellX < 0.0f || cellY < 0.0f || cellX >= float(m_width) || cellY >= float(m_height)) {
+		return false;
+	}
+	x = static_cast<uint32_t>(cellX);
+	y = static_cast<uint32_t>(cellY);
+	return true;
+}
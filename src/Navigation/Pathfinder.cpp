@@ -0,0 +1,329 @@
+#include "Navigation/Pathfinder.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+	constexpr float kDiagonalStep = 1.41421356f;
+	constexpr float kTieBreak = 1.001f; ///< Con prioridades iguales gana el ms cercano al destino: menos zigzag.
+
+	/**
+	 * @brief Distancia octil entre dos celdas (el costo mnimo con pasos rectos y diagonales),
+	 *        apenas inflada por `kTieBreak`.
+	 */
+	inline float
+	octile(uint32_t fromX, uint32_t fromY, uint32_t toX, uint32_t toY) {
+		float dx = static_cast<float>(fromX > toX ? fromX - toX : toX - fromX);
+		float dy = static_cast<float>(fromY > toY ? fromY - toY : toY - fromY);
+		return (dx + dy + (kDiagonalStep - 2.0f) * std::min(dx, dy)) * kTieBreak;
+	}
+
+	/**
+	 * @brief Orden del montculo: arriba la menor prioridad.
+	 */
+	inline bool
+	lowerFirst(const Pathfinder::SearchNodes::Open& a, const Pathfinder::SearchNodes::Open& b) {
+		return a.priority > b.priority;
+	}
+}
+
+Pathfinder::~Pathfinder() {
+	m_jobs.wait(m_counter);
+}
+
+bool
+Pathfinder::request(const sf::Vector2f& start, const sf::Vector2f& goal, PathHandle into) {
+	const NavGrid* grid = EngineUtilities::TService<NavGrid>::get();
+	uint32_t startX, startY, goalX, goalY;
+	if (!grid || !grid->cellAt(start, startX, startY) || !grid->cellAt(goal, goalX, goalY) ||
+	    !grid->isWalkable(int32_t(startX), int32_t(startY)) || !grid->isWalkable(int32_t(goalX), int32_t(goalY))) {
+		return false;
+	}
+	Query query;
+	query.startCell = grid->indexOf(startX, startY);
+	query.goalCell = grid->indexOf(goalX, goalY);
+	query.goal = goal;
+	query.into = into;
+	m_queued.push_back(std::move(query));
+	return true;
+}
+
+void
+Pathfinder::dispatch() {
+	if (m_queued.empty()) {
+		return;
+	}
+	const NavGrid& grid = EngineUtilities::TService<NavGrid>::instance();
+	if (grid.version() != m_cacheVersion) {
+		m_cache.clear();
+		m_cacheIndex.clear();
+		m_cacheVersion = grid.version();
+	}
+
+	EngineUtilities::TUniquePtr<Batch> batch = EngineUtilities::MakeUnique<Batch>();
+	std::unordered_map<uint64_t, uint32_t> firstOfPair;
+	for (Query& query : m_queued) {
+		uint64_t key = cacheKey(query.startCell, query.goalCell);
+		if (const std::vector<sf::Vector2f>* points = recall(key)) {
+			query.points = *points;
+			query.found = true;
+			m_ready.push_back(std::move(query));
+			++m_cacheHits;
+			continue;
+		}
+		// El mismo par dos veces en el lote se busca una sola
+		auto first = firstOfPair.try_emplace(key, static_cast<uint32_t>(batch->queries.size()));
+		if (first.second) {
+			++m_cacheMisses;
+		}
+		else {
+			query.sameAs = first.first->second;
+			++m_cacheHits;
+		}
+		batch->queries.push_back(std::move(query));
+	}
+	m_queued.clear();
+	if (batch->queries.empty()) {
+		return;
+	}
+
+	// Los trabajos leen la copia: la grilla puede cambiar mientras buscan
+	batch->grid = grid;
+	size_t count = batch->queries.size();
+	size_t jobs = (count + kRequestsPerJob - 1) / kRequestsPerJob;
+	batch->remaining.store(static_cast<uint32_t>(jobs), std::memory_order_relaxed);
+	Batch* solving = batch.get();
+	m_batches.push_back(std::move(batch));
+	for (size_t begin = 0; begin < count; begin += kRequestsPerJob) {
+		m_jobs.run([this, solving, begin]() {
+			size_t end = std::min(solving->queries.size(), begin + kRequestsPerJob);
+			SearchNodes* nodes = acquireNodes();
+			for (size_t i = begin; i < end; ++i) {
+				if (solving->queries[i].sameAs == kNoQuery) {
+					solve(solving->grid, solving->queries[i], *nodes);
+				}
+			}
+			releaseNodes(nodes);
+			solving->remaining.fetch_sub(1, std::memory_order_release);
+		}, &m_counter);
+	}
+	// Sin hilos de trabajo nadie ms tomara los trabajos
+	if (m_jobs.activeWorkers() == 0) {
+		m_jobs.wait(m_counter);
+	}
+}
+
+size_t
+Pathfinder::collect() {
+	size_t delivered = 0;
+	for (const Query& query : m_ready) {
+		delivered += deliver(query, query.points) ? 1 : 0;
+	}
+	m_ready.clear();
+
+	for (size_t i = 0; i < m_batches.size();) {
+		Batch& batch = *m_batches[i];
+		if (batch.remaining.load(std::memory_order_acquire) != 0) {
+			++i;
+			continue;
+		}
+		// Lo buscado sobre una grilla que ya cambi se entrega, pero no se guarda
+		bool current = batch.grid.version() == m_cacheVersion;
+		for (const Query& query : batch.queries) {
+			const Query& solved = query.sameAs == kNoQuery ? query : batch.queries[query.sameAs];
+			if (!solved.found) {
+				continue;
+			}
+			if (current && &solved == &query) {
+				remember(cacheKey(query.startCell, query.goalCell), query.points);
+			}
+			delivered += deliver(query, solved.points) ? 1 : 0;
+		}
+		m_batches[i] = std::move(m_batches.back());
+		m_batches.pop_back();
+	}
+	return delivered;
+}
+
+void
+Pathfinder::finishAll() {
+	dispatch();
+	m_jobs.wait(m_counter);
+	collect();
+}
+
+size_t
+Pathfinder::pendingCount() const {
+	size_t count = m_queued.size() + m_ready.size();
+	for (const EngineUtilities::TUniquePtr<Batch>& batch : m_batches) {
+		count += batch->queries.size();
+	}
+	return count;
+}
+
+bool
+Pathfinder::findPath(const NavGrid& grid, uint32_t start, uint32_t goal, SearchNodes& nodes, std::vector<uint32_t>& cells) {
+	size_t count = grid.cellCount();
+	if (start >= count || goal >= count || grid.costAt(start) == NavGrid::kBlocked || grid.costAt(goal) == NavGrid::kBlocked) {
+		return false;
+	}
+	if (nodes.stamp.size() != count) {
+		nodes.cost.resize(count);
+		nodes.parent.resize(count);
+		nodes.closed.resize(count);
+		nodes.stamp.assign(count, 0);
+		nodes.search = 0;
+	}
+	// Con un sello nuevo todos los nodos cuentan como no visitados, sin limpiar nada
+	if (++nodes.search == 0) {
+		nodes.stamp.assign(count, 0);
+		nodes.search = 1;
+	}
+	uint32_t search = nodes.search;
+	auto touch = [&nodes, search](uint32_t node) {
+		if (nodes.stamp[node] != search) {
+			nodes.stamp[node] = search;
+			nodes.cost[node] = std::numeric_limits<float>::infinity();
+			nodes.closed[node] = 0;
+		}
+	};
+
+	uint32_t width = grid.width();
+	uint32_t goalX = goal % width;
+	uint32_t goalY = goal / width;
+	nodes.open.clear();
+	touch(start);
+	nodes.cost[start] = 0.0f;
+	nodes.parent[start] = start;
+	nodes.open.push_back({ octile(start % width, start / width, goalX, goalY), start });
+
+	static constexpr int32_t kOffsets[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+	while (!nodes.open.empty()) {
+		std::pop_heap(nodes.open.begin(), nodes.open.end(), lowerFirst);
+		uint32_t node = nodes.open.back().node;
+		nodes.open.pop_back();
+		// Entrada vieja: el nodo ya sali con un costo menor
+		if (nodes.closed[node]) {
+			continue;
+		}
+		nodes.closed[node] = 1;
+		if (node == goal) {
+			cells.clear();
+			for (uint32_t step = goal;; step = nodes.parent[step]) {
+				cells.push_back(step);
+				if (step == start) {
+					break;
+				}
+			}
+			std::reverse(cells.begin(), cells.end());
+			return true;
+		}
+
+		int32_t x = static_cast<int32_t>(node % width);
+		int32_t y = static_cast<int32_t>(node / width);
+		for (const int32_t* offset : kOffsets) {
+			int32_t nx = x + offset[0];
+			int32_t ny = y + offset[1];
+			if (!grid.isWalkable(nx, ny)) {
+				continue;
+			}
+			bool diagonal = offset[0] != 0 && offset[1] != 0;
+			// Sin cortar esquinas: las dos celdas rectas tambin deben poder pasarse
+			if (diagonal && (!grid.isWalkable(x + offset[0], y) || !grid.isWalkable(x, y + offset[1]))) {
+				continue;
+			}
+			uint32_t next = grid.indexOf(uint32_t(nx), uint32_t(ny));
+			touch(next);
+			if (nodes.closed[next]) {
+				continue;
+			}
+			float cost = nodes.cost[node] + (diagonal ? kDiagonalStep : 1.0f) * grid.costAt(next);
+			if (cost < nodes.cost[next]) {
+				nodes.cost[next] = cost;
+				nodes.parent[next] = node;
+				nodes.open.push_back({ cost + octile(uint32_t(nx), uint32_t(ny), goalX, goalY), next });
+				std::push_heap(nodes.open.begin(), nodes.open.end(), lowerFirst);
+			}
+		}
+	}
+	return false;
+}
+
+void
+Pathfinder::solve(const NavGrid& grid, Query& query, SearchNodes& nodes) {
+	query.points.clear();
+	query.found = findPath(grid, query.startCell, query.goalCell, nodes, nodes.cells);
+	if (!query.found) {
+		return;
+	}
+	// Sin la celda de salida, y solo las celdas donde el camino dobla
+	const std::vector<uint32_t>& cells = nodes.cells;
+	uint32_t width = grid.width();
+	for (size_t k = 1; k < cells.size(); ++k) {
+		if (k + 1 < cells.size()) {
+			int64_t inX = int64_t(cells[k] % width) - int64_t(cells[k - 1] % width);
+			int64_t inY = int64_t(cells[k] / width) - int64_t(cells[k - 1] / width);
+			int64_t outX = int64_t(cells[k + 1] % width) - int64_t(cells[k] % width);
+			int64_t outY = int64_t(cells[k + 1] / width) - int64_t(cells[k] / width);
+			if (inX == outX && inY == outY) {
+				continue;
+			}
+		}
+		query.points.push_back(grid.centerOf(cells[k] % width, cells[k] / width));
+	}
+}
+
+Pathfinder::SearchNodes*
+Pathfinder::acquireNodes() {
+	std::lock_guard<std::mutex> lock(m_nodesMutex);
+	if (m_freeNodes.empty()) {
+		m_nodes.push_back(EngineUtilities::MakeUnique<SearchNodes>());
+		return m_nodes.back().get();
+	}
+	SearchNodes* nodes = m_freeNodes.back();
+	m_freeNodes.pop_back();
+	return nodes;
+}
+
+void
+Pathfinder::releaseNodes(SearchNodes* nodes) {
+	std::lock_guard<std::mutex> lock(m_nodesMutex);
+	m_freeNodes.push_back(nodes);
+}
+
+void
+Pathfinder::remember(uint64_t key, const std::vector<sf::Vector2f>& points) {
+	auto found = m_cacheIndex.find(key);
+	if (found != m_cacheIndex.end()) {
+		found->second->points = points;
+		m_cache.splice(m_cache.begin(), m_cache, found->second);
+		return;
+	}
+	m_cache.push_front(CacheEntry{ key, points });
+	m_cacheIndex[key] = m_cache.begin();
+	if (m_cache.size() > kCacheCapacity) {
+		m_cacheIndex.erase(m_cache.back().key);
+		m_cache.pop_back();
+	}
+}
+
+const std::vector<sf::Vector2f>*
+Pathfinder::recall(uint64_t key) {
+	auto found = m_cacheIndex.find(key);
+	if (found == m_cacheIndex.end()) {
+		return nullptr;
+	}
+	m_cache.splice(m_cache.begin(), m_cache, found->second);
+	return &found->second->points;
+}
+
+bool
+Pathfinder::deliver(const Query& query, const std::vector<sf::Vector2f>& points) {
+	std::vector<sf::Vector2f> route = points;
+	if (route.empty()) {
+		route.push_back(query.goal);
+	}
+	else {
+		route.back() = query.goal;
+	}
+	return EngineUtilities::TService<PathLibrary>::instance().setPoints(query.into, route);
+}
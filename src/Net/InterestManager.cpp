@@ -0,0 +1,110 @@
+#include "Net/InterestManager.h"
+#include <algorithm>
+
+InterestManager::Client&
+InterestManager::client(ClientId client) {
+	if (client >= m_clients.size()) {
+		m_clients.resize(client + 1);
+	}
+	return m_clients[client];
+}
+
+void
+InterestManager::setArea(ClientId id, const sf::FloatRect& area) {
+	Client& state = client(id);
+	state.area = area;
+	state.hasArea = true;
+}
+
+sf::FloatRect
+InterestManager::interestArea(ClientId client) const {
+	if (!hasArea(client)) {
+		return {};
+	}
+	const sf::FloatRect& area = m_clients[client].area;
+	return { area.left - m_margin, area.top - m_margin, area.width + 2.0f * m_margin, area.height + 2.0f * m_margin };
+}
+
+void
+InterestManager::removeClient(ClientId client) {
+	if (client < m_clients.size()) {
+		m_clients[client] = Client();
+	}
+}
+
+void
+InterestManager::select(ClientId id, std::span<const NetActorState> current, std::span<const uint32_t> relevant,
+	size_t byteBudget, std::vector<NetActorState>& view) {
+	Client& state = client(id);
+	if (!current.empty() && state.priority.size() <= current.back().id) {
+		state.priority.resize(current.back().id + 1, 0.0f);
+	}
+	sf::FloatRect area = interestArea(id);
+	sf::Vector2f center(area.left + 0.5f * area.width, area.top + 0.5f * area.height);
+	float reach = 0.5f * std::max(area.width, area.height);
+
+	auto byId = [](const NetActorState& state, uint32_t id) { return state.id < id; };
+	auto findIn = [&byId](std::span<const NetActorState> states, uint32_t id) -> const NetActorState* {
+		auto found = std::lower_bound(states.begin(), states.end(), id, byId);
+		return found != states.end() && found->id == id ? &*found : nullptr;
+	};
+
+	// Lo que cambi desde lo ltimo mandado compite por el presupuesto; lo igual no cuesta
+	m_candidates.clear();
+	for (uint32_t actorId : relevant) {
+		const NetActorState* now = findIn(current, actorId);
+		if (!now) {
+			continue;
+		}
+		const NetActorState* sent = findIn(state.sent, actorId);
+		if (sent && *sent == *now) {
+			continue;
+		}
+		float weight = 1.0f;
+		if (state.hasArea && reach > 0.0f) {
+			sf::Vector2f offset = now->position() - center;
+			float distance = (offset.x * offset.x + offset.y * offset.y) / (reach * reach);
+			weight = 1.0f / (1.0f + distance);
+		}
+		if (!sent) {
+			weight *= kNewActorBoost;
+		}
+		float& priority = state.priority[actorId];
+		priority += weight;
+		m_candidates.push_back({ actorId, priority, sent ? kChangedActorBytes : kNewActorBytes });
+	}
+	std::sort(m_candidates.begin(), m_candidates.end(),
+		[](const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+	m_chosen.clear();
+	size_t spent = 0;
+	for (const Candidate& candidate : m_candidates) {
+		if (spent + candidate.cost <= byteBudget) {
+			spent += candidate.cost;
+			m_chosen.push_back(candidate.id);
+			state.priority[candidate.id] = 0.0f;
+		}
+	}
+	std::sort(m_chosen.begin(), m_chosen.end());
+
+	// Lo que sali de la zona empieza de cero si vuelve
+	for (const NetActorState& sent : state.sent) {
+		if (sent.id < state.priority.size() && !std::binary_search(relevant.begin(), relevant.end(), sent.id)) {
+			state.priority[sent.id] = 0.0f;
+		}
+	}
+
+	view.clear();
+	for (uint32_t actorId : relevant) {
+		const NetActorState* now = findIn(current, actorId);
+		if (!now) {
+			continue;
+		}
+		if (std::binary_search(m_chosen.begin(), m_chosen.end(), actorId)) {
+			view.push_back(*now);
+		}
+		else if (const NetActorState* sent = findIn(state.sent, actorId)) {
+			view.push_back(*sent);
+		}
+	}
+	state.sent.assign(view.begin(), view.end());
+}
@@ -0,0 +1,71 @@
+#include "Net/NetBuffer.h"
+#include <new>
+#include "Memory/MemoryAccounting.h"
+#include "Memory/ServiceLocator.h"
+
+NetBuffer
+NetBuffer::acquire(size_t capacity) {
+	return EngineUtilities::TService<NetBufferPool>::instance().acquire(capacity);
+}
+
+void
+NetBuffer::release() {
+	if (m_block && m_block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		m_block->pool->recycle(m_block);
+	}
+	m_block = nullptr;
+}
+
+NetBufferPool::~NetBufferPool() {
+	for (std::vector<NetBuffer::Block*>& blocks : m_free) {
+		for (NetBuffer::Block* block : blocks) {
+			EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Network, sizeof(NetBuffer::Block) + block->capacity, block);
+			block->~Block();
+			::operator delete(block);
+		}
+	}
+}
+
+NetBuffer
+NetBufferPool::acquire(size_t capacity) {
+	if (capacity > kLargeBytes) {
+		return NetBuffer();
+	}
+	uint8_t sizeClass = capacity > kSmallBytes ? 1 : 0;
+	NetBuffer::Block* block = nullptr;
+	{
+		std::lock_guard<EngineMutex> lock(m_mutex);
+		++m_stats.live;
+		if (!m_free[sizeClass].empty()) {
+			block = m_free[sizeClass].back();
+			m_free[sizeClass].pop_back();
+		}
+		else {
+			++m_stats.allocated;
+		}
+	}
+	if (!block) {
+		size_t bytes = sizeClass ? kLargeBytes : kSmallBytes;
+		block = new (::operator new(sizeof(NetBuffer::Block) + bytes)) NetBuffer::Block();
+		EngineUtilities::MemoryAccounting::onAllocate(EngineUtilities::MemoryCategory::Network, sizeof(NetBuffer::Block) + bytes, block);
+		block->pool = this;
+		block->capacity = bytes;
+		block->sizeClass = sizeClass;
+	}
+	block->size = 0;
+	block->overflowed = false;
+	return NetBuffer(block);
+}
+
+void
+NetBufferPool::recycle(NetBuffer::Block* block) {
+	std::lock_guard<EngineMutex> lock(m_mutex);
+	--m_stats.live;
+	m_free[block->sizeClass].push_back(block);
+}
+
+NetBufferPool::Stats
+NetBufferPool::stats() const {
+	std::lock_guard<EngineMutex> lock(m_mutex);
+	return m_stats;
+}
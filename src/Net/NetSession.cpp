@@ -0,0 +1,397 @@
+#include "Net/NetSession.h"
+#include <algorithm>
+#include <cmath>
+#include "Actor.h"
+#include "Memory/ServiceLocator.h"
+#include "Render/SpatialGrid.h"
+
+bool
+NetSession::host(unsigned short port) {
+	close();
+	if (!m_transport.bind(port)) {
+		return false;
+	}
+	m_transport.setAcceptingPeers(true);
+	m_thread.start(m_transport);
+	m_role = Role::Host;
+	return true;
+}
+
+bool
+NetSession::connect(const sf::IpAddress& address, unsigned short port) {
+	close();
+	if (!m_transport.bind(sf::Socket::AnyPort)) {
+		return false;
+	}
+	m_transport.setAcceptingPeers(false);
+	m_server = m_transport.connect(address, port);
+	m_thread.start(m_transport);
+	m_role = Role::Client;
+	return true;
+}
+
+void
+NetSession::close() {
+	if (isOpen() && !m_statsPath.empty()) {
+		NetStats measured;
+		stats(measured);
+		if (!measured.write(m_statsPath)) {
+			MESSAGE("NetSession", "close", "could not write the network stats");
+		}
+	}
+	m_thread.stop();
+	m_transport.unbind();
+	m_replication = ReplicationServer();
+	m_clients.clear();
+	m_interest = InterestManager();
+	m_ids.clear();
+	m_replicated = ReplicationClient();
+	m_interpolator.clear();
+	m_serverTime = 0.0;
+	m_sinceSnapshot = 0.0f;
+	m_traffic.clear();
+	m_rateStart = localTime();
+	m_rateBytesOut = 0;
+	m_rateBytesIn = 0;
+	m_bytesOutPerSecond = 0.0f;
+	m_bytesInPerSecond = 0.0f;
+	m_role = Role::None;
+}
+
+void
+NetSession::update(std::span<const EngineUtilities::TSharedPointer<Actor>> actors, float deltaTime) {
+	if (m_role == Role::Host) {
+		updateHost(actors, deltaTime);
+	}
+	else if (m_role == Role::Client) {
+		updateClient(actors);
+	}
+	if (isOpen()) {
+		updateRates();
+	}
+}
+
+void
+NetSession::update(std::span<const NetActorState> states, float deltaTime) {
+	if (m_role != Role::Host) {
+		return;
+	}
+	receiveHost();
+	if (snapshotDue(deltaTime)) {
+		m_states.assign(states.begin(), states.end());
+		m_ids.clear();
+		sendSnapshot();
+	}
+	m_thread.flush();
+	updateRates();
+}
+
+void
+NetSession::updateHost(std::span<const EngineUtilities::TSharedPointer<Actor>> actors, float deltaTime) {
+	receiveHost();
+	if (snapshotDue(deltaTime)) {
+		m_states.clear();
+		m_ids.clear();
+		for (size_t i = 0; i < actors.size(); ++i) {
+			if (!actors[i].isNull()) {
+				m_states.push_back(NetActorState::capture(static_cast<uint32_t>(i + 1), *actors[i]));
+				m_ids.emplace(actors[i].get(), static_cast<uint32_t>(i + 1));
+			}
+		}
+		sendSnapshot();
+	}
+	m_thread.flush();
+}
+
+void
+NetSession::receiveHost() {
+	NetIncoming incoming;
+	while (m_thread.poll(incoming)) {
+		UdpTransport::PeerId peer = incoming.peer;
+		if (incoming.kind == NetIncoming::Kind::Connected) {
+			if (peer >= m_clients.size()) {
+				m_clients.resize(peer + 1, kNoClient);
+			}
+			m_clients[peer] = m_replication.addClient();
+			if (peer < m_traffic.size()) {
+				m_traffic[peer] = NetPeerStats();
+			}
+			continue;
+		}
+		if (peer >= m_clients.size() || m_clients[peer] == kNoClient) {
+			continue;
+		}
+		if (incoming.kind == NetIncoming::Kind::Disconnected) {
+			m_replication.removeClient(m_clients[peer]);
+			m_interest.removeClient(m_clients[peer]);
+			m_clients[peer] = kNoClient;
+			continue;
+		}
+		std::span<const unsigned char> bytes = incoming.bytes.bytes();
+		countMessage(peer, bytes, false);
+		if (!bytes.empty() && bytes[0] == kAckMessage) {
+			NetReader reader(bytes.subspan(1));
+			m_replication.readAck(m_clients[peer], reader);
+			// La zona es opcional: un cliente sin ella recibe todo
+			float left = 0.0f, top = 0.0f, width = 0.0f, height = 0.0f;
+			if (reader.remaining().size() >= 4 * sizeof(float) && (reader >> left >> top >> width >> height) && width > 0.0f) {
+				m_interest.setArea(m_clients[peer], sf::FloatRect(left, top, width, height));
+			}
+		}
+		else if (!bytes.empty() && bytes[0] == kEventMessage) {
+			handleEvent(peer, bytes);
+		}
+	}
+}
+
+bool
+NetSession::snapshotDue(float deltaTime) {
+	// Las fotos siguen a la simulacin, no al reloj: a `kSnapshotHz` pasos simulados por segundo
+	m_serverTime += deltaTime;
+	m_sinceSnapshot += deltaTime;
+	if (m_sinceSnapshot < 1.0f / kSnapshotHz) {
+		return false;
+	}
+	m_sinceSnapshot = std::fmod(m_sinceSnapshot, 1.0f / kSnapshotHz);
+	return true;
+}
+
+void
+NetSession::sendSnapshot() {
+	uint32_t milliseconds = static_cast<uint32_t>(m_serverTime * 1000.0);
+	const unsigned char header[kSnapshotHeaderBytes] = { kSnapshotMessage, static_cast<unsigned char>(milliseconds >> 24),
+		static_cast<unsigned char>(milliseconds >> 16), static_cast<unsigned char>(milliseconds >> 8), static_cast<unsigned char>(milliseconds) };
+	m_replication.capture(m_states, header);
+	// Los clientes con la misma base comparten el bloque
+	for (UdpTransport::PeerId peer = 0; peer < m_clients.size(); ++peer) {
+		if (m_clients[peer] != kNoClient) {
+			selectView(m_clients[peer]);
+			NetBuffer snapshot = m_replication.message(m_clients[peer]);
+			countMessage(peer, snapshot.bytes(), true);
+			m_thread.send(peer, std::move(snapshot), NetDelivery::Unreliable);
+		}
+	}
+}
+
+void
+NetSession::selectView(ReplicationServer::ClientId client) {
+	bool hasArea = m_interest.hasArea(client);
+	SpatialGrid* grid = m_ids.empty() ? nullptr : EngineUtilities::TService<SpatialGrid>::get();
+	if (m_bandwidth == 0 && !hasArea) {
+		return;
+	}
+	m_relevant.clear();
+	if (hasArea && grid) {
+		m_found.clear();
+		grid->query(m_interest.interestArea(client), m_found);
+		for (Entity* entity : m_found) {
+			auto found = m_ids.find(entity);
+			if (found != m_ids.end()) {
+				m_relevant.push_back(found->second);
+			}
+		}
+		std::sort(m_relevant.begin(), m_relevant.end());
+	}
+	else if (hasArea) {
+		// Sin actores de la escena (fotos de `update` por estados) o sin grilla: se recorre la foto
+		sf::FloatRect area = m_interest.interestArea(client);
+		for (const NetActorState& state : m_states) {
+			if (area.contains(state.position())) {
+				m_relevant.push_back(state.id);
+			}
+		}
+	}
+	else {
+		for (const NetActorState& state : m_states) {
+			m_relevant.push_back(state.id);
+		}
+	}
+	size_t budget = m_bandwidth == 0 ? ~size_t(0) : static_cast<size_t>(m_bandwidth / kSnapshotHz);
+	m_interest.select(client, m_replication.current(), m_relevant, budget, m_view);
+	m_replication.setClientView(client, m_view);
+}
+
+void
+NetSession::updateClient(std::span<const EngineUtilities::TSharedPointer<Actor>> actors) {
+	double now = localTime();
+	bool acknowledge = false;
+	bool lost = false;
+	NetIncoming incoming;
+	while (m_thread.poll(incoming)) {
+		std::span<const unsigned char> bytes = incoming.bytes.bytes();
+		if (incoming.kind == NetIncoming::Kind::Disconnected) {
+			lost = true;
+		}
+		if (incoming.kind != NetIncoming::Kind::Message || bytes.empty()) {
+			continue;
+		}
+		countMessage(m_server, bytes, false);
+		if (bytes[0] == kSnapshotMessage) {
+			NetReader reader(bytes.subspan(1));
+			uint32_t milliseconds = 0;
+			std::span<const unsigned char> snapshot = (reader >> milliseconds).remaining();
+			if (reader && m_replicated.read(snapshot.data(), snapshot.size())) {
+				m_interpolator.push(milliseconds / 1000.0, m_replicated.actors(), now);
+				acknowledge = true;
+			}
+		}
+		else if (bytes[0] == kEventMessage) {
+			handleEvent(incoming.peer, bytes);
+		}
+	}
+	if (lost) {
+		MESSAGE("NetSession", "updateClient", "the server stopped answering");
+		close();
+		return;
+	}
+	if (acknowledge) {
+		NetBuffer ack = NetBuffer::acquire(kAckBytes);
+		ack << kAckMessage;
+		m_replicated.writeAck(ack);
+		if (m_interestArea.width > 0.0f) {
+			ack << m_interestArea.left << m_interestArea.top << m_interestArea.width << m_interestArea.height;
+		}
+		countMessage(m_server, ack.bytes(), true);
+		m_thread.send(m_server, std::move(ack), NetDelivery::Unreliable);
+	}
+	m_thread.flush();
+
+	if (m_interpolator.sample(now, m_states)) {
+		for (const NetActorState& state : m_states) {
+			if (state.id > 0 && state.id <= actors.size() && !actors[state.id - 1].isNull()) {
+				state.apply(*actors[state.id - 1]);
+			}
+		}
+	}
+}
+
+bool
+NetSession::sendEvent(std::span<const unsigned char> bytes) {
+	if (m_role == Role::None || bytes.size() + 1 > UdpTransport::maxPayload()) {
+		return false;
+	}
+	// Un bloque para todos: cada cola guarda una referencia
+	NetBuffer framed = NetBuffer::acquire(bytes.size() + 1);
+	framed << kEventMessage;
+	framed.append(bytes.data(), bytes.size());
+	if (m_role == Role::Client) {
+		countMessage(m_server, framed.bytes(), true);
+		return m_thread.send(m_server, framed, NetDelivery::Reliable);
+	}
+	bool all = true;
+	for (UdpTransport::PeerId peer = 0; peer < m_clients.size(); ++peer) {
+		if (m_clients[peer] != kNoClient) {
+			countMessage(peer, framed.bytes(), true);
+			all = m_thread.send(peer, framed, NetDelivery::Reliable) && all;
+		}
+	}
+	return all;
+}
+
+void
+NetSession::handleEvent(UdpTransport::PeerId peer, std::span<const unsigned char> bytes) {
+	if (m_onEvent) {
+		m_onEvent(peer, bytes.subspan(1));
+	}
+}
+
+void
+NetSession::countMessage(UdpTransport::PeerId peer, std::span<const unsigned char> bytes, bool outgoing) {
+	if (bytes.empty() || bytes[0] == 0 || bytes[0] > NetPeerStats::kMessageTypes) {
+		return;
+	}
+	if (peer >= m_traffic.size()) {
+		m_traffic.resize(peer + 1);
+	}
+	NetPeerStats& traffic = m_traffic[peer];
+	traffic.peer = peer;
+	size_t type = bytes[0] - 1;
+	(outgoing ? traffic.messagesOut : traffic.messagesIn)[type] += 1;
+	(outgoing ? traffic.bytesOut : traffic.bytesIn)[type] += bytes.size();
+	if (bytes[0] == kSnapshotMessage) {
+		traffic.snapshotBytes = static_cast<uint32_t>(bytes.size());
+		traffic.snapshotBytesMax = std::max(traffic.snapshotBytesMax, traffic.snapshotBytes);
+	}
+}
+
+size_t
+NetSession::peerLimit() const {
+	return m_role == Role::Client ? static_cast<size_t>(m_server) + 1 : m_clients.size();
+}
+
+size_t
+NetSession::clientCount() const {
+	return static_cast<size_t>(std::count_if(m_clients.begin(), m_clients.end(),
+		[](ReplicationServer::ClientId client) { return client != kNoClient; }));
+}
+
+bool
+NetSession::isPeer(UdpTransport::PeerId peer) const {
+	if (m_role == Role::Client) {
+		return peer == m_server;
+	}
+	return m_role == Role::Host && peer < m_clients.size() && m_clients[peer] != kNoClient;
+}
+
+void
+NetSession::stats(NetStats& out) const {
+	out.peers.clear();
+	out.total = NetPeerStats();
+	out.bytesOutPerSecond = m_bytesOutPerSecond;
+	out.bytesInPerSecond = m_bytesInPerSecond;
+	NetPeerStats& total = out.total;
+	for (UdpTransport::PeerId peer = 0; peer < peerLimit(); ++peer) {
+		if (!isPeer(peer)) {
+			continue;
+		}
+		NetPeerStats& stats = out.peers.emplace_back(peer < m_traffic.size() ? m_traffic[peer] : NetPeerStats());
+		stats.peer = peer;
+		stats.link = m_thread.linkStats(peer);
+		const NetLinkStats& link = stats.link;
+		total.link.datagramsOut += link.datagramsOut;
+		total.link.datagramsIn += link.datagramsIn;
+		total.link.bytesOut += link.bytesOut;
+		total.link.bytesIn += link.bytesIn;
+		total.link.acked += link.acked;
+		total.link.lost += link.lost;
+		total.link.resends += link.resends;
+		total.link.rttMs += link.rttMs;
+		total.link.jitterMs += link.jitterMs;
+		for (size_t i = 0; i < NetPeerStats::kMessageTypes; ++i) {
+			total.messagesOut[i] += stats.messagesOut[i];
+			total.messagesIn[i] += stats.messagesIn[i];
+			total.bytesOut[i] += stats.bytesOut[i];
+			total.bytesIn[i] += stats.bytesIn[i];
+		}
+		total.snapshotBytes = std::max(total.snapshotBytes, stats.snapshotBytes);
+		total.snapshotBytesMax = std::max(total.snapshotBytesMax, stats.snapshotBytesMax);
+	}
+	if (!out.peers.empty()) {
+		total.link.rttMs /= static_cast<float>(out.peers.size());
+		total.link.jitterMs /= static_cast<float>(out.peers.size());
+	}
+}
+
+void
+NetSession::updateRates() {
+	double now = localTime();
+	if (now - m_rateStart < 1.0) {
+		return;
+	}
+	uint64_t bytesOut = 0;
+	uint64_t bytesIn = 0;
+	for (UdpTransport::PeerId peer = 0; peer < peerLimit(); ++peer) {
+		if (isPeer(peer)) {
+			NetLinkStats link = m_thread.linkStats(peer);
+			bytesOut += link.bytesOut;
+			bytesIn += link.bytesIn;
+		}
+	}
+	// Un par que se fue se lleva sus bytes: ese segundo no cuenta
+	float seconds = static_cast<float>(now - m_rateStart);
+	m_bytesOutPerSecond = bytesOut >= m_rateBytesOut ? (bytesOut - m_rateBytesOut) / seconds : 0.0f;
+	m_bytesInPerSecond = bytesIn >= m_rateBytesIn ? (bytesIn - m_rateBytesIn) / seconds : 0.0f;
+	m_rateBytesOut = bytesOut;
+	m_rateBytesIn = bytesIn;
+	m_rateStart = now;
+}
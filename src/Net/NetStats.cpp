@@ -0,0 +1,79 @@
+#include "Net/NetStats.h"
+#include <cstdio>
+
+namespace {
+
+	constexpr const char* kMessageNames[NetPeerStats::kMessageTypes] = { "snapshot", "ack", "event" };
+
+	void
+	writeCsv(std::FILE* file, const char* name, const NetPeerStats& s) {
+		const NetLinkStats& l = s.link;
+		std::fprintf(file, "%s,%llu,%llu,%llu,%llu,%.3f,%.3f,%.5f,%llu,%u,%u", name,
+		             static_cast<unsigned long long>(l.datagramsOut), static_cast<unsigned long long>(l.datagramsIn),
+		             static_cast<unsigned long long>(l.bytesOut), static_cast<unsigned long long>(l.bytesIn), l.rttMs,
+		             l.jitterMs, l.loss(), static_cast<unsigned long long>(l.resends), s.snapshotBytes, s.snapshotBytesMax);
+		for (size_t i = 0; i < NetPeerStats::kMessageTypes; ++i) {
+			std::fprintf(file, ",%llu,%llu,%llu,%llu", static_cast<unsigned long long>(s.messagesOut[i]),
+			             static_cast<unsigned long long>(s.bytesOut[i]), static_cast<unsigned long long>(s.messagesIn[i]),
+			             static_cast<unsigned long long>(s.bytesIn[i]));
+		}
+		std::fprintf(file, "\n");
+	}
+
+	void
+	writeJson(std::FILE* file, const char* name, const NetPeerStats& s, bool last) {
+		const NetLinkStats& l = s.link;
+		std::fprintf(file,
+		             "  {\"peer\": \"%s\", \"datagrams_out\": %llu, \"datagrams_in\": %llu, \"bytes_out\": %llu, "
+		             "\"bytes_in\": %llu, \"rtt_ms\": %.3f, \"jitter_ms\": %.3f, \"loss\": %.5f, \"resends\": %llu, "
+		             "\"snapshot_bytes\": %u, \"snapshot_bytes_max\": %u", name,
+		             static_cast<unsigned long long>(l.datagramsOut), static_cast<unsigned long long>(l.datagramsIn),
+		             static_cast<unsigned long long>(l.bytesOut), static_cast<unsigned long long>(l.bytesIn), l.rttMs,
+		             l.jitterMs, l.loss(), static_cast<unsigned long long>(l.resends), s.snapshotBytes, s.snapshotBytesMax);
+		for (size_t i = 0; i < NetPeerStats::kMessageTypes; ++i) {
+			std::fprintf(file, ", \"%s\": {\"messages_out\": %llu, \"bytes_out\": %llu, \"messages_in\": %llu, \"bytes_in\": %llu}",
+			             kMessageNames[i], static_cast<unsigned long long>(s.messagesOut[i]),
+			             static_cast<unsigned long long>(s.bytesOut[i]), static_cast<unsigned long long>(s.messagesIn[i]),
+			             static_cast<unsigned long long>(s.bytesIn[i]));
+		}
+		std::fprintf(file, "}%s\n", last ? "" : ",");
+	}
+
+} // namespace
+
+bool
+NetStats::write(const std::string& path) const {
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if (!file) {
+		return false;
+	}
+	bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+	if (json) {
+		std::fprintf(file, "[\n");
+	}
+	else {
+		std::fprintf(file, "peer,datagrams_out,datagrams_in,bytes_out,bytes_in,rtt_ms,jitter_ms,loss,resends,snapshot_bytes,snapshot_bytes_max");
+		for (const char* name : kMessageNames) {
+			std::fprintf(file, ",%s_messages_out,%s_bytes_out,%s_messages_in,%s_bytes_in", name, name, name, name);
+		}
+		std::fprintf(file, "\n");
+	}
+	char name[16];
+	for (const NetPeerStats& peer : peers) {
+		std::snprintf(name, sizeof(name), "%u", peer.peer);
+		if (json) {
+			writeJson(file, name, peer, false);
+		}
+		else {
+			writeCsv(file, name, peer);
+		}
+	}
+	if (json) {
+		writeJson(file, "total", total, true);
+		std::fprintf(file, "]\n");
+	}
+	else {
+		writeCsv(file, "total", total);
+	}
+	return std::fclose(file) == 0;
+}
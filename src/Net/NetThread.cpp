@@ -0,0 +1,136 @@
+#include "Net/NetThread.h"
+#include <chrono>
+#include "Profiling/Profiler.h"
+
+void
+NetThread::start(UdpTransport& transport) {
+	stop();
+	m_transport = &transport;
+	m_stop.store(false, std::memory_order_relaxed);
+	m_thread = std::thread([this]() { run(); });
+}
+
+void
+NetThread::stop() {
+	if (!m_thread.joinable()) {
+		return;
+	}
+	m_stop.store(true, std::memory_order_relaxed);
+	m_thread.join();
+	NetIncoming discarded;
+	while (m_incoming.tryPop(discarded)) {
+	}
+	m_backlog.clear();
+	m_backlogFirst = 0;
+	m_transport = nullptr;
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	m_linkStats.clear();
+}
+
+bool
+NetThread::send(UdpTransport::PeerId peer, NetBuffer message, NetDelivery delivery) {
+	return m_outgoing.tryPush({ NetOutgoing::Kind::Send, peer, delivery, std::move(message) });
+}
+
+bool
+NetThread::disconnect(UdpTransport::PeerId peer) {
+	return m_outgoing.tryPush({ NetOutgoing::Kind::Disconnect, peer, NetDelivery::Unreliable, NetBuffer() });
+}
+
+void
+NetThread::flush() {
+	// Si no cabe, el hilo igual arma los datagramas a los `kFlushInterval`
+	m_outgoing.tryPush({ NetOutgoing::Kind::Flush, 0, NetDelivery::Unreliable, NetBuffer() });
+}
+
+void
+NetThread::run() {
+	using Clock = std::chrono::steady_clock;
+	Profiler::instance().setThreadName("Net");
+	Clock::time_point lastFlush = Clock::now();
+	while (!m_stop.load(std::memory_order_relaxed)) {
+		// Un servidor sin clientes casi no despierta: el primer datagrama lo saca del selector
+		int wait = m_transport->peerCount() ? kWaitMilliseconds : kIdleWaitMilliseconds;
+		m_transport->wait(wait / 1000.0f);
+		m_transport->receive();
+		deliverReceived();
+		bool flushNow = drainOutgoing();
+		Clock::time_point now = Clock::now();
+		if (flushNow || std::chrono::duration<float>(now - lastFlush).count() >= kFlushInterval) {
+			m_transport->flush();
+			publishStats();
+			lastFlush = now;
+		}
+	}
+	drainOutgoing();
+	m_transport->flush();
+}
+
+NetLinkStats
+NetThread::linkStats(UdpTransport::PeerId peer) const {
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	return peer < m_linkStats.size() ? m_linkStats[peer] : NetLinkStats();
+}
+
+void
+NetThread::publishStats() {
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	m_linkStats.resize(m_transport->peerSlots());
+	for (UdpTransport::PeerId peer = 0; peer < m_linkStats.size(); ++peer) {
+		m_linkStats[peer] = m_transport->linkStats(peer);
+	}
+}
+
+void
+NetThread::deliverReceived() {
+	auto queue = [this](NetIncoming&& incoming) {
+		// Con atraso, lo nuevo va detrs para no desordenar
+		if (m_backlogFirst == m_backlog.size() && m_incoming.tryPush(std::move(incoming))) {
+			return;
+		}
+		bool unreliable = incoming.kind == NetIncoming::Kind::Message && incoming.delivery == NetDelivery::Unreliable;
+		if (!unreliable || m_backlog.size() - m_backlogFirst < kMaxBacklog) {
+			m_backlog.push_back(std::move(incoming));
+		}
+	};
+	while (m_backlogFirst < m_backlog.size() && m_incoming.tryPush(std::move(m_backlog[m_backlogFirst]))) {
+		++m_backlogFirst;
+	}
+	if (m_backlogFirst == m_backlog.size() || m_backlogFirst >= kQueueCapacity) {
+		m_backlog.erase(m_backlog.begin(), m_backlog.begin() + m_backlogFirst);
+		m_backlogFirst = 0;
+	}
+
+	for (UdpTransport::PeerId peer : m_transport->connected()) {
+		queue({ NetIncoming::Kind::Connected, peer, NetDelivery::Unreliable, NetBuffer() });
+	}
+	for (const UdpTransport::Received& message : m_transport->received()) {
+		std::span<const unsigned char> bytes = m_transport->bytes(message);
+		NetBuffer buffer = NetBuffer::acquire(bytes.size());
+		buffer.append(bytes.data(), bytes.size());
+		queue({ NetIncoming::Kind::Message, message.peer, message.delivery, std::move(buffer) });
+	}
+	for (UdpTransport::PeerId peer : m_transport->disconnected()) {
+		queue({ NetIncoming::Kind::Disconnected, peer, NetDelivery::Unreliable, NetBuffer() });
+	}
+}
+
+bool
+NetThread::drainOutgoing() {
+	bool flushNow = false;
+	NetOutgoing outgoing;
+	while (m_outgoing.tryPop(outgoing)) {
+		switch (outgoing.kind) {
+		case NetOutgoing::Kind::Send:
+			m_transport->send(outgoing.peer, std::move(outgoing.bytes), outgoing.delivery);
+			break;
+		case NetOutgoing::Kind::Flush:
+			flushNow = true;
+			break;
+		case NetOutgoing::Kind::Disconnect:
+			m_transport->disconnect(outgoing.peer);
+			break;
+		}
+	}
+	return flushNow;
+}
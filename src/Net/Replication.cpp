@@ -0,0 +1,518 @@
+#include "Net/Replication.h"
+#include <algorithm>
+#include <cmath>
+#include "Actor.h"
+#include "Net/BitStream.h"
+
+namespace {
+	constexpr unsigned kFieldPosition = 1u << 0;
+	constexpr unsigned kFieldRotation = 1u << 1;
+	constexpr unsigned kFieldScale = 1u << 2;
+	constexpr unsigned kFieldShape = 1u << 3;    ///< Tipo y capa.
+	constexpr unsigned kFieldColor = 1u << 4;
+	constexpr unsigned kFieldBits = 5;
+
+	constexpr size_t kHeaderBytes = 16;         ///< Secuencias y los dos conteos.
+	constexpr size_t kMaxActorBytes = 32;        ///< Un actor nuevo con todo y su id, redondeado hacia arriba.
+
+	/**
+	 * @brief Si `a` es posterior a `b`, con vuelta a cero cada 65536 fotos.
+	 */
+	bool
+	newer(uint16_t a, uint16_t b) {
+		return static_cast<int16_t>(a - b) > 0;
+	}
+
+	bool
+	byId(const NetActorState& a, const NetActorState& b) {
+		return a.id < b.id;
+	}
+
+	unsigned
+	changedFields(const NetActorState& current, const NetActorState& base) {
+		unsigned fields = 0;
+		fields |= current.x != base.x || current.y != base.y ? kFieldPosition : 0;
+		fields |= current.rotation != base.rotation ? kFieldRotation : 0;
+		fields |= current.scaleX != base.scaleX || current.scaleY != base.scaleY ? kFieldScale : 0;
+		fields |= current.shape != base.shape || current.layer != base.layer ? kFieldShape : 0;
+		fields |= current.color != base.color ? kFieldColor : 0;
+		return fields;
+	}
+
+	/**
+	 * @brief Escribe los campos `fields` de `current`; la posicin como desplazamiento desde
+	 *        `base` si se tiene y cabe.
+	 */
+	void
+	writeFields(BitWriter& writer, const NetActorState& current, const NetActorState* base, unsigned fields) {
+		if (fields & kFieldPosition) {
+			int64_t dx = base ? int64_t(current.x) - base->x : 0;
+			int64_t dy = base ? int64_t(current.y) - base->y : 0;
+			bool small = base && BitWriter::fitsSigned(dx, NetActorState::kPositionDeltaBits) &&
+				BitWriter::fitsSigned(dy, NetActorState::kPositionDeltaBits);
+			if (base) {
+				writer.writeBool(small);
+			}
+			if (small) {
+				writer.writeSigned(static_cast<int32_t>(dx), NetActorState::kPositionDeltaBits);
+				writer.writeSigned(static_cast<int32_t>(dy), NetActorState::kPositionDeltaBits);
+			}
+			else {
+				writer.writeSigned(current.x, NetActorState::kPositionBits);
+				writer.writeSigned(current.y, NetActorState::kPositionBits);
+			}
+		}
+		if (fields & kFieldRotation) {
+			writer.write(current.rotation, NetActorState::kRotationBits);
+		}
+		if (fields & kFieldScale) {
+			writer.writeSigned(current.scaleX, NetActorState::kScaleBits);
+			writer.writeSigned(current.scaleY, NetActorState::kScaleBits);
+		}
+		if (fields & kFieldShape) {
+			writer.write(current.shape, 2);
+			writer.write(current.layer, 8);
+		}
+		if (fields & kFieldColor) {
+			writer.write(current.color, 32);
+		}
+	}
+
+	/**
+	 * @brief Inverso de `writeFields`, sobre `state` (que trae la base si hubo).
+	 */
+	void
+	readFields(BitReader& reader, NetActorState& state, bool hasBase, unsigned fields) {
+		if (fields & kFieldPosition) {
+			if (hasBase && reader.readBool()) {
+				state.x += reader.readSigned(NetActorState::kPositionDeltaBits);
+				state.y += reader.readSigned(NetActorState::kPositionDeltaBits);
+			}
+			else {
+				state.x = reader.readSigned(NetActorState::kPositionBits);
+				state.y = reader.readSigned(NetActorState::kPositionBits);
+			}
+		}
+		if (fields & kFieldRotation) {
+			state.rotation = static_cast<uint16_t>(reader.read(NetActorState::kRotationBits));
+		}
+		if (fields & kFieldScale) {
+			state.scaleX = static_cast<int16_t>(reader.readSigned(NetActorState::kScaleBits));
+			state.scaleY = static_cast<int16_t>(reader.readSigned(NetActorState::kScaleBits));
+		}
+		if (fields & kFieldShape) {
+			state.shape = static_cast<uint8_t>(reader.read(2));
+			state.layer = static_cast<uint8_t>(reader.read(8));
+		}
+		if (fields & kFieldColor) {
+			state.color = reader.read(32);
+		}
+	}
+
+	/**
+	 * @brief Recorre `current` y `baseline` (los dos por id) a la vez: `changed(actor, base)`
+	 *        por cada actor nuevo (`base` nula) o distinto, y `removed(id)` por cada uno que ya no est.
+	 */
+	template<typename Changed, typename Removed>
+	void
+	diff(std::span<const NetActorState> current, std::span<const NetActorState> baseline, Changed&& changed,
+		Removed&& removed) {
+		size_t b = 0;
+		for (const NetActorState& actor : current) {
+			while (b < baseline.size() && baseline[b].id < actor.id) {
+				removed(baseline[b++].id);
+			}
+			if (b < baseline.size() && baseline[b].id == actor.id) {
+				if (changedFields(actor, baseline[b])) {
+					changed(actor, &baseline[b]);
+				}
+				++b;
+			}
+			else {
+				changed(actor, nullptr);
+			}
+		}
+		for (; b < baseline.size(); ++b) {
+			removed(baseline[b].id);
+		}
+	}
+}
+
+NetActorState
+NetActorState::capture(uint32_t id, const Actor& actor) {
+	NetActorState state;
+	state.id = id;
+	state.scaleX = static_cast<int16_t>(kScaleScale);
+	state.scaleY = static_cast<int16_t>(kScaleScale);
+	if (const Transform* transform = actor.findComponent<Transform>()) {
+		const int32_t positionLimit = (1 << (kPositionBits - 1)) - 1;
+		auto position = [positionLimit](float value) {
+			return static_cast<int32_t>(std::clamp<long>(std::lround(value * kPositionScale), -positionLimit, positionLimit));
+		};
+		auto scale = [](float value) {
+			return static_cast<int16_t>(std::clamp<long>(std::lround(value * kScaleScale), INT16_MIN, INT16_MAX));
+		};
+		state.x = position(transform->getPosition().x);
+		state.y = position(transform->getPosition().y);
+		float turn = std::fmod(transform->getRotation(), 360.0f) / 360.0f;
+		turn += turn < 0.0f ? 1.0f : 0.0f;
+		state.rotation = static_cast<uint16_t>(std::lround(turn * (1u << kRotationBits)) & ((1u << kRotationBits) - 1));
+		state.scaleX = scale(transform->getScale().x);
+		state.scaleY = scale(transform->getScale().y);
+	}
+	if (const ShapeFactory* shape = actor.findComponent<ShapeFactory>()) {
+		state.shape = static_cast<uint8_t>(shape->getShapeType());
+		state.layer = shape->getLayer();
+		state.color = shape->getShape() ? shape->getFillColor().toInteger() : 0;
+	}
+	return state;
+}
+
+void
+NetActorState::apply(Actor& actor) const {
+	// Solo lo distinto: cada `set` marca el componente como cambiado
+	if (Transform* transform = actor.findComponent<Transform>()) {
+		if (transform->getPosition() != position()) {
+			transform->setPosition(position());
+		}
+		if (transform->getRotation() != degrees()) {
+			transform->setRotation(degrees());
+		}
+		if (transform->getScale() != scale()) {
+			transform->setScale(scale());
+		}
+	}
+	if (ShapeFactory* shape = actor.findComponent<ShapeFactory>()) {
+		if (shape->getShapeType() != static_cast<ShapeType>(this->shape)) {
+			shape->createShape(static_cast<ShapeType>(this->shape));
+		}
+		if (shape->getShape() && shape->getFillColor() != sf::Color(color)) {
+			shape->setFillColor(sf::Color(color));
+		}
+		if (shape->getLayer() != layer) {
+			shape->setLayer(layer);
+		}
+	}
+}
+
+float
+NetActorState::degrees() const {
+	return rotation * (360.0f / (1u << kRotationBits));
+}
+
+void
+ReplicationServer::capture(std::span<const NetActorState> actors, std::span<const unsigned char> header) {
+	++m_sequence;
+	Snapshot& snapshot = m_history[m_sequence % kHistory];
+	snapshot.sequence = m_sequence;
+	snapshot.valid = true;
+	snapshot.actors.assign(actors.begin(), actors.end());
+	std::sort(snapshot.actors.begin(), snapshot.actors.end(), byId);
+	// Lo que ya se encol sigue vivo en el transporte; aqu solo se suelta
+	for (size_t i = 0; i < m_encodedCount; ++i) {
+		m_encoded[i].buffer = NetBuffer();
+	}
+	m_encodedCount = 0;
+	m_header.assign(header.begin(), header.end());
+}
+
+ReplicationServer::ClientId
+ReplicationServer::addClient() {
+	ClientId client;
+	if (!m_freeClients.empty()) {
+		client = m_freeClients.back();
+		m_freeClients.pop_back();
+	}
+	else {
+		client = static_cast<ClientId>(m_clients.size());
+		m_clients.emplace_back();
+	}
+	m_clients[client] = Client{};
+	m_clients[client].active = true;
+	return client;
+}
+
+void
+ReplicationServer::removeClient(ClientId client) {
+	if (client < m_clients.size() && m_clients[client].active) {
+		m_clients[client].active = false;
+		m_freeClients.push_back(client);
+	}
+}
+
+void
+ReplicationServer::acknowledge(ClientId client, uint16_t sequence) {
+	if (client >= m_clients.size() || !m_clients[client].active || newer(sequence, m_sequence)) {
+		return;
+	}
+	Client& state = m_clients[client];
+	if (!state.hasAck || newer(sequence, state.acked)) {
+		state.acked = sequence;
+		state.hasAck = true;
+	}
+}
+
+bool
+ReplicationServer::readAck(ClientId client, sf::Packet& packet) {
+	sf::Uint16 sequence = 0;
+	if (!(packet >> sequence)) {
+		return false;
+	}
+	acknowledge(client, sequence);
+	return true;
+}
+
+bool
+ReplicationServer::readAck(ClientId client, NetReader& reader) {
+	uint16_t sequence = 0;
+	if (!(reader >> sequence)) {
+		return false;
+	}
+	acknowledge(client, sequence);
+	return true;
+}
+
+const ReplicationServer::Snapshot*
+ReplicationServer::find(uint16_t sequence) const {
+	const Snapshot& snapshot = m_history[sequence % kHistory];
+	return snapshot.valid && snapshot.sequence == sequence ? &snapshot : nullptr;
+}
+
+void
+ReplicationServer::setClientView(ClientId client, std::span<const NetActorState> view) {
+	if (client >= m_clients.size() || !m_clients[client].active) {
+		return;
+	}
+	Client& state = m_clients[client];
+	if (state.views.empty()) {
+		// Lo que confirm hasta ahora era de la foto entera, no de su anillo
+		state.views.resize(kHistory);
+		state.hasAck = false;
+	}
+	Snapshot& slot = state.views[m_sequence % kHistory];
+	slot.sequence = m_sequence;
+	slot.valid = true;
+	slot.actors.assign(view.begin(), view.end());
+}
+
+std::span<const NetActorState>
+ReplicationServer::current() const {
+	const Snapshot* snapshot = find(m_sequence);
+	return snapshot ? std::span<const NetActorState>(snapshot->actors) : std::span<const NetActorState>();
+}
+
+NetBuffer
+ReplicationServer::message(ClientId client) {
+	if (client >= m_clients.size() || !m_clients[client].active || !find(m_sequence)) {
+		return NetBuffer();
+	}
+	Client& state = m_clients[client];
+	if (!state.views.empty()) {
+		Snapshot& view = state.views[m_sequence % kHistory];
+		if (!view.valid || view.sequence != m_sequence) {
+			setClientView(client, current());
+		}
+		const Snapshot& base = state.views[state.acked % kHistory];
+		bool hasBase = state.hasAck && base.valid && base.sequence == state.acked;
+		NetBuffer buffer = encodeMessage(view.actors, hasBase ? &base.actors : nullptr, state.acked);
+		return buffer.overflowed() ? NetBuffer() : buffer;
+	}
+	const Snapshot* base = state.hasAck ? find(state.acked) : nullptr;
+	Encoded* encoded = nullptr;
+	for (size_t i = 0; i < m_encodedCount && !encoded; ++i) {
+		if (m_encoded[i].full == !base && (!base || m_encoded[i].baseline == state.acked)) {
+			encoded = &m_encoded[i];
+		}
+	}
+	if (!encoded) {
+		if (m_encodedCount == m_encoded.size()) {
+			m_encoded.emplace_back();
+		}
+		encoded = &m_encoded[m_encodedCount++];
+		encoded->full = !base;
+		encoded->baseline = state.acked;
+		encoded->buffer = encodeMessage(current(), base ? &base->actors : nullptr, state.acked);
+	}
+	return encoded->buffer.overflowed() ? NetBuffer() : encoded->buffer;
+}
+
+size_t
+ReplicationServer::write(ClientId client, sf::Packet& packet) {
+	NetBuffer buffer = message(client);
+	packet.append(buffer.data(), buffer.size());
+	return buffer.size();
+}
+
+size_t
+ReplicationServer::Counts::bound() const {
+	return kHeaderBytes + (changed + removed) * kMaxActorBytes;
+}
+
+ReplicationServer::Counts
+ReplicationServer::count(std::span<const NetActorState> actors, std::span<const NetActorState> baseline) {
+	Counts counts;
+	diff(actors, baseline, [&counts](const NetActorState&, const NetActorState*) { ++counts.changed; },
+		[&counts](uint32_t) { ++counts.removed; });
+	return counts;
+}
+
+void
+ReplicationServer::encode(const std::vector<NetActorState>* baseline, uint16_t baselineSequence,
+	std::vector<unsigned char>& bytes) const {
+	std::span<const NetActorState> base = baseline ? std::span<const NetActorState>(*baseline) : std::span<const NetActorState>();
+	Counts counts = count(current(), base);
+	bytes.resize(counts.bound());
+	BitWriter writer(bytes.data(), bytes.size());
+	encode(current(), baseline, baselineSequence, counts, writer);
+	bytes.resize(writer.bytes());
+}
+
+NetBuffer
+ReplicationServer::encodeMessage(std::span<const NetActorState> actors, const std::vector<NetActorState>* baseline,
+	uint16_t baselineSequence) const {
+	// Directo en el bloque que se va a mandar; la cota es holgada y casi nunca pasa del tope
+	std::span<const NetActorState> base = baseline ? std::span<const NetActorState>(*baseline) : std::span<const NetActorState>();
+	Counts counts = count(actors, base);
+	NetBuffer buffer = NetBuffer::acquire(std::min(m_header.size() + counts.bound(), NetBufferPool::kLargeBytes));
+	buffer.append(m_header.data(), m_header.size());
+	BitWriter writer = buffer.bits();
+	encode(actors, baseline, baselineSequence, counts, writer);
+	buffer.commit(writer);
+	return buffer;
+}
+
+void
+ReplicationServer::encode(std::span<const NetActorState> actors, const std::vector<NetActorState>* baseline,
+	uint16_t baselineSequence, Counts counts, BitWriter& writer) const {
+	std::span<const NetActorState> base = baseline ? std::span<const NetActorState>(*baseline) : std::span<const NetActorState>();
+	writer.write(m_sequence, 16);
+	writer.writeBool(baseline != nullptr);
+	if (baseline) {
+		writer.write(baselineSequence, 16);
+	}
+
+	// Los ids van en orden, como distancia al siguiente posible
+	writer.writeVarint(counts.changed);
+	uint32_t next = 0;
+	diff(actors, base, [&writer, &next](const NetActorState& actor, const NetActorState* previous) {
+		writer.writeVarint(actor.id - next);
+		next = actor.id + 1;
+		writer.writeBool(previous == nullptr);
+		unsigned fields = previous ? changedFields(actor, *previous) : (1u << kFieldBits) - 1;
+		if (previous) {
+			writer.write(fields, kFieldBits);
+		}
+		writeFields(writer, actor, previous, fields);
+	}, [](uint32_t) {});
+	writer.writeVarint(counts.removed);
+	next = 0;
+	diff(actors, base, [](const NetActorState&, const NetActorState*) {}, [&writer, &next](uint32_t id) {
+		writer.writeVarint(id - next);
+		next = id + 1;
+	});
+}
+
+bool
+ReplicationClient::read(const sf::Packet& packet) {
+	return read(static_cast<const unsigned char*>(packet.getData()), packet.getDataSize());
+}
+
+bool
+ReplicationClient::read(const unsigned char* data, size_t size) {
+	BitReader reader(data, size);
+	uint16_t sequence = static_cast<uint16_t>(reader.read(16));
+	bool hasBase = reader.readBool();
+	uint16_t baseSequence = hasBase ? static_cast<uint16_t>(reader.read(16)) : 0;
+	if (reader.overflowed() || (m_hasLatest && !newer(sequence, m_latest))) {
+		return false;
+	}
+	const Snapshot* base = nullptr;
+	if (hasBase) {
+		const Snapshot& slot = m_history[baseSequence % kHistory];
+		if (!slot.valid || slot.sequence != baseSequence) {
+			return false;
+		}
+		base = &slot;
+	}
+	std::span<const NetActorState> baseline = base ? std::span<const NetActorState>(base->actors) : std::span<const NetActorState>();
+
+	m_changed.clear();
+	uint32_t count = reader.readVarint();
+	uint32_t next = 0;
+	for (uint32_t i = 0; i < count && !reader.overflowed(); ++i) {
+		NetActorState state;
+		state.id = next + reader.readVarint();
+		next = state.id + 1;
+		bool isNew = reader.readBool();
+		if (!isNew) {
+			auto found = std::lower_bound(baseline.begin(), baseline.end(), state, byId);
+			if (found == baseline.end() || found->id != state.id) {
+				return false;
+			}
+			state = *found;
+		}
+		readFields(reader, state, !isNew, isNew ? (1u << kFieldBits) - 1 : reader.read(kFieldBits));
+		m_changed.push_back(state);
+	}
+	m_removed.clear();
+	count = reader.readVarint();
+	next = 0;
+	for (uint32_t i = 0; i < count && !reader.overflowed(); ++i) {
+		m_removed.push_back(next + reader.readVarint());
+		next = m_removed.back() + 1;
+	}
+	if (reader.overflowed()) {
+		return false;
+	}
+
+	// La base sin lo que se fue y con lo que cambi; los tres van por id
+	m_decoded.clear();
+	size_t c = 0;
+	size_t r = 0;
+	for (const NetActorState& actor : baseline) {
+		while (c < m_changed.size() && m_changed[c].id < actor.id) {
+			m_decoded.push_back(m_changed[c++]);
+		}
+		while (r < m_removed.size() && m_removed[r] < actor.id) {
+			++r;
+		}
+		if (c < m_changed.size() && m_changed[c].id == actor.id) {
+			m_decoded.push_back(m_changed[c++]);
+		}
+		else if (r >= m_removed.size() || m_removed[r] != actor.id) {
+			m_decoded.push_back(actor);
+		}
+	}
+	m_decoded.insert(m_decoded.end(), m_changed.begin() + c, m_changed.end());
+
+	Snapshot& slot = m_history[sequence % kHistory];
+	slot.actors.swap(m_decoded);
+	slot.sequence = sequence;
+	slot.valid = true;
+	m_latest = sequence;
+	m_hasLatest = true;
+	return true;
+}
+
+bool
+ReplicationClient::writeAck(sf::Packet& packet) const {
+	if (!m_hasLatest) {
+		return false;
+	}
+	packet << sf::Uint16(m_latest);
+	return true;
+}
+
+bool
+ReplicationClient::writeAck(NetBuffer& buffer) const {
+	if (!m_hasLatest) {
+		return false;
+	}
+	buffer << m_latest;
+	return !buffer.overflowed();
+}
+
+std::span<const NetActorState>
+ReplicationClient::actors() const {
+	return m_hasLatest ? std::span<const NetActorState>(m_history[m_latest % kHistory].actors) : std::span<const NetActorState>();
+}
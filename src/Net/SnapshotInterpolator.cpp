@@ -0,0 +1,80 @@
+#include "Net/SnapshotInterpolator.h"
+#include <cmath>
+
+namespace {
+	int32_t
+	mix(int32_t from, int32_t to, double t) {
+		return from + static_cast<int32_t>(std::lround((to - from) * t));
+	}
+}
+
+void
+SnapshotInterpolator::push(double serverTime, std::span<const NetActorState> actors, double localTime) {
+	if (m_count > 0 && serverTime <= at(m_count - 1).serverTime) {
+		return;
+	}
+	double offset = serverTime - localTime;
+	if (!m_hasOffset || offset > m_offset) {
+		m_offset = offset;
+		m_hasOffset = true;
+	}
+	else {
+		m_offset += (offset - m_offset) * kClockFollow;
+	}
+	if (m_count == kCapacity) {
+		m_first = (m_first + 1) % kCapacity;
+		--m_count;
+	}
+	Snapshot& snapshot = m_ring[(m_first + m_count) % kCapacity];
+	snapshot.serverTime = serverTime;
+	snapshot.actors.assign(actors.begin(), actors.end());
+	++m_count;
+}
+
+bool
+SnapshotInterpolator::sample(double localTime, std::vector<NetActorState>& out) const {
+	if (m_count == 0) {
+		return false;
+	}
+	double target = localTime + m_offset - m_delay;
+	size_t next = 0;
+	while (next < m_count && at(next).serverTime <= target) {
+		++next;
+	}
+	// Antes de la primera o despus de la ltima: esa, sin interpolar
+	if (next == 0 || next == m_count) {
+		const Snapshot& held = at(next == 0 ? 0 : m_count - 1);
+		out.assign(held.actors.begin(), held.actors.end());
+		return true;
+	}
+	const Snapshot& from = at(next - 1);
+	const Snapshot& to = at(next);
+	double t = (target - from.serverTime) / (to.serverTime - from.serverTime);
+
+	// Los de la foto siguiente; los que ya estaban se mezclan con su estado anterior
+	out.clear();
+	size_t previous = 0;
+	for (const NetActorState& later : to.actors) {
+		while (previous < from.actors.size() && from.actors[previous].id < later.id) {
+			++previous;
+		}
+		if (previous == from.actors.size() || from.actors[previous].id != later.id) {
+			out.push_back(later);
+			continue;
+		}
+		const NetActorState& earlier = from.actors[previous];
+		NetActorState state = earlier;
+		state.x = mix(earlier.x, later.x, t);
+		state.y = mix(earlier.y, later.y, t);
+		state.scaleX = static_cast<int16_t>(mix(earlier.scaleX, later.scaleX, t));
+		state.scaleY = static_cast<int16_t>(mix(earlier.scaleY, later.scaleY, t));
+		const int32_t turn = 1 << NetActorState::kRotationBits;
+		int32_t arc = (later.rotation - earlier.rotation) & (turn - 1);
+		if (arc >= turn / 2) {
+			arc -= turn;
+		}
+		state.rotation = static_cast<uint16_t>(mix(earlier.rotation, earlier.rotation + arc, t) & (turn - 1));
+		out.push_back(state);
+	}
+	return true;
+}
@@ -0,0 +1,461 @@
+#include "Net/UdpTransport.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	constexpr uint8_t kKindUnreliable = 0;
+	constexpr uint8_t kKindReliable = 1;
+	constexpr uint8_t kKindFragment = 2;
+	constexpr int kMaxDatagramsPerReceive = 4096;   ///< Para no quedarse leyendo si no dejan de llegar.
+
+	void
+	put16(unsigned char* at, uint16_t value) {
+		at[0] = static_cast<unsigned char>(value);
+		at[1] = static_cast<unsigned char>(value >> 8);
+	}
+
+	void
+	put32(unsigned char* at, uint32_t value) {
+		put16(at, static_cast<uint16_t>(value));
+		put16(at + 2, static_cast<uint16_t>(value >> 16));
+	}
+
+	uint16_t
+	get16(const unsigned char* at) {
+		return static_cast<uint16_t>(at[0] | (at[1] << 8));
+	}
+
+	uint32_t
+	get32(const unsigned char* at) {
+		return get16(at) | (uint32_t(get16(at + 2)) << 16);
+	}
+}
+
+bool
+UdpTransport::bind(unsigned short port) {
+	unbind();
+	m_socket.setBlocking(false);
+	m_bound = m_socket.bind(port) == sf::Socket::Done;
+	if (m_bound) {
+		m_selector.add(m_socket);
+	}
+	return m_bound;
+}
+
+void
+UdpTransport::unbind() {
+	if (m_bound) {
+		m_selector.clear();
+		m_socket.unbind();
+		m_bound = false;
+	}
+	m_peers.clear();
+	m_freePeers.clear();
+	m_byEndpoint.clear();
+	m_inbox.clear();
+	m_received.clear();
+	m_connected.clear();
+	m_disconnected.clear();
+}
+
+UdpTransport::PeerId
+UdpTransport::connect(const sf::IpAddress& address, unsigned short port) {
+	auto found = m_byEndpoint.find(endpointKey(address, port));
+	return found != m_byEndpoint.end() ? found->second : addPeer(address, port, now());
+}
+
+UdpTransport::PeerId
+UdpTransport::addPeer(const sf::IpAddress& address, unsigned short port, double time) {
+	PeerId id;
+	if (!m_freePeers.empty()) {
+		id = m_freePeers.back();
+		m_freePeers.pop_back();
+	}
+	else {
+		id = static_cast<PeerId>(m_peers.size());
+		m_peers.emplace_back();
+	}
+	Peer& peer = m_peers[id];
+	peer = Peer();
+	peer.address = address;
+	peer.port = port;
+	peer.active = true;
+	// Las secuencias empiezan en 1: la confirmacin 0 de quien no recibi nada no confirma nada
+	peer.localSequence = 1;
+	peer.lastReceived = time;
+	peer.lastSent = time - kKeepAliveSeconds;
+	m_byEndpoint[endpointKey(address, port)] = id;
+	return id;
+}
+
+void
+UdpTransport::disconnect(PeerId id) {
+	if (!isConnected(id)) {
+		return;
+	}
+	Peer& peer = m_peers[id];
+	peer.active = false;
+	m_byEndpoint.erase(endpointKey(peer.address, peer.port));
+	m_freePeers.push_back(id);
+}
+
+bool
+UdpTransport::send(PeerId id, std::span<const unsigned char> message, NetDelivery delivery) {
+	if (message.size() > kMaxMessageBytes) {
+		return false;
+	}
+	NetBuffer buffer = NetBuffer::acquire(message.size());
+	buffer.append(message.data(), message.size());
+	return send(id, std::move(buffer), delivery);
+}
+
+bool
+UdpTransport::send(PeerId id, NetBuffer message, NetDelivery delivery) {
+	if (!isConnected(id) || !message || message.overflowed()) {
+		return false;
+	}
+	Peer& peer = m_peers[id];
+	const size_t size = message.size();
+	if (delivery == NetDelivery::Reliable) {
+		if (size > maxPayload() || peer.reliableOut.size() >= kMaxPendingReliable) {
+			return false;
+		}
+		PendingReliable& pending = peer.reliableOut.emplace_back();
+		pending.id = peer.nextReliableId++;
+		pending.bytes = std::move(message);
+		return true;
+	}
+
+	const size_t whole = kMtu - kHeaderBytes - kMessageHeaderBytes;
+	size_t count = size <= whole ? 1 : (size + kFragmentBytes - 1) / kFragmentBytes;
+	if (count > kMaxFragments) {
+		return false;
+	}
+	if (size <= whole) {
+		peer.queued.push_back({ std::move(message), 0, size });
+		return true;
+	}
+	// Los fragmentos son tramos del mismo bloque
+	uint16_t group = peer.nextGroup++;
+	for (size_t index = 0; index < count; ++index) {
+		size_t offset = index * kFragmentBytes;
+		peer.queued.push_back({ message, offset, std::min(kFragmentBytes, size - offset), group,
+			static_cast<uint8_t>(index), static_cast<uint8_t>(count) });
+	}
+	return true;
+}
+
+void
+UdpTransport::flush() {
+	if (!m_bound) {
+		return;
+	}
+	double time = now();
+	for (Peer& peer : m_peers) {
+		if (peer.active) {
+			flushPeer(peer, time);
+		}
+	}
+}
+
+void
+UdpTransport::flushPeer(Peer& peer, double time) {
+	const double resend = std::max(kMinResendSeconds, peer.rtt * 1.5f);
+	auto due = [time, resend](const PendingReliable& pending) {
+		return pending.lastSent < 0.0 || time - pending.lastSent >= resend;
+	};
+	size_t next = 0;
+	bool sentAny = false;
+	while (true) {
+		Sent& sent = peer.sent[peer.localSequence % kSentHistory];
+		sent.reliableCount = 0;
+		size_t used = kHeaderBytes;
+
+		// Primero lo crtico que toca (re)enviar; despus lo dems, en orden, mientras quepa
+		for (PendingReliable& pending : peer.reliableOut) {
+			// Ms all de la ventana el otro lado lo descartara, pero confirmara el datagrama
+			uint16_t ahead = pending.id - peer.reliableOut.front().id;
+			if (sent.reliableCount == kMaxReliablePerDatagram || ahead >= kReliableWindow) {
+				break;
+			}
+			if (!due(pending) || used + kReliableHeaderBytes + pending.bytes.size() > kMtu) {
+				continue;
+			}
+			unsigned char* at = m_datagram.data() + used;
+			at[0] = kKindReliable;
+			put16(at + 1, static_cast<uint16_t>(pending.bytes.size()));
+			put16(at + 3, pending.id);
+			std::memcpy(at + kReliableHeaderBytes, pending.bytes.data(), pending.bytes.size());
+			used += kReliableHeaderBytes + pending.bytes.size();
+			if (pending.lastSent >= 0.0) {
+				++peer.stats.resends;
+			}
+			pending.lastSent = time;
+			sent.reliable[sent.reliableCount++] = pending.id;
+		}
+		for (; next < peer.queued.size(); ++next) {
+			const Queued& queued = peer.queued[next];
+			size_t header = queued.count ? kFragmentHeaderBytes : kMessageHeaderBytes;
+			if (used + header + queued.size > kMtu) {
+				break;
+			}
+			unsigned char* at = m_datagram.data() + used;
+			at[0] = queued.count ? kKindFragment : kKindUnreliable;
+			put16(at + 1, static_cast<uint16_t>(queued.size));
+			if (queued.count) {
+				put16(at + 3, queued.group);
+				at[5] = queued.index;
+				at[6] = queued.count;
+			}
+			std::memcpy(at + header, queued.buffer.data() + queued.offset, queued.size);
+			used += header + queued.size;
+		}
+
+		// Vaco solo para confirmar lo recibido o no dejar vencer al par
+		bool idle = used == kHeaderBytes;
+		if (idle && (sentAny || (!peer.ackPending && time - peer.lastSent < kKeepAliveSeconds))) {
+			break;
+		}
+		put32(m_datagram.data(), kProtocolId);
+		put16(m_datagram.data() + 4, peer.localSequence);
+		put16(m_datagram.data() + 6, peer.remoteSequence);
+		put32(m_datagram.data() + 8, peer.remoteBits);
+		// El lugar es de hace `kSentHistory` datagramas: si nadie lo confirm, se perdi
+		if (sent.valid && !sent.acked) {
+			++peer.stats.lost;
+		}
+		sent.sequence = peer.localSequence;
+		sent.valid = true;
+		sent.acked = false;
+		sent.time = time;
+		m_socket.send(m_datagram.data(), used, peer.address, peer.port);
+		++peer.stats.datagramsOut;
+		peer.stats.bytesOut += used;
+		if (++peer.localSequence == 0) {
+			peer.localSequence = 1;
+		}
+		peer.lastSent = time;
+		peer.ackPending = false;
+		sentAny = true;
+		if (idle || (next == peer.queued.size() && std::none_of(peer.reliableOut.begin(), peer.reliableOut.end(), due))) {
+			break;
+		}
+	}
+	peer.queued.clear();
+}
+
+void
+UdpTransport::receive() {
+	m_inbox.clear();
+	m_received.clear();
+	m_connected.clear();
+	m_disconnected.clear();
+	if (!m_bound) {
+		return;
+	}
+	double time = now();
+	std::array<unsigned char, kMtu> buffer;
+	for (int i = 0; i < kMaxDatagramsPerReceive; ++i) {
+		size_t size = 0;
+		sf::IpAddress sender;
+		unsigned short port = 0;
+		sf::Socket::Status status = m_socket.receive(buffer.data(), buffer.size(), size, sender, port);
+		if (status == sf::Socket::NotReady) {
+			break;
+		}
+		if (status != sf::Socket::Done || size < kHeaderBytes || get32(buffer.data()) != kProtocolId) {
+			continue;
+		}
+		auto found = m_byEndpoint.find(endpointKey(sender, port));
+		PeerId peer;
+		if (found != m_byEndpoint.end()) {
+			peer = found->second;
+		}
+		else if (m_accepting) {
+			peer = addPeer(sender, port, time);
+			m_connected.push_back(peer);
+		}
+		else {
+			continue;
+		}
+		processDatagram(peer, buffer.data(), size, time);
+	}
+	for (PeerId id = 0; id < m_peers.size(); ++id) {
+		if (m_peers[id].active && time - m_peers[id].lastReceived > kTimeoutSeconds) {
+			disconnect(id);
+			m_disconnected.push_back(id);
+		}
+	}
+}
+
+bool
+UdpTransport::wait(float seconds) {
+	return m_bound && m_selector.wait(sf::seconds(seconds));
+}
+
+void
+UdpTransport::processDatagram(PeerId id, const unsigned char* data, size_t size, double time) {
+	Peer& peer = m_peers[id];
+	++peer.stats.datagramsIn;
+	peer.stats.bytesIn += size;
+	uint16_t sequence = get16(data + 4);
+	if (!peer.hasRemote) {
+		peer.remoteSequence = sequence;
+		peer.remoteBits = 0;
+		peer.hasRemote = true;
+	}
+	else {
+		int distance = static_cast<int16_t>(sequence - peer.remoteSequence);
+		if (distance > 0) {
+			uint32_t shifted = distance < 32 ? peer.remoteBits << distance : 0;
+			peer.remoteBits = shifted | (distance <= 32 ? 1u << (distance - 1) : 0u);
+			peer.remoteSequence = sequence;
+		}
+		else {
+			// Repetido o muy viejo: lo que traa ya se entreg o ya no sirve
+			int back = -distance - 1;
+			if (distance == 0 || back >= 32 || (peer.remoteBits & (1u << back))) {
+				return;
+			}
+			peer.remoteBits |= 1u << back;
+		}
+	}
+	peer.lastReceived = time;
+	peer.ackPending = true;
+
+	uint16_t ack = get16(data + 6);
+	uint32_t ackBits = get32(data + 8);
+	acknowledge(peer, ack, time);
+	for (uint16_t bit = 0; bit < 32; ++bit) {
+		if (ackBits & (1u << bit)) {
+			acknowledge(peer, static_cast<uint16_t>(ack - 1 - bit), time);
+		}
+	}
+	// Ya no entra en los bits de ninguna confirmacin
+	expire(peer, static_cast<uint16_t>(ack - 33));
+
+	const size_t chunk = kFragmentBytes;
+	size_t offset = kHeaderBytes;
+	while (offset + kMessageHeaderBytes <= size) {
+		const unsigned char* at = data + offset;
+		uint8_t kind = at[0];
+		size_t length = get16(at + 1);
+		size_t header = kind == kKindReliable ? kReliableHeaderBytes : kind == kKindFragment ? kFragmentHeaderBytes : kMessageHeaderBytes;
+		if (kind > kKindFragment || offset + header + length > size) {
+			return;
+		}
+		const unsigned char* payload = at + header;
+		offset += header + length;
+
+		if (kind == kKindUnreliable) {
+			deliver(id, NetDelivery::Unreliable, payload, length);
+		}
+		else if (kind == kKindReliable) {
+			uint16_t messageId = get16(at + 3);
+			int ahead = static_cast<int16_t>(messageId - peer.nextExpected);
+			if (ahead < 0 || ahead >= static_cast<int>(kReliableWindow)) {
+				continue;
+			}
+			if (ahead > 0) {
+				size_t slot = messageId % kReliableWindow;
+				if (!peer.reliableInValid[slot]) {
+					peer.reliableIn[slot].assign(payload, payload + length);
+					peer.reliableInValid[slot] = true;
+				}
+				continue;
+			}
+			// El que se esperaba, y los que ya haban llegado detrs de l
+			deliver(id, NetDelivery::Reliable, payload, length);
+			++peer.nextExpected;
+			while (peer.reliableInValid[peer.nextExpected % kReliableWindow]) {
+				size_t slot = peer.nextExpected % kReliableWindow;
+				deliver(id, NetDelivery::Reliable, peer.reliableIn[slot].data(), peer.reliableIn[slot].size());
+				peer.reliableInValid[slot] = false;
+				++peer.nextExpected;
+			}
+		}
+		else {
+			uint16_t group = get16(at + 3);
+			uint8_t index = at[5];
+			uint8_t count = at[6];
+			if (count < 2 || count > kMaxFragments || index >= count || (index + 1 < count && length != chunk)) {
+				continue;
+			}
+			bool assembling = peer.assemblingCount != 0;
+			if (!assembling || group != peer.assemblingGroup) {
+				// Un grupo nuevo reemplaza al que est a medias; uno viejo se ignora
+				if (assembling && static_cast<int16_t>(group - peer.assemblingGroup) < 0) {
+					continue;
+				}
+				peer.assemblingGroup = group;
+				peer.assemblingCount = count;
+				peer.assemblingMask = 0;
+				peer.assembling.resize(count * chunk);
+			}
+			if (count != peer.assemblingCount) {
+				continue;
+			}
+			std::memcpy(peer.assembling.data() + index * chunk, payload, length);
+			peer.assemblingMask |= uint64_t(1) << index;
+			if (index + 1 == count) {
+				peer.assemblingSize = index * chunk + length;
+			}
+			uint64_t full = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+			if (peer.assemblingMask == full) {
+				deliver(id, NetDelivery::Unreliable, peer.assembling.data(), peer.assemblingSize);
+				peer.assemblingCount = 0;
+			}
+		}
+	}
+}
+
+void
+UdpTransport::acknowledge(Peer& peer, uint16_t sequence, double time) {
+	Sent& sent = peer.sent[sequence % kSentHistory];
+	if (!sent.valid || sent.sequence != sequence || sent.acked) {
+		return;
+	}
+	sent.acked = true;
+	++peer.stats.acked;
+	float sample = static_cast<float>(time - sent.time);
+	peer.rtt += (sample - peer.rtt) * 0.1f;
+	// Como RTP (RFC 3550): la diferencia entre dos medidas seguidas, suavizada en 1/16
+	if (peer.lastRttSample >= 0.0f) {
+		peer.stats.jitterMs += (std::abs(sample - peer.lastRttSample) * 1000.0f - peer.stats.jitterMs) / 16.0f;
+	}
+	peer.lastRttSample = sample;
+	for (uint8_t i = 0; i < sent.reliableCount; ++i) {
+		uint16_t id = sent.reliable[i];
+		auto found = std::find_if(peer.reliableOut.begin(), peer.reliableOut.end(),
+			[id](const PendingReliable& pending) { return pending.id == id; });
+		if (found != peer.reliableOut.end()) {
+			peer.reliableOut.erase(found);
+		}
+	}
+}
+
+void
+UdpTransport::expire(Peer& peer, uint16_t sequence) {
+	Sent& sent = peer.sent[sequence % kSentHistory];
+	if (sent.valid && sent.sequence == sequence && !sent.acked) {
+		sent.valid = false;
+		++peer.stats.lost;
+	}
+}
+
+NetLinkStats
+UdpTransport::linkStats(PeerId id) const {
+	if (!isConnected(id)) {
+		return {};
+	}
+	NetLinkStats stats = m_peers[id].stats;
+	stats.rttMs = m_peers[id].rtt * 1000.0f;
+	return stats;
+}
+
+void
+UdpTransport::deliver(PeerId peer, NetDelivery delivery, const unsigned char* data, size_t size) {
+	m_received.push_back({ peer, delivery, m_inbox.size(), size });
+	m_inbox.insert(m_inbox.end(), data, data + size);
+}
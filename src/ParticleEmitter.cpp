@@ -0,0 +1,50 @@
+#include "ParticleEmitter.h"
+#include <algorithm>
+#include <cmath>
+#include "Render/ParticleSystem.h"
+
+namespace {
+	constexpr float kDegreesToRadians = 3.14159265f / 180.0f;
+}
+
+void
+ParticleEmitter::update(float deltaTime) {
+	if (m_rate <= 0.0f) {
+		return;
+	}
+	m_pending += m_rate * deltaTime;
+	uint32_t count = static_cast<uint32_t>(m_pending);
+	m_pending -= static_cast<float>(count);
+	if (count > 0) {
+		burst(count);
+	}
+}
+
+void
+ParticleEmitter::burst(uint32_t count) {
+	sf::Vector2f origin = m_transform ? m_transform->getPosition() : sf::Vector2f();
+	float baseDegrees = m_direction + (m_transform ? m_transform->getRotation() : 0.0f);
+	ParticleSystem& system = EngineUtilities::TService<ParticleSystem>::instance();
+	float random[kSpawnBatch * 4];
+	for (uint32_t first = 0; first < count; first += kSpawnBatch) {
+		uint32_t batch = std::min(kSpawnBatch, count - first);
+		m_random.fillUniform(random, batch * 4);
+		for (uint32_t i = 0; i < batch; ++i) {
+			spawn(system, origin, baseDegrees, random + i * 4);
+		}
+	}
+}
+
+void
+ParticleEmitter::spawn(ParticleSystem& system, const sf::Vector2f& origin, float baseDegrees, const float* random) {
+	float angle = (baseDegrees + (random[0] - 0.5f) * m_spread) * kDegreesToRadians;
+	float speed = m_speedMin + (m_speedMax - m_speedMin) * random[1];
+
+	ParticleSystem::Particle particle;
+	particle.position = origin;
+	particle.velocity = sf::Vector2f(std::cos(angle) * speed, std::sin(angle) * speed);
+	particle.lifetime = m_lifetimeMin + (m_lifetimeMax - m_lifetimeMin) * random[2];
+	particle.size = m_sizeMin + (m_sizeMax - m_sizeMin) * random[3];
+	particle.color = m_color;
+	system.emit(particle);
+}
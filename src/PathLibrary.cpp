@@ -0,0 +1,188 @@
+#include "PathLibrary.h"
+#include "Jobs/ParallelFor.h"
+#include "ShapeFactory.h"
+#include "Transform.h"
+
+namespace {
+	/**
+	 * @brief Punto `t` en [0, 1] del tramo `segment` de `path`.
+	 */
+	sf::Vector2f
+	evaluate(const Path& path, size_t segment, float t) {
+		const std::vector<sf::Vector2f>& p = path.points;
+		size_t count = p.size();
+		auto at = [&](size_t i) { return p[i % count]; };
+		switch (path.curve) {
+		case PathCurve::CatmullRom: {
+			// Sin `loop` los extremos repiten su punto: la curva empieza y termina en ellos
+			sf::Vector2f p1 = at(segment);
+			sf::Vector2f p2 = at(segment + 1);
+			sf::Vector2f p0 = segment > 0 || path.loop ? at(segment + count - 1) : p1;
+			sf::Vector2f p3 = segment + 2 < count || path.loop ? at(segment + 2) : p2;
+			float t2 = t * t;
+			float t3 = t2 * t;
+			return 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+				(3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+		}
+		case PathCurve::Bezier: {
+			sf::Vector2f p0 = at(segment * 3);
+			sf::Vector2f c0 = at(segment * 3 + 1);
+			sf::Vector2f c1 = at(segment * 3 + 2);
+			sf::Vector2f p1 = at(segment * 3 + 3);
+			float u = 1.0f - t;
+			return u * u * u * p0 + 3.0f * u * u * t * c0 + 3.0f * u * t * t * c1 + t * t * t * p1;
+		}
+		default:
+			return at(segment) + (at(segment + 1) - at(segment)) * t;
+		}
+	}
+
+	size_t
+	segmentCount(const Path& path) {
+		size_t count = path.points.size();
+		if (count < 2) {
+			return 0;
+		}
+		if (path.curve == PathCurve::Bezier) {
+			return path.loop ? count / 3 : (count - 1) / 3;
+		}
+		return path.loop ? count : count - 1;
+	}
+
+	inline float
+	distanceBetween(const sf::Vector2f& a, const sf::Vector2f& b) {
+		sf::Vector2f d = b - a;
+		return std::sqrt(d.x * d.x + d.y * d.y);
+	}
+}
+
+PathHandle
+PathLibrary::create(std::vector<sf::Vector2f> points, bool loop, PathCurve curve) {
+	Path path;
+	path.points = std::move(points);
+	path.loop = loop;
+	path.curve = curve;
+	bake(path);
+	return m_paths.insert(std::move(path));
+}
+
+bool
+PathLibrary::setPoints(PathHandle path, std::span<const sf::Vector2f> points) {
+	Path* entry = m_paths.get(path);
+	if (!entry) {
+		return false;
+	}
+	entry->points.assign(points.begin(), points.end());
+	bake(*entry);
+	return true;
+}
+
+bool
+PathLibrary::advance(PathFollower& follower, const Path& path, const sf::Vector2f& position, float radius) {
+	uint32_t count = static_cast<uint32_t>(path.points.size());
+	if (count == 0) {
+		return false;
+	}
+	// El recorrido pudo acortarse desde el ltimo paso
+	if (follower.index >= count) {
+		follower.index %= count;
+	}
+	sf::Vector2f offset = path.points[follower.index] - position;
+	if (offset.x * offset.x + offset.y * offset.y > radius * radius) {
+		return false;
+	}
+	if (follower.index + 1 < count) {
+		++follower.index;
+	}
+	else if (!path.loop) {
+		// Fin del recorrido: se avisa una sola vez
+		if (follower.progress >= 1.0f) {
+			return false;
+		}
+		follower.progress = 1.0f;
+		return true;
+	}
+	else {
+		follower.index = 0;
+	}
+	follower.progress += 1.0f / static_cast<float>(count);
+	return true;
+}
+
+void
+PathLibrary::follow(World& world, JobSystem& jobs) const {
+	parallelForEach(jobs, world.view<PathFollower, SeekTarget, const Transform>(), 256,
+		[this](EntityId, PathFollower& follower, SeekTarget& seek, const Transform& transform) {
+			const Path* path = m_paths.get(follower.path);
+			if (!path || path->points.empty()) {
+				return;
+			}
+			advance(follower, *path, transform.getPosition(), seek.range);
+			seek.target = path->points[follower.index];
+		});
+}
+
+void
+PathLibrary::ride(World& world, JobSystem& jobs, float deltaTime) const {
+	parallelForEach(jobs, world.view<SplineFollower, Transform>(), 256,
+		[this, deltaTime](EntityId, SplineFollower& follower, Transform& transform) {
+			const Path* path = m_paths.get(follower.path);
+			if (!path || path->samples.empty()) {
+				return;
+			}
+			follower.distance += follower.speed * deltaTime;
+			// Sin crecer para siempre: lejos del cero el float pierde precisin
+			if (path->loop && path->length > 0.0f && follower.distance >= path->length) {
+				follower.distance = std::fmod(follower.distance, path->length);
+			}
+			transform.setPosition(path->pointAt(follower.distance));
+		});
+}
+
+void
+PathLibrary::bake(Path& path) {
+	path.samples.clear();
+	path.length = 0.0f;
+	path.sampleStep = 0.0f;
+	size_t segments = segmentCount(path);
+	if (segments == 0) {
+		path.samples.assign(path.points.begin(), path.points.end());
+		return;
+	}
+
+	// Curva medida en tramos rectos cortos, con la distancia acumulada hasta cada punto
+	std::vector<sf::Vector2f> dense;
+	std::vector<float> along;
+	dense.reserve(segments * Path::kSubdivisions + 1);
+	along.reserve(segments * Path::kSubdivisions + 1);
+	dense.push_back(evaluate(path, 0, 0.0f));
+	along.push_back(0.0f);
+	for (size_t segment = 0; segment < segments; ++segment) {
+		for (uint32_t step = 1; step <= Path::kSubdivisions; ++step) {
+			sf::Vector2f point = evaluate(path, segment, static_cast<float>(step) / Path::kSubdivisions);
+			along.push_back(along.back() + distanceBetween(dense.back(), point));
+			dense.push_back(point);
+		}
+	}
+	path.length = along.back();
+	if (path.length <= 0.0f) {
+		path.samples.push_back(dense.front());
+		return;
+	}
+
+	// Muestras a la misma distancia: la bsqueda se hace aqu una vez, no en cada paso
+	size_t count = static_cast<size_t>(std::ceil(path.length / Path::kSampleSpacing)) + 1;
+	path.sampleStep = path.length / static_cast<float>(count - 1);
+	path.samples.reserve(count);
+	size_t cursor = 1;
+	for (size_t i = 0; i + 1 < count; ++i) {
+		float target = static_cast<float>(i) * path.sampleStep;
+		while (cursor + 1 < along.size() && along[cursor] < target) {
+			++cursor;
+		}
+		float span = along[cursor] - along[cursor - 1];
+		float t = span > 0.0f ? (target - along[cursor - 1]) / span : 0.0f;
+		path.samples.push_back(dense[cursor - 1] + (dense[cursor] - dense[cursor - 1]) * t);
+	}
+	path.samples.push_back(dense.back());
+}
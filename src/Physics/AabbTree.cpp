@@ -0,0 +1,208 @@
+#include "Physics/AabbTree.h"
+#include <cassert>
+
+uint32_t
+AabbTree::createProxy(const Aabb& aabb, void* userData) {
+	uint32_t proxy = allocateNode();
+	Node& node = m_nodes[proxy];
+	node.aabb = { aabb.minX - kMargin, aabb.minY - kMargin, aabb.maxX + kMargin, aabb.maxY + kMargin };
+	node.userData = userData;
+	node.height = 0;
+	insertLeaf(proxy);
+	++m_proxyCount;
+	return proxy;
+}
+
+void
+AabbTree::destroyProxy(uint32_t proxy) {
+	assert(proxy < m_nodes.size() && m_nodes[proxy].isLeaf());
+	removeLeaf(proxy);
+	freeNode(proxy);
+	--m_proxyCount;
+}
+
+bool
+AabbTree::moveProxy(uint32_t proxy, const Aabb& aabb, const sf::Vector2f& displacement) {
+	assert(proxy < m_nodes.size() && m_nodes[proxy].isLeaf());
+	if (m_nodes[proxy].aabb.contains(aabb)) {
+		return false;
+	}
+	removeLeaf(proxy);
+
+	// La caja nueva mira hacia donde va el objeto: los prximos frames caben en ella
+	Aabb fat = { aabb.minX - kMargin, aabb.minY - kMargin, aabb.maxX + kMargin, aabb.maxY + kMargin };
+	float dx = kDisplacementFactor * displacement.x;
+	float dy = kDisplacementFactor * displacement.y;
+	(dx < 0.0f ? fat.minX : fat.maxX) += dx;
+	(dy < 0.0f ? fat.minY : fat.maxY) += dy;
+	m_nodes[proxy].aabb = fat;
+	insertLeaf(proxy);
+	return true;
+}
+
+uint32_t
+AabbTree::allocateNode() {
+	if (m_freeList == kNullNode) {
+		m_nodes.emplace_back();
+		return static_cast<uint32_t>(m_nodes.size() - 1);
+	}
+	uint32_t index = m_freeList;
+	m_freeList = m_nodes[index].parent;
+	m_nodes[index] = Node();
+	return index;
+}
+
+void
+AabbTree::freeNode(uint32_t index) {
+	Node& node = m_nodes[index];
+	node.parent = m_freeList;
+	node.child1 = kNullNode;
+	node.child2 = kNullNode;
+	node.height = -1;
+	node.userData = nullptr;
+	m_freeList = index;
+}
+
+void
+AabbTree::insertLeaf(uint32_t leaf) {
+	if (m_root == kNullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = kNullNode;
+		return;
+	}
+
+	// Baja por donde la caja del rbol crece menos; parar aqu cuesta crear un padre
+	// nuevo con los dos, bajar cuesta lo que crece este nodo ms lo que cuesta el hijo
+	Aabb leafAabb = m_nodes[leaf].aabb;
+	uint32_t index = m_root;
+	while (!m_nodes[index].isLeaf()) {
+		const Node& node = m_nodes[index];
+		float area = node.aabb.perimeter();
+		float combined = Aabb::merge(node.aabb, leafAabb).perimeter();
+		float cost = 2.0f * combined;
+		float inherited = 2.0f * (combined - area);
+
+		auto descendCost = [this, &leafAabb, inherited](uint32_t child) {
+			const Node& childNode = m_nodes[child];
+			float merged = Aabb::merge(childNode.aabb, leafAabb).perimeter();
+			return childNode.isLeaf() ? merged + inherited : merged - childNode.aabb.perimeter() + inherited;
+		};
+		float cost1 = descendCost(node.child1);
+		float cost2 = descendCost(node.child2);
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	uint32_t sibling = index;
+	uint32_t oldParent = m_nodes[sibling].parent;
+	uint32_t newParent = allocateNode();
+	Node& parent = m_nodes[newParent];
+	parent.parent = oldParent;
+	parent.aabb = Aabb::merge(leafAabb, m_nodes[sibling].aabb);
+	parent.height = m_nodes[sibling].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+	if (oldParent == kNullNode) {
+		m_root = newParent;
+	}
+	else if (m_nodes[oldParent].child1 == sibling) {
+		m_nodes[oldParent].child1 = newParent;
+	}
+	else {
+		m_nodes[oldParent].child2 = newParent;
+	}
+
+	// Sube arreglando cajas y alturas
+	for (index = m_nodes[leaf].parent; index != kNullNode; index = m_nodes[index].parent) {
+		index = balance(index);
+		Node& node = m_nodes[index];
+		node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+		node.aabb = Aabb::merge(m_nodes[node.child1].aabb, m_nodes[node.child2].aabb);
+	}
+}
+
+void
+AabbTree::removeLeaf(uint32_t leaf) {
+	if (leaf == m_root) {
+		m_root = kNullNode;
+		return;
+	}
+	uint32_t parent = m_nodes[leaf].parent;
+	uint32_t grandParent = m_nodes[parent].parent;
+	uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// El hermano toma el lugar del padre
+	freeNode(parent);
+	if (grandParent == kNullNode) {
+		m_root = sibling;
+		m_nodes[sibling].parent = kNullNode;
+		return;
+	}
+	if (m_nodes[grandParent].child1 == parent) {
+		m_nodes[grandParent].child1 = sibling;
+	}
+	else {
+		m_nodes[grandParent].child2 = sibling;
+	}
+	m_nodes[sibling].parent = grandParent;
+	for (uint32_t index = grandParent; index != kNullNode; index = m_nodes[index].parent) {
+		index = balance(index);
+		Node& node = m_nodes[index];
+		node.aabb = Aabb::merge(m_nodes[node.child1].aabb, m_nodes[node.child2].aabb);
+		node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+	}
+}
+
+uint32_t
+AabbTree::balance(uint32_t indexA) {
+	Node& a = m_nodes[indexA];
+	if (a.isLeaf() || a.height < 2) {
+		return indexA;
+	}
+	uint32_t indexB = a.child1;
+	uint32_t indexC = a.child2;
+	int32_t skew = m_nodes[indexC].height - m_nodes[indexB].height;
+	if (skew >= -1 && skew <= 1) {
+		return indexA;
+	}
+
+	// El hijo ms alto sube al lugar de A; A se queda con el nieto ms bajo
+	uint32_t indexUp = skew > 0 ? indexC : indexB;
+	uint32_t indexStay = skew > 0 ? indexB : indexC;
+	Node& up = m_nodes[indexUp];
+	uint32_t indexF = up.child1;
+	uint32_t indexG = up.child2;
+
+	up.child1 = indexA;
+	up.parent = a.parent;
+	a.parent = indexUp;
+	if (up.parent == kNullNode) {
+		m_root = indexUp;
+	}
+	else if (m_nodes[up.parent].child1 == indexA) {
+		m_nodes[up.parent].child1 = indexUp;
+	}
+	else {
+		m_nodes[up.parent].child2 = indexUp;
+	}
+
+	uint32_t taller = m_nodes[indexF].height > m_nodes[indexG].height ? indexF : indexG;
+	uint32_t shorter = taller == indexF ? indexG : indexF;
+	up.child2 = taller;
+	if (skew > 0) {
+		a.child2 = shorter;
+	}
+	else {
+		a.child1 = shorter;
+	}
+	m_nodes[shorter].parent = indexA;
+	a.aabb = Aabb::merge(m_nodes[indexStay].aabb, m_nodes[shorter].aabb);
+	a.height = 1 + std::max(m_nodes[indexStay].height, m_nodes[shorter].height);
+	up.aabb = Aabb::merge(a.aabb, m_nodes[taller].aabb);
+	up.height = 1 + std::max(a.height, m_nodes[taller].height);
+	return indexUp;
+}
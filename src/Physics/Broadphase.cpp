@@ -0,0 +1,82 @@
+#include "Physics/Broadphase.h"
+#include <algorithm>
+#include <iterator>
+
+uint32_t
+Broadphase::createProxy(const Aabb& aabb, void* userData, bool isStatic) {
+	uint32_t proxy = m_tree.createProxy(aabb, userData);
+	if (proxy >= m_flags.size()) {
+		m_flags.resize(proxy + 1, 0);
+	}
+	m_flags[proxy] = isStatic ? kStatic : 0;
+	bufferMove(proxy);
+	return proxy;
+}
+
+void
+Broadphase::destroyProxy(uint32_t proxy) {
+	// El nodo sigue reservado hasta `updatePairs`: un proxy nuevo no puede tomar su ndice
+	// mientras quedan pares viejos con l
+	m_flags[proxy] |= kDestroyed;
+	m_destroyed.push_back(proxy);
+	bufferMove(proxy);
+}
+
+void
+Broadphase::moveProxy(uint32_t proxy, const Aabb& aabb, const sf::Vector2f& displacement) {
+	if (m_tree.moveProxy(proxy, aabb, displacement)) {
+		bufferMove(proxy);
+	}
+}
+
+void
+Broadphase::updatePairs() {
+	// Los pares de los que no se movieron siguen igual; los de los movidos se buscan de nuevo
+	m_next.clear();
+	for (const ProxyPair& pair : m_pairs) {
+		if (!((m_flags[pair.a] | m_flags[pair.b]) & kMoved)) {
+			m_next.push_back(pair);
+		}
+	}
+	for (uint32_t proxy : m_moveBuffer) {
+		if (m_flags[proxy] & kDestroyed) {
+			continue;
+		}
+		bool isStatic = (m_flags[proxy] & kStatic) != 0;
+		m_tree.query(m_tree.fatAabb(proxy), [this, proxy, isStatic](uint32_t other) {
+			uint8_t flags = m_flags[other];
+			if (other != proxy && !(flags & kDestroyed) && !(isStatic && (flags & kStatic))) {
+				m_next.push_back(proxy < other ? ProxyPair{ proxy, other } : ProxyPair{ other, proxy });
+			}
+			return true;
+		});
+	}
+	// Dos movidos que se tocan aparecen una vez por cada uno
+	std::sort(m_next.begin(), m_next.end());
+	m_next.erase(std::unique(m_next.begin(), m_next.end()), m_next.end());
+
+	m_began.clear();
+	m_ended.clear();
+	std::set_difference(m_next.begin(), m_next.end(), m_pairs.begin(), m_pairs.end(), std::back_inserter(m_began));
+	std::set_difference(m_pairs.begin(), m_pairs.end(), m_next.begin(), m_next.end(), std::back_inserter(m_ended));
+	m_pairs.swap(m_next);
+
+	for (uint32_t proxy : m_moveBuffer) {
+		m_flags[proxy] &= static_cast<uint8_t>(~kMoved);
+	}
+	m_lastMoveCount = m_moveBuffer.size();
+	m_moveBuffer.clear();
+	for (uint32_t proxy : m_destroyed) {
+		m_tree.destroyProxy(proxy);
+		m_flags[proxy] = 0;
+	}
+	m_destroyed.clear();
+}
+
+void
+Broadphase::bufferMove(uint32_t proxy) {
+	if (!(m_flags[proxy] & kMoved)) {
+		m_flags[proxy] |= kMoved;
+		m_moveBuffer.push_back(proxy);
+	}
+}
@@ -0,0 +1,10 @@
+#include "Physics/Collider.h"
+#include "Physics/PhysicsWorld.h"
+
+Collider::~Collider() {
+	if (m_proxy != AabbTree::kNullNode || m_body != PhysicsWorld::kNoBody) {
+		if (PhysicsWorld* physics = EngineUtilities::TService<PhysicsWorld>::get()) {
+			physics->removeCollider(*this);
+		}
+	}
+}
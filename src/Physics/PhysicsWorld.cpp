@@ -0,0 +1,633 @@
+#include "Physics/PhysicsWorld.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include "Jobs/JobSystem.h"
+#include "Transform.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PHYSICS_SSE 1
+#endif
+
+namespace {
+	/**
+	 * @brief `box` movida a `(x, y)`.
+	 */
+	inline Aabb
+	offset(const Aabb& box, float x, float y) { return { box.minX + x, box.minY + y, box.maxX + x, box.maxY + y }; }
+
+	/**
+	 * @brief `v += g * dt` y la amortiguacin, en `[0, count)`.
+	 */
+	void
+	integrateVelocities(float* vx, float* vy, size_t count, float gravityX, float gravityY, float damping) {
+		size_t i = 0;
+#if PHYSICS_SSE
+		__m128 gx = _mm_set1_ps(gravityX);
+		__m128 gy = _mm_set1_ps(gravityY);
+		__m128 keep = _mm_set1_ps(damping);
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(vx + i, _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vx + i), gx), keep));
+			_mm_storeu_ps(vy + i, _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vy + i), gy), keep));
+		}
+#endif
+		for (; i < count; ++i) {
+			vx[i] = (vx[i] + gravityX) * damping;
+			vy[i] = (vy[i] + gravityY) * damping;
+		}
+	}
+
+	/**
+	 * @brief `p += v * dt` en `[0, count)`.
+	 */
+	void
+	integratePositions(float* x, float* y, const float* vx, const float* vy, size_t count, float deltaTime) {
+		size_t i = 0;
+#if PHYSICS_SSE
+		__m128 dt = _mm_set1_ps(deltaTime);
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dt)));
+			_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), dt)));
+		}
+#endif
+		for (; i < count; ++i) {
+			x[i] += vx[i] * deltaTime;
+			y[i] += vy[i] * deltaTime;
+		}
+	}
+}
+
+void
+PhysicsWorld::syncColliders(World& world, uint32_t since) {
+	world.view<const Transform, Collider>().eachChanged<Transform, Collider>(since,
+		[this, &world](EntityId entity, const Transform& transform, Collider& collider) {
+			// Los cuerpos los mueve `step`
+			if (collider.m_body != kNoBody) {
+				return;
+			}
+			Aabb bounds = Aabb::fromRect(transform.getWorldTransform().transformRect(collider.m_bounds));
+			if (collider.m_proxy == AabbTree::kNullNode) {
+				collider.m_entity = entity;
+				collider.m_worldBounds = bounds;
+				if (collider.m_mass > 0.0f && !collider.m_static) {
+					ComponentRef<Transform>* ref = world.getComponent<ComponentRef<Transform>>(entity);
+					sf::Vector2f position = transform.getPosition();
+					collider.m_body = createBody(position, offset(bounds, -position.x, -position.y), collider.m_mass,
+						collider.m_restitution, &collider, ref ? ref->component : nullptr);
+					collider.m_proxy = m_proxy[m_slotOfBody[collider.m_body]];
+					return;
+				}
+				collider.m_proxy = m_broadphase.createProxy(bounds, &collider, collider.m_static);
+				trackProxy(collider.m_proxy, bounds, kNoBody);
+				return;
+			}
+			const Aabb& last = collider.m_worldBounds;
+			sf::Vector2f displacement(0.5f * ((bounds.minX + bounds.maxX) - (last.minX + last.maxX)),
+				0.5f * ((bounds.minY + bounds.maxY) - (last.minY + last.maxY)));
+			collider.m_worldBounds = bounds;
+			m_boundsOfProxy[collider.m_proxy] = bounds;
+			m_broadphase.moveProxy(collider.m_proxy, bounds, displacement);
+		});
+}
+
+void
+PhysicsWorld::step(float deltaTime, JobSystem* jobs) {
+	m_broadphase.updatePairs();
+	// Un par que termin puede ser un apoyo que se destruy: los dormidos de ese par despiertan
+	for (const ProxyPair& pair : m_broadphase.endedPairs()) {
+		for (uint32_t proxy : { pair.a, pair.b }) {
+			BodyId body = m_bodyOfProxy[proxy];
+			if (body != kNoBody && m_slotOfBody[body] >= m_awakeCount) {
+				wake(m_slotOfBody[body]);
+			}
+		}
+	}
+	if (m_awakeCount == 0 || deltaTime <= 0.0f) {
+		return;
+	}
+	m_lastContacts.swap(m_contacts);
+	m_contacts.clear();
+
+	integrateVelocities(m_vx.data(), m_vy.data(), m_awakeCount, m_gravity.x * deltaTime, m_gravity.y * deltaTime,
+		1.0f / (1.0f + kLinearDamping * deltaTime));
+	buildContacts();
+	if (jobs && jobs->activeWorkers() == 0) {
+		jobs = nullptr;
+	}
+	buildIslands(m_deterministic || jobs);
+	forEachIsland(jobs, [this](const Island& island, JobSystem* islandJobs) {
+		forEachBatch(island, islandJobs, [this](uint32_t begin, uint32_t end) { warmStart(begin, end); });
+		for (uint32_t iteration = 0; iteration < kVelocityIterations; ++iteration) {
+			forEachBatch(island, islandJobs, [this](uint32_t begin, uint32_t end) { solveVelocities(begin, end); });
+		}
+	});
+	integratePositions(m_x.data(), m_y.data(), m_vx.data(), m_vy.data(), m_awakeCount, deltaTime);
+	forEachIsland(jobs, [this](const Island& island, JobSystem* islandJobs) {
+		forEachBatch(island, islandJobs, [this](uint32_t begin, uint32_t end) { correctPositions(begin, end); });
+	});
+
+	// Cajas y `Transform` de los despiertos, antes de que alguno se duerma
+	for (uint32_t slot = 0; slot < m_awakeCount; ++slot) {
+		m_broadphase.moveProxy(m_proxy[slot], offset(m_localBox[slot], m_x[slot], m_y[slot]),
+			sf::Vector2f(m_vx[slot] * deltaTime, m_vy[slot] * deltaTime));
+		if (Transform* transform = m_transform[slot]) {
+			transform->setPosition(m_x[slot], m_y[slot]);
+		}
+	}
+	updateSleep(deltaTime);
+}
+
+void
+PhysicsWorld::removeCollider(Collider& collider) {
+	if (collider.m_body != kNoBody) {
+		destroyBody(collider.m_body);
+		collider.m_body = kNoBody;
+		collider.m_proxy = AabbTree::kNullNode;
+	}
+	else if (collider.m_proxy != AabbTree::kNullNode) {
+		m_broadphase.destroyProxy(collider.m_proxy);
+		collider.m_proxy = AabbTree::kNullNode;
+	}
+}
+
+PhysicsWorld::BodyId
+PhysicsWorld::createBody(const sf::Vector2f& position, const Aabb& localBox, float mass, float restitution,
+	Collider* owner, Transform* transform) {
+	BodyId body;
+	if (m_freeBodies.empty()) {
+		body = static_cast<BodyId>(m_slotOfBody.size());
+		m_slotOfBody.push_back(kNoSlot);
+	}
+	else {
+		body = m_freeBodies.back();
+		m_freeBodies.pop_back();
+	}
+	Aabb bounds = offset(localBox, position.x, position.y);
+	uint32_t proxy = m_broadphase.createProxy(bounds, owner, false);
+	trackProxy(proxy, bounds, body);
+
+	// Entra despierto: al final de los arreglos y luego al final del tramo despierto
+	uint32_t slot = static_cast<uint32_t>(m_x.size());
+	m_x.push_back(position.x);
+	m_y.push_back(position.y);
+	m_vx.push_back(0.0f);
+	m_vy.push_back(0.0f);
+	m_inverseMass.push_back(1.0f / mass);
+	m_restitution.push_back(restitution);
+	m_stillTime.push_back(0.0f);
+	m_localBox.push_back(localBox);
+	m_proxy.push_back(proxy);
+	m_island.push_back(kNoIsland);
+	m_transform.push_back(transform);
+	m_bodyOfSlot.push_back(body);
+	m_slotOfBody[body] = slot;
+	swapSlots(slot, m_awakeCount);
+	++m_awakeCount;
+	return body;
+}
+
+void
+PhysicsWorld::destroyBody(BodyId body) {
+	uint32_t slot = m_slotOfBody[body];
+	m_broadphase.destroyProxy(m_proxy[slot]);
+	m_bodyOfProxy[m_proxy[slot]] = kNoBody;
+	if (slot < m_awakeCount) {
+		swapSlots(slot, m_awakeCount - 1);
+		slot = --m_awakeCount;
+	}
+	uint32_t last = static_cast<uint32_t>(m_x.size() - 1);
+	swapSlots(slot, last);
+	m_x.pop_back();
+	m_y.pop_back();
+	m_vx.pop_back();
+	m_vy.pop_back();
+	m_inverseMass.pop_back();
+	m_restitution.pop_back();
+	m_stillTime.pop_back();
+	m_localBox.pop_back();
+	m_proxy.pop_back();
+	m_island.pop_back();
+	m_transform.pop_back();
+	m_bodyOfSlot.pop_back();
+	m_slotOfBody[body] = kNoSlot;
+	m_freeBodies.push_back(body);
+}
+
+uint32_t
+PhysicsWorld::createStatic(const Aabb& bounds) {
+	uint32_t proxy = m_broadphase.createProxy(bounds, nullptr, true);
+	trackProxy(proxy, bounds, kNoBody);
+	return proxy;
+}
+
+void
+PhysicsWorld::setVelocity(BodyId body, const sf::Vector2f& velocity) {
+	uint32_t slot = m_slotOfBody[body];
+	if (slot >= m_awakeCount) {
+		wake(slot);
+		slot = m_slotOfBody[body];
+	}
+	m_vx[slot] = velocity.x;
+	m_vy[slot] = velocity.y;
+	m_stillTime[slot] = 0.0f;
+}
+
+void
+PhysicsWorld::trackProxy(uint32_t proxy, const Aabb& bounds, BodyId body) {
+	if (proxy >= m_bodyOfProxy.size()) {
+		m_bodyOfProxy.resize(proxy + 1, kNoBody);
+		m_boundsOfProxy.resize(proxy + 1);
+	}
+	m_bodyOfProxy[proxy] = body;
+	m_boundsOfProxy[proxy] = bounds;
+}
+
+Aabb
+PhysicsWorld::boundsOf(uint32_t proxy) const {
+	BodyId body = m_bodyOfProxy[proxy];
+	if (body == kNoBody) {
+		return m_boundsOfProxy[proxy];
+	}
+	uint32_t slot = m_slotOfBody[body];
+	return offset(m_localBox[slot], m_x[slot], m_y[slot]);
+}
+
+void
+PhysicsWorld::wake(uint32_t slot) {
+	uint32_t island = m_island[slot];
+	for (uint32_t other = m_awakeCount; other < m_x.size(); ++other) {
+		if (m_island[other] == island) {
+			swapSlots(other, m_awakeCount);
+			m_island[m_awakeCount] = kNoIsland;
+			m_stillTime[m_awakeCount] = 0.0f;
+			++m_awakeCount;
+		}
+	}
+}
+
+void
+PhysicsWorld::buildContacts() {
+	const std::vector<ProxyPair>& pairs = m_broadphase.pairs();
+	auto slotOf = [this](uint32_t proxy) {
+		BodyId body = m_bodyOfProxy[proxy];
+		return body == kNoBody ? kNoSlot : m_slotOfBody[body];
+	};
+
+	// Primero se despierta lo que toca algo en movimiento: despus los ndices ya no cambian
+	for (const ProxyPair& pair : pairs) {
+		uint32_t a = slotOf(pair.a);
+		uint32_t b = slotOf(pair.b);
+		bool sleepingA = a != kNoSlot && a >= m_awakeCount;
+		bool sleepingB = b != kNoSlot && b >= m_awakeCount;
+		if (sleepingA == sleepingB) {
+			continue;
+		}
+		uint32_t sleeper = sleepingA ? a : b;
+		uint32_t toucher = sleepingA ? pair.b : pair.a;
+		uint32_t toucherSlot = sleepingA ? b : a;
+		// Un esttico no despierta a nadie; un despierto o uno movido por su `Transform` s
+		const Collider* collider = colliderOf(toucher);
+		bool moving = toucherSlot != kNoSlot || (collider && !collider->isStatic());
+		if (moving && boundsOf(pair.a).overlaps(boundsOf(pair.b))) {
+			wake(sleeper);
+		}
+	}
+
+	// Los dos arreglos van en el orden de los pares: se cruzan en una pasada
+	size_t last = 0;
+	for (const ProxyPair& pair : pairs) {
+		uint32_t a = slotOf(pair.a);
+		uint32_t b = slotOf(pair.b);
+		bool awakeA = a != kNoSlot && a < m_awakeCount;
+		bool awakeB = b != kNoSlot && b < m_awakeCount;
+		// Al menos un despierto, y ningn dormido: uno que qued dormido no lo tocaba
+		if ((!awakeA && !awakeB) || (a != kNoSlot && !awakeA) || (b != kNoSlot && !awakeB)) {
+			continue;
+		}
+		Aabb boxA = boundsOf(pair.a);
+		Aabb boxB = boundsOf(pair.b);
+		float overlapX = std::min(boxA.maxX, boxB.maxX) - std::max(boxA.minX, boxB.minX);
+		float overlapY = std::min(boxA.maxY, boxB.maxY) - std::max(boxA.minY, boxB.minY);
+		if (overlapX <= 0.0f || overlapY <= 0.0f) {
+			continue;
+		}
+		Contact contact;
+		contact.pair = pair;
+		contact.a = a;
+		contact.b = b;
+		contact.impulse = 0.0f;
+		// Sale por el eje que menos penetra, hacia el lado de `b`
+		if (overlapX < overlapY) {
+			contact.normalX = (boxB.minX + boxB.maxX) >= (boxA.minX + boxA.maxX) ? 1.0f : -1.0f;
+			contact.normalY = 0.0f;
+			contact.depth = overlapX;
+		}
+		else {
+			contact.normalX = 0.0f;
+			contact.normalY = (boxB.minY + boxB.maxY) >= (boxA.minY + boxA.maxY) ? 1.0f : -1.0f;
+			contact.depth = overlapY;
+		}
+		float restitutionA = a != kNoSlot ? m_restitution[a] : 0.0f;
+		float restitutionB = b != kNoSlot ? m_restitution[b] : 0.0f;
+		float approach = (b != kNoSlot ? m_vx[b] : 0.0f) - (a != kNoSlot ? m_vx[a] : 0.0f);
+		approach = approach * contact.normalX +
+			((b != kNoSlot ? m_vy[b] : 0.0f) - (a != kNoSlot ? m_vy[a] : 0.0f)) * contact.normalY;
+		contact.bounce = approach < -kBounceSpeed ? -std::max(restitutionA, restitutionB) * approach : 0.0f;
+		while (last < m_lastContacts.size() && m_lastContacts[last].pair < pair) {
+			++last;
+		}
+		if (last < m_lastContacts.size() && m_lastContacts[last].pair == pair &&
+		    m_lastContacts[last].normalX == contact.normalX && m_lastContacts[last].normalY == contact.normalY) {
+			contact.impulse = m_lastContacts[last].impulse;
+		}
+		m_contacts.push_back(contact);
+	}
+}
+
+void
+PhysicsWorld::buildIslands(bool coloring) {
+	// Unin y bsqueda: los despiertos que se tocan quedan en la misma isla
+	m_islandParent.resize(m_awakeCount);
+	for (uint32_t slot = 0; slot < m_awakeCount; ++slot) {
+		m_islandParent[slot] = slot;
+	}
+	for (const Contact& contact : m_contacts) {
+		if (contact.a != kNoSlot && contact.b != kNoSlot) {
+			uint32_t rootA = findIsland(contact.a);
+			uint32_t rootB = findIsland(contact.b);
+			if (rootA != rootB) {
+				m_islandParent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+			}
+		}
+	}
+
+	// Las islas salen en el orden de su primer contacto; `end` cuenta mientras tanto
+	m_islands.clear();
+	m_coloredIslands.clear();
+	m_colorStart.clear();
+	m_islandIndex.assign(m_awakeCount, kNoIsland);
+	m_contactColor.resize(m_contacts.size());
+	for (uint32_t i = 0; i < m_contacts.size(); ++i) {
+		const Contact& contact = m_contacts[i];
+		uint32_t root = findIsland(contact.a != kNoSlot ? contact.a : contact.b);
+		if (m_islandIndex[root] == kNoIsland) {
+			m_islandIndex[root] = static_cast<uint32_t>(m_islands.size());
+			m_islands.push_back({ 0, 0, 0, 0, false });
+		}
+		m_contactColor[i] = m_islandIndex[root];
+		++m_islands[m_islandIndex[root]].end;
+	}
+	uint32_t offset = 0;
+	for (Island& island : m_islands) {
+		island.begin = offset;
+		offset += island.end;
+		island.end = island.begin;
+	}
+	m_order.resize(m_contacts.size());
+	for (uint32_t i = 0; i < m_contacts.size(); ++i) {
+		m_order[m_islands[m_contactColor[i]].end++] = i;
+	}
+
+	if (!coloring) {
+		return;
+	}
+	m_colorMask.resize(m_awakeCount, 0);
+	size_t kept = 0;
+	for (Island& island : m_islands) {
+		if (island.end - island.begin >= kColoringThreshold) {
+			colorIsland(island);
+			m_coloredIslands.push_back(island);
+		}
+		else {
+			m_islands[kept++] = island;
+		}
+	}
+	m_islands.resize(kept);
+}
+
+void
+PhysicsWorld::colorIsland(Island& island) {
+	// Cada contacto toma el primer color que no usa ninguno de sus dos cuerpos
+	uint32_t counts[kMaxColors + 1] = {};
+	for (uint32_t i = island.begin; i < island.end; ++i) {
+		const Contact& contact = m_contacts[m_order[i]];
+		uint64_t used = (contact.a != kNoSlot ? m_colorMask[contact.a] : 0) | (contact.b != kNoSlot ? m_colorMask[contact.b] : 0);
+		uint32_t color = used == ~uint64_t(0) ? kMaxColors : static_cast<uint32_t>(std::countr_one(used));
+		if (color < kMaxColors) {
+			uint64_t bit = uint64_t(1) << color;
+			if (contact.a != kNoSlot) {
+				m_colorMask[contact.a] |= bit;
+			}
+			if (contact.b != kNoSlot) {
+				m_colorMask[contact.b] |= bit;
+			}
+		}
+		m_contactColor[i] = color;
+		++counts[color];
+	}
+	for (uint32_t i = island.begin; i < island.end; ++i) {
+		const Contact& contact = m_contacts[m_order[i]];
+		if (contact.a != kNoSlot) {
+			m_colorMask[contact.a] = 0;
+		}
+		if (contact.b != kNoSlot) {
+			m_colorMask[contact.b] = 0;
+		}
+	}
+
+	// Se reordena el tramo por color sin cambiar el orden dentro de cada color
+	island.firstColor = static_cast<uint32_t>(m_colorStart.size());
+	island.overflow = counts[kMaxColors] != 0;
+	uint32_t cursor[kMaxColors + 1];
+	uint32_t offset = island.begin;
+	for (uint32_t color = 0; color <= kMaxColors; ++color) {
+		if (counts[color] == 0) {
+			continue;
+		}
+		m_colorStart.push_back(offset);
+		cursor[color] = offset - island.begin;
+		offset += counts[color];
+	}
+	m_colorStart.push_back(island.end);
+	island.colorCount = static_cast<uint32_t>(m_colorStart.size()) - island.firstColor - 1;
+	m_scratch.resize(island.end - island.begin);
+	for (uint32_t i = island.begin; i < island.end; ++i) {
+		m_scratch[cursor[m_contactColor[i]]++] = m_order[i];
+	}
+	std::copy(m_scratch.begin(), m_scratch.end(), m_order.begin() + island.begin);
+}
+
+template<typename Fn>
+void
+PhysicsWorld::forEachBatch(const Island& island, JobSystem* jobs, Fn&& function) {
+	// Los colores son tramos seguidos: en serie, recorrer la isla entera es recorrerlos en orden
+	if (island.colorCount == 0 || !jobs) {
+		function(island.begin, island.end);
+		return;
+	}
+	for (uint32_t color = 0; color < island.colorCount; ++color) {
+		uint32_t begin = m_colorStart[island.firstColor + color];
+		uint32_t end = m_colorStart[island.firstColor + color + 1];
+		if (island.overflow && color + 1 == island.colorCount) {
+			function(begin, end);
+			continue;
+		}
+		jobs->parallelFor(end - begin, kContactGrain, [&function, begin](size_t first, size_t last) {
+			function(begin + static_cast<uint32_t>(first), begin + static_cast<uint32_t>(last));
+		});
+	}
+}
+
+template<typename Fn>
+void
+PhysicsWorld::forEachIsland(JobSystem* jobs, Fn&& function) {
+	for (const Island& island : m_coloredIslands) {
+		function(island, jobs);
+	}
+	if (!jobs) {
+		for (const Island& island : m_islands) {
+			function(island, nullptr);
+		}
+		return;
+	}
+	// Cada isla escribe solo sus cuerpos: los trabajos no se cruzan
+	jobs->parallelFor(m_islands.size(), kIslandGrain, [this, &function](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			function(m_islands[i], nullptr);
+		}
+	});
+}
+
+void
+PhysicsWorld::warmStart(uint32_t begin, uint32_t end) {
+	for (uint32_t i = begin; i < end; ++i) {
+		const Contact& contact = m_contacts[m_order[i]];
+		if (contact.impulse == 0.0f) {
+			continue;
+		}
+		if (contact.a != kNoSlot) {
+			m_vx[contact.a] -= contact.impulse * m_inverseMass[contact.a] * contact.normalX;
+			m_vy[contact.a] -= contact.impulse * m_inverseMass[contact.a] * contact.normalY;
+		}
+		if (contact.b != kNoSlot) {
+			m_vx[contact.b] += contact.impulse * m_inverseMass[contact.b] * contact.normalX;
+			m_vy[contact.b] += contact.impulse * m_inverseMass[contact.b] * contact.normalY;
+		}
+	}
+}
+
+void
+PhysicsWorld::solveVelocities(uint32_t begin, uint32_t end) {
+	for (uint32_t i = begin; i < end; ++i) {
+		Contact& contact = m_contacts[m_order[i]];
+		float inverseA = contact.a != kNoSlot ? m_inverseMass[contact.a] : 0.0f;
+		float inverseB = contact.b != kNoSlot ? m_inverseMass[contact.b] : 0.0f;
+		float vxA = contact.a != kNoSlot ? m_vx[contact.a] : 0.0f;
+		float vyA = contact.a != kNoSlot ? m_vy[contact.a] : 0.0f;
+		float vxB = contact.b != kNoSlot ? m_vx[contact.b] : 0.0f;
+		float vyB = contact.b != kNoSlot ? m_vy[contact.b] : 0.0f;
+		float approach = (vxB - vxA) * contact.normalX + (vyB - vyA) * contact.normalY;
+		float total = std::max(contact.impulse + (contact.bounce - approach) / (inverseA + inverseB), 0.0f);
+		float impulse = total - contact.impulse;
+		contact.impulse = total;
+		if (contact.a != kNoSlot) {
+			m_vx[contact.a] -= impulse * inverseA * contact.normalX;
+			m_vy[contact.a] -= impulse * inverseA * contact.normalY;
+		}
+		if (contact.b != kNoSlot) {
+			m_vx[contact.b] += impulse * inverseB * contact.normalX;
+			m_vy[contact.b] += impulse * inverseB * contact.normalY;
+		}
+	}
+}
+
+void
+PhysicsWorld::correctPositions(uint32_t begin, uint32_t end) {
+	for (uint32_t i = begin; i < end; ++i) {
+		const Contact& contact = m_contacts[m_order[i]];
+		float inverseA = contact.a != kNoSlot ? m_inverseMass[contact.a] : 0.0f;
+		float inverseB = contact.b != kNoSlot ? m_inverseMass[contact.b] : 0.0f;
+		float push = std::max(contact.depth - kPenetrationSlop, 0.0f) * kCorrection / (inverseA + inverseB);
+		if (contact.a != kNoSlot) {
+			m_x[contact.a] -= push * inverseA * contact.normalX;
+			m_y[contact.a] -= push * inverseA * contact.normalY;
+		}
+		if (contact.b != kNoSlot) {
+			m_x[contact.b] += push * inverseB * contact.normalX;
+			m_y[contact.b] += push * inverseB * contact.normalY;
+		}
+	}
+}
+
+void
+PhysicsWorld::updateSleep(float deltaTime) {
+	// Las islas son las de `buildIslands`: una duerme solo si todos sus cuerpos llevan quietos `kTimeToSleep`
+	m_islandStill.assign(m_awakeCount, kTimeToSleep);
+	float stillSq = kSleepSpeed * kSleepSpeed;
+	for (uint32_t slot = 0; slot < m_awakeCount; ++slot) {
+		bool still = m_vx[slot] * m_vx[slot] + m_vy[slot] * m_vy[slot] < stillSq;
+		m_stillTime[slot] = still ? m_stillTime[slot] + deltaTime : 0.0f;
+		uint32_t root = findIsland(slot);
+		m_islandStill[root] = std::min(m_islandStill[root], m_stillTime[slot]);
+	}
+	m_islandId.assign(m_awakeCount, kNoIsland);
+	bool anySleeping = false;
+	for (uint32_t slot = 0; slot < m_awakeCount; ++slot) {
+		uint32_t root = findIsland(slot);
+		if (m_islandStill[root] >= kTimeToSleep) {
+			if (m_islandId[root] == kNoIsland) {
+				m_islandId[root] = m_nextIsland++;
+				// Sin chocar con `kNoIsland`
+				if (m_nextIsland == kNoIsland) {
+					m_nextIsland = 0;
+				}
+			}
+			m_island[slot] = m_islandId[root];
+			anySleeping = true;
+		}
+	}
+	if (!anySleeping) {
+		return;
+	}
+
+	// Los que se duermen pasan al tramo de atrs, quietos del todo
+	for (uint32_t slot = m_awakeCount; slot-- > 0;) {
+		if (m_island[slot] != kNoIsland) {
+			m_vx[slot] = 0.0f;
+			m_vy[slot] = 0.0f;
+			swapSlots(slot, m_awakeCount - 1);
+			--m_awakeCount;
+		}
+	}
+}
+
+void
+PhysicsWorld::swapSlots(uint32_t a, uint32_t b) {
+	if (a == b) {
+		return;
+	}
+	std::swap(m_x[a], m_x[b]);
+	std::swap(m_y[a], m_y[b]);
+	std::swap(m_vx[a], m_vx[b]);
+	std::swap(m_vy[a], m_vy[b]);
+	std::swap(m_inverseMass[a], m_inverseMass[b]);
+	std::swap(m_restitution[a], m_restitution[b]);
+	std::swap(m_stillTime[a], m_stillTime[b]);
+	std::swap(m_localBox[a], m_localBox[b]);
+	std::swap(m_proxy[a], m_proxy[b]);
+	std::swap(m_island[a], m_island[b]);
+	std::swap(m_transform[a], m_transform[b]);
+	std::swap(m_bodyOfSlot[a], m_bodyOfSlot[b]);
+	m_slotOfBody[m_bodyOfSlot[a]] = a;
+	m_slotOfBody[m_bodyOfSlot[b]] = b;
+}
+
+uint32_t
+PhysicsWorld::findIsland(uint32_t slot) {
+	while (m_islandParent[slot] != slot) {
+		m_islandParent[slot] = m_islandParent[m_islandParent[slot]];
+		slot = m_islandParent[slot];
+	}
+	return slot;
+}
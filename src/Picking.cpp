@@ -0,0 +1,137 @@
+#include "Picking.h"
+#include <algorithm>
+#include "Jobs/JobSystem.h"
+#include "MeshRenderer.h"
+#include "Render/SpatialGrid.h"
+#include "Transform.h"
+
+namespace {
+	/**
+	 * @brief Sombra en el plano de la caja local `[low, high]` llevada al mundo por `world`.
+	 */
+	Aabb
+	footprint(const Mat4& world, const sf::Vector3f& low, const sf::Vector3f& high) {
+		sf::Vector3f first = world.transformPoint(low);
+		Aabb bounds{ first.x, first.y, first.x, first.y };
+		for (int corner = 1; corner < 8; ++corner) {
+			sf::Vector3f point = world.transformPoint(sf::Vector3f((corner & 1) ? high.x : low.x,
+				(corner & 2) ? high.y : low.y, (corner & 4) ? high.z : low.z));
+			bounds.minX = std::min(bounds.minX, point.x);
+			bounds.minY = std::min(bounds.minY, point.y);
+			bounds.maxX = std::max(bounds.maxX, point.x);
+			bounds.maxY = std::max(bounds.maxY, point.y);
+		}
+		return bounds;
+	}
+}
+
+void
+Picking::syncMeshes(World& world, uint32_t since) {
+	world.view<const Transform, MeshRenderer>().eachChanged<Transform, MeshRenderer>(since,
+		[this](EntityId, const Transform&, MeshRenderer& renderer) {
+			if (!renderer.m_mesh) {
+				if (renderer.m_pickProxy != AabbTree::kNullNode) {
+					removeMesh(renderer);
+				}
+				return;
+			}
+			Aabb bounds = footprint(renderer.getWorldMatrix(), renderer.m_mesh->boundsMin(), renderer.m_mesh->boundsMax());
+			if (renderer.m_pickProxy == AabbTree::kNullNode) {
+				renderer.m_pickProxy = m_tree.createProxy(bounds, &renderer);
+				renderer.m_pickBounds = bounds;
+				return;
+			}
+			const Aabb& last = renderer.m_pickBounds;
+			sf::Vector2f displacement(0.5f * ((bounds.minX + bounds.maxX) - (last.minX + last.maxX)),
+				0.5f * ((bounds.minY + bounds.maxY) - (last.minY + last.maxY)));
+			renderer.m_pickBounds = bounds;
+			m_tree.moveProxy(renderer.m_pickProxy, bounds, displacement);
+		});
+}
+
+void
+Picking::removeMesh(MeshRenderer& mesh) {
+	if (mesh.m_pickProxy == AabbTree::kNullNode) {
+		return;
+	}
+	m_tree.destroyProxy(mesh.m_pickProxy);
+	mesh.m_pickProxy = AabbTree::kNullNode;
+}
+
+bool
+Picking::raycast(const PickRay& ray, PickHit& hit) const {
+	sf::Vector2f from(ray.origin.x, ray.origin.y);
+	sf::Vector2f to(ray.origin.x + ray.direction.x * ray.maxDistance, ray.origin.y + ray.direction.y * ray.maxDistance);
+	MeshRenderer* closest = nullptr;
+	float closestDistance = ray.maxDistance;
+	sf::Vector2f inverse(1.0f / (to.x - from.x), 1.0f / (to.y - from.y));
+	m_tree.raycast(from, to, [&](uint32_t proxy) {
+		MeshRenderer* renderer = static_cast<MeshRenderer*>(m_tree.userData(proxy));
+		// La caja gorda es ms grande que la sombra: la real descarta antes que los tringulos
+		float distance = 0.0f;
+		if (renderer->m_pickBounds.intersectsSegment(from, inverse) &&
+		    renderer->raycast(ray.origin, ray.direction, closestDistance, distance)) {
+			closest = renderer;
+			closestDistance = distance;
+		}
+		return true;
+	});
+	if (!closest) {
+		return false;
+	}
+	hit.mesh = closest;
+	hit.distance = closestDistance;
+	return true;
+}
+
+void
+Picking::queryMeshes(const sf::FloatRect& area, std::vector<MeshRenderer*>& out) const {
+	Aabb box = Aabb::fromRect(area);
+	m_tree.query(box, [&](uint32_t proxy) {
+		MeshRenderer* renderer = static_cast<MeshRenderer*>(m_tree.userData(proxy));
+		if (renderer->m_pickBounds.overlaps(box)) {
+			out.push_back(renderer);
+		}
+		return true;
+	});
+}
+
+Entity*
+Picking::pickActor(const sf::Vector2f& point) const {
+	return EngineUtilities::TService<SpatialGrid>::instance().pickPoint(point);
+}
+
+void
+Picking::queryActors(const sf::FloatRect& area, std::vector<Entity*>& out) const {
+	EngineUtilities::TService<SpatialGrid>::instance().queryArea(area, out);
+}
+
+void
+Picking::raycastBatch(std::span<const PickRay> rays, std::span<PickHit> hits, JobSystem* jobs) const {
+	auto work = [this, rays, hits](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			hits[i] = PickHit();
+			raycast(rays[i], hits[i]);
+		}
+	};
+	if (!jobs) {
+		work(0, rays.size());
+		return;
+	}
+	jobs->parallelFor(rays.size(), kBatchGrain, work);
+}
+
+void
+Picking::pickActorBatch(std::span<const sf::Vector2f> points, std::span<Entity*> hits, JobSystem* jobs) const {
+	const SpatialGrid& grid = EngineUtilities::TService<SpatialGrid>::instance();
+	auto work = [&grid, points, hits](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			hits[i] = grid.pickPoint(points[i]);
+		}
+	};
+	if (!jobs) {
+		work(0, points.size());
+		return;
+	}
+	jobs->parallelFor(points.size(), kBatchGrain, work);
+}
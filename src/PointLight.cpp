@@ -0,0 +1,21 @@
+#include "PointLight.h"
+#include "Render/RenderCommandBuffer.h"
+
+void
+PointLight::render(RenderCommandBuffer& commands) {
+	if (m_radius <= 0.0f || m_intensity <= 0.0f) {
+		return;
+	}
+	sf::Vector2f position = m_transform ? m_transform->getRenderTransform().transformPoint(0.0f, 0.0f) : sf::Vector2f();
+	float scale = m_intensity / 255.0f;
+
+	PointLightData light;
+	light.position[0] = position.x;
+	light.position[1] = position.y;
+	light.position[2] = m_height;
+	light.position[3] = m_radius;
+	light.color[0] = m_color.r * scale;
+	light.color[1] = m_color.g * scale;
+	light.color[2] = m_color.b * scale;
+	commands.addLight(light);
+}
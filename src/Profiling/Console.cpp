@@ -0,0 +1,217 @@
+#include "Profiling/Console.h"
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <sstream>
+
+namespace {
+	bool
+	isSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	void
+	splitWords(std::string_view text, std::vector<std::string_view>& out) {
+		out.clear();
+		size_t at = 0;
+		while (at < text.size()) {
+			while (at < text.size() && isSpace(text[at])) {
+				++at;
+			}
+			size_t start = at;
+			while (at < text.size() && !isSpace(text[at])) {
+				++at;
+			}
+			if (at > start) {
+				out.push_back(text.substr(start, at - start));
+			}
+		}
+	}
+}
+
+void
+Console::addVariable(std::string name, std::string help, std::function<std::string()> get,
+                     std::function<bool(std::string_view)> set) {
+	m_variables.push_back({ std::move(name), std::move(help), std::move(get), std::move(set) });
+}
+
+void
+Console::addBool(std::string name, std::string help, std::function<bool()> get, std::function<void(bool)> set) {
+	addVariable(std::move(name), std::move(help),
+		[get = std::move(get)]() { return std::string(get() ? "1" : "0"); },
+		[set = std::move(set)](std::string_view text) {
+			bool value = false;
+			if (!parseBool(text, value)) {
+				return false;
+			}
+			set(value);
+			return true;
+		});
+}
+
+void
+Console::addFloat(std::string name, std::string help, std::function<float()> get, std::function<bool(float)> set) {
+	addVariable(std::move(name), std::move(help),
+		[get = std::move(get)]() {
+			std::ostringstream text;
+			text << get();
+			return text.str();
+		},
+		[set = std::move(set)](std::string_view text) {
+			float value = 0.0f;
+			return parseFloat(text, value) && set(value);
+		});
+}
+
+void
+Console::addCommand(std::string name, std::string usage, std::string help, Command command) {
+	m_commands.push_back({ std::move(name), std::move(usage), std::move(help), std::move(command) });
+}
+
+bool
+Console::execute(std::string_view line) {
+	bool succeeded = true;
+	std::vector<std::string_view> words;
+	while (!line.empty()) {
+		size_t end = std::min(line.find(';'), line.size());
+		splitWords(line.substr(0, end), words);
+		if (!words.empty()) {
+			succeeded = run(words) && succeeded;
+		}
+		line.remove_prefix(std::min(end + 1, line.size()));
+	}
+	return succeeded;
+}
+
+bool
+Console::run(std::span<const std::string_view> words) {
+	std::string_view name = words[0];
+	if (name == "help") {
+		printHelp();
+		return true;
+	}
+	for (Variable& variable : m_variables) {
+		if (variable.name != name) {
+			continue;
+		}
+		if (words.size() > 1 && !variable.set(words[1])) {
+			print("valor no vlido para " + variable.name + ": " + std::string(words[1]));
+			return false;
+		}
+		print(variable.name + " = " + variable.get());
+		return true;
+	}
+	for (Entry& entry : m_commands) {
+		if (entry.name != name) {
+			continue;
+		}
+		if (!entry.command(words.subspan(1))) {
+			print("uso: " + entry.name + " " + entry.usage);
+			return false;
+		}
+		return true;
+	}
+	print("no existe: " + std::string(name));
+	return false;
+}
+
+void
+Console::printHelp() {
+	for (const Variable& variable : m_variables) {
+		print(variable.name + " = " + variable.get() + "  " + variable.help);
+	}
+	for (const Entry& entry : m_commands) {
+		print(entry.name + " " + entry.usage + "  " + entry.help);
+	}
+}
+
+void
+Console::print(std::string_view text) {
+	std::cout << text << "\n";
+	while (true) {
+		size_t end = text.find('\n');
+		m_lines.emplace_back(text.substr(0, end));
+		if (end == std::string_view::npos) {
+			break;
+		}
+		text.remove_prefix(end + 1);
+	}
+	if (m_lines.size() > kMaxLines) {
+		m_lines.erase(m_lines.begin(), m_lines.end() - kMaxLines);
+	}
+}
+
+void
+Console::type(uint32_t unicode) {
+	if (unicode == '\b') {
+		if (!m_input.empty()) {
+			m_input.pop_back();
+		}
+		return;
+	}
+	if (unicode == '\r' || unicode == '\n') {
+		if (m_input.empty()) {
+			return;
+		}
+		std::string line = std::move(m_input);
+		m_input.clear();
+		print("> " + line);
+		m_history.push_back(line);
+		m_recalled = m_history.size();
+		if (m_typedHook) {
+			m_typedHook(line);
+		}
+		execute(line);
+		return;
+	}
+	// Solo ASCII: la fuente del overlay y los nombres no necesitan ms
+	if (unicode < 32 || unicode > 126 || unicode == '`' || unicode == '~' || m_input.size() >= kMaxInputChars) {
+		return;
+	}
+	m_input.push_back(static_cast<char>(unicode));
+}
+
+void
+Console::recall(int direction) {
+	if (m_history.empty()) {
+		return;
+	}
+	if (direction < 0 && m_recalled > 0) {
+		--m_recalled;
+	}
+	else if (direction > 0 && m_recalled < m_history.size()) {
+		++m_recalled;
+	}
+	m_input = m_recalled < m_history.size() ? m_history[m_recalled] : std::string();
+}
+
+std::string
+Console::text() const {
+	std::string text;
+	size_t first = m_lines.size() > kVisibleLines ? m_lines.size() - kVisibleLines : 0;
+	for (size_t i = first; i < m_lines.size(); ++i) {
+		text += m_lines[i];
+		text += '\n';
+	}
+	text += "> " + m_input + "_";
+	return text;
+}
+
+bool
+Console::parseBool(std::string_view text, bool& out) {
+	if (text == "1" || text == "on" || text == "true") {
+		out = true;
+		return true;
+	}
+	if (text == "0" || text == "off" || text == "false") {
+		out = false;
+		return true;
+	}
+	return false;
+}
+
+bool
+Console::parseFloat(std::string_view text, float& out) {
+	std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), out);
+	return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
@@ -0,0 +1,142 @@
+#include "Profiling/EntityCostProfiler.h"
+#include <algorithm>
+#include "Entity.h"
+
+namespace {
+	constexpr double kNsToMs = 1.0 / 1000000.0;
+
+	/**
+	 * @brief `average` un paso hacia `sample`.
+	 */
+	void
+	smooth(double& average, double sample) { average += EntityCostProfiler::kSmoothing * (sample - average); }
+}
+
+void
+EntityCostProfiler::setEnabled(bool enabled) {
+	m_enabled = enabled;
+	m_sampling = enabled;
+	m_frame = 0;
+	if (!enabled) {
+		m_samples = 0;
+		m_slots = {};
+		m_touched = {};
+		m_tracked = {};
+		m_frameComponentNs = {};
+		m_componentMs = {};
+	}
+}
+
+EntityCostProfiler::Slot&
+EntityCostProfiler::slot(EntityHandle handle) {
+	if (handle.index >= m_slots.size()) {
+		m_slots.resize(handle.index + 1);
+	}
+	Slot& slot = m_slots[handle.index];
+	if (slot.generation != handle.generation) {
+		// Otra entidad en el mismo ndice: lo de la anterior no es suyo
+		bool touched = slot.touched;
+		bool tracked = slot.tracked;
+		slot = Slot{};
+		slot.generation = handle.generation;
+		slot.touched = touched;
+		slot.tracked = tracked;
+	}
+	if (!slot.touched) {
+		slot.touched = true;
+		m_touched.push_back(handle.index);
+	}
+	return slot;
+}
+
+void
+EntityCostProfiler::addUpdate(const Entity& entity, ComponentType type, int64_t ns) {
+	slot(entity.getHandle()).updateNs += ns;
+	m_frameComponentNs[type] += ns;
+}
+
+void
+EntityCostProfiler::addRender(const Entity& entity, int64_t ns) {
+	slot(entity.getHandle()).renderNs += ns;
+}
+
+bool
+EntityCostProfiler::endFrame() {
+	if (!m_enabled) {
+		return false;
+	}
+	bool sampled = m_sampling;
+	m_frame = sampled ? 0 : m_frame + 1;
+	m_sampling = m_frame + 1 >= m_sampleEvery;
+	if (!sampled) {
+		return false;
+	}
+
+	++m_samples;
+	for (uint32_t index : m_touched) {
+		Slot& entry = m_slots[index];
+		entry.touched = false;
+		if (!entry.tracked) {
+			// La primera vez el promedio es lo medido, no una fraccin de eso
+			entry.tracked = true;
+			entry.updateMs = entry.updateNs * kNsToMs;
+			entry.renderMs = entry.renderNs * kNsToMs;
+			m_tracked.push_back(index);
+		}
+		entry.lastSample = m_samples;
+	}
+	m_touched.clear();
+
+	for (size_t i = 0; i < m_tracked.size();) {
+		Slot& entry = m_slots[m_tracked[i]];
+		if (m_samples - entry.lastSample >= kForgetSamples) {
+			entry = Slot{};
+			m_tracked[i] = m_tracked.back();
+			m_tracked.pop_back();
+			continue;
+		}
+		smooth(entry.updateMs, entry.updateNs * kNsToMs);
+		smooth(entry.renderMs, entry.renderNs * kNsToMs);
+		entry.updateNs = 0;
+		entry.renderNs = 0;
+		++i;
+	}
+
+	for (size_t type = 0; type < kComponentTypeCount; ++type) {
+		smooth(m_componentMs[type], m_frameComponentNs[type] * kNsToMs);
+	}
+	m_frameComponentNs = {};
+	return true;
+}
+
+void
+EntityCostProfiler::report(EntityCostReport& out, size_t count) const {
+	out.samples = m_samples;
+	out.sampleEvery = m_sampleEvery;
+	out.componentMs = m_componentMs;
+	out.top.clear();
+	for (uint32_t index : m_tracked) {
+		const Slot& entry = m_slots[index];
+		out.top.push_back({ EntityHandle{ index, entry.generation }, kNoName, entry.updateMs, entry.renderMs });
+	}
+	count = std::min(count, out.top.size());
+	std::partial_sort(out.top.begin(), out.top.begin() + count, out.top.end(),
+		[](const EntityCost& a, const EntityCost& b) { return a.totalMs() > b.totalMs(); });
+	out.top.resize(count);
+
+	const EntityRegistry* registry = EngineUtilities::TService<EntityRegistry>::get();
+	for (EntityCost& cost : out.top) {
+		cost.name = registry ? registry->name(cost.entity) : kNoName;
+	}
+}
+
+const char*
+EntityCostProfiler::componentTypeName(ComponentType type) {
+	static const char* const kNames[kFirstUserComponentType] = {
+		"none", "transform", "sprite", "renderer", "physics", "audio", "shape", "camera", "particles", "tilemap", "light",
+	};
+	static const char* const kUserNames[kComponentTypeCount - kFirstUserComponentType] = {
+		"type 11", "type 12", "type 13", "type 14", "type 15",
+	};
+	return type < kFirstUserComponentType ? kNames[type] : kUserNames[type - kFirstUserComponentType];
+}
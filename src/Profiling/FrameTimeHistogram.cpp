@@ -0,0 +1,72 @@
+#include "Profiling/FrameTimeHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+void
+FrameTimeHistogram::add(double ms) {
+	uint32_t bucket = ms > 0.0 ? static_cast<uint32_t>(std::min(ms / kBucketMs, double(kBuckets - 1))) : 0;
+	++m_buckets[bucket];
+	++m_count;
+	m_maxMs = std::max(m_maxMs, ms);
+}
+
+void
+FrameTimeHistogram::reset() {
+	m_buckets.fill(0);
+	m_count = 0;
+	m_maxMs = 0.0;
+}
+
+double
+FrameTimeHistogram::percentile(double p) const {
+	if (m_count == 0) {
+		return 0.0;
+	}
+	// El primero cuya cuenta acumulada llega al rango pedido
+	uint32_t rank = std::max(1u, static_cast<uint32_t>(std::ceil(p * m_count)));
+	uint32_t seen = 0;
+	for (uint32_t bucket = 0; bucket < kBuckets; ++bucket) {
+		seen += m_buckets[bucket];
+		if (seen >= rank) {
+			return std::min((bucket + 1) * kBucketMs, m_maxMs);
+		}
+	}
+	return m_maxMs;
+}
+
+uint32_t
+FrameTimeHistogram::countAbove(double ms) const {
+	uint32_t first = static_cast<uint32_t>(std::clamp(std::ceil(ms / kBucketMs), 0.0, double(kBuckets)));
+	uint32_t above = 0;
+	for (uint32_t bucket = first; bucket < kBuckets; ++bucket) {
+		above += m_buckets[bucket];
+	}
+	return above;
+}
+
+bool
+FrameTimeMonitor::addFrame(double frameMs, double updateMs, double renderMs) {
+	m_frame.add(frameMs);
+	m_update.add(updateMs);
+	m_render.add(renderMs);
+	m_elapsedMs += frameMs;
+	if (m_period <= 0.0 || m_elapsedMs < m_period * 1000.0) {
+		return false;
+	}
+	m_report.frames = m_frame.count();
+	m_report.seconds = m_elapsedMs / 1000.0;
+	m_report.frame = summarize(m_frame);
+	m_report.update = summarize(m_update);
+	m_report.render = summarize(m_render);
+	m_report.hitches = m_frame.countAbove(kHitchFactor * m_report.frame.p50Ms);
+	m_frame.reset();
+	m_update.reset();
+	m_render.reset();
+	m_elapsedMs = 0.0;
+	return true;
+}
+
+FramePhaseTimes
+FrameTimeMonitor::summarize(const FrameTimeHistogram& histogram) {
+	return { histogram.percentile(0.50), histogram.percentile(0.95), histogram.percentile(0.99), histogram.maxMs() };
+}
@@ -0,0 +1,137 @@
+#include "Profiling/HardwareCounters.h"
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#if defined(__linux__)
+	/**
+	 * @brief El grupo de contadores de un hilo; se cierra cuando el hilo termina.
+	 */
+	struct CounterGroup {
+		static constexpr uint64_t kEvents[4] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		                                         PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+		int fds[4] = { -1, -1, -1, -1 };
+		bool tried = false;
+
+		~CounterGroup() {
+			for (int fd : fds) {
+				if (fd >= 0) {
+					close(fd);
+				}
+			}
+		}
+
+		/**
+		 * @return `false` si el primero (el lder del grupo) no pudo abrirse.
+		 */
+		bool
+		open() {
+			tried = true;
+			for (size_t i = 0; i < 4; ++i) {
+				perf_event_attr attributes;
+				std::memset(&attributes, 0, sizeof(attributes));
+				attributes.type = PERF_TYPE_HARDWARE;
+				attributes.size = sizeof(attributes);
+				attributes.config = kEvents[i];
+				attributes.read_format = PERF_FORMAT_GROUP;
+				attributes.disabled = i == 0;
+				attributes.exclude_kernel = 1;
+				attributes.exclude_hv = 1;
+				// Este hilo, en cualquier ncleo
+				fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, i == 0 ? -1 : fds[0], 0));
+				if (fds[0] < 0) {
+					return false;
+				}
+			}
+			ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			return true;
+		}
+
+		bool
+		read(HardwareCounterValues& out) {
+			if (!tried) {
+				open();
+			}
+			if (fds[0] < 0) {
+				return false;
+			}
+			// Con PERF_FORMAT_GROUP: cuntos y sus valores, en el orden en que se abrieron
+			uint64_t values[1 + 4] = {};
+			if (::read(fds[0], values, sizeof(values)) < static_cast<ssize_t>(sizeof(uint64_t))) {
+				return false;
+			}
+			uint64_t* targets[4] = { &out.cycles, &out.instructions, &out.cacheMisses, &out.branchMisses };
+			for (size_t i = 0, slot = 0; i < 4 && slot < values[0]; ++i) {
+				// Un contador que no abri no ocupa lugar en el grupo
+				if (fds[i] >= 0) {
+					*targets[i] = values[1 + slot++];
+				}
+			}
+			return true;
+		}
+	};
+
+	thread_local CounterGroup t_group;
+#endif
+}
+
+bool
+HardwareCounters::setEnabled(bool enabled) {
+	if (enabled) {
+		HardwareCounterValues probe;
+		if (!read(probe)) {
+			s_enabled.store(false, std::memory_order_relaxed);
+			return false;
+		}
+	}
+	s_enabled.store(enabled, std::memory_order_relaxed);
+	return true;
+}
+
+bool
+HardwareCounters::read(HardwareCounterValues& out) {
+	out = HardwareCounterValues();
+#if defined(_WIN32)
+	ULONG64 cycles = 0;
+	if (!QueryThreadCycleTime(GetCurrentThread(), &cycles)) {
+		return false;
+	}
+	out.cycles = cycles;
+	return true;
+#elif defined(__linux__)
+	return t_group.read(out);
+#else
+	return false;
+#endif
+}
+
+uint32_t
+HardwareCounters::available() {
+#if defined(_WIN32)
+	return kCycles;
+#elif defined(__linux__)
+	HardwareCounterValues probe;
+	if (!t_group.read(probe)) {
+		return 0;
+	}
+	uint32_t bits = 0;
+	for (size_t i = 0; i < 4; ++i) {
+		bits |= t_group.fds[i] >= 0 ? 1u << i : 0u;
+	}
+	return bits;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,75 @@
+#include "Profiling/HitchRecorder.h"
+#include <algorithm>
+#include <cstdio>
+
+HitchRecorder::~HitchRecorder() {
+	m_jobs.wait(m_writing);
+}
+
+void
+HitchRecorder::setThreshold(double thresholdMs, double seconds, const std::string& directory) {
+	m_thresholdMs = thresholdMs > 0.0 ? thresholdMs : 0.0;
+	m_seconds = seconds > 0.0 ? seconds : kDefaultSeconds;
+	m_directory = directory.empty() ? "." : directory;
+	m_next = 0;
+	m_count = 0;
+	if (!isEnabled()) {
+		// La traza en escritura usa su propia copia; el anillo puede soltarse ya
+		std::vector<Frame>().swap(m_ring);
+	}
+	else if (m_ring.size() != kMaxFrames) {
+		m_ring.resize(kMaxFrames);
+	}
+}
+
+bool
+HitchRecorder::addFrame(const Profiler& profiler) {
+	if (!isEnabled()) {
+		return false;
+	}
+	const ProfileFrame& last = profiler.lastFrame();
+	Frame& frame = m_ring[m_next];
+	frame.zones.assign(profiler.lastZones().begin(), profiler.lastZones().end());
+	frame.counters.assign(profiler.lastCounters().begin(), profiler.lastCounters().end());
+	frame.end = last.end;
+	frame.start = last.end - static_cast<int64_t>(last.frameMs * 1.0e6);
+	m_next = (m_next + 1) % kMaxFrames;
+	m_count = std::min(m_count + 1, kMaxFrames);
+
+	if (last.frameMs <= m_thresholdMs || m_count <= kWarmupFrames) {
+		return false;
+	}
+	if (!m_writing.isDone()) {
+		++m_skipped;
+		return false;
+	}
+	dump(profiler, frame);
+	return true;
+}
+
+void
+HitchRecorder::dump(const Profiler& profiler, const Frame& hitch) {
+	char name[32];
+	std::snprintf(name, sizeof(name), "hitch_%03u.json", m_dumps++);
+	m_lastPath = m_directory + "/" + name;
+
+	// Del ms viejo que entra en la ventana hasta el tirn, en orden
+	int64_t since = hitch.end - static_cast<int64_t>(m_seconds * 1.0e9);
+	size_t frames = 0;
+	while (frames < m_count && m_ring[(m_next + kMaxFrames - 1 - frames) % kMaxFrames].end >= since) {
+		++frames;
+	}
+	m_dump.start(m_lastPath, static_cast<uint32_t>(frames));
+	for (size_t i = frames; i > 0; --i) {
+		const Frame& frame = m_ring[(m_next + kMaxFrames - i) % kMaxFrames];
+		m_dump.addFrame(frame.zones, frame.counters, frame.end);
+	}
+	m_dump.markHitch(hitch.start, hitch.end);
+
+	const Profiler* source = &profiler;
+	m_jobs.run([this, source]() {
+		if (!m_dump.write(*source)) {
+			m_failed.fetch_add(1, std::memory_order_relaxed);
+		}
+	}, &m_writing);
+}
@@ -0,0 +1,141 @@
+#include "Profiling/Microbenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+namespace {
+	double
+	median(std::vector<double>& values) {
+		if (values.empty()) {
+			return 0.0;
+		}
+		std::sort(values.begin(), values.end());
+		size_t middle = values.size() / 2;
+		return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+	}
+}
+
+void
+MicrobenchmarkSuite::add(const char* name, Prepare prepare) {
+	m_cases.push_back({ name, std::move(prepare) });
+}
+
+const std::vector<MicrobenchmarkResult>&
+MicrobenchmarkSuite::run(const MicrobenchmarkOptions& options, std::ostream& out) {
+	using Clock = std::chrono::steady_clock;
+	m_results.clear();
+	for (const Case& benchmark : m_cases) {
+		if (!options.filter.empty() && std::string(benchmark.name).find(options.filter) == std::string::npos) {
+			continue;
+		}
+		for (size_t size : options.sizes) {
+			Operation operation = benchmark.prepare(size);
+			if (!operation || size == 0) {
+				continue;
+			}
+			// Una vuelta para calibrar, que tambin calienta cachs
+			Clock::time_point start = Clock::now();
+			operation();
+			double onceMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			uint64_t repetitions = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(options.minSampleMs / std::max(onceMs, 1e-6))));
+
+			std::vector<double> samples;
+			samples.reserve(options.samples);
+			for (uint32_t sample = 0; sample < options.warmupSamples + options.samples; ++sample) {
+				start = Clock::now();
+				for (uint64_t i = 0; i < repetitions; ++i) {
+					operation();
+				}
+				double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+				if (sample >= options.warmupSamples) {
+					samples.push_back(ns / (static_cast<double>(repetitions) * size));
+				}
+			}
+			const MicrobenchmarkResult& result = m_results.emplace_back(summarize(benchmark.name, size, repetitions, std::move(samples)));
+			char line[256];
+			std::snprintf(line, sizeof(line), "%-28s %8zu  %10.2f ns  +-%.2f  mad %.2f  min %.2f  (%u fuera)\n", result.name.c_str(),
+			              result.size, result.medianNs, result.ci95Ns, result.madNs, result.minNs, result.outliers);
+			out << line;
+		}
+	}
+	return m_results;
+}
+
+MicrobenchmarkResult
+MicrobenchmarkSuite::summarize(const char* name, size_t size, uint64_t repetitions, std::vector<double> samples) {
+	MicrobenchmarkResult result;
+	result.name = name;
+	result.size = size;
+	result.repetitions = repetitions;
+	result.samplesNs = samples;
+	if (samples.empty()) {
+		return result;
+	}
+	double sum = 0.0;
+	for (double value : samples) {
+		sum += value;
+	}
+	result.meanNs = sum / samples.size();
+	double squares = 0.0;
+	for (double value : samples) {
+		squares += (value - result.meanNs) * (value - result.meanNs);
+	}
+	result.stddevNs = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+	result.ci95Ns = 1.96 * result.stddevNs / std::sqrt(static_cast<double>(samples.size()));
+	result.medianNs = median(samples);
+	result.minNs = samples.front();
+	result.maxNs = samples.back();
+	std::vector<double> deviations;
+	deviations.reserve(samples.size());
+	for (double value : samples) {
+		deviations.push_back(std::abs(value - result.medianNs));
+	}
+	result.madNs = median(deviations);
+	for (double value : samples) {
+		if (std::abs(value - result.medianNs) > 3.0 * result.madNs && result.madNs > 0.0) {
+			++result.outliers;
+		}
+	}
+	return result;
+}
+
+bool
+MicrobenchmarkSuite::write(const std::string& path) const {
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if (!file) {
+		return false;
+	}
+	bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+	if (json) {
+		std::fprintf(file, "[\n");
+	}
+	else {
+		std::fprintf(file, "name,size,repetitions,median_ns,mean_ns,stddev_ns,min_ns,max_ns,mad_ns,ci95_ns,outliers\n");
+	}
+	for (size_t i = 0; i < m_results.size(); ++i) {
+		const MicrobenchmarkResult& r = m_results[i];
+		if (json) {
+			std::fprintf(file,
+			             "  {\"name\": \"%s\", \"size\": %zu, \"repetitions\": %llu, \"median_ns\": %.4f, \"mean_ns\": %.4f, "
+			             "\"stddev_ns\": %.4f, \"min_ns\": %.4f, \"max_ns\": %.4f, \"mad_ns\": %.4f, \"ci95_ns\": %.4f, "
+			             "\"outliers\": %u, \"samples_ns\": [",
+			             r.name.c_str(), r.size, static_cast<unsigned long long>(r.repetitions), r.medianNs, r.meanNs,
+			             r.stddevNs, r.minNs, r.maxNs, r.madNs, r.ci95Ns, r.outliers);
+			for (size_t s = 0; s < r.samplesNs.size(); ++s) {
+				std::fprintf(file, "%s%.4f", s ? ", " : "", r.samplesNs[s]);
+			}
+			std::fprintf(file, "]}%s\n", i + 1 < m_results.size() ? "," : "");
+		}
+		else {
+			std::fprintf(file, "%s,%zu,%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%u\n", r.name.c_str(), r.size,
+			             static_cast<unsigned long long>(r.repetitions), r.medianNs, r.meanNs, r.stddevNs, r.minNs,
+			             r.maxNs, r.madNs, r.ci95Ns, r.outliers);
+		}
+	}
+	if (json) {
+		std::fprintf(file, "]\n");
+	}
+	return std::fclose(file) == 0;
+}
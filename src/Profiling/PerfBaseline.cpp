@@ -0,0 +1,349 @@
+#include "Profiling/PerfBaseline.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include "Prerequisites.h"
+#include "Profiling/Microbenchmark.h"
+#include "ScalingReport.h"
+
+namespace {
+	/**
+	 * @brief Lo justo de JSON para los archivos de resultados: arreglos de objetos con textos,
+	 *        nmeros y arreglos de nmeros.
+	 */
+	class
+	ResultsReader {
+	public:
+		explicit
+		ResultsReader(const std::string& text) : m_text(text) {}
+
+		bool
+		read(std::vector<PerfRecord>& out) {
+			if (!consume('[')) {
+				return false;
+			}
+			if (consume(']')) {
+				return true;
+			}
+			do {
+				PerfRecord record;
+				if (!readObject(record)) {
+					return false;
+				}
+				out.push_back(std::move(record));
+			} while (consume(','));
+			return consume(']');
+		}
+
+	private:
+		void
+		skipSpace() {
+			while (m_at < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_at]))) {
+				++m_at;
+			}
+		}
+
+		bool
+		consume(char c) {
+			skipSpace();
+			if (m_at < m_text.size() && m_text[m_at] == c) {
+				++m_at;
+				return true;
+			}
+			return false;
+		}
+
+		bool
+		readString(std::string& out) {
+			if (!consume('"')) {
+				return false;
+			}
+			out.clear();
+			while (m_at < m_text.size() && m_text[m_at] != '"') {
+				if (m_text[m_at] == '\\' && m_at + 1 < m_text.size()) {
+					++m_at;
+				}
+				out += m_text[m_at++];
+			}
+			return consume('"');
+		}
+
+		bool
+		readNumber(double& out) {
+			skipSpace();
+			const char* start = m_text.c_str() + m_at;
+			char* end = nullptr;
+			out = std::strtod(start, &end);
+			if (end == start) {
+				return false;
+			}
+			m_at += static_cast<size_t>(end - start);
+			return true;
+		}
+
+		/**
+		 * @brief El nombre y el tamao (o los actores) forman la clave; los `_ns` y `_ms`, las mtricas.
+		 */
+		bool
+		readObject(PerfRecord& record) {
+			if (!consume('{')) {
+				return false;
+			}
+			std::string name;
+			std::string size;
+			std::vector<double> samples;
+			do {
+				std::string key;
+				if (!readString(key) || !consume(':')) {
+					return false;
+				}
+				skipSpace();
+				if (m_at < m_text.size() && m_text[m_at] == '"') {
+					std::string value;
+					if (!readString(value)) {
+						return false;
+					}
+					if (key == "name") {
+						name = value;
+					}
+				}
+				else if (consume('[')) {
+					std::vector<double> values;
+					if (!consume(']')) {
+						do {
+							double value = 0.0;
+							if (!readNumber(value)) {
+								return false;
+							}
+							values.push_back(value);
+						} while (consume(','));
+						if (!consume(']')) {
+							return false;
+						}
+					}
+					if (key == "samples_ns") {
+						samples = std::move(values);
+					}
+				}
+				else {
+					double value = 0.0;
+					if (!readNumber(value)) {
+						return false;
+					}
+					if (key == "size" || key == "actors") {
+						size = std::to_string(static_cast<unsigned long long>(value));
+						if (key == "actors") {
+							name = "scaling";
+						}
+					}
+					else if (isCompared(key)) {
+						record.metrics.push_back({ key, value, {} });
+					}
+				}
+			} while (consume(','));
+			if (!consume('}')) {
+				return false;
+			}
+			record.key = name + "/" + size;
+			for (PerfMetric& metric : record.metrics) {
+				if (metric.name == "median_ns") {
+					metric.samples = samples;
+				}
+			}
+			return true;
+		}
+
+		static bool
+		isCompared(const std::string& key) {
+			return key == "median_ns" || key == "update_ms" || key == "render_ms" || key == "frame_p50_ms"
+				|| key == "frame_p99_ms";
+		}
+
+		const std::string& m_text;
+		size_t m_at = 0;
+	};
+}
+
+std::string
+PerfBaseline::pathOf(const std::string& name) {
+	bool json = name.size() >= 5 && name.compare(name.size() - 5, 5, ".json") == 0;
+	return json ? name : std::string(kDirectory) + "/" + name + ".json";
+}
+
+bool
+PerfBaseline::read(const std::string& path, std::vector<PerfRecord>& out) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	std::ostringstream text;
+	text << file.rdbuf();
+	out.clear();
+	return ResultsReader(text.str()).read(out);
+}
+
+std::vector<PerfRecord>
+PerfBaseline::records(const std::vector<MicrobenchmarkResult>& results) {
+	std::vector<PerfRecord> out;
+	for (const MicrobenchmarkResult& result : results) {
+		out.push_back({ result.name + "/" + std::to_string(result.size), { { "median_ns", result.medianNs, result.samplesNs } } });
+	}
+	return out;
+}
+
+std::vector<PerfRecord>
+PerfBaseline::records(const std::vector<ScalingSample>& samples) {
+	std::vector<PerfRecord> out;
+	for (const ScalingSample& sample : samples) {
+		std::string key = "scaling/" + std::to_string(sample.actors);
+		if (sample.threads > 0) {
+			key += "/t" + std::to_string(sample.threads);
+		}
+		PerfRecord& record = out.emplace_back(PerfRecord{ key, {
+			{ "update_ms", sample.updateMs, {} },
+			{ "render_ms", sample.renderMs, {} },
+			{ "frame_p50_ms", sample.frameP50Ms, {} },
+			{ "frame_p99_ms", sample.frameP99Ms, {} } } });
+		for (size_t i = 0; sample.threads > 0 && i < kScalingSystems; ++i) {
+			record.metrics.push_back({ std::string(ScalingReport::systemName(i)) + "_ms", sample.systemMs[i], {} });
+		}
+	}
+	return out;
+}
+
+double
+PerfBaseline::mannWhitneyP(const std::vector<double>& a, const std::vector<double>& b) {
+	size_t n1 = a.size();
+	size_t n2 = b.size();
+	if (n1 == 0 || n2 == 0) {
+		return 1.0;
+	}
+	std::vector<std::pair<double, bool>> all;   // Valor y si es de `a`
+	all.reserve(n1 + n2);
+	for (double value : a) {
+		all.emplace_back(value, true);
+	}
+	for (double value : b) {
+		all.emplace_back(value, false);
+	}
+	std::sort(all.begin(), all.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+
+	// Rangos promedio en los empates; la correccin de la varianza sale de los mismos grupos
+	double rankSumA = 0.0;
+	double ties = 0.0;
+	for (size_t i = 0; i < all.size(); ) {
+		size_t j = i;
+		while (j < all.size() && all[j].first == all[i].first) {
+			++j;
+		}
+		double rank = (i + 1 + j) / 2.0;
+		for (size_t k = i; k < j; ++k) {
+			if (all[k].second) {
+				rankSumA += rank;
+			}
+		}
+		double group = static_cast<double>(j - i);
+		ties += group * group * group - group;
+		i = j;
+	}
+	double n = static_cast<double>(n1 + n2);
+	double u = rankSumA - n1 * (n1 + 1) / 2.0;
+	double mean = n1 * n2 / 2.0;
+	double variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+	if (variance <= 0.0) {
+		return 1.0;
+	}
+	double z = (std::abs(u - mean) - 0.5) / std::sqrt(variance);
+	return std::erfc(std::max(z, 0.0) / std::sqrt(2.0));
+}
+
+size_t
+PerfBaseline::compare(const std::vector<PerfRecord>& baseline, const std::vector<PerfRecord>& current,
+                      const BaselineOptions& options, std::ostream& out) {
+	static constexpr size_t kMinSamples = 5;
+	size_t regressions = 0;
+	size_t improvements = 0;
+	size_t missing = 0;
+	char line[256];
+	for (const PerfRecord& record : current) {
+		auto base = std::find_if(baseline.begin(), baseline.end(), [&](const PerfRecord& r) { return r.key == record.key; });
+		if (base == baseline.end()) {
+			std::snprintf(line, sizeof(line), "  %-36s nuevo, sin lnea base\n", record.key.c_str());
+			out << line;
+			continue;
+		}
+		for (const PerfMetric& metric : record.metrics) {
+			auto before = std::find_if(base->metrics.begin(), base->metrics.end(),
+				[&](const PerfMetric& m) { return m.name == metric.name; });
+			if (before == base->metrics.end() || before->value <= 0.0) {
+				continue;
+			}
+			double change = metric.value / before->value - 1.0;
+			bool tested = metric.samples.size() >= kMinSamples && before->samples.size() >= kMinSamples;
+			double p = tested ? mannWhitneyP(before->samples, metric.samples) : 0.0;
+			bool significant = std::abs(change) > options.threshold && (!tested || p < options.alpha);
+			const char* verdict = "";
+			if (significant && change > 0.0) {
+				verdict = "REGRESION";
+				++regressions;
+			}
+			else if (significant) {
+				verdict = "mejora";
+				++improvements;
+			}
+			if (tested) {
+				std::snprintf(line, sizeof(line), "  %-36s %-13s %12.3f -> %12.3f  %+7.1f%%  p=%.4f  %s\n", record.key.c_str(),
+				              metric.name.c_str(), before->value, metric.value, change * 100.0, p, verdict);
+			}
+			else {
+				std::snprintf(line, sizeof(line), "  %-36s %-13s %12.3f -> %12.3f  %+7.1f%%            %s\n", record.key.c_str(),
+				              metric.name.c_str(), before->value, metric.value, change * 100.0, verdict);
+			}
+			out << line;
+		}
+	}
+	for (const PerfRecord& record : baseline) {
+		if (std::none_of(current.begin(), current.end(), [&](const PerfRecord& r) { return r.key == record.key; })) {
+			++missing;
+		}
+	}
+	std::snprintf(line, sizeof(line), "%zu regresiones, %zu mejoras, %zu de la lnea base sin medir (umbral %.1f%%, alfa %.3f)\n",
+	              regressions, improvements, missing, options.threshold * 100.0, options.alpha);
+	out << line;
+	return regressions;
+}
+
+int
+PerfBaseline::apply(const BaselineOptions& options, const std::vector<PerfRecord>& current,
+                    const std::function<bool(const std::string&)>& writeJson, std::ostream& out) {
+	int status = 0;
+	if (!options.save.empty()) {
+		std::string path = pathOf(options.save);
+		std::error_code error;
+		std::filesystem::path directory = std::filesystem::path(path).parent_path();
+		if (!directory.empty()) {
+			std::filesystem::create_directories(directory, error);
+		}
+		if (!writeJson(path)) {
+			MESSAGE("PerfBaseline", "apply", "could not write the baseline file");
+			status = 1;
+		}
+	}
+	if (!options.compare.empty()) {
+		std::vector<PerfRecord> baseline;
+		if (!read(pathOf(options.compare), baseline)) {
+			MESSAGE("PerfBaseline", "apply", "could not read the baseline file");
+			return 1;
+		}
+		if (compare(baseline, current, options, out) > 0) {
+			status = 2;
+		}
+	}
+	return status;
+}
@@ -0,0 +1,180 @@
+#include "Profiling/Profiler.h"
+#include "Memory/HeapTracker.h"
+#include <algorithm>
+#include <cstring>
+
+Profiler::ThreadBuffer&
+Profiler::threadBuffer() {
+	if (!t_buffer) {
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		m_threads.push_back(EngineUtilities::MakeUnique<ThreadBuffer>());
+		t_buffer = m_threads.back().get();
+		t_buffer->thread = static_cast<uint32_t>(m_threads.size() - 1);
+		t_buffer->id = std::this_thread::get_id();
+	}
+	return *t_buffer;
+}
+
+void
+Profiler::setThreadName(const std::string& name) {
+	ENGINE_TRACY_THREAD_NAME(name.c_str());
+	EngineUtilities::HeapTracker::setThreadName(name.c_str());
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+	std::thread::id id = std::this_thread::get_id();
+	for (std::pair<std::thread::id, std::string>& named : m_threadNames) {
+		if (named.first == id) {
+			named.second = name;
+			return;
+		}
+	}
+	m_threadNames.emplace_back(id, name);
+}
+
+std::string
+Profiler::threadName(uint32_t thread) const {
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+	if (thread >= m_threads.size()) {
+		return std::string();
+	}
+	for (const std::pair<std::thread::id, std::string>& named : m_threadNames) {
+		if (named.first == m_threads[thread]->id) {
+			return named.second;
+		}
+	}
+	return std::string();
+}
+
+void
+Profiler::record(const char* name, int64_t start, int64_t end, uint32_t depth, const HardwareCounterValues& counters) {
+	ThreadBuffer& buffer = threadBuffer();
+	if (!buffer.zones.tryPush({ name, start, end, depth, buffer.thread, counters })) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void
+Profiler::counter(const char* name, double value) {
+	if (!isEnabled()) {
+		return;
+	}
+	ThreadBuffer& buffer = threadBuffer();
+	if (!buffer.counters.tryPush({ name, now(), value })) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void
+Profiler::endFrame() {
+	int64_t time = now();
+	uint32_t self = threadBuffer().thread;
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		m_drain.clear();
+		for (EngineUtilities::TUniquePtr<ThreadBuffer>& buffer : m_threads) {
+			m_drain.push_back(buffer.get());
+		}
+	}
+	m_zones.clear();
+	m_counters.clear();
+	m_frame.dropped = 0;
+	ProfileZone zone;
+	ProfileCounter counter;
+	for (ThreadBuffer* buffer : m_drain) {
+		while (buffer->zones.tryPop(zone)) {
+			m_zones.push_back(zone);
+		}
+		while (buffer->counters.tryPop(counter)) {
+			m_counters.push_back(counter);
+		}
+		uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+		m_frame.dropped += dropped - buffer->reported;
+		buffer->reported = dropped;
+	}
+	// Por hilo y por comienzo; a igual comienzo, la de afuera primero
+	std::sort(m_zones.begin(), m_zones.end(), [](const ProfileZone& a, const ProfileZone& b) {
+		if (a.thread != b.thread) {
+			return a.thread < b.thread;
+		}
+		return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+	});
+	std::stable_sort(m_counters.begin(), m_counters.end(),
+		[](const ProfileCounter& a, const ProfileCounter& b) { return a.time < b.time; });
+
+	m_frame.frame = m_frameCount++;
+	m_frame.frameMs = m_lastFrameEnd ? (time - m_lastFrameEnd) / 1.0e6 : 0.0;
+	m_lastFrameEnd = time;
+	m_frame.end = time;
+	m_frame.threads.clear();
+	for (const ProfileZone& zone : m_zones) {
+		if (zone.thread == self) {
+			continue;
+		}
+		if (m_frame.threads.empty() || m_frame.threads.back().thread != zone.thread) {
+			m_frame.threads.push_back({ zone.thread, 0, 0.0 });
+		}
+		ProfileThread& thread = m_frame.threads.back();
+		++thread.zones;
+		if (zone.depth == 0) {
+			thread.busyMs += (zone.end - zone.start) / 1.0e6;
+		}
+	}
+	buildTree(self);
+}
+
+void
+Profiler::buildTree(uint32_t thread) {
+	// Nodo 0: la raz, sin nombre
+	m_tree.clear();
+	m_tree.emplace_back();
+	m_open.clear();
+	m_open.emplace_back(0, INT64_MAX);
+	auto range = std::equal_range(m_zones.begin(), m_zones.end(), ProfileZone{ nullptr, 0, 0, 0, thread, {} },
+		[](const ProfileZone& a, const ProfileZone& b) { return a.thread < b.thread; });
+	for (auto zone = range.first; zone != range.second; ++zone) {
+		while (m_open.size() > 1 && zone->start >= m_open.back().second) {
+			m_open.pop_back();
+		}
+		uint32_t parent = m_open.back().first;
+		uint32_t node = m_tree[parent].firstChild;
+		while (node != kNoNode && std::strcmp(m_tree[node].name, zone->name) != 0) {
+			node = m_tree[node].nextSibling;
+		}
+		if (node == kNoNode) {
+			node = static_cast<uint32_t>(m_tree.size());
+			TreeNode& created = m_tree.emplace_back();
+			created.name = zone->name;
+			created.depth = static_cast<uint32_t>(m_open.size() - 1);
+			TreeNode& owner = m_tree[parent];
+			if (owner.lastChild == kNoNode) {
+				owner.firstChild = node;
+			}
+			else {
+				m_tree[owner.lastChild].nextSibling = node;
+			}
+			owner.lastChild = node;
+		}
+		++m_tree[node].calls;
+		m_tree[node].nanoseconds += zone->end - zone->start;
+		m_tree[node].counters += zone->counters;
+		m_open.emplace_back(node, zone->end);
+	}
+
+	// Preorden, con la pila de abiertas como pila de recorrido
+	m_frame.nodes.clear();
+	m_open.clear();
+	if (m_tree[0].firstChild != kNoNode) {
+		m_open.emplace_back(m_tree[0].firstChild, 0);
+	}
+	while (!m_open.empty()) {
+		uint32_t node = m_open.back().first;
+		m_open.pop_back();
+		const TreeNode& tree = m_tree[node];
+		m_frame.nodes.push_back({ tree.name, tree.depth, tree.calls, tree.nanoseconds / 1.0e6, tree.counters });
+		if (tree.nextSibling != kNoNode) {
+			m_open.emplace_back(tree.nextSibling, 0);
+		}
+		if (tree.firstChild != kNoNode) {
+			m_open.emplace_back(tree.firstChild, 0);
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#include "Profiling/TraceCapture.h"
+#include <algorithm>
+#include <cstdio>
+
+void
+TraceCapture::start(const std::string& path, uint32_t frames) {
+	m_path = path;
+	m_remaining = frames;
+	m_threads = 0;
+	m_zones.clear();
+	m_counters.clear();
+	m_frameEnds.clear();
+	m_hitches.clear();
+}
+
+bool
+TraceCapture::addFrame(const Profiler& profiler) {
+	return addFrame(profiler.lastZones(), profiler.lastCounters(), profiler.lastFrame().end);
+}
+
+bool
+TraceCapture::addFrame(std::span<const ProfileZone> zones, std::span<const ProfileCounter> counters, int64_t end) {
+	if (m_remaining == 0) {
+		return false;
+	}
+	m_zones.insert(m_zones.end(), zones.begin(), zones.end());
+	for (const ProfileZone& zone : zones) {
+		m_threads = std::max(m_threads, zone.thread + 1);
+	}
+	m_counters.insert(m_counters.end(), counters.begin(), counters.end());
+	m_frameEnds.push_back(end);
+	return --m_remaining == 0;
+}
+
+void
+TraceCapture::markHitch(int64_t start, int64_t end) {
+	m_hitches.emplace_back(start, end);
+}
+
+bool
+TraceCapture::write(const Profiler& profiler) const {
+	std::FILE* file = std::fopen(m_path.c_str(), "w");
+	if (!file) {
+		return false;
+	}
+	int64_t origin = m_frameEnds.empty() ? 0 : m_frameEnds.front();
+	for (const ProfileZone& zone : m_zones) {
+		origin = std::min(origin, zone.start);
+	}
+	for (const std::pair<int64_t, int64_t>& hitch : m_hitches) {
+		origin = std::min(origin, hitch.first);
+	}
+	auto micros = [origin](int64_t time) { return (time - origin) / 1000.0; };
+
+	// Microsegundos; los metadatos primero para que los carriles salgan con su nombre
+	std::fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	std::fprintf(file, "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"Engine\"}}");
+	for (uint32_t thread = 0; thread < m_threads; ++thread) {
+		std::string name = profiler.threadName(thread);
+		if (name.empty()) {
+			name = "Thread " + std::to_string(thread);
+		}
+		std::fprintf(file, ",\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"%s\"}}",
+		             thread, name.c_str());
+	}
+	for (const ProfileZone& zone : m_zones) {
+		std::fprintf(file, ",\n  {\"name\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u",
+		             zone.name, micros(zone.start), (zone.end - zone.start) / 1000.0, zone.thread);
+		// Los contadores del procesador van como argumentos: se ven al elegir la zona
+		const HardwareCounterValues& counters = zone.counters;
+		if (counters.cycles) {
+			std::fprintf(file, ", \"args\": {\"cycles\": %llu, \"instructions\": %llu, \"cache_misses\": %llu, \"branch_misses\": %llu}",
+			             static_cast<unsigned long long>(counters.cycles), static_cast<unsigned long long>(counters.instructions),
+			             static_cast<unsigned long long>(counters.cacheMisses), static_cast<unsigned long long>(counters.branchMisses));
+		}
+		std::fprintf(file, "}");
+	}
+	for (const ProfileCounter& counter : m_counters) {
+		std::fprintf(file, ",\n  {\"name\": \"%s\", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"args\": {\"value\": %g}}",
+		             counter.name, micros(counter.time), counter.value);
+	}
+	for (const std::pair<int64_t, int64_t>& hitch : m_hitches) {
+		double ms = (hitch.second - hitch.first) / 1.0e6;
+		std::fprintf(file, ",\n  {\"name\": \"Hitch\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": 0, "
+		             "\"args\": {\"frame_ms\": %.3f}}", micros(hitch.first), ms * 1000.0, ms);
+	}
+	for (int64_t end : m_frameEnds) {
+		std::fprintf(file, ",\n  {\"name\": \"Frame\", \"ph\": \"i\", \"s\": \"g\", \"ts\": %.3f, \"pid\": 1, \"tid\": 0}", micros(end));
+	}
+	std::fprintf(file, "\n]}\n");
+	return std::fclose(file) == 0;
+}
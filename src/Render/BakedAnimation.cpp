@@ -0,0 +1,32 @@
+#include "Render/BakedAnimation.h"
+#include <algorithm>
+#include <cmath>
+#include "Animation/Skeleton.h"
+#include "Render/MeshPipeline.h"
+
+BakedAnimation::~BakedAnimation() {
+	if (m_pipeline) {
+		m_pipeline->evict(*this);
+	}
+}
+
+void
+BakedAnimation::bake(const Skeleton& skeleton, const SkeletalClip& clip, float frameRate) {
+	m_frameRate = frameRate > 0.0f ? frameRate : kDefaultFrameRate;
+	m_loop = clip.isLooping();
+	m_boneCount = static_cast<uint32_t>(std::min<size_t>(skeleton.boneCount(), clip.boneCount()));
+	// Con `loop`, el ltimo cuadro mezcla con el primero: no se repite
+	float duration = clip.duration();
+	m_frameCount = m_loop ? std::max(1u, static_cast<uint32_t>(std::ceil(duration * m_frameRate)))
+	                      : static_cast<uint32_t>(std::floor(duration * m_frameRate)) + 1;
+	if (m_boneCount == 0 || clip.frameCount() == 0) {
+		m_frameCount = 0;
+	}
+	m_matrices.resize(size_t(m_frameCount) * m_boneCount);
+	std::vector<BonePose> pose(m_boneCount);
+	for (uint32_t frame = 0; frame < m_frameCount; ++frame) {
+		clip.sample(std::min(static_cast<float>(frame) / m_frameRate, duration), pose);
+		skeleton.skinningMatrices(pose, std::span<Mat4>(m_matrices).subspan(size_t(frame) * m_boneCount, m_boneCount));
+	}
+	++m_version;
+}
@@ -0,0 +1,564 @@
+#include "Render/CompressedTexture.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include "Render/GlFunctions.h"
+
+namespace {
+	constexpr uint32_t kDdsMagic = 0x20534444;          ///< "DDS ".
+	constexpr size_t kDdsHeaderSize = 4 + 124;
+	constexpr size_t kDx10HeaderSize = 20;
+	constexpr uint32_t kDdsPixelFourCc = 0x4;
+	constexpr uint32_t kDdsCaps2Cubemap = 0x200;
+	constexpr uint32_t kDdsCaps2Volume = 0x200000;
+
+	constexpr uint32_t
+	fourCc(char a, char b, char c, char d) {
+		return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+	}
+
+	// Los de DXGI_FORMAT que se leen
+	constexpr uint32_t kDxgiBc1 = 71;
+	constexpr uint32_t kDxgiBc1Srgb = 72;
+	constexpr uint32_t kDxgiBc3 = 77;
+	constexpr uint32_t kDxgiBc3Srgb = 78;
+	constexpr uint32_t kDxgiBc7 = 98;
+	constexpr uint32_t kDxgiBc7Srgb = 99;
+
+	uint32_t
+	read32(const unsigned char* at) {
+		uint32_t value;
+		std::memcpy(&value, at, sizeof(value));
+		return value;
+	}
+
+	void
+	write32(std::vector<unsigned char>& out, uint32_t value) {
+		unsigned char bytes[4];
+		std::memcpy(bytes, &value, sizeof(bytes));
+		out.insert(out.end(), bytes, bytes + 4);
+	}
+
+	size_t
+	levelBytes(BlockFormat format, unsigned int width, unsigned int height) {
+		return size_t((width + 3) / 4) * ((height + 3) / 4) * CompressedTexture::blockBytes(format);
+	}
+
+	/**
+	 * @brief Los niveles de `width` x `height` hasta `count` (o hasta 1x1), uno tras otro.
+	 */
+	void
+	layoutLevels(CompressedImage& image, uint32_t count) {
+		image.levels.clear();
+		unsigned int width = image.width;
+		unsigned int height = image.height;
+		size_t offset = 0;
+		for (uint32_t i = 0; i < count; ++i) {
+			size_t size = levelBytes(image.format, width, height);
+			image.levels.push_back({ offset, size, width, height });
+			offset += size;
+			if (width == 1 && height == 1) {
+				break;
+			}
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+		}
+	}
+
+	struct Rgb {
+		int r;
+		int g;
+		int b;
+	};
+
+	uint16_t
+	to565(const Rgb& color) {
+		return static_cast<uint16_t>(((color.r * 31 + 127) / 255) << 11 | ((color.g * 63 + 127) / 255) << 5 | ((color.b * 31 + 127) / 255));
+	}
+
+	Rgb
+	from565(uint16_t packed) {
+		int r = (packed >> 11) & 31;
+		int g = (packed >> 5) & 63;
+		int b = packed & 31;
+		return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+	}
+
+	/**
+	 * @brief Los cuatro colores de un bloque de color; `opaque` fuerza el modo de cuatro, como
+	 *        lee BC3 su bloque de color.
+	 */
+	void
+	colorPalette(uint16_t first, uint16_t second, bool opaque, Rgb palette[4], bool& transparentLast) {
+		palette[0] = from565(first);
+		palette[1] = from565(second);
+		transparentLast = false;
+		if (first > second || opaque) {
+			palette[2] = { (2 * palette[0].r + palette[1].r) / 3, (2 * palette[0].g + palette[1].g) / 3, (2 * palette[0].b + palette[1].b) / 3 };
+			palette[3] = { (palette[0].r + 2 * palette[1].r) / 3, (palette[0].g + 2 * palette[1].g) / 3, (palette[0].b + 2 * palette[1].b) / 3 };
+		}
+		else {
+			palette[2] = { (palette[0].r + palette[1].r) / 2, (palette[0].g + palette[1].g) / 2, (palette[0].b + palette[1].b) / 2 };
+			palette[3] = { 0, 0, 0 };
+			transparentLast = true;
+		}
+	}
+
+	void
+	alphaPalette(int first, int second, int palette[8]) {
+		palette[0] = first;
+		palette[1] = second;
+		if (first > second) {
+			for (int i = 2; i < 8; ++i) {
+				palette[i] = ((8 - i) * first + (i - 1) * second) / 7;
+			}
+		}
+		else {
+			for (int i = 2; i < 6; ++i) {
+				palette[i] = ((6 - i) * first + (i - 1) * second) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	/**
+	 * @brief Bloque de color de los 16 pxeles RGBA de `pixels`.
+	 */
+	void
+	encodeColorBlock(const sf::Uint8 pixels[64], unsigned char out[8]) {
+		Rgb low{ 255, 255, 255 };
+		Rgb high{ 0, 0, 0 };
+		for (int i = 0; i < 16; ++i) {
+			low = { std::min<int>(low.r, pixels[i * 4]), std::min<int>(low.g, pixels[i * 4 + 1]), std::min<int>(low.b, pixels[i * 4 + 2]) };
+			high = { std::max<int>(high.r, pixels[i * 4]), std::max<int>(high.g, pixels[i * 4 + 1]), std::max<int>(high.b, pixels[i * 4 + 2]) };
+		}
+		// Recortada: los extremos de la caja casi nunca son pxeles, y as la paleta cae ms adentro
+		Rgb inset{ (high.r - low.r) / 16, (high.g - low.g) / 16, (high.b - low.b) / 16 };
+		low = { low.r + inset.r, low.g + inset.g, low.b + inset.b };
+		high = { high.r - inset.r, high.g - inset.g, high.b - inset.b };
+
+		uint16_t first = to565(high);
+		uint16_t second = to565(low);
+		uint32_t indices = 0;
+		if (first < second) {
+			std::swap(first, second);
+		}
+		if (first != second) {
+			Rgb palette[4];
+			bool transparentLast;
+			colorPalette(first, second, true, palette, transparentLast);
+			for (int i = 0; i < 16; ++i) {
+				int best = 0;
+				int bestDistance = INT32_MAX;
+				for (int candidate = 0; candidate < 4; ++candidate) {
+					int dr = pixels[i * 4] - palette[candidate].r;
+					int dg = pixels[i * 4 + 1] - palette[candidate].g;
+					int db = pixels[i * 4 + 2] - palette[candidate].b;
+					int distance = dr * dr + dg * dg + db * db;
+					if (distance < bestDistance) {
+						best = candidate;
+						bestDistance = distance;
+					}
+				}
+				indices |= uint32_t(best) << (i * 2);
+			}
+		}
+		std::memcpy(out, &first, 2);
+		std::memcpy(out + 2, &second, 2);
+		std::memcpy(out + 4, &indices, 4);
+	}
+
+	void
+	encodeAlphaBlock(const sf::Uint8 pixels[64], unsigned char out[8]) {
+		int low = 255;
+		int high = 0;
+		for (int i = 0; i < 16; ++i) {
+			low = std::min<int>(low, pixels[i * 4 + 3]);
+			high = std::max<int>(high, pixels[i * 4 + 3]);
+		}
+		uint64_t indices = 0;
+		if (high != low) {
+			int palette[8];
+			alphaPalette(high, low, palette);
+			for (int i = 0; i < 16; ++i) {
+				int best = 0;
+				for (int candidate = 1; candidate < 8; ++candidate) {
+					if (std::abs(pixels[i * 4 + 3] - palette[candidate]) < std::abs(pixels[i * 4 + 3] - palette[best])) {
+						best = candidate;
+					}
+				}
+				indices |= uint64_t(best) << (i * 3);
+			}
+		}
+		out[0] = static_cast<unsigned char>(high);
+		out[1] = static_cast<unsigned char>(low);
+		for (int i = 0; i < 6; ++i) {
+			out[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+		}
+	}
+
+	/**
+	 * @brief Mitad de `source` por lado, promediando cada 2x2 (los bordes impares se repiten).
+	 */
+	sf::Image
+	halve(const sf::Image& source) {
+		sf::Vector2u size = source.getSize();
+		unsigned int width = std::max(1u, size.x / 2);
+		unsigned int height = std::max(1u, size.y / 2);
+		std::vector<sf::Uint8> pixels(size_t(width) * height * 4);
+		const sf::Uint8* from = source.getPixelsPtr();
+		for (unsigned int y = 0; y < height; ++y) {
+			for (unsigned int x = 0; x < width; ++x) {
+				unsigned int x0 = std::min(x * 2, size.x - 1), x1 = std::min(x * 2 + 1, size.x - 1);
+				unsigned int y0 = std::min(y * 2, size.y - 1), y1 = std::min(y * 2 + 1, size.y - 1);
+				for (int channel = 0; channel < 4; ++channel) {
+					int sum = from[(size_t(y0) * size.x + x0) * 4 + channel] + from[(size_t(y0) * size.x + x1) * 4 + channel] +
+						from[(size_t(y1) * size.x + x0) * 4 + channel] + from[(size_t(y1) * size.x + x1) * 4 + channel];
+					pixels[(size_t(y) * width + x) * 4 + channel] = static_cast<sf::Uint8>((sum + 2) / 4);
+				}
+			}
+		}
+		sf::Image half;
+		half.create(width, height, pixels.data());
+		return half;
+	}
+
+	/**
+	 * @brief Si el driver habla de `extension` o lista `internalFormat` entre los comprimidos.
+	 */
+	bool
+	driverHas(const char* extension, GLenum internalFormat) {
+		// En un perfil de ncleo `GL_EXTENSIONS` no vale; la lista de formatos s
+		const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+		if (extensions && std::strstr(extensions, extension)) {
+			return true;
+		}
+		GLint count = 0;
+		glGetIntegerv(kGlNumCompressedTextureFormats, &count);
+		std::vector<GLint> formats(static_cast<size_t>(std::max(count, 0)));
+		if (!formats.empty()) {
+			glGetIntegerv(kGlCompressedTextureFormats, formats.data());
+		}
+		return std::find(formats.begin(), formats.end(), static_cast<GLint>(internalFormat)) != formats.end();
+	}
+
+	GLenum
+	internalFormat(BlockFormat format, bool srgb) {
+		switch (format) {
+		case BlockFormat::Bc1:
+			return srgb ? kGlCompressedSrgbAlphaS3tcDxt1 : kGlCompressedRgbaS3tcDxt1;
+		case BlockFormat::Bc3:
+			return srgb ? kGlCompressedSrgbAlphaS3tcDxt5 : kGlCompressedRgbaS3tcDxt5;
+		default:
+			return srgb ? kGlCompressedSrgbAlphaBptcUnorm : kGlCompressedRgbaBptcUnorm;
+		}
+	}
+}
+
+bool
+CompressedTexture::isDds(std::span<const unsigned char> bytes) {
+	return bytes.size() >= 4 && read32(bytes.data()) == kDdsMagic;
+}
+
+bool
+CompressedTexture::hasDdsExtension(std::string_view path) {
+	if (path.size() < 4) {
+		return false;
+	}
+	std::string_view tail = path.substr(path.size() - 4);
+	return tail[0] == '.' && (tail[1] | 0x20) == 'd' && (tail[2] | 0x20) == 'd' && (tail[3] | 0x20) == 's';
+}
+
+bool
+CompressedTexture::parseDds(std::span<const unsigned char> bytes, CompressedImage& image) {
+	image = CompressedImage();
+	if (bytes.size() < kDdsHeaderSize || !isDds(bytes) || read32(bytes.data() + 4) != 124) {
+		return false;
+	}
+	const unsigned char* header = bytes.data();
+	image.height = read32(header + 12);
+	image.width = read32(header + 16);
+	uint32_t mipCount = std::max<uint32_t>(1, read32(header + 28));
+	uint32_t pixelFlags = read32(header + 80);
+	uint32_t code = read32(header + 84);
+	uint32_t caps2 = read32(header + 112);
+	if (image.width == 0 || image.height == 0 || !(pixelFlags & kDdsPixelFourCc) ||
+		(caps2 & (kDdsCaps2Cubemap | kDdsCaps2Volume))) {
+		return false;
+	}
+
+	size_t dataOffset = kDdsHeaderSize;
+	if (code == fourCc('D', 'X', 'T', '1')) {
+		image.format = BlockFormat::Bc1;
+	}
+	else if (code == fourCc('D', 'X', 'T', '5')) {
+		image.format = BlockFormat::Bc3;
+	}
+	else if (code == fourCc('D', 'X', '1', '0')) {
+		if (bytes.size() < kDdsHeaderSize + kDx10HeaderSize) {
+			return false;
+		}
+		const unsigned char* dx10 = header + kDdsHeaderSize;
+		// Solo texturas 2D sueltas: dimensin 3, sin la marca de cubo, arreglo de una
+		if (read32(dx10 + 4) != 3 || (read32(dx10 + 8) & 0x4) || read32(dx10 + 12) > 1) {
+			return false;
+		}
+		switch (read32(dx10)) {
+		case kDxgiBc1Srgb: image.srgb = true; [[fallthrough]];
+		case kDxgiBc1: image.format = BlockFormat::Bc1; break;
+		case kDxgiBc3Srgb: image.srgb = true; [[fallthrough]];
+		case kDxgiBc3: image.format = BlockFormat::Bc3; break;
+		case kDxgiBc7Srgb: image.srgb = true; [[fallthrough]];
+		case kDxgiBc7: image.format = BlockFormat::Bc7; break;
+		default: return false;
+		}
+		dataOffset += kDx10HeaderSize;
+	}
+	else {
+		return false;
+	}
+
+	layoutLevels(image, mipCount);
+	size_t total = image.levels.back().offset + image.levels.back().size;
+	if (total > bytes.size() - dataOffset) {
+		image = CompressedImage();
+		return false;
+	}
+	image.data.assign(bytes.begin() + dataOffset, bytes.begin() + dataOffset + total);
+	return true;
+}
+
+std::vector<unsigned char>
+CompressedTexture::writeDds(const CompressedImage& image) {
+	bool dx10 = image.srgb || image.format == BlockFormat::Bc7;
+	std::vector<unsigned char> out;
+	out.reserve(kDdsHeaderSize + kDx10HeaderSize + image.data.size());
+	write32(out, kDdsMagic);
+	write32(out, 124);
+	write32(out, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000);   // Caps, alto, ancho, formato, mipmaps, tamao lineal
+	write32(out, image.height);
+	write32(out, image.width);
+	write32(out, static_cast<uint32_t>(image.levels.empty() ? 0 : image.levels[0].size));
+	write32(out, 0);
+	write32(out, static_cast<uint32_t>(image.levels.size()));
+	for (int i = 0; i < 11; ++i) {
+		write32(out, 0);
+	}
+	write32(out, 32);
+	write32(out, kDdsPixelFourCc);
+	write32(out, dx10 ? fourCc('D', 'X', '1', '0') : image.format == BlockFormat::Bc1 ? fourCc('D', 'X', 'T', '1') : fourCc('D', 'X', 'T', '5'));
+	for (int i = 0; i < 5; ++i) {
+		write32(out, 0);
+	}
+	write32(out, 0x1000 | (image.levels.size() > 1 ? 0x8 | 0x400000 : 0));
+	for (int i = 0; i < 4; ++i) {
+		write32(out, 0);
+	}
+	if (dx10) {
+		uint32_t dxgi = image.format == BlockFormat::Bc1 ? kDxgiBc1 : image.format == BlockFormat::Bc3 ? kDxgiBc3 : kDxgiBc7;
+		write32(out, dxgi + (image.srgb ? 1 : 0));
+		write32(out, 3);
+		write32(out, 0);
+		write32(out, 1);
+		write32(out, 0);
+	}
+	out.insert(out.end(), image.data.begin(), image.data.end());
+	return out;
+}
+
+bool
+CompressedTexture::encode(const sf::Image& source, BlockFormat format, bool mipmaps, CompressedImage& image) {
+	image = CompressedImage();
+	sf::Vector2u size = source.getSize();
+	if (format == BlockFormat::Bc7 || size.x == 0 || size.y == 0) {
+		return false;
+	}
+	image.format = format;
+	image.width = size.x;
+	image.height = size.y;
+	layoutLevels(image, mipmaps ? 32 : 1);
+	image.data.resize(image.levels.back().offset + image.levels.back().size);
+
+	sf::Image level = source;
+	for (size_t index = 0; index < image.levels.size(); ++index) {
+		const CompressedImage::Level& info = image.levels[index];
+		if (index > 0) {
+			level = halve(level);
+		}
+		const sf::Uint8* pixels = level.getPixelsPtr();
+		unsigned char* out = image.data.data() + info.offset;
+		for (unsigned int blockY = 0; blockY < info.height; blockY += 4) {
+			for (unsigned int blockX = 0; blockX < info.width; blockX += 4) {
+				// Los bloques del borde repiten la ltima fila o columna
+				sf::Uint8 block[64];
+				for (unsigned int y = 0; y < 4; ++y) {
+					for (unsigned int x = 0; x < 4; ++x) {
+						unsigned int px = std::min(blockX + x, info.width - 1);
+						unsigned int py = std::min(blockY + y, info.height - 1);
+						std::memcpy(block + (y * 4 + x) * 4, pixels + (size_t(py) * info.width + px) * 4, 4);
+					}
+				}
+				if (format == BlockFormat::Bc3) {
+					encodeAlphaBlock(block, out);
+					out += 8;
+				}
+				encodeColorBlock(block, out);
+				out += 8;
+			}
+		}
+	}
+	return true;
+}
+
+bool
+CompressedTexture::decode(const CompressedImage& image, sf::Image& out) {
+	if (image.empty() || image.format == BlockFormat::Bc7) {
+		return false;
+	}
+	std::vector<sf::Uint8> pixels(size_t(image.width) * image.height * 4);
+	const unsigned char* in = image.data.data();
+	for (unsigned int blockY = 0; blockY < image.height; blockY += 4) {
+		for (unsigned int blockX = 0; blockX < image.width; blockX += 4) {
+			int alphas[16];
+			std::fill(alphas, alphas + 16, 255);
+			if (image.format == BlockFormat::Bc3) {
+				int palette[8];
+				alphaPalette(in[0], in[1], palette);
+				uint64_t indices = 0;
+				for (int i = 0; i < 6; ++i) {
+					indices |= uint64_t(in[2 + i]) << (i * 8);
+				}
+				for (int i = 0; i < 16; ++i) {
+					alphas[i] = palette[(indices >> (i * 3)) & 7];
+				}
+				in += 8;
+			}
+			uint16_t first, second;
+			uint32_t indices;
+			std::memcpy(&first, in, 2);
+			std::memcpy(&second, in + 2, 2);
+			std::memcpy(&indices, in + 4, 4);
+			in += 8;
+			Rgb palette[4];
+			bool transparentLast;
+			colorPalette(first, second, image.format == BlockFormat::Bc3, palette, transparentLast);
+			for (unsigned int y = 0; y < 4 && blockY + y < image.height; ++y) {
+				for (unsigned int x = 0; x < 4 && blockX + x < image.width; ++x) {
+					int i = static_cast<int>(y * 4 + x);
+					uint32_t index = (indices >> (i * 2)) & 3;
+					sf::Uint8* pixel = &pixels[((size_t(blockY) + y) * image.width + blockX + x) * 4];
+					pixel[0] = static_cast<sf::Uint8>(palette[index].r);
+					pixel[1] = static_cast<sf::Uint8>(palette[index].g);
+					pixel[2] = static_cast<sf::Uint8>(palette[index].b);
+					pixel[3] = static_cast<sf::Uint8>(transparentLast && index == 3 ? 0 : alphas[i]);
+				}
+			}
+		}
+	}
+	out.create(image.width, image.height, pixels.data());
+	return true;
+}
+
+bool
+CompressedTexture::cookFile(const std::string& sourcePath, const std::string& ddsPath, const BlockFormat* format) {
+	sf::Image source;
+	if (!source.loadFromFile(sourcePath)) {
+		return false;
+	}
+	BlockFormat chosen = BlockFormat::Bc1;
+	if (format) {
+		chosen = *format;
+	}
+	else {
+		const sf::Uint8* pixels = source.getPixelsPtr();
+		size_t count = size_t(source.getSize().x) * source.getSize().y;
+		for (size_t i = 0; i < count; ++i) {
+			if (pixels[i * 4 + 3] != 255) {
+				chosen = BlockFormat::Bc3;
+				break;
+			}
+		}
+	}
+	CompressedImage image;
+	if (!encode(source, chosen, true, image)) {
+		return false;
+	}
+	std::vector<unsigned char> bytes = writeDds(image);
+	std::ofstream file(ddsPath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return static_cast<bool>(file);
+}
+
+bool
+CompressedTexture::isSupported(BlockFormat format) {
+	// Por formato: -1 sin preguntar todava
+	static int s_supported[3] = { -1, -1, -1 };
+	int& supported = s_supported[static_cast<int>(format)];
+	if (supported < 0) {
+		loadGlFunctions();
+		bool has = gl.compressedTexImage2D != nullptr && (format == BlockFormat::Bc7
+			? driverHas("GL_ARB_texture_compression_bptc", kGlCompressedRgbaBptcUnorm)
+			: driverHas("GL_EXT_texture_compression_s3tc", kGlCompressedRgbaS3tcDxt5));
+		supported = has ? 1 : 0;
+	}
+	return supported == 1;
+}
+
+bool
+CompressedTexture::upload(sf::Texture& texture, const CompressedImage& image, size_t skipLevels) {
+	if (image.empty()) {
+		return false;
+	}
+	if (!isSupported(image.format)) {
+		sf::Image pixels;
+		if (!decode(image, pixels)) {
+			MESSAGE("CompressedTexture", "upload", "the driver cannot read this block format");
+			return false;
+		}
+		return texture.loadFromImage(pixels);
+	}
+	if (!texture.create(image.width, image.height)) {
+		return false;
+	}
+	// Lo que qued de antes no es de esta subida
+	while (glGetError() != GL_NO_ERROR) {
+	}
+	// Como hace SFML: el `RenderTarget` recuerda la ltima textura atada, as que se devuelve
+	GLint previous = 0;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+	glBindTexture(GL_TEXTURE_2D, texture.getNativeHandle());
+	GLenum format = internalFormat(image.format, image.srgb);
+	// El nivel 0 de GL es el primero que se sube; SFML normaliza con el tamao completo
+	size_t first = std::min(skipLevels, image.levels.size() - 1);
+	for (size_t i = first; i < image.levels.size(); ++i) {
+		const CompressedImage::Level& level = image.levels[i];
+		gl.compressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i - first), format, static_cast<GLsizei>(level.width),
+			static_cast<GLsizei>(level.height), 0, static_cast<GLsizei>(level.size), image.data.data() + level.offset);
+	}
+	glTexParameteri(GL_TEXTURE_2D, kGlTextureMaxLevel, static_cast<GLint>(image.levels.size() - 1 - first));
+	if (image.levels.size() - first > 1) {
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.isSmooth() ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR);
+	}
+	glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous));
+	return glGetError() == GL_NO_ERROR;
+}
+
+size_t
+CompressedTexture::uploadedBytes(const CompressedImage& image, size_t skipLevels) {
+	if (image.empty()) {
+		return 0;
+	}
+	if (!isSupported(image.format)) {
+		return static_cast<size_t>(image.width) * image.height * 4;
+	}
+	size_t bytes = 0;
+	for (size_t i = std::min(skipLevels, image.levels.size() - 1); i < image.levels.size(); ++i) {
+		bytes += image.levels[i].size;
+	}
+	return bytes;
+}
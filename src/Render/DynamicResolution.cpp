@@ -0,0 +1,56 @@
+#include "Render/DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+void
+DynamicResolution::setSettings(const Settings& settings) {
+	m_settings = settings;
+	m_settings.minScale = std::clamp(m_settings.minScale, m_settings.step, 1.0f);
+	m_settings.maxScale = std::clamp(m_settings.maxScale, m_settings.minScale, 1.0f);
+	reset();
+}
+
+void
+DynamicResolution::reset() {
+	m_scale = quantize(m_settings.maxScale);
+	m_averageMs = 0.0;
+	m_hasAverage = false;
+	m_framesSinceChange = 0;
+}
+
+bool
+DynamicResolution::update(double gpuMs) {
+	if (gpuMs <= 0.0) {
+		return false;
+	}
+	m_averageMs = m_hasAverage ? m_averageMs + (gpuMs - m_averageMs) * kSmoothing : gpuMs;
+	m_hasAverage = true;
+	if (++m_framesSinceChange < m_settings.cooldownFrames) {
+		return false;
+	}
+
+	float next = m_scale;
+	if (m_averageMs > m_settings.targetMs) {
+		// Baja lo que haga falta de una vez: el costo va con el rea
+		next = quantize(m_scale * static_cast<float>(std::sqrt(m_settings.targetMs / m_averageMs)));
+		next = std::min(next, m_scale - m_settings.step);
+	}
+	else if (m_averageMs < m_settings.targetMs * (1.0 - m_settings.headroom)) {
+		next = m_scale + m_settings.step;
+	}
+	next = std::clamp(quantize(next), quantize(m_settings.minScale), quantize(m_settings.maxScale));
+	if (next == m_scale) {
+		return false;
+	}
+	m_scale = next;
+	m_framesSinceChange = 0;
+	// Los tiempos que siguen son de la escala vieja: el promedio arranca de nuevo con la nueva
+	m_hasAverage = false;
+	return true;
+}
+
+float
+DynamicResolution::quantize(float scale) const {
+	float steps = std::floor(scale / m_settings.step + 0.001f);
+	return std::max(steps, 1.0f) * m_settings.step;
+}
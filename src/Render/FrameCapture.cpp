@@ -0,0 +1,192 @@
+#include "Render/FrameCapture.h"
+#include <cstdio>
+#include <cstring>
+
+FrameCapture::~FrameCapture() {
+	m_jobs.wait(m_counter);
+}
+
+bool
+FrameCapture::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions()) {
+		return false;
+	}
+	for (Slot& slot : m_slots) {
+		gl.genBuffers(1, &slot.buffer);
+		slot.capacity = 0;
+		slot.fence = nullptr;
+	}
+	m_next = 0;
+	return true;
+}
+
+void
+FrameCapture::release() {
+	if (!isInitialized()) {
+		return;
+	}
+	for (Slot& slot : m_slots) {
+		if (slot.fence) {
+			gl.deleteSync(slot.fence);
+			slot.fence = nullptr;
+		}
+		gl.deleteBuffers(1, &slot.buffer);
+		slot.buffer = 0;
+		slot.capacity = 0;
+	}
+}
+
+void
+FrameCapture::requestScreenshot(const std::string& path) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_screenshots.push_back(path);
+}
+
+void
+FrameCapture::setRecording(bool enabled, const std::string& directory) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (enabled && !m_recording.load(std::memory_order_relaxed)) {
+		m_recordDirectory = directory;
+		m_recordFrame = 0;
+	}
+	m_recording.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+FrameCapture::isActive() const {
+	if (m_recording.load(std::memory_order_relaxed)) {
+		return true;
+	}
+	for (const Slot& slot : m_slots) {
+		if (slot.fence) {
+			return true;
+		}
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return !m_screenshots.empty();
+}
+
+void
+FrameCapture::capture(sf::RenderTarget& target) {
+	if (!isInitialized()) {
+		return;
+	}
+	// Primero las lecturas viejas: la ms antigua es la que sigue a `m_next`
+	for (size_t i = 0; i < kRingSize; ++i) {
+		Slot& slot = m_slots[(m_next + i) % kRingSize];
+		if (slot.fence) {
+			collect(slot);
+		}
+	}
+
+	Slot& slot = m_slots[m_next];
+	std::string path;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		bool screenshot = !m_screenshots.empty();
+		if (!screenshot && !m_recording.load(std::memory_order_relaxed)) {
+			return;
+		}
+		// Sin PBO libre: una captura pedida espera al frame siguiente, uno de la grabacin se pierde
+		if (slot.fence) {
+			if (!screenshot) {
+				++m_recordFrame;
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+			return;
+		}
+		if (screenshot) {
+			path = std::move(m_screenshots.front());
+			m_screenshots.erase(m_screenshots.begin());
+		}
+		else {
+			char name[32];
+			std::snprintf(name, sizeof(name), "/frame_%06u.png", m_recordFrame++);
+			path = m_recordDirectory + name;
+		}
+	}
+
+	sf::Vector2u size = target.getSize();
+	size_t bytes = size_t(size.x) * size.y * 4;
+	gl.bindBuffer(kGlPixelPackBuffer, slot.buffer);
+	if (slot.capacity < bytes) {
+		gl.bufferData(kGlPixelPackBuffer, static_cast<std::ptrdiff_t>(bytes), nullptr, kGlStreamRead);
+		slot.capacity = bytes;
+	}
+	// Con un PBO enlazado la lectura solo se encola: el ltimo argumento es un desplazamiento
+	glReadPixels(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	gl.bindBuffer(kGlPixelPackBuffer, 0);
+	slot.fence = gl.fenceSync(kGlSyncGpuCommandsComplete, 0);
+	slot.size = size;
+	slot.path = std::move(path);
+	m_next = (m_next + 1) % kRingSize;
+}
+
+bool
+FrameCapture::collect(Slot& slot) {
+	GLenum status = gl.clientWaitSync(slot.fence, 0, 0);
+	if (status != kGlAlreadySignaled && status != kGlConditionSatisfied) {
+		return false;
+	}
+	gl.deleteSync(slot.fence);
+	slot.fence = nullptr;
+
+	Encode* encode = freeEncode();
+	if (!encode) {
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	size_t bytes = size_t(slot.size.x) * slot.size.y * 4;
+	gl.bindBuffer(kGlPixelPackBuffer, slot.buffer);
+	const void* mapped = gl.mapBufferRange(kGlPixelPackBuffer, 0, static_cast<std::ptrdiff_t>(bytes), kGlMapReadBit);
+	if (mapped) {
+		encode->pixels.resize(bytes);
+		std::memcpy(encode->pixels.data(), mapped, bytes);
+		gl.unmapBuffer(kGlPixelPackBuffer);
+	}
+	gl.bindBuffer(kGlPixelPackBuffer, 0);
+	if (!mapped) {
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	encode->size = slot.size;
+	encode->path = std::move(slot.path);
+	encode->done.store(false, std::memory_order_relaxed);
+	m_jobs.run([this, encode]() {
+		// OpenGL lee desde abajo
+		sf::Image image;
+		image.create(encode->size.x, encode->size.y, encode->pixels.data());
+		image.flipVertically();
+		if (image.saveToFile(encode->path)) {
+			m_captured.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		encode->done.store(true, std::memory_order_release);
+	}, &m_counter);
+	return true;
+}
+
+FrameCapture::Encode*
+FrameCapture::freeEncode() {
+	for (EngineUtilities::TUniquePtr<Encode>& encode : m_encodes) {
+		if (encode->done.load(std::memory_order_acquire)) {
+			return encode.get();
+		}
+	}
+	if (m_encodes.size() >= kMaxPendingEncodes) {
+		return nullptr;
+	}
+	m_encodes.push_back(EngineUtilities::MakeUnique<Encode>());
+	return m_encodes.back().get();
+}
+
+void
+FrameCapture::finishEncoding() {
+	m_jobs.wait(m_counter);
+}
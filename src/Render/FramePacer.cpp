@@ -0,0 +1,127 @@
+#include "Render/FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace {
+	/**
+	 * @brief Le dice al ncleo que esto es una espera activa: gasta menos y no le quita el
+	 *        ncleo al otro hilo del mismo.
+	 */
+	inline void
+	cpuPause() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+		_mm_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#else
+		std::this_thread::yield();
+#endif
+	}
+}
+
+FramePacer::FramePacer() {
+#ifdef _WIN32
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+	m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+	if (!m_timer) {
+		m_timer = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+	}
+#endif
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+	if (m_timer) {
+		CloseHandle(m_timer);
+	}
+#endif
+}
+
+void
+FramePacer::waitUntil(Clock::time_point deadline) {
+	Clock::time_point now = Clock::now();
+	Clock::time_point wake = m_spinEnabled ? deadline - m_spin : deadline;
+	if (wake > now) {
+		sleepUntil(wake);
+		// Sube de una vez hasta cubrir lo que se pas, con algo de aire; baja un dieciseisavo por frame
+		Clock::duration overshoot = Clock::now() - wake;
+		if (overshoot + overshoot / 2 > m_spin) {
+			m_spin = std::min(kMaxSpin, overshoot + overshoot / 2);
+		}
+		else {
+			m_spin = std::max(kMinSpin, m_spin - (m_spin - overshoot) / 16);
+		}
+	}
+	while ((now = Clock::now()) < deadline) {
+		cpuPause();
+	}
+	int64_t late = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count();
+	m_lateNs += late;
+	m_maxLateNs = std::max(m_maxLateNs, late);
+	++m_frames;
+}
+
+PacingStats
+FramePacer::takeStats() {
+	PacingStats stats;
+	stats.frames = m_frames;
+	stats.meanLateUs = m_frames ? m_lateNs / 1000.0 / m_frames : 0.0;
+	stats.maxLateUs = m_maxLateNs / 1000.0;
+	stats.spinUs = std::chrono::duration<double, std::micro>(m_spin).count();
+	m_frames = 0;
+	m_lateNs = 0;
+	m_maxLateNs = 0;
+	return stats;
+}
+
+double
+FramePacer::displayRefreshRate() {
+#ifdef _WIN32
+	DEVMODEW mode = {};
+	mode.dmSize = sizeof(mode);
+	// 0 y 1 son "lo que tenga el hardware"
+	if (EnumDisplaySettingsW(nullptr, ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1) {
+		return static_cast<double>(mode.dmDisplayFrequency);
+	}
+#endif
+	return 0.0;
+}
+
+double
+FramePacer::alignToRefresh(double hz, double refreshHz) {
+	if (refreshHz <= 0.0 || hz <= 0.0 || hz >= refreshHz) {
+		return hz;
+	}
+	return refreshHz / std::ceil(refreshHz / hz - 1e-3);
+}
+
+void
+FramePacer::sleepUntil(Clock::time_point until) {
+#ifdef _WIN32
+	if (m_timer) {
+		// Negativo: relativo, en unidades de 100 ns
+		int64_t ticks = std::chrono::duration_cast<std::chrono::nanoseconds>(until - Clock::now()).count() / 100;
+		if (ticks <= 0) {
+			return;
+		}
+		LARGE_INTEGER due;
+		due.QuadPart = -ticks;
+		if (SetWaitableTimer(m_timer, &due, 0, nullptr, nullptr, FALSE)) {
+			WaitForSingleObject(m_timer, INFINITE);
+			return;
+		}
+	}
+#endif
+	std::this_thread::sleep_until(until);
+}
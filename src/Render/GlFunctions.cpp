@@ -0,0 +1,164 @@
+#include "Render/GlFunctions.h"
+#include "Prerequisites.h"
+
+#ifdef _WIN32
+#pragma comment(lib, "opengl32.lib")
+#endif
+
+GlFunctions gl;
+
+namespace {
+	template<typename Fn>
+	bool
+	loadFunction(Fn& slot, const char* name) {
+		slot = reinterpret_cast<Fn>(sf::Context::getFunction(name));
+		return slot != nullptr;
+	}
+
+	bool
+	loadAll() {
+		bool ok = true;
+		ok &= loadFunction(gl.genVertexArrays, "glGenVertexArrays");
+		ok &= loadFunction(gl.bindVertexArray, "glBindVertexArray");
+		ok &= loadFunction(gl.deleteVertexArrays, "glDeleteVertexArrays");
+		ok &= loadFunction(gl.genBuffers, "glGenBuffers");
+		ok &= loadFunction(gl.bindBuffer, "glBindBuffer");
+		ok &= loadFunction(gl.bufferData, "glBufferData");
+		ok &= loadFunction(gl.bufferSubData, "glBufferSubData");
+		ok &= loadFunction(gl.copyBufferSubData, "glCopyBufferSubData");
+		ok &= loadFunction(gl.deleteBuffers, "glDeleteBuffers");
+		ok &= loadFunction(gl.vertexAttribPointer, "glVertexAttribPointer");
+		ok &= loadFunction(gl.enableVertexAttribArray, "glEnableVertexAttribArray");
+		ok &= loadFunction(gl.vertexAttribDivisor, "glVertexAttribDivisor");
+		ok &= loadFunction(gl.drawArraysInstanced, "glDrawArraysInstanced");
+		ok &= loadFunction(gl.drawElementsBaseVertex, "glDrawElementsBaseVertex");
+		ok &= loadFunction(gl.drawElementsInstancedBaseVertex, "glDrawElementsInstancedBaseVertex");
+		ok &= loadFunction(gl.createShader, "glCreateShader");
+		ok &= loadFunction(gl.shaderSource, "glShaderSource");
+		ok &= loadFunction(gl.compileShader, "glCompileShader");
+		ok &= loadFunction(gl.getShaderiv, "glGetShaderiv");
+		ok &= loadFunction(gl.deleteShader, "glDeleteShader");
+		ok &= loadFunction(gl.createProgram, "glCreateProgram");
+		ok &= loadFunction(gl.attachShader, "glAttachShader");
+		ok &= loadFunction(gl.linkProgram, "glLinkProgram");
+		ok &= loadFunction(gl.getProgramiv, "glGetProgramiv");
+		ok &= loadFunction(gl.deleteProgram, "glDeleteProgram");
+		ok &= loadFunction(gl.useProgram, "glUseProgram");
+		ok &= loadFunction(gl.getUniformLocation, "glGetUniformLocation");
+		ok &= loadFunction(gl.uniformMatrix4fv, "glUniformMatrix4fv");
+		ok &= loadFunction(gl.uniform4fv, "glUniform4fv");
+		ok &= loadFunction(gl.uniform1i, "glUniform1i");
+		ok &= loadFunction(gl.uniform1f, "glUniform1f");
+		ok &= loadFunction(gl.activeTexture, "glActiveTexture");
+		ok &= loadFunction(gl.getUniformBlockIndex, "glGetUniformBlockIndex");
+		ok &= loadFunction(gl.uniformBlockBinding, "glUniformBlockBinding");
+		ok &= loadFunction(gl.bindBufferBase, "glBindBufferBase");
+		ok &= loadFunction(gl.mapBufferRange, "glMapBufferRange");
+		ok &= loadFunction(gl.unmapBuffer, "glUnmapBuffer");
+		ok &= loadFunction(gl.fenceSync, "glFenceSync");
+		ok &= loadFunction(gl.clientWaitSync, "glClientWaitSync");
+		ok &= loadFunction(gl.deleteSync, "glDeleteSync");
+		loadFunction(gl.programParameteri, "glProgramParameteri");
+		loadFunction(gl.getProgramBinary, "glGetProgramBinary");
+		loadFunction(gl.programBinary, "glProgramBinary");
+		loadFunction(gl.genQueries, "glGenQueries");
+		loadFunction(gl.deleteQueries, "glDeleteQueries");
+		loadFunction(gl.queryCounter, "glQueryCounter");
+		loadFunction(gl.getQueryObjectiv, "glGetQueryObjectiv");
+		loadFunction(gl.getQueryObjectui64v, "glGetQueryObjectui64v");
+		loadFunction(gl.texBuffer, "glTexBuffer");
+		loadFunction(gl.compressedTexImage2D, "glCompressedTexImage2D");
+		loadFunction(gl.dispatchCompute, "glDispatchCompute");
+		loadFunction(gl.memoryBarrier, "glMemoryBarrier");
+		loadFunction(gl.genFramebuffers, "glGenFramebuffers");
+		loadFunction(gl.deleteFramebuffers, "glDeleteFramebuffers");
+		loadFunction(gl.bindFramebuffer, "glBindFramebuffer");
+		loadFunction(gl.framebufferTexture2D, "glFramebufferTexture2D");
+		loadFunction(gl.checkFramebufferStatus, "glCheckFramebufferStatus");
+		loadFunction(gl.blitFramebuffer, "glBlitFramebuffer");
+		// Algunos drivers dan direccin a cualquier nombre: las extensiones se confirman antes
+		if (sf::Context::isExtensionAvailable("GL_ARB_base_instance")) {
+			loadFunction(gl.drawElementsInstancedBaseVertexBaseInstance, "glDrawElementsInstancedBaseVertexBaseInstance");
+		}
+		if (sf::Context::isExtensionAvailable("GL_ARB_bindless_texture")) {
+			loadFunction(gl.getTextureHandleARB, "glGetTextureHandleARB");
+			loadFunction(gl.makeTextureHandleResidentARB, "glMakeTextureHandleResidentARB");
+		}
+		if (sf::Context::isExtensionAvailable("GL_ARB_buffer_storage")) {
+			loadFunction(gl.bufferStorage, "glBufferStorage");
+		}
+		return ok;
+	}
+
+	GLuint
+	compileShader(GLenum type, const char* source) {
+		GLuint shader = gl.createShader(type);
+		gl.shaderSource(shader, 1, &source, nullptr);
+		gl.compileShader(shader);
+		GLint compiled = 0;
+		gl.getShaderiv(shader, kGlCompileStatus, &compiled);
+		if (!compiled) {
+			gl.deleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+}
+
+bool
+loadGlFunctions() {
+	static const bool s_loaded = loadAll();
+	return s_loaded;
+}
+
+GLuint
+linkGlProgram(const char* vertexSource, const char* fragmentSource, bool retrievable) {
+	GLuint vertex = compileShader(kGlVertexShader, vertexSource);
+	GLuint fragment = compileShader(kGlFragmentShader, fragmentSource);
+	if (!vertex || !fragment) {
+		if (vertex) gl.deleteShader(vertex);
+		if (fragment) gl.deleteShader(fragment);
+		return 0;
+	}
+	GLuint program = gl.createProgram();
+	gl.attachShader(program, vertex);
+	gl.attachShader(program, fragment);
+	if (retrievable && gl.programParameteri) {
+		gl.programParameteri(program, kGlProgramBinaryRetrievableHint, GL_TRUE);
+	}
+	gl.linkProgram(program);
+	gl.deleteShader(vertex);
+	gl.deleteShader(fragment);
+	GLint linked = 0;
+	gl.getProgramiv(program, kGlLinkStatus, &linked);
+	if (!linked) {
+		gl.deleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+GLuint
+linkGlComputeProgram(const char* source, bool retrievable) {
+	if (!hasGlComputeShaders()) {
+		return 0;
+	}
+	GLuint compute = compileShader(kGlComputeShader, source);
+	if (!compute) {
+		return 0;
+	}
+	GLuint program = gl.createProgram();
+	gl.attachShader(program, compute);
+	if (retrievable && gl.programParameteri) {
+		gl.programParameteri(program, kGlProgramBinaryRetrievableHint, GL_TRUE);
+	}
+	gl.linkProgram(program);
+	gl.deleteShader(compute);
+	GLint linked = 0;
+	gl.getProgramiv(program, kGlLinkStatus, &linked);
+	if (!linked) {
+		gl.deleteProgram(program);
+		return 0;
+	}
+	return program;
+}
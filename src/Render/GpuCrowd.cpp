@@ -0,0 +1,214 @@
+#include "Render/GpuCrowd.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Render/GlFunctions.h"
+#include "Render/RenderStats.h"
+#include "Render/ShaderCache.h"
+
+namespace {
+
+	// Misma disposicin que `GpuAgent`: dos vec2 y cuatro escalares, sin relleno en std430
+	const char* kStepShader = R"(#version 430
+layout(local_size_x = 256) in;
+struct Agent {
+	vec2 position;
+	vec2 target;
+	float speed;
+	float range;
+	uint waypoint;
+	uint color;
+};
+layout(std430, binding = 0) buffer Agents { Agent agents[]; };
+layout(std430, binding = 1) readonly buffer Path { vec2 points[]; };
+uniform float u_deltaTime;
+uniform int u_count;
+uniform int u_pathCount;
+void main() {
+	uint i = gl_GlobalInvocationID.x;
+	if (i >= uint(u_count)) {
+		return;
+	}
+	vec2 position = agents[i].position;
+	vec2 target = agents[i].target;
+	float range = agents[i].range;
+	vec2 d = target - position;
+	float lengthSq = dot(d, d);
+	if (lengthSq > range * range) {
+		agents[i].position = position + d * (agents[i].speed * u_deltaTime * inversesqrt(lengthSq));
+	}
+	else if (u_pathCount > 0) {
+		uint next = (agents[i].waypoint + 1u) % uint(u_pathCount);
+		agents[i].waypoint = next;
+		agents[i].target = points[next];
+	}
+}
+)";
+
+	const char* kVertexShader = R"(#version 430
+layout(location = 0) in vec2 a_position;
+struct Agent {
+	vec2 position;
+	vec2 target;
+	float speed;
+	float range;
+	uint waypoint;
+	uint color;
+};
+layout(std430, binding = 0) readonly buffer Agents { Agent agents[]; };
+uniform mat4 u_view;
+uniform float u_radius;
+out vec4 v_color;
+void main() {
+	vec2 position = agents[gl_InstanceID].position + a_position * u_radius;
+	gl_Position = u_view * vec4(position, 0.0, 1.0);
+	// `toInteger` deja el rojo en el byte alto; unpackUnorm4x8 empieza por el bajo
+	v_color = unpackUnorm4x8(agents[gl_InstanceID].color).wzyx;
+}
+)";
+
+	const char* kFragmentShader = R"(#version 430
+in vec4 v_color;
+out vec4 o_color;
+void main() {
+	o_color = v_color;
+}
+)";
+
+} // namespace
+
+bool
+GpuCrowd::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions() || !hasGlComputeShaders()) {
+		return false;
+	}
+	ShaderCache& shaders = EngineUtilities::TService<ShaderCache>::instance();
+	GLuint step = shaders.computeProgram(kStepShader);
+	GLuint draw = step ? shaders.program(kVertexShader, kFragmentShader) : 0;
+	if (!step || !draw) {
+		return false;
+	}
+	m_stepProgram = step;
+	m_drawProgram = draw;
+	m_deltaTimeLocation = gl.getUniformLocation(step, "u_deltaTime");
+	m_countLocation = gl.getUniformLocation(step, "u_count");
+	m_pathCountLocation = gl.getUniformLocation(step, "u_pathCount");
+	m_viewLocation = gl.getUniformLocation(draw, "u_view");
+	m_radiusLocation = gl.getUniformLocation(draw, "u_radius");
+
+	// Polgono unitario en abanico desde el centro
+	std::vector<sf::Vector2f> triangles;
+	triangles.reserve(kOutlinePoints * 3);
+	for (uint32_t i = 0; i < kOutlinePoints; ++i) {
+		float a0 = 6.2831853f * static_cast<float>(i) / kOutlinePoints;
+		float a1 = 6.2831853f * static_cast<float>(i + 1) / kOutlinePoints;
+		triangles.push_back(sf::Vector2f(0.0f, 0.0f));
+		triangles.push_back(sf::Vector2f(std::cos(a0), std::sin(a0)));
+		triangles.push_back(sf::Vector2f(std::cos(a1), std::sin(a1)));
+	}
+	GLuint buffers[3] = {};
+	GLuint vertexArray = 0;
+	gl.genBuffers(3, buffers);
+	gl.genVertexArrays(1, &vertexArray);
+	m_meshBuffer = buffers[0];
+	m_agentBuffer = buffers[1];
+	m_pathBuffer = buffers[2];
+	m_vertexArray = vertexArray;
+
+	gl.bindVertexArray(m_vertexArray);
+	gl.bindBuffer(kGlArrayBuffer, m_meshBuffer);
+	gl.bufferData(kGlArrayBuffer, static_cast<std::ptrdiff_t>(triangles.size() * sizeof(sf::Vector2f)), triangles.data(),
+		kGlStaticDraw);
+	gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vector2f), nullptr);
+	gl.enableVertexAttribArray(0);
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+
+	// Un SSBO vaco no puede enlazarse: el recorrido empieza con un punto
+	sf::Vector2f origin;
+	gl.bindBuffer(kGlShaderStorageBuffer, m_pathBuffer);
+	gl.bufferData(kGlShaderStorageBuffer, sizeof(origin), &origin, kGlStaticDraw);
+	gl.bindBuffer(kGlShaderStorageBuffer, 0);
+	return true;
+}
+
+void
+GpuCrowd::release() {
+	if (!isInitialized()) {
+		return;
+	}
+	GLuint buffers[3] = { m_meshBuffer, m_agentBuffer, m_pathBuffer };
+	GLuint vertexArray = m_vertexArray;
+	gl.deleteBuffers(3, buffers);
+	gl.deleteVertexArrays(1, &vertexArray);
+	// Los programas son de `ShaderCache`, que los borra en `release`
+	m_stepProgram = 0;
+	m_drawProgram = 0;
+	m_vertexArray = 0;
+	m_meshBuffer = 0;
+	m_agentBuffer = 0;
+	m_pathBuffer = 0;
+	m_count = 0;
+	m_pathCount = 0;
+}
+
+void
+GpuCrowd::upload(std::span<const GpuAgent> agents, std::span<const sf::Vector2f> path) {
+	if (!isInitialized()) {
+		return;
+	}
+	// El compute shader los escribe y el de vrtices los lee: nunca pasan por la CPU otra vez
+	gl.bindBuffer(kGlShaderStorageBuffer, m_agentBuffer);
+	gl.bufferData(kGlShaderStorageBuffer, static_cast<std::ptrdiff_t>(std::max<size_t>(agents.size_bytes(), sizeof(GpuAgent))),
+		agents.empty() ? nullptr : agents.data(), kGlDynamicCopy);
+	m_count = static_cast<uint32_t>(agents.size());
+	RenderStatsCounter::current().countUpload(agents.size_bytes());
+	if (!path.empty()) {
+		static_assert(sizeof(sf::Vector2f) == 2 * sizeof(float), "vec2 en std430");
+		gl.bindBuffer(kGlShaderStorageBuffer, m_pathBuffer);
+		gl.bufferData(kGlShaderStorageBuffer, static_cast<std::ptrdiff_t>(path.size_bytes()), path.data(), kGlStaticDraw);
+	}
+	m_pathCount = static_cast<uint32_t>(path.size());
+	gl.bindBuffer(kGlShaderStorageBuffer, 0);
+}
+
+void
+GpuCrowd::step(float deltaTime) {
+	if (!isInitialized() || m_count == 0 || deltaTime <= 0.0f) {
+		return;
+	}
+	gl.useProgram(m_stepProgram);
+	gl.uniform1f(m_deltaTimeLocation, deltaTime);
+	gl.uniform1i(m_countLocation, static_cast<GLint>(m_count));
+	gl.uniform1i(m_pathCountLocation, static_cast<GLint>(m_pathCount));
+	gl.bindBufferBase(kGlShaderStorageBuffer, 0, m_agentBuffer);
+	gl.bindBufferBase(kGlShaderStorageBuffer, 1, m_pathBuffer);
+	gl.dispatchCompute((m_count + kGroupSize - 1) / kGroupSize, 1, 1);
+	// El dibujo lee lo que escribi el paso
+	gl.memoryBarrier(kGlShaderStorageBarrierBit);
+	gl.useProgram(0);
+}
+
+void
+GpuCrowd::draw(sf::RenderTarget& target) {
+	if (!isInitialized() || m_count == 0) {
+		return;
+	}
+	// SFML guarda y restaura su estado alrededor del OpenGL propio
+	target.pushGLStates();
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl.useProgram(m_drawProgram);
+	gl.uniformMatrix4fv(m_viewLocation, 1, GL_FALSE, target.getView().getTransform().getMatrix());
+	gl.uniform1f(m_radiusLocation, m_radius);
+	gl.bindBufferBase(kGlShaderStorageBuffer, 0, m_agentBuffer);
+	gl.bindVertexArray(m_vertexArray);
+	gl.drawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(kOutlinePoints * 3), static_cast<GLsizei>(m_count));
+	RenderStatsCounter::current().countDraw(size_t(kOutlinePoints) * 3 * m_count, nullptr, nullptr, sf::BlendAlpha, m_drawProgram);
+	gl.bindVertexArray(0);
+	gl.useProgram(0);
+	target.popGLStates();
+}
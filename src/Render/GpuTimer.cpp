@@ -0,0 +1,142 @@
+#include "Render/GpuTimer.h"
+#include "Render/GlFunctions.h"
+#include "Profiling/TracyBridge.h"
+
+bool
+GpuTimer::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions() || !hasGlTimerQueries()) {
+		return false;
+	}
+	for (std::array<uint32_t, kMarks>& frame : m_queries) {
+		gl.genQueries(static_cast<GLsizei>(kMarks), frame.data());
+	}
+	m_marked = {};
+	m_inFlight = {};
+	m_frame = 0;
+	return true;
+}
+
+void
+GpuTimer::release() {
+	if (!isInitialized()) {
+		return;
+	}
+	for (std::array<uint32_t, kMarks>& frame : m_queries) {
+		gl.deleteQueries(static_cast<GLsizei>(kMarks), frame.data());
+		frame = {};
+	}
+}
+
+void
+GpuTimer::begin(Pass pass) {
+	if (!isInitialized()) {
+		return;
+	}
+	gl.queryCounter(m_queries[m_frame][pass], kGlTimestamp);
+	m_marked[m_frame][pass] = true;
+}
+
+void
+GpuTimer::endFrame() {
+	if (!isInitialized()) {
+		return;
+	}
+	gl.queryCounter(m_queries[m_frame][kPassCount], kGlTimestamp);
+	m_marked[m_frame][kPassCount] = true;
+	m_inFlight[m_frame] = true;
+
+	// El siguiente juego es el ms viejo: se lee (si lleg) antes de reutilizarlo
+	m_frame = (m_frame + 1) % kLatencyFrames;
+	if (m_inFlight[m_frame]) {
+		collect(m_frame);
+	}
+	m_marked[m_frame] = {};
+	m_inFlight[m_frame] = false;
+}
+
+void
+GpuTimer::collect(size_t frame) {
+	const std::array<uint32_t, kMarks>& queries = m_queries[frame];
+	GLint available = 0;
+	gl.getQueryObjectiv(queries[kPassCount], kGlQueryResultAvailable, &available);
+	if (!available) {
+		return;
+	}
+
+	// Las marcas terminan en orden: si lleg la ltima, llegaron todas
+	std::array<uint64_t, kMarks> stamps{};
+	for (size_t i = 0; i < kMarks; ++i) {
+		if (m_marked[frame][i]) {
+			gl.getQueryObjectui64v(queries[i], kGlQueryResult, &stamps[i]);
+		}
+	}
+	std::array<double, kPassCount> passMs{};
+	double first = 0.0;
+	bool started = false;
+	for (size_t pass = 0; pass < kPassCount; ++pass) {
+		if (!m_marked[frame][pass]) {
+			continue;
+		}
+		size_t next = pass + 1;
+		while (!m_marked[frame][next]) {
+			++next;
+		}
+		passMs[pass] = static_cast<double>(stamps[next] - stamps[pass]) / 1.0e6;
+		if (!started) {
+			first = static_cast<double>(stamps[pass]);
+			started = true;
+		}
+	}
+
+	m_latest.clearMs = passMs[Clear];
+	m_latest.meshesMs = passMs[Meshes];
+	m_latest.worldMs = passMs[World];
+	m_latest.postProcessMs = passMs[PostProcess];
+	m_latest.overlayMs = passMs[Overlay];
+	m_latest.totalMs = started ? (static_cast<double>(stamps[kPassCount]) - first) / 1.0e6 : 0.0;
+	m_latest.valid = true;
+	emitTracyZones(frame, stamps);
+}
+
+void
+GpuTimer::emitTracyZones(size_t frame, const std::array<uint64_t, kMarks>& stamps) {
+#if ENGINE_TRACY
+	static const ___tracy_source_location_data kPassLocations[kPassCount] = {
+		{ "Clear", "GpuTimer", __FILE__, __LINE__, 0 },
+		{ "Meshes", "GpuTimer", __FILE__, __LINE__, 0 },
+		{ "World", "GpuTimer", __FILE__, __LINE__, 0 },
+		{ "PostProcess", "GpuTimer", __FILE__, __LINE__, 0 },
+		{ "Overlay", "GpuTimer", __FILE__, __LINE__, 0 },
+	};
+	// Las zonas salen cuando llegan los resultados, unos frames tarde: Tracy las ubica por
+	// la marca de GPU; el contexto se calibra con la primera que llega
+	if (m_tracyContext < 0) {
+		m_tracyContext = tracy::GetGpuCtxCounter().fetch_add(1, std::memory_order_relaxed);
+		uint8_t context = static_cast<uint8_t>(m_tracyContext);
+		___tracy_emit_gpu_new_context_serial({ static_cast<int64_t>(stamps[kPassCount]), 1.0f, context, 0, 1 });
+		___tracy_emit_gpu_context_name_serial({ context, "OpenGL", 6 });
+	}
+	uint8_t context = static_cast<uint8_t>(m_tracyContext);
+	for (size_t pass = 0; pass < kPassCount; ++pass) {
+		if (!m_marked[frame][pass]) {
+			continue;
+		}
+		size_t next = pass + 1;
+		while (!m_marked[frame][next]) {
+			++next;
+		}
+		uint16_t begin = m_tracyQuery++;
+		uint16_t end = m_tracyQuery++;
+		___tracy_emit_gpu_zone_begin_serial({ reinterpret_cast<uint64_t>(&kPassLocations[pass]), begin, context });
+		___tracy_emit_gpu_zone_end_serial({ end, context });
+		___tracy_emit_gpu_time_serial({ static_cast<int64_t>(stamps[pass]), begin, context });
+		___tracy_emit_gpu_time_serial({ static_cast<int64_t>(stamps[next]), end, context });
+	}
+#else
+	(void)frame;
+	(void)stamps;
+#endif
+}
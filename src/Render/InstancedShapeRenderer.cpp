@@ -0,0 +1,210 @@
+#include "Render/InstancedShapeRenderer.h"
+#include <cstddef>
+#include "Render/GlFunctions.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/RenderStats.h"
+#include "Render/ShaderCache.h"
+#include "Render/ShapeBatcher.h"
+
+namespace {
+
+	// Atributos: 0 punto de la malla; 1 y 2 filas de la matriz de mundo; 3 color (por instancia)
+	const char* kVertexShader = R"(#version 330
+layout(location = 0) in vec2 a_position;
+layout(location = 1) in vec3 a_row0;
+layout(location = 2) in vec3 a_row1;
+layout(location = 3) in vec4 a_color;
+uniform mat4 u_view;
+out vec4 v_color;
+void main() {
+	vec3 local = vec3(a_position, 1.0);
+	gl_Position = u_view * vec4(dot(a_row0, local), dot(a_row1, local), 0.0, 1.0);
+	v_color = a_color;
+}
+)";
+
+	const char* kFragmentShader = R"(#version 330
+in vec4 v_color;
+out vec4 o_color;
+void main() {
+	o_color = v_color;
+}
+)";
+
+	/**
+	 * @brief Capa y profundidad de un comando (los 24 bits altos de su clave): lo que decide
+	 *        qu queda encima.
+	 */
+	uint32_t
+	depthOf(const DrawCommand& command) { return static_cast<uint32_t>(command.sortKey >> 40); }
+
+} // namespace
+
+bool
+InstancedShapeRenderer::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions()) {
+		return false;
+	}
+	GLuint program = EngineUtilities::TService<ShaderCache>::instance().program(kVertexShader, kFragmentShader);
+	if (!program) {
+		return false;
+	}
+	m_program = program;
+	m_viewLocation = gl.getUniformLocation(program, "u_view");
+
+	if (!m_instances.initialize()) {
+		return false;
+	}
+	GLuint vertexArray = 0;
+	gl.genVertexArrays(1, &vertexArray);
+	m_vertexArray = vertexArray;
+	return true;
+}
+
+void
+InstancedShapeRenderer::release() {
+	if (!isInitialized()) {
+		return;
+	}
+	for (Mesh& mesh : m_meshes) {
+		GLuint buffer = mesh.vertexBuffer;
+		gl.deleteBuffers(1, &buffer);
+	}
+	m_meshes.clear();
+	GLuint vertexArray = m_vertexArray;
+	m_instances.release();
+	gl.deleteVertexArrays(1, &vertexArray);
+	// El programa es de `ShaderCache`, que lo borra en `release`
+	m_program = 0;
+	m_vertexArray = 0;
+}
+
+bool
+InstancedShapeRenderer::isInstanceable(const DrawCommand& command) {
+	return command.outline && command.outlineCount >= 3 && !command.texture && !command.shader &&
+	       command.blendMode == sf::BlendAlpha && ShapeBatcher::isBatchable(command) && !command.shape->getTexture();
+}
+
+InstancedShapeRenderer::Mesh&
+InstancedShapeRenderer::meshFor(const DrawCommand& command) {
+	for (Mesh& mesh : m_meshes) {
+		if (mesh.outline == command.outline) {
+			return mesh;
+		}
+	}
+	// Abanico desde el primer punto, igual que ShapeBatcher, en coordenadas locales
+	std::vector<sf::Vector2f> triangles;
+	triangles.reserve((command.outlineCount - 2) * 3);
+	for (uint32_t i = 2; i < command.outlineCount; ++i) {
+		triangles.push_back(command.outline[0]);
+		triangles.push_back(command.outline[i - 1]);
+		triangles.push_back(command.outline[i]);
+	}
+	Mesh& mesh = m_meshes.emplace_back();
+	mesh.outline = command.outline;
+	mesh.vertexCount = static_cast<uint32_t>(triangles.size());
+	GLuint buffer = 0;
+	gl.genBuffers(1, &buffer);
+	gl.bindBuffer(kGlArrayBuffer, buffer);
+	gl.bufferData(kGlArrayBuffer, static_cast<std::ptrdiff_t>(triangles.size() * sizeof(sf::Vector2f)), triangles.data(),
+		kGlStaticDraw);
+	mesh.vertexBuffer = buffer;
+	return mesh;
+}
+
+void
+InstancedShapeRenderer::submit(sf::RenderTarget& target, RenderCommandBuffer& commands, ShapeBatcher& batcher) {
+	m_drawCalls = 0;
+	m_instanceTotal = 0;
+	m_instances.beginFrame();
+	batcher.begin();
+	commands.sort();
+	uint32_t depth = 0;
+	commands.forEach([&](const DrawCommand& command) {
+		// Capa o profundidad nueva: lo de la anterior se dibuja antes
+		if (depthOf(command) != depth) {
+			batcher.end(target);
+			flush(target);
+			depth = depthOf(command);
+		}
+		if (!isInstanceable(command)) {
+			batcher.add(target, command);
+			return;
+		}
+		Instance& instance = meshFor(command).pending.emplace_back();
+		const float* m = (command.transform * command.shape->getTransform()).getMatrix();
+		instance.row0[0] = m[0];
+		instance.row0[1] = m[4];
+		instance.row0[2] = m[12];
+		instance.row1[0] = m[1];
+		instance.row1[1] = m[5];
+		instance.row1[2] = m[13];
+		sf::Color color = command.color;
+		instance.color[0] = color.r;
+		instance.color[1] = color.g;
+		instance.color[2] = color.b;
+		instance.color[3] = color.a;
+	});
+	batcher.end(target);
+	flush(target);
+}
+
+void
+InstancedShapeRenderer::flush(sf::RenderTarget& target) {
+	m_upload.clear();
+	for (const Mesh& mesh : m_meshes) {
+		m_upload.insert(m_upload.end(), mesh.pending.begin(), mesh.pending.end());
+	}
+	if (m_upload.empty()) {
+		return;
+	}
+
+	// SFML guarda y restaura su estado alrededor del OpenGL propio
+	target.pushGLStates();
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl.useProgram(m_program);
+	gl.uniformMatrix4fv(m_viewLocation, 1, GL_FALSE, target.getView().getTransform().getMatrix());
+	gl.bindVertexArray(m_vertexArray);
+
+	// Una sola escritura con las instancias de todas las mallas
+	size_t offset = m_instances.write(m_upload.data(), m_upload.size() * sizeof(Instance));
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	stats.countUpload(m_upload.size() * sizeof(Instance));
+
+	size_t first = 0;
+	for (Mesh& mesh : m_meshes) {
+		if (mesh.pending.empty()) {
+			continue;
+		}
+		gl.bindBuffer(kGlArrayBuffer, mesh.vertexBuffer);
+		gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vector2f), nullptr);
+		gl.enableVertexAttribArray(0);
+
+		gl.bindBuffer(kGlArrayBuffer, m_instances.buffer());
+		const char* base = reinterpret_cast<const char*>(offset + first * sizeof(Instance));
+		gl.vertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), base + offsetof(Instance, row0));
+		gl.vertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), base + offsetof(Instance, row1));
+		gl.vertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), base + offsetof(Instance, color));
+		for (GLuint attribute = 1; attribute <= 3; ++attribute) {
+			gl.enableVertexAttribArray(attribute);
+			gl.vertexAttribDivisor(attribute, 1);
+		}
+
+		gl.drawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(mesh.vertexCount),
+			static_cast<GLsizei>(mesh.pending.size()));
+		stats.countDraw(mesh.vertexCount * mesh.pending.size(), nullptr, nullptr, sf::BlendAlpha, m_program);
+		++m_drawCalls;
+		m_instanceTotal += mesh.pending.size();
+		first += mesh.pending.size();
+		mesh.pending.clear();
+	}
+
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+	gl.useProgram(0);
+	target.popGLStates();
+}
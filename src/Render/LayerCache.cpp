@@ -0,0 +1,226 @@
+#include "Render/LayerCache.h"
+#include <algorithm>
+#include "ECS/ChangeTick.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/RenderStats.h"
+#include "Render/ShapeBatcher.h"
+
+namespace {
+	/**
+	 * @brief Mezcla para pegar una textura dibujada sobre transparente: sus colores ya vienen
+	 *        multiplicados por su alfa.
+	 */
+	const sf::BlendMode kPremultipliedAlpha(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+	bool
+	sameView(const sf::View& a, const sf::View& b) {
+		return a.getCenter() == b.getCenter() && a.getSize() == b.getSize() && a.getRotation() == b.getRotation() &&
+		       a.getViewport() == b.getViewport();
+	}
+
+	sf::FloatRect
+	unite(const sf::FloatRect& a, const sf::FloatRect& b) {
+		float left = std::min(a.left, b.left);
+		float top = std::min(a.top, b.top);
+		float right = std::max(a.left + a.width, b.left + b.width);
+		float bottom = std::max(a.top + a.height, b.top + b.height);
+		return sf::FloatRect(left, top, right - left, bottom - top);
+	}
+}
+
+void
+LayerCache::setCached(uint8_t layer, bool cached) {
+	if (cached == isCached(layer)) {
+		return;
+	}
+	if (cached) {
+		EngineUtilities::TUniquePtr<Layer> entry = EngineUtilities::MakeUnique<Layer>();
+		entry->id = layer;
+		m_layers.push_back(std::move(entry));
+		m_cachedMask[layer >> 6] |= uint64_t(1) << (layer & 63);
+		return;
+	}
+	m_layers.erase(std::find_if(m_layers.begin(), m_layers.end(),
+		[layer](const EngineUtilities::TUniquePtr<Layer>& entry) { return entry->id == layer; }));
+	m_cachedMask[layer >> 6] &= ~(uint64_t(1) << (layer & 63));
+}
+
+void
+LayerCache::markDirty(uint8_t layer) {
+	if (Layer* entry = find(layer)) {
+		entry->dirty = true;
+	}
+}
+
+void
+LayerCache::markDirty(uint8_t layer, const sf::FloatRect& area) {
+	Layer* entry = find(layer);
+	if (!entry || entry->dirty) {
+		return;
+	}
+	entry->region = entry->regionDirty ? unite(entry->region, area) : area;
+	entry->regionDirty = true;
+}
+
+void
+LayerCache::noteChange(uint8_t layer, uint32_t changeTick) {
+	Layer* entry = find(layer);
+	if (entry && isNewerTick(changeTick, entry->drawnTick)) {
+		entry->dirty = true;
+	}
+}
+
+bool
+LayerCache::isDirty(uint8_t layer) const {
+	const Layer* entry = find(layer);
+	return entry && (entry->dirty || entry->regionDirty);
+}
+
+void
+LayerCache::submit(sf::RenderTarget& target, RenderCommandBuffer& commands, ShapeBatcher& batcher) {
+	commands.sort();
+	syncTarget(target);
+
+	// Si cambi cuntos comandos trae una capa, alguien entr o sali de ella
+	std::array<uint32_t, 256> counts{};
+	commands.forEach([&counts](const DrawCommand& command) { ++counts[RenderCommandBuffer::layerOf(command.sortKey)]; });
+	for (EngineUtilities::TUniquePtr<Layer>& layer : m_layers) {
+		if (counts[layer->id] != layer->commandCount) {
+			layer->dirty = true;
+			layer->commandCount = counts[layer->id];
+		}
+		// Una capa que qued vaca no aparece abajo: se limpia aqu
+		if (layer->commandCount == 0 && (layer->dirty || layer->regionDirty) && beginRedraw(*layer)) {
+			endRedraw(*layer);
+		}
+	}
+
+	// Los comandos vienen por capa: cada tramo va a la ventana o a la textura de su capa
+	batcher.begin();
+	int currentId = -1;
+	Layer* current = nullptr;
+	bool redrawing = false;
+	sf::RenderTarget* destination = &target;
+	auto closeLayer = [&]() {
+		batcher.end(*destination);
+		if (current) {
+			if (redrawing) {
+				endRedraw(*current);
+			}
+			composite(target, *current);
+		}
+	};
+	commands.forEach([&](const DrawCommand& command) {
+		int id = RenderCommandBuffer::layerOf(command.sortKey);
+		if (id != currentId) {
+			closeLayer();
+			currentId = id;
+			current = isCached(static_cast<uint8_t>(id)) ? find(static_cast<uint8_t>(id)) : nullptr;
+			redrawing = current && (current->dirty || current->regionDirty) && beginRedraw(*current);
+			destination = redrawing ? static_cast<sf::RenderTarget*>(&current->texture) : &target;
+		}
+		// Capa en cach y limpia: su dibujo ya est en la textura
+		if (!current || redrawing) {
+			batcher.add(*destination, command);
+		}
+	});
+	closeLayer();
+}
+
+LayerCache::Layer*
+LayerCache::find(uint8_t layer) {
+	if (!isCached(layer)) {
+		return nullptr;
+	}
+	for (EngineUtilities::TUniquePtr<Layer>& entry : m_layers) {
+		if (entry->id == layer) {
+			return entry.get();
+		}
+	}
+	return nullptr;
+}
+
+const LayerCache::Layer*
+LayerCache::find(uint8_t layer) const {
+	return const_cast<LayerCache*>(this)->find(layer);
+}
+
+void
+LayerCache::syncTarget(const sf::RenderTarget& target) {
+	bool viewChanged = !sameView(target.getView(), m_view);
+	m_size = target.getSize();
+	m_view = target.getView();
+	for (size_t i = 0; i < m_layers.size();) {
+		Layer& layer = *m_layers[i];
+		if (layer.texture.getSize() != m_size) {
+			if (!layer.texture.create(m_size.x, m_size.y)) {
+				// Sin textura la capa vuelve a dibujarse directo en la ventana
+				MESSAGE("LayerCache", "syncTarget", "could not create a layer texture, the layer is no longer cached");
+				setCached(layer.id, false);
+				continue;
+			}
+			layer.dirty = true;
+		}
+		if (viewChanged) {
+			layer.dirty = true;
+		}
+		++i;
+	}
+}
+
+bool
+LayerCache::beginRedraw(Layer& layer) {
+	sf::RenderTexture& texture = layer.texture;
+	if (layer.dirty || m_view.getRotation() != 0.0f) {
+		layer.dirty = true;
+		texture.setView(m_view);
+		texture.clear(sf::Color::Transparent);
+		return true;
+	}
+
+	// rea sucia en pxeles, redondeada hacia afuera y recortada a la textura
+	sf::Vector2i low = texture.mapCoordsToPixel(sf::Vector2f(layer.region.left, layer.region.top), m_view);
+	sf::Vector2i high = texture.mapCoordsToPixel(
+		sf::Vector2f(layer.region.left + layer.region.width, layer.region.top + layer.region.height), m_view);
+	int left = std::max(0, std::min(low.x, high.x) - 1);
+	int top = std::max(0, std::min(low.y, high.y) - 1);
+	int right = std::min(static_cast<int>(m_size.x), std::max(low.x, high.x) + 1);
+	int bottom = std::min(static_cast<int>(m_size.y), std::max(low.y, high.y) + 1);
+	if (right <= left || bottom <= top) {
+		layer.regionDirty = false;
+		return false;
+	}
+
+	// Una vista que muestra solo esa rea, en ese lugar de la textura: el viewport recorta lo dems
+	sf::Vector2f from = texture.mapPixelToCoords(sf::Vector2i(left, top), m_view);
+	sf::Vector2f to = texture.mapPixelToCoords(sf::Vector2i(right, bottom), m_view);
+	sf::View clip(sf::FloatRect(from, to - from));
+	clip.setViewport(sf::FloatRect(static_cast<float>(left) / m_size.x, static_cast<float>(top) / m_size.y,
+		static_cast<float>(right - left) / m_size.x, static_cast<float>(bottom - top) / m_size.y));
+	texture.setView(clip);
+
+	sf::RectangleShape eraser(to - from);
+	eraser.setPosition(from);
+	eraser.setFillColor(sf::Color::Transparent);
+	texture.draw(eraser, sf::RenderStates(sf::BlendNone));
+	return true;
+}
+
+void
+LayerCache::endRedraw(Layer& layer) {
+	layer.texture.display();
+	layer.texture.setView(m_view);
+	layer.dirty = false;
+	layer.regionDirty = false;
+	layer.drawnTick = advanceChangeTick();
+	++m_redraws;
+}
+
+void
+LayerCache::composite(sf::RenderTarget& target, Layer& layer) {
+	sf::View view = target.getView();
+	target.setView(target.getDefaultView());
+	target.draw(sf::Sprite(layer.texture.getTexture()), sf::RenderStates(kPremultipliedAlpha));
+	RenderStatsCounter::current().countDraw(4, &layer.texture.getTexture(), nullptr, kPremultipliedAlpha);
+	target.setView(view);
+}
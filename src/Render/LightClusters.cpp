@@ -0,0 +1,148 @@
+#include "Render/LightClusters.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	/**
+	 * @brief Celda de una coordenada normalizada en `[-1, 1]` entre `tiles`, recortada.
+	 */
+	uint32_t
+	tileOf(float ndc, uint32_t tiles) {
+		float tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+		return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tiles - 1)));
+	}
+}
+
+void
+LightClusters::build(const CameraUniforms& camera, std::span<const PointLightData> lights) {
+	// Planos de la proyeccin, en profundidad de vista (positiva delante de la cmara)
+	const float* projection = camera.projection.data();
+	m_perspective = projection[11] != 0.0f;
+	if (m_perspective) {
+		m_near = projection[14] / (projection[10] - 1.0f);
+		m_far = projection[14] / (projection[10] + 1.0f);
+	}
+	else {
+		m_near = (projection[14] + 1.0f) / projection[10];
+		m_far = (projection[14] - 1.0f) / projection[10];
+	}
+	m_logarithmic = m_perspective && m_near > 0.0f && m_far > m_near;
+	if (m_logarithmic) {
+		m_sliceScale = static_cast<float>(kSlices) / std::log(m_far / m_near);
+		m_sliceBias = -std::log(m_near) * m_sliceScale;
+	}
+	else {
+		m_sliceScale = m_far != m_near ? static_cast<float>(kSlices) / (m_far - m_near) : 0.0f;
+		m_sliceBias = -m_near * m_sliceScale;
+	}
+
+	// Contar: cuntas luces toca cada celda
+	m_lightCount = std::min(lights.size(), kMaxLights);
+	m_bounds.resize(m_lightCount);
+	std::fill(m_clusters.begin(), m_clusters.end(), Range{});
+	for (size_t light = 0; light < m_lightCount; ++light) {
+		Bounds& bounds = m_bounds[light];
+		if (!boundsOf(camera, lights[light], bounds)) {
+			bounds.x1 = 0;
+			bounds.x0 = 1;
+			continue;
+		}
+		for (uint32_t z = bounds.z0; z <= bounds.z1; ++z) {
+			for (uint32_t y = bounds.y0; y <= bounds.y1; ++y) {
+				Range* row = &m_clusters[(z * kTilesY + y) * kTilesX];
+				for (uint32_t x = bounds.x0; x <= bounds.x1; ++x) {
+					++row[x].count;
+				}
+			}
+		}
+	}
+
+	// Dnde empieza cada celda, y llenar en el mismo orden
+	uint32_t total = 0;
+	for (Range& range : m_clusters) {
+		range.offset = total;
+		total += range.count;
+		range.count = 0;
+	}
+	m_indices.resize(total);
+	for (size_t light = 0; light < m_lightCount; ++light) {
+		const Bounds& bounds = m_bounds[light];
+		if (bounds.x1 < bounds.x0) {
+			continue;
+		}
+		for (uint32_t z = bounds.z0; z <= bounds.z1; ++z) {
+			for (uint32_t y = bounds.y0; y <= bounds.y1; ++y) {
+				Range* row = &m_clusters[(z * kTilesY + y) * kTilesX];
+				for (uint32_t x = bounds.x0; x <= bounds.x1; ++x) {
+					m_indices[row[x].offset + row[x].count++] = static_cast<uint32_t>(light);
+				}
+			}
+		}
+	}
+}
+
+bool
+LightClusters::boundsOf(const CameraUniforms& camera, const PointLightData& light, Bounds& out) const {
+	const float* view = camera.view.data();
+	const float* projection = camera.projection.data();
+	float radius = light.position[3];
+	if (radius <= 0.0f) {
+		return false;
+	}
+
+	// Centro en la vista y mitad de la caja de la esfera por eje: la vista 2D escala distinto en x e y
+	float center[3];
+	float extent[3];
+	for (int row = 0; row < 3; ++row) {
+		center[row] = view[row] * light.position[0] + view[4 + row] * light.position[1] + view[8 + row] * light.position[2] +
+		              view[12 + row];
+		extent[row] = radius * std::sqrt(view[row] * view[row] + view[4 + row] * view[4 + row] + view[8 + row] * view[8 + row]);
+	}
+
+	// Profundidad de vista de la esfera: -z, delante positiva
+	float nearest = -center[2] - extent[2];
+	float farthest = -center[2] + extent[2];
+	if (farthest < m_near || nearest > m_far) {
+		return false;
+	}
+	out.z0 = sliceOf(std::max(nearest, m_near));
+	out.z1 = sliceOf(std::min(farthest, m_far));
+
+	// Las 8 esquinas de su caja en la vista, proyectadas; en perspectiva no pasan del plano cercano
+	float lowX = 1.0f, lowY = 1.0f, highX = -1.0f, highY = -1.0f;
+	for (int corner = 0; corner < 8; ++corner) {
+		float x = center[0] + ((corner & 1) ? extent[0] : -extent[0]);
+		float y = center[1] + ((corner & 2) ? extent[1] : -extent[1]);
+		float z = center[2] + ((corner & 4) ? extent[2] : -extent[2]);
+		if (m_perspective) {
+			z = std::min(z, -m_near);
+		}
+		float clipX = projection[0] * x + projection[4] * y + projection[8] * z + projection[12];
+		float clipY = projection[1] * x + projection[5] * y + projection[9] * z + projection[13];
+		float clipW = projection[3] * x + projection[7] * y + projection[11] * z + projection[15];
+		lowX = std::min(lowX, clipX / clipW);
+		highX = std::max(highX, clipX / clipW);
+		lowY = std::min(lowY, clipY / clipW);
+		highY = std::max(highY, clipY / clipW);
+	}
+	if (highX < -1.0f || lowX > 1.0f || highY < -1.0f || lowY > 1.0f) {
+		return false;
+	}
+	out.x0 = tileOf(lowX, kTilesX);
+	out.x1 = tileOf(highX, kTilesX);
+	out.y0 = tileOf(lowY, kTilesY);
+	out.y1 = tileOf(highY, kTilesY);
+	return true;
+}
+
+uint32_t
+LightClusters::sliceOf(float viewDepth) const {
+	float depth = m_logarithmic ? std::log(std::max(viewDepth, 1e-4f)) : viewDepth;
+	float slice = std::floor(depth * m_sliceScale + m_sliceBias);
+	return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(kSlices - 1)));
+}
+
+uint32_t
+LightClusters::clusterOf(float ndcX, float ndcY, float viewDepth) const {
+	return (sliceOf(viewDepth) * kTilesY + tileOf(ndcY, kTilesY)) * kTilesX + tileOf(ndcX, kTilesX);
+}
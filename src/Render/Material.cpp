@@ -0,0 +1,192 @@
+#include "Render/Material.h"
+#include <charconv>
+#include "Render/MeshPipeline.h"
+#include "Render/TextureAtlas.h"
+#include "Render/TextureLoader.h"
+#include "Scene/MappedFile.h"
+
+namespace {
+
+	bool
+	isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+	/**
+	 * @brief Siguiente palabra de `line`, que avanza; vaca al final o donde empieza un comentario.
+	 */
+	std::string_view
+	readWord(std::string_view& line) {
+		size_t start = 0;
+		while (start < line.size() && isBlank(line[start])) {
+			++start;
+		}
+		size_t end = start;
+		while (end < line.size() && !isBlank(line[end]) && line[end] != '#') {
+			++end;
+		}
+		std::string_view word = line.substr(start, end - start);
+		line.remove_prefix(end);
+		return word;
+	}
+
+	bool
+	readFloat(std::string_view& line, float& value) {
+		std::string_view word = readWord(line);
+		std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), value);
+		return !word.empty() && result.ec == std::errc() && result.ptr == word.data() + word.size();
+	}
+
+	/**
+	 * @brief `R G B [A]` de 0 a 255, o `0xRRGGBB[AA]`, como en `SceneText`.
+	 */
+	bool
+	readColor(std::string_view& line, sf::Color& color) {
+		std::string_view word = readWord(line);
+		if (word.size() > 2 && word[0] == '0' && (word[1] == 'x' || word[1] == 'X')) {
+			uint32_t hex = 0;
+			word.remove_prefix(2);
+			std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), hex, 16);
+			if ((word.size() != 6 && word.size() != 8) || result.ec != std::errc() || result.ptr != word.data() + word.size()) {
+				return false;
+			}
+			color = sf::Color(word.size() == 6 ? hex << 8 | 0xFFu : hex);
+			return true;
+		}
+		unsigned channels[4] = { 0, 0, 0, 255 };
+		size_t count = 0;
+		for (; !word.empty() && count < 4; word = readWord(line)) {
+			std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), channels[count]);
+			if (result.ec != std::errc() || result.ptr != word.data() + word.size() || channels[count] > 255) {
+				return false;
+			}
+			if (++count == 4) {
+				break;
+			}
+		}
+		if (count < 3) {
+			return false;
+		}
+		color = sf::Color(static_cast<sf::Uint8>(channels[0]), static_cast<sf::Uint8>(channels[1]),
+			static_cast<sf::Uint8>(channels[2]), static_cast<sf::Uint8>(channels[3]));
+		return true;
+	}
+
+	/**
+	 * @brief El resto de `line` sin los blancos de los lados ni el comentario.
+	 */
+	std::string_view
+	readRest(std::string_view line) {
+		line = line.substr(0, line.find('#'));
+		while (!line.empty() && isBlank(line.front())) {
+			line.remove_prefix(1);
+		}
+		while (!line.empty() && isBlank(line.back())) {
+			line.remove_suffix(1);
+		}
+		return line;
+	}
+
+} // namespace
+
+Material::~Material() {
+	if (m_pipeline) {
+		m_pipeline->evict(*this);
+	}
+}
+
+void
+Material::setColor(sf::Color color) {
+	m_color = color;
+	++m_version;
+}
+
+void
+Material::setEmissive(sf::Color emissive) {
+	m_emissive = emissive;
+	++m_version;
+}
+
+void
+Material::setTexture(const sf::Texture* texture, const sf::FloatRect& rect) {
+	m_texture = texture;
+	m_textureRect = rect;
+	++m_version;
+}
+
+void
+Material::setTexture(const AtlasRegion& region) {
+	if (!region.texture) {
+		setTexture(nullptr);
+		return;
+	}
+	sf::Vector2f size(region.texture->getSize());
+	setTexture(region.texture, sf::FloatRect(region.rect.left / size.x, region.rect.top / size.y,
+		region.rect.width / size.x, region.rect.height / size.y));
+}
+
+bool
+Material::parse(std::string_view text, std::string* error) {
+	size_t lineNumber = 0;
+	while (!text.empty()) {
+		size_t end = text.find('\n');
+		std::string_view line = text.substr(0, end);
+		text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+		++lineNumber;
+
+		auto fail = [&](const char* message) {
+			if (error) {
+				*error = "line " + std::to_string(lineNumber) + ": " + message;
+			}
+			return false;
+		};
+		std::string_view keyword = readWord(line);
+		if (keyword.empty()) {
+			continue;
+		}
+		if (keyword == "color" || keyword == "emissive") {
+			sf::Color color;
+			if (!readColor(line, color)) {
+				return fail("expected R G B [A] or 0xRRGGBB[AA]");
+			}
+			if (keyword == "color") {
+				setColor(color);
+			}
+			else {
+				setEmissive(color);
+			}
+		}
+		else if (keyword == "texture") {
+			std::string_view path = readRest(line);
+			TextureLoader* loader = EngineUtilities::TService<TextureLoader>::get();
+			if (path.empty()) {
+				return fail("texture expects a path");
+			}
+			if (loader) {
+				setTexture(loader->load(std::string(path)), m_textureRect);
+			}
+		}
+		else if (keyword == "uv") {
+			sf::FloatRect rect;
+			if (!readFloat(line, rect.left) || !readFloat(line, rect.top) || !readFloat(line, rect.width) ||
+				!readFloat(line, rect.height)) {
+				return fail("uv expects left top width height");
+			}
+			setTexture(m_texture, rect);
+		}
+		else {
+			return fail("unknown keyword");
+		}
+	}
+	return true;
+}
+
+bool
+Material::loadFromFile(const std::string& path, std::string* error) {
+	MappedFile file;
+	if (!file.open(path)) {
+		if (error) {
+			*error = "could not open " + path;
+		}
+		return false;
+	}
+	return parse(std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), error);
+}
@@ -0,0 +1,146 @@
+#include "Render/Mesh.h"
+#include <algorithm>
+#include <cmath>
+#include "Render/MeshPipeline.h"
+
+Mesh::~Mesh() {
+	if (m_pipeline) {
+		m_pipeline->evict(*this);
+	}
+	EngineUtilities::MemoryAccounting::onFree(kMemoryCategory, bytes());
+}
+
+void
+Mesh::setGeometry(std::vector<MeshVertex> vertices, std::vector<uint32_t> indices) {
+	EngineUtilities::MemoryAccounting::onFree(kMemoryCategory, bytes());
+	m_vertices = std::move(vertices);
+	m_indices = std::move(indices);
+	EngineUtilities::MemoryAccounting::onAllocate(kMemoryCategory, bytes());
+	++m_version;
+
+	m_center = sf::Vector3f();
+	m_boundsMin = sf::Vector3f();
+	m_boundsMax = sf::Vector3f();
+	if (m_vertices.empty()) {
+		return;
+	}
+	float low[3] = { m_vertices[0].position[0], m_vertices[0].position[1], m_vertices[0].position[2] };
+	float high[3] = { low[0], low[1], low[2] };
+	for (const MeshVertex& vertex : m_vertices) {
+		for (int axis = 0; axis < 3; ++axis) {
+			low[axis] = std::min(low[axis], vertex.position[axis]);
+			high[axis] = std::max(high[axis], vertex.position[axis]);
+		}
+	}
+	m_center = sf::Vector3f((low[0] + high[0]) * 0.5f, (low[1] + high[1]) * 0.5f, (low[2] + high[2]) * 0.5f);
+	m_boundsMin = sf::Vector3f(low[0], low[1], low[2]);
+	m_boundsMax = sf::Vector3f(high[0], high[1], high[2]);
+}
+
+void
+Mesh::setSkin(std::vector<MeshSkin> skin) {
+	EngineUtilities::MemoryAccounting::onFree(kMemoryCategory, bytes());
+	m_skin = std::move(skin);
+	EngineUtilities::MemoryAccounting::onAllocate(kMemoryCategory, bytes());
+	++m_version;
+}
+
+bool
+Mesh::raycast(const sf::Vector3f& origin, const sf::Vector3f& direction, float maxDistance, float& distance) const {
+	if (m_indices.empty()) {
+		return false;
+	}
+	// Caja por ejes: los tres tramos de t dentro de cada par de planos tienen que cruzarse
+	const float from[3] = { origin.x, origin.y, origin.z };
+	const float step[3] = { direction.x, direction.y, direction.z };
+	const float low[3] = { m_boundsMin.x, m_boundsMin.y, m_boundsMin.z };
+	const float high[3] = { m_boundsMax.x, m_boundsMax.y, m_boundsMax.z };
+	float enter = 0.0f;
+	float exit = maxDistance;
+	for (int axis = 0; axis < 3; ++axis) {
+		if (step[axis] == 0.0f) {
+			if (from[axis] < low[axis] || from[axis] > high[axis]) {
+				return false;
+			}
+			continue;
+		}
+		float t0 = (low[axis] - from[axis]) / step[axis];
+		float t1 = (high[axis] - from[axis]) / step[axis];
+		enter = std::max(enter, std::min(t0, t1));
+		exit = std::min(exit, std::max(t0, t1));
+		if (enter > exit) {
+			return false;
+		}
+	}
+
+	// Mller-Trumbore por tringulo, quedndose con el ms cercano
+	bool hit = false;
+	float closest = maxDistance;
+	for (size_t i = 0; i + 2 < m_indices.size(); i += 3) {
+		const float* a = m_vertices[m_indices[i]].position;
+		const float* b = m_vertices[m_indices[i + 1]].position;
+		const float* c = m_vertices[m_indices[i + 2]].position;
+		sf::Vector3f edge1(b[0] - a[0], b[1] - a[1], b[2] - a[2]);
+		sf::Vector3f edge2(c[0] - a[0], c[1] - a[1], c[2] - a[2]);
+		sf::Vector3f p(direction.y * edge2.z - direction.z * edge2.y, direction.z * edge2.x - direction.x * edge2.z,
+			direction.x * edge2.y - direction.y * edge2.x);
+		float determinant = edge1.x * p.x + edge1.y * p.y + edge1.z * p.z;
+		if (std::abs(determinant) < 1e-12f) {
+			continue;
+		}
+		float inverse = 1.0f / determinant;
+		sf::Vector3f s(origin.x - a[0], origin.y - a[1], origin.z - a[2]);
+		float u = (s.x * p.x + s.y * p.y + s.z * p.z) * inverse;
+		if (u < 0.0f || u > 1.0f) {
+			continue;
+		}
+		sf::Vector3f q(s.y * edge1.z - s.z * edge1.y, s.z * edge1.x - s.x * edge1.z, s.x * edge1.y - s.y * edge1.x);
+		float v = (direction.x * q.x + direction.y * q.y + direction.z * q.z) * inverse;
+		if (v < 0.0f || u + v > 1.0f) {
+			continue;
+		}
+		float t = (edge2.x * q.x + edge2.y * q.y + edge2.z * q.z) * inverse;
+		if (t >= 0.0f && t <= closest) {
+			closest = t;
+			hit = true;
+		}
+	}
+	if (hit) {
+		distance = closest;
+	}
+	return hit;
+}
+
+void
+Mesh::makeBox(const sf::Vector3f& halfExtents) {
+	// Por cara: normal y los dos ejes que la recorren
+	static const float kFaces[6][3][3] = {
+		{ { 1, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 } },
+		{ { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+		{ { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } },
+		{ { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+		{ { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+		{ { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1, 0 } },
+	};
+	const float half[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> indices;
+	vertices.reserve(24);
+	indices.reserve(36);
+	for (const auto& face : kFaces) {
+		uint32_t first = static_cast<uint32_t>(vertices.size());
+		for (int corner = 0; corner < 4; ++corner) {
+			float u = (corner == 1 || corner == 2) ? 1.0f : -1.0f;
+			float v = (corner >= 2) ? 1.0f : -1.0f;
+			MeshVertex& vertex = vertices.emplace_back();
+			for (int axis = 0; axis < 3; ++axis) {
+				vertex.position[axis] = (face[0][axis] + u * face[1][axis] + v * face[2][axis]) * half[axis];
+				vertex.normal[axis] = face[0][axis];
+			}
+			vertex.uv[0] = (u + 1.0f) * 0.5f;
+			vertex.uv[1] = (v + 1.0f) * 0.5f;
+		}
+		indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+	}
+	setGeometry(std::move(vertices), std::move(indices));
+}
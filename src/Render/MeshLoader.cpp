@@ -0,0 +1,337 @@
+#include "Render/MeshLoader.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include "Render/MeshFormat.h"
+#include "Scene/MappedFile.h"
+
+namespace {
+
+	/**
+	 * @brief Lo que falta leer del texto; los tokens son tramos de l, nunca copias.
+	 */
+	struct Cursor {
+		const char* at;
+		const char* end;
+	};
+
+	bool
+	isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+	void
+	skipBlanks(Cursor& cursor) {
+		while (cursor.at < cursor.end && isBlank(*cursor.at)) {
+			++cursor.at;
+		}
+	}
+
+	void
+	skipLine(Cursor& cursor) {
+		while (cursor.at < cursor.end && *cursor.at++ != '\n') {
+		}
+	}
+
+	bool
+	atLineEnd(const Cursor& cursor) {
+		return cursor.at >= cursor.end || *cursor.at == '\n' || *cursor.at == '#';
+	}
+
+	bool
+	readFloat(Cursor& cursor, float& value) {
+		skipBlanks(cursor);
+		if (cursor.at < cursor.end && *cursor.at == '+') {
+			++cursor.at;
+		}
+		std::from_chars_result result = std::from_chars(cursor.at, cursor.end, value);
+		if (result.ec != std::errc()) {
+			return false;
+		}
+		cursor.at = result.ptr;
+		return true;
+	}
+
+	bool
+	readIndex(Cursor& cursor, int64_t& value) {
+		std::from_chars_result result = std::from_chars(cursor.at, cursor.end, value);
+		if (result.ec != std::errc()) {
+			return false;
+		}
+		cursor.at = result.ptr;
+		return true;
+	}
+
+	/**
+	 * @brief ndice de `.obj` (desde 1, o negativo desde el final) a uno desde 0, o -1.
+	 */
+	int64_t
+	resolve(int64_t index, size_t count) {
+		int64_t resolved = index > 0 ? index - 1 : static_cast<int64_t>(count) + index;
+		return index != 0 && resolved >= 0 && resolved < static_cast<int64_t>(count) ? resolved : -1;
+	}
+
+	/**
+	 * @brief Los tres ndices de una esquina de cara, ya desde 0; -1 si no vino.
+	 */
+	struct Corner {
+		int64_t position;
+		int64_t uv;
+		int64_t normal;
+
+		bool
+		operator==(const Corner& other) const {
+			return position == other.position && uv == other.uv && normal == other.normal;
+		}
+	};
+
+	struct CornerHash {
+		size_t
+		operator()(const Corner& corner) const {
+			uint64_t hash = static_cast<uint64_t>(corner.position) * 0x9E3779B97F4A7C15ull;
+			hash ^= static_cast<uint64_t>(corner.uv + 1) * 0xC2B2AE3D27D4EB4Full + (hash >> 29);
+			hash ^= static_cast<uint64_t>(corner.normal + 1) * 0x165667B19E3779F9ull + (hash >> 32);
+			return static_cast<size_t>(hash);
+		}
+	};
+
+} // namespace
+
+MeshLoader::~MeshLoader() {
+	m_jobs.wait(m_counter);
+}
+
+EngineUtilities::TSharedPointer<Mesh>
+MeshLoader::load(const std::string& path) {
+	EngineUtilities::TUniquePtr<Request> request = EngineUtilities::MakeUnique<Request>();
+	request->mesh = EngineUtilities::MakeShared<Mesh>();
+	request->path = path;
+	request->packed = PackLibrary::lookup(path);
+	EngineUtilities::TSharedPointer<Mesh> mesh = request->mesh;
+
+	// El trabajo no toca `mesh`: solo la ruta y lo que llena
+	Request* loading = request.get();
+	m_requests.push_back(std::move(request));
+	m_jobs.run([this, loading]() {
+		MappedFile file;
+		std::vector<unsigned char> unpacked;
+		std::span<const unsigned char> bytes;
+		if (loading->packed.found) {
+			bytes = loading->packed.bytes(unpacked, &m_jobs);
+		}
+		else if (file.open(loading->path)) {
+			bytes = std::span<const unsigned char>(file.data(), file.size());
+		}
+		if (!bytes.empty()) {
+			uint32_t magic = 0;
+			if (bytes.size() >= sizeof(magic)) {
+				std::memcpy(&magic, bytes.data(), sizeof(magic));
+			}
+			loading->loaded = magic == kMeshMagic
+				? parseMesh(bytes.data(), bytes.size(), loading->vertices, loading->indices)
+				: !m_cookedOnly && parseObj(reinterpret_cast<const char*>(bytes.data()), bytes.size(), loading->vertices, loading->indices);
+		}
+		loading->done.store(true, std::memory_order_release);
+	}, &m_counter);
+	return mesh;
+}
+
+size_t
+MeshLoader::adoptFinished() {
+	size_t adopted = 0;
+	for (size_t i = 0; i < m_requests.size();) {
+		Request& request = *m_requests[i];
+		if (!request.done.load(std::memory_order_acquire)) {
+			++i;
+			continue;
+		}
+		if (request.loaded) {
+			request.mesh->setGeometry(std::move(request.vertices), std::move(request.indices));
+			++adopted;
+		}
+		else {
+			MESSAGE("MeshLoader", "adoptFinished", "could not load a mesh file, the mesh stays empty");
+		}
+		m_requests[i] = std::move(m_requests.back());
+		m_requests.pop_back();
+	}
+	return adopted;
+}
+
+bool
+MeshLoader::isPending(const Mesh* mesh) const {
+	for (const EngineUtilities::TUniquePtr<Request>& request : m_requests) {
+		if (request->mesh.get() == mesh) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+MeshLoader::finishAll() {
+	m_jobs.wait(m_counter);
+	adoptFinished();
+}
+
+bool
+MeshLoader::parseObj(const char* text, size_t size, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) {
+	vertices.clear();
+	indices.clear();
+	std::vector<sf::Vector3f> positions;
+	std::vector<sf::Vector2f> uvs;
+	std::vector<sf::Vector3f> normals;
+	std::unordered_map<Corner, uint32_t, CornerHash> corners;
+	bool missingNormals = false;
+
+	Cursor cursor{ text, text + size };
+	while (cursor.at < cursor.end) {
+		skipBlanks(cursor);
+		const char* line = cursor.at;
+		char next = line + 1 < cursor.end ? line[1] : '\n';
+		if (line < cursor.end && *line == 'v' && (isBlank(next) || next == 't' || next == 'n')) {
+			cursor.at += isBlank(next) ? 1 : 2;
+			float x = 0.0f, y = 0.0f, z = 0.0f;
+			bool ok = readFloat(cursor, x) && readFloat(cursor, y);
+			if (next == 't') {
+				uvs.emplace_back(x, y);
+			}
+			else if (ok && readFloat(cursor, z)) {
+				(next == 'n' ? normals : positions).emplace_back(x, y, z);
+			}
+		}
+		else if (line < cursor.end && *line == 'f' && isBlank(next)) {
+			++cursor.at;
+			uint32_t first = 0;
+			uint32_t previous = 0;
+			uint32_t count = 0;
+			for (skipBlanks(cursor); !atLineEnd(cursor); skipBlanks(cursor)) {
+				int64_t position = 0, uv = 0, normal = 0;
+				if (!readIndex(cursor, position)) {
+					return false;
+				}
+				if (cursor.at < cursor.end && *cursor.at == '/') {
+					++cursor.at;
+					if (cursor.at < cursor.end && *cursor.at != '/' && !readIndex(cursor, uv)) {
+						return false;
+					}
+					if (cursor.at < cursor.end && *cursor.at == '/') {
+						++cursor.at;
+						if (!readIndex(cursor, normal)) {
+							return false;
+						}
+					}
+				}
+				Corner corner{ resolve(position, positions.size()), uv ? resolve(uv, uvs.size()) : -1,
+					normal ? resolve(normal, normals.size()) : -1 };
+				if (corner.position < 0 || (uv && corner.uv < 0) || (normal && corner.normal < 0)) {
+					return false;
+				}
+
+				auto [found, added] = corners.try_emplace(corner, static_cast<uint32_t>(vertices.size()));
+				if (added) {
+					const sf::Vector3f& p = positions[corner.position];
+					const sf::Vector3f n = corner.normal >= 0 ? normals[corner.normal] : sf::Vector3f();
+					const sf::Vector2f t = corner.uv >= 0 ? uvs[corner.uv] : sf::Vector2f();
+					vertices.push_back(MeshVertex{ { p.x, p.y, p.z }, { n.x, n.y, n.z }, { t.x, t.y } });
+					missingNormals |= corner.normal < 0;
+				}
+
+				// Polgonos en abanico desde la primera esquina
+				uint32_t index = found->second;
+				if (count == 0) {
+					first = index;
+				}
+				else if (count >= 2) {
+					indices.insert(indices.end(), { first, previous, index });
+				}
+				previous = index;
+				++count;
+			}
+		}
+		skipLine(cursor);
+	}
+
+	if (missingNormals) {
+		// Suma de las normales de cara (pesadas por rea) en los vrtices que no traan
+		std::vector<bool> fill(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			const float* n = vertices[i].normal;
+			fill[i] = n[0] == 0.0f && n[1] == 0.0f && n[2] == 0.0f;
+		}
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			const float* a = vertices[indices[i]].position;
+			const float* b = vertices[indices[i + 1]].position;
+			const float* c = vertices[indices[i + 2]].position;
+			float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			float v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+			float face[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+			for (size_t corner = i; corner < i + 3; ++corner) {
+				if (fill[indices[corner]]) {
+					float* n = vertices[indices[corner]].normal;
+					n[0] += face[0];
+					n[1] += face[1];
+					n[2] += face[2];
+				}
+			}
+		}
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			float* n = vertices[i].normal;
+			float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if (fill[i] && length > 0.0f) {
+				n[0] /= length;
+				n[1] /= length;
+				n[2] /= length;
+			}
+		}
+	}
+	return true;
+}
+
+bool
+MeshLoader::parseMesh(const unsigned char* data, size_t size, std::vector<MeshVertex>& vertices,
+                      std::vector<uint32_t>& indices) {
+	vertices.clear();
+	indices.clear();
+	MeshFileHeader header;
+	if (size < sizeof(header)) {
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(header));
+	size_t indexSize = (header.flags & kMeshIndices16) ? sizeof(uint16_t) : sizeof(uint32_t);
+	size_t needed = sizeof(header) + size_t(header.vertexCount) * sizeof(PackedMeshVertex) + size_t(header.indexCount) * indexSize;
+	if (header.magic != kMeshMagic || header.version != kMeshVersion || size < needed) {
+		return false;
+	}
+
+	vertices.resize(header.vertexCount);
+	const unsigned char* cursor = data + sizeof(header);
+	for (MeshVertex& vertex : vertices) {
+		PackedMeshVertex packed;
+		std::memcpy(&packed, cursor, sizeof(packed));
+		cursor += sizeof(packed);
+		for (int axis = 0; axis < 3; ++axis) {
+			vertex.position[axis] = dequantizeUnorm16(packed.position[axis], header.positionMin[axis], header.positionScale[axis]);
+		}
+		unpackNormal(packed.normal, vertex.normal);
+		for (int axis = 0; axis < 2; ++axis) {
+			vertex.uv[axis] = dequantizeUnorm16(packed.uv[axis], header.uvMin[axis], header.uvScale[axis]);
+		}
+	}
+
+	indices.resize(header.indexCount);
+	for (uint32_t& index : indices) {
+		if (indexSize == sizeof(uint16_t)) {
+			uint16_t narrow;
+			std::memcpy(&narrow, cursor, sizeof(narrow));
+			index = narrow;
+		}
+		else {
+			std::memcpy(&index, cursor, sizeof(index));
+		}
+		cursor += indexSize;
+		if (index >= header.vertexCount) {
+			return false;
+		}
+	}
+	return true;
+}
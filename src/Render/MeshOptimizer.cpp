@@ -0,0 +1,277 @@
+#include "Render/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include "Render/MeshFormat.h"
+#include "Render/MeshLoader.h"
+#include "Scene/MappedFile.h"
+
+namespace {
+	// Constantes de Forsyth, "Linear-Speed Vertex Cache Optimisation"
+	constexpr float kLastTriangleScore = 0.75f;
+	constexpr float kCacheDecayPower = 1.5f;
+	constexpr float kValenceBoostScale = 2.0f;
+	constexpr float kValenceBoostPower = 0.5f;
+
+	/**
+	 * @brief Qu tan bueno es usar ahora un vrtice: alto si est al frente de la cach y si le
+	 *        quedan pocos tringulos (si no, se quedara solo al final).
+	 */
+	float
+	vertexScore(int32_t cachePosition, uint32_t remaining) {
+		if (remaining == 0) {
+			return -1.0f;
+		}
+		float score = 0.0f;
+		if (cachePosition >= 0) {
+			// Los tres del ltimo tringulo valen lo mismo: cul se usa primero no importa
+			if (cachePosition < 3) {
+				score = kLastTriangleScore;
+			}
+			else {
+				float scaled = 1.0f - static_cast<float>(cachePosition - 3) / (MeshOptimizer::kCacheSize - 3);
+				score = std::pow(scaled, kCacheDecayPower);
+			}
+		}
+		return score + kValenceBoostScale * std::pow(static_cast<float>(remaining), -kValenceBoostPower);
+	}
+}
+
+void
+MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || vertexCount == 0) {
+		return;
+	}
+
+	// Tringulos de cada vrtice, contiguos; `remaining[v]` son los que an no se emitieron
+	std::vector<uint32_t> remaining(vertexCount, 0);
+	for (size_t i = 0; i < triangleCount * 3; ++i) {
+		++remaining[indices[i]];
+	}
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] = offsets[v] + remaining[v];
+	}
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i) {
+			adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<int32_t> cachePosition(vertexCount, -1);
+	std::vector<float> score(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		score[v] = vertexScore(-1, remaining[v]);
+	}
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	int64_t best = -1;
+	float bestScore = -1.0f;
+	for (size_t t = 0; t < triangleCount; ++t) {
+		triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+		if (triangleScore[t] > bestScore) {
+			bestScore = triangleScore[t];
+			best = static_cast<int64_t>(t);
+		}
+	}
+
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+	uint32_t cache[kCacheSize + 3];
+	uint32_t cacheCount = 0;
+	size_t scan = 0;
+	while (output.size() < triangleCount * 3) {
+		// Nada en la cach tiene tringulos pendientes: el siguiente que falte, en orden
+		if (best < 0) {
+			while (emitted[scan]) {
+				++scan;
+			}
+			best = static_cast<int64_t>(scan);
+		}
+		size_t triangle = static_cast<size_t>(best);
+		emitted[triangle] = true;
+		const uint32_t* corners = &indices[triangle * 3];
+		for (int c = 0; c < 3; ++c) {
+			uint32_t v = corners[c];
+			output.push_back(v);
+			uint32_t* list = &adjacency[offsets[v]];
+			for (uint32_t i = 0; i < remaining[v]; ++i) {
+				if (list[i] == triangle) {
+					list[i] = list[remaining[v] - 1];
+					break;
+				}
+			}
+			--remaining[v];
+		}
+
+		// El tringulo va al frente de la cach; lo que se sale del final deja de contar
+		uint32_t next[kCacheSize + 3];
+		uint32_t nextCount = 0;
+		for (int c = 0; c < 3; ++c) {
+			next[nextCount++] = corners[c];
+		}
+		for (uint32_t i = 0; i < cacheCount; ++i) {
+			if (cache[i] != corners[0] && cache[i] != corners[1] && cache[i] != corners[2]) {
+				next[nextCount++] = cache[i];
+			}
+		}
+		for (uint32_t i = 0; i < nextCount; ++i) {
+			uint32_t v = next[i];
+			cachePosition[v] = i < kCacheSize ? static_cast<int32_t>(i) : -1;
+			score[v] = vertexScore(cachePosition[v], remaining[v]);
+		}
+		cacheCount = std::min(nextCount, kCacheSize);
+		std::memcpy(cache, next, cacheCount * sizeof(uint32_t));
+
+		// Solo cambian los tringulos de los vrtices que se tocaron
+		best = -1;
+		bestScore = -1.0f;
+		for (uint32_t i = 0; i < nextCount; ++i) {
+			uint32_t v = next[i];
+			const uint32_t* list = &adjacency[offsets[v]];
+			for (uint32_t j = 0; j < remaining[v]; ++j) {
+				uint32_t t = list[j];
+				triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+				if (triangleScore[t] > bestScore) {
+					bestScore = triangleScore[t];
+					best = t;
+				}
+			}
+		}
+	}
+	output.insert(output.end(), indices.begin() + triangleCount * 3, indices.end());
+	indices.swap(output);
+}
+
+void
+MeshOptimizer::optimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) {
+	constexpr uint32_t kUnused = ~uint32_t(0);
+	std::vector<uint32_t> remap(vertices.size(), kUnused);
+	std::vector<MeshVertex> ordered;
+	ordered.reserve(vertices.size());
+	for (uint32_t& index : indices) {
+		if (remap[index] == kUnused) {
+			remap[index] = static_cast<uint32_t>(ordered.size());
+			ordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices.swap(ordered);
+}
+
+double
+MeshOptimizer::averageCacheMissRatio(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) {
+		return 0.0;
+	}
+	// FIFO: un vrtice sigue en la cach mientras no hayan entrado `cacheSize` despus de l
+	std::vector<int64_t> insertedAt(vertexCount, INT64_MIN / 2);
+	int64_t insertions = 0;
+	size_t misses = 0;
+	for (size_t i = 0; i < triangleCount * 3; ++i) {
+		uint32_t v = indices[i];
+		if (insertions - insertedAt[v] > static_cast<int64_t>(cacheSize)) {
+			insertedAt[v] = ++insertions;
+			++misses;
+		}
+	}
+	return static_cast<double>(misses) / static_cast<double>(triangleCount);
+}
+
+std::vector<unsigned char>
+MeshOptimizer::encode(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices) {
+	MeshFileHeader header;
+	header.vertexCount = static_cast<uint32_t>(vertices.size());
+	header.indexCount = static_cast<uint32_t>(indices.size());
+	header.flags = vertices.size() <= 65536 ? kMeshIndices16 : 0;
+
+	// Caja de posiciones y rango de coordenadas: los 16 bits se reparten dentro de ellos
+	float positionMax[3] = {};
+	float uvMax[2] = {};
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const MeshVertex& vertex = vertices[i];
+		for (int axis = 0; axis < 3; ++axis) {
+			header.positionMin[axis] = i == 0 ? vertex.position[axis] : std::min(header.positionMin[axis], vertex.position[axis]);
+			positionMax[axis] = i == 0 ? vertex.position[axis] : std::max(positionMax[axis], vertex.position[axis]);
+		}
+		for (int axis = 0; axis < 2; ++axis) {
+			header.uvMin[axis] = i == 0 ? vertex.uv[axis] : std::min(header.uvMin[axis], vertex.uv[axis]);
+			uvMax[axis] = i == 0 ? vertex.uv[axis] : std::max(uvMax[axis], vertex.uv[axis]);
+		}
+	}
+	for (int axis = 0; axis < 3; ++axis) {
+		header.positionScale[axis] = positionMax[axis] - header.positionMin[axis];
+	}
+	for (int axis = 0; axis < 2; ++axis) {
+		header.uvScale[axis] = uvMax[axis] - header.uvMin[axis];
+	}
+
+	size_t indexSize = (header.flags & kMeshIndices16) ? sizeof(uint16_t) : sizeof(uint32_t);
+	size_t indexBytes = (indices.size() * indexSize + 3) & ~size_t(3);
+	std::vector<unsigned char> bytes(sizeof(header) + vertices.size() * sizeof(PackedMeshVertex) + indexBytes, 0);
+	std::memcpy(bytes.data(), &header, sizeof(header));
+
+	unsigned char* cursor = bytes.data() + sizeof(header);
+	for (const MeshVertex& vertex : vertices) {
+		PackedMeshVertex packed{};
+		for (int axis = 0; axis < 3; ++axis) {
+			packed.position[axis] = quantizeUnorm16(vertex.position[axis], header.positionMin[axis], header.positionScale[axis]);
+		}
+		packed.normal = packNormal(vertex.normal);
+		for (int axis = 0; axis < 2; ++axis) {
+			packed.uv[axis] = quantizeUnorm16(vertex.uv[axis], header.uvMin[axis], header.uvScale[axis]);
+		}
+		std::memcpy(cursor, &packed, sizeof(packed));
+		cursor += sizeof(packed);
+	}
+	for (uint32_t index : indices) {
+		if (indexSize == sizeof(uint16_t)) {
+			uint16_t narrow = static_cast<uint16_t>(index);
+			std::memcpy(cursor, &narrow, sizeof(narrow));
+		}
+		else {
+			std::memcpy(cursor, &index, sizeof(index));
+		}
+		cursor += indexSize;
+	}
+	return bytes;
+}
+
+bool
+MeshOptimizer::optimizeFile(const std::string& objPath, const std::string& outPath, Report* report) {
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> indices;
+	{
+		MappedFile file;
+		if (!file.open(objPath) ||
+		    !MeshLoader::parseObj(reinterpret_cast<const char*>(file.data()), file.size(), vertices, indices)) {
+			return false;
+		}
+	}
+
+	Report result;
+	result.cacheMissRatioBefore = averageCacheMissRatio(indices, vertices.size());
+	result.bytesBefore = vertices.size() * sizeof(MeshVertex) + indices.size() * sizeof(uint32_t);
+	optimizeVertexCache(indices, vertices.size());
+	optimizeVertexFetch(vertices, indices);
+	result.cacheMissRatioAfter = averageCacheMissRatio(indices, vertices.size());
+	result.vertices = vertices.size();
+	result.triangles = indices.size() / 3;
+
+	std::vector<unsigned char> bytes = encode(vertices, indices);
+	result.bytesAfter = bytes.size();
+	std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	if (report) {
+		*report = result;
+	}
+	return static_cast<bool>(file);
+}
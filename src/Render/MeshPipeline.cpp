@@ -0,0 +1,1479 @@
+#include "Render/MeshPipeline.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include "Render/GlFunctions.h"
+#include "Render/Mesh.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/RenderStats.h"
+#include "Render/ShaderCache.h"
+
+namespace {
+
+	static_assert(sizeof(MeshVertex) == 32, "MeshVertex debe quedar intercalado sin relleno");
+
+	constexpr uint32_t kInitialVertices = 4096;
+	constexpr uint32_t kInitialIndices = 3 * kInitialVertices;
+	constexpr GLuint kCameraBinding = 0; ///< Punto de enlace del bloque `CameraBlock`.
+
+	static_assert(sizeof(CameraUniforms) == 3 * 64 + 16, "CameraUniforms debe seguir la disposicin std140");
+
+	// Atributos: 0 posicin, 1 normal, 2 coordenadas de textura; con piel, 3 huesos y 4 pesos.
+	// Con DRAW_BUFFER la matriz, el color y el resto de cada comando estn en `u_draws`, y el
+	// draw solo dice su ndice: con BASE_INSTANCE en el atributo 5, que avanza por instancia
+	// desde la instancia base. SKINNING 1 toma las matrices de la paleta del frame; 2, de una
+	// animacin horneada, con la matriz de mundo y el tiempo de cada instancia. SHADOW_PASS
+	// proyecta con la luz
+	const char* kVertexShader = R"(#version 330
+#ifndef SKINNING
+#define SKINNING 0
+#endif
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_uv;
+layout(std140) uniform CameraBlock {
+	mat4 u_view;
+	mat4 u_projection;
+	mat4 u_viewProjection;
+	vec4 u_cameraPosition;
+};
+#if DRAW_BUFFER
+uniform samplerBuffer u_draws;          // Siete texels por comando: matriz, color, material y piel, horneada
+uniform samplerBuffer u_materials;      // Cuatro texels por material; el primero es su color
+#if BASE_INSTANCE
+layout(location = 5) in float a_drawIndex;
+int drawIndex() { return int(a_drawIndex) - gl_InstanceID; }
+#else
+uniform int u_drawIndex;
+int drawIndex() { return u_drawIndex; }
+#endif
+vec4 drawTexel(int i) { return texelFetch(u_draws, 7 * drawIndex() + i); }
+mat4 drawModel() { return mat4(drawTexel(0), drawTexel(1), drawTexel(2), drawTexel(3)); }
+#else
+uniform mat4 u_model;
+uniform vec4 u_color;
+mat4 drawModel() { return u_model; }
+#endif
+#if SHADOW_PASS
+uniform mat4 u_lightViewProjection;     // De la cascada que se dibuja
+#endif
+#if SKINNING
+layout(location = 3) in vec4 a_joints;
+layout(location = 4) in vec4 a_weights;
+uniform samplerBuffer u_bones;          // Cuatro texels por matriz, por columnas
+mat4 bone(int index) {
+	int texel = 4 * index;
+	return mat4(texelFetch(u_bones, texel), texelFetch(u_bones, texel + 1), texelFetch(u_bones, texel + 2),
+		texelFetch(u_bones, texel + 3));
+}
+#endif
+#if SKINNING == 1
+mat4 worldMatrix() {
+	int firstBone = int(drawTexel(5).y);
+	ivec4 joints = ivec4(a_joints);
+	mat4 skin = mat4(0.0);
+	for (int i = 0; i < 4; ++i) {
+		skin += bone(firstBone + joints[i]) * a_weights[i];
+	}
+	return drawModel() * skin;
+}
+#elif SKINNING == 2
+uniform samplerBuffer u_instances;      // Cinco texels por instancia: matriz y tiempo
+mat4 worldMatrix() {
+	vec4 draw = drawTexel(5);               // Material, primer hueso, primera instancia, cuadros por segundo
+	ivec4 bake = ivec4(drawTexel(6));       // Primera matriz, huesos, cuadros, 1 si da la vuelta
+	int instance = 5 * (int(draw.z) + gl_InstanceID);
+	mat4 model = mat4(texelFetch(u_instances, instance), texelFetch(u_instances, instance + 1),
+		texelFetch(u_instances, instance + 2), texelFetch(u_instances, instance + 3));
+	float frames = float(bake.z);
+	float frame = texelFetch(u_instances, instance + 4).x * draw.w;
+	frame = bake.w != 0 ? mod(frame, frames) : clamp(frame, 0.0, frames - 1.0);
+	int frame0 = min(int(frame), bake.z - 1);
+	int frame1 = bake.w != 0 ? (frame0 + 1) % bake.z : min(frame0 + 1, bake.z - 1);
+	float t = frame - float(frame0);
+	int base0 = bake.x + frame0 * bake.y;
+	int base1 = bake.x + frame1 * bake.y;
+	ivec4 joints = ivec4(a_joints);
+	mat4 skin = mat4(0.0);
+	for (int i = 0; i < 4; ++i) {
+		if (a_weights[i] > 0.0) {
+			skin += mix(bone(base0 + joints[i]), bone(base1 + joints[i]), t) * a_weights[i];
+		}
+	}
+	return model * skin;
+}
+#endif
+out vec3 v_normal;
+out vec3 v_worldPosition;
+out float v_viewDepth;
+out vec2 v_uv;
+flat out vec4 v_color;
+#if DRAW_BUFFER
+flat out int v_material;
+#endif
+void main() {
+#if SKINNING
+	mat4 model = worldMatrix();
+#else
+	mat4 model = drawModel();
+#endif
+	vec4 world = model * vec4(a_position, 1.0);
+	v_normal = mat3(model) * a_normal;
+	v_worldPosition = world.xyz;
+	v_viewDepth = -(u_view * world).z;
+	v_uv = a_uv;
+#if DRAW_BUFFER
+	v_material = int(drawTexel(5).x);
+	v_color = drawTexel(4) * texelFetch(u_materials, 4 * v_material);
+#else
+	v_color = u_color;
+#endif
+#if SHADOW_PASS
+	gl_Position = u_lightViewProjection * world;
+#else
+	gl_Position = u_viewProjection * world;
+#endif
+}
+)";
+
+	// La luz direccional del frame ms su ambiente, con SHADOWS tapada segn la cascada de la
+	// profundidad del pxel; con CLUSTERED_LIGHTS, adems las luces puntuales de la celda del
+	// pxel (`LightClusters`). Con DRAW_BUFFER, la emisin y la textura del material: con
+	// BINDLESS_TEXTURES su handle viene en el bfer, si no, es la enlazada en `u_materialTexture`
+	const char* kFragmentShader = R"(#version 330
+#if BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture : require
+#endif
+in vec3 v_normal;
+in vec3 v_worldPosition;
+in float v_viewDepth;
+in vec2 v_uv;
+flat in vec4 v_color;
+#if DRAW_BUFFER
+flat in int v_material;
+uniform samplerBuffer u_materials;      // Color, emisin, rectngulo de uv, handle y 1 si tiene textura
+#if !BINDLESS_TEXTURES
+uniform sampler2D u_materialTexture;
+#endif
+#endif
+uniform vec4 u_sunDirection;            // Hacia dnde viaja la luz
+uniform vec4 u_sunColor;                // w = ambiente
+#if SHADOWS
+uniform sampler2DShadow u_shadowMap;    // Las cascadas en 2 x 2
+uniform mat4 u_shadowMatrices[SHADOW_CASCADES];
+uniform vec4 u_shadowSplits;            // Profundidad de vista donde termina cada cascada
+float sunShadow() {
+	for (int i = 0; i < SHADOW_CASCADES; ++i) {
+		if (v_viewDepth < u_shadowSplits[i]) {
+			vec3 coord = (u_shadowMatrices[i] * vec4(v_worldPosition, 1.0)).xyz;
+			return textureLod(u_shadowMap, vec3(coord.xy, min(coord.z - 0.0005, 1.0)), 0.0);
+		}
+	}
+	return 1.0;
+}
+#endif
+#if CLUSTERED_LIGHTS
+uniform samplerBuffer u_lightData;      // Dos texels por luz: posicin y radio, color
+uniform usamplerBuffer u_lightClusters; // Por celda: primer ndice y cuntos
+uniform usamplerBuffer u_lightIndices;
+uniform vec4 u_clusterParams;           // Escala y sesgo de rebanada, 1 si logartmica, 1 si hay luces
+uniform vec4 u_viewport;                // En pxeles, con el origen abajo
+#endif
+out vec4 o_color;
+void main() {
+	vec4 color = v_color;
+	vec3 emissive = vec3(0.0);
+#if DRAW_BUFFER
+	int material = 4 * v_material;
+	emissive = texelFetch(u_materials, material + 1).rgb;
+	vec4 textureData = texelFetch(u_materials, material + 3);
+	if (textureData.z > 0.0) {
+		vec4 rect = texelFetch(u_materials, material + 2);
+		vec2 uv = rect.xy + v_uv * rect.zw;
+#if BINDLESS_TEXTURES
+		color *= texture(sampler2D(floatBitsToUint(textureData.xy)), uv);
+#else
+		color *= texture(u_materialTexture, uv);
+#endif
+	}
+#endif
+	vec3 light = -normalize(u_sunDirection.xyz);
+	vec3 normal = normalize(v_normal);
+	float diffuse = max(dot(normal, light), 0.0);
+#if SHADOWS
+	if (diffuse > 0.0) {
+		diffuse *= sunShadow();
+	}
+#endif
+	vec3 lit = u_sunColor.w + u_sunColor.rgb * diffuse;
+#if CLUSTERED_LIGHTS
+	if (u_clusterParams.w > 0.0) {
+		vec2 screen = (gl_FragCoord.xy - u_viewport.xy) / u_viewport.zw;
+		ivec2 tile = clamp(ivec2(floor(screen * vec2(CLUSTER_TILES_X, CLUSTER_TILES_Y))), ivec2(0),
+			ivec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+		float depth = u_clusterParams.z > 0.0 ? log(max(v_viewDepth, 1e-4)) : v_viewDepth;
+		int slice = clamp(int(floor(depth * u_clusterParams.x + u_clusterParams.y)), 0, CLUSTER_SLICES - 1);
+		int cluster = (slice * CLUSTER_TILES_Y + tile.y) * CLUSTER_TILES_X + tile.x;
+		uvec2 range = texelFetch(u_lightClusters, cluster).xy;
+		for (uint i = 0u; i < range.y; ++i) {
+			int index = int(texelFetch(u_lightIndices, int(range.x + i)).x);
+			vec4 positionRadius = texelFetch(u_lightData, 2 * index);
+			vec3 lightColor = texelFetch(u_lightData, 2 * index + 1).rgb;
+			vec3 toLight = positionRadius.xyz - v_worldPosition;
+			float lengthSquared = max(dot(toLight, toLight), 1e-8);
+			float falloff = clamp(1.0 - lengthSquared / (positionRadius.w * positionRadius.w), 0.0, 1.0);
+			lit += lightColor * (falloff * falloff * max(dot(normal, toLight * inversesqrt(lengthSquared)), 0.0));
+		}
+	}
+#endif
+	o_color = vec4(color.rgb * lit + emissive, color.a);
+}
+)";
+
+	// Unidades de textura de los bferes de luces: la 0 es de SFML
+	constexpr GLint kLightDataUnit = 1;
+	constexpr GLint kLightClustersUnit = 2;
+	constexpr GLint kLightIndicesUnit = 3;
+	// Y de los de piel
+	constexpr GLint kBonesUnit = 4;
+	constexpr GLint kBakedBonesUnit = 5;
+	constexpr GLint kInstancesUnit = 6;
+	// Y del atlas de sombras
+	constexpr GLint kShadowUnit = 7;
+	// Y de los comandos y materiales del frame
+	constexpr GLint kMaterialsUnit = 8;
+	constexpr GLint kDrawsUnit = 9;
+	constexpr GLint kMaterialTextureUnit = 10;
+
+	constexpr size_t kDrawTexels = 7;       ///< Por comando en `u_draws`.
+	constexpr size_t kMaterialTexels = 4;   ///< Por material en `u_materials`.
+	constexpr uint32_t kInitialDrawIndices = 1024;
+
+	/**
+	 * @brief Defines de todos los programas: con bfer de comandos si el driver tiene bferes
+	 *        de textura, y cmo llega el ndice del draw y la textura del material.
+	 */
+	std::string
+	drawDefines(bool drawBuffer) {
+		if (!drawBuffer) {
+			return "#define DRAW_BUFFER 0\n";
+		}
+		return std::string("#define DRAW_BUFFER 1\n#define BASE_INSTANCE ") + (hasGlBaseInstance() ? "1" : "0") +
+		       "\n#define BINDLESS_TEXTURES " + (hasGlBindlessTextures() ? "1" : "0") + "\n";
+	}
+
+	/**
+	 * @brief Defines del shader de color: con luces si el driver tiene bferes de textura, con
+	 *        sombras si tiene framebuffers.
+	 */
+	std::string
+	fragmentDefines(bool clustered, bool shadows) {
+		std::string defines = shadows ? "#define SHADOWS 1\n#define SHADOW_CASCADES " +
+		                                std::to_string(ShadowCascades::kCascades) + "\n"
+		                              : "#define SHADOWS 0\n";
+		if (!clustered) {
+			return defines + "#define CLUSTERED_LIGHTS 0\n";
+		}
+		return defines + "#define CLUSTERED_LIGHTS 1\n#define CLUSTER_TILES_X " + std::to_string(LightClusters::kTilesX) +
+		       "\n#define CLUSTER_TILES_Y " + std::to_string(LightClusters::kTilesY) + "\n#define CLUSTER_SLICES " +
+		       std::to_string(LightClusters::kSlices) + "\n";
+	}
+
+	// Solo profundidad, para el pre-paso y las sombras, con el shader de vrtices de siempre
+	const char* kDepthFragmentShader = R"(#version 330
+void main() {
+}
+)";
+
+	/**
+	 * @brief Modo de piel de `command` para el shader: 0 rgida, 1 paleta, 2 horneada.
+	 */
+	int
+	skinningOf(const MeshCommand& command) {
+		return command.baked ? 2 : command.boneCount != 0 ? 1 : 0;
+	}
+
+	/**
+	 * @brief Resumen de un comando esttico para la cach de sombras: malla, versin y matriz.
+	 */
+	uint64_t
+	staticKeyOf(const MeshCommand& command) {
+		uint64_t hash = 0xCBF29CE484222325ull;
+		auto mix = [&hash](const void* data, size_t bytes) {
+			const unsigned char* at = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < bytes; ++i) {
+				hash = (hash ^ at[i]) * 0x100000001B3ull;
+			}
+		};
+		uintptr_t mesh = reinterpret_cast<uintptr_t>(command.mesh);
+		uint32_t version = command.mesh->version();
+		mix(&mesh, sizeof(mesh));
+		mix(&version, sizeof(version));
+		mix(command.model.data(), 16 * sizeof(float));
+		return hash;
+	}
+
+	constexpr uint64_t kTransparentBit = uint64_t(1) << 63;
+	constexpr uint64_t kIndexMask = (uint64_t(1) << 31) - 1;
+
+	/**
+	 * @brief Bits de `value` que se ordenan como el float: los negativos, invertidos.
+	 */
+	uint32_t
+	orderedBits(float value) {
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	}
+
+} // namespace
+
+bool
+MeshPipeline::loadProgram(ProgramVariant& variant, const char* vertexSource, const char* fragmentSource,
+	const std::string& defines, int32_t bonesUnit) {
+	variant = ProgramVariant{};
+	GLuint program = EngineUtilities::TService<ShaderCache>::instance().program(vertexSource, fragmentSource, defines);
+	if (!program) {
+		return false;
+	}
+	variant.program = program;
+	// El pase de sombras puede no usar el bloque de la cmara
+	GLuint cameraBlock = gl.getUniformBlockIndex(program, "CameraBlock");
+	if (cameraBlock != 0xFFFFFFFFu) {
+		gl.uniformBlockBinding(program, cameraBlock, kCameraBinding);
+	}
+	variant.model = gl.getUniformLocation(program, "u_model");
+	variant.color = gl.getUniformLocation(program, "u_color");
+	variant.drawIndex = gl.getUniformLocation(program, "u_drawIndex");
+	variant.clusterParams = gl.getUniformLocation(program, "u_clusterParams");
+	variant.viewport = gl.getUniformLocation(program, "u_viewport");
+	variant.sunDirection = gl.getUniformLocation(program, "u_sunDirection");
+	variant.sunColor = gl.getUniformLocation(program, "u_sunColor");
+	variant.shadowMatrices = gl.getUniformLocation(program, "u_shadowMatrices");
+	variant.shadowSplits = gl.getUniformLocation(program, "u_shadowSplits");
+	variant.lightViewProjection = gl.getUniformLocation(program, "u_lightViewProjection");
+	// Las unidades no cambian: se fijan una vez; las que el programa no usa dan -1 y no hacen nada
+	gl.useProgram(program);
+	gl.uniform1i(gl.getUniformLocation(program, "u_bones"), bonesUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_instances"), kInstancesUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_lightData"), kLightDataUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_lightClusters"), kLightClustersUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_lightIndices"), kLightIndicesUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_shadowMap"), kShadowUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_draws"), kDrawsUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_materials"), kMaterialsUnit);
+	gl.uniform1i(gl.getUniformLocation(program, "u_materialTexture"), kMaterialTextureUnit);
+	gl.useProgram(0);
+	return true;
+}
+
+void
+MeshPipeline::initializeSkinning(const std::string& drawDefines, const std::string& colorDefines) {
+	for (int mode = 1; mode <= 2; ++mode) {
+		std::string defines = drawDefines + "#define SKINNING " + std::to_string(mode) + "\n";
+		GLint bonesUnit = mode == 1 ? kBonesUnit : kBakedBonesUnit;
+		if (!loadProgram(m_colorPrograms[mode], kVertexShader, kFragmentShader, defines + colorDefines, bonesUnit) ||
+			!loadProgram(m_depthPrograms[mode], kVertexShader, kDepthFragmentShader, defines, bonesUnit)) {
+			for (int i = 1; i <= 2; ++i) {
+				m_colorPrograms[i] = ProgramVariant{};
+				m_depthPrograms[i] = ProgramVariant{};
+			}
+			return;
+		}
+	}
+
+	// Paleta del frame, instancias y animaciones horneadas: tres bferes de textura de vec4
+	GLuint buffers[3];
+	GLuint textures[3];
+	gl.genBuffers(3, buffers);
+	glGenTextures(3, textures);
+	for (int i = 0; i < 3; ++i) {
+		gl.bindBuffer(kGlTextureBuffer, buffers[i]);
+		gl.bufferData(kGlTextureBuffer, 16, nullptr, kGlStreamDraw);
+		glBindTexture(kGlTextureBuffer, textures[i]);
+		gl.texBuffer(kGlTextureBuffer, kGlRgba32f, buffers[i]);
+	}
+	glBindTexture(kGlTextureBuffer, 0);
+	gl.bindBuffer(kGlTextureBuffer, 0);
+	m_boneBuffer = buffers[0];
+	m_boneTexture = textures[0];
+	m_instanceBuffer = buffers[1];
+	m_instanceTexture = textures[1];
+	m_bakedBuffer = buffers[2];
+	m_bakedTexture = textures[2];
+}
+
+void
+MeshPipeline::initializeShadows(const std::string& drawDefines) {
+	// Un programa de profundidad por modo de piel, proyectado con la luz
+	int modes = hasSkinning() ? 3 : 1;
+	for (int mode = 0; mode < modes; ++mode) {
+		std::string defines = drawDefines + "#define SHADOW_PASS 1\n#define SKINNING " + std::to_string(mode) + "\n";
+		GLint bonesUnit = mode == 1 ? kBonesUnit : kBakedBonesUnit;
+		if (!loadProgram(m_shadowPrograms[mode], kVertexShader, kDepthFragmentShader, defines, bonesUnit)) {
+			if (mode == 0) {
+				return;
+			}
+			// Sin piel en las sombras: esas mallas proyectan la de reposo
+			m_shadowPrograms[1] = m_shadowPrograms[2] = ProgramVariant{};
+			break;
+		}
+	}
+
+	// Lo esttico guardado y la copia del frame con lo que se mueve encima: dos texturas de
+	// profundidad con comparacin, cada una con su framebuffer
+	GLint previousFramebuffer = 0;
+	GLint previousTexture = 0;
+	glGetIntegerv(kGlFramebufferBinding, &previousFramebuffer);
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+	GLuint textures[2];
+	GLuint framebuffers[2];
+	glGenTextures(2, textures);
+	gl.genFramebuffers(2, framebuffers);
+	bool complete = true;
+	for (int i = 0; i < 2; ++i) {
+		glBindTexture(GL_TEXTURE_2D, textures[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, kGlDepthComponent24, ShadowCascades::kAtlasSize, ShadowCascades::kAtlasSize, 0,
+			GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, kGlClampToEdge);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, kGlClampToEdge);
+		glTexParameteri(GL_TEXTURE_2D, kGlTextureCompareMode, kGlCompareRefToTexture);
+		glTexParameteri(GL_TEXTURE_2D, kGlTextureCompareFunc, GL_LEQUAL);
+		gl.bindFramebuffer(kGlFramebuffer, framebuffers[i]);
+		gl.framebufferTexture2D(kGlFramebuffer, kGlDepthAttachment, GL_TEXTURE_2D, textures[i], 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		complete &= gl.checkFramebufferStatus(kGlFramebuffer) == kGlFramebufferComplete;
+	}
+	gl.bindFramebuffer(kGlFramebuffer, static_cast<GLuint>(previousFramebuffer));
+	glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previousTexture));
+	if (!complete) {
+		gl.deleteFramebuffers(2, framebuffers);
+		glDeleteTextures(2, textures);
+		for (ProgramVariant& variant : m_shadowPrograms) {
+			variant = ProgramVariant{};
+		}
+		return;
+	}
+	for (int i = 0; i < 2; ++i) {
+		m_shadowTextures[i] = textures[i];
+		m_shadowFramebuffers[i] = framebuffers[i];
+	}
+	m_cascades.invalidate();
+}
+
+void
+MeshPipeline::initializeDraws() {
+	// Comandos del frame y materiales residentes: dos bferes de textura de vec4
+	GLuint buffers[2];
+	GLuint textures[2];
+	gl.genBuffers(2, buffers);
+	glGenTextures(2, textures);
+	for (int i = 0; i < 2; ++i) {
+		gl.bindBuffer(kGlTextureBuffer, buffers[i]);
+		gl.bufferData(kGlTextureBuffer, 16, nullptr, kGlStreamDraw);
+		glBindTexture(kGlTextureBuffer, textures[i]);
+		gl.texBuffer(kGlTextureBuffer, kGlRgba32f, buffers[i]);
+	}
+	glBindTexture(kGlTextureBuffer, 0);
+	gl.bindBuffer(kGlTextureBuffer, 0);
+	m_drawBuffer = buffers[0];
+	m_drawTexture = textures[0];
+	m_materialBuffer = buffers[1];
+	m_materialTexture = textures[1];
+	m_bindless = hasGlBindlessTextures();
+	m_materialsDirty = true;
+}
+
+bool
+MeshPipeline::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions()) {
+		return false;
+	}
+	bool clustered = hasGlTextureBuffers();
+	bool shadows = hasGlFramebuffers();
+	std::string draws = drawDefines(clustered);
+	std::string colorDefines = draws + fragmentDefines(clustered, shadows);
+	if (!loadProgram(m_colorPrograms[0], kVertexShader, kFragmentShader, colorDefines, kBonesUnit)) {
+		return false;
+	}
+	if (clustered) {
+		GLuint buffers[3];
+		GLuint textures[3];
+		gl.genBuffers(3, buffers);
+		glGenTextures(3, textures);
+		const GLenum formats[3] = { kGlRgba32f, kGlRg32ui, kGlR32ui };
+		for (int i = 0; i < 3; ++i) {
+			m_lightBuffers[i] = buffers[i];
+			m_lightTextures[i] = textures[i];
+			gl.bindBuffer(kGlTextureBuffer, buffers[i]);
+			gl.bufferData(kGlTextureBuffer, 16, nullptr, kGlStreamDraw);
+			glBindTexture(kGlTextureBuffer, textures[i]);
+			gl.texBuffer(kGlTextureBuffer, formats[i], buffers[i]);
+		}
+		glBindTexture(kGlTextureBuffer, 0);
+		gl.bindBuffer(kGlTextureBuffer, 0);
+		initializeDraws();
+	}
+
+	// Sin l, el pre-paso queda apagado
+	loadProgram(m_depthPrograms[0], kVertexShader, kDepthFragmentShader, draws, kBonesUnit);
+
+	// Piel: sin bferes de textura, o si no compila, las mallas con piel se ven en reposo
+	if (clustered) {
+		initializeSkinning(draws, colorDefines);
+	}
+	// Sombras: sin framebuffers, o si no se pueden crear, todo queda iluminado
+	if (shadows) {
+		initializeShadows(draws);
+	}
+
+	GLuint vertexArray = 0;
+	GLuint cameraBuffer = 0;
+	gl.genVertexArrays(1, &vertexArray);
+	gl.genBuffers(1, &cameraBuffer);
+	m_vertexArray = vertexArray;
+	m_cameraBuffer = cameraBuffer;
+	gl.bindBuffer(kGlUniformBuffer, cameraBuffer);
+	gl.bufferData(kGlUniformBuffer, sizeof(CameraUniforms), nullptr, kGlStreamDraw);
+	gl.bindBuffer(kGlUniformBuffer, 0);
+	m_cameraUploaded = false;
+	grow(kInitialVertices, kInitialIndices);
+	return true;
+}
+
+void
+MeshPipeline::release() {
+	if (!isInitialized()) {
+		return;
+	}
+	detachAll();
+	GLuint buffers[3] = { m_vertexBuffer, m_indexBuffer, m_cameraBuffer };
+	GLuint vertexArray = m_vertexArray;
+	gl.deleteBuffers(3, buffers);
+	gl.deleteVertexArrays(1, &vertexArray);
+	if (m_lightBuffers[0]) {
+		GLuint lightBuffers[3] = { m_lightBuffers[0], m_lightBuffers[1], m_lightBuffers[2] };
+		GLuint lightTextures[3] = { m_lightTextures[0], m_lightTextures[1], m_lightTextures[2] };
+		gl.deleteBuffers(3, lightBuffers);
+		glDeleteTextures(3, lightTextures);
+		for (int i = 0; i < 3; ++i) {
+			m_lightBuffers[i] = 0;
+			m_lightTextures[i] = 0;
+		}
+	}
+	if (m_boneBuffer) {
+		GLuint skinBuffers[3] = { m_boneBuffer, m_instanceBuffer, m_bakedBuffer };
+		GLuint skinTextures[3] = { m_boneTexture, m_instanceTexture, m_bakedTexture };
+		gl.deleteBuffers(3, skinBuffers);
+		glDeleteTextures(3, skinTextures);
+		m_boneBuffer = m_instanceBuffer = m_bakedBuffer = 0;
+		m_boneTexture = m_instanceTexture = m_bakedTexture = 0;
+	}
+	if (m_skinBuffer) {
+		GLuint skinBuffer = m_skinBuffer;
+		gl.deleteBuffers(1, &skinBuffer);
+		m_skinBuffer = 0;
+	}
+	if (m_drawBuffer) {
+		GLuint drawBuffers[3] = { m_drawBuffer, m_materialBuffer, m_drawIndexBuffer };
+		GLuint drawTextures[2] = { m_drawTexture, m_materialTexture };
+		gl.deleteBuffers(m_drawIndexBuffer ? 3 : 2, drawBuffers);
+		glDeleteTextures(2, drawTextures);
+		m_drawBuffer = m_materialBuffer = m_drawIndexBuffer = 0;
+		m_drawTexture = m_materialTexture = 0;
+		m_drawIndexCapacity = 0;
+		// Los handles sin enlace mueren con su textura
+		m_residentHandles.clear();
+	}
+	if (m_shadowFramebuffers[0]) {
+		GLuint framebuffers[2] = { m_shadowFramebuffers[0], m_shadowFramebuffers[1] };
+		GLuint textures[2] = { m_shadowTextures[0], m_shadowTextures[1] };
+		gl.deleteFramebuffers(2, framebuffers);
+		glDeleteTextures(2, textures);
+		for (int i = 0; i < 2; ++i) {
+			m_shadowFramebuffers[i] = 0;
+			m_shadowTextures[i] = 0;
+		}
+	}
+	// Los programas son de `ShaderCache`, que los borra en `release`
+	for (int i = 0; i < 3; ++i) {
+		m_colorPrograms[i] = ProgramVariant{};
+		m_depthPrograms[i] = ProgramVariant{};
+		m_shadowPrograms[i] = ProgramVariant{};
+	}
+	m_vertexArray = 0;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_cameraBuffer = 0;
+	m_vertexCapacity = 0;
+	m_indexCapacity = 0;
+}
+
+void
+MeshPipeline::submit(sf::RenderTarget& target, const RenderCommandBuffer& commands) {
+	m_drawCalls = 0;
+	m_culledMeshes = 0;
+	m_uploadedBytes = 0;
+	std::span<const MeshCommand> meshes = commands.meshCommands();
+	if (meshes.empty()) {
+		return;
+	}
+
+	m_uploads.clear();
+	for (const MeshCommand& command : meshes) {
+		makeResident(*command.mesh);
+		if (command.baked && hasSkinning()) {
+			makeResident(*command.baked);
+		}
+		if (command.material && m_drawBuffer) {
+			makeResident(*command.material);
+		}
+	}
+
+	// SFML guarda y restaura su estado alrededor del OpenGL propio
+	target.pushGLStates();
+	gl.bindVertexArray(m_vertexArray);
+
+	// Lo nuevo del frame, cada malla en su tramo; el bfer de ndices es parte del VAO
+	gl.bindBuffer(kGlArrayBuffer, m_vertexBuffer);
+	for (const Mesh* mesh : m_uploads) {
+		size_t vertexBytes = mesh->m_vertices.size() * sizeof(MeshVertex);
+		size_t indexBytes = mesh->m_indices.size() * sizeof(uint32_t);
+		gl.bufferSubData(kGlArrayBuffer, static_cast<std::ptrdiff_t>(mesh->m_baseVertex * sizeof(MeshVertex)),
+			static_cast<std::ptrdiff_t>(vertexBytes), mesh->m_vertices.data());
+		gl.bufferSubData(kGlElementArrayBuffer, static_cast<std::ptrdiff_t>(mesh->m_firstIndex * sizeof(uint32_t)),
+			static_cast<std::ptrdiff_t>(indexBytes), mesh->m_indices.data());
+		m_uploadedBytes += vertexBytes + indexBytes;
+	}
+	// La piel va a la par de los vrtices, en su propio bfer
+	if (m_skinBuffer) {
+		gl.bindBuffer(kGlArrayBuffer, m_skinBuffer);
+		for (const Mesh* mesh : m_uploads) {
+			if (mesh->isSkinned()) {
+				size_t skinBytes = mesh->m_skin.size() * sizeof(MeshSkin);
+				gl.bufferSubData(kGlArrayBuffer, static_cast<std::ptrdiff_t>(mesh->m_baseVertex * sizeof(MeshSkin)),
+					static_cast<std::ptrdiff_t>(skinBytes), mesh->m_skin.data());
+				m_uploadedBytes += skinBytes;
+			}
+		}
+	}
+	m_uploads.clear();
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	stats.countUpload(m_uploadedBytes);
+
+	size_t cameraBytes = m_uploadedBytes;
+	uploadCamera(target, commands);
+	stats.countUpload(m_uploadedBytes - cameraBytes);
+	size_t opaqueCount = sortCommands(meshes);
+	if (m_occlusionCulling) {
+		opaqueCount = cullOccluded(meshes, opaqueCount);
+	}
+	uploadLights(target, commands);
+	uploadSkinning(commands);
+	uploadDraws(meshes);
+	m_boundMaterialTexture = 0;
+	GLuint shadowMap = renderShadows(meshes, commands);
+	uploadSun(commands, shadowMap != 0);
+	if (shadowMap) {
+		gl.activeTexture(kGlTexture0 + kShadowUnit);
+		glBindTexture(GL_TEXTURE_2D, shadowMap);
+		gl.activeTexture(kGlTexture0);
+	}
+
+	auto drawRange = [&](size_t begin, size_t end, const ProgramVariant* programs, bool withColor,
+		const sf::BlendMode& blend) {
+		GLuint current = 0;
+		for (size_t i = begin; i < end; ++i) {
+			uint32_t index = static_cast<uint32_t>(m_order[i] & kIndexMask);
+			drawCommand(meshes[index], index, programs, withColor, blend, current);
+		}
+	};
+
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glDisable(GL_BLEND);
+
+	// Pre-paso: solo profundidad, as el paso de color sombrea cada pxel opaco una vez
+	bool prePass = m_depthPrePass && m_depthPrograms[0].program && opaqueCount > 0;
+	if (prePass) {
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		glDepthFunc(GL_LESS);
+		drawRange(0, opaqueCount, m_depthPrograms, false, sf::BlendNone);
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glDepthMask(GL_FALSE);
+		glDepthFunc(GL_LEQUAL);
+	}
+	else {
+		glDepthFunc(GL_LESS);
+	}
+
+	// Opacas de adelante hacia atrs: lo tapado falla el test antes de sombrearse
+	drawRange(0, opaqueCount, m_colorPrograms, true, sf::BlendNone);
+
+	// Transparentes de atrs hacia adelante, mezcladas y sin escribir profundidad
+	if (opaqueCount < m_order.size()) {
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDepthMask(GL_FALSE);
+		glDepthFunc(GL_LESS);
+		drawRange(opaqueCount, m_order.size(), m_colorPrograms, true, sf::BlendAlpha);
+	}
+
+	glDepthMask(GL_TRUE);
+	glDisable(GL_DEPTH_TEST);
+	if (m_lightBuffers[0]) {
+		for (GLint unit : { kLightDataUnit, kLightClustersUnit, kLightIndicesUnit, kBonesUnit, kBakedBonesUnit, kInstancesUnit,
+			     kMaterialsUnit, kDrawsUnit }) {
+			gl.activeTexture(kGlTexture0 + unit);
+			glBindTexture(kGlTextureBuffer, 0);
+		}
+		gl.activeTexture(kGlTexture0);
+	}
+	if (m_boundMaterialTexture) {
+		gl.activeTexture(kGlTexture0 + kMaterialTextureUnit);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		gl.activeTexture(kGlTexture0);
+	}
+	if (shadowMap) {
+		gl.activeTexture(kGlTexture0 + kShadowUnit);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		gl.activeTexture(kGlTexture0);
+	}
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+	gl.useProgram(0);
+	target.popGLStates();
+}
+
+void
+MeshPipeline::drawCommand(const MeshCommand& command, uint32_t index, const ProgramVariant* programs, bool withColor,
+	const sf::BlendMode& blend, uint32_t& currentProgram) {
+	const Mesh& mesh = *command.mesh;
+	if (mesh.m_indices.empty()) {
+		return;
+	}
+	// Cada comando con el programa de su piel; sin piel en el driver, con el rgido y en reposo
+	int skinning = hasSkinning() && mesh.isSkinned() ? skinningOf(command) : 0;
+	if (!programs[skinning].program) {
+		skinning = 0;
+	}
+	const ProgramVariant& variant = programs[skinning];
+	if (variant.program != currentProgram) {
+		gl.useProgram(variant.program);
+		currentProgram = variant.program;
+	}
+	bool baseInstance = m_drawBuffer && hasGlBaseInstance();
+	if (m_drawBuffer) {
+		// Todo lo del comando ya est en `u_draws`: a lo sumo su ndice y la textura del material
+		if (!baseInstance) {
+			gl.uniform1i(variant.drawIndex, static_cast<GLint>(index));
+		}
+		const sf::Texture* texture = command.material ? command.material->m_texture : nullptr;
+		if (withColor && !m_bindless && texture && texture->getNativeHandle() != m_boundMaterialTexture) {
+			m_boundMaterialTexture = texture->getNativeHandle();
+			gl.activeTexture(kGlTexture0 + kMaterialTextureUnit);
+			glBindTexture(GL_TEXTURE_2D, m_boundMaterialTexture);
+			gl.activeTexture(kGlTexture0);
+		}
+	}
+	else {
+		gl.uniformMatrix4fv(variant.model, 1, GL_FALSE, command.model.data());
+		if (withColor) {
+			sf::Color color = command.material ? command.color * command.material->m_color : command.color;
+			const float values[4] = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+			gl.uniform4fv(variant.color, 1, values);
+		}
+	}
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	const void* firstIndex = reinterpret_cast<const void*>(static_cast<size_t>(mesh.m_firstIndex) * sizeof(uint32_t));
+	// Una multitud horneada es un solo draw; sin piel en el driver, solo la primera instancia
+	GLsizei instances = skinning == 2 ? static_cast<GLsizei>(command.instanceCount) : 1;
+	GLsizei count = static_cast<GLsizei>(mesh.m_indices.size());
+	if (baseInstance) {
+		gl.drawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, count, GL_UNSIGNED_INT, firstIndex, instances,
+			static_cast<GLint>(mesh.m_baseVertex), index);
+	}
+	else if (skinning == 2) {
+		gl.drawElementsInstancedBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, firstIndex, instances,
+			static_cast<GLint>(mesh.m_baseVertex));
+	}
+	else {
+		gl.drawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, firstIndex, static_cast<GLint>(mesh.m_baseVertex));
+	}
+	stats.countDraw(mesh.m_indices.size() * static_cast<size_t>(instances), nullptr, nullptr, blend, variant.program);
+	++m_drawCalls;
+}
+
+GLuint
+MeshPipeline::renderShadows(std::span<const MeshCommand> meshes, const RenderCommandBuffer& commands) {
+	m_shadowDrawCalls = 0;
+	m_shadowRebuilds = 0;
+	if (!m_shadows || !m_shadowFramebuffers[0]) {
+		return 0;
+	}
+
+	// Resumen del conjunto esttico: una suma, as el orden en que se recorri la escena no lo
+	// cambia. Las transparentes no dan sombra
+	uint64_t staticKey = 0;
+	bool moving = false;
+	for (const MeshCommand& command : meshes) {
+		if (!command.isOpaque()) {
+			continue;
+		}
+		if (command.isStatic && !command.isSkinned()) {
+			staticKey += staticKeyOf(command);
+		}
+		else {
+			moving = true;
+		}
+	}
+	const float* direction = commands.sunLight().direction;
+	uint32_t rebuilt = m_cascades.update(m_camera, sf::Vector3f(direction[0], direction[1], direction[2]), staticKey);
+	if (!rebuilt && !moving) {
+		return m_shadowTextures[0];
+	}
+
+	GLint previousFramebuffer = 0;
+	GLint previousViewport[4];
+	GLint previousScissor[4];
+	GLboolean scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+	glGetIntegerv(kGlFramebufferBinding, &previousFramebuffer);
+	glGetIntegerv(GL_VIEWPORT, previousViewport);
+	glGetIntegerv(GL_SCISSOR_BOX, previousScissor);
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+	glDepthFunc(GL_LESS);
+	glDisable(GL_BLEND);
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	// Los oclusores entre la luz y la caja se aplastan contra su plano cercano en vez de perderse
+	glEnable(kGlDepthClamp);
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	glPolygonOffset(2.0f, 4.0f);
+	glEnable(GL_SCISSOR_TEST);
+
+	size_t drawCalls = m_drawCalls;
+	auto drawCasters = [&](uint32_t cascade, bool staticPass) {
+		GLint x = static_cast<GLint>(ShadowCascades::atlasX(cascade));
+		GLint y = static_cast<GLint>(ShadowCascades::atlasY(cascade));
+		GLsizei size = static_cast<GLsizei>(ShadowCascades::kResolution);
+		glViewport(x, y, size, size);
+		glScissor(x, y, size, size);
+		if (staticPass) {
+			glClear(GL_DEPTH_BUFFER_BIT);
+		}
+		const Mat4& viewProjection = m_cascades.viewProjection(cascade);
+		GLuint current = 0;
+		for (uint32_t index = 0; index < meshes.size(); ++index) {
+			const MeshCommand& command = meshes[index];
+			if (!command.isOpaque() || (command.isStatic && !command.isSkinned()) != staticPass ||
+				!m_cascades.overlaps(cascade, command.mesh->boundsMin(), command.mesh->boundsMax(), command.model)) {
+				continue;
+			}
+			// La matriz de la cascada va a cada programa la primera vez que se usa en ella
+			int skinning = hasSkinning() && command.mesh->isSkinned() ? skinningOf(command) : 0;
+			const ProgramVariant& variant = m_shadowPrograms[m_shadowPrograms[skinning].program ? skinning : 0];
+			if (variant.program != current) {
+				gl.useProgram(variant.program);
+				gl.uniformMatrix4fv(variant.lightViewProjection, 1, GL_FALSE, viewProjection.data());
+				current = variant.program;
+			}
+			drawCommand(command, index, m_shadowPrograms, false, sf::BlendNone, current);
+		}
+	};
+
+	// Lo esttico, solo en las cascadas cuya caja cambi
+	if (rebuilt) {
+		gl.bindFramebuffer(kGlFramebuffer, m_shadowFramebuffers[0]);
+		for (uint32_t cascade = 0; cascade < ShadowCascades::kCascades; ++cascade) {
+			if ((rebuilt >> cascade) & 1u) {
+				drawCasters(cascade, true);
+				++m_shadowRebuilds;
+			}
+		}
+	}
+
+	// Lo que se mueve, sobre una copia de lo guardado
+	GLuint shadowMap = m_shadowTextures[0];
+	if (moving) {
+		GLint size = static_cast<GLint>(ShadowCascades::kAtlasSize);
+		glDisable(GL_SCISSOR_TEST);
+		gl.bindFramebuffer(kGlReadFramebuffer, m_shadowFramebuffers[0]);
+		gl.bindFramebuffer(kGlDrawFramebuffer, m_shadowFramebuffers[1]);
+		gl.blitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+		gl.bindFramebuffer(kGlFramebuffer, m_shadowFramebuffers[1]);
+		glEnable(GL_SCISSOR_TEST);
+		for (uint32_t cascade = 0; cascade < ShadowCascades::kCascades; ++cascade) {
+			drawCasters(cascade, false);
+		}
+		shadowMap = m_shadowTextures[1];
+	}
+
+	// `drawCommand` las cont como del paso de color
+	m_shadowDrawCalls = m_drawCalls - drawCalls;
+	m_drawCalls = drawCalls;
+	glScissor(previousScissor[0], previousScissor[1], previousScissor[2], previousScissor[3]);
+	if (!scissorTest) {
+		glDisable(GL_SCISSOR_TEST);
+	}
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glDisable(kGlDepthClamp);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	gl.bindFramebuffer(kGlFramebuffer, static_cast<GLuint>(previousFramebuffer));
+	glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+	return shadowMap;
+}
+
+void
+MeshPipeline::uploadSun(const RenderCommandBuffer& commands, bool shadowed) {
+	const DirectionalLightData& sun = commands.sunLight();
+	float matrices[ShadowCascades::kCascades * 16];
+	float splits[4] = { -1e30f, -1e30f, -1e30f, -1e30f };
+	if (shadowed) {
+		for (uint32_t cascade = 0; cascade < ShadowCascades::kCascades; ++cascade) {
+			std::memcpy(matrices + cascade * 16, m_cascades.shadowMatrix(cascade).data(), 16 * sizeof(float));
+			splits[cascade] = m_cascades.splitDistance(cascade);
+		}
+	}
+	for (const ProgramVariant& variant : m_colorPrograms) {
+		if (!variant.program) {
+			continue;
+		}
+		gl.useProgram(variant.program);
+		gl.uniform4fv(variant.sunDirection, 1, sun.direction);
+		gl.uniform4fv(variant.sunColor, 1, sun.color);
+		gl.uniform4fv(variant.shadowSplits, 1, splits);
+		if (shadowed) {
+			gl.uniformMatrix4fv(variant.shadowMatrices, ShadowCascades::kCascades, GL_FALSE, matrices);
+		}
+	}
+}
+
+size_t
+MeshPipeline::sortCommands(std::span<const MeshCommand> meshes) {
+	// Fila z de la vista-proyeccin: crece con la distancia a la cmara, en perspectiva y en
+	// ortogrfica, sin dividir por w
+	const float* viewProjection = m_camera.viewProjection.data();
+	m_order.resize(meshes.size());
+	size_t opaqueCount = 0;
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		const MeshCommand& command = meshes[i];
+		const float* model = command.model.data();
+		const sf::Vector3f& center = command.mesh->center();
+		float world[3];
+		for (int row = 0; row < 3; ++row) {
+			world[row] = model[row] * center.x + model[4 + row] * center.y + model[8 + row] * center.z + model[12 + row];
+		}
+		float depth = viewProjection[2] * world[0] + viewProjection[6] * world[1] + viewProjection[10] * world[2] +
+		              viewProjection[14];
+		uint64_t depthBits = orderedBits(depth);
+		bool opaque = command.isOpaque();
+		opaqueCount += opaque;
+		m_order[i] = opaque ? (depthBits << 31) | i : kTransparentBit | (uint64_t(~depthBits & 0xFFFFFFFFu) << 31) | i;
+	}
+	std::sort(m_order.begin(), m_order.end());
+	return opaqueCount;
+}
+
+size_t
+MeshPipeline::cullOccluded(std::span<const MeshCommand> meshes, size_t opaqueCount) {
+	// Los oclusores, de las opacas de adelante hacia atrs: las primeras que valgan tapan ms
+	m_occlusion.begin(m_camera.viewProjection);
+	for (size_t i = 0; i < opaqueCount; ++i) {
+		const MeshCommand& command = meshes[m_order[i] & kIndexMask];
+		// Una malla con piel se mueve fuera de su caja de reposo: no tapa a nadie
+		if (command.isSkinned()) {
+			continue;
+		}
+		m_occlusion.addOccluder(*command.mesh, command.model);
+		if (m_occlusion.occluderTriangles() >= OcclusionCuller::kMaxOccluderTriangles) {
+			break;
+		}
+	}
+	m_occlusion.finish();
+
+	// Se quitan de `m_order` sin cambiar el orden de las que quedan
+	size_t kept = 0;
+	size_t keptOpaque = 0;
+	for (size_t i = 0; i < m_order.size(); ++i) {
+		const MeshCommand& command = meshes[m_order[i] & kIndexMask];
+		if (!command.isSkinned() && !m_occlusion.isVisible(command.mesh->boundsMin(), command.mesh->boundsMax(), command.model)) {
+			continue;
+		}
+		keptOpaque += i < opaqueCount;
+		m_order[kept++] = m_order[i];
+	}
+	m_culledMeshes = m_order.size() - kept;
+	m_order.resize(kept);
+	return keptOpaque;
+}
+
+void
+MeshPipeline::uploadLights(const sf::RenderTarget& target, const RenderCommandBuffer& commands) {
+	if (!m_lightBuffers[0]) {
+		return;
+	}
+	std::span<const PointLightData> lights = commands.lights();
+	float params[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	if (!lights.empty()) {
+		m_clusters.build(m_camera, lights);
+		params[0] = m_clusters.sliceScale();
+		params[1] = m_clusters.sliceBias();
+		params[2] = m_clusters.isLogarithmic() ? 1.0f : 0.0f;
+		params[3] = m_clusters.lightIndices().empty() ? 0.0f : 1.0f;
+	}
+	if (params[3] > 0.0f) {
+		// Cada bfer se reemplaza entero: el driver no espera al frame anterior
+		const void* sources[3] = { lights.data(), m_clusters.clusters().data(), m_clusters.lightIndices().data() };
+		const size_t sizes[3] = { m_clusters.lightCount() * sizeof(PointLightData),
+			m_clusters.clusters().size() * sizeof(LightClusters::Range), m_clusters.lightIndices().size() * sizeof(uint32_t) };
+		RenderStatsCounter& stats = RenderStatsCounter::current();
+		for (int i = 0; i < 3; ++i) {
+			gl.bindBuffer(kGlTextureBuffer, m_lightBuffers[i]);
+			gl.bufferData(kGlTextureBuffer, static_cast<std::ptrdiff_t>(sizes[i]), sources[i], kGlStreamDraw);
+			stats.countUpload(sizes[i]);
+			m_uploadedBytes += sizes[i];
+		}
+		gl.bindBuffer(kGlTextureBuffer, 0);
+		const GLint units[3] = { kLightDataUnit, kLightClustersUnit, kLightIndicesUnit };
+		for (int i = 0; i < 3; ++i) {
+			gl.activeTexture(kGlTexture0 + units[i]);
+			glBindTexture(kGlTextureBuffer, m_lightTextures[i]);
+		}
+		gl.activeTexture(kGlTexture0);
+	}
+
+	// gl_FragCoord cuenta desde abajo; el viewport de SFML, desde arriba
+	sf::IntRect viewport = target.getViewport(target.getView());
+	float bottom = static_cast<float>(target.getSize().y) - static_cast<float>(viewport.top + viewport.height);
+	const float area[4] = { static_cast<float>(viewport.left), bottom, static_cast<float>(viewport.width),
+		static_cast<float>(viewport.height) };
+	for (const ProgramVariant& variant : m_colorPrograms) {
+		if (variant.program) {
+			gl.useProgram(variant.program);
+			gl.uniform4fv(variant.clusterParams, 1, params);
+			gl.uniform4fv(variant.viewport, 1, area);
+		}
+	}
+}
+
+void
+MeshPipeline::uploadSkinning(const RenderCommandBuffer& commands) {
+	if (!hasSkinning()) {
+		return;
+	}
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	// Todas las paletas del frame de una vez, y todas las instancias de una vez
+	auto replace = [&](GLuint buffer, const void* data, size_t bytes) {
+		if (bytes == 0) {
+			return;
+		}
+		gl.bindBuffer(kGlTextureBuffer, buffer);
+		gl.bufferData(kGlTextureBuffer, static_cast<std::ptrdiff_t>(bytes), data, kGlStreamDraw);
+		stats.countUpload(bytes);
+		m_uploadedBytes += bytes;
+	};
+	replace(m_boneBuffer, commands.bonePalette().data(), commands.bonePalette().size_bytes());
+	replace(m_instanceBuffer, commands.skinnedInstances().data(), commands.skinnedInstances().size_bytes());
+
+	// Las horneadas solo cuando cambi cules hay: se empaquetan todas de nuevo
+	if (m_bakedDirty) {
+		m_bakedDirty = false;
+		size_t total = 0;
+		for (const BakedAnimation* baked : m_bakedResident) {
+			baked->m_firstMatrix = static_cast<uint32_t>(total);
+			baked->m_uploadedVersion = baked->m_version;
+			total += baked->m_matrices.size();
+		}
+		gl.bindBuffer(kGlTextureBuffer, m_bakedBuffer);
+		gl.bufferData(kGlTextureBuffer, static_cast<std::ptrdiff_t>(std::max<size_t>(total * sizeof(Mat4), 16)), nullptr,
+			kGlStaticDraw);
+		for (const BakedAnimation* baked : m_bakedResident) {
+			gl.bufferSubData(kGlTextureBuffer, static_cast<std::ptrdiff_t>(size_t(baked->m_firstMatrix) * sizeof(Mat4)),
+				static_cast<std::ptrdiff_t>(baked->bytes()), baked->m_matrices.data());
+		}
+		stats.countUpload(total * sizeof(Mat4));
+		m_uploadedBytes += total * sizeof(Mat4);
+	}
+	gl.bindBuffer(kGlTextureBuffer, 0);
+
+	const GLint units[3] = { kBonesUnit, kBakedBonesUnit, kInstancesUnit };
+	const GLuint textures[3] = { m_boneTexture, m_bakedTexture, m_instanceTexture };
+	for (int i = 0; i < 3; ++i) {
+		gl.activeTexture(kGlTexture0 + units[i]);
+		glBindTexture(kGlTextureBuffer, textures[i]);
+	}
+	gl.activeTexture(kGlTexture0);
+}
+
+void
+MeshPipeline::makeResident(const BakedAnimation& animation) {
+	if (animation.m_pipeline == this && animation.m_uploadedVersion == animation.m_version) {
+		return;
+	}
+	if (animation.m_pipeline != this) {
+		animation.m_pipeline = this;
+		animation.m_residentIndex = static_cast<uint32_t>(m_bakedResident.size());
+		m_bakedResident.push_back(&animation);
+	}
+	m_bakedDirty = true;
+}
+
+void
+MeshPipeline::evict(const BakedAnimation& animation) {
+	if (animation.m_pipeline != this) {
+		return;
+	}
+	uint32_t index = animation.m_residentIndex;
+	m_bakedResident[index] = m_bakedResident.back();
+	m_bakedResident[index]->m_residentIndex = index;
+	m_bakedResident.pop_back();
+	animation.m_pipeline = nullptr;
+	m_bakedDirty = true;
+}
+
+void
+MeshPipeline::uploadDraws(std::span<const MeshCommand> meshes) {
+	if (!m_drawBuffer) {
+		return;
+	}
+	uploadMaterials();
+
+	// Siete vec4 por comando, en el orden de `meshes`: el ndice del comando es el del draw
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	m_drawData.resize(meshes.size() * kDrawTexels * 4);
+	uint32_t indexEnd = 0;
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		const MeshCommand& command = meshes[i];
+		float* out = m_drawData.data() + i * kDrawTexels * 4;
+		std::memcpy(out, command.model.data(), 16 * sizeof(float));
+		out[16] = command.color.r / 255.0f;
+		out[17] = command.color.g / 255.0f;
+		out[18] = command.color.b / 255.0f;
+		out[19] = command.color.a / 255.0f;
+		const Material* material = command.material;
+		out[20] = material && material->m_pipeline == this ? static_cast<float>(material->m_residentIndex + 1) : 0.0f;
+		out[21] = static_cast<float>(command.firstBone);
+		out[22] = static_cast<float>(command.firstInstance);
+		const BakedAnimation* baked = hasSkinning() ? command.baked : nullptr;
+		out[23] = baked ? baked->m_frameRate : 0.0f;
+		out[24] = baked ? static_cast<float>(baked->m_firstMatrix) : 0.0f;
+		out[25] = baked ? static_cast<float>(baked->m_boneCount) : 0.0f;
+		out[26] = baked ? static_cast<float>(baked->m_frameCount) : 0.0f;
+		out[27] = baked && baked->m_loop ? 1.0f : 0.0f;
+		indexEnd = std::max(indexEnd, static_cast<uint32_t>(i) + std::max(command.instanceCount, 1u));
+	}
+	size_t bytes = m_drawData.size() * sizeof(float);
+	gl.bindBuffer(kGlTextureBuffer, m_drawBuffer);
+	gl.bufferData(kGlTextureBuffer, static_cast<std::ptrdiff_t>(bytes), m_drawData.data(), kGlStreamDraw);
+	gl.bindBuffer(kGlTextureBuffer, 0);
+	stats.countUpload(bytes);
+	m_uploadedBytes += bytes;
+
+	// El atributo del ndice lee draw + instancia: tiene que llegar a la ltima instancia
+	if (hasGlBaseInstance() && indexEnd > m_drawIndexCapacity) {
+		uint32_t capacity = std::max(m_drawIndexCapacity, kInitialDrawIndices);
+		while (capacity < indexEnd) {
+			capacity *= 2;
+		}
+		std::vector<float> indices(capacity);
+		std::iota(indices.begin(), indices.end(), 0.0f);
+		if (!m_drawIndexBuffer) {
+			GLuint buffer = 0;
+			gl.genBuffers(1, &buffer);
+			m_drawIndexBuffer = buffer;
+		}
+		// Con el VAO de `submit` enlazado: el atributo queda en l
+		gl.bindBuffer(kGlArrayBuffer, m_drawIndexBuffer);
+		gl.bufferData(kGlArrayBuffer, static_cast<std::ptrdiff_t>(capacity * sizeof(float)), indices.data(), kGlStaticDraw);
+		gl.vertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(float), nullptr);
+		gl.vertexAttribDivisor(5, 1);
+		gl.enableVertexAttribArray(5);
+		gl.bindBuffer(kGlArrayBuffer, 0);
+		m_drawIndexCapacity = capacity;
+	}
+
+	const GLint units[2] = { kDrawsUnit, kMaterialsUnit };
+	const GLuint textures[2] = { m_drawTexture, m_materialTexture };
+	for (int i = 0; i < 2; ++i) {
+		gl.activeTexture(kGlTexture0 + units[i]);
+		glBindTexture(kGlTextureBuffer, textures[i]);
+	}
+	gl.activeTexture(kGlTexture0);
+}
+
+void
+MeshPipeline::uploadMaterials() {
+	if (!m_materialsDirty) {
+		return;
+	}
+	m_materialsDirty = false;
+
+	// El 0 es el de los comandos sin material: blanco, sin emisin ni textura
+	m_materialData.assign((m_materialResident.size() + 1) * kMaterialTexels * 4, 0.0f);
+	std::fill(m_materialData.begin(), m_materialData.begin() + 4, 1.0f);
+	for (size_t i = 0; i < m_materialResident.size(); ++i) {
+		const Material& material = *m_materialResident[i];
+		float* out = m_materialData.data() + (i + 1) * kMaterialTexels * 4;
+		const sf::Color colors[2] = { material.m_color, material.m_emissive };
+		for (int c = 0; c < 2; ++c) {
+			out[c * 4 + 0] = colors[c].r / 255.0f;
+			out[c * 4 + 1] = colors[c].g / 255.0f;
+			out[c * 4 + 2] = colors[c].b / 255.0f;
+			out[c * 4 + 3] = c == 0 ? colors[c].a / 255.0f : 0.0f;
+		}
+		out[8] = material.m_textureRect.left;
+		out[9] = material.m_textureRect.top;
+		out[10] = material.m_textureRect.width;
+		out[11] = material.m_textureRect.height;
+		GLuint name = material.m_texture ? material.m_texture->getNativeHandle() : 0;
+		if (name) {
+			// Sin enlace, el handle de 64 bits va en los bits de dos floats
+			if (m_bindless) {
+				uint64_t handle = gl.getTextureHandleARB(name);
+				if (m_residentHandles.insert(handle).second) {
+					gl.makeTextureHandleResidentARB(handle);
+				}
+				const uint32_t halves[2] = { static_cast<uint32_t>(handle), static_cast<uint32_t>(handle >> 32) };
+				std::memcpy(out + 12, halves, sizeof(halves));
+			}
+			out[14] = 1.0f;
+		}
+		material.m_uploadedVersion = material.m_version;
+		material.m_uploadedTexture = name;
+	}
+	size_t bytes = m_materialData.size() * sizeof(float);
+	gl.bindBuffer(kGlTextureBuffer, m_materialBuffer);
+	gl.bufferData(kGlTextureBuffer, static_cast<std::ptrdiff_t>(bytes), m_materialData.data(), kGlStaticDraw);
+	gl.bindBuffer(kGlTextureBuffer, 0);
+	RenderStatsCounter::current().countUpload(bytes);
+	m_uploadedBytes += bytes;
+}
+
+void
+MeshPipeline::makeResident(const Material& material) {
+	// `TextureLoader` cambia el nombre de GL de la textura al terminar de subirla
+	GLuint name = material.m_texture ? material.m_texture->getNativeHandle() : 0;
+	if (material.m_pipeline == this && material.m_uploadedVersion == material.m_version &&
+		material.m_uploadedTexture == name) {
+		return;
+	}
+	if (material.m_pipeline != this) {
+		material.m_pipeline = this;
+		material.m_residentIndex = static_cast<uint32_t>(m_materialResident.size());
+		m_materialResident.push_back(&material);
+	}
+	m_materialsDirty = true;
+}
+
+void
+MeshPipeline::evict(const Material& material) {
+	if (material.m_pipeline != this) {
+		return;
+	}
+	uint32_t index = material.m_residentIndex;
+	m_materialResident[index] = m_materialResident.back();
+	m_materialResident[index]->m_residentIndex = index;
+	m_materialResident.pop_back();
+	material.m_pipeline = nullptr;
+	m_materialsDirty = true;
+}
+
+void
+MeshPipeline::uploadCamera(const sf::RenderTarget& target, const RenderCommandBuffer& commands) {
+	CameraUniforms camera;
+	if (const CameraUniforms* recorded = commands.camera()) {
+		camera = *recorded;
+	}
+	else {
+		// La vista 2D en x e y; z de [-kDepthRange, kDepthRange] a [1, -1]: lo positivo, delante
+		camera.view = Mat4::fromTransform(target.getView().getTransform());
+		camera.projection = Mat4::scale(1.0f, 1.0f, -1.0f / kDepthRange);
+		camera.viewProjection = camera.projection * camera.view;
+		camera.position[0] = target.getView().getCenter().x;
+		camera.position[1] = target.getView().getCenter().y;
+		camera.position[2] = kDepthRange;
+	}
+
+	// Una subida por frame como mucho: ninguna si la cmara no se movi
+	if (!m_cameraUploaded || std::memcmp(&camera, &m_camera, sizeof(CameraUniforms)) != 0) {
+		m_camera = camera;
+		m_cameraUploaded = true;
+		gl.bindBuffer(kGlUniformBuffer, m_cameraBuffer);
+		gl.bufferSubData(kGlUniformBuffer, 0, sizeof(CameraUniforms), &m_camera);
+		gl.bindBuffer(kGlUniformBuffer, 0);
+		m_uploadedBytes += sizeof(CameraUniforms);
+	}
+	gl.bindBufferBase(kGlUniformBuffer, kCameraBinding, m_cameraBuffer);
+}
+
+void
+MeshPipeline::evict(const Mesh& mesh) {
+	if (mesh.m_pipeline != this) {
+		return;
+	}
+	uint32_t index = mesh.m_residentIndex;
+	m_resident[index] = m_resident.back();
+	m_resident[index]->m_residentIndex = index;
+	m_resident.pop_back();
+	m_freeVertices += mesh.m_vertexCapacity;
+	m_uploads.erase(std::remove(m_uploads.begin(), m_uploads.end(), &mesh), m_uploads.end());
+	mesh.m_pipeline = nullptr;
+	mesh.m_vertexCapacity = 0;
+	mesh.m_indexCapacity = 0;
+}
+
+void
+MeshPipeline::makeResident(const Mesh& mesh) {
+	if (mesh.m_pipeline == this && mesh.m_uploadedVersion == mesh.m_version) {
+		return;
+	}
+	uint32_t vertexCount = static_cast<uint32_t>(mesh.m_vertices.size());
+	uint32_t indexCount = static_cast<uint32_t>(mesh.m_indices.size());
+	mesh.m_uploadedVersion = mesh.m_version;
+
+	// Cambi pero cabe en su tramo: se sube encima
+	if (mesh.m_pipeline == this && vertexCount <= mesh.m_vertexCapacity && indexCount <= mesh.m_indexCapacity) {
+		m_uploads.push_back(&mesh);
+		return;
+	}
+	if (mesh.m_pipeline == this) {
+		m_freeVertices += mesh.m_vertexCapacity;
+	}
+	else {
+		mesh.m_pipeline = this;
+		mesh.m_residentIndex = static_cast<uint32_t>(m_resident.size());
+		m_resident.push_back(&mesh);
+	}
+	mesh.m_vertexCapacity = 0;
+	mesh.m_indexCapacity = 0;
+
+	bool fits = m_vertexEnd + vertexCount <= m_vertexCapacity && m_indexEnd + indexCount <= m_indexCapacity;
+	if (!fits && m_freeVertices > m_vertexEnd / 2) {
+		// Empaquetar le da tramo tambin a esta
+		compact();
+		return;
+	}
+	allocate(mesh);
+}
+
+void
+MeshPipeline::allocate(const Mesh& mesh) {
+	uint32_t vertexCount = static_cast<uint32_t>(mesh.m_vertices.size());
+	uint32_t indexCount = static_cast<uint32_t>(mesh.m_indices.size());
+	if (m_vertexEnd + vertexCount > m_vertexCapacity || m_indexEnd + indexCount > m_indexCapacity) {
+		grow(std::max(m_vertexCapacity * 2, m_vertexEnd + vertexCount), std::max(m_indexCapacity * 2, m_indexEnd + indexCount));
+	}
+	mesh.m_baseVertex = m_vertexEnd;
+	mesh.m_vertexCapacity = vertexCount;
+	mesh.m_firstIndex = m_indexEnd;
+	mesh.m_indexCapacity = indexCount;
+	m_vertexEnd += vertexCount;
+	m_indexEnd += indexCount;
+	m_uploads.push_back(&mesh);
+}
+
+void
+MeshPipeline::grow(uint32_t vertexCapacity, uint32_t indexCapacity) {
+	vertexCapacity = std::max(vertexCapacity, m_vertexCapacity);
+	indexCapacity = std::max(indexCapacity, m_indexCapacity);
+	GLuint buffers[2] = {};
+	gl.genBuffers(2, buffers);
+
+	// Lo ya subido pasa de bfer a bfer sin volver por la CPU
+	auto replace = [](GLuint from, GLuint to, size_t capacityBytes, size_t usedBytes) {
+		gl.bindBuffer(kGlCopyWriteBuffer, to);
+		gl.bufferData(kGlCopyWriteBuffer, static_cast<std::ptrdiff_t>(capacityBytes), nullptr, kGlStaticDraw);
+		if (from != 0 && usedBytes != 0) {
+			gl.bindBuffer(kGlCopyReadBuffer, from);
+			gl.copyBufferSubData(kGlCopyReadBuffer, kGlCopyWriteBuffer, 0, 0, static_cast<std::ptrdiff_t>(usedBytes));
+			gl.bindBuffer(kGlCopyReadBuffer, 0);
+		}
+		gl.bindBuffer(kGlCopyWriteBuffer, 0);
+		if (from != 0) {
+			gl.deleteBuffers(1, &from);
+		}
+	};
+	replace(m_vertexBuffer, buffers[0], vertexCapacity * sizeof(MeshVertex), m_vertexEnd * sizeof(MeshVertex));
+	replace(m_indexBuffer, buffers[1], indexCapacity * sizeof(uint32_t), m_indexEnd * sizeof(uint32_t));
+	m_vertexBuffer = buffers[0];
+	m_indexBuffer = buffers[1];
+	if (hasSkinning()) {
+		GLuint skinBuffer = 0;
+		gl.genBuffers(1, &skinBuffer);
+		replace(m_skinBuffer, skinBuffer, vertexCapacity * sizeof(MeshSkin), m_vertexEnd * sizeof(MeshSkin));
+		m_skinBuffer = skinBuffer;
+	}
+	m_vertexCapacity = vertexCapacity;
+	m_indexCapacity = indexCapacity;
+	bindAttributes();
+}
+
+void
+MeshPipeline::compact() {
+	m_vertexEnd = 0;
+	m_indexEnd = 0;
+	m_freeVertices = 0;
+	m_uploads.clear();
+	for (const Mesh* mesh : m_resident) {
+		allocate(*mesh);
+	}
+}
+
+void
+MeshPipeline::bindAttributes() {
+	gl.bindVertexArray(m_vertexArray);
+	gl.bindBuffer(kGlArrayBuffer, m_vertexBuffer);
+	gl.vertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+		reinterpret_cast<const void*>(offsetof(MeshVertex, position)));
+	gl.vertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+		reinterpret_cast<const void*>(offsetof(MeshVertex, normal)));
+	gl.vertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), reinterpret_cast<const void*>(offsetof(MeshVertex, uv)));
+	for (GLuint attribute = 0; attribute <= 2; ++attribute) {
+		gl.enableVertexAttribArray(attribute);
+	}
+	// Huesos como enteros en float, pesos normalizados de 0 a 1
+	if (m_skinBuffer) {
+		gl.bindBuffer(kGlArrayBuffer, m_skinBuffer);
+		gl.vertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(MeshSkin),
+			reinterpret_cast<const void*>(offsetof(MeshSkin, joints)));
+		gl.vertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MeshSkin),
+			reinterpret_cast<const void*>(offsetof(MeshSkin, weights)));
+		gl.enableVertexAttribArray(3);
+		gl.enableVertexAttribArray(4);
+	}
+	gl.bindBuffer(kGlElementArrayBuffer, m_indexBuffer);
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+}
+
+void
+MeshPipeline::detachAll() {
+	for (const Mesh* mesh : m_resident) {
+		mesh->m_pipeline = nullptr;
+		mesh->m_vertexCapacity = 0;
+		mesh->m_indexCapacity = 0;
+	}
+	m_resident.clear();
+	m_uploads.clear();
+	for (const BakedAnimation* baked : m_bakedResident) {
+		baked->m_pipeline = nullptr;
+	}
+	m_bakedResident.clear();
+	m_bakedDirty = false;
+	for (const Material* material : m_materialResident) {
+		material->m_pipeline = nullptr;
+	}
+	m_materialResident.clear();
+	m_materialsDirty = true;
+	m_vertexEnd = 0;
+	m_indexEnd = 0;
+	m_freeVertices = 0;
+}
@@ -0,0 +1,245 @@
+#include "Render/OcclusionCuller.h"
+#include <algorithm>
+#include <cmath>
+#include "Render/Mesh.h"
+
+namespace {
+	constexpr float kMinW = 1e-5f;
+	constexpr float kDepthBias = 1e-5f;      ///< La cara de una caja coincide con su malla: que no se tape sola.
+	constexpr uint32_t kTestTexels = 4;       ///< Texels por lado a recorrer en `farthestIn`.
+
+	/**
+	 * @brief Coordenadas de recorte de `(x, y, z, 1)` con `m`.
+	 */
+	void
+	toClip(const float* m, float x, float y, float z, float* clip) {
+		for (int row = 0; row < 4; ++row) {
+			clip[row] = m[row] * x + m[4 + row] * y + m[8 + row] * z + m[12 + row];
+		}
+	}
+
+	/**
+	 * @brief Del lado izquierdo de `a`-`b` positivo, dos veces el rea de `a`, `b`, `p`.
+	 */
+	float
+	edge(const float* a, const float* b, float px, float py) {
+		return (b[0] - a[0]) * (py - a[1]) - (b[1] - a[1]) * (px - a[0]);
+	}
+}
+
+OcclusionCuller::OcclusionCuller() {
+	uint32_t total = 0;
+	uint32_t width = kWidth;
+	uint32_t height = kHeight;
+	for (;;) {
+		m_levels.push_back(Level{ total, width, height });
+		total += width * height;
+		if (width == 1 && height == 1) {
+			break;
+		}
+		width = (width + 1) / 2;
+		height = (height + 1) / 2;
+	}
+	m_depth.assign(total, 1.0f);
+}
+
+void
+OcclusionCuller::begin(const Mat4& viewProjection) {
+	m_viewProjection = viewProjection;
+	std::fill(m_depth.begin(), m_depth.begin() + kWidth * kHeight, 1.0f);
+	m_occluders = 0;
+	m_triangles = 0;
+}
+
+bool
+OcclusionCuller::addOccluder(const Mesh& mesh, const Mat4& model) {
+	const std::vector<uint32_t>& indices = mesh.indices();
+	uint32_t triangles = static_cast<uint32_t>(indices.size() / 3);
+	if (triangles == 0 || triangles > kMaxMeshTriangles || m_triangles + triangles > kMaxOccluderTriangles) {
+		return false;
+	}
+	ScreenBounds bounds;
+	if (!project(mesh.boundsMin(), mesh.boundsMax(), model, bounds)) {
+		return false;
+	}
+	// Lo que cruza el plano cercano est encima de la cmara: ocluye aunque no se sepa su rea
+	if (!bounds.crossesNear) {
+		float width = std::min(bounds.maxX, float(kWidth)) - std::max(bounds.minX, 0.0f);
+		float height = std::min(bounds.maxY, float(kHeight)) - std::max(bounds.minY, 0.0f);
+		if (width * height < kMinOccluderArea * float(kWidth * kHeight)) {
+			return false;
+		}
+	}
+
+	// Cada vrtice una vez; el cuarto valor dice si qued delante del plano cercano
+	Mat4 transform = m_viewProjection * model;
+	const std::vector<MeshVertex>& vertices = mesh.vertices();
+	m_projected.resize(vertices.size() * 4);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		float clip[4];
+		toClip(transform.data(), vertices[i].position[0], vertices[i].position[1], vertices[i].position[2], clip);
+		float* out = &m_projected[i * 4];
+		bool valid = clip[3] > kMinW && clip[2] >= -clip[3];
+		float inverseW = valid ? 1.0f / clip[3] : 0.0f;
+		out[0] = (clip[0] * inverseW * 0.5f + 0.5f) * float(kWidth);
+		out[1] = (clip[1] * inverseW * 0.5f + 0.5f) * float(kHeight);
+		out[2] = clip[2] * inverseW;
+		out[3] = valid ? 1.0f : 0.0f;
+	}
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		const float* a = &m_projected[size_t(indices[i]) * 4];
+		const float* b = &m_projected[size_t(indices[i + 1]) * 4];
+		const float* c = &m_projected[size_t(indices[i + 2]) * 4];
+		// Un tringulo recortado por el plano cercano se deja: ocluir de menos no se ve
+		if (a[3] != 0.0f && b[3] != 0.0f && c[3] != 0.0f) {
+			rasterize(a, b, c);
+		}
+	}
+	m_triangles += triangles;
+	++m_occluders;
+	return true;
+}
+
+void
+OcclusionCuller::rasterize(const float* a, const float* b, const float* c) {
+	float area = edge(a, b, c[0], c[1]);
+	if (std::fabs(area) < 1e-8f) {
+		return;
+	}
+	// Las dos caras ocluyen: se ordena en sentido antihorario
+	if (area < 0.0f) {
+		std::swap(b, c);
+		area = -area;
+	}
+	float minX = std::min({ a[0], b[0], c[0] });
+	float maxX = std::max({ a[0], b[0], c[0] });
+	float minY = std::min({ a[1], b[1], c[1] });
+	float maxY = std::max({ a[1], b[1], c[1] });
+	int32_t x0 = std::max(0, static_cast<int32_t>(std::ceil(minX - 0.5f)));
+	int32_t x1 = std::min(int32_t(kWidth) - 1, static_cast<int32_t>(std::floor(maxX - 0.5f)));
+	int32_t y0 = std::max(0, static_cast<int32_t>(std::ceil(minY - 0.5f)));
+	int32_t y1 = std::min(int32_t(kHeight) - 1, static_cast<int32_t>(std::floor(maxY - 0.5f)));
+	if (x0 > x1 || y0 > y1) {
+		return;
+	}
+
+	// Funciones de borde en el centro del primer texel; avanzan con una suma por texel
+	float inverseArea = 1.0f / area;
+	float startX = float(x0) + 0.5f;
+	float stepX0 = -(c[1] - b[1]);
+	float stepX1 = -(a[1] - c[1]);
+	float stepX2 = -(b[1] - a[1]);
+	for (int32_t y = y0; y <= y1; ++y) {
+		float centerY = float(y) + 0.5f;
+		float w0 = edge(b, c, startX, centerY);
+		float w1 = edge(c, a, startX, centerY);
+		float w2 = edge(a, b, startX, centerY);
+		float* row = &m_depth[size_t(y) * kWidth];
+		for (int32_t x = x0; x <= x1; ++x) {
+			if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) {
+				// La profundidad normalizada es lineal en pantalla
+				float z = (w0 * a[2] + w1 * b[2] + w2 * c[2]) * inverseArea;
+				row[x] = std::min(row[x], z);
+			}
+			w0 += stepX0;
+			w1 += stepX1;
+			w2 += stepX2;
+		}
+	}
+}
+
+void
+OcclusionCuller::finish() {
+	for (size_t level = 1; level < m_levels.size(); ++level) {
+		const Level& below = m_levels[level - 1];
+		const Level& current = m_levels[level];
+		const float* from = &m_depth[below.offset];
+		float* to = &m_depth[current.offset];
+		for (uint32_t y = 0; y < current.height; ++y) {
+			uint32_t y0 = y * 2;
+			uint32_t y1 = std::min(y0 + 1, below.height - 1);
+			for (uint32_t x = 0; x < current.width; ++x) {
+				uint32_t x0 = x * 2;
+				uint32_t x1 = std::min(x0 + 1, below.width - 1);
+				to[y * current.width + x] = std::max({ from[y0 * below.width + x0], from[y0 * below.width + x1],
+					from[y1 * below.width + x0], from[y1 * below.width + x1] });
+			}
+		}
+	}
+}
+
+bool
+OcclusionCuller::project(const sf::Vector3f& boundsMin, const sf::Vector3f& boundsMax, const Mat4& model,
+	ScreenBounds& bounds) const {
+	Mat4 transform = m_viewProjection * model;
+	float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, minZ = 1e30f;
+	bounds.crossesNear = false;
+	int behind = 0;
+	for (int corner = 0; corner < 8; ++corner) {
+		float clip[4];
+		toClip(transform.data(), (corner & 1) ? boundsMax.x : boundsMin.x, (corner & 2) ? boundsMax.y : boundsMin.y,
+			(corner & 4) ? boundsMax.z : boundsMin.z, clip);
+		if (clip[3] <= kMinW || clip[2] < -clip[3]) {
+			bounds.crossesNear = true;
+			++behind;
+			continue;
+		}
+		float inverseW = 1.0f / clip[3];
+		float x = clip[0] * inverseW;
+		float y = clip[1] * inverseW;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minZ = std::min(minZ, clip[2] * inverseW);
+	}
+	// Entera detrs del plano cercano no se ve; cruzndolo, la proyeccin de las otras no vale
+	if (bounds.crossesNear) {
+		return behind < 8;
+	}
+	if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || minZ > 1.0f) {
+		return false;
+	}
+	bounds.minX = (minX * 0.5f + 0.5f) * float(kWidth);
+	bounds.maxX = (maxX * 0.5f + 0.5f) * float(kWidth);
+	bounds.minY = (minY * 0.5f + 0.5f) * float(kHeight);
+	bounds.maxY = (maxY * 0.5f + 0.5f) * float(kHeight);
+	bounds.nearestDepth = minZ;
+	return true;
+}
+
+bool
+OcclusionCuller::isVisible(const sf::Vector3f& boundsMin, const sf::Vector3f& boundsMax, const Mat4& model) const {
+	ScreenBounds bounds;
+	if (!project(boundsMin, boundsMax, model, bounds)) {
+		return false;
+	}
+	if (bounds.crossesNear || m_occluders == 0) {
+		return true;
+	}
+	// Un texel ms por lado: los bordes de los oclusores se rasterizaron por centros
+	int32_t x0 = std::max(0, static_cast<int32_t>(std::floor(bounds.minX)) - 1);
+	int32_t x1 = std::min(int32_t(kWidth) - 1, static_cast<int32_t>(std::floor(bounds.maxX)) + 1);
+	int32_t y0 = std::max(0, static_cast<int32_t>(std::floor(bounds.minY)) - 1);
+	int32_t y1 = std::min(int32_t(kHeight) - 1, static_cast<int32_t>(std::floor(bounds.maxY)) + 1);
+	return bounds.nearestDepth <= farthestIn(x0, y0, x1, y1) + kDepthBias;
+}
+
+float
+OcclusionCuller::farthestIn(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+	// El nivel donde el rectngulo ocupa a lo ms `kTestTexels` por lado; cubre de ms, nunca de menos
+	size_t level = 0;
+	while (level + 1 < m_levels.size() &&
+	       (uint32_t((x1 >> level) - (x0 >> level)) >= kTestTexels || uint32_t((y1 >> level) - (y0 >> level)) >= kTestTexels)) {
+		++level;
+	}
+	const Level& at = m_levels[level];
+	const float* texels = &m_depth[at.offset];
+	float farthest = -1.0f;
+	for (int32_t y = y0 >> level; y <= (y1 >> level); ++y) {
+		for (int32_t x = x0 >> level; x <= (x1 >> level); ++x) {
+			farthest = std::max(farthest, texels[size_t(y) * at.width + size_t(x)]);
+		}
+	}
+	return farthest;
+}
@@ -0,0 +1,147 @@
+#include "Render/ParticleSystem.h"
+#include <algorithm>
+#include "Jobs/ParallelFor.h"
+#include "Render/RenderCommandBuffer.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PARTICLES_SSE 1
+#endif
+
+namespace {
+	constexpr size_t kVertexGrain = 4096; ///< Partculas por trabajo al escribir los quads.
+}
+
+void
+ParticleSystem::setCapacity(size_t capacity) {
+	// Relleno hasta mltiplo de kLanes: el ltimo paso SIMD puede leer y escribir ah
+	size_t padded = (capacity + kLanes - 1) / kLanes * kLanes;
+	m_x.resize(padded);
+	m_y.resize(padded);
+	m_velocityX.resize(padded);
+	m_velocityY.resize(padded);
+	m_life.resize(padded);
+	m_inverseLifetime.resize(padded);
+	m_size.resize(padded);
+	m_color.resize(padded);
+	m_capacity = capacity;
+	m_count = std::min(m_count, capacity);
+}
+
+bool
+ParticleSystem::emit(const Particle& particle) {
+	if (m_count == m_capacity || particle.lifetime <= 0.0f) {
+		return false;
+	}
+	size_t index = m_count++;
+	m_x[index] = particle.position.x;
+	m_y[index] = particle.position.y;
+	m_velocityX[index] = particle.velocity.x;
+	m_velocityY[index] = particle.velocity.y;
+	m_life[index] = particle.lifetime;
+	m_inverseLifetime[index] = 1.0f / particle.lifetime;
+	m_size[index] = particle.size;
+	m_color[index] = particle.color.toInteger();
+	return true;
+}
+
+void
+ParticleSystem::update(float deltaTime) {
+	integrate(deltaTime);
+
+	// La ltima viva ocupa el lugar de la muerta; se vuelve a revisar el mismo ndice
+	size_t index = 0;
+	while (index < m_count) {
+		if (m_life[index] > 0.0f) {
+			++index;
+			continue;
+		}
+		size_t last = --m_count;
+		m_x[index] = m_x[last];
+		m_y[index] = m_y[last];
+		m_velocityX[index] = m_velocityX[last];
+		m_velocityY[index] = m_velocityY[last];
+		m_life[index] = m_life[last];
+		m_inverseLifetime[index] = m_inverseLifetime[last];
+		m_size[index] = m_size[last];
+		m_color[index] = m_color[last];
+	}
+}
+
+void
+ParticleSystem::integrate(float deltaTime) {
+	size_t end = (m_count + kLanes - 1) / kLanes * kLanes;
+	float* x = m_x.data();
+	float* y = m_y.data();
+	float* velocityX = m_velocityX.data();
+	float* velocityY = m_velocityY.data();
+	float* life = m_life.data();
+	float gravityX = m_gravity.x * deltaTime;
+	float gravityY = m_gravity.y * deltaTime;
+#if PARTICLES_SSE
+	__m128 dt = _mm_set1_ps(deltaTime);
+	__m128 gx = _mm_set1_ps(gravityX);
+	__m128 gy = _mm_set1_ps(gravityY);
+	for (size_t i = 0; i < end; i += kLanes) {
+		__m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + i), gx);
+		__m128 vy = _mm_add_ps(_mm_loadu_ps(velocityY + i), gy);
+		_mm_storeu_ps(velocityX + i, vx);
+		_mm_storeu_ps(velocityY + i, vy);
+		_mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx, dt)));
+		_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy, dt)));
+		_mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt));
+	}
+#else
+	for (size_t i = 0; i < end; ++i) {
+		velocityX[i] += gravityX;
+		velocityY[i] += gravityY;
+		x[i] += velocityX[i] * deltaTime;
+		y[i] += velocityY[i] * deltaTime;
+		life[i] -= deltaTime;
+	}
+#endif
+}
+
+void
+ParticleSystem::render(RenderCommandBuffer& commands, const sf::FloatRect& visibleArea) {
+	if (m_count == 0) {
+		return;
+	}
+	sf::VertexArray& vertices = m_frames[m_frame];
+	m_frame ^= 1;
+	vertices.resize(m_count * kVerticesPerParticle);
+
+	float left = visibleArea.left;
+	float top = visibleArea.top;
+	float right = visibleArea.left + visibleArea.width;
+	float bottom = visibleArea.top + visibleArea.height;
+	sf::Vertex* out = &vertices[0];
+	const float* base = m_x.data();
+	JobSystem& jobs = EngineUtilities::TService<JobSystem>::instance();
+	parallelForChunks(jobs, std::span<const float>(m_x.data(), m_count), kVertexGrain,
+		[&](std::span<const float> chunk, size_t) {
+			size_t first = static_cast<size_t>(chunk.data() - base);
+			for (size_t i = first; i < first + chunk.size(); ++i) {
+				sf::Vertex* quad = out + i * kVerticesPerParticle;
+				float half = m_size[i] * 0.5f;
+				float x0 = m_x[i] - half;
+				float y0 = m_y[i] - half;
+				float x1 = m_x[i] + half;
+				float y1 = m_y[i] + half;
+				if (x1 < left || x0 > right || y1 < top || y0 > bottom) {
+					// Quad sin rea: no llega a ningn pxel
+					x1 = x0;
+					y1 = y0;
+				}
+				sf::Color color(m_color[i]);
+				color.a = static_cast<sf::Uint8>(color.a * std::min(1.0f, m_life[i] * m_inverseLifetime[i]));
+				quad[0] = sf::Vertex(sf::Vector2f(x0, y0), color);
+				quad[1] = sf::Vertex(sf::Vector2f(x1, y0), color);
+				quad[2] = sf::Vertex(sf::Vector2f(x1, y1), color);
+				quad[3] = quad[0];
+				quad[4] = quad[2];
+				quad[5] = sf::Vertex(sf::Vector2f(x0, y1), color);
+			}
+		});
+	commands.draw(vertices, sf::Transform::Identity, m_layer);
+}
@@ -0,0 +1,145 @@
+#include "Render/PostEffects.h"
+#include "Render/ShaderCache.h"
+
+namespace {
+	/**
+	 * @brief 9 texeles en 5 lecturas: los pesos de cada par vecino ya van sumados y la lectura cae
+	 *        entre los dos, donde el filtro lineal da la mezcla.
+	 */
+	const char* const kBlurFragment = R"(#version 120
+uniform sampler2D u_source;
+uniform vec2 u_step;
+
+void main() {
+	vec2 uv = gl_TexCoord[0].xy;
+	vec2 near = u_step * 1.3846153846;
+	vec2 far = u_step * 3.2307692308;
+	vec4 color = texture2D(u_source, uv) * 0.2270270270;
+	color += (texture2D(u_source, uv + near) + texture2D(u_source, uv - near)) * 0.3162162162;
+	color += (texture2D(u_source, uv + far) + texture2D(u_source, uv - far)) * 0.0702702703;
+	gl_FragColor = color;
+}
+)";
+
+	const char* const kBrightFragment = R"(#version 120
+uniform sampler2D u_source;
+uniform float u_threshold;
+
+void main() {
+	vec3 color = texture2D(u_source, gl_TexCoord[0].xy).rgb;
+	float luma = dot(color, vec3(0.2126, 0.7152, 0.0722));
+	gl_FragColor = vec4(color * (max(luma - u_threshold, 0.0) / max(luma, 0.0001)), 1.0);
+}
+)";
+
+	const char* const kBloomCompositeFragment = R"(#version 120
+uniform sampler2D u_source;
+uniform sampler2D u_bloom;
+uniform float u_intensity;
+
+void main() {
+	vec2 uv = gl_TexCoord[0].xy;
+	vec4 color = texture2D(u_source, uv);
+	gl_FragColor = vec4(color.rgb + texture2D(u_bloom, uv).rgb * u_intensity, color.a);
+}
+)";
+
+	const char* const kGradingFragment = R"(#version 120
+uniform sampler2D u_source;
+uniform float u_exposure;
+uniform float u_contrast;
+uniform float u_saturation;
+uniform vec4 u_tint;
+
+void main() {
+	vec4 color = texture2D(u_source, gl_TexCoord[0].xy);
+	vec3 graded = color.rgb * u_exposure;
+	graded = (graded - 0.5) * u_contrast + 0.5;
+	float luma = dot(graded, vec3(0.2126, 0.7152, 0.0722));
+	graded = mix(vec3(luma), graded, u_saturation) * u_tint.rgb;
+	gl_FragColor = vec4(clamp(graded, 0.0, 1.0), color.a);
+}
+)";
+
+	sf::Shader*
+	effectShader(const char* fragmentSource) {
+		ShaderCache& shaders = EngineUtilities::TService<ShaderCache>::instance();
+		return shaders.shader(PostProcessStack::kVertexSource, fragmentSource);
+	}
+}
+
+bool
+BlurEffect::blur(const sf::Texture& source, sf::RenderTexture& scratch, sf::RenderTexture& destination,
+                 float radius) {
+	sf::Shader* shader = effectShader(kBlurFragment);
+	if (!shader) {
+		return false;
+	}
+	// Si `source` es ms grande, el primer pase tambin la reduce
+	sf::Vector2u size = scratch.getSize();
+	shader->setUniform("u_source", sf::Shader::CurrentTexture);
+	shader->setUniform("u_step", sf::Glsl::Vec2(radius / size.x, 0.0f));
+	PostProcessStack::blit(source, scratch, shader);
+	scratch.display();
+	shader->setUniform("u_step", sf::Glsl::Vec2(0.0f, radius / size.y));
+	PostProcessStack::blit(scratch.getTexture(), destination, shader);
+	destination.display();
+	return true;
+}
+
+bool
+BlurEffect::apply(PostProcessStack& stack, const sf::Texture& source, sf::RenderTarget& output) {
+	sf::RenderTexture* scratch = stack.acquire(resolution());
+	sf::RenderTexture* blurred = stack.acquire(resolution());
+	bool done = scratch && blurred && blur(source, *scratch, *blurred, m_radius);
+	if (done) {
+		PostProcessStack::blit(blurred->getTexture(), output);
+	}
+	stack.release(scratch);
+	stack.release(blurred);
+	return done;
+}
+
+bool
+BloomEffect::apply(PostProcessStack& stack, const sf::Texture& source, sf::RenderTarget& output) {
+	sf::Shader* bright = effectShader(kBrightFragment);
+	sf::Shader* composite = effectShader(kBloomCompositeFragment);
+	if (!bright || !composite) {
+		return false;
+	}
+	sf::RenderTexture* glow = stack.acquire(resolution());
+	sf::RenderTexture* scratch = stack.acquire(resolution());
+	bool done = glow && scratch;
+	if (done) {
+		// Lo brillante, ya reducido; el desenfoque lo deja otra vez en `glow`
+		bright->setUniform("u_source", sf::Shader::CurrentTexture);
+		bright->setUniform("u_threshold", m_threshold);
+		PostProcessStack::blit(source, *glow, bright);
+		glow->display();
+		done = BlurEffect::blur(glow->getTexture(), *scratch, *glow, m_radius);
+	}
+	if (done) {
+		composite->setUniform("u_source", sf::Shader::CurrentTexture);
+		composite->setUniform("u_bloom", glow->getTexture());
+		composite->setUniform("u_intensity", m_intensity);
+		PostProcessStack::blit(source, output, composite);
+	}
+	stack.release(glow);
+	stack.release(scratch);
+	return done;
+}
+
+bool
+ColorGradingEffect::apply(PostProcessStack&, const sf::Texture& source, sf::RenderTarget& output) {
+	sf::Shader* shader = effectShader(kGradingFragment);
+	if (!shader) {
+		return false;
+	}
+	shader->setUniform("u_source", sf::Shader::CurrentTexture);
+	shader->setUniform("u_exposure", m_exposure);
+	shader->setUniform("u_contrast", m_contrast);
+	shader->setUniform("u_saturation", m_saturation);
+	shader->setUniform("u_tint", sf::Glsl::Vec4(m_tint));
+	PostProcessStack::blit(source, output, shader);
+	return true;
+}
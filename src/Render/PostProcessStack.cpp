@@ -0,0 +1,83 @@
+#include "Render/PostProcessStack.h"
+#include <algorithm>
+#include "Render/RenderStats.h"
+
+const char* const PostProcessStack::kVertexSource = R"(#version 120
+void main() {
+	gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+	gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;
+	gl_FrontColor = gl_Color;
+}
+)";
+
+bool
+PostProcessStack::isActive() const {
+	return std::any_of(m_effects.begin(), m_effects.end(),
+		[](const EngineUtilities::TUniquePtr<PostEffect>& effect) { return effect->isEnabled(); });
+}
+
+void
+PostProcessStack::apply(const sf::Texture& source, sf::RenderTarget& output) {
+	m_graph.reset();
+	RenderGraph::ResourceId scene = m_graph.importTexture("Scene", source);
+	RenderGraph::ResourceId present = m_graph.importTarget("Output", output);
+	addPasses(m_graph, scene, present);
+	m_graph.execute();
+}
+
+void
+PostProcessStack::addPasses(RenderGraph& graph, RenderGraph::ResourceId source, RenderGraph::ResourceId output) {
+	m_size = graph.size(source);
+	size_t last = m_effects.size();
+	for (size_t i = 0; i < m_effects.size(); ++i) {
+		if (m_effects[i]->isEnabled()) {
+			last = i;
+		}
+	}
+	if (last == m_effects.size()) {
+		graph.addPass("Copy", [&](RenderGraph::PassBuilder& pass) { pass.read(source).write(output); },
+			[source, output](RenderGraph::PassContext& context) { blit(context.texture(source), context.target(output)); });
+		return;
+	}
+
+	// Cada efecto lee el resultado del anterior; el ltimo escribe en `output`
+	RenderGraph::ResourceId current = source;
+	for (size_t i = 0; i <= last; ++i) {
+		PostEffect* effect = m_effects[i].get();
+		if (!effect->isEnabled()) {
+			continue;
+		}
+		RenderGraph::ResourceId next = i == last ? output : graph.createTexture("PostEffect", m_size);
+		graph.addPass("PostEffect", [&](RenderGraph::PassBuilder& pass) { pass.read(current).write(next); },
+			[this, effect, current, next](RenderGraph::PassContext& context) {
+				if (!effect->apply(*this, context.texture(current), context.target(next))) {
+					blit(context.texture(current), context.target(next));
+				}
+			});
+		current = next;
+	}
+}
+
+sf::RenderTexture*
+PostProcessStack::acquire(uint32_t divisor) {
+	divisor = std::max<uint32_t>(divisor, 1);
+	sf::Vector2u size(std::max(m_size.x / divisor, 1u), std::max(m_size.y / divisor, 1u));
+	return m_pool.acquire(size);
+}
+
+void
+PostProcessStack::blit(const sf::Texture& source, sf::RenderTarget& destination, const sf::Shader* shader,
+                       const sf::BlendMode& blend) {
+	sf::Vector2u from = source.getSize();
+	sf::Vector2u to = destination.getSize();
+	sf::Sprite sprite(source);
+	sprite.setScale(static_cast<float>(to.x) / from.x, static_cast<float>(to.y) / from.y);
+
+	sf::RenderStates states(blend);
+	states.shader = shader;
+	sf::View view = destination.getView();
+	destination.setView(destination.getDefaultView());
+	destination.draw(sprite, states);
+	destination.setView(view);
+	RenderStatsCounter::current().countDraw(4, &source, shader, blend);
+}
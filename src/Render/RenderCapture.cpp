@@ -0,0 +1,416 @@
+#include "Render/RenderCapture.h"
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace {
+	/**
+	 * @brief FNV-1a de `size` bytes, seguido de `hash`.
+	 */
+	uint64_t
+	hashBytes(uint64_t hash, const void* data, size_t size) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	template<typename T>
+	void
+	writeArray(std::ofstream& file, const std::vector<T>& items) {
+		static_assert(std::is_trivially_copyable_v<T>, "las tablas se guardan byte a byte");
+		file.write(reinterpret_cast<const char*>(items.data()), static_cast<std::streamsize>(items.size() * sizeof(T)));
+	}
+
+	template<typename T>
+	bool
+	readArray(std::ifstream& file, std::vector<T>& items, uint32_t count) {
+		static_assert(std::is_trivially_copyable_v<T>, "las tablas se guardan byte a byte");
+		items.resize(count);
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(items.data()), static_cast<std::streamsize>(count * sizeof(T))));
+	}
+
+	void
+	storeTransform(const sf::Transform& transform, float* out) {
+		// `getMatrix` es 4x4 por columnas; sf::Transform se arma con la 3x3 por filas
+		const float* m = transform.getMatrix();
+		const float rows[9] = { m[0], m[4], m[12], m[1], m[5], m[13], m[3], m[7], m[15] };
+		std::memcpy(out, rows, sizeof(rows));
+	}
+
+	sf::Transform
+	loadTransform(const float* m) {
+		return sf::Transform(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
+	}
+}
+
+void
+RenderCapture::clear() {
+	m_frames.clear();
+	m_commands.clear();
+	m_geometries.clear();
+	m_meshDraws.clear();
+	m_lights.clear();
+	m_points.clear();
+	m_vertices.clear();
+	m_textures.clear();
+	m_meshes.clear();
+	m_textureIds.clear();
+	m_meshIds.clear();
+	m_geometryIds.clear();
+	m_skipped = 0;
+	m_replayTextures.clear();
+	m_replayMeshes.clear();
+	m_replayShapes.clear();
+	m_replayVertices.clear();
+}
+
+void
+RenderCapture::record(const RenderCommandBuffer& commands, const sf::View& view) {
+	Frame& frame = m_frames.emplace_back();
+	frame.center[0] = view.getCenter().x;
+	frame.center[1] = view.getCenter().y;
+	frame.size[0] = view.getSize().x;
+	frame.size[1] = view.getSize().y;
+	frame.rotation = view.getRotation();
+	const sf::FloatRect& viewport = view.getViewport();
+	const float viewportValues[4] = { viewport.left, viewport.top, viewport.width, viewport.height };
+	std::memcpy(frame.viewport, viewportValues, sizeof(viewportValues));
+	if (const CameraUniforms* camera = commands.camera()) {
+		frame.hasCamera = 1;
+		frame.camera = *camera;
+	}
+	frame.firstLight = static_cast<uint32_t>(m_lights.size());
+	m_lights.insert(m_lights.end(), commands.lights().begin(), commands.lights().end());
+	frame.lightCount = static_cast<uint32_t>(m_lights.size()) - frame.firstLight;
+
+	frame.firstMesh = static_cast<uint32_t>(m_meshDraws.size());
+	for (const MeshCommand& mesh : commands.meshCommands()) {
+		m_meshDraws.push_back({ meshIndex(*mesh.mesh), mesh.model, mesh.color.toInteger() });
+	}
+	frame.meshCount = static_cast<uint32_t>(m_meshDraws.size()) - frame.firstMesh;
+
+	frame.firstCommand = static_cast<uint32_t>(m_commands.size());
+	for (const DrawCommand& command : commands.commands()) {
+		if (command.shader) {
+			++m_skipped;
+			continue;
+		}
+		Geometry geometry;
+		sf::Transform world = command.transform;
+		if (const sf::Shape* shape = command.shape) {
+			// La matriz de la figura va en la del comando: la copia se dibuja sin la suya
+			world.combine(shape->getTransform());
+			geometry.kind = Kind::Shape;
+			geometry.first = static_cast<uint32_t>(m_points.size());
+			if (command.outlineCount) {
+				m_points.insert(m_points.end(), command.outline, command.outline + command.outlineCount);
+			}
+			else {
+				for (size_t i = 0; i < shape->getPointCount(); ++i) {
+					m_points.push_back(shape->getPoint(i));
+				}
+			}
+			geometry.count = static_cast<uint32_t>(m_points.size()) - geometry.first;
+			geometry.texture = textureIndex(shape->getTexture());
+			geometry.fillColor = command.color.toInteger();
+			geometry.outlineColor = shape->getOutlineColor().toInteger();
+			geometry.outlineThickness = shape->getOutlineThickness();
+			const sf::IntRect& rect = command.textureRect.width != 0 ? command.textureRect : shape->getTextureRect();
+			const int32_t rectValues[4] = { rect.left, rect.top, rect.width, rect.height };
+			std::memcpy(geometry.textureRect, rectValues, sizeof(rectValues));
+		}
+		else if (const sf::VertexArray* vertices = dynamic_cast<const sf::VertexArray*>(command.geometry)) {
+			geometry.kind = Kind::Vertices;
+			geometry.primitive = static_cast<uint8_t>(vertices->getPrimitiveType());
+			geometry.first = static_cast<uint32_t>(m_vertices.size());
+			for (size_t i = 0; i < vertices->getVertexCount(); ++i) {
+				m_vertices.push_back((*vertices)[i]);
+			}
+			geometry.count = static_cast<uint32_t>(m_vertices.size()) - geometry.first;
+		}
+		else {
+			++m_skipped;
+			continue;
+		}
+
+		Command& captured = m_commands.emplace_back();
+		captured.geometry = geometryIndex(geometry);
+		captured.texture = textureIndex(command.texture);
+		captured.layer = RenderCommandBuffer::layerOf(command.sortKey);
+		captured.depth = static_cast<uint16_t>(command.sortKey >> 40);
+		const sf::BlendMode& blend = command.blendMode;
+		const uint8_t blendValues[6] = { uint8_t(blend.colorSrcFactor), uint8_t(blend.colorDstFactor), uint8_t(blend.colorEquation),
+		                                 uint8_t(blend.alphaSrcFactor), uint8_t(blend.alphaDstFactor), uint8_t(blend.alphaEquation) };
+		std::memcpy(captured.blend, blendValues, sizeof(blendValues));
+		storeTransform(world, captured.transform);
+	}
+	frame.commandCount = static_cast<uint32_t>(m_commands.size()) - frame.firstCommand;
+}
+
+int32_t
+RenderCapture::textureIndex(const sf::Texture* texture) {
+	if (!texture) {
+		return -1;
+	}
+	for (const std::pair<const sf::Texture*, int32_t>& known : m_textureIds) {
+		if (known.first == texture) {
+			return known.second;
+		}
+	}
+	sf::Image image = texture->copyToImage();
+	TextureData& data = m_textures.emplace_back();
+	data.width = image.getSize().x;
+	data.height = image.getSize().y;
+	data.smooth = texture->isSmooth();
+	data.repeated = texture->isRepeated();
+	data.pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + size_t(data.width) * data.height * 4);
+	int32_t index = static_cast<int32_t>(m_textures.size() - 1);
+	m_textureIds.emplace_back(texture, index);
+	return index;
+}
+
+uint32_t
+RenderCapture::meshIndex(const Mesh& mesh) {
+	for (const std::pair<const Mesh*, uint32_t>& known : m_meshIds) {
+		if (known.first == &mesh) {
+			return known.second;
+		}
+	}
+	m_meshes.push_back({ mesh.vertices(), mesh.indices() });
+	uint32_t index = static_cast<uint32_t>(m_meshes.size() - 1);
+	m_meshIds.emplace_back(&mesh, index);
+	return index;
+}
+
+uint32_t
+RenderCapture::geometryIndex(const Geometry& geometry) {
+	const void* data = geometry.kind == Kind::Shape ? static_cast<const void*>(m_points.data() + geometry.first)
+	                                                : static_cast<const void*>(m_vertices.data() + geometry.first);
+	size_t bytes = geometry.count * (geometry.kind == Kind::Shape ? sizeof(sf::Vector2f) : sizeof(sf::Vertex));
+	// Todo menos dnde empiezan sus datos
+	Geometry key = geometry;
+	key.first = 0;
+	uint64_t hash = hashBytes(hashBytes(1469598103934665603ull, &key, sizeof(key)), data, bytes);
+
+	auto [begin, end] = m_geometryIds.equal_range(hash);
+	for (auto it = begin; it != end; ++it) {
+		const Geometry& known = m_geometries[it->second];
+		Geometry knownKey = known;
+		knownKey.first = 0;
+		const void* knownData = known.kind == Kind::Shape ? static_cast<const void*>(m_points.data() + known.first)
+		                                                  : static_cast<const void*>(m_vertices.data() + known.first);
+		if (std::memcmp(&knownKey, &key, sizeof(key)) == 0 && std::memcmp(knownData, data, bytes) == 0) {
+			// Ya estaba: los datos recin copiados sobran
+			if (geometry.kind == Kind::Shape) {
+				m_points.resize(geometry.first);
+			}
+			else {
+				m_vertices.resize(geometry.first);
+			}
+			return it->second;
+		}
+	}
+	m_geometries.push_back(geometry);
+	uint32_t index = static_cast<uint32_t>(m_geometries.size() - 1);
+	m_geometryIds.emplace(hash, index);
+	return index;
+}
+
+bool
+RenderCapture::write(const std::string& path) const {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	Header header = { { 'G', 'R', 'C', 'S' }, kVersion, static_cast<uint32_t>(m_frames.size()),
+	                  static_cast<uint32_t>(m_commands.size()), static_cast<uint32_t>(m_geometries.size()),
+	                  static_cast<uint32_t>(m_meshDraws.size()), static_cast<uint32_t>(m_lights.size()),
+	                  static_cast<uint32_t>(m_points.size()), static_cast<uint32_t>(m_vertices.size()),
+	                  static_cast<uint32_t>(m_textures.size()), static_cast<uint32_t>(m_meshes.size()) };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	writeArray(file, m_frames);
+	writeArray(file, m_commands);
+	writeArray(file, m_geometries);
+	writeArray(file, m_meshDraws);
+	writeArray(file, m_lights);
+	writeArray(file, m_points);
+	writeArray(file, m_vertices);
+	for (const TextureData& texture : m_textures) {
+		const uint32_t values[4] = { texture.width, texture.height, texture.smooth, texture.repeated };
+		file.write(reinterpret_cast<const char*>(values), sizeof(values));
+		writeArray(file, texture.pixels);
+	}
+	for (const MeshData& mesh : m_meshes) {
+		const uint32_t counts[2] = { static_cast<uint32_t>(mesh.vertices.size()), static_cast<uint32_t>(mesh.indices.size()) };
+		file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+		writeArray(file, mesh.vertices);
+		writeArray(file, mesh.indices);
+	}
+	return static_cast<bool>(file);
+}
+
+bool
+RenderCapture::read(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	Header header;
+	if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+	    std::memcmp(header.magic, "GRCS", 4) != 0 || header.version != kVersion) {
+		return false;
+	}
+	RenderCapture loaded;
+	if (!readArray(file, loaded.m_frames, header.frames) || !readArray(file, loaded.m_commands, header.commands) ||
+	    !readArray(file, loaded.m_geometries, header.geometries) || !readArray(file, loaded.m_meshDraws, header.meshDraws) ||
+	    !readArray(file, loaded.m_lights, header.lights) || !readArray(file, loaded.m_points, header.points) ||
+	    !readArray(file, loaded.m_vertices, header.vertices)) {
+		return false;
+	}
+	loaded.m_textures.resize(header.textures);
+	for (TextureData& texture : loaded.m_textures) {
+		uint32_t values[4];
+		if (!file.read(reinterpret_cast<char*>(values), sizeof(values)) ||
+		    !readArray(file, texture.pixels, values[0] * values[1] * 4)) {
+			return false;
+		}
+		texture.width = values[0];
+		texture.height = values[1];
+		texture.smooth = values[2];
+		texture.repeated = values[3];
+	}
+	loaded.m_meshes.resize(header.meshes);
+	for (MeshData& mesh : loaded.m_meshes) {
+		uint32_t counts[2];
+		if (!file.read(reinterpret_cast<char*>(counts), sizeof(counts)) || !readArray(file, mesh.vertices, counts[0]) ||
+		    !readArray(file, mesh.indices, counts[1])) {
+			return false;
+		}
+	}
+
+	// Los ndices deben caer dentro de sus tablas: el archivo pudo cortarse o venir de otra versin
+	for (const Frame& frame : loaded.m_frames) {
+		if (uint64_t(frame.firstCommand) + frame.commandCount > header.commands ||
+		    uint64_t(frame.firstMesh) + frame.meshCount > header.meshDraws ||
+		    uint64_t(frame.firstLight) + frame.lightCount > header.lights) {
+			return false;
+		}
+	}
+	for (const Command& command : loaded.m_commands) {
+		if (command.geometry >= header.geometries || command.texture >= int32_t(header.textures)) {
+			return false;
+		}
+	}
+	for (const Geometry& geometry : loaded.m_geometries) {
+		uint32_t limit = geometry.kind == Kind::Shape ? header.points : header.vertices;
+		if (uint64_t(geometry.first) + geometry.count > limit || geometry.texture >= int32_t(header.textures)) {
+			return false;
+		}
+	}
+	for (const MeshDraw& draw : loaded.m_meshDraws) {
+		if (draw.mesh >= header.meshes) {
+			return false;
+		}
+	}
+
+	clear();
+	m_frames.swap(loaded.m_frames);
+	m_commands.swap(loaded.m_commands);
+	m_geometries.swap(loaded.m_geometries);
+	m_meshDraws.swap(loaded.m_meshDraws);
+	m_lights.swap(loaded.m_lights);
+	m_points.swap(loaded.m_points);
+	m_vertices.swap(loaded.m_vertices);
+	m_textures.swap(loaded.m_textures);
+	m_meshes.swap(loaded.m_meshes);
+	prepare();
+	return true;
+}
+
+void
+RenderCapture::prepare() {
+	for (const TextureData& data : m_textures) {
+		EngineUtilities::TUniquePtr<sf::Texture> texture = EngineUtilities::MakeUnique<sf::Texture>();
+		sf::Image image;
+		image.create(data.width, data.height, data.pixels.data());
+		texture->loadFromImage(image);
+		texture->setSmooth(data.smooth != 0);
+		texture->setRepeated(data.repeated != 0);
+		m_replayTextures.push_back(std::move(texture));
+	}
+	for (const MeshData& data : m_meshes) {
+		EngineUtilities::TUniquePtr<Mesh> mesh = EngineUtilities::MakeUnique<Mesh>();
+		mesh->setGeometry(data.vertices, data.indices);
+		m_replayMeshes.push_back(std::move(mesh));
+	}
+	m_replayShapes.resize(m_geometries.size());
+	m_replayVertices.resize(m_geometries.size());
+	for (size_t i = 0; i < m_geometries.size(); ++i) {
+		const Geometry& geometry = m_geometries[i];
+		if (geometry.kind == Kind::Vertices) {
+			sf::VertexArray& vertices = m_replayVertices[i];
+			vertices.setPrimitiveType(static_cast<sf::PrimitiveType>(geometry.primitive));
+			vertices.resize(geometry.count);
+			for (uint32_t v = 0; v < geometry.count; ++v) {
+				vertices[v] = m_vertices[geometry.first + v];
+			}
+			continue;
+		}
+		sf::ConvexShape& shape = m_replayShapes[i];
+		shape.setPointCount(geometry.count);
+		for (uint32_t p = 0; p < geometry.count; ++p) {
+			shape.setPoint(p, m_points[geometry.first + p]);
+		}
+		shape.setFillColor(sf::Color(geometry.fillColor));
+		shape.setOutlineColor(sf::Color(geometry.outlineColor));
+		shape.setOutlineThickness(geometry.outlineThickness);
+		if (geometry.texture >= 0) {
+			shape.setTexture(m_replayTextures[geometry.texture].get());
+		}
+		shape.setTextureRect(sf::IntRect(geometry.textureRect[0], geometry.textureRect[1], geometry.textureRect[2],
+		                                 geometry.textureRect[3]));
+	}
+}
+
+void
+RenderCapture::replay(size_t frame, RenderCommandBuffer& out) const {
+	const Frame& captured = m_frames[frame];
+	out.clear();
+	if (captured.hasCamera) {
+		out.setCamera(captured.camera);
+	}
+	for (uint32_t i = 0; i < captured.lightCount; ++i) {
+		out.addLight(m_lights[captured.firstLight + i]);
+	}
+	for (uint32_t i = 0; i < captured.meshCount; ++i) {
+		const MeshDraw& draw = m_meshDraws[captured.firstMesh + i];
+		out.drawMesh(*m_replayMeshes[draw.mesh], draw.model, sf::Color(draw.color));
+	}
+	for (uint32_t i = 0; i < captured.commandCount; ++i) {
+		const Command& command = m_commands[captured.firstCommand + i];
+		const Geometry& geometry = m_geometries[command.geometry];
+		DrawState state;
+		state.layer = command.layer;
+		state.depth = command.depth;
+		state.texture = command.texture >= 0 ? m_replayTextures[command.texture].get() : nullptr;
+		const uint8_t* b = command.blend;
+		state.blendMode = sf::BlendMode(sf::BlendMode::Factor(b[0]), sf::BlendMode::Factor(b[1]), sf::BlendMode::Equation(b[2]),
+		                                sf::BlendMode::Factor(b[3]), sf::BlendMode::Factor(b[4]), sf::BlendMode::Equation(b[5]));
+		sf::Transform transform = loadTransform(command.transform);
+		if (geometry.kind == Kind::Shape) {
+			out.draw(m_replayShapes[command.geometry], transform, state,
+				std::span<const sf::Vector2f>(m_points).subspan(geometry.first, geometry.count));
+		}
+		else {
+			out.draw(m_replayVertices[command.geometry], transform, state);
+		}
+	}
+}
+
+sf::View
+RenderCapture::viewOf(size_t frame) const {
+	const Frame& captured = m_frames[frame];
+	sf::View view(sf::Vector2f(captured.center[0], captured.center[1]), sf::Vector2f(captured.size[0], captured.size[1]));
+	view.setRotation(captured.rotation);
+	view.setViewport(sf::FloatRect(captured.viewport[0], captured.viewport[1], captured.viewport[2], captured.viewport[3]));
+	return view;
+}
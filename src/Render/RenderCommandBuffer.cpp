@@ -0,0 +1,316 @@
+#include "Render/RenderCommandBuffer.h"
+#include <algorithm>
+#include <array>
+#include <typeinfo>
+#include "Jobs/JobSystem.h"
+
+namespace {
+	constexpr size_t kSortChunk = 16384; ///< Claves por trozo de un `sort` en paralelo.
+
+	/**
+	 * @brief Los `bits` bajos de un hash de `pointer`; iguales para el mismo puntero.
+	 */
+	uint64_t
+	pointerKey(const void* pointer, unsigned bits) {
+		uint64_t value = reinterpret_cast<uintptr_t>(pointer);
+		value ^= value >> 29;
+		value *= 0x9E3779B97F4A7C15ull;
+		return (value >> (64 - bits)) & ((uint64_t(1) << bits) - 1);
+	}
+
+	/**
+	 * @brief 8 bits para un modo de mezcla; `sf::BlendAlpha`, el de casi todo, da 0.
+	 */
+	uint64_t
+	blendKey(const sf::BlendMode& mode) {
+		if (mode == sf::BlendAlpha) {
+			return 0;
+		}
+		uint32_t packed = (uint32_t(mode.colorSrcFactor) << 0) | (uint32_t(mode.colorDstFactor) << 4) |
+		                  (uint32_t(mode.colorEquation) << 8) | (uint32_t(mode.alphaSrcFactor) << 11) |
+		                  (uint32_t(mode.alphaDstFactor) << 15) | (uint32_t(mode.alphaEquation) << 19);
+		packed *= 0x9E3779B1u;
+		return (packed >> 24) | 1;
+	}
+}
+
+uint64_t
+RenderCommandBuffer::sortKeyOf(const DrawState& state) {
+	return (uint64_t(state.layer) << 56) | (uint64_t(state.depth) << 40) |
+	       ((state.shader ? pointerKey(state.shader, 12) : 0) << 28) |
+	       ((state.texture ? pointerKey(state.texture, 20) : 0) << 8) | blendKey(state.blendMode);
+}
+
+void
+RenderCommandBuffer::draw(const sf::Drawable& geometry, const sf::Transform& transform, uint8_t layer, const sf::Texture* texture) {
+	DrawState state;
+	state.layer = layer;
+	state.texture = texture;
+	draw(geometry, transform, state);
+}
+
+void
+RenderCommandBuffer::draw(const sf::Shape& shape, const sf::Transform& transform, uint8_t layer, const sf::Texture* texture,
+	std::span<const sf::Vector2f> outline) {
+	DrawState state;
+	state.layer = layer;
+	state.texture = texture;
+	draw(shape, transform, state, outline);
+}
+
+void
+RenderCommandBuffer::drawMesh(const Mesh& mesh, const Mat4& model, sf::Color color, const Material* material) {
+	MeshCommand& command = m_meshes.emplace_back();
+	command.mesh = &mesh;
+	command.model = model;
+	command.color = color;
+	command.material = material;
+}
+
+void
+RenderCommandBuffer::drawStaticMesh(const Mesh& mesh, const Mat4& model, sf::Color color, const Material* material) {
+	drawMesh(mesh, model, color, material);
+	m_meshes.back().isStatic = true;
+}
+
+void
+RenderCommandBuffer::drawSkinnedMesh(const Mesh& mesh, const Mat4& model, std::span<const Mat4> palette, sf::Color color,
+	const Material* material) {
+	MeshCommand& command = m_meshes.emplace_back();
+	command.mesh = &mesh;
+	command.model = model;
+	command.color = color;
+	command.material = material;
+	command.firstBone = static_cast<uint32_t>(m_bones.size());
+	command.boneCount = static_cast<uint32_t>(palette.size());
+	m_bones.insert(m_bones.end(), palette.begin(), palette.end());
+}
+
+void
+RenderCommandBuffer::drawSkinnedInstances(const Mesh& mesh, const BakedAnimation& animation,
+	std::span<const SkinnedInstance> instances, sf::Color color, const Material* material) {
+	if (instances.empty()) {
+		return;
+	}
+	MeshCommand& command = m_meshes.emplace_back();
+	command.mesh = &mesh;
+	command.model = instances.front().model;
+	command.color = color;
+	command.material = material;
+	command.baked = &animation;
+	command.firstInstance = static_cast<uint32_t>(m_skinnedInstances.size());
+	command.instanceCount = static_cast<uint32_t>(instances.size());
+	m_skinnedInstances.insert(m_skinnedInstances.end(), instances.begin(), instances.end());
+}
+
+void
+RenderCommandBuffer::draw(const sf::Drawable& geometry, const sf::Transform& transform, const DrawState& state) {
+	DrawCommand& command = m_commands.emplace_back();
+	command.geometry = &geometry;
+	command.transform = transform;
+	command.texture = state.texture;
+	command.shader = state.shader;
+	command.blendMode = state.blendMode;
+	command.sortKey = sortKeyOf(state);
+	m_sorted = false;
+}
+
+void
+RenderCommandBuffer::draw(const sf::Shape& shape, const sf::Transform& transform, const DrawState& state,
+	std::span<const sf::Vector2f> outline) {
+	draw(static_cast<const sf::Drawable&>(shape), transform, state);
+	DrawCommand& command = m_commands.back();
+	command.shape = &shape;
+	command.color = shape.getFillColor();
+	command.outline = outline.data();
+	command.outlineCount = static_cast<uint32_t>(outline.size());
+}
+
+void
+RenderCommandBuffer::drawShared(const sf::Shape& shape, const sf::Transform& transform, sf::Color color, uint8_t layer,
+	std::span<const sf::Vector2f> outline) {
+	DrawState state;
+	state.layer = layer;
+	state.texture = shape.getTexture();
+	draw(shape, transform, state, outline);
+	DrawCommand& command = m_commands.back();
+	command.color = color;
+	command.sharedShape = true;
+}
+
+void
+RenderCommandBuffer::drawSprite(const sf::Shape& square, const sf::Transform& transform, const sf::Texture* texture,
+	const sf::IntRect& textureRect, sf::Color color, uint8_t layer, std::span<const sf::Vector2f> outline) {
+	DrawState state;
+	state.layer = layer;
+	state.texture = texture;
+	draw(square, transform, state, outline);
+	DrawCommand& command = m_commands.back();
+	command.color = color;
+	command.sharedShape = true;
+	command.textureRect = textureRect;
+}
+
+void
+RenderCommandBuffer::append(const RenderCommandBuffer& other) {
+	if (other.m_commands.empty() && other.m_meshes.empty() && other.m_lights.empty() && !other.m_hasCamera) {
+		return;
+	}
+	m_commands.insert(m_commands.end(), other.m_commands.begin(), other.m_commands.end());
+
+	// Las mallas con piel apuntan a sus paletas e instancias, que quedan ms adelante aqu
+	uint32_t boneBase = static_cast<uint32_t>(m_bones.size());
+	uint32_t instanceBase = static_cast<uint32_t>(m_skinnedInstances.size());
+	for (const MeshCommand& mesh : other.m_meshes) {
+		MeshCommand& copy = m_meshes.emplace_back(mesh);
+		if (copy.boneCount != 0) {
+			copy.firstBone += boneBase;
+		}
+		if (copy.baked) {
+			copy.firstInstance += instanceBase;
+		}
+	}
+	m_bones.insert(m_bones.end(), other.m_bones.begin(), other.m_bones.end());
+	m_skinnedInstances.insert(m_skinnedInstances.end(), other.m_skinnedInstances.begin(), other.m_skinnedInstances.end());
+	m_lights.insert(m_lights.end(), other.m_lights.begin(), other.m_lights.end());
+	if (other.m_hasCamera) {
+		setCamera(other.m_camera);
+	}
+	m_sorted = false;
+}
+
+void
+RenderCommandBuffer::sort(JobSystem* jobs) {
+	if (m_sorted) {
+		return;
+	}
+	// Se ordenan claves de 8 bytes con su ndice, no comandos de 100
+	size_t count = m_commands.size();
+	m_keys.resize(count);
+	m_order.resize(count);
+	m_scratchKeys.resize(count);
+	m_scratchOrder.resize(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		m_keys[i] = m_commands[i].sortKey;
+		m_order[i] = i;
+	}
+
+	// Los ocho histogramas en una sola lectura de las claves
+	std::array<std::array<uint32_t, 256>, 8> histograms{};
+	for (uint64_t key : m_keys) {
+		for (unsigned pass = 0; pass < 8; ++pass) {
+			++histograms[pass][(key >> (pass * 8)) & 0xFF];
+		}
+	}
+
+	size_t chunks = (count + kSortChunk - 1) / kSortChunk;
+	bool parallel = jobs && jobs->activeWorkers() > 0 && chunks > 1;
+	if (parallel) {
+		m_chunkOffsets.resize(chunks);
+	}
+	auto scatter = [this](size_t begin, size_t end, unsigned shift, std::array<uint32_t, 256>& offsets) {
+		for (size_t i = begin; i < end; ++i) {
+			uint32_t slot = offsets[(m_keys[i] >> shift) & 0xFF]++;
+			m_scratchKeys[slot] = m_keys[i];
+			m_scratchOrder[slot] = m_order[i];
+		}
+	};
+
+	// LSD: cada pasada es estable, as que a igual clave queda el orden de llegada
+	for (unsigned pass = 0; pass < 8; ++pass) {
+		std::array<uint32_t, 256>& histogram = histograms[pass];
+		unsigned shift = pass * 8;
+		if (count == 0 || histogram[(m_keys[0] >> shift) & 0xFF] == count) {
+			continue;
+		}
+		if (!parallel) {
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram) {
+				uint32_t size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+			scatter(0, count, shift, histogram);
+		}
+		else {
+			// Cada trozo cuenta los suyos; en cada cubeta van despus de los de los trozos anteriores
+			jobs->parallelFor(chunks, 1, [this, count, shift](size_t first, size_t last) {
+				for (size_t chunk = first; chunk < last; ++chunk) {
+					std::array<uint32_t, 256>& counts = m_chunkOffsets[chunk];
+					counts.fill(0);
+					size_t end = std::min(count, (chunk + 1) * kSortChunk);
+					for (size_t i = chunk * kSortChunk; i < end; ++i) {
+						++counts[(m_keys[i] >> shift) & 0xFF];
+					}
+				}
+			});
+			uint32_t offset = 0;
+			for (size_t bucket = 0; bucket < 256; ++bucket) {
+				for (std::array<uint32_t, 256>& counts : m_chunkOffsets) {
+					uint32_t size = counts[bucket];
+					counts[bucket] = offset;
+					offset += size;
+				}
+			}
+			jobs->parallelFor(chunks, 1, [this, count, shift, &scatter](size_t first, size_t last) {
+				for (size_t chunk = first; chunk < last; ++chunk) {
+					scatter(chunk * kSortChunk, std::min(count, (chunk + 1) * kSortChunk), shift, m_chunkOffsets[chunk]);
+				}
+			});
+		}
+		m_keys.swap(m_scratchKeys);
+		m_order.swap(m_scratchOrder);
+	}
+	m_sorted = true;
+}
+
+void
+RenderCommandBuffer::copyShapes() {
+	// Primero se cuentan: los vectores no deben crecer mientras los comandos apuntan a ellos
+	size_t circles = 0, rectangles = 0, convexShapes = 0;
+	for (const DrawCommand& command : m_commands) {
+		if (command.shape && !command.sharedShape) {
+			const std::type_info& type = typeid(*command.shape);
+			circles += type == typeid(sf::CircleShape);
+			rectangles += type == typeid(sf::RectangleShape);
+			convexShapes += type == typeid(sf::ConvexShape);
+		}
+	}
+	m_circles.resize(std::max(m_circles.size(), circles));
+	m_rectangles.resize(std::max(m_rectangles.size(), rectangles));
+	m_convexShapes.resize(std::max(m_convexShapes.size(), convexShapes));
+
+	// Asignar sobre copias viejas reutiliza sus arreglos de vrtices
+	circles = rectangles = convexShapes = 0;
+	for (DrawCommand& command : m_commands) {
+		if (!command.shape || command.sharedShape) {
+			continue;
+		}
+		const std::type_info& type = typeid(*command.shape);
+		const sf::Shape* copy = command.shape;
+		if (type == typeid(sf::CircleShape)) {
+			copy = &(m_circles[circles++] = static_cast<const sf::CircleShape&>(*command.shape));
+		}
+		else if (type == typeid(sf::RectangleShape)) {
+			copy = &(m_rectangles[rectangles++] = static_cast<const sf::RectangleShape&>(*command.shape));
+		}
+		else if (type == typeid(sf::ConvexShape)) {
+			copy = &(m_convexShapes[convexShapes++] = static_cast<const sf::ConvexShape&>(*command.shape));
+		}
+		command.shape = copy;
+		command.geometry = copy;
+	}
+}
+
+void
+RenderCommandBuffer::clear() {
+	m_commands.clear();
+	m_meshes.clear();
+	m_lights.clear();
+	m_bones.clear();
+	m_skinnedInstances.clear();
+	m_hasCamera = false;
+	m_sun = DirectionalLightData{};
+	m_order.clear();
+	m_sorted = false;
+}
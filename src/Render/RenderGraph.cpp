@@ -0,0 +1,222 @@
+#include "Render/RenderGraph.h"
+#include <algorithm>
+#include "Render/RenderTargetPool.h"
+
+sf::RenderTarget&
+RenderGraph::PassContext::target(ResourceId resource) const {
+	Resource& entry = m_graph.m_resources[resource];
+	if (entry.kind == Kind::Target) {
+		return *entry.target;
+	}
+	return *entry.physical;
+}
+
+const sf::Texture&
+RenderGraph::PassContext::texture(ResourceId resource) const {
+	const Resource& entry = m_graph.m_resources[resource];
+	if (entry.kind == Kind::Texture) {
+		return *entry.texture;
+	}
+	return entry.physical->getTexture();
+}
+
+RenderGraph::PassBuilder&
+RenderGraph::PassBuilder::read(ResourceId resource) {
+	m_graph.addAccess(m_pass, resource, false);
+	return *this;
+}
+
+RenderGraph::PassBuilder&
+RenderGraph::PassBuilder::write(ResourceId resource) {
+	m_graph.addAccess(m_pass, resource, true);
+	return *this;
+}
+
+void
+RenderGraph::reset() {
+	m_resources.clear();
+	m_passes.clear();
+	m_accesses.clear();
+}
+
+RenderGraph::ResourceId
+RenderGraph::importTarget(const char* name, sf::RenderTarget& target) {
+	Resource resource;
+	resource.name = name;
+	resource.kind = Kind::Target;
+	resource.size = target.getSize();
+	resource.target = &target;
+	return addResource(resource);
+}
+
+RenderGraph::ResourceId
+RenderGraph::importTexture(const char* name, const sf::Texture& texture) {
+	Resource resource;
+	resource.name = name;
+	resource.kind = Kind::Texture;
+	resource.size = texture.getSize();
+	resource.texture = &texture;
+	resource.written = true;
+	return addResource(resource);
+}
+
+RenderGraph::ResourceId
+RenderGraph::createTexture(const char* name, sf::Vector2u size) {
+	Resource resource;
+	resource.name = name;
+	resource.kind = Kind::Transient;
+	resource.size = size;
+	return addResource(resource);
+}
+
+sf::Vector2u
+RenderGraph::size(ResourceId resource) const {
+	return m_resources[resource].size;
+}
+
+size_t
+RenderGraph::transientCount() const {
+	size_t count = 0;
+	for (const Resource& resource : m_resources) {
+		count += resource.kind == Kind::Transient;
+	}
+	return count;
+}
+
+RenderGraph::ResourceId
+RenderGraph::addResource(Resource resource) {
+	m_resources.push_back(resource);
+	return static_cast<ResourceId>(m_resources.size() - 1);
+}
+
+uint32_t
+RenderGraph::beginPass(const char* name, Execute execute) {
+	Pass pass;
+	pass.name = name;
+	pass.execute = std::move(execute);
+	pass.firstAccess = static_cast<uint32_t>(m_accesses.size());
+	m_passes.push_back(std::move(pass));
+	return static_cast<uint32_t>(m_passes.size() - 1);
+}
+
+void
+RenderGraph::addAccess(uint32_t pass, ResourceId resource, bool write) {
+	if (resource >= m_resources.size()) {
+		MESSAGE("RenderGraph", "addAccess", "a pass used a resource that does not exist");
+		return;
+	}
+	m_accesses.push_back(Access{ resource, write });
+	++m_passes[pass].accessCount;
+}
+
+void
+RenderGraph::cull() {
+	// Un pase que lee una transitoria sin escribir no tiene de dnde leer
+	std::vector<bool>& readable = m_readable;
+	readable.assign(m_resources.size(), false);
+	for (size_t i = 0; i < m_resources.size(); ++i) {
+		readable[i] = m_resources[i].kind != Kind::Transient;
+	}
+	std::vector<bool>& valid = m_valid;
+	valid.assign(m_passes.size(), true);
+	for (size_t p = 0; p < m_passes.size(); ++p) {
+		const Pass& pass = m_passes[p];
+		for (uint32_t a = pass.firstAccess; a < pass.firstAccess + pass.accessCount; ++a) {
+			if (!m_accesses[a].write && !readable[m_accesses[a].resource]) {
+				valid[p] = false;
+			}
+		}
+		for (uint32_t a = pass.firstAccess; valid[p] && a < pass.firstAccess + pass.accessCount; ++a) {
+			if (m_accesses[a].write) {
+				readable[m_accesses[a].resource] = true;
+			}
+		}
+	}
+
+	// Del ltimo al primero: vive quien escribe algo que se necesita, y lo que lee se necesita
+	for (Resource& resource : m_resources) {
+		resource.needed = resource.kind == Kind::Target;
+	}
+	m_culled = 0;
+	for (size_t p = m_passes.size(); p-- > 0;) {
+		Pass& pass = m_passes[p];
+		pass.alive = false;
+		for (uint32_t a = pass.firstAccess; valid[p] && a < pass.firstAccess + pass.accessCount; ++a) {
+			if (m_accesses[a].write && m_resources[m_accesses[a].resource].needed) {
+				pass.alive = true;
+			}
+		}
+		if (!pass.alive) {
+			++m_culled;
+			continue;
+		}
+		for (uint32_t a = pass.firstAccess; a < pass.firstAccess + pass.accessCount; ++a) {
+			if (!m_accesses[a].write) {
+				m_resources[m_accesses[a].resource].needed = true;
+			}
+		}
+	}
+
+	// Vida de cada transitoria entre los pases que quedan
+	for (Resource& resource : m_resources) {
+		resource.firstPass = ~uint32_t(0);
+		resource.lastPass = 0;
+	}
+	for (uint32_t p = 0; p < m_passes.size(); ++p) {
+		const Pass& pass = m_passes[p];
+		if (!pass.alive) {
+			continue;
+		}
+		for (uint32_t a = pass.firstAccess; a < pass.firstAccess + pass.accessCount; ++a) {
+			Resource& resource = m_resources[m_accesses[a].resource];
+			resource.firstPass = std::min(resource.firstPass, p);
+			resource.lastPass = std::max(resource.lastPass, p);
+		}
+	}
+}
+
+void
+RenderGraph::execute() {
+	cull();
+	PassContext context(*this);
+	size_t live = 0;
+	m_peakTransients = 0;
+	for (uint32_t p = 0; p < m_passes.size(); ++p) {
+		Pass& pass = m_passes[p];
+		if (!pass.alive) {
+			continue;
+		}
+		bool ready = true;
+		for (uint32_t a = pass.firstAccess; a < pass.firstAccess + pass.accessCount; ++a) {
+			Resource& resource = m_resources[m_accesses[a].resource];
+			if (resource.kind == Kind::Transient && resource.firstPass == p && !resource.physical) {
+				resource.physical = m_pool.acquire(resource.size);
+				live += resource.physical != nullptr;
+			}
+			if (resource.kind == Kind::Transient && !resource.physical) {
+				ready = false;
+			}
+		}
+		m_peakTransients = std::max(m_peakTransients, live);
+
+		// Sin su textura el pase no corre; quien la lea despus tampoco tendr nada
+		if (ready) {
+			pass.execute(context);
+		}
+		for (uint32_t a = pass.firstAccess; a < pass.firstAccess + pass.accessCount; ++a) {
+			Resource& resource = m_resources[m_accesses[a].resource];
+			if (resource.kind != Kind::Transient || !resource.physical) {
+				continue;
+			}
+			if (m_accesses[a].write) {
+				resource.physical->display();
+			}
+			if (resource.lastPass == p) {
+				m_pool.release(resource.physical);
+				resource.physical = nullptr;
+				--live;
+			}
+		}
+	}
+	m_pool.endFrame();
+}
@@ -0,0 +1,56 @@
+#include "Render/RenderStats.h"
+
+RenderStatsCounter&
+RenderStatsCounter::current() {
+	thread_local RenderStatsCounter t_counter;
+	return t_counter;
+}
+
+void
+RenderStatsCounter::countDraw(size_t vertices, const sf::Texture* texture, const sf::Shader* shader,
+	const sf::BlendMode& blendMode, uint32_t glProgram) {
+	++m_frame.drawCalls;
+	m_frame.vertices += vertices;
+	bool textureChanged = !m_hasLast || texture != m_lastTexture;
+	if (textureChanged || shader != m_lastShader || blendMode != m_lastBlendMode || glProgram != m_lastProgram) {
+		++m_frame.stateChanges;
+	}
+	if (textureChanged && texture) {
+		++m_frame.textureBinds;
+	}
+	m_lastTexture = texture;
+	m_lastShader = shader;
+	m_lastBlendMode = blendMode;
+	m_lastProgram = glProgram;
+	m_hasLast = true;
+}
+
+RenderStats
+RenderStatsCounter::endFrame() {
+	RenderStats finished = m_frame;
+	m_frame = RenderStats();
+	m_hasLast = false;
+	return finished;
+}
+
+size_t
+RenderStatsCounter::vertexCount(const sf::Drawable& drawable) {
+	// Como las dibuja SFML: abanico de relleno y tira de contorno
+	if (const sf::Shape* shape = dynamic_cast<const sf::Shape*>(&drawable)) {
+		size_t points = shape->getPointCount();
+		return points + 2 + (shape->getOutlineThickness() != 0.0f ? (points + 1) * 2 : 0);
+	}
+	if (dynamic_cast<const sf::Sprite*>(&drawable)) {
+		return 4;
+	}
+	if (const sf::VertexArray* array = dynamic_cast<const sf::VertexArray*>(&drawable)) {
+		return array->getVertexCount();
+	}
+	if (const sf::VertexBuffer* buffer = dynamic_cast<const sf::VertexBuffer*>(&drawable)) {
+		return buffer->getVertexCount();
+	}
+	if (const sf::Text* text = dynamic_cast<const sf::Text*>(&drawable)) {
+		return text->getString().getSize() * 6;
+	}
+	return 0;
+}
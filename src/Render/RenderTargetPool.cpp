@@ -0,0 +1,49 @@
+#include "Render/RenderTargetPool.h"
+#include <algorithm>
+
+sf::RenderTexture*
+RenderTargetPool::acquire(sf::Vector2u size) {
+	if (size.x == 0 || size.y == 0) {
+		return nullptr;
+	}
+	for (Entry& entry : m_entries) {
+		if (!entry.inUse && entry.size == size) {
+			entry.inUse = true;
+			entry.lastUsed = m_frame;
+			return entry.target.get();
+		}
+	}
+
+	EngineUtilities::TUniquePtr<sf::RenderTexture> target = EngineUtilities::MakeUnique<sf::RenderTexture>();
+	if (!target->create(size.x, size.y)) {
+		MESSAGE("RenderTargetPool", "acquire", "could not create an intermediate render texture");
+		return nullptr;
+	}
+	target->setSmooth(true);
+	++m_created;
+	Entry entry;
+	entry.target = std::move(target);
+	entry.size = size;
+	entry.lastUsed = m_frame;
+	entry.inUse = true;
+	m_entries.push_back(std::move(entry));
+	return m_entries.back().target.get();
+}
+
+void
+RenderTargetPool::release(sf::RenderTexture* target) {
+	for (Entry& entry : m_entries) {
+		if (entry.target.get() == target) {
+			entry.inUse = false;
+			return;
+		}
+	}
+}
+
+void
+RenderTargetPool::endFrame() {
+	++m_frame;
+	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [this](const Entry& entry) {
+		return !entry.inUse && m_frame - entry.lastUsed > kIdleFrames;
+	}), m_entries.end());
+}
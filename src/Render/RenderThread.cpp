@@ -0,0 +1,97 @@
+#include "Render/RenderThread.h"
+#include <chrono>
+#include "Render/StaticGeometryCache.h"
+#include "Window.h"
+#include "Profiling/Profiler.h"
+
+void
+RenderThread::start(Window& window) {
+	if (isRunning()) {
+		return;
+	}
+	m_window = &window;
+	m_stop = false;
+	m_pending = -1;
+	m_submitting = false;
+
+	// Un contexto solo puede estar activo en un hilo
+	window.presentTarget().setActive(false);
+	m_thread = std::thread([this]() { loop(); });
+}
+
+void
+RenderThread::stop() {
+	if (!isRunning()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_one();
+	m_thread.join();
+	m_window->presentTarget().setActive(true);
+}
+
+RenderThread::Frame&
+RenderThread::acquireFrame() {
+	auto start = std::chrono::steady_clock::now();
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.wait(lock, [this]() { return m_pending == -1 && !m_submitting; });
+	}
+	m_lastWaitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	Frame& frame = m_frames[m_writeIndex];
+	frame.commands.clear();
+	return frame;
+}
+
+void
+RenderThread::submitFrame() {
+	// Todo lo que lee de los componentes, en este hilo
+	m_frames[m_writeIndex].commands.copyShapes();
+	if (StaticGeometryCache* cache = EngineUtilities::TService<StaticGeometryCache>::get()) {
+		cache->prepare();
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending = m_writeIndex;
+	}
+	m_wake.notify_one();
+	m_writeIndex ^= 1;
+}
+
+void
+RenderThread::loop() {
+	sf::RenderTarget& target = m_window->presentTarget();
+	target.setActive(true);
+	Profiler::instance().setThreadName("Render");
+	for (;;) {
+		int index;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this]() { return m_pending != -1 || m_stop; });
+			if (m_pending == -1) {
+				break;
+			}
+			index = m_pending;
+			m_pending = -1;
+			m_submitting = true;
+		}
+
+		Frame& frame = m_frames[index];
+		// `clear` puede cambiar el destino de la escena (`Window::postProcess`)
+		m_window->clear();
+		m_window->getTarget().setView(frame.views.front());
+		m_window->submit(frame.commands, frame.views);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_submitting = false;
+		}
+		m_idle.notify_one();
+
+		// La espera del vsync ya no frena a la simulacin
+		m_window->display();
+	}
+	target.setActive(false);
+}
@@ -0,0 +1,212 @@
+#include "Render/SdfShapeRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <typeinfo>
+#include "Render/GlFunctions.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/RenderStats.h"
+#include "Render/ShaderCache.h"
+#include "Render/ShapeBatcher.h"
+
+namespace {
+
+	// Atributos: 0 esquina del quad; 1 y 2 filas de la matriz; 3 radio, margen y lados; 4 color
+	const char* kVertexShader = R"(#version 330
+layout(location = 0) in vec2 a_corner;
+layout(location = 1) in vec3 a_row0;
+layout(location = 2) in vec3 a_row1;
+layout(location = 3) in vec3 a_shape;
+layout(location = 4) in vec4 a_color;
+uniform mat4 u_view;
+out vec2 v_local;
+flat out vec2 v_shape;
+out vec4 v_color;
+void main() {
+	float radius = a_shape.x;
+	v_local = a_corner * (radius + a_shape.y);
+	vec3 local = vec3(v_local + vec2(radius), 1.0);
+	gl_Position = u_view * vec4(dot(a_row0, local), dot(a_row1, local), 0.0, 1.0);
+	v_shape = vec2(radius, a_shape.z);
+	v_color = a_color;
+}
+)";
+
+	// Distancia con signo al borde; `fwidth` la pasa a pxeles para la cobertura
+	const char* kFragmentShader = R"(#version 330
+in vec2 v_local;
+flat in vec2 v_shape;
+in vec4 v_color;
+out vec4 o_color;
+void main() {
+	float radius = v_shape.x;
+	float sides = v_shape.y;
+	float edgeDistance;
+	if (sides < 3.0) {
+		edgeDistance = length(v_local) - radius;
+	}
+	else {
+		// ngulo desde el primer vrtice, arriba (y local hacia abajo, como SFML)
+		float halfAngle = 3.14159265 / sides;
+		float angle = atan(v_local.x, -v_local.y);
+		float edge = mod(angle, 2.0 * halfAngle) - halfAngle;
+		edgeDistance = length(v_local) * cos(edge) - radius * cos(halfAngle);
+	}
+	float coverage = clamp(0.5 - edgeDistance / max(fwidth(edgeDistance), 1e-5), 0.0, 1.0);
+	if (coverage <= 0.0) {
+		discard;
+	}
+	o_color = vec4(v_color.rgb, v_color.a * coverage);
+}
+)";
+
+	/**
+	 * @brief Capa y profundidad de un comando (los 24 bits altos de su clave).
+	 */
+	uint32_t
+	depthOf(const DrawCommand& command) { return static_cast<uint32_t>(command.sortKey >> 40); }
+
+} // namespace
+
+bool
+SdfShapeRenderer::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions()) {
+		return false;
+	}
+	GLuint program = EngineUtilities::TService<ShaderCache>::instance().program(kVertexShader, kFragmentShader);
+	if (!program) {
+		return false;
+	}
+	m_program = program;
+	m_viewLocation = gl.getUniformLocation(program, "u_view");
+
+	if (!m_instances.initialize()) {
+		return false;
+	}
+	GLuint vertexArray = 0;
+	GLuint quadBuffer = 0;
+	gl.genVertexArrays(1, &vertexArray);
+	gl.genBuffers(1, &quadBuffer);
+	m_vertexArray = vertexArray;
+	m_quadBuffer = quadBuffer;
+
+	// El quad, en tira; los atributos por instancia cambian de lugar con cada `flush`
+	const float quad[8] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+	gl.bindVertexArray(vertexArray);
+	gl.bindBuffer(kGlArrayBuffer, m_quadBuffer);
+	gl.bufferData(kGlArrayBuffer, sizeof(quad), quad, kGlStaticDraw);
+	gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+	gl.enableVertexAttribArray(0);
+	for (GLuint attribute = 1; attribute <= 4; ++attribute) {
+		gl.enableVertexAttribArray(attribute);
+		gl.vertexAttribDivisor(attribute, 1);
+	}
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+	return true;
+}
+
+void
+SdfShapeRenderer::release() {
+	if (!isInitialized()) {
+		return;
+	}
+	GLuint quadBuffer = m_quadBuffer;
+	GLuint vertexArray = m_vertexArray;
+	gl.deleteBuffers(1, &quadBuffer);
+	gl.deleteVertexArrays(1, &vertexArray);
+	m_instances.release();
+	// El programa es de `ShaderCache`, que lo borra en `release`
+	m_program = 0;
+	m_vertexArray = 0;
+	m_quadBuffer = 0;
+}
+
+bool
+SdfShapeRenderer::isSdfShape(const DrawCommand& command) {
+	return command.shape && typeid(*command.shape) == typeid(sf::CircleShape) && !command.texture && !command.shader &&
+	       command.blendMode == sf::BlendAlpha && ShapeBatcher::isBatchable(command) && !command.shape->getTexture();
+}
+
+void
+SdfShapeRenderer::submit(sf::RenderTarget& target, RenderCommandBuffer& commands, ShapeBatcher& batcher) {
+	m_drawCalls = 0;
+	m_shapeTotal = 0;
+	m_instances.beginFrame();
+	batcher.begin();
+	commands.sort();
+	float pixelScale = commands.pixelScale() > 0.0f ? commands.pixelScale() : 1.0f;
+	uint32_t depth = 0;
+	commands.forEach([&](const DrawCommand& command) {
+		// Capa o profundidad nueva: lo de la anterior se dibuja antes
+		if (depthOf(command) != depth) {
+			batcher.end(target);
+			flush(target);
+			depth = depthOf(command);
+		}
+		if (!isSdfShape(command)) {
+			batcher.add(target, command);
+			return;
+		}
+		const sf::CircleShape& circle = static_cast<const sf::CircleShape&>(*command.shape);
+		const float* m = (command.transform * circle.getTransform()).getMatrix();
+		float scale = std::sqrt(std::max(m[0] * m[0] + m[1] * m[1], m[4] * m[4] + m[5] * m[5]));
+		size_t points = circle.getPointCount();
+
+		Instance& instance = m_pending.emplace_back();
+		instance.row0[0] = m[0];
+		instance.row0[1] = m[4];
+		instance.row0[2] = m[12];
+		instance.row1[0] = m[1];
+		instance.row1[1] = m[5];
+		instance.row1[2] = m[13];
+		instance.radius = circle.getRadius();
+		instance.margin = kEdgeMarginPixels / std::max(scale * pixelScale, 1e-6f);
+		instance.sides = points < kMinCirclePoints ? static_cast<float>(points) : 0.0f;
+		sf::Color color = command.color;
+		instance.color[0] = color.r;
+		instance.color[1] = color.g;
+		instance.color[2] = color.b;
+		instance.color[3] = color.a;
+	});
+	batcher.end(target);
+	flush(target);
+}
+
+void
+SdfShapeRenderer::flush(sf::RenderTarget& target) {
+	if (m_pending.empty()) {
+		return;
+	}
+
+	// SFML guarda y restaura su estado alrededor del OpenGL propio
+	target.pushGLStates();
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl.useProgram(m_program);
+	gl.uniformMatrix4fv(m_viewLocation, 1, GL_FALSE, target.getView().getTransform().getMatrix());
+	gl.bindVertexArray(m_vertexArray);
+
+	// A continuacin de lo ya escrito en el frame: ni hurfano ni espera
+	size_t offset = m_instances.write(m_pending.data(), m_pending.size() * sizeof(Instance));
+	const char* base = reinterpret_cast<const char*>(offset);
+	gl.vertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), base + offsetof(Instance, row0));
+	gl.vertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), base + offsetof(Instance, row1));
+	gl.vertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), base + offsetof(Instance, radius));
+	gl.vertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), base + offsetof(Instance, color));
+	gl.drawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(m_pending.size()));
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	stats.countUpload(m_pending.size() * sizeof(Instance));
+	stats.countDraw(4 * m_pending.size(), nullptr, nullptr, sf::BlendAlpha, m_program);
+	++m_drawCalls;
+	m_shapeTotal += m_pending.size();
+	m_pending.clear();
+
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+	gl.useProgram(0);
+	target.popGLStates();
+}
@@ -0,0 +1,266 @@
+#include "Render/ShaderCache.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "Scene/MappedFile.h"
+
+namespace {
+
+	constexpr uint32_t kBinaryMagic = 0x42505347; // "GSPB"
+	constexpr uint64_t kFnvOffset = 0xCBF29CE484222325ull;
+	constexpr uint64_t kSfmlShaderSeed = 1;       ///< Los `sf::Shader` no dependen del driver.
+	constexpr std::string_view kComputeStage = "compute"; ///< En lugar de la fuente de fragmentos, en la clave.
+
+	/**
+	 * @brief Cabecera de un binario en disco; le siguen `length` bytes del driver.
+	 */
+	struct ShaderBinaryHeader {
+		uint32_t magic;
+		uint32_t format;   ///< `binaryFormat` de `glGetProgramBinary`.
+		uint64_t key;      ///< Debe coincidir con el nombre del archivo.
+		uint32_t length;
+		uint32_t reserved;
+	};
+	static_assert(sizeof(ShaderBinaryHeader) == 24, "Disposicin del binario cambiada");
+
+	uint64_t
+	fnv1a(uint64_t hash, std::string_view text) {
+		for (char c : text) {
+			hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+		}
+		// Separador: "ab" + "c" no debe valer lo mismo que "a" + "bc"
+		return (hash ^ 0xFF) * 0x100000001B3ull;
+	}
+
+	std::string_view
+	glText(GLenum name) {
+		const GLubyte* text = glGetString(name);
+		return text ? std::string_view(reinterpret_cast<const char*>(text)) : std::string_view();
+	}
+
+} // namespace
+
+ShaderCache::~ShaderCache() {
+	waitPrecompile();
+}
+
+uint64_t
+ShaderCache::hashSources(uint64_t seed, std::string_view defines, std::string_view vertexSource,
+	std::string_view fragmentSource) {
+	return fnv1a(fnv1a(fnv1a(seed, defines), vertexSource), fragmentSource);
+}
+
+std::string
+ShaderCache::withDefines(std::string_view source, std::string_view defines) {
+	if (defines.empty()) {
+		return std::string(source);
+	}
+	size_t insertAt = 0;
+	if (source.substr(0, 8) == "#version") {
+		size_t lineEnd = source.find('\n');
+		insertAt = lineEnd == std::string_view::npos ? source.size() : lineEnd + 1;
+	}
+	std::string result;
+	result.reserve(source.size() + defines.size() + 1);
+	result.append(source.substr(0, insertAt));
+	if (insertAt == source.size() && insertAt != 0) {
+		result += '\n';
+	}
+	result.append(defines);
+	if (defines.back() != '\n') {
+		result += '\n';
+	}
+	result.append(source.substr(insertAt));
+	return result;
+}
+
+uint64_t
+ShaderCache::keyOf(uint64_t seed, const Variant& variant) {
+	if (variant.computeSource) {
+		return hashSources(seed, variant.defines, variant.computeSource, kComputeStage);
+	}
+	return hashSources(seed, variant.defines, variant.vertexSource, variant.fragmentSource);
+}
+
+GLuint
+ShaderCache::program(const char* vertexSource, const char* fragmentSource, std::string_view defines) {
+	Variant variant{ vertexSource, fragmentSource, std::string(defines) };
+	return find(variant, keyOf(driverSeed(), variant), false);
+}
+
+GLuint
+ShaderCache::computeProgram(const char* source, std::string_view defines) {
+	Variant variant{ nullptr, nullptr, std::string(defines), source };
+	return find(variant, keyOf(driverSeed(), variant), false);
+}
+
+void
+ShaderCache::precompile(std::vector<Variant> variants) {
+	waitPrecompile();
+	m_precompiler = std::thread([this, variants = std::move(variants)]() {
+		// Un contexto propio, compartido con los de la ventana por SFML
+		sf::Context context;
+		if (!loadGlFunctions()) {
+			return;
+		}
+		uint64_t seed = driverSeed();
+		for (const Variant& variant : variants) {
+			find(variant, keyOf(seed, variant), true);
+		}
+	});
+}
+
+void
+ShaderCache::waitPrecompile() {
+	if (m_precompiler.joinable()) {
+		m_precompiler.join();
+	}
+}
+
+GLuint
+ShaderCache::find(const Variant& variant, uint64_t key, bool finish) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto [found, added] = m_programs.try_emplace(key);
+	Entry& entry = found->second;
+	if (!added) {
+		m_built.wait(lock, [&entry]() { return !entry.building; });
+		return entry.program;
+	}
+
+	// Compilar sin el candado: los dems programas siguen disponibles
+	lock.unlock();
+	GLuint program = build(variant, key);
+	if (finish) {
+		glFinish();
+	}
+	lock.lock();
+	entry.program = program;
+	entry.building = false;
+	m_built.notify_all();
+	return program;
+}
+
+GLuint
+ShaderCache::build(const Variant& variant, uint64_t key) {
+	if (!loadGlFunctions()) {
+		return 0;
+	}
+	bool binaries = !m_directory.empty() && hasGlProgramBinaries();
+	if (binaries) {
+		GLuint program = gl.createProgram();
+		if (loadBinary(program, key)) {
+			m_binaryLoads.fetch_add(1, std::memory_order_relaxed);
+			return program;
+		}
+		gl.deleteProgram(program);
+	}
+
+	GLuint program = 0;
+	if (variant.computeSource) {
+		std::string compute = withDefines(variant.computeSource, variant.defines);
+		program = linkGlComputeProgram(compute.c_str(), binaries);
+	}
+	else {
+		std::string vertex = withDefines(variant.vertexSource, variant.defines);
+		std::string fragment = withDefines(variant.fragmentSource, variant.defines);
+		program = linkGlProgram(vertex.c_str(), fragment.c_str(), binaries);
+	}
+	if (!program) {
+		MESSAGE("ShaderCache", "build", "a shader program did not compile");
+		return 0;
+	}
+	m_compiles.fetch_add(1, std::memory_order_relaxed);
+	if (binaries) {
+		saveBinary(program, key);
+	}
+	return program;
+}
+
+bool
+ShaderCache::loadBinary(GLuint program, uint64_t key) {
+	MappedFile file;
+	if (!file.open(binaryPath(key)) || file.size() < sizeof(ShaderBinaryHeader)) {
+		return false;
+	}
+	ShaderBinaryHeader header;
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (header.magic != kBinaryMagic || header.key != key || header.length != file.size() - sizeof(header)) {
+		return false;
+	}
+	gl.programBinary(program, header.format, file.data() + sizeof(header), static_cast<GLsizei>(header.length));
+	GLint linked = 0;
+	gl.getProgramiv(program, kGlLinkStatus, &linked);
+	return linked != 0;
+}
+
+void
+ShaderCache::saveBinary(GLuint program, uint64_t key) {
+	GLint length = 0;
+	gl.getProgramiv(program, kGlProgramBinaryLength, &length);
+	if (length <= 0) {
+		return;
+	}
+	std::vector<char> bytes(static_cast<size_t>(length));
+	GLsizei written = 0;
+	GLenum format = 0;
+	gl.getProgramBinary(program, length, &written, &format, bytes.data());
+
+	// Sin carpeta o sin permiso solo se pierde el arranque rpido
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+	std::ofstream file(binaryPath(key), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		MESSAGE("ShaderCache", "saveBinary", "could not write a shader binary, the next start compiles it again");
+		return;
+	}
+	ShaderBinaryHeader header{ kBinaryMagic, format, key, static_cast<uint32_t>(written), 0 };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(bytes.data(), written);
+}
+
+std::string
+ShaderCache::binaryPath(uint64_t key) const {
+	char name[24];
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+	return (std::filesystem::path(m_directory) / name).string();
+}
+
+uint64_t
+ShaderCache::driverSeed() {
+	uint64_t seed = m_driverSeed.load(std::memory_order_relaxed);
+	if (seed == 0) {
+		seed = fnv1a(fnv1a(fnv1a(kFnvOffset, glText(GL_VENDOR)), glText(GL_RENDERER)), glText(GL_VERSION));
+		m_driverSeed.store(seed, std::memory_order_relaxed);
+	}
+	return seed;
+}
+
+sf::Shader*
+ShaderCache::shader(const std::string& vertexSource, const std::string& fragmentSource, std::string_view defines) {
+	uint64_t key = hashSources(kSfmlShaderSeed, defines, vertexSource, fragmentSource);
+	auto [found, added] = m_shaders.try_emplace(key);
+	if (added) {
+		EngineUtilities::TUniquePtr<sf::Shader> loaded = EngineUtilities::MakeUnique<sf::Shader>();
+		if (loaded->loadFromMemory(withDefines(vertexSource, defines), withDefines(fragmentSource, defines))) {
+			found->second = std::move(loaded);
+		}
+		else {
+			MESSAGE("ShaderCache", "shader", "an sf::Shader did not compile");
+		}
+	}
+	return found->second.get();
+}
+
+void
+ShaderCache::release() {
+	waitPrecompile();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& [key, entry] : m_programs) {
+		if (entry.program) {
+			gl.deleteProgram(entry.program);
+		}
+	}
+	m_programs.clear();
+	m_shaders.clear();
+}
@@ -0,0 +1,122 @@
+#include "Render/ShadowCascades.h"
+#include <algorithm>
+#include <cmath>
+#include "Render/RenderCommandBuffer.h"
+
+uint32_t
+ShadowCascades::update(const CameraUniforms& camera, const sf::Vector3f& direction, uint64_t staticKey) {
+	// Otra luz u otro conjunto esttico: ninguna caja ni nada guardado sirve
+	float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+	sf::Vector3f forward = length > 0.0f ? direction / length : sf::Vector3f(0.0f, 0.0f, -1.0f);
+	if (forward != m_direction || staticKey != m_staticKey) {
+		m_direction = forward;
+		m_staticKey = staticKey;
+		m_valid = 0;
+		sf::Vector3f up = std::abs(forward.z) < 0.9f ? sf::Vector3f(0.0f, 0.0f, 1.0f) : sf::Vector3f(0.0f, -1.0f, 0.0f);
+		m_lightView = Mat4::lookAt(sf::Vector3f(), forward, up);
+	}
+
+	// Planos de la cmara desde su proyeccin: en perspectiva w es la profundidad, si no es 1
+	const float* projection = camera.projection.data();
+	bool perspective = projection[11] != 0.0f;
+	float nearDepth = perspective ? projection[14] / (projection[10] - 1.0f) : (projection[14] + 1.0f) / projection[10];
+	float farDepth = perspective ? projection[14] / (projection[10] + 1.0f) : (projection[14] - 1.0f) / projection[10];
+	float endDepth = std::min(farDepth, m_maxDistance);
+	if (!(endDepth > nearDepth)) {
+		for (Cascade& cascade : m_cascades) {
+			cascade.split = nearDepth;
+		}
+		return 0;
+	}
+
+	// Esquinas de la pirmide de vista a la profundidad `depth`, en el mundo
+	Mat4 viewInverse = camera.view.inverseAffine();
+	auto corners = [&](float depth, sf::Vector3f* out) {
+		float z = -depth;
+		float w = projection[11] * z + projection[15];
+		for (int i = 0; i < 4; ++i) {
+			float sx = (i & 1) ? w : -w;
+			float sy = (i & 2) ? w : -w;
+			sf::Vector3f view((sx - projection[8] * z - projection[12]) / projection[0],
+				(sy - projection[9] * z - projection[13]) / projection[5], z);
+			out[i] = viewInverse.transformPoint(view);
+		}
+	};
+
+	uint32_t rebuilt = 0;
+	float sliceStart = nearDepth;
+	for (uint32_t i = 0; i < kCascades; ++i) {
+		Cascade& cascade = m_cascades[i];
+		float fraction = static_cast<float>(i + 1) / static_cast<float>(kCascades);
+		float uniform = nearDepth + (endDepth - nearDepth) * fraction;
+		float logarithmic = nearDepth > 0.0f ? nearDepth * std::pow(endDepth / nearDepth, fraction) : uniform;
+		cascade.split = m_splitBlend * logarithmic + (1.0f - m_splitBlend) * uniform;
+
+		// Esfera del tramo: la misma gire como gire la cmara
+		sf::Vector3f points[8];
+		corners(sliceStart, points);
+		corners(cascade.split, points + 4);
+		sliceStart = cascade.split;
+		sf::Vector3f center;
+		for (const sf::Vector3f& point : points) {
+			center += point;
+		}
+		center /= 8.0f;
+		float radius = 0.0f;
+		for (const sf::Vector3f& point : points) {
+			sf::Vector3f offset = point - center;
+			radius = std::max(radius, offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+		}
+		// Redondeado hacia arriba, as el ruido de coma flotante no la cambia entre frames
+		radius = std::ceil(std::sqrt(radius) * 16.0f) / 16.0f;
+		sf::Vector3f light = m_lightView.transformPoint(center);
+		float depth = -light.z;
+
+		bool valid = (m_valid >> i) & 1u;
+		if (valid && std::abs(light.x - cascade.center.x) + radius <= cascade.halfExtent &&
+			std::abs(light.y - cascade.center.y) + radius <= cascade.halfExtent && depth - radius >= cascade.nearDepth &&
+			depth + radius <= cascade.farDepth && cascade.halfExtent <= 2.0f * radius) {
+			continue;
+		}
+
+		// Caja nueva con margen, con el centro en la grilla de texels para que no tiemble
+		float half = std::max(radius, 1e-3f) * (1.0f + kMargin);
+		float texel = 2.0f * half / static_cast<float>(kResolution);
+		cascade.center = sf::Vector3f(std::floor(light.x / texel) * texel, std::floor(light.y / texel) * texel, light.z);
+		cascade.halfExtent = half;
+		cascade.nearDepth = depth - half;
+		cascade.farDepth = depth + half;
+		cascade.viewProjection = Mat4::orthographic(cascade.center.x - half, cascade.center.x + half,
+			cascade.center.y - half, cascade.center.y + half, cascade.nearDepth, cascade.farDepth) * m_lightView;
+		m_valid |= 1u << i;
+		rebuilt |= 1u << i;
+		++m_rebuilds;
+	}
+	return rebuilt;
+}
+
+Mat4
+ShadowCascades::shadowMatrix(uint32_t cascade) const {
+	// De [-1, 1] al cuadrante de la cascada, y la profundidad a [0, 1]
+	float x = 0.25f + 0.5f * static_cast<float>(cascade & 1u);
+	float y = 0.25f + 0.5f * static_cast<float>(cascade >> 1);
+	return Mat4::translation(x, y, 0.5f) * Mat4::scale(0.25f, 0.25f, 0.5f) * m_cascades[cascade].viewProjection;
+}
+
+bool
+ShadowCascades::overlaps(uint32_t cascade, const sf::Vector3f& boundsMin, const sf::Vector3f& boundsMax,
+	const Mat4& model) const {
+	// Ortogrfica: sin dividir por w
+	Mat4 toLight = m_cascades[cascade].viewProjection * model;
+	sf::Vector3f low(1e30f, 1e30f, 1e30f);
+	sf::Vector3f high(-1e30f, -1e30f, -1e30f);
+	for (int i = 0; i < 8; ++i) {
+		sf::Vector3f corner((i & 1) ? boundsMax.x : boundsMin.x, (i & 2) ? boundsMax.y : boundsMin.y,
+			(i & 4) ? boundsMax.z : boundsMin.z);
+		sf::Vector3f point = toLight.transformPoint(corner);
+		low = sf::Vector3f(std::min(low.x, point.x), std::min(low.y, point.y), std::min(low.z, point.z));
+		high = sf::Vector3f(std::max(high.x, point.x), std::max(high.y, point.y), std::max(high.z, point.z));
+	}
+	// Lo que queda antes del plano cercano s cuenta: se aplasta contra l
+	return high.x >= -1.0f && low.x <= 1.0f && high.y >= -1.0f && low.y <= 1.0f && low.z <= 1.0f;
+}
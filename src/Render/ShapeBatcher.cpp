@@ -0,0 +1,246 @@
+#include "Render/ShapeBatcher.h"
+#include <algorithm>
+#include <cstddef>
+#include <typeinfo>
+#include "Render/GlFunctions.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/RenderStats.h"
+#include "Render/ShaderCache.h"
+
+namespace {
+	// Atributos: 0 posicin de mundo; 1 color. Como `sf::Vertex`, sin las coordenadas de textura
+	const char* kVertexShader = R"(#version 330
+layout(location = 0) in vec2 a_position;
+layout(location = 1) in vec4 a_color;
+uniform mat4 u_view;
+out vec4 v_color;
+void main() {
+	gl_Position = u_view * vec4(a_position, 0.0, 1.0);
+	v_color = a_color;
+}
+)";
+
+	const char* kFragmentShader = R"(#version 330
+in vec4 v_color;
+out vec4 o_color;
+void main() {
+	o_color = v_color;
+}
+)";
+
+	/**
+	 * @brief Textura con la que se dibuja un comando: la suya o la de la figura.
+	 */
+	const sf::Texture*
+	textureOf(const DrawCommand& command) {
+		if (command.texture) {
+			return command.texture;
+		}
+		return command.shape ? command.shape->getTexture() : nullptr;
+	}
+
+	/**
+	 * @brief Indica si el estado de un lote o comando se puede dibujar con el shader propio.
+	 */
+	bool
+	isStreamable(const sf::Texture* texture, const sf::Shader* shader, const sf::BlendMode& blendMode) {
+		return !texture && !shader && blendMode == sf::BlendAlpha;
+	}
+}
+
+bool
+ShapeBatcher::setStreaming(bool enabled) {
+	if (!enabled) {
+		if (isStreaming()) {
+			GLuint vertexArray = m_vertexArray;
+			gl.deleteVertexArrays(1, &vertexArray);
+			m_stream.release();
+			// El programa es de `ShaderCache`, que lo borra en `release`
+			m_program = 0;
+			m_vertexArray = 0;
+		}
+		return true;
+	}
+	if (isStreaming()) {
+		return true;
+	}
+	if (!loadGlFunctions() || !m_stream.initialize()) {
+		return false;
+	}
+	GLuint program = EngineUtilities::TService<ShaderCache>::instance().program(kVertexShader, kFragmentShader);
+	if (!program) {
+		m_stream.release();
+		return false;
+	}
+	m_viewLocation = gl.getUniformLocation(program, "u_view");
+	GLuint vertexArray = 0;
+	gl.genVertexArrays(1, &vertexArray);
+	gl.bindVertexArray(vertexArray);
+	gl.enableVertexAttribArray(0);
+	gl.enableVertexAttribArray(1);
+	gl.bindVertexArray(0);
+	m_vertexArray = vertexArray;
+	m_program = program;
+	return true;
+}
+
+bool
+ShapeBatcher::isBatchable(const DrawCommand& command) {
+	// El contorno es otra tira de tringulos con su propio color; esas figuras van solas
+	return command.shape && command.shape->getOutlineThickness() == 0.0f && command.shape->getPointCount() >= 3;
+}
+
+void
+ShapeBatcher::submit(sf::RenderTarget& target, RenderCommandBuffer& commands) {
+	begin();
+	commands.sort();
+	commands.forEach([this, &target](const DrawCommand& command) { add(target, command); });
+	end(target);
+}
+
+void
+ShapeBatcher::begin() {
+	m_drawCalls = 0;
+	m_batchedShapes = 0;
+	m_vertices.clear();
+	if (isStreaming()) {
+		m_stream.beginFrame();
+	}
+}
+
+void
+ShapeBatcher::add(sf::RenderTarget& target, const DrawCommand& command) {
+	if (m_enabled && isBatchable(command)) {
+		const sf::Texture* texture = textureOf(command);
+		if (!m_vertices.empty() &&
+		    (texture != m_batchTexture || command.shader != m_batchShader || command.blendMode != m_batchBlendMode)) {
+			flush(target);
+		}
+		m_batchTexture = texture;
+		m_batchShader = command.shader;
+		m_batchBlendMode = command.blendMode;
+		append(command);
+		++m_batchedShapes;
+		return;
+	}
+	flush(target);
+	if (command.sharedShape && isBatchable(command)) {
+		// Figura compartida: su color va en el comando, as que se dibuja como un lote de una
+		m_batchTexture = textureOf(command);
+		m_batchShader = command.shader;
+		m_batchBlendMode = command.blendMode;
+		append(command);
+		flush(target);
+		return;
+	}
+	if (isStreaming() && isStreamable(textureOf(command), command.shader, command.blendMode) &&
+	    typeid(*command.geometry) == typeid(sf::VertexArray)) {
+		// Las partculas: un arreglo de tringulos que se rehace cada frame
+		const sf::VertexArray& vertices = static_cast<const sf::VertexArray&>(*command.geometry);
+		if (vertices.getPrimitiveType() == sf::Triangles) {
+			if (vertices.getVertexCount() != 0) {
+				drawStreamed(target, &vertices[0], vertices.getVertexCount(), command.transform);
+			}
+			return;
+		}
+	}
+	target.draw(*command.geometry, command.renderStates());
+	RenderStatsCounter::current().countDraw(RenderStatsCounter::vertexCount(*command.geometry), textureOf(command),
+		command.shader, command.blendMode);
+	++m_drawCalls;
+}
+
+void
+ShapeBatcher::append(const DrawCommand& command) {
+	const sf::Shape& shape = *command.shape;
+	const sf::Vector2f* points = command.outline;
+	size_t count = command.outlineCount;
+	if (!points) {
+		count = shape.getPointCount();
+		m_points.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			m_points[i] = shape.getPoint(i);
+		}
+		points = m_points.data();
+	}
+
+	// Coordenadas de textura como las pone SFML: el rectngulo de textura estirado sobre la caja de la figura
+	sf::Vector2f low = points[0];
+	sf::Vector2f high = points[0];
+	for (size_t i = 1; i < count; ++i) {
+		low.x = std::min(low.x, points[i].x);
+		low.y = std::min(low.y, points[i].y);
+		high.x = std::max(high.x, points[i].x);
+		high.y = std::max(high.y, points[i].y);
+	}
+	sf::IntRect rect = command.textureRect.width != 0 ? command.textureRect : shape.getTextureRect();
+	sf::Vector2f texScale((high.x > low.x) ? rect.width / (high.x - low.x) : 0.0f,
+	                      (high.y > low.y) ? rect.height / (high.y - low.y) : 0.0f);
+	sf::Vector2f texOrigin(static_cast<float>(rect.left), static_cast<float>(rect.top));
+
+	sf::Transform world = command.transform * shape.getTransform();
+	sf::Color color = command.color;
+	auto vertexAt = [&](size_t i) {
+		sf::Vector2f local = points[i];
+		sf::Vector2f uv(texOrigin.x + (local.x - low.x) * texScale.x, texOrigin.y + (local.y - low.y) * texScale.y);
+		return sf::Vertex(world.transformPoint(local), color, uv);
+	};
+
+	// Las figuras de SFML son convexas: un abanico desde el primer punto
+	size_t first = m_vertices.size();
+	m_vertices.resize(first + (count - 2) * 3);
+	sf::Vertex* out = m_vertices.data() + first;
+	sf::Vertex pivot = vertexAt(0);
+	sf::Vertex previous = vertexAt(1);
+	for (size_t i = 2; i < count; ++i) {
+		sf::Vertex current = vertexAt(i);
+		*out++ = pivot;
+		*out++ = previous;
+		*out++ = current;
+		previous = current;
+	}
+}
+
+void
+ShapeBatcher::flush(sf::RenderTarget& target) {
+	if (m_vertices.empty()) {
+		return;
+	}
+	if (isStreaming() && isStreamable(m_batchTexture, m_batchShader, m_batchBlendMode)) {
+		drawStreamed(target, m_vertices.data(), m_vertices.size(), sf::Transform::Identity);
+		m_vertices.clear();
+		return;
+	}
+	sf::RenderStates states(m_batchBlendMode, sf::Transform::Identity, m_batchTexture, m_batchShader);
+	target.draw(m_vertices.data(), m_vertices.size(), sf::Triangles, states);
+	RenderStatsCounter::current().countDraw(m_vertices.size(), m_batchTexture, m_batchShader, m_batchBlendMode);
+	++m_drawCalls;
+	m_vertices.clear();
+}
+
+void
+ShapeBatcher::drawStreamed(sf::RenderTarget& target, const sf::Vertex* vertices, size_t count,
+                           const sf::Transform& transform) {
+	// SFML guarda y restaura su estado alrededor del OpenGL propio
+	target.pushGLStates();
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl.useProgram(m_program);
+	gl.uniformMatrix4fv(m_viewLocation, 1, GL_FALSE, (target.getView().getTransform() * transform).getMatrix());
+	gl.bindVertexArray(m_vertexArray);
+
+	size_t offset = m_stream.write(vertices, count * sizeof(sf::Vertex));
+	const char* base = reinterpret_cast<const char*>(offset);
+	gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), base + offsetof(sf::Vertex, position));
+	gl.vertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(sf::Vertex), base + offsetof(sf::Vertex, color));
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count));
+	RenderStatsCounter& stats = RenderStatsCounter::current();
+	stats.countUpload(count * sizeof(sf::Vertex));
+	stats.countDraw(count, nullptr, nullptr, sf::BlendAlpha, m_program);
+	++m_drawCalls;
+
+	gl.bindVertexArray(0);
+	gl.bindBuffer(kGlArrayBuffer, 0);
+	gl.useProgram(0);
+	target.popGLStates();
+}
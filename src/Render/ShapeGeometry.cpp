@@ -0,0 +1,59 @@
+#include "Render/ShapeGeometry.h"
+#include "Math/UnitShapes.h"
+
+const ShapeGeometry*
+ShapeGeometryLibrary::find(ShapeType type, const sf::Vector2f& size, size_t pointCount, const sf::Texture* texture) {
+	if (type == RECTANGLE) {
+		pointCount = 4;
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const Entry& entry : m_entries) {
+		if (entry.type == type && entry.size == size && entry.pointCount == pointCount && entry.texture == texture) {
+			return &entry.geometry;
+		}
+	}
+
+	std::unique_ptr<sf::Shape> shape;
+	std::vector<sf::Vector2f> points;
+	switch (type) {
+	case CIRCLE:
+	case TRIANGLE: {
+		std::span<const UnitShapes::Point> unit = UnitShapes::polygon(pointCount);
+		if (unit.empty()) {
+			return nullptr;
+		}
+		// Los puntos de `sf::CircleShape::getPoint`, escalados de la tabla
+		float radius = size.x;
+		for (const UnitShapes::Point& point : unit) {
+			points.emplace_back(point.x * radius + radius, point.y * radius + radius);
+		}
+		shape = std::make_unique<sf::CircleShape>(radius, pointCount);
+		break;
+	}
+	case RECTANGLE: {
+		points = { sf::Vector2f(0.0f, 0.0f), sf::Vector2f(size.x, 0.0f), size, sf::Vector2f(0.0f, size.y) };
+		shape = std::make_unique<sf::RectangleShape>(size);
+		break;
+	}
+	default:
+		return nullptr;
+	}
+	shape->setTexture(texture);
+
+	Entry& entry = m_entries.emplace_back();
+	entry.type = type;
+	entry.size = size;
+	entry.pointCount = pointCount;
+	entry.texture = texture;
+	entry.shape = std::move(shape);
+	entry.points = std::move(points);
+	entry.geometry.shape = entry.shape.get();
+	entry.geometry.outline = entry.points;
+	return &entry.geometry;
+}
+
+size_t
+ShapeGeometryLibrary::size() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
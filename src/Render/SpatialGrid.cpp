@@ -0,0 +1,242 @@
+#include "Render/SpatialGrid.h"
+#include <algorithm>
+#include "Entity.h"
+
+void
+SpatialGrid::insert(Entity& entity) {
+	if (entity.hasComponent<SpatialItem>()) {
+		return;
+	}
+	uint32_t index = static_cast<uint32_t>(m_items.size());
+	Item& item = m_items.emplace_back();
+	item.entity = &entity;
+	place(index);
+	entity.addComponent<SpatialItem>(SpatialItem{ index });
+}
+
+void
+SpatialGrid::remove(Entity& entity) {
+	uint32_t index = 0;
+	bool hasWorld = EngineUtilities::TService<World>::get() != nullptr;
+	if (hasWorld) {
+		SpatialItem* slot = entity.getComponent<SpatialItem>();
+		if (!slot) {
+			return;
+		}
+		index = slot->index;
+		entity.removeComponent<SpatialItem>();
+	}
+	else {
+		// Al cerrar, el World puede irse antes: se busca a mano
+		auto found = std::find_if(m_items.begin(), m_items.end(), [&entity](const Item& item) { return item.entity == &entity; });
+		if (found == m_items.end()) {
+			return;
+		}
+		index = static_cast<uint32_t>(found - m_items.begin());
+	}
+	unplace(index);
+
+	// El ltimo ocupa el hueco: se cambia su ndice en las celdas o listas donde est
+	uint32_t last = static_cast<uint32_t>(m_items.size() - 1);
+	if (index != last) {
+		unplace(last);
+		m_items[index] = m_items[last];
+		place(index);
+		if (hasWorld) {
+			m_items[index].entity->getComponent<SpatialItem>()->index = index;
+		}
+	}
+	m_items.pop_back();
+}
+
+void
+SpatialGrid::updateBounds(SpatialItem handle, const sf::FloatRect& bounds) {
+	Item& item = m_items[handle.index];
+	if (item.placement == Placement::Cells && bounds.width > 0.0f && bounds.height > 0.0f &&
+	    cellOf(bounds.left) == item.x0 && cellOf(bounds.top) == item.y0 &&
+	    cellOf(bounds.left + bounds.width) == item.x1 && cellOf(bounds.top + bounds.height) == item.y1) {
+		// Se movi dentro de las mismas celdas: basta con la caja
+		item.bounds = bounds;
+		return;
+	}
+	unplace(handle.index);
+	item.bounds = bounds;
+	place(handle.index);
+}
+
+void
+SpatialGrid::query(std::span<const sf::FloatRect> areas, std::vector<Entity*>& out) {
+	uint32_t stamp = ++m_queryStamp;
+	auto touches = [areas](const sf::FloatRect& bounds) {
+		for (const sf::FloatRect& area : areas) {
+			if (bounds.intersects(area)) {
+				return true;
+			}
+		}
+		return false;
+	};
+	for (uint32_t index : m_unbounded) {
+		out.push_back(m_items[index].entity);
+	}
+	for (uint32_t index : m_large) {
+		if (touches(m_items[index].bounds)) {
+			out.push_back(m_items[index].entity);
+		}
+	}
+	for (const sf::FloatRect& area : areas) {
+		int32_t x0 = cellOf(area.left);
+		int32_t y0 = cellOf(area.top);
+		int32_t x1 = cellOf(area.left + area.width);
+		int32_t y1 = cellOf(area.top + area.height);
+		for (int32_t y = y0; y <= y1; ++y) {
+			for (int32_t x = x0; x <= x1; ++x) {
+				auto cell = m_cells.find(cellKey(x, y));
+				if (cell == m_cells.end()) {
+					continue;
+				}
+				for (uint32_t index : cell->second) {
+					Item& item = m_items[index];
+					// Una caja en varias celdas, o de varias reas, sale una sola vez
+					if (item.queryStamp != stamp) {
+						item.queryStamp = stamp;
+						if (touches(item.bounds)) {
+							out.push_back(item.entity);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void
+SpatialGrid::queryPoint(const sf::Vector2f& point, std::vector<Entity*>& out) const {
+	for (uint32_t index : m_large) {
+		if (m_items[index].bounds.contains(point)) {
+			out.push_back(m_items[index].entity);
+		}
+	}
+	auto cell = m_cells.find(cellKey(cellOf(point.x), cellOf(point.y)));
+	if (cell == m_cells.end()) {
+		return;
+	}
+	for (uint32_t index : cell->second) {
+		if (m_items[index].bounds.contains(point)) {
+			out.push_back(m_items[index].entity);
+		}
+	}
+}
+
+Entity*
+SpatialGrid::pickPoint(const sf::Vector2f& point) const {
+	Entity* best = nullptr;
+	float bestArea = 0.0f;
+	auto consider = [&](uint32_t index) {
+		const Item& item = m_items[index];
+		float area = item.bounds.width * item.bounds.height;
+		if ((!best || area < bestArea) && item.bounds.contains(point)) {
+			best = item.entity;
+			bestArea = area;
+		}
+	};
+	for (uint32_t index : m_large) {
+		consider(index);
+	}
+	auto cell = m_cells.find(cellKey(cellOf(point.x), cellOf(point.y)));
+	if (cell != m_cells.end()) {
+		for (uint32_t index : cell->second) {
+			consider(index);
+		}
+	}
+	return best;
+}
+
+void
+SpatialGrid::queryArea(const sf::FloatRect& area, std::vector<Entity*>& out) const {
+	for (uint32_t index : m_large) {
+		if (m_items[index].bounds.intersects(area)) {
+			out.push_back(m_items[index].entity);
+		}
+	}
+	int32_t x0 = cellOf(area.left);
+	int32_t y0 = cellOf(area.top);
+	int32_t x1 = cellOf(area.left + area.width);
+	int32_t y1 = cellOf(area.top + area.height);
+	for (int32_t y = y0; y <= y1; ++y) {
+		for (int32_t x = x0; x <= x1; ++x) {
+			auto cell = m_cells.find(cellKey(x, y));
+			if (cell == m_cells.end()) {
+				continue;
+			}
+			for (uint32_t index : cell->second) {
+				const Item& item = m_items[index];
+				// Sin sellos: la duea es la primera celda comn, y sale de ah o de ninguna
+				if (x == std::max(x0, item.x0) && y == std::max(y0, item.y0) && item.bounds.intersects(area)) {
+					out.push_back(item.entity);
+				}
+			}
+		}
+	}
+}
+
+void
+SpatialGrid::unplace(uint32_t index) {
+	Item& item = m_items[index];
+	switch (item.placement) {
+	case Placement::Unbounded:
+		eraseFromList(m_unbounded, m_items, item.listIndex);
+		break;
+	case Placement::Large:
+		eraseFromList(m_large, m_items, item.listIndex);
+		break;
+	case Placement::Cells:
+		for (int32_t y = item.y0; y <= item.y1; ++y) {
+			for (int32_t x = item.x0; x <= item.x1; ++x) {
+				std::vector<uint32_t>& cell = m_cells[cellKey(x, y)];
+				auto found = std::find(cell.begin(), cell.end(), index);
+				*found = cell.back();
+				cell.pop_back();
+			}
+		}
+		break;
+	}
+}
+
+void
+SpatialGrid::place(uint32_t index) {
+	Item& item = m_items[index];
+	if (item.bounds.width <= 0.0f || item.bounds.height <= 0.0f) {
+		item.placement = Placement::Unbounded;
+		item.listIndex = static_cast<uint32_t>(m_unbounded.size());
+		m_unbounded.push_back(index);
+		return;
+	}
+	int32_t x0 = cellOf(item.bounds.left);
+	int32_t y0 = cellOf(item.bounds.top);
+	int32_t x1 = cellOf(item.bounds.left + item.bounds.width);
+	int32_t y1 = cellOf(item.bounds.top + item.bounds.height);
+	if (uint64_t(x1 - x0 + 1) * uint64_t(y1 - y0 + 1) > kMaxCellsPerItem) {
+		item.placement = Placement::Large;
+		item.listIndex = static_cast<uint32_t>(m_large.size());
+		m_large.push_back(index);
+		return;
+	}
+	item.placement = Placement::Cells;
+	item.x0 = x0;
+	item.y0 = y0;
+	item.x1 = x1;
+	item.y1 = y1;
+	for (int32_t y = y0; y <= y1; ++y) {
+		for (int32_t x = x0; x <= x1; ++x) {
+			m_cells[cellKey(x, y)].push_back(index);
+		}
+	}
+}
+
+void
+SpatialGrid::eraseFromList(std::vector<uint32_t>& list, std::vector<Item>& items, uint32_t listIndex) {
+	uint32_t moved = list.back();
+	list[listIndex] = moved;
+	items[moved].listIndex = listIndex;
+	list.pop_back();
+}
@@ -0,0 +1,154 @@
+#include "Render/StaticGeometryCache.h"
+#include <algorithm>
+#include <functional>
+#include "ECS/ChangeTick.h"
+#include "Render/RenderStats.h"
+#include "ShapeFactory.h"
+
+bool
+StaticGeometryCache::add(ShapeFactory& shape) {
+	if (shape.m_staticIndex != kNotStatic) {
+		return true;
+	}
+	const sf::Shape* geometry = static_cast<const ShapeFactory&>(shape).getShape();
+	if (geometry && geometry->getOutlineThickness() != 0.0f) {
+		return false;
+	}
+	shape.m_staticIndex = static_cast<uint32_t>(m_entries.size());
+	m_entries.push_back({ &shape });
+	m_dirty = true;
+	return true;
+}
+
+void
+StaticGeometryCache::remove(ShapeFactory& shape) {
+	uint32_t index = shape.m_staticIndex;
+	if (index == kNotStatic) {
+		return;
+	}
+	m_entries[index] = m_entries.back();
+	m_entries[index].shape->m_staticIndex = index;
+	m_entries.pop_back();
+	shape.m_staticIndex = kNotStatic;
+	m_dirty = true;
+}
+
+void
+StaticGeometryCache::markVisible(const ShapeFactory& shape) {
+	if (shape.m_staticIndex != kNotStatic) {
+		m_entries[shape.m_staticIndex].visibleFrame = m_frame;
+	}
+}
+
+bool
+StaticGeometryCache::needsBake() const {
+	if (m_dirty) {
+		return true;
+	}
+	for (const Entry& entry : m_entries) {
+		if ((entry.visibleFrame == m_frame) != entry.baked) {
+			return true;
+		}
+		if (!entry.baked) {
+			continue;
+		}
+		const ShapeFactory& shape = *entry.shape;
+		if (isNewerTick(shape.getChangeTick(), m_bakedTick)) {
+			return true;
+		}
+		const Transform* transform = shape.getTransform();
+		if (transform && transform->getWorldVersion() != entry.worldVersion) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+StaticGeometryCache::bake() {
+	// Lo que cambie desde ahora tiene un tick ms nuevo que este
+	m_bakedTick = advanceChangeTick();
+	m_dirty = false;
+	++m_bakes;
+
+	// Por textura: el orden entre figuras estticas de distinta textura no importa
+	std::vector<const ShapeFactory*> visible;
+	visible.reserve(m_entries.size());
+	for (Entry& entry : m_entries) {
+		const ShapeFactory& shape = *entry.shape;
+		entry.baked = entry.visibleFrame == m_frame && shape.getShape();
+		if (entry.baked) {
+			const Transform* transform = shape.getTransform();
+			entry.worldVersion = transform ? transform->getWorldVersion() : 0;
+			visible.push_back(&shape);
+		}
+	}
+	auto textureOf = [](const ShapeFactory* shape) { return shape->getTexture(); };
+	std::stable_sort(visible.begin(), visible.end(), [&textureOf](const ShapeFactory* a, const ShapeFactory* b) {
+		return std::less<const sf::Texture*>()(textureOf(a), textureOf(b));
+	});
+
+	size_t used = 0;
+	for (size_t first = 0; first < visible.size();) {
+		const sf::Texture* texture = textureOf(visible[first]);
+		m_tessellator.clear();
+		size_t last = first;
+		for (; last < visible.size() && textureOf(visible[last]) == texture; ++last) {
+			const ShapeFactory& shape = *visible[last];
+			std::span<const sf::Vector2f> outline = shape.getLocalOutline();
+			DrawCommand command;
+			command.geometry = shape.getShape();
+			command.shape = shape.getShape();
+			command.color = shape.getFillColor();
+			command.outline = outline.data();
+			command.outlineCount = static_cast<uint32_t>(outline.size());
+			command.transform = shape.getWorldTransform();
+			m_tessellator.append(command);
+		}
+		first = last;
+
+		if (used == m_batches.size()) {
+			m_batches.emplace_back();
+		}
+		// Se sube en `draw`, que puede correr en el hilo de render
+		Batch& batch = m_batches[used++];
+		batch.texture = texture;
+		batch.vertices = m_tessellator.vertices();
+		batch.vertexCount = batch.vertices.size();
+		batch.uploaded = false;
+	}
+	m_batches.resize(used);
+	m_tessellator.clear();
+}
+
+void
+StaticGeometryCache::prepare() {
+	if (!m_prepared && needsBake()) {
+		bake();
+	}
+	m_prepared = true;
+}
+
+void
+StaticGeometryCache::draw(sf::RenderTarget& target) {
+	prepare();
+	m_prepared = false;
+	for (Batch& batch : m_batches) {
+		if (!batch.uploaded && sf::VertexBuffer::isAvailable()) {
+			batch.buffer.create(batch.vertexCount);
+			batch.buffer.update(batch.vertices.data());
+			batch.uploaded = true;
+			RenderStatsCounter::current().countUpload(batch.vertexCount * sizeof(sf::Vertex));
+		}
+		sf::RenderStates states;
+		states.texture = batch.texture;
+		if (sf::VertexBuffer::isAvailable()) {
+			target.draw(batch.buffer, 0, batch.vertexCount, states);
+		}
+		else {
+			target.draw(batch.vertices.data(), batch.vertexCount, sf::Triangles, states);
+		}
+		RenderStatsCounter::current().countDraw(batch.vertexCount, batch.texture);
+	}
+	++m_frame;
+}
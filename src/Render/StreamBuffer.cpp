@@ -0,0 +1,145 @@
+#include "Render/StreamBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include "Render/GlFunctions.h"
+
+namespace {
+	constexpr size_t kAlignment = 16;            ///< De cada `write`: sirve a cualquier atributo.
+	constexpr size_t kMinRegionBytes = 4096;
+	constexpr uint64_t kWaitNanoseconds = 1000000;
+
+	size_t
+	alignUp(size_t value) { return (value + kAlignment - 1) / kAlignment * kAlignment; }
+
+	/**
+	 * @return `true` si la GPU todava no haba llegado al fence.
+	 */
+	bool
+	waitAndDelete(GlSync& fence) {
+		if (!fence) {
+			return false;
+		}
+		GLenum status = gl.clientWaitSync(fence, 0, 0);
+		bool stalled = status != kGlAlreadySignaled && status != kGlConditionSatisfied && status != kGlWaitFailed;
+		while (status != kGlAlreadySignaled && status != kGlConditionSatisfied && status != kGlWaitFailed) {
+			status = gl.clientWaitSync(fence, kGlSyncFlushCommandsBit, kWaitNanoseconds);
+		}
+		gl.deleteSync(fence);
+		fence = nullptr;
+		return stalled;
+	}
+}
+
+bool
+StreamBuffer::initialize() {
+	if (isInitialized()) {
+		return true;
+	}
+	if (!loadGlFunctions()) {
+		return false;
+	}
+	m_regionBytes = alignUp(std::max(m_regionBytes, kMinRegionBytes));
+	return allocate();
+}
+
+void
+StreamBuffer::release() {
+	destroy();
+}
+
+bool
+StreamBuffer::allocate() {
+	GLuint buffer = 0;
+	gl.genBuffers(1, &buffer);
+	gl.bindBuffer(kGlArrayBuffer, buffer);
+	std::ptrdiff_t total = static_cast<std::ptrdiff_t>(m_regionBytes * kRegionCount);
+	if (hasGlBufferStorage()) {
+		GLbitfield flags = kGlMapWriteBit | kGlMapPersistentBit | kGlMapCoherentBit;
+		gl.bufferStorage(kGlArrayBuffer, total, nullptr, flags);
+		m_mapped = static_cast<uint8_t*>(gl.mapBufferRange(kGlArrayBuffer, 0, total, flags));
+	}
+	if (!m_mapped) {
+		// Sin almacenamiento inmutable, o el driver no quiso mapearlo: un bfer comn
+		if (hasGlBufferStorage()) {
+			gl.deleteBuffers(1, &buffer);
+			gl.genBuffers(1, &buffer);
+			gl.bindBuffer(kGlArrayBuffer, buffer);
+		}
+		gl.bufferData(kGlArrayBuffer, total, nullptr, kGlStreamDraw);
+	}
+	m_buffer = buffer;
+	m_region = 0;
+	m_used = 0;
+	return true;
+}
+
+void
+StreamBuffer::destroy() {
+	if (!isInitialized()) {
+		return;
+	}
+	for (GlSync& fence : m_fences) {
+		if (fence) {
+			gl.deleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	// Borrarlo lo desmapea; los draws ya enviados siguen leyendo la copia del driver
+	GLuint buffer = m_buffer;
+	gl.deleteBuffers(1, &buffer);
+	m_buffer = 0;
+	m_mapped = nullptr;
+	m_used = 0;
+}
+
+void
+StreamBuffer::beginFrame() {
+	if (isInitialized() && m_used != 0) {
+		advance();
+	}
+}
+
+void
+StreamBuffer::advance() {
+	m_fences[m_region] = gl.fenceSync(kGlSyncGpuCommandsComplete, 0);
+	m_region = (m_region + 1) % kRegionCount;
+	m_used = 0;
+	if (waitAndDelete(m_fences[m_region])) {
+		++m_stalls;
+	}
+}
+
+size_t
+StreamBuffer::write(const void* data, size_t bytes) {
+	if (bytes > m_regionBytes) {
+		// Nunca entrara: regiones nuevas del doble, las veces que haga falta
+		destroy();
+		while (m_regionBytes < bytes) {
+			m_regionBytes *= 2;
+		}
+		allocate();
+	}
+	else if (m_used + bytes > m_regionBytes) {
+		advance();
+	}
+
+	size_t offset = static_cast<size_t>(m_region) * m_regionBytes + m_used;
+	gl.bindBuffer(kGlArrayBuffer, m_buffer);
+	if (m_mapped) {
+		std::memcpy(m_mapped + offset, data, bytes);
+	}
+	else {
+		// La regin ya pas su fence: nada que esperar al mapear
+		void* target = gl.mapBufferRange(kGlArrayBuffer, static_cast<std::ptrdiff_t>(offset),
+			static_cast<std::ptrdiff_t>(bytes), kGlMapWriteBit | kGlMapInvalidateRangeBit | kGlMapUnsynchronizedBit);
+		if (target) {
+			std::memcpy(target, data, bytes);
+			gl.unmapBuffer(kGlArrayBuffer);
+		}
+		else {
+			gl.bufferSubData(kGlArrayBuffer, static_cast<std::ptrdiff_t>(offset), static_cast<std::ptrdiff_t>(bytes), data);
+		}
+	}
+	m_used += alignUp(bytes);
+	return offset;
+}
@@ -0,0 +1,140 @@
+#include "Render/TextBatcher.h"
+#include <algorithm>
+#include "Render/RenderStats.h"
+
+void
+TextBatcher::setFont(const sf::Font& font) {
+	m_font = &font;
+	m_layouts.clear();
+	for (Batch& batch : m_batches) {
+		batch.vertices.clear();
+	}
+}
+
+void
+TextBatcher::prepare(unsigned int characterSize) {
+	if (!m_font) {
+		return;
+	}
+	for (char32_t glyph = kFirstPreparedGlyph; glyph <= kLastPreparedGlyph; ++glyph) {
+		m_font->getGlyph(glyph, characterSize, false);
+	}
+}
+
+TextBatcher::LayoutId
+TextBatcher::cacheLayout(std::string_view text, unsigned int characterSize) {
+	Layout& cached = m_layouts.emplace_back();
+	cached.characterSize = characterSize;
+	layout(text, characterSize, sf::Vector2f(), sf::Color::White, &cached.vertices);
+	return static_cast<LayoutId>(m_layouts.size() - 1);
+}
+
+void
+TextBatcher::updateLayout(LayoutId id, std::string_view text) {
+	Layout& cached = m_layouts[id];
+	cached.vertices.clear();
+	layout(text, cached.characterSize, sf::Vector2f(), sf::Color::White, &cached.vertices);
+}
+
+void
+TextBatcher::add(std::string_view text, unsigned int characterSize, const sf::Vector2f& position, sf::Color color) {
+	layout(text, characterSize, position, color, &batchFor(characterSize).vertices);
+}
+
+void
+TextBatcher::add(LayoutId id, const sf::Vector2f& position, sf::Color color) {
+	const Layout& cached = m_layouts[id];
+	std::vector<sf::Vertex>& out = batchFor(cached.characterSize).vertices;
+	size_t first = out.size();
+	out.insert(out.end(), cached.vertices.begin(), cached.vertices.end());
+	for (size_t i = first; i < out.size(); ++i) {
+		out[i].position += position;
+		out[i].color = color;
+	}
+}
+
+sf::Vector2f
+TextBatcher::measure(std::string_view text, unsigned int characterSize) const {
+	return layout(text, characterSize, sf::Vector2f(), sf::Color::White, nullptr);
+}
+
+void
+TextBatcher::draw(sf::RenderTarget& target, const sf::RenderStates& states) {
+	m_drawCalls = 0;
+	if (!m_font) {
+		return;
+	}
+	for (Batch& batch : m_batches) {
+		if (batch.vertices.empty()) {
+			continue;
+		}
+		sf::RenderStates batchStates = states;
+		batchStates.texture = &m_font->getTexture(batch.characterSize);
+		target.draw(batch.vertices.data(), batch.vertices.size(), sf::Triangles, batchStates);
+		RenderStatsCounter::current().countDraw(batch.vertices.size(), batchStates.texture, batchStates.shader,
+			batchStates.blendMode);
+		++m_drawCalls;
+		batch.vertices.clear();
+	}
+}
+
+sf::Vector2f
+TextBatcher::layout(std::string_view text, unsigned int characterSize, const sf::Vector2f& origin, sf::Color color,
+	std::vector<sf::Vertex>* out) const {
+	if (!m_font || text.empty()) {
+		return sf::Vector2f();
+	}
+
+	// Como `sf::Text`: la primera lnea tiene la lnea base a un tamao de la esquina
+	float lineSpacing = m_font->getLineSpacing(characterSize);
+	float x = 0.0f;
+	float y = static_cast<float>(characterSize);
+	float width = 0.0f;
+	sf::Uint32 previous = 0;
+	for (auto at = text.begin(); at != text.end();) {
+		sf::Uint32 codePoint = 0;
+		at = sf::Utf8::decode(at, text.end(), codePoint);
+		if (codePoint == '\n') {
+			width = std::max(width, x);
+			x = 0.0f;
+			y += lineSpacing;
+			previous = 0;
+			continue;
+		}
+		x += m_font->getKerning(previous, codePoint, characterSize);
+		previous = codePoint;
+		const sf::Glyph& glyph = m_font->getGlyph(codePoint, characterSize, false);
+		if (out && glyph.textureRect.width > 0) {
+			float left = origin.x + x + glyph.bounds.left;
+			float top = origin.y + y + glyph.bounds.top;
+			float right = left + glyph.bounds.width;
+			float bottom = top + glyph.bounds.height;
+			float u0 = static_cast<float>(glyph.textureRect.left);
+			float v0 = static_cast<float>(glyph.textureRect.top);
+			float u1 = u0 + static_cast<float>(glyph.textureRect.width);
+			float v1 = v0 + static_cast<float>(glyph.textureRect.height);
+			out->insert(out->end(), {
+				sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u0, v0)),
+				sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0)),
+				sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1)),
+				sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1)),
+				sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0)),
+				sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1)),
+			});
+		}
+		x += glyph.advance;
+	}
+	return sf::Vector2f(std::max(width, x), y - static_cast<float>(characterSize) + lineSpacing);
+}
+
+TextBatcher::Batch&
+TextBatcher::batchFor(unsigned int characterSize) {
+	for (Batch& batch : m_batches) {
+		if (batch.characterSize == characterSize) {
+			return batch;
+		}
+	}
+	Batch& batch = m_batches.emplace_back();
+	batch.characterSize = characterSize;
+	return batch;
+}
@@ -0,0 +1,217 @@
+#include "Render/TextureAtlas.h"
+#include <algorithm>
+
+namespace {
+	uint32_t
+	alignUp(uint32_t value, uint32_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+uint32_t
+TextureAtlas::add(std::string_view name, const sf::Image& image) {
+	std::string key(name);
+	auto found = m_names.find(key);
+	if (found != m_names.end()) {
+		return found->second;
+	}
+	uint32_t id = static_cast<uint32_t>(m_regions.size());
+	m_regions.emplace_back();
+	m_names.emplace(std::move(key), id);
+	m_pending.push_back(Pending{ id, image });
+	return id;
+}
+
+uint32_t
+TextureAtlas::addFile(const std::string& path) {
+	uint32_t id = find(path);
+	if (id != kInvalidRegion) {
+		return id;
+	}
+	sf::Image image;
+	if (!image.loadFromFile(path)) {
+		return kInvalidRegion;
+	}
+	return add(path, image);
+}
+
+uint32_t
+TextureAtlas::find(std::string_view name) const {
+	auto found = m_names.find(std::string(name));
+	return found != m_names.end() ? found->second : kInvalidRegion;
+}
+
+uint32_t
+TextureAtlas::border() const {
+	if (m_settings.mipLevels == 0) {
+		return m_settings.padding;
+	}
+	// Al menos un texel del ltimo nivel, y mltiplo de l para que la imagen quede alineada
+	return alignUp(std::max(m_settings.padding, alignment()), alignment());
+}
+
+bool
+TextureAtlas::build() {
+	// Las altas primero: el perfil queda ms parejo y se pierde menos debajo
+	std::stable_sort(m_pending.begin(), m_pending.end(), [](const Pending& a, const Pending& b) {
+		sf::Vector2u sizeA = a.image.getSize();
+		sf::Vector2u sizeB = b.image.getSize();
+		return sizeA.y != sizeB.y ? sizeA.y > sizeB.y : sizeA.x > sizeB.x;
+	});
+
+	bool allPlaced = true;
+	std::vector<bool> touched(m_pages.size(), false);
+	uint32_t edge = border();
+	for (const Pending& pending : m_pending) {
+		sf::Vector2u size = pending.image.getSize();
+		uint32_t width = alignUp(size.x + 2 * edge, alignment());
+		uint32_t height = alignUp(size.y + 2 * edge, alignment());
+		if (size.x == 0 || size.y == 0 || width > m_settings.pageSize || height > m_settings.pageSize) {
+			allPlaced = false;
+			continue;
+		}
+
+		// La pgina donde quede ms baja; si no cabe en ninguna, una nueva
+		size_t bestPage = m_pages.size();
+		int bestSegment = -1;
+		uint32_t bestY = 0;
+		for (size_t i = 0; i < m_pages.size(); ++i) {
+			uint32_t y = 0;
+			int segment = findPosition(m_pages[i], width, height, y);
+			if (segment >= 0 && (bestSegment < 0 || y < bestY)) {
+				bestPage = i;
+				bestSegment = segment;
+				bestY = y;
+			}
+		}
+		if (bestSegment < 0) {
+			Page& page = m_pages.emplace_back();
+			if (!page.texture.create(m_settings.pageSize, m_settings.pageSize)) {
+				m_pages.pop_back();
+				allPlaced = false;
+				continue;
+			}
+			page.texture.setSmooth(m_settings.smooth);
+			page.skyline.push_back(Segment{ 0, 0, m_settings.pageSize });
+			touched.push_back(false);
+			bestPage = m_pages.size() - 1;
+			bestSegment = 0;
+			bestY = 0;
+		}
+
+		Page& page = m_pages[bestPage];
+		uint32_t x = page.skyline[bestSegment].x;
+		placeSegment(page, static_cast<size_t>(bestSegment), width, bestY + height);
+		page.usedArea += static_cast<uint64_t>(width) * height;
+		upload(page, pending.image, x, bestY);
+		touched[bestPage] = true;
+
+		AtlasRegion& region = m_regions[pending.id];
+		region.texture = &page.texture;
+		region.rect = sf::IntRect(static_cast<int>(x + edge), static_cast<int>(bestY + edge), static_cast<int>(size.x),
+			static_cast<int>(size.y));
+	}
+	m_pending.clear();
+
+	if (m_settings.mipLevels > 0) {
+		for (size_t i = 0; i < m_pages.size(); ++i) {
+			if (touched[i]) {
+				m_pages[i].texture.generateMipmap();
+			}
+		}
+	}
+	return allPlaced;
+}
+
+int
+TextureAtlas::findPosition(const Page& page, uint32_t width, uint32_t height, uint32_t& outY) const {
+	int best = -1;
+	uint32_t bestY = 0;
+	const std::vector<Segment>& skyline = page.skyline;
+	for (size_t i = 0; i < skyline.size(); ++i) {
+		if (skyline[i].x + width > m_settings.pageSize) {
+			break;
+		}
+		// Apoyado sobre el ms alto de los tramos que cubre
+		uint32_t y = 0;
+		uint32_t covered = 0;
+		for (size_t j = i; covered < width; ++j) {
+			y = std::max(y, skyline[j].y);
+			covered += skyline[j].width;
+		}
+		if (y + height <= m_settings.pageSize && (best < 0 || y < bestY)) {
+			best = static_cast<int>(i);
+			bestY = y;
+		}
+	}
+	outY = bestY;
+	return best;
+}
+
+void
+TextureAtlas::placeSegment(Page& page, size_t index, uint32_t width, uint32_t top) {
+	std::vector<Segment>& skyline = page.skyline;
+	uint32_t x = skyline[index].x;
+	uint32_t end = x + width;
+	skyline.insert(skyline.begin() + index, Segment{ x, top, width });
+
+	// Los tramos tapados se recortan o se quitan
+	size_t next = index + 1;
+	while (next < skyline.size() && skyline[next].x < end) {
+		Segment& segment = skyline[next];
+		uint32_t segmentEnd = segment.x + segment.width;
+		if (segmentEnd <= end) {
+			skyline.erase(skyline.begin() + next);
+			continue;
+		}
+		segment.width = segmentEnd - end;
+		segment.x = end;
+		break;
+	}
+
+	// Vecinos a la misma altura: un solo tramo
+	for (size_t i = 1; i < skyline.size();) {
+		if (skyline[i - 1].y == skyline[i].y) {
+			skyline[i - 1].width += skyline[i].width;
+			skyline.erase(skyline.begin() + i);
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+void
+TextureAtlas::upload(Page& page, const sf::Image& image, uint32_t x, uint32_t y) {
+	// El bloque entero, alineacin incluida: cada pxel fuera de la imagen repite el ms cercano
+	sf::Vector2u size = image.getSize();
+	uint32_t edge = border();
+	uint32_t width = alignUp(size.x + 2 * edge, alignment());
+	uint32_t height = alignUp(size.y + 2 * edge, alignment());
+	const sf::Uint8* source = image.getPixelsPtr();
+	std::vector<sf::Uint8> pixels(static_cast<size_t>(width) * height * 4);
+	for (uint32_t row = 0; row < height; ++row) {
+		uint32_t sourceRow = static_cast<uint32_t>(
+			std::clamp(static_cast<int>(row) - static_cast<int>(edge), 0, static_cast<int>(size.y) - 1));
+		for (uint32_t column = 0; column < width; ++column) {
+			uint32_t sourceColumn = static_cast<uint32_t>(
+				std::clamp(static_cast<int>(column) - static_cast<int>(edge), 0, static_cast<int>(size.x) - 1));
+			const sf::Uint8* from = source + (static_cast<size_t>(sourceRow) * size.x + sourceColumn) * 4;
+			std::copy(from, from + 4, pixels.data() + (static_cast<size_t>(row) * width + column) * 4);
+		}
+	}
+	page.texture.update(pixels.data(), width, height, x, y);
+}
+
+float
+TextureAtlas::occupancy() const {
+	if (m_pages.empty()) {
+		return 0.0f;
+	}
+	uint64_t used = 0;
+	for (const Page& page : m_pages) {
+		used += page.usedArea;
+	}
+	double total = static_cast<double>(m_settings.pageSize) * m_settings.pageSize * m_pages.size();
+	return static_cast<float>(static_cast<double>(used) / total);
+}
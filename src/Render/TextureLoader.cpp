@@ -0,0 +1,290 @@
+#include "Render/TextureLoader.h"
+#include <algorithm>
+#include "Memory/MemoryAccounting.h"
+#include "Render/RenderStats.h"
+#include "Scene/MappedFile.h"
+
+namespace {
+
+	/**
+	 * @brief Damero gris de `kPlaceholderSize` pxeles: se nota que falta algo, sin gritar.
+	 */
+	bool
+	createPlaceholder(sf::Texture& texture) {
+		const unsigned int size = TextureLoader::kPlaceholderSize;
+		if (!texture.create(size, size)) {
+			return false;
+		}
+		std::vector<sf::Uint8> pixels(size * size * 4);
+		for (unsigned int y = 0; y < size; ++y) {
+			for (unsigned int x = 0; x < size; ++x) {
+				sf::Uint8 shade = (x + y) % 2 ? 96 : 160;
+				sf::Uint8* pixel = &pixels[(y * size + x) * 4];
+				pixel[0] = pixel[1] = pixel[2] = shade;
+				pixel[3] = 255;
+			}
+		}
+		texture.update(pixels.data());
+		return true;
+	}
+
+} // namespace
+
+TextureLoader::~TextureLoader() {
+	m_jobs.wait(m_counter);
+}
+
+const sf::Texture*
+TextureLoader::load(const std::string& path) {
+	auto found = m_byPath.find(path);
+	if (found != m_byPath.end()) {
+		Entry* entry = found->second;
+		if (!entry->resident) {
+			// Soltada por `release`: se lee otra vez en el mismo objeto
+			entry->resident = true;
+			entry->decoded = false;
+			entry->uploadedRows = 0;
+			entry->skipLevels = m_droppedLevels;
+			entry->failed.store(false, std::memory_order_relaxed);
+			entry->packed = PackLibrary::lookup(path);
+			m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+			decode(entry);
+		}
+		return &entry->texture;
+	}
+	EngineUtilities::TUniquePtr<Entry> entry = EngineUtilities::MakeUnique<Entry>();
+	entry->path = path;
+	entry->packed = PackLibrary::lookup(path);
+	entry->skipLevels = m_droppedLevels;
+	Entry* loading = entry.get();
+	m_entries.push_back(std::move(entry));
+	m_byPath.emplace(path, loading);
+	m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_created.push_back(loading);
+	}
+	decode(loading);
+	return &loading->texture;
+}
+
+bool
+TextureLoader::reload(const std::string& path) {
+	auto found = m_byPath.find(path);
+	if (found == m_byPath.end()) {
+		return false;
+	}
+	Entry* entry = found->second;
+	if (!entry->resident ||
+	    (!entry->ready.load(std::memory_order_acquire) && !entry->failed.load(std::memory_order_acquire))) {
+		return false;
+	}
+	// Terminada, el hilo de render ya no la toca; sin damero, se sigue viendo la anterior
+	entry->decoded = false;
+	entry->uploadedRows = 0;
+	entry->ready.store(false, std::memory_order_relaxed);
+	entry->failed.store(false, std::memory_order_relaxed);
+	entry->packed = PackLibrary::lookup(path);
+	m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+	decode(entry);
+	return true;
+}
+
+bool
+TextureLoader::release(const std::string& path) {
+	auto found = m_byPath.find(path);
+	if (found == m_byPath.end()) {
+		return false;
+	}
+	Entry* entry = found->second;
+	if (!entry->resident ||
+	    (!entry->ready.load(std::memory_order_acquire) && !entry->failed.load(std::memory_order_acquire))) {
+		return false;
+	}
+	// Se descuenta ya: el presupuesto no vuelve a soltar lo mismo mientras el damero espera
+	entry->resident = false;
+	entry->ready.store(false, std::memory_order_relaxed);
+	size_t released = entry->bytes.exchange(0, std::memory_order_relaxed);
+	m_residentBytes.fetch_sub(released, std::memory_order_relaxed);
+	EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Assets, released);
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	m_released.push_back(entry);
+	return true;
+}
+
+bool
+TextureLoader::dropLevel(const std::string& path) {
+	auto found = m_byPath.find(path);
+	if (found == m_byPath.end() || !found->second->ready.load(std::memory_order_acquire) ||
+	    found->second->levels.load(std::memory_order_relaxed) < 2) {
+		return false;
+	}
+	++found->second->skipLevels;
+	return reload(path);
+}
+
+size_t
+TextureLoader::bytes(const std::string& path) const {
+	auto found = m_byPath.find(path);
+	return found != m_byPath.end() ? found->second->bytes.load(std::memory_order_relaxed) : 0;
+}
+
+void
+TextureLoader::decode(Entry* loading) {
+	// El trabajo solo escribe la imagen; la textura es del hilo de render
+	m_jobs.run([this, loading]() {
+		MappedFile file;
+		std::vector<unsigned char> unpacked;
+		std::span<const unsigned char> bytes;
+		if (loading->packed.found) {
+			bytes = loading->packed.bytes(unpacked, &m_jobs);
+		}
+		else if (CompressedTexture::hasDdsExtension(loading->path) && file.open(loading->path)) {
+			bytes = std::span<const unsigned char>(file.data(), file.size());
+		}
+		if (CompressedTexture::isDds(bytes)) {
+			loading->decoded = CompressedTexture::parseDds(bytes, loading->blocks);
+		}
+		else if (m_cookedOnly) {
+			loading->decoded = false;
+		}
+		else if (!bytes.empty()) {
+			loading->decoded = loading->image.loadFromMemory(bytes.data(), bytes.size());
+		}
+		else if (!loading->packed.found) {
+			loading->decoded = loading->image.loadFromFile(loading->path);
+		}
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_decoded.push_back(loading);
+	}, &m_counter);
+}
+
+bool
+TextureLoader::isReady(const sf::Texture* texture) const {
+	for (const EngineUtilities::TUniquePtr<Entry>& entry : m_entries) {
+		if (&entry->texture == texture) {
+			return entry->ready.load(std::memory_order_acquire);
+		}
+	}
+	return false;
+}
+
+bool
+TextureLoader::hasFailed(const sf::Texture* texture) const {
+	for (const EngineUtilities::TUniquePtr<Entry>& entry : m_entries) {
+		if (&entry->texture == texture) {
+			return entry->failed.load(std::memory_order_acquire);
+		}
+	}
+	return false;
+}
+
+size_t
+TextureLoader::uploadPending() {
+	std::vector<Entry*> created;
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		created.swap(m_created);
+		// Antes que las decodificadas: una soltada y vuelta a pedir llega despus
+		created.insert(created.end(), m_released.begin(), m_released.end());
+		m_released.clear();
+		m_uploads.insert(m_uploads.end(), m_decoded.begin(), m_decoded.end());
+		m_decoded.clear();
+	}
+	// El damero no cuenta: es diminuto y las figuras ya apuntan a la textura
+	for (Entry* entry : created) {
+		if (!entry->ready.load(std::memory_order_relaxed)) {
+			createPlaceholder(entry->texture);
+		}
+	}
+
+	size_t uploaded = 0;
+	while (m_uploadFront < m_uploads.size() && uploaded < m_uploadBudget) {
+		Entry& entry = *m_uploads[m_uploadFront];
+		uploaded += uploadRows(entry, m_uploadBudget - uploaded);
+		if (!entry.ready.load(std::memory_order_relaxed) && entry.decoded) {
+			break;
+		}
+		++m_uploadFront;
+	}
+	if (m_uploadFront == m_uploads.size()) {
+		m_uploads.clear();
+		m_uploadFront = 0;
+	}
+	return uploaded;
+}
+
+size_t
+TextureLoader::uploadRows(Entry& entry, size_t budget) {
+	if (!entry.decoded) {
+		MESSAGE("TextureLoader", "uploadRows", "could not decode a texture file, it keeps the placeholder");
+		entry.failed.store(true, std::memory_order_release);
+		m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+		return 0;
+	}
+	if (!entry.blocks.empty()) {
+		size_t bytes = CompressedTexture::uploadedBytes(entry.blocks, entry.skipLevels);
+		if (!CompressedTexture::upload(entry.staging, entry.blocks, entry.skipLevels)) {
+			MESSAGE("TextureLoader", "uploadRows", "could not upload a compressed texture, it keeps the placeholder");
+			entry.decoded = false;
+			entry.blocks = CompressedImage();
+			entry.failed.store(true, std::memory_order_release);
+			m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+			return 0;
+		}
+		RenderStatsCounter::current().countUpload(bytes);
+		size_t levels = entry.blocks.levels.size() - std::min<size_t>(entry.skipLevels, entry.blocks.levels.size() - 1);
+		complete(entry, bytes, static_cast<uint32_t>(levels));
+		return bytes;
+	}
+	sf::Vector2u size = entry.image.getSize();
+	if (entry.uploadedRows == 0 && !entry.staging.create(size.x, size.y)) {
+		MESSAGE("TextureLoader", "uploadRows", "could not create a texture, it keeps the placeholder");
+		entry.decoded = false;
+		entry.failed.store(true, std::memory_order_release);
+		m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+		return 0;
+	}
+
+	// Filas enteras, al menos una aunque no quepa en lo que queda del presupuesto
+	size_t rowBytes = static_cast<size_t>(size.x) * 4;
+	unsigned int rows = static_cast<unsigned int>(std::max<size_t>(1, budget / std::max<size_t>(rowBytes, 1)));
+	rows = std::min(rows, size.y - entry.uploadedRows);
+	if (rows > 0) {
+		entry.staging.update(entry.image.getPixelsPtr() + entry.uploadedRows * rowBytes, size.x, rows, 0, entry.uploadedRows);
+		entry.uploadedRows += rows;
+		RenderStatsCounter::current().countUpload(rows * rowBytes);
+	}
+	if (entry.uploadedRows < size.y) {
+		return rows * rowBytes;
+	}
+
+	complete(entry, rowBytes * size.y, 1);
+	return rows * rowBytes;
+}
+
+void
+TextureLoader::complete(Entry& entry, size_t bytes, uint32_t levels) {
+	// Las figuras la ven en el mismo objeto; el damero y los pxeles se sueltan
+	entry.texture.swap(entry.staging);
+	size_t replaced = entry.bytes.exchange(bytes, std::memory_order_relaxed);
+	m_residentBytes.fetch_add(bytes, std::memory_order_relaxed);
+	m_residentBytes.fetch_sub(replaced, std::memory_order_relaxed);
+	EngineUtilities::MemoryAccounting::onAllocate(EngineUtilities::MemoryCategory::Assets, bytes);
+	EngineUtilities::MemoryAccounting::onFree(EngineUtilities::MemoryCategory::Assets, replaced);
+	entry.levels.store(levels, std::memory_order_relaxed);
+	entry.staging = sf::Texture();
+	entry.image = sf::Image();
+	entry.blocks = CompressedImage();
+	entry.ready.store(true, std::memory_order_release);
+	m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void
+TextureLoader::finishAll() {
+	m_jobs.wait(m_counter);
+	size_t budget = m_uploadBudget;
+	m_uploadBudget = SIZE_MAX;
+	uploadPending();
+	m_uploadBudget = budget;
+}
@@ -0,0 +1,209 @@
+#include "ScalingReport.h"
+#include <algorithm>
+#include <cstdio>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+	/**
+	 * @brief Percentil `p` (0 a 1) de `sorted`, por el rango ms cercano.
+	 */
+	double
+	percentile(const std::vector<double>& sorted, double p) {
+		if (sorted.empty()) {
+			return 0.0;
+		}
+		size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	}
+
+	constexpr const char* kSystemNames[kScalingSystems] = { "update", "movement", "physics", "render_list" };
+	constexpr const char* kSystemZones[kScalingSystems] = { "Update", "SplineFollow", "Physics", "RecordVisible" };
+
+} // namespace
+
+void
+ScalingReport::beginSample(size_t actors, unsigned threads) {
+	ScalingSample& sample = m_samples.emplace_back();
+	sample.actors = actors;
+	sample.threads = threads;
+	m_systemTotal.fill(0.0);
+	m_systemFrames = 0;
+	m_frameMs.clear();
+	m_updateTotal = 0.0;
+	m_renderTotal = 0.0;
+	m_gpuTotal = 0.0;
+	m_gpuFrames = 0;
+}
+
+void
+ScalingReport::addFrame(double updateMs, double renderMs, double frameMs, double gpuMs) {
+	m_updateTotal += updateMs;
+	m_renderTotal += renderMs;
+	if (gpuMs >= 0.0) {
+		m_gpuTotal += gpuMs;
+		++m_gpuFrames;
+	}
+	m_frameMs.push_back(frameMs);
+}
+
+void
+ScalingReport::addSystems(const std::array<double, kScalingSystems>& ms) {
+	for (size_t i = 0; i < kScalingSystems; ++i) {
+		m_systemTotal[i] += ms[i];
+	}
+	++m_systemFrames;
+}
+
+const ScalingSample&
+ScalingReport::endSample() {
+	ScalingSample& sample = m_samples.back();
+	sample.frames = static_cast<uint32_t>(m_frameMs.size());
+	if (!m_frameMs.empty()) {
+		double frames = static_cast<double>(m_frameMs.size());
+		sample.updateMs = m_updateTotal / frames;
+		sample.renderMs = m_renderTotal / frames;
+		sample.gpuMs = m_gpuFrames ? m_gpuTotal / m_gpuFrames : 0.0;
+		std::sort(m_frameMs.begin(), m_frameMs.end());
+		sample.frameP50Ms = percentile(m_frameMs, 0.50);
+		sample.frameP90Ms = percentile(m_frameMs, 0.90);
+		sample.frameP99Ms = percentile(m_frameMs, 0.99);
+		sample.frameMaxMs = m_frameMs.back();
+	}
+	sample.memoryBytes = processMemoryBytes();
+	if (sample.threads == 0 || m_systemFrames == 0) {
+		return sample;
+	}
+
+	for (size_t i = 0; i < kScalingSystems; ++i) {
+		sample.systemMs[i] = m_systemTotal[i] / m_systemFrames;
+	}
+	// La referencia es la primera corrida de este tamao: normalmente la de un hilo
+	const ScalingSample* reference = &sample;
+	for (const ScalingSample& other : m_samples) {
+		if (other.actors == sample.actors && other.threads > 0) {
+			reference = &other;
+			break;
+		}
+	}
+	double threads = static_cast<double>(sample.threads) / reference->threads;
+	for (size_t i = 0; i < kScalingSystems; ++i) {
+		if (sample.systemMs[i] <= 0.0 || reference->systemMs[i] <= 0.0) {
+			continue;
+		}
+		double speedup = reference->systemMs[i] / sample.systemMs[i];
+		sample.speedup[i] = speedup;
+		sample.efficiency[i] = speedup / threads;
+		if (threads > 1.0) {
+			sample.serialFraction[i] = (1.0 / speedup - 1.0 / threads) / (1.0 - 1.0 / threads);
+		}
+	}
+	return sample;
+}
+
+bool
+ScalingReport::write(const std::string& path) const {
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if (!file) {
+		return false;
+	}
+	bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+	// Las columnas de hilos solo si se barrieron: los archivos de siempre no cambian
+	bool threads = std::any_of(m_samples.begin(), m_samples.end(), [](const ScalingSample& s) { return s.threads > 0; });
+	if (json) {
+		std::fprintf(file, "[\n");
+	}
+	else {
+		std::fprintf(file, "actors,frames,update_ms,render_ms,gpu_ms,frame_p50_ms,frame_p90_ms,frame_p99_ms,frame_max_ms,memory_bytes");
+		if (threads) {
+			std::fprintf(file, ",threads");
+			for (size_t k = 0; k < kScalingSystems; ++k) {
+				std::fprintf(file, ",%s_ms,%s_speedup,%s_efficiency,%s_serial", kSystemNames[k], kSystemNames[k],
+				             kSystemNames[k], kSystemNames[k]);
+			}
+		}
+		std::fprintf(file, "\n");
+	}
+	for (size_t i = 0; i < m_samples.size(); ++i) {
+		const ScalingSample& s = m_samples[i];
+		if (json) {
+			std::fprintf(file,
+			             "  {\"actors\": %zu, \"frames\": %u, \"update_ms\": %.4f, \"render_ms\": %.4f, \"gpu_ms\": %.4f, "
+			             "\"frame_p50_ms\": %.4f, \"frame_p90_ms\": %.4f, \"frame_p99_ms\": %.4f, "
+			             "\"frame_max_ms\": %.4f, \"memory_bytes\": %zu",
+			             s.actors, s.frames, s.updateMs, s.renderMs, s.gpuMs, s.frameP50Ms, s.frameP90Ms, s.frameP99Ms,
+			             s.frameMaxMs, s.memoryBytes);
+			if (threads) {
+				std::fprintf(file, ", \"threads\": %u", s.threads);
+				for (size_t k = 0; k < kScalingSystems; ++k) {
+					std::fprintf(file, ", \"%s\": {\"ms\": %.4f, \"speedup\": %.4f, \"efficiency\": %.4f, \"serial\": %.4f}",
+					             kSystemNames[k], s.systemMs[k], s.speedup[k], s.efficiency[k], s.serialFraction[k]);
+				}
+			}
+			std::fprintf(file, "}%s\n", i + 1 < m_samples.size() ? "," : "");
+		}
+		else {
+			std::fprintf(file, "%zu,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%zu", s.actors, s.frames, s.updateMs,
+			             s.renderMs, s.gpuMs, s.frameP50Ms, s.frameP90Ms, s.frameP99Ms, s.frameMaxMs, s.memoryBytes);
+			if (threads) {
+				std::fprintf(file, ",%u", s.threads);
+				for (size_t k = 0; k < kScalingSystems; ++k) {
+					std::fprintf(file, ",%.4f,%.4f,%.4f,%.4f", s.systemMs[k], s.speedup[k], s.efficiency[k], s.serialFraction[k]);
+				}
+			}
+			std::fprintf(file, "\n");
+		}
+	}
+	if (json) {
+		std::fprintf(file, "]\n");
+	}
+	return std::fclose(file) == 0;
+}
+
+const char*
+ScalingReport::systemName(size_t index) {
+	return kSystemNames[index];
+}
+
+const char*
+ScalingReport::systemZone(size_t index) {
+	return kSystemZones[index];
+}
+
+#ifdef _WIN32
+
+size_t
+ScalingReport::processMemoryBytes() {
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return 0;
+	}
+	return counters.WorkingSetSize;
+}
+
+#else
+
+size_t
+ScalingReport::processMemoryBytes() {
+	// Segundo campo de /proc/self/statm: pginas residentes
+	std::FILE* statm = std::fopen("/proc/self/statm", "r");
+	if (!statm) {
+		return 0;
+	}
+	unsigned long long pages = 0;
+	unsigned long long resident = 0;
+	int read = std::fscanf(statm, "%llu %llu", &pages, &resident);
+	std::fclose(statm);
+	return read == 2 ? static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+}
+
+#endif
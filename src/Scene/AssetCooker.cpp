@@ -0,0 +1,326 @@
+#include "Scene/AssetCooker.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "Jobs/JobSystem.h"
+#include "Render/CompressedTexture.h"
+#include "Render/MeshOptimizer.h"
+#include "Scene/PackWriter.h"
+#include "Scene/SceneText.h"
+
+namespace {
+	constexpr uint64_t kFnvOffset = 0xCBF29CE484222325ull;
+
+	uint64_t
+	mix(uint64_t hash, const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	bool
+	readFile(const std::string& path, std::vector<unsigned char>& bytes) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	bool
+	hasExtension(const std::string& path, std::string_view extension) {
+		return path.size() >= extension.size() && std::string_view(path).substr(path.size() - extension.size()) == extension;
+	}
+
+	/**
+	 * @brief Siguiente palabra de `[at, end)`; vaca al final o donde empieza un comentario.
+	 */
+	std::string_view
+	readWord(const char*& at, const char* end) {
+		while (at < end && (*at == ' ' || *at == '\t' || *at == '\r')) {
+			++at;
+		}
+		const char* start = at;
+		while (at < end && *at != ' ' && *at != '\t' && *at != '\r' && *at != '#') {
+			++at;
+		}
+		return std::string_view(start, static_cast<size_t>(at - start));
+	}
+
+	constexpr std::pair<std::string_view, AssetCooker::Kind> kKinds[] = {
+		{ "file", AssetCooker::Kind::File }, { "scene", AssetCooker::Kind::Scene },
+		{ "mesh", AssetCooker::Kind::Mesh }, { "material", AssetCooker::Kind::Material },
+		{ "texture", AssetCooker::Kind::Texture }, { "shader", AssetCooker::Kind::Shader }
+	};
+}
+
+void
+AssetCooker::add(Kind kind, const std::string& source) {
+	auto [found, inserted] = m_byId.emplace(assetId(source), m_assets.size());
+	if (inserted) {
+		m_assets.push_back({ kind, source });
+	}
+	else {
+		m_assets[found->second].kind = kind;
+	}
+}
+
+bool
+AssetCooker::addDependency(const std::string& dependent, const std::string& dependency) {
+	return m_graph.addDependency(assetId(dependent), assetId(dependency));
+}
+
+bool
+AssetCooker::parse(std::string_view text, std::string* error) {
+	const char* at = text.data();
+	const char* end = text.data() + text.size();
+	for (size_t line = 1; at < end; ++line) {
+		const char* lineEnd = at;
+		while (lineEnd < end && *lineEnd != '\n') {
+			++lineEnd;
+		}
+		const char* cursor = at;
+		at = lineEnd < end ? lineEnd + 1 : end;
+
+		auto fail = [error, line](const std::string& what) {
+			if (error) {
+				*error = "line " + std::to_string(line) + ": " + what;
+			}
+			return false;
+		};
+
+		std::string_view keyword = readWord(cursor, lineEnd);
+		if (keyword.empty()) {
+			continue;
+		}
+		if (keyword == "uses") {
+			std::string dependent(readWord(cursor, lineEnd));
+			std::string_view dependency = readWord(cursor, lineEnd);
+			if (dependent.empty() || dependency.empty()) {
+				return fail("uses expects an asset and what it uses");
+			}
+			for (; !dependency.empty(); dependency = readWord(cursor, lineEnd)) {
+				if (!addDependency(dependent, std::string(dependency))) {
+					return fail("uses would make a cycle with " + std::string(dependency));
+				}
+			}
+			continue;
+		}
+		const Kind* kind = nullptr;
+		for (const auto& [name, value] : kKinds) {
+			if (keyword == name) {
+				kind = &value;
+			}
+		}
+		if (!kind) {
+			return fail("unknown keyword");
+		}
+		std::string_view source = readWord(cursor, lineEnd);
+		if (source.empty()) {
+			return fail("expected a path");
+		}
+		if (!readWord(cursor, lineEnd).empty()) {
+			return fail("unexpected text after the path");
+		}
+		add(*kind, std::string(source));
+	}
+	return true;
+}
+
+bool
+AssetCooker::parseFile(const std::string& path, std::string* error) {
+	std::vector<unsigned char> bytes;
+	if (!readFile(path, bytes)) {
+		if (error) {
+			*error = "could not open " + path;
+		}
+		return false;
+	}
+	return parse(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), error);
+}
+
+std::string
+AssetCooker::packName(Kind kind, const std::string& source) {
+	if (kind == Kind::Scene && SceneText::hasTextExtension(source)) {
+		return source.substr(0, source.size() - SceneText::kExtension.size()) + ".gscn";
+	}
+	return source;
+}
+
+bool
+AssetCooker::cook(const std::string& packPath, const std::string& cacheDirectory, Report* report, std::string* error,
+	JobSystem* jobs) {
+	auto fail = [error](const std::string& what) {
+		if (error) {
+			*error = what;
+		}
+		return false;
+	};
+	std::error_code created;
+	std::filesystem::create_directories(cacheDirectory, created);
+	if (created) {
+		return fail("could not create " + cacheDirectory);
+	}
+
+	// Lo que se usa va antes que quien lo usa: su clave ya est al calcular la de este
+	std::vector<AssetId> ids;
+	ids.reserve(m_assets.size());
+	for (const Asset& asset : m_assets) {
+		ids.push_back(assetId(asset.source));
+	}
+	std::vector<AssetId> ordered;
+	m_graph.affected(ids, ordered);
+	std::vector<Asset*> assets;
+	assets.reserve(ordered.size());
+	for (AssetId id : ordered) {
+		auto found = m_byId.find(id);
+		if (found == m_byId.end()) {
+			return fail("an asset uses something not in the list");
+		}
+		assets.push_back(&m_assets[found->second]);
+	}
+
+	struct Step {
+		std::vector<unsigned char> source;
+		std::vector<unsigned char> cooked;
+		uint64_t contentHash = 0;
+		bool read = false;
+		Outcome outcome = Outcome::Failed;
+		std::string error;
+	};
+	std::vector<Step> steps(assets.size());
+	auto forEach = [jobs](size_t count, auto&& function) {
+		if (jobs) {
+			jobs->parallelFor(count, 1, function);
+		}
+		else {
+			function(size_t(0), count);
+		}
+	};
+
+	forEach(steps.size(), [&assets, &steps](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			steps[i].read = readFile(assets[i]->source, steps[i].source);
+			steps[i].contentHash = mix(kFnvOffset, steps[i].source.data(), steps[i].source.size());
+		}
+	});
+
+	// Las claves en orden; el primero con cada clave la cocina y los repetidos toman lo suyo
+	std::unordered_map<uint64_t, size_t> firstWithKey;
+	std::vector<size_t> cooking;
+	for (size_t i = 0; i < assets.size(); ++i) {
+		Asset& asset = *assets[i];
+		if (!steps[i].read) {
+			return fail("could not read " + asset.source);
+		}
+		uint64_t key = mix(kFnvOffset, &kVersion, sizeof(kVersion));
+		key = mix(key, &asset.kind, sizeof(asset.kind));
+		key = mix(key, &steps[i].contentHash, sizeof(uint64_t));
+		for (AssetId dependency : m_graph.dependencies(assetId(asset.source))) {
+			key = mix(key, &m_assets[m_byId.at(dependency)].key, sizeof(uint64_t));
+		}
+		asset.key = key;
+		if (firstWithKey.emplace(key, i).second) {
+			cooking.push_back(i);
+		}
+	}
+
+	forEach(cooking.size(), [&assets, &steps, &cooking, &cacheDirectory](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			Step& step = steps[cooking[i]];
+			step.outcome = cookAsset(*assets[cooking[i]], step.source, cacheDirectory, step.cooked, step.error);
+		}
+	});
+
+	Report done;
+	PackWriter writer;
+	for (size_t i = 0; i < assets.size(); ++i) {
+		const Asset& asset = *assets[i];
+		const Step& first = steps[firstWithKey.at(asset.key)];
+		switch (first.outcome) {
+		case Outcome::Failed:
+			return fail(first.error);
+		case Outcome::Copied:
+			++done.copied;
+			break;
+		case Outcome::Reused:
+			++done.reused;
+			break;
+		case Outcome::Cooked:
+			if (&first == &steps[i]) {
+				++done.cooked;
+			}
+			else {
+				++done.reused;
+			}
+			break;
+		}
+		// Lo que ya viene comprimido (PNG, OGG, fuentes) no gana nada con LZ4
+		PackCompression compression = asset.kind == Kind::File ? PackCompression::None : PackCompression::Lz4;
+		writer.add(packName(asset.kind, asset.source), first.cooked, compression);
+		++done.assets;
+	}
+
+	PackWriter::Stats stats;
+	if (!writer.write(packPath, &stats)) {
+		return fail("could not write " + packPath);
+	}
+	done.uniqueBlobs = stats.uniqueBlobs;
+	done.sharedBytes = stats.sharedBytes;
+	if (report) {
+		*report = done;
+	}
+	return true;
+}
+
+AssetCooker::Outcome
+AssetCooker::cookAsset(const Asset& asset, const std::vector<unsigned char>& source, const std::string& cacheDirectory,
+	std::vector<unsigned char>& bytes, std::string& error) {
+	bool copy = asset.kind == Kind::File || asset.kind == Kind::Material || asset.kind == Kind::Shader ||
+		(asset.kind == Kind::Texture && CompressedTexture::isDds(source)) ||
+		(asset.kind == Kind::Mesh && !hasExtension(asset.source, ".obj")) ||
+		(asset.kind == Kind::Scene && !SceneText::hasTextExtension(asset.source));
+	if (copy) {
+		bytes = source;
+		return Outcome::Copied;
+	}
+
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.cooked", static_cast<unsigned long long>(asset.key));
+	std::string cached = (std::filesystem::path(cacheDirectory) / name).string();
+	if (readFile(cached, bytes)) {
+		return Outcome::Reused;
+	}
+
+	// Se cocina aparte y se renombra: una coccin cortada no deja una entrada a medias
+	std::string temporary = cached + ".tmp";
+	bool ok = false;
+	std::string why;
+	switch (asset.kind) {
+	case Kind::Texture:
+		ok = CompressedTexture::cookFile(asset.source, temporary);
+		break;
+	case Kind::Mesh:
+		ok = MeshOptimizer::optimizeFile(asset.source, temporary);
+		break;
+	case Kind::Scene:
+		ok = SceneText::cookFile(asset.source, temporary, &why);
+		break;
+	default:
+		break;
+	}
+	std::error_code renamed;
+	if (ok) {
+		std::filesystem::rename(temporary, cached, renamed);
+	}
+	if (!ok || renamed || !readFile(cached, bytes)) {
+		std::filesystem::remove(temporary, renamed);
+		error = "could not cook " + asset.source + (why.empty() ? std::string() : ": " + why);
+		return Outcome::Failed;
+	}
+	return Outcome::Cooked;
+}
@@ -0,0 +1,98 @@
+#include "Scene/AssetGraph.h"
+#include <algorithm>
+
+bool
+AssetGraph::addDependency(AssetId dependent, AssetId dependency) {
+	if (dependent == dependency || uses(dependency, dependent)) {
+		return false;
+	}
+	std::vector<AssetId>& dependencies = m_nodes[dependent].dependencies;
+	if (std::find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end()) {
+		return true;
+	}
+	dependencies.push_back(dependency);
+	m_nodes[dependency].dependents.push_back(dependent);
+	return true;
+}
+
+void
+AssetGraph::clearDependencies(AssetId dependent) {
+	auto found = m_nodes.find(dependent);
+	if (found == m_nodes.end()) {
+		return;
+	}
+	for (AssetId dependency : found->second.dependencies) {
+		std::vector<AssetId>& users = m_nodes[dependency].dependents;
+		users.erase(std::remove(users.begin(), users.end(), dependent), users.end());
+	}
+	found->second.dependencies.clear();
+}
+
+std::span<const AssetId>
+AssetGraph::dependencies(AssetId id) const {
+	auto found = m_nodes.find(id);
+	return found != m_nodes.end() ? std::span<const AssetId>(found->second.dependencies) : std::span<const AssetId>();
+}
+
+std::span<const AssetId>
+AssetGraph::dependents(AssetId id) const {
+	auto found = m_nodes.find(id);
+	return found != m_nodes.end() ? std::span<const AssetId>(found->second.dependents) : std::span<const AssetId>();
+}
+
+bool
+AssetGraph::uses(AssetId from, AssetId target) const {
+	std::vector<AssetId> pending{ from };
+	std::unordered_set<AssetId> seen;
+	while (!pending.empty()) {
+		AssetId id = pending.back();
+		pending.pop_back();
+		if (id == target) {
+			return true;
+		}
+		if (!seen.insert(id).second) {
+			continue;
+		}
+		for (AssetId dependency : dependencies(id)) {
+			pending.push_back(dependency);
+		}
+	}
+	return false;
+}
+
+void
+AssetGraph::visit(AssetId id, const std::unordered_set<AssetId>* wanted, std::unordered_set<AssetId>& done,
+	std::vector<AssetId>& ordered) const {
+	if (!done.insert(id).second) {
+		return;
+	}
+	for (AssetId dependency : dependencies(id)) {
+		if (!wanted || wanted->count(dependency)) {
+			visit(dependency, wanted, done, ordered);
+		}
+	}
+	ordered.push_back(id);
+}
+
+void
+AssetGraph::affected(std::span<const AssetId> changed, std::vector<AssetId>& ordered) const {
+	// Primero quines, subiendo por los dependientes; despus en qu orden
+	std::unordered_set<AssetId> reached;
+	std::vector<AssetId> found;
+	std::vector<AssetId> pending(changed.rbegin(), changed.rend());
+	while (!pending.empty()) {
+		AssetId id = pending.back();
+		pending.pop_back();
+		if (!reached.insert(id).second) {
+			continue;
+		}
+		found.push_back(id);
+		for (AssetId dependent : dependents(id)) {
+			pending.push_back(dependent);
+		}
+	}
+	std::unordered_set<AssetId> done;
+	for (AssetId id : found) {
+		visit(id, &reached, done, ordered);
+	}
+}
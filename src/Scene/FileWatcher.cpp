@@ -0,0 +1,318 @@
+#include "Scene/FileWatcher.h"
+#include <cstring>
+#include <filesystem>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	/**
+	 * @brief Carpeta de una ruta ya normalizada; vaca si est en la actual.
+	 */
+	std::string
+	directoryOf(const std::string& normalized) {
+		size_t slash = normalized.rfind('/');
+		return slash == std::string::npos ? std::string() : normalized.substr(0, slash);
+	}
+
+#ifdef _WIN32
+	constexpr DWORD kBufferBytes = 16 * 1024;   ///< Avisos por lectura; si no caben, esa tanda se pierde.
+#endif
+}
+
+std::string
+FileWatcher::normalize(const std::string& path) {
+	std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+	if (normalized == ".") {
+		normalized.clear();
+	}
+	while (normalized.size() > 1 && normalized.back() == '/') {
+		normalized.pop_back();
+	}
+	return normalized;
+}
+
+void
+FileWatcher::record(const std::string& directory, const char* name, size_t length) {
+	std::string file = directory.empty() ? std::string(name, length) : directory + '/' + std::string(name, length);
+	if (m_files.count(file)) {
+		m_pending[file] = Clock::now();
+	}
+}
+
+void
+FileWatcher::takeChanges(std::vector<std::string>& changed) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_pending.empty()) {
+		return;
+	}
+	Clock::time_point settled = Clock::now() - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(kSettleSeconds));
+	for (auto it = m_pending.begin(); it != m_pending.end();) {
+		if (it->second <= settled) {
+			changed.push_back(it->first);
+			it = m_pending.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+#ifdef _WIN32
+
+bool
+FileWatcher::start() {
+	if (!kHotReload) {
+		return false;
+	}
+	if (m_running) {
+		return true;
+	}
+	m_wake = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+	if (!m_wake) {
+		return false;
+	}
+	m_stopping.store(false);
+	m_running = true;
+	m_thread = std::thread([this]() { listen(); });
+	return true;
+}
+
+void
+FileWatcher::stop() {
+	if (!m_running) {
+		return;
+	}
+	m_stopping.store(true);
+	SetEvent(m_wake);
+	m_thread.join();
+	// Cancelada y esperada: el sistema ya no escribe en el bfer que se libera
+	for (Directory& directory : m_directories) {
+		OVERLAPPED* overlapped = static_cast<OVERLAPPED*>(directory.overlapped);
+		if (directory.armed) {
+			DWORD bytes = 0;
+			CancelIoEx(directory.handle, overlapped);
+			GetOverlappedResult(directory.handle, overlapped, &bytes, TRUE);
+		}
+		CloseHandle(overlapped->hEvent);
+		delete overlapped;
+		CloseHandle(directory.handle);
+	}
+	CloseHandle(m_wake);
+	m_wake = nullptr;
+	m_directories.clear();
+	m_files.clear();
+	m_pending.clear();
+	m_running = false;
+}
+
+bool
+FileWatcher::watch(const std::string& path) {
+	if (!m_running) {
+		return false;
+	}
+	std::string file = normalize(path);
+	std::string folder = directoryOf(file);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_files.insert(file);
+	for (const Directory& directory : m_directories) {
+		if (directory.path == folder) {
+			return true;
+		}
+	}
+	if (m_directories.size() >= kMaxDirectories) {
+		return false;
+	}
+	HANDLE handle = CreateFileA(folder.empty() ? "." : folder.c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	OVERLAPPED* overlapped = new OVERLAPPED();
+	overlapped->hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+	Directory& directory = m_directories.emplace_back();
+	directory.path = folder;
+	directory.handle = handle;
+	directory.overlapped = overlapped;
+	directory.buffer.resize(kBufferBytes);
+	// La lectura se pide desde el hilo: la de un hilo que termina se cancela
+	SetEvent(m_wake);
+	return true;
+}
+
+void
+FileWatcher::listen() {
+	std::vector<HANDLE> events;
+	while (!m_stopping.load()) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			events.assign(1, m_wake);
+			for (Directory& directory : m_directories) {
+				OVERLAPPED* overlapped = static_cast<OVERLAPPED*>(directory.overlapped);
+				if (!directory.armed) {
+					directory.armed = ReadDirectoryChangesW(directory.handle, directory.buffer.data(), kBufferBytes, FALSE,
+						FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, overlapped, nullptr) != 0;
+				}
+				events.push_back(overlapped->hEvent);
+			}
+		}
+		DWORD result = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE, INFINITE);
+		if (m_stopping.load() || result == WAIT_FAILED) {
+			break;
+		}
+		if (result == WAIT_OBJECT_0 || result > WAIT_OBJECT_0 + events.size() - 1) {
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Directory& directory = m_directories[result - WAIT_OBJECT_0 - 1];
+		OVERLAPPED* overlapped = static_cast<OVERLAPPED*>(directory.overlapped);
+		DWORD bytes = 0;
+		directory.armed = false;
+		// Cero bytes: no cupieron los avisos; no se sabe qu cambi
+		if (!GetOverlappedResult(directory.handle, overlapped, &bytes, FALSE) || bytes == 0) {
+			continue;
+		}
+		const unsigned char* at = directory.buffer.data();
+		for (;;) {
+			const FILE_NOTIFY_INFORMATION* notice = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(at);
+			if (notice->Action == FILE_ACTION_ADDED || notice->Action == FILE_ACTION_MODIFIED ||
+			    notice->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+				char name[MAX_PATH];
+				int length = WideCharToMultiByte(CP_ACP, 0, notice->FileName, static_cast<int>(notice->FileNameLength / sizeof(WCHAR)),
+					name, sizeof(name), nullptr, nullptr);
+				if (length > 0) {
+					record(directory.path, name, static_cast<size_t>(length));
+				}
+			}
+			if (notice->NextEntryOffset == 0) {
+				break;
+			}
+			at += notice->NextEntryOffset;
+		}
+	}
+}
+
+#else
+
+bool
+FileWatcher::start() {
+	if (!kHotReload) {
+		return false;
+	}
+	if (m_running) {
+		return true;
+	}
+	m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_inotify < 0) {
+		return false;
+	}
+	if (pipe(m_wake) != 0) {
+		close(m_inotify);
+		m_inotify = -1;
+		return false;
+	}
+	m_stopping.store(false);
+	m_running = true;
+	m_thread = std::thread([this]() { listen(); });
+	return true;
+}
+
+void
+FileWatcher::stop() {
+	if (!m_running) {
+		return;
+	}
+	m_stopping.store(true);
+	char wake = 0;
+	if (write(m_wake[1], &wake, 1) != 1) {
+		// Sin poder escribir en el tubo el hilo no despierta; mejor no esperarlo
+		m_thread.detach();
+	}
+	else {
+		m_thread.join();
+	}
+	// Cerrar el descriptor suelta todas las vigilancias
+	close(m_inotify);
+	close(m_wake[0]);
+	close(m_wake[1]);
+	m_inotify = m_wake[0] = m_wake[1] = -1;
+	m_directories.clear();
+	m_files.clear();
+	m_pending.clear();
+	m_running = false;
+}
+
+bool
+FileWatcher::watch(const std::string& path) {
+	if (!m_running) {
+		return false;
+	}
+	std::string file = normalize(path);
+	std::string folder = directoryOf(file);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_files.insert(file);
+	for (const Directory& directory : m_directories) {
+		if (directory.path == folder) {
+			return true;
+		}
+	}
+	// Al cerrar tras escribir o al llegar por un renombre: no en cada `write` parcial
+	int descriptor = inotify_add_watch(m_inotify, folder.empty() ? "." : folder.c_str(),
+		IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR);
+	if (descriptor < 0) {
+		return false;
+	}
+	Directory& directory = m_directories.emplace_back();
+	directory.path = folder;
+	directory.descriptor = descriptor;
+	return true;
+}
+
+void
+FileWatcher::listen() {
+	alignas(inotify_event) char buffer[4096];
+	pollfd sources[2] = { { m_inotify, POLLIN, 0 }, { m_wake[0], POLLIN, 0 } };
+	while (!m_stopping.load()) {
+		if (poll(sources, 2, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		if (sources[1].revents != 0) {
+			break;
+		}
+		for (;;) {
+			ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+			if (length <= 0) {
+				break;
+			}
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (const char* at = buffer; at < buffer + length;) {
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+				if (event->len > 0) {
+					for (const Directory& directory : m_directories) {
+						if (directory.descriptor == event->wd) {
+							record(directory.path, event->name, std::strlen(event->name));
+							break;
+						}
+					}
+				}
+				at += sizeof(inotify_event) + event->len;
+			}
+		}
+	}
+}
+
+#endif
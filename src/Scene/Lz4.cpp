@@ -0,0 +1,175 @@
+#include "Scene/Lz4.h"
+#include <cstring>
+
+namespace {
+	constexpr uint32_t kHashBits = 14;
+	constexpr size_t kMinMatch = 4;
+	constexpr size_t kLastLiterals = 5;     ///< Lo que la especificacin pide dejar en literales al final.
+	constexpr size_t kMatchLimit = 12;      ///< Ninguna coincidencia empieza a menos de esto del final.
+	constexpr size_t kMaxOffset = 65535;
+
+	uint32_t
+	read32(const unsigned char* at) {
+		uint32_t value;
+		std::memcpy(&value, at, sizeof(value));
+		return value;
+	}
+
+	uint32_t
+	hashOf(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - kHashBits); }
+
+	/**
+	 * @brief Escribe `length` como 15 en el token ms bytes de 255; `false` si no cabe.
+	 */
+	bool
+	writeLength(unsigned char*& out, const unsigned char* end, size_t length) {
+		for (; length >= 255; length -= 255) {
+			if (out >= end) {
+				return false;
+			}
+			*out++ = 255;
+		}
+		if (out >= end) {
+			return false;
+		}
+		*out++ = static_cast<unsigned char>(length);
+		return true;
+	}
+
+	bool
+	readLength(const unsigned char*& in, const unsigned char* end, size_t& length) {
+		unsigned char byte;
+		do {
+			if (in >= end) {
+				return false;
+			}
+			byte = *in++;
+			length += byte;
+		} while (byte == 255);
+		return true;
+	}
+
+	/**
+	 * @brief Una secuencia: literales `[literals, literals + literalCount)` y, si `matchLength`,
+	 *        la coincidencia a `offset` bytes hacia atrs.
+	 */
+	bool
+	writeSequence(unsigned char*& out, const unsigned char* end, const unsigned char* literals, size_t literalCount,
+		size_t offset, size_t matchLength) {
+		if (out >= end) {
+			return false;
+		}
+		unsigned char* token = out++;
+		*token = static_cast<unsigned char>((literalCount >= 15 ? 15 : literalCount) << 4);
+		if (literalCount >= 15 && !writeLength(out, end, literalCount - 15)) {
+			return false;
+		}
+		if (literalCount > static_cast<size_t>(end - out)) {
+			return false;
+		}
+		if (literalCount) {
+			std::memcpy(out, literals, literalCount);
+			out += literalCount;
+		}
+		if (matchLength == 0) {
+			return true;
+		}
+		if (end - out < 2) {
+			return false;
+		}
+		*out++ = static_cast<unsigned char>(offset & 0xFF);
+		*out++ = static_cast<unsigned char>(offset >> 8);
+		size_t extra = matchLength - kMinMatch;
+		*token |= static_cast<unsigned char>(extra >= 15 ? 15 : extra);
+		return extra < 15 || writeLength(out, end, extra - 15);
+	}
+}
+
+size_t
+Lz4::compress(const unsigned char* source, size_t size, unsigned char* destination, size_t capacity) {
+	unsigned char* out = destination;
+	const unsigned char* end = destination + capacity;
+	size_t anchor = 0;
+	if (size > kMatchLimit) {
+		// Posiciones de la ltima vez que se vio cada hash; 0 al inicio vale, se comprueba el contenido
+		uint32_t table[1u << kHashBits] = {};
+		size_t limit = size - kMatchLimit;
+		size_t matchEnd = size - kLastLiterals;
+		size_t position = 0;
+		while (position < limit) {
+			uint32_t sequence = read32(source + position);
+			uint32_t& slot = table[hashOf(sequence)];
+			size_t candidate = slot;
+			slot = static_cast<uint32_t>(position);
+			if (candidate >= position || position - candidate > kMaxOffset || read32(source + candidate) != sequence) {
+				++position;
+				continue;
+			}
+			size_t length = kMinMatch;
+			while (position + length < matchEnd && source[candidate + length] == source[position + length]) {
+				++length;
+			}
+			if (!writeSequence(out, end, source + anchor, position - anchor, position - candidate, length)) {
+				return 0;
+			}
+			position += length;
+			anchor = position;
+		}
+	}
+	if (!writeSequence(out, end, source + anchor, size - anchor, 0, 0)) {
+		return 0;
+	}
+	return static_cast<size_t>(out - destination);
+}
+
+bool
+Lz4::decompress(const unsigned char* source, size_t sourceSize, unsigned char* destination, size_t size) {
+	const unsigned char* in = source;
+	const unsigned char* inEnd = source + sourceSize;
+	unsigned char* out = destination;
+	unsigned char* outEnd = destination + size;
+	while (in < inEnd) {
+		unsigned char token = *in++;
+		size_t literals = token >> 4;
+		if (literals == 15 && !readLength(in, inEnd, literals)) {
+			return false;
+		}
+		if (literals > static_cast<size_t>(inEnd - in) || literals > static_cast<size_t>(outEnd - out)) {
+			return false;
+		}
+		if (literals) {
+			std::memcpy(out, in, literals);
+			in += literals;
+			out += literals;
+		}
+		// La ltima secuencia no tiene coincidencia
+		if (in == inEnd) {
+			break;
+		}
+		if (inEnd - in < 2) {
+			return false;
+		}
+		size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+		in += 2;
+		size_t length = token & 15;
+		if (length == 15 && !readLength(in, inEnd, length)) {
+			return false;
+		}
+		length += kMinMatch;
+		if (offset == 0 || offset > static_cast<size_t>(out - destination) || length > static_cast<size_t>(outEnd - out)) {
+			return false;
+		}
+		const unsigned char* match = out - offset;
+		if (offset >= length) {
+			std::memcpy(out, match, length);
+			out += length;
+		}
+		else {
+			// Se solapa con lo que escribe: byte a byte repite el patrn
+			for (size_t i = 0; i < length; ++i) {
+				*out++ = match[i];
+			}
+		}
+	}
+	return out == outEnd;
+}
@@ -0,0 +1,229 @@
+#include "Scene/MappedFile.h"
+#include <cstring>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool
+MappedFile::open(const std::string& path) {
+	close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	m_file = file;
+	m_mapping = mapping;
+	m_data = static_cast<const unsigned char*>(view);
+	m_size = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void
+MappedFile::close() {
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		CloseHandle(m_file);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_file = nullptr;
+	m_mapping = nullptr;
+}
+
+bool
+MappedFileWriter::open(const std::string& path, size_t reserve) {
+	close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	m_file = file;
+	m_size = 0;
+	if (!remap(reserve > 0 ? reserve : kGrowBytes)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool
+MappedFileWriter::remap(size_t capacity) {
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		m_data = nullptr;
+		m_mapping = nullptr;
+	}
+	// El mapeo con ms bytes que el archivo lo agranda, con ceros
+	LARGE_INTEGER size;
+	size.QuadPart = static_cast<LONGLONG>(capacity);
+	HANDLE mapping = CreateFileMappingA(m_file, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+	if (!mapping) {
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, capacity);
+	if (!view) {
+		CloseHandle(mapping);
+		return false;
+	}
+	m_mapping = mapping;
+	m_data = static_cast<unsigned char*>(view);
+	m_capacity = capacity;
+	return true;
+}
+
+void
+MappedFileWriter::close() {
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+	}
+	if (m_file) {
+		LARGE_INTEGER end;
+		end.QuadPart = static_cast<LONGLONG>(m_size);
+		SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN);
+		SetEndOfFile(m_file);
+		CloseHandle(m_file);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_capacity = 0;
+	m_file = nullptr;
+	m_mapping = nullptr;
+}
+
+#else
+
+bool
+MappedFile::open(const std::string& path) {
+	close();
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size <= 0) {
+		::close(file);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	// El mapeo sigue vivo sin el descriptor
+	::close(file);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+	m_data = static_cast<const unsigned char*>(view);
+	m_size = static_cast<size_t>(info.st_size);
+	return true;
+}
+
+void
+MappedFile::close() {
+	if (m_data) {
+		munmap(const_cast<unsigned char*>(m_data), m_size);
+	}
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool
+MappedFileWriter::open(const std::string& path, size_t reserve) {
+	close();
+	m_file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_file < 0) {
+		return false;
+	}
+	m_size = 0;
+	if (!remap(reserve > 0 ? reserve : kGrowBytes)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool
+MappedFileWriter::remap(size_t capacity) {
+	if (m_data) {
+		munmap(m_data, m_capacity);
+		m_data = nullptr;
+	}
+	if (ftruncate(m_file, static_cast<off_t>(capacity)) != 0) {
+		return false;
+	}
+	void* view = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+	m_data = static_cast<unsigned char*>(view);
+	m_capacity = capacity;
+	return true;
+}
+
+void
+MappedFileWriter::close() {
+	if (m_data) {
+		munmap(m_data, m_capacity);
+	}
+	if (m_file >= 0) {
+		if (ftruncate(m_file, static_cast<off_t>(m_size)) != 0) {
+			// Quedan ceros al final; el formato ya los reconoce como fin
+		}
+		::close(m_file);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_capacity = 0;
+	m_file = -1;
+}
+
+#endif
+
+bool
+MappedFileWriter::append(const void* data, size_t bytes) {
+	if (!m_data) {
+		return false;
+	}
+	if (m_size + bytes > m_capacity) {
+		size_t capacity = m_capacity;
+		while (m_size + bytes > capacity) {
+			capacity += capacity > kGrowBytes ? capacity : kGrowBytes;
+		}
+		if (!remap(capacity)) {
+			// Sin mapeo no se puede seguir: lo escrito queda en el archivo
+			close();
+			return false;
+		}
+	}
+	std::memcpy(m_data + m_size, data, bytes);
+	m_size += bytes;
+	return true;
+}
@@ -0,0 +1,217 @@
+#include "Scene/PackFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "Jobs/JobSystem.h"
+#include "Scene/Lz4.h"
+
+bool
+PackFile::open(const std::string& path) {
+	reset();
+	if (!m_file.open(path)) {
+		return false;
+	}
+	m_data = m_file.data();
+	m_size = m_file.size();
+	if (!validate()) {
+		reset();
+		return false;
+	}
+	return true;
+}
+
+bool
+PackFile::openMemory(const unsigned char* data, size_t size) {
+	reset();
+	m_data = data;
+	m_size = size;
+	if (!data || reinterpret_cast<uintptr_t>(data) % kPackBlobAlignment != 0 || !validate()) {
+		reset();
+		return false;
+	}
+	return true;
+}
+
+void
+PackFile::reset() {
+	m_file.close();
+	m_data = nullptr;
+	m_size = 0;
+	m_entries = {};
+	m_names = {};
+}
+
+bool
+PackFile::validate() {
+	if (m_size < sizeof(PackHeader)) {
+		return false;
+	}
+	PackHeader header;
+	std::memcpy(&header, m_data, sizeof(header));
+	if (header.magic != kPackMagic || header.version != kPackVersion || header.fileSize != m_size) {
+		return false;
+	}
+	uint64_t tableEnd = sizeof(PackHeader) + uint64_t(header.entryCount) * sizeof(PackEntry);
+	if (tableEnd > m_size || header.namesOffset < tableEnd || header.namesOffset > m_size ||
+		header.namesSize > m_size - header.namesOffset) {
+		return false;
+	}
+	m_entries = std::span<const PackEntry>(
+		reinterpret_cast<const PackEntry*>(m_data + sizeof(PackHeader)), header.entryCount);
+	m_names = std::string_view(reinterpret_cast<const char*>(m_data + header.namesOffset), header.namesSize);
+
+	for (size_t i = 0; i < m_entries.size(); ++i) {
+		const PackEntry& entry = m_entries[i];
+		// Ordenada y sin repetidos: `find` busca en binario
+		if (i > 0 && m_entries[i - 1].id >= entry.id) {
+			return false;
+		}
+		if (entry.offset % kPackBlobAlignment != 0 || entry.offset < tableEnd || entry.offset > m_size ||
+			entry.storedSize > m_size - entry.offset) {
+			return false;
+		}
+		// Los trozos se comprueban al descomprimir; aqu, que quepa su tabla
+		switch (entry.compression) {
+		case PackCompression::None:
+			if (entry.storedSize != entry.size) {
+				return false;
+			}
+			break;
+		case PackCompression::Lz4:
+			if (packChunkCount(entry.size) > entry.storedSize / sizeof(uint32_t)) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+		if (uint64_t(entry.nameOffset) + entry.nameLength > m_names.size()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+PackedAsset
+PackFile::find(AssetId id) const {
+	auto found = std::lower_bound(m_entries.begin(), m_entries.end(), id,
+		[](const PackEntry& entry, AssetId key) { return entry.id < key; });
+	if (found == m_entries.end() || found->id != id) {
+		return PackedAsset();
+	}
+	PackedAsset asset;
+	asset.stored = std::span<const unsigned char>(m_data + found->offset, found->storedSize);
+	asset.size = found->size;
+	asset.contentHash = found->contentHash;
+	asset.compression = found->compression;
+	asset.found = true;
+	return asset;
+}
+
+bool
+PackedAsset::unpackInto(std::span<unsigned char> destination, JobSystem* jobs) const {
+	if (destination.size() != size) {
+		return false;
+	}
+	if (!isCompressed()) {
+		if (size) {
+			std::memcpy(destination.data(), stored.data(), size);
+		}
+		return true;
+	}
+	// Dnde empieza cada trozo; la suma no puede pasar de lo guardado
+	size_t chunkCount = static_cast<size_t>(packChunkCount(size));
+	std::vector<uint64_t> starts(chunkCount + 1);
+	starts[0] = chunkCount * sizeof(uint32_t);
+	for (size_t i = 0; i < chunkCount; ++i) {
+		uint32_t chunkSize;
+		std::memcpy(&chunkSize, stored.data() + i * sizeof(uint32_t), sizeof(chunkSize));
+		starts[i + 1] = starts[i] + chunkSize;
+	}
+	if (starts[chunkCount] > stored.size()) {
+		return false;
+	}
+
+	std::atomic<bool> failed{ false };
+	auto work = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const unsigned char* source = stored.data() + starts[i];
+			size_t sourceSize = static_cast<size_t>(starts[i + 1] - starts[i]);
+			size_t offset = i * kPackChunkSize;
+			size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(kPackChunkSize, size - offset));
+			if (sourceSize == chunkSize) {
+				std::memcpy(destination.data() + offset, source, chunkSize);
+			}
+			else if (!Lz4::decompress(source, sourceSize, destination.data() + offset, chunkSize)) {
+				failed.store(true, std::memory_order_relaxed);
+			}
+		}
+	};
+	if (jobs && chunkCount > 1) {
+		jobs->parallelFor(chunkCount, 1, work);
+	}
+	else {
+		work(0, chunkCount);
+	}
+	return !failed.load(std::memory_order_relaxed);
+}
+
+std::span<const unsigned char>
+PackedAsset::bytes(std::vector<unsigned char>& scratch, JobSystem* jobs) const {
+	if (!isCompressed()) {
+		return stored;
+	}
+	scratch.resize(static_cast<size_t>(size));
+	if (!unpackInto(scratch, jobs)) {
+		scratch.clear();
+		return {};
+	}
+	return scratch;
+}
+
+sf::Int64
+PackStream::read(void* data, sf::Int64 size) {
+	sf::Int64 available = static_cast<sf::Int64>(m_data.size()) - m_position;
+	sf::Int64 count = std::min(size, available);
+	if (count <= 0) {
+		return 0;
+	}
+	std::memcpy(data, m_data.data() + m_position, static_cast<size_t>(count));
+	m_position += count;
+	return count;
+}
+
+sf::Int64
+PackStream::seek(sf::Int64 position) {
+	if (position < 0 || position > static_cast<sf::Int64>(m_data.size())) {
+		return -1;
+	}
+	m_position = position;
+	return m_position;
+}
+
+bool
+PackLibrary::mount(const std::string& path) {
+	EngineUtilities::TUniquePtr<PackFile> pack = EngineUtilities::MakeUnique<PackFile>();
+	if (!pack->open(path)) {
+		MESSAGE("PackLibrary", "mount", "Pack file could not be opened or is invalid");
+		return false;
+	}
+	m_packs.push_back(std::move(pack));
+	return true;
+}
+
+PackedAsset
+PackLibrary::find(std::string_view path) const {
+	if (m_packs.empty()) {
+		return PackedAsset();
+	}
+	AssetId id = assetId(path);
+	for (auto pack = m_packs.rbegin(); pack != m_packs.rend(); ++pack) {
+		PackedAsset asset = (*pack)->find(id);
+		if (asset.found) {
+			return asset;
+		}
+	}
+	return PackedAsset();
+}
@@ -0,0 +1,165 @@
+#include "Scene/PackWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include "Scene/Lz4.h"
+
+void
+PackWriter::add(std::string_view name, std::span<const unsigned char> bytes, PackCompression compression) {
+	for (Blob& blob : m_blobs) {
+		if (blob.name == name) {
+			blob.bytes.assign(bytes.begin(), bytes.end());
+			blob.compression = compression;
+			return;
+		}
+	}
+	m_blobs.push_back({ std::string(name), std::vector<unsigned char>(bytes.begin(), bytes.end()), compression });
+}
+
+bool
+PackWriter::addFile(std::string_view name, const std::string& diskPath, PackCompression compression) {
+	std::ifstream file(diskPath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	add(name, bytes, compression);
+	return true;
+}
+
+std::vector<unsigned char>
+PackWriter::compress(const std::vector<unsigned char>& bytes) {
+	size_t chunkCount = static_cast<size_t>(packChunkCount(bytes.size()));
+	std::vector<unsigned char> stored(chunkCount * sizeof(uint32_t));
+	std::vector<unsigned char> chunk(Lz4::compressBound(kPackChunkSize));
+	for (size_t i = 0; i < chunkCount; ++i) {
+		size_t offset = i * kPackChunkSize;
+		size_t size = std::min<size_t>(kPackChunkSize, bytes.size() - offset);
+		size_t packed = Lz4::compress(bytes.data() + offset, size, chunk.data(), chunk.size());
+		// Un trozo que no se achica va tal cual; el lector lo reconoce por el tamao
+		const unsigned char* source = chunk.data();
+		if (packed == 0 || packed >= size) {
+			packed = size;
+			source = bytes.data() + offset;
+		}
+		uint32_t stored32 = static_cast<uint32_t>(packed);
+		std::memcpy(stored.data() + i * sizeof(uint32_t), &stored32, sizeof(stored32));
+		stored.insert(stored.end(), source, source + packed);
+	}
+	if (stored.size() >= bytes.size()) {
+		return {};
+	}
+	return stored;
+}
+
+std::vector<unsigned char>
+PackWriter::build(Stats* stats) const {
+	// Cada contenido distinto, una vez: `original[i]` es el primer blob igual a `m_blobs[i]`
+	std::vector<size_t> original(m_blobs.size());
+	std::vector<uint64_t> hashes(m_blobs.size());
+	std::unordered_multimap<uint64_t, size_t> byHash;
+	uint64_t sharedBytes = 0;
+	for (size_t i = 0; i < m_blobs.size(); ++i) {
+		hashes[i] = contentHash(m_blobs[i].bytes.data(), m_blobs[i].bytes.size());
+		original[i] = i;
+		auto [first, last] = byHash.equal_range(hashes[i]);
+		for (auto it = first; it != last; ++it) {
+			if (m_blobs[it->second].bytes == m_blobs[i].bytes) {
+				original[i] = it->second;
+				sharedBytes += m_blobs[i].bytes.size();
+				break;
+			}
+		}
+		if (original[i] == i) {
+			byHash.emplace(hashes[i], i);
+		}
+	}
+
+	std::vector<size_t> sorted(m_blobs.size());
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		sorted[i] = i;
+	}
+	std::sort(sorted.begin(), sorted.end(),
+		[this](size_t a, size_t b) { return assetId(m_blobs[a].name) < assetId(m_blobs[b].name); });
+
+	// Lo comprimido, ya en su forma final; vaco si va tal cual o si repite otro contenido
+	std::vector<std::vector<unsigned char>> compressed(m_blobs.size());
+	for (size_t i = 0; i < m_blobs.size(); ++i) {
+		if (original[i] == i && m_blobs[i].compression == PackCompression::Lz4) {
+			compressed[i] = compress(m_blobs[i].bytes);
+		}
+	}
+
+	std::vector<PackEntry> entries(sorted.size());
+	std::string names;
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		const Blob& blob = m_blobs[sorted[i]];
+		entries[i].id = assetId(blob.name);
+		entries[i].nameOffset = static_cast<uint32_t>(names.size());
+		entries[i].nameLength = static_cast<uint32_t>(blob.name.size());
+		entries[i].contentHash = hashes[sorted[i]];
+		names.append(blob.name);
+	}
+
+	PackHeader header;
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.namesSize = static_cast<uint32_t>(names.size());
+	header.namesOffset = sizeof(PackHeader) + entries.size() * sizeof(PackEntry);
+	uint64_t cursor = header.namesOffset + names.size();
+	std::vector<const PackEntry*> placed(m_blobs.size(), nullptr); ///< Entrada que guard cada contenido.
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		size_t blob = original[sorted[i]];
+		if (const PackEntry* shared = placed[blob]) {
+			entries[i].offset = shared->offset;
+			entries[i].size = shared->size;
+			entries[i].compression = shared->compression;
+			entries[i].storedSize = shared->storedSize;
+			continue;
+		}
+		cursor = (cursor + kPackBlobAlignment - 1) & ~(kPackBlobAlignment - 1);
+		entries[i].offset = cursor;
+		entries[i].size = m_blobs[blob].bytes.size();
+		entries[i].compression = compressed[blob].empty() ? PackCompression::None : PackCompression::Lz4;
+		entries[i].storedSize = compressed[blob].empty() ? entries[i].size : compressed[blob].size();
+		cursor += entries[i].storedSize;
+		placed[blob] = &entries[i];
+	}
+	header.fileSize = cursor;
+
+	std::vector<unsigned char> bytes(cursor, 0);
+	std::memcpy(bytes.data(), &header, sizeof(header));
+	if (!entries.empty()) {
+		std::memcpy(bytes.data() + sizeof(header), entries.data(), entries.size() * sizeof(PackEntry));
+	}
+	if (!names.empty()) {
+		std::memcpy(bytes.data() + header.namesOffset, names.data(), names.size());
+	}
+	for (size_t blob = 0; blob < m_blobs.size(); ++blob) {
+		if (!placed[blob]) {
+			continue;
+		}
+		const std::vector<unsigned char>& source = compressed[blob].empty() ? m_blobs[blob].bytes : compressed[blob];
+		if (!source.empty()) {
+			std::memcpy(bytes.data() + placed[blob]->offset, source.data(), source.size());
+		}
+	}
+	if (stats) {
+		stats->entries = m_blobs.size();
+		stats->uniqueBlobs = byHash.size();
+		stats->sharedBytes = sharedBytes;
+	}
+	return bytes;
+}
+
+bool
+PackWriter::write(const std::string& path, Stats* stats) const {
+	std::vector<unsigned char> bytes = build(stats);
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return static_cast<bool>(file);
+}
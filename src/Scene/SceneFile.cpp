@@ -0,0 +1,155 @@
+#include "Scene/SceneFile.h"
+
+bool
+SceneFile::open(const std::string& path) {
+	reset();
+	if (!m_file.open(path)) {
+		return false;
+	}
+	m_data = m_file.data();
+	m_size = m_file.size();
+	if (!validate()) {
+		reset();
+		return false;
+	}
+	return true;
+}
+
+bool
+SceneFile::openMemory(const unsigned char* data, size_t size) {
+	reset();
+	m_data = data;
+	m_size = size;
+	if (!data || reinterpret_cast<uintptr_t>(data) % kSceneSectionAlignment != 0 || !validate()) {
+		reset();
+		return false;
+	}
+	return true;
+}
+
+void
+SceneFile::reset() {
+	m_file.close();
+	m_data = nullptr;
+	m_size = 0;
+	m_sections = {};
+	m_actors = {};
+	m_waypoints = {};
+	m_regions = {};
+	m_regionAssets = {};
+	m_strings = {};
+}
+
+bool
+SceneFile::validate() {
+	if (m_size < sizeof(SceneHeader)) {
+		return false;
+	}
+	SceneHeader header;
+	std::memcpy(&header, m_data, sizeof(header));
+	if (header.magic != kSceneMagic || header.version != kSceneVersion || header.fileSize != m_size) {
+		return false;
+	}
+	uint64_t tableEnd = sizeof(SceneHeader) + uint64_t(header.sectionCount) * sizeof(SceneSection);
+	if (tableEnd > m_size) {
+		return false;
+	}
+	m_sections = std::span<const SceneSection>(
+		reinterpret_cast<const SceneSection*>(m_data + sizeof(SceneHeader)), header.sectionCount);
+
+	for (size_t i = 0; i < m_sections.size(); ++i) {
+		const SceneSection& section = m_sections[i];
+		// Sin desbordes: count * elementSize cabe en el archivo antes de multiplicar
+		if (section.offset % kSceneSectionAlignment != 0 || section.offset < tableEnd || section.offset > m_size) {
+			return false;
+		}
+		if (section.elementSize == 0 || section.count > (m_size - section.offset) / section.elementSize) {
+			return false;
+		}
+		switch (section.kind) {
+		case SceneSectionKind::Actors:
+			if (section.elementSize != sizeof(SceneActorRecord)) {
+				return false;
+			}
+			m_actors = sectionSpan<SceneActorRecord>(section);
+			break;
+		case SceneSectionKind::Strings:
+			if (section.elementSize != 1) {
+				return false;
+			}
+			m_strings = std::string_view(reinterpret_cast<const char*>(m_data + section.offset), section.count);
+			break;
+		case SceneSectionKind::Waypoints:
+			if (section.elementSize != sizeof(ScenePoint)) {
+				return false;
+			}
+			m_waypoints = sectionSpan<ScenePoint>(section);
+			break;
+		case SceneSectionKind::ComponentOwners:
+			if (section.elementSize != sizeof(uint32_t)) {
+				return false;
+			}
+			break;
+		case SceneSectionKind::ComponentData: {
+			// Cada seccin de datos va precedida por la de sus dueos, del mismo tipo y tamao
+			if (i == 0) {
+				return false;
+			}
+			const SceneSection& owners = m_sections[i - 1];
+			if (owners.kind != SceneSectionKind::ComponentOwners || owners.typeHash != section.typeHash ||
+				owners.count != section.count) {
+				return false;
+			}
+			break;
+		}
+		case SceneSectionKind::Regions:
+			if (section.elementSize != sizeof(SceneRegionRecord)) {
+				return false;
+			}
+			m_regions = sectionSpan<SceneRegionRecord>(section);
+			break;
+		case SceneSectionKind::RegionAssets:
+			if (section.elementSize != sizeof(SceneRegionAsset)) {
+				return false;
+			}
+			m_regionAssets = sectionSpan<SceneRegionAsset>(section);
+			break;
+		default:
+			// Secciones que esta versin no conoce: se ignoran
+			break;
+		}
+	}
+
+	for (const SceneActorRecord& actor : m_actors) {
+		if (uint64_t(actor.nameOffset) + actor.nameLength > m_strings.size()) {
+			return false;
+		}
+	}
+	// Cada actor est en una regin como mucho: tramos ordenados que no se pisan
+	uint64_t regionEnd = 0;
+	for (const SceneRegionRecord& region : m_regions) {
+		uint64_t last = uint64_t(region.firstActor) + region.actorCount;
+		if (region.firstActor < regionEnd || last > m_actors.size() ||
+			uint64_t(region.firstAsset) + region.assetCount > m_regionAssets.size() ||
+			!(region.minX <= region.maxX && region.minY <= region.maxY)) {
+			return false;
+		}
+		regionEnd = last;
+	}
+	for (const SceneRegionAsset& asset : m_regionAssets) {
+		if (uint64_t(asset.pathOffset) + asset.pathLength > m_strings.size()) {
+			return false;
+		}
+	}
+	for (const SceneSection& section : m_sections) {
+		if (section.kind != SceneSectionKind::ComponentOwners) {
+			continue;
+		}
+		for (uint32_t owner : sectionSpan<uint32_t>(section)) {
+			if (owner >= m_actors.size()) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
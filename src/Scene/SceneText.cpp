@@ -0,0 +1,359 @@
+#include "Scene/SceneText.h"
+#include <charconv>
+#include <vector>
+#include "Prerequisites.h"
+#include "AssetStreamer.h"
+#include "Scene/MappedFile.h"
+
+namespace {
+
+	/**
+	 * @brief Lo que falta leer de una lnea; las palabras son tramos de ella, nunca copias.
+	 */
+	struct Cursor {
+		const char* at;
+		const char* end;
+	};
+
+	bool
+	isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+	void
+	skipBlanks(Cursor& cursor) {
+		while (cursor.at < cursor.end && isBlank(*cursor.at)) {
+			++cursor.at;
+		}
+	}
+
+	/**
+	 * @brief Siguiente palabra de la lnea; vaca al final o donde empieza un comentario.
+	 */
+	std::string_view
+	readWord(Cursor& cursor) {
+		skipBlanks(cursor);
+		const char* start = cursor.at;
+		while (cursor.at < cursor.end && !isBlank(*cursor.at) && *cursor.at != '#') {
+			++cursor.at;
+		}
+		return std::string_view(start, static_cast<size_t>(cursor.at - start));
+	}
+
+	/**
+	 * @brief El resto de la lnea sin los blancos de los lados ni el comentario.
+	 */
+	std::string_view
+	readRest(Cursor& cursor) {
+		skipBlanks(cursor);
+		const char* start = cursor.at;
+		const char* last = start;
+		while (cursor.at < cursor.end && *cursor.at != '#') {
+			if (!isBlank(*cursor.at++)) {
+				last = cursor.at;
+			}
+		}
+		return std::string_view(start, static_cast<size_t>(last - start));
+	}
+
+	bool
+	readFloat(Cursor& cursor, float& value) {
+		std::string_view word = readWord(cursor);
+		if (!word.empty() && word.front() == '+') {
+			word.remove_prefix(1);
+		}
+		std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), value);
+		return !word.empty() && result.ec == std::errc() && result.ptr == word.data() + word.size();
+	}
+
+	/**
+	 * @brief Entero sin signo en decimal o, con `0x`, en hexadecimal.
+	 */
+	bool
+	parseUnsigned(std::string_view word, uint64_t& value) {
+		int base = 10;
+		if (word.size() > 2 && word[0] == '0' && (word[1] == 'x' || word[1] == 'X')) {
+			word.remove_prefix(2);
+			base = 16;
+		}
+		std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), value, base);
+		return !word.empty() && result.ec == std::errc() && result.ptr == word.data() + word.size();
+	}
+
+	bool
+	readUnsigned(Cursor& cursor, uint64_t& value) {
+		return parseUnsigned(readWord(cursor), value);
+	}
+
+	/**
+	 * @brief `R G B [A]` de 0 a 255, o `0xRRGGBB[AA]`; deja RGBA como `sf::Color::toInteger`.
+	 */
+	bool
+	readColor(Cursor& cursor, uint32_t& rgba) {
+		std::string_view word = readWord(cursor);
+		if (word.size() > 2 && word[0] == '0' && (word[1] == 'x' || word[1] == 'X')) {
+			uint64_t hex = 0;
+			word.remove_prefix(2);
+			std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), hex, 16);
+			if ((word.size() != 6 && word.size() != 8) || result.ec != std::errc() || result.ptr != word.data() + word.size()) {
+				return false;
+			}
+			rgba = word.size() == 6 ? static_cast<uint32_t>(hex << 8 | 0xFFu) : static_cast<uint32_t>(hex);
+			return true;
+		}
+		uint64_t channels[4] = { 0, 0, 0, 255 };
+		size_t count = 0;
+		for (; !word.empty() && count < 4; word = readWord(cursor)) {
+			if (!parseUnsigned(word, channels[count]) || channels[count] > 255) {
+				return false;
+			}
+			if (++count == 4) {
+				break;
+			}
+		}
+		if (count < 3) {
+			return false;
+		}
+		rgba = static_cast<uint32_t>(channels[0] << 24 | channels[1] << 16 | channels[2] << 8 | channels[3]);
+		return true;
+	}
+
+	bool
+	readBool(Cursor& cursor, bool& value) {
+		std::string_view word = readWord(cursor);
+		if (word == "true" || word == "1") {
+			value = true;
+			return true;
+		}
+		if (word == "false" || word == "0") {
+			value = false;
+			return true;
+		}
+		return false;
+	}
+
+	bool
+	readShape(Cursor& cursor, uint32_t& shapeType) {
+		static constexpr std::pair<std::string_view, ShapeType> kShapes[] = {
+			{ "empty", ShapeType::EMPTY }, { "circle", ShapeType::CIRCLE },
+			{ "rectangle", ShapeType::RECTANGLE }, { "triangle", ShapeType::TRIANGLE }
+		};
+		std::string_view word = readWord(cursor);
+		for (const auto& [name, type] : kShapes) {
+			if (word == name) {
+				shapeType = static_cast<uint32_t>(type);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool
+	readAssetKind(Cursor& cursor, uint32_t& kind) {
+		static constexpr std::pair<std::string_view, AssetKind> kKinds[] = {
+			{ "texture", AssetKind::Texture }, { "font", AssetKind::Font },
+			{ "sound", AssetKind::Sound }, { "mesh", AssetKind::Mesh }
+		};
+		std::string_view word = readWord(cursor);
+		for (const auto& [name, value] : kKinds) {
+			if (word == name) {
+				kind = static_cast<uint32_t>(value);
+				return true;
+			}
+		}
+		return false;
+	}
+
+} // namespace
+
+bool
+SceneText::hasTextExtension(std::string_view path) {
+	return path.size() >= kExtension.size() && path.substr(path.size() - kExtension.size()) == kExtension;
+}
+
+bool
+SceneText::parse(std::string_view text, SceneWriter& writer, std::string* error) {
+	std::vector<ScenePoint> waypoints;
+	std::vector<uint32_t> owners;
+	std::vector<SceneActorMasks> masks;
+	std::string name;
+	SceneActorRecord record;
+	SceneActorMasks mask;
+	bool inActor = false;
+	auto finishActor = [&]() {
+		if (inActor) {
+			owners.push_back(writer.addActor(name, record));
+			masks.push_back(mask);
+		}
+		inActor = false;
+	};
+
+	// La regin abierta se lleva los actores que siguen hasta `endregion` o la prxima
+	SceneRegionRecord region;
+	std::vector<std::pair<uint32_t, std::string>> regionAssets;
+	bool inRegion = false;
+	auto finishRegion = [&]() {
+		if (inRegion) {
+			region.actorCount = static_cast<uint32_t>(owners.size()) - region.firstActor;
+			uint32_t index = writer.addRegion(region);
+			for (const auto& [kind, path] : regionAssets) {
+				writer.addRegionAsset(index, kind, path);
+			}
+		}
+		regionAssets.clear();
+		inRegion = false;
+	};
+
+	const char* at = text.data();
+	const char* end = text.data() + text.size();
+	for (size_t line = 1; at < end; ++line) {
+		const char* lineEnd = at;
+		while (lineEnd < end && *lineEnd != '\n') {
+			++lineEnd;
+		}
+		Cursor cursor{ at, lineEnd };
+		at = lineEnd < end ? lineEnd + 1 : end;
+
+		auto fail = [error, line](const char* what) {
+			if (error) {
+				*error = "line " + std::to_string(line) + ": " + what;
+			}
+			return false;
+		};
+
+		std::string_view keyword = readWord(cursor);
+		if (keyword.empty()) {
+			continue;
+		}
+		if (keyword == "actor") {
+			finishActor();
+			name = readRest(cursor);
+			if (name.empty()) {
+				return fail("actor without a name");
+			}
+			record = SceneActorRecord();
+			record.flags = kSceneActorActive;
+			mask = SceneActorMasks();
+			inActor = true;
+			continue;
+		}
+		if (keyword == "region" || keyword == "endregion") {
+			finishActor();
+			finishRegion();
+			if (keyword == "region") {
+				region = SceneRegionRecord();
+				if (!readFloat(cursor, region.minX) || !readFloat(cursor, region.minY) ||
+					!readFloat(cursor, region.maxX) || !readFloat(cursor, region.maxY) ||
+					region.minX > region.maxX || region.minY > region.maxY) {
+					return fail("region expects minX minY maxX maxY");
+				}
+				region.firstActor = static_cast<uint32_t>(owners.size());
+				inRegion = true;
+			}
+		}
+		else if (keyword == "asset") {
+			uint32_t kind = 0;
+			if (!inRegion) {
+				return fail("asset outside of a region");
+			}
+			if (!readAssetKind(cursor, kind)) {
+				return fail("asset expects texture, font, sound or mesh and a path");
+			}
+			std::string path(readRest(cursor));
+			if (path.empty()) {
+				return fail("asset expects texture, font, sound or mesh and a path");
+			}
+			regionAssets.emplace_back(kind, std::move(path));
+			continue;
+		}
+		else if (keyword == "waypoint") {
+			ScenePoint point;
+			if (!readFloat(cursor, point.x) || !readFloat(cursor, point.y)) {
+				return fail("waypoint expects x y");
+			}
+			waypoints.push_back(point);
+		}
+		else if (!inActor) {
+			return fail("actor property before any actor line");
+		}
+		else if (keyword == "shape") {
+			if (!readShape(cursor, record.shapeType)) {
+				return fail("shape expects empty, circle, rectangle or triangle");
+			}
+		}
+		else if (keyword == "color") {
+			if (!readColor(cursor, record.fillColor)) {
+				return fail("color expects R G B [A] from 0 to 255 or 0xRRGGBB[AA]");
+			}
+		}
+		else if (keyword == "position") {
+			if (!readFloat(cursor, record.positionX) || !readFloat(cursor, record.positionY)) {
+				return fail("position expects x y");
+			}
+		}
+		else if (keyword == "rotation") {
+			if (!readFloat(cursor, record.rotation)) {
+				return fail("rotation expects degrees");
+			}
+		}
+		else if (keyword == "scale") {
+			if (!readFloat(cursor, record.scaleX) || !readFloat(cursor, record.scaleY)) {
+				return fail("scale expects x y");
+			}
+		}
+		else if (keyword == "tags") {
+			if (!readUnsigned(cursor, mask.tags)) {
+				return fail("tags expects a mask");
+			}
+		}
+		else if (keyword == "layers") {
+			if (!readUnsigned(cursor, mask.layers)) {
+				return fail("layers expects a mask");
+			}
+		}
+		else if (keyword == "active") {
+			bool active = true;
+			if (!readBool(cursor, active)) {
+				return fail("active expects true or false");
+			}
+			record.flags = active ? (record.flags | kSceneActorActive) : (record.flags & ~kSceneActorActive);
+		}
+		else {
+			return fail("unknown keyword");
+		}
+		if (!readWord(cursor).empty()) {
+			return fail("unexpected text after the values");
+		}
+	}
+	finishActor();
+	finishRegion();
+
+	writer.addComponents<SceneActorMasks>("EntityMasks", owners, masks);
+	writer.setWaypoints(waypoints);
+	return true;
+}
+
+bool
+SceneText::parseFile(const std::string& path, SceneWriter& writer, std::string* error) {
+	MappedFile file;
+	if (!file.open(path)) {
+		if (error) {
+			*error = "could not open " + path;
+		}
+		return false;
+	}
+	return parse(std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), writer, error);
+}
+
+bool
+SceneText::cookFile(const std::string& textPath, const std::string& scenePath, std::string* error) {
+	SceneWriter writer;
+	if (!parseFile(textPath, writer, error)) {
+		return false;
+	}
+	if (!writer.write(scenePath)) {
+		if (error) {
+			*error = "could not write " + scenePath;
+		}
+		return false;
+	}
+	return true;
+}
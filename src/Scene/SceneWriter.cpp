@@ -0,0 +1,112 @@
+#include "Scene/SceneWriter.h"
+#include <fstream>
+
+namespace {
+	/**
+	 * @brief Reserva lugar para una seccin y la anota en la tabla.
+	 */
+	void
+	addSection(std::vector<SceneSection>& sections, uint64_t& cursor, SceneSectionKind kind,
+		uint32_t elementSize, uint64_t count, uint64_t typeHash = 0) {
+		cursor = (cursor + kSceneSectionAlignment - 1) & ~(kSceneSectionAlignment - 1);
+		sections.push_back({ kind, elementSize, count, cursor, typeHash });
+		cursor += uint64_t(elementSize) * count;
+	}
+}
+
+uint32_t
+SceneWriter::addActor(std::string_view name, SceneActorRecord record) {
+	record.nameOffset = static_cast<uint32_t>(m_strings.size());
+	record.nameLength = static_cast<uint32_t>(name.size());
+	m_strings.append(name);
+	m_actors.push_back(record);
+	return static_cast<uint32_t>(m_actors.size() - 1);
+}
+
+uint32_t
+SceneWriter::addRegion(SceneRegionRecord record) {
+	assert((m_regions.empty() || record.firstActor >= m_regions.back().firstActor + m_regions.back().actorCount) &&
+		"Regiones en orden de actores y sin pisarse");
+	record.firstAsset = 0;
+	record.assetCount = 0;
+	m_regions.push_back(record);
+	m_regionAssets.emplace_back();
+	return static_cast<uint32_t>(m_regions.size() - 1);
+}
+
+void
+SceneWriter::addRegionAsset(uint32_t region, uint32_t kind, std::string_view path) {
+	assert(region < m_regions.size() && "Regin de addRegion");
+	SceneRegionAsset asset;
+	asset.kind = kind;
+	asset.pathOffset = static_cast<uint32_t>(m_strings.size());
+	asset.pathLength = static_cast<uint32_t>(path.size());
+	m_strings.append(path);
+	m_regionAssets[region].push_back(asset);
+}
+
+std::vector<unsigned char>
+SceneWriter::build() const {
+	// Sin regiones no se escriben sus secciones: el archivo queda como los de antes
+	std::vector<SceneRegionRecord> regions = m_regions;
+	std::vector<SceneRegionAsset> assets;
+	for (size_t i = 0; i < regions.size(); ++i) {
+		regions[i].firstAsset = static_cast<uint32_t>(assets.size());
+		regions[i].assetCount = static_cast<uint32_t>(m_regionAssets[i].size());
+		assets.insert(assets.end(), m_regionAssets[i].begin(), m_regionAssets[i].end());
+	}
+	uint32_t regionSections = regions.empty() ? 0 : 2;
+	uint32_t sectionCount = 3 + static_cast<uint32_t>(m_components.size()) * 2 + regionSections;
+	uint64_t cursor = sizeof(SceneHeader) + uint64_t(sectionCount) * sizeof(SceneSection);
+
+	std::vector<SceneSection> sections;
+	sections.reserve(sectionCount);
+	addSection(sections, cursor, SceneSectionKind::Actors, sizeof(SceneActorRecord), m_actors.size());
+	addSection(sections, cursor, SceneSectionKind::Strings, 1, m_strings.size());
+	addSection(sections, cursor, SceneSectionKind::Waypoints, sizeof(ScenePoint), m_waypoints.size());
+	for (const ComponentBlock& block : m_components) {
+		addSection(sections, cursor, SceneSectionKind::ComponentOwners, sizeof(uint32_t), block.owners.size(), block.typeHash);
+		addSection(sections, cursor, SceneSectionKind::ComponentData, block.elementSize,
+			block.bytes.size() / block.elementSize, block.typeHash);
+	}
+	if (regionSections) {
+		addSection(sections, cursor, SceneSectionKind::Regions, sizeof(SceneRegionRecord), regions.size());
+		addSection(sections, cursor, SceneSectionKind::RegionAssets, sizeof(SceneRegionAsset), assets.size());
+	}
+
+	std::vector<unsigned char> bytes(cursor, 0);
+	SceneHeader header;
+	header.sectionCount = sectionCount;
+	header.fileSize = cursor;
+	std::memcpy(bytes.data(), &header, sizeof(header));
+	std::memcpy(bytes.data() + sizeof(header), sections.data(), sections.size() * sizeof(SceneSection));
+
+	auto copy = [&bytes](const SceneSection& section, const void* source) {
+		if (section.count) {
+			std::memcpy(bytes.data() + section.offset, source, section.count * section.elementSize);
+		}
+	};
+	copy(sections[0], m_actors.data());
+	copy(sections[1], m_strings.data());
+	copy(sections[2], m_waypoints.data());
+	for (size_t i = 0; i < m_components.size(); ++i) {
+		copy(sections[3 + i * 2], m_components[i].owners.data());
+		copy(sections[4 + i * 2], m_components[i].bytes.data());
+	}
+	if (regionSections) {
+		copy(sections[sectionCount - 2], regions.data());
+		copy(sections[sectionCount - 1], assets.data());
+	}
+	return bytes;
+}
+
+bool
+SceneWriter::write(const std::string& path) const {
+	std::vector<unsigned char> bytes = build();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,246 @@
+#include "SceneGraph.h"
+#include <algorithm>
+#include "Actor.h"
+#include "Math/VectorBatch.h"
+#include "Memory/ServiceLocator.h"
+
+bool
+SceneGraph::attach(Actor& child, Actor& parent) {
+	if (&child == &parent) {
+		return false;
+	}
+	// Un `Transform` que ya estaba con otro actor: el de antes muri y su pool lo reutiliz.
+	// Se limpia antes de tomar ndices, que `rebuild` cambia
+	auto stale = [this](Actor& actor) {
+		auto it = m_lookup.find(actor.findComponent<Transform>());
+		return it != m_lookup.end() && m_nodes[it->second].entity != actor.getHandle();
+	};
+	if (stale(child) || stale(parent)) {
+		rebuild();
+	}
+	uint32_t childIndex = nodeOf(child);
+	uint32_t parentIndex = nodeOf(parent);
+	if (childIndex == kNoParent || parentIndex == kNoParent) {
+		return false;
+	}
+	const Transform* childTransform = m_nodes[childIndex].transform.get();
+	const Transform* parentTransform = m_nodes[parentIndex].transform.get();
+
+	// `parent` no puede colgar, de cerca o de lejos, de `child`
+	for (const Transform* above = parentTransform; above; above = m_nodes[m_lookup.at(above)].parentTransform) {
+		if (above == childTransform) {
+			ERROR("SceneGraph", "attach", "An actor can't be attached to one of its own descendants");
+			return false;
+		}
+	}
+	if (m_nodes[childIndex].parentTransform != parentTransform) {
+		m_nodes[childIndex].parentTransform = parentTransform;
+		m_nodes[childIndex].transform->setParent(parentTransform);
+		m_structureChanged = true;
+	}
+	return true;
+}
+
+void
+SceneGraph::detach(Actor& child) {
+	const Transform* transform = child.findComponent<Transform>();
+	auto it = transform ? m_lookup.find(transform) : m_lookup.end();
+	if (it == m_lookup.end() || m_nodes[it->second].entity != child.getHandle()) {
+		return;
+	}
+	Node& node = m_nodes[it->second];
+	if (node.parentTransform) {
+		node.parentTransform = nullptr;
+		node.transform->setParent(nullptr);
+		m_structureChanged = true;
+	}
+}
+
+EntityHandle
+SceneGraph::parentOf(const Actor& child) const {
+	const Transform* transform = child.findComponent<Transform>();
+	auto it = transform ? m_lookup.find(transform) : m_lookup.end();
+	if (it == m_lookup.end() || m_nodes[it->second].entity != child.getHandle() || !m_nodes[it->second].parentTransform) {
+		return EntityHandle{};
+	}
+	return m_nodes[m_lookup.at(m_nodes[it->second].parentTransform)].entity;
+}
+
+void
+SceneGraph::update() {
+	// Un actor muerto deja a sus hijos sueltos antes de que alguien lea su matriz
+	EntityRegistry& registry = EngineUtilities::TService<EntityRegistry>::instance();
+	for (size_t i = 0; i < m_nodes.size() && !m_structureChanged; ++i) {
+		m_structureChanged = !registry.contains(m_nodes[i].entity);
+	}
+	if (m_structureChanged) {
+		rebuild();
+	}
+
+	m_lastRecomputed = 0;
+	m_dirty.assign(m_nodes.size(), 0);
+	auto arrays = [this](size_t first) {
+		return VectorBatch::Affine2DArrays{ m_scratch[first].data(), m_scratch[first + 1].data(), m_scratch[first + 2].data(),
+			m_scratch[first + 3].data(), m_scratch[first + 4].data(), m_scratch[first + 5].data() };
+	};
+
+	for (size_t level = 0; level + 1 < m_levelStart.size(); ++level) {
+		// Sucio: cambi su `Transform` o se recalcul su padre (los padres ya pasaron)
+		m_batch.clear();
+		for (uint32_t i = m_levelStart[level]; i < m_levelStart[level + 1]; ++i) {
+			const Node& node = m_nodes[i];
+			if (node.transform->getLocalVersion() != node.seenLocal || (node.parent != kNoParent && m_dirty[node.parent])) {
+				m_dirty[i] = 1;
+				m_batch.push_back(i);
+			}
+		}
+		if (m_batch.empty()) {
+			continue;
+		}
+		size_t count = m_batch.size();
+		if (m_scratch[0].size() < count) {
+			for (std::vector<float>& column : m_scratch) {
+				column.resize(count);
+			}
+		}
+
+		// Padres y locales a arreglos separados; la raz no tiene padre y su matriz es la local
+		VectorBatch::Affine2DArrays parents = arrays(0);
+		VectorBatch::Affine2DArrays locals = arrays(6);
+		VectorBatch::Affine2DArrays worlds = level == 0 ? locals : arrays(12);
+		for (size_t k = 0; k < count; ++k) {
+			Node& node = m_nodes[m_batch[k]];
+			const float* local = node.transform->getLocalTransform().getMatrix();
+			node.seenLocal = node.transform->getLocalVersion();
+			locals.a[k] = local[0];
+			locals.b[k] = local[1];
+			locals.c[k] = local[4];
+			locals.d[k] = local[5];
+			locals.tx[k] = local[12];
+			locals.ty[k] = local[13];
+			if (level > 0) {
+				parents.a[k] = m_world[0][node.parent];
+				parents.b[k] = m_world[1][node.parent];
+				parents.c[k] = m_world[2][node.parent];
+				parents.d[k] = m_world[3][node.parent];
+				parents.tx[k] = m_world[4][node.parent];
+				parents.ty[k] = m_world[5][node.parent];
+			}
+		}
+		if (level > 0) {
+			VectorBatch::composeAffine2D(parents, locals, worlds, count);
+		}
+
+		for (size_t k = 0; k < count; ++k) {
+			uint32_t i = m_batch[k];
+			m_world[0][i] = worlds.a[k];
+			m_world[1][i] = worlds.b[k];
+			m_world[2][i] = worlds.c[k];
+			m_world[3][i] = worlds.d[k];
+			m_world[4][i] = worlds.tx[k];
+			m_world[5][i] = worlds.ty[k];
+			m_nodes[i].transform->setWorldTransform(sf::Transform(worlds.a[k], worlds.c[k], worlds.tx[k],
+			                                                      worlds.b[k], worlds.d[k], worlds.ty[k],
+			                                                      0.0f, 0.0f, 1.0f));
+		}
+		m_lastRecomputed += count;
+	}
+}
+
+uint32_t
+SceneGraph::nodeOf(Actor& actor) {
+	EngineUtilities::TIntrusivePtr<Transform> transform = actor.getComponent<Transform>();
+	if (!transform) {
+		return kNoParent;
+	}
+	auto it = m_lookup.find(transform.get());
+	if (it != m_lookup.end()) {
+		return it->second;
+	}
+	uint32_t index = static_cast<uint32_t>(m_nodes.size());
+	Node& node = m_nodes.emplace_back();
+	node.transform = transform;
+	node.entity = actor.getHandle();
+	// La jerarqua la lleva el grafo: un padre puesto a mano con `setParent` se suelta
+	if (transform->getParent()) {
+		transform->setParent(nullptr);
+	}
+	node.seenLocal = transform->getLocalVersion() + 1;
+	m_lookup.emplace(transform.get(), index);
+	m_structureChanged = true;
+	return index;
+}
+
+void
+SceneGraph::rebuild() {
+	EntityRegistry& registry = EngineUtilities::TService<EntityRegistry>::instance();
+	std::vector<uint8_t>& alive = m_dirty;
+	alive.resize(m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		alive[i] = registry.contains(m_nodes[i].entity);
+		m_nodes[i].children = 0;
+	}
+
+	// Los hijos de un muerto quedan sueltos; los dems cuentan para su padre
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		Node& node = m_nodes[i];
+		if (!alive[i] || !node.parentTransform) {
+			continue;
+		}
+		auto parent = m_lookup.find(node.parentTransform);
+		if (parent == m_lookup.end() || !alive[parent->second]) {
+			node.parentTransform = nullptr;
+			node.transform->setParent(nullptr);
+			continue;
+		}
+		++m_nodes[parent->second].children;
+	}
+
+	// Se quedan los vivos con padre o con hijos
+	size_t kept = 0;
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		if (alive[i] && (m_nodes[i].parentTransform || m_nodes[i].children > 0)) {
+			if (kept != i) {
+				m_nodes[kept] = std::move(m_nodes[i]);
+			}
+			++kept;
+		}
+	}
+	m_nodes.resize(kept);
+	m_lookup.clear();
+	for (uint32_t i = 0; i < m_nodes.size(); ++i) {
+		m_lookup.emplace(m_nodes[i].transform.get(), i);
+	}
+
+	// Profundidad subiendo hasta la raz; la jerarqua cambia poco y es baja
+	for (Node& node : m_nodes) {
+		node.depth = 0;
+		for (const Transform* above = node.parentTransform; above; above = m_nodes[m_lookup.at(above)].parentTransform) {
+			++node.depth;
+		}
+	}
+	std::stable_sort(m_nodes.begin(), m_nodes.end(), [](const Node& a, const Node& b) { return a.depth < b.depth; });
+
+	// ndices nuevos, padres por ndice y el primero de cada nivel. Todo se recalcula una vez
+	m_levelStart.clear();
+	for (uint32_t i = 0; i < m_nodes.size(); ++i) {
+		m_lookup[m_nodes[i].transform.get()] = i;
+		while (m_levelStart.size() <= m_nodes[i].depth) {
+			m_levelStart.push_back(i);
+		}
+	}
+	m_levelStart.push_back(static_cast<uint32_t>(m_nodes.size()));
+	for (Node& node : m_nodes) {
+		node.parent = node.parentTransform ? m_lookup.at(node.parentTransform) : kNoParent;
+		node.seenLocal = node.transform->getLocalVersion() + 1;
+	}
+	for (std::vector<float>& column : m_world) {
+		column.resize(m_nodes.size());
+	}
+	m_structureChanged = false;
+}
+
+SceneGraph&
+SceneGraph::instance() {
+	return EngineUtilities::TService<SceneGraph>::instance();
+}
@@ -1,48 +1,216 @@
 #include "ShapeFactory.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "Math/UnitShapes.h"
+#include "Render/LayerCache.h"
+#include "Render/StaticGeometryCache.h"
+#include "TShape.h"
 
-sf::Shape*
-ShapeFactory::createShape(ShapeType shapeType) {
-	m_shapeType = shapeType;
-	switch (shapeType) {
-	case EMPTY: {
-		return nullptr;
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SEEK_AVX 1
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SEEK_SSE 1
+#endif
+
+namespace {
+	constexpr float kCircleRadius = ShapeTraits<CIRCLE>::kWidth;
+
+	/**
+	 * @brief Geometra compartida de `type` con `texture`; las medidas son las de `ShapeTraits`.
+	 */
+	const ShapeGeometry*
+	findGeometry(ShapeType type, const sf::Texture* texture) {
+		switch (type) {
+		case CIRCLE:
+			return findShapeGeometry<CIRCLE>(texture);
+		case RECTANGLE:
+			return findShapeGeometry<RECTANGLE>(texture);
+		case TRIANGLE:
+			return findShapeGeometry<TRIANGLE>(texture);
+		default:
+			return nullptr;
+		}
 	}
-	case CIRCLE: {
-		sf::CircleShape* circle = new sf::CircleShape(10.0f);
-		circle->setFillColor(sf::Color::White);
-		m_shape = circle;
-		return circle;
+
+	constexpr std::array<uint8_t, ShapeFactory::kCircleLodLevels> kLodPoints = { 6, 8, 12, 16, 24, 32, 48, 64 };
+	constexpr float kLodMaxError = 0.5f; ///< Distancia mxima en pxeles entre el crculo y su contorno.
+
+	/**
+	 * @brief Radio en pxeles hasta el que alcanza cada nivel. Flecha de la cuerda:
+	 *        r (1 - cos(pi / n)) <= error.
+	 */
+	constexpr std::array<float, ShapeFactory::kCircleLodLevels> kLodMaxRadius = []() {
+		std::array<float, ShapeFactory::kCircleLodLevels> result{};
+		for (size_t level = 0; level < kLodPoints.size(); ++level) {
+			result[level] = kLodMaxError / UnitShapes::sagitta(kLodPoints[level]);
+		}
+		return result;
+	}();
+
+	/**
+	 * @brief Contornos compartidos de cada nivel, escalados de las tablas de `UnitShapes`.
+	 */
+	struct CircleLods {
+		std::array<std::vector<sf::Vector2f>, ShapeFactory::kCircleLodLevels> outlines;
+
+		CircleLods() {
+			for (size_t level = 0; level < kLodPoints.size(); ++level) {
+				for (const UnitShapes::Point& unit : UnitShapes::polygon(kLodPoints[level])) {
+					outlines[level].emplace_back(unit.x * kCircleRadius + kCircleRadius, unit.y * kCircleRadius + kCircleRadius);
+				}
+			}
+		}
+	};
+
+	const CircleLods&
+	circleLods() {
+		static const CircleLods s_lods;
+		return s_lods;
 	}
-	case RECTANGLE: {
-		sf::RectangleShape* rectangle = new sf::RectangleShape(sf::Vector2(100.0f, 50.0f));
-		rectangle->setFillColor(sf::Color::White);
-		m_shape = rectangle;
-		return rectangle;
+}
+
+ShapeFactory::~ShapeFactory() {
+	setStatic(false);
+}
+
+void
+ShapeFactory::setStatic(bool isStatic) {
+	if (isStatic == this->isStatic()) {
+		return;
 	}
-	case TRIANGLE: {
-		sf::CircleShape* triangle = new sf::CircleShape(50.0f, 3);
-		triangle->setFillColor(sf::Color::White);
-		m_shape = triangle;
-		return triangle;
+	if (isStatic) {
+		EngineUtilities::TService<StaticGeometryCache>::instance().add(*this);
 	}
-	default:
-		return nullptr;
+	else if (StaticGeometryCache* cache = EngineUtilities::TService<StaticGeometryCache>::get()) {
+		cache->remove(*this);
 	}
+	else {
+		m_staticIndex = UINT32_MAX;
+	}
+}
+
+const sf::Shape*
+ShapeFactory::createShape(ShapeType shapeType) {
+	markChanged();
+	m_shapeType = shapeType;
+	m_lod = UINT8_MAX;
+	m_texture = nullptr;
+	m_fillColor = sf::Color::White;
+	m_position = sf::Vector2f();
+	m_geometry = findGeometry(shapeType, nullptr);
+	return getShape();
+}
+
+void
+ShapeFactory::setTexture(const sf::Texture* texture) {
+	m_texture = texture;
+	m_geometry = findGeometry(m_shapeType, texture);
+	markChanged();
 }
 
 void 
 ShapeFactory::setPosition(float x, float y) {
-	m_shape->setPosition(x, y);
+	setPosition(sf::Vector2f(x, y));
 }
 
 void 
 ShapeFactory::setPosition(const sf::Vector2f& position) {
-	m_shape->setPosition(position);
+	if (m_transform) {
+		m_transform->setPosition(position);
+		return;
+	}
+	m_position = position;
+	markChanged();
+}
+
+sf::Vector2f
+ShapeFactory::getPosition() const {
+	if (m_transform) {
+		return m_transform->getPosition();
+	}
+	return m_position;
+}
+
+sf::Transform
+ShapeFactory::getWorldTransform() const {
+	if (m_transform) {
+		return m_transform->getWorldTransform();
+	}
+	return sf::Transform().translate(m_position);
+}
+
+void
+ShapeFactory::render(RenderCommandBuffer& commands) {
+	if (!m_geometry) {
+		return;
+	}
+	if (isStatic()) {
+		EngineUtilities::TService<StaticGeometryCache>::instance().markVisible(*this);
+		return;
+	}
+	sf::Transform transform = m_transform ? m_transform->getRenderTransform() : sf::Transform().translate(m_position);
+	std::span<const sf::Vector2f> outline = m_geometry->outline;
+	if (m_shapeType == CIRCLE && commands.pixelScale() > 0.0f) {
+		outline = selectCircleLod(transform, commands.pixelScale());
+	}
+	LayerCache* layers = EngineUtilities::TService<LayerCache>::get();
+	if (layers && layers->isCached(m_layer)) {
+		layers->noteChange(m_layer, getChangeTick());
+		if (m_transform) {
+			layers->noteChange(m_layer, m_transform->getChangeTick());
+		}
+	}
+	commands.drawShared(*m_geometry->shape, transform, m_fillColor, m_layer, outline);
+}
+
+std::span<const sf::Vector2f>
+ShapeFactory::selectCircleLod(const sf::Transform& transform, float pixelScale) {
+	// Radio en pxeles con la mayor escala de las dos direcciones
+	const float* m = transform.getMatrix();
+	float scale = std::sqrt(std::max(m[0] * m[0] + m[1] * m[1], m[4] * m[4] + m[5] * m[5]));
+	float radius = kCircleRadius * scale * pixelScale;
+
+	const CircleLods& lods = circleLods();
+	uint8_t level = m_lod;
+	if (level >= kCircleLodLevels) {
+		level = 0;
+		while (level + 1 < kCircleLodLevels && radius > kLodMaxRadius[level]) {
+			++level;
+		}
+	}
+	else {
+		while (level + 1 < kCircleLodLevels && radius > kLodMaxRadius[level] * (1.0f + kLodHysteresis)) {
+			++level;
+		}
+		while (level > 0 && radius < kLodMaxRadius[level - 1] * (1.0f - kLodHysteresis)) {
+			--level;
+		}
+	}
+	// Otro contorno cambia el dibujo: las capas en cach deben enterarse
+	if (level != m_lod) {
+		m_lod = level;
+		markChanged();
+	}
+	return lods.outlines[level];
+}
+
+size_t
+ShapeFactory::getLodPointCount() const {
+	return m_lod < kCircleLodLevels ? kLodPoints[m_lod] : 0;
+}
+
+std::span<const sf::Vector2f>
+ShapeFactory::getLocalOutline() const {
+	return m_geometry ? m_geometry->outline : std::span<const sf::Vector2f>();
 }
 
 void 
 ShapeFactory::setFillColor(const sf::Color& color) {
-	m_shape->setFillColor(color);
+	m_fillColor = color;
+	markChanged();
 }
 
 void 
@@ -50,11 +218,17 @@ ShapeFactory::Seek(const sf::Vector2f& targetPosition,
 									 float speed, 
 									 float deltaTime, 
 									 float range) {
-	// Obtener la posicin actual de mi shape
-	sf::Vector2f shapePosition = m_shape->getPosition();
+	setPosition(seekStep(getPosition(), targetPosition, speed, deltaTime, range));
+}
 
+sf::Vector2f
+ShapeFactory::seekStep(const sf::Vector2f& position,
+									 const sf::Vector2f& targetPosition,
+									 float speed,
+									 float deltaTime,
+									 float range) {
 	// Calcular la direccin desde el crculo hacia el objetivo
-	sf::Vector2f direction = targetPosition - shapePosition;
+	sf::Vector2f direction = targetPosition - position;
 
 	// Calcular la distancia al objetivo
 	float lenght = std::sqrt(direction.x * direction.x + direction.y * direction.y);
@@ -62,6 +236,64 @@ ShapeFactory::Seek(const sf::Vector2f& targetPosition,
 	// Si la distancia es mayor que el rango, mover la shape hacia el objetivo
 	if (lenght > range) {
 		direction /= lenght;
-		m_shape->move(direction * speed * deltaTime);
+		return position + direction * speed * deltaTime;
+	}
+	return position;
+}
+
+void
+ShapeFactory::seekBatch(float* x, float* y, const float* targetX, const float* targetY, const float* speed,
+                        const float* range, size_t count, float deltaTime) {
+	size_t i = 0;
+	// 1/|d| ~ r * (1.5 - 0.5 * |d| * r): un paso de Newton sobre la aproximacin de rsqrt.
+	// Donde |d| <= rango (incluido |d| = 0, que da infinito) la mscara anula el paso.
+#if SEEK_AVX
+	__m256 dt = _mm256_set1_ps(deltaTime);
+	__m256 half = _mm256_set1_ps(0.5f);
+	__m256 threeHalves = _mm256_set1_ps(1.5f);
+	for (; i + 8 <= count; i += 8) {
+		__m256 px = _mm256_loadu_ps(x + i);
+		__m256 py = _mm256_loadu_ps(y + i);
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(targetX + i), px);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(targetY + i), py);
+		__m256 lengthSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		__m256 limit = _mm256_loadu_ps(range + i);
+		__m256 moving = _mm256_cmp_ps(lengthSq, _mm256_mul_ps(limit, limit), _CMP_GT_OQ);
+		__m256 inverse = _mm256_rsqrt_ps(lengthSq);
+		inverse = _mm256_mul_ps(inverse,
+			_mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, lengthSq), _mm256_mul_ps(inverse, inverse))));
+		__m256 step = _mm256_and_ps(moving, _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(speed + i), dt), inverse));
+		_mm256_storeu_ps(x + i, _mm256_add_ps(px, _mm256_mul_ps(dx, step)));
+		_mm256_storeu_ps(y + i, _mm256_add_ps(py, _mm256_mul_ps(dy, step)));
+	}
+#elif SEEK_SSE
+	__m128 dt = _mm_set1_ps(deltaTime);
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 threeHalves = _mm_set1_ps(1.5f);
+	for (; i + 4 <= count; i += 4) {
+		__m128 px = _mm_loadu_ps(x + i);
+		__m128 py = _mm_loadu_ps(y + i);
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(targetX + i), px);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(targetY + i), py);
+		__m128 lengthSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		__m128 limit = _mm_loadu_ps(range + i);
+		__m128 moving = _mm_cmpgt_ps(lengthSq, _mm_mul_ps(limit, limit));
+		__m128 inverse = _mm_rsqrt_ps(lengthSq);
+		inverse = _mm_mul_ps(inverse,
+			_mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, lengthSq), _mm_mul_ps(inverse, inverse))));
+		__m128 step = _mm_and_ps(moving, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(speed + i), dt), inverse));
+		_mm_storeu_ps(x + i, _mm_add_ps(px, _mm_mul_ps(dx, step)));
+		_mm_storeu_ps(y + i, _mm_add_ps(py, _mm_mul_ps(dy, step)));
+	}
+#endif
+	for (; i < count; ++i) {
+		float dx = targetX[i] - x[i];
+		float dy = targetY[i] - y[i];
+		float lengthSq = dx * dx + dy * dy;
+		if (lengthSq > range[i] * range[i]) {
+			float step = speed[i] * deltaTime / std::sqrt(lengthSq);
+			x[i] += dx * step;
+			y[i] += dy * step;
+		}
 	}
 }
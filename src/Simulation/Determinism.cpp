@@ -0,0 +1,67 @@
+#include "Simulation/Determinism.h"
+#include <cstring>
+#include "ECS/World.h"
+#include "Transform.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define DETERMINISM_SSE 1
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <math.h>
+#endif
+
+namespace {
+	inline uint64_t
+	mix(uint64_t hash, const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	inline uint64_t
+	mix(uint64_t hash, float value) {
+		// +0 y -0 comparan igual pero no tienen los mismos bits: se cuentan como distintos a propsito
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return mix(hash, &bits, sizeof(bits));
+	}
+}
+
+void
+Determinism::configureFloatingPoint() {
+#if DETERMINISM_SSE
+	// Todas las excepciones enmascaradas, redondeo al ms cercano, sin FTZ ni DAZ: el valor de
+	// arranque, por si un driver o una biblioteca lo cambi
+	_mm_setcsr(0x1F80);
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+	_set_FMA3_enable(0);
+#endif
+}
+
+bool
+Determinism::isSupported() {
+#if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+	return false;
+#else
+	return true;
+#endif
+}
+
+uint64_t
+Determinism::checksum(World& world) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	world.view<const Transform>().each([&hash](EntityId entity, const Transform& transform) {
+		hash = mix(hash, &entity, sizeof(entity));
+		hash = mix(hash, transform.getPosition().x);
+		hash = mix(hash, transform.getPosition().y);
+		hash = mix(hash, transform.getRotation());
+		hash = mix(hash, transform.getScale().x);
+		hash = mix(hash, transform.getScale().y);
+	});
+	return hash;
+}
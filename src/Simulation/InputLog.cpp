@@ -0,0 +1,124 @@
+#include "Simulation/InputLog.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	constexpr size_t
+	padded(size_t bytes) {
+		return (bytes + 3) & ~size_t(3);
+	}
+}
+
+bool
+InputLog::create(const std::string& path, float step) {
+	close();
+	if (!m_writer.open(path)) {
+		return false;
+	}
+	Header header = { { 'G', 'I', 'N', 'P' }, kVersion, step, 0 };
+	if (!m_writer.append(&header, sizeof(header))) {
+		return false;
+	}
+	m_step = step;
+	return true;
+}
+
+void
+InputLog::recordEvent(TickEventType type, std::string_view data) {
+	if (!m_writer.isOpen() || m_pendingCount == UINT16_MAX) {
+		return;
+	}
+	EventHeader header = { static_cast<uint16_t>(type), 0, static_cast<uint32_t>(data.size()) };
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&header);
+	m_pending.insert(m_pending.end(), bytes, bytes + sizeof(header));
+	m_pending.insert(m_pending.end(), data.begin(), data.end());
+	m_pending.resize(padded(m_pending.size()), 0);
+	++m_pendingCount;
+}
+
+bool
+InputLog::record(const TickInput& input) {
+	if (!m_writer.isOpen()) {
+		return false;
+	}
+	TickHeader header = { m_ticks + 1, m_pendingCount, 0, static_cast<uint32_t>(m_pending.size()) };
+	bool written = m_writer.append(&header, sizeof(header)) && m_writer.append(&input, sizeof(input)) &&
+	               (m_pending.empty() || m_writer.append(m_pending.data(), m_pending.size()));
+	m_pending.clear();
+	m_pendingCount = 0;
+	if (written) {
+		++m_ticks;
+	}
+	return written;
+}
+
+bool
+InputLog::open(const std::string& path) {
+	close();
+	Header header;
+	if (!m_reader.open(path) || m_reader.size() < sizeof(header)) {
+		m_reader.close();
+		return false;
+	}
+	std::memcpy(&header, m_reader.data(), sizeof(header));
+	if (std::memcmp(header.magic, "GINP", 4) != 0 || header.version != kVersion || !(header.step > 0.0f)) {
+		m_reader.close();
+		return false;
+	}
+	m_step = header.step;
+	m_cursor = sizeof(header);
+	return true;
+}
+
+bool
+InputLog::next(TickInput& input) {
+	m_events.clear();
+	if (!m_reader.isOpen()) {
+		return false;
+	}
+	const unsigned char* data = m_reader.data();
+	size_t size = m_reader.size();
+	TickHeader header;
+	if (size - m_cursor < sizeof(header) + sizeof(TickInput)) {
+		return false;
+	}
+	std::memcpy(&header, data + m_cursor, sizeof(header));
+	// Un paso sin nmero (los ceros de un archivo sin cerrar), fuera de orden o cortado es el final
+	size_t body = sizeof(header) + sizeof(TickInput);
+	if (header.tick != m_ticks + 1 || size - m_cursor - body < header.eventBytes) {
+		return false;
+	}
+	std::memcpy(&input, data + m_cursor + sizeof(header), sizeof(TickInput));
+
+	const unsigned char* at = data + m_cursor + body;
+	const unsigned char* end = at + header.eventBytes;
+	for (uint16_t i = 0; i < header.eventCount; ++i) {
+		EventHeader event;
+		if (static_cast<size_t>(end - at) < sizeof(event)) {
+			m_events.clear();
+			return false;
+		}
+		std::memcpy(&event, at, sizeof(event));
+		at += sizeof(event);
+		if (static_cast<size_t>(end - at) < event.bytes) {
+			m_events.clear();
+			return false;
+		}
+		m_events.push_back(TickEvent{ static_cast<TickEventType>(event.type), std::span<const unsigned char>(at, event.bytes) });
+		at += std::min(padded(event.bytes), static_cast<size_t>(end - at));
+	}
+	m_cursor += body + header.eventBytes;
+	++m_ticks;
+	return true;
+}
+
+void
+InputLog::close() {
+	m_writer.close();
+	m_reader.close();
+	m_pending.clear();
+	m_pendingCount = 0;
+	m_events.clear();
+	m_cursor = 0;
+	m_ticks = 0;
+}
@@ -0,0 +1,100 @@
+#include "Simulation/SessionHost.h"
+#include <algorithm>
+#include <thread>
+
+void
+HostedSession::step(float deltaTime) {
+	m_systems.run(m_world, deltaTime);
+	m_states.clear();
+	if (m_capture) {
+		m_capture(m_world, m_states);
+	}
+	m_net.update(m_states, deltaTime);
+	++m_steps;
+}
+
+SessionHost::SessionHost(JobSystem& jobs, float stepHz)
+	: m_jobs(jobs), m_step(stepHz > 0.0f ? 1.0f / stepHz : 1.0f / kDefaultStepHz) {
+}
+
+HostedSession*
+SessionHost::open(unsigned short port) {
+	EngineUtilities::TUniquePtr<HostedSession> session = EngineUtilities::MakeUnique<HostedSession>(m_jobs);
+	if (!session->net().host(port)) {
+		MESSAGE("SessionHost", "open", "could not listen on the session port");
+		return nullptr;
+	}
+	session->m_nextStep = now();
+	HostedSession* opened = session.get();
+	m_sessions.push_back(std::move(session));
+	return opened;
+}
+
+void
+SessionHost::close(HostedSession& session) {
+	auto found = std::find_if(m_sessions.begin(), m_sessions.end(),
+		[&session](const EngineUtilities::TUniquePtr<HostedSession>& owned) { return owned.get() == &session; });
+	if (found != m_sessions.end()) {
+		(*found)->net().close();
+		m_sessions.erase(found);
+	}
+	m_due.clear();
+}
+
+void
+SessionHost::closeAll() {
+	for (EngineUtilities::TUniquePtr<HostedSession>& session : m_sessions) {
+		session->net().close();
+	}
+	m_sessions.clear();
+	m_due.clear();
+}
+
+double
+SessionHost::tick() {
+	double time = now();
+	m_due.clear();
+	for (EngineUtilities::TUniquePtr<HostedSession>& owned : m_sessions) {
+		HostedSession& session = *owned;
+		if (time < session.m_nextStep) {
+			continue;
+		}
+		if (session.isIdle()) {
+			// Si aparece un cliente, el primer paso es en el turno siguiente
+			session.poll();
+			session.m_nextStep = time + kIdlePollSeconds;
+			continue;
+		}
+		// Atrasada por ms de un paso, sigue desde ahora en vez de ponerse al da de golpe
+		session.m_nextStep = std::max(session.m_nextStep + m_step, time);
+		m_due.push_back(&session);
+	}
+
+	if (m_due.size() == 1) {
+		m_due.front()->step(m_step);
+	}
+	else if (!m_due.empty()) {
+		JobCounter counter;
+		const float step = m_step;
+		for (HostedSession* session : m_due) {
+			m_jobs.run([session, step]() { session->step(step); }, &counter);
+		}
+		m_jobs.wait(counter);
+	}
+
+	double next = time + kIdlePollSeconds;
+	for (const EngineUtilities::TUniquePtr<HostedSession>& session : m_sessions) {
+		next = std::min(next, session->m_nextStep);
+	}
+	return std::max(0.0, next - now());
+}
+
+void
+SessionHost::run(const std::atomic<bool>& stop) {
+	while (!stop.load(std::memory_order_relaxed)) {
+		double wait = tick();
+		if (wait > 0.0) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#include "SpatialHash.h"
+#include <algorithm>
+
+void
+SpatialHash::build(std::span<const float> x, std::span<const float> y, float cellSize) {
+	size_t count = std::min(x.size(), y.size());
+	m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+	m_inverseCellSize = 1.0f / m_cellSize;
+
+	size_t buckets = 64;
+	while (buckets < count * 2) {
+		buckets <<= 1;
+	}
+	m_bucketMask = static_cast<uint32_t>(buckets - 1);
+	m_entries.resize(count);
+	m_items.resize(count);
+	m_bucketOfItem.resize(count);
+	m_bucketStart.assign(buckets + 1, 0);
+
+	// Conteo por cubeta, suma acumulada hasta el final de cada una y reparto de atrs hacia
+	// adelante: `m_bucketStart[b]` queda en el inicio de la cubeta `b`
+	for (size_t i = 0; i < count; ++i) {
+		uint32_t bucket = bucketOf(cellOf(x[i]), cellOf(y[i]));
+		m_bucketOfItem[i] = bucket;
+		++m_bucketStart[bucket];
+	}
+	for (size_t b = 1; b < buckets; ++b) {
+		m_bucketStart[b] += m_bucketStart[b - 1];
+	}
+	m_bucketStart[buckets] = static_cast<uint32_t>(count);
+	for (size_t i = count; i-- > 0;) {
+		uint32_t slot = --m_bucketStart[m_bucketOfItem[i]];
+		m_entries[slot] = Entry{ cellOf(x[i]), cellOf(y[i]), x[i], y[i] };
+		m_items[slot] = static_cast<uint32_t>(i);
+	}
+}
+
+size_t
+SpatialHash::queryRadius(const sf::Vector2f& center, float radius, std::span<uint32_t> out) const {
+	size_t written = 0;
+	if (out.empty()) {
+		return 0;
+	}
+	forEachInRadius(center, radius, [&out, &written](uint32_t item, float) {
+		out[written++] = item;
+		return written < out.size();
+	});
+	return written;
+}
+
+size_t
+SpatialHash::queryBox(const sf::FloatRect& box, std::span<uint32_t> out) const {
+	size_t written = 0;
+	if (out.empty()) {
+		return 0;
+	}
+	forEachInBox(box, [&out, &written](uint32_t item) {
+		out[written++] = item;
+		return written < out.size();
+	});
+	return written;
+}
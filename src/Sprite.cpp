@@ -0,0 +1,80 @@
+#include "Sprite.h"
+#include "Render/LayerCache.h"
+#include "Render/RenderCommandBuffer.h"
+#include "Render/ShapeGeometry.h"
+
+void
+Sprite::setImage(const TextureAtlas* atlas, uint32_t region) {
+	m_atlas = atlas;
+	m_region = region;
+	if (!m_square) {
+		m_square = EngineUtilities::TService<ShapeGeometryLibrary>::instance().find(ShapeType::RECTANGLE,
+			sf::Vector2f(1.0f, 1.0f), 4, nullptr);
+	}
+	markChanged();
+}
+
+bool
+Sprite::setImage(const TextureAtlas* atlas, std::string_view name) {
+	uint32_t region = atlas ? atlas->find(name) : TextureAtlas::kInvalidRegion;
+	setImage(region != TextureAtlas::kInvalidRegion ? atlas : nullptr, region);
+	return region != TextureAtlas::kInvalidRegion;
+}
+
+void
+Sprite::setSize(const sf::Vector2f& size) {
+	m_size = size;
+	markChanged();
+}
+
+sf::Vector2f
+Sprite::getSize() const {
+	if (m_size.x != 0.0f || m_size.y != 0.0f || !m_atlas) {
+		return m_size;
+	}
+	const sf::IntRect& rect = m_atlas->region(m_region).rect;
+	return sf::Vector2f(static_cast<float>(rect.width), static_cast<float>(rect.height));
+}
+
+void
+Sprite::setOrigin(const sf::Vector2f& origin) {
+	m_origin = origin;
+	markChanged();
+}
+
+void
+Sprite::setColor(sf::Color color) {
+	m_color = color;
+	markChanged();
+}
+
+void
+Sprite::setLayer(uint8_t layer) {
+	m_layer = layer;
+	markChanged();
+}
+
+void
+Sprite::render(RenderCommandBuffer& commands) {
+	if (!m_atlas || !m_square) {
+		return;
+	}
+	const AtlasRegion& region = m_atlas->region(m_region);
+	if (!region.texture) {
+		return;
+	}
+
+	// El cuadrado unidad, corrido al origen y estirado al tamao
+	sf::Vector2f size = getSize();
+	sf::Transform transform = m_transform ? m_transform->getRenderTransform() : sf::Transform::Identity;
+	transform.scale(size).translate(-m_origin);
+
+	LayerCache* layers = EngineUtilities::TService<LayerCache>::get();
+	if (layers && layers->isCached(m_layer)) {
+		layers->noteChange(m_layer, getChangeTick());
+		if (m_transform) {
+			layers->noteChange(m_layer, m_transform->getChangeTick());
+		}
+	}
+	commands.drawSprite(*m_square->shape, transform, region.texture, region.rect, m_color, m_layer, m_square->outline);
+}
@@ -0,0 +1,249 @@
+#include "Steering.h"
+#include <algorithm>
+#include "Jobs/JobSystem.h"
+#include "Transform.h"
+
+namespace {
+	/**
+	 * @brief Suma a `force` lo que hace falta para pasar de `velocity` a ir por `(dx, dy)` a
+	 *        `speed`, por `weight`. Una direccin nula no pide nada.
+	 */
+	inline void
+	addToward(float dx, float dy, float speed, float vx, float vy, float weight, float& forceX, float& forceY) {
+		float lengthSq = dx * dx + dy * dy;
+		if (lengthSq <= 0.0f) {
+			return;
+		}
+		float scale = speed / std::sqrt(lengthSq);
+		forceX += weight * (dx * scale - vx);
+		forceY += weight * (dy * scale - vy);
+	}
+
+	/**
+	 * @brief Recorta `(x, y)` a largo `limit`.
+	 */
+	inline void
+	truncate(float& x, float& y, float limit) {
+		float lengthSq = x * x + y * y;
+		if (lengthSq > limit * limit) {
+			float scale = limit / std::sqrt(lengthSq);
+			x *= scale;
+			y *= scale;
+		}
+	}
+
+	/**
+	 * @brief Nmero en [-1, 1] que depende solo de la entidad y el frame.
+	 */
+	inline float
+	wanderNoise(uint32_t entity, uint32_t frame) {
+		uint32_t h = entity * 0x9E3779B1u ^ frame * 0x85EBCA77u;
+		h ^= h >> 15;
+		h *= 0x2C1B3C6Du;
+		h ^= h >> 12;
+		return static_cast<float>(h & 0xFFFFFF) / float(0x7FFFFF) - 1.0f;
+	}
+}
+
+void
+SteeringSystem::update(World& world, JobSystem& jobs, float deltaTime, const UpdateLod* lod) {
+	gather(world, lod);
+	if (m_agents.empty()) {
+		return;
+	}
+	buildNeighborGrid();
+	++m_frame;
+
+	jobs.parallelFor(m_agents.size(), kGrain, [this, deltaTime](size_t begin, size_t end) { steer(begin, end, deltaTime); });
+
+	// Cada agente escribe solo lo suyo: las filas de un trabajo no se cruzan con las de otro
+	jobs.parallelFor(m_agents.size(), kGrain, [this, deltaTime](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			m_agents[i]->velocity = sf::Vector2f(m_nextVx[i], m_nextVy[i]);
+			m_transforms[i]->setPosition(m_x[i] + m_nextVx[i] * deltaTime, m_y[i] + m_nextVy[i] * deltaTime);
+		}
+	});
+}
+
+void
+SteeringSystem::gather(World& world, const UpdateLod* lod) {
+	m_ids.clear();
+	m_agents.clear();
+	m_transforms.clear();
+	m_x.clear();
+	m_y.clear();
+	m_vx.clear();
+	m_vy.clear();
+	m_interval.clear();
+	m_steeredCount = 0;
+	uint32_t maxIndex = 0;
+	world.view<SteeringAgent, Transform>().each([&](EntityId entity, SteeringAgent& agent, Transform& transform) {
+		m_ids.push_back(entity);
+		m_agents.push_back(&agent);
+		m_transforms.push_back(&transform);
+		m_x.push_back(transform.getPosition().x);
+		m_y.push_back(transform.getPosition().y);
+		m_vx.push_back(agent.velocity.x);
+		m_vy.push_back(agent.velocity.y);
+		uint32_t interval = lod ? lod->dueInterval(entity.index, transform.getPosition()) : 1;
+		m_interval.push_back(interval);
+		m_steeredCount += interval != 0 ? 1 : 0;
+		maxIndex = std::max(maxIndex, entity.index);
+	});
+	size_t count = m_agents.size();
+	m_nextVx.resize(count);
+	m_nextVy.resize(count);
+	m_quarryX.resize(count);
+	m_quarryY.resize(count);
+	m_quarryVx.resize(count);
+	m_quarryVy.resize(count);
+	if (count == 0) {
+		return;
+	}
+
+	// Las entradas viejas no se limpian: una presa vale solo si su agente tiene ese mismo id
+	if (m_slotOfEntity.size() <= maxIndex) {
+		m_slotOfEntity.resize(size_t(maxIndex) + 1, 0);
+	}
+	for (size_t i = 0; i < count; ++i) {
+		m_slotOfEntity[m_ids[i].index] = static_cast<uint32_t>(i);
+	}
+	for (size_t i = 0; i < count; ++i) {
+		const SteeringAgent& agent = *m_agents[i];
+		// Sin presa, la propia posicin: pursue y evade no piden nada
+		m_quarryX[i] = m_x[i];
+		m_quarryY[i] = m_y[i];
+		m_quarryVx[i] = 0.0f;
+		m_quarryVy[i] = 0.0f;
+		if (!agent.quarry || (agent.weights.pursue == 0.0f && agent.weights.evade == 0.0f)) {
+			continue;
+		}
+		uint32_t index = agent.quarry.index;
+		if (index < m_slotOfEntity.size() && m_slotOfEntity[index] < count && m_ids[m_slotOfEntity[index]] == agent.quarry) {
+			uint32_t slot = m_slotOfEntity[index];
+			m_quarryX[i] = m_x[slot];
+			m_quarryY[i] = m_y[slot];
+			m_quarryVx[i] = m_vx[slot];
+			m_quarryVy[i] = m_vy[slot];
+		}
+		else if (ComponentRef<Transform>* quarry = world.getComponent<ComponentRef<Transform>>(agent.quarry)) {
+			m_quarryX[i] = quarry->component->getPosition().x;
+			m_quarryY[i] = quarry->component->getPosition().y;
+		}
+	}
+}
+
+void
+SteeringSystem::buildNeighborGrid() {
+	float radius = 1.0f;
+	for (const SteeringAgent* agent : m_agents) {
+		radius = std::max(radius, agent->neighborRadius);
+	}
+	m_neighbors.build(m_x, m_y, radius);
+}
+
+void
+SteeringSystem::steer(size_t begin, size_t end, float deltaTime) {
+	for (size_t i = begin; i < end; ++i) {
+		// Si no le toca, sigue derecho; al tocarle, la fuerza cubre todos los pasos saltados
+		if (m_interval[i] == 0) {
+			m_nextVx[i] = m_vx[i];
+			m_nextVy[i] = m_vy[i];
+			continue;
+		}
+		float stepTime = deltaTime * static_cast<float>(m_interval[i]);
+		SteeringAgent& agent = *m_agents[i];
+		const SteeringWeights& weights = agent.weights;
+		float x = m_x[i];
+		float y = m_y[i];
+		float vx = m_vx[i];
+		float vy = m_vy[i];
+		float forceX = 0.0f;
+		float forceY = 0.0f;
+
+		float toTargetX = agent.target.x - x;
+		float toTargetY = agent.target.y - y;
+		if (weights.seek != 0.0f) {
+			addToward(toTargetX, toTargetY, agent.maxSpeed, vx, vy, weights.seek, forceX, forceY);
+		}
+		if (weights.flee != 0.0f) {
+			addToward(-toTargetX, -toTargetY, agent.maxSpeed, vx, vy, weights.flee, forceX, forceY);
+		}
+		if (weights.arrive != 0.0f) {
+			float distance = std::sqrt(toTargetX * toTargetX + toTargetY * toTargetY);
+			if (distance < agent.arriveRadius) {
+				forceX -= weights.arrive * vx;
+				forceY -= weights.arrive * vy;
+			}
+			else {
+				float speed = agent.maxSpeed * std::min(1.0f, distance / std::max(agent.slowingRadius, 1e-3f));
+				addToward(toTargetX, toTargetY, speed, vx, vy, weights.arrive, forceX, forceY);
+			}
+		}
+
+		if (weights.pursue != 0.0f || weights.evade != 0.0f) {
+			// Mira ms adelante cuanto ms lejos est la presa
+			float dx = m_quarryX[i] - x;
+			float dy = m_quarryY[i] - y;
+			float ahead = std::min(std::sqrt(dx * dx + dy * dy) / std::max(agent.maxSpeed, 1e-3f), kMaxPrediction);
+			dx += m_quarryVx[i] * ahead;
+			dy += m_quarryVy[i] * ahead;
+			addToward(dx, dy, agent.maxSpeed, vx, vy, weights.pursue, forceX, forceY);
+			addToward(-dx, -dy, agent.maxSpeed, vx, vy, weights.evade, forceX, forceY);
+		}
+
+		if (weights.wander != 0.0f) {
+			// Un punto que se desliza por un crculo delante del agente
+			float angle = agent.wanderAngle + agent.wanderJitter * stepTime * wanderNoise(m_ids[i].index, m_frame);
+			agent.wanderAngle = angle;
+			float speedSq = vx * vx + vy * vy;
+			float headingX = 1.0f;
+			float headingY = 0.0f;
+			if (speedSq > 0.0f) {
+				float inverse = 1.0f / std::sqrt(speedSq);
+				headingX = vx * inverse;
+				headingY = vy * inverse;
+			}
+			float dx = headingX * agent.wanderDistance + std::cos(angle) * agent.wanderRadius;
+			float dy = headingY * agent.wanderDistance + std::sin(angle) * agent.wanderRadius;
+			addToward(dx, dy, agent.maxSpeed, vx, vy, weights.wander, forceX, forceY);
+		}
+
+		if (weights.separation != 0.0f || weights.alignment != 0.0f || weights.cohesion != 0.0f) {
+			float awayX = 0.0f, awayY = 0.0f;
+			float sumVx = 0.0f, sumVy = 0.0f;
+			float sumX = 0.0f, sumY = 0.0f;
+			uint32_t neighbors = 0;
+			m_neighbors.forEachInRadius(sf::Vector2f(x, y), agent.neighborRadius, [&](uint32_t j, float distanceSq) {
+				if (j == i) {
+					return true;
+				}
+				if (distanceSq > 0.0f) {
+					float dx = x - m_x[j];
+					float dy = y - m_y[j];
+					awayX += dx / distanceSq;
+					awayY += dy / distanceSq;
+				}
+				sumVx += m_vx[j];
+				sumVy += m_vy[j];
+				sumX += m_x[j];
+				sumY += m_y[j];
+				return ++neighbors < kMaxNeighbors;
+			});
+			if (neighbors != 0) {
+				float inverse = 1.0f / static_cast<float>(neighbors);
+				addToward(awayX, awayY, agent.maxSpeed, vx, vy, weights.separation, forceX, forceY);
+				forceX += weights.alignment * (sumVx * inverse - vx);
+				forceY += weights.alignment * (sumVy * inverse - vy);
+				addToward(sumX * inverse - x, sumY * inverse - y, agent.maxSpeed, vx, vy, weights.cohesion, forceX, forceY);
+			}
+		}
+
+		truncate(forceX, forceY, agent.maxForce);
+		vx += forceX * stepTime;
+		vy += forceY * stepTime;
+		truncate(vx, vy, agent.maxSpeed);
+		m_nextVx[i] = vx;
+		m_nextVy[i] = vy;
+	}
+}
@@ -0,0 +1,8 @@
+#include "TShape.h"
+
+void
+recordShapeInstances(World& world, RenderCommandBuffer& commands) {
+	recordShapes<CIRCLE>(world, commands);
+	recordShapes<RECTANGLE>(world, commands);
+	recordShapes<TRIANGLE>(world, commands);
+}
@@ -0,0 +1,158 @@
+#include "Tilemap.h"
+#include <algorithm>
+#include <cmath>
+#include "Render/LayerCache.h"
+#include "Render/RenderCommandBuffer.h"
+
+void
+Tilemap::resize(uint32_t width, uint32_t height) {
+	m_width = width;
+	m_height = height;
+	m_chunksX = (width + kChunkTiles - 1) / kChunkTiles;
+	m_chunksY = (height + kChunkTiles - 1) / kChunkTiles;
+	m_tiles.assign(static_cast<size_t>(width) * height, kEmptyTile);
+	m_chunks.clear();
+	m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+	markChanged();
+}
+
+void
+Tilemap::setTileset(const sf::Texture* texture, uint32_t tilePixels) {
+	m_tileset = texture;
+	m_tilePixels = std::max(1u, tilePixels);
+	m_tilesetColumns = texture ? texture->getSize().x / m_tilePixels : 0;
+	markAllDirty();
+}
+
+void
+Tilemap::setTileSize(float size) {
+	m_tileSize = size;
+	markAllDirty();
+}
+
+void
+Tilemap::setTile(uint32_t x, uint32_t y, TileId tile) {
+	if (x >= m_width || y >= m_height) {
+		return;
+	}
+	TileId& slot = m_tiles[static_cast<size_t>(y) * m_width + x];
+	if (slot == tile) {
+		return;
+	}
+	slot = tile;
+	m_chunks[static_cast<size_t>(y / kChunkTiles) * m_chunksX + x / kChunkTiles].dirty = true;
+	markChanged();
+}
+
+Tilemap::TileId
+Tilemap::getTile(uint32_t x, uint32_t y) const {
+	if (x >= m_width || y >= m_height) {
+		return kEmptyTile;
+	}
+	return m_tiles[static_cast<size_t>(y) * m_width + x];
+}
+
+void
+Tilemap::setTiles(std::span<const TileId> tiles) {
+	size_t count = std::min(tiles.size(), m_tiles.size());
+	std::copy_n(tiles.begin(), count, m_tiles.begin());
+	std::fill(m_tiles.begin() + count, m_tiles.end(), kEmptyTile);
+	markAllDirty();
+}
+
+void
+Tilemap::markAllDirty() {
+	for (Chunk& chunk : m_chunks) {
+		chunk.dirty = true;
+	}
+	markChanged();
+}
+
+void
+Tilemap::render(RenderCommandBuffer& commands) {
+	if (m_chunks.empty()) {
+		return;
+	}
+	sf::Transform transform = m_transform ? m_transform->getRenderTransform() : sf::Transform::Identity;
+
+	// Trozos que toca la vista, en coordenadas del mapa
+	uint32_t firstX = 0, firstY = 0, lastX = m_chunksX - 1, lastY = m_chunksY - 1;
+	const sf::FloatRect& visible = commands.visibleArea();
+	if (visible.width > 0.0f && visible.height > 0.0f) {
+		sf::FloatRect local = transform.getInverse().transformRect(visible);
+		float chunkSize = m_tileSize * kChunkTiles;
+		float x0 = std::floor(local.left / chunkSize);
+		float y0 = std::floor(local.top / chunkSize);
+		float x1 = std::floor((local.left + local.width) / chunkSize);
+		float y1 = std::floor((local.top + local.height) / chunkSize);
+		if (x1 < 0.0f || y1 < 0.0f || x0 >= m_chunksX || y0 >= m_chunksY) {
+			return;
+		}
+		firstX = static_cast<uint32_t>(std::max(x0, 0.0f));
+		firstY = static_cast<uint32_t>(std::max(y0, 0.0f));
+		lastX = std::min(m_chunksX - 1, static_cast<uint32_t>(x1));
+		lastY = std::min(m_chunksY - 1, static_cast<uint32_t>(y1));
+	}
+
+	LayerCache* layers = EngineUtilities::TService<LayerCache>::get();
+	bool cachedLayer = layers && layers->isCached(m_layer);
+	for (uint32_t chunkY = firstY; chunkY <= lastY; ++chunkY) {
+		for (uint32_t chunkX = firstX; chunkX <= lastX; ++chunkX) {
+			Chunk& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunksX + chunkX];
+			if (chunk.dirty) {
+				rebuild(chunkX, chunkY);
+				if (cachedLayer) {
+					layers->markDirty(m_layer);
+				}
+			}
+			if (chunk.vertices.getVertexCount() > 0) {
+				commands.draw(chunk.vertices, transform, m_layer, m_tileset);
+			}
+		}
+	}
+	if (cachedLayer && m_transform) {
+		layers->noteChange(m_layer, m_transform->getChangeTick());
+	}
+}
+
+void
+Tilemap::rebuild(uint32_t chunkX, uint32_t chunkY) {
+	Chunk& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunksX + chunkX];
+	chunk.dirty = false;
+	chunk.vertices.clear();
+	++m_rebuilds;
+	if (m_tilesetColumns == 0) {
+		return;
+	}
+
+	uint32_t beginX = chunkX * kChunkTiles;
+	uint32_t beginY = chunkY * kChunkTiles;
+	uint32_t endX = std::min(m_width, beginX + kChunkTiles);
+	uint32_t endY = std::min(m_height, beginY + kChunkTiles);
+	float pixels = static_cast<float>(m_tilePixels);
+	for (uint32_t y = beginY; y < endY; ++y) {
+		for (uint32_t x = beginX; x < endX; ++x) {
+			TileId tile = m_tiles[static_cast<size_t>(y) * m_width + x];
+			if (tile == kEmptyTile) {
+				continue;
+			}
+			sf::Vector2f low(x * m_tileSize, y * m_tileSize);
+			sf::Vector2f high = low + sf::Vector2f(m_tileSize, m_tileSize);
+			sf::Vector2f uvLow((tile % m_tilesetColumns) * pixels, (tile / m_tilesetColumns) * pixels);
+			sf::Vector2f uvHigh = uvLow + sf::Vector2f(pixels, pixels);
+
+			sf::Vertex corners[4] = {
+				sf::Vertex(low, uvLow),
+				sf::Vertex(sf::Vector2f(high.x, low.y), sf::Vector2f(uvHigh.x, uvLow.y)),
+				sf::Vertex(high, uvHigh),
+				sf::Vertex(sf::Vector2f(low.x, high.y), sf::Vector2f(uvLow.x, uvHigh.y)),
+			};
+			chunk.vertices.append(corners[0]);
+			chunk.vertices.append(corners[1]);
+			chunk.vertices.append(corners[2]);
+			chunk.vertices.append(corners[0]);
+			chunk.vertices.append(corners[2]);
+			chunk.vertices.append(corners[3]);
+		}
+	}
+}
@@ -0,0 +1,149 @@
+#include "Transform.h"
+
+void
+Transform::setPosition(const sf::Vector2f& position) {
+	if (position != m_position) {
+		keepPrevious();
+		m_position = position;
+		changed();
+	}
+}
+
+void
+Transform::setRotation(float degrees) {
+	degrees = std::fmod(degrees, 360.0f);
+	if (degrees < 0.0f) {
+		degrees += 360.0f;
+	}
+	if (degrees != m_rotation) {
+		keepPrevious();
+		m_rotation = degrees;
+		changed();
+	}
+}
+
+void
+Transform::setScale(const sf::Vector2f& scale) {
+	if (scale != m_scale) {
+		keepPrevious();
+		m_scale = scale;
+		changed();
+	}
+}
+
+void
+Transform::changed() {
+	m_localDirty = true;
+	++m_localVersion;
+	markChanged();
+	if (m_snapStep == s_simulationStep) {
+		m_previousPosition = m_position;
+		m_previousRotation = m_rotation;
+		m_previousScale = m_scale;
+	}
+}
+
+void
+Transform::snapInterpolation() {
+	m_snapStep = s_simulationStep;
+	m_previousPosition = m_position;
+	m_previousRotation = m_rotation;
+	m_previousScale = m_scale;
+}
+
+void
+Transform::setParent(const Transform* parent) {
+	if (parent == this) {
+		ERROR("Transform", "setParent", "A transform can't be its own parent");
+		return;
+	}
+	if (parent != m_parent) {
+		m_parent = parent;
+		m_worldDirty = true;
+		markChanged();
+	}
+}
+
+namespace {
+	/**
+	 * @brief Misma composicin que `sf::Transformable::getTransform`, sin origen.
+	 */
+	sf::Transform
+	composeLocal(const sf::Vector2f& position, float degrees, const sf::Vector2f& scale) {
+		float angle = -degrees * 3.141592654f / 180.0f;
+		float cosine = std::cos(angle);
+		float sine = std::sin(angle);
+		float sxc = scale.x * cosine;
+		float syc = scale.y * cosine;
+		float sxs = scale.x * sine;
+		float sys = scale.y * sine;
+		return sf::Transform(sxc, sys, position.x,
+		                     -sxs, syc, position.y,
+		                     0.0f, 0.0f, 1.0f);
+	}
+}
+
+const sf::Transform&
+Transform::getLocalTransform() const {
+	if (m_localDirty) {
+		m_local = composeLocal(m_position, m_rotation, m_scale);
+		m_localDirty = false;
+		m_worldDirty = true;
+	}
+	return m_local;
+}
+
+const sf::Transform&
+Transform::getWorldTransform() const {
+	const sf::Transform& local = getLocalTransform();
+	if (m_parent) {
+		const sf::Transform& parentWorld = m_parent->getWorldTransform();
+		if (m_parentVersion != m_parent->m_worldVersion) {
+			m_parentVersion = m_parent->m_worldVersion;
+			m_worldDirty = true;
+		}
+		if (m_worldDirty) {
+			m_world = parentWorld * local;
+			m_worldDirty = false;
+			++m_worldVersion;
+		}
+	}
+	else if (m_worldDirty) {
+		m_world = local;
+		m_worldDirty = false;
+		++m_worldVersion;
+	}
+	return m_world;
+}
+
+void
+Transform::setWorldTransform(const sf::Transform& world) const {
+	getLocalTransform();
+	m_world = world;
+	m_worldDirty = false;
+	++m_worldVersion;
+	m_parentVersion = m_parent ? m_parent->m_worldVersion : 0;
+}
+
+sf::Transform
+Transform::getRenderTransform() const {
+	bool moved = s_renderAlpha < 1.0f && m_previousStep == s_simulationStep &&
+	             (m_previousPosition != m_position || m_previousRotation != m_rotation || m_previousScale != m_scale);
+	if (!moved) {
+		return m_parent ? m_parent->getRenderTransform() * getLocalTransform() : getWorldTransform();
+	}
+
+	// Por el lado corto: de 350 a 10 grados son 20, no 340
+	float alpha = s_renderAlpha;
+	float turn = std::fmod(m_rotation - m_previousRotation + 540.0f, 360.0f) - 180.0f;
+	sf::Transform local = composeLocal(m_previousPosition + (m_position - m_previousPosition) * alpha,
+		m_previousRotation + turn * alpha, m_previousScale + (m_scale - m_previousScale) * alpha);
+	return m_parent ? m_parent->getRenderTransform() * local : local;
+}
+
+void
+Transform::updateBatch(std::span<Component* const> components, float deltaTime) {
+	for (Component* component : components) {
+		static_cast<Transform*>(component)->getWorldTransform();
+	}
+}
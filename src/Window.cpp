@@ -1,34 +1,133 @@
 #include "Window.h"
+#include <algorithm>
+#include <cmath>
+#include "Render/RenderCommandBuffer.h"
+#include "Render/LayerCache.h"
+#include "Render/ShaderCache.h"
+#include "Render/StaticGeometryCache.h"
+#include "Render/TextureLoader.h"
+#include "Events/EventBus.h"
+#include "Memory/HeapTracker.h"
+#include "Memory/MemoryAccounting.h"
+#include "Profiling/Profiler.h"
+#include "Events/EngineEvents.h"
+#include "Input/InputSystem.h"
 
-Window::Window(int width, int height, const std::string& title) {
-	m_window = new sf::RenderWindow(sf::VideoMode(width, height), title);
+Window::Window(int width, int height, const std::string& title, bool headless, bool eventThread) {
+	sf::ContextSettings settings;
+	settings.depthBits = kDepthBits;
+	auto create = [=]() {
+		return new sf::RenderWindow(sf::VideoMode(width, height), title, headless ? sf::Style::None : sf::Style::Default,
+			settings);
+	};
+	// Sin pantalla no hay mensajes que atender: la bomba solo sirve con la ventana visible
+	if (eventThread && !headless) {
+		m_window = m_eventPump.start(create);
+		if (m_window) {
+			m_window->setActive(true);
+		}
+	}
+	else {
+		m_window = create();
+	}
+
+	// Sin pantalla: la ventana oculta solo da el contexto, se dibuja en una textura y sin vsync
+	if (m_window && headless) {
+		m_window->setVisible(false);
+		m_window->setVerticalSyncEnabled(false);
+		m_window->setFramerateLimit(0);
+		m_offscreen = new sf::RenderTexture();
+		if (!m_offscreen->create(static_cast<unsigned int>(width), static_cast<unsigned int>(height), settings)) {
+			MESSAGE("Window", "Window", "could not create the offscreen target, drawing to the hidden window");
+			SAFE_PTR_RELEASE(m_offscreen);
+		}
+	}
 
 	if (!m_window) {
 		ERROR("Window", "Window", "CHECK CONSTRUCTOR" );
 	}
 	else {
+		EngineUtilities::TService<InputSystem>::instance().attach(*m_window);
 		MESSAGE("Window", "Window", "OK");
 	}
 }
 
 Window::~Window() {
-	delete m_window;
+	destroy();
 }
 
 void
 Window::handleEvents() {
+	PROFILE_SCOPE("HandleEvents");
 	sf::Event event;
-	while (m_window->pollEvent(event))
-	{
+	EventBus* events = EngineUtilities::TService<EventBus>::get();
+	InputSystem& input = EngineUtilities::TService<InputSystem>::instance();
+	input.beginFrame();
+	auto dispatch = [&](const sf::Event& event) {
+		input.handle(event);
+		// Todo menos el mouse fuera o la prdida del foco cuenta como actividad para el modo ocioso
+		if (event.type != sf::Event::LostFocus && event.type != sf::Event::MouseLeft)
+			m_lastInput = std::chrono::steady_clock::now();
+		// Se cierra al destruirla: el hilo de render puede estar usndola
 		if (event.type == sf::Event::Closed)
-			m_window->close();
+			m_closeRequested = true;
+		else if (events && event.type == sf::Event::KeyPressed)
+			events->publish(KeyPressed{ event.key.code });
+		else if (events && event.type == sf::Event::MouseButtonPressed)
+			events->publish(MouseButtonPressed{ event.mouseButton.button,
+			                                    sf::Vector2i(event.mouseButton.x, event.mouseButton.y) });
+	};
+	for (const sf::Event& pending : m_pendingEvents)
+		dispatch(pending);
+	m_pendingEvents.clear();
+	while (nextEvent(event))
+		dispatch(event);
+	input.endFrame();
+}
+
+bool
+Window::nextEvent(sf::Event& event) {
+	return m_eventPump.isRunning() ? m_eventPump.tryPop(event) : m_window->pollEvent(event);
+}
+
+bool
+Window::waitForEvent(std::chrono::steady_clock::duration timeout) {
+	PROFILE_SCOPE("WaitForEvent");
+	sf::Event event;
+	bool forever = timeout < std::chrono::steady_clock::duration::zero();
+	if (forever && !m_eventPump.isRunning()) {
+		if (!m_window->waitEvent(event)) {
+			return false;
+		}
+		m_pendingEvents.push_back(event);
+		return true;
+	}
+	// SFML no espera con lmite, y la cola de la bomba no despierta a nadie: se mira en tajadas cortas
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+	for (;;) {
+		if (nextEvent(event)) {
+			m_pendingEvents.push_back(event);
+			return true;
+		}
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (forever) {
+			std::this_thread::sleep_for(kEventPollSlice);
+			continue;
+		}
+		if (now >= deadline) {
+			return false;
+		}
+		std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, kEventPollSlice));
 	}
 }
 
 void
 Window::clear() {
 	if (m_window != nullptr) {
-		m_window->clear();
+		syncSceneTarget();
+		m_gpuTimer.begin(GpuTimer::Clear);
+		getTarget().clear();
+		RenderStatsCounter::current().countClear();
 	}
 	else {
 		ERROR("Window", "clear", "CHECK FOR WINDOW POINTER DATA" );
@@ -37,8 +136,75 @@ Window::clear() {
 
 void
 Window::display() {
+	PROFILE_SCOPE("Display");
 	if (m_window != nullptr) {
-		m_window->display();
+		RenderStats finished = RenderStatsCounter::current().endFrame();
+		{
+			std::lock_guard<EngineMutex> lock(m_statsMutex);
+			m_lastStats = finished;
+		}
+		PROFILE_COUNTER("DrawCalls", finished.drawCalls);
+		// Lo que queda del frame: efectos o escalado de la escena, y el overlay encima
+		m_frameGraph.reset();
+		RenderGraph::ResourceId present = m_frameGraph.importTarget("Present", presentTarget());
+		if (m_sceneTarget) {
+			m_sceneTarget->display();
+			RenderGraph::ResourceId scene = m_frameGraph.importTexture("Scene", m_sceneTarget->getTexture());
+			if (m_postProcess.isActive()) {
+				m_postProcess.addPasses(m_frameGraph, scene, present);
+			}
+			else {
+				m_frameGraph.addPass("Upscale", [&](RenderGraph::PassBuilder& pass) { pass.read(scene).write(present); },
+					[scene, present](RenderGraph::PassContext& context) {
+						PostProcessStack::blit(context.texture(scene), context.target(present));
+					});
+			}
+		}
+		// Fuera de la cuenta: el overlay no se mide a s mismo
+		if (m_statsOverlay.load(std::memory_order_relaxed)) {
+			m_frameGraph.addPass("Overlay", [&](RenderGraph::PassBuilder& pass) { pass.write(present); },
+				[this, &finished](RenderGraph::PassContext&) {
+					m_gpuTimer.begin(GpuTimer::Overlay);
+					drawStatsOverlay(finished);
+				});
+		}
+		std::string console;
+		{
+			std::lock_guard<EngineMutex> lock(m_statsMutex);
+			console = m_consoleText;
+		}
+		if (!console.empty()) {
+			m_frameGraph.addPass("Console", [&](RenderGraph::PassBuilder& pass) { pass.write(present); },
+				[this, &console](RenderGraph::PassContext&) { drawConsole(console); });
+		}
+		// Los pases de la escena corren primero: la marca cubre efectos y escalado
+		if (m_sceneTarget) {
+			m_gpuTimer.begin(GpuTimer::PostProcess);
+		}
+		m_frameGraph.execute();
+		if (!m_captureUnsupported && m_capture.isActive()) {
+			presentTarget().setActive(true);
+			m_captureUnsupported = !m_capture.initialize();
+			if (m_captureUnsupported) {
+				MESSAGE("Window", "display", "OpenGL 3.3 is not available, frames are not captured");
+			}
+			m_capture.capture(presentTarget());
+		}
+		m_gpuTimer.endFrame();
+		{
+			std::lock_guard<EngineMutex> lock(m_statsMutex);
+			m_lastGpuTimings = m_gpuTimer.latest();
+		}
+		if (m_dynamicResolutionEnabled && m_gpuTimer.latest().valid) {
+			m_dynamicResolution.update(m_gpuTimer.latest().totalMs);
+		}
+		if (m_offscreen) {
+			m_offscreen->display();
+		}
+		else {
+			m_window->display();
+		}
+		ENGINE_TRACY_FRAME();
 	}
 	else {
 		ERROR("Window", "display", "CHECK FOR WINDOW POINTER DATA" );
@@ -48,7 +214,7 @@ Window::display() {
 bool
 Window::isOpen() const {
 	if (m_window != nullptr) {
-		return m_window->isOpen();
+		return m_window->isOpen() && !m_closeRequested;
 	}
 	else {
 		ERROR("Window", "isOpen", "CHECK FOR WINDOW POINTER DATA" );
@@ -57,15 +223,93 @@ Window::isOpen() const {
 }
 
 void
-Window::draw(const sf::Drawable& drawable) {
+Window::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
 	if (m_window != nullptr) {
-		m_window->draw(drawable);
+		getTarget().draw(drawable, states);
+		RenderStatsCounter::current().countDraw(RenderStatsCounter::vertexCount(drawable), states.texture, states.shader,
+			states.blendMode);
 	}
 	else {
 		ERROR("Window", "draw", "CHECK FOR WINDOW POINTER DATA" );
 	}
 }
 
+void
+Window::submit(RenderCommandBuffer& commands) {
+	if (m_window == nullptr) {
+		ERROR("Window", "submit", "CHECK FOR WINDOW POINTER DATA" );
+		return;
+	}
+	sf::RenderTarget& target = getTarget();
+	// Las texturas que terminaron de decodificarse, antes de que alguna figura las use
+	if (TextureLoader* textures = EngineUtilities::TService<TextureLoader>::get()) {
+		textures->uploadPending();
+	}
+	if (!commands.meshCommands().empty() && !m_meshesUnsupported) {
+		if (m_meshes.initialize()) {
+			m_gpuTimer.begin(GpuTimer::Meshes);
+			m_meshes.submit(target, commands);
+		}
+		else {
+			m_meshesUnsupported = true;
+			MESSAGE("Window", "submit", "OpenGL 3.3 is not available, 3D meshes are not drawn");
+		}
+	}
+	// Lo esttico va debajo de todo, desde sus bferes ya subidos
+	m_gpuTimer.begin(GpuTimer::World);
+	if (StaticGeometryCache* cache = EngineUtilities::TService<StaticGeometryCache>::get()) {
+		cache->draw(target);
+	}
+	LayerCache* layers = EngineUtilities::TService<LayerCache>::get();
+	if (layers && layers->cachedCount() != 0) {
+		layers->submit(target, commands, m_batcher);
+	}
+	else if (m_sdfShapes) {
+		m_sdf.submit(target, commands, m_batcher);
+	}
+	else if (m_instancing) {
+		m_instanced.submit(target, commands, m_batcher);
+	}
+	else {
+		m_batcher.submit(target, commands);
+	}
+	if (m_gpuCrowd.size() != 0) {
+		m_gpuCrowd.step(m_gpuCrowdTime.exchange(0.0f, std::memory_order_relaxed));
+		m_gpuCrowd.draw(target);
+	}
+}
+
+void
+Window::submit(RenderCommandBuffer& commands, std::span<const sf::View> views) {
+	if (m_window == nullptr) {
+		ERROR("Window", "submit", "CHECK FOR WINDOW POINTER DATA" );
+		return;
+	}
+	sf::RenderTarget& target = getTarget();
+	sf::View previous = target.getView();
+	for (const sf::View& view : views) {
+		target.setView(view);
+		submit(commands);
+	}
+	target.setView(previous);
+}
+
+sf::RenderTarget&
+Window::getTarget() {
+	if (m_sceneTarget != nullptr) {
+		return *m_sceneTarget;
+	}
+	return presentTarget();
+}
+
+sf::RenderTarget&
+Window::presentTarget() {
+	if (m_offscreen != nullptr) {
+		return *m_offscreen;
+	}
+	return *getWindow();
+}
+
 sf::RenderWindow*
 Window::getWindow() {
 	if (m_window != nullptr) {
@@ -77,7 +321,494 @@ Window::getWindow() {
 	}
 }
 
+bool
+Window::setInstancing(bool enabled) {
+	m_instancing = false;
+	if (!enabled || m_window == nullptr) {
+		return !enabled;
+	}
+	presentTarget().setActive(true);
+	m_instancing = m_instanced.initialize();
+	return m_instancing;
+}
+
+bool
+Window::setStreaming(bool enabled) {
+	if (m_window == nullptr) {
+		return !enabled;
+	}
+	presentTarget().setActive(true);
+	return m_batcher.setStreaming(enabled);
+}
+
+bool
+Window::setGpuCrowd(std::span<const GpuAgent> agents, std::span<const sf::Vector2f> path) {
+	if (m_window == nullptr) {
+		return false;
+	}
+	presentTarget().setActive(true);
+	if (!m_gpuCrowd.initialize()) {
+		return false;
+	}
+	m_gpuCrowd.upload(agents, path);
+	m_gpuCrowdTime.store(0.0f, std::memory_order_relaxed);
+	return true;
+}
+
+void
+Window::advanceGpuCrowd(float deltaTime) {
+	float time = m_gpuCrowdTime.load(std::memory_order_relaxed);
+	while (!m_gpuCrowdTime.compare_exchange_weak(time, time + deltaTime, std::memory_order_relaxed)) {
+	}
+}
+
+RenderStats
+Window::stats() const {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	return m_lastStats;
+}
+
+void
+Window::setAudioStats(const AudioStats& stats) {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_audioStats = stats;
+	m_hasAudioStats = true;
+}
+
+AudioStats
+Window::audioStats() const {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	return m_audioStats;
+}
+
+void
+Window::setNetStats(const NetStats& stats) {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_netStats.total = stats.total;
+	m_netStats.bytesOutPerSecond = stats.bytesOutPerSecond;
+	m_netStats.bytesInPerSecond = stats.bytesInPerSecond;
+	m_netStats.peers.resize(stats.peers.size());   // Solo cuntos: el overlay muestra la suma
+	m_hasNetStats = true;
+}
+
+void
+Window::setFrameTimeReport(const FrameTimeReport& report) {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_frameTimes = report;
+	m_hasFrameTimes = true;
+}
+
+void
+Window::setEntityCosts(const EntityCostReport& report) {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_entityCosts.samples = report.samples;
+	m_entityCosts.sampleEvery = report.sampleEvery;
+	m_entityCosts.top.assign(report.top.begin(), report.top.end());
+	m_entityCosts.componentMs = report.componentMs;
+}
+
+void
+Window::setProfileFrame(const ProfileFrame& frame) {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_profileFrame.frame = frame.frame;
+	m_profileFrame.frameMs = frame.frameMs;
+	m_profileFrame.nodes.assign(frame.nodes.begin(), frame.nodes.end());
+	m_profileFrame.threads.assign(frame.threads.begin(), frame.threads.end());
+	m_profileFrame.dropped = frame.dropped;
+	m_hasProfileFrame = true;
+}
+
+void
+Window::setJobTelemetry(const JobTelemetry& telemetry) {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_jobTelemetry.ms = telemetry.ms;
+	m_jobTelemetry.externalQueued = telemetry.externalQueued;
+	m_jobTelemetry.workers.assign(telemetry.workers.begin(), telemetry.workers.end());
+	m_hasJobTelemetry = true;
+}
+
+bool
+Window::loadStatsFont(const std::string& fontPath) {
+	if (!m_statsFontLoaded) {
+		if (!m_statsFont.loadFromFile(fontPath)) {
+			MESSAGE("Window", "loadStatsFont", "could not load the overlay font");
+			return false;
+		}
+		m_statsFontLoaded = true;
+	}
+	return true;
+}
+
+bool
+Window::setStatsOverlay(bool enabled, const std::string& fontPath) {
+	if (enabled && !loadStatsFont(fontPath)) {
+		return false;
+	}
+	m_statsOverlay.store(enabled, std::memory_order_relaxed);
+	return true;
+}
+
+bool
+Window::setConsoleText(const std::string& text, const std::string& fontPath) {
+	if (!text.empty() && !loadStatsFont(fontPath)) {
+		return false;
+	}
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	m_consoleText = text;
+	return true;
+}
+
+void
+Window::setVerticalSync(bool enabled) {
+	if (m_window != nullptr && !m_offscreen) {
+		m_window->setVerticalSyncEnabled(enabled);
+		m_verticalSync = enabled;
+	}
+}
+
+void
+Window::prepareStatsText() {
+	// Los nombres no cambian: se maquetan una vez, en el hilo que dibuja (usa el atlas de la fuente)
+	static constexpr const char* kLabels = "draw calls\nvertices\nstate changes\ntexture binds\nupload KB";
+	static constexpr const char* kAudioLabels = "voices\nvirtual\nunderruns\nsteals\nrefill ms\nlatency ms";
+	static constexpr const char* kNetLabels = "peers\nout KB/s\nin KB/s\nrtt ms\njitter ms\nloss %\nresends\nsnapshot B";
+	if (!m_statsTextReady) {
+		m_statsText.setFont(m_statsFont);
+		m_statsText.prepare(kStatsTextSize);
+		m_statsLabels = m_statsText.cacheLayout(kLabels, kStatsTextSize);
+		m_audioLabels = m_statsText.cacheLayout(kAudioLabels, kStatsTextSize);
+		m_netLabels = m_statsText.cacheLayout(kNetLabels, kStatsTextSize);
+		m_statsValuesX = 16.0f + std::max({ m_statsText.measure(kLabels, kStatsTextSize).x,
+			m_statsText.measure(kAudioLabels, kStatsTextSize).x, m_statsText.measure(kNetLabels, kStatsTextSize).x });
+		m_audioTop = m_statsText.measure(kLabels, kStatsTextSize).y + kStatsTextSize;
+		m_audioHeight = m_statsText.measure(kAudioLabels, kStatsTextSize).y + kStatsTextSize;
+		m_statsTextReady = true;
+	}
+}
+
+void
+Window::drawConsole(const std::string& text) {
+	// Lo que reserva el texto de depuracin no es del frame
+	EngineUtilities::HeapTracker::Scope heapScope;
+	prepareStatsText();
+	sf::RenderTarget& target = presentTarget();
+	const float margin = 8.0f;
+	float height = m_statsText.measure(text, kStatsTextSize).y + 2.0f * margin;
+	sf::RectangleShape background(sf::Vector2f(static_cast<float>(target.getSize().x), height));
+	background.setPosition(0.0f, static_cast<float>(target.getSize().y) - height);
+	background.setFillColor(sf::Color(0, 0, 0, 200));
+	m_statsText.add(text, kStatsTextSize, background.getPosition() + sf::Vector2f(margin, margin), sf::Color::White);
+
+	sf::View view = target.getView();
+	target.setView(target.getDefaultView());
+	target.draw(background);
+	m_statsText.draw(target);
+	target.setView(view);
+}
+
+void
+Window::drawStatsOverlay(const RenderStats& stats) {
+	EngineUtilities::HeapTracker::Scope heapScope;
+	prepareStatsText();
+	std::ostringstream values;
+	values << stats.drawCalls << "\n" << stats.vertices << "\n" << stats.stateChanges << "\n" << stats.textureBinds
+	       << "\n" << stats.uploadBytes / 1024;
+	std::string text = values.str();
+
+	std::string audioText;
+	std::string netText;
+	std::string profileText;
+	{
+		std::lock_guard<EngineMutex> lock(m_statsMutex);
+		if (m_hasAudioStats) {
+			std::ostringstream audio;
+			audio.setf(std::ios::fixed);
+			audio.precision(2);
+			audio << m_audioStats.voices << "\n" << m_audioStats.virtuals << "\n" << m_audioStats.underruns << "\n"
+			      << m_audioStats.steals << "\n" << m_audioStats.refillMaxMs << "\n" << m_audioStats.latencyMaxMs;
+			audioText = audio.str();
+		}
+		if (m_hasNetStats) {
+			const NetLinkStats& link = m_netStats.total.link;
+			std::ostringstream net;
+			net.setf(std::ios::fixed);
+			net.precision(1);
+			net << m_netStats.peers.size() << "\n" << m_netStats.bytesOutPerSecond / 1024.0f << "\n"
+			    << m_netStats.bytesInPerSecond / 1024.0f << "\n" << link.rttMs << "\n" << link.jitterMs << "\n"
+			    << link.loss() * 100.0f << "\n" << link.resends << "\n" << m_netStats.total.snapshotBytes;
+			netText = net.str();
+		}
+		if (m_hasFrameTimes) {
+			std::ostringstream frames;
+			frames.setf(std::ios::fixed);
+			frames.precision(1);
+			frames << "p50 " << m_frameTimes.frame.p50Ms << " p95 " << m_frameTimes.frame.p95Ms << " p99 "
+			       << m_frameTimes.frame.p99Ms << " max " << m_frameTimes.frame.maxMs << " ms\n"
+			       << m_frameTimes.hitches << " hitches in " << m_frameTimes.seconds << " s";
+			profileText = frames.str();
+		}
+		if (m_hasProfileFrame) {
+			// Lo de arriba del rbol; lo ms hondo queda para la traza
+			static constexpr uint32_t kMaxDepth = 4;
+			static constexpr size_t kMaxLines = 24;
+			std::ostringstream profile;
+			profile.setf(std::ios::fixed);
+			profile.precision(2);
+			profile << "frame " << m_profileFrame.frameMs << " ms";
+			size_t lines = 1;
+			for (const ProfileNode& node : m_profileFrame.nodes) {
+				if (node.depth >= kMaxDepth) {
+					continue;
+				}
+				if (++lines > kMaxLines) {
+					break;
+				}
+				profile << "\n" << std::string(node.depth * 2, ' ') << node.name << " " << node.ms << " ms";
+				if (node.calls > 1) {
+					profile << " x" << node.calls;
+				}
+				// Sin instrucciones (Windows) solo hay ciclos
+				if (node.counters.cycles) {
+					profile << " " << node.counters.cycles / 1000 << "k cyc";
+				}
+				if (node.counters.instructions) {
+					profile << " ipc " << node.counters.ipc() << " llc " << node.counters.cacheMisses / 1000 << "k br "
+					        << node.counters.branchMisses / 1000 << "k";
+				}
+			}
+			for (const ProfileThread& thread : m_profileFrame.threads) {
+				profile << "\nthread " << thread.thread << " " << thread.busyMs << " ms";
+			}
+			if (m_profileFrame.dropped) {
+				profile << "\ndropped " << m_profileFrame.dropped;
+			}
+			profileText += (profileText.empty() ? "" : "\n") + profile.str();
+		}
+		if (m_entityCosts.samples) {
+			// Promedio de los frames medidos; sin nombre, el ndice del handle
+			std::ostringstream costs;
+			costs.setf(std::ios::fixed);
+			costs.precision(3);
+			costs << "entities update / render ms (1 in " << m_entityCosts.sampleEvery << ")";
+			for (const EntityCost& cost : m_entityCosts.top) {
+				std::string_view name = NameTable::instance().view(cost.name);
+				costs << "\n  ";
+				if (name.empty()) {
+					costs << "#" << cost.entity.index;
+				}
+				else {
+					costs << name;
+				}
+				costs << " " << cost.updateMs << " / " << cost.renderMs;
+			}
+			costs << "\ncomponents";
+			for (size_t type = 0; type < kComponentTypeCount; ++type) {
+				if (m_entityCosts.componentMs[type] >= 0.001) {
+					costs << " " << EntityCostProfiler::componentTypeName(static_cast<ComponentType>(type)) << " "
+					      << m_entityCosts.componentMs[type];
+				}
+			}
+			profileText += (profileText.empty() ? "" : "\n") + costs.str();
+		}
+		if (m_hasJobTelemetry && m_jobTelemetry.ms > 0.0) {
+			// Ocupado, trabajos, robos logrados / intentos, espera y cola de cada hilo
+			static constexpr size_t kMaxWorkers = 16;
+			JobWorkerStats total = m_jobTelemetry.total();
+			std::ostringstream jobs;
+			jobs.setf(std::ios::fixed);
+			jobs.precision(1);
+			jobs << "jobs " << m_jobTelemetry.utilization() * 100.0 << "% " << total.jobs << " run " << total.steals << "/"
+			     << total.stealAttempts << " steals wait " << total.waitMs << " ms queued " << total.queued;
+			for (size_t i = 0; i < m_jobTelemetry.workers.size() && i < kMaxWorkers; ++i) {
+				const JobWorkerStats& worker = m_jobTelemetry.workers[i];
+				jobs << "\n  " << (i == 0 ? "main" : "worker " + std::to_string(i)) << " "
+				     << worker.busyMs * 100.0 / m_jobTelemetry.ms << "% " << worker.jobs << " " << worker.steals << "/"
+				     << worker.stealAttempts << " " << worker.waitMs << " ms q " << worker.queued;
+			}
+			profileText += (profileText.empty() ? "" : "\n") + jobs.str();
+		}
+	}
+	if constexpr (EngineUtilities::kMemoryAccounting) {
+		// Solo lo que reserv algo o tiene presupuesto; `!` si el pico lo pas
+		std::ostringstream memory;
+		memory.setf(std::ios::fixed);
+		memory.precision(1);
+		memory << "memory MiB now / peak / budget";
+		for (const EngineUtilities::MemoryUsage& usage : EngineUtilities::MemoryAccounting::snapshot()) {
+			if (usage.peakBytes == 0 && usage.budgetBytes == 0) {
+				continue;
+			}
+			memory << "\n" << EngineUtilities::MemoryAccounting::name(usage.category) << " " << usage.currentBytes / 1048576.0
+			       << " / " << usage.peakBytes / 1048576.0;
+			if (usage.budgetBytes) {
+				memory << " / " << usage.budgetBytes / 1048576.0 << (usage.overBudget() ? " !" : "");
+			}
+		}
+		profileText += (profileText.empty() ? "" : "\n") + memory.str();
+	}
+	if constexpr (EngineUtilities::kHeapHooks) {
+		EngineUtilities::HeapFrame heap = EngineUtilities::HeapTracker::lastFrame();
+		std::ostringstream line;
+		line.setf(std::ios::fixed);
+		line.precision(1);
+		line << "heap " << heap.allocations << " allocs / " << heap.bytes / 1024.0 << " KiB per frame";
+		profileText += (profileText.empty() ? "" : "\n") + line.str();
+	}
+
+	// Sombra de un pxel para que se lea sobre cualquier fondo
+	const sf::Vector2f corner(8.0f, 8.0f);
+	const sf::Vector2f shadow(1.0f, 1.0f);
+	const sf::Vector2f valuesAt(corner.x + m_statsValuesX, corner.y);
+	m_statsText.add(m_statsLabels, corner + shadow, sf::Color::Black);
+	m_statsText.add(text, kStatsTextSize, valuesAt + shadow, sf::Color::Black);
+	m_statsText.add(m_statsLabels, corner, sf::Color::White);
+	m_statsText.add(text, kStatsTextSize, valuesAt, sf::Color::White);
+	if (!audioText.empty()) {
+		const sf::Vector2f audioAt(corner.x, corner.y + m_audioTop);
+		const sf::Vector2f audioValuesAt(valuesAt.x, audioAt.y);
+		m_statsText.add(m_audioLabels, audioAt + shadow, sf::Color::Black);
+		m_statsText.add(audioText, kStatsTextSize, audioValuesAt + shadow, sf::Color::Black);
+		m_statsText.add(m_audioLabels, audioAt, sf::Color::White);
+		m_statsText.add(audioText, kStatsTextSize, audioValuesAt, sf::Color::White);
+	}
+	if (!netText.empty()) {
+		const sf::Vector2f netAt(corner.x, corner.y + m_audioTop + (audioText.empty() ? 0.0f : m_audioHeight));
+		const sf::Vector2f netValuesAt(valuesAt.x, netAt.y);
+		m_statsText.add(m_netLabels, netAt + shadow, sf::Color::Black);
+		m_statsText.add(netText, kStatsTextSize, netValuesAt + shadow, sf::Color::Black);
+		m_statsText.add(m_netLabels, netAt, sf::Color::White);
+		m_statsText.add(netText, kStatsTextSize, netValuesAt, sf::Color::White);
+	}
+
+	sf::RenderTarget& target = presentTarget();
+	if (!profileText.empty()) {
+		const sf::Vector2f profileAt(target.getSize().x - corner.x - m_statsText.measure(profileText, kStatsTextSize).x, corner.y);
+		m_statsText.add(profileText, kStatsTextSize, profileAt + shadow, sf::Color::Black);
+		m_statsText.add(profileText, kStatsTextSize, profileAt, sf::Color::White);
+	}
+
+	// En pxeles de la ventana, sin importar la vista del juego ni los efectos
+	sf::View view = target.getView();
+	target.setView(target.getDefaultView());
+	m_statsText.draw(target);
+	target.setView(view);
+}
+
+bool
+Window::setGpuTiming(bool enabled) {
+	if (m_window == nullptr) {
+		return !enabled;
+	}
+	presentTarget().setActive(true);
+	if (!enabled) {
+		m_gpuTimer.release();
+		return true;
+	}
+	return m_gpuTimer.initialize();
+}
+
+GpuTimings
+Window::gpuTimings() const {
+	std::lock_guard<EngineMutex> lock(m_statsMutex);
+	return m_lastGpuTimings;
+}
+
+bool
+Window::setSdfShapes(bool enabled) {
+	m_sdfShapes = false;
+	if (!enabled || m_window == nullptr) {
+		return !enabled;
+	}
+	presentTarget().setActive(true);
+	m_sdfShapes = m_sdf.initialize();
+	return m_sdfShapes;
+}
+
+bool
+Window::setDynamicResolution(bool enabled, const DynamicResolution::Settings& settings) {
+	m_dynamicResolutionEnabled = false;
+	m_dynamicResolution.setSettings(settings);
+	if (!enabled) {
+		m_dynamicResolution.reset();
+		return true;
+	}
+	if (!setGpuTiming(true)) {
+		return false;
+	}
+	m_dynamicResolutionEnabled = true;
+	return true;
+}
+
+void
+Window::syncSceneTarget() {
+	sf::RenderTarget& present = presentTarget();
+	float scale = m_dynamicResolutionEnabled ? m_dynamicResolution.scale() : 1.0f;
+	if (m_postProcessUnsupported || (!m_postProcess.isActive() && scale >= 1.0f)) {
+		if (m_sceneTarget) {
+			present.setView(m_sceneTarget->getView());
+			SAFE_PTR_RELEASE(m_sceneTarget);
+		}
+		m_resolutionScale.store(1.0f, std::memory_order_relaxed);
+		return;
+	}
+	sf::Vector2u size(std::max(1u, static_cast<unsigned int>(std::lround(present.getSize().x * scale))),
+	                  std::max(1u, static_cast<unsigned int>(std::lround(present.getSize().y * scale))));
+	if (m_sceneTarget && m_sceneTarget->getSize() == size) {
+		return;
+	}
+
+	sf::View view = getTarget().getView();
+	SAFE_PTR_RELEASE(m_sceneTarget);
+	sf::ContextSettings settings;
+	settings.depthBits = kDepthBits;
+	m_sceneTarget = new sf::RenderTexture();
+	if (!m_sceneTarget->create(size.x, size.y, settings)) {
+		MESSAGE("Window", "syncSceneTarget", "could not create the scene texture, drawing straight to the window");
+		SAFE_PTR_RELEASE(m_sceneTarget);
+		m_postProcessUnsupported = true;
+		m_resolutionScale.store(1.0f, std::memory_order_relaxed);
+		return;
+	}
+	// La vista es en coordenadas de mundo: con menos pxeles se ve la misma rea
+	m_sceneTarget->setSmooth(true);
+	m_sceneTarget->setView(view);
+	m_resolutionScale.store(scale, std::memory_order_relaxed);
+}
+
 void 
 Window::destroy() {
+	// Los objetos de OpenGL se borran mientras el contexto existe
+	if (m_window != nullptr) {
+		presentTarget().setActive(true);
+		m_instanced.release();
+		m_batcher.setStreaming(false);
+		m_gpuCrowd.release();
+		m_sdf.release();
+		m_meshes.release();
+		m_gpuTimer.release();
+		m_capture.release();
+		m_postProcess.pool().clear();
+		SAFE_PTR_RELEASE(m_sceneTarget);
+		if (ShaderCache* shaders = EngineUtilities::TService<ShaderCache>::get()) {
+			shaders->release();
+		}
+	}
+	m_instancing = false;
+	m_sdfShapes = false;
+	// El muestreo lee la ventana desde su hilo
+	if (m_window != nullptr) {
+		if (InputSystem* input = EngineUtilities::TService<InputSystem>::get()) {
+			input->detach();
+		}
+	}
+	SAFE_PTR_RELEASE(m_offscreen);
+	if (m_eventPump.isRunning()) {
+		// La ventana se destruye en el hilo que la cre, con el contexto suelto
+		if (m_window != nullptr) {
+			m_window->setActive(false);
+		}
+		m_eventPump.stop();
+		m_window = nullptr;
+	}
 	SAFE_PTR_RELEASE(m_window);
 }
@@ -0,0 +1,332 @@
+#include "WorldStreamer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Actor.h"
+#include "ActorPool.h"
+#include "Events/EngineEvents.h"
+#include "Events/EventBus.h"
+#include "Memory/ServiceLocator.h"
+#include "Scene/SceneWriter.h"
+
+namespace {
+	constexpr size_t kPageBytes = 4096;
+
+	/**
+	 * @brief Lee un byte por pgina de `[begin, end)` para que el sistema las traiga.
+	 */
+	void
+	touchPages(const unsigned char* begin, const unsigned char* end) {
+		volatile unsigned char sink = 0;
+		for (const unsigned char* at = begin; at < end; at += kPageBytes) {
+			sink = sink ^ *at;
+		}
+		if (begin < end) {
+			sink = sink ^ end[-1];
+		}
+	}
+}
+
+bool
+WorldStreamer::open(const std::string& path) {
+	close();
+	if (!m_scene.open(path)) {
+		return false;
+	}
+	adopt();
+	return true;
+}
+
+bool
+WorldStreamer::openMemory(const unsigned char* data, size_t size) {
+	close();
+	if (!m_scene.openMemory(data, size)) {
+		return false;
+	}
+	adopt();
+	return true;
+}
+
+bool
+WorldStreamer::openMemory(std::vector<unsigned char> bytes) {
+	close();
+	m_bytes = std::move(bytes);
+	if (!m_scene.openMemory(m_bytes.data(), m_bytes.size())) {
+		m_bytes = {};
+		return false;
+	}
+	adopt();
+	return true;
+}
+
+void
+WorldStreamer::adopt() {
+	m_regions = std::vector<Region>(m_scene.regions().size());
+	m_masks = m_scene.components<SceneActorMasks>("EntityMasks");
+	m_maskOf.assign(m_regions.empty() ? 0 : m_scene.actors().size(), kNoMask);
+	for (uint32_t i = 0; !m_maskOf.empty() && i < m_masks.owners.size(); ++i) {
+		m_maskOf[m_masks.owners[i]] = i;
+	}
+}
+
+void
+WorldStreamer::close() {
+	JobSystem* jobs = EngineUtilities::TService<JobSystem>::get();
+	for (Region& region : m_regions) {
+		// El trabajo lee el mapeo: debe terminar antes de cerrarlo
+		if (jobs && !region.prefetch.isDone()) {
+			jobs->wait(region.prefetch);
+		}
+		cancelAssets(region);
+		for (EngineUtilities::TSharedPointer<Actor>& actor : region.actors) {
+			actor->destroy();
+		}
+	}
+	m_regions.clear();
+	m_maskOf.clear();
+	m_masks = {};
+	m_actorCount = 0;
+	m_scene.close();
+	m_bytes = {};
+}
+
+void
+WorldStreamer::update(ActorPool& pool) {
+	if (m_regions.empty()) {
+		return;
+	}
+	sf::Clock clock;
+	std::span<const SceneRegionRecord> records = m_scene.regions();
+
+	// Qu toca empezar, qu termin de cargar y qu qued lejos
+	m_order.clear();
+	uint32_t loading = 0;
+	for (uint32_t i = 0; i < m_regions.size(); ++i) {
+		Region& region = m_regions[i];
+		region.distance = distanceTo(records[i]);
+		bool far = region.distance > m_unloadMargin;
+		switch (region.state) {
+		case RegionState::Unloaded:
+			if (region.distance <= m_loadMargin) {
+				m_order.push_back(i);
+			}
+			break;
+		case RegionState::Loading: {
+			if (far) {
+				cancelAssets(region);
+				region.state = RegionState::Unloading;
+				break;
+			}
+			++loading;
+			AssetStreamer* streamer = EngineUtilities::TService<AssetStreamer>::get();
+			bool ready = region.prefetch.isDone() && std::none_of(region.assets.begin(), region.assets.end(),
+				[streamer](StreamHandle handle) {
+					StreamState state = streamer ? streamer->state(handle) : StreamState::None;
+					return state == StreamState::Queued || state == StreamState::Loading;
+				});
+			if (ready) {
+				region.state = RegionState::Activating;
+				region.next = 0;
+			}
+			break;
+		}
+		case RegionState::Activating:
+		case RegionState::Active:
+			if (far) {
+				cancelAssets(region);
+				region.state = RegionState::Unloading;
+			}
+			break;
+		case RegionState::Unloading:
+			break;
+		}
+	}
+
+	// Las ms cercanas primero, sin pasar de `maxLoading` a la vez
+	std::sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) { return m_regions[a].distance < m_regions[b].distance; });
+	for (uint32_t index : m_order) {
+		if (loading >= m_maxLoading) {
+			break;
+		}
+		beginLoading(index);
+		++loading;
+	}
+
+	// Crear y destruir actores con un solo presupuesto: primero lo que se va, despus lo ms cercano.
+	// Al menos un actor por frame, para que una regin avance aunque el frame ya venga cargado
+	m_order.clear();
+	for (uint32_t i = 0; i < m_regions.size(); ++i) {
+		if (m_regions[i].state == RegionState::Unloading || m_regions[i].state == RegionState::Activating) {
+			m_order.push_back(i);
+		}
+	}
+	std::sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+		bool aLeaving = m_regions[a].state == RegionState::Unloading;
+		bool bLeaving = m_regions[b].state == RegionState::Unloading;
+		return aLeaving != bLeaving ? aLeaving : m_regions[a].distance < m_regions[b].distance;
+	});
+	bool first = true;
+	auto withinBudget = [&]() {
+		bool within = first || clock.getElapsedTime().asSeconds() < m_activationBudget;
+		first = false;
+		return within;
+	};
+	for (uint32_t index : m_order) {
+		Region& region = m_regions[index];
+		const SceneRegionRecord& record = records[index];
+		if (region.state == RegionState::Unloading) {
+			while (!region.actors.empty() && withinBudget()) {
+				region.actors.back()->destroy();
+				region.actors.pop_back();
+				--m_actorCount;
+			}
+			// El trabajo de una carga cancelada todava puede estar leyendo
+			if (region.actors.empty() && region.prefetch.isDone()) {
+				region.state = RegionState::Unloaded;
+				region.actors.shrink_to_fit();
+				if (region.announced) {
+					region.announced = false;
+					EngineUtilities::TService<EventBus>::instance().publish(RegionUnloaded{ index });
+				}
+			}
+			continue;
+		}
+		while (region.next < record.actorCount && withinBudget()) {
+			activateNext(region, record, pool);
+		}
+		if (region.next == record.actorCount) {
+			finishActivation(index);
+		}
+	}
+}
+
+void
+WorldStreamer::loadAll(ActorPool& pool) {
+	std::span<const SceneRegionRecord> records = m_scene.regions();
+	for (uint32_t i = 0; i < m_regions.size(); ++i) {
+		Region& region = m_regions[i];
+		if (region.state != RegionState::Unloaded) {
+			continue;
+		}
+		// Los recursos se piden igual, pero los actores no los esperan
+		beginLoading(i);
+		region.state = RegionState::Activating;
+		region.next = 0;
+		while (region.next < records[i].actorCount) {
+			activateNext(region, records[i], pool);
+		}
+		finishActivation(i);
+	}
+}
+
+EngineUtilities::TSharedPointer<Actor>
+WorldStreamer::spawnActor(ActorPool& pool, const SceneFile& scene, const SceneActorRecord& record) {
+	EngineUtilities::TSharedPointer<Actor> actor = pool.spawn(scene.actorName(record));
+	Transform* transform = actor->findComponent<Transform>();
+	transform->setPosition(record.positionX, record.positionY);
+	transform->setRotation(record.rotation);
+	transform->setScale(record.scaleX, record.scaleY);
+	ShapeFactory* shape = actor->findComponent<ShapeFactory>();
+	if (shape->createShape(static_cast<ShapeType>(record.shapeType))) {
+		shape->setFillColor(sf::Color(record.fillColor));
+	}
+	actor->setActive((record.flags & kSceneActorActive) != 0);
+	return actor;
+}
+
+void
+WorldStreamer::save(SceneWriter& writer, std::vector<uint32_t>& owners, std::vector<SceneActorMasks>& masks) const {
+	std::span<const SceneActorRecord> actors = m_scene.actors();
+	for (const SceneRegionRecord& region : m_scene.regions()) {
+		SceneRegionRecord copy = region;
+		copy.firstActor = writer.actorCount();
+		for (uint32_t i = region.firstActor; i < region.firstActor + region.actorCount; ++i) {
+			uint32_t index = writer.addActor(m_scene.actorName(actors[i]), actors[i]);
+			if (m_maskOf[i] != kNoMask) {
+				owners.push_back(index);
+				masks.push_back(m_masks.values[m_maskOf[i]]);
+			}
+		}
+		uint32_t saved = writer.addRegion(copy);
+		for (const SceneRegionAsset& asset : m_scene.regionAssets(region)) {
+			writer.addRegionAsset(saved, asset.kind, m_scene.assetPath(asset));
+		}
+	}
+}
+
+float
+WorldStreamer::distanceTo(const SceneRegionRecord& region) const {
+	float nearest = std::numeric_limits<float>::infinity();
+	for (const sf::FloatRect& area : m_foci) {
+		float dx = std::max({ 0.0f, region.minX - (area.left + area.width), area.left - region.maxX });
+		float dy = std::max({ 0.0f, region.minY - (area.top + area.height), area.top - region.maxY });
+		nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy));
+	}
+	return nearest;
+}
+
+void
+WorldStreamer::beginLoading(uint32_t index) {
+	Region& region = m_regions[index];
+	const SceneRegionRecord& record = m_scene.regions()[index];
+	region.state = RegionState::Loading;
+
+	// Registros y nombres de la regin: los escribe seguidos `SceneWriter`, as que son dos tramos
+	if (record.actorCount > 0) {
+		const SceneActorRecord* first = m_scene.actors().data() + record.firstActor;
+		const SceneActorRecord* last = first + record.actorCount;
+		std::string_view firstName = m_scene.actorName(first[0]);
+		std::string_view lastName = m_scene.actorName(last[-1]);
+		const unsigned char* names = reinterpret_cast<const unsigned char*>(firstName.data());
+		const unsigned char* namesEnd = reinterpret_cast<const unsigned char*>(lastName.data() + lastName.size());
+		EngineUtilities::TService<JobSystem>::instance().run([first, last, names, namesEnd]() {
+			touchPages(reinterpret_cast<const unsigned char*>(first), reinterpret_cast<const unsigned char*>(last));
+			touchPages(names, namesEnd);
+		}, &region.prefetch);
+	}
+
+	std::span<const SceneRegionAsset> assets = m_scene.regionAssets(record);
+	if (!assets.empty()) {
+		AssetStreamer& streamer = EngineUtilities::TService<AssetStreamer>::instance();
+		sf::Vector2f center(0.5f * (record.minX + record.maxX), 0.5f * (record.minY + record.maxY));
+		region.assets.reserve(assets.size());
+		for (const SceneRegionAsset& asset : assets) {
+			region.assets.push_back(streamer.requestAt(static_cast<AssetKind>(asset.kind), std::string(m_scene.assetPath(asset)), center));
+		}
+	}
+}
+
+void
+WorldStreamer::activateNext(Region& region, const SceneRegionRecord& record, ActorPool& pool) {
+	uint32_t actorIndex = record.firstActor + region.next++;
+	EngineUtilities::TSharedPointer<Actor> actor = spawnActor(pool, m_scene, m_scene.actors()[actorIndex]);
+	if (m_maskOf[actorIndex] != kNoMask) {
+		actor->setTags(m_masks.values[m_maskOf[actorIndex]].tags);
+		actor->setLayers(m_masks.values[m_maskOf[actorIndex]].layers);
+	}
+	region.actors.push_back(std::move(actor));
+	++m_actorCount;
+}
+
+void
+WorldStreamer::finishActivation(uint32_t index) {
+	Region& region = m_regions[index];
+	region.state = RegionState::Active;
+	region.announced = true;
+	EngineUtilities::TService<EventBus>::instance().publish(RegionActivated{ index, m_scene.regions()[index].actorCount });
+}
+
+void
+WorldStreamer::cancelAssets(Region& region) {
+	if (AssetStreamer* streamer = EngineUtilities::TService<AssetStreamer>::get()) {
+		for (StreamHandle handle : region.assets) {
+			streamer->cancel(handle);
+		}
+	}
+	region.assets.clear();
+}
+
+WorldStreamer&
+WorldStreamer::instance() {
+	return EngineUtilities::TService<WorldStreamer>::instance();
+}